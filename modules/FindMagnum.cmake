@@ -41,6 +41,7 @@
 #  Audio                        - Audio library
 #  DebugTools                   - DebugTools library
 #  MeshTools                    - MeshTools library
+#  PointCloud                   - PointCloud library
 #  Primitives                   - Primitives library
 #  SceneGraph                   - SceneGraph library
 #  Shaders                      - Shaders library
@@ -64,15 +65,20 @@
 #  EglContext                   - EGL context
 #  GlxContext                   - GLX context
 #  WglContext                   - WGL context
+#  KtxImporter                  - KTX importer plugin
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MeshBlobImporter             - Mesh blob importer plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
 #  WavAudioImporter             - WAV audio importer plugin
+#  capturereplay                - magnum-capturereplay executable
 #  distancefieldconverter       - magnum-distancefieldconverter executable
 #  fontconverter                - magnum-fontconverter executable
+#  imageconverter               - magnum-imageconverter executable
 #  info                         - magnum-info executable
+#  meshbaker                    - magnum-meshbaker executable
 #
 # Example usage with specifying additional components is::
 #
@@ -107,6 +113,12 @@
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
 #  MAGNUM_BUILD_MULTITHREADED   - Defined if compiled in a way that allows
 #   having multiple thread-local Magnum contexts
+#  MAGNUM_BUILD_STATISTICS      - Defined if compiled with GL call and state
+#   change statistics counters
+#  MAGNUM_BUILD_TRACING         - Defined if compiled with tracing hooks in
+#   hot paths
+#  MAGNUM_BUILD_CAPTURE         - Defined if compiled with GL command capture
+#   hooks
 #  MAGNUM_TARGET_GLES           - Defined if compiled for OpenGL ES
 #  MAGNUM_TARGET_GLES2          - Defined if compiled for OpenGL ES 2.0
 #  MAGNUM_TARGET_GLES3          - Defined if compiled for OpenGL ES 3.0
@@ -209,6 +221,9 @@ set(_magnumFlags
     BUILD_DEPRECATED
     BUILD_STATIC
     BUILD_MULTITHREADED
+    BUILD_STATISTICS
+    BUILD_TRACING
+    BUILD_CAPTURE
     TARGET_GLES
     TARGET_GLES2
     TARGET_GLES3
@@ -272,6 +287,9 @@ if(NOT TARGET Magnum::Magnum)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
          Corrade::Utility
          Corrade::PluginManager)
+    find_package(Threads)
+    set_property(TARGET Magnum::Magnum APPEND PROPERTY
+        INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
 
     # Dependent libraries and includes
     if(NOT MAGNUM_TARGET_GLES OR MAGNUM_TARGET_DESKTOP_GLES)
@@ -302,7 +320,9 @@ set(_MAGNUM_ADDITIONAL_COMPONENTS )
 foreach(_component ${Magnum_FIND_COMPONENTS})
     string(TOUPPER ${_component} _COMPONENT)
 
-    if(_component STREQUAL Shapes)
+    if(_component STREQUAL PointCloud)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES SceneGraph)
+    elseif(_component STREQUAL Shapes)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES SceneGraph)
     elseif(_component STREQUAL Text)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TextureTools)
@@ -312,6 +332,8 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TgaImporter) # and below
     elseif(_component STREQUAL MagnumFontConverter)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TgaImageConverter) # and below
+    elseif(_component STREQUAL MeshBlobImporter)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES MeshTools)
     elseif(_component STREQUAL ObjImporter)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES MeshTools)
     endif()
@@ -342,9 +364,9 @@ endif()
 
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
-set(_MAGNUM_LIBRARY_COMPONENTS "^(Audio|DebugTools|MeshTools|Primitives|SceneGraph|Shaders|Shapes|Text|TextureTools|AndroidApplication|GlfwApplication|GlutApplication|GlxApplication|NaClApplication|Sdl2Application|XEglApplication|WindowlessCglApplication|WindowlessEglApplication|WindowlessGlxApplication|WindowlessIosApplication|WindowlessNaClApplication|WindowlessWglApplication|WindowlessWindowsEglApplication|CglContext|EglContext|GlxContext|WglContext)$")
-set(_MAGNUM_PLUGIN_COMPONENTS "^(MagnumFont|MagnumFontConverter|ObjImporter|TgaImageConverter|TgaImporter|WavAudioImporter)$")
-set(_MAGNUM_EXECUTABLE_COMPONENTS "^(distancefieldconverter|fontconverter|info)$")
+set(_MAGNUM_LIBRARY_COMPONENTS "^(Audio|DebugTools|MeshTools|PointCloud|Primitives|SceneGraph|Shaders|Shapes|Text|TextureTools|AndroidApplication|GlfwApplication|GlutApplication|GlxApplication|NaClApplication|Sdl2Application|XEglApplication|WindowlessCglApplication|WindowlessEglApplication|WindowlessGlxApplication|WindowlessIosApplication|WindowlessNaClApplication|WindowlessWglApplication|WindowlessWindowsEglApplication|CglContext|EglContext|GlxContext|WglContext)$")
+set(_MAGNUM_PLUGIN_COMPONENTS "^(KtxImporter|MagnumFont|MagnumFontConverter|MeshBlobImporter|ObjImporter|TgaImageConverter|TgaImporter|WavAudioImporter)$")
+set(_MAGNUM_EXECUTABLE_COMPONENTS "^(capturereplay|distancefieldconverter|fontconverter|imageconverter|info|meshbaker)$")
 
 # Find all components
 foreach(_component ${Magnum_FIND_COMPONENTS})
@@ -568,18 +590,33 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
                 INTERFACE_INCLUDE_DIRECTORIES ${OPENAL_INCLUDE_DIR})
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES ${OPENAL_LIBRARY})
+            find_package(Threads)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
 
         # No special setup for DebugTools library
 
         # Mesh tools library
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
+            find_package(Threads)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
+        # PointCloud library
+        elseif(_component STREQUAL PointCloud)
+            set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Octree.h)
 
         # Primitives library
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library dependencies
+        elseif(_component STREQUAL SceneGraph)
+            find_package(Threads)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
         # No special setup for Shaders library
         # No special setup for Shapes library
         # No special setup for Text library
@@ -587,6 +624,15 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # TextureTools library
         elseif(_component STREQUAL TextureTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
+            find_package(Threads)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
+        # ObjImporter plugin dependencies
+        elseif(_component STREQUAL ObjImporter)
+            find_package(Threads)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
         endif()
 
         # Find library/plugin includes
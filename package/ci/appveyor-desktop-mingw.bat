@@ -25,6 +25,8 @@ cmake .. ^
     -DWITH_SDL2APPLICATION=ON ^
     -DWITH_WINDOWLESSWGLAPPLICATION=ON ^
     -DWITH_WGLCONTEXT=ON ^
+    -DWITH_KTXIMPORTER=ON ^
+    -DWITH_MESHBLOBIMPORTER=ON ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
     -DWITH_OBJIMPORTER=ON ^
@@ -62,6 +62,8 @@ cmake .. ^
     -DSDL2_INCLUDE_DIR=%APPVEYOR_BUILD_FOLDER%/SDL/include ^
     -DWITH_AUDIO=OFF ^
     -DWITH_SDL2APPLICATION=ON ^
+    -DWITH_KTXIMPORTER=ON ^
+    -DWITH_MESHBLOBIMPORTER=ON ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
     -DWITH_OBJIMPORTER=ON ^
@@ -22,6 +22,8 @@ cmake .. \
     -DWITH_SDL2APPLICATION=ON \
     -DWITH_WINDOWLESS${PLATFORM_GL_API}APPLICATION=ON \
     -DWITH_${PLATFORM_GL_API}CONTEXT=ON \
+    -DWITH_KTXIMPORTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
     -DWITH_OBJIMPORTER=ON \
@@ -48,6 +48,8 @@ cmake .. \
     -DCMAKE_FIND_ROOT_PATH=$HOME/deps \
     -DWITH_AUDIO=OFF \
     -DWITH_SDL2APPLICATION=ON \
+    -DWITH_KTXIMPORTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
     -DWITH_OBJIMPORTER=ON \
@@ -49,6 +49,8 @@ cmake .. \
     -DWITH_SDL2APPLICATION=ON \
     -DWITH_WINDOWLESSIOSAPPLICATION=ON \
     -DWITH_EGLCONTEXT=ON \
+    -DWITH_KTXIMPORTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
     -DWITH_OBJIMPORTER=ON \
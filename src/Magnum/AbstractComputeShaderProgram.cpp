@@ -0,0 +1,60 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "AbstractComputeShaderProgram.h"
+
+namespace Magnum {
+
+Vector3ui AbstractComputeShaderProgram::workGroupCount(const Vector3ui& invocationCount, const Vector3ui& workGroupSize) {
+    CORRADE_ASSERT(workGroupSize.product(),
+        "AbstractComputeShaderProgram::workGroupCount(): invalid workgroup size" << workGroupSize, {});
+    return (invocationCount + workGroupSize - Vector3ui{1})/workGroupSize;
+}
+
+AbstractComputeShaderProgram::AbstractComputeShaderProgram() = default;
+
+AbstractComputeShaderProgram::AbstractComputeShaderProgram(AbstractComputeShaderProgram&& other) noexcept = default;
+
+AbstractComputeShaderProgram::~AbstractComputeShaderProgram() = default;
+
+AbstractComputeShaderProgram& AbstractComputeShaderProgram::operator=(AbstractComputeShaderProgram&& other) noexcept = default;
+
+Vector3ui AbstractComputeShaderProgram::workGroupSize() {
+    if(_workGroupSize.isZero()) {
+        Vector3i size;
+        glGetProgramiv(id(), GL_COMPUTE_WORK_GROUP_SIZE, size.data());
+        _workGroupSize = Vector3ui{size};
+    }
+
+    return _workGroupSize;
+}
+
+AbstractComputeShaderProgram& AbstractComputeShaderProgram::dispatchComputeInvocations(const Vector3ui& invocationCount) {
+    dispatchCompute(workGroupCount(invocationCount, workGroupSize()));
+    return *this;
+}
+
+}
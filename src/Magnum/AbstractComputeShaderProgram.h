@@ -0,0 +1,163 @@
+#ifndef Magnum_AbstractComputeShaderProgram_h
+#define Magnum_AbstractComputeShaderProgram_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::AbstractComputeShaderProgram
+ */
+#endif
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Vector3.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Base for compute shader program implementations
+
+Compared to @ref AbstractShaderProgram it knows about the local workgroup size
+declared in the compute shader and is thus able to dispatch the compute for
+given count of invocations instead of count of workgroups. See
+@ref AbstractShaderProgram-compute-workflow for general information.
+
+## Subclassing workflow
+
+The subclass attaches and links just the @ref Shader::Type::Compute shader and
+provides functions for setting uniforms and binding the resources. Shader
+storage buffers, uniform buffers and atomic counter buffers are bound to
+indexed binding points using @ref Buffer::bind(), images using
+@ref AbstractTexture::bindImages() or the `bindImage()` family of functions of
+particular texture types. It's recommended to expose the binding points as an
+enum, similarly to attribute locations:
+@code
+class ParticleUpdate: public AbstractComputeShaderProgram {
+    public:
+        enum: UnsignedInt { ParticleBufferBinding = 0 };
+
+        explicit ParticleUpdate() {
+            Shader comp{Version::GL430, Shader::Type::Compute};
+            comp.addFile("ParticleUpdate.comp");
+            CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+            attachShader(comp);
+            CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        }
+
+        ParticleUpdate& bindParticleBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, ParticleBufferBinding);
+            return *this;
+        }
+};
+@endcode
+
+## Dispatch workflow
+
+Bind the resources, dispatch the compute for the whole data set using
+@ref dispatchComputeInvocations() and then put a memory barrier using
+@ref Renderer::setMemoryBarrier() before the results are consumed. The barrier
+bits describe how the data are going to be *read* afterwards, not how they
+were written:
+@code
+ParticleUpdate update;
+update.bindParticleBuffer(particles)
+    .dispatchComputeInvocations({particleCount, 1, 1});
+
+Renderer::setMemoryBarrier(Renderer::MemoryBarrier::VertexAttributeArray);
+mesh.draw(shader);
+@endcode
+
+If the workgroup count is computed on the GPU, use
+@ref dispatchComputeIndirect() instead and put
+@ref Renderer::MemoryBarrier::Command barrier between the dispatch writing
+the count and the indirect dispatch.
+
+@requires_gl43 Extension @extension{ARB,compute_shader}
+@requires_gles31 Compute shaders are not available in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_EXPORT AbstractComputeShaderProgram: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Workgroup count needed for given invocation count
+         *
+         * Divides @p invocationCount by @p workGroupSize in each dimension,
+         * rounding up. The shader is then expected to discard invocations
+         * outside of the original range.
+         */
+        static Vector3ui workGroupCount(const Vector3ui& invocationCount, const Vector3ui& workGroupSize);
+
+        /**
+         * @brief Constructor
+         *
+         * Creates one OpenGL shader program.
+         * @see @fn_gl{CreateProgram}
+         */
+        explicit AbstractComputeShaderProgram();
+
+        /** @brief Move constructor */
+        AbstractComputeShaderProgram(AbstractComputeShaderProgram&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated OpenGL shader program.
+         * @see @fn_gl{DeleteProgram}
+         */
+        virtual ~AbstractComputeShaderProgram() = 0;
+
+        /** @brief Move assignment */
+        AbstractComputeShaderProgram& operator=(AbstractComputeShaderProgram&& other) noexcept;
+
+        /**
+         * @brief Local workgroup size
+         *
+         * The size declared with `layout(local_size_x = ...)` in the compute
+         * shader. The program is expected to be successfully linked. The
+         * value is queried only once and then cached.
+         * @see @fn_gl{GetProgram} with @def_gl{COMPUTE_WORK_GROUP_SIZE}
+         */
+        Vector3ui workGroupSize();
+
+        /**
+         * @brief Dispatch compute for given invocation count
+         *
+         * Equivalent to calling @ref dispatchCompute() with
+         * @ref workGroupCount(const Vector3ui&, const Vector3ui&) "workGroupCount(invocationCount, workGroupSize())".
+         * @see @fn_gl{DispatchCompute}
+         */
+        AbstractComputeShaderProgram& dispatchComputeInvocations(const Vector3ui& invocationCount);
+
+    private:
+        Vector3ui _workGroupSize;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -45,6 +45,8 @@
 
 #include "Implementation/FramebufferState.h"
 #include "Implementation/State.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 namespace Magnum {
 
@@ -136,6 +138,8 @@ void AbstractFramebuffer::bindImplementationSingle(FramebufferTarget) {
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(framebufferBinds);
+    MAGNUM_CAPTURE(bindFramebuffer(GL_FRAMEBUFFER, _id));
     glBindFramebuffer(GL_FRAMEBUFFER, _id);
 }
 #endif
@@ -156,6 +160,8 @@ void AbstractFramebuffer::bindImplementationDefault(FramebufferTarget target) {
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(framebufferBinds);
+    MAGNUM_CAPTURE(bindFramebuffer(GLenum(target), _id));
     glBindFramebuffer(GLenum(target), _id);
 }
 
@@ -180,6 +186,8 @@ FramebufferTarget AbstractFramebuffer::bindImplementationSingle() {
 
         /* Binding the framebuffer finally creates it */
         _flags |= ObjectFlag::Created;
+        MAGNUM_STATISTICS_INCREMENT(framebufferBinds);
+        MAGNUM_CAPTURE(bindFramebuffer(GL_FRAMEBUFFER, _id));
         glBindFramebuffer(GL_FRAMEBUFFER, _id);
     }
 
@@ -204,6 +212,8 @@ FramebufferTarget AbstractFramebuffer::bindImplementationDefault() {
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(framebufferBinds);
+    MAGNUM_CAPTURE(bindFramebuffer(GLenum(FramebufferTarget::Read), _id));
     glBindFramebuffer(GLenum(FramebufferTarget::Read), _id);
     return FramebufferTarget::Read;
 }
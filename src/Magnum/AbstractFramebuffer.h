@@ -319,6 +319,10 @@ class MAGNUM_EXPORT AbstractFramebuffer {
          *
          * If @extension{ARB,robustness} is available, the operation is
          * protected from buffer overflow.
+         *
+         * OpenGL ES guarantees only @ref PixelFormat::RGBA with
+         * @ref PixelType::UnsignedByte to be readable, read the data in that
+         * format and use @ref convertPixels() to get any other layout.
          * @see @fn_gl{BindFramebuffer}, then @fn_gl{PixelStore} and
          *      @fn_gl{ReadPixels} or @fn_gl_extension{ReadnPixels,ARB,robustness}
          */
@@ -169,6 +169,20 @@ template<class T> class AbstractResourceLoader {
             set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
         }
 
+        /**
+         * @brief Set loaded resource with memory cost to resource manager
+         *
+         * Same as above, additionally specifying memory cost of the resource.
+         * See @ref ResourceManager::set(ResourceKey, T*, ResourceDataState, ResourcePolicy, std::size_t)
+         * for more information.
+         */
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t cost);
+
+        /** @overload */
+        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t cost) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, cost);
+        }
+
         /**
          * @brief Set loaded resource to resource manager
          *
@@ -234,10 +248,14 @@ template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
 }
 
 template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+    set(key, data, state, policy, 0);
+}
+
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t cost) {
     CORRADE_ASSERT(state == ResourceDataState::Mutable || state == ResourceDataState::Final,
         "AbstractResourceLoader::set(): state must be either Mutable or Final", );
     ++_loadedCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, cost);
 }
 
 template<class T> inline void AbstractResourceLoader<T>::setNotFound(ResourceKey key) {
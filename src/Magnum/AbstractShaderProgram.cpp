@@ -25,10 +25,13 @@
 
 #include "AbstractShaderProgram.h"
 
+#include <cstring>
 #include <Corrade/Containers/Array.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/ProgramBinaryCache.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Math/RectangularMatrix.h"
 
@@ -37,6 +40,8 @@
 #endif
 #include "Implementation/ShaderProgramState.h"
 #include "Implementation/State.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 #if defined(CORRADE_TARGET_NACL_NEWLIB) || defined(CORRADE_TARGET_ANDROID)
 #include <sstream>
@@ -277,7 +282,7 @@ AbstractShaderProgram::AbstractShaderProgram(): _id(glCreateProgram()) {
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
 }
 
-AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id) {
+AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id), _uniformCache{std::move(other._uniformCache)} {
     other._id = 0;
 }
 
@@ -292,6 +297,7 @@ AbstractShaderProgram::~AbstractShaderProgram() {
 AbstractShaderProgram& AbstractShaderProgram::operator=(AbstractShaderProgram&& other) noexcept {
     using std::swap;
     swap(_id, other._id);
+    swap(_uniformCache, other._uniformCache);
     return *this;
 }
 
@@ -332,17 +338,84 @@ std::pair<bool, std::string> AbstractShaderProgram::validate() {
     return {success, std::move(message)};
 }
 
+bool AbstractShaderProgram::isLinkFinished() {
+    #if !defined(MAGNUM_TARGET_WEBGL) && !defined(CORRADE_TARGET_NACL)
+    if(Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>()) {
+        GLint finished;
+        glGetProgramiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+        return finished == GL_TRUE;
+    }
+    #endif
+
+    /* Status query in checkLink() will block until the linking is done */
+    return true;
+}
+
+AbstractShaderProgram& AbstractShaderProgram::setUniformCacheEnabled(const bool enabled) {
+    if(!enabled) _uniformCache = nullptr;
+    else if(!_uniformCache) _uniformCache.reset(new Implementation::ShaderProgramUniformCache{Context::current().state().shaderProgram->uniformCacheGeneration});
+    return *this;
+}
+
+UnsignedLong AbstractShaderProgram::skippedUniformUploadCount() const {
+    return _uniformCache ? _uniformCache->skippedCount : 0;
+}
+
+UnsignedLong AbstractShaderProgram::issuedUniformUploadCount() const {
+    return _uniformCache ? _uniformCache->issuedCount : 0;
+}
+
+bool AbstractShaderProgram::updateUniformCache(const GLint location, const void* const data, const std::size_t size) {
+    /* Setting nonexistent uniform is a no-op, nothing to cache */
+    if(location == -1) return true;
+
+    /* The values might have been changed externally since last state reset */
+    Implementation::ShaderProgramUniformCache& cache = *_uniformCache;
+    const UnsignedInt generation = Context::current().state().shaderProgram->uniformCacheGeneration;
+    if(cache.generation != generation) {
+        cache.values.clear();
+        cache.generation = generation;
+    }
+
+    std::vector<char>& value = cache.values[location];
+    if(value.size() == size && std::memcmp(value.data(), data, size) == 0) {
+        ++cache.skippedCount;
+        return false;
+    }
+
+    const char* const begin = static_cast<const char*>(data);
+    value.assign(begin, begin + size);
+    ++cache.issuedCount;
+    return true;
+}
+
+void AbstractShaderProgram::invalidateUniformCache() {
+    if(_uniformCache) _uniformCache->values.clear();
+}
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractShaderProgram::dispatchCompute(const Vector3ui& workgroupCount) {
     use();
     glDispatchCompute(workgroupCount.x(), workgroupCount.y(), workgroupCount.z());
 }
+
+void AbstractShaderProgram::dispatchComputeIndirect(Buffer& buffer, const GLintptr offset) {
+    CORRADE_ASSERT(offset % 4 == 0,
+        "AbstractShaderProgram::dispatchComputeIndirect(): offset" << offset << "is not a multiple of 4", );
+    use();
+    buffer.bindInternal(Buffer::TargetHint::DispatchIndirect);
+    glDispatchComputeIndirect(offset);
+}
 #endif
 
 void AbstractShaderProgram::use() {
     /* Use only if the program isn't already in use */
     GLuint& current = Context::current().state().shaderProgram->current;
-    if(current != _id) glUseProgram(current = _id);
+    if(current == _id) return;
+
+    MAGNUM_STATISTICS_INCREMENT(shaderSwitches);
+    MAGNUM_CAPTURE(useProgram(_id));
+    glUseProgram(current = _id);
 }
 
 void AbstractShaderProgram::attachShader(Shader& shader) {
@@ -378,11 +451,79 @@ void AbstractShaderProgram::setTransformFeedbackOutputs(const std::initializer_l
 }
 #endif
 
+bool AbstractShaderProgram::loadCachedBinary(std::initializer_list<std::reference_wrapper<const Shader>> shaders) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!ProgramBinaryCache::hasCurrent()) return false;
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>()) return false;
+    #endif
+
+    ProgramBinaryCache& cache = ProgramBinaryCache::current();
+    const std::string key = cache.key(shaders);
+    const std::pair<GLenum, Containers::Array<char>> binary = cache.find(key);
+    if(binary.second) {
+        invalidateUniformCache();
+        glProgramBinary(_id, binary.first, binary.second, binary.second.size());
+
+        GLint success;
+        glGetProgramiv(_id, GL_LINK_STATUS, &success);
+        if(success) {
+            ++cache._hitCount;
+            return true;
+        }
+
+        /* The binary is corrupted or incompatible, it'll get replaced */
+        cache.remove(key);
+    }
+
+    ++cache._missCount;
+    setRetrievableBinary(true);
+    #else
+    static_cast<void>(shaders);
+    #endif
+    return false;
+}
+
+void AbstractShaderProgram::saveCachedBinary(std::initializer_list<std::reference_wrapper<const Shader>> shaders) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!ProgramBinaryCache::hasCurrent()) return;
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>()) return;
+    #endif
+
+    /* Some drivers don't support any binary formats */
+    GLint size;
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if(!size) return;
+
+    GLenum format;
+    Containers::Array<char> binary{std::size_t(size)};
+    glGetProgramBinary(_id, size, nullptr, &format, binary);
+
+    ProgramBinaryCache& cache = ProgramBinaryCache::current();
+    if(!cache.insert(cache.key(shaders), format, binary))
+        Warning() << "AbstractShaderProgram::saveCachedBinary(): can't save the binary to" << cache.directory();
+    #else
+    static_cast<void>(shaders);
+    #endif
+}
+
 bool AbstractShaderProgram::link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
-    bool allSuccess = true;
+    submitLink(shaders);
+    return checkLink(shaders);
+}
 
+void AbstractShaderProgram::submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
     /* Invoke (possibly parallel) linking on all shaders */
-    for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+    for(AbstractShaderProgram& shader: shaders) {
+        /* Linking resets all uniforms to their defaults */
+        shader.invalidateUniformCache();
+        glLinkProgram(shader._id);
+    }
+}
+
+bool AbstractShaderProgram::checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
+    bool allSuccess = true;
 
     /* After linking phase, check status of all shaders */
     Int i = 1;
@@ -456,7 +597,9 @@ UnsignedInt AbstractShaderProgram::uniformBlockIndexInternal(const Containers::A
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Float> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform1fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLfloat* const values) {
@@ -484,7 +627,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location,  const Containers::ArrayView<const Math::Vector<2, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform2fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_VEC2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLfloat>* const values) {
@@ -512,7 +657,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform3fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_VEC3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLfloat>* const values) {
@@ -540,7 +687,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform4fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_VEC4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLfloat>* const values) {
@@ -568,7 +717,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Int> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform1ivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_INT, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLint* values) {
@@ -596,7 +747,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, Int>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform2ivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_INT_VEC2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLint>* const values) {
@@ -624,7 +777,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Int>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform3ivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_INT_VEC3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLint>* const values) {
@@ -652,7 +807,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Int>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform4ivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_INT_VEC4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLint>* const values) {
@@ -681,7 +838,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const UnsignedInt> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform1uivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_UNSIGNED_INT, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLuint* const values) {
@@ -700,7 +859,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, UnsignedInt>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform2uivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_UNSIGNED_INT_VEC2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLuint>* const values) {
@@ -719,7 +880,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, UnsignedInt>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform3uivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_UNSIGNED_INT_VEC3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLuint>* const values) {
@@ -738,7 +901,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, UnsignedInt>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform4uivImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_UNSIGNED_INT_VEC4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLuint>* const values) {
@@ -759,7 +924,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 
 #ifndef MAGNUM_TARGET_GLES
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Double> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform1dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLdouble* const values) {
@@ -776,7 +943,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform2dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_VEC2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLdouble>* const values) {
@@ -793,7 +962,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform3dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_VEC3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLdouble>* const values) {
@@ -810,7 +981,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniform4dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_VEC4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLdouble>* const values) {
@@ -828,7 +1001,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 2, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 2, GLfloat>* const values) {
@@ -856,7 +1031,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 3, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 3, GLfloat>* const values) {
@@ -884,7 +1061,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 4, GLfloat>* const values) {
@@ -913,7 +1092,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 3, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2x3fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT2x3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 3, GLfloat>* const values) {
@@ -932,7 +1113,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 2, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3x2fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT3x2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 2, GLfloat>* const values) {
@@ -951,7 +1134,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 4, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2x4fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT2x4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 4, GLfloat>* const values) {
@@ -970,7 +1155,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 2, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4x2fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT4x2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 2, GLfloat>* const values) {
@@ -989,7 +1176,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 4, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3x4fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT3x4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 4, GLfloat>* const values) {
@@ -1008,7 +1197,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 3, Float>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4x3fvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_FLOAT_MAT4x3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 3, GLfloat>* const values) {
@@ -1029,7 +1220,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT_SSOEXT(const GLint locat
 
 #ifndef MAGNUM_TARGET_GLES
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 2, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 2, GLdouble>* const values) {
@@ -1046,7 +1239,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 3, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 3, GLdouble>* const values) {
@@ -1063,7 +1258,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 4, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 4, GLdouble>* const values) {
@@ -1080,7 +1277,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 3, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2x3dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT2x3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 3, GLdouble>* const values) {
@@ -1097,7 +1296,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 2, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3x2dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT3x2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 2, GLdouble>* const values) {
@@ -1114,7 +1315,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 4, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix2x4dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT2x4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 4, GLdouble>* const values) {
@@ -1131,7 +1334,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 2, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4x2dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT4x2, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 2, GLdouble>* const values) {
@@ -1148,7 +1353,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 4, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix3x4dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT3x4, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 4, GLdouble>* const values) {
@@ -1165,7 +1372,9 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 3, Double>> values) {
+    if(_uniformCache && !updateUniformCache(location, values.data(), values.size()*sizeof(values[0]))) return;
     (this->*Context::current().state().shaderProgram->uniformMatrix4x3dvImplementation)(location, values.size(), values);
+    MAGNUM_CAPTURE(uniform(_id, location, GL_DOUBLE_MAT4x3, values.size(), values));
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 3, GLdouble>* const values) {
@@ -1180,6 +1389,11 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 3, GLdouble>* const values) {
     glProgramUniformMatrix4x3dvEXT(_id, location, count, GL_FALSE, values[0].data());
 }
+
+void AbstractShaderProgram::setUniformHandle(const Int location, const Containers::ArrayView<const UnsignedLong> handles) {
+    if(_uniformCache && !updateUniformCache(location, handles.data(), handles.size()*sizeof(handles[0]))) return;
+    glProgramUniformHandleui64vARB(_id, location, handles.size(), handles);
+}
 #endif
 
 }
@@ -30,6 +30,7 @@
  */
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <Corrade/Containers/ArrayView.h>
 
@@ -38,7 +39,10 @@
 
 namespace Magnum {
 
-namespace Implementation { struct ShaderProgramState; }
+namespace Implementation {
+    struct ShaderProgramState;
+    struct ShaderProgramUniformCache;
+}
 
 /**
 @brief Base for shader program implementations
@@ -418,7 +422,10 @@ mesh.draw(shader);
 
 Add just the @ref Shader::Type::Compute shader and implement uniform/texture
 setting functions as needed. After setting up required parameters call
-@ref dispatchCompute().
+@ref dispatchCompute() or @ref dispatchComputeIndirect(). See
+@ref AbstractComputeShaderProgram for a base class with convenience
+functions for computing the workgroup count from the local workgroup size
+declared in the shader.
 
 @anchor AbstractShaderProgram-types
 ## Mapping between GLSL and Magnum types
@@ -453,6 +460,93 @@ also @ref Attribute::DataType enum for additional type options.
     @ref Matrix2x4, @ref Matrix4x2, @ref Matrix3x4 and @ref Matrix4x3) are not
     available in WebGL 1.0.
 
+@anchor AbstractShaderProgram-async
+## Asynchronous compilation and linking
+
+By default @ref Shader::compile() and @ref link() wait for the result, which
+can take hundreds of milliseconds when creating many programs at once. The
+submission and status check can be done separately with
+@ref Shader::submitCompile(), @ref submitLink() and
+@ref Shader::checkCompile(), @ref checkLink(). If
+@extension{KHR,parallel_shader_compile} is available, the driver compiles
+and links in the background and @ref isLinkFinished() can be polled each
+frame to check the status without blocking, spreading the work over multiple
+frames:
+
+@code
+Shader::submitCompile({vert, frag});
+attachShaders({vert, frag});
+submitLink({*this});
+
+// ... some frames later
+
+if(isLinkFinished()) {
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::checkCompile({vert, frag}) && checkLink({*this}));
+    // query uniform locations, ...
+}
+@endcode
+
+If the extension is not available, @ref isLinkFinished() always returns
+`true` and the work is postponed to checking the status instead. The builtin
+@ref Shaders::Phong shader provides @ref Shaders::Phong::compile() for this.
+
+@anchor AbstractShaderProgram-binary-cache
+## Program binary cache
+
+If a @ref ProgramBinaryCache is current, the program can be loaded from a
+binary saved in previous runs instead of compiling and linking the shaders.
+Create the shaders with all their sources first, then try to load the binary
+with @ref loadCachedBinary() and go through the usual compilation workflow and
+save the result with @ref saveCachedBinary() only if that fails. Note that
+setting uniforms and uniform block bindings is needed in both cases:
+
+@code
+MyShader() {
+    Shader vert(Version::GL430, Shader::Type::Vertex);
+    Shader frag(Version::GL430, Shader::Type::Fragment);
+    vert.addFile("MyShader.vert");
+    frag.addFile("MyShader.frag");
+
+    if(!loadCachedBinary({vert, frag})) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+        attachShaders({vert, frag});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({vert, frag});
+    }
+
+    // ...
+}
+@endcode
+
+All builtin shaders in the @ref Shaders namespace use the cache this way.
+
+@anchor AbstractShaderProgram-uniform-cache
+## Uniform cache
+
+Each @ref setUniform() call results in an OpenGL call, even if the program
+already has the same value set. Applications setting the same value for each
+drawn object can enable a shadow copy of uniform values using
+@ref setUniformCacheEnabled(), which then skips the uploads that wouldn't
+change anything:
+
+@code
+MyShader shader;
+shader.setUniformCacheEnabled(true);
+
+// ... draw all objects
+
+Debug() << shader.skippedUniformUploadCount() << "of"
+        << shader.skippedUniformUploadCount() + shader.issuedUniformUploadCount()
+        << "uniform uploads skipped";
+@endcode
+
+The values are compared byte-wise and cached per uniform location, so an
+array uniform should be always set through the location of its first element.
+The cache is cleared on relinking and on
+@ref Context::resetState() "Context::resetState(Context::State::Shaders)",
+so it's safe to modify the uniforms using raw OpenGL calls if the state is
+reset afterwards.
+
 @anchor AbstractShaderProgram-performance-optimization
 ## Performance optimizations
 
@@ -763,6 +857,60 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         std::pair<bool, std::string> validate();
 
+        /**
+         * @brief Whether linking finished
+         *
+         * If @extension{KHR,parallel_shader_compile} is available, queries
+         * the completion status without blocking. Otherwise always returns
+         * `true` and the status check in @ref checkLink() blocks until the
+         * linking is done. See @ref AbstractShaderProgram-async "class documentation"
+         * for more information.
+         * @see @ref submitLink(), @fn_gl{GetProgram} with
+         *      @def_gl{COMPLETION_STATUS_KHR}
+         */
+        bool isLinkFinished();
+
+        /**
+         * @brief Whether uniform cache is enabled
+         *
+         * @see @ref setUniformCacheEnabled()
+         */
+        bool isUniformCacheEnabled() const { return !!_uniformCache; }
+
+        /**
+         * @brief Enable or disable uniform cache
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref setUniform() doesn't issue any OpenGL call if the
+         * uniform already has the same value. Disabling discards the cached
+         * values and resets the counters. Default is disabled. See
+         * @ref AbstractShaderProgram-uniform-cache "class documentation" for
+         * more information.
+         * @see @ref skippedUniformUploadCount(),
+         *      @ref issuedUniformUploadCount()
+         */
+        AbstractShaderProgram& setUniformCacheEnabled(bool enabled);
+
+        /**
+         * @brief Count of skipped uniform uploads
+         *
+         * Count of @ref setUniform() calls that were skipped because the
+         * uniform already had the same value. Always `0` if the uniform cache
+         * is not enabled.
+         * @see @ref setUniformCacheEnabled()
+         */
+        UnsignedLong skippedUniformUploadCount() const;
+
+        /**
+         * @brief Count of issued uniform uploads
+         *
+         * Count of @ref setUniform() calls that resulted in an OpenGL call
+         * since the uniform cache was enabled. Always `0` if the uniform
+         * cache is not enabled.
+         * @see @ref setUniformCacheEnabled()
+         */
+        UnsignedLong issuedUniformUploadCount() const;
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Dispatch compute
@@ -776,6 +924,27 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          * @requires_gles Compute shaders are not available in WebGL.
          */
         void dispatchCompute(const Vector3ui& workgroupCount);
+
+        /**
+         * @brief Dispatch compute with workgroup count taken from a buffer
+         * @param buffer    Buffer with the workgroup count
+         * @param offset    Offset of the workgroup count in the buffer
+         *
+         * Like @ref dispatchCompute(), but the workgroup count is read from
+         * three @ref Magnum::UnsignedInt "UnsignedInt" values at @p offset in
+         * @p buffer, which can be written by a previous compute dispatch
+         * without a round trip to the CPU. The @p offset is expected to be a
+         * multiple of `4`. Don't forget to put
+         * @ref Renderer::MemoryBarrier::Command between the dispatch writing
+         * the buffer and this call.
+         * @see @ref Buffer::TargetHint::DispatchIndirect,
+         *      @fn_gl{BindBuffer}, @fn_gl{DispatchComputeIndirect}
+         * @requires_gl43 Extension @extension{ARB,compute_shader}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
+         *      and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        void dispatchComputeIndirect(Buffer& buffer, GLintptr offset = 0);
         #endif
 
         #ifdef MAGNUM_BUILD_DEPRECATED
@@ -802,6 +971,32 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         static bool link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
 
+        /**
+         * @brief Submit multiple shaders for linking
+         *
+         * Starts linking of all @p shaders without waiting for the result.
+         * The attached shaders don't need to have finished compiling yet.
+         * Use @ref isLinkFinished() to check whether the linking finished
+         * and @ref checkLink() to retrieve the result. See
+         * @ref AbstractShaderProgram-async "class documentation" for an
+         * example.
+         * @see @ref link(), @ref Shader::submitCompile(), @fn_gl{LinkProgram}
+         */
+        static void submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
+        /**
+         * @brief Check link status of multiple shaders
+         *
+         * Expects that the shaders were submitted with @ref submitLink().
+         * Returns `false` if linking of any shader failed, `true` if
+         * everything succeeded. Linker message (if any) is printed to error
+         * output. Blocks until the linking finishes.
+         * @see @ref isLinkFinished(), @fn_gl{GetProgram} with
+         *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl{GetProgramInfoLog}
+         */
+        static bool checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Allow retrieving program binary
@@ -818,6 +1013,41 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         }
         #endif
 
+        /**
+         * @brief Load program binary from the cache
+         * @param shaders   Shaders the program would be linked from
+         *
+         * If there is a current @ref ProgramBinaryCache and it contains a
+         * binary for given shaders that the driver accepted, returns `true`.
+         * The program is then linked and the shaders don't need to be
+         * compiled, attached or linked at all. Otherwise returns `false`
+         * and, if there is a current cache, enables
+         * @ref setRetrievableBinary() so the program can be saved with
+         * @ref saveCachedBinary() after linking. Always returns `false` if
+         * @extension{ARB,get_program_binary} isn't available, in WebGL and
+         * in OpenGL ES 2.0. See
+         * @ref AbstractShaderProgram-binary-cache "class documentation" for
+         * an example.
+         * @see @ref ProgramBinaryCache::hitCount(),
+         *      @ref ProgramBinaryCache::missCount(), @fn_gl{ProgramBinary},
+         *      @fn_gl{GetProgram} with @def_gl{LINK_STATUS}
+         */
+        bool loadCachedBinary(std::initializer_list<std::reference_wrapper<const Shader>> shaders);
+
+        /**
+         * @brief Save program binary to the cache
+         * @param shaders   Shaders the program was linked from
+         *
+         * Expects that the program is linked. If there is a current
+         * @ref ProgramBinaryCache, saves the program binary into it under key
+         * computed from given shaders. Does nothing if
+         * @extension{ARB,get_program_binary} isn't available, in WebGL and
+         * in OpenGL ES 2.0.
+         * @see @ref loadCachedBinary(), @fn_gl{GetProgram} with
+         *      @def_gl{PROGRAM_BINARY_LENGTH}, @fn_gl{GetProgramBinary}
+         */
+        void saveCachedBinary(std::initializer_list<std::reference_wrapper<const Shader>> shaders);
+
         #ifndef MAGNUM_TARGET_WEBGL
         /**
          * @brief Allow the program to be bound to individual pipeline stages
@@ -1146,6 +1376,37 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         void setUniform(Int location, Containers::ArrayView<const Math::RectangularMatrix<4, 3, Double>> values); /**< @overload */
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set bindless texture handle uniform
+         * @param location      Uniform location
+         * @param handle        Texture handle
+         *
+         * Convenience alternative for setting one value, see
+         * @ref setUniformHandle(Int, Containers::ArrayView<const UnsignedLong>)
+         * for more information.
+         */
+        void setUniformHandle(Int location, UnsignedLong handle) {
+            setUniformHandle(location, {&handle, 1});
+        }
+
+        /**
+         * @brief Set bindless texture handle uniforms
+         * @param location      Uniform location
+         * @param handles       Texture handles
+         *
+         * Sets sampler uniforms to textures referenced by handles returned
+         * from @ref AbstractTexture::handle() instead of texture units. The
+         * program doesn't need to be in use for this operation.
+         * @see @ref uniformLocation(),
+         *      @fn_gl_extension{ProgramUniformHandle,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        void setUniformHandle(Int location, Containers::ArrayView<const UnsignedLong> handles);
+        #endif
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /**
          * @brief Set uniform values
@@ -1189,6 +1450,9 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         Int uniformLocationInternal(Containers::ArrayView<const char> name);
         UnsignedInt uniformBlockIndexInternal(Containers::ArrayView<const char> name);
 
+        bool MAGNUM_LOCAL updateUniformCache(GLint location, const void* data, std::size_t size);
+        void MAGNUM_LOCAL invalidateUniformCache();
+
         #ifndef MAGNUM_BUILD_DEPRECATED
         void use();
         #endif
@@ -1347,6 +1611,7 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         #endif
 
         GLuint _id;
+        std::unique_ptr<Implementation::ShaderProgramUniformCache> _uniformCache;
 };
 
 }
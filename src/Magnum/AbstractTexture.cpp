@@ -36,17 +36,40 @@
 #include "Magnum/Image.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/TextureFormat.h"
+#include "Magnum/Tracing.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
+#include "Implementation/MemoryState.h"
 #include "Implementation/State.h"
 #include "Implementation/TextureState.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 namespace Magnum {
 
+namespace {
+    /* Images are distinguished also by target to handle cube map faces */
+    inline void trackImage(const GLuint id, const GLenum target, const GLint level, const std::size_t size) {
+        Implementation::MemoryState& memory = *Context::current().state().memory;
+        if(memory.enabled)
+            memory.setImageSize(Context::MemoryObject::Texture, id, UnsignedLong(target) << 32 | UnsignedInt(level), size);
+    }
+
+    inline void trackImage(const GLuint id, const GLenum target, const GLint level, const TextureFormat internalFormat, const Vector3i& size) {
+        trackImage(id, target, level, Implementation::MemoryState::textureStorageSize(target, GLenum(internalFormat), 1, size));
+    }
+
+    inline void trackStorage(const GLuint id, const GLenum target, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size, const GLsizei samples = 1) {
+        Implementation::MemoryState& memory = *Context::current().state().memory;
+        if(memory.enabled)
+            memory.setStorageSize(Context::MemoryObject::Texture, id, Implementation::MemoryState::textureStorageSize(target, GLenum(internalFormat), levels, size)*std::size_t(samples));
+    }
+}
+
 #ifndef MAGNUM_TARGET_GLES2
 Float AbstractTexture::maxLodBias() {
     GLfloat& value = Context::current().state().texture->maxLodBias;
@@ -119,6 +142,8 @@ void AbstractTexture::unbind(const Int textureUnit) {
     if(textureState.bindings[textureUnit].second == 0) return;
 
     /* Unbind the texture, reset state tracker */
+    MAGNUM_STATISTICS_INCREMENT(textureBinds);
+    MAGNUM_CAPTURE(bindTexture(textureUnit, 0));
     Context::current().state().texture->unbindImplementation(textureUnit);
     textureState.bindings[textureUnit] = {};
 }
@@ -189,6 +214,8 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
         if(textureState.bindings[firstTextureUnit + i].second != id) {
             different = true;
             textureState.bindings[firstTextureUnit + i].second = id;
+            MAGNUM_STATISTICS_INCREMENT(textureBinds);
+            MAGNUM_CAPTURE(bindTexture(firstTextureUnit + i, id));
         }
     }
 
@@ -215,8 +242,10 @@ Int AbstractTexture::compressedBlockDataSizeImplementationBitsWorkaround(const G
 #endif
 
 AbstractTexture::AbstractTexture(GLenum target): _target{target}, _flags{ObjectFlag::DeleteOnDestruction} {
-    (this->*Context::current().state().texture->createImplementation)();
+    Implementation::State& state = Context::current().state();
+    (this->*state.texture->createImplementation)();
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
+    state.memory->created(Context::MemoryObject::Texture, _id);
 }
 
 void AbstractTexture::createImplementationDefault() {
@@ -248,6 +277,7 @@ AbstractTexture::~AbstractTexture() {
     }
     #endif
 
+    Context::current().state().memory->destroyed(Context::MemoryObject::Texture, _id);
     glDeleteTextures(1, &_id);
 }
 
@@ -340,9 +370,31 @@ void AbstractTexture::bind(Int textureUnit) {
 
     /* Update state tracker, bind the texture to the unit */
     textureState.bindings[textureUnit] = {_target, _id};
+    MAGNUM_STATISTICS_INCREMENT(textureBinds);
+    MAGNUM_CAPTURE(bindTexture(textureUnit, _id));
     (this->*textureState.bindImplementation)(textureUnit);
 }
 
+#ifndef MAGNUM_TARGET_GLES
+UnsignedLong AbstractTexture::handle() {
+    createIfNotAlready();
+    return glGetTextureHandleARB(_id);
+}
+
+bool AbstractTexture::isResident() {
+    return glIsTextureHandleResidentARB(handle());
+}
+
+AbstractTexture& AbstractTexture::setResident(const bool resident) {
+    const GLuint64 handle = this->handle();
+    if(!!glIsTextureHandleResidentARB(handle) == resident) return *this;
+
+    if(resident) glMakeTextureHandleResidentARB(handle);
+    else glMakeTextureHandleNonResidentARB(handle);
+    return *this;
+}
+#endif
+
 void AbstractTexture::bindImplementationDefault(GLint textureUnit) {
     Implementation::TextureState& textureState = *Context::current().state().texture;
 
@@ -508,6 +560,79 @@ void AbstractTexture::generateMipmap() {
     (this->*Context::current().state().texture->mipmapImplementation)();
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Vector3i AbstractTexture::sparsePageSizeInternal(const GLenum target, const TextureFormat internalFormat) {
+    /* The format might not be usable for sparse textures at all */
+    GLint count{};
+    glGetInternalformativ(target, GLenum(internalFormat), GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &count);
+    if(!count) return {};
+
+    /* Implementations are required to list the preferred size first */
+    Vector3i size;
+    glGetInternalformativ(target, GLenum(internalFormat), GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &size.x());
+    glGetInternalformativ(target, GLenum(internalFormat), GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &size.y());
+    glGetInternalformativ(target, GLenum(internalFormat), GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &size.z());
+    return size;
+}
+
+template<UnsignedInt dimensions> void AbstractTexture::setSparseStorageInternal(const GLsizei levels, const TextureFormat internalFormat, const Math::Vector<dimensions, GLsizei>& size) {
+    /* The sparse flag needs to be set before the storage is allocated */
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+    DataHelper<dimensions>::setStorage(*this, levels, internalFormat, size);
+
+    /* No memory is committed after the allocation, the pages are accounted
+       for in commitPagesInternal() */
+    Implementation::MemoryState& memory = *Context::current().state().memory;
+    if(memory.enabled)
+        memory.setStorageSize(Context::MemoryObject::Texture, _id, 0);
+}
+
+template void MAGNUM_EXPORT AbstractTexture::setSparseStorageInternal<1>(GLsizei, TextureFormat, const Math::Vector<1, GLsizei>&);
+template void MAGNUM_EXPORT AbstractTexture::setSparseStorageInternal<2>(GLsizei, TextureFormat, const Math::Vector<2, GLsizei>&);
+template void MAGNUM_EXPORT AbstractTexture::setSparseStorageInternal<3>(GLsizei, TextureFormat, const Math::Vector<3, GLsizei>&);
+
+Int AbstractTexture::sparseLevelCountInternal() {
+    bindInternal();
+    GLint value{};
+    glGetTexParameteriv(_target, GL_NUM_SPARSE_LEVELS_ARB, &value);
+    return value;
+}
+
+void AbstractTexture::commitPagesInternal(const GLint level, const Vector3i& offset, const Vector3i& size, const bool commit) {
+    (this->*Context::current().state().texture->pageCommitmentImplementation)(level, offset, size, commit);
+
+    /* Committed regions are tracked as separate images, keyed by level and
+       offset. The top bit distinguishes them from regular images. Decommit
+       has to be done with the same region as commit to be accounted
+       properly. */
+    Implementation::MemoryState& memory = *Context::current().state().memory;
+    if(!memory.enabled) return;
+
+    std::size_t byteSize = 0;
+    if(commit) {
+        GLint format{};
+        (this->*Context::current().state().texture->getLevelParameterivImplementation)(level, GL_TEXTURE_INTERNAL_FORMAT, &format);
+        byteSize = Implementation::MemoryState::textureStorageSize(_target, GLenum(format), 1, size);
+    }
+    memory.setImageSize(Context::MemoryObject::Texture, _id,
+        1ull << 63 |
+        UnsignedLong(level & 0x7fff) << 48 |
+        UnsignedLong(offset.z() & 0xffff) << 32 |
+        UnsignedLong(offset.y() & 0xffff) << 16 |
+        UnsignedLong(offset.x() & 0xffff), byteSize);
+}
+
+void AbstractTexture::pageCommitmentImplementationDefault(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    bindInternal();
+    glTexPageCommitmentARB(_target, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
+
+void AbstractTexture::pageCommitmentImplementationDSAEXT(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    _flags |= ObjectFlag::Created;
+    glTexturePageCommitmentEXT(_id, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
+#endif
+
 void AbstractTexture::mipmapImplementationDefault() {
     bindInternal();
     glGenerateMipmap(_target);
@@ -547,6 +672,7 @@ void AbstractTexture::bindInternal() {
 
     /* Binding the texture finally creates it */
     _flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(textureBinds);
     glBindTexture(_target, _id);
 }
 
@@ -1815,26 +1941,32 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture->storage1DImplementation)(levels, internalFormat, size);
+    trackStorage(texture._id, texture._target, levels, internalFormat, {size[0], 1, 1});
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture->storage2DImplementation)(levels, internalFormat, size);
+    MAGNUM_CAPTURE(textureStorage(texture._id, texture._target, levels, GLenum(internalFormat), {size, 1}));
+    trackStorage(texture._id, texture._target, levels, internalFormat, {size, 1});
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture->storage3DImplementation)(levels, internalFormat, size);
+    trackStorage(texture._id, texture._target, levels, internalFormat, size);
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    trackStorage(texture._id, texture._target, 1, internalFormat, {size, 1}, samples);
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    trackStorage(texture._id, texture._target, 1, internalFormat, size, samples);
 }
 #endif
 
@@ -1844,6 +1976,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), image.data());
+    trackImage(texture._id, texture._target, level, internalFormat, {image.size()[0], 1, 1});
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView1D& image) {
@@ -1851,6 +1984,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    trackImage(texture._id, texture._target, level, image.data().size());
 }
 
 void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, BufferImage1D& image) {
@@ -1858,6 +1992,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    trackImage(texture._id, texture._target, level, internalFormat, {image.size()[0], 1, 1});
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage1D& image) {
@@ -1865,9 +2000,12 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    trackImage(texture._id, texture._target, level, image.dataSize());
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const ImageView1D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
     image.storage().applyUnpack();
     (texture.*Context::current().state().texture->subImage1DImplementation)(level, offset, image.size(), image.format(), image.type(), image.data());
@@ -1880,6 +2018,8 @@ void AbstractTexture::DataHelper<1>::setCompressedSubImage(AbstractTexture& text
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, BufferImage1D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     image.buffer().bindInternal(Buffer::TargetHint::PixelUnpack);
     image.storage().applyUnpack();
     (texture.*Context::current().state().texture->subImage1DImplementation)(level, offset, image.size(), image.format(), image.type(), nullptr);
@@ -1903,6 +2043,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         );
+    trackImage(texture._id, target, level, internalFormat, {image.size(), 1});
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, const CompressedImageView2D& image) {
@@ -1916,6 +2057,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    trackImage(texture._id, target, level, image.data().size());
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -1924,6 +2066,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage2D(target, level, GLint(internalFormat), image.size().x(), image.size().y(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    trackImage(texture._id, target, level, internalFormat, {image.size(), 1});
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, CompressedBufferImage2D& image) {
@@ -1935,10 +2078,13 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    trackImage(texture._id, target, level, image.dataSize());
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setSubImage(AbstractTexture& texture, const GLint level, const Vector2i& offset, const ImageView2D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     #ifndef MAGNUM_TARGET_GLES2
     Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
     #endif
@@ -1948,6 +2094,7 @@ void AbstractTexture::DataHelper<2>::setSubImage(AbstractTexture& texture, const
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         );
+    MAGNUM_CAPTURE(textureSubImage(texture._id, texture._target, level, {offset, 0}, {image.size(), 1}, GLenum(image.format()), GLenum(image.type()), image.storage().alignment(), image.data()));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedSubImage(AbstractTexture& texture, const GLint level, const Vector2i& offset, const CompressedImageView2D& image) {
@@ -1964,9 +2111,12 @@ void AbstractTexture::DataHelper<2>::setCompressedSubImage(AbstractTexture& text
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractTexture::DataHelper<2>::setSubImage(AbstractTexture& texture, const GLint level, const Vector2i& offset, BufferImage2D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     image.buffer().bindInternal(Buffer::TargetHint::PixelUnpack);
     image.storage().applyUnpack();
     (texture.*Context::current().state().texture->subImage2DImplementation)(level, offset, image.size(), image.format(), image.type(), nullptr);
+    MAGNUM_CAPTURE(textureSubImage(texture._id, texture._target, level, {offset, 0}, {image.size(), 1}, GLenum(image.format()), GLenum(image.type()), image.storage().alignment(), {nullptr, image.dataSize()}));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedSubImage(AbstractTexture& texture, const GLint level, const Vector2i& offset, CompressedBufferImage2D& image) {
@@ -1997,6 +2147,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     static_cast<void>(image);
     CORRADE_ASSERT_UNREACHABLE();
     #endif
+    trackImage(texture._id, texture._target, level, internalFormat, image.size());
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView3D& image) {
@@ -2018,6 +2169,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     static_cast<void>(image);
     CORRADE_ASSERT_UNREACHABLE();
     #endif
+    trackImage(texture._id, texture._target, level, image.data().size());
 }
 #endif
 
@@ -2027,6 +2179,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage3D(texture._target, level, GLint(internalFormat), image.size().x(), image.size().y(), image.size().z(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    trackImage(texture._id, texture._target, level, internalFormat, image.size());
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage3D& image) {
@@ -2038,11 +2191,14 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    trackImage(texture._id, texture._target, level, image.dataSize());
 }
 #endif
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setSubImage(AbstractTexture& texture, const GLint level, const Vector3i& offset, const ImageView3D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     #ifndef MAGNUM_TARGET_GLES2
     Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
     #endif
@@ -2069,6 +2225,8 @@ void AbstractTexture::DataHelper<3>::setCompressedSubImage(AbstractTexture& text
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractTexture::DataHelper<3>::setSubImage(AbstractTexture& texture, const GLint level, const Vector3i& offset, BufferImage3D& image) {
+    MAGNUM_TRACE_ZONE("AbstractTexture::setSubImage");
+
     image.buffer().bindInternal(Buffer::TargetHint::PixelUnpack);
     image.storage().applyUnpack();
     (texture.*Context::current().state().texture->subImage3DImplementation)(level, offset, image.size(), image.format(), image.type(), nullptr);
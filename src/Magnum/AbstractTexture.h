@@ -135,6 +135,9 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
     friend Implementation::TextureState;
     friend AbstractFramebuffer;
     friend CubeMapTexture;
+    #ifndef MAGNUM_TARGET_GLES2
+    friend TextureStreamer;
+    #endif
 
     public:
         #ifndef MAGNUM_TARGET_GLES2
@@ -398,6 +401,59 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
          */
         void bind(Int textureUnit);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         *
+         * Returns a handle which can be passed to the shader via
+         * @ref AbstractShaderProgram::setUniformHandle() or stored in a
+         * uniform or shader storage buffer instead of binding the texture to
+         * a texture unit. Once the handle is created, the texture storage and
+         * sampling parameters are immutable, any further attempt to change
+         * them results in an OpenGL error. The handle needs to be made
+         * resident with @ref setResident() before it's accessed by a shader.
+         * The result is *not* cached, but the driver returns the same handle
+         * for all calls.
+         * @see @fn_gl_extension{GetTextureHandle,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        UnsignedLong handle();
+
+        /**
+         * @brief Whether the bindless handle is resident
+         *
+         * The result is *not* cached, repeated queries will result in repeated
+         * OpenGL calls.
+         * @see @ref handle(), @ref setResident(),
+         *      @fn_gl_extension{IsTextureHandleResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        bool isResident();
+
+        /**
+         * @brief Make the bindless handle resident or non-resident
+         * @return Reference to self (for method chaining)
+         *
+         * Only resident handles can be accessed by shaders. Residency is a
+         * per-context state and resident textures can't be evicted from GPU
+         * memory, so make only the textures needed for rendering resident.
+         * Does nothing if the handle is already in requested state. The
+         * handle is made non-resident implicitly when the texture is
+         * destroyed.
+         * @see @ref handle(), @ref isResident(),
+         *      @fn_gl_extension{MakeTextureHandleResident,ARB,bindless_texture},
+         *      @fn_gl_extension{MakeTextureHandleNonResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        AbstractTexture& setResident(bool resident);
+        #endif
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -477,6 +533,13 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void invalidateImage(Int level);
         void generateMipmap();
 
+        #ifndef MAGNUM_TARGET_GLES
+        static Vector3i sparsePageSizeInternal(GLenum target, TextureFormat internalFormat);
+        template<UnsignedInt dimensions> void setSparseStorageInternal(GLsizei levels, TextureFormat internalFormat, const Math::Vector<dimensions, GLsizei>& size);
+        Int sparseLevelCountInternal();
+        void commitPagesInternal(GLint level, const Vector3i& offset, const Vector3i& size, bool commit);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         template<UnsignedInt dimensions> void image(GLint level, Image<dimensions>& image);
         template<UnsignedInt dimensions> void image(GLint level, BufferImage<dimensions>& image, BufferUsage usage);
@@ -662,6 +725,11 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void MAGNUM_LOCAL invalidateSubImageImplementationARB(GLint level, const Vector3i& offset, const Vector3i& size);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL pageCommitmentImplementationDefault(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
+        void MAGNUM_LOCAL pageCommitmentImplementationDSAEXT(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
+        #endif
+
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         PixelFormat MAGNUM_LOCAL imageFormatForInternalFormat(TextureFormat internalFormat);
         PixelType MAGNUM_LOCAL imageTypeForInternalFormat(TextureFormat internalFormat);
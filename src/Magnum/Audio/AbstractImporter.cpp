@@ -25,10 +25,13 @@
 
 #include "AbstractImporter.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Implementation/viewAllocator.h"
+
 namespace Magnum { namespace Audio {
 
 AbstractImporter::AbstractImporter() = default;
@@ -68,11 +71,25 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
     doOpenData(Utility::Directory::read(filename));
 }
 
+AbstractImporter& AbstractImporter::setAllocator(const Allocator allocator, void* const userData) {
+    _allocator = allocator;
+    _allocatorUserData = userData;
+    return *this;
+}
+
+Containers::Array<char> AbstractImporter::allocate(const std::size_t size) {
+    if(_allocator) return _allocator(size, _allocatorUserData);
+    return Containers::Array<char>{size};
+}
+
 void AbstractImporter::close() {
     if(isOpened()) {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    _readData = nullptr;
+    _readOffset = 0;
 }
 
 Buffer::Format AbstractImporter::format() const {
@@ -90,4 +107,44 @@ Containers::Array<char> AbstractImporter::data() {
     return doData();
 }
 
+std::size_t AbstractImporter::data(const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::data(): no file opened", {});
+
+    /* Temporarily hand out the view to the implementation */
+    const Allocator allocator = _allocator;
+    void* const allocatorUserData = _allocatorUserData;
+    Implementation::ViewAllocatorState state{data, false};
+    setAllocator(Implementation::viewAllocator, &state);
+    Containers::Array<char> out = doData();
+    setAllocator(allocator, allocatorUserData);
+
+    if(out.size() > data.size()) {
+        Error() << "Audio::AbstractImporter::data(): expected at least" << out.size() << "bytes for the data but got" << data.size();
+        return 0;
+    }
+
+    return Implementation::moveIntoView(std::move(out), data).size();
+}
+
+std::size_t AbstractImporter::read(const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::read(): no file opened", {});
+    return doRead(data);
+}
+
+std::size_t AbstractImporter::doRead(const Containers::ArrayView<char> data) {
+    if(!_readData) _readData = doData();
+
+    const std::size_t size = std::min(data.size(), _readData.size() - _readOffset);
+    std::copy_n(_readData + _readOffset, size, data.begin());
+    _readOffset += size;
+    return size;
+}
+
+void AbstractImporter::rewind() {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::rewind(): no file opened", );
+    doRewind();
+}
+
+void AbstractImporter::doRewind() { _readOffset = 0; }
+
 }}
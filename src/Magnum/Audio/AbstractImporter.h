@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Audio::AbstractImporter
  */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -48,6 +49,9 @@ importer plugins.
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Plugins able to decode the data incrementally should implement also
+@ref doRead() and @ref doRewind(), the default implementation decodes the
+whole file on first @ref read() call.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -60,10 +64,10 @@ checked by the implementation:
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
-Plugin interface string is `"cz.mosra.magnum.Audio.AbstractImporter/0.1"`.
+Plugin interface string is `"cz.mosra.magnum.Audio.AbstractImporter/0.2.2"`.
 */
 class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlugin<AbstractImporter> {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Audio.AbstractImporter/0.2.2")
 
     public:
         /**
@@ -83,6 +87,15 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         typedef Containers::EnumSet<Feature> Features;
 
+        /**
+         * @brief Data allocator
+         *
+         * Called with requested size in bytes and the user pointer passed
+         * to @ref setAllocator().
+         * @see @ref allocate()
+         */
+        typedef Containers::Array<char>(*Allocator)(std::size_t, void*);
+
         /** @brief Default constructor */
         explicit AbstractImporter();
 
@@ -131,8 +144,68 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Import sample data into existing memory
+         * @param data      Where to put the data
+         * @return Count of bytes written, `0` on failure
+         *
+         * Like @ref data(), but puts all sample data to @p data. If the
+         * importer allocates the data through @ref allocate(), it decodes
+         * them directly to @p data, otherwise they are copied there. Fails
+         * if @p data is too small. Independent on @ref read().
+         */
+        std::size_t data(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Read next chunk of sample data
+         * @param data      Where to put the data
+         * @return Count of bytes read, `0` at the end of the data
+         *
+         * Reads at most @p data.size() bytes following the previous read, so
+         * the file can be decoded in small chunks instead of keeping all the
+         * data in memory, see @ref StreamingSource for an example use. If
+         * size of @p data is a multiple of sample size, the chunks contain
+         * only whole samples. Independent on @ref data().
+         * @see @ref rewind()
+         */
+        std::size_t read(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Rewind to the beginning of sample data
+         *
+         * Next call to @ref read() will return the data from the beginning.
+         */
+        void rewind();
+
         /*@}*/
 
+        /** @brief Data allocator */
+        Allocator allocator() const { return _allocator; }
+
+        /**
+         * @brief Set data allocator
+         * @return Reference to self (for method chaining)
+         *
+         * The @p allocator is called by importer implementations for storage
+         * of returned sample data, see @ref allocate(). The returned array
+         * can use a custom deleter to give the memory back to a staging
+         * arena instead of the heap. Importers referencing memory-mapped
+         * files directly don't call the allocator. Set to `nullptr` to use
+         * the default heap allocation.
+         */
+        AbstractImporter& setAllocator(Allocator allocator, void* userData = nullptr);
+
+    protected:
+        /**
+         * @brief Allocate data storage
+         *
+         * Should be used by @ref doData() implementations instead of
+         * allocating the array directly. Calls the allocator set by
+         * @ref setAllocator(), if any, otherwise allocates a
+         * default-initialized array on the heap.
+         */
+        Containers::Array<char> allocate(std::size_t size);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -166,6 +239,28 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref read()
+         *
+         * Default implementation calls @ref doData() on first call and then
+         * returns the data in chunks.
+         */
+        virtual std::size_t doRead(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Implementation for @ref rewind()
+         *
+         * Default implementation rewinds the data cached by the default
+         * @ref doRead() implementation.
+         */
+        virtual void doRewind();
+
+    private:
+        Allocator _allocator{};
+        void* _allocatorUserData{};
+        Containers::Array<char> _readData;
+        std::size_t _readOffset{};
 };
 
 }}
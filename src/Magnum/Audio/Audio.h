@@ -36,8 +36,12 @@ namespace Magnum { namespace Audio {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 class AbstractImporter;
 class Buffer;
+class BufferLoader;
 class Context;
 class Source;
+class StreamingSource;
+class Voice;
+class VoicePool;
 /* Renderer used only statically */
 #endif
 
@@ -29,6 +29,17 @@
 
 namespace Magnum { namespace Audio {
 
+Float Buffer::duration() const {
+    ALint size, channels, bits, frequency;
+    alGetBufferi(_id, AL_SIZE, &size);
+    alGetBufferi(_id, AL_CHANNELS, &channels);
+    alGetBufferi(_id, AL_BITS, &bits);
+    alGetBufferi(_id, AL_FREQUENCY, &frequency);
+    if(!size || !channels || !bits || !frequency) return 0.0f;
+
+    return Float(size*8/(channels*bits))/Float(frequency);
+}
+
 Debug& operator<<(Debug& debug, const Buffer::Format value) {
     switch(value) {
         #define _c(value) case Buffer::Format::value: return debug << "Audio::Buffer::Format::" #value;
@@ -131,6 +131,16 @@ class Buffer {
             return *this;
         }
 
+        /**
+         * @brief Duration of the data in seconds
+         *
+         * Calculated from size, channel count, bits per sample and frequency
+         * of the data. Returns `0.0f` if the buffer has no data.
+         * @see @fn_al{GetBufferi} with @def_al{SIZE}, @def_al{CHANNELS},
+         *      @def_al{BITS}, @def_al{FREQUENCY}
+         */
+        Float duration() const;
+
     private:
         ALuint _id;
 };
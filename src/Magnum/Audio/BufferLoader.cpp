@@ -0,0 +1,66 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferLoader.h"
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+
+namespace Magnum { namespace Audio {
+
+BufferLoader::BufferLoader(AbstractImporter& importer, const ResourcePolicy policy): _importer(importer), _policy{policy}, _decodedCount{} {}
+
+ResourceKey BufferLoader::add(const std::string& filename) {
+    const ResourceKey key{filename};
+    _filenames.emplace(key, filename);
+    return key;
+}
+
+std::string BufferLoader::doName(const ResourceKey key) const {
+    const auto found = _filenames.find(key);
+    return found == _filenames.end() ? std::string{} : found->second;
+}
+
+void BufferLoader::doLoad(const ResourceKey key) {
+    const auto found = _filenames.find(key);
+    if(found == _filenames.end() || !_importer.openFile(found->second)) {
+        setNotFound(key);
+        return;
+    }
+
+    const Buffer::Format format = _importer.format();
+    const UnsignedInt frequency = _importer.frequency();
+    Containers::Array<char> data = _importer.data();
+    _importer.close();
+
+    Buffer buffer;
+    buffer.setData(format, data, frequency);
+    ++_decodedCount;
+    set(key, std::move(buffer), ResourceDataState::Final, _policy, data.size());
+}
+
+}}
@@ -0,0 +1,121 @@
+#ifndef Magnum_Audio_BufferLoader_h
+#define Magnum_Audio_BufferLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::BufferLoader
+ */
+
+#include <string>
+#include <unordered_map>
+
+#include "Magnum/ResourceManager.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Resource loader sharing decoded audio buffers
+
+Playing the same sound from many sources shouldn't decode and upload it many
+times. The loader decodes each registered file using given importer on first
+request and passes the resulting @ref Buffer to the @ref ResourceManager,
+which then hands out the same buffer to everything requesting given key:
+@code
+ResourceManager<Audio::Buffer> manager;
+Audio::BufferLoader loader{*importer};
+manager.setLoader(&loader)
+    .setBudget<Audio::Buffer>(16*1024*1024);
+
+const ResourceKey hit = loader.add("sounds/hit.wav");
+
+// Decoded only once, all voices share the same buffer
+for(Emitter& emitter: emitters) {
+    emitter.buffer = manager.get<Audio::Buffer>(hit);
+    emitter.source.setBuffer(emitter.buffer);
+}
+@endcode
+
+## Eviction
+
+@ref Source references the buffer only through a raw pointer, keep the
+@ref Resource instance around for as long as the source may play it. By
+default the buffers are added with @ref ResourcePolicy::Budgeted and the size
+of decoded sample data as their cost, so buffers that are no longer
+referenced stay in memory until @ref ResourceManager::memoryUsage() goes over
+@ref ResourceManager::setBudget() "the budget" and are then deleted in least
+recently used order. With @ref ResourcePolicy::ReferenceCounted the buffer is
+deleted as soon as the last reference is gone. Deleted buffers are decoded
+again on next request.
+
+The importer is used only from @ref ResourceManager::get() and has to stay
+alive for the whole lifetime of the loader.
+*/
+class MAGNUM_AUDIO_EXPORT BufferLoader: public AbstractResourceLoader<Buffer> {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer  Importer used for decoding the files
+         * @param policy    Policy for loaded buffers
+         */
+        explicit BufferLoader(AbstractImporter& importer, ResourcePolicy policy = ResourcePolicy::Budgeted);
+
+        /** @brief Policy for loaded buffers */
+        ResourcePolicy policy() const { return _policy; }
+
+        /**
+         * @brief Register a file
+         * @return Resource key under which the buffer is available
+         *
+         * The file is not opened until the buffer is requested from the
+         * manager. Registering the same file more than once returns the same
+         * key.
+         */
+        ResourceKey add(const std::string& filename);
+
+        /**
+         * @brief Count of decoded files
+         *
+         * Count of successful decodes, including files decoded again after
+         * their buffer was evicted.
+         */
+        std::size_t decodedCount() const { return _decodedCount; }
+
+    private:
+        MAGNUM_AUDIO_LOCAL std::string doName(ResourceKey key) const override;
+        MAGNUM_AUDIO_LOCAL void doLoad(ResourceKey key) override;
+
+        AbstractImporter& _importer;
+        ResourcePolicy _policy;
+        std::size_t _decodedCount;
+        std::unordered_map<ResourceKey, std::string> _filenames;
+};
+
+}}
+
+#endif
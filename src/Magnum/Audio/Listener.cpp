@@ -83,18 +83,22 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
     }
 
     /* Add all objects of the Playables in the PlayableGroups to a vector to
-       later setClean() */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, Float>>> objects;
-
-    objects.push_back(this->object());
+       later setClean(), reuse the vector from previous call to avoid
+       allocating every frame */
+    _objects.clear();
+    _objects.push_back(this->object());
     for(PlayableGroup<dimensions>& group : groups) {
         for(UnsignedInt i = 0; i < group.size(); ++i) {
-            objects.push_back(group[i].object());
+            _objects.push_back(group[i].object());
         }
     }
 
-    /* Use the more performant way to set multiple objects clean */
-    AbstractObject<dimensions, Float>::setClean(objects);
+    /* Use the more performant way to set multiple objects clean, batch all
+       the resulting OpenAL updates together */
+    ALCcontext* const context = alcGetCurrentContext();
+    if(context) alcSuspendContext(context);
+    AbstractObject<dimensions, Float>::setClean(_objects);
+    if(context) alcProcessContext(context);
 }
 
 /* On non-MinGW Windows the instantiations are already marked with extern
@@ -189,6 +189,7 @@ template <UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFea
 
         Matrix4 _soundTransformation;
         Float _gain;
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
 };
 
 
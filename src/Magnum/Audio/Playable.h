@@ -146,8 +146,19 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             if(playables()) {
                 position = playables()->soundTransformation().transformVector(position);
             }
-            _source.setPosition(position);
-            _source.setDirection(Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd));
+            const Vector3 direction = Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd);
+
+            /* The object might be dirty only because its parent or the sound
+               transformation changed, avoid redundant OpenAL calls if the
+               result is the same */
+            if(position != _position) {
+                _source.setPosition(position);
+                _position = position;
+            }
+            if(direction != _direction) {
+                _source.setDirection(direction);
+                _direction = direction;
+            }
 
             /** @todo velocity */
         }
@@ -165,6 +176,8 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
         VectorTypeFor<dimensions, Float> _fwd;
         Float _gain;
         Source _source;
+        /* Last values passed to the source, zero is OpenAL default */
+        Vector3 _position, _direction;
 };
 
 /**
@@ -33,6 +33,7 @@
 #include <functional>
 #include <string>
 #include <vector>
+#include <alc.h>
 
 #include <Magnum/SceneGraph/AbstractObject.h>
 #include <Magnum/SceneGraph/SceneGraph.h>
@@ -154,6 +155,12 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
         /**
          * @brief Set all contained Playables clean
+         *
+         * Only Playables with dirty objects are updated and only if their
+         * resulting position or direction actually changed. The updates are
+         * batched between @fn_alc{SuspendContext} and
+         * @fn_alc{ProcessContext} so the implementation can apply them all
+         * at once.
          * @see @ref AbstractObject::setClean()
          */
         void setClean();
@@ -171,6 +178,7 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
         Matrix4 _soundTransform;
         Float _gain;
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
 };
 
 template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup<dimensions>::setSoundTransformation(const Matrix4& matrix) {
@@ -186,13 +194,16 @@ template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup
 }
 
 template<UnsignedInt dimensions> inline void PlayableGroup<dimensions>::setClean() {
-    std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-    objects.reserve(this->size());
-
+    /* Reuse the list from previous call to avoid allocating every frame */
+    _objects.clear();
     for(UnsignedInt i = 0; i < this->size(); ++i)
-        objects.push_back((*this)[i].object());
+        _objects.push_back((*this)[i].object());
 
-    SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    /* Batch all source updates together */
+    ALCcontext* const context = alcGetCurrentContext();
+    if(context) alcSuspendContext(context);
+    SceneGraph::AbstractObject<dimensions, Float>::setClean(_objects);
+    if(context) alcProcessContext(context);
 }
 
 /**
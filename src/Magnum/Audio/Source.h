@@ -45,8 +45,10 @@ namespace Magnum { namespace Audio {
 /**
 @brief Source
 
-Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+Manages positional audio source. Either a single buffer can be attached using
+@ref setBuffer() or more buffers can be queued for sequential playback using
+@ref queueBuffers(), see also @ref StreamingSource for a convenient wrapper
+streaming the data from an importer.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
@@ -502,6 +504,49 @@ class MAGNUM_AUDIO_EXPORT Source {
          */
         Source& setBuffer(Buffer* buffer);
 
+        /**
+         * @brief Queue buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Appends the buffers to the queue of buffers played one after
+         * another and changes source type to @ref Type::Streaming. The
+         * buffers must be already filled with data of the same format.
+         * @see @ref unqueueBuffers(), @ref buffersQueued(),
+         *      @fn_al{SourceQueueBuffers}
+         */
+        Source& queueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers);
+        Source& queueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers); /**< @overload */
+
+        /**
+         * @brief Unqueue buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Removes first @p count buffers from the queue, in the same order
+         * as they were queued. Only already processed buffers can be
+         * unqueued, all buffers are processed after calling @ref stop().
+         * @see @ref queueBuffers(), @ref buffersProcessed(),
+         *      @fn_al{SourceUnqueueBuffers}
+         */
+        Source& unqueueBuffers(Int count);
+
+        /**
+         * @brief Count of queued buffers
+         *
+         * @see @ref queueBuffers(), @fn_al{GetSourcei} with
+         *      @def_al{BUFFERS_QUEUED}
+         */
+        Int buffersQueued() const;
+
+        /**
+         * @brief Count of processed buffers
+         *
+         * Count of queued buffers that were already played and can be
+         * unqueued.
+         * @see @ref unqueueBuffers(), @fn_al{GetSourcei} with
+         *      @def_al{BUFFERS_PROCESSED}
+         */
+        Int buffersProcessed() const;
+
         /*@}*/
 
         /** @{ @name State management */
@@ -719,6 +764,18 @@ inline auto Source::state() const -> State {
     return State(state);
 }
 
+inline Int Source::buffersQueued() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_QUEUED, &count);
+    return count;
+}
+
+inline Int Source::buffersProcessed() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_PROCESSED, &count);
+    return count;
+}
+
 inline bool Source::isLooping() const {
     ALint looping;
     alGetSourcei(_id, AL_LOOPING, &looping);
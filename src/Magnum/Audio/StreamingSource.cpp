@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingSource.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Magnum/Audio/AbstractImporter.h"
+
+namespace Magnum { namespace Audio {
+
+StreamingSource::StreamingSource(AbstractImporter& importer, const std::size_t bufferSize, const UnsignedInt bufferCount): _importer(importer), _chunk(std::max(bufferSize & ~std::size_t(15), std::size_t(16))) {
+    CORRADE_ASSERT(bufferCount, "Audio::StreamingSource: at least one buffer is required", );
+
+    _buffers.reserve(bufferCount);
+    for(UnsignedInt i = 0; i != bufferCount; ++i)
+        _buffers.emplace_back();
+
+    _thread = std::thread{&StreamingSource::run, this};
+}
+
+StreamingSource::~StreamingSource() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+
+    _source.stop();
+    _source.unqueueBuffers(_queued);
+}
+
+bool StreamingSource::isLooping() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _looping;
+}
+
+StreamingSource& StreamingSource::setLooping(const bool loop) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _looping = loop;
+    return *this;
+}
+
+void StreamingSource::play() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if(!_queued) queue();
+        _playing = true;
+        _source.play();
+    }
+    _condition.notify_one();
+}
+
+void StreamingSource::pause() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _playing = false;
+    _source.pause();
+}
+
+void StreamingSource::stop() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _playing = false;
+    _source.stop();
+
+    /* After stop all buffers are processed */
+    _source.unqueueBuffers(_queued);
+    _queueBegin = _queued = 0;
+    _importer.rewind();
+}
+
+void StreamingSource::run() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    while(!_quit) {
+        /* Wake up periodically, the buffers are long enough for that */
+        _condition.wait_for(lock, std::chrono::milliseconds{10});
+        if(_quit || !_playing) continue;
+
+        /* Buffers are unqueued in the same order as they were queued, so
+           the processed ones are at the beginning of the ring */
+        const Int processed = _source.buffersProcessed();
+        if(processed) {
+            _source.unqueueBuffers(processed);
+            _queueBegin = (_queueBegin + processed) % _buffers.size();
+            _queued -= processed;
+        }
+
+        /* Refill everything that was played */
+        queue();
+
+        /* Nothing more to play, the stream has ended */
+        if(!_queued) {
+            _playing = false;
+            continue;
+        }
+
+        /* The source ran out of data before we managed to refill it, resume
+           the playback */
+        if(_source.state() == Source::State::Stopped) _source.play();
+    }
+}
+
+void StreamingSource::queue() {
+    while(_queued != _buffers.size()) {
+        Buffer& buffer = _buffers[(_queueBegin + _queued) % _buffers.size()];
+        if(!fill(buffer)) break;
+
+        _source.queueBuffers({buffer});
+        ++_queued;
+    }
+}
+
+bool StreamingSource::fill(Buffer& buffer) {
+    std::size_t size = _importer.read(_chunk);
+    if(!size && _looping) {
+        _importer.rewind();
+        size = _importer.read(_chunk);
+    }
+
+    if(!size) return false;
+
+    buffer.setData(_importer.format(), {_chunk.data(), size}, _importer.frequency());
+    return true;
+}
+
+}}
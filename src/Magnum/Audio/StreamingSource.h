@@ -0,0 +1,163 @@
+#ifndef Magnum_Audio_StreamingSource_h
+#define Magnum_Audio_StreamingSource_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::StreamingSource
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming source
+
+Plays sample data from an @ref AbstractImporter without decoding the whole
+file up front. The data are read in chunks of given size using
+@ref AbstractImporter::read() into a small ring of buffers, which are queued
+on the underlying @ref Source. A background thread periodically unqueues the
+already played buffers, refills them with next chunks and queues them again.
+Example usage:
+@code
+std::unique_ptr<Audio::AbstractImporter> importer = manager.instance("WavAudioImporter");
+importer->openFile("music.wav");
+
+Audio::StreamingSource source{*importer};
+source.setLooping(true)
+    .play();
+@endcode
+
+The importer must stay opened for the whole lifetime of the streaming source
+and it shouldn't be accessed from other places while the source exists.
+Position, gain and other properties can be set on the underlying source
+accessible through @ref source(), but playback state and looping should be
+controlled only through this class.
+*/
+class MAGNUM_AUDIO_EXPORT StreamingSource {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer      Importer with opened file
+         * @param bufferSize    Size of one buffer in bytes
+         * @param bufferCount   Count of buffers in the ring
+         *
+         * The @p bufferSize is rounded down to a multiple of 16 bytes so the
+         * buffers always contain whole samples of any supported format.
+         * Larger buffers or more of them make the playback more resistant to
+         * stalls at the expense of memory use.
+         */
+        explicit StreamingSource(AbstractImporter& importer, std::size_t bufferSize = 64*1024, UnsignedInt bufferCount = 4);
+
+        /** @brief Copying is not allowed */
+        StreamingSource(const StreamingSource&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamingSource(StreamingSource&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the background thread and the playback.
+         */
+        ~StreamingSource();
+
+        /** @brief Copying is not allowed */
+        StreamingSource& operator=(const StreamingSource&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamingSource& operator=(StreamingSource&&) = delete;
+
+        /** @brief Underlying source */
+        Source& source() { return _source; }
+        const Source& source() const { return _source; } /**< @overload */
+
+        /** @brief Whether the playback is looping */
+        bool isLooping() const;
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the importer is rewound after reaching end of the data
+         * and the playback continues from the beginning. Default is
+         * `false`.
+         */
+        StreamingSource& setLooping(bool loop);
+
+        /**
+         * @brief Play
+         *
+         * Fills the buffers with data, if not already, and starts or resumes
+         * the playback.
+         * @see @ref Source::play()
+         */
+        void play();
+
+        /**
+         * @brief Pause
+         *
+         * @see @ref Source::pause()
+         */
+        void pause();
+
+        /**
+         * @brief Stop
+         *
+         * Stops the playback, unqueues all buffers and rewinds the importer,
+         * so next call to @ref play() starts from the beginning.
+         * @see @ref Source::stop(), @ref AbstractImporter::rewind()
+         */
+        void stop();
+
+    private:
+        void run();
+        void queue();
+        bool fill(Buffer& buffer);
+
+        AbstractImporter& _importer;
+        Containers::Array<char> _chunk;
+        /* Buffers need to be destroyed after the source */
+        std::vector<Buffer> _buffers;
+        Source _source;
+        UnsignedInt _queueBegin{}, _queued{};
+        bool _looping{}, _playing{}, _quit{};
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        std::thread _thread;
+};
+
+}}
+
+#endif
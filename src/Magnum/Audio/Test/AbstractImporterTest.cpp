@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
@@ -37,10 +38,18 @@ struct AbstractImporterTest: TestSuite::Tester {
     explicit AbstractImporterTest();
 
     void openFile();
+    void read();
+    void dataIntoView();
+    void dataIntoViewCopy();
+    void dataIntoViewTooSmall();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+              &AbstractImporterTest::read,
+              &AbstractImporterTest::dataIntoView,
+              &AbstractImporterTest::dataIntoViewCopy,
+              &AbstractImporterTest::dataIntoViewTooSmall});
 }
 
 void AbstractImporterTest::openFile() {
@@ -71,6 +80,100 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+void AbstractImporterTest::read() {
+    class Importer: public Audio::AbstractImporter {
+        public:
+            UnsignedInt dataCalls{};
+
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            Buffer::Format doFormat() const override { return {}; }
+            UnsignedInt doFrequency() const override { return {}; }
+            Corrade::Containers::Array<char> doData() override {
+                ++dataCalls;
+                return Containers::Array<char>::from('a', 'b', 'c', 'd', 'e');
+            }
+    };
+
+    /* Default implementation should decode the data just once and return
+       them in chunks */
+    Importer importer;
+    char data[2];
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE(data[0], 'a');
+    CORRADE_COMPARE(data[1], 'b');
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE(data[0], 'c');
+    CORRADE_COMPARE(importer.read(data), 1);
+    CORRADE_COMPARE(data[0], 'e');
+    CORRADE_COMPARE(importer.read(data), 0);
+    CORRADE_COMPARE(importer.dataCalls, 1);
+
+    importer.rewind();
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE(data[0], 'a');
+    CORRADE_COMPARE(importer.dataCalls, 1);
+}
+
+namespace {
+    class AllocatingImporter: public Audio::AbstractImporter {
+        public:
+            bool useAllocator{true};
+
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            Buffer::Format doFormat() const override { return {}; }
+            UnsignedInt doFrequency() const override { return {}; }
+            Corrade::Containers::Array<char> doData() override {
+                Containers::Array<char> data = useAllocator ? allocate(3) : Containers::Array<char>{3};
+                data[0] = 'a';
+                data[1] = 'b';
+                data[2] = 'c';
+                return data;
+            }
+    };
+}
+
+void AbstractImporterTest::dataIntoView() {
+    AllocatingImporter importer;
+    char data[4]{};
+
+    CORRADE_COMPARE(importer.data(data), 3);
+    CORRADE_COMPARE(data[0], 'a');
+    CORRADE_COMPARE(data[2], 'c');
+    CORRADE_COMPARE(data[3], '\0');
+
+    /* The original allocator is restored afterwards */
+    CORRADE_VERIFY(!importer.allocator());
+}
+
+void AbstractImporterTest::dataIntoViewCopy() {
+    AllocatingImporter importer;
+    importer.useAllocator = false;
+    char data[3]{};
+
+    /* The importer doesn't use allocate(), the data are copied */
+    CORRADE_COMPARE(importer.data(data), 3);
+    CORRADE_COMPARE(data[0], 'a');
+    CORRADE_COMPARE(data[2], 'c');
+}
+
+void AbstractImporterTest::dataIntoViewTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AllocatingImporter importer;
+    char data[2];
+    CORRADE_COMPARE(importer.data(data), 0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): expected at least 3 bytes for the data but got 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::AbstractImporterTest)
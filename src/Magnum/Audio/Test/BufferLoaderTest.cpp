@@ -0,0 +1,177 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferLoader.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct BufferLoaderTest: TestSuite::Tester {
+    explicit BufferLoaderTest();
+
+    void shared();
+    void notFound();
+    void referenceCounted();
+    void budget();
+
+    Context _context;
+};
+
+BufferLoaderTest::BufferLoaderTest() {
+    addTests({&BufferLoaderTest::shared,
+              &BufferLoaderTest::notFound,
+              &BufferLoaderTest::referenceCounted,
+              &BufferLoaderTest::budget});
+}
+
+namespace {
+
+class Importer: public Audio::AbstractImporter {
+    public:
+        UnsignedInt openCount{};
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(const std::string& filename) override {
+            ++openCount;
+            _opened = filename != "missing.wav";
+        }
+        void doClose() override { _opened = false; }
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Mono8; }
+        UnsignedInt doFrequency() const override { return 22050; }
+        Corrade::Containers::Array<char> doData() override {
+            return Containers::Array<char>{Containers::ValueInit, 100};
+        }
+
+        bool _opened{};
+};
+
+typedef ResourceManager<Buffer> BufferManager;
+
+}
+
+void BufferLoaderTest::shared() {
+    BufferManager manager;
+    Importer importer;
+    BufferLoader loader{importer};
+    manager.setLoader(&loader);
+    CORRADE_COMPARE(loader.policy(), ResourcePolicy::Budgeted);
+
+    const ResourceKey key = loader.add("hit.wav");
+    CORRADE_COMPARE(loader.add("hit.wav"), key);
+    CORRADE_COMPARE(loader.name(key), "hit.wav");
+
+    Resource<Buffer> a = manager.get<Buffer>(key);
+    Resource<Buffer> b = manager.get<Buffer>(key);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_VERIFY(static_cast<Buffer*>(a) == static_cast<Buffer*>(b));
+    CORRADE_COMPARE(a->duration(), 100.0f/22050.0f);
+
+    /* Both sources play the same buffer, decoded only once */
+    Source first, second;
+    first.setBuffer(a);
+    second.setBuffer(b);
+    CORRADE_COMPARE(importer.openCount, 1);
+    CORRADE_COMPARE(loader.decodedCount(), 1);
+    CORRADE_COMPARE(manager.memoryUsage<Buffer>(), 100);
+}
+
+void BufferLoaderTest::notFound() {
+    BufferManager manager;
+    Importer importer;
+    BufferLoader loader{importer};
+    manager.setLoader(&loader);
+
+    /* Not registered, the importer is not even asked */
+    CORRADE_COMPARE(manager.get<Buffer>("hit.wav").state(), ResourceState::NotFound);
+    CORRADE_COMPARE(importer.openCount, 0);
+
+    /* Registered, but the import fails */
+    const ResourceKey missing = loader.add("missing.wav");
+    CORRADE_COMPARE(manager.get<Buffer>(missing).state(), ResourceState::NotFound);
+    CORRADE_COMPARE(importer.openCount, 1);
+    CORRADE_COMPARE(loader.decodedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 2);
+}
+
+void BufferLoaderTest::referenceCounted() {
+    BufferManager manager;
+    Importer importer;
+    BufferLoader loader{importer, ResourcePolicy::ReferenceCounted};
+    manager.setLoader(&loader);
+
+    const ResourceKey key = loader.add("hit.wav");
+    {
+        Resource<Buffer> a = manager.get<Buffer>(key);
+        CORRADE_COMPARE(a.state(), ResourceState::Final);
+        CORRADE_COMPARE(manager.state<Buffer>(key), ResourceState::Final);
+    }
+
+    /* Deleted with the last reference, decoded again on next request */
+    CORRADE_COMPARE(manager.state<Buffer>(key), ResourceState::NotLoaded);
+    CORRADE_COMPARE(manager.memoryUsage<Buffer>(), 0);
+    CORRADE_COMPARE(manager.get<Buffer>(key).state(), ResourceState::Final);
+    CORRADE_COMPARE(loader.decodedCount(), 2);
+}
+
+void BufferLoaderTest::budget() {
+    BufferManager manager;
+    Importer importer;
+    BufferLoader loader{importer};
+    manager.setLoader(&loader)
+        .setBudget<Buffer>(150);
+
+    const ResourceKey hit = loader.add("hit.wav");
+    const ResourceKey explosion = loader.add("explosion.wav");
+
+    /* Not referenced anymore, but stays in memory as it fits the budget */
+    CORRADE_COMPARE(manager.get<Buffer>(hit).state(), ResourceState::Final);
+    CORRADE_COMPARE(manager.state<Buffer>(hit), ResourceState::Final);
+    CORRADE_COMPARE(manager.memoryUsage<Buffer>(), 100);
+
+    /* Loading another one makes room by evicting the unreferenced one */
+    Resource<Buffer> a = manager.get<Buffer>(explosion);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(manager.state<Buffer>(hit), ResourceState::NotLoaded);
+    CORRADE_COMPARE(manager.evictedCount<Buffer>(), 1);
+    CORRADE_COMPARE(manager.memoryUsage<Buffer>(), 100);
+    CORRADE_COMPARE(loader.decodedCount(), 2);
+
+    /* The referenced one is not evicted even though over the budget */
+    CORRADE_COMPARE(manager.get<Buffer>(hit).state(), ResourceState::Final);
+    CORRADE_COMPARE(manager.state<Buffer>(explosion), ResourceState::Final);
+    CORRADE_COMPARE(loader.decodedCount(), 3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::BufferLoaderTest)
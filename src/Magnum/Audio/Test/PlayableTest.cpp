@@ -43,13 +43,15 @@ struct PlayableTest: TestSuite::Tester {
 
     void testFeature();
     void testGroup();
+    void testGroupUnchanged();
 
     Context _context;
 };
 
 PlayableTest::PlayableTest() {
     addTests({&PlayableTest::testFeature,
-              &PlayableTest::testGroup});
+              &PlayableTest::testGroup,
+              &PlayableTest::testGroupUnchanged});
 }
 
 void PlayableTest::testFeature() {
@@ -92,6 +94,30 @@ void PlayableTest::testGroup() {
     group.stop();
 }
 
+void PlayableTest::testGroupUnchanged() {
+    Scene3D scene;
+    Object3D object{&scene};
+    PlayableGroup3D group;
+    Playable3D playable{object, &group};
+
+    constexpr Vector3 offset{-3.0f, 2.0f, 1.0f};
+    object.translate(offset);
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), offset);
+
+    /* Object is dirty, but the resulting position is the same, so the source
+       shouldn't get updated */
+    playable.source().setPosition({});
+    object.setDirty();
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), Vector3{});
+
+    /* After actual change it should */
+    object.translate(offset);
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), offset*2.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::PlayableTest)
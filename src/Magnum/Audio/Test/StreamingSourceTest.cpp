@@ -0,0 +1,91 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/StreamingSource.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct StreamingSourceTest: TestSuite::Tester {
+    explicit StreamingSourceTest();
+
+    void looping();
+    void stop();
+
+    Context _context;
+};
+
+StreamingSourceTest::StreamingSourceTest() {
+    addTests({&StreamingSourceTest::looping,
+              &StreamingSourceTest::stop});
+}
+
+namespace {
+
+class Importer: public Audio::AbstractImporter {
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Mono8; }
+        UnsignedInt doFrequency() const override { return 22050; }
+        Corrade::Containers::Array<char> doData() override {
+            return Containers::Array<char>{Containers::ValueInit, 100};
+        }
+};
+
+}
+
+void StreamingSourceTest::looping() {
+    Importer importer;
+    StreamingSource source{importer, 32, 2};
+    CORRADE_VERIFY(!source.isLooping());
+
+    source.setLooping(true);
+    CORRADE_VERIFY(source.isLooping());
+}
+
+void StreamingSourceTest::stop() {
+    Importer importer;
+    StreamingSource source{importer, 32, 2};
+
+    source.play();
+    source.stop();
+    CORRADE_COMPARE(source.source().buffersQueued(), 0);
+    CORRADE_COMPARE(source.source().state(), Source::State::Stopped);
+
+    /* The importer is rewound, so all the data are available again */
+    char data[128];
+    CORRADE_COMPARE(importer.read(data), 100);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamingSourceTest)
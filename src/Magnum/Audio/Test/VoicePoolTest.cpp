@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/VoicePool.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct VoicePoolTest: TestSuite::Tester {
+    explicit VoicePoolTest();
+
+    void bufferDuration();
+    void audibility();
+    void virtualize();
+    void virtualOffset();
+    void virtualFinished();
+    void destroyVoice();
+
+    Context _context;
+    Buffer _buffer;
+};
+
+VoicePoolTest::VoicePoolTest() {
+    addTests({&VoicePoolTest::bufferDuration,
+              &VoicePoolTest::audibility,
+              &VoicePoolTest::virtualize,
+              &VoicePoolTest::virtualOffset,
+              &VoicePoolTest::virtualFinished,
+              &VoicePoolTest::destroyVoice});
+
+    /* One second of silence */
+    Containers::Array<char> data{Containers::ValueInit, 22050};
+    _buffer.setData(Buffer::Format::Mono8, {data.data(), data.size()}, 22050);
+}
+
+void VoicePoolTest::bufferDuration() {
+    CORRADE_COMPARE(_buffer.duration(), 1.0f);
+    CORRADE_COMPARE(Buffer{}.duration(), 0.0f);
+}
+
+void VoicePoolTest::audibility() {
+    VoicePool pool{1};
+    Voice voice{pool};
+    voice.setGain(0.5f)
+        .setPriority(2.0f)
+        .setPosition({0.0f, 0.0f, 4.0f});
+
+    CORRADE_COMPARE(voice.audibility({}), 0.25f);
+
+    /* Clamped to reference distance */
+    voice.setReferenceDistance(8.0f);
+    CORRADE_COMPARE(voice.audibility({}), 1.0f);
+}
+
+void VoicePoolTest::virtualize() {
+    VoicePool pool{2};
+    CORRADE_COMPARE(pool.sourceCount(), 2);
+    CORRADE_COMPARE(pool.freeSourceCount(), 2);
+
+    Voice a{pool}, b{pool}, c{pool};
+    CORRADE_COMPARE(pool.voiceCount(), 3);
+    for(Voice* voice: {&a, &b, &c})
+        voice->setBuffer(&_buffer).setLooping(true).play();
+    a.setPriority(3.0f);
+    b.setPriority(1.0f);
+    c.setPriority(2.0f);
+
+    /* Nothing is assigned until update */
+    CORRADE_VERIFY(a.isVirtual());
+
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+    CORRADE_VERIFY(!c.isVirtual());
+    CORRADE_COMPARE(pool.freeSourceCount(), 0);
+
+    /* Priority change swaps the voices */
+    b.setPriority(4.0f);
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(!b.isVirtual());
+    CORRADE_VERIFY(c.isVirtual());
+
+    /* Stopped voice returns its source */
+    a.stop();
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(a.isVirtual());
+    CORRADE_VERIFY(!b.isVirtual());
+    CORRADE_VERIFY(!c.isVirtual());
+
+    /* Voices below threshold don't get a source even if there's one free */
+    c.setPosition({0.0f, 0.0f, 10000.0f});
+    pool.update({}, 0.0f);
+    CORRADE_VERIFY(c.isVirtual());
+    CORRADE_COMPARE(pool.freeSourceCount(), 1);
+}
+
+void VoicePoolTest::virtualOffset() {
+    VoicePool pool{1};
+    Voice voice{pool};
+    voice.setBuffer(&_buffer)
+        .setLooping(true)
+        .setPriority(0.0f)
+        .play();
+
+    pool.update({}, 0.25f);
+    CORRADE_VERIFY(voice.isVirtual());
+    CORRADE_COMPARE(voice.offset(), 0.25f);
+
+    /* Looping wraps around */
+    pool.update({}, 1.0f);
+    CORRADE_VERIFY(voice.isPlaying());
+    CORRADE_COMPARE(voice.offset(), 0.25f);
+}
+
+void VoicePoolTest::virtualFinished() {
+    VoicePool pool{1};
+    Voice voice{pool};
+    voice.setBuffer(&_buffer)
+        .setPriority(0.0f)
+        .play();
+
+    pool.update({}, 0.5f);
+    CORRADE_VERIFY(voice.isPlaying());
+
+    pool.update({}, 0.75f);
+    CORRADE_VERIFY(!voice.isPlaying());
+    CORRADE_COMPARE(voice.offset(), 0.0f);
+}
+
+void VoicePoolTest::destroyVoice() {
+    VoicePool pool{1};
+    Voice a{pool};
+    {
+        Voice b{pool};
+        b.setBuffer(&_buffer).setLooping(true).play();
+        pool.update({}, 0.0f);
+        CORRADE_VERIFY(!b.isVirtual());
+        CORRADE_COMPARE(pool.freeSourceCount(), 0);
+    }
+
+    CORRADE_COMPARE(pool.voiceCount(), 1);
+    CORRADE_COMPARE(pool.freeSourceCount(), 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::VoicePoolTest)
@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VoicePool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/Buffer.h"
+
+namespace Magnum { namespace Audio {
+
+Voice::Voice(VoicePool& pool): _pool(pool), _index{pool._voices.size()} {
+    pool._voices.push_back(this);
+}
+
+Voice::~Voice() {
+    if(_source) _pool._freeSources.push_back(&release());
+
+    /* Swap with the last one to avoid shifting the whole list */
+    Voice* const last = _pool._voices.back();
+    _pool._voices[_index] = last;
+    last->_index = _index;
+    _pool._voices.pop_back();
+}
+
+Voice& Voice::setBuffer(Buffer* const buffer) {
+    _buffer = buffer;
+    _duration = buffer ? buffer->duration() : 0.0f;
+    _offset = 0.0f;
+
+    /* Buffer can't be changed on a playing source */
+    if(_source) {
+        _source->stop();
+        _source->setBuffer(buffer);
+        if(_playing) _source->play();
+    }
+
+    return *this;
+}
+
+Voice& Voice::setPosition(const Vector3& position) {
+    _position = position;
+    if(_source) _source->setPosition(position);
+    return *this;
+}
+
+Voice& Voice::setGain(const Float gain) {
+    _gain = gain;
+    if(_source) _source->setGain(gain);
+    return *this;
+}
+
+Voice& Voice::setReferenceDistance(const Float distance) {
+    _referenceDistance = distance;
+    if(_source) _source->setReferenceDistance(distance);
+    return *this;
+}
+
+Voice& Voice::setRolloffFactor(const Float factor) {
+    _rolloffFactor = factor;
+    if(_source) _source->setRolloffFactor(factor);
+    return *this;
+}
+
+Voice& Voice::setLooping(const bool loop) {
+    _looping = loop;
+    if(_source) _source->setLooping(loop);
+    return *this;
+}
+
+Float Voice::offset() const {
+    return _source ? _source->offsetInSeconds() : _offset;
+}
+
+Voice& Voice::play() {
+    _playing = true;
+    _offset = 0.0f;
+    if(_source) _source->play();
+    return *this;
+}
+
+Voice& Voice::stop() {
+    _playing = false;
+    _offset = 0.0f;
+    if(_source) _source->stop();
+    return *this;
+}
+
+Float Voice::audibility(const Vector3& listenerPosition) const {
+    /* Inverse distance clamped model, see OpenAL 1.1 specification */
+    const Float distance = std::max((_position - listenerPosition).length(), _referenceDistance);
+    const Float denominator = _referenceDistance + _rolloffFactor*(distance - _referenceDistance);
+    const Float attenuation = denominator > 0.0f ? _referenceDistance/denominator : 1.0f;
+    return _gain*_priority*attenuation;
+}
+
+void Voice::acquire(Source& source) {
+    _source = &source;
+    source.setBuffer(_buffer)
+        .setPosition(_position)
+        .setGain(_gain)
+        .setReferenceDistance(_referenceDistance)
+        .setRolloffFactor(_rolloffFactor)
+        .setLooping(_looping)
+        .setOffsetInSeconds(_offset);
+    source.play();
+}
+
+Source& Voice::release() {
+    Source& source = *_source;
+    if(_playing) _offset = source.offsetInSeconds();
+    source.stop();
+    source.setBuffer(nullptr);
+    _source = nullptr;
+    return source;
+}
+
+VoicePool::VoicePool(const UnsignedInt sourceCount): _sources(sourceCount) {
+    _freeSources.reserve(sourceCount);
+    for(Source& source: _sources) _freeSources.push_back(&source);
+}
+
+VoicePool::~VoicePool() {
+    CORRADE_ASSERT(_voices.empty(), "Audio::VoicePool: destroyed while there are still" << _voices.size() << "voices", );
+}
+
+void VoicePool::update(const Vector3& listenerPosition, const Float timeDelta) {
+    /* Update playback state of all voices and gather the audible ones */
+    _candidates.clear();
+    for(Voice* const voice: _voices) {
+        if(voice->_source) {
+            /* Non-looping playback finished */
+            if(voice->_playing && voice->_source->state() == Source::State::Stopped) {
+                voice->_playing = false;
+                voice->_offset = 0.0f;
+            }
+
+        } else if(voice->_playing) {
+            voice->_offset += timeDelta;
+            if(voice->_offset >= voice->_duration) {
+                if(voice->_looping && voice->_duration > 0.0f)
+                    voice->_offset = std::fmod(voice->_offset, voice->_duration);
+                else {
+                    voice->_playing = false;
+                    voice->_offset = 0.0f;
+                }
+            }
+        }
+
+        const Float audibility = voice->_playing && voice->_buffer ?
+            voice->audibility(listenerPosition) : 0.0f;
+        if(audibility < _audibilityThreshold || !voice->_playing || !voice->_buffer) {
+            if(voice->_source) _freeSources.push_back(&voice->release());
+            continue;
+        }
+
+        _candidates.emplace_back(audibility, voice);
+    }
+
+    /* Pick the most audible voices, prefer the ones that already have a
+       source on ties to avoid needless switching */
+    const std::size_t realCount = std::min(_candidates.size(), _sources.size());
+    if(realCount < _candidates.size())
+        std::nth_element(_candidates.begin(), _candidates.begin() + realCount, _candidates.end(),
+            [](const std::pair<Float, Voice*>& a, const std::pair<Float, Voice*>& b) {
+                return a.first > b.first || (a.first == b.first && a.second->_source && !b.second->_source);
+            });
+
+    /* First release the sources of voices that became virtual so there is
+       enough free sources for the rest */
+    for(std::size_t i = realCount; i != _candidates.size(); ++i)
+        if(_candidates[i].second->_source)
+            _freeSources.push_back(&_candidates[i].second->release());
+
+    for(std::size_t i = 0; i != realCount; ++i) {
+        Voice& voice = *_candidates[i].second;
+        if(voice._source) continue;
+
+        CORRADE_INTERNAL_ASSERT(!_freeSources.empty());
+        voice.acquire(*_freeSources.back());
+        _freeSources.pop_back();
+    }
+}
+
+}}
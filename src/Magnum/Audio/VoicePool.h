@@ -0,0 +1,355 @@
+#ifndef Magnum_Audio_VoicePool_h
+#define Magnum_Audio_VoicePool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::Voice, @ref Magnum::Audio::VoicePool
+ */
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/visibility.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Logical sound emitter
+
+Keeps playback state of a sound without permanently occupying an OpenAL
+source. The @ref VoicePool it belongs to assigns a real @ref Source to the
+voice only while it is among the most audible ones, otherwise the voice is
+*virtual* and its playback position is just tracked in time. See
+@ref VoicePool for more information and example usage.
+
+Only properties exposed by this class are preserved when the voice loses its
+source. Properties set directly on @ref source() are not tracked and the
+source keeps them when it is given to another voice, so avoid changing
+anything other than what the voice itself manages.
+*/
+class MAGNUM_AUDIO_EXPORT Voice {
+    friend VoicePool;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Adds the voice to given pool. The voice is not playing and has no
+         * buffer attached.
+         */
+        explicit Voice(VoicePool& pool);
+
+        /** @brief Copying is not allowed */
+        Voice(const Voice&) = delete;
+
+        /** @brief Moving is not allowed */
+        Voice(Voice&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the voice from the pool and returns its source, if any.
+         */
+        ~Voice();
+
+        /** @brief Copying is not allowed */
+        Voice& operator=(const Voice&) = delete;
+
+        /** @brief Moving is not allowed */
+        Voice& operator=(Voice&&) = delete;
+
+        /** @brief Pool this voice belongs to */
+        VoicePool& pool() { return _pool; }
+        const VoicePool& pool() const { return _pool; } /**< @overload */
+
+        /**
+         * @brief Real source
+         *
+         * Source currently assigned to this voice or `nullptr` if the voice
+         * is virtual.
+         * @see @ref isVirtual()
+         */
+        Source* source() { return _source; }
+        const Source* source() const { return _source; } /**< @overload */
+
+        /**
+         * @brief Whether the voice is virtual
+         *
+         * Equivalent to `!source()`.
+         */
+        bool isVirtual() const { return !_source; }
+
+        /** @brief Attached buffer */
+        Buffer* buffer() const { return _buffer; }
+
+        /**
+         * @brief Attach buffer
+         * @return Reference to self (for method chaining)
+         */
+        Voice& setBuffer(Buffer* buffer);
+
+        /** @brief Position */
+        Vector3 position() const { return _position; }
+
+        /**
+         * @brief Set position
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `{0.0f, 0.0f, 0.0f}`.
+         * @see @ref Source::setPosition()
+         */
+        Voice& setPosition(const Vector3& position);
+
+        /** @brief Gain */
+        Float gain() const { return _gain; }
+
+        /**
+         * @brief Set gain
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Source::setGain()
+         */
+        Voice& setGain(Float gain);
+
+        /** @brief Reference distance */
+        Float referenceDistance() const { return _referenceDistance; }
+
+        /**
+         * @brief Set reference distance
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Source::setReferenceDistance()
+         */
+        Voice& setReferenceDistance(Float distance);
+
+        /** @brief Rolloff factor */
+        Float rolloffFactor() const { return _rolloffFactor; }
+
+        /**
+         * @brief Set rolloff factor
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Source::setRolloffFactor()
+         */
+        Voice& setRolloffFactor(Float factor);
+
+        /** @brief Priority */
+        Float priority() const { return _priority; }
+
+        /**
+         * @brief Set priority
+         * @return Reference to self (for method chaining)
+         *
+         * The priority multiplies the audibility of the voice when deciding
+         * which voices get a real source. Default is `1.0f`.
+         * @see @ref audibility()
+         */
+        Voice& setPriority(Float priority) {
+            _priority = priority;
+            return *this;
+        }
+
+        /** @brief Whether the playback is looping */
+        bool isLooping() const { return _looping; }
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `false`.
+         * @see @ref Source::setLooping()
+         */
+        Voice& setLooping(bool loop);
+
+        /** @brief Whether the voice is playing */
+        bool isPlaying() const { return _playing; }
+
+        /**
+         * @brief Playback offset in seconds
+         *
+         * If the voice is virtual, returns offset tracked by
+         * @ref VoicePool::update().
+         */
+        Float offset() const;
+
+        /**
+         * @brief Play
+         * @return Reference to self (for method chaining)
+         *
+         * Starts the playback from the beginning. If the voice is virtual, it
+         * gets a real source on next @ref VoicePool::update() if it is
+         * audible enough.
+         */
+        Voice& play();
+
+        /**
+         * @brief Stop
+         * @return Reference to self (for method chaining)
+         *
+         * The source, if any, is returned to the pool on next
+         * @ref VoicePool::update().
+         */
+        Voice& stop();
+
+        /**
+         * @brief Audibility from given listener position
+         *
+         * Gain multiplied by priority and by attenuation for given distance
+         * using the OpenAL default inverse distance clamped model.
+         */
+        Float audibility(const Vector3& listenerPosition) const;
+
+    private:
+        void acquire(Source& source);
+        Source& release();
+
+        VoicePool& _pool;
+        std::size_t _index;
+        Source* _source{};
+        Buffer* _buffer{};
+        Vector3 _position;
+        Float _gain{1.0f},
+            _referenceDistance{1.0f},
+            _rolloffFactor{1.0f},
+            _priority{1.0f},
+            _duration{},
+            _offset{};
+        bool _looping{}, _playing{};
+};
+
+/**
+@brief Pool of sources with voice virtualization
+
+Keeps a fixed number of OpenAL sources and distributes them among arbitrary
+number of @ref Voice instances. Each call to @ref update() evaluates
+audibility of all playing voices in a single pass, gives the real sources to
+the most audible ones and makes the rest virtual. Virtual voices don't occupy
+any hardware resources, only their playback position is advanced, so they
+continue at the right place once they become audible again.
+
+@code
+Audio::VoicePool pool{32};
+
+std::vector<std::unique_ptr<Audio::Voice>> voices;
+for(const Vector3& position: emitterPositions) {
+    voices.emplace_back(new Audio::Voice{pool});
+    voices.back()->setBuffer(&buffer)
+        .setPosition(position)
+        .setLooping(true)
+        .play();
+}
+
+// every frame:
+pool.update(listenerPosition, timeDelta);
+@endcode
+
+The sources are created upfront in the constructor, so no @fn_al{GenSources}
+is done at runtime.
+*/
+class MAGNUM_AUDIO_EXPORT VoicePool {
+    friend Voice;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param sourceCount   Count of real sources
+         */
+        explicit VoicePool(UnsignedInt sourceCount);
+
+        /** @brief Copying is not allowed */
+        VoicePool(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool(VoicePool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all voices were already destroyed.
+         */
+        ~VoicePool();
+
+        /** @brief Copying is not allowed */
+        VoicePool& operator=(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool& operator=(VoicePool&&) = delete;
+
+        /** @brief Count of real sources */
+        UnsignedInt sourceCount() const { return _sources.size(); }
+
+        /** @brief Count of sources not assigned to any voice */
+        UnsignedInt freeSourceCount() const { return _freeSources.size(); }
+
+        /** @brief Count of voices in the pool */
+        std::size_t voiceCount() const { return _voices.size(); }
+
+        /** @brief Audibility threshold */
+        Float audibilityThreshold() const { return _audibilityThreshold; }
+
+        /**
+         * @brief Set audibility threshold
+         * @return Reference to self (for method chaining)
+         *
+         * Voices with audibility below the threshold are virtual even if
+         * there are free sources. Default is `0.001f`.
+         * @see @ref Voice::audibility()
+         */
+        VoicePool& setAudibilityThreshold(Float threshold) {
+            _audibilityThreshold = threshold;
+            return *this;
+        }
+
+        /**
+         * @brief Update the voices
+         * @param listenerPosition  Listener position
+         * @param timeDelta         Time elapsed since previous call in
+         *      seconds
+         *
+         * Advances playback position of virtual voices, stops the finished
+         * ones, and redistributes the sources to the most audible voices.
+         * Voices keep their source if they stay among the most audible ones.
+         */
+        void update(const Vector3& listenerPosition, Float timeDelta);
+
+    private:
+        std::vector<Source> _sources;
+        std::vector<Source*> _freeSources;
+        std::vector<Voice*> _voices;
+        std::vector<std::pair<Float, Voice*>> _candidates;
+        Float _audibilityThreshold{0.001f};
+};
+
+}}
+
+#endif
@@ -0,0 +1,137 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/RenderbufferFormat.h"
+
+namespace Magnum {
+
+BatchRenderer::BatchRenderer(const Vector2i& size, const UnsignedInt inFlightCount, UnsignedInt encoderThreadCount): _size{size}, _framebuffer{{{}, size}}, _reader{inFlightCount}, _running{}, _finished{}, _stopped{} {
+    _color.setStorage(RenderbufferFormat::RGBA8, size);
+    _depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, size);
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, _color)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, _depthStencil);
+
+    if(!encoderThreadCount) encoderThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _threads.reserve(encoderThreadCount);
+    for(UnsignedInt i = 0; i != encoderThreadCount; ++i)
+        _threads.emplace_back(&BatchRenderer::run, this);
+}
+
+BatchRenderer::~BatchRenderer() {
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopped = true;
+    }
+    _jobCondition.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+}
+
+std::size_t BatchRenderer::pendingCount() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _inFlight.size() + _jobs.size() + _running;
+}
+
+std::size_t BatchRenderer::finishedCount() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _finished;
+}
+
+void BatchRenderer::submit(RenderFunction render, EncodeFunction encode) {
+    /* Hand over what's already done, then make room for the new read. Only
+       the readback is waited for, encoding runs independently. */
+    update();
+    if(_inFlight.size() == _reader.slotCount()) retireOldest();
+
+    _framebuffer.bind();
+    render(_framebuffer);
+
+    const UnsignedInt slot = _reader.read(_framebuffer, {{}, _size}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    _inFlight.emplace_back(slot, std::move(encode));
+}
+
+std::size_t BatchRenderer::update() {
+    std::size_t count = 0;
+    while(!_inFlight.empty() && _reader.isReady(_inFlight.front().first)) {
+        retireOldest();
+        ++count;
+    }
+
+    return count;
+}
+
+void BatchRenderer::finish() {
+    while(!_inFlight.empty()) retireOldest();
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _doneCondition.wait(lock, [this]() { return _jobs.empty() && !_running; });
+}
+
+void BatchRenderer::retireOldest() {
+    std::pair<UnsignedInt, EncodeFunction> oldest = std::move(_inFlight.front());
+    _inFlight.pop_front();
+    Image2D image = _reader.retrieve(oldest.first);
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _jobs.emplace_back(std::move(image), std::move(oldest.second));
+    }
+    _jobCondition.notify_one();
+}
+
+void BatchRenderer::run() {
+    for(;;) {
+        std::pair<Image2D, EncodeFunction> job{Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}, nullptr};
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _jobCondition.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+            if(_jobs.empty()) return;
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+            ++_running;
+        }
+
+        job.second(job.first);
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            --_running;
+            ++_finished;
+        }
+        _doneCondition.notify_all();
+    }
+}
+
+}
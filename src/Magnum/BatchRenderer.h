@@ -0,0 +1,215 @@
+#ifndef Magnum_BatchRenderer_h
+#define Magnum_BatchRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::BatchRenderer
+ */
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/FramebufferReader.h"
+#include "Magnum/Image.h"
+#include "Magnum/Renderbuffer.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Pipelined offscreen batch renderer
+
+Renders a stream of independent jobs (thumbnails, offline renders) into an
+offscreen framebuffer and overlaps rendering of one job with reading back
+the previous ones and encoding the ones before that, so neither the GPU nor
+the CPU waits for the other. Meant for long-running processes built on
+@ref Platform::WindowlessEglApplication "Platform::Windowless*Application",
+where the context, the shaders (possibly loaded from a
+@ref ProgramBinaryCache) and all other resources are created once and reused
+for all jobs.
+
+## Usage
+
+Each job consists of a render function, called on the thread owning the
+OpenGL context with the framebuffer bound, and an encode function, called
+with the rendered image on one of the encoder threads:
+@code
+BatchRenderer renderer{{256, 256}};
+Shaders::Phong shader;
+
+while(Job job = nextJob()) {
+    renderer.submit([&](Framebuffer& framebuffer) {
+        framebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+        drawModel(shader, job.model);
+    }, [job](Image2D& image) {
+        // save the image to job.filename using a per-thread converter...
+    });
+}
+
+renderer.finish();
+@endcode
+
+The read back is done using @ref FramebufferReader, @ref submit() blocks only
+if there are already @ref inFlightCount() reads in progress. Call
+@ref update() periodically when waiting for new jobs to pass the finished
+reads to the encoders.
+
+## Thread safety
+
+The encode functions are called concurrently from all encoder threads, they
+must not access any state shared with other threads without their own
+synchronization and must not use OpenGL. All other functions have to be
+called from the thread owning the OpenGL context.
+
+@requires_gles30 Pixel pack buffers are not available in OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_EXPORT BatchRenderer {
+    public:
+        /**
+         * @brief Render function
+         *
+         * Called with the framebuffer bound for drawing.
+         */
+        typedef std::function<void(Framebuffer&)> RenderFunction;
+
+        /** @brief Encode function */
+        typedef std::function<void(Image2D&)> EncodeFunction;
+
+        /**
+         * @brief Constructor
+         * @param size              Framebuffer size
+         * @param inFlightCount     Count of reads that can be in progress at
+         *      the same time
+         * @param encoderThreadCount Encoder thread count. If `0`, count of
+         *      hardware threads is used.
+         *
+         * Creates a framebuffer with @ref RenderbufferFormat::RGBA8 color and
+         * @ref RenderbufferFormat::Depth24Stencil8 depth/stencil
+         * attachment. The images are read as @ref PixelFormat::RGBA with
+         * @ref PixelType::UnsignedByte.
+         */
+        explicit BatchRenderer(const Vector2i& size, UnsignedInt inFlightCount = 3, UnsignedInt encoderThreadCount = 0);
+
+        /** @brief Copying is not allowed */
+        BatchRenderer(const BatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchRenderer(BatchRenderer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref finish() and joins the encoder threads.
+         */
+        ~BatchRenderer();
+
+        /** @brief Copying is not allowed */
+        BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchRenderer& operator=(BatchRenderer&&) = delete;
+
+        /** @brief Framebuffer size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Framebuffer */
+        Framebuffer& framebuffer() { return _framebuffer; }
+
+        /** @brief Count of reads that can be in progress at the same time */
+        UnsignedInt inFlightCount() const { return _reader.slotCount(); }
+
+        /** @brief Encoder thread count */
+        UnsignedInt encoderThreadCount() const { return _threads.size(); }
+
+        /**
+         * @brief Count of jobs not yet finished
+         *
+         * Jobs that are being read back or encoded.
+         */
+        std::size_t pendingCount();
+
+        /** @brief Count of jobs that were completely encoded */
+        std::size_t finishedCount();
+
+        /**
+         * @brief Submit a job
+         *
+         * Calls @ref update(), then, if there are @ref inFlightCount() reads
+         * in progress, waits for the oldest one to finish. Then binds the
+         * framebuffer, calls @p render and starts reading the result back.
+         * Once the read is finished, the image is passed to @p encode on one
+         * of the encoder threads.
+         */
+        void submit(RenderFunction render, EncodeFunction encode);
+
+        /**
+         * @brief Pass finished reads to the encoders
+         * @return Count of reads that were passed to the encoders
+         *
+         * Never waits for the GPU or the encoder threads.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Finish all jobs
+         *
+         * Waits until all reads are done and all images are encoded.
+         */
+        void finish();
+
+    private:
+        void MAGNUM_LOCAL retireOldest();
+        void MAGNUM_LOCAL run();
+
+        Vector2i _size;
+        Renderbuffer _color, _depthStencil;
+        Framebuffer _framebuffer;
+        FramebufferReader _reader;
+        std::deque<std::pair<UnsignedInt, EncodeFunction>> _inFlight;
+        std::vector<std::thread> _threads;
+
+        /* Shared with the encoder threads */
+        std::mutex _mutex;
+        std::condition_variable _jobCondition, _doneCondition;
+        std::deque<std::pair<Image2D, EncodeFunction>> _jobs;
+        std::size_t _running, _finished;
+        bool _stopped;
+};
+
+}
+#endif
+
+#endif
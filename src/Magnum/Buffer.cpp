@@ -36,6 +36,10 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
+#include "Implementation/MemoryState.h"
+#include "Implementation/MeshState.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 namespace Magnum {
 
@@ -51,6 +55,18 @@ Int Buffer::minMapAlignment() {
 
     return value;
 }
+
+Int Buffer::sparsePageSize() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_buffer>())
+        return 0;
+
+    GLint& value = Context::current().state().buffer->sparsePageSize;
+
+    if(value == 0)
+        glGetIntegerv(GL_SPARSE_BUFFER_PAGE_SIZE_ARB, &value);
+
+    return value;
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -190,8 +206,10 @@ Buffer::Buffer(const TargetHint targetHint): _targetHint{targetHint}, _flags{Obj
     , _mappedBuffer{nullptr}
     #endif
 {
-    (this->*Context::current().state().buffer->createImplementation)();
+    Implementation::State& state = Context::current().state();
+    (this->*state.buffer->createImplementation)();
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
+    state.memory->created(Context::MemoryObject::Buffer, _id);
 }
 
 void Buffer::createImplementationDefault() {
@@ -209,12 +227,21 @@ Buffer::~Buffer() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
-    GLuint* bindings = Context::current().state().buffer->bindings;
+    Implementation::State& state = Context::current().state();
+    GLuint* bindings = state.buffer->bindings;
 
     /* Remove all current bindings from the state */
     for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
         if(bindings[i] == _id) bindings[i] = 0;
 
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    /* Deleting the buffer detaches it from the default vertex array, so the
+       attributes using it need to be specified again */
+    for(Implementation::MeshState::VertexAttribute& attribute: state.mesh->vertexAttributes)
+        if(attribute.buffer == _id) attribute.buffer = 0;
+    #endif
+
+    state.memory->destroyed(Context::MemoryObject::Buffer, _id);
     glDeleteBuffers(1, &_id);
 }
 
@@ -261,6 +288,7 @@ void Buffer::bindInternal(const TargetHint target, Buffer* const buffer) {
     /* Bind the buffer otherwise, which will also finally create it */
     bound = id;
     if(buffer) buffer->_flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(bufferBinds);
     glBindBuffer(GLenum(target), id);
 }
 
@@ -279,6 +307,7 @@ auto Buffer::bindSomewhereInternal(const TargetHint hint) -> TargetHint {
     /* Bind the buffer to hint target otherwise */
     hintBinding = _id;
     _flags |= ObjectFlag::Created;
+    MAGNUM_STATISTICS_INCREMENT(bufferBinds);
     glBindBuffer(GLenum(hint), _id);
     return hint;
 }
@@ -320,12 +349,40 @@ Int Buffer::size() {
 }
 
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
-    (this->*Context::current().state().buffer->dataImplementation)(data.size(), data, usage);
+    Implementation::State& state = Context::current().state();
+    (this->*state.buffer->dataImplementation)(data.size(), data, usage);
+    MAGNUM_CAPTURE(bufferData(_id, data, GLenum(usage)));
+    /* Allocation-only calls with no data aren't counted as uploads */
+    if(data.data()) {
+        MAGNUM_STATISTICS_INCREMENT(bufferUploads);
+        MAGNUM_STATISTICS_ADD(bufferUploadBytes, data.size());
+    }
+    state.memory->setImageSize(Context::MemoryObject::Buffer, _id, 0, data.size());
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Buffer& Buffer::setStorage(const Containers::ArrayView<const void> data, const StorageFlags flags) {
+    Implementation::State& state = Context::current().state();
+    (this->*state.buffer->storageImplementation)(data.size(), data, flags);
+    /* Immutable storage has no usage, the replay picks a default one */
+    MAGNUM_CAPTURE(bufferData(_id, data, 0));
+    /* Allocation-only calls with no data aren't counted as uploads */
+    if(data.data()) {
+        MAGNUM_STATISTICS_INCREMENT(bufferUploads);
+        MAGNUM_STATISTICS_ADD(bufferUploadBytes, data.size());
+    }
+    /* Sparse storage has no memory until the pages are committed */
+    state.memory->setImageSize(Context::MemoryObject::Buffer, _id, 0, flags & StorageFlag::Sparse ? 0 : data.size());
+    return *this;
+}
+#endif
+
 Buffer& Buffer::setSubData(const GLintptr offset, const Containers::ArrayView<const void> data) {
     (this->*Context::current().state().buffer->subDataImplementation)(offset, data.size(), data);
+    MAGNUM_CAPTURE(bufferSubData(_id, offset, data));
+    MAGNUM_STATISTICS_INCREMENT(bufferUploads);
+    MAGNUM_STATISTICS_ADD(bufferUploadBytes, data.size());
     return *this;
 }
 
@@ -339,6 +396,24 @@ Buffer& Buffer::invalidateSubData(const GLintptr offset, const GLsizeiptr length
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Buffer& Buffer::commitPages(const GLintptr offset, const GLsizeiptr size) {
+    Implementation::State& state = Context::current().state();
+    (this->*state.buffer->pageCommitmentImplementation)(offset, size, GL_TRUE);
+    /* Committed ranges are tracked as separate images keyed by the offset,
+       the top bit distinguishes them from the whole storage */
+    state.memory->setImageSize(Context::MemoryObject::Buffer, _id, 1ull << 63 | UnsignedLong(offset), size);
+    return *this;
+}
+
+Buffer& Buffer::decommitPages(const GLintptr offset, const GLsizeiptr size) {
+    Implementation::State& state = Context::current().state();
+    (this->*state.buffer->pageCommitmentImplementation)(offset, size, GL_FALSE);
+    state.memory->setImageSize(Context::MemoryObject::Buffer, _id, 1ull << 63 | UnsignedLong(offset), 0);
+    return *this;
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 void* Buffer::map(const MapAccess access) {
     return (this->*Context::current().state().buffer->mapImplementation)(access);
@@ -496,6 +571,34 @@ void Buffer::dataImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, Buffe
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void Buffer::storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    glBufferStorage(GLenum(bindSomewhereInternal(_targetHint)), size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSA(const GLsizeiptr size, const GLvoid* const data, const StorageFlags flags) {
+    glNamedBufferStorage(_id, size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    _flags |= ObjectFlag::Created;
+    glNamedBufferStorageEXT(_id, size, data, GLbitfield(flags));
+}
+
+void Buffer::pageCommitmentImplementationDefault(const GLintptr offset, const GLsizeiptr size, const GLboolean commit) {
+    glBufferPageCommitmentARB(GLenum(bindSomewhereInternal(_targetHint)), offset, size, commit);
+}
+
+void Buffer::pageCommitmentImplementationDSA(const GLintptr offset, const GLsizeiptr size, const GLboolean commit) {
+    glNamedBufferPageCommitmentARB(_id, offset, size, commit);
+}
+
+void Buffer::pageCommitmentImplementationDSAEXT(const GLintptr offset, const GLsizeiptr size, const GLboolean commit) {
+    _flags |= ObjectFlag::Created;
+    glNamedBufferPageCommitmentEXT(_id, offset, size, commit);
+}
+#endif
+
 void Buffer::subDataImplementationDefault(GLintptr offset, GLsizeiptr size, const GLvoid* data) {
     glBufferSubData(GLenum(bindSomewhereInternal(_targetHint)), offset, size, data);
 }
@@ -638,6 +741,9 @@ Debug& operator<<(Debug& debug, Buffer::TargetHint value) {
         #endif
         #endif
         _c(ElementArray)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(Parameter)
+        #endif
         #ifndef MAGNUM_TARGET_GLES2
         _c(PixelPack)
         _c(PixelUnpack)
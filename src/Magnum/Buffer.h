@@ -228,6 +228,9 @@ functions do nothing.
  */
 class MAGNUM_EXPORT Buffer: public AbstractObject {
     friend Implementation::BufferState;
+    #ifndef MAGNUM_TARGET_GLES2
+    friend TextureStreamer;
+    #endif
 
     public:
         /**
@@ -293,6 +296,17 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             /** Used for storing vertex indices. */
             ElementArray = GL_ELEMENT_ARRAY_BUFFER,
 
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Used for supplying draw count for indirect drawing.
+             * @see @ref MeshView::drawIndirect(AbstractShaderProgram&, Mesh&, Buffer&, GLintptr, Buffer&, GLintptr, Int, GLsizei)
+             * @requires_extension Extension @extension{ARB,indirect_parameters}
+             * @requires_gl Indirect draw count is not available in OpenGL ES
+             *      or WebGL.
+             */
+            Parameter = GL_PARAMETER_BUFFER_ARB,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES2
             /**
              * Target for pixel pack operations.
@@ -594,6 +608,30 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             #else
             Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT_EXT
             #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            ,
+            /**
+             * Allow the buffer to stay mapped while it's used by OpenGL. The
+             * buffer storage must be created with @ref setStorage() and
+             * @ref StorageFlag::MapPersistent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Persistent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Persistent = GL_MAP_PERSISTENT_BIT,
+
+            /**
+             * Persistent mapping is coherent, i.e. writes to the mapped
+             * memory are visible to OpenGL without any explicit flushing. The
+             * buffer storage must be created with @ref setStorage() and
+             * @ref StorageFlag::MapCoherent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Persistent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Coherent = GL_MAP_COHERENT_BIT
+            #endif
         };
 
         /**
@@ -608,6 +646,55 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         typedef Containers::EnumSet<MapFlag> MapFlags;
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Buffer storage flag
+         *
+         * @see @ref StorageFlags, @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL
+         *      ES and WebGL.
+         */
+        enum class StorageFlag: GLbitfield {
+            /** Allow the buffer to be mapped for reading. */
+            MapRead = GL_MAP_READ_BIT,
+
+            /** Allow the buffer to be mapped for writing. */
+            MapWrite = GL_MAP_WRITE_BIT,
+
+            /**
+             * Allow the buffer to be mapped with @ref MapFlag::Persistent.
+             */
+            MapPersistent = GL_MAP_PERSISTENT_BIT,
+
+            /** Allow the buffer to be mapped with @ref MapFlag::Coherent. */
+            MapCoherent = GL_MAP_COHERENT_BIT,
+
+            /** Allow the buffer contents to be updated with @ref setSubData(). */
+            DynamicStorage = GL_DYNAMIC_STORAGE_BIT,
+
+            /** Prefer to allocate the storage in client memory. */
+            ClientStorage = GL_CLIENT_STORAGE_BIT,
+
+            /**
+             * Only reserve virtual address space for the storage, physical
+             * memory is allocated with @ref commitPages().
+             * @requires_extension Extension @extension{ARB,sparse_buffer}
+             */
+            Sparse = GL_SPARSE_STORAGE_BIT_ARB
+        };
+
+        /**
+         * @brief Buffer storage flags
+         *
+         * @see @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL
+         *      ES and WebGL.
+         */
+        typedef Containers::EnumSet<StorageFlag> StorageFlags;
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Minimal supported mapping alignment
@@ -622,6 +709,22 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         static Int minMapAlignment();
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Sparse buffer page size
+         *
+         * Offsets and sizes passed to @ref commitPages() and
+         * @ref decommitPages() need to be multiples of this value. The result
+         * is cached, repeated queries don't result in repeated OpenGL calls.
+         * If extension @extension{ARB,sparse_buffer} is not available,
+         * returns `0`.
+         * @see @fn_gl{Get} with @def_gl_extension{SPARSE_BUFFER_PAGE_SIZE,ARB,sparse_buffer}
+         * @requires_gl Sparse buffers are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static Int sparsePageSize();
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES2
         #ifndef MAGNUM_TARGET_WEBGL
         /**
@@ -1121,6 +1224,30 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set immutable buffer storage
+         * @param data      Initial data. If only size is specified and
+         *      pointer is `nullptr`, the storage is left uninitialized.
+         * @param flags     Storage flags
+         * @return Reference to self (for method chaining)
+         *
+         * After calling this function the buffer size can't be changed
+         * anymore and @ref setData() can't be used. If neither
+         * @extension{ARB,direct_state_access} (part of OpenGL 4.5) nor
+         * @extension{EXT,direct_state_access} desktop extension is
+         * available, the buffer is bound to hinted target before the
+         * operation (if not already).
+         * @see @ref setTargetHint(), @fn_gl2{NamedBufferStorage,BufferStorage},
+         *      @fn_gl_extension{NamedBufferStorage,EXT,direct_state_access},
+         *      eventually @fn_gl{BindBuffer} and @fn_gl{BufferStorage}
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL
+         *      ES and WebGL, use @ref setData() instead.
+         */
+        Buffer& setStorage(Containers::ArrayView<const void> data, StorageFlags flags);
+        #endif
+
         /**
          * @brief Set buffer subdata
          * @param offset    Offset in the buffer
@@ -1171,6 +1298,48 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
          */
         Buffer& invalidateSubData(GLintptr offset, GLsizeiptr length);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Commit sparse buffer pages
+         * @param offset    Offset into the buffer
+         * @param size      Size of the committed range
+         * @return Reference to self (for method chaining)
+         *
+         * Allocates physical memory for given range of a buffer created with
+         * @ref setStorage() and @ref StorageFlag::Sparse. Both @p offset and
+         * @p size need to be multiples of @ref sparsePageSize(), @p size can
+         * be unaligned only if the range extends to the end of the buffer.
+         * Contents of newly committed pages are undefined. If neither
+         * @extension{ARB,direct_state_access} (part of OpenGL 4.5) nor
+         * @extension{EXT,direct_state_access} desktop extension is
+         * available, the buffer is bound to hinted target before the
+         * operation (if not already).
+         * @see @ref decommitPages(), @ref setTargetHint(),
+         *      @fn_gl_extension{NamedBufferPageCommitment,ARB,sparse_buffer},
+         *      @fn_gl_extension{NamedBufferPageCommitment,EXT,direct_state_access},
+         *      eventually @fn_gl{BindBuffer} and
+         *      @fn_gl_extension{BufferPageCommitment,ARB,sparse_buffer}
+         * @requires_extension Extension @extension{ARB,sparse_buffer}
+         * @requires_gl Sparse buffers are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Buffer& commitPages(GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Decommit sparse buffer pages
+         * @param offset    Offset into the buffer
+         * @param size      Size of the decommitted range
+         * @return Reference to self (for method chaining)
+         *
+         * Releases physical memory of given range, the contents are lost.
+         * See @ref commitPages() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_buffer}
+         * @requires_gl Sparse buffers are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Buffer& decommitPages(GLintptr offset, GLsizeiptr size);
+        #endif
+
         #ifndef MAGNUM_TARGET_WEBGL
         /**
          * @brief Map buffer to client memory
@@ -1383,6 +1552,16 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         void MAGNUM_LOCAL dataImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, BufferUsage usage);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSA(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+
+        void MAGNUM_LOCAL pageCommitmentImplementationDefault(GLintptr offset, GLsizeiptr size, GLboolean commit);
+        void MAGNUM_LOCAL pageCommitmentImplementationDSA(GLintptr offset, GLsizeiptr size, GLboolean commit);
+        void MAGNUM_LOCAL pageCommitmentImplementationDSAEXT(GLintptr offset, GLsizeiptr size, GLboolean commit);
+        #endif
+
         void MAGNUM_LOCAL subDataImplementationDefault(GLintptr offset, GLsizeiptr size, const GLvoid* data);
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL subDataImplementationDSA(GLintptr offset, GLsizeiptr size, const GLvoid* data);
@@ -1435,6 +1614,9 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
 
 #ifndef MAGNUM_TARGET_WEBGL
 CORRADE_ENUMSET_OPERATORS(Buffer::MapFlags)
+#ifndef MAGNUM_TARGET_GLES
+CORRADE_ENUMSET_OPERATORS(Buffer::StorageFlags)
+#endif
 #endif
 
 /** @debugoperatorclassenum{Magnum::Buffer,Magnum::Buffer::TargetHint} */
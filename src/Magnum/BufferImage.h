@@ -90,6 +90,22 @@ template<UnsignedInt dimensions> class BufferImage {
         #endif
         #endif
 
+        /**
+         * @brief Construct from existing buffer
+         * @param storage           Storage of pixel data
+         * @param format            Format of pixel data
+         * @param type              Data type of pixel data
+         * @param size              Image size
+         * @param buffer            Buffer containing image data
+         * @param dataSize          Buffer data size
+         *
+         * Takes ownership of @p buffer instead of allocating a new one. Use
+         * @ref release() to get the buffer back, for example to upload
+         * several images from one buffer, each located at different offset
+         * specified using @ref PixelStorage::setSkip().
+         */
+        explicit BufferImage(PixelStorage storage, PixelFormat format, PixelType type, const VectorTypeFor<dimensions, Int>& size, Buffer&& buffer, std::size_t dataSize) noexcept;
+
         /**
          * @brief Constructor
          * @param storage           Storage of pixel data
@@ -155,6 +171,15 @@ template<UnsignedInt dimensions> class BufferImage {
         /** @brief Image buffer */
         Buffer& buffer() { return _buffer; }
 
+        /**
+         * @brief Release image buffer
+         *
+         * Returns the buffer and resets @ref dataSize() to `0`. The image
+         * has no buffer afterwards and it's not usable until
+         * @ref setData() is called with non-empty data.
+         */
+        Buffer release();
+
         /**
          * @brief Set image data
          * @param storage           Storage of pixel data
@@ -0,0 +1,94 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Magnum {
+
+namespace {
+    /* Enough for all math types, new[] guarantees the same for block starts */
+    constexpr std::size_t UniformAlignment = 16;
+}
+
+CommandBuffer::CommandBuffer(const std::size_t blockSize): _blockSize{blockSize}, _currentBlock{}, _blockOffset{} {}
+
+std::size_t CommandBuffer::arenaSize() const {
+    std::size_t size = _blockOffset;
+    for(std::size_t i = 0; i < _currentBlock && i != _blocks.size(); ++i)
+        size += _blocks[i].size();
+    return size;
+}
+
+std::size_t CommandBuffer::arenaCapacity() const {
+    std::size_t size = 0;
+    for(const Containers::Array<char>& block: _blocks) size += block.size();
+    return size;
+}
+
+CommandBuffer& CommandBuffer::record(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const RenderState* const state, const Float depth, const UniformSetup setup, const void* const uniforms, const std::size_t uniformSize) {
+    void* data = nullptr;
+    if(uniformSize) {
+        data = allocate(uniformSize);
+        std::memcpy(data, uniforms, uniformSize);
+    }
+
+    _packets.push_back({&shader, &mesh, _textures.size(), textures.size(), state, depth, setup, data});
+    _textures.insert(_textures.end(), textures.begin(), textures.end());
+    return *this;
+}
+
+void* CommandBuffer::allocate(const std::size_t size) {
+    const std::size_t offset = (_blockOffset + UniformAlignment - 1) & ~(UniformAlignment - 1);
+
+    /* Fits into current block */
+    if(_currentBlock < _blocks.size() && offset + size <= _blocks[_currentBlock].size()) {
+        _blockOffset = offset + size;
+        return _blocks[_currentBlock] + offset;
+    }
+
+    /* Move to next block, reusing it if it's large enough, otherwise
+       allocating a new one in its place. The rest of current block is
+       wasted. */
+    if(_currentBlock < _blocks.size()) ++_currentBlock;
+    if(_currentBlock == _blocks.size())
+        _blocks.emplace_back(std::max(_blockSize, size));
+    else if(_blocks[_currentBlock].size() < size)
+        _blocks[_currentBlock] = Containers::Array<char>(size);
+
+    _blockOffset = size;
+    return _blocks[_currentBlock];
+}
+
+void CommandBuffer::clear() {
+    _packets.clear();
+    _textures.clear();
+    _currentBlock = 0;
+    _blockOffset = 0;
+}
+
+}
@@ -0,0 +1,233 @@
+#ifndef Magnum_CommandBuffer_h
+#define Magnum_CommandBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::CommandBuffer
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Draw command buffer
+
+All GL wrappers need to be called on the thread owning the context, but
+preparing the draws --- scene traversal, culling, computing the uniform
+values --- doesn't. The command buffer records draw packets without touching
+GL at all, so it can be filled on a worker thread and then replayed on the GL
+thread through @ref RenderQueue, which sorts the packets by state and submits
+them.
+
+## Usage
+
+Each worker thread records into its own buffer, the buffers aren't
+thread-safe. Each packet consists of shader, mesh, textures, optional
+@ref RenderState and a blob of uniform data together with a function that
+applies them to the shader right before the draw:
+@code
+struct PhongUniforms {
+    Matrix4 transformationMatrix, projectionMatrix;
+    Color4 diffuseColor;
+};
+
+void applyPhongUniforms(Shaders::Phong& shader, const PhongUniforms& uniforms) {
+    shader.setTransformationMatrix(uniforms.transformationMatrix)
+        .setNormalMatrix(uniforms.transformationMatrix.rotation())
+        .setProjectionMatrix(uniforms.projectionMatrix)
+        .setDiffuseColor(uniforms.diffuseColor);
+}
+
+std::vector<CommandBuffer> buffers(threadCount);
+
+// on worker thread i
+for(Object* object: objectsForThread[i]) {
+    if(!isVisible(*object)) continue;
+
+    buffers[i].record(phong, object->mesh(), {&object->texture()}, &opaqueState,
+        object->depth(), PhongUniforms{...}, applyPhongUniforms);
+}
+
+// on the GL thread, after the workers are joined
+for(CommandBuffer& buffer: buffers) queue.add(buffer);
+queue.draw();
+for(CommandBuffer& buffer: buffers) buffer.clear();
+@endcode
+
+The shader, mesh, textures and render state are referenced by pointer and need
+to be kept alive until the packets are drawn. The uniform data are copied
+byte-wise into the buffer, so the type has to be trivially copyable.
+
+## Memory
+
+The uniform data are stored in a linear arena made of fixed-size blocks.
+@ref clear() doesn't free the blocks, so after the first few frames recording
+doesn't allocate at all. As the packets added to a @ref RenderQueue point into
+the arena, the buffer can be cleared only after the queue is drawn or
+cleared.
+*/
+class MAGNUM_EXPORT CommandBuffer {
+    public:
+        /**
+         * @brief Uniform setup function
+         *
+         * Receives the shader and a pointer to the uniform data recorded with
+         * the packet.
+         */
+        typedef void(*UniformSetup)(AbstractShaderProgram&, const void*);
+
+        /**
+         * @brief Draw packet
+         *
+         * @see @ref packets()
+         */
+        struct Packet {
+            AbstractShaderProgram* shader;  /**< @brief Shader */
+            Mesh* mesh;                     /**< @brief Mesh */
+
+            /** @brief Offset of the textures in @ref textures() */
+            std::size_t textureOffset;
+
+            std::size_t textureCount;       /**< @brief Texture count */
+            const RenderState* state;       /**< @brief Render state or `nullptr` */
+            Float depth;                    /**< @brief Distance from camera */
+            UniformSetup setup;             /**< @brief Uniform setup function or `nullptr` */
+            const void* uniforms;           /**< @brief Uniform data */
+        };
+
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of one arena block in bytes
+         *
+         * The blocks are allocated on first use. Uniform blobs larger than
+         * @p blockSize get a dedicated block.
+         */
+        explicit CommandBuffer(std::size_t blockSize = 65536);
+
+        /** @brief Copying is not allowed */
+        CommandBuffer(const CommandBuffer&) = delete;
+
+        /** @brief Move constructor */
+        CommandBuffer(CommandBuffer&&) = default;
+
+        /** @brief Copying is not allowed */
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /** @brief Move assignment */
+        CommandBuffer& operator=(CommandBuffer&&) = default;
+
+        /** @brief Count of recorded packets */
+        std::size_t size() const { return _packets.size(); }
+
+        /** @brief Whether the buffer is empty */
+        bool isEmpty() const { return _packets.empty(); }
+
+        /** @brief Recorded packets */
+        const std::vector<Packet>& packets() const { return _packets; }
+
+        /** @brief Textures of all recorded packets */
+        const std::vector<AbstractTexture*>& textures() const { return _textures; }
+
+        /**
+         * @brief Arena memory used by recorded uniform data
+         *
+         * Includes the alignment padding.
+         * @see @ref arenaCapacity()
+         */
+        std::size_t arenaSize() const;
+
+        /** @brief Arena memory allocated */
+        std::size_t arenaCapacity() const;
+
+        /**
+         * @brief Record a draw packet
+         * @param shader        Shader to draw with
+         * @param mesh          Mesh to draw
+         * @param textures      Textures to bind to consecutive layers
+         *      starting from `0`. Null pointers are skipped.
+         * @param state         Render state to apply before the draw or
+         *      `nullptr` to leave the state untouched
+         * @param depth         Distance from camera, see
+         *      @ref RenderQueue::add()
+         * @param setup         Uniform setup function or `nullptr`
+         * @param uniforms      Uniform data to copy into the arena
+         * @param uniformSize   Size of the uniform data
+         * @return Reference to self (for method chaining)
+         *
+         * Doesn't call any GL functions. The uniform data are aligned to 16
+         * bytes in the arena.
+         */
+        CommandBuffer& record(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const RenderState* state, Float depth, UniformSetup setup, const void* uniforms, std::size_t uniformSize);
+
+        /**
+         * @brief Record a draw packet with typed uniform data
+         *
+         * Convenience alternative to the above, the @p setup function gets
+         * the shader and uniforms already cast to the right types.
+         */
+        template<class Shader, class T> CommandBuffer& record(Shader& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const RenderState* state, Float depth, const T& uniforms, void(*setup)(Shader&, const T&));
+
+        /**
+         * @brief Clear the buffer
+         *
+         * Keeps the arena blocks for reuse.
+         */
+        void clear();
+
+    private:
+        template<class Shader, class T> struct TypedUniforms {
+            void(*setup)(Shader&, const T&);
+            T uniforms;
+        };
+
+        template<class Shader, class T> static void typedSetup(AbstractShaderProgram& shader, const void* data) {
+            auto typed = static_cast<const TypedUniforms<Shader, T>*>(data);
+            typed->setup(static_cast<Shader&>(shader), typed->uniforms);
+        }
+
+        void* allocate(std::size_t size);
+
+        std::size_t _blockSize;
+        std::vector<Packet> _packets;
+        std::vector<AbstractTexture*> _textures;
+        std::vector<Containers::Array<char>> _blocks;
+        std::size_t _currentBlock, _blockOffset;
+};
+
+template<class Shader, class T> CommandBuffer& CommandBuffer::record(Shader& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const RenderState* state, const Float depth, const T& uniforms, void(*setup)(Shader&, const T&)) {
+    const TypedUniforms<Shader, T> typed{setup, uniforms};
+    return record(shader, mesh, textures, state, depth, typedSetup<Shader, T>, &typed, sizeof(typed));
+}
+
+}
+
+#endif
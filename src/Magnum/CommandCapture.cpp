@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandCapture.h"
+
+#include <cstring>
+#include <ostream>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Implementation/State.h"
+
+namespace Magnum {
+
+namespace {
+    /* File signature followed by format version and capture flags */
+    constexpr const char Signature[4]{'M', 'G', 'C', 'P'};
+    constexpr UnsignedInt Version = 1;
+    constexpr std::size_t HeaderSize = sizeof(Signature) + 2*sizeof(UnsignedInt);
+
+    /* Each command is a byte followed by size of the record and payload */
+    constexpr std::size_t CommandHeaderSize = sizeof(UnsignedByte) + sizeof(UnsignedInt);
+}
+
+std::size_t CommandCapture::recordSize(const Command command) {
+    switch(command) {
+        case Command::EndFrame: return 0;
+        case Command::BufferData: return sizeof(BufferDataRecord);
+        case Command::BufferSubData: return sizeof(BufferSubDataRecord);
+        case Command::TextureStorage: return sizeof(TextureStorageRecord);
+        case Command::TextureSubImage: return sizeof(TextureSubImageRecord);
+        case Command::Draw: return sizeof(DrawRecord);
+        case Command::UseProgram: return sizeof(UseProgramRecord);
+        case Command::Uniform: return sizeof(UniformRecord);
+        case Command::BindTexture: return sizeof(BindTextureRecord);
+        case Command::BindFramebuffer: return sizeof(BindFramebufferRecord);
+        case Command::State: return sizeof(StateRecord);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+CommandCapture::CommandCapture(std::ostream& out, const UnsignedInt frameCount, const Flags flags): _out(out), _state{}, _frameCount{frameCount}, _capturedFrameCount{}, _commandCount{}, _flags{flags}, _capturing{true} {
+    if(Context::hasCurrent()) {
+        Implementation::State& state = Context::current().state();
+        CORRADE_ASSERT(!state.capture,
+            "CommandCapture: another capture is already active on current context", );
+        state.capture = this;
+        _state = &state;
+    }
+
+    const UnsignedInt flagsValue = UnsignedInt(flags);
+    _out.write(Signature, sizeof(Signature));
+    _out.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+    _out.write(reinterpret_cast<const char*>(&flagsValue), sizeof(flagsValue));
+}
+
+CommandCapture::~CommandCapture() { stop(); }
+
+void CommandCapture::nextFrame() {
+    if(!_capturing) return;
+
+    record(Command::EndFrame, nullptr, 0);
+    if(++_capturedFrameCount == _frameCount) stop();
+}
+
+void CommandCapture::stop() {
+    if(!_capturing) return;
+
+    if(_state && _state->capture == this) _state->capture = nullptr;
+    _state = nullptr;
+    _capturing = false;
+    _out.flush();
+}
+
+void CommandCapture::record(const Command command, const void* const record, const std::size_t size, const Containers::ArrayView<const void> payload) {
+    const UnsignedByte commandValue = UnsignedByte(command);
+    const UnsignedInt bodySize = size + payload.size();
+    _out.write(reinterpret_cast<const char*>(&commandValue), sizeof(commandValue));
+    _out.write(reinterpret_cast<const char*>(&bodySize), sizeof(bodySize));
+    if(size) _out.write(static_cast<const char*>(record), size);
+    if(payload.size()) _out.write(static_cast<const char*>(payload.data()), payload.size());
+    ++_commandCount;
+}
+
+void CommandCapture::bufferData(const GLuint buffer, const Containers::ArrayView<const void> data, const GLenum usage) {
+    const BufferDataRecord r{data.size(), buffer, usage};
+    record(Command::BufferData, &r, sizeof(r), _flags & Flag::ElidePayload || !data.data() ? Containers::ArrayView<const void>{} : data);
+}
+
+void CommandCapture::bufferSubData(const GLuint buffer, const GLintptr offset, const Containers::ArrayView<const void> data) {
+    const BufferSubDataRecord r{UnsignedLong(offset), data.size(), buffer, 0};
+    record(Command::BufferSubData, &r, sizeof(r), _flags & Flag::ElidePayload ? Containers::ArrayView<const void>{} : data);
+}
+
+void CommandCapture::textureStorage(const GLuint texture, const GLenum target, const GLsizei levels, const GLenum format, const Vector3i& size) {
+    const TextureStorageRecord r{texture, target, levels, format, size};
+    record(Command::TextureStorage, &r, sizeof(r));
+}
+
+void CommandCapture::textureSubImage(const GLuint texture, const GLenum target, const GLint level, const Vector3i& offset, const Vector3i& size, const GLenum format, const GLenum type, const Int alignment, const Containers::ArrayView<const void> data) {
+    const TextureSubImageRecord r{data.size(), texture, target, level, offset, size, format, type, alignment};
+    record(Command::TextureSubImage, &r, sizeof(r), _flags & Flag::ElidePayload || !data.data() ? Containers::ArrayView<const void>{} : data);
+}
+
+void CommandCapture::draw(const GLuint mesh, const GLenum primitive, const Int count, const Int baseVertex, const Int instanceCount, const GLuint indexBuffer, const GLenum indexType, const GLintptr indexOffset) {
+    const DrawRecord r{UnsignedLong(indexOffset), mesh, primitive, count, baseVertex, instanceCount, indexBuffer, indexType, 0};
+    record(Command::Draw, &r, sizeof(r));
+}
+
+void CommandCapture::useProgram(const GLuint program) {
+    const UseProgramRecord r{program};
+    record(Command::UseProgram, &r, sizeof(r));
+}
+
+void CommandCapture::uniform(const GLuint program, const Int location, const GLenum type, const std::size_t count, const Containers::ArrayView<const void> values) {
+    const UniformRecord r{program, location, type, UnsignedInt(count)};
+    record(Command::Uniform, &r, sizeof(r), values);
+}
+
+void CommandCapture::bindTexture(const Int unit, const GLuint texture) {
+    const BindTextureRecord r{unit, texture};
+    record(Command::BindTexture, &r, sizeof(r));
+}
+
+void CommandCapture::bindFramebuffer(const GLenum target, const GLuint framebuffer) {
+    const BindFramebufferRecord r{target, framebuffer};
+    record(Command::BindFramebuffer, &r, sizeof(r));
+}
+
+void CommandCapture::state(const StateFunction function, const UnsignedInt argument0, const UnsignedInt argument1, const UnsignedInt argument2, const UnsignedInt argument3) {
+    const StateRecord r{function, {argument0, argument1, argument2, argument3}};
+    record(Command::State, &r, sizeof(r));
+}
+
+CommandCaptureReader::CommandCaptureReader(const Containers::ArrayView<const char> data): _data{data}, _position{HeaderSize}, _command{}, _valid{false} {
+    if(data.size() < HeaderSize || std::memcmp(data.data(), Signature, sizeof(Signature)) != 0) {
+        Error() << "CommandCaptureReader: invalid file signature";
+        return;
+    }
+
+    UnsignedInt version, flags;
+    std::memcpy(&version, data + sizeof(Signature), sizeof(version));
+    std::memcpy(&flags, data + sizeof(Signature) + sizeof(version), sizeof(flags));
+    if(version != Version) {
+        Error() << "CommandCaptureReader: unsupported version" << version;
+        return;
+    }
+
+    _flags = CommandCapture::Flags(CommandCapture::Flag(flags));
+    _valid = true;
+}
+
+bool CommandCaptureReader::nextCommand() {
+    _record = _payload = nullptr;
+    if(!_valid || _position == _data.size()) return false;
+
+    if(_data.size() - _position < CommandHeaderSize) {
+        Error() << "CommandCaptureReader::nextCommand(): truncated command at offset" << _position;
+        return _valid = false;
+    }
+
+    UnsignedByte command;
+    UnsignedInt size;
+    std::memcpy(&command, _data + _position, sizeof(command));
+    std::memcpy(&size, _data + _position + sizeof(command), sizeof(size));
+    if(command < UnsignedByte(CommandCapture::Command::EndFrame) || command > UnsignedByte(CommandCapture::Command::State)) {
+        Error() << "CommandCaptureReader::nextCommand(): unknown command" << UnsignedInt(command) << "at offset" << _position;
+        return _valid = false;
+    }
+
+    _command = CommandCapture::Command(command);
+    const std::size_t recordSize = CommandCapture::recordSize(_command);
+    if(size < recordSize || _data.size() - _position - CommandHeaderSize < size) {
+        Error() << "CommandCaptureReader::nextCommand(): truncated command at offset" << _position;
+        return _valid = false;
+    }
+
+    _position += CommandHeaderSize;
+    _record = _data.slice(_position, _position + recordSize);
+    _payload = _data.slice(_position + recordSize, _position + size);
+    _position += size;
+    return true;
+}
+
+void CommandCaptureReader::copyRecord(void* const out, const std::size_t size) const {
+    CORRADE_ASSERT(size == _record.size(),
+        "CommandCaptureReader::record(): expected a record of" << _record.size() << "bytes but got" << size, );
+    std::memcpy(out, _record.data(), size);
+}
+
+}
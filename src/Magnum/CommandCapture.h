@@ -0,0 +1,464 @@
+#ifndef Magnum_CommandCapture_h
+#define Magnum_CommandCapture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::CommandCapture, @ref Magnum::CommandCaptureReader
+ */
+
+#include <iosfwd>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum {
+
+namespace Implementation { struct State; }
+
+class Renderer;
+
+/**
+@brief GL command capture
+
+Records the sequence of GL operations issued through Magnum for a given count
+of frames into a compact binary stream, which can be later inspected with
+@ref CommandCaptureReader or replayed with timing on a different machine
+using the @ref magnum-capturereplay "magnum-capturereplay" utility. Useful for
+reproducing driver-side performance issues without the original application.
+
+The capture is compiled in only if the library is built with
+@ref MAGNUM_BUILD_CAPTURE, otherwise only frame markers are recorded.
+
+## Basic usage
+
+Create the capture on a stream after the context is created and call
+@ref nextFrame() after each `swapBuffers()`. After given count of frames the
+capture stops itself:
+@code
+std::ofstream file{"frames.capture", std::ios::binary};
+CommandCapture capture{file, 10};
+
+// in drawEvent()
+// ...
+swapBuffers();
+capture.nextFrame();
+@endcode
+
+## Captured commands
+
+The following operations are recorded at the same places where
+@ref Context::statistics() are counted, each as a @ref Command followed by
+a fixed-size record and an optional payload:
+
+-   buffer uploads through @ref Buffer::setData() and
+    @ref Buffer::setSubData(), see @ref BufferDataRecord and
+    @ref BufferSubDataRecord
+-   two-dimensional texture storage allocation and subimage uploads, see
+    @ref TextureStorageRecord and @ref TextureSubImageRecord
+-   draw calls of @ref Mesh and @ref MeshView, see @ref DrawRecord
+-   shader switches and uniform uploads, see @ref UseProgramRecord and
+    @ref UniformRecord
+-   texture and framebuffer binds, see @ref BindTextureRecord and
+    @ref BindFramebufferRecord
+-   the most common @ref Renderer state changes, see @ref StateRecord
+
+Buffer and texture payloads are usually the largest part of the capture. With
+@ref Flag::ElidePayload only their sizes are recorded and the replay uploads
+zero-filled data of the same size instead. Uniform values are always
+recorded.
+
+The records are stored with native byte order and layout, so the capture is
+meant to be replayed on a machine of the same architecture.
+
+Only one capture can be active for given context at a time. The capture has to
+be stopped or destroyed before the context is destroyed.
+@see @ref Context::statistics()
+*/
+class MAGNUM_EXPORT CommandCapture {
+    public:
+        /**
+         * @brief Capture flag
+         *
+         * @see @ref Flags, @ref CommandCapture()
+         */
+        enum class Flag: UnsignedInt {
+            /** Don't record buffer and texture upload payloads */
+            ElidePayload = 1 << 0
+        };
+
+        /**
+         * @brief Capture flags
+         *
+         * @see @ref CommandCapture()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /** @brief Captured command */
+        enum class Command: UnsignedByte {
+            EndFrame = 1,       /**< End of a frame, no record */
+            BufferData,         /**< @ref BufferDataRecord */
+            BufferSubData,      /**< @ref BufferSubDataRecord */
+            TextureStorage,     /**< @ref TextureStorageRecord */
+            TextureSubImage,    /**< @ref TextureSubImageRecord */
+            Draw,               /**< @ref DrawRecord */
+            UseProgram,         /**< @ref UseProgramRecord */
+            Uniform,            /**< @ref UniformRecord */
+            BindTexture,        /**< @ref BindTextureRecord */
+            BindFramebuffer,    /**< @ref BindFramebufferRecord */
+            State               /**< @ref StateRecord */
+        };
+
+        /**
+         * @brief Captured state change
+         *
+         * @see @ref StateRecord
+         */
+        enum class StateFunction: UnsignedInt {
+            /** @ref Renderer::enable(), feature in first argument */
+            Enable = 1,
+
+            /** @ref Renderer::disable(), feature in first argument */
+            Disable,
+
+            /** @ref Renderer::setFrontFace() */
+            FrontFace,
+
+            /** @ref Renderer::setFaceCullingMode() */
+            FaceCullingMode,
+
+            /** @ref Renderer::setDepthFunction() */
+            DepthFunction,
+
+            /** @ref Renderer::setDepthMask() */
+            DepthMask,
+
+            /** @ref Renderer::setColorMask(), all four arguments */
+            ColorMask,
+
+            /** @ref Renderer::setBlendEquation(), RGB and alpha equation */
+            BlendEquation,
+
+            /**
+             * @ref Renderer::setBlendFunction(), RGB source and destination
+             * followed by alpha source and destination
+             */
+            BlendFunction
+        };
+
+        /**
+         * @brief Buffer data record
+         *
+         * Followed by @ref size bytes of payload unless the capture was done
+         * with @ref Flag::ElidePayload.
+         */
+        struct BufferDataRecord {
+            UnsignedLong size;      /**< @brief Data size */
+            UnsignedInt buffer;     /**< @brief Buffer ID */
+            UnsignedInt usage;      /**< @brief Buffer usage */
+        };
+
+        /**
+         * @brief Buffer subdata record
+         *
+         * Followed by @ref size bytes of payload unless the capture was done
+         * with @ref Flag::ElidePayload.
+         */
+        struct BufferSubDataRecord {
+            UnsignedLong offset;    /**< @brief Offset in the buffer */
+            UnsignedLong size;      /**< @brief Data size */
+            UnsignedInt buffer;     /**< @brief Buffer ID */
+            UnsignedInt padding;    /**< @brief Unused */
+        };
+
+        /** @brief Texture storage record */
+        struct TextureStorageRecord {
+            UnsignedInt texture;    /**< @brief Texture ID */
+            UnsignedInt target;     /**< @brief Texture target */
+            Int levels;             /**< @brief Level count */
+            UnsignedInt format;     /**< @brief Internal texture format */
+            Vector3i size;          /**< @brief Size of base level */
+        };
+
+        /**
+         * @brief Texture subimage record
+         *
+         * Followed by @ref dataSize bytes of payload unless the capture was
+         * done with @ref Flag::ElidePayload.
+         */
+        struct TextureSubImageRecord {
+            UnsignedLong dataSize;  /**< @brief Image data size */
+            UnsignedInt texture;    /**< @brief Texture ID */
+            UnsignedInt target;     /**< @brief Texture target */
+            Int level;              /**< @brief Mip level */
+            Vector3i offset;        /**< @brief Offset in the texture */
+            Vector3i size;          /**< @brief Image size */
+            UnsignedInt format;     /**< @brief Pixel format */
+            UnsignedInt type;       /**< @brief Pixel type */
+            Int alignment;          /**< @brief Row alignment */
+        };
+
+        /** @brief Draw record */
+        struct DrawRecord {
+            UnsignedLong indexOffset;   /**< @brief Offset in index buffer */
+            UnsignedInt mesh;           /**< @brief Mesh ID */
+            UnsignedInt primitive;      /**< @brief Mesh primitive */
+            Int count;                  /**< @brief Vertex or index count */
+            Int baseVertex;             /**< @brief Base vertex */
+            Int instanceCount;          /**< @brief Instance count */
+
+            /** @brief Index buffer ID, `0` if the mesh is not indexed */
+            UnsignedInt indexBuffer;
+
+            /** @brief Index type, `0` if the mesh is not indexed */
+            UnsignedInt indexType;
+
+            UnsignedInt padding;        /**< @brief Unused */
+        };
+
+        /** @brief Shader program switch record */
+        struct UseProgramRecord {
+            UnsignedInt program;    /**< @brief Program ID */
+        };
+
+        /**
+         * @brief Uniform record
+         *
+         * Always followed by the uniform values.
+         */
+        struct UniformRecord {
+            UnsignedInt program;    /**< @brief Program ID */
+            Int location;           /**< @brief Uniform location */
+
+            /** @brief GLSL type of the uniform, e.g. `GL_FLOAT_VEC4` */
+            UnsignedInt type;
+
+            UnsignedInt count;      /**< @brief Array size */
+        };
+
+        /** @brief Texture bind record */
+        struct BindTextureRecord {
+            Int unit;               /**< @brief Texture unit */
+            UnsignedInt texture;    /**< @brief Texture ID, `0` if unbound */
+        };
+
+        /** @brief Framebuffer bind record */
+        struct BindFramebufferRecord {
+            UnsignedInt target;         /**< @brief Framebuffer target */
+            UnsignedInt framebuffer;    /**< @brief Framebuffer ID */
+        };
+
+        /** @brief State change record */
+        struct StateRecord {
+            StateFunction function;     /**< @brief State function */
+
+            /** @brief Function arguments, unused are set to `0` */
+            UnsignedInt arguments[4];
+        };
+
+        /**
+         * @brief Size of a record for given command
+         *
+         * Size of the fixed part of the record, not including the payload.
+         */
+        static std::size_t recordSize(Command command);
+
+        /**
+         * @brief Constructor
+         * @param out           Output stream
+         * @param frameCount    Count of frames to capture. If `0`, the
+         *      capture runs until @ref stop() is called.
+         * @param flags         Capture flags
+         *
+         * Writes the file header and attaches itself to current context, if
+         * any. Expects that there's no other capture active on the context.
+         */
+        explicit CommandCapture(std::ostream& out, UnsignedInt frameCount, Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        CommandCapture(const CommandCapture&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandCapture(CommandCapture&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop().
+         */
+        ~CommandCapture();
+
+        /** @brief Copying is not allowed */
+        CommandCapture& operator=(const CommandCapture&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandCapture& operator=(CommandCapture&&) = delete;
+
+        /** @brief Capture flags */
+        Flags flags() const { return _flags; }
+
+        /** @brief Count of frames to capture */
+        UnsignedInt frameCount() const { return _frameCount; }
+
+        /** @brief Count of frames captured so far */
+        UnsignedInt capturedFrameCount() const { return _capturedFrameCount; }
+
+        /** @brief Count of commands captured so far, including frame ends */
+        std::size_t commandCount() const { return _commandCount; }
+
+        /** @brief Whether the capture is running */
+        bool isCapturing() const { return _capturing; }
+
+        /**
+         * @brief End the frame
+         *
+         * Records @ref Command::EndFrame and stops the capture if
+         * @ref frameCount() frames were captured. Does nothing if the capture
+         * is not running.
+         */
+        void nextFrame();
+
+        /**
+         * @brief Stop the capture
+         *
+         * Detaches the capture from the context and flushes the stream. Does
+         * nothing if the capture is not running.
+         */
+        void stop();
+
+    private:
+        friend AbstractFramebuffer;
+        friend AbstractShaderProgram;
+        friend AbstractTexture;
+        friend Buffer;
+        friend Mesh;
+        friend MeshView;
+        friend Renderer;
+
+        void record(Command command, const void* record, std::size_t size, Containers::ArrayView<const void> payload = nullptr);
+
+        void bufferData(GLuint buffer, Containers::ArrayView<const void> data, GLenum usage);
+        void bufferSubData(GLuint buffer, GLintptr offset, Containers::ArrayView<const void> data);
+        void textureStorage(GLuint texture, GLenum target, GLsizei levels, GLenum format, const Vector3i& size);
+        void textureSubImage(GLuint texture, GLenum target, GLint level, const Vector3i& offset, const Vector3i& size, GLenum format, GLenum type, Int alignment, Containers::ArrayView<const void> data);
+        void draw(GLuint mesh, GLenum primitive, Int count, Int baseVertex, Int instanceCount, GLuint indexBuffer, GLenum indexType, GLintptr indexOffset);
+        void useProgram(GLuint program);
+        void uniform(GLuint program, Int location, GLenum type, std::size_t count, Containers::ArrayView<const void> values);
+        void bindTexture(Int unit, GLuint texture);
+        void bindFramebuffer(GLenum target, GLuint framebuffer);
+        void state(StateFunction function, UnsignedInt argument0, UnsignedInt argument1 = 0, UnsignedInt argument2 = 0, UnsignedInt argument3 = 0);
+
+        std::ostream& _out;
+        Implementation::State* _state;
+        UnsignedInt _frameCount, _capturedFrameCount;
+        std::size_t _commandCount;
+        Flags _flags;
+        bool _capturing;
+};
+
+CORRADE_ENUMSET_OPERATORS(CommandCapture::Flags)
+
+/**
+@brief GL command capture reader
+
+Iterates over commands recorded by @ref CommandCapture:
+@code
+std::string data = ...;
+CommandCaptureReader reader{{data.data(), data.size()}};
+while(reader.nextCommand()) {
+    if(reader.command() == CommandCapture::Command::Draw) {
+        const auto draw = reader.record<CommandCapture::DrawRecord>();
+        // ...
+    }
+}
+@endcode
+
+The reader doesn't copy the data, the view has to stay valid for the whole
+lifetime of the reader.
+*/
+class MAGNUM_EXPORT CommandCaptureReader {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Checks the file header. If the data are not a valid capture, prints
+         * a message to error output and @ref isValid() returns `false`.
+         */
+        explicit CommandCaptureReader(Containers::ArrayView<const char> data);
+
+        /** @brief Whether the data are a valid capture */
+        bool isValid() const { return _valid; }
+
+        /** @brief Capture flags */
+        CommandCapture::Flags flags() const { return _flags; }
+
+        /**
+         * @brief Advance to next command
+         *
+         * Returns `false` at the end of the data or if the data are
+         * truncated or corrupted, in which case a message is printed to error
+         * output and @ref isValid() returns `false`.
+         */
+        bool nextCommand();
+
+        /** @brief Current command */
+        CommandCapture::Command command() const { return _command; }
+
+        /**
+         * @brief Record of current command
+         *
+         * Expects that @p T is the record type corresponding to
+         * @ref command().
+         */
+        template<class T> T record() const {
+            T out;
+            copyRecord(&out, sizeof(T));
+            return out;
+        }
+
+        /**
+         * @brief Payload of current command
+         *
+         * Empty if the command has no payload or if it was elided.
+         */
+        Containers::ArrayView<const char> payload() const { return _payload; }
+
+    private:
+        void copyRecord(void* out, std::size_t size) const;
+
+        Containers::ArrayView<const char> _data, _record, _payload;
+        std::size_t _position;
+        CommandCapture::Flags _flags;
+        CommandCapture::Command _command;
+        bool _valid;
+};
+
+}
+
+#endif
@@ -25,9 +25,10 @@
 
 #include "Context.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream> /* for initialization log redirection */
 #include <string>
-#include <unordered_map>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/String.h>
@@ -49,6 +50,7 @@
 #include "Implementation/State.h"
 #include "Implementation/BufferState.h"
 #include "Implementation/FramebufferState.h"
+#include "Implementation/MemoryState.h"
 #include "Implementation/MeshState.h"
 #include "Implementation/RendererState.h"
 #include "Implementation/ShaderProgramState.h"
@@ -81,7 +83,9 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,ARB,pipeline_statistics_query),
         _extension(GL,ARB,sparse_buffer),
         _extension(GL,ARB,transform_feedback_overflow_query),
+        _extension(GL,ARB,gl_spirv),
         _extension(GL,ATI,texture_mirror_once),
+        _extension(GL,ATI,meminfo),
         _extension(GL,EXT,texture_filter_anisotropic),
         _extension(GL,EXT,texture_compression_s3tc),
         _extension(GL,EXT,texture_mirror_clamp),
@@ -95,7 +99,9 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,texture_compression_astc_hdr),
         _extension(GL,KHR,blend_equation_advanced),
         _extension(GL,KHR,blend_equation_advanced_coherent),
-        _extension(GL,KHR,no_error)};
+        _extension(GL,KHR,no_error),
+        _extension(GL,KHR,parallel_shader_compile),
+        _extension(GL,NVX,gpu_memory_info)};
     static const std::vector<Extension> extensions300{
         _extension(GL,ARB,map_buffer_range),
         _extension(GL,ARB,color_buffer_float),
@@ -298,6 +304,7 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,robust_buffer_access_behavior),
         _extension(GL,KHR,context_flush_control),
         _extension(GL,KHR,no_error),
+        _extension(GL,KHR,parallel_shader_compile),
         _extension(GL,NV,read_buffer_front),
         _extension(GL,NV,read_depth),
         _extension(GL,NV,read_stencil),
@@ -461,6 +468,9 @@ Context::Context(Context&& other): _version{std::move(other._version)},
     _supportedExtensions{std::move(other._supportedExtensions)},
     _state{std::move(other._state)},
     _detectedDrivers{std::move(other._detectedDrivers)}
+    #ifdef MAGNUM_BUILD_STATISTICS
+    , _statistics(other._statistics)
+    #endif
 {
     other._state = nullptr;
     if(currentContext == &other) currentContext = this;
@@ -477,6 +487,35 @@ void Context::create() {
     if(!tryCreate()) std::exit(1);
 }
 
+namespace {
+
+/* All known extensions sorted by their string. The table is built just once
+   per process and then used for binary search when matching the driver
+   extension strings and disabled extensions, so context creation doesn't
+   need to build any hash maps. */
+const std::vector<const Extension*>& sortedExtensions(const std::vector<Version>& versions) {
+    static const std::vector<const Extension*> extensions = [&versions]() {
+        std::vector<const Extension*> out;
+        for(const Version version: versions)
+            for(const Extension& extension: Extension::extensions(version))
+                out.push_back(&extension);
+        std::sort(out.begin(), out.end(), [](const Extension* a, const Extension* b) {
+            return std::strcmp(a->string(), b->string()) < 0;
+        });
+        return out;
+    }();
+    return extensions;
+}
+
+const Extension* findExtension(const std::vector<const Extension*>& extensions, const char* const string) {
+    const auto found = std::lower_bound(extensions.begin(), extensions.end(), string, [](const Extension* a, const char* b) {
+        return std::strcmp(a->string(), b) < 0;
+    });
+    return found != extensions.end() && std::strcmp((*found)->string(), string) == 0 ? *found : nullptr;
+}
+
+}
+
 bool Context::tryCreate() {
     CORRADE_ASSERT(_version == Version::None,
         "Platform::Context::tryCreate(): context already created", false);
@@ -624,21 +663,16 @@ bool Context::tryCreate() {
         for(const Extension& extension: Extension::extensions(versions[i]))
             _extensionStatus.set(extension._index);
 
-    /* List of extensions from future versions (extensions from current and
-       previous versions should be supported automatically, so we don't need
-       to check for them) */
-    std::unordered_map<std::string, Extension> futureExtensions;
-    for(std::size_t i = future; i != versions.size(); ++i)
-        for(const Extension& extension: Extension::extensions(versions[i]))
-            futureExtensions.emplace(extension._string, extension);
-
-    /* Check for presence of future and vendor extensions */
+    /* Check for presence of future and vendor extensions. Extensions from
+       current and previous versions are already marked as supported and
+       don't need to be checked. */
+    const std::vector<const Extension*>& knownExtensions = sortedExtensions(versions);
     const std::vector<std::string> extensions = extensionStrings();
     for(const std::string& extension: extensions) {
-        const auto found = futureExtensions.find(extension);
-        if(found != futureExtensions.end()) {
-            _supportedExtensions.push_back(found->second);
-            _extensionStatus.set(found->second._index);
+        const Extension* const found = findExtension(knownExtensions, extension.data());
+        if(found && !_extensionStatus[found->_index]) {
+            _supportedExtensions.push_back(*found);
+            _extensionStatus.set(found->_index);
         }
     }
 
@@ -670,20 +704,14 @@ bool Context::tryCreate() {
     if(!_disabledExtensions.empty()) {
         Debug{output} << "Disabling extensions:";
 
-        /* Put remaining extensions into the hashmap for faster lookup */
-        std::unordered_map<std::string, Extension> allExtensions{std::move(futureExtensions)};
-        for(std::size_t i = 0; i != future; ++i)
-            for(const Extension& extension: Extension::extensions(versions[i]))
-                allExtensions.emplace(extension._string, extension);
-
         /* Disable extensions that are known and supported and print a message
            for each */
         for(auto&& extension: _disabledExtensions) {
-            auto found = allExtensions.find(extension);
+            const Extension* const found = findExtension(knownExtensions, extension.data());
             /** @todo Error message here? I should not clutter the output at this point */
-            if(found == allExtensions.end()) continue;
+            if(!found) continue;
 
-            _extensionRequiredVersion[found->second._index] = Version::None;
+            _extensionRequiredVersion[found->_index] = Version::None;
             Debug{output} << "   " << extension;
         }
     }
@@ -811,7 +839,8 @@ void Context::resetState(const States states) {
         _state->renderer->packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer->shadow = RenderState{};
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
@@ -826,6 +855,59 @@ void Context::resetState(const States states) {
     #endif
 }
 
+bool Context::isMemoryTrackingEnabled() const {
+    return _state->memory->enabled;
+}
+
+Context& Context::setMemoryTrackingEnabled(const bool enabled) {
+    _state->memory->setEnabled(enabled);
+    return *this;
+}
+
+Context::MemoryUsage Context::memoryUsage(const MemoryObject type) const {
+    const Implementation::MemoryState& state = *_state->memory;
+    return {state.objects[UnsignedInt(type)].size(), state.byteCount[UnsignedInt(type)]};
+}
+
+#ifdef MAGNUM_BUILD_STATISTICS
+Context::Statistics Context::resetStatistics() {
+    const Statistics statistics = _statistics;
+    _statistics = Statistics{};
+    return statistics;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+std::size_t Context::totalDeviceMemory() {
+    if(!isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>())
+        return 0;
+
+    /* The value is in kB */
+    GLint value = 0;
+    glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &value);
+    return std::size_t(value)*1024;
+}
+
+std::size_t Context::availableDeviceMemory() {
+    /* The values are in kB */
+    if(isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+        GLint value = 0;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &value);
+        return std::size_t(value)*1024;
+    }
+
+    /* Total free memory, largest free block, total free auxiliary memory,
+       largest free auxiliary block */
+    if(isExtensionSupported<Extensions::GL::ATI::meminfo>()) {
+        GLint values[4]{};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, values);
+        return std::size_t(values[0])*1024;
+    }
+
+    return 0;
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Context::Flag value) {
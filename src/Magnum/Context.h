@@ -241,6 +241,80 @@ class MAGNUM_EXPORT Context {
          */
         typedef Containers::EnumSet<DetectedDriver> DetectedDrivers;
 
+        /**
+         * @brief Object type for memory tracking
+         *
+         * @see @ref memoryUsage(), @ref setMemoryTrackingEnabled()
+         */
+        enum class MemoryObject: UnsignedByte {
+            Buffer,         /**< @ref Magnum::Buffer "Buffer" objects */
+
+            /** Texture objects, i.e. all subclasses of @ref AbstractTexture */
+            Texture,
+
+            Renderbuffer    /**< @ref Magnum::Renderbuffer "Renderbuffer" objects */
+        };
+
+        /**
+         * @brief Tracked memory usage
+         *
+         * @see @ref memoryUsage()
+         */
+        struct MemoryUsage {
+            std::size_t objectCount;    /**< @brief Count of live objects */
+            std::size_t byteCount;      /**< @brief Allocated memory in bytes */
+        };
+
+        #if defined(MAGNUM_BUILD_STATISTICS) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief GL call and state change statistics
+         *
+         * Only GL calls that were actually issued are counted, state changes
+         * filtered out by the state tracker don't contribute to the numbers.
+         * @see @ref statistics(), @ref resetStatistics()
+         */
+        struct Statistics {
+            /**
+             * @brief Draw calls
+             *
+             * Each `glDraw*()` and `glMultiDraw*()` call counts as one.
+             */
+            UnsignedInt drawCalls;
+
+            /**
+             * @brief Mesh binds
+             *
+             * Vertex array object binds or, if VAOs are not used, vertex
+             * attribute setups done before each draw.
+             */
+            UnsignedInt meshBinds;
+
+            UnsignedInt shaderSwitches;     /**< @brief Shader program switches */
+
+            /**
+             * @brief Texture binds
+             *
+             * Counts each texture unit whose binding changed, including
+             * internal binds done for texture data uploads and queries.
+             */
+            UnsignedInt textureBinds;
+
+            UnsignedInt framebufferBinds;   /**< @brief Framebuffer binds */
+
+            /**
+             * @brief Buffer binds
+             *
+             * Counts `glBindBuffer()` calls, including internal binds done
+             * for buffer data uploads and mesh setup. With
+             * @extension{ARB,direct_state_access} most of these are avoided.
+             */
+            UnsignedInt bufferBinds;
+
+            UnsignedInt bufferUploads;      /**< @brief Buffer data uploads */
+            std::size_t bufferUploadBytes;  /**< @brief Uploaded buffer data in bytes */
+        };
+        #endif
+
         /**
          * @brief Whether there is any current context
          *
@@ -498,11 +572,102 @@ class MAGNUM_EXPORT Context {
          */
         DetectedDrivers detectedDriver();
 
+        /**
+         * @brief Whether memory tracking is enabled
+         *
+         * @see @ref setMemoryTrackingEnabled()
+         */
+        bool isMemoryTrackingEnabled() const;
+
+        /**
+         * @brief Enable or disable memory tracking
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, creation and destruction of @ref Buffer,
+         * @ref Renderbuffer and texture objects is counted and all their data
+         * and storage allocations are accounted for in @ref memoryUsage().
+         * Disabled by default, as it adds a small overhead to every
+         * allocation. Changing the state discards all tracked info, so it's
+         * best to enable the tracking right after context creation --- objects
+         * created earlier are counted only once they allocate some memory.
+         * @see @ref totalDeviceMemory(), @ref availableDeviceMemory(),
+         *      @ref DebugTools::printMemoryUsage()
+         */
+        Context& setMemoryTrackingEnabled(bool enabled);
+
+        /**
+         * @brief Tracked memory usage for given object type
+         *
+         * Texture and renderbuffer sizes are estimated from the internal
+         * format, size and mip level count, the actual driver allocation may
+         * differ due to padding and alignment. Buffers and compressed images
+         * are tracked exactly. Returns zero counts if memory tracking is
+         * disabled.
+         * @see @ref setMemoryTrackingEnabled()
+         */
+        MemoryUsage memoryUsage(MemoryObject type) const;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Total dedicated device memory
+         *
+         * Size of dedicated video memory in bytes, queried from the driver
+         * using @extension{NVX,gpu_memory_info}. If the extension is not
+         * available, returns `0`.
+         * @see @ref availableDeviceMemory(), @fn_gl{Get} with
+         *      @def_gl{GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX}
+         * @requires_gl Memory info queries are not available in OpenGL ES
+         *      or WebGL.
+         */
+        std::size_t totalDeviceMemory();
+
+        /**
+         * @brief Currently available device memory
+         *
+         * Size of free video memory in bytes, queried from the driver using
+         * @extension{NVX,gpu_memory_info} or free texture memory using
+         * @extension{ATI,meminfo}. If neither extension is available, returns
+         * `0`. The value is not cached, each call results in a GL query.
+         * @see @ref totalDeviceMemory(), @fn_gl{Get} with
+         *      @def_gl{GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX} or
+         *      @def_gl{TEXTURE_FREE_MEMORY_ATI}
+         * @requires_gl Memory info queries are not available in OpenGL ES
+         *      or WebGL.
+         */
+        std::size_t availableDeviceMemory();
+        #endif
+
+        #if defined(MAGNUM_BUILD_STATISTICS) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief GL call and state change statistics
+         *
+         * Counters accumulated since context creation or since last call to
+         * @ref resetStatistics().
+         * @note Available only if Magnum is built with
+         *      @ref MAGNUM_BUILD_STATISTICS.
+         * @see @ref DebugTools::Profiler
+         */
+        const Statistics& statistics() const { return _statistics; }
+
+        /**
+         * @brief Reset statistics
+         *
+         * Returns current value of @ref statistics() and resets all counters
+         * to zero. Call once per frame to get per-frame numbers.
+         * @note Available only if Magnum is built with
+         *      @ref MAGNUM_BUILD_STATISTICS.
+         */
+        Statistics resetStatistics();
+        #endif
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
         bool isDriverWorkaroundDisabled(const std::string& workaround);
         Implementation::State& state() { return *_state; }
+        #ifdef MAGNUM_BUILD_STATISTICS
+        Statistics& statisticsInternal() { return _statistics; }
+        #endif
 
     private:
         explicit Context(NoCreateT, Int argc, const char** argv, void functionLoader());
@@ -532,6 +697,10 @@ class MAGNUM_EXPORT Context {
         std::vector<std::pair<std::string, bool>> _driverWorkarounds;
         std::vector<std::string> _disabledExtensions;
         bool _displayInitializationLog;
+
+        #ifdef MAGNUM_BUILD_STATISTICS
+        Statistics _statistics{};
+        #endif
 };
 
 CORRADE_ENUMSET_OPERATORS(Context::DetectedDrivers)
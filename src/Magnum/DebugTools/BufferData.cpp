@@ -25,6 +25,9 @@
 
 #include "BufferData.h"
 
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
 #ifndef MAGNUM_TARGET_WEBGL
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
@@ -34,5 +37,111 @@ void bufferSubData(Buffer& buffer, GLintptr offset, GLsizeiptr size, void* outpu
     buffer.unmap();
 }
 
-}}}
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+BufferDataReader::Slot::Slot(): buffer{Buffer::TargetHint::CopyWrite}, capacity{0}, size{0}, fence{}, pending{false} {}
+
+BufferDataReader::BufferDataReader(const UnsignedInt slotCount): _next{0} {
+    CORRADE_ASSERT(slotCount, "DebugTools::BufferDataReader::BufferDataReader(): slot count must be positive", );
+    _slots.reserve(slotCount);
+    for(UnsignedInt i = 0; i != slotCount; ++i) _slots.emplace_back();
+}
+
+BufferDataReader::~BufferDataReader() {
+    for(Slot& slot: _slots) deleteFence(slot);
+}
+
+UnsignedInt BufferDataReader::pendingCount() const {
+    return std::count_if(_slots.begin(), _slots.end(), [](const Slot& slot) { return slot.pending; });
+}
+
+UnsignedInt BufferDataReader::read(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    /* Find a free slot, starting after the last used one so the slots are
+       used in a round-robin fashion */
+    UnsignedInt slot = _next;
+    for(UnsignedInt i = 0; i != _slots.size() && _slots[slot].pending; ++i)
+        slot = (slot + 1) % _slots.size();
+    CORRADE_ASSERT(!_slots[slot].pending,
+        "DebugTools::BufferDataReader::read(): all" << _slots.size() << "slots are pending, retrieve or discard some first", {});
+    _next = (slot + 1) % _slots.size();
+
+    /* Reallocate the staging buffer only if it's too small */
+    Slot& s = _slots[slot];
+    if(s.capacity < size) {
+        s.buffer.setData({nullptr, std::size_t(size)}, BufferUsage::StreamRead);
+        s.capacity = size;
+    }
+    if(size) Buffer::copy(buffer, s.buffer, offset, 0, size);
+
+    s.size = size;
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s.pending = true;
+    return slot;
+}
+
+UnsignedInt BufferDataReader::read(Buffer& buffer) {
+    return read(buffer, 0, buffer.size());
+}
+
+bool BufferDataReader::isReady(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "DebugTools::BufferDataReader::isReady(): slot" << slot << "is not pending", false);
+
+    Slot& s = _slots[slot];
+    if(!s.fence) return true;
+
+    /* Flush the commands so the fence eventually gets signaled even if
+       nothing else is submitted */
+    if(glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    deleteFence(s);
+    return true;
+}
+
+GLsizeiptr BufferDataReader::size(const UnsignedInt slot) const {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "DebugTools::BufferDataReader::size(): slot" << slot << "is not pending", 0);
+    return _slots[slot].size;
+}
+
+Buffer& BufferDataReader::buffer(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "DebugTools::BufferDataReader::buffer(): slot" << slot << "is not pending", _slots[0].buffer);
+    return _slots[slot].buffer;
+}
+
+void BufferDataReader::retrieveInternal(const UnsignedInt slot, void* const output) {
+    Slot& s = _slots[slot];
+    if(s.fence) {
+        while(glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+        deleteFence(s);
+    }
+
+    if(s.size) {
+        const char* const mapped = s.buffer.map<const char>(0, s.size, Buffer::MapFlag::Read);
+        CORRADE_INTERNAL_ASSERT(mapped);
+        std::copy_n(mapped, s.size, reinterpret_cast<char*>(output));
+        s.buffer.unmap();
+    }
+
+    s.pending = false;
+}
+
+void BufferDataReader::discard(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "DebugTools::BufferDataReader::discard(): slot" << slot << "is not pending", );
+    deleteFence(_slots[slot]);
+    _slots[slot].pending = false;
+}
+
+void BufferDataReader::deleteFence(Slot& slot) {
+    if(!slot.fence) return;
+    glDeleteSync(slot.fence);
+    slot.fence = {};
+}
+#endif
+
+}}
 #endif
@@ -27,10 +27,11 @@
 
 #ifndef MAGNUM_TARGET_WEBGL
 /** @file
- * @brief Function @ref Magnum::DebugTools::bufferData(), @ref Magnum::DebugTools::bufferSubData()
+ * @brief Function @ref Magnum::DebugTools::bufferData(), @ref Magnum::DebugTools::bufferSubData(), class @ref Magnum::DebugTools::BufferDataReader
  */
 #endif
 
+#include <vector>
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/Buffer.h"
@@ -73,6 +74,170 @@ template<class T = char> Containers::Array<T> inline bufferData(Buffer& buffer)
     return bufferSubData<T>(buffer, 0, bufferSize/sizeof(T));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Asynchronous buffer data reader
+
+Unlike @ref bufferData() and @ref bufferSubData(), which wait for the GPU to
+finish all work writing to the buffer, the data are first copied to a staging
+buffer using @ref Buffer::copy() and then retrieved a frame or two later,
+without stalling the pipeline. Useful for inspecting results of transform
+feedback or compute shaders.
+
+## Usage
+
+Start the read using @ref read(), which returns a slot index, and later check
+with @ref isReady() whether it's finished:
+@code
+DebugTools::BufferDataReader reader{3};
+
+// each frame, after the simulation step
+pending.push_back(reader.read(particleBuffer));
+
+while(!pending.empty() && reader.isReady(pending.front())) {
+    Containers::Array<Vector4> particles = reader.retrieve<Vector4>(pending.front());
+    sendTelemetry(particles);
+    pending.pop_front();
+}
+@endcode
+
+Each copy is followed by a fence sync object, @ref isReady() only checks
+whether the fence is signaled. The slot is reused only after its result is
+retrieved with @ref retrieve() or discarded with @ref discard(), so the slot
+count limits how many reads can be in flight. To avoid the copy, the staging
+buffer can be also mapped directly, see @ref buffer().
+@see @ref FramebufferReader
+@requires_gl32 Extension @extension{ARB,sync} and @extension{ARB,copy_buffer}
+@requires_gles30 Buffer copying and fence sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT BufferDataReader {
+    public:
+        /**
+         * @brief Constructor
+         * @param slotCount     Slot count
+         *
+         * The staging buffers are allocated on first read into given slot.
+         */
+        explicit BufferDataReader(UnsignedInt slotCount = 3);
+
+        /** @brief Copying is not allowed */
+        BufferDataReader(const BufferDataReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferDataReader(BufferDataReader&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fence sync objects and the staging buffers.
+         */
+        ~BufferDataReader();
+
+        /** @brief Copying is not allowed */
+        BufferDataReader& operator=(const BufferDataReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferDataReader& operator=(BufferDataReader&&) = delete;
+
+        /** @brief Slot count */
+        UnsignedInt slotCount() const { return _slots.size(); }
+
+        /** @brief Count of reads that weren't retrieved yet */
+        UnsignedInt pendingCount() const;
+
+        /**
+         * @brief Start reading buffer subdata
+         * @param buffer    Buffer to read from
+         * @param offset    Offset in the buffer, in bytes
+         * @param size      Data size, in bytes
+         * @return Slot index to pass to @ref isReady() and @ref retrieve()
+         *
+         * Expects that there is a free slot, i.e. that less than
+         * @ref slotCount() reads are pending. The staging buffer in given
+         * slot is reallocated only if it's too small for the data.
+         * @see @ref Buffer::copy(), @fn_gl{FenceSync}
+         */
+        UnsignedInt read(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /** @overload
+         * Reads the whole buffer.
+         */
+        UnsignedInt read(Buffer& buffer);
+
+        /**
+         * @brief Whether the read in given slot is finished
+         *
+         * Never waits for the read to finish.
+         * @see @fn_gl{ClientWaitSync}
+         */
+        bool isReady(UnsignedInt slot);
+
+        /**
+         * @brief Data size in given slot
+         *
+         * Size passed to @ref read(), in bytes. Expects that the read in
+         * given slot wasn't retrieved or discarded yet.
+         */
+        GLsizeiptr size(UnsignedInt slot) const;
+
+        /**
+         * @brief Staging buffer in given slot
+         *
+         * Allows to access the data without copying them by mapping the
+         * first @ref size() bytes of the buffer. Expects that the read in
+         * given slot wasn't retrieved or discarded yet. The data are
+         * complete only after @ref isReady() returns `true` for given slot,
+         * the buffer should be unmapped before the slot is discarded.
+         */
+        Buffer& buffer(UnsignedInt slot);
+
+        /**
+         * @brief Retrieve the result of read in given slot
+         *
+         * Waits for the read to finish if it isn't already, maps the staging
+         * buffer and copies the data to returned array. The slot is then free
+         * for another read. Expects that the read in given slot wasn't
+         * retrieved or discarded yet and that the size is divisible by size
+         * of @p T.
+         * @see @ref isReady(), @ref Buffer::map()
+         */
+        template<class T = char> Containers::Array<T> retrieve(UnsignedInt slot);
+
+        /**
+         * @brief Discard the read in given slot
+         *
+         * Frees the slot without retrieving the data.
+         */
+        void discard(UnsignedInt slot);
+
+    private:
+        struct Slot {
+            explicit Slot();
+
+            Buffer buffer;
+            GLsizeiptr capacity, size;
+            GLsync fence;
+            bool pending;
+        };
+
+        void MAGNUM_LOCAL deleteFence(Slot& slot);
+        void retrieveInternal(UnsignedInt slot, void* output);
+
+        std::vector<Slot> _slots;
+        UnsignedInt _next;
+};
+
+template<class T> Containers::Array<T> BufferDataReader::retrieve(const UnsignedInt slot) {
+    const GLsizeiptr dataSize = size(slot);
+    CORRADE_ASSERT(dataSize%sizeof(T) == 0, "DebugTools::BufferDataReader::retrieve(): the data size is" << dataSize << "bytes, which can't be expressed as array of types with size" << sizeof(T), nullptr);
+    Containers::Array<T> data{std::size_t(dataSize/sizeof(T))};
+    retrieveInternal(slot, data);
+    return data;
+}
+#endif
+
 }}
 #else
 #error this header is not available in WebGL build
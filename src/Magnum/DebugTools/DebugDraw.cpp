@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DebugDraw.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+template<UnsignedInt> ResourceKey shaderKey();
+template<> inline ResourceKey shaderKey<2>() { return ResourceKey("VertexColorShader2D"); }
+template<> inline ResourceKey shaderKey<3>() { return ResourceKey("VertexColorShader3D"); }
+
+enum: UnsignedInt { CircleSegmentCount = 32 };
+
+/* Unit circle, calculated only once */
+const std::array<Vector2, CircleSegmentCount>& circle() {
+    static const std::array<Vector2, CircleSegmentCount> points = []() {
+        std::array<Vector2, CircleSegmentCount> out;
+        for(UnsignedInt i = 0; i != CircleSegmentCount; ++i) {
+            const Rad angle{Constants::pi()*2.0f*Float(i)/CircleSegmentCount};
+            out[i] = {Math::cos(angle), Math::sin(angle)};
+        }
+        return out;
+    }();
+    return points;
+}
+
+/* Directions of the arrow head lines, perpendicular to the arrow */
+void arrowHeadDirections(const Vector2& direction, std::vector<Vector2>& out) {
+    const Vector2 perpendicular = direction.perpendicular();
+    out = {perpendicular, -perpendicular};
+}
+
+void arrowHeadDirections(const Vector3& direction, std::vector<Vector3>& out) {
+    /* Start with the coordinate axis that's the least parallel to the arrow */
+    const Vector3 absolute = Math::abs(direction);
+    const Vector3 axis = absolute.x() <= absolute.y() && absolute.x() <= absolute.z() ? Vector3::xAxis() :
+        absolute.y() <= absolute.z() ? Vector3::yAxis() : Vector3::zAxis();
+    const Vector3 a = Math::cross(direction, axis).resized(direction.length());
+    const Vector3 b = Math::cross(direction, a).resized(direction.length());
+    out = {a, -a, b, -b};
+}
+
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>::DebugDraw(): _capacity{} {
+    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::VertexColor<dimensions>>(shaderKey<dimensions>());
+    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::VertexColor<dimensions>);
+
+    _mesh.setPrimitive(MeshPrimitive::Lines)
+        .addVertexBuffer(_buffer, 0,
+            typename Shaders::VertexColor<dimensions>::Position(),
+            typename Shaders::VertexColor<dimensions>::Color());
+}
+
+/* To avoid deleting pointers to incomplete type on destruction of Resource members */
+template<UnsignedInt dimensions> DebugDraw<dimensions>::~DebugDraw() = default;
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::line(const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Color3& color, const Float duration) {
+    _vertices.push_back({a, color});
+    _vertices.push_back({b, color});
+    _lifetimes.push_back(duration);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::box(const RangeTypeFor<dimensions, Float>& range, const Color3& color, const Float duration) {
+    return box(MatrixTypeFor<dimensions, Float>::translation(range.center())*
+        MatrixTypeFor<dimensions, Float>::scaling(range.size()/2.0f), color, duration);
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::box(const MatrixTypeFor<dimensions, Float>& transformation, const Color3& color, const Float duration) {
+    /* Corner `i` has the coordinate `k` positive if bit `k` of `i` is set */
+    constexpr UnsignedInt cornerCount = 1 << dimensions;
+    std::array<VectorTypeFor<dimensions, Float>, cornerCount> corners;
+    for(UnsignedInt i = 0; i != cornerCount; ++i) {
+        VectorTypeFor<dimensions, Float> corner;
+        for(UnsignedInt k = 0; k != dimensions; ++k)
+            corner[k] = i & (1 << k) ? 1.0f : -1.0f;
+        corners[i] = transformation.transformPoint(corner);
+    }
+
+    /* Edges connect corners differing in exactly one coordinate */
+    for(UnsignedInt i = 0; i != cornerCount; ++i)
+        for(UnsignedInt k = 0; k != dimensions; ++k)
+            if(!(i & (1 << k))) line(corners[i], corners[i | (1 << k)], color, duration);
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::sphere(const VectorTypeFor<dimensions, Float>& center, const Float radius, const Color3& color, const Float duration) {
+    /* One circle in 2D, circles in XY, YZ and ZX planes in 3D */
+    const std::array<Vector2, CircleSegmentCount>& points = circle();
+    for(UnsignedInt plane = 0; plane != (dimensions == 2 ? 1 : 3); ++plane) {
+        const UnsignedInt u = plane, v = (plane + 1) % dimensions;
+        VectorTypeFor<dimensions, Float> previous = center;
+        previous[u] += radius*points.back().x();
+        previous[v] += radius*points.back().y();
+        for(const Vector2& point: points) {
+            VectorTypeFor<dimensions, Float> current = center;
+            current[u] += radius*point.x();
+            current[v] += radius*point.y();
+            line(previous, current, color, duration);
+            previous = current;
+        }
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::arrow(const VectorTypeFor<dimensions, Float>& from, const VectorTypeFor<dimensions, Float>& to, const Color3& color, const Float duration) {
+    line(from, to, color, duration);
+
+    /* Zero-length arrow has no direction for the head */
+    const VectorTypeFor<dimensions, Float> direction = to - from;
+    if(direction.isZero()) return *this;
+
+    /* Head lines go back from the tip, at 45° for head size being a fifth
+       of the length */
+    std::vector<VectorTypeFor<dimensions, Float>> headDirections;
+    arrowHeadDirections(direction*0.1f, headDirections);
+    for(const VectorTypeFor<dimensions, Float>& headDirection: headDirections)
+        line(to, to - direction*0.2f + headDirection, color, duration);
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> DebugDraw<dimensions>& DebugDraw<dimensions>::cross(const VectorTypeFor<dimensions, Float>& position, const Float size, const Color3& color, const Float duration) {
+    for(UnsignedInt k = 0; k != dimensions; ++k) {
+        VectorTypeFor<dimensions, Float> arm;
+        arm[k] = size/2.0f;
+        line(position - arm, position + arm, color, duration);
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> void DebugDraw<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Float timeDelta) {
+    if(!_vertices.empty()) {
+        /* Grow the buffer if the vertices don't fit, otherwise just orphan
+           the previous contents so the upload doesn't need to wait for draws
+           that still use them */
+        if(_vertices.size() > _capacity)
+            _capacity = std::max(_vertices.size(), 2*_capacity);
+        _buffer.setData({nullptr, _capacity*sizeof(Vertex)}, BufferUsage::StreamDraw)
+            .setSubData(0, _vertices);
+
+        _mesh.setCount(_vertices.size());
+        _shader->setTransformationProjectionMatrix(transformationProjectionMatrix);
+        _mesh.draw(*_shader);
+    }
+
+    /* Keep only lines that didn't expire, in place */
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _lifetimes.size(); ++i) {
+        const Float lifetime = _lifetimes[i] - timeDelta;
+        if(lifetime <= 0.0f) continue;
+
+        _lifetimes[count] = lifetime;
+        _vertices[count*2] = _vertices[i*2];
+        _vertices[count*2 + 1] = _vertices[i*2 + 1];
+        ++count;
+    }
+    _lifetimes.resize(count);
+    _vertices.resize(count*2);
+}
+
+template<UnsignedInt dimensions> void DebugDraw<dimensions>::clear() {
+    _vertices.clear();
+    _lifetimes.clear();
+}
+
+template class DebugDraw<2>;
+template class DebugDraw<3>;
+
+}}
@@ -0,0 +1,216 @@
+#ifndef Magnum_DebugTools_DebugDraw_h
+#define Magnum_DebugTools_DebugDraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::DebugDraw, typedef @ref Magnum::DebugTools::DebugDraw2D, @ref Magnum::DebugTools::DebugDraw3D
+ */
+
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Resource.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Immediate-mode debug drawing
+
+Draws ad-hoc lines, boxes, spheres, arrows and crosses without creating any
+scene graph features. All primitives are converted to colored line segments,
+appended to a single vertex array and drawn with one draw call using
+@ref Shaders::VertexColor in @ref draw(). The vertex array and the streaming
+vertex buffer grow as needed and are reused between frames, so once they
+reach the size needed by the application, adding primitives doesn't allocate.
+
+@anchor DebugTools-DebugDraw-usage
+## Basic usage
+
+Primitives with zero @p duration (the default) are drawn once and then
+discarded, primitives with positive duration are drawn until given amount of
+time passes:
+@code
+DebugTools::ResourceManager manager;
+DebugTools::DebugDraw3D debugDraw;
+
+// anywhere during the frame
+debugDraw.line(a, b, Color3::red())
+    .box(collider.bounds(), Color3::green())
+    .arrow(position, position + velocity, Color3::yellow())
+    .sphere(hit, 0.1f, Color3::blue(), 2.0f); // visible for two seconds
+
+// at the end of drawEvent()
+debugDraw.draw(camera.projectionMatrix()*camera.cameraMatrix(), timeline.previousFrameDuration());
+@endcode
+
+The shader is shared with @ref ObjectRenderer through
+@ref DebugTools::ResourceManager, so an instance of it must exist for the
+whole lifetime of the class.
+@see @ref DebugDraw2D, @ref DebugDraw3D
+@todo Text labels, once DebugTools can depend on the Text library
+*/
+template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT DebugDraw {
+    public:
+        /** @brief Constructor */
+        explicit DebugDraw();
+
+        /** @brief Copying is not allowed */
+        DebugDraw(const DebugDraw<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        DebugDraw(DebugDraw<dimensions>&&) = delete;
+
+        ~DebugDraw();
+
+        /** @brief Copying is not allowed */
+        DebugDraw<dimensions>& operator=(const DebugDraw<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        DebugDraw<dimensions>& operator=(DebugDraw<dimensions>&&) = delete;
+
+        /**
+         * @brief Count of line segments to draw
+         *
+         * Includes segments added since last @ref draw() and segments from
+         * previous frames whose duration didn't expire yet.
+         */
+        std::size_t lineCount() const { return _lifetimes.size(); }
+
+        /**
+         * @brief Vertex buffer capacity
+         *
+         * Count of vertices the streaming vertex buffer can hold. Grows in
+         * @ref draw() if there are more vertices than that, never shrinks.
+         */
+        std::size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Add line segment
+         * @param a         Segment start
+         * @param b         Segment end
+         * @param color     Color
+         * @param duration  How long to draw the segment. If `0.0f`, it is
+         *      drawn only in the next @ref draw().
+         * @return Reference to self (for method chaining)
+         */
+        DebugDraw<dimensions>& line(const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Add axis-aligned box
+         * @return Reference to self (for method chaining)
+         *
+         * Draws four or twelve edges of given range. See
+         * @ref line() for description of @p color and @p duration.
+         */
+        DebugDraw<dimensions>& box(const RangeTypeFor<dimensions, Float>& range, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Add oriented box
+         * @return Reference to self (for method chaining)
+         *
+         * Draws a box from @f$ [-1, -1] @f$ to @f$ [1, 1] @f$ (or
+         * @f$ [-1, -1, -1] @f$ to @f$ [1, 1, 1] @f$ in 3D) transformed with
+         * @p transformation, the same as @ref Shapes::Box does. See
+         * @ref line() for description of @p color and @p duration.
+         */
+        DebugDraw<dimensions>& box(const MatrixTypeFor<dimensions, Float>& transformation, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Add sphere
+         * @return Reference to self (for method chaining)
+         *
+         * Draws a circle in 2D, three circles in the planes of the coordinate
+         * axes in 3D. See @ref line() for description of @p color and
+         * @p duration.
+         */
+        DebugDraw<dimensions>& sphere(const VectorTypeFor<dimensions, Float>& center, Float radius, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Add arrow
+         * @return Reference to self (for method chaining)
+         *
+         * Draws line from @p from to @p to with a head at @p to, which has a
+         * fifth of the arrow length. See @ref line() for description of
+         * @p color and @p duration.
+         */
+        DebugDraw<dimensions>& arrow(const VectorTypeFor<dimensions, Float>& from, const VectorTypeFor<dimensions, Float>& to, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Add cross
+         * @return Reference to self (for method chaining)
+         *
+         * Draws an axis-aligned cross with arms of @p size length centered at
+         * @p position, useful for marking points. See @ref line() for
+         * description of @p color and @p duration.
+         */
+        DebugDraw<dimensions>& cross(const VectorTypeFor<dimensions, Float>& position, Float size, const Color3& color, Float duration = 0.0f);
+
+        /**
+         * @brief Draw everything added so far
+         * @param transformationProjectionMatrix    Transformation and
+         *      projection matrix
+         * @param timeDelta     Time elapsed since last call, used for
+         *      expiring primitives with positive duration
+         *
+         * Uploads the vertices and draws them in a single draw call. Then
+         * discards primitives with zero duration and subtracts
+         * @p timeDelta from duration of the others, discarding those that
+         * expired.
+         */
+        void draw(const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, Float timeDelta = 0.0f);
+
+        /** @brief Discard all primitives without drawing them */
+        void clear();
+
+    private:
+        struct Vertex {
+            VectorTypeFor<dimensions, Float> position;
+            Color3 color;
+        };
+
+        std::vector<Vertex> _vertices;
+        std::vector<Float> _lifetimes;
+        std::size_t _capacity;
+
+        Resource<AbstractShaderProgram, Shaders::VertexColor<dimensions>> _shader;
+        Buffer _buffer;
+        Mesh _mesh;
+};
+
+/** @brief Two-dimensional debug drawing */
+typedef DebugDraw<2> DebugDraw2D;
+
+/** @brief Three-dimensional debug drawing */
+typedef DebugDraw<3> DebugDraw3D;
+
+}}
+
+#endif
@@ -34,11 +34,19 @@
 namespace Magnum { namespace DebugTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+template<UnsignedInt> class DebugDraw;
+typedef DebugDraw<2> DebugDraw2D;
+typedef DebugDraw<3> DebugDraw3D;
+
 template<UnsignedInt> class ForceRenderer;
 typedef ForceRenderer<2> ForceRenderer2D;
 typedef ForceRenderer<3> ForceRenderer3D;
 class ForceRendererOptions;
 
+template<UnsignedInt> class InstancedRenderer;
+typedef InstancedRenderer<2> InstancedRenderer2D;
+typedef InstancedRenderer<3> InstancedRenderer3D;
+
 template<UnsignedInt> class ObjectRenderer;
 typedef ObjectRenderer<2> ObjectRenderer2D;
 typedef ObjectRenderer<3> ObjectRenderer3D;
@@ -28,7 +28,9 @@
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
 #include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/DebugTools/ShapeRenderer.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Trade/MeshData2D.h"
@@ -122,6 +124,18 @@ template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShap
 
 template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::~AbstractShapeRenderer() {}
 
+template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+    MatrixTypeFor<dimensions, Float> transformation;
+    transformations(*options, &transformation);
+    wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformation)
+        .setColor(options->color());
+    wireframeMesh->draw(*wireframeShader);
+}
+
+template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::configurePart(UnsignedInt, MeshView& view) {
+    view.setCount(wireframeMesh->count());
+}
+
 template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::createResources(typename MeshData<dimensions>::Type data) {
     create<dimensions>(data, wireframeMesh, vertexBuffer, indexBuffer);
 }
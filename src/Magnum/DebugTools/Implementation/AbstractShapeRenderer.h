@@ -50,7 +50,24 @@ template<UnsignedInt dimensions> class AbstractShapeRenderer {
         AbstractShapeRenderer(ResourceKey mesh, ResourceKey vertexBuffer, ResourceKey indexBuffer);
         virtual ~AbstractShapeRenderer();
 
-        virtual void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) = 0;
+        /* Draws the shape parts with given transformations */
+        virtual void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix);
+
+        /* Count of mesh parts the shape is drawn with */
+        virtual UnsignedInt partCount() const { return 1; }
+
+        /* Configures view of given part on a mesh with the same
+           configuration as mesh() */
+        virtual void configurePart(UnsignedInt part, MeshView& view);
+
+        /* Fills partCount() transformations of the mesh parts */
+        virtual void transformations(const ShapeRendererOptions& options, MatrixTypeFor<dimensions, Float>* out) = 0;
+
+        /* Shared mesh and its buffers, used for creating instanced meshes.
+           The index buffer is nullptr if the mesh is not indexed. */
+        Mesh& mesh() { return *wireframeMesh; }
+        Buffer& vertices() { return *vertexBuffer; }
+        Buffer* indices() { return indexBuffer ? &*indexBuffer : nullptr; }
 
     protected:
         /* Call only if the mesh resource isn't already present */
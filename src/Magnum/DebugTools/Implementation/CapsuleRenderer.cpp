@@ -25,6 +25,8 @@
 
 #include "CapsuleRenderer.h"
 
+#include <algorithm>
+
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshView.h"
 #include "Magnum/DebugTools/ResourceManager.h"
@@ -39,73 +41,123 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
+namespace {
+    constexpr UnsignedInt Rings = 10;
+    constexpr UnsignedInt Segments = 40;
+}
+
 AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>("capsule2d", "capsule2d-vertices", "capsule2d-indices") {
-    constexpr UnsignedInt rings = 10;
-    if(!wireframeMesh) createResources(Primitives::Capsule2D::wireframe(rings, 1, 1.0f));
+    if(!wireframeMesh) createResources(Primitives::Capsule2D::wireframe(Rings, 1, 1.0f));
 
     /* Bottom hemisphere */
     if(!(bottom = ResourceManager::instance().get<MeshView>("capsule2d-bottom"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(rings*4)
-            .setIndexRange(0, 0, rings*2+1);
+        configurePart(0, *view);
         ResourceManager::instance().set(bottom.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 
     /* Cylinder */
     if(!(cylinder = ResourceManager::instance().get<MeshView>("capsule2d-cylinder"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(4)
-            .setIndexRange(rings*4, rings*2+1, rings*2+3);
+        configurePart(1, *view);
         ResourceManager::instance().set(cylinder.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 
     /* Top hemisphere */
     if(!(top = ResourceManager::instance().get<MeshView>("capsule2d-top"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(rings*4)
-            .setIndexRange(rings*4+4, rings*2+3, rings*4+4);
+        configurePart(2, *view);
         ResourceManager::instance().set(top.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 }
 
+void AbstractCapsuleRenderer<2>::configurePart(const UnsignedInt part, MeshView& view) {
+    switch(part) {
+        /* Bottom hemisphere */
+        case 0:
+            view.setCount(Rings*4)
+                .setIndexRange(0, 0, Rings*2+1);
+            return;
+
+        /* Cylinder */
+        case 1:
+            view.setCount(4)
+                .setIndexRange(Rings*4, Rings*2+1, Rings*2+3);
+            return;
+
+        /* Top hemisphere */
+        case 2:
+            view.setCount(Rings*4)
+                .setIndexRange(Rings*4+4, Rings*2+3, Rings*4+4);
+            return;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
 AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>("capsule3d", "capsule3d-vertices", "capsule3d-indices") {
-    constexpr UnsignedInt rings = 10;
-    constexpr UnsignedInt segments = 40;
-    if(!wireframeMesh) createResources(Primitives::Capsule3D::wireframe(rings, 1, segments, 1.0f));
+    if(!wireframeMesh) createResources(Primitives::Capsule3D::wireframe(Rings, 1, Segments, 1.0f));
 
     /* Bottom hemisphere */
     if(!(bottom = ResourceManager::instance().get<MeshView>("capsule3d-bottom"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(rings*8)
-            .setIndexRange(0, 0, rings*4+1);
+        configurePart(0, *view);
         ResourceManager::instance().set(bottom.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 
     /* Cylinder */
     if(!(cylinder = ResourceManager::instance().get<MeshView>("capsule3d-cylinder"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(segments*4+8)
-            .setIndexRange(rings*8, rings*4+1, rings*4+segments*2+5);
+        configurePart(1, *view);
         ResourceManager::instance().set(cylinder.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 
     /* Top */
     if(!(top = ResourceManager::instance().get<MeshView>("capsule3d-top"))) {
         auto view = new MeshView(*wireframeMesh);
-        view->setCount(rings*8)
-            .setIndexRange(rings*8+segments*4+8, rings*4+segments*2+5, rings*8+segments*2+6);
+        configurePart(2, *view);
         ResourceManager::instance().set(top.key(), view, ResourceDataState::Final, ResourcePolicy::Manual);
     }
 }
 
+void AbstractCapsuleRenderer<3>::configurePart(const UnsignedInt part, MeshView& view) {
+    switch(part) {
+        /* Bottom hemisphere */
+        case 0:
+            view.setCount(Rings*8)
+                .setIndexRange(0, 0, Rings*4+1);
+            return;
+
+        /* Cylinder */
+        case 1:
+            view.setCount(Segments*4+8)
+                .setIndexRange(Rings*8, Rings*4+1, Rings*4+Segments*2+5);
+            return;
+
+        /* Top */
+        case 2:
+            view.setCount(Rings*8)
+                .setIndexRange(Rings*8+Segments*4+8, Rings*4+Segments*2+5, Rings*8+Segments*2+6);
+            return;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
 AbstractCapsuleRenderer<2>::~AbstractCapsuleRenderer() = default;
 
 AbstractCapsuleRenderer<3>::~AbstractCapsuleRenderer() = default;
 
 template<UnsignedInt dimensions> CapsuleRenderer<dimensions>::CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>& capsule): capsule(static_cast<const Shapes::Implementation::Shape<Shapes::Capsule<dimensions>>&>(capsule).shape) {}
 
+template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::transformations(const ShapeRendererOptions&, MatrixTypeFor<dimensions, Float>* const out) {
+    const std::array<MatrixTypeFor<dimensions, Float>, 3> matrices = Implementation::capsuleRendererTransformation<dimensions>(capsule.a(), capsule.b(), capsule.radius());
+    std::copy(matrices.begin(), matrices.end(), out);
+}
+
 template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
-    std::array<MatrixTypeFor<dimensions, Float>, 3> transformations = Implementation::capsuleRendererTransformation<dimensions>(capsule.a(), capsule.b(), capsule.radius());
+    MatrixTypeFor<dimensions, Float> transformations[3];
+    this->transformations(*options, transformations);
     AbstractShapeRenderer<dimensions>::wireframeShader->setColor(options->color());
 
     /* Bottom */
@@ -38,6 +38,9 @@ template<> class AbstractCapsuleRenderer<2>: public AbstractShapeRenderer<2> {
         explicit AbstractCapsuleRenderer();
         ~AbstractCapsuleRenderer();
 
+        UnsignedInt partCount() const override { return 3; }
+        void configurePart(UnsignedInt part, MeshView& view) override;
+
     protected:
         Resource<MeshView> bottom, cylinder, top;
 };
@@ -47,6 +50,9 @@ template<> class AbstractCapsuleRenderer<3>: public AbstractShapeRenderer<3> {
         explicit AbstractCapsuleRenderer();
         ~AbstractCapsuleRenderer();
 
+        UnsignedInt partCount() const override { return 3; }
+        void configurePart(UnsignedInt part, MeshView& view) override;
+
     protected:
         Resource<MeshView> bottom, cylinder, top;
 };
@@ -57,6 +63,7 @@ template<UnsignedInt dimensions> class CapsuleRenderer: public AbstractCapsuleRe
         CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>&&) = delete;
 
         void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) override;
+        void transformations(const ShapeRendererOptions& options, MatrixTypeFor<dimensions, Float>* out) override;
 
     private:
         const Shapes::Capsule<dimensions>& capsule;
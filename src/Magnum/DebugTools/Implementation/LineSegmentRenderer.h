@@ -36,7 +36,7 @@ template<UnsignedInt dimensions> class LineSegmentRenderer: public AbstractShape
         explicit LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>& line);
         LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>&&) = delete;
 
-        void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) override;
+        void transformations(const ShapeRendererOptions& options, MatrixTypeFor<dimensions, Float>* out) override;
 
     private:
         const Shapes::LineSegment<dimensions>& line;
@@ -53,13 +53,10 @@ template<UnsignedInt dimensions> PointRenderer<dimensions>::PointRenderer(const
     if(!AbstractShapeRenderer<dimensions>::wireframeMesh) AbstractShapeRenderer<dimensions>::createResources(meshData<dimensions>());
 }
 
-template<UnsignedInt dimensions> void PointRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+template<UnsignedInt dimensions> void PointRenderer<dimensions>::transformations(const ShapeRendererOptions& options, MatrixTypeFor<dimensions, Float>* const out) {
     /* Half scale, because the point is 2x2(x2) */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
-        MatrixTypeFor<dimensions, Float>::translation(point.position())*
-        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options->pointSize()/2}))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    out[0] = MatrixTypeFor<dimensions, Float>::translation(point.position())*
+        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options.pointSize()/2});
 }
 
 template class PointRenderer<2>;
@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstancedRenderer.h"
+
+#include <algorithm>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/DebugTools/ObjectRenderer.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/DebugTools/ShapeRenderer.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shapes/AbstractShape.h"
+
+#include "Implementation/AbstractShapeRenderer.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace Implementation {
+
+template<UnsignedInt dimensions> struct Instance {
+    MatrixTypeFor<dimensions, Float> transformation;
+    Color4 color;
+};
+
+/* Instanced copy of a shared mesh (or a part of it), drawn with per-instance
+   transformations and colors */
+template<UnsignedInt dimensions> struct InstanceBatch {
+    explicit InstanceBatch(): instanceBuffer{Buffer::TargetHint::Array}, view{mesh} {}
+
+    Mesh mesh;
+    Buffer instanceBuffer;
+    MeshView view;
+    std::vector<Instance<dimensions>> instances;
+};
+
+}
+
+namespace {
+
+template<UnsignedInt> ResourceKey shaderKey();
+template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShaderInstanced2D"); }
+template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShaderInstanced3D"); }
+
+Mesh::IndexType indexTypeFor(const std::size_t size) {
+    switch(size) {
+        case 1: return Mesh::IndexType::UnsignedByte;
+        case 2: return Mesh::IndexType::UnsignedShort;
+    }
+
+    CORRADE_INTERNAL_ASSERT(size == 4);
+    return Mesh::IndexType::UnsignedInt;
+}
+
+/* Configures the batch mesh to use the same vertex and index data as
+   `source`, with instanced transformation and color taken from the batch
+   instance buffer */
+template<UnsignedInt dimensions> void configureBatch(Implementation::InstanceBatch<dimensions>& batch, const Mesh& source, Buffer& vertices, Buffer* indices, const std::size_t vertexGap) {
+    batch.mesh.setPrimitive(source.primitive())
+        .setCount(source.count())
+        .addVertexBuffer(vertices, 0, typename Shaders::Flat<dimensions>::Position{}, vertexGap)
+        .addVertexBufferInstanced(batch.instanceBuffer, 1, 0,
+            typename Shaders::Flat<dimensions>::TransformationMatrix{},
+            typename Shaders::Flat<dimensions>::InstanceColor{});
+    if(indices) batch.mesh.setIndexBuffer(*indices, 0, indexTypeFor(source.indexSize()));
+}
+
+}
+
+template<UnsignedInt dimensions> struct InstancedRenderer<dimensions>::ShapeEntry {
+    explicit ShapeEntry(Shapes::AbstractShape<dimensions>& shape, ResourceKey options): shape(shape), options{ResourceManager::instance().get<ShapeRendererOptions>(options)} {
+        Implementation::createDebugMesh(renderers, Shapes::Implementation::getAbstractShape(shape));
+    }
+
+    ~ShapeEntry() {
+        for(auto i: renderers) delete i;
+    }
+
+    Shapes::AbstractShape<dimensions>& shape;
+    Resource<ShapeRendererOptions> options;
+    std::vector<Implementation::AbstractShapeRenderer<dimensions>*> renderers;
+};
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::InstancedRenderer(): _drawCallCount{} {
+    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
+    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(),
+        new Shaders::Flat<dimensions>{Shaders::Flat<dimensions>::Flag::InstancedTransformation|Shaders::Flat<dimensions>::Flag::InstancedColor},
+        ResourceDataState::Final, ResourcePolicy::Resident);
+
+    Implementation::objectRendererResources<dimensions>(_axisMesh, _axisVertexBuffer, _axisIndexBuffer);
+}
+
+/* To avoid deleting pointers to incomplete type on destruction of Resource members */
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::~InstancedRenderer() = default;
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>& InstancedRenderer<dimensions>::addShape(Shapes::AbstractShape<dimensions>& shape, ResourceKey options) {
+    _shapes.emplace_back(new ShapeEntry{shape, options});
+    return *this;
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>& InstancedRenderer<dimensions>::removeShape(Shapes::AbstractShape<dimensions>& shape) {
+    auto found = std::find_if(_shapes.begin(), _shapes.end(), [&shape](const std::unique_ptr<ShapeEntry>& entry) {
+        return &entry->shape == &shape;
+    });
+    if(found != _shapes.end()) _shapes.erase(found);
+    return *this;
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>& InstancedRenderer<dimensions>::addObject(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options) {
+    _objects.push_back(object);
+    _objectOptions.push_back(ResourceManager::instance().get<ObjectRendererOptions>(options));
+    return *this;
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>& InstancedRenderer<dimensions>::removeObject(SceneGraph::AbstractObject<dimensions, Float>& object) {
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        if(&_objects[i].get() != &object) continue;
+        _objects.erase(_objects.begin() + i);
+        _objectOptions.erase(_objectOptions.begin() + i);
+        break;
+    }
+    return *this;
+}
+
+template<UnsignedInt dimensions> Implementation::InstanceBatch<dimensions>& InstancedRenderer<dimensions>::batch(const BatchKey& key) {
+    std::unique_ptr<Implementation::InstanceBatch<dimensions>>& batch = _batches[key];
+    if(!batch) batch.reset(new Implementation::InstanceBatch<dimensions>);
+    return *batch;
+}
+
+template<UnsignedInt dimensions> void InstancedRenderer<dimensions>::draw(SceneGraph::Camera<dimensions, Float>& camera) {
+    SceneGraph::AbstractObject<dimensions, Float>* const scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "DebugTools::InstancedRenderer::draw(): camera is not part of any scene", );
+
+    for(auto& batch: _batches) batch.second->instances.clear();
+
+    /* Update transformed shapes and camera matrix */
+    _cleanObjects.clear();
+    _cleanObjects.reserve(_shapes.size() + 1);
+    for(const std::unique_ptr<ShapeEntry>& entry: _shapes)
+        _cleanObjects.push_back(entry->shape.object());
+    _cleanObjects.push_back(camera.object());
+    SceneGraph::AbstractObject<dimensions, Float>::setClean(_cleanObjects);
+
+    /* Gather shape instances, the transformed shapes are already in absolute
+       coordinates */
+    MatrixTypeFor<dimensions, Float> partTransformations[3];
+    for(const std::unique_ptr<ShapeEntry>& entry: _shapes) {
+        const ShapeRendererOptions& options = *entry->options;
+        for(Implementation::AbstractShapeRenderer<dimensions>* renderer: entry->renderers) {
+            const UnsignedInt partCount = renderer->partCount();
+            CORRADE_INTERNAL_ASSERT(partCount <= 3);
+            renderer->transformations(options, partTransformations);
+
+            for(UnsignedInt part = 0; part != partCount; ++part) {
+                Implementation::InstanceBatch<dimensions>& batch = this->batch({&renderer->mesh(), part});
+                if(batch.mesh.count() == 0) {
+                    configureBatch(batch, renderer->mesh(), renderer->vertices(), renderer->indices(), 0);
+                    renderer->configurePart(part, batch.view);
+                }
+
+                batch.instances.push_back({partTransformations[part], options.color()});
+            }
+        }
+    }
+
+    /* Gather object instances, each axis is a separate batch with its own
+       color. The vertex buffer has interleaved colors, which are skipped. */
+    if(!_objects.empty()) scene->transformationMatrices(_objects, _transformations);
+    for(UnsignedInt axis = 0; axis != dimensions && !_objects.empty(); ++axis) {
+        Implementation::InstanceBatch<dimensions>& batch = this->batch({&*_axisMesh, axis});
+        if(batch.mesh.count() == 0) {
+            configureBatch(batch, *_axisMesh, *_axisVertexBuffer, &*_axisIndexBuffer, sizeof(Color3));
+            batch.view.setCount(6)
+                .setIndexRange(axis*6);
+        }
+
+        Color4 color{0.0f, 0.0f, 0.0f, 1.0f};
+        color[axis] = 1.0f;
+        for(std::size_t i = 0; i != _objects.size(); ++i)
+            batch.instances.push_back({_transformations[i]*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_objectOptions[i]->size()}), color});
+    }
+
+    /* Upload and draw */
+    _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*camera.cameraMatrix())
+        .setColor(Color4{1.0f});
+    _drawCallCount = 0;
+    for(auto& item: _batches) {
+        Implementation::InstanceBatch<dimensions>& batch = *item.second;
+        if(batch.instances.empty()) continue;
+
+        batch.instanceBuffer.setData(batch.instances, BufferUsage::StreamDraw);
+        batch.view.setInstanceCount(Int(batch.instances.size()));
+        batch.view.draw(*_shader);
+        ++_drawCallCount;
+    }
+}
+
+template class InstancedRenderer<2>;
+template class InstancedRenderer<3>;
+
+}}
@@ -0,0 +1,205 @@
+#ifndef Magnum_DebugTools_InstancedRenderer_h
+#define Magnum_DebugTools_InstancedRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::InstancedRenderer, typedef @ref Magnum::DebugTools::InstancedRenderer2D, @ref Magnum::DebugTools::InstancedRenderer3D
+ */
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Resource.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace Implementation {
+    template<UnsignedInt> struct InstanceBatch;
+}
+
+/**
+@brief Instanced shape and object renderer
+
+@ref ShapeRenderer and @ref ObjectRenderer are drawables that issue at least
+one draw call with its own uniform setup for every shape or object, which
+quickly becomes the bottleneck with thousands of them. This renderer instead
+gathers transformations and colors of all shapes of the same type into an
+instance buffer each frame and draws them with one instanced draw call. The
+draw call count is then given by the count of distinct shape types and not by
+the count of shapes.
+
+@anchor DebugTools-InstancedRenderer-usage
+## Basic usage
+
+Shapes and objects are added with the same options as used by
+@ref ShapeRenderer and @ref ObjectRenderer, the renderer is then drawn
+explicitly with given camera instead of being part of a drawable group:
+@code
+// Create some options
+DebugTools::ResourceManager::instance().set("red",
+    DebugTools::ShapeRendererOptions().setColor({1.0f, 0.0f, 0.0f}));
+
+DebugTools::InstancedRenderer3D debugRenderer;
+for(Shapes::AbstractShape3D* shape: colliders)
+    debugRenderer.addShape(*shape, "red");
+debugRenderer.addObject(player);
+
+// in drawEvent()
+camera.draw(drawables);
+debugRenderer.draw(camera);
+@endcode
+
+Shapes and objects must be available for the whole lifetime of the renderer
+or until removed using @ref removeShape() or @ref removeObject() and if the
+shape is a group, it must not change its internal structure. Option resources
+are queried on every @ref draw(), so the color or point size can be changed
+at any time.
+
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+    @es_extension{EXT,instanced_arrays} or
+    @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
+    1.0.
+
+@see @ref InstancedRenderer2D, @ref InstancedRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT InstancedRenderer {
+    public:
+        explicit InstancedRenderer();
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer(const InstancedRenderer<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedRenderer(InstancedRenderer<dimensions>&&) = delete;
+
+        ~InstancedRenderer();
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer<dimensions>& operator=(const InstancedRenderer<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedRenderer<dimensions>& operator=(InstancedRenderer<dimensions>&&) = delete;
+
+        /** @brief Count of added shapes */
+        std::size_t shapeCount() const { return _shapes.size(); }
+
+        /** @brief Count of added objects */
+        std::size_t objectCount() const { return _objects.size(); }
+
+        /**
+         * @brief Count of draw calls issued by last @ref draw()
+         *
+         * One for each distinct shape type (three for capsules, which are
+         * drawn in parts) and one for each axis of the objects.
+         */
+        UnsignedInt drawCallCount() const { return _drawCallCount; }
+
+        /**
+         * @brief Add shape
+         * @param shape     Shape to render
+         * @param options   @ref ShapeRendererOptions resource key
+         * @return Reference to self (for method chaining)
+         *
+         * @ref ShapeRendererOptions::renderMode() is ignored, the same as in
+         * @ref ShapeRenderer.
+         */
+        InstancedRenderer<dimensions>& addShape(Shapes::AbstractShape<dimensions>& shape, ResourceKey options = ResourceKey());
+
+        /**
+         * @brief Remove shape
+         * @return Reference to self (for method chaining)
+         *
+         * Does nothing if the shape wasn't added.
+         */
+        InstancedRenderer<dimensions>& removeShape(Shapes::AbstractShape<dimensions>& shape);
+
+        /**
+         * @brief Add object
+         * @param object    Object whose axes to render
+         * @param options   @ref ObjectRendererOptions resource key
+         * @return Reference to self (for method chaining)
+         */
+        InstancedRenderer<dimensions>& addObject(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options = ResourceKey());
+
+        /**
+         * @brief Remove object
+         * @return Reference to self (for method chaining)
+         *
+         * Does nothing if the object wasn't added.
+         */
+        InstancedRenderer<dimensions>& removeObject(SceneGraph::AbstractObject<dimensions, Float>& object);
+
+        /**
+         * @brief Draw all shapes and objects
+         *
+         * Cleans absolute transformations of all shape and object owners,
+         * uploads the instance data and issues one instanced draw call for
+         * each mesh that has at least one instance. Expects that the camera
+         * is part of a scene.
+         */
+        void draw(SceneGraph::Camera<dimensions, Float>& camera);
+
+    private:
+        struct ShapeEntry;
+
+        typedef std::pair<const Mesh*, UnsignedInt> BatchKey;
+
+        Implementation::InstanceBatch<dimensions>& batch(const BatchKey& key);
+
+        Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> _shader;
+        Resource<Mesh> _axisMesh;
+        Resource<Buffer> _axisVertexBuffer, _axisIndexBuffer;
+
+        std::vector<std::unique_ptr<ShapeEntry>> _shapes;
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
+        std::vector<Resource<ObjectRendererOptions>> _objectOptions;
+        std::map<BatchKey, std::unique_ptr<Implementation::InstanceBatch<dimensions>>> _batches;
+
+        /* Reused between draws to avoid allocations */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _cleanObjects;
+        std::vector<MatrixTypeFor<dimensions, Float>> _transformations;
+
+        UnsignedInt _drawCallCount;
+};
+
+/** @brief Two-dimensional instanced renderer */
+typedef InstancedRenderer<2> InstancedRenderer2D;
+
+/** @brief Three-dimensional instanced renderer */
+typedef InstancedRenderer<3> InstancedRenderer3D;
+
+}}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryUsage.h"
+
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Context.h"
+
+namespace Magnum { namespace DebugTools {
+
+void printMemoryUsage() {
+    Context& context = Context::current();
+
+    if(!context.isMemoryTrackingEnabled()) {
+        Debug() << "Memory tracking is disabled, enable it with Context::setMemoryTrackingEnabled()";
+    } else {
+        Debug() << "Tracked memory usage:";
+
+        std::size_t total = 0;
+        for(auto type: {std::make_pair(Context::MemoryObject::Buffer, "Buffers:"),
+                        std::make_pair(Context::MemoryObject::Texture, "Textures:"),
+                        std::make_pair(Context::MemoryObject::Renderbuffer, "Renderbuffers:")}) {
+            const Context::MemoryUsage usage = context.memoryUsage(type.first);
+            Debug() << " " << type.second << usage.objectCount << "objects," << (usage.byteCount + 1023)/1024 << "kB";
+            total += usage.byteCount;
+        }
+
+        Debug() << "  Total:" << (total + 1023)/1024 << "kB";
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const std::size_t available = context.availableDeviceMemory();
+    const std::size_t totalDevice = context.totalDeviceMemory();
+    if(available && totalDevice)
+        Debug() << "Device memory:" << available/1024 << "kB free out of" << totalDevice/1024 << "kB";
+    else if(available)
+        Debug() << "Device memory:" << available/1024 << "kB free";
+    #endif
+}
+
+}}
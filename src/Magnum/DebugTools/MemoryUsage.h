@@ -0,0 +1,63 @@
+#ifndef Magnum_DebugTools_MemoryUsage_h
+#define Magnum_DebugTools_MemoryUsage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::DebugTools::printMemoryUsage()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Print memory usage of GL objects
+
+Prints count of live buffers, textures and renderbuffers and memory occupied
+by them, as tracked by the current context, followed by total and free device
+memory if the driver exposes it. Example output:
+@code
+Tracked memory usage:
+  Buffers: 35 objects, 48210 kB
+  Textures: 12 objects, 174762 kB
+  Renderbuffers: 2 objects, 16200 kB
+  Total: 239172 kB
+Device memory: 1482304 kB free out of 2097152 kB
+@endcode
+
+The tracking needs to be enabled with
+@ref Context::setMemoryTrackingEnabled() first, ideally right after context
+creation. Calling this function periodically and comparing the numbers is a
+simple way to detect leaked objects.
+@see @ref Context::memoryUsage(), @ref Context::totalDeviceMemory(),
+    @ref Context::availableDeviceMemory()
+*/
+MAGNUM_DEBUGTOOLS_EXPORT void printMemoryUsage();
+
+}}
+
+#endif
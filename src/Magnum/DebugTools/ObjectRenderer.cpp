@@ -144,36 +144,47 @@ const std::array<UnsignedByte, 18> Renderer<3>::indices{{
 
 }
 
-/* MSVC 2015 can't handle {} here */
-template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{ResourceManager::instance().get<ObjectRendererOptions>(options)} {
-    /* Shader */
-    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::VertexColor<dimensions>>(Renderer<dimensions>::shader());
-    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::VertexColor<dimensions>);
+namespace Implementation {
 
-    /* Mesh and vertex buffer */
-    _mesh = ResourceManager::instance().get<Mesh>(Renderer<dimensions>::mesh());
-    _vertexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::vertexBuffer());
-    _indexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::indexBuffer());
-    if(_mesh) return;
+template<UnsignedInt dimensions> void objectRendererResources(Resource<Mesh>& mesh, Resource<Buffer>& vertexBuffer, Resource<Buffer>& indexBuffer) {
+    mesh = ResourceManager::instance().get<Mesh>(Renderer<dimensions>::mesh());
+    vertexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::vertexBuffer());
+    indexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::indexBuffer());
+    if(mesh) return;
 
     /* Create the mesh */
-    Buffer* vertexBuffer = new Buffer{Buffer::TargetHint::Array};
-    Buffer* indexBuffer = new Buffer{Buffer::TargetHint::ElementArray};
-    Mesh* mesh = new Mesh;
+    Buffer* vertices = new Buffer{Buffer::TargetHint::Array};
+    Buffer* indices = new Buffer{Buffer::TargetHint::ElementArray};
+    Mesh* axes = new Mesh;
 
-    vertexBuffer->setData(MeshTools::interleave(Renderer<dimensions>::positions, Renderer<dimensions>::colors), BufferUsage::StaticDraw);
-    ResourceManager::instance().set(_vertexBuffer.key(), vertexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    vertices->setData(MeshTools::interleave(Renderer<dimensions>::positions, Renderer<dimensions>::colors), BufferUsage::StaticDraw);
+    ResourceManager::instance().set(vertexBuffer.key(), vertices, ResourceDataState::Final, ResourcePolicy::Manual);
 
-    indexBuffer->setData(Renderer<dimensions>::indices, BufferUsage::StaticDraw);
-    ResourceManager::instance().set(_indexBuffer.key(), indexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    indices->setData(Renderer<dimensions>::indices, BufferUsage::StaticDraw);
+    ResourceManager::instance().set(indexBuffer.key(), indices, ResourceDataState::Final, ResourcePolicy::Manual);
 
-    mesh->setPrimitive(MeshPrimitive::Lines)
+    axes->setPrimitive(MeshPrimitive::Lines)
         .setCount(Renderer<dimensions>::indices.size())
-        .addVertexBuffer(*vertexBuffer, 0,
+        .addVertexBuffer(*vertices, 0,
             typename Shaders::VertexColor<dimensions>::Position(),
             typename Shaders::VertexColor<dimensions>::Color())
-        .setIndexBuffer(*indexBuffer, 0, Mesh::IndexType::UnsignedByte, 0, Renderer<dimensions>::positions.size());
-    ResourceManager::instance().set<Mesh>(_mesh.key(), _mesh, ResourceDataState::Final, ResourcePolicy::Manual);
+        .setIndexBuffer(*indices, 0, Mesh::IndexType::UnsignedByte, 0, Renderer<dimensions>::positions.size());
+    ResourceManager::instance().set<Mesh>(mesh.key(), axes, ResourceDataState::Final, ResourcePolicy::Manual);
+}
+
+template void objectRendererResources<2>(Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&);
+template void objectRendererResources<3>(Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&);
+
+}
+
+/* MSVC 2015 can't handle {} here */
+template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{ResourceManager::instance().get<ObjectRendererOptions>(options)} {
+    /* Shader */
+    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::VertexColor<dimensions>>(Renderer<dimensions>::shader());
+    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::VertexColor<dimensions>);
+
+    /* Mesh and vertex buffer */
+    Implementation::objectRendererResources<dimensions>(_mesh, _vertexBuffer, _indexBuffer);
 }
 
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
@@ -36,6 +36,13 @@
 
 namespace Magnum { namespace DebugTools {
 
+namespace Implementation {
+    /* Fetches shared axis mesh and its buffers, creating them if they are
+       not present yet. Axes are drawn with six indices each, in X, Y(, Z)
+       order. */
+    template<UnsignedInt dimensions> void objectRendererResources(Resource<Mesh>& mesh, Resource<Buffer>& vertexBuffer, Resource<Buffer>& indexBuffer);
+}
+
 /**
 @brief Object renderer options
 
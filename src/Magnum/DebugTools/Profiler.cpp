@@ -26,7 +26,12 @@
 #include "Profiler.h"
 
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
 #include <numeric>
+#include <thread>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -36,6 +41,212 @@ using namespace std::chrono;
 
 namespace Magnum { namespace DebugTools {
 
+namespace Implementation {
+
+struct ProfilerCapture {
+    /* Scopes can be recorded from any thread, everything here is guarded */
+    std::mutex mutex;
+    std::ofstream file;
+    Profiler::TraceFormat format;
+    bool first;
+    /* Incremented on every capture so scopes spanning two captures are
+       dropped */
+    UnsignedInt generation{};
+    UnsignedInt frameCount{};
+    high_resolution_clock::time_point begin;
+
+    struct Thread {
+        std::thread::id id;
+        UnsignedInt depth;
+    };
+    std::vector<Thread> threads;
+
+    /* Index of calling thread in the trace, must be called with the mutex
+       locked */
+    UnsignedInt thread();
+
+    /* Must be called with the mutex locked */
+    void write(const char* type, const std::string& name, UnsignedInt thread, UnsignedInt depth, high_resolution_clock::time_point time, high_resolution_clock::duration duration);
+};
+
+UnsignedInt ProfilerCapture::thread() {
+    const std::thread::id id = std::this_thread::get_id();
+    for(std::size_t i = 0; i != threads.size(); ++i)
+        if(threads[i].id == id) return i;
+
+    threads.push_back({id, 0});
+    return threads.size() - 1;
+}
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& string) {
+    out << '"';
+    for(const char c: string) {
+        if(c == '"' || c == '\\') out << '\\' << c;
+        else if(UnsignedByte(c) < 0x20) {
+            const char hex[] = "0123456789abcdef";
+            out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+        } else out << c;
+    }
+    out << '"';
+}
+
+void writeCsvString(std::ostream& out, const std::string& string) {
+    if(string.find_first_of(",\"\n\r") == std::string::npos) {
+        out << string;
+        return;
+    }
+
+    /* Quote the value and double all quotes inside */
+    out << '"';
+    for(const char c: string) {
+        if(c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+}
+
+void ProfilerCapture::write(const char* const type, const std::string& name, const UnsignedInt thread, const UnsignedInt depth, const high_resolution_clock::time_point time, const high_resolution_clock::duration duration) {
+    const Double timestamp = duration_cast<nanoseconds>(time - begin).count()/1000.0;
+    const Double length = duration_cast<nanoseconds>(duration).count()/1000.0;
+
+    if(format == Profiler::TraceFormat::ChromeTrace) {
+        file << (first ? "\n" : ",\n") << "{\"name\":";
+        writeJsonString(file, name);
+        file << ",\"cat\":\"" << type << "\",\"pid\":0,\"tid\":" << thread << ",\"ts\":" << timestamp;
+
+        /* Frame boundaries are global instant events, the rest are complete
+           events */
+        if(std::string{type} == "frame") file << ",\"ph\":\"i\",\"s\":\"g\"}";
+        else file << ",\"ph\":\"X\",\"dur\":" << length << ",\"args\":{\"depth\":" << depth << "}}";
+    } else {
+        file << type << ',';
+        writeCsvString(file, name);
+        file << ',' << thread << ',' << depth << ',' << timestamp << ',' << length << '\n';
+    }
+
+    first = false;
+}
+
+}
+
+#ifdef MAGNUM_BUILD_STATISTICS
+namespace {
+
+void addStatistics(Context::Statistics& out, const Context::Statistics& in) {
+    out.drawCalls += in.drawCalls;
+    out.meshBinds += in.meshBinds;
+    out.shaderSwitches += in.shaderSwitches;
+    out.textureBinds += in.textureBinds;
+    out.framebufferBinds += in.framebufferBinds;
+    out.bufferBinds += in.bufferBinds;
+    out.bufferUploads += in.bufferUploads;
+    out.bufferUploadBytes += in.bufferUploadBytes;
+}
+
+void subtractStatistics(Context::Statistics& out, const Context::Statistics& in) {
+    out.drawCalls -= in.drawCalls;
+    out.meshBinds -= in.meshBinds;
+    out.shaderSwitches -= in.shaderSwitches;
+    out.textureBinds -= in.textureBinds;
+    out.framebufferBinds -= in.framebufferBinds;
+    out.bufferBinds -= in.bufferBinds;
+    out.bufferUploads -= in.bufferUploads;
+    out.bufferUploadBytes -= in.bufferUploadBytes;
+}
+
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+namespace {
+
+/* Order of the query pools in Profiler::_pipelineQueries */
+constexpr PipelineStatisticsQuery::Target PipelineTargets[]{
+    PipelineStatisticsQuery::Target::VertexShaderInvocations,
+    PipelineStatisticsQuery::Target::FragmentShaderInvocations,
+    PipelineStatisticsQuery::Target::ClippingInputPrimitives,
+    PipelineStatisticsQuery::Target::ClippingOutputPrimitives
+};
+
+enum: std::size_t { PipelineTargetCount = sizeof(PipelineTargets)/sizeof(PipelineTargets[0]) };
+
+UnsignedLong& pipelineCounter(Profiler::PipelineStatistics& statistics, const std::size_t i) {
+    UnsignedLong* const counters[]{
+        &statistics.vertexShaderInvocations,
+        &statistics.fragmentShaderInvocations,
+        &statistics.clippingInputPrimitives,
+        &statistics.clippingOutputPrimitives
+    };
+    return *counters[i];
+}
+
+}
+#endif
+
+Profiler::Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _currentSection(otherSection)
+    #ifndef MAGNUM_TARGET_WEBGL
+    , _gpuEnabled{false}, _gpuRunning{false}, _gpuLatency{3}, _gpuCurrentFrame{0}, _gpuFrameCount{0}
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    , _pipelineEnabled{false}, _pipelineRunning{false}, _pipelineCurrentFrame{0}, _pipelineFrameCount{0}
+    #endif
+    #ifdef MAGNUM_BUILD_STATISTICS
+    , _statisticsTotal{}
+    #endif
+    /* Allocated upfront so scopes can keep a pointer to it even if the
+       profiler is moved */
+    , _capture{new Implementation::ProfilerCapture} {}
+
+Profiler::Profiler(Profiler&&) noexcept = default;
+
+Profiler::~Profiler() { endCapture(); }
+
+Profiler& Profiler::operator=(Profiler&& other) noexcept {
+    endCapture();
+
+    _enabled = other._enabled;
+    _measureDuration = other._measureDuration;
+    _currentFrame = other._currentFrame;
+    _frameCount = other._frameCount;
+    std::swap(_sections, other._sections);
+    std::swap(_frameData, other._frameData);
+    std::swap(_totalData, other._totalData);
+    _previousTime = other._previousTime;
+    _currentSection = other._currentSection;
+    #ifndef MAGNUM_TARGET_WEBGL
+    _gpuEnabled = other._gpuEnabled;
+    _gpuRunning = other._gpuRunning;
+    _gpuLatency = other._gpuLatency;
+    _gpuCurrentFrame = other._gpuCurrentFrame;
+    _gpuFrameCount = other._gpuFrameCount;
+    std::swap(_gpuFrames, other._gpuFrames);
+    std::swap(_gpuFrameValid, other._gpuFrameValid);
+    std::swap(_gpuFrameData, other._gpuFrameData);
+    std::swap(_gpuTotalData, other._gpuTotalData);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    _pipelineEnabled = other._pipelineEnabled;
+    _pipelineRunning = other._pipelineRunning;
+    _pipelineCurrentFrame = other._pipelineCurrentFrame;
+    _pipelineFrameCount = other._pipelineFrameCount;
+    std::swap(_pipelineQueries, other._pipelineQueries);
+    std::swap(_pipelineFrames, other._pipelineFrames);
+    std::swap(_pipelineFrameValid, other._pipelineFrameValid);
+    std::swap(_pipelineFrameData, other._pipelineFrameData);
+    std::swap(_pipelineTotalData, other._pipelineTotalData);
+    #endif
+    #ifdef MAGNUM_BUILD_STATISTICS
+    std::swap(_statisticsData, other._statisticsData);
+    _statisticsTotal = other._statisticsTotal;
+    #endif
+    std::swap(_capture, other._capture);
+    return *this;
+}
+
 Profiler::Section Profiler::addSection(const std::string& name) {
     CORRADE_ASSERT(!_enabled, "Profiler: cannot add section when profiling is enabled", 0);
     _sections.push_back(name);
@@ -47,14 +258,81 @@ void Profiler::setMeasureDuration(std::size_t frames) {
     _measureDuration = frames;
 }
 
+#ifndef MAGNUM_TARGET_WEBGL
+void Profiler::setGpuMeasurementEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot enable GPU measurement when profiling is enabled", );
+    _gpuEnabled = enabled;
+}
+
+void Profiler::setGpuLatency(const std::size_t frames) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot set GPU latency when profiling is enabled", );
+    CORRADE_ASSERT(frames, "Profiler: GPU latency must be at least one frame", );
+    _gpuLatency = frames;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void Profiler::setPipelineStatisticsEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot enable pipeline statistics when profiling is enabled", );
+    _pipelineEnabled = enabled;
+}
+#endif
+
 void Profiler::enable() {
     _enabled = true;
     _frameData.assign(_measureDuration*_sections.size(), high_resolution_clock::duration::zero());
     _totalData.assign(_sections.size(), high_resolution_clock::duration::zero());
     _frameCount = 0;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) {
+        _gpuFrames.resize(_gpuLatency);
+        for(GpuFrame& frame: _gpuFrames) frame.used = 0;
+        _gpuFrameValid.assign(_measureDuration, false);
+        _gpuFrameData.assign(_measureDuration*_sections.size(), 0);
+        _gpuTotalData.assign(_sections.size(), 0);
+        _gpuCurrentFrame = 0;
+        _gpuFrameCount = 0;
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) {
+        /* The pools are kept across enable() calls so the queries are
+           reused, only the handles of pending queries are dropped */
+        if(_pipelineQueries.empty()) for(const PipelineStatisticsQuery::Target target: PipelineTargets)
+            _pipelineQueries.emplace_back(target);
+        for(PipelineFrame& frame: _pipelineFrames) {
+            for(std::size_t i = 0; i != frame.queries.size(); ++i)
+                _pipelineQueries[i % PipelineTargetCount].release(frame.queries[i]);
+            frame.queries.clear();
+            frame.sections.clear();
+        }
+        _pipelineFrames.resize(_gpuLatency);
+        _pipelineFrameValid.assign(_measureDuration, false);
+        _pipelineFrameData.assign(_measureDuration*_sections.size(), PipelineStatistics{});
+        _pipelineTotalData.assign(_sections.size(), PipelineStatistics{});
+        _pipelineCurrentFrame = 0;
+        _pipelineFrameCount = 0;
+    }
+    #endif
+
+    /* Discard everything counted before profiling was enabled */
+    #ifdef MAGNUM_BUILD_STATISTICS
+    _statisticsData.assign(_measureDuration, Context::Statistics{});
+    _statisticsTotal = Context::Statistics{};
+    Context::current().resetStatistics();
+    #endif
 }
 
 void Profiler::disable() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) gpuEnd();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) pipelineEnd();
+    #endif
+
     _enabled = false;
 }
 
@@ -65,6 +343,13 @@ void Profiler::start(Section section) {
     save();
 
     _currentSection = section;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) gpuBegin();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) pipelineBegin();
+    #endif
 }
 
 void Profiler::stop() {
@@ -79,12 +364,131 @@ void Profiler::save() {
     auto now = high_resolution_clock::now();
 
     /* If the profiler is already running, add time to given section */
-    if(_previousTime != high_resolution_clock::time_point())
+    if(_previousTime != high_resolution_clock::time_point()) {
         _frameData[_currentFrame*_sections.size()+_currentSection] += now-_previousTime;
 
+        if(_capture && _capture->file.is_open()) {
+            std::lock_guard<std::mutex> lock{_capture->mutex};
+            _capture->write("section", _sections[_currentSection], _capture->thread(), 0, _previousTime, now-_previousTime);
+        }
+    }
+
     /* Set current time as previous for next section */
     _previousTime = now;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) gpuEnd();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) pipelineEnd();
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void Profiler::gpuBegin() {
+    GpuFrame& frame = _gpuFrames[_gpuCurrentFrame];
+
+    /* The queries are reused in later frames, create new ones only if this
+       frame has more sections than any before */
+    if(frame.used == frame.queries.size()) {
+        frame.queries.emplace_back(TimeQuery::Target::TimeElapsed);
+        frame.sections.push_back(_currentSection);
+    } else frame.sections[frame.used] = _currentSection;
+
+    frame.queries[frame.used].begin();
+    _gpuRunning = true;
+}
+
+void Profiler::gpuEnd() {
+    if(!_gpuRunning) return;
+
+    GpuFrame& frame = _gpuFrames[_gpuCurrentFrame];
+    frame.queries[frame.used].end();
+    ++frame.used;
+    _gpuRunning = false;
+}
+
+void Profiler::gpuNextFrame() {
+    /* Split the currently running section at the frame boundary */
+    const bool running = _gpuRunning;
+    gpuEnd();
+
+    /* The oldest frame, _gpuLatency frames ago */
+    _gpuCurrentFrame = (_gpuCurrentFrame + 1) % _gpuLatency;
+    GpuFrame& frame = _gpuFrames[_gpuCurrentFrame];
+
+    /* Never wait for the results, if any of them is not available yet, drop
+       the whole frame */
+    bool available = frame.used != 0;
+    for(std::size_t i = 0; i != frame.used && available; ++i)
+        available = frame.queries[i].resultAvailable();
+
+    if(available) {
+        for(std::size_t i = 0; i != frame.used; ++i)
+            _gpuFrameData[_currentFrame*_sections.size() + frame.sections[i]] += frame.queries[i].result<UnsignedLong>();
+        _gpuFrameValid[_currentFrame] = true;
+        ++_gpuFrameCount;
+    }
+
+    frame.used = 0;
+    if(running) gpuBegin();
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void Profiler::pipelineBegin() {
+    PipelineFrame& frame = _pipelineFrames[_pipelineCurrentFrame];
+
+    /* Queries of different targets can be active at the same time */
+    for(QueryPool<PipelineStatisticsQuery>& pool: _pipelineQueries)
+        frame.queries.push_back(pool.begin());
+    frame.sections.push_back(_currentSection);
+    _pipelineRunning = true;
+}
+
+void Profiler::pipelineEnd() {
+    if(!_pipelineRunning) return;
+
+    PipelineFrame& frame = _pipelineFrames[_pipelineCurrentFrame];
+    const std::size_t offset = frame.queries.size() - PipelineTargetCount;
+    for(std::size_t i = 0; i != PipelineTargetCount; ++i)
+        _pipelineQueries[i].end(frame.queries[offset + i]);
+    _pipelineRunning = false;
+}
+
+void Profiler::pipelineNextFrame() {
+    /* Split the currently running section at the frame boundary */
+    const bool running = _pipelineRunning;
+    pipelineEnd();
+
+    /* The oldest frame, _gpuLatency frames ago */
+    _pipelineCurrentFrame = (_pipelineCurrentFrame + 1) % _gpuLatency;
+    PipelineFrame& frame = _pipelineFrames[_pipelineCurrentFrame];
+
+    /* Never wait for the results, if any of them is not available yet, drop
+       the whole frame. The queries go back to the pool in both cases. */
+    bool available = !frame.queries.empty();
+    for(std::size_t i = 0; i != frame.queries.size() && available; ++i)
+        available = _pipelineQueries[i % PipelineTargetCount].resultAvailable(frame.queries[i]);
+
+    for(std::size_t i = 0; i != frame.queries.size(); ++i) {
+        QueryPool<PipelineStatisticsQuery>& pool = _pipelineQueries[i % PipelineTargetCount];
+        UnsignedLong result;
+        if(available && pool.result(frame.queries[i], result))
+            pipelineCounter(_pipelineFrameData[_currentFrame*_sections.size() + frame.sections[i/PipelineTargetCount]], i % PipelineTargetCount) += result;
+        else pool.release(frame.queries[i]);
+    }
+
+    if(available) {
+        _pipelineFrameValid[_currentFrame] = true;
+        ++_pipelineFrameCount;
+    }
+
+    frame.queries.clear();
+    frame.sections.clear();
+    if(running) pipelineBegin();
 }
+#endif
 
 void Profiler::nextFrame() {
     if(!_enabled) return;
@@ -92,6 +496,15 @@ void Profiler::nextFrame() {
     /* Next frame index */
     std::size_t nextFrame = (_currentFrame+1) % _measureDuration;
 
+    /* Results of GPU queries from few frames back are saved into current
+       frame */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) gpuNextFrame();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) pipelineNextFrame();
+    #endif
+
     /* Add times of current frame to total */
     for(std::size_t i = 0; i != _sections.size(); ++i)
         _totalData[i] += _frameData[_currentFrame*_sections.size()+i];
@@ -102,12 +515,177 @@ void Profiler::nextFrame() {
         _frameData[nextFrame*_sections.size()+i] = high_resolution_clock::duration::zero();
     }
 
+    /* The same for GPU times, counting only frames that have them */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) {
+        for(std::size_t i = 0; i != _sections.size(); ++i)
+            _gpuTotalData[i] += _gpuFrameData[_currentFrame*_sections.size()+i];
+
+        for(std::size_t i = 0; i != _sections.size(); ++i) {
+            _gpuTotalData[i] -= _gpuFrameData[nextFrame*_sections.size()+i];
+            _gpuFrameData[nextFrame*_sections.size()+i] = 0;
+        }
+
+        if(_gpuFrameValid[nextFrame]) --_gpuFrameCount;
+        _gpuFrameValid[nextFrame] = false;
+    }
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) {
+        for(std::size_t i = 0; i != _sections.size(); ++i) {
+            for(std::size_t j = 0; j != PipelineTargetCount; ++j) {
+                pipelineCounter(_pipelineTotalData[i], j) += pipelineCounter(_pipelineFrameData[_currentFrame*_sections.size()+i], j);
+                pipelineCounter(_pipelineTotalData[i], j) -= pipelineCounter(_pipelineFrameData[nextFrame*_sections.size()+i], j);
+            }
+            _pipelineFrameData[nextFrame*_sections.size()+i] = PipelineStatistics{};
+        }
+
+        if(_pipelineFrameValid[nextFrame]) --_pipelineFrameCount;
+        _pipelineFrameValid[nextFrame] = false;
+    }
+    #endif
+
+    /* Snapshot GL call statistics of current frame and add them to total,
+       subtract statistics of next frame */
+    #ifdef MAGNUM_BUILD_STATISTICS
+    _statisticsData[_currentFrame] = Context::current().resetStatistics();
+    addStatistics(_statisticsTotal, _statisticsData[_currentFrame]);
+    subtractStatistics(_statisticsTotal, _statisticsData[nextFrame]);
+    _statisticsData[nextFrame] = Context::Statistics{};
+    #endif
+
+    /* Mark the frame boundary in the trace */
+    if(_capture && _capture->file.is_open()) {
+        std::lock_guard<std::mutex> lock{_capture->mutex};
+        _capture->write("frame", "Frame " + std::to_string(_capture->frameCount++), _capture->thread(), 0, high_resolution_clock::now(), {});
+    }
+
     /* Advance to next frame */
     _currentFrame = nextFrame;
 
     if(_frameCount < _measureDuration) ++_frameCount;
 }
 
+high_resolution_clock::duration Profiler::percentile(std::vector<high_resolution_clock::duration>& durations, const Float percentile) const {
+    CORRADE_ASSERT(percentile >= 0.0f && percentile <= 100.0f, "Profiler: percentile must be in range [0, 100]", {});
+    if(durations.empty()) return high_resolution_clock::duration::zero();
+
+    /* Nearest-rank method */
+    std::size_t rank = std::size_t(std::ceil(percentile/100.0f*durations.size()));
+    if(rank) --rank;
+    std::nth_element(durations.begin(), durations.begin() + rank, durations.end());
+    return durations[rank];
+}
+
+high_resolution_clock::duration Profiler::sectionPercentile(const Section section, const Float percentile) const {
+    if(!_enabled) return high_resolution_clock::duration::zero();
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to sectionPercentile()", {});
+
+    /* Current frame is not finished yet, so take at most the previous
+       _measureDuration - 1 frames */
+    const std::size_t count = std::min(_frameCount, _measureDuration - 1);
+    std::vector<high_resolution_clock::duration> durations;
+    durations.reserve(count);
+    for(std::size_t i = 1; i <= count; ++i) {
+        const std::size_t frame = (_currentFrame + _measureDuration - i) % _measureDuration;
+        durations.push_back(_frameData[frame*_sections.size() + section]);
+    }
+
+    return this->percentile(durations, percentile);
+}
+
+high_resolution_clock::duration Profiler::framePercentile(const Float percentile) const {
+    if(!_enabled) return high_resolution_clock::duration::zero();
+
+    const std::size_t count = std::min(_frameCount, _measureDuration - 1);
+    std::vector<high_resolution_clock::duration> durations;
+    durations.reserve(count);
+    for(std::size_t i = 1; i <= count; ++i) {
+        const std::size_t frame = (_currentFrame + _measureDuration - i) % _measureDuration;
+        durations.push_back(std::accumulate(_frameData.begin() + frame*_sections.size(), _frameData.begin() + (frame + 1)*_sections.size(), high_resolution_clock::duration::zero()));
+    }
+
+    return this->percentile(durations, percentile);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Profiler::PipelineStatistics Profiler::sectionPipelineStatistics(const Section section) const {
+    if(!_enabled || !_pipelineEnabled || !_pipelineFrameCount) return {};
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to sectionPipelineStatistics()", {});
+
+    PipelineStatistics out = _pipelineTotalData[section];
+    for(std::size_t i = 0; i != PipelineTargetCount; ++i)
+        pipelineCounter(out, i) /= _pipelineFrameCount;
+    return out;
+}
+#endif
+
+bool Profiler::isCapturing() const {
+    return _capture && _capture->file.is_open();
+}
+
+bool Profiler::beginCapture(const std::string& filename, const TraceFormat format) {
+    endCapture();
+
+    std::lock_guard<std::mutex> lock{_capture->mutex};
+    _capture->file.open(filename, std::ofstream::out|std::ofstream::trunc);
+    if(!_capture->file.good()) {
+        Error() << "DebugTools::Profiler::beginCapture(): cannot open file" << filename;
+        _capture->file.close();
+        return false;
+    }
+
+    _capture->file << std::fixed << std::setprecision(3);
+    _capture->format = format;
+    _capture->first = true;
+    ++_capture->generation;
+    _capture->frameCount = 0;
+    _capture->begin = high_resolution_clock::now();
+    _capture->threads.clear();
+
+    if(format == TraceFormat::ChromeTrace) _capture->file << '[';
+    else _capture->file << "type,name,thread,depth,begin_us,duration_us\n";
+
+    return true;
+}
+
+void Profiler::endCapture() {
+    if(!isCapturing()) return;
+
+    std::lock_guard<std::mutex> lock{_capture->mutex};
+    if(_capture->format == TraceFormat::ChromeTrace) _capture->file << "\n]\n";
+    _capture->file.close();
+}
+
+Profiler::Scope::Scope(Profiler& profiler, std::string name): _capture{profiler._capture.get()}, _name{std::move(name)} {
+    if(!_capture) return;
+
+    std::lock_guard<std::mutex> lock{_capture->mutex};
+    if(!_capture->file.is_open()) {
+        _capture = nullptr;
+        return;
+    }
+
+    _thread = _capture->thread();
+    _depth = _capture->threads[_thread].depth++;
+    _generation = _capture->generation;
+    _begin = high_resolution_clock::now();
+}
+
+Profiler::Scope::~Scope() {
+    if(!_capture) return;
+
+    const auto now = high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock{_capture->mutex};
+
+    /* The capture ended or a new one was started in the meantime */
+    if(!_capture->file.is_open() || _capture->generation != _generation)
+        return;
+
+    --_capture->threads[_thread].depth;
+    _capture->write("scope", _name, _thread, _depth, _begin, now - _begin);
+}
+
 void Profiler::printStatistics() {
     if(!_enabled) return;
 
@@ -117,8 +695,37 @@ void Profiler::printStatistics() {
     std::sort(totalSorted.begin(), totalSorted.end(), [this](std::size_t i, std::size_t j){return _totalData[i] > _totalData[j];});
 
     Debug() << "Statistics for last" << _measureDuration << "frames:";
-    for(std::size_t i = 0; i != _sections.size(); ++i)
-        Debug() << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(_totalData[totalSorted[i]]).count()/_frameCount << u8"µs";
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) {
+        for(std::size_t i = 0; i != _sections.size(); ++i)
+            Debug() << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(_totalData[totalSorted[i]]).count()/_frameCount << u8"µs CPU," << (_gpuFrameCount ? _gpuTotalData[totalSorted[i]]/1000/_gpuFrameCount : 0) << u8"µs GPU, p50" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 50.0f)).count() << u8"µs, p95" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 95.0f)).count() << u8"µs, p99" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 99.0f)).count() << u8"µs";
+    } else
+    #endif
+    {
+        for(std::size_t i = 0; i != _sections.size(); ++i)
+            Debug() << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(_totalData[totalSorted[i]]).count()/_frameCount << u8"µs, p50" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 50.0f)).count() << u8"µs, p95" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 95.0f)).count() << u8"µs, p99" << duration_cast<microseconds>(sectionPercentile(totalSorted[i], 99.0f)).count() << u8"µs";
+    }
+
+    Debug() << " Frame p50" << duration_cast<microseconds>(framePercentile(50.0f)).count() << u8"µs, p95" << duration_cast<microseconds>(framePercentile(95.0f)).count() << u8"µs, p99" << duration_cast<microseconds>(framePercentile(99.0f)).count() << u8"µs";
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_pipelineEnabled) {
+        Debug() << " Pipeline statistics per frame:";
+        for(std::size_t i = 0; i != _sections.size(); ++i) {
+            const PipelineStatistics statistics = sectionPipelineStatistics(totalSorted[i]);
+            Debug() << "  " << _sections[totalSorted[i]] << statistics.vertexShaderInvocations << "vertex shader invocations," << statistics.fragmentShaderInvocations << "fragment shader invocations," << statistics.clippingInputPrimitives << "primitives clipped to" << statistics.clippingOutputPrimitives;
+        }
+    }
+    #endif
+
+    /* Current frame is not finished yet, so the total contains at most the
+       previous _measureDuration - 1 frames */
+    #ifdef MAGNUM_BUILD_STATISTICS
+    if(const std::size_t count = std::min(_frameCount, _measureDuration - 1)) {
+        Debug() << " Per frame:" << _statisticsTotal.drawCalls/count << "draw calls," << _statisticsTotal.meshBinds/count << "mesh binds," << _statisticsTotal.shaderSwitches/count << "shader switches," << _statisticsTotal.textureBinds/count << "texture binds," << _statisticsTotal.framebufferBinds/count << "framebuffer binds," << _statisticsTotal.bufferBinds/count << "buffer binds";
+        Debug() << " Per frame:" << _statisticsTotal.bufferUploads/count << "buffer uploads," << _statisticsTotal.bufferUploadBytes/count << "bytes uploaded";
+    }
+    #endif
 }
 
 }}
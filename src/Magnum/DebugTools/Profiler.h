@@ -31,14 +31,27 @@
 
 #include <chrono>
 #include <initializer_list>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Magnum/Types.h"
+#ifdef MAGNUM_BUILD_STATISTICS
+#include "Magnum/Context.h"
+#endif
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/TimeQuery.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/PipelineStatisticsQuery.h"
+#include "Magnum/QueryPool.h"
+#endif
 #include "Magnum/DebugTools/visibility.h"
 
 namespace Magnum { namespace DebugTools {
 
+namespace Implementation { struct ProfilerCapture; }
+
 /**
 @brief Profiler
 
@@ -96,6 +109,76 @@ p.printStatistics();
 It's possible to start profiler only for certain parts of the code and then
 stop it again using @ref stop(), if you are not interested in profiling the rest.
 
+@anchor DebugTools-Profiler-capture
+## Capturing traces
+
+Besides the averages, @ref printStatistics() prints also 50th, 95th and 99th
+percentile of each section and of the whole frame, which are available also
+through @ref sectionPercentile() and @ref framePercentile().
+
+For diagnosing individual hitches, the sections can be recorded into a trace
+file with @ref beginCapture(). Additionally, arbitrary nested parts of the
+code on any thread can be marked with a @ref Scope:
+@code
+p.beginCapture("trace.json", DebugTools::Profiler::TraceFormat::ChromeTrace);
+
+void Loader::load() {
+    DebugTools::Profiler::Scope scope{p, "Loading"};
+    for(const std::string& file: files) {
+        DebugTools::Profiler::Scope scope{p, file};
+        // ...
+    }
+}
+
+p.endCapture();
+@endcode
+
+The events are written to the file as they are recorded, so arbitrarily long
+captures can be done without holding the data in memory. The
+@ref TraceFormat::ChromeTrace file can be opened in the `chrome://tracing`
+viewer, the @ref TraceFormat::Csv file is meant for further processing.
+
+@anchor DebugTools-Profiler-gpu
+## GPU time measurement
+
+OpenGL commands are executed asynchronously, so the CPU time of a section
+contains just the time needed to submit the commands. With
+@ref setGpuMeasurementEnabled() each section additionally measures how long
+the GPU was executing the commands submitted in it using @ref TimeQuery. The
+query results are read only after given count of frames (see
+@ref setGpuLatency()) and only if they are already available, so the
+measurement never waits for the GPU. Both times are then shown side by side
+in @ref printStatistics():
+@code
+DebugTools::Profiler p;
+// add sections...
+p.setGpuMeasurementEnabled(true);
+p.enable();
+@endcode
+
+@anchor DebugTools-Profiler-pipeline
+## Pipeline statistics
+
+On desktop GL with @extension{ARB,pipeline_statistics_query} available,
+@ref setPipelineStatisticsEnabled() makes each section additionally count
+vertex and fragment shader invocations and primitives entering and leaving
+the clipping stage using @ref PipelineStatisticsQuery. The queries are taken
+from a @ref QueryPool and read back with the same latency as the GPU time
+queries, so again the measurement never waits for the GPU. The per-frame
+averages are available through @ref sectionPipelineStatistics() and printed
+in @ref printStatistics(). High fragment shader invocation count relative to
+the framebuffer size points to overdraw, high vertex shader invocation count
+to poor vertex reuse or missing culling.
+
+@anchor DebugTools-Profiler-statistics
+## GL call statistics
+
+If Magnum is built with @ref MAGNUM_BUILD_STATISTICS, the profiler takes a
+snapshot of @ref Context::statistics() in each @ref nextFrame() call and resets
+the counters, so @ref printStatistics() additionally shows average count of
+draw calls, state changes and buffer uploads per frame. Note that this means
+the counters shouldn't be reset anywhere else while profiling is enabled.
+
 @todo Some unit testing
 @todo More time intervals
 */
@@ -115,7 +198,74 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         static const Section otherSection = 0;
 
-        explicit Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _currentSection(otherSection) {}
+        /**
+         * @brief Trace format
+         *
+         * @see @ref beginCapture()
+         */
+        enum class TraceFormat: UnsignedByte {
+            /**
+             * JSON in [Chrome Trace Event Format](https://github.com/catapult-project/catapult/wiki/Trace-Event-Format),
+             * with sections and scopes as complete events and frame
+             * boundaries as instant events.
+             */
+            ChromeTrace,
+
+            /**
+             * Comma-separated values with a header, one row per section,
+             * scope or frame boundary. Columns are event type (`section`,
+             * `scope` or `frame`), name, thread index, nesting depth, begin
+             * and duration in microseconds.
+             */
+            Csv
+        };
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Pipeline statistics
+         *
+         * @see @ref sectionPipelineStatistics()
+         * @requires_gl Pipeline statistics queries are not available in
+         *      OpenGL ES and WebGL.
+         */
+        struct PipelineStatistics {
+            /** @brief Count of vertex shader invocations */
+            UnsignedLong vertexShaderInvocations;
+
+            /** @brief Count of fragment shader invocations */
+            UnsignedLong fragmentShaderInvocations;
+
+            /** @brief Count of primitives entering the clipping stage */
+            UnsignedLong clippingInputPrimitives;
+
+            /** @brief Count of primitives leaving the clipping stage */
+            UnsignedLong clippingOutputPrimitives;
+        };
+        #endif
+
+        class Scope;
+
+        explicit Profiler();
+
+        /** @brief Copying is not allowed */
+        Profiler(const Profiler&) = delete;
+
+        /** @brief Move constructor */
+        Profiler(Profiler&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Ends the capture, if any.
+         * @see @ref endCapture()
+         */
+        ~Profiler();
+
+        /** @brief Copying is not allowed */
+        Profiler& operator=(const Profiler&) = delete;
+
+        /** @brief Move assignment */
+        Profiler& operator=(Profiler&&) noexcept;
 
         /**
          * @brief Set measure duration
@@ -126,6 +276,53 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void setMeasureDuration(std::size_t frames);
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /** @brief Whether GPU time is measured */
+        bool isGpuMeasurementEnabled() const { return _gpuEnabled; }
+
+        /**
+         * @brief Enable or disable GPU time measurement
+         *
+         * Default is disabled. See @ref DebugTools-Profiler-gpu "class documentation"
+         * for more information.
+         * @attention This function cannot be called if profiling is enabled.
+         * @requires_gl33 Extension @extension{ARB,timer_query}
+         * @requires_es_extension Extension @es_extension{EXT,disjoint_timer_query}
+         * @requires_gles Time queries are not available in WebGL.
+         */
+        void setGpuMeasurementEnabled(bool enabled);
+
+        /**
+         * @brief Set GPU measurement latency
+         *
+         * Count of frames after which the GPU time queries are read back.
+         * Results that are not available by then are discarded. Expects that
+         * the value is at least `1`. Default value is 3.
+         * @attention This function cannot be called if profiling is enabled.
+         * @requires_gles Time queries are not available in WebGL.
+         */
+        void setGpuLatency(std::size_t frames);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /** @brief Whether pipeline statistics are measured */
+        bool isPipelineStatisticsEnabled() const { return _pipelineEnabled; }
+
+        /**
+         * @brief Enable or disable pipeline statistics measurement
+         *
+         * Default is disabled. The results are read back after the same
+         * count of frames as GPU time, see @ref setGpuLatency(). See
+         * @ref DebugTools-Profiler-pipeline "class documentation" for more
+         * information.
+         * @attention This function cannot be called if profiling is enabled.
+         * @requires_extension Extension @extension{ARB,pipeline_statistics_query}
+         * @requires_gl Pipeline statistics queries are not available in
+         *      OpenGL ES and WebGL.
+         */
+        void setPipelineStatisticsEnabled(bool enabled);
+        #endif
+
         /**
          * @brief Add named section
          *
@@ -190,16 +387,110 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void nextFrame();
 
+        /**
+         * @brief Section duration percentile
+         * @param section       Section
+         * @param percentile    Percentile in range @f$ [ 0, 100 ] @f$
+         *
+         * Computed from durations of given section in last frames. Returns
+         * zero duration if profiling is disabled or no frame was measured
+         * yet.
+         * @see @ref framePercentile(), @ref setMeasureDuration()
+         */
+        std::chrono::high_resolution_clock::duration sectionPercentile(Section section, Float percentile) const;
+
+        /**
+         * @brief Frame duration percentile
+         * @param percentile    Percentile in range @f$ [ 0, 100 ] @f$
+         *
+         * Like @ref sectionPercentile(), but computed from sum of durations
+         * of all sections in given frame.
+         */
+        std::chrono::high_resolution_clock::duration framePercentile(Float percentile) const;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Section pipeline statistics
+         *
+         * Average per-frame counts of given section in last frames for which
+         * the query results were available. Returns all zeros if profiling
+         * or pipeline statistics measurement is disabled or no frame was
+         * measured yet.
+         * @see @ref setPipelineStatisticsEnabled()
+         * @requires_gl Pipeline statistics queries are not available in
+         *      OpenGL ES and WebGL.
+         */
+        PipelineStatistics sectionPipelineStatistics(Section section) const;
+        #endif
+
+        /** @brief Whether a trace is being captured */
+        bool isCapturing() const;
+
+        /**
+         * @brief Begin capturing a trace
+         * @param filename  File to write the trace to
+         * @param format    Trace format
+         * @return `False` if the file cannot be opened, `true` otherwise
+         *
+         * Sections, frame boundaries and @ref Scope "scopes" from all threads
+         * are written to the file as they are recorded, until
+         * @ref endCapture() is called. If another capture is in progress,
+         * it's ended first. See @ref DebugTools-Profiler-capture "class documentation"
+         * for more information.
+         */
+        bool beginCapture(const std::string& filename, TraceFormat format);
+
+        /**
+         * @brief End capturing a trace
+         *
+         * Finishes and closes the file. Does nothing if no trace is being
+         * captured.
+         */
+        void endCapture();
+
         /**
          * @brief Print statistics
          *
-         * Prints statistics about previous frame ordered by duration.
+         * Prints statistics about previous frame ordered by duration,
+         * together with 50th, 95th and 99th percentile. If GPU time is
+         * measured, the GPU time of each section is printed next to the CPU
+         * time. If pipeline statistics are measured, average shader
+         * invocation and clipped primitive counts of each section are
+         * printed too. If Magnum is built with @ref MAGNUM_BUILD_STATISTICS, average
+         * count of GL calls and state changes per frame is printed as well,
+         * see @ref DebugTools-Profiler-statistics "class documentation" for
+         * more information.
          * @note Does nothing if profiling is disabled.
          */
         void printStatistics();
 
     private:
         void save();
+        std::chrono::high_resolution_clock::duration percentile(std::vector<std::chrono::high_resolution_clock::duration>& durations, Float percentile) const;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        struct GpuFrame {
+            std::vector<TimeQuery> queries;
+            std::vector<Section> sections;
+            std::size_t used = 0;
+        };
+
+        void gpuBegin();
+        void gpuEnd();
+        void gpuNextFrame();
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        struct PipelineFrame {
+            /* Four query handles (one for each pool) per section */
+            std::vector<UnsignedInt> queries;
+            std::vector<Section> sections;
+        };
+
+        void pipelineBegin();
+        void pipelineEnd();
+        void pipelineNextFrame();
+        #endif
 
         bool _enabled;
         std::size_t _measureDuration, _currentFrame, _frameCount;
@@ -208,6 +499,75 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
         std::vector<std::chrono::high_resolution_clock::duration> _totalData;
         std::chrono::high_resolution_clock::time_point _previousTime;
         Section _currentSection;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        bool _gpuEnabled, _gpuRunning;
+        std::size_t _gpuLatency, _gpuCurrentFrame, _gpuFrameCount;
+        std::vector<GpuFrame> _gpuFrames;
+        std::vector<bool> _gpuFrameValid;
+        std::vector<UnsignedLong> _gpuFrameData;
+        std::vector<UnsignedLong> _gpuTotalData;
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        bool _pipelineEnabled, _pipelineRunning;
+        std::size_t _pipelineCurrentFrame, _pipelineFrameCount;
+        std::vector<QueryPool<PipelineStatisticsQuery>> _pipelineQueries;
+        std::vector<PipelineFrame> _pipelineFrames;
+        std::vector<bool> _pipelineFrameValid;
+        std::vector<PipelineStatistics> _pipelineFrameData;
+        std::vector<PipelineStatistics> _pipelineTotalData;
+        #endif
+
+        #ifdef MAGNUM_BUILD_STATISTICS
+        std::vector<Context::Statistics> _statisticsData;
+        Context::Statistics _statisticsTotal;
+        #endif
+
+        std::unique_ptr<Implementation::ProfilerCapture> _capture;
+};
+
+/**
+@brief Profiler scope
+
+Records a named part of code into the trace captured by @ref Profiler from
+construction to destruction. Can be nested and used from any thread. Does
+nothing if no trace is being captured at the time of construction. See
+@ref DebugTools-Profiler-capture "Profiler documentation" for an example.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT Profiler::Scope {
+    public:
+        /**
+         * @brief Constructor
+         * @param profiler  Profiler which captures the trace
+         * @param name      Scope name
+         */
+        explicit Scope(Profiler& profiler, std::string name);
+
+        /** @brief Copying is not allowed */
+        Scope(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope(Scope&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Writes the scope to the trace.
+         */
+        ~Scope();
+
+        /** @brief Copying is not allowed */
+        Scope& operator=(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        Implementation::ProfilerCapture* _capture;
+        std::string _name;
+        std::chrono::high_resolution_clock::time_point _begin;
+        UnsignedInt _thread, _depth, _generation;
 };
 
 }}
@@ -42,70 +42,70 @@ namespace Magnum { namespace DebugTools {
 
 namespace Implementation {
 
-template<> void createDebugMesh(ShapeRenderer<2>& renderer, const Shapes::Implementation::AbstractShape<2>& shape) {
+template<> void createDebugMesh(std::vector<AbstractShapeRenderer<2>*>& renderers, const Shapes::Implementation::AbstractShape<2>& shape) {
     switch(shape.type()) {
         case Shapes::AbstractShape2D::Type::AxisAlignedBox:
-            renderer._renderers.push_back(new Implementation::AxisAlignedBoxRenderer<2>(shape));
+            renderers.push_back(new Implementation::AxisAlignedBoxRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Box:
-            renderer._renderers.push_back(new Implementation::BoxRenderer<2>(shape));
+            renderers.push_back(new Implementation::BoxRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::LineSegment:
-            renderer._renderers.push_back(new Implementation::LineSegmentRenderer<2>(shape));
+            renderers.push_back(new Implementation::LineSegmentRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Point:
-            renderer._renderers.push_back(new Implementation::PointRenderer<2>(shape));
+            renderers.push_back(new Implementation::PointRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Sphere:
         case Shapes::AbstractShape2D::Type::InvertedSphere: /* Isn't publicly subclassed, but shouldn't matter */
-            renderer._renderers.push_back(new Implementation::SphereRenderer<2>(shape));
+            renderers.push_back(new Implementation::SphereRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Capsule:
-            renderer._renderers.push_back(new Implementation::CapsuleRenderer<2>(shape));
+            renderers.push_back(new Implementation::CapsuleRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Cylinder:
-            renderer._renderers.push_back(new Implementation::CylinderRenderer<2>(shape));
+            renderers.push_back(new Implementation::CylinderRenderer<2>(shape));
             break;
         case Shapes::AbstractShape2D::Type::Composition: {
             const Shapes::Composition2D& composition =
                 static_cast<const Shapes::Implementation::Shape<Shapes::Composition2D>&>(shape).shape;
             for(std::size_t i = 0; i != composition.size(); ++i)
-                createDebugMesh(renderer, Shapes::Implementation::getAbstractShape(composition, i));
+                createDebugMesh(renderers, Shapes::Implementation::getAbstractShape(composition, i));
         } break;
         default:
             Warning() << "DebugTools::ShapeRenderer2D::createShapeRenderer(): type" << shape.type() << "not implemented";
     }
 }
 
-template<> void createDebugMesh(ShapeRenderer<3>& renderer, const Shapes::Implementation::AbstractShape<3>& shape) {
+template<> void createDebugMesh(std::vector<AbstractShapeRenderer<3>*>& renderers, const Shapes::Implementation::AbstractShape<3>& shape) {
     switch(shape.type()) {
         case Shapes::AbstractShape3D::Type::AxisAlignedBox:
-            renderer._renderers.push_back(new Implementation::AxisAlignedBoxRenderer<3>(shape));
+            renderers.push_back(new Implementation::AxisAlignedBoxRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Box:
-            renderer._renderers.push_back(new Implementation::BoxRenderer<3>(shape));
+            renderers.push_back(new Implementation::BoxRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::LineSegment:
-            renderer._renderers.push_back(new Implementation::LineSegmentRenderer<3>(shape));
+            renderers.push_back(new Implementation::LineSegmentRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Point:
-            renderer._renderers.push_back(new Implementation::PointRenderer<3>(shape));
+            renderers.push_back(new Implementation::PointRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Sphere:
         case Shapes::AbstractShape3D::Type::InvertedSphere: /* Isn't publicly subclassed, but shouldn't matter */
-            renderer._renderers.push_back(new Implementation::SphereRenderer<3>(shape));
+            renderers.push_back(new Implementation::SphereRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Capsule:
-            renderer._renderers.push_back(new Implementation::CapsuleRenderer<3>(shape));
+            renderers.push_back(new Implementation::CapsuleRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Cylinder:
-            renderer._renderers.push_back(new Implementation::CylinderRenderer<3>(shape));
+            renderers.push_back(new Implementation::CylinderRenderer<3>(shape));
             break;
         case Shapes::AbstractShape3D::Type::Composition: {
             const Shapes::Composition3D& composition =
                 static_cast<const Shapes::Implementation::Shape<Shapes::Composition3D>&>(shape).shape;
             for(std::size_t i = 0; i != composition.size(); ++i)
-                createDebugMesh(renderer, Shapes::Implementation::getAbstractShape(composition, i));
+                createDebugMesh(renderers, Shapes::Implementation::getAbstractShape(composition, i));
         } break;
         default:
             Warning() << "DebugTools::ShapeRenderer3D::createShapeRenderer(): type" << shape.type() << "not implemented";
@@ -115,7 +115,7 @@ template<> void createDebugMesh(ShapeRenderer<3>& renderer, const Shapes::Implem
 }
 
 template<UnsignedInt dimensions> ShapeRenderer<dimensions>::ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(shape.object(), drawables), _options(ResourceManager::instance().get<ShapeRendererOptions>(options)) {
-    Implementation::createDebugMesh(*this, Shapes::Implementation::getAbstractShape(shape));
+    Implementation::createDebugMesh(_renderers, Shapes::Implementation::getAbstractShape(shape));
 }
 
 template<UnsignedInt dimensions> ShapeRenderer<dimensions>::~ShapeRenderer() {
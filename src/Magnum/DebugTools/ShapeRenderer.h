@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::DebugTools::ShapeRenderer, @ref Magnum::DebugTools::ShapeRendererOptions, typedef @ref Magnum::DebugTools::ShapeRenderer2D, @ref Magnum::DebugTools::ShapeRenderer3D
  */
 
+#include <vector>
+
 #include "Magnum/Resource.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -43,7 +45,10 @@ template<UnsignedInt> class ShapeRenderer;
 namespace Implementation {
     template<UnsignedInt> class AbstractShapeRenderer;
 
-    template<UnsignedInt dimensions> void createDebugMesh(ShapeRenderer<dimensions>& renderer, const Shapes::Implementation::AbstractShape<dimensions>& shape);
+    /* Creates renderers for given shape, for groups one for each shape */
+    template<UnsignedInt dimensions> void createDebugMesh(std::vector<AbstractShapeRenderer<dimensions>*>& renderers, const Shapes::Implementation::AbstractShape<dimensions>& shape);
+    template<> void createDebugMesh(std::vector<AbstractShapeRenderer<2>*>& renderers, const Shapes::Implementation::AbstractShape<2>& shape);
+    template<> void createDebugMesh(std::vector<AbstractShapeRenderer<3>*>& renderers, const Shapes::Implementation::AbstractShape<3>& shape);
 }
 
 /**
@@ -139,10 +144,6 @@ new DebugTools::ShapeRenderer2D(shape, "red", debugDrawables);
 @todo Different drawing style for inverted shapes? (marking the "inside" somehow)
 */
 template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ShapeRenderer: public SceneGraph::Drawable<dimensions, Float> {
-    #ifndef DOXYGEN_GENERATING_OUTPUT
-    friend void Implementation::createDebugMesh<>(ShapeRenderer<dimensions>&, const Shapes::Implementation::AbstractShape<dimensions>&);
-    #endif
-
     public:
         /**
          * @brief Constructor
@@ -25,6 +25,8 @@
 
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/DebugTools/BufferData.h"
 #include "Magnum/Test/AbstractOpenGLTester.h"
 
@@ -35,11 +37,24 @@ struct BufferDataGLTest: Magnum::Test::AbstractOpenGLTester {
 
     void data();
     void subData();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void reader();
+    void readerSubData();
+    void readerSlots();
+    #endif
 };
 
 BufferDataGLTest::BufferDataGLTest() {
     addTests({&BufferDataGLTest::data,
-              &BufferDataGLTest::subData});
+              &BufferDataGLTest::subData,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &BufferDataGLTest::reader,
+              &BufferDataGLTest::readerSubData,
+              &BufferDataGLTest::readerSlots
+              #endif
+              });
 }
 
 namespace {
@@ -66,6 +81,96 @@ void BufferDataGLTest::subData() {
         TestSuite::Compare::Container);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void BufferDataGLTest::reader() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::copy_buffer>())
+        CORRADE_SKIP(Extensions::GL::ARB::copy_buffer::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+
+    BufferDataReader reader;
+    const UnsignedInt slot = reader.read(buffer);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(reader.pendingCount(), 1);
+    CORRADE_COMPARE(reader.size(slot), GLsizeiptr(sizeof(Data)));
+
+    /* Overwriting the original doesn't affect the read */
+    constexpr Int zeros[5]{};
+    buffer.setSubData(0, zeros);
+
+    const Containers::Array<Int> contents = reader.retrieve<Int>(slot);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(reader.pendingCount(), 0);
+    CORRADE_COMPARE_AS(contents,
+        Containers::ArrayView<const Int>{Data},
+        TestSuite::Compare::Container);
+}
+
+void BufferDataGLTest::readerSubData() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::copy_buffer>())
+        CORRADE_SKIP(Extensions::GL::ARB::copy_buffer::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+
+    BufferDataReader reader;
+    const UnsignedInt slot = reader.read(buffer, 4, 12);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The fence gets signaled eventually */
+    while(!reader.isReady(slot));
+
+    const Containers::Array<Int> contents = reader.retrieve<Int>(slot);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents,
+        Containers::ArrayView<const Int>{Data}.slice(1, 4),
+        TestSuite::Compare::Container);
+}
+
+void BufferDataGLTest::readerSlots() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::copy_buffer>())
+        CORRADE_SKIP(Extensions::GL::ARB::copy_buffer::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+
+    BufferDataReader reader{2};
+    CORRADE_COMPARE(reader.slotCount(), 2);
+
+    const UnsignedInt first = reader.read(buffer, 0, 8);
+    const UnsignedInt second = reader.read(buffer, 8, 12);
+    CORRADE_VERIFY(first != second);
+    CORRADE_COMPARE(reader.pendingCount(), 2);
+
+    /* Discarded slot gets reused, with the buffer large enough already */
+    reader.discard(first);
+    const UnsignedInt third = reader.read(buffer, 16, 4);
+    CORRADE_COMPARE(third, first);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE_AS(reader.retrieve<Int>(second),
+        Containers::ArrayView<const Int>{Data}.slice(2, 5),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(reader.retrieve<Int>(third),
+        Containers::ArrayView<const Int>{Data}.slice(4, 5),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(reader.pendingCount(), 0);
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::DebugTools::Test::BufferDataGLTest)
@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/DebugTools/DebugDraw.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct DebugDrawGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit DebugDrawGLTest();
+
+    void empty();
+    void primitives2D();
+    void primitives3D();
+    void duration();
+    void capacity();
+    void clear();
+};
+
+DebugDrawGLTest::DebugDrawGLTest() {
+    addTests({&DebugDrawGLTest::empty,
+              &DebugDrawGLTest::primitives2D,
+              &DebugDrawGLTest::primitives3D,
+              &DebugDrawGLTest::duration,
+              &DebugDrawGLTest::capacity,
+              &DebugDrawGLTest::clear});
+}
+
+void DebugDrawGLTest::empty() {
+    ResourceManager manager;
+
+    DebugDraw3D debugDraw;
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.lineCount(), 0);
+    CORRADE_COMPARE(debugDraw.capacity(), 0);
+}
+
+void DebugDrawGLTest::primitives2D() {
+    ResourceManager manager;
+
+    DebugDraw2D debugDraw;
+    debugDraw.box(Range2D{{-1.0f, -1.0f}, {1.0f, 1.0f}}, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 4);
+    debugDraw.sphere({}, 1.0f, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 4 + 32);
+    debugDraw.arrow({}, Vector2::xAxis(), Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 4 + 32 + 3);
+    debugDraw.cross({}, 0.5f, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 4 + 32 + 3 + 2);
+
+    debugDraw.draw(Matrix3{});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Zero duration lines are drawn exactly once */
+    CORRADE_COMPARE(debugDraw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::primitives3D() {
+    ResourceManager manager;
+
+    DebugDraw3D debugDraw;
+    debugDraw.box(Matrix4::rotationX(Deg(35.0f)), Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 12);
+    debugDraw.sphere({}, 1.0f, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 12 + 96);
+    debugDraw.arrow({}, Vector3::zAxis(), Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 12 + 96 + 5);
+    debugDraw.cross({}, 0.5f, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 12 + 96 + 5 + 3);
+
+    /* Degenerate arrow has no head */
+    debugDraw.arrow({}, {}, Color3{1.0f});
+    CORRADE_COMPARE(debugDraw.lineCount(), 12 + 96 + 5 + 3 + 1);
+
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::duration() {
+    ResourceManager manager;
+
+    DebugDraw3D debugDraw;
+    debugDraw.line({}, Vector3::xAxis(), Color3{1.0f})
+        .line({}, Vector3::yAxis(), Color3{1.0f}, 1.0f)
+        .line({}, Vector3::zAxis(), Color3{1.0f}, 2.5f);
+
+    debugDraw.draw(Matrix4{}, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.lineCount(), 1);
+
+    debugDraw.draw(Matrix4{}, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.lineCount(), 1);
+
+    debugDraw.draw(Matrix4{}, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::capacity() {
+    ResourceManager manager;
+
+    DebugDraw3D debugDraw;
+    debugDraw.box(Range3D{{}, Vector3{1.0f}}, Color3{1.0f});
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.capacity(), 24);
+
+    /* Fewer vertices reuse the storage */
+    debugDraw.cross({}, 1.0f, Color3{1.0f});
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.capacity(), 24);
+
+    /* More vertices at least double it */
+    debugDraw.box(Range3D{{}, Vector3{1.0f}}, Color3{1.0f})
+        .line({}, Vector3::xAxis(), Color3{1.0f});
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(debugDraw.capacity(), 48);
+}
+
+void DebugDrawGLTest::clear() {
+    ResourceManager manager;
+
+    DebugDraw3D debugDraw;
+    debugDraw.sphere({}, 1.0f, Color3{1.0f}, 10.0f);
+    CORRADE_COMPARE(debugDraw.lineCount(), 96);
+
+    debugDraw.clear();
+    CORRADE_COMPARE(debugDraw.lineCount(), 0);
+    debugDraw.draw(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DebugDrawGLTest)
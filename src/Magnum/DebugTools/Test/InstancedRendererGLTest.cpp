@@ -0,0 +1,175 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/DebugTools/InstancedRenderer.h"
+#include "Magnum/DebugTools/ObjectRenderer.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/DebugTools/ShapeRenderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct InstancedRendererGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit InstancedRendererGLTest();
+
+    void empty();
+    void shapes();
+    void objects();
+    void remove();
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+InstancedRendererGLTest::InstancedRendererGLTest() {
+    addTests({&InstancedRendererGLTest::empty,
+              &InstancedRendererGLTest::shapes,
+              &InstancedRendererGLTest::objects,
+              &InstancedRendererGLTest::remove});
+}
+
+void InstancedRendererGLTest::empty() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not available."));
+    #endif
+
+    ResourceManager manager;
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    InstancedRenderer3D renderer;
+    renderer.draw(camera);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.shapeCount(), 0);
+    CORRADE_COMPARE(renderer.objectCount(), 0);
+    CORRADE_COMPARE(renderer.drawCallCount(), 0);
+}
+
+void InstancedRendererGLTest::shapes() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not available."));
+    #endif
+
+    ResourceManager manager;
+    manager.set("red", ShapeRendererOptions().setColor({1.0f, 0.0f, 0.0f}));
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    InstancedRenderer3D renderer;
+    for(Int i = 0; i != 100; ++i) {
+        auto object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i)));
+        renderer.addShape(*new Shapes::Shape<Shapes::Sphere3D>{*object, {{}, 0.5f}}, "red");
+    }
+    for(Int i = 0; i != 10; ++i) {
+        auto object = new Object3D{&scene};
+        object->translate(Vector3::yAxis(Float(i)));
+        renderer.addShape(*new Shapes::Shape<Shapes::Capsule3D>{*object, {{}, Vector3::zAxis(), 0.5f}});
+    }
+
+    renderer.draw(camera);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* One draw for all spheres, three for the capsule parts */
+    CORRADE_COMPARE(renderer.shapeCount(), 110);
+    CORRADE_COMPARE(renderer.drawCallCount(), 4);
+}
+
+void InstancedRendererGLTest::objects() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not available."));
+    #endif
+
+    ResourceManager manager;
+    manager.set("small", ObjectRendererOptions().setSize(0.25f));
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    InstancedRenderer3D renderer;
+    for(Int i = 0; i != 100; ++i)
+        renderer.addObject(*new Object3D{&scene}, i % 2 ? "small" : ResourceKey());
+
+    renderer.draw(camera);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* One draw for each axis */
+    CORRADE_COMPARE(renderer.objectCount(), 100);
+    CORRADE_COMPARE(renderer.drawCallCount(), 3);
+}
+
+void InstancedRendererGLTest::remove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not available."));
+    #endif
+
+    ResourceManager manager;
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    Object3D a{&scene}, b{&scene};
+    Shapes::Shape<Shapes::Sphere3D> sphere{a, {{}, 1.0f}};
+    Shapes::Shape<Shapes::Capsule3D> capsule{b, {{}, Vector3::zAxis(), 0.5f}};
+
+    InstancedRenderer3D renderer;
+    renderer.addShape(sphere)
+        .addShape(capsule)
+        .addObject(a);
+    renderer.draw(camera);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.drawCallCount(), 7);
+
+    /* Batches without any instances are not drawn */
+    renderer.removeShape(capsule)
+        .removeObject(a)
+        .removeObject(b);
+    renderer.draw(camera);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.shapeCount(), 1);
+    CORRADE_COMPARE(renderer.objectCount(), 0);
+    CORRADE_COMPARE(renderer.drawCallCount(), 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::InstancedRendererGLTest)
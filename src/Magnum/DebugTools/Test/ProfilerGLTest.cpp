@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/DebugTools/Profiler.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct ProfilerGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit ProfilerGLTest();
+
+    void cpu();
+    void gpu();
+    #ifndef MAGNUM_TARGET_GLES
+    void pipelineStatistics();
+    #endif
+};
+
+ProfilerGLTest::ProfilerGLTest() {
+    addTests({&ProfilerGLTest::cpu,
+              &ProfilerGLTest::gpu,
+              #ifndef MAGNUM_TARGET_GLES
+              &ProfilerGLTest::pipelineStatistics
+              #endif
+              });
+}
+
+void ProfilerGLTest::cpu() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    CORRADE_VERIFY(!p.isGpuMeasurementEnabled());
+    p.setMeasureDuration(4);
+    p.enable();
+
+    for(std::size_t i = 0; i != 8; ++i) {
+        p.start();
+        p.start(a);
+        p.stop();
+        p.nextFrame();
+    }
+
+    std::ostringstream out;
+    {
+        Debug redirectDebug{&out};
+        p.printStatistics();
+    }
+
+    CORRADE_VERIFY(out.str().find("Statistics for last 4 frames:") == 0);
+    CORRADE_VERIFY(out.str().find("GPU") == std::string::npos);
+}
+
+void ProfilerGLTest::gpu() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available"));
+    #endif
+
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    p.setMeasureDuration(4);
+    p.setGpuLatency(2);
+    p.setGpuMeasurementEnabled(true);
+    CORRADE_VERIFY(p.isGpuMeasurementEnabled());
+    p.enable();
+
+    /* The "Other" section spans across frame boundaries */
+    p.start();
+    for(std::size_t i = 0; i != 8; ++i) {
+        p.start(a);
+        p.start(b);
+        p.start();
+        p.nextFrame();
+    }
+    p.stop();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    std::ostringstream out;
+    {
+        Debug redirectDebug{&out};
+        p.printStatistics();
+    }
+
+    p.disable();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(out.str().find(u8"µs CPU,") != std::string::npos);
+    CORRADE_VERIFY(out.str().find(u8"µs GPU") != std::string::npos);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void ProfilerGLTest::pipelineStatistics() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::pipeline_statistics_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::pipeline_statistics_query::string() + std::string(" is not available"));
+
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.setMeasureDuration(4);
+    p.setGpuLatency(2);
+    CORRADE_VERIFY(!p.isPipelineStatisticsEnabled());
+    p.setPipelineStatisticsEnabled(true);
+    CORRADE_VERIFY(p.isPipelineStatisticsEnabled());
+    p.enable();
+
+    p.start();
+    for(std::size_t i = 0; i != 8; ++i) {
+        p.start(a);
+        p.start();
+        p.nextFrame();
+    }
+    p.stop();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Nothing was drawn, so all counters are zero */
+    const Profiler::PipelineStatistics statistics = p.sectionPipelineStatistics(a);
+    CORRADE_COMPARE(statistics.vertexShaderInvocations, 0);
+    CORRADE_COMPARE(statistics.fragmentShaderInvocations, 0);
+
+    std::ostringstream out;
+    {
+        Debug redirectDebug{&out};
+        p.printStatistics();
+    }
+
+    p.disable();
+
+    /* Enabling again reuses the pooled queries */
+    p.enable();
+    p.start(a);
+    p.nextFrame();
+    p.disable();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(out.str().find("Pipeline statistics per frame:") != std::string::npos);
+    CORRADE_VERIFY(out.str().find("fragment shader invocations") != std::string::npos);
+}
+#endif
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::DebugTools::Test::ProfilerGLTest)
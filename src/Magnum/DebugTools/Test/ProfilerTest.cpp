@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/DebugTools/Profiler.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct ProfilerTest: TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void percentile();
+    void percentileDisabled();
+
+    void captureChromeTrace();
+    void captureCsv();
+    void captureCannotOpen();
+    void captureScopeOutside();
+    void captureScopeThreads();
+};
+
+namespace {
+
+std::string readFile(const std::string& filename) {
+    std::ifstream in{filename, std::ifstream::binary};
+    std::ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+}
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::percentile,
+              &ProfilerTest::percentileDisabled,
+
+              &ProfilerTest::captureChromeTrace,
+              &ProfilerTest::captureCsv,
+              &ProfilerTest::captureCannotOpen,
+              &ProfilerTest::captureScopeOutside,
+              &ProfilerTest::captureScopeThreads});
+
+    Utility::Directory::mkpath(DEBUGTOOLS_TEST_OUTPUT_DIR);
+}
+
+void ProfilerTest::percentile() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.setMeasureDuration(8);
+    p.enable();
+
+    for(std::size_t i = 0; i != 16; ++i) {
+        p.start(a);
+        p.start();
+        p.nextFrame();
+    }
+
+    CORRADE_VERIFY(p.sectionPercentile(a, 50.0f) <= p.sectionPercentile(a, 95.0f));
+    CORRADE_VERIFY(p.sectionPercentile(a, 95.0f) <= p.sectionPercentile(a, 99.0f));
+    CORRADE_VERIFY(p.sectionPercentile(a, 99.0f) <= p.framePercentile(99.0f));
+    CORRADE_VERIFY(p.framePercentile(50.0f) <= p.framePercentile(99.0f));
+    CORRADE_VERIFY(p.framePercentile(100.0f) > std::chrono::high_resolution_clock::duration::zero());
+
+    std::ostringstream out;
+    {
+        Debug redirectDebug{&out};
+        p.printStatistics();
+    }
+
+    CORRADE_VERIFY(out.str().find("p50") != std::string::npos);
+    CORRADE_VERIFY(out.str().find(" Frame p50") != std::string::npos);
+}
+
+void ProfilerTest::percentileDisabled() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+
+    CORRADE_COMPARE(p.sectionPercentile(a, 50.0f).count(), 0);
+    CORRADE_COMPARE(p.framePercentile(50.0f).count(), 0);
+}
+
+void ProfilerTest::captureChromeTrace() {
+    const std::string filename = Utility::Directory::join(DEBUGTOOLS_TEST_OUTPUT_DIR, "profiler.json");
+
+    Profiler p;
+    const Profiler::Section a = p.addSection("A \"quoted\"");
+    p.enable();
+
+    CORRADE_VERIFY(!p.isCapturing());
+    CORRADE_VERIFY(p.beginCapture(filename, Profiler::TraceFormat::ChromeTrace));
+    CORRADE_VERIFY(p.isCapturing());
+
+    p.start(a);
+    {
+        Profiler::Scope outer{p, "Outer"};
+        Profiler::Scope inner{p, "Inner"};
+    }
+    p.stop();
+    p.nextFrame();
+
+    p.endCapture();
+    CORRADE_VERIFY(!p.isCapturing());
+
+    const std::string trace = readFile(filename);
+    CORRADE_VERIFY(trace.find("[\n{") == 0);
+    CORRADE_VERIFY(trace.find("\n]\n") == trace.size() - 3);
+    CORRADE_VERIFY(trace.find("{\"name\":\"A \\\"quoted\\\"\",\"cat\":\"section\"") != std::string::npos);
+    CORRADE_VERIFY(trace.find("{\"name\":\"Outer\",\"cat\":\"scope\"") != std::string::npos);
+    CORRADE_VERIFY(trace.find("\"args\":{\"depth\":1}") != std::string::npos);
+    CORRADE_VERIFY(trace.find("{\"name\":\"Frame 0\",\"cat\":\"frame\"") != std::string::npos);
+
+    /* Inner scope ends first */
+    CORRADE_VERIFY(trace.find("\"Inner\"") < trace.find("\"Outer\""));
+}
+
+void ProfilerTest::captureCsv() {
+    const std::string filename = Utility::Directory::join(DEBUGTOOLS_TEST_OUTPUT_DIR, "profiler.csv");
+
+    Profiler p;
+    const Profiler::Section a = p.addSection("A, B");
+    p.enable();
+
+    CORRADE_VERIFY(p.beginCapture(filename, Profiler::TraceFormat::Csv));
+    p.start(a);
+    {
+        Profiler::Scope scope{p, "Scope"};
+    }
+    p.stop();
+    p.nextFrame();
+    p.endCapture();
+
+    const std::string trace = readFile(filename);
+    CORRADE_VERIFY(trace.find("type,name,thread,depth,begin_us,duration_us\n") == 0);
+    CORRADE_VERIFY(trace.find("\nscope,Scope,0,0,") != std::string::npos);
+    CORRADE_VERIFY(trace.find("\nsection,\"A, B\",0,0,") != std::string::npos);
+    CORRADE_VERIFY(trace.find("\nframe,Frame 0,0,0,") != std::string::npos);
+}
+
+void ProfilerTest::captureCannotOpen() {
+    Profiler p;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!p.beginCapture("/nonexistent/profiler.json", Profiler::TraceFormat::ChromeTrace));
+    CORRADE_VERIFY(!p.isCapturing());
+    CORRADE_COMPARE(out.str(), "DebugTools::Profiler::beginCapture(): cannot open file /nonexistent/profiler.json\n");
+}
+
+void ProfilerTest::captureScopeOutside() {
+    const std::string filename = Utility::Directory::join(DEBUGTOOLS_TEST_OUTPUT_DIR, "profiler-outside.csv");
+
+    Profiler p;
+
+    /* Scope created before the capture is not recorded */
+    {
+        Profiler::Scope before{p, "Before"};
+        CORRADE_VERIFY(p.beginCapture(filename, Profiler::TraceFormat::Csv));
+    }
+
+    /* Scope ending after the capture is not recorded either */
+    {
+        Profiler::Scope after{p, "After"};
+        p.endCapture();
+    }
+
+    CORRADE_COMPARE(readFile(filename),
+        "type,name,thread,depth,begin_us,duration_us\n");
+}
+
+void ProfilerTest::captureScopeThreads() {
+    const std::string filename = Utility::Directory::join(DEBUGTOOLS_TEST_OUTPUT_DIR, "profiler-threads.csv");
+
+    Profiler p;
+    CORRADE_VERIFY(p.beginCapture(filename, Profiler::TraceFormat::Csv));
+
+    {
+        Profiler::Scope main{p, "Main"};
+        std::thread thread{[&p]() {
+            Profiler::Scope scope{p, "Worker"};
+        }};
+        thread.join();
+    }
+
+    p.endCapture();
+
+    const std::string trace = readFile(filename);
+    CORRADE_VERIFY(trace.find("\nWorker") == std::string::npos);
+    CORRADE_VERIFY(trace.find("scope,Worker,1,0,") != std::string::npos);
+    CORRADE_VERIFY(trace.find("scope,Main,0,0,") != std::string::npos);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerTest)
@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/DebugTools/TiledRender.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct TiledRenderGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit TiledRenderGLTest();
+
+    void render();
+    void abort();
+};
+
+TiledRenderGLTest::TiledRenderGLTest() {
+    addTests({&TiledRenderGLTest::render,
+              &TiledRenderGLTest::abort});
+}
+
+void TiledRenderGLTest::render() {
+    /* Values that are exact also in RGBA4 */
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i{4});
+    #endif
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    /* Each tile cleared to a color based on its position */
+    std::vector<Range2Di> tiles;
+    std::vector<Image2D> rows;
+    CORRADE_VERIFY(renderTiled(framebuffer, {10, 7}, PixelFormat::RGBA, PixelType::UnsignedByte,
+        [&](const Range2Di& tile) {
+            tiles.push_back(tile);
+            Renderer::setClearColor(Math::normalize<Color4>(Color4ub(tile.min().x()/4*51, tile.min().y()/4*51, 0, 255)));
+            framebuffer.clear(FramebufferClear::Color);
+        }, [&](const ImageView2D& image) {
+            Containers::Array<char> data{image.data().size()};
+            std::copy_n(image.data(), data.size(), data.begin());
+            rows.emplace_back(image.storage(), image.format(), image.type(), image.size(), std::move(data));
+            return true;
+        }));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, Vector2i{4}}));
+    CORRADE_COMPARE_AS(tiles, (std::vector<Range2Di>{
+        {{0, 0}, {4, 4}}, {{4, 0}, {8, 4}}, {{8, 0}, {10, 4}},
+        {{0, 4}, {4, 7}}, {{4, 4}, {8, 7}}, {{8, 4}, {10, 7}}}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(rows.size(), 2);
+    CORRADE_COMPARE(rows[0].size(), (Vector2i{10, 4}));
+    CORRADE_COMPARE(rows[1].size(), (Vector2i{10, 3}));
+    for(std::size_t row = 0; row != rows.size(); ++row) {
+        const Color4ub* pixels = rows[row].data<Color4ub>();
+        for(Int y = 0; y != rows[row].size().y(); ++y) for(Int x = 0; x != 10; ++x) {
+            CORRADE_COMPARE(pixels[y*10 + x], Color4ub(x/4*51, row*51, 0, 255));
+        }
+    }
+}
+
+void TiledRenderGLTest::abort() {
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i{4});
+    #endif
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    /* The second row of tiles shouldn't be rendered at all */
+    Int drawCount = 0, consumeCount = 0;
+    CORRADE_VERIFY(!renderTiled(framebuffer, {10, 7}, PixelFormat::RGBA, PixelType::UnsignedByte,
+        [&](const Range2Di&) {
+            ++drawCount;
+            framebuffer.clear(FramebufferClear::Color);
+        }, [&](const ImageView2D&) {
+            ++consumeCount;
+            return false;
+        }));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawCount, 3);
+    CORRADE_COMPARE(consumeCount, 1);
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, Vector2i{4}}));
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::DebugTools::Test::TiledRenderGLTest)
@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/DebugTools/TiledRender.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct TiledRenderTest: TestSuite::Tester {
+    explicit TiledRenderTest();
+
+    void projectionWholeImage();
+    void projectionOrthographic();
+    void projectionPerspective();
+};
+
+TiledRenderTest::TiledRenderTest() {
+    addTests({&TiledRenderTest::projectionWholeImage,
+              &TiledRenderTest::projectionOrthographic,
+              &TiledRenderTest::projectionPerspective});
+}
+
+namespace {
+
+Vector3 project(const Matrix4& projection, const Vector3& point) {
+    const Vector4 clip = projection*Vector4{point, 1.0f};
+    return clip.xyz()/clip.w();
+}
+
+}
+
+void TiledRenderTest::projectionWholeImage() {
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(35.0f), 1.5f, 0.1f, 100.0f);
+    CORRADE_COMPARE(tileProjectionMatrix(projection, {300, 200}, {{}, {300, 200}}), projection);
+}
+
+void TiledRenderTest::projectionOrthographic() {
+    /* Lower right quarter of the image, the tile corners should end up in
+       the viewport corners */
+    const Matrix4 projection = Matrix4::orthographicProjection({8.0f, 4.0f}, -1.0f, 1.0f);
+    const Matrix4 tile = tileProjectionMatrix(projection, {8, 4}, {{4, 0}, {8, 2}});
+
+    CORRADE_COMPARE(project(tile, {0.0f, -2.0f, 0.5f}), (Vector3{-1.0f, -1.0f, -0.5f}));
+    CORRADE_COMPARE(project(tile, {4.0f, 0.0f, 0.5f}), (Vector3{1.0f, 1.0f, -0.5f}));
+    CORRADE_COMPARE(project(tile, {2.0f, -1.0f, 0.5f}), (Vector3{0.0f, 0.0f, -0.5f}));
+}
+
+void TiledRenderTest::projectionPerspective() {
+    /* Upper right quarter of the image, which is [0, 1] in NDC of the whole
+       image and [-1, 1] in NDC of the tile. Depth shouldn't change. */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 2.0f, 0.1f, 100.0f);
+    const Matrix4 tile = tileProjectionMatrix(projection, {100, 50}, {{50, 25}, {100, 50}});
+
+    const Vector3 point{1.5f, 0.25f, -2.0f};
+    const Vector3 expected = project(projection, point);
+    const Vector3 actual = project(tile, point);
+    CORRADE_COMPARE(actual.xy(), expected.xy()*2.0f - Vector2{1.0f});
+    CORRADE_COMPARE(actual.z(), expected.z());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::TiledRenderTest)
@@ -0,0 +1,117 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TiledRender.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferImage.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+Matrix4 tileProjectionMatrix(const Matrix4& projection, const Vector2i& size, const Range2Di& tile) {
+    /* Scale the tile to the whole [-1, 1] NDC range and move its center to
+       the origin. The translation is multiplied by clip-space w, so it works
+       for perspective projection as well. */
+    const Vector2 scale = Vector2{size}/Vector2{tile.size()};
+    const Vector2 center = Vector2{tile.min() + tile.max()}/Vector2{size} - Vector2{1.0f};
+    return Matrix4::translation({-center*scale, 0.0f})*Matrix4::scaling({scale, 1.0f})*projection;
+}
+
+bool renderTiled(AbstractFramebuffer& framebuffer, const Vector2i& size, const PixelFormat format, const PixelType type, const std::function<void(const Range2Di&)>& draw, const std::function<bool(const ImageView2D&)>& consume) {
+    const Range2Di viewport = framebuffer.viewport();
+    const Vector2i tileSize = viewport.size();
+    CORRADE_ASSERT(tileSize.product(),
+        "DebugTools::renderTiled(): the framebuffer viewport is empty", false);
+
+    /* One row of tiles */
+    const PixelStorage storage = PixelStorage{}.setAlignment(1);
+    const std::size_t pixelSize = PixelStorage::pixelSize(format, type);
+    Containers::Array<char> rows{std::size_t(size.x())*tileSize.y()*pixelSize};
+
+    /* Copies tightly packed tile data into the row */
+    const auto copyTile = [&](const char* const data, const Range2Di& tile) {
+        const std::size_t tileRowSize = tile.sizeX()*pixelSize;
+        for(Int y = 0; y != tile.sizeY(); ++y)
+            std::copy_n(data + y*tileRowSize, tileRowSize,
+                rows + (std::size_t(y)*size.x() + tile.min().x())*pixelSize);
+    };
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Two pixel buffers, one being filled while the other is mapped */
+    BufferImage2D images[]{{storage, format, type}, {storage, format, type}};
+    Range2Di pendingTile;
+    const auto retire = [&](BufferImage2D& image) {
+        const char* data = image.buffer().map<const char>(0, image.dataSize(), Buffer::MapFlag::Read);
+        copyTile(data, pendingTile);
+        image.buffer().unmap();
+    };
+    #else
+    Image2D image{storage, format, type};
+    #endif
+
+    bool result = true;
+    std::size_t tileIndex = 0;
+    for(Int y = 0; y < size.y() && result; y += tileSize.y()) {
+        const Int height = Math::min(tileSize.y(), size.y() - y);
+        for(Int x = 0; x < size.x(); x += tileSize.x(), ++tileIndex) {
+            const Range2Di tile = Range2Di::fromSize({x, y}, {Math::min(tileSize.x(), size.x() - x), height});
+            framebuffer.setViewport({viewport.min(), viewport.min() + tile.size()});
+            draw(tile);
+
+            /* Start reading the tile and finish reading the previous one in
+               the same row meanwhile */
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            framebuffer.read({viewport.min(), viewport.min() + tile.size()}, images[tileIndex % 2], BufferUsage::StreamRead);
+            if(x) retire(images[(tileIndex + 1) % 2]);
+            pendingTile = tile;
+            #else
+            framebuffer.read({viewport.min(), viewport.min() + tile.size()}, image);
+            copyTile(image.data(), tile);
+            #endif
+        }
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        retire(images[(tileIndex + 1) % 2]);
+        #endif
+
+        result = consume(ImageView2D{storage, format, type, {size.x(), height},
+            rows.prefix(std::size_t(size.x())*height*pixelSize)});
+    }
+
+    framebuffer.setViewport(viewport);
+    return result;
+}
+
+}}
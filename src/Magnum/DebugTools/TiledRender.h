@@ -0,0 +1,97 @@
+#ifndef Magnum_DebugTools_TiledRender_h
+#define Magnum_DebugTools_TiledRender_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::DebugTools::tileProjectionMatrix(), @ref Magnum::DebugTools::renderTiled()
+ */
+
+#include <functional>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Projection matrix for a tile of a larger image
+
+Returns @p projection with the sub-frustum corresponding to @p tile of an
+image of given @p size stretched over the whole viewport, so rendering with
+it into a viewport of @p tile size produces given part of the large image.
+Works with both orthographic and perspective projections. Usable for example
+with @ref SceneGraph::Camera3D:
+@code
+camera.setProjectionMatrix(DebugTools::tileProjectionMatrix(projection, size, tile));
+@endcode
+@see @ref renderTiled()
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Matrix4 tileProjectionMatrix(const Matrix4& projection, const Vector2i& size, const Range2Di& tile);
+
+/**
+@brief Render an image larger than the framebuffer in tiles
+
+Splits the image of given @p size into tiles of the @p framebuffer viewport
+size, calls @p draw for each of them and reads its contents. Tiles at the
+right and top edge of the image are smaller, the viewport is set to the size
+of each tile before calling @p draw and restored at the end. The @p draw
+function is expected to clear the framebuffer and render the scene with
+projection matrix created by @ref tileProjectionMatrix().
+
+Each finished row of tiles is passed to @p consume, from bottom to top, as a
+tightly packed (with @ref PixelStorage::alignment() set to `1`) image of full
+width and tile height, so only one such row of tiles is kept in memory at a
+time. If @p consume returns `false`, the rendering is aborted and the function
+returns `false`, otherwise it returns `true`. Example usage, streaming a
+capture larger than @ref Renderbuffer::maxSize() to
+@ref Trade::TgaImageConverter "TgaImageConverter":
+@code
+Framebuffer framebuffer{{{}, Vector2i{Renderbuffer::maxSize()}}};
+// attach color and depth renderbuffers...
+
+Trade::TgaImageConverter converter;
+converter.beginFile("capture.tga", PixelFormat::RGB, PixelType::UnsignedByte, size);
+DebugTools::renderTiled(framebuffer, size, PixelFormat::RGB, PixelType::UnsignedByte,
+    [&](const Range2Di& tile) {
+        framebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+        camera.setProjectionMatrix(DebugTools::tileProjectionMatrix(projection, size, tile));
+        camera.draw(drawables);
+    }, [&](const ImageView2D& rows) { return converter.appendRows(rows); });
+converter.endFile();
+@endcode
+
+Except on OpenGL ES 2.0 and WebGL, the tiles are read asynchronously into
+pixel buffers and copied to client memory only after the next tile was
+rendered, so the GPU doesn't stall on each readback.
+
+Note that only @ref Magnum::PixelFormat "PixelFormat" and @ref PixelType values
+that are marked as framebuffer readable are supported.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT bool renderTiled(AbstractFramebuffer& framebuffer, const Vector2i& size, PixelFormat format, PixelType type, const std::function<void(const Range2Di&)>& draw, const std::function<bool(const ImageView2D&)>& consume);
+
+}}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicResolution.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+    /* Weight of a new measurement in the moving average */
+    constexpr Float Smoothing = 0.25f;
+
+    /* The scale goes up only if the frame time is below this fraction of the
+       target, and at most by given factor per measurement */
+    constexpr Float Headroom = 0.85f;
+    constexpr Float MaxIncrease = 1.05f;
+
+    /* Size granularity in pixels */
+    constexpr Int Granularity = 8;
+}
+
+DynamicResolution::Query::Query(): query{TimeQuery::Target::TimeElapsed}, scale{}, pending{false} {}
+
+DynamicResolution::DynamicResolution(const Vector2i& maxSize, const TextureFormat colorFormat, const RenderbufferFormat depthFormat, const UnsignedInt queryCount): _maxSize{maxSize}, _size{maxSize}, _framebuffer{{{}, maxSize}}, _next{0}, _running{false}, _scale{1.0f}, _minScale{0.5f}, _maxScale{1.0f}, _targetFrameTime{1.0f/60.0f}, _frameTime{0.0f} {
+    CORRADE_ASSERT(queryCount, "DynamicResolution::DynamicResolution(): query count must be positive", );
+
+    _color.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, colorFormat, maxSize);
+    _depth.setStorage(depthFormat, maxSize);
+    _framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, _color, 0)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, _depth);
+
+    _queries.reserve(queryCount);
+    for(UnsignedInt i = 0; i != queryCount; ++i) _queries.emplace_back();
+}
+
+DynamicResolution::~DynamicResolution() = default;
+
+DynamicResolution& DynamicResolution::setScale(const Float scale) {
+    _scale = Math::clamp(scale, _minScale, _maxScale);
+    updateSize();
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setScaleRange(const Float min, const Float max) {
+    CORRADE_ASSERT(min > 0.0f && min <= max && max <= 1.0f,
+        "DynamicResolution::setScaleRange(): invalid range" << min << max, *this);
+    _minScale = min;
+    _maxScale = max;
+    return setScale(_scale);
+}
+
+DynamicResolution& DynamicResolution::setTargetFrameTime(const Float seconds) {
+    _targetFrameTime = seconds;
+    return *this;
+}
+
+void DynamicResolution::updateSize() {
+    /* Round up to the granularity, but don't go over the max size */
+    const Vector2i size{Math::ceil(Vector2{_maxSize}*_scale/Float(Granularity))*Float(Granularity)};
+    _size = Math::min(Math::max(size, Vector2i{1}), _maxSize);
+}
+
+DynamicResolution& DynamicResolution::addFrameTime(const Float time) {
+    /* Moving average to filter out single-frame spikes */
+    _frameTime = _frameTime == 0.0f ? time : _frameTime + (time - _frameTime)*Smoothing;
+    if(_frameTime <= 0.0f) return *this;
+
+    /* The time is proportional to pixel count, i.e. to square of the scale.
+       Go down right away when over the target, go up only gradually and if
+       there's enough headroom. */
+    Float scale = _scale*std::sqrt(_targetFrameTime/_frameTime);
+    if(_frameTime <= _targetFrameTime) {
+        if(_frameTime > _targetFrameTime*Headroom) return *this;
+        scale = Math::min(scale, _scale*MaxIncrease);
+    }
+
+    /* Renormalize the average to the new scale so the next measurements
+       aren't compared against time of a different pixel count */
+    const Float previousScale = _scale;
+    setScale(scale);
+    _frameTime *= (_scale*_scale)/(previousScale*previousScale);
+    return *this;
+}
+
+void DynamicResolution::begin() {
+    CORRADE_ASSERT(!_running, "DynamicResolution::begin(): end() was not called for previous frame", );
+
+    /* Pick up finished queries in the order they were started, stop at the
+       first unfinished one to not wait for the GPU */
+    for(std::size_t i = 0; i != _queries.size(); ++i) {
+        Query& q = _queries[(_next + i) % _queries.size()];
+        if(!q.pending) continue;
+        if(!q.query.resultAvailable()) break;
+
+        /* Normalize the time to current scale */
+        const Float time = q.query.result<UnsignedLong>()/1.0e9f;
+        q.pending = false;
+        addFrameTime(time*(_scale*_scale)/(q.scale*q.scale));
+    }
+
+    _framebuffer.setViewport({{}, _size})
+        .bind();
+
+    /* Start a query if the next one is free, otherwise this frame is not
+       measured */
+    Query& q = _queries[_next];
+    if(!q.pending) {
+        q.query.begin();
+        q.scale = _scale;
+        _running = true;
+    }
+}
+
+void DynamicResolution::end() {
+    if(!_running) return;
+
+    Query& q = _queries[_next];
+    q.query.end();
+    q.pending = true;
+    _next = (_next + 1) % _queries.size();
+    _running = false;
+}
+
+}
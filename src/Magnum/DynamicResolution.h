@@ -0,0 +1,249 @@
+#ifndef Magnum_DynamicResolution_h
+#define Magnum_DynamicResolution_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DynamicResolution
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TimeQuery.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Dynamic resolution controller
+
+Renders the scene into a framebuffer allocated at maximal size, using only its
+lower left part, and scales the rendered part to keep GPU frame time at given
+target. The GPU time of each frame is measured with @ref TimeQuery, the results
+are picked up a few frames later without stalling the pipeline.
+
+## Usage
+
+Wrap the scene rendering in @ref begin() and @ref end() and then upscale the
+result to the default framebuffer, for example with
+@ref Shaders::SharpenUpscale and @ref MeshTools::fullScreenTriangle():
+@code
+DynamicResolution resolution{defaultFramebuffer.viewport().size()};
+resolution.setTargetFrameTime(1.0f/60.0f)
+    .setScaleRange(0.5f, 1.0f);
+
+// each frame
+resolution.begin();
+resolution.framebuffer().clear(FramebufferClear::Color|FramebufferClear::Depth);
+camera.setViewport(resolution.size());
+camera.draw(drawables);
+resolution.end();
+
+defaultFramebuffer.bind();
+upscale.setTexture(resolution.colorTexture())
+    .setTextureScale(resolution.textureScale());
+triangle.draw(upscale);
+@endcode
+
+The GPU time is assumed to be proportional to pixel count. When the frame time
+gets over the target, the scale is lowered right away, it goes up only
+gradually and only if there's enough headroom, to avoid oscillation. The
+rendered size is rounded up to a multiple of eight pixels so small
+fluctuations don't change it every frame.
+
+@requires_gl33 Extension @extension{ARB,timer_query}
+@requires_es_extension Extension @es_extension{EXT,disjoint_timer_query}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_gles Time queries are not available in WebGL.
+*/
+class MAGNUM_EXPORT DynamicResolution {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxSize       Maximal size of the render target
+         * @param colorFormat   Color texture format
+         * @param depthFormat   Depth renderbuffer format
+         * @param queryCount    Count of time queries in flight
+         *
+         * The scale is initially `1.0f`.
+         */
+        explicit DynamicResolution(const Vector2i& maxSize, TextureFormat colorFormat = TextureFormat::RGBA8, RenderbufferFormat depthFormat = RenderbufferFormat::DepthComponent24, UnsignedInt queryCount = 3);
+
+        /** @brief Copying is not allowed */
+        DynamicResolution(const DynamicResolution&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicResolution(DynamicResolution&&) = delete;
+
+        ~DynamicResolution();
+
+        /** @brief Copying is not allowed */
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicResolution& operator=(DynamicResolution&&) = delete;
+
+        /** @brief Render target framebuffer */
+        Framebuffer& framebuffer() { return _framebuffer; }
+
+        /** @brief Color texture */
+        Texture2D& colorTexture() { return _color; }
+
+        /** @brief Depth renderbuffer */
+        Renderbuffer& depthRenderbuffer() { return _depth; }
+
+        /** @brief Maximal size */
+        Vector2i maxSize() const { return _maxSize; }
+
+        /**
+         * @brief Current render size
+         *
+         * @ref maxSize() multiplied by @ref scale(), rounded up to a multiple
+         * of eight pixels and clamped to @ref maxSize().
+         */
+        Vector2i size() const { return _size; }
+
+        /**
+         * @brief Rendered part of the color texture
+         *
+         * @ref size() divided by @ref maxSize(), to be passed to
+         * @ref Shaders::SharpenUpscale::setTextureScale().
+         */
+        Vector2 textureScale() const { return Vector2{_size}/Vector2{_maxSize}; }
+
+        /** @brief Scale of each dimension */
+        Float scale() const { return _scale; }
+
+        /**
+         * @brief Set scale
+         * @return Reference to self (for method chaining)
+         *
+         * The value is clamped to the range set by @ref setScaleRange(). The
+         * scale is then adjusted by subsequent frame time measurements.
+         */
+        DynamicResolution& setScale(Float scale);
+
+        /** @brief Minimal scale */
+        Float minScale() const { return _minScale; }
+
+        /** @brief Maximal scale */
+        Float maxScale() const { return _maxScale; }
+
+        /**
+         * @brief Set scale range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p min is positive and not larger than @p max and
+         * that @p max is not larger than `1.0f`. Default is `0.5f` to
+         * `1.0f`. Current scale is clamped to the new range.
+         */
+        DynamicResolution& setScaleRange(Float min, Float max);
+
+        /** @brief Target GPU frame time in seconds */
+        Float targetFrameTime() const { return _targetFrameTime; }
+
+        /**
+         * @brief Set target GPU frame time
+         * @return Reference to self (for method chaining)
+         *
+         * In seconds, default is `1.0f/60.0f`. Note that the measured time
+         * covers only the commands between @ref begin() and @ref end(), so
+         * the target should leave some room for the rest of the frame.
+         */
+        DynamicResolution& setTargetFrameTime(Float seconds);
+
+        /**
+         * @brief Measured GPU frame time in seconds
+         *
+         * Moving average of the recent measurements, normalized to current
+         * @ref scale(). `0.0f` if nothing was measured yet.
+         */
+        Float frameTime() const { return _frameTime; }
+
+        /**
+         * @brief Add frame time measurement
+         * @return Reference to self (for method chaining)
+         *
+         * Called from @ref begin() for each finished time query, but can be
+         * used also to feed measurements coming from elsewhere. The @p time
+         * is in seconds and is expected to be measured at current
+         * @ref scale(). Updates @ref frameTime() and adjusts the scale.
+         */
+        DynamicResolution& addFrameTime(Float time);
+
+        /**
+         * @brief Begin rendering a frame
+         *
+         * Adds results of all finished time queries with @ref addFrameTime(),
+         * without waiting for the unfinished ones, sets the framebuffer
+         * viewport to @ref size(), binds it and starts a time query if there
+         * is a free one.
+         * @see @ref end(), @ref TimeQuery::resultAvailable()
+         */
+        void begin();
+
+        /**
+         * @brief End rendering a frame
+         *
+         * Ends the time query started in @ref begin(), if any.
+         */
+        void end();
+
+    private:
+        struct Query {
+            explicit Query();
+
+            TimeQuery query;
+            Float scale;
+            bool pending;
+        };
+
+        void MAGNUM_LOCAL updateSize();
+
+        Vector2i _maxSize, _size;
+        Texture2D _color;
+        Renderbuffer _depth;
+        Framebuffer _framebuffer;
+
+        std::vector<Query> _queries;
+        UnsignedInt _next;
+        bool _running;
+
+        Float _scale, _minScale, _maxScale, _targetFrameTime, _frameTime;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -200,8 +200,10 @@ namespace GL {
         _extension(GL,ARB,pipeline_statistics_query,    GL300,  None) // #171
         _extension(GL,ARB,sparse_buffer,                GL210,  None) // #172
         _extension(GL,ARB,transform_feedback_overflow_query, GL300, None) // #173
+        _extension(GL,ARB,gl_spirv,                     GL330,  None) // #190
     } namespace ATI {
         _extension(GL,ATI,texture_mirror_once,          GL210,  None) // #221
+        _extension(GL,ATI,meminfo,                      GL210,  None) // #359
     } namespace EXT {
         _extension(GL,EXT,texture_filter_anisotropic,   GL210,  None) // #187
         _extension(GL,EXT,texture_compression_s3tc,     GL210,  None) // #198
@@ -233,11 +235,14 @@ namespace GL {
         _extension(GL,KHR,blend_equation_advanced,      GL210,  None) // #174
         _extension(GL,KHR,blend_equation_advanced_coherent, GL210, None) // #174
         _extension(GL,KHR,no_error,                     GL210,  None) // #175
+        _extension(GL,KHR,parallel_shader_compile,      GL210,  None) // #192
     } namespace NV {
         _extension(GL,NV,primitive_restart,             GL210, GL310) // #285
         _extension(GL,NV,depth_buffer_float,            GL210, GL300) // #334
         _extension(GL,NV,conditional_render,            GL210, GL300) // #346
         /* NV_draw_texture not supported */                           // #430
+    } namespace NVX {
+        _extension(GL,NVX,gpu_memory_info,              GL210,  None) // #438
     }
     /* IMPORTANT: if this line is > 329 (73 + size), don't forget to update array size in Context.h */
     #elif defined(MAGNUM_TARGET_WEBGL)
@@ -377,6 +382,7 @@ namespace GL {
         _extension(GL,KHR,robust_buffer_access_behavior, GLES200, None) // #189
         _extension(GL,KHR,context_flush_control,    GLES200,    None) // #191
         _extension(GL,KHR,no_error,                 GLES200,    None) // #243
+        _extension(GL,KHR,parallel_shader_compile,  GLES200,    None) // #288
     } namespace NV {
         #ifdef MAGNUM_TARGET_GLES2
         _extension(GL,NV,draw_buffers,              GLES200, GLES300) // #91
@@ -0,0 +1,65 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FixedStepTimeline.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+FixedStepTimeline::FixedStepTimeline(const Float stepDuration, const UnsignedInt maxSteps): _stepDuration{stepDuration}, _maxSteps{maxSteps}, _accumulated{}, _droppedTime{}, _stepCount{} {
+    CORRADE_ASSERT(stepDuration > 0.0f && maxSteps,
+        "FixedStepTimeline: step duration and max step count must be positive", );
+}
+
+void FixedStepTimeline::advance(const Float frameDuration) {
+    if(frameDuration <= 0.0f) return;
+
+    _accumulated += frameDuration;
+
+    /* Drop everything above max step count so a slow simulation doesn't
+       spiral out of control */
+    const Float max = _maxSteps*_stepDuration;
+    if(_accumulated > max) {
+        _droppedTime += _accumulated - max;
+        _accumulated = max;
+    }
+}
+
+bool FixedStepTimeline::step() {
+    if(_accumulated < _stepDuration) return false;
+
+    _accumulated -= _stepDuration;
+    ++_stepCount;
+    return true;
+}
+
+void FixedStepTimeline::reset() {
+    _accumulated = 0.0f;
+    _droppedTime = 0.0f;
+    _stepCount = 0;
+}
+
+}
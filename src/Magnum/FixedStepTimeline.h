@@ -0,0 +1,162 @@
+#ifndef Magnum_FixedStepTimeline_h
+#define Magnum_FixedStepTimeline_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FixedStepTimeline
+ */
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Fixed-step timeline
+
+Decouples simulation rate from rendering rate. Frame durations, for example
+from @ref Timeline::previousFrameDuration(), are accumulated with
+@ref advance() and then consumed in steps of constant duration with
+@ref step(). The time left over after all whole steps is exposed as
+@ref alpha(), which can be used to interpolate rendered state between the last
+two simulation steps, for example using @ref SceneGraph::TransformationInterpolator.
+
+## Basic usage
+
+Call @ref advance() once per frame and then run the simulation as long as
+@ref step() returns `true`:
+@code
+FixedStepTimeline fixed{1.0f/60.0f};
+
+void MyApplication::drawEvent() {
+    fixed.advance(timeline.previousFrameDuration());
+
+    interpolator.restore();
+    while(fixed.step()) {
+        animables.step(fixed.time(), fixed.stepDuration());
+        // physics, collision queries ...
+        interpolator.save();
+    }
+    interpolator.interpolate(fixed.alpha());
+
+    camera.draw(drawables);
+
+    swapBuffers();
+    redraw();
+    timeline.nextFrame();
+}
+@endcode
+
+The simulation thus runs with the same step regardless of framerate, which
+makes it stable and deterministic, while the rendering stays smooth even if
+the framerate is not a multiple of the simulation rate.
+
+## Spiral of death
+
+If a single simulation step takes longer than the step duration, each frame
+accumulates more time than it consumes and the application gradually grinds
+to a halt. To prevent that, at most @ref maxSteps() steps are run per frame
+and time above that is dropped, so the simulation slows down instead. The
+dropped time is reported in @ref droppedTime().
+*/
+class MAGNUM_EXPORT FixedStepTimeline {
+    public:
+        /**
+         * @brief Constructor
+         * @param stepDuration  Simulation step duration in seconds
+         * @param maxSteps      Max count of steps run per frame
+         *
+         * Expects that both values are positive.
+         */
+        explicit FixedStepTimeline(Float stepDuration, UnsignedInt maxSteps = 8);
+
+        /** @brief Simulation step duration (in seconds) */
+        Float stepDuration() const { return _stepDuration; }
+
+        /** @brief Max count of steps run per frame */
+        UnsignedInt maxSteps() const { return _maxSteps; }
+
+        /**
+         * @brief Accumulate frame duration
+         *
+         * Adds @p frameDuration (in seconds) to the time not yet consumed by
+         * @ref step(). Time exceeding @ref maxSteps() steps is dropped, see
+         * @ref droppedTime(). Negative durations are ignored.
+         */
+        void advance(Float frameDuration);
+
+        /**
+         * @brief Consume one simulation step
+         *
+         * If at least @ref stepDuration() is accumulated, subtracts it,
+         * advances @ref time() and returns `true`. Otherwise returns `false`.
+         */
+        bool step();
+
+        /**
+         * @brief Interpolation factor
+         *
+         * Fraction of step duration accumulated but not consumed by
+         * @ref step(), in range @f$ [0, 1) @f$. Use it to interpolate
+         * between state after the previous and the last step.
+         */
+        Float alpha() const { return _accumulated/_stepDuration; }
+
+        /** @brief Count of steps run since construction or @ref reset() */
+        UnsignedLong stepCount() const { return _stepCount; }
+
+        /**
+         * @brief Simulation time (in seconds)
+         *
+         * Equal to @ref stepCount() multiplied by @ref stepDuration().
+         */
+        Float time() const { return Float(Double(_stepCount)*_stepDuration); }
+
+        /**
+         * @brief Dropped time (in seconds)
+         *
+         * Time dropped since construction or @ref reset() because
+         * @ref maxSteps() was exceeded.
+         */
+        Float droppedTime() const { return _droppedTime; }
+
+        /**
+         * @brief Reset the timeline
+         *
+         * Sets step count, accumulated and dropped time to zero.
+         */
+        void reset();
+
+    private:
+        Float _stepDuration;
+        UnsignedInt _maxSteps;
+        Float _accumulated, _droppedTime;
+        UnsignedLong _stepCount;
+};
+
+}
+
+#endif
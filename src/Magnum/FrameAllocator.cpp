@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameAllocator.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+FrameAllocator& FrameAllocator::current() {
+    /* __thread supports only trivially destructible types, so the allocator
+       is created on the heap and never freed there */
+    #if defined(MAGNUM_BUILD_MULTITHREADED) && (defined(CORRADE_GCC47_COMPATIBILITY) || defined(CORRADE_TARGET_APPLE))
+    static __thread FrameAllocator* allocator = nullptr;
+    if(!allocator) allocator = new FrameAllocator;
+    return *allocator;
+    #else
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    thread_local
+    #endif
+    static FrameAllocator allocator;
+    return allocator;
+    #endif
+}
+
+FrameAllocator::FrameAllocator(const std::size_t capacity): _initialCapacity{capacity} {}
+
+FrameAllocator::~FrameAllocator() = default;
+
+std::size_t FrameAllocator::capacity() const {
+    std::size_t capacity = 0;
+    for(const Block& block: _blocks) capacity += block.size;
+    return capacity;
+}
+
+void* FrameAllocator::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "FrameAllocator::allocate(): alignment" << alignment << "is not a power of two", nullptr);
+
+    /* Try to fit the allocation into the current block */
+    if(!_blocks.empty()) {
+        Block& block = _blocks.back();
+        const std::size_t address = reinterpret_cast<std::size_t>(block.data.get());
+        const std::size_t offset = ((address + _offset + alignment - 1) & ~(alignment - 1)) - address;
+        if(offset + size <= block.size) {
+            _usedSize += offset + size - _offset;
+            _offset = offset + size;
+            ++_allocationCount;
+            return block.data.get() + offset;
+        }
+    }
+
+    /* Not enough space, allocate a new block large enough for the aligned
+       allocation. Blocks get merged into one after all allocations are
+       freed, so this happens only until the capacity settles. */
+    const std::size_t blockSize = std::max(_initialCapacity, size + alignment - 1);
+    _blocks.push_back({std::unique_ptr<char[]>{new char[blockSize]}, blockSize});
+    ++_heapAllocationCount;
+
+    char* const data = _blocks.back().data.get();
+    const std::size_t address = reinterpret_cast<std::size_t>(data);
+    const std::size_t offset = ((address + alignment - 1) & ~(alignment - 1)) - address;
+    _usedSize += offset + size;
+    _offset = offset + size;
+    ++_allocationCount;
+    return data + offset;
+}
+
+void FrameAllocator::deallocate(void* const data) {
+    if(!data) return;
+
+    CORRADE_ASSERT(_allocationCount,
+        "FrameAllocator::deallocate(): no allocation to free", );
+
+    if(!--_allocationCount) rewind();
+}
+
+void FrameAllocator::rewind() {
+    _offset = 0;
+    _usedSize = 0;
+
+    /* Merge all blocks into one so the next frame fits without overflowing */
+    if(_blocks.size() > 1) {
+        const std::size_t size = capacity();
+        _blocks.clear();
+        _blocks.push_back({std::unique_ptr<char[]>{new char[size]}, size});
+        ++_heapAllocationCount;
+    }
+}
+
+}
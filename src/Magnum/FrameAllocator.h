@@ -0,0 +1,253 @@
+#ifndef Magnum_FrameAllocator_h
+#define Magnum_FrameAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FrameAllocator, @ref Magnum::FrameAllocatorAdapter, alias @ref Magnum::FrameVector
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Linear allocator for per-frame temporaries
+
+Hands out memory by bumping an offset in a preallocated block, which is
+reused once all allocations made from it are freed again. Engine internals
+such as multi-threaded @ref SceneGraph::Object::setClean(),
+@ref Shapes::ShapeGroup::candidatePairs() or
+@ref Text::AbstractBatchRenderer::add() use the allocator of current thread
+for their temporary arrays through @ref FrameVector, so once the capacity
+settles after the first few frames, they don't touch the global heap at all.
+
+## Basic usage
+
+The allocator is meant to be used through @ref FrameVector for short-lived
+arrays local to a function:
+@code
+FrameVector<UnsignedInt> indices;
+indices.reserve(objectCount);
+// ...
+@endcode
+
+All @ref Platform application classes call @ref nextFrame() from their
+`swapBuffers()` implementation, resetting the per-frame statistics. Count of
+heap allocations done by the allocator during the frame can be queried with
+@ref heapAllocationCount() to verify that the steady state is
+allocation-free:
+@code
+void MyApplication::drawEvent() {
+    CORRADE_INTERNAL_ASSERT(FrameAllocator::current().heapAllocationCount() == 0);
+
+    // ...
+
+    swapBuffers();
+}
+@endcode
+
+## Memory management
+
+If the current block is not large enough for given allocation, a new one is
+allocated from the heap. When all allocations are freed, the offset is reset
+to the beginning and if more than one block was needed, all blocks are
+replaced with a single one of their total size. Memory of freed allocations
+is thus not reused until all allocations are freed, so the allocator is not
+suitable for long-lived data --- a single allocation kept alive would make
+the memory usage grow without bounds.
+
+## Thread safety
+
+Each thread has its own allocator returned by @ref current(), if Magnum is
+built with `MAGNUM_BUILD_MULTITHREADED`. The allocator itself is not
+thread-safe, so the memory needs to be freed on the same thread it was
+allocated on.
+*/
+class MAGNUM_EXPORT FrameAllocator {
+    public:
+        /**
+         * @brief Allocator for current thread
+         *
+         * Created with default capacity on first use.
+         */
+        static FrameAllocator& current();
+
+        /**
+         * @brief Constructor
+         * @param capacity  Size of the initial block in bytes
+         *
+         * The block is allocated on first call to @ref allocate().
+         */
+        explicit FrameAllocator(std::size_t capacity = 64*1024);
+
+        /** @brief Copying is not allowed */
+        FrameAllocator(const FrameAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameAllocator(FrameAllocator&&) = delete;
+
+        ~FrameAllocator();
+
+        /** @brief Copying is not allowed */
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+        /**
+         * @brief Capacity in bytes
+         *
+         * Total size of all allocated blocks.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Used size in bytes
+         *
+         * Including alignment padding. Reset to `0` when all allocations are
+         * freed.
+         */
+        std::size_t usedSize() const { return _usedSize; }
+
+        /** @brief Count of allocations that are not freed yet */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Count of heap allocations done since last @ref nextFrame()
+         *
+         * Counts allocations of new blocks and merging of existing blocks,
+         * `0` in the steady state.
+         */
+        std::size_t heapAllocationCount() const { return _heapAllocationCount; }
+
+        /**
+         * @brief Allocate memory
+         * @param size      Size in bytes
+         * @param alignment Alignment in bytes
+         *
+         * Expects that @p alignment is a power of two.
+         * @see @ref deallocate()
+         */
+        void* allocate(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Free memory
+         *
+         * The memory is actually reused only after all allocations are freed.
+         * Passing `nullptr` is a no-op.
+         */
+        void deallocate(void* data);
+
+        /**
+         * @brief Start next frame
+         *
+         * Resets @ref heapAllocationCount(). Called from `swapBuffers()` of
+         * all @ref Platform application classes.
+         */
+        void nextFrame() { _heapAllocationCount = 0; }
+
+    private:
+        MAGNUM_LOCAL void rewind();
+
+        struct Block {
+            std::unique_ptr<char[]> data;
+            std::size_t size;
+        };
+
+        std::size_t _initialCapacity;
+        std::vector<Block> _blocks;
+        std::size_t _offset{}, _usedSize{}, _allocationCount{}, _heapAllocationCount{};
+};
+
+/**
+@brief Standard allocator adapter for @ref FrameAllocator
+
+Allows to use @ref FrameAllocator with STL containers, see @ref FrameVector.
+*/
+template<class T> class FrameAllocatorAdapter {
+    public:
+        typedef T value_type; /**< @brief Value type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Uses @ref FrameAllocator::current().
+         */
+        FrameAllocatorAdapter(): _allocator{&FrameAllocator::current()} {}
+
+        /** @brief Construct with given allocator */
+        /*implicit*/ FrameAllocatorAdapter(FrameAllocator& allocator) noexcept: _allocator{&allocator} {}
+
+        /** @brief Construct from adapter for another type */
+        template<class U> FrameAllocatorAdapter(const FrameAllocatorAdapter<U>& other) noexcept: _allocator{&other.allocator()} {}
+
+        /** @brief Underlying allocator */
+        FrameAllocator& allocator() const { return *_allocator; }
+
+        /** @brief Allocate memory for @p count items */
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(_allocator->allocate(count*sizeof(T), alignof(T)));
+        }
+
+        /** @brief Free memory */
+        void deallocate(T* data, std::size_t) { _allocator->deallocate(data); }
+
+    private:
+        FrameAllocator* _allocator;
+};
+
+/** @relates FrameAllocatorAdapter
+@brief Equality comparison
+
+Adapters are equal if they use the same allocator.
+*/
+template<class T, class U> bool operator==(const FrameAllocatorAdapter<T>& a, const FrameAllocatorAdapter<U>& b) {
+    return &a.allocator() == &b.allocator();
+}
+
+/** @relates FrameAllocatorAdapter
+@brief Non-equality comparison
+*/
+template<class T, class U> bool operator!=(const FrameAllocatorAdapter<T>& a, const FrameAllocatorAdapter<U>& b) {
+    return &a.allocator() != &b.allocator();
+}
+
+/**
+@brief Vector allocated with @ref FrameAllocator
+
+Meant for temporary arrays local to a function, see @ref FrameAllocator for
+more information.
+*/
+template<class T> using FrameVector = std::vector<T, FrameAllocatorAdapter<T>>;
+
+}
+
+#endif
@@ -0,0 +1,428 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FrameGraph.h"
+
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+
+enum class AttachmentType: UnsignedByte { Color, Depth, DepthStencil };
+
+AttachmentType attachmentType(const TextureFormat format) {
+    switch(format) {
+        case TextureFormat::DepthComponent:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::DepthComponent16:
+        case TextureFormat::DepthComponent24:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::DepthComponent32F:
+        #endif
+            return AttachmentType::Depth;
+
+        case TextureFormat::DepthStencil:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::Depth32FStencil8:
+        #endif
+            return AttachmentType::DepthStencil;
+
+        default: return AttachmentType::Color;
+    }
+}
+
+constexpr std::size_t None = std::numeric_limits<std::size_t>::max();
+
+struct Attachment {
+    TextureFormat format;
+    Vector2 viewportScale;
+    Texture2D* imported;
+    Vector2i size;
+    std::vector<UnsignedInt> writers;
+
+    /* Filled in compile(): index of the backing texture and position of the
+       first and last pass using the attachment in the execution order */
+    std::size_t texture, first, last;
+};
+
+struct Write {
+    UnsignedInt attachment;
+    AttachmentType type;
+    UnsignedInt colorIndex;
+};
+
+struct Pass {
+    explicit Pass(std::function<void()>&& execute): execute{std::move(execute)} {}
+
+    std::function<void()> execute;
+    std::vector<UnsignedInt> reads;
+    std::vector<Write> writes;
+    UnsignedInt colorCount{};
+
+    /* Filled in compile() */
+    Framebuffer framebuffer{NoCreate};
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    std::vector<Framebuffer::InvalidationAttachment> invalidateBefore;
+    std::vector<std::pair<UnsignedInt, Framebuffer::InvalidationAttachment>> invalidateAfter;
+    #endif
+};
+
+struct PooledTexture {
+    TextureFormat format;
+    Vector2i size;
+    std::unique_ptr<Texture2D> texture;
+    std::size_t last;
+};
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+template<class F> void forEachInvalidationAttachment(const Write& write, F f) {
+    if(write.type == AttachmentType::Color)
+        f(Framebuffer::InvalidationAttachment{Framebuffer::ColorAttachment{write.colorIndex}});
+    else {
+        f(Framebuffer::InvalidationAttachment::Depth);
+        if(write.type == AttachmentType::DepthStencil)
+            f(Framebuffer::InvalidationAttachment::Stencil);
+    }
+}
+#endif
+
+}
+
+struct FrameGraph::State {
+    std::vector<Attachment> attachments;
+    std::vector<Pass> passes;
+    std::vector<PooledTexture> textures;
+
+    /* Execution order, filled in compile() */
+    std::vector<UnsignedInt> order;
+    bool compiled{};
+
+    /* Temporary storage for execute(), reused to avoid allocations */
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    std::vector<Framebuffer::InvalidationAttachment> invalidate;
+    #endif
+};
+
+FrameGraph::FrameGraph(): _state{new State} {}
+
+FrameGraph::FrameGraph(FrameGraph&&) noexcept = default;
+
+FrameGraph::~FrameGraph() = default;
+
+FrameGraph& FrameGraph::operator=(FrameGraph&&) noexcept = default;
+
+UnsignedInt FrameGraph::addAttachment(const TextureFormat format, const Vector2& viewportScale) {
+    _state->attachments.push_back({format, viewportScale, nullptr, {}, {}, None, None, None});
+    _state->compiled = false;
+    return _state->attachments.size() - 1;
+}
+
+UnsignedInt FrameGraph::importAttachment(Texture2D& texture, const Vector2i& size, const TextureFormat format) {
+    _state->attachments.push_back({format, {}, &texture, size, {}, None, None, None});
+    _state->compiled = false;
+    return _state->attachments.size() - 1;
+}
+
+UnsignedInt FrameGraph::addPass(std::function<void()> execute) {
+    _state->passes.emplace_back(std::move(execute));
+    _state->compiled = false;
+    return _state->passes.size() - 1;
+}
+
+FrameGraph& FrameGraph::addRead(const UnsignedInt pass, const UnsignedInt attachment) {
+    CORRADE_ASSERT(pass < _state->passes.size() && attachment < _state->attachments.size(),
+        "FrameGraph::addRead(): pass" << pass << "or attachment" << attachment << "out of range", *this);
+    _state->passes[pass].reads.push_back(attachment);
+    _state->compiled = false;
+    return *this;
+}
+
+FrameGraph& FrameGraph::addWrite(const UnsignedInt pass, const UnsignedInt attachment) {
+    CORRADE_ASSERT(pass < _state->passes.size() && attachment < _state->attachments.size(),
+        "FrameGraph::addWrite(): pass" << pass << "or attachment" << attachment << "out of range", *this);
+    Pass& p = _state->passes[pass];
+    const AttachmentType type = attachmentType(_state->attachments[attachment].format);
+    p.writes.push_back({attachment, type, type == AttachmentType::Color ? p.colorCount++ : 0});
+    _state->attachments[attachment].writers.push_back(pass);
+    _state->compiled = false;
+    return *this;
+}
+
+void FrameGraph::compile(const Vector2i& viewport) {
+    State& state = *_state;
+    const std::size_t passCount = state.passes.size();
+
+    /* A reader depends on all writers of the attachment, writers of the same
+       attachment on each other in the order they were added */
+    std::vector<std::vector<UnsignedInt>> dependencies(passCount);
+    for(std::size_t i = 0; i != passCount; ++i)
+        for(const UnsignedInt attachment: state.passes[i].reads)
+            for(const UnsignedInt writer: state.attachments[attachment].writers)
+                if(writer != i) dependencies[i].push_back(writer);
+    for(const Attachment& attachment: state.attachments)
+        for(std::size_t i = 1; i < attachment.writers.size(); ++i)
+            if(attachment.writers[i] != attachment.writers[i - 1])
+                dependencies[attachment.writers[i]].push_back(attachment.writers[i - 1]);
+
+    /* Topological sort, preferring the order in which the passes were added */
+    std::vector<UnsignedInt> order;
+    std::vector<bool> scheduled(passCount);
+    for(std::size_t i = 0; i != passCount; ++i) {
+        std::size_t next = 0;
+        for(; next != passCount; ++next) {
+            if(scheduled[next]) continue;
+            bool ready = true;
+            for(const UnsignedInt dependency: dependencies[next]) if(!scheduled[dependency]) {
+                ready = false;
+                break;
+            }
+            if(ready) break;
+        }
+
+        CORRADE_ASSERT(next != passCount,
+            "FrameGraph::compile(): circular dependency between passes", );
+        scheduled[next] = true;
+        order.push_back(next);
+    }
+
+    /* Passes with no writes or writing to imported attachments are needed,
+       and everything they depend on. Going in reverse execution order, as
+       the dependencies are always earlier. */
+    std::vector<bool> needed(passCount);
+    for(std::size_t i = 0; i != passCount; ++i) {
+        const Pass& pass = state.passes[i];
+        if(pass.writes.empty()) needed[i] = true;
+        for(const Write& write: pass.writes)
+            if(state.attachments[write.attachment].imported) needed[i] = true;
+    }
+    for(auto it = order.rbegin(); it != order.rend(); ++it)
+        if(needed[*it]) for(const UnsignedInt dependency: dependencies[*it])
+            needed[dependency] = true;
+
+    state.order.clear();
+    for(const UnsignedInt pass: order) if(needed[pass])
+        state.order.push_back(pass);
+
+    /* Attachment lifetimes and sizes */
+    for(Attachment& attachment: state.attachments) {
+        attachment.texture = attachment.first = attachment.last = None;
+        if(!attachment.imported)
+            attachment.size = Math::max(Vector2i{Vector2{viewport}*attachment.viewportScale}, Vector2i{1});
+    }
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        const Pass& pass = state.passes[state.order[i]];
+        auto use = [&](const UnsignedInt id) {
+            Attachment& attachment = state.attachments[id];
+            if(attachment.first == None) attachment.first = i;
+            attachment.last = i;
+        };
+        for(const UnsignedInt attachment: pass.reads) use(attachment);
+        for(const Write& write: pass.writes) use(write.attachment);
+    }
+
+    /* Assign textures to transient attachments in order of their first use,
+       reusing a texture of the same format and size if its previous user is
+       not needed anymore. Textures from previous compilation are reused if
+       possible. */
+    std::vector<PooledTexture> previous = std::move(state.textures);
+    state.textures.clear();
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        const Pass& pass = state.passes[state.order[i]];
+        auto assign = [&](const UnsignedInt id) {
+            Attachment& attachment = state.attachments[id];
+            if(attachment.imported || attachment.first != i || attachment.texture != None) return;
+
+            for(std::size_t t = 0; t != state.textures.size(); ++t) {
+                PooledTexture& texture = state.textures[t];
+                if(texture.format != attachment.format || texture.size != attachment.size || texture.last >= i) continue;
+                attachment.texture = t;
+                texture.last = attachment.last;
+                return;
+            }
+
+            std::unique_ptr<Texture2D> texture;
+            for(PooledTexture& p: previous) if(p.texture && p.format == attachment.format && p.size == attachment.size) {
+                texture = std::move(p.texture);
+                break;
+            }
+            if(!texture) {
+                texture.reset(new Texture2D);
+                const Sampler::Filter filter = attachmentType(attachment.format) == AttachmentType::Color ? Sampler::Filter::Linear : Sampler::Filter::Nearest;
+                texture->setMinificationFilter(filter)
+                    .setMagnificationFilter(filter)
+                    .setWrapping(Sampler::Wrapping::ClampToEdge)
+                    .setStorage(1, attachment.format, attachment.size);
+            }
+
+            attachment.texture = state.textures.size();
+            state.textures.push_back({attachment.format, attachment.size, std::move(texture), attachment.last});
+        };
+        for(const UnsignedInt attachment: pass.reads) assign(attachment);
+        for(const Write& write: pass.writes) assign(write.attachment);
+    }
+
+    /* Framebuffers and invalidation lists */
+    for(Pass& pass: state.passes) {
+        pass.framebuffer = Framebuffer{NoCreate};
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        pass.invalidateBefore.clear();
+        pass.invalidateAfter.clear();
+        #endif
+    }
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        Pass& pass = state.passes[state.order[i]];
+        if(pass.writes.empty()) continue;
+
+        const Vector2i size = state.attachments[pass.writes.front().attachment].size;
+        pass.framebuffer = Framebuffer{{{}, size}};
+
+        std::vector<std::pair<UnsignedInt, Framebuffer::DrawAttachment>> drawAttachments;
+        for(const Write& write: pass.writes) {
+            const Attachment& attachment = state.attachments[write.attachment];
+            CORRADE_ASSERT(attachment.size == size,
+                "FrameGraph::compile(): attachments written by pass" << state.order[i] << "have different sizes", );
+
+            Texture2D& texture = attachment.imported ? *attachment.imported : *state.textures[attachment.texture].texture;
+            switch(write.type) {
+                case AttachmentType::Color:
+                    pass.framebuffer.attachTexture(Framebuffer::ColorAttachment{write.colorIndex}, texture, 0);
+                    drawAttachments.emplace_back(write.colorIndex, Framebuffer::ColorAttachment{write.colorIndex});
+                    break;
+                case AttachmentType::Depth:
+                    pass.framebuffer.attachTexture(Framebuffer::BufferAttachment::Depth, texture, 0);
+                    break;
+                case AttachmentType::DepthStencil:
+                    pass.framebuffer.attachTexture(Framebuffer::BufferAttachment::DepthStencil, texture, 0);
+                    break;
+            }
+
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            /* Previous contents of transient attachments are never used */
+            if(!attachment.imported && attachment.first == i)
+                forEachInvalidationAttachment(write, [&pass](Framebuffer::InvalidationAttachment a) {
+                    pass.invalidateBefore.push_back(a);
+                });
+            #endif
+        }
+
+        if(drawAttachments.size() > 1)
+            pass.framebuffer.mapForDraw(drawAttachments);
+    }
+
+    /* Transient attachments are invalidated after the last pass using them,
+       through the framebuffer of the last pass that wrote them */
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    for(std::size_t i = 0; i != state.order.size(); ++i) {
+        const UnsignedInt writer = state.order[i];
+        for(const Write& write: state.passes[writer].writes) {
+            const Attachment& attachment = state.attachments[write.attachment];
+            if(attachment.imported) continue;
+
+            /* Invalidate only from the last writer */
+            bool lastWriter = true;
+            for(std::size_t j = i + 1; j != state.order.size(); ++j)
+                for(const Write& other: state.passes[state.order[j]].writes)
+                    if(other.attachment == write.attachment) lastWriter = false;
+            if(!lastWriter) continue;
+
+            Pass& last = state.passes[state.order[attachment.last]];
+            forEachInvalidationAttachment(write, [&last, writer](Framebuffer::InvalidationAttachment a) {
+                last.invalidateAfter.emplace_back(writer, a);
+            });
+        }
+    }
+    #endif
+
+    state.compiled = true;
+}
+
+void FrameGraph::execute() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.compiled, "FrameGraph::execute(): the graph is not compiled", );
+
+    for(const UnsignedInt id: state.order) {
+        Pass& pass = state.passes[id];
+        if(pass.framebuffer.id()) {
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            if(!pass.invalidateBefore.empty())
+                pass.framebuffer.invalidate(pass.invalidateBefore);
+            #endif
+            pass.framebuffer.bind();
+        }
+
+        if(pass.execute) pass.execute();
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        /* Group the invalidations by framebuffer */
+        for(std::size_t i = 0; i != pass.invalidateAfter.size(); ) {
+            const UnsignedInt writer = pass.invalidateAfter[i].first;
+            state.invalidate.clear();
+            for(; i != pass.invalidateAfter.size() && pass.invalidateAfter[i].first == writer; ++i)
+                state.invalidate.push_back(pass.invalidateAfter[i].second);
+            state.passes[writer].framebuffer.invalidate(state.invalidate);
+        }
+        #endif
+    }
+}
+
+std::size_t FrameGraph::passCount() const { return _state->order.size(); }
+
+std::size_t FrameGraph::culledPassCount() const {
+    return _state->compiled ? _state->passes.size() - _state->order.size() : 0;
+}
+
+std::size_t FrameGraph::textureCount() const { return _state->textures.size(); }
+
+Texture2D& FrameGraph::texture(const UnsignedInt attachment) {
+    CORRADE_ASSERT(_state->compiled && attachment < _state->attachments.size(),
+        "FrameGraph::texture(): the graph is not compiled or attachment" << attachment << "out of range", *static_cast<Texture2D*>(nullptr));
+    Attachment& a = _state->attachments[attachment];
+    if(a.imported) return *a.imported;
+    CORRADE_ASSERT(a.texture != None,
+        "FrameGraph::texture(): attachment" << attachment << "is not used", *static_cast<Texture2D*>(nullptr));
+    return *_state->textures[a.texture].texture;
+}
+
+Framebuffer& FrameGraph::framebuffer(const UnsignedInt pass) {
+    CORRADE_ASSERT(_state->compiled && pass < _state->passes.size() && _state->passes[pass].framebuffer.id(),
+        "FrameGraph::framebuffer(): the graph is not compiled or pass" << pass << "has no framebuffer", *static_cast<Framebuffer*>(nullptr));
+    return _state->passes[pass].framebuffer;
+}
+
+}
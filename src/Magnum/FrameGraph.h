@@ -0,0 +1,240 @@
+#ifndef Magnum_FrameGraph_h
+#define Magnum_FrameGraph_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FrameGraph
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Frame graph
+
+Schedules render passes and manages the textures they render to. Each pass
+declares which attachments it reads and writes, the graph then orders the
+passes, drops the ones that don't contribute to the final image, allocates
+the textures and framebuffers and invalidates attachment contents that are
+not needed anymore.
+
+## Usage
+
+Transient attachments are described by format and size relative to the
+viewport, external textures (e.g. a history buffer that needs to survive to
+the next frame) can be imported. Passes are then added with a callback and
+their inputs and outputs:
+@code
+FrameGraph graph;
+UnsignedInt gbufferColor = graph.addAttachment(TextureFormat::RGBA8);
+UnsignedInt gbufferDepth = graph.addAttachment(TextureFormat::DepthComponent24);
+UnsignedInt halfBlur = graph.addAttachment(TextureFormat::RGBA8, Vector2{0.5f});
+UnsignedInt result = graph.importAttachment(resultTexture, viewport);
+
+UnsignedInt gbuffer = graph.addPass([&]() {
+    graph.framebuffer(gbuffer).clear(FramebufferClear::Color|FramebufferClear::Depth);
+    camera.draw(drawables);
+});
+graph.addWrite(gbuffer, gbufferColor)
+    .addWrite(gbuffer, gbufferDepth);
+
+UnsignedInt blur = graph.addPass([&]() {
+    blurShader.setTexture(graph.texture(gbufferColor));
+    fullScreenTriangle.draw(blurShader);
+});
+graph.addRead(blur, gbufferColor)
+    .addWrite(blur, halfBlur);
+
+UnsignedInt compose = graph.addPass([&]() { ... });
+graph.addRead(compose, gbufferColor)
+    .addRead(compose, halfBlur)
+    .addWrite(compose, result);
+
+graph.compile(viewport);
+@endcode
+
+Then each frame:
+@code
+graph.execute();
+@endcode
+
+@ref compile() needs to be called again only if the graph or the viewport
+size changes. Textures and framebuffers that can be kept are not recreated.
+
+## Scheduling
+
+A pass reading an attachment is executed after all passes writing it, passes
+writing the same attachment are executed in the order they were added. Apart
+from that the order in which the passes were added is preserved. Passes that
+write only to transient attachments that are not read by any other pass are
+culled. Passes writing to an imported attachment or passes with no writes
+(e.g. rendering to @ref DefaultFramebuffer) are always executed.
+
+## Aliasing and invalidation
+
+Transient attachments with the same format and size whose lifetimes don't
+overlap share the same texture, see @ref textureCount(). Before a pass is
+executed, transient attachments written there for the first time are
+invalidated, as their previous contents are never used. After a pass,
+transient attachments that are not used by any later pass are invalidated,
+which saves the memory bandwidth needed to write them back from the tile
+memory on tiled GPUs. See @ref Framebuffer::invalidate() for details.
+
+The pass framebuffer has color attachments attached in the order the writes
+were added, mapped to consecutive draw buffers, and a depth or depth/stencil
+attachment for depth formats. It's bound before the pass callback is called.
+Passes without writes get no framebuffer.
+*/
+class MAGNUM_EXPORT FrameGraph {
+    public:
+        explicit FrameGraph();
+
+        /** @brief Copying is not allowed */
+        FrameGraph(const FrameGraph&) = delete;
+
+        /** @brief Move constructor */
+        FrameGraph(FrameGraph&&) noexcept;
+
+        ~FrameGraph();
+
+        /** @brief Copying is not allowed */
+        FrameGraph& operator=(const FrameGraph&) = delete;
+
+        /** @brief Move assignment */
+        FrameGraph& operator=(FrameGraph&&) noexcept;
+
+        /**
+         * @brief Add transient attachment
+         * @param format            Texture format
+         * @param viewportScale     Size relative to viewport
+         * @return Attachment ID
+         *
+         * The texture is allocated in @ref compile(), with size of the
+         * viewport multiplied by @p viewportScale, but at least one pixel.
+         */
+        UnsignedInt addAttachment(TextureFormat format, const Vector2& viewportScale = Vector2{1.0f});
+
+        /**
+         * @brief Import external attachment
+         * @param texture           Texture
+         * @param size              Texture size
+         * @param format            Texture format, used to decide whether
+         *      the texture is a color or depth attachment
+         * @return Attachment ID
+         *
+         * The texture is never aliased or invalidated and passes writing to
+         * it are never culled. The texture needs to be kept alive for the
+         * whole lifetime of the graph.
+         */
+        UnsignedInt importAttachment(Texture2D& texture, const Vector2i& size, TextureFormat format);
+
+        /**
+         * @brief Add pass
+         * @param execute   Function called when the pass is executed
+         * @return Pass ID
+         */
+        UnsignedInt addPass(std::function<void()> execute);
+
+        /**
+         * @brief Add attachment read by given pass
+         * @return Reference to self (for method chaining)
+         *
+         * The pass is executed after all passes writing to the attachment.
+         * Use @ref texture() in the pass callback to get the texture.
+         */
+        FrameGraph& addRead(UnsignedInt pass, UnsignedInt attachment);
+
+        /**
+         * @brief Add attachment written by given pass
+         * @return Reference to self (for method chaining)
+         *
+         * All attachments written by one pass are expected to have the same
+         * size.
+         */
+        FrameGraph& addWrite(UnsignedInt pass, UnsignedInt attachment);
+
+        /**
+         * @brief Compile the graph
+         *
+         * Orders and culls the passes, allocates the textures and creates
+         * the framebuffers. Expects that there are no circular dependencies
+         * between the passes.
+         */
+        void compile(const Vector2i& viewport);
+
+        /**
+         * @brief Execute the graph
+         *
+         * Expects that @ref compile() was called.
+         */
+        void execute();
+
+        /** @brief Count of passes executed by @ref execute() */
+        std::size_t passCount() const;
+
+        /** @brief Count of culled passes */
+        std::size_t culledPassCount() const;
+
+        /**
+         * @brief Count of allocated textures
+         *
+         * Count of textures backing the transient attachments, lower than
+         * count of transient attachments if some of them are aliased.
+         */
+        std::size_t textureCount() const;
+
+        /**
+         * @brief Attachment texture
+         *
+         * Expects that @ref compile() was called and the attachment is used
+         * by a pass that wasn't culled. Aliased attachments share the same
+         * texture.
+         */
+        Texture2D& texture(UnsignedInt attachment);
+
+        /**
+         * @brief Pass framebuffer
+         *
+         * Expects that @ref compile() was called and the pass writes to at
+         * least one attachment and wasn't culled.
+         */
+        Framebuffer& framebuffer(UnsignedInt pass);
+
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+};
+
+}
+
+#endif
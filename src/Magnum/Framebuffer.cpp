@@ -32,6 +32,7 @@
 #include "Magnum/DefaultFramebuffer.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Image.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Renderbuffer.h"
 #include "Magnum/Texture.h"
 
@@ -154,6 +155,10 @@ Framebuffer::Status Framebuffer::checkStatus(const FramebufferTarget target) {
 }
 
 Framebuffer& Framebuffer::mapForDraw(std::initializer_list<std::pair<UnsignedInt, DrawAttachment>> attachments) {
+    return mapForDraw(Containers::ArrayView<const std::pair<UnsignedInt, DrawAttachment>>{attachments.begin(), attachments.size()});
+}
+
+Framebuffer& Framebuffer::mapForDraw(const Containers::ArrayView<const std::pair<UnsignedInt, DrawAttachment>> attachments) {
     /* Max attachment location */
     std::size_t max = 0;
     for(const auto& attachment: attachments)
@@ -186,10 +191,14 @@ Framebuffer& Framebuffer::mapForRead(const ColorAttachment attachment) {
 }
 
 void Framebuffer::invalidate(std::initializer_list<InvalidationAttachment> attachments) {
+    invalidate(Containers::ArrayView<const InvalidationAttachment>{attachments.begin(), attachments.size()});
+}
+
+void Framebuffer::invalidate(const Containers::ArrayView<const InvalidationAttachment> attachments) {
     /** @todo C++14: use VLA to avoid heap allocation */
     Containers::Array<GLenum> _attachments(attachments.size());
     for(std::size_t i = 0; i != attachments.size(); ++i)
-        _attachments[i] = GLenum(*(attachments.begin()+i));
+        _attachments[i] = GLenum(attachments[i]);
 
     (this->*Context::current().state().framebuffer->invalidateImplementation)(attachments.size(), _attachments);
 }
@@ -203,9 +212,54 @@ void Framebuffer::invalidate(std::initializer_list<InvalidationAttachment> attac
 
     (this->*Context::current().state().framebuffer->invalidateSubImplementation)(attachments.size(), _attachments, rectangle);
 }
+
+Framebuffer& Framebuffer::clearColor(const Int drawBuffer, const Color4& color) {
+    bindInternal(FramebufferTarget::Draw);
+    glClearBufferfv(GL_COLOR, drawBuffer, color.data());
+    return *this;
+}
+
+Framebuffer& Framebuffer::clearColor(const Int drawBuffer, const Vector4i& color) {
+    bindInternal(FramebufferTarget::Draw);
+    glClearBufferiv(GL_COLOR, drawBuffer, color.data());
+    return *this;
+}
+
+Framebuffer& Framebuffer::clearColor(const Int drawBuffer, const Vector4ui& color) {
+    bindInternal(FramebufferTarget::Draw);
+    glClearBufferuiv(GL_COLOR, drawBuffer, color.data());
+    return *this;
+}
 #endif
 #endif
 
+Framebuffer& Framebuffer::setRenderPassPolicy(const FramebufferClearMask clear, const FramebufferClearMask invalidate) {
+    CORRADE_ASSERT(!(invalidate & FramebufferClear::Color),
+        "Framebuffer::setRenderPassPolicy(): only depth and stencil can be invalidated", *this);
+    _renderPassClear = clear;
+    _renderPassInvalidation = invalidate;
+    return *this;
+}
+
+Framebuffer& Framebuffer::beginRenderPass() {
+    bind();
+    if(_renderPassClear) clear(_renderPassClear);
+    return *this;
+}
+
+Framebuffer& Framebuffer::endRenderPass() {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    InvalidationAttachment attachments[]{InvalidationAttachment::Depth, InvalidationAttachment::Stencil};
+    std::size_t count = 0;
+    if(_renderPassInvalidation & FramebufferClear::Depth)
+        attachments[count++] = InvalidationAttachment::Depth;
+    if(_renderPassInvalidation & FramebufferClear::Stencil)
+        attachments[count++] = InvalidationAttachment::Stencil;
+    if(count) invalidate(Containers::ArrayView<const InvalidationAttachment>{attachments, count});
+    #endif
+    return *this;
+}
+
 Framebuffer& Framebuffer::attachRenderbuffer(const BufferAttachment attachment, Renderbuffer& renderbuffer) {
     (this->*Context::current().state().framebuffer->renderbufferImplementation)(attachment, renderbuffer.id());
     return *this;
@@ -223,6 +277,13 @@ Framebuffer& Framebuffer::attachTexture(const BufferAttachment attachment, Textu
     return *this;
 }
 
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+Framebuffer& Framebuffer::attachTextureImplicitResolve(const BufferAttachment attachment, Texture2D& texture, const Int level, const Int samples) {
+    glFramebufferTexture2DMultisampleEXT(GLenum(bindInternal()), GLenum(attachment), GL_TEXTURE_2D, texture.id(), level, samples);
+    return *this;
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 Framebuffer& Framebuffer::attachTexture(const BufferAttachment attachment, RectangleTexture& texture) {
     (this->*Context::current().state().framebuffer->texture2DImplementation)(attachment, GL_TEXTURE_RECTANGLE, texture.id(), 0);
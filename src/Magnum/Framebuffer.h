@@ -480,6 +480,13 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          */
         Framebuffer& mapForDraw(std::initializer_list<std::pair<UnsignedInt, DrawAttachment>> attachments);
 
+        /**
+         * @overload
+         *
+         * Useful when the attachment list is known only at runtime.
+         */
+        Framebuffer& mapForDraw(Containers::ArrayView<const std::pair<UnsignedInt, DrawAttachment>> attachments);
+
         /**
          * @brief Map shader output to attachment
          * @param attachment        Draw attachment
@@ -542,8 +549,73 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          *      1.0.
          */
         void invalidate(std::initializer_list<InvalidationAttachment> attachments);
+
+        /**
+         * @overload
+         *
+         * Useful when the attachment list is known only at runtime.
+         */
+        void invalidate(Containers::ArrayView<const InvalidationAttachment> attachments);
         #endif
 
+        /** @brief Buffers cleared at the beginning of a render pass */
+        FramebufferClearMask renderPassClear() const { return _renderPassClear; }
+
+        /** @brief Buffers invalidated at the end of a render pass */
+        FramebufferClearMask renderPassInvalidation() const { return _renderPassInvalidation; }
+
+        /**
+         * @brief Set render pass policy
+         * @param clear         Buffers to clear in @ref beginRenderPass()
+         * @param invalidate    Buffers to invalidate in @ref endRenderPass()
+         * @return Reference to self (for method chaining)
+         *
+         * Tiled GPUs (common on mobile) render into small on-chip memory and
+         * load the previous framebuffer contents into it at the beginning of
+         * a render pass and write the contents back at the end. Clearing the
+         * buffers right after binding tells the driver that the previous
+         * contents are not needed, invalidating them tells it that the
+         * contents don't need to be written back. For example, the depth
+         * buffer is often needed only while rendering:
+         * @code
+         * framebuffer.setRenderPassPolicy(
+         *     FramebufferClear::Color|FramebufferClear::Depth,
+         *     FramebufferClear::Depth);
+         *
+         * // each frame
+         * framebuffer.beginRenderPass();
+         * // draw ...
+         * framebuffer.endRenderPass();
+         * @endcode
+         *
+         * Only @ref FramebufferClear::Depth and @ref FramebufferClear::Stencil
+         * can be invalidated. Default is to neither clear nor invalidate
+         * anything.
+         * @see @ref invalidate(), @ref clear()
+         */
+        Framebuffer& setRenderPassPolicy(FramebufferClearMask clear, FramebufferClearMask invalidate);
+
+        /**
+         * @brief Begin render pass
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the framebuffer for drawing and clears buffers set by
+         * @ref setRenderPassPolicy(), if any.
+         * @see @ref bind(), @ref clear()
+         */
+        Framebuffer& beginRenderPass();
+
+        /**
+         * @brief End render pass
+         * @return Reference to self (for method chaining)
+         *
+         * Invalidates buffers set by @ref setRenderPassPolicy(), if any.
+         * @see @ref invalidate()
+         * @requires_webgl20 Framebuffer invalidation is not available in
+         *      WebGL 1.0, the function does nothing there.
+         */
+        Framebuffer& endRenderPass();
+
         #ifndef MAGNUM_TARGET_GLES2
         /**
          * @brief Invalidate framebuffer rectangle
@@ -564,6 +636,33 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          *      1.0.
          */
         void invalidate(std::initializer_list<InvalidationAttachment> attachments, const Range2Di& rectangle);
+
+        /**
+         * @brief Clear color buffer to given value
+         * @param drawBuffer        Shader output mapped to the buffer using
+         *      @ref mapForDraw()
+         * @param color             Value to clear with
+         * @return Reference to self (for method chaining)
+         *
+         * Unlike @ref clear(), which uses @ref Renderer::setClearColor() for
+         * all color buffers, clears only one buffer. Integer buffers can't
+         * be cleared with @ref clear(), use the
+         * @ref clearColor(Int, const Vector4i&) or
+         * @ref clearColor(Int, const Vector4ui&) overload for them, for
+         * example when clearing object ID buffer used for picking. The
+         * framebuffer is bound before the operation (if not already).
+         * @see @fn_gl{BindFramebuffer}, @fn_gl{ClearBuffer}
+         * @requires_gl30 Extension @extension{EXT,texture_integer}
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL 1.0.
+         */
+        Framebuffer& clearColor(Int drawBuffer, const Color4& color);
+
+        /** @overload */
+        Framebuffer& clearColor(Int drawBuffer, const Vector4i& color);
+
+        /** @overload */
+        Framebuffer& clearColor(Int drawBuffer, const Vector4ui& color);
         #endif
 
         /**
@@ -628,6 +727,32 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          */
         Framebuffer& attachTexture(BufferAttachment attachment, Texture2D& texture, Int level);
 
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Attach texture to given buffer with implicit multisample resolve
+         * @param attachment        Buffer attachment
+         * @param texture           Texture
+         * @param level             Mip level
+         * @param samples           Sample count
+         * @return Reference to self (for method chaining)
+         *
+         * Rendering happens with @p samples samples per pixel in on-chip tile
+         * memory and the result is resolved into @p texture when the tile is
+         * flushed, avoiding both the separate multisample storage and the
+         * bandwidth of an explicit @ref blit(). Depth and stencil attachments
+         * of the same framebuffer should be created with
+         * @ref Renderbuffer::setStorageMultisampleImplicitResolve() with the
+         * same sample count. The framebuffer is bound before the operation
+         * (if not already).
+         * @see @ref MultisampleFramebuffer, @fn_gl{BindFramebuffer},
+         *      @fn_gl_extension{FramebufferTexture2DMultisample,EXT,multisampled_render_to_texture}
+         * @requires_es_extension Extension @es_extension{EXT,multisampled_render_to_texture}
+         * @requires_gles Not available in desktop OpenGL or WebGL, attach
+         *      a multisample @ref Renderbuffer and @ref blit() instead.
+         */
+        Framebuffer& attachTextureImplicitResolve(BufferAttachment attachment, Texture2D& texture, Int level, Int samples);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /** @overload
          * @requires_gl31 Extension @extension{ARB,texture_rectangle}
@@ -885,6 +1010,8 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
         void MAGNUM_LOCAL textureLayerImplementationDSA(BufferAttachment attachment, GLuint textureId, GLint level, GLint layer);
         void MAGNUM_LOCAL textureLayerImplementationDSAEXT(BufferAttachment attachment, GLuint textureId, GLint level, GLint layer);
         #endif
+
+        FramebufferClearMask _renderPassClear, _renderPassInvalidation;
 };
 
 /** @debugoperatorclassenum{Magnum::Framebuffer,Magnum::Framebuffer::Status} */
@@ -894,6 +1021,8 @@ inline Framebuffer::Framebuffer(Framebuffer&& other) noexcept {
     _id = other._id;
     _viewport = other._viewport;
     _flags = other._flags;
+    _renderPassClear = other._renderPassClear;
+    _renderPassInvalidation = other._renderPassInvalidation;
     other._id = 0;
     other._viewport = {};
 }
@@ -903,6 +1032,8 @@ inline Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept {
     swap(_id, other._id);
     swap(_viewport, other._viewport);
     swap(_flags, other._flags);
+    swap(_renderPassClear, other._renderPassClear);
+    swap(_renderPassInvalidation, other._renderPassInvalidation);
     return *this;
 }
 
@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramebufferReader.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+
+namespace Magnum {
+
+FramebufferReader::Slot::Slot(): image{PixelFormat::RGBA, PixelType::UnsignedByte}, fence{}, pending{false} {}
+
+FramebufferReader::FramebufferReader(const UnsignedInt slotCount): _next{0} {
+    CORRADE_ASSERT(slotCount, "FramebufferReader::FramebufferReader(): slot count must be positive", );
+    _slots.reserve(slotCount);
+    for(UnsignedInt i = 0; i != slotCount; ++i) _slots.emplace_back();
+}
+
+FramebufferReader::~FramebufferReader() {
+    for(Slot& slot: _slots) deleteFence(slot);
+}
+
+UnsignedInt FramebufferReader::pendingCount() const {
+    return std::count_if(_slots.begin(), _slots.end(), [](const Slot& slot) { return slot.pending; });
+}
+
+UnsignedInt FramebufferReader::read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const BufferImage2D& image) {
+    /* Find a free slot, starting after the last used one so the slots are
+       used in a round-robin fashion */
+    UnsignedInt slot = _next;
+    for(UnsignedInt i = 0; i != _slots.size() && _slots[slot].pending; ++i)
+        slot = (slot + 1) % _slots.size();
+    CORRADE_ASSERT(!_slots[slot].pending,
+        "FramebufferReader::read(): all" << _slots.size() << "slots are pending, retrieve or discard some first", {});
+    _next = (slot + 1) % _slots.size();
+
+    /* Update the image properties but keep the buffer, the framebuffer read
+       reallocates it only if it's too small */
+    Slot& s = _slots[slot];
+    s.image.setData(image.storage(), image.format(), image.type(), {}, nullptr, BufferUsage::StreamRead);
+    framebuffer.read(rectangle, s.image, BufferUsage::StreamRead);
+
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s.pending = true;
+    return slot;
+}
+
+UnsignedInt FramebufferReader::read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const PixelFormat format, const PixelType type) {
+    return read(framebuffer, rectangle, BufferImage2D{format, type});
+}
+
+bool FramebufferReader::isReady(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "FramebufferReader::isReady(): slot" << slot << "is not pending", false);
+
+    Slot& s = _slots[slot];
+    if(!s.fence) return true;
+
+    /* Flush the commands so the fence eventually gets signaled even if
+       nothing else is submitted */
+    if(glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    deleteFence(s);
+    return true;
+}
+
+BufferImage2D& FramebufferReader::image(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "FramebufferReader::image(): slot" << slot << "is not pending", _slots[0].image);
+    return _slots[slot].image;
+}
+
+Image2D FramebufferReader::retrieve(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "FramebufferReader::retrieve(): slot" << slot << "is not pending", (Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+
+    Slot& s = _slots[slot];
+    if(s.fence) {
+        while(glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+        deleteFence(s);
+    }
+
+    const std::size_t dataSize = Implementation::imageDataSize(s.image);
+    Containers::Array<char> data{dataSize};
+    if(dataSize) {
+        const char* const mapped = s.image.buffer().map<char>(0, dataSize, Buffer::MapFlag::Read);
+        CORRADE_INTERNAL_ASSERT(mapped);
+        std::copy_n(mapped, dataSize, data.begin());
+        s.image.buffer().unmap();
+    }
+
+    s.pending = false;
+    return Image2D{s.image.storage(), s.image.format(), s.image.type(), s.image.size(), std::move(data)};
+}
+
+void FramebufferReader::discard(const UnsignedInt slot) {
+    CORRADE_ASSERT(slot < _slots.size() && _slots[slot].pending,
+        "FramebufferReader::discard(): slot" << slot << "is not pending", );
+    deleteFence(_slots[slot]);
+    _slots[slot].pending = false;
+}
+
+void FramebufferReader::deleteFence(Slot& slot) {
+    if(!slot.fence) return;
+    glDeleteSync(slot.fence);
+    slot.fence = {};
+}
+
+}
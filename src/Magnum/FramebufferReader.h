@@ -0,0 +1,186 @@
+#ifndef Magnum_FramebufferReader_h
+#define Magnum_FramebufferReader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::FramebufferReader
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/BufferImage.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Asynchronous framebuffer reader
+
+Reads framebuffer contents into a ring of pixel pack buffers without waiting
+for the GPU. The result can be retrieved a frame or two later, when the read
+is finished, without stalling the pipeline.
+
+## Usage
+
+Start the read using @ref read(), which returns a slot index, and later check
+with @ref isReady() whether it's finished:
+@code
+FramebufferReader reader{3};
+
+// each frame, after rendering
+pending.push_back(reader.read(framebuffer, framebuffer.viewport(), {PixelFormat::RGBA, PixelType::UnsignedByte}));
+
+while(!pending.empty() && reader.isReady(pending.front())) {
+    Image2D image = reader.retrieve(pending.front());
+    encodeFrame(image);
+    pending.pop_front();
+}
+@endcode
+
+Each read is followed by a fence sync object, @ref isReady() only checks
+whether the fence is signaled. The slot is reused only after its result is
+retrieved with @ref retrieve() or discarded with @ref discard(), so the slot
+count limits how many reads can be in flight.
+
+@see @ref AbstractFramebuffer::read(const Range2Di&, BufferImage2D&, BufferUsage)
+@requires_gles30 Pixel pack buffers are not available in OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_EXPORT FramebufferReader {
+    public:
+        /**
+         * @brief Constructor
+         * @param slotCount     Slot count
+         *
+         * The buffers are allocated on first read into given slot.
+         */
+        explicit FramebufferReader(UnsignedInt slotCount = 3);
+
+        /** @brief Copying is not allowed */
+        FramebufferReader(const FramebufferReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        FramebufferReader(FramebufferReader&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fence sync objects and the buffers.
+         */
+        ~FramebufferReader();
+
+        /** @brief Copying is not allowed */
+        FramebufferReader& operator=(const FramebufferReader&) = delete;
+
+        /** @brief Moving is not allowed */
+        FramebufferReader& operator=(FramebufferReader&&) = delete;
+
+        /** @brief Slot count */
+        UnsignedInt slotCount() const { return _slots.size(); }
+
+        /** @brief Count of reads that weren't retrieved yet */
+        UnsignedInt pendingCount() const;
+
+        /**
+         * @brief Start reading a block of pixels from framebuffer
+         * @param framebuffer   Framebuffer to read from
+         * @param rectangle     Framebuffer rectangle to read
+         * @param image         Image specifying storage, format and type of
+         *      the data. Only the properties are used, the image isn't
+         *      modified.
+         * @return Slot index to pass to @ref isReady() and @ref retrieve()
+         *
+         * Expects that there is a free slot, i.e. that less than
+         * @ref slotCount() reads are pending. The buffer in given slot is
+         * reallocated only if it's too small for the data.
+         * @see @ref AbstractFramebuffer::read(), @fn_gl{FenceSync}
+         */
+        UnsignedInt read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const BufferImage2D& image);
+
+        /** @overload
+         * Uses default @ref PixelStorage parameters.
+         */
+        UnsignedInt read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, PixelFormat format, PixelType type);
+
+        /**
+         * @brief Whether the read in given slot is finished
+         *
+         * Never waits for the read to finish.
+         * @see @fn_gl{ClientWaitSync}
+         */
+        bool isReady(UnsignedInt slot);
+
+        /**
+         * @brief Buffer image in given slot
+         *
+         * Allows to access the data without copying them, e.g. by mapping
+         * the buffer. Expects that the read in given slot wasn't retrieved
+         * or discarded yet. The data are complete only after @ref isReady()
+         * returns `true` for given slot.
+         */
+        BufferImage2D& image(UnsignedInt slot);
+
+        /**
+         * @brief Retrieve the result of read in given slot
+         *
+         * Waits for the read to finish if it isn't already, maps the buffer
+         * and copies the data to returned image. The slot is then free for
+         * another read. Expects that the read in given slot wasn't retrieved
+         * or discarded yet.
+         * @see @ref isReady(), @ref Buffer::map()
+         */
+        Image2D retrieve(UnsignedInt slot);
+
+        /**
+         * @brief Discard the read in given slot
+         *
+         * Frees the slot without retrieving the data.
+         */
+        void discard(UnsignedInt slot);
+
+    private:
+        struct Slot {
+            explicit Slot();
+
+            BufferImage2D image;
+            GLsync fence;
+            bool pending;
+        };
+
+        void MAGNUM_LOCAL deleteFence(Slot& slot);
+
+        std::vector<Slot> _slots;
+        UnsignedInt _next;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
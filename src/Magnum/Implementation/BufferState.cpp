@@ -51,7 +51,8 @@ const Buffer::TargetHint BufferState::targetForIndex[] = {
     Buffer::TargetHint::ShaderStorage,
     #endif
     #ifndef MAGNUM_TARGET_GLES
-    Buffer::TargetHint::Texture
+    Buffer::TargetHint::Texture,
+    Buffer::TargetHint::Parameter
     #endif
     #endif
 };
@@ -75,6 +76,7 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
         #endif
         #ifndef MAGNUM_TARGET_GLES
         case Buffer::TargetHint::Texture:           return 13;
+        case Buffer::TargetHint::Parameter:         return 14;
         #endif
         #endif
     }
@@ -85,7 +87,7 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
 BufferState::BufferState(Context& context, std::vector<std::string>& extensions): bindings()
     #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_GLES
-    , minMapAlignment(0)
+    , minMapAlignment(0), sparsePageSize(0)
     #endif
     #ifndef MAGNUM_TARGET_WEBGL
     , maxAtomicCounterBindings{0}, maxShaderStorageBindings{0}, shaderStorageOffsetAlignment{0}
@@ -113,6 +115,8 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getParameterImplementation = &Buffer::getParameterImplementationDSA;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSA;
         dataImplementation = &Buffer::dataImplementationDSA;
+        storageImplementation = &Buffer::storageImplementationDSA;
+        pageCommitmentImplementation = &Buffer::pageCommitmentImplementationDSA;
         subDataImplementation = &Buffer::subDataImplementationDSA;
         mapImplementation = &Buffer::mapImplementationDSA;
         mapRangeImplementation = &Buffer::mapRangeImplementationDSA;
@@ -125,6 +129,8 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getParameterImplementation = &Buffer::getParameterImplementationDSAEXT;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSAEXT;
         dataImplementation = &Buffer::dataImplementationDSAEXT;
+        storageImplementation = &Buffer::storageImplementationDSAEXT;
+        pageCommitmentImplementation = &Buffer::pageCommitmentImplementationDSAEXT;
         subDataImplementation = &Buffer::subDataImplementationDSAEXT;
         mapImplementation = &Buffer::mapImplementationDSAEXT;
         mapRangeImplementation = &Buffer::mapRangeImplementationDSAEXT;
@@ -141,6 +147,10 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getSubDataImplementation = &Buffer::getSubDataImplementationDefault;
         #endif
         dataImplementation = &Buffer::dataImplementationDefault;
+        #ifndef MAGNUM_TARGET_GLES
+        storageImplementation = &Buffer::storageImplementationDefault;
+        pageCommitmentImplementation = &Buffer::pageCommitmentImplementationDefault;
+        #endif
         subDataImplementation = &Buffer::subDataImplementationDefault;
         #ifndef MAGNUM_TARGET_WEBGL
         mapImplementation = &Buffer::mapImplementationDefault;
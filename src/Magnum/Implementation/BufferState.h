@@ -32,7 +32,7 @@ namespace Magnum { namespace Implementation {
 struct BufferState {
     enum: std::size_t {
         #ifndef MAGNUM_TARGET_GLES
-        TargetCount = 13+1
+        TargetCount = 14+1
         #elif !defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 8+1
         #elif !defined(MAGNUM_TARGET_GLES2)
@@ -61,6 +61,10 @@ struct BufferState {
     void(Buffer::*getSubDataImplementation)(GLintptr, GLsizeiptr, GLvoid*);
     #endif
     void(Buffer::*dataImplementation)(GLsizeiptr, const GLvoid*, BufferUsage);
+    #ifndef MAGNUM_TARGET_GLES
+    void(Buffer::*storageImplementation)(GLsizeiptr, const GLvoid*, Buffer::StorageFlags);
+    void(Buffer::*pageCommitmentImplementation)(GLintptr, GLsizeiptr, GLboolean);
+    #endif
     void(Buffer::*subDataImplementation)(GLintptr, GLsizeiptr, const GLvoid*);
     void(Buffer::*invalidateImplementation)();
     void(Buffer::*invalidateSubImplementation)(GLintptr, GLsizeiptr);
@@ -79,6 +83,7 @@ struct BufferState {
     GLint
         #ifndef MAGNUM_TARGET_GLES
         minMapAlignment,
+        sparsePageSize,
         #endif
         #ifndef MAGNUM_TARGET_WEBGL
         maxAtomicCounterBindings,
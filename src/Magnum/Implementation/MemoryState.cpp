@@ -0,0 +1,344 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryState.h"
+
+#include <algorithm>
+
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Implementation {
+
+UnsignedInt MemoryState::formatBits(const GLenum internalFormat) {
+    switch(TextureFormat(internalFormat)) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::R8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8UI:
+        case TextureFormat::R8I:
+        #else
+        case TextureFormat::Luminance:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R3B3G2:
+        case TextureFormat::RGBA2:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::StencilIndex8:
+        #endif
+            return 8;
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RG8:
+        case TextureFormat::DepthComponent16:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::RG8UI:
+        case TextureFormat::RG8I:
+        case TextureFormat::R16UI:
+        case TextureFormat::R16I:
+        case TextureFormat::R16F:
+        #else
+        case TextureFormat::LuminanceAlpha:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R16:
+        case TextureFormat::R16Snorm:
+        case TextureFormat::RGB4:
+        case TextureFormat::RGB5:
+        #endif
+        case TextureFormat::RGB565:
+        case TextureFormat::RGBA4:
+        case TextureFormat::RGB5A1:
+            return 16;
+
+        /* Three-component formats are usually padded to four components */
+        case TextureFormat::RGB:
+        case TextureFormat::RGBA:
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGB8:
+        case TextureFormat::RGBA8:
+        case TextureFormat::RGB10A2:
+        case TextureFormat::DepthComponent24:
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGB:
+        case TextureFormat::SRGBAlpha:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || (defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL))
+        case TextureFormat::RGB10:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB8Snorm:
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGB8UI:
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::RGB8I:
+        case TextureFormat::RGBA8I:
+        case TextureFormat::RG16UI:
+        case TextureFormat::RG16I:
+        case TextureFormat::RG16F:
+        case TextureFormat::R32UI:
+        case TextureFormat::R32I:
+        case TextureFormat::R32F:
+        case TextureFormat::R11FG11FB10F:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::SRGB8:
+        case TextureFormat::RGB10A2UI:
+        case TextureFormat::SRGB8Alpha8:
+        case TextureFormat::DepthComponent32F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RG16:
+        case TextureFormat::RG16Snorm:
+        #endif
+            return 32;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB16UI:
+        case TextureFormat::RGBA16UI:
+        case TextureFormat::RGB16I:
+        case TextureFormat::RGBA16I:
+        case TextureFormat::RGB16F:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32UI:
+        case TextureFormat::RG32I:
+        case TextureFormat::RG32F:
+        case TextureFormat::Depth32FStencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGB16:
+        case TextureFormat::RGBA16:
+        case TextureFormat::RGB16Snorm:
+        case TextureFormat::RGBA16Snorm:
+        case TextureFormat::RGB12:
+        case TextureFormat::RGBA12:
+        #endif
+            return 64;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB32UI:
+        case TextureFormat::RGBA32UI:
+        case TextureFormat::RGB32I:
+        case TextureFormat::RGBA32I:
+        case TextureFormat::RGB32F:
+        case TextureFormat::RGBA32F:
+            return 128;
+        #endif
+
+        /* Compressed formats with 64-bit 4x4 blocks */
+        case TextureFormat::CompressedRGBS3tcDxt1:
+        case TextureFormat::CompressedRGBAS3tcDxt1:
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRedRgtc1:
+        case TextureFormat::CompressedSignedRedRgtc1:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGB8Etc2:
+        case TextureFormat::CompressedSRGB8Etc2:
+        case TextureFormat::CompressedRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedSRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedR11Eac:
+        case TextureFormat::CompressedSignedR11Eac:
+        #endif
+            return 4;
+
+        /* Compressed formats with 128-bit 4x4 blocks */
+        case TextureFormat::CompressedRGBAS3tcDxt3:
+        case TextureFormat::CompressedRGBAS3tcDxt5:
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRGRgtc2:
+        case TextureFormat::CompressedSignedRGRgtc2:
+        case TextureFormat::CompressedRGBBptcUnsignedFloat:
+        case TextureFormat::CompressedRGBBptcSignedFloat:
+        case TextureFormat::CompressedRGBABptcUnorm:
+        case TextureFormat::CompressedSRGBAlphaBptcUnorm:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGBA8Etc2Eac:
+        case TextureFormat::CompressedSRGB8Alpha8Etc2Eac:
+        case TextureFormat::CompressedRG11Eac:
+        case TextureFormat::CompressedSignedRG11Eac:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::CompressedRGBAAstc4x4:
+        case TextureFormat::CompressedSRGB8Alpha8Astc4x4:
+        #endif
+            return 8;
+
+        /* ASTC has always 128-bit blocks of varying size, round up */
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::CompressedRGBAAstc5x4:
+        case TextureFormat::CompressedSRGB8Alpha8Astc5x4:
+            return 7;
+        case TextureFormat::CompressedRGBAAstc5x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc5x5:
+            return 6;
+        case TextureFormat::CompressedRGBAAstc6x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc6x5:
+            return 5;
+        case TextureFormat::CompressedRGBAAstc6x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc6x6:
+        case TextureFormat::CompressedRGBAAstc8x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x5:
+            return 4;
+        case TextureFormat::CompressedRGBAAstc8x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x6:
+        case TextureFormat::CompressedRGBAAstc10x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x5:
+        case TextureFormat::CompressedRGBAAstc10x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x6:
+            return 3;
+        case TextureFormat::CompressedRGBAAstc8x8:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x8:
+        case TextureFormat::CompressedRGBAAstc10x8:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x8:
+        case TextureFormat::CompressedRGBAAstc10x10:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x10:
+        case TextureFormat::CompressedRGBAAstc12x10:
+        case TextureFormat::CompressedSRGB8Alpha8Astc12x10:
+            return 2;
+        case TextureFormat::CompressedRGBAAstc12x12:
+        case TextureFormat::CompressedSRGB8Alpha8Astc12x12:
+            return 1;
+        #endif
+
+        /* Generic compressed formats, renderbuffer-only formats etc. */
+        default: break;
+    }
+
+    return 32;
+}
+
+std::size_t MemoryState::textureStorageSize(const GLenum target, const GLenum internalFormat, const Int levels, const Vector3i& size) {
+    /* Array layers are not downsampled, cube maps have six faces */
+    bool arrayY = false, arrayZ = false;
+    std::size_t faceCount = 1;
+    switch(target) {
+        #ifndef MAGNUM_TARGET_GLES
+        case GL_TEXTURE_1D_ARRAY:
+            arrayY = true;
+            break;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case GL_TEXTURE_2D_ARRAY:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        #ifndef MAGNUM_TARGET_GLES
+        case GL_TEXTURE_CUBE_MAP_ARRAY:
+        #else
+        case GL_TEXTURE_CUBE_MAP_ARRAY_EXT:
+        #endif
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+            arrayZ = true;
+            break;
+        #endif
+        case GL_TEXTURE_CUBE_MAP:
+            faceCount = 6;
+            break;
+    }
+
+    const std::size_t bits = formatBits(internalFormat);
+    Vector3i levelSize = size;
+    std::size_t byteCount = 0;
+    for(Int level = 0; level != levels; ++level) {
+        byteCount += (std::size_t(levelSize.x())*levelSize.y()*levelSize.z()*bits + 7)/8;
+
+        levelSize.x() = std::max(levelSize.x()/2, 1);
+        if(!arrayY) levelSize.y() = std::max(levelSize.y()/2, 1);
+        if(!arrayZ) levelSize.z() = std::max(levelSize.z()/2, 1);
+    }
+
+    return byteCount*faceCount;
+}
+
+void MemoryState::setEnabled(const bool enabled) {
+    this->enabled = enabled;
+
+    /* Forget everything, as the info would be incomplete after reenabling */
+    for(std::size_t i = 0; i != TypeCount; ++i) {
+        objects[i].clear();
+        images[i].clear();
+        byteCount[i] = 0;
+    }
+}
+
+void MemoryState::created(const Context::MemoryObject type, const GLuint id) {
+    if(!enabled) return;
+
+    objects[UnsignedInt(type)].insert(id);
+}
+
+void MemoryState::destroyed(const Context::MemoryObject type, const GLuint id) {
+    if(!enabled) return;
+
+    objects[UnsignedInt(type)].erase(id);
+    eraseImages(type, id);
+}
+
+void MemoryState::eraseImages(const Context::MemoryObject type, const GLuint id) {
+    /* Images of given object are sorted together */
+    auto& typeImages = images[UnsignedInt(type)];
+    const auto begin = typeImages.lower_bound({id, 0});
+    const auto end = typeImages.upper_bound({id, AllImages});
+    for(auto it = begin; it != end; ++it)
+        byteCount[UnsignedInt(type)] -= it->second;
+    typeImages.erase(begin, end);
+}
+
+void MemoryState::setImageSize(const Context::MemoryObject type, const GLuint id, const UnsignedLong image, const std::size_t size) {
+    if(!enabled) return;
+
+    /* Objects created before the tracking was enabled are counted since
+       their first allocation */
+    objects[UnsignedInt(type)].insert(id);
+
+    std::size_t& imageSize = images[UnsignedInt(type)][{id, image}];
+    byteCount[UnsignedInt(type)] += size;
+    byteCount[UnsignedInt(type)] -= imageSize;
+    imageSize = size;
+}
+
+void MemoryState::setStorageSize(const Context::MemoryObject type, const GLuint id, const std::size_t size) {
+    if(!enabled) return;
+
+    /* Storage fallback implementations might have already tracked the
+       images one by one */
+    eraseImages(type, id);
+    setImageSize(type, id, AllImages, size);
+}
+
+}}
@@ -0,0 +1,70 @@
+#ifndef Magnum_Implementation_MemoryState_h
+#define Magnum_Implementation_MemoryState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <map>
+#include <unordered_set>
+
+#include "Magnum/Context.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Opt-in accounting of memory allocated by GL objects. Each object can have
+   more than one image (e.g. texture levels or cube map faces), replacing an
+   image replaces its previously tracked size. */
+struct MemoryState {
+    enum: std::size_t { TypeCount = 3 };
+
+    /* Image ID used for immutable storage covering all images at once */
+    enum: UnsignedLong { AllImages = ~UnsignedLong{} };
+
+    /* Estimated size of one pixel of given internal format in bits. Block
+       compressed formats report the average over the block. */
+    static UnsignedInt formatBits(GLenum internalFormat);
+
+    /* Estimated size of given texture storage, including all mip levels */
+    static std::size_t textureStorageSize(GLenum target, GLenum internalFormat, Int levels, const Vector3i& size);
+
+    void setEnabled(bool enabled);
+
+    void created(Context::MemoryObject type, GLuint id);
+    void destroyed(Context::MemoryObject type, GLuint id);
+    void setImageSize(Context::MemoryObject type, GLuint id, UnsignedLong image, std::size_t size);
+
+    /* Replaces all previously tracked images of given object */
+    void setStorageSize(Context::MemoryObject type, GLuint id, std::size_t size);
+    void eraseImages(Context::MemoryObject type, GLuint id);
+
+    bool enabled{};
+    std::array<std::unordered_set<GLuint>, TypeCount> objects;
+    std::array<std::map<std::pair<GLuint, UnsignedLong>, std::size_t>, TypeCount> images;
+    std::array<std::size_t, TypeCount> byteCount{};
+};
+
+}}
+
+#endif
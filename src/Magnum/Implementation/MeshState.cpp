@@ -34,6 +34,9 @@
 namespace Magnum { namespace Implementation {
 
 MeshState::MeshState(Context& context, std::vector<std::string>& extensions): currentVAO(0)
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    , bindCount{0}
+    #endif
     #ifndef MAGNUM_TARGET_GLES2
     , maxElementIndex{0}, maxElementsIndices{0}, maxElementsVertices{0}
     #endif
@@ -57,17 +60,23 @@ MeshState::MeshState(Context& context, std::vector<std::string>& extensions): cu
         destroyImplementation = &Mesh::destroyImplementationVAO;
 
         #ifndef MAGNUM_TARGET_GLES
-        if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>()) {
+        if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>()) {
+            /* Extension added below */
+
+            attributePointerImplementation = &Mesh::attributePointerImplementationDSA;
+            bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationDSA;
+        } else if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>()) {
             extensions.push_back(Extensions::GL::EXT::direct_state_access::string());
 
             attributePointerImplementation = &Mesh::attributePointerImplementationDSAEXT;
+            bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationVAO;
         } else
         #endif
         {
             attributePointerImplementation = &Mesh::attributePointerImplementationVAO;
+            bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationVAO;
         }
 
-        bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationVAO;
         bindImplementation = &Mesh::bindImplementationVAO;
         unbindImplementation = &Mesh::unbindImplementationVAO;
     }
@@ -83,13 +92,33 @@ MeshState::MeshState(Context& context, std::vector<std::string>& extensions): cu
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
-    /* DSA create implementation (other cases handled above) */
+    /* DSA create implementation (other cases handled above). Attribute
+       pointer and index buffer DSA implementations are selected in the VAO
+       branch, as ARB_direct_state_access implies ARB_vertex_array_object. */
     if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>()) {
         extensions.push_back(Extensions::GL::ARB::direct_state_access::string());
         createImplementation = &Mesh::createImplementationVAODSA;
     }
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Separate attribute format implementation */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>()) {
+        /* Extension added above */
+
+        vertexFormatImplementation = &Mesh::vertexFormatImplementationDSA;
+        vertexBindingDivisorImplementation = &Mesh::vertexBindingDivisorImplementationDSA;
+        bindVertexBufferImplementation = &Mesh::bindVertexBufferImplementationDSA;
+    } else
+    #endif
+    {
+        vertexFormatImplementation = &Mesh::vertexFormatImplementationDefault;
+        vertexBindingDivisorImplementation = &Mesh::vertexBindingDivisorImplementationDefault;
+        bindVertexBufferImplementation = &Mesh::bindVertexBufferImplementationDefault;
+    }
+    #endif
+
     #ifdef MAGNUM_TARGET_GLES
     #ifndef MAGNUM_TARGET_WEBGL
     /* Multi draw implementation on ES */
@@ -132,8 +161,11 @@ MeshState::MeshState(Context& context, std::vector<std::string>& extensions): cu
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
-    /* Partial EXT_DSA implementation of vertex attrib divisor */
-    if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>()) {
+    /* DSA implementation of vertex attrib divisor, EXT_DSA has it only
+       partially */
+    if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>())
+        vertexAttribDivisorImplementation = &Mesh::vertexAttribDivisorImplementationDSA;
+    else if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>()) {
         if(glVertexArrayVertexAttribDivisorEXT)
             vertexAttribDivisorImplementation = &Mesh::vertexAttribDivisorImplementationDSAEXT;
         else vertexAttribDivisorImplementation = &Mesh::vertexAttribDivisorImplementationVAO;
@@ -163,6 +195,13 @@ MeshState::MeshState(Context& context, std::vector<std::string>& extensions): cu
 
 void MeshState::reset() {
     currentVAO = State::DisengagedBinding;
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    for(VertexAttribute& attribute: vertexAttributes) {
+        attribute.buffer = 0;
+        attribute.enabled = -1;
+    }
+    #endif
 }
 
 }}
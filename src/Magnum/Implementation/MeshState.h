@@ -44,6 +44,11 @@ struct MeshState {
     void(Mesh::*vertexAttribDivisorImplementation)(GLuint, GLuint);
     #endif
     void(Mesh::*bindIndexBufferImplementation)(Buffer&);
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void(Mesh::*vertexFormatImplementation)(GLuint, GLuint, GLint, GLenum, Mesh::AttributeKind, GLuint);
+    void(Mesh::*vertexBindingDivisorImplementation)(GLuint, GLuint);
+    void(Mesh::*bindVertexBufferImplementation)(GLuint, GLuint, GLintptr, GLsizei);
+    #endif
     void(Mesh::*bindImplementation)();
     void(Mesh::*unbindImplementation)();
 
@@ -57,6 +62,25 @@ struct MeshState {
     #endif
 
     GLuint currentVAO;
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    /* Shadow of the default vertex array state, used if vertex array objects
+       are not available so switching meshes needs to touch only the
+       attributes that actually differ. Indexed by attribute location, grown
+       on demand. Zero buffer ID means the pointer is not known. */
+    struct VertexAttribute {
+        GLuint buffer{}, divisor{};
+        GLint size{};
+        GLenum type{};
+        Mesh::AttributeKind kind{};
+        GLintptr offset{};
+        GLsizei stride{};
+        Byte enabled{-1}; /* -1 if not known */
+        UnsignedInt bindCount{}; /* Last bind in which it was used */
+    };
+    std::vector<VertexAttribute> vertexAttributes;
+    UnsignedInt bindCount;
+    #endif
     #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_WEBGL
     GLint64 maxElementIndex;
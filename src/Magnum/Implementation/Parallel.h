@@ -0,0 +1,91 @@
+#ifndef Magnum_Implementation_Parallel_h
+#define Magnum_Implementation_Parallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include "Magnum/TaskScheduler.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Runs given function for [begin, end) subranges of [0, count), one for each
+   of given count of threads, on the global task scheduler. Thread count of
+   `0` means all workers of the scheduler plus the calling thread. */
+template<class F> void parallelFor(const std::size_t count, UnsignedInt threadCount, F function) {
+    if(!threadCount) threadCount = TaskScheduler::global().workerCount() + 1;
+    if(threadCount == 1 || count < 2) {
+        function(0, count);
+        return;
+    }
+
+    TaskScheduler::global().parallelFor(count, (count + threadCount - 1)/threadCount, function);
+}
+
+/* Calls `f(i)` for all `i` in `[0, count)`, the scheduler balances chunks of
+   the range among its workers. Thread count of `0` means all workers of the
+   scheduler, otherwise the chunks are made larger so at most given count of
+   threads is busy. */
+template<class F> void parallelForEach(const std::size_t count, const UnsignedInt threadCount, F f) {
+    enum: std::size_t { ChunkSize = 256 };
+
+    if(threadCount == 1 || count <= ChunkSize) {
+        for(std::size_t i = 0; i != count; ++i) f(i);
+        return;
+    }
+
+    const std::size_t chunkSize = threadCount ? std::max(std::size_t(ChunkSize), (count + threadCount - 1)/threadCount) : std::size_t(ChunkSize);
+    TaskScheduler::global().parallelFor(count, chunkSize, [&f](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) f(i);
+    });
+}
+
+/* Splits `[0, count)` into consecutive chunks, one for each thread of the
+   global task scheduler. Arrays smaller than two minimal chunks are processed
+   in a single chunk, as distributing the work would take longer than the
+   processing itself. Chunk size is a multiple of 16 so the vector loops don't
+   end up with a scalar tail in every chunk. */
+inline std::size_t chunkSize(const std::size_t count, const std::size_t minChunkSize) {
+    const std::size_t threadCount = std::min(std::size_t(TaskScheduler::global().workerCount() + 1), count/minChunkSize);
+    if(threadCount > 1) return (count/threadCount + 15) & ~std::size_t{15};
+
+    return std::max(count, std::size_t{1});
+}
+
+/* Calls `f(chunk, begin, end)` for all chunks of given size */
+template<class F> void parallelChunks(const std::size_t count, const std::size_t chunkSize, F f) {
+    if(count > chunkSize) {
+        TaskScheduler::global().parallelFor(count, chunkSize, [&f, chunkSize](const std::size_t begin, const std::size_t end) {
+            f(begin/chunkSize, begin, end);
+        });
+        return;
+    }
+
+    f(0, 0, count);
+}
+
+}}
+
+#endif
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "Magnum/Renderer.h"
+#include "Magnum/RenderState.h"
 #include "Magnum/Math/Vector3.h"
 #include "MagnumExternal/Optional/optional.hpp"
 
@@ -73,6 +74,9 @@ struct RendererState {
     };
 
     PixelStorage packPixelStorage, unpackPixelStorage;
+
+    /* Shadow copy of the fixed-function state, empty when unknown */
+    RenderState shadow;
 };
 
 }}
@@ -33,7 +33,7 @@
 
 namespace Magnum { namespace Implementation {
 
-ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string>& extensions): current(0), maxVertexAttributes(0)
+ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string>& extensions): current(0), uniformCacheGeneration(0), maxVertexAttributes(0)
         #ifndef MAGNUM_TARGET_GLES2
         #ifndef MAGNUM_TARGET_WEBGL
         , maxAtomicCounterBufferSize(0), maxComputeSharedMemorySize(0), maxComputeWorkGroupInvocations(0), maxImageUnits(0), maxCombinedShaderOutputResources(0), maxUniformLocations(0)
@@ -212,6 +212,7 @@ ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string
 
 void ShaderProgramState::reset() {
     current = State::DisengagedBinding;
+    ++uniformCacheGeneration;
 }
 
 }}
@@ -26,6 +26,7 @@
 */
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Magnum/Magnum.h"
@@ -93,6 +94,10 @@ struct ShaderProgramState {
     /* Currently used program */
     GLuint current;
 
+    /* Incremented on each state reset, uniform caches of older generation
+       are discarded as the values could be changed externally meanwhile */
+    UnsignedInt uniformCacheGeneration;
+
     GLint maxVertexAttributes;
     #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_WEBGL
@@ -118,6 +123,16 @@ struct ShaderProgramState {
     #endif
 };
 
+/* Shadow copy of uniform values of a single program, see
+   AbstractShaderProgram::setUniformCacheEnabled() */
+struct ShaderProgramUniformCache {
+    explicit ShaderProgramUniformCache(UnsignedInt generation): generation{generation}, skippedCount{}, issuedCount{} {}
+
+    std::unordered_map<GLint, std::vector<char>> values;
+    UnsignedInt generation;
+    UnsignedLong skippedCount, issuedCount;
+};
+
 }}
 
 #endif
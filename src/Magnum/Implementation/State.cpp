@@ -35,6 +35,7 @@
 #include "DebugState.h"
 #endif
 #include "FramebufferState.h"
+#include "MemoryState.h"
 #include "MeshState.h"
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 #include "QueryState.h"
@@ -64,6 +65,7 @@ State::State(Context& context, std::ostream* const out) {
     debug.reset(new DebugState{context, extensions});
     #endif
     framebuffer.reset(new FramebufferState{context, extensions});
+    memory.reset(new MemoryState);
     mesh.reset(new MeshState{context, extensions});
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     query.reset(new QueryState{context, extensions});
@@ -37,6 +37,7 @@ struct BufferState;
 struct DebugState;
 #endif
 struct FramebufferState;
+struct MemoryState;
 struct MeshState;
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 struct QueryState;
@@ -62,6 +63,7 @@ struct State {
     std::unique_ptr<DebugState> debug;
     #endif
     std::unique_ptr<FramebufferState> framebuffer;
+    std::unique_ptr<MemoryState> memory;
     std::unique_ptr<MeshState> mesh;
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     std::unique_ptr<QueryState> query;
@@ -73,6 +75,9 @@ struct State {
     #ifndef MAGNUM_TARGET_GLES2
     std::unique_ptr<TransformFeedbackState> transformFeedback;
     #endif
+
+    /* Active command capture, if any. Owned by the user. */
+    CommandCapture* capture{};
 };
 
 }}
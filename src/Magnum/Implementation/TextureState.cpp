@@ -26,6 +26,7 @@
 #include "TextureState.h"
 
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/AbstractTexture.h"
 #include "Magnum/CubeMapTexture.h"
@@ -39,6 +40,14 @@
 
 namespace Magnum { namespace Implementation {
 
+#ifndef MAGNUM_TARGET_GLES2
+std::size_t SamplerParametersHash::operator()(const Sampler::Parameters& parameters) const {
+    /* All members are four bytes wide, so there is no padding to hash */
+    static_assert(sizeof(Sampler::Parameters) % 4 == 0, "unexpected padding in Sampler::Parameters");
+    return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&parameters), sizeof(Sampler::Parameters)).byteArray());
+}
+#endif
+
 TextureState::TextureState(Context& context, std::vector<std::string>& extensions): maxSize{},
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     max3DSize{},
@@ -113,6 +122,21 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         bindMultiImplementation = &AbstractTexture::bindImplementationFallback;
     }
 
+    /* Sampler multi bind implementation */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::GL::ARB::multi_bind>()) {
+        /* Extension name added above */
+
+        bindSamplersImplementation = &Sampler::bindImplementationMulti;
+
+    } else
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    {
+        bindSamplersImplementation = &Sampler::bindImplementationFallback;
+    }
+    #endif
+
     /* DSA/non-DSA implementation */
     #ifndef MAGNUM_TARGET_GLES
     if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>()) {
@@ -219,6 +243,14 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         invalidateSubImageImplementation = &AbstractTexture::invalidateSubImageImplementationNoOp;
     }
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* Sparse page commitment implementation. There's no ARB DSA variant, so
+       the EXT one is used even if ARB_direct_state_access is available */
+    if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+        pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDSAEXT;
+    else pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDefault;
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     /* Compressed cubemap image size query implementation (extensions added
        above) */
@@ -388,6 +420,9 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
     CORRADE_INTERNAL_ASSERT(maxTextureUnits > 0);
     bindings = Containers::Array<std::pair<GLenum, GLuint>>{Containers::ValueInit, std::size_t(maxTextureUnits)};
+    #ifndef MAGNUM_TARGET_GLES2
+    samplerBindings = Containers::Array<GLuint>{Containers::ValueInit, std::size_t(maxTextureUnits)};
+    #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     /* Allocate image bindings array to hold all possible image units */
@@ -404,13 +439,25 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
     #endif
 }
 
-TextureState::~TextureState() = default;
+TextureState::~TextureState() {
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Delete cached samplers directly, the state tracker is going away
+       together with them */
+    for(auto& sampler: samplerCache) {
+        const GLuint id = sampler.second.release();
+        glDeleteSamplers(1, &id);
+    }
+    #endif
+}
 
 void TextureState::reset() {
     std::fill_n(bindings.begin(), bindings.size(), std::pair<GLenum, GLuint>{{}, State::DisengagedBinding});
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     std::fill_n(imageBindings.begin(), imageBindings.size(), std::tuple<GLuint, GLint, GLboolean, GLint, GLenum>{State::DisengagedBinding, 0, false, 0, 0});
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    std::fill_n(samplerBindings.begin(), samplerBindings.size(), State::DisengagedBinding);
+    #endif
 }
 
 }}
@@ -26,11 +26,13 @@
 */
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
+#include "Magnum/Sampler.h"
 
 #if defined(_MSC_VER) && !defined(MAGNUM_TARGET_GLES2)
 /* Otherwise the member function pointers will have different size based on
@@ -42,6 +44,12 @@
 
 namespace Magnum { namespace Implementation {
 
+#ifndef MAGNUM_TARGET_GLES2
+struct SamplerParametersHash {
+    std::size_t operator()(const Sampler::Parameters& parameters) const;
+};
+#endif
+
 struct TextureState {
     explicit TextureState(Context& context, std::vector<std::string>& extensions);
     ~TextureState();
@@ -51,6 +59,9 @@ struct TextureState {
     Int(*compressedBlockDataSizeImplementation)(GLenum, TextureFormat);
     void(*unbindImplementation)(GLint);
     void(*bindMultiImplementation)(GLint, Containers::ArrayView<AbstractTexture* const>);
+    #ifndef MAGNUM_TARGET_GLES2
+    void(*bindSamplersImplementation)(GLint, Containers::ArrayView<Sampler* const>);
+    #endif
     void(AbstractTexture::*createImplementation)();
     void(AbstractTexture::*bindImplementation)(GLint);
     void(AbstractTexture::*parameteriImplementation)(GLenum, GLint);
@@ -95,6 +106,9 @@ struct TextureState {
     #endif
     void(AbstractTexture::*invalidateImageImplementation)(GLint);
     void(AbstractTexture::*invalidateSubImageImplementation)(GLint, const Vector3i&, const Vector3i&);
+    #ifndef MAGNUM_TARGET_GLES
+    void(AbstractTexture::*pageCommitmentImplementation)(GLint, const Vector3i&, const Vector3i&, GLboolean);
+    #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     void(BufferTexture::*setBufferImplementation)(BufferTextureFormat, Buffer&);
@@ -147,6 +161,10 @@ struct TextureState {
     /* Texture object ID, level, layered, layer, access */
     Containers::Array<std::tuple<GLuint, GLint, GLboolean, GLint, GLenum>> imageBindings;
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    Containers::Array<GLuint> samplerBindings;
+    std::unordered_map<Sampler::Parameters, Sampler, SamplerParametersHash> samplerCache;
+    #endif
 };
 
 }}
@@ -0,0 +1,100 @@
+#ifndef Magnum_Implementation_mapFile_h
+#define Magnum_Implementation_mapFile_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <string>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_TARGET_NACL)
+#define MAGNUM_IMPLEMENTATION_MAPFILE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* File mapping shared by the importer and font plugins. Available only if
+   MAGNUM_IMPLEMENTATION_MAPFILE is defined, the plugins read the file into
+   memory otherwise. */
+
+#ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+namespace Magnum { namespace Implementation {
+
+/* The mapping has to begin on a page boundary, the deleter gets the beginning
+   back by rounding the pointer down */
+template<class T> void unmapFile(T* const data, const std::size_t size) {
+    const std::size_t pageOffset = reinterpret_cast<std::uintptr_t>(data) % sysconf(_SC_PAGESIZE);
+    munmap(const_cast<char*>(data) - pageOffset, size + pageOffset);
+}
+
+template<class T> Containers::Array<T> mapFileInternal(const std::string& filename, const std::size_t offset, const std::size_t size, const int protection) {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd == -1) return nullptr;
+
+    const std::size_t pageOffset = offset % sysconf(_SC_PAGESIZE);
+    void* const mapped = mmap(nullptr, size + pageOffset, protection, MAP_PRIVATE, fd, offset - pageOffset);
+    ::close(fd);
+
+    if(mapped == MAP_FAILED) return nullptr;
+    return Containers::Array<T>{static_cast<T*>(mapped) + pageOffset, size, unmapFile<T>};
+}
+
+/* Size of given file, 0 if it can't be accessed */
+inline std::size_t fileSize(const std::string& filename) {
+    struct stat st;
+    return ::stat(filename.c_str(), &st) == 0 ? std::size_t(st.st_size) : 0;
+}
+
+/* Read-only mapping of given file range or whole file. Empty files and ranges
+   can't be mapped, nullptr is returned for them as well as on failure. */
+inline Containers::Array<const char> mapFile(const std::string& filename, const std::size_t offset, const std::size_t size) {
+    if(!size) return nullptr;
+    return mapFileInternal<const char>(filename, offset, size, PROT_READ);
+}
+
+inline Containers::Array<const char> mapFile(const std::string& filename) {
+    return mapFile(filename, 0, fileSize(filename));
+}
+
+/* Private writable mapping of given file range or whole file, with the same
+   restrictions. Changes are not written back to the file, so the data can be
+   converted in place and handed over to the user. */
+inline Containers::Array<char> mapFileWritable(const std::string& filename, const std::size_t offset, const std::size_t size) {
+    if(!size) return nullptr;
+    return mapFileInternal<char>(filename, offset, size, PROT_READ|PROT_WRITE);
+}
+
+inline Containers::Array<char> mapFileWritable(const std::string& filename) {
+    return mapFileWritable(filename, 0, fileSize(filename));
+}
+
+}}
+#endif
+
+#endif
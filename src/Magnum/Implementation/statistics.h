@@ -0,0 +1,44 @@
+#ifndef Magnum_Implementation_statistics_h
+#define Magnum_Implementation_statistics_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+
+#ifdef MAGNUM_BUILD_STATISTICS
+#include "Magnum/Context.h"
+
+/* Adds given value to a Context::Statistics counter of current context. Used
+   right before the actual GL call, compiled out completely if the library is
+   not built with MAGNUM_BUILD_STATISTICS. */
+#define MAGNUM_STATISTICS_ADD(counter, value)                               \
+    static_cast<void>(Magnum::Context::current().statisticsInternal().counter += (value))
+#else
+#define MAGNUM_STATISTICS_ADD(counter, value) static_cast<void>(0)
+#endif
+
+#define MAGNUM_STATISTICS_INCREMENT(counter) MAGNUM_STATISTICS_ADD(counter, 1)
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef Magnum_Implementation_viewAllocator_h
+#define Magnum_Implementation_viewAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+
+namespace Magnum { namespace Implementation {
+
+/* Used by the importers for importing into caller-provided memory. The view
+   is handed out for the first allocation that fits into it, all other
+   allocations go to the heap. */
+struct ViewAllocatorState {
+    Containers::ArrayView<char> view;
+    bool used;
+};
+
+inline Containers::Array<char> viewAllocator(const std::size_t size, void* const state) {
+    ViewAllocatorState& s = *static_cast<ViewAllocatorState*>(state);
+    if(s.used || size > s.view.size()) return Containers::Array<char>{size};
+
+    s.used = true;
+    return Containers::Array<char>{s.view.data(), size, [](char*, std::size_t) {}};
+}
+
+/* Returns non-owning array referencing the view, copying the data there if
+   the importer didn't allocate them from it. Expects that the data fit. */
+inline Containers::Array<char> moveIntoView(Containers::Array<char>&& data, const Containers::ArrayView<char> view) {
+    Containers::Array<char> moved{std::move(data)};
+    if(moved.data() != view.data())
+        std::copy_n(moved.begin(), moved.size(), view.begin());
+    return Containers::Array<char>{view.data(), moved.size(), [](char*, std::size_t) {}};
+}
+
+}}
+
+#endif
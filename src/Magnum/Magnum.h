@@ -99,6 +99,36 @@ Magnum contexts. Enabled by default.
 #define MAGNUM_BUILD_MULTITHREADED
 #undef MAGNUM_BUILD_MULTITHREADED
 
+/**
+@brief Build with statistics counters
+
+Defined if the library is built with counters of draw calls, buffer uploads
+and redundant state changes. Disabled by default.
+@see @ref building, @ref cmake, @ref Magnum::Context::statistics() "Context::statistics()"
+*/
+#define MAGNUM_BUILD_STATISTICS
+#undef MAGNUM_BUILD_STATISTICS
+
+/**
+@brief Build with tracing hooks
+
+Defined if the library is built with instrumentation zones in hot paths that
+forward to user-registered callbacks. Disabled by default.
+@see @ref building, @ref cmake, @ref Magnum::Tracing "Tracing"
+*/
+#define MAGNUM_BUILD_TRACING
+#undef MAGNUM_BUILD_TRACING
+
+/**
+@brief Build with GL command capture hooks
+
+Defined if the library is built with hooks that record GL operations into an
+active @ref Magnum::CommandCapture "CommandCapture". Disabled by default.
+@see @ref building, @ref cmake
+*/
+#define MAGNUM_BUILD_CAPTURE
+#undef MAGNUM_BUILD_CAPTURE
+
 /**
 @brief OpenGL ES target
 
@@ -457,6 +487,9 @@ using Math::Literals::operator "" _radf;
    FramebufferTarget enums used only directly with framebuffer instance */
 class AbstractFramebuffer;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class AbstractComputeShaderProgram;
+#endif
 class AbstractQuery;
 class AbstractShaderProgram;
 class AbstractTexture;
@@ -493,6 +526,9 @@ template<class T> using BasicColor3 CORRADE_DEPRECATED_ALIAS("use Math::Color3 i
 template<class T> using BasicColor4 CORRADE_DEPRECATED_ALIAS("use Math::Color4 instead") = Math::Color4<T>;
 #endif
 
+class CommandBuffer;
+class CommandCapture;
+class CommandCaptureReader;
 class Context;
 
 class CubeMapTexture;
@@ -505,8 +541,20 @@ class CubeMapTextureArray;
 /* DefaultFramebuffer is available only through global instance */
 /* DimensionTraits forward declaration is not needed */
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class DynamicResolution;
+#endif
+
 class Extension;
+class FixedStepTimeline;
+class FrameAllocator;
+template<class> class FrameAllocatorAdapter;
 class Framebuffer;
+class FrameGraph;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class FramebufferReader;
+#endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 enum class ImageFormat: GLenum;
@@ -543,8 +591,15 @@ typedef CompressedImageView<3> CompressedImageView3D;
 enum class MeshPrimitive: GLenum;
 
 class Mesh;
+#ifndef MAGNUM_TARGET_GLES
+class MeshPool;
+#endif
 class MeshView;
 
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class MultisampleFramebuffer;
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 /* MultisampleTextureSampleLocations enum used only in the function */
 template<UnsignedInt> class MultisampleTexture;
@@ -568,24 +623,37 @@ class CompressedPixelStorage;
 
 /* ObjectFlag, ObjectFlags are used only in conjunction with *::wrap() function */
 
+#ifndef MAGNUM_TARGET_GLES
+class PipelineStatisticsQuery;
+#endif
 class PrimitiveQuery;
+template<class> class QueryPool;
 class SampleQuery;
 class TimeQuery;
 
+class ProgramBinaryCache;
+
 class RectangleTexture;
 
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
 
+class RenderQueue;
+class RenderState;
+
 enum class ResourceState: UnsignedByte;
 enum class ResourceDataState: UnsignedByte;
 enum class ResourcePolicy: UnsignedByte;
 template<class T, class U = T> class Resource;
+template<class T, class U = T> class PinnedResource;
 class ResourceKey;
 template<class...> class ResourceManager;
 
+class RingBuffer;
+
 class Sampler;
 class Shader;
+class TaskScheduler;
 
 template<UnsignedInt> class Texture;
 #ifndef MAGNUM_TARGET_GLES
@@ -604,6 +672,10 @@ typedef TextureArray<2> Texture2DArray;
 
 enum class TextureFormat: GLenum;
 
+#ifndef MAGNUM_TARGET_GLES2
+class TextureStreamer;
+#endif
+
 class TransformFeedback;
 class Timeline;
 
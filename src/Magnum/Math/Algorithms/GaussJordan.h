@@ -29,7 +29,11 @@
  * @brief Function @ref Magnum::Math::Algorithms::gaussJordanInPlaceTransposed(), @ref Magnum::Math::Algorithms::gaussJordanInPlace()
  */
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/RectangularMatrix.h"
+#include "Magnum/Math/Algorithms/Implementation/Lanes.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -111,6 +115,115 @@ template<std::size_t size, std::size_t cols, class T> bool gaussJordanInPlace(Re
     return ret;
 }
 
+namespace Implementation {
+
+template<std::size_t size, std::size_t cols, std::size_t lanes, class T> void gaussJordanLanes(LaneMatrix<size, size, lanes, T>& a, LaneMatrix<cols, size, lanes, T>& t, bool(&regular)[lanes]) {
+    for(std::size_t lane = 0; lane != lanes; ++lane) regular[lane] = true;
+
+    for(std::size_t row = 0; row != size; ++row) {
+        /* Find max pivot */
+        std::size_t rowMax[lanes];
+        for(std::size_t lane = 0; lane != lanes; ++lane) rowMax[lane] = row;
+        for(std::size_t row2 = row+1; row2 != size; ++row2)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                rowMax[lane] = std::abs(a[row][row2][lane]) > std::abs(a[row][rowMax[lane]][lane]) ? row2 : rowMax[lane];
+
+        /* Swap the rows */
+        using std::swap;
+        for(std::size_t lane = 0; lane != lanes; ++lane) {
+            for(std::size_t col = 0; col != size; ++col)
+                swap(a[col][row][lane], a[col][rowMax[lane]][lane]);
+            for(std::size_t col = 0; col != cols; ++col)
+                swap(t[col][row][lane], t[col][rowMax[lane]][lane]);
+        }
+
+        /* Singular lanes continue with a unit pivot to avoid dividing by
+           zero, their result is discarded */
+        for(std::size_t lane = 0; lane != lanes; ++lane) {
+            const bool singular = TypeTraits<T>::equals(a[row][row][lane], T(0));
+            regular[lane] = regular[lane] && !singular;
+            a[row][row][lane] = singular ? T(1) : a[row][row][lane];
+        }
+
+        /* Eliminate column */
+        for(std::size_t row2 = row+1; row2 != size; ++row2) {
+            T c[lanes];
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                c[lane] = a[row][row2][lane]/a[row][row][lane];
+            for(std::size_t col = 0; col != size; ++col)
+                for(std::size_t lane = 0; lane != lanes; ++lane)
+                    a[col][row2][lane] -= a[col][row][lane]*c[lane];
+            for(std::size_t col = 0; col != cols; ++col)
+                for(std::size_t lane = 0; lane != lanes; ++lane)
+                    t[col][row2][lane] -= t[col][row][lane]*c[lane];
+        }
+    }
+
+    /* Backsubstitute */
+    for(std::size_t row = size; row != 0; --row) {
+        T c[lanes];
+        for(std::size_t lane = 0; lane != lanes; ++lane)
+            c[lane] = T(1)/a[row-1][row-1][lane];
+
+        for(std::size_t row2 = 0; row2 != row-1; ++row2)
+            for(std::size_t col = 0; col != cols; ++col)
+                for(std::size_t lane = 0; lane != lanes; ++lane)
+                    t[col][row2][lane] -= t[col][row-1][lane]*a[row-1][row2][lane]*c[lane];
+
+        /* Normalize the row */
+        for(std::size_t col = 0; col != cols; ++col)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                t[col][row-1][lane] *= c[lane];
+    }
+}
+
+}
+
+/**
+@brief Batched in-place Gauss-Jordan elimination
+@param[in,out] a        Left sides of augmented matrices
+@param[in,out] t        Right sides of augmented matrices
+@param[out] regular     Whether given item of @p a is regular. Optional, if
+    non-empty, expected to have the same size as @p a.
+@return True if all matrices in @p a are regular, false otherwise
+
+Equivalent to calling @ref gaussJordanInPlace(RectangularMatrix<size, size, T>&, RectangularMatrix<cols, size, T>&)
+on each pair of matrices, but processes several matrices at once in a
+structure-of-arrays layout that's friendly to SIMD vectorization. The result
+for singular matrices is unspecified. The views are expected to have the
+same size. The function has no shared state, so the work can be spread
+across multiple threads by calling it on disjoint slices of the views.
+*/
+template<class MatrixType, class RightMatrixType> bool gaussJordanInPlace(const Containers::ArrayView<MatrixType> a, const Containers::ArrayView<RightMatrixType> t, const Containers::ArrayView<bool> regular = nullptr) {
+    static_assert(std::size_t(MatrixType::Cols) == std::size_t(MatrixType::Rows), "left side matrix is not square");
+    static_assert(std::size_t(RightMatrixType::Rows) == std::size_t(MatrixType::Rows), "right side matrix has different row count");
+    typedef typename MatrixType::Type T;
+    constexpr std::size_t size = MatrixType::Rows;
+    constexpr std::size_t cols = RightMatrixType::Cols;
+    constexpr std::size_t lanes = Implementation::laneCount<T>();
+    CORRADE_ASSERT(a.size() == t.size() && (regular.empty() || regular.size() == a.size()),
+        "Math::Algorithms::gaussJordanInPlace(): expected views of the same size", false);
+
+    bool allRegular = true;
+    Implementation::forEachLaneGroup(a.size(), lanes, [&](const std::size_t offset, const std::size_t count) {
+        Implementation::LaneMatrix<size, size, lanes, T> laneA;
+        Implementation::LaneMatrix<cols, size, lanes, T> laneT;
+        bool laneRegular[lanes];
+        Implementation::loadLanes<lanes>(a.data() + offset, count, laneA);
+        Implementation::loadLanes<lanes>(t.data() + offset, count, laneT);
+        Implementation::gaussJordanLanes<size, cols, lanes, T>(laneA, laneT, laneRegular);
+        Implementation::storeLanes<lanes>(laneA, count, a.data() + offset);
+        Implementation::storeLanes<lanes>(laneT, count, t.data() + offset);
+
+        for(std::size_t i = 0; i != count; ++i) {
+            allRegular = allRegular && laneRegular[i];
+            if(!regular.empty()) regular[offset + i] = laneRegular[i];
+        }
+    });
+
+    return allRegular;
+}
+
 }}}
 
 #endif
@@ -29,7 +29,10 @@
  * @brief Function @ref Magnum::Math::Algorithms::gramSchmidtOrthogonalizeInPlace(), @ref Magnum::Math::Algorithms::gramSchmidtOrthogonalize(), @ref Magnum::Math::Algorithms::gramSchmidtOrthonormalizeInPlace(), @ref Magnum::Math::Algorithms::gramSchmidtOrthonormalize()
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "Magnum/Math/RectangularMatrix.h"
+#include "Magnum/Math/Algorithms/Implementation/Lanes.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -80,6 +83,57 @@ template<std::size_t cols, std::size_t rows, class T> RectangularMatrix<cols, ro
     return matrix;
 }
 
+namespace Implementation {
+
+template<std::size_t cols, std::size_t rows, std::size_t lanes, class T> void gramSchmidtOrthonormalizeLanes(LaneMatrix<cols, rows, lanes, T>& m) {
+    for(std::size_t i = 0; i != cols; ++i) {
+        T length[lanes]{};
+        for(std::size_t k = 0; k != rows; ++k)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                length[lane] += m[i][k][lane]*m[i][k][lane];
+        for(std::size_t lane = 0; lane != lanes; ++lane)
+            length[lane] = T(1)/std::sqrt(length[lane]);
+        for(std::size_t k = 0; k != rows; ++k)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                m[i][k][lane] *= length[lane];
+
+        for(std::size_t j = i+1; j != cols; ++j) {
+            T dot[lanes]{};
+            for(std::size_t k = 0; k != rows; ++k)
+                for(std::size_t lane = 0; lane != lanes; ++lane)
+                    dot[lane] += m[j][k][lane]*m[i][k][lane];
+            for(std::size_t k = 0; k != rows; ++k)
+                for(std::size_t lane = 0; lane != lanes; ++lane)
+                    m[j][k][lane] -= dot[lane]*m[i][k][lane];
+        }
+    }
+}
+
+}
+
+/**
+@brief Batched in-place Gram-Schmidt matrix orthonormalization
+@param[in,out] matrices Matrices to perform orthonormalization on
+
+Equivalent to calling @ref gramSchmidtOrthonormalizeInPlace(RectangularMatrix<cols, rows, T>&)
+on each matrix, but processes several matrices at once in a
+structure-of-arrays layout that's friendly to SIMD vectorization. The
+function has no shared state, so the work can be spread across multiple
+threads by calling it on disjoint slices of the view.
+*/
+template<class MatrixType> void gramSchmidtOrthonormalizeInPlace(const Containers::ArrayView<MatrixType> matrices) {
+    static_assert(std::size_t(MatrixType::Cols) <= std::size_t(MatrixType::Rows), "Unsupported matrix aspect ratio");
+    typedef typename MatrixType::Type T;
+    constexpr std::size_t lanes = Implementation::laneCount<T>();
+
+    Implementation::forEachLaneGroup(matrices.size(), lanes, [&](const std::size_t offset, const std::size_t count) {
+        Implementation::LaneMatrix<MatrixType::Cols, MatrixType::Rows, lanes, T> m;
+        Implementation::loadLanes<lanes>(matrices.data() + offset, count, m);
+        Implementation::gramSchmidtOrthonormalizeLanes<MatrixType::Cols, MatrixType::Rows, lanes, T>(m);
+        Implementation::storeLanes<lanes>(m, count, matrices.data() + offset);
+    });
+}
+
 }}}
 
 #endif
@@ -0,0 +1,77 @@
+#ifndef Magnum_Math_Algorithms_Implementation_Lanes_h
+#define Magnum_Math_Algorithms_Implementation_Lanes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Batched algorithms process the matrices in groups of laneCount<T>(). Each
+   group is copied into a structure-of-arrays layout with the matrix index
+   being the innermost dimension, so the algorithm does the same operation on
+   all lanes in a branch-free loop which the compiler vectorizes. Incomplete
+   groups at the end are padded with identity matrices so the padding lanes
+   don't produce NaNs. */
+
+#include <algorithm>
+
+#include "Magnum/Math/RectangularMatrix.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Implementation {
+
+/* 256 bits worth of lanes, i.e. two SSE/NEON registers or one AVX register */
+template<class T> constexpr std::size_t laneCount() { return 32/sizeof(T); }
+
+template<std::size_t cols, std::size_t rows, std::size_t lanes, class T> using LaneMatrix = T[cols][rows][lanes];
+
+/* Templated on the matrix type so subclasses such as Matrix3 can be used */
+template<std::size_t lanes, class MatrixType> void loadLanes(const MatrixType* const matrices, const std::size_t count, LaneMatrix<MatrixType::Cols, MatrixType::Rows, lanes, typename MatrixType::Type>& out) {
+    typedef typename MatrixType::Type T;
+    for(std::size_t col = 0; col != MatrixType::Cols; ++col)
+        for(std::size_t row = 0; row != MatrixType::Rows; ++row)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                out[col][row][lane] = lane < count ? matrices[lane][col][row] : T(col == row ? 1 : 0);
+}
+
+template<std::size_t lanes, class MatrixType> void storeLanes(const LaneMatrix<MatrixType::Cols, MatrixType::Rows, lanes, typename MatrixType::Type>& in, const std::size_t count, MatrixType* const matrices) {
+    for(std::size_t lane = 0; lane != count; ++lane)
+        for(std::size_t col = 0; col != MatrixType::Cols; ++col)
+            for(std::size_t row = 0; row != MatrixType::Rows; ++row)
+                matrices[lane][col][row] = in[col][row][lane];
+}
+
+template<std::size_t size, std::size_t lanes, class T> void identityLanes(LaneMatrix<size, size, lanes, T>& out) {
+    for(std::size_t col = 0; col != size; ++col)
+        for(std::size_t row = 0; row != size; ++row)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                out[col][row][lane] = T(col == row ? 1 : 0);
+}
+
+/* Calls f(offset, count) for each group of lanes */
+template<class F> void forEachLaneGroup(const std::size_t size, const std::size_t lanes, F f) {
+    for(std::size_t offset = 0; offset < size; offset += lanes)
+        f(offset, std::min(lanes, size - offset));
+}
+
+}}}}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef Magnum_Math_Algorithms_Jacobi_h
+#define Magnum_Math_Algorithms_Jacobi_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::jacobiEigen(), @ref Magnum::Math::Algorithms::jacobiEigenInPlace(), @ref Magnum::Math::Algorithms::jacobiSvd(), @ref Magnum::Math::Algorithms::jacobiSvdInPlace()
+ */
+
+#include <tuple>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Algorithms/Implementation/Lanes.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+enum: std::size_t { JacobiMaxSweeps = 32 };
+
+/* Rotation that zeroes the off-diagonal element, branch-free so it can be
+   vectorized. Returns identity rotation if the element is zero already. */
+template<class T> inline void jacobiRotation(const T app, const T aqq, const T apq, T& c, T& s) {
+    const bool zero = apq == T(0);
+    const T theta = (aqq - app)/(T(2)*(zero ? T(1) : apq));
+    const T t = (theta < T(0) ? T(-1) : T(1))/(std::abs(theta) + std::sqrt(theta*theta + T(1)));
+    c = zero ? T(1) : T(1)/std::sqrt(t*t + T(1));
+    s = zero ? T(0) : t*c;
+}
+
+template<std::size_t cols, std::size_t rows, std::size_t lanes, class T> inline void rotateColumns(LaneMatrix<cols, rows, lanes, T>& m, const std::size_t p, const std::size_t q, const T(&c)[lanes], const T(&s)[lanes]) {
+    for(std::size_t k = 0; k != rows; ++k)
+        for(std::size_t lane = 0; lane != lanes; ++lane) {
+            const T x = m[p][k][lane];
+            const T y = m[q][k][lane];
+            m[p][k][lane] = c[lane]*x - s[lane]*y;
+            m[q][k][lane] = s[lane]*x + c[lane]*y;
+        }
+}
+
+/* Cyclic Jacobi eigenvalue algorithm on symmetric matrices. On output the
+   diagonal of `a` contains the eigenvalues and columns of `v` the
+   eigenvectors. */
+template<std::size_t size, std::size_t lanes, class T> void jacobiEigenLanes(LaneMatrix<size, size, lanes, T>& a, LaneMatrix<size, size, lanes, T>& v) {
+    identityLanes<size, lanes, T>(v);
+
+    for(std::size_t sweep = 0; sweep != JacobiMaxSweeps; ++sweep) {
+        /* Done if off-diagonal elements are negligible in all lanes */
+        T offDiagonal[lanes]{}, norm[lanes]{};
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != size; ++row)
+                for(std::size_t lane = 0; lane != lanes; ++lane) {
+                    const T value = a[col][row][lane]*a[col][row][lane];
+                    norm[lane] += value;
+                    if(col != row) offDiagonal[lane] += value;
+                }
+        bool converged = true;
+        for(std::size_t lane = 0; lane != lanes; ++lane)
+            converged = converged && offDiagonal[lane] <= TypeTraits<T>::epsilon()*TypeTraits<T>::epsilon()*norm[lane];
+        if(converged) break;
+
+        for(std::size_t p = 0; p != size; ++p) for(std::size_t q = p + 1; q != size; ++q) {
+            T c[lanes], s[lanes];
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                jacobiRotation(a[p][p][lane], a[q][q][lane], a[q][p][lane], c[lane], s[lane]);
+
+            /* A' = J^T A J, V' = V J */
+            rotateColumns(a, p, q, c, s);
+            for(std::size_t k = 0; k != size; ++k)
+                for(std::size_t lane = 0; lane != lanes; ++lane) {
+                    const T x = a[k][p][lane];
+                    const T y = a[k][q][lane];
+                    a[k][p][lane] = c[lane]*x - s[lane]*y;
+                    a[k][q][lane] = s[lane]*x + c[lane]*y;
+                }
+            rotateColumns(v, p, q, c, s);
+        }
+    }
+}
+
+/* One-sided (Hestenes) Jacobi SVD. On output columns of `u` are
+   orthonormal, `w` contains the singular values and `v` is the right
+   orthogonal matrix. */
+template<std::size_t cols, std::size_t rows, std::size_t lanes, class T> void jacobiSvdLanes(LaneMatrix<cols, rows, lanes, T>& u, T(&w)[cols][lanes], LaneMatrix<cols, cols, lanes, T>& v) {
+    identityLanes<cols, lanes, T>(v);
+
+    for(std::size_t sweep = 0; sweep != JacobiMaxSweeps; ++sweep) {
+        bool rotated = false;
+
+        for(std::size_t p = 0; p != cols; ++p) for(std::size_t q = p + 1; q != cols; ++q) {
+            T alpha[lanes]{}, beta[lanes]{}, gamma[lanes]{};
+            for(std::size_t k = 0; k != rows; ++k)
+                for(std::size_t lane = 0; lane != lanes; ++lane) {
+                    alpha[lane] += u[p][k][lane]*u[p][k][lane];
+                    beta[lane] += u[q][k][lane]*u[q][k][lane];
+                    gamma[lane] += u[p][k][lane]*u[q][k][lane];
+                }
+
+            /* Rotate only columns that aren't orthogonal yet. The rotation
+               angle is the same as for the symmetric eigenproblem on
+               the 2x2 submatrix of U^T U. */
+            T c[lanes], s[lanes];
+            for(std::size_t lane = 0; lane != lanes; ++lane) {
+                const bool orthogonal = std::abs(gamma[lane]) <= TypeTraits<T>::epsilon()*std::sqrt(alpha[lane]*beta[lane]);
+                rotated = rotated || !orthogonal;
+                jacobiRotation(alpha[lane], beta[lane], orthogonal ? T(0) : gamma[lane], c[lane], s[lane]);
+            }
+
+            rotateColumns(u, p, q, c, s);
+            rotateColumns(v, p, q, c, s);
+        }
+
+        if(!rotated) break;
+    }
+
+    /* Singular values are lengths of the columns, zero columns stay zero */
+    for(std::size_t i = 0; i != cols; ++i) {
+        for(std::size_t lane = 0; lane != lanes; ++lane) w[i][lane] = T(0);
+        for(std::size_t k = 0; k != rows; ++k)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                w[i][lane] += u[i][k][lane]*u[i][k][lane];
+        for(std::size_t lane = 0; lane != lanes; ++lane)
+            w[i][lane] = std::sqrt(w[i][lane]);
+        for(std::size_t k = 0; k != rows; ++k)
+            for(std::size_t lane = 0; lane != lanes; ++lane)
+                u[i][k][lane] = w[i][lane] == T(0) ? T(0) : u[i][k][lane]/w[i][lane];
+    }
+}
+
+}
+
+/**
+@brief Eigendecomposition of a symmetric matrix
+@return Matrix with eigenvectors as columns and corresponding eigenvalues
+
+Uses the cyclic Jacobi eigenvalue algorithm. For small matrices such as
+inertia tensors or covariance matrices it is considerably cheaper than going
+through @ref svd(). The matrix is expected to be symmetric, otherwise the
+result is undefined. The eigenvalues are not sorted.
+@see @ref jacobiEigenInPlace()
+*/
+template<std::size_t size, class T> std::pair<Matrix<size, T>, Vector<size, T>> jacobiEigen(const Matrix<size, T>& matrix) {
+    Implementation::LaneMatrix<size, size, 1, T> a, v;
+    Implementation::loadLanes<1>(&matrix, 1, a);
+    Implementation::jacobiEigenLanes<size, 1, T>(a, v);
+
+    std::pair<Matrix<size, T>, Vector<size, T>> out;
+    Implementation::storeLanes<1>(v, 1, &out.first);
+    for(std::size_t i = 0; i != size; ++i) out.second[i] = a[i][i][0];
+    return out;
+}
+
+/**
+@brief Batched eigendecomposition of symmetric matrices
+@param[in,out] matrices Symmetric matrices, replaced with matrices having
+    eigenvectors as columns
+@param[out] eigenvalues Corresponding eigenvalues. Expected to have the same
+    size as @p matrices.
+
+Equivalent to calling @ref jacobiEigen() on each matrix, but processes
+several matrices at once in a structure-of-arrays layout that's friendly to
+SIMD vectorization. All matrices in a group are iterated until the slowest
+one converges. The function has no shared state, so the work can be spread
+across multiple threads by calling it on disjoint slices of the views.
+*/
+template<class MatrixType, class VectorType> void jacobiEigenInPlace(const Containers::ArrayView<MatrixType> matrices, const Containers::ArrayView<VectorType> eigenvalues) {
+    static_assert(std::size_t(MatrixType::Cols) == std::size_t(MatrixType::Rows) && std::size_t(VectorType::Size) == std::size_t(MatrixType::Cols), "Unsupported matrix or vector size");
+    typedef typename MatrixType::Type T;
+    constexpr std::size_t size = MatrixType::Cols;
+    constexpr std::size_t lanes = Implementation::laneCount<T>();
+    CORRADE_ASSERT(matrices.size() == eigenvalues.size(),
+        "Math::Algorithms::jacobiEigenInPlace(): expected views of the same size", );
+
+    Implementation::forEachLaneGroup(matrices.size(), lanes, [&](const std::size_t offset, const std::size_t count) {
+        Implementation::LaneMatrix<size, size, lanes, T> a, v;
+        Implementation::loadLanes<lanes>(matrices.data() + offset, count, a);
+        Implementation::jacobiEigenLanes<size, lanes, T>(a, v);
+        Implementation::storeLanes<lanes>(v, count, matrices.data() + offset);
+        for(std::size_t lane = 0; lane != count; ++lane)
+            for(std::size_t i = 0; i != size; ++i)
+                eigenvalues[offset + lane][i] = a[i][i][lane];
+    });
+}
+
+/**
+@brief Singular Value Decomposition using one-sided Jacobi rotations
+
+Returns the same values as @ref svd() --- first @p cols column vectors of
+@f$ U @f$, diagonal of @f$ \Sigma @f$ and non-transposed @f$ V @f$, the
+singular values are not sorted. The one-sided Jacobi method orthogonalizes
+columns of the matrix by pairwise plane rotations, which for small matrices
+(3x3 and 4x4 transformation or calibration matrices) is considerably
+cheaper than the Golub-Reinsch algorithm used in @ref svd() while being at
+least as accurate. Columns of @f$ U @f$ corresponding to zero singular values
+are zero.
+@see @ref jacobiSvdInPlace()
+*/
+template<std::size_t cols, std::size_t rows, class T> std::tuple<RectangularMatrix<cols, rows, T>, Vector<cols, T>, Matrix<cols, T>> jacobiSvd(const RectangularMatrix<cols, rows, T>& matrix) {
+    static_assert(rows >= cols, "Unsupported matrix aspect ratio");
+
+    Implementation::LaneMatrix<cols, rows, 1, T> u;
+    Implementation::LaneMatrix<cols, cols, 1, T> v;
+    T w[cols][1];
+    Implementation::loadLanes<1>(&matrix, 1, u);
+    Implementation::jacobiSvdLanes<cols, rows, 1, T>(u, w, v);
+
+    std::tuple<RectangularMatrix<cols, rows, T>, Vector<cols, T>, Matrix<cols, T>> out;
+    Implementation::storeLanes<1>(u, 1, &std::get<0>(out));
+    for(std::size_t i = 0; i != cols; ++i) std::get<1>(out)[i] = w[i][0];
+    Implementation::storeLanes<1>(v, 1, &std::get<2>(out));
+    return out;
+}
+
+/**
+@brief Batched Singular Value Decomposition using one-sided Jacobi rotations
+@param[in,out] matrices Matrices to decompose, replaced with first @p cols
+    column vectors of @f$ U @f$
+@param[out] w           Diagonals of @f$ \Sigma @f$. Expected to have the
+    same size as @p matrices.
+@param[out] v           Non-transposed @f$ V @f$ matrices. Expected to have
+    the same size as @p matrices.
+
+Equivalent to calling @ref jacobiSvd() on each matrix, but processes several
+matrices at once in a structure-of-arrays layout that's friendly to SIMD
+vectorization. All matrices in a group are iterated until the slowest one
+converges. The function has no shared state, so the work can be spread
+across multiple threads by calling it on disjoint slices of the views.
+*/
+template<class MatrixType, class VectorType, class SquareMatrixType> void jacobiSvdInPlace(const Containers::ArrayView<MatrixType> matrices, const Containers::ArrayView<VectorType> w, const Containers::ArrayView<SquareMatrixType> v) {
+    static_assert(std::size_t(MatrixType::Rows) >= std::size_t(MatrixType::Cols), "Unsupported matrix aspect ratio");
+    static_assert(std::size_t(VectorType::Size) == std::size_t(MatrixType::Cols) && std::size_t(SquareMatrixType::Cols) == std::size_t(MatrixType::Cols) && std::size_t(SquareMatrixType::Rows) == std::size_t(MatrixType::Cols), "Unsupported vector or matrix size");
+    typedef typename MatrixType::Type T;
+    constexpr std::size_t cols = MatrixType::Cols;
+    constexpr std::size_t rows = MatrixType::Rows;
+    constexpr std::size_t lanes = Implementation::laneCount<T>();
+    CORRADE_ASSERT(matrices.size() == w.size() && matrices.size() == v.size(),
+        "Math::Algorithms::jacobiSvdInPlace(): expected views of the same size", );
+
+    Implementation::forEachLaneGroup(matrices.size(), lanes, [&](const std::size_t offset, const std::size_t count) {
+        Implementation::LaneMatrix<cols, rows, lanes, T> laneU;
+        Implementation::LaneMatrix<cols, cols, lanes, T> laneV;
+        T laneW[cols][lanes];
+        Implementation::loadLanes<lanes>(matrices.data() + offset, count, laneU);
+        Implementation::jacobiSvdLanes<cols, rows, lanes, T>(laneU, laneW, laneV);
+        Implementation::storeLanes<lanes>(laneU, count, matrices.data() + offset);
+        Implementation::storeLanes<lanes>(laneV, count, v.data() + offset);
+        for(std::size_t lane = 0; lane != count; ++lane)
+            for(std::size_t i = 0; i != cols; ++i)
+                w[offset + lane][i] = laneW[i][lane];
+    });
+}
+
+}}}
+
+#endif
@@ -34,6 +34,7 @@ struct GaussJordanTest: Corrade::TestSuite::Tester {
 
     void singular();
     void invert();
+    void invertBatch();
 };
 
 typedef RectangularMatrix<4, 4, Float> Matrix4x4;
@@ -41,7 +42,8 @@ typedef Vector<4, Float> Vector4;
 
 GaussJordanTest::GaussJordanTest() {
     addTests({&GaussJordanTest::singular,
-              &GaussJordanTest::invert});
+              &GaussJordanTest::invert,
+              &GaussJordanTest::invertBatch});
 }
 
 void GaussJordanTest::singular() {
@@ -73,6 +75,38 @@ void GaussJordanTest::invert() {
     CORRADE_COMPARE(a*inverse, Matrix4x4::fromDiagonal(Vector4(1.0f)));
 }
 
+void GaussJordanTest::invertBatch() {
+    const Matrix4x4 regular(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
+                            Vector4(4.0f,  4.0f, 7.0f, 3.0f),
+                            Vector4(7.0f, -1.0f, 8.0f, 0.0f),
+                            Vector4(9.0f,  4.0f, 5.0f, 9.0f));
+    const Matrix4x4 singular(Vector4(1.0f, 2.0f,  3.0f,  4.0f),
+                             Vector4(2.0f, 3.0f, -7.0f, 11.0f),
+                             Vector4(2.0f, 4.0f,  6.0f,  8.0f),
+                             Vector4(1.0f, 2.0f,  7.0f, 40.0f));
+
+    /* More than one group of lanes with an incomplete one at the end */
+    Matrix4x4 a[11];
+    Matrix4x4 t[11];
+    bool regularFlags[11];
+    for(std::size_t i = 0; i != 11; ++i) {
+        a[i] = i == 9 ? singular : regular*Float(i + 1);
+        t[i] = Matrix4x4::fromDiagonal(Vector4(1.0f));
+    }
+
+    CORRADE_VERIFY(!gaussJordanInPlace(Containers::arrayView(a), Containers::arrayView(t), Containers::arrayView(regularFlags)));
+
+    for(std::size_t i = 0; i != 11; ++i) {
+        if(i == 9) {
+            CORRADE_VERIFY(!regularFlags[i]);
+            continue;
+        }
+
+        CORRADE_VERIFY(regularFlags[i]);
+        CORRADE_COMPARE(regular*Float(i + 1)*t[i], Matrix4x4::fromDiagonal(Vector4(1.0f)));
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::GaussJordanTest)
@@ -34,6 +34,7 @@ struct GramSchmidtTest: Corrade::TestSuite::Tester {
 
     void orthogonalize();
     void orthonormalize();
+    void orthonormalizeBatch();
 };
 
 typedef RectangularMatrix<3, 3, Float> Matrix3x3;
@@ -41,7 +42,8 @@ typedef Vector<3, Float> Vector3;
 
 GramSchmidtTest::GramSchmidtTest() {
     addTests({&GramSchmidtTest::orthogonalize,
-              &GramSchmidtTest::orthonormalize});
+              &GramSchmidtTest::orthonormalize,
+              &GramSchmidtTest::orthonormalizeBatch});
 }
 
 void GramSchmidtTest::orthogonalize() {
@@ -95,6 +97,23 @@ void GramSchmidtTest::orthonormalize() {
     CORRADE_COMPARE(orthonormalized, expected);
 }
 
+void GramSchmidtTest::orthonormalizeBatch() {
+    Matrix3x3 matrices[11];
+    for(std::size_t i = 0; i != 11; ++i)
+        matrices[i] = Matrix3x3(Vector3(3.0f,  5.0f, 8.0f + Float(i)),
+                                Vector3(4.0f,  4.0f, 7.0f),
+                                Vector3(7.0f, -1.0f, 8.0f - Float(i)));
+
+    Algorithms::gramSchmidtOrthonormalizeInPlace(Containers::arrayView(matrices));
+
+    for(std::size_t i = 0; i != 11; ++i) {
+        CORRADE_COMPARE(matrices[i], Algorithms::gramSchmidtOrthonormalize(
+            Matrix3x3(Vector3(3.0f,  5.0f, 8.0f + Float(i)),
+                      Vector3(4.0f,  4.0f, 7.0f),
+                      Vector3(7.0f, -1.0f, 8.0f - Float(i)))));
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::GramSchmidtTest)
@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Algorithms/Jacobi.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct JacobiTest: Corrade::TestSuite::Tester {
+    explicit JacobiTest();
+
+    void eigen();
+    void eigenDiagonal();
+    void eigenBatch();
+    void svd();
+    void svdRankDeficient();
+    void svdBatch();
+};
+
+typedef Matrix<3, Float> Matrix3x3;
+typedef Vector<3, Float> Vector3;
+typedef RectangularMatrix<5, 8, Double> Matrix5x8d;
+typedef Matrix<8, Double> Matrix8d;
+typedef Matrix<5, Double> Matrix5d;
+typedef Vector<8, Double> Vector8d;
+typedef Vector<5, Double> Vector5d;
+
+JacobiTest::JacobiTest() {
+    addTests({&JacobiTest::eigen,
+              &JacobiTest::eigenDiagonal,
+              &JacobiTest::eigenBatch,
+              &JacobiTest::svd,
+              &JacobiTest::svdRankDeficient,
+              &JacobiTest::svdBatch});
+}
+
+namespace {
+    const Matrix3x3 Symmetric{Vector3{4.0f, 1.0f, -2.0f},
+                              Vector3{1.0f, 2.0f, 0.0f},
+                              Vector3{-2.0f, 0.0f, 3.0f}};
+
+    const Matrix3x3 General{Vector3{3.0f, 5.0f, 8.0f},
+                            Vector3{4.0f, 4.0f, 7.0f},
+                            Vector3{7.0f, -1.0f, 8.0f}};
+
+    template<std::size_t size, class T> Vector<size, T> sorted(Vector<size, T> a) {
+        std::sort(a.data(), a.data() + size);
+        return a;
+    }
+}
+
+void JacobiTest::eigen() {
+    Matrix3x3 v;
+    Vector3 lambda;
+    std::tie(v, lambda) = jacobiEigen(Symmetric);
+
+    /* Eigenvectors are orthonormal and reconstruct the matrix */
+    CORRADE_COMPARE(v.transposed()*v, Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(v*Matrix3x3::fromDiagonal(lambda)*v.transposed(), Symmetric);
+
+    /* Trace is preserved */
+    CORRADE_COMPARE(lambda.sum(), 9.0f);
+}
+
+void JacobiTest::eigenDiagonal() {
+    Matrix3x3 v;
+    Vector3 lambda;
+    std::tie(v, lambda) = jacobiEigen(Matrix3x3::fromDiagonal({3.0f, -1.0f, 2.0f}));
+
+    CORRADE_COMPARE(v, Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(lambda, (Vector3{3.0f, -1.0f, 2.0f}));
+}
+
+void JacobiTest::eigenBatch() {
+    /* More than one group of lanes with an incomplete one at the end */
+    Matrix3x3 matrices[11];
+    Vector3 eigenvalues[11];
+    for(std::size_t i = 0; i != 11; ++i)
+        matrices[i] = Symmetric + Matrix3x3::fromDiagonal(Vector3{Float(i)});
+
+    jacobiEigenInPlace(Containers::arrayView(matrices), Containers::arrayView(eigenvalues));
+
+    for(std::size_t i = 0; i != 11; ++i) {
+        const std::pair<Matrix3x3, Vector3> expected = jacobiEigen(Symmetric + Matrix3x3::fromDiagonal(Vector3{Float(i)}));
+        CORRADE_COMPARE(matrices[i], expected.first);
+        CORRADE_COMPARE(eigenvalues[i], expected.second);
+    }
+}
+
+void JacobiTest::svd() {
+    Matrix3x3 u;
+    Vector3 w;
+    Matrix3x3 v;
+    std::tie(u, w, v) = jacobiSvd(RectangularMatrix<3, 3, Float>{General});
+
+    CORRADE_COMPARE(u*Matrix3x3::fromDiagonal(w)*v.transposed(), General);
+    CORRADE_COMPARE(u.transposed()*u, Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(v.transposed()*v, Matrix3x3{IdentityInit});
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_VERIFY(w[i] >= 0.0f);
+}
+
+void JacobiTest::svdRankDeficient() {
+    /* Same input as in SvdTest */
+    constexpr Matrix5x8d a(
+        Vector8d(22.0, 14.0,  -1.0, -3.0,  9.0,  9.0,  2.0,  4.0),
+        Vector8d(10.0,  7.0,  13.0, -2.0,  8.0,  1.0, -6.0,  5.0),
+        Vector8d( 2.0, 10.0,  -1.0, 13.0,  1.0, -7.0,  6.0,  0.0),
+        Vector8d( 3.0,  0.0, -11.0, -2.0, -2.0,  5.0,  5.0, -2.0),
+        Vector8d( 7.0,  8.0,   3.0,  4.0,  4.0, -1.0,  1.0,  2.0)
+    );
+
+    Matrix5x8d u;
+    Vector5d w;
+    Matrix5d v;
+    std::tie(u, w, v) = jacobiSvd(a);
+
+    Matrix8d u2(u[0], u[1], u[2], u[3], u[4], Vector8d(), Vector8d(), Vector8d());
+    CORRADE_COMPARE(u2*Matrix5x8d::fromDiagonal(w)*v.transposed(), a);
+    CORRADE_COMPARE(v.transposed()*v, Matrix5d{IdentityInit});
+    CORRADE_COMPARE(sorted(w), (Vector5d{0.0, 0.0, std::sqrt(384.0), 20.0, std::sqrt(1248.0)}));
+}
+
+void JacobiTest::svdBatch() {
+    Matrix3x3 matrices[11];
+    Vector3 w[11];
+    Matrix3x3 v[11];
+    for(std::size_t i = 0; i != 11; ++i)
+        matrices[i] = General*Float(i + 1);
+
+    jacobiSvdInPlace(Containers::arrayView(matrices), Containers::arrayView(w), Containers::arrayView(v));
+
+    for(std::size_t i = 0; i != 11; ++i) {
+        CORRADE_COMPARE(matrices[i]*Matrix3x3::fromDiagonal(w[i])*v[i].transposed(), General*Float(i + 1));
+        CORRADE_COMPARE(w[i], std::get<1>(jacobiSvd(RectangularMatrix<3, 3, Float>{General*Float(i + 1)})));
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::JacobiTest)
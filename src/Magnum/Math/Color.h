@@ -123,6 +123,28 @@ template<class T> inline typename Color3<T>::HSV toHSV(typename std::enable_if<s
     return toHSV<typename Color3<T>::FloatingPointType>(normalize<Color3<typename Color3<T>::FloatingPointType>>(color));
 }
 
+/* sRGB transfer function, exact */
+template<class T> inline T fromSrgb(const T value) {
+    return value <= T(0.04045) ? value/T(12.92) : std::pow((value + T(0.055))/T(1.055), T(2.4));
+}
+template<class T> inline T toSrgb(const T value) {
+    return value <= T(0.0031308) ? value*T(12.92) : T(1.055)*std::pow(value, T(1.0)/T(2.4)) - T(0.055);
+}
+
+/* Convert color from and to sRGB */
+template<class T> inline typename std::enable_if<std::is_floating_point<T>::value, Color3<T>>::type fromSrgb(const Vector3<typename Color3<T>::FloatingPointType>& srgb) {
+    return {fromSrgb(srgb[0]), fromSrgb(srgb[1]), fromSrgb(srgb[2])};
+}
+template<class T> inline typename std::enable_if<std::is_integral<T>::value, Color3<T>>::type fromSrgb(const Vector3<typename Color3<T>::FloatingPointType>& srgb) {
+    return denormalize<Color3<T>>(fromSrgb<typename Color3<T>::FloatingPointType>(srgb));
+}
+template<class T> inline Vector3<typename Color3<T>::FloatingPointType> toSrgb(typename std::enable_if<std::is_floating_point<T>::value, const Color3<T>&>::type color) {
+    return {toSrgb(color[0]), toSrgb(color[1]), toSrgb(color[2])};
+}
+template<class T> inline Vector3<typename Color3<T>::FloatingPointType> toSrgb(typename std::enable_if<std::is_integral<T>::value, const Color3<T>&>::type color) {
+    return toSrgb<typename Color3<T>::FloatingPointType>(normalize<Color3<typename Color3<T>::FloatingPointType>>(color));
+}
+
 /* Value for full channel (1.0f for floats, 255 for unsigned byte) */
 template<class T> constexpr typename std::enable_if<std::is_floating_point<T>::value, T>::type fullChannel() {
     return T(1);
@@ -131,6 +153,20 @@ template<class T> constexpr typename std::enable_if<std::is_integral<T>::value,
     return std::numeric_limits<T>::max();
 }
 
+/* Alpha channel (de)normalization, no-op for floats */
+template<class T> inline typename std::enable_if<std::is_floating_point<T>::value, T>::type normalizeChannel(const T value) {
+    return value;
+}
+template<class T> inline typename std::enable_if<std::is_integral<T>::value, typename TypeTraits<T>::FloatingPointType>::type normalizeChannel(const T value) {
+    return normalize<typename TypeTraits<T>::FloatingPointType>(value);
+}
+template<class T> inline typename std::enable_if<std::is_floating_point<T>::value, T>::type denormalizeChannel(const T value) {
+    return value;
+}
+template<class T> inline typename std::enable_if<std::is_integral<T>::value, T>::type denormalizeChannel(const typename TypeTraits<T>::FloatingPointType value) {
+    return denormalize<T>(value);
+}
+
 }
 
 /**
@@ -151,6 +187,19 @@ Conversion from and to HSV is done always using floating-point types, so hue
 is always in range in range @f$ [0.0, 360.0] @f$, saturation and value in
 range @f$ [0.0, 1.0] @f$.
 
+The color is assumed to be in linear RGB, conversion from and to sRGB is
+done using @ref fromSrgb() and @ref toSrgb(), again always using
+floating-point types. These use the exact sRGB transfer function and are
+meant for converting single values, such as colors specified in a
+sRGB-based color picker. For converting whole images or pixel arrays use
+the @ref srgbToLinear(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>) "srgbToLinear()"
+and @ref linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>) "linearToSrgb()"
+batch functions instead, which are considerably faster:
+@code
+Color3 a = Color3::fromSrgb(0x33b27f_rgb); // a == {0.0331048f, 0.445201f, 0.212231f}
+Vector3 b = a.toSrgb();                    // b == {0.2f, 0.698039f, 0.498039f}
+@endcode
+
 @see @link operator""_rgb() @endlink, @link operator""_rgbf() @endlink,
     @ref Color4, @ref Magnum::Color3, @ref Magnum::Color3ub
 */
@@ -249,6 +298,42 @@ template<class T> class Color3: public Vector3<T> {
             return fromHSV(std::make_tuple(hue, saturation, value));
         }
 
+        /**
+         * @brief Create linear RGB color from sRGB representation
+         * @param srgb  Color in sRGB color space
+         *
+         * Applies inverse sRGB curve onto the input, returning the input in
+         * linear RGB color space with D65 illuminant and 2° standard
+         * observer. For integral types the result is denormalized.
+         * @f[
+         *      \boldsymbol{c}_\mathrm{linear} = \begin{cases}
+         *          \dfrac{\boldsymbol{c}_\mathrm{sRGB}}{12.92}, & \boldsymbol{c}_\mathrm{sRGB} \le 0.04045 \\
+         *          \left( \dfrac{0.055 + \boldsymbol{c}_\mathrm{sRGB}}{1.055} \right)^{2.4}, & \boldsymbol{c}_\mathrm{sRGB} > 0.04045
+         *      \end{cases}
+         * @f]
+         * @see @ref toSrgb(), @ref Color4::fromSrgbAlpha(),
+         *      @ref srgbToLinear(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>)
+         */
+        static Color3<T> fromSrgb(const Vector3<FloatingPointType>& srgb) {
+            return Implementation::fromSrgb<T>(srgb);
+        }
+
+        /**
+         * @brief Create linear RGB color from integral sRGB representation
+         * @param srgb  Color in sRGB color space
+         *
+         * Useful in cases where you have for example an 8-bit sRGB
+         * representation and want to create a floating-point linear RGB
+         * color out of it:
+         * @code
+         * Math::Vector3<UnsignedByte> srgb;
+         * auto rgb = Color3::fromSrgb(srgb);
+         * @endcode
+         */
+        template<class Integral> static Color3<T> fromSrgb(const Vector3<Integral>& srgb) {
+            return fromSrgb(normalize<Vector3<FloatingPointType>>(srgb));
+        }
+
         /**
          * @brief Default constructor
          *
@@ -342,6 +427,40 @@ template<class T> class Color3: public Vector3<T> {
             return Implementation::value<T>(*this);
         }
 
+        /**
+         * @brief Convert to sRGB representation
+         *
+         * Assuming the color is in linear RGB with D65 illuminant and 2°
+         * standard observer, applies sRGB curve onto it, returning the
+         * color represented in sRGB color space:
+         * @f[
+         *      \boldsymbol{c}_\mathrm{sRGB} = \begin{cases}
+         *          12.92 \boldsymbol{c}_\mathrm{linear}, & \boldsymbol{c}_\mathrm{linear} \le 0.0031308 \\
+         *          1.055 \boldsymbol{c}_\mathrm{linear}^{1/2.4}-0.055, & \boldsymbol{c}_\mathrm{linear} > 0.0031308
+         *      \end{cases}
+         * @f]
+         * @see @ref fromSrgb(), @ref Color4::toSrgbAlpha(),
+         *      @ref linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>)
+         */
+        Vector3<FloatingPointType> toSrgb() const {
+            return Implementation::toSrgb<T>(*this);
+        }
+
+        /**
+         * @brief Convert to integral sRGB representation
+         *
+         * Useful in cases where you have a floating-point linear RGB color
+         * and want to create for example an 8-bit sRGB representation out
+         * of it:
+         * @code
+         * Color3 color;
+         * Math::Vector3<UnsignedByte> srgb = color.toSrgb<UnsignedByte>();
+         * @endcode
+         */
+        template<class Integral> Vector3<Integral> toSrgb() const {
+            return denormalize<Vector3<Integral>>(toSrgb());
+        }
+
         MAGNUM_VECTOR_SUBCLASS_IMPLEMENTATION(3, Color3)
 };
 
@@ -444,6 +563,67 @@ class Color4: public Vector4<T> {
             return fromHSV(std::make_tuple(hue, saturation, value), alpha);
         }
 
+        /**
+         * @brief Create linear RGBA color from sRGB + alpha representation
+         * @param srgbAlpha Color in sRGB color space with linear alpha
+         *
+         * Applies inverse sRGB curve onto RGB channels of the input, alpha
+         * channel is kept linear. See @ref Color3::fromSrgb() for more
+         * information.
+         * @see @ref toSrgbAlpha()
+         */
+        static Color4<T> fromSrgbAlpha(const Vector4<FloatingPointType>& srgbAlpha) {
+            return {Implementation::fromSrgb<T>(srgbAlpha.rgb()), Implementation::denormalizeChannel<T>(srgbAlpha[3])};
+        }
+
+        /**
+         * @brief Create linear RGBA color from integral sRGB + alpha representation
+         * @param srgbAlpha Color in sRGB color space with linear alpha
+         *
+         * Useful in cases where you have for example an 8-bit sRGB + alpha
+         * representation and want to create a floating-point linear RGBA
+         * color out of it. See @ref Color3::fromSrgb() for more
+         * information.
+         */
+        template<class Integral> static Color4<T> fromSrgbAlpha(const Vector4<Integral>& srgbAlpha) {
+            return fromSrgbAlpha(normalize<Vector4<FloatingPointType>>(srgbAlpha));
+        }
+
+        /**
+         * @brief Create linear RGBA color from sRGB representation
+         * @param srgb  Color in sRGB color space
+         * @param a     Alpha value, defaults to `1.0` for floating-point types
+         *      and maximum positive value for integral types.
+         *
+         * See @ref Color3::fromSrgb() for more information.
+         */
+        static Color4<T> fromSrgb(const Vector3<FloatingPointType>& srgb, T a = Implementation::fullChannel<T>()) {
+            return {Implementation::fromSrgb<T>(srgb), a};
+        }
+
+        /**
+         * @brief Convert to sRGB + alpha representation
+         *
+         * Applies sRGB curve onto RGB channels, alpha channel is kept
+         * linear. See @ref Color3::toSrgb() for more information.
+         * @see @ref fromSrgbAlpha()
+         */
+        Vector4<FloatingPointType> toSrgbAlpha() const {
+            return {Implementation::toSrgb<T>(Vector4<T>::rgb()), Implementation::normalizeChannel<T>(Vector4<T>::a())};
+        }
+
+        /**
+         * @brief Convert to integral sRGB + alpha representation
+         *
+         * Useful in cases where you have a floating-point linear RGBA color
+         * and want to create for example an 8-bit sRGB + alpha
+         * representation out of it. See @ref Color3::toSrgb() for more
+         * information.
+         */
+        template<class Integral> Vector4<Integral> toSrgbAlpha() const {
+            return denormalize<Vector4<Integral>>(toSrgbAlpha());
+        }
+
         /**
          * @brief Default constructor
          *
@@ -0,0 +1,166 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ColorBatch.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/Simd.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Linear value of each 8-bit sRGB value */
+const Float* srgbToLinearTable() {
+    static const struct Table {
+        Table() {
+            for(std::size_t i = 0; i != 256; ++i) {
+                const Double value = i/255.0;
+                data[i] = Float(value <= 0.04045 ? value/12.92 : std::pow((value + 0.055)/1.055, 2.4));
+            }
+        }
+
+        Float data[256];
+    } table;
+    return table.data;
+}
+
+/* Linear value at which the rounded 8-bit sRGB value changes from i to i + 1,
+   the last one is never reached */
+const Float* linearToSrgbThresholds() {
+    static const struct Table {
+        Table() {
+            for(std::size_t i = 0; i != 255; ++i) {
+                const Double value = (i + 0.5)/255.0;
+                data[i] = Float(value <= 0.04045 ? value/12.92 : std::pow((value + 0.055)/1.055, 2.4));
+            }
+            data[255] = 2.0f;
+        }
+
+        Float data[256];
+    } table;
+    return table.data;
+}
+
+/* Least-squares fit of 1.055 x^(1/2.4) - 0.055 on [0.0031308, 1], the
+   largest error is near the lower end */
+constexpr Float SrgbCoefficients[]{0.554545388f, 0.899887369f, -0.488642398f, 0.0344128033f};
+
+inline Float linearToSrgbFast(const Float value) {
+    if(value <= 0.0031308f) return value*12.92f;
+
+    const Float s1 = std::sqrt(value);
+    const Float s2 = std::sqrt(s1);
+    const Float s3 = std::sqrt(s2);
+    return SrgbCoefficients[0]*s1 + SrgbCoefficients[1]*s2 + SrgbCoefficients[2]*s3 + SrgbCoefficients[3];
+}
+
+}
+
+void srgbToLinear(const Containers::ArrayView<const UnsignedByte> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::srgbToLinear(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const table = srgbToLinearTable();
+    for(std::size_t i = 0; i != in.size(); ++i) out[i] = table[in[i]];
+}
+
+void linearToSrgb(const Containers::ArrayView<const Float> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::linearToSrgb(): expected output size" << in.size() << "but got" << out.size(), );
+
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_SIMD_SSE2)
+    /* Square roots of values in the linear segment may be NaN, but they are
+       masked out */
+    const __m128 threshold = _mm_set1_ps(0.0031308f);
+    const __m128 slope = _mm_set1_ps(12.92f);
+    const __m128 c0 = _mm_set1_ps(SrgbCoefficients[0]);
+    const __m128 c1 = _mm_set1_ps(SrgbCoefficients[1]);
+    const __m128 c2 = _mm_set1_ps(SrgbCoefficients[2]);
+    const __m128 c3 = _mm_set1_ps(SrgbCoefficients[3]);
+    for(; i + 4 <= in.size(); i += 4) {
+        const __m128 value = _mm_loadu_ps(in.data() + i);
+        const __m128 s1 = _mm_sqrt_ps(value);
+        const __m128 s2 = _mm_sqrt_ps(s1);
+        const __m128 s3 = _mm_sqrt_ps(s2);
+        __m128 curve = Implementation::Simd::multiplyAdd(c0, s1, c3);
+        curve = Implementation::Simd::multiplyAdd(c1, s2, curve);
+        curve = Implementation::Simd::multiplyAdd(c2, s3, curve);
+        const __m128 linear = _mm_cmple_ps(value, threshold);
+        _mm_storeu_ps(out.data() + i, _mm_or_ps(
+            _mm_and_ps(linear, _mm_mul_ps(value, slope)),
+            _mm_andnot_ps(linear, curve)));
+    }
+    #elif defined(MAGNUM_MATH_SIMD_NEON) && defined(__aarch64__)
+    /* Vector square root is available only on AArch64 */
+    const float32x4_t threshold = vdupq_n_f32(0.0031308f);
+    for(; i + 4 <= in.size(); i += 4) {
+        const float32x4_t value = vld1q_f32(in.data() + i);
+        const float32x4_t s1 = vsqrtq_f32(value);
+        const float32x4_t s2 = vsqrtq_f32(s1);
+        const float32x4_t s3 = vsqrtq_f32(s2);
+        float32x4_t curve = vmlaq_n_f32(vdupq_n_f32(SrgbCoefficients[3]), s1, SrgbCoefficients[0]);
+        curve = vmlaq_n_f32(curve, s2, SrgbCoefficients[1]);
+        curve = vmlaq_n_f32(curve, s3, SrgbCoefficients[2]);
+        vst1q_f32(out.data() + i, vbslq_f32(vcleq_f32(value, threshold),
+            vmulq_n_f32(value, 12.92f), curve));
+    }
+    #endif
+
+    for(; i != in.size(); ++i) out[i] = linearToSrgbFast(in[i]);
+}
+
+void linearToSrgb(const Containers::ArrayView<const Float> in, const Containers::ArrayView<UnsignedByte> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::linearToSrgb(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const thresholds = linearToSrgbThresholds();
+
+    /* Processing in small blocks on the stack so the approximation can be
+       vectorized */
+    Float clamped[64];
+    Float srgb[64];
+    for(std::size_t offset = 0; offset < in.size(); offset += 64) {
+        const std::size_t size = Math::min(in.size() - offset, std::size_t(64));
+        for(std::size_t i = 0; i != size; ++i)
+            clamped[i] = Math::clamp(in[offset + i], 0.0f, 1.0f);
+        linearToSrgb(Containers::ArrayView<const Float>{clamped, size}, Containers::ArrayView<Float>{srgb, size});
+
+        /* The approximation is at most one off after rounding, fix it by
+           comparing to the exact thresholds */
+        for(std::size_t i = 0; i != size; ++i) {
+            Int value = Math::clamp(Int(srgb[i]*255.0f + 0.5f), 0, 255);
+            if(clamped[i] >= thresholds[value]) ++value;
+            else if(value && clamped[i] < thresholds[value - 1]) --value;
+            out[offset + i] = UnsignedByte(value);
+        }
+    }
+}
+
+}}
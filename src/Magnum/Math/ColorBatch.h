@@ -0,0 +1,87 @@
+#ifndef Magnum_Math_ColorBatch_h
+#define Magnum_Math_ColorBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::srgbToLinear(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>), @ref Magnum::Math::linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<Float>), @ref Magnum::Math::linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>)
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/** @{ @name Batch color functions */
+
+/**
+@brief Convert an array of 8-bit sRGB values to linear floats
+@param[in]  in      Input sRGB values
+@param[out] out     Output linear values, expected to have the same size as
+    @p in
+
+Same as applying @ref Color3::fromSrgb() to each normalized value, but uses
+a 256-entry lookup table instead of evaluating the sRGB curve. The table is
+calculated on first use.
+*/
+MAGNUM_EXPORT void srgbToLinear(Containers::ArrayView<const UnsignedByte> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Fast approximate conversion of an array of linear floats to sRGB
+@param[in]  in      Input linear values in range @f$ [0.0, 1.0] @f$
+@param[out] out     Output sRGB values, expected to have the same size as
+    @p in
+
+Approximates the @f$ x^{1/2.4} @f$ term of the sRGB curve in
+@ref Color3::toSrgb() with a polynomial in @f$ \sqrt{x} @f$,
+@f$ \sqrt[4]{x} @f$ and @f$ \sqrt[8]{x} @f$, the maximal absolute error is
+about @f$ 2 \cdot 10^{-4} @f$. The square roots are calculated four values at
+a time using SSE2 or NEON on AArch64 if enabled in compiler flags. The output
+can be the same as the input.
+*/
+MAGNUM_EXPORT void linearToSrgb(Containers::ArrayView<const Float> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Convert an array of linear floats to 8-bit sRGB values
+@param[in]  in      Input linear values, clamped to range
+    @f$ [0.0, 1.0] @f$
+@param[out] out     Output sRGB values, expected to have the same size as
+    @p in
+
+Uses the approximation from @ref linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<Float>)
+and then corrects the rounding using a 256-entry table of linear values
+at which the rounded sRGB value changes, so the result is the same as
+applying @ref Color3::toSrgb() to each value and rounding to nearest
+integer.
+*/
+MAGNUM_EXPORT void linearToSrgb(Containers::ArrayView<const Float> in, Containers::ArrayView<UnsignedByte> out);
+
+/*@}*/
+
+}}
+
+#endif
@@ -53,6 +53,32 @@ namespace Implementation {
         template<class T> constexpr static T pow(T) { return 1; }
     };
 
+    /* Reduces the angle to [-π/2, π/2] by subtracting a multiple of π,
+       which is split into two parts to keep the precision. The result has to
+       be negated for odd multiples. */
+    template<class T> inline T reduceAngle(const T angle, bool& negate) {
+        const T k = std::round(angle*T(0.318309886183790671538));
+        negate = Long(k) & 1;
+        return (angle - k*T(3.140625)) - k*T(9.67653589793e-4);
+    }
+
+    /* Taylor polynomials of ninth and tenth degree in Horner form, precise
+       enough in the reduced range */
+    template<class T> inline T sinFast(const T angle) {
+        bool negate;
+        const T x = reduceAngle(angle, negate);
+        const T x2 = x*x;
+        const T out = x*(T(1) + x2*(T(-1.0/6.0) + x2*(T(1.0/120.0) + x2*(T(-1.0/5040.0) + x2*T(1.0/362880.0)))));
+        return negate ? -out : out;
+    }
+    template<class T> inline T cosFast(const T angle) {
+        bool negate;
+        const T x = reduceAngle(angle, negate);
+        const T x2 = x*x;
+        const T out = T(1) + x2*(T(-0.5) + x2*(T(1.0/24.0) + x2*(T(-1.0/720.0) + x2*(T(1.0/40320.0) + x2*T(-1.0/3628800.0)))));
+        return negate ? -out : out;
+    }
+
     template<class> struct IsBoolVector: std::false_type {};
     template<std::size_t size> struct IsBoolVector<BoolVector<size>>: std::true_type {};
 }
@@ -178,6 +204,39 @@ template<class T> inline T tan(Unit<Rad, T> angle) { return std::tan(T(angle));
 template<class T> inline T tan(Unit<Deg, T> angle) { return tan(Rad<T>(angle)); }
 #endif
 
+/**
+@brief Fast approximate sine
+
+Reduces the angle to @f$ [-\frac{\pi}{2}, \frac{\pi}{2}] @f$ and evaluates a
+ninth-degree polynomial instead of calling @ref sin(). Absolute error is below
+@f$ 5 \cdot 10^{-6} @f$ for angles in range @f$ [-1000, 1000] @f$ radians,
+for larger angles the precision degrades with the range reduction. Meant for
+code where the performance matters more than precision, such as culling,
+level-of-detail selection or particle simulation.
+@see @ref cosFast(), @ref sinFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T> inline T sinFast(Rad<T> angle);
+#else
+template<class T> inline T sinFast(Unit<Rad, T> angle) { return Implementation::sinFast(T(angle)); }
+template<class T> inline T sinFast(Unit<Deg, T> angle) { return sinFast(Rad<T>(angle)); }
+#endif
+
+/**
+@brief Fast approximate cosine
+
+Reduces the angle to @f$ [-\frac{\pi}{2}, \frac{\pi}{2}] @f$ and evaluates a
+tenth-degree polynomial instead of calling @ref cos(). The precision is the
+same as with @ref sinFast().
+@see @ref cos(), @ref cosFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T> inline T cosFast(Rad<T> angle);
+#else
+template<class T> inline T cosFast(Unit<Rad, T> angle) { return Implementation::cosFast(T(angle)); }
+template<class T> inline T cosFast(Unit<Deg, T> angle) { return cosFast(Rad<T>(angle)); }
+#endif
+
 /** @brief Arc sine */
 template<class T> inline Rad<T> asin(T value) { return Rad<T>(std::asin(value)); }
 
@@ -422,6 +481,54 @@ template<std::size_t size, class T> Vector<size, T> sqrtInverted(const Vector<si
 }
 #endif
 
+/**
+@brief Fast approximate inverse square root
+
+Computes the initial estimate by manipulating the floating-point
+representation and refines it with two Newton-Raphson iterations. Relative
+error is below @f$ 5 \cdot 10^{-6} @f$ for all positive normal numbers, the
+result for zero, negative values, denormals, infinity or NaN is undefined.
+Available only for @ref Magnum::Float "Float" and its vector types.
+@see @ref sqrtInverted(), @ref lengthFast(), @ref normalizedFast(),
+    @ref sqrtInvertedFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>)
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T> inline T sqrtInvertedFast(const T& a);
+#else
+inline Float sqrtInvertedFast(Float a) { return Implementation::sqrtInvertedFast(a); }
+template<std::size_t size> Vector<size, Float> sqrtInvertedFast(const Vector<size, Float>& a) {
+    Vector<size, Float> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = Implementation::sqrtInvertedFast(a[i]);
+    return out;
+}
+#endif
+
+/**
+@brief Fast approximate vector length
+
+Calculated using @ref sqrtInvertedFast(), see its documentation for precision
+details. Unlike with @ref Vector::length(), the result for zero vector is
+undefined.
+@see @ref normalizedFast()
+*/
+template<std::size_t size> inline Float lengthFast(const Vector<size, Float>& a) {
+    const Float dot = a.dot();
+    return dot*Implementation::sqrtInvertedFast(dot);
+}
+
+/**
+@brief Fast approximate vector normalization
+
+Calculated using @ref sqrtInvertedFast(), see its documentation for precision
+details. The result for zero vector is undefined.
+@see @ref Vector::normalized(), @ref lengthFast(),
+    @ref normalizedFast(Containers::ArrayView<const Vector3<Float>>, Containers::ArrayView<Vector3<Float>>)
+*/
+template<std::size_t size> inline Vector<size, Float> normalizedFast(const Vector<size, Float>& a) {
+    return a*Implementation::sqrtInvertedFast(a.dot());
+}
+
 /**
 @brief Linear interpolation of two values
 @param a     First value
@@ -0,0 +1,97 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/Simd.h"
+
+namespace Magnum { namespace Math {
+
+void sqrtInvertedFast(const Containers::ArrayView<const Float> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::sqrtInvertedFast(): expected output size" << in.size() << "but got" << out.size(), );
+
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_SIMD_SSE2)
+    /* The estimate has 12 bits of precision, one iteration is enough */
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    for(; i + 4 <= in.size(); i += 4) {
+        const __m128 a = _mm_loadu_ps(in.data() + i);
+        const __m128 estimate = _mm_rsqrt_ps(a);
+        _mm_storeu_ps(out.data() + i, _mm_mul_ps(_mm_mul_ps(half, estimate),
+            _mm_sub_ps(three, _mm_mul_ps(_mm_mul_ps(a, estimate), estimate))));
+    }
+    #elif defined(MAGNUM_MATH_SIMD_NEON)
+    /* The estimate has only 8 bits of precision, two iterations needed */
+    for(; i + 4 <= in.size(); i += 4) {
+        const float32x4_t a = vld1q_f32(in.data() + i);
+        float32x4_t estimate = vrsqrteq_f32(a);
+        estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(a, estimate), estimate));
+        estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(a, estimate), estimate));
+        vst1q_f32(out.data() + i, estimate);
+    }
+    #endif
+
+    for(; i != in.size(); ++i) out[i] = sqrtInvertedFast(in[i]);
+}
+
+/* Plain loops without function calls, so the compiler is able to vectorize
+   them */
+
+void sinFast(const Containers::ArrayView<const Float> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::sinFast(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const input = in.data();
+    Float* const output = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        output[i] = Implementation::sinFast(input[i]);
+}
+
+void cosFast(const Containers::ArrayView<const Float> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::cosFast(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const input = in.data();
+    Float* const output = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        output[i] = Implementation::cosFast(input[i]);
+}
+
+void normalizedFast(const Containers::ArrayView<const Vector3<Float>> in, const Containers::ArrayView<Vector3<Float>> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::normalizedFast(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Vector3<Float>* const input = in.data();
+    Vector3<Float>* const output = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        output[i] = input[i]*Implementation::sqrtInvertedFast(input[i].dot());
+}
+
+}}
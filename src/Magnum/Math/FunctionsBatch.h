@@ -0,0 +1,84 @@
+#ifndef Magnum_Math_FunctionsBatch_h
+#define Magnum_Math_FunctionsBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::sqrtInvertedFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>), @ref Magnum::Math::sinFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>), @ref Magnum::Math::cosFast(Containers::ArrayView<const Float>, Containers::ArrayView<Float>), @ref Magnum::Math::normalizedFast(Containers::ArrayView<const Vector3<Float>>, Containers::ArrayView<Vector3<Float>>)
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math {
+
+/** @{ @name Batch functions */
+
+/**
+@brief Fast approximate inverse square root of an array of values
+@param[in]  in      Input values
+@param[out] out     Output values, expected to have the same size as @p in
+
+Same as calling @ref sqrtInvertedFast(Float) for each value, but uses the
+SSE2 or NEON reciprocal square root estimate followed by a Newton-Raphson
+iteration if enabled in compiler flags. The precision is the same.
+*/
+MAGNUM_EXPORT void sqrtInvertedFast(Containers::ArrayView<const Float> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Fast approximate sine of an array of values
+@param[in]  in      Input angles in radians
+@param[out] out     Output values, expected to have the same size as @p in
+
+Same as calling @ref sinFast() for each value.
+*/
+MAGNUM_EXPORT void sinFast(Containers::ArrayView<const Float> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Fast approximate cosine of an array of values
+@param[in]  in      Input angles in radians
+@param[out] out     Output values, expected to have the same size as @p in
+
+Same as calling @ref cosFast() for each value.
+*/
+MAGNUM_EXPORT void cosFast(Containers::ArrayView<const Float> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Fast approximate normalization of an array of vectors
+@param[in]  in      Input vectors
+@param[out] out     Output vectors, expected to have the same size as @p in
+
+Same as calling @ref normalizedFast() for each vector. The output can be the
+same as the input.
+*/
+MAGNUM_EXPORT void normalizedFast(Containers::ArrayView<const Vector3<Float>> in, Containers::ArrayView<Vector3<Float>> out);
+
+/*@}*/
+
+}}
+
+#endif
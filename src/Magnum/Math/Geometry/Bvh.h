@@ -0,0 +1,543 @@
+#ifndef Magnum_Math_Geometry_Bvh_h
+#define Magnum_Math_Geometry_Bvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Math::Geometry::Bvh, alias @ref Magnum::Math::Geometry::Bvh2D, @ref Magnum::Math::Geometry::Bvh3D
+ */
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Math {
+
+namespace Implementation {
+    template<UnsignedInt, class> struct BvhTraits;
+
+    /* Half of the perimeter in 2D, half of the surface area in 3D */
+    template<class T> struct BvhTraits<2, T> {
+        static T halfArea(const Vector2<T>& size) {
+            return size.x() + size.y();
+        }
+    };
+    template<class T> struct BvhTraits<3, T> {
+        static T halfArea(const Vector3<T>& size) {
+            return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+        }
+    };
+}
+
+namespace Geometry {
+
+/**
+@brief Bounding volume hierarchy
+
+Binary tree of axis-aligned boxes over a set of items, each represented by its
+bounding box. Meant to be shared by everything that needs to quickly find
+items in some region --- collision broadphase, picking, culling or light
+assignment.
+
+## Building
+
+The tree is built top-down using binned surface area heuristic. At each node
+the item centers are sorted into @ref BinCount bins along the axis with the
+largest spread and the node is split at the bin boundary that minimizes the
+sum of child surface areas (perimeters in 2D) weighted by item count. Nodes
+with at most `maxLeafSize` items become leaves. Nodes deep in the tree are
+split at the median instead, so the depth never exceeds @ref MaxDepth. The
+tree is built on the calling thread, independent trees (for example one per
+scene layer) can be built in parallel by the caller.
+@code
+std::vector<Range3D> boxes;
+Math::Geometry::Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+@endcode
+
+If the items move, but their relative placement doesn't change much, the tree
+doesn't need to be built again, it's enough to update the node bounds with
+@ref refit(), which is linear in the item count.
+
+## Queries
+
+The tree can be queried for items overlapping a box with @ref queryRange(),
+items inside a frustum with @ref queryFrustum() and items hit by a ray with
+@ref queryRay(). All queries use a fixed-size stack and don't allocate. The
+callback gets called with item ID, i.e. index of the box passed to the
+constructor:
+@code
+bvh.queryFrustum({planes.data(), planes.size()}, [&](UnsignedInt id) {
+    visible.push_back(id);
+});
+@endcode
+
+## Memory layout
+
+Nodes are stored in a single array in depth-first order, the first child of an
+inner node is always the next node. Each node is a @ref Node structure with
+node bounds, index of second child or first item and item count, which is 32
+bytes for @ref Bvh3D "Bvh3D<Float>" and 24 bytes for
+@ref Bvh2D "Bvh2D<Float>". Item bounds are kept in a separate array in the same
+order as items in the leaves, so each leaf tests a contiguous range of boxes.
+
+Only 2D and 3D trees are supported.
+@see @ref Bvh2D, @ref Bvh3D
+*/
+template<UnsignedInt dimensions, class T> class Bvh {
+    static_assert(dimensions == 2 || dimensions == 3, "Math::Geometry::Bvh: only 2D and 3D trees are supported");
+
+    public:
+        /** @brief Vector type */
+        typedef typename Range<dimensions, T>::VectorType VectorType;
+
+        enum: UnsignedInt {
+            BinCount = 16,      /**< Count of bins used when building */
+            MaxDepth = 64       /**< Max depth of a leaf node */
+        };
+
+        /**
+         * @brief Tree node
+         *
+         * First child of inner node is always the next node in
+         * @ref nodes().
+         */
+        struct Node {
+            /** @brief Bounds of all items in the subtree */
+            Range<dimensions, T> bounds;
+
+            /**
+             * @brief Second child or first item
+             *
+             * Index of second child in @ref nodes() for inner nodes, index
+             * of first item in @ref items() for leaf nodes.
+             */
+            UnsignedInt offset;
+
+            /** @brief Item count for leaf nodes, `0` for inner nodes */
+            UnsignedInt count;
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty tree.
+         */
+        explicit Bvh() = default;
+
+        /**
+         * @brief Build the tree
+         * @param boxes         Item bounding boxes
+         * @param maxLeafSize   Max count of items in a leaf. Expected to be
+         *      non-zero.
+         */
+        explicit Bvh(Containers::ArrayView<const Range<dimensions, T>> boxes, UnsignedInt maxLeafSize = 4);
+
+        /** @brief Count of items */
+        std::size_t itemCount() const { return _items.size(); }
+
+        /**
+         * @brief Items
+         *
+         * Item IDs in order in which they are referenced from leaf nodes.
+         */
+        Containers::ArrayView<const UnsignedInt> items() const {
+            return {_items.data(), _items.size()};
+        }
+
+        /** @brief Count of nodes */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /** @brief Nodes */
+        Containers::ArrayView<const Node> nodes() const {
+            return {_nodes.data(), _nodes.size()};
+        }
+
+        /**
+         * @brief Bounds of all items
+         *
+         * Returns zero range if the tree is empty.
+         */
+        Range<dimensions, T> bounds() const {
+            return _nodes.empty() ? Range<dimensions, T>{} : _nodes.front().bounds;
+        }
+
+        /**
+         * @brief Update bounds of moved items
+         *
+         * Expects that @p boxes has the same size as the boxes the tree was
+         * built from. Updates bounds of all nodes without changing the tree
+         * structure, so the queries become slower if the items moved too
+         * much relative to each other.
+         */
+        void refit(Containers::ArrayView<const Range<dimensions, T>> boxes);
+
+        /**
+         * @brief Query items overlapping a range
+         *
+         * Calls @p callback with ID of each item whose bounding box overlaps
+         * @p range, including touching boxes.
+         */
+        template<class F> void queryRange(const Range<dimensions, T>& range, F callback) const;
+
+        /**
+         * @brief Query items inside a frustum
+         * @param planes    Frustum planes with normals pointing inside,
+         *      points @f$ \boldsymbol{p} @f$ for which
+         *      @f$ \boldsymbol{n} \cdot \boldsymbol{p} + d \ge 0 @f$ are
+         *      inside. There can be any count of planes, the planes don't
+         *      need to be normalized.
+         * @param callback  Called with ID of each item whose bounding box is
+         *      not fully outside of any plane
+         *
+         * The test is conservative, boxes near frustum corners might be
+         * reported even if they are not inside. Subtrees which are fully
+         * inside are reported without testing each item.
+         */
+        template<class F> void queryFrustum(Containers::ArrayView<const Vector<dimensions + 1, T>> planes, F callback) const;
+
+        /**
+         * @brief Query items hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction
+         * @param callback      Called with ID of each item whose bounding box
+         *      is hit by the ray between @p origin and @p maxDistance and
+         *      distance of the hit, in multiples of @p direction. Zero if
+         *      the origin is inside the box.
+         *
+         * Nearer subtrees are visited first, but the items are not sorted by
+         * distance.
+         */
+        template<class F> void queryRay(const VectorType& origin, const VectorType& direction, T maxDistance, F callback) const;
+
+    private:
+        static Range<dimensions, T> join(const Range<dimensions, T>& a, const Range<dimensions, T>& b) {
+            return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+        }
+
+        static void build(Containers::ArrayView<const Range<dimensions, T>> boxes, UnsignedInt* items, std::vector<Node>& nodes, UnsignedInt begin, UnsignedInt end, UnsignedInt depth, UnsignedInt maxLeafSize);
+
+        static bool outsidePlane(const Range<dimensions, T>& box, const Vector<dimensions + 1, T>& plane);
+        static bool insidePlane(const Range<dimensions, T>& box, const Vector<dimensions + 1, T>& plane);
+        static T rayDistance(const Range<dimensions, T>& box, const VectorType& origin, const VectorType& inverseDirection);
+
+        /* Item ranges of a subtree are contiguous */
+        template<class F> void forEachItem(UnsignedInt node, F callback) const;
+
+        std::vector<Node> _nodes;
+        std::vector<UnsignedInt> _items;
+        std::vector<Range<dimensions, T>> _itemBounds;
+};
+
+/**
+@brief Two-dimensional bounding volume hierarchy
+
+Convenience alternative to `Bvh<2, T>`. See @ref Bvh for more information.
+@see @ref Bvh3D
+*/
+template<class T> using Bvh2D = Bvh<2, T>;
+
+/**
+@brief Three-dimensional bounding volume hierarchy
+
+Convenience alternative to `Bvh<3, T>`. See @ref Bvh for more information.
+@see @ref Bvh2D
+*/
+template<class T> using Bvh3D = Bvh<3, T>;
+
+template<UnsignedInt dimensions, class T> Bvh<dimensions, T>::Bvh(const Containers::ArrayView<const Range<dimensions, T>> boxes, const UnsignedInt maxLeafSize): _items(boxes.size()) {
+    CORRADE_ASSERT(maxLeafSize,
+        "Math::Geometry::Bvh: max leaf size can't be zero", );
+
+    if(boxes.empty()) return;
+
+    for(std::size_t i = 0; i != _items.size(); ++i) _items[i] = i;
+    build(boxes, _items.data(), _nodes, 0, _items.size(), 0, maxLeafSize);
+
+    /* Item bounds in the same order as items in the leaves */
+    _itemBounds.reserve(_items.size());
+    for(const UnsignedInt id: _items) _itemBounds.push_back(boxes[id]);
+}
+
+template<UnsignedInt dimensions, class T> void Bvh<dimensions, T>::build(const Containers::ArrayView<const Range<dimensions, T>> boxes, UnsignedInt* const items, std::vector<Node>& nodes, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, const UnsignedInt maxLeafSize) {
+    /* The node is referenced by index, as children are added to the same
+       array */
+    const std::size_t index = nodes.size();
+    nodes.push_back({});
+
+    /* Bounds of the items and of their centers */
+    Range<dimensions, T> bounds = boxes[items[begin]];
+    Range<dimensions, T> centers{bounds.center(), bounds.center()};
+    for(UnsignedInt i = begin + 1; i != end; ++i) {
+        const Range<dimensions, T>& box = boxes[items[i]];
+        bounds = join(bounds, box);
+        centers = {Math::min(centers.min(), box.center()), Math::max(centers.max(), box.center())};
+    }
+    nodes[index].bounds = bounds;
+
+    /* Few enough items, make a leaf */
+    if(end - begin <= maxLeafSize) {
+        nodes[index].offset = begin;
+        nodes[index].count = end - begin;
+        return;
+    }
+
+    /* Split along the axis with largest spread of centers */
+    const VectorType extent = centers.size();
+    UnsignedInt axis = 0;
+    for(UnsignedInt i = 1; i != dimensions; ++i)
+        if(extent[i] > extent[axis]) axis = i;
+
+    /* All centers in the same point or the tree is getting too deep, split
+       at the median */
+    UnsignedInt middle;
+    if(extent[axis] == T(0) || depth >= MaxDepth/2) {
+        middle = begin + (end - begin)/2;
+        std::nth_element(items + begin, items + middle, items + end, [&](const UnsignedInt a, const UnsignedInt b) {
+            return boxes[a].center()[axis] < boxes[b].center()[axis];
+        });
+
+    /* Otherwise put the centers into bins and find split with lowest cost */
+    } else {
+        const T scale = T(BinCount)/extent[axis];
+        const T offset = centers.min()[axis];
+        const auto bin = [&](const Range<dimensions, T>& box) {
+            return Math::min(UnsignedInt((box.center()[axis] - offset)*scale), UnsignedInt(BinCount - 1));
+        };
+
+        Range<dimensions, T> binBounds[BinCount];
+        UnsignedInt binCounts[BinCount]{};
+        for(UnsignedInt i = begin; i != end; ++i) {
+            const Range<dimensions, T>& box = boxes[items[i]];
+            const UnsignedInt b = bin(box);
+            binBounds[b] = binCounts[b] ? join(binBounds[b], box) : box;
+            ++binCounts[b];
+        }
+
+        /* Area and count on the right of each split, split i puts bins
+           [0, i) to the left and [i, BinCount) to the right */
+        T rightAreas[BinCount];
+        UnsignedInt rightCounts[BinCount];
+        Range<dimensions, T> accumulated;
+        UnsignedInt accumulatedCount = 0;
+        for(UnsignedInt i = BinCount - 1; i != 0; --i) {
+            if(binCounts[i]) {
+                accumulated = accumulatedCount ? join(accumulated, binBounds[i]) : binBounds[i];
+                accumulatedCount += binCounts[i];
+            }
+            rightAreas[i] = Implementation::BvhTraits<dimensions, T>::halfArea(accumulated.size());
+            rightCounts[i] = accumulatedCount;
+        }
+
+        /* The first and the last bin are never empty, so some split is
+           always found */
+        T bestCost{};
+        UnsignedInt bestSplit = 0;
+        accumulatedCount = 0;
+        for(UnsignedInt i = 1; i != BinCount; ++i) {
+            if(binCounts[i - 1]) {
+                accumulated = accumulatedCount ? join(accumulated, binBounds[i - 1]) : binBounds[i - 1];
+                accumulatedCount += binCounts[i - 1];
+            }
+            if(!accumulatedCount || !rightCounts[i]) continue;
+
+            const T cost = Implementation::BvhTraits<dimensions, T>::halfArea(accumulated.size())*T(accumulatedCount) + rightAreas[i]*T(rightCounts[i]);
+            if(!bestSplit || cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+        CORRADE_INTERNAL_ASSERT(bestSplit);
+
+        middle = std::partition(items + begin, items + end, [&](const UnsignedInt id) {
+            return bin(boxes[id]) < bestSplit;
+        }) - items;
+    }
+
+    /* The first child directly follows the parent */
+    nodes[index].count = 0;
+    build(boxes, items, nodes, begin, middle, depth + 1, maxLeafSize);
+    nodes[index].offset = nodes.size();
+    build(boxes, items, nodes, middle, end, depth + 1, maxLeafSize);
+}
+
+template<UnsignedInt dimensions, class T> void Bvh<dimensions, T>::refit(const Containers::ArrayView<const Range<dimensions, T>> boxes) {
+    CORRADE_ASSERT(boxes.size() == _items.size(),
+        "Math::Geometry::Bvh::refit(): expected" << _items.size() << "boxes but got" << boxes.size(), );
+
+    for(std::size_t i = 0; i != _items.size(); ++i)
+        _itemBounds[i] = boxes[_items[i]];
+
+    /* Children are always after their parent, so going backwards updates
+       them first */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(node.count) {
+            node.bounds = _itemBounds[node.offset];
+            for(UnsignedInt j = node.offset + 1; j != node.offset + node.count; ++j)
+                node.bounds = join(node.bounds, _itemBounds[j]);
+        } else node.bounds = join(_nodes[i].bounds, _nodes[node.offset].bounds);
+    }
+}
+
+template<UnsignedInt dimensions, class T> template<class F> void Bvh<dimensions, T>::forEachItem(const UnsignedInt node, F callback) const {
+    UnsignedInt first = node, last = node;
+    while(!_nodes[first].count) ++first;
+    while(!_nodes[last].count) last = _nodes[last].offset;
+    for(UnsignedInt i = _nodes[first].offset, end = _nodes[last].offset + _nodes[last].count; i != end; ++i)
+        callback(_items[i]);
+}
+
+template<UnsignedInt dimensions, class T> template<class F> void Bvh<dimensions, T>::queryRange(const Range<dimensions, T>& range, F callback) const {
+    const auto overlaps = [&](const Range<dimensions, T>& box) {
+        return (box.min() <= range.max()).all() && (box.max() >= range.min()).all();
+    };
+
+    UnsignedInt stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    if(!_nodes.empty()) stack[stackSize++] = 0;
+    while(stackSize) {
+        const UnsignedInt index = stack[--stackSize];
+        const Node& node = _nodes[index];
+        if(!overlaps(node.bounds)) continue;
+
+        if(node.count) {
+            for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i)
+                if(overlaps(_itemBounds[i])) callback(_items[i]);
+        } else {
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = index + 1;
+        }
+    }
+}
+
+template<UnsignedInt dimensions, class T> inline bool Bvh<dimensions, T>::outsidePlane(const Range<dimensions, T>& box, const Vector<dimensions + 1, T>& plane) {
+    /* The corner furthest along the normal is outside */
+    T distance = plane[dimensions];
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        distance += plane[i]*(plane[i] >= T(0) ? box.max()[i] : box.min()[i]);
+    return distance < T(0);
+}
+
+template<UnsignedInt dimensions, class T> inline bool Bvh<dimensions, T>::insidePlane(const Range<dimensions, T>& box, const Vector<dimensions + 1, T>& plane) {
+    /* The corner furthest against the normal is inside */
+    T distance = plane[dimensions];
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        distance += plane[i]*(plane[i] >= T(0) ? box.min()[i] : box.max()[i]);
+    return distance >= T(0);
+}
+
+template<UnsignedInt dimensions, class T> template<class F> void Bvh<dimensions, T>::queryFrustum(const Containers::ArrayView<const Vector<dimensions + 1, T>> planes, F callback) const {
+    UnsignedInt stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    if(!_nodes.empty()) stack[stackSize++] = 0;
+    while(stackSize) {
+        const UnsignedInt index = stack[--stackSize];
+        const Node& node = _nodes[index];
+
+        bool outside = false, inside = true;
+        for(const Vector<dimensions + 1, T>& plane: planes) {
+            if(outsidePlane(node.bounds, plane)) {
+                outside = true;
+                break;
+            }
+            if(inside && !insidePlane(node.bounds, plane)) inside = false;
+        }
+        if(outside) continue;
+
+        /* The whole subtree is inside, no need to test anything else */
+        if(inside) {
+            forEachItem(index, callback);
+            continue;
+        }
+
+        if(node.count) {
+            for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i) {
+                bool itemOutside = false;
+                for(const Vector<dimensions + 1, T>& plane: planes) {
+                    if(outsidePlane(_itemBounds[i], plane)) {
+                        itemOutside = true;
+                        break;
+                    }
+                }
+                if(!itemOutside) callback(_items[i]);
+            }
+        } else {
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = index + 1;
+        }
+    }
+}
+
+template<UnsignedInt dimensions, class T> inline T Bvh<dimensions, T>::rayDistance(const Range<dimensions, T>& box, const VectorType& origin, const VectorType& inverseDirection) {
+    /* Slab test, returns infinity if the box is not hit */
+    const VectorType a = (box.min() - origin)*inverseDirection;
+    const VectorType b = (box.max() - origin)*inverseDirection;
+    const T near = Math::max(Math::min(a, b).max(), T(0));
+    const T far = Math::max(a, b).min();
+    return near <= far ? near : Constants<T>::inf();
+}
+
+template<UnsignedInt dimensions, class T> template<class F> void Bvh<dimensions, T>::queryRay(const VectorType& origin, const VectorType& direction, const T maxDistance, F callback) const {
+    const VectorType inverseDirection = VectorType{T(1)}/direction;
+
+    UnsignedInt stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    if(!_nodes.empty() && rayDistance(_nodes.front().bounds, origin, inverseDirection) <= maxDistance)
+        stack[stackSize++] = 0;
+    while(stackSize) {
+        const UnsignedInt index = stack[--stackSize];
+        const Node& node = _nodes[index];
+
+        if(node.count) {
+            for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i) {
+                const T distance = rayDistance(_itemBounds[i], origin, inverseDirection);
+                if(distance <= maxDistance) callback(_items[i], distance);
+            }
+            continue;
+        }
+
+        /* Push the farther child first so the nearer one is visited first */
+        UnsignedInt near = index + 1, far = node.offset;
+        T nearDistance = rayDistance(_nodes[near].bounds, origin, inverseDirection);
+        T farDistance = rayDistance(_nodes[far].bounds, origin, inverseDirection);
+        if(farDistance < nearDistance) {
+            std::swap(near, far);
+            std::swap(nearDistance, farDistance);
+        }
+        if(farDistance <= maxDistance) stack[stackSize++] = far;
+        if(nearDistance <= maxDistance) stack[stackSize++] = near;
+    }
+}
+
+}}}
+
+#endif
@@ -29,11 +29,49 @@
  * @brief Class @ref Magnum::Math::Geometry::Distance
  */
 
+#include <algorithm>
+#include <limits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Geometry {
 
+namespace Implementation {
+    /* Makes the parameter a non-deduced context, so e.g. a view on mutable
+       data can be passed where a const view is expected */
+    template<class T> struct NonDeduced { typedef T Type; };
+
+    enum: std::size_t { PointBlockSize = 64 };
+
+    /* Calls f(offset, count, x, y, z) for consecutive blocks of the points,
+       with the coordinates split into separate arrays so the per-point loops
+       over them can be vectorized */
+    template<class T, class F> void forEachPointBlock(const Containers::ArrayView<const Vector3<T>> points, F f) {
+        T x[PointBlockSize], y[PointBlockSize], z[PointBlockSize];
+        for(std::size_t offset = 0; offset < points.size(); offset += PointBlockSize) {
+            const std::size_t count = std::min(std::size_t(PointBlockSize), points.size() - offset);
+            for(std::size_t i = 0; i != count; ++i) {
+                x[i] = points[offset + i].x();
+                y[i] = points[offset + i].y();
+                z[i] = points[offset + i].z();
+            }
+            f(offset, count, x, y, z);
+        }
+    }
+
+    /* Branch-free variant of lineSegmentPointSquared() working on
+       precomputed segment data */
+    template<class T> inline T lineSegmentPointSquared(const Vector3<T>& a, const Vector3<T>& bMinusA, const T inverseLengthSquared, const T x, const T y, const T z) {
+        const T pax = x - a.x(), pay = y - a.y(), paz = z - a.z();
+        const T t = std::min(std::max((pax*bMinusA.x() + pay*bMinusA.y() + paz*bMinusA.z())*inverseLengthSquared, T(0)), T(1));
+        const T dx = pax - t*bMinusA.x(), dy = pay - t*bMinusA.y(), dz = paz - t*bMinusA.z();
+        return dx*dx + dy*dy + dz*dz;
+    }
+}
+
 /** @brief Functions for computing distances */
 class Distance {
     public:
@@ -162,6 +200,93 @@ class Distance {
          * the square root.
          */
         template<class T> static T lineSegmentPointSquared(const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& point);
+
+        /**
+         * @brief Distances of line and points in 3D, squared
+         * @param a         First point of the line
+         * @param b         Second point of the line
+         * @param points    Points
+         * @param[out] out  Where to put squared distances. Expected to have
+         *      the same size as @p points.
+         *
+         * Equivalent to calling @ref linePointSquared(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&)
+         * for each point, but processes the points in blocks with
+         * coordinates in separate arrays, which the compiler can vectorize.
+         * The function has no shared state, so large inputs can be split
+         * across multiple threads by calling it on disjoint slices of the
+         * views.
+         */
+        template<class T> static void linePointSquared(const Vector3<T>& a, const Vector3<T>& b, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out);
+
+        /**
+         * @brief Distances of line segment and points in 3D, squared
+         * @param a         Starting point of the line
+         * @param b         Ending point of the line
+         * @param points    Points
+         * @param[out] out  Where to put squared distances. Expected to have
+         *      the same size as @p points.
+         *
+         * Equivalent to calling @ref lineSegmentPointSquared(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&)
+         * for each point, but processes the points in blocks with
+         * coordinates in separate arrays, which the compiler can vectorize.
+         * Unlike the single-point variant, the position on the segment is
+         * found by clamping the projection, which avoids branching. The
+         * function has no shared state, so large inputs can be split across
+         * multiple threads by calling it on disjoint slices of the views.
+         */
+        template<class T> static void lineSegmentPointSquared(const Vector3<T>& a, const Vector3<T>& b, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out);
+
+        /**
+         * @brief Signed distance of point from plane
+         * @param planePosition Plane position
+         * @param planeNormal   Plane normal
+         * @param point         Point
+         *
+         * Positive if the point lies on the side the normal points to. The
+         * normal doesn't need to be normalized. @f[
+         *      d = \frac{\boldsymbol n \cdot (\boldsymbol p - \boldsymbol p_0)}{|\boldsymbol n|}
+         * @f]
+         */
+        template<class T> static T planePoint(const Vector3<T>& planePosition, const Vector3<T>& planeNormal, const Vector3<T>& point) {
+            return dot(planeNormal, point - planePosition)/planeNormal.length();
+        }
+
+        /**
+         * @brief Signed distances of points from plane
+         * @param planePosition Plane position
+         * @param planeNormal   Plane normal
+         * @param points        Points
+         * @param[out] out      Where to put signed distances. Expected to
+         *      have the same size as @p points.
+         *
+         * Equivalent to calling @ref planePoint(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&)
+         * for each point, see @ref linePointSquared(const Vector3<T>&, const Vector3<T>&, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>>, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type>)
+         * for more information.
+         */
+        template<class T> static void planePoint(const Vector3<T>& planePosition, const Vector3<T>& planeNormal, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out);
+
+        /**
+         * @brief Nearest line segment for each point in 3D
+         * @param a         Starting points of the line segments
+         * @param b         Ending points of the line segments. Expected to
+         *      have the same size as @p a.
+         * @param points    Points
+         * @param[out] segments Where to put index of the nearest segment for
+         *      each point. Expected to have the same size as @p points.
+         * @param[out] distancesSquared Where to put squared distance to the
+         *      nearest segment. Optional, if non-empty, expected to have the
+         *      same size as @p points.
+         *
+         * Fused equivalent of calling
+         * @ref lineSegmentPointSquared(const Vector3<T>&, const Vector3<T>&, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>>, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type>)
+         * for each segment and picking the minimum. Each block of points is
+         * tested against all segments while it's in cache, without any
+         * temporary per-segment distance arrays. If there are no segments,
+         * all indices are set to `0xffffffffu` and distances to
+         * infinity. If more segments are at the same distance, the first one
+         * is picked.
+         */
+        template<class T> static void nearestLineSegmentPoint(Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> a, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> b, Containers::ArrayView<const Vector3<T>> points, Containers::ArrayView<UnsignedInt> segments, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> distancesSquared = nullptr);
 };
 
 template<class T> T Distance::lineSegmentPoint(const Vector2<T>& a, const Vector2<T>& b, const Vector2<T>& point) {
@@ -223,6 +348,81 @@ template<class T> T Distance::lineSegmentPointSquared(const Vector3<T>& a, const
     return cross(pointMinusA, pointMinusB).dot()/bDistanceA;
 }
 
+template<class T> void Distance::linePointSquared(const Vector3<T>& a, const Vector3<T>& b, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, const Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out) {
+    CORRADE_ASSERT(points.size() == out.size(),
+        "Math::Geometry::Distance::linePointSquared(): expected" << points.size() << "output items but got" << out.size(), );
+
+    const T inverseLengthSquared = T(1)/(b - a).dot();
+    Implementation::forEachPointBlock(points, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        for(std::size_t i = 0; i != count; ++i) {
+            const T pax = x[i] - a.x(), pay = y[i] - a.y(), paz = z[i] - a.z();
+            const T pbx = x[i] - b.x(), pby = y[i] - b.y(), pbz = z[i] - b.z();
+            const T cx = pay*pbz - paz*pby;
+            const T cy = paz*pbx - pax*pbz;
+            const T cz = pax*pby - pay*pbx;
+            out[offset + i] = (cx*cx + cy*cy + cz*cz)*inverseLengthSquared;
+        }
+    });
+}
+
+template<class T> void Distance::lineSegmentPointSquared(const Vector3<T>& a, const Vector3<T>& b, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, const Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out) {
+    CORRADE_ASSERT(points.size() == out.size(),
+        "Math::Geometry::Distance::lineSegmentPointSquared(): expected" << points.size() << "output items but got" << out.size(), );
+
+    /* Degenerate segment is treated as a point */
+    const Vector3<T> bMinusA = b - a;
+    const T lengthSquared = bMinusA.dot();
+    const T inverseLengthSquared = lengthSquared == T(0) ? T(0) : T(1)/lengthSquared;
+    Implementation::forEachPointBlock(points, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        for(std::size_t i = 0; i != count; ++i)
+            out[offset + i] = Implementation::lineSegmentPointSquared(a, bMinusA, inverseLengthSquared, x[i], y[i], z[i]);
+    });
+}
+
+template<class T> void Distance::planePoint(const Vector3<T>& planePosition, const Vector3<T>& planeNormal, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> points, const Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out) {
+    CORRADE_ASSERT(points.size() == out.size(),
+        "Math::Geometry::Distance::planePoint(): expected" << points.size() << "output items but got" << out.size(), );
+
+    const Vector3<T> n = planeNormal/planeNormal.length();
+    const T f = dot(n, planePosition);
+    Implementation::forEachPointBlock(points, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        for(std::size_t i = 0; i != count; ++i)
+            out[offset + i] = n.x()*x[i] + n.y()*y[i] + n.z()*z[i] - f;
+    });
+}
+
+template<class T> void Distance::nearestLineSegmentPoint(const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> a, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> b, const Containers::ArrayView<const Vector3<T>> points, const Containers::ArrayView<UnsignedInt> segments, const Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> distancesSquared) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::Geometry::Distance::nearestLineSegmentPoint(): expected" << a.size() << "segment ending points but got" << b.size(), );
+    CORRADE_ASSERT(points.size() == segments.size() && (distancesSquared.empty() || points.size() == distancesSquared.size()),
+        "Math::Geometry::Distance::nearestLineSegmentPoint(): expected" << points.size() << "output items but got" << segments.size() << "and" << distancesSquared.size(), );
+
+    Implementation::forEachPointBlock(points, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        T nearest[Implementation::PointBlockSize];
+        UnsignedInt nearestSegment[Implementation::PointBlockSize];
+        for(std::size_t i = 0; i != count; ++i) {
+            nearest[i] = std::numeric_limits<T>::infinity();
+            nearestSegment[i] = 0xffffffffu;
+        }
+
+        for(std::size_t segment = 0; segment != a.size(); ++segment) {
+            const Vector3<T> bMinusA = b[segment] - a[segment];
+            const T lengthSquared = bMinusA.dot();
+            const T inverseLengthSquared = lengthSquared == T(0) ? T(0) : T(1)/lengthSquared;
+            for(std::size_t i = 0; i != count; ++i) {
+                const T distance = Implementation::lineSegmentPointSquared(a[segment], bMinusA, inverseLengthSquared, x[i], y[i], z[i]);
+                const bool closer = distance < nearest[i];
+                nearest[i] = closer ? distance : nearest[i];
+                nearestSegment[i] = closer ? UnsignedInt(segment) : nearestSegment[i];
+            }
+        }
+
+        std::copy(nearestSegment, nearestSegment + count, segments.begin() + offset);
+        if(!distancesSquared.empty())
+            std::copy(nearest, nearest + count, distancesSquared.begin() + offset);
+    });
+}
+
 }}}
 
 #endif
@@ -29,7 +29,11 @@
  * @brief Class @ref Magnum::Math::Geometry::Intersection
  */
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Geometry/Distance.h"
 
 namespace Magnum { namespace Math { namespace Geometry {
 
@@ -123,8 +127,43 @@ class Intersection {
             const T f = dot(planePosition, planeNormal);
             return (f-dot(planeNormal, p))/dot(planeNormal, r);
         }
+
+        /**
+         * @brief Intersections of a plane and lines
+         * @param planePosition Plane position
+         * @param planeNormal   Plane normal
+         * @param p             Starting points of the lines
+         * @param r             Directions of the lines. Expected to have the
+         *      same size as @p p.
+         * @param[out] out      Where to put intersection point positions.
+         *      Expected to have the same size as @p p.
+         *
+         * Equivalent to calling @ref planeLine(const Vector3<T>&, const Vector3<T>&, const Vector3<T>&, const Vector3<T>&)
+         * for each line, but processes the lines in blocks with coordinates
+         * in separate arrays, which the compiler can vectorize. The function
+         * has no shared state, so large inputs can be split across multiple
+         * threads by calling it on disjoint slices of the views.
+         */
+        template<class T> static void planeLine(const Vector3<T>& planePosition, const Vector3<T>& planeNormal, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> p, Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> r, Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out);
 };
 
+template<class T> void Intersection::planeLine(const Vector3<T>& planePosition, const Vector3<T>& planeNormal, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> p, const Containers::ArrayView<const Vector3<typename Implementation::NonDeduced<T>::Type>> r, const Containers::ArrayView<typename Implementation::NonDeduced<T>::Type> out) {
+    CORRADE_ASSERT(p.size() == r.size() && p.size() == out.size(),
+        "Math::Geometry::Intersection::planeLine(): expected views of the same size but got" << p.size() << r.size() << "and" << out.size(), );
+
+    /* First calculate the denominators, then divide the numerators in the
+       second pass, so the directions don't need a separate block */
+    const T f = dot(planePosition, planeNormal);
+    Implementation::forEachPointBlock(r, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        for(std::size_t i = 0; i != count; ++i)
+            out[offset + i] = planeNormal.x()*x[i] + planeNormal.y()*y[i] + planeNormal.z()*z[i];
+    });
+    Implementation::forEachPointBlock(p, [&](const std::size_t offset, const std::size_t count, const T* x, const T* y, const T* z) {
+        for(std::size_t i = 0; i != count; ++i)
+            out[offset + i] = (f - (planeNormal.x()*x[i] + planeNormal.y()*y[i] + planeNormal.z()*z[i]))/out[offset + i];
+    });
+}
+
 }}}
 
 #endif
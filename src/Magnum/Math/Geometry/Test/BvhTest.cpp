@@ -0,0 +1,306 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Geometry/Bvh.h"
+
+namespace Magnum { namespace Math { namespace Geometry { namespace Test {
+
+struct BvhTest: Corrade::TestSuite::Tester {
+    explicit BvhTest();
+
+    void nodeSize();
+    void constructEmpty();
+    void construct();
+    void constructLarge();
+    void constructSameCenter();
+    void constructZeroLeafSize();
+    void refit();
+    void refitWrongSize();
+
+    void queryRange();
+    void queryRange2D();
+    void queryFrustum();
+    void queryRay();
+};
+
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Range2D<Float> Range2D;
+typedef Math::Range3D<Float> Range3D;
+
+BvhTest::BvhTest() {
+    addTests({&BvhTest::nodeSize,
+              &BvhTest::constructEmpty,
+              &BvhTest::construct,
+              &BvhTest::constructLarge,
+              &BvhTest::constructSameCenter,
+              &BvhTest::constructZeroLeafSize,
+              &BvhTest::refit,
+              &BvhTest::refitWrongSize,
+
+              &BvhTest::queryRange,
+              &BvhTest::queryRange2D,
+              &BvhTest::queryFrustum,
+              &BvhTest::queryRay});
+}
+
+namespace {
+
+/* Grid of 10x10x10 boxes of size 0.5 at integer positions */
+std::vector<Range3D> grid() {
+    std::vector<Range3D> boxes;
+    for(Int z = 0; z != 10; ++z)
+        for(Int y = 0; y != 10; ++y)
+            for(Int x = 0; x != 10; ++x)
+                boxes.push_back(Range3D::fromSize(Vector3(Float(x), Float(y), Float(z)), Vector3(0.5f)));
+    return boxes;
+}
+
+/* Verifies that the nodes contain their children and that each item is in
+   exactly one leaf */
+template<UnsignedInt dimensions> bool isValid(const Bvh<dimensions, Float>& bvh, const std::vector<Range<dimensions, Float>>& boxes, UnsignedInt maxLeafSize) {
+    const auto contains = [](const Range<dimensions, Float>& a, const Range<dimensions, Float>& b) {
+        return (a.min() <= b.min()).all() && (a.max() >= b.max()).all();
+    };
+
+    std::vector<UnsignedInt> referenced(boxes.size());
+    for(std::size_t i = 0; i != bvh.nodeCount(); ++i) {
+        const typename Bvh<dimensions, Float>::Node& node = bvh.nodes()[i];
+        if(node.count) {
+            if(node.count > maxLeafSize) return false;
+            for(UnsignedInt j = node.offset; j != node.offset + node.count; ++j) {
+                const UnsignedInt id = bvh.items()[j];
+                if(!contains(node.bounds, boxes[id])) return false;
+                ++referenced[id];
+            }
+        } else {
+            if(node.offset <= i + 1 || node.offset >= bvh.nodeCount()) return false;
+            if(!contains(node.bounds, bvh.nodes()[i + 1].bounds) ||
+               !contains(node.bounds, bvh.nodes()[node.offset].bounds)) return false;
+        }
+    }
+
+    return std::all_of(referenced.begin(), referenced.end(), [](UnsignedInt count) { return count == 1; });
+}
+
+}
+
+void BvhTest::nodeSize() {
+    CORRADE_COMPARE(sizeof(Bvh3D<Float>::Node), 32);
+    CORRADE_COMPARE(sizeof(Bvh2D<Float>::Node), 24);
+}
+
+void BvhTest::constructEmpty() {
+    Bvh3D<Float> bvh;
+    CORRADE_COMPARE(bvh.itemCount(), 0);
+    CORRADE_COMPARE(bvh.nodeCount(), 0);
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+
+    Bvh3D<Float> bvh2{nullptr};
+    CORRADE_COMPARE(bvh2.itemCount(), 0);
+    CORRADE_COMPARE(bvh2.nodeCount(), 0);
+
+    /* Queries don't crash */
+    std::size_t count = 0;
+    bvh.queryRange({{}, Vector3{1.0f}}, [&](UnsignedInt) { ++count; });
+    CORRADE_COMPARE(count, 0);
+}
+
+void BvhTest::construct() {
+    const std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+
+    CORRADE_COMPARE(bvh.itemCount(), 1000);
+    CORRADE_COMPARE(bvh.bounds(), Range3D({}, {9.5f, 9.5f, 9.5f}));
+    CORRADE_VERIFY(bvh.nodeCount() >= 2*1000/4 - 1);
+    CORRADE_VERIFY(isValid<3>(bvh, {boxes.begin(), boxes.end()}, 4));
+}
+
+void BvhTest::constructLarge() {
+    std::vector<Range3D> boxes;
+    for(Int i = 0; i != 20000; ++i)
+        boxes.push_back(Range3D::fromSize(Vector3(Float(i%37), Float(i%101), Float(i%29)), Vector3(0.5f)));
+
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+    CORRADE_COMPARE(bvh.itemCount(), 20000);
+    CORRADE_VERIFY(isValid<3>(bvh, {boxes.begin(), boxes.end()}, 4));
+}
+
+void BvhTest::constructSameCenter() {
+    /* All centers are the same, split at the median */
+    std::vector<Range3D> boxes;
+    for(Int i = 0; i != 100; ++i)
+        boxes.push_back(Range3D{Vector3(-Float(i)), Vector3(Float(i))});
+
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+    CORRADE_VERIFY(isValid<3>(bvh, {boxes.begin(), boxes.end()}, 4));
+}
+
+void BvhTest::constructZeroLeafSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Range3D box;
+    Bvh3D<Float> bvh{{&box, 1}, 0};
+    CORRADE_COMPARE(out.str(), "Math::Geometry::Bvh: max leaf size can't be zero\n");
+}
+
+void BvhTest::refit() {
+    std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+    const std::size_t nodeCount = bvh.nodeCount();
+
+    /* Move all boxes, the structure stays the same */
+    for(Range3D& box: boxes) box = box.translated({0.0f, 0.0f, 5.0f});
+    boxes[0] = boxes[0].translated({-20.0f, 0.0f, 0.0f});
+    bvh.refit({boxes.data(), boxes.size()});
+    CORRADE_COMPARE(bvh.nodeCount(), nodeCount);
+    CORRADE_COMPARE(bvh.bounds(), Range3D({-20.0f, 0.0f, 5.0f}, {9.5f, 9.5f, 14.5f}));
+    CORRADE_VERIFY(isValid<3>(bvh, {boxes.begin(), boxes.end()}, 4));
+
+    /* Queries see the new positions */
+    std::vector<UnsignedInt> found;
+    bvh.queryRange({{-20.0f, 0.0f, 5.0f}, {-19.0f, 1.0f, 6.0f}}, [&](UnsignedInt id) {
+        found.push_back(id);
+    });
+    CORRADE_COMPARE_AS(found, std::vector<UnsignedInt>{0},
+        TestSuite::Compare::Container);
+}
+
+void BvhTest::refitWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+    bvh.refit({boxes.data(), 10});
+    CORRADE_COMPARE(out.str(), "Math::Geometry::Bvh::refit(): expected 1000 boxes but got 10\n");
+}
+
+void BvhTest::queryRange() {
+    const std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+
+    /* Touching boxes are included as well */
+    const Range3D range{{1.25f, 2.5f, 0.0f}, {3.0f, 3.75f, 0.25f}};
+    std::vector<UnsignedInt> found, expected;
+    bvh.queryRange(range, [&](UnsignedInt id) { found.push_back(id); });
+    for(std::size_t i = 0; i != boxes.size(); ++i)
+        if((boxes[i].min() <= range.max()).all() && (boxes[i].max() >= range.min()).all())
+            expected.push_back(i);
+
+    std::sort(found.begin(), found.end());
+    CORRADE_COMPARE(expected.size(), 6);
+    CORRADE_COMPARE_AS(found, expected, TestSuite::Compare::Container);
+}
+
+void BvhTest::queryRange2D() {
+    std::vector<Range2D> boxes;
+    for(Int y = 0; y != 10; ++y)
+        for(Int x = 0; x != 10; ++x)
+            boxes.push_back(Range2D::fromSize(Vector2(Float(x), Float(y)), Vector2(0.5f)));
+
+    Bvh2D<Float> bvh{{boxes.data(), boxes.size()}, 2};
+    CORRADE_VERIFY(isValid<2>(bvh, {boxes.begin(), boxes.end()}, 2));
+
+    std::vector<UnsignedInt> found;
+    bvh.queryRange({{3.75f, 5.25f}, {4.25f, 5.75f}}, [&](UnsignedInt id) { found.push_back(id); });
+    CORRADE_COMPARE_AS(found, std::vector<UnsignedInt>{54},
+        TestSuite::Compare::Container);
+}
+
+void BvhTest::queryFrustum() {
+    const std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+
+    /* An oblique slab x + y in [2, 6], restricted to z <= 2. Plane normals
+       point inside. */
+    const Vector4 planes[]{
+        { 1.0f,  1.0f,  0.0f, -2.0f},
+        {-1.0f, -1.0f,  0.0f,  6.0f},
+        { 0.0f,  0.0f, -1.0f,  2.0f}
+    };
+
+    std::vector<UnsignedInt> found, expected;
+    bvh.queryFrustum(planes, [&](UnsignedInt id) { found.push_back(id); });
+
+    /* A box is outside if its max x + y is below 2, its min x + y is above 6
+       or its min z is above 2 */
+    for(std::size_t i = 0; i != boxes.size(); ++i) {
+        const Range3D& box = boxes[i];
+        if(box.max().x() + box.max().y() < 2.0f ||
+           box.min().x() + box.min().y() > 6.0f ||
+           box.min().z() > 2.0f) continue;
+        expected.push_back(i);
+    }
+
+    std::sort(found.begin(), found.end());
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_COMPARE_AS(found, expected, TestSuite::Compare::Container);
+}
+
+void BvhTest::queryRay() {
+    const std::vector<Range3D> boxes = grid();
+    Bvh3D<Float> bvh{{boxes.data(), boxes.size()}, 4};
+
+    /* Going along the first row, hitting the boxes at distance 1 + x */
+    std::vector<std::pair<UnsignedInt, Float>> found;
+    bvh.queryRay({-1.0f, 0.25f, 0.25f}, {1.0f, 0.0f, 0.0f}, 5.5f, [&](UnsignedInt id, Float distance) {
+        found.emplace_back(id, distance);
+    });
+    std::sort(found.begin(), found.end());
+    CORRADE_COMPARE_AS(found, (std::vector<std::pair<UnsignedInt, Float>>{
+        {0, 1.0f}, {1, 2.0f}, {2, 3.0f}, {3, 4.0f}, {4, 5.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Origin inside a box, non-normalized direction going up */
+    found.clear();
+    bvh.queryRay({9.25f, 9.25f, 3.25f}, {0.0f, 0.0f, 2.0f}, 1.0f, [&](UnsignedInt id, Float distance) {
+        found.emplace_back(id, distance);
+    });
+    std::sort(found.begin(), found.end());
+    CORRADE_COMPARE_AS(found, (std::vector<std::pair<UnsignedInt, Float>>{
+        {399, 0.0f}, {499, 0.375f}, {599, 0.875f}
+    }), TestSuite::Compare::Container);
+
+    /* Missing everything */
+    found.clear();
+    bvh.queryRay({-1.0f, 0.75f, 0.25f}, {1.0f, 0.0f, 0.0f}, 100.0f, [&](UnsignedInt id, Float distance) {
+        found.emplace_back(id, distance);
+    });
+    CORRADE_VERIFY(found.empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::BvhTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Constants.h"
@@ -37,6 +39,13 @@ struct DistanceTest: Corrade::TestSuite::Tester {
     void linePoint3D();
     void lineSegmentPoint2D();
     void lineSegmentPoint3D();
+    void planePoint();
+
+    void linePointBatch();
+    void lineSegmentPointBatch();
+    void planePointBatch();
+    void nearestLineSegmentPoint();
+    void nearestLineSegmentPointNoSegments();
 };
 
 typedef Math::Vector2<Float> Vector2;
@@ -47,7 +56,14 @@ DistanceTest::DistanceTest() {
     addTests({&DistanceTest::linePoint2D,
               &DistanceTest::linePoint3D,
               &DistanceTest::lineSegmentPoint2D,
-              &DistanceTest::lineSegmentPoint3D});
+              &DistanceTest::lineSegmentPoint3D,
+              &DistanceTest::planePoint,
+
+              &DistanceTest::linePointBatch,
+              &DistanceTest::lineSegmentPointBatch,
+              &DistanceTest::planePointBatch,
+              &DistanceTest::nearestLineSegmentPoint,
+              &DistanceTest::nearestLineSegmentPointNoSegments});
 }
 
 void DistanceTest::linePoint2D() {
@@ -156,6 +172,104 @@ void DistanceTest::lineSegmentPoint3D() {
                     Constants::sqrt2());
 }
 
+void DistanceTest::planePoint() {
+    const Vector3 position{0.0f, 2.0f, 0.0f};
+    const Vector3 normal{0.0f, 3.0f, 0.0f};
+
+    CORRADE_COMPARE(Distance::planePoint(position, normal, Vector3{5.0f, 2.0f, -1.0f}), 0.0f);
+    CORRADE_COMPARE(Distance::planePoint(position, normal, Vector3{5.0f, 4.5f, -1.0f}), 2.5f);
+    CORRADE_COMPARE(Distance::planePoint(position, normal, Vector3{5.0f, 1.0f, -1.0f}), -1.0f);
+}
+
+namespace {
+    /* More than one block with an incomplete one at the end */
+    std::vector<Vector3> points() {
+        std::vector<Vector3> out;
+        for(std::size_t i = 0; i != 150; ++i)
+            out.emplace_back(Float(i%7) - 3.0f, Float(i%11)*0.5f - 2.0f, Float(i%5) - 1.5f);
+        return out;
+    }
+}
+
+void DistanceTest::linePointBatch() {
+    const Vector3 a{0.0f};
+    const Vector3 b{1.0f, 2.0f, 0.5f};
+    const std::vector<Vector3> input = points();
+    std::vector<Float> out(input.size());
+
+    Distance::linePointSquared(a, b, {input.data(), input.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != input.size(); ++i)
+        CORRADE_COMPARE(out[i], Distance::linePointSquared(a, b, input[i]));
+}
+
+void DistanceTest::lineSegmentPointBatch() {
+    const Vector3 a{0.0f};
+    const Vector3 b{1.0f, 2.0f, 0.5f};
+    const std::vector<Vector3> input = points();
+    std::vector<Float> out(input.size());
+
+    Distance::lineSegmentPointSquared(a, b, {input.data(), input.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != input.size(); ++i)
+        CORRADE_COMPARE(out[i], Distance::lineSegmentPointSquared(a, b, input[i]));
+
+    /* Degenerate segment is a point */
+    Distance::lineSegmentPointSquared(b, b, {input.data(), input.size()}, {out.data(), out.size()});
+    for(std::size_t i = 0; i != input.size(); ++i)
+        CORRADE_COMPARE(out[i], (input[i] - b).dot());
+}
+
+void DistanceTest::planePointBatch() {
+    const Vector3 position{0.0f, 2.0f, 0.0f};
+    const Vector3 normal{1.0f, 3.0f, -0.5f};
+    const std::vector<Vector3> input = points();
+    std::vector<Float> out(input.size());
+
+    Distance::planePoint(position, normal, {input.data(), input.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != input.size(); ++i)
+        CORRADE_COMPARE(out[i], Distance::planePoint(position, normal, input[i]));
+}
+
+void DistanceTest::nearestLineSegmentPoint() {
+    const Vector3 a[]{{-3.0f, 0.0f, 0.0f}, {0.0f, -2.0f, 1.0f}, {2.0f, 2.0f, 2.0f}};
+    const Vector3 b[]{{3.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 1.0f}, {2.0f, 2.0f, 2.0f}};
+    const std::vector<Vector3> input = points();
+    std::vector<UnsignedInt> segments(input.size());
+    std::vector<Float> distances(input.size());
+
+    Distance::nearestLineSegmentPoint<Float>(a, b, {input.data(), input.size()}, {segments.data(), segments.size()}, {distances.data(), distances.size()});
+
+    /* The last segment is degenerate, which the single-point variant can't
+       handle */
+    auto distance = [&](const UnsignedInt segment, const Vector3& point) {
+        return segment == 2 ? (point - a[segment]).dot() : Distance::lineSegmentPointSquared(a[segment], b[segment], point);
+    };
+
+    for(std::size_t i = 0; i != input.size(); ++i) {
+        const Float expected = std::min({distance(0, input[i]), distance(1, input[i]), distance(2, input[i])});
+        CORRADE_COMPARE(distances[i], expected);
+        CORRADE_VERIFY(segments[i] < 3);
+        CORRADE_COMPARE(distance(segments[i], input[i]), expected);
+    }
+
+    /* Distances are optional */
+    std::vector<UnsignedInt> segments2(input.size());
+    Distance::nearestLineSegmentPoint<Float>(a, b, {input.data(), input.size()}, {segments2.data(), segments2.size()});
+    CORRADE_VERIFY(segments2 == segments);
+}
+
+void DistanceTest::nearestLineSegmentPointNoSegments() {
+    const Vector3 input[]{{1.0f, 2.0f, 3.0f}};
+    UnsignedInt segments[1];
+    Float distances[1];
+
+    Distance::nearestLineSegmentPoint<Float>(nullptr, nullptr, input, segments, distances);
+    CORRADE_COMPARE(segments[0], 0xffffffffu);
+    CORRADE_COMPARE(distances[0], Constants::inf());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::DistanceTest)
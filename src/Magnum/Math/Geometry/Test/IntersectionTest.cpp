@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Geometry/Intersection.h"
@@ -33,6 +34,7 @@ struct IntersectionTest: Corrade::TestSuite::Tester {
     explicit IntersectionTest();
 
     void planeLine();
+    void planeLineBatch();
     void lineLine();
 };
 
@@ -42,6 +44,7 @@ typedef Math::Constants<Float> Constants;
 
 IntersectionTest::IntersectionTest() {
     addTests({&IntersectionTest::planeLine,
+              &IntersectionTest::planeLineBatch,
               &IntersectionTest::lineLine});
 }
 
@@ -66,6 +69,24 @@ void IntersectionTest::planeLine() {
         {1.0f, 0.0f, 1.0f}, {-1.0f, 0.0f, 0.0f}), -Constants::inf());
 }
 
+void IntersectionTest::planeLineBatch() {
+    const Vector3 planePosition(-1.0f, 1.0f, 0.5f);
+    const Vector3 planeNormal(0.0f, 0.5f, 1.0f);
+
+    /* More than one block with an incomplete one at the end */
+    std::vector<Vector3> p, r;
+    for(std::size_t i = 0; i != 100; ++i) {
+        p.emplace_back(Float(i%3), Float(i%7) - 3.0f, -1.0f);
+        r.emplace_back(0.5f, Float(i%5) - 2.0f, Float(i%4) + 1.0f);
+    }
+    std::vector<Float> out(p.size());
+
+    Intersection::planeLine(planePosition, planeNormal, {p.data(), p.size()}, {r.data(), r.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != p.size(); ++i)
+        CORRADE_COMPARE(out[i], Intersection::planeLine(planePosition, planeNormal, p[i], r[i]));
+}
+
 void IntersectionTest::lineLine() {
     const Vector2 p(-1.0f, -1.0f);
     const Vector2 r(1.0, 2.0f);
@@ -0,0 +1,145 @@
+#ifndef Magnum_Math_Implementation_Simd_h
+#define Magnum_Math_Implementation_Simd_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* SIMD kernels for Float four-component vectors, 4x4 matrices and
+   quaternions. Everything operates on plain Float arrays so the math classes
+   stay layout-compatible with their scalar versions. The instruction set is
+   picked from the compiler flags (e.g. -msse2, -mfma or -mfpu=neon), defining
+   MAGNUM_MATH_NO_SIMD before including any Math header disables it. */
+
+#include "Magnum/Types.h"
+
+#ifndef MAGNUM_MATH_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAGNUM_MATH_SIMD_SSE2
+#include <emmintrin.h>
+#ifdef __FMA__
+#define MAGNUM_MATH_SIMD_FMA
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAGNUM_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(MAGNUM_MATH_SIMD_SSE2) || defined(MAGNUM_MATH_SIMD_NEON)
+#define MAGNUM_MATH_SIMD
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation { namespace Simd {
+
+#ifdef MAGNUM_MATH_SIMD_SSE2
+/* a*b + c */
+inline __m128 multiplyAdd(const __m128 a, const __m128 b, const __m128 c) {
+    #ifdef MAGNUM_MATH_SIMD_FMA
+    return _mm_fmadd_ps(a, b, c);
+    #else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+}
+
+/* Column-major 4x4 matrix times a four-component column. The order of
+   additions is the same as in the scalar loop, so without FMA the result is
+   bit-exact. */
+inline __m128 multiplyColumn(const Float* const a, const Float* const column) {
+    __m128 out = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(column[0]));
+    out = multiplyAdd(_mm_loadu_ps(a + 4), _mm_set1_ps(column[1]), out);
+    out = multiplyAdd(_mm_loadu_ps(a + 8), _mm_set1_ps(column[2]), out);
+    return multiplyAdd(_mm_loadu_ps(a + 12), _mm_set1_ps(column[3]), out);
+}
+
+inline void multiplyMatrix4(const Float* const a, const Float* const b, Float* const out) {
+    /* Computing all columns first in case out aliases any of the inputs */
+    const __m128 c0 = multiplyColumn(a, b);
+    const __m128 c1 = multiplyColumn(a, b + 4);
+    const __m128 c2 = multiplyColumn(a, b + 8);
+    const __m128 c3 = multiplyColumn(a, b + 12);
+    _mm_storeu_ps(out, c0);
+    _mm_storeu_ps(out + 4, c1);
+    _mm_storeu_ps(out + 8, c2);
+    _mm_storeu_ps(out + 12, c3);
+}
+
+inline void multiplyMatrix4Vector4(const Float* const a, const Float* const b, Float* const out) {
+    _mm_storeu_ps(out, multiplyColumn(a, b));
+}
+
+/* Hamilton product of two XYZW quaternions */
+inline void multiplyQuaternion(const Float* const a, const Float* const b, Float* const out) {
+    const __m128 qa = _mm_loadu_ps(a);
+    const __m128 qb = _mm_loadu_ps(b);
+    const __m128 signW = _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0, 0));
+
+    /* (aw bx, aw by, aw bz, aw bw) */
+    const __m128 t0 = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(3, 3, 3, 3)), qb);
+    /* (ax bw, ay bw, az bw, -ax bx) */
+    const __m128 t1 = _mm_xor_ps(signW, _mm_mul_ps(
+        _mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 2, 1, 0)),
+        _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 3, 3, 3))));
+    /* (ay bz, az bx, ax by, -ay by) */
+    const __m128 t2 = _mm_xor_ps(signW, _mm_mul_ps(
+        _mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 0, 2, 1)),
+        _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 1, 0, 2))));
+    /* (az by, ax bz, ay bx, az bz) */
+    const __m128 t3 = _mm_mul_ps(
+        _mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 1, 0, 2)),
+        _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 0, 2, 1)));
+
+    _mm_storeu_ps(out, _mm_sub_ps(_mm_add_ps(_mm_add_ps(t0, t1), t2), t3));
+}
+#endif
+
+#ifdef MAGNUM_MATH_SIMD_NEON
+inline float32x4_t multiplyColumn(const Float* const a, const Float* const column) {
+    float32x4_t out = vmulq_n_f32(vld1q_f32(a), column[0]);
+    out = vmlaq_n_f32(out, vld1q_f32(a + 4), column[1]);
+    out = vmlaq_n_f32(out, vld1q_f32(a + 8), column[2]);
+    return vmlaq_n_f32(out, vld1q_f32(a + 12), column[3]);
+}
+
+inline void multiplyMatrix4(const Float* const a, const Float* const b, Float* const out) {
+    /* Computing all columns first in case out aliases any of the inputs */
+    const float32x4_t c0 = multiplyColumn(a, b);
+    const float32x4_t c1 = multiplyColumn(a, b + 4);
+    const float32x4_t c2 = multiplyColumn(a, b + 8);
+    const float32x4_t c3 = multiplyColumn(a, b + 12);
+    vst1q_f32(out, c0);
+    vst1q_f32(out + 4, c1);
+    vst1q_f32(out + 8, c2);
+    vst1q_f32(out + 12, c3);
+}
+
+inline void multiplyMatrix4Vector4(const Float* const a, const Float* const b, Float* const out) {
+    vst1q_f32(out, multiplyColumn(a, b));
+}
+#endif
+
+}}}}
+
+#endif
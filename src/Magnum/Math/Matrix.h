@@ -35,6 +35,7 @@ namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInversion;
 }
 
 /**
@@ -343,16 +344,66 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
-    Matrix<size, T> out{ZeroInit};
+namespace Implementation {
 
-    const T _determinant = determinant();
+template<std::size_t size, class T> struct MatrixInversion {
+    Matrix<size, T> operator()(const Matrix<size, T>& m) const {
+        Matrix<size, T> out{ZeroInit};
 
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != size; ++row)
-            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant()/_determinant;
+        const T determinant = m.determinant();
 
-    return out;
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != size; ++row)
+                out[col][row] = (((row+col) & 1) ? -1 : 1)*m.ij(row, col).determinant()/determinant;
+
+        return out;
+    }
+};
+
+/* The generic implementation recalculates the same 2x2 subdeterminants over
+   and over, this shares them among all cofactors */
+template<class T> struct MatrixInversion<4, T> {
+    Matrix<4, T> operator()(const Matrix<4, T>& m) const {
+        const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+        const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+        const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+        const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+        const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+        const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+
+        const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+        const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+        const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+        const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+        const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+        const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+
+        const T invDeterminant = T(1)/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+        return {
+            Vector<4, T>{( m[1][1]*c5 - m[1][2]*c4 + m[1][3]*c3)*invDeterminant,
+                         (-m[0][1]*c5 + m[0][2]*c4 - m[0][3]*c3)*invDeterminant,
+                         ( m[3][1]*s5 - m[3][2]*s4 + m[3][3]*s3)*invDeterminant,
+                         (-m[2][1]*s5 + m[2][2]*s4 - m[2][3]*s3)*invDeterminant},
+            Vector<4, T>{(-m[1][0]*c5 + m[1][2]*c2 - m[1][3]*c1)*invDeterminant,
+                         ( m[0][0]*c5 - m[0][2]*c2 + m[0][3]*c1)*invDeterminant,
+                         (-m[3][0]*s5 + m[3][2]*s2 - m[3][3]*s1)*invDeterminant,
+                         ( m[2][0]*s5 - m[2][2]*s2 + m[2][3]*s1)*invDeterminant},
+            Vector<4, T>{( m[1][0]*c4 - m[1][1]*c2 + m[1][3]*c0)*invDeterminant,
+                         (-m[0][0]*c4 + m[0][1]*c2 - m[0][3]*c0)*invDeterminant,
+                         ( m[3][0]*s4 - m[3][1]*s2 + m[3][3]*s0)*invDeterminant,
+                         (-m[2][0]*s4 + m[2][1]*s2 - m[2][3]*s0)*invDeterminant},
+            Vector<4, T>{(-m[1][0]*c3 + m[1][1]*c1 - m[1][2]*c0)*invDeterminant,
+                         ( m[0][0]*c3 - m[0][1]*c1 + m[0][2]*c0)*invDeterminant,
+                         (-m[3][0]*s3 + m[3][1]*s1 - m[3][2]*s0)*invDeterminant,
+                         ( m[2][0]*s3 - m[2][1]*s1 + m[2][2]*s0)*invDeterminant}};
+    }
+};
+
+}
+
+template<std::size_t size, class T> inline Matrix<size, T> Matrix<size, T>::inverted() const {
+    return Implementation::MatrixInversion<size, T>{}(*this);
 }
 
 }}
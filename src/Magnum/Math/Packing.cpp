@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Packing.h"
+
+#include <cstring>
+#include <type_traits>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/Simd.h"
+
+#if defined(MAGNUM_MATH_SIMD_SSE2) && defined(__F16C__)
+#define MAGNUM_MATH_SIMD_F16C
+#include <immintrin.h>
+#endif
+
+/* ARMv7 NEON flushes denormals to zero, use the vectorized conversion only
+   on ARM64 so it gives the same results as the scalar one */
+#if defined(MAGNUM_MATH_SIMD_NEON) && defined(__aarch64__)
+#define MAGNUM_MATH_SIMD_NEON_FP16
+#endif
+
+namespace Magnum { namespace Math {
+
+/* Based on public domain code by Fabian Giesen,
+   https://gist.github.com/rygorous/2156668 */
+UnsignedShort packHalf(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+
+    const UnsignedInt sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    UnsignedShort out;
+
+    /* Too large to be representable (converted to infinity), infinity or NaN
+       (converted to quiet NaN) */
+    if(bits >= 0x47800000u)
+        out = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+
+    /* Resulting value is a denormal or zero, let the FPU do the rounding by
+       adding 0.5 (which shifts the mantissa to the right place) */
+    else if(bits < 0x38800000u) {
+        constexpr UnsignedInt Magic = 0x3f000000u;
+        Float f;
+        std::memcpy(&f, &bits, sizeof(Float));
+        f += 0.5f;
+        std::memcpy(&bits, &f, sizeof(Float));
+        out = bits - Magic;
+
+    /* Normal value, rebias the exponent and round the mantissa to nearest
+       even */
+    } else {
+        const UnsignedInt mantissaOdd = (bits >> 13) & 1;
+        bits += (UnsignedInt(15 - 127) << 23) + 0xfff;
+        bits += mantissaOdd;
+        out = bits >> 13;
+    }
+
+    return out | (sign >> 16);
+}
+
+Float unpackHalf(const UnsignedShort value) {
+    constexpr UnsignedInt ShiftedExponent = 0x7c00u << 13;
+    constexpr UnsignedInt Magic = 113u << 23;
+
+    UnsignedInt bits = UnsignedInt(value & 0x7fff) << 13;
+    const UnsignedInt exponent = ShiftedExponent & bits;
+    bits += (127 - 15) << 23;
+
+    /* Infinity or NaN, adjust the exponent once more */
+    if(exponent == ShiftedExponent)
+        bits += (128 - 16) << 23;
+
+    /* Zero or denormal, renormalize */
+    else if(exponent == 0) {
+        bits += 1 << 23;
+        Float f, magic;
+        std::memcpy(&f, &bits, sizeof(Float));
+        std::memcpy(&magic, &Magic, sizeof(Float));
+        f -= magic;
+        std::memcpy(&bits, &f, sizeof(Float));
+    }
+
+    bits |= UnsignedInt(value & 0x8000) << 16;
+
+    Float out;
+    std::memcpy(&out, &bits, sizeof(Float));
+    return out;
+}
+
+void packHalf(const Containers::ArrayView<const Float> in, const Containers::ArrayView<UnsignedShort> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::packHalf(): expected output size" << in.size() << "but got" << out.size(), );
+
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_SIMD_F16C)
+    for(; i + 4 <= in.size(); i += 4)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out.data() + i),
+            _mm_cvtps_ph(_mm_loadu_ps(in.data() + i), _MM_FROUND_TO_NEAREST_INT));
+    #elif defined(MAGNUM_MATH_SIMD_NEON_FP16)
+    for(; i + 4 <= in.size(); i += 4)
+        vst1_u16(out.data() + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in.data() + i))));
+    #endif
+
+    for(; i != in.size(); ++i) out[i] = packHalf(in[i]);
+}
+
+void unpackHalf(const Containers::ArrayView<const UnsignedShort> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::unpackHalf(): expected output size" << in.size() << "but got" << out.size(), );
+
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_SIMD_F16C)
+    for(; i + 4 <= in.size(); i += 4)
+        _mm_storeu_ps(out.data() + i, _mm_cvtph_ps(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.data() + i))));
+    #elif defined(MAGNUM_MATH_SIMD_NEON_FP16)
+    for(; i + 4 <= in.size(); i += 4)
+        vst1q_f32(out.data() + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in.data() + i))));
+    #endif
+
+    for(; i != in.size(); ++i) out[i] = unpackHalf(in[i]);
+}
+
+namespace {
+
+/* Plain loops without function calls or branches, so the compiler is able
+   to vectorize them */
+template<class Integral> inline typename std::enable_if<std::is_unsigned<Integral>::value, Integral>::type packNormalizedOne(const Float value) {
+    return Integral(Math::clamp(value, 0.0f, 1.0f)*Float(std::numeric_limits<Integral>::max()) + 0.5f);
+}
+
+template<class Integral> inline typename std::enable_if<std::is_signed<Integral>::value, Integral>::type packNormalizedOne(const Float value) {
+    const Float scaled = Math::clamp(value, -1.0f, 1.0f)*Float(std::numeric_limits<Integral>::max());
+    return Integral(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+}
+
+}
+
+template<class Integral> void packNormalized(const Containers::ArrayView<const Float> in, const Containers::ArrayView<Integral> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::packNormalized(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const input = in.data();
+    Integral* const output = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        output[i] = packNormalizedOne<Integral>(input[i]);
+}
+
+template<class Integral> void unpackNormalized(const Containers::ArrayView<const Integral> in, const Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::unpackNormalized(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Integral* const input = in.data();
+    Float* const output = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        output[i] = Math::normalize<Float, Integral>(input[i]);
+}
+
+template MAGNUM_EXPORT void packNormalized<Byte>(Containers::ArrayView<const Float>, Containers::ArrayView<Byte>);
+template MAGNUM_EXPORT void packNormalized<UnsignedByte>(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>);
+template MAGNUM_EXPORT void packNormalized<Short>(Containers::ArrayView<const Float>, Containers::ArrayView<Short>);
+template MAGNUM_EXPORT void packNormalized<UnsignedShort>(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedShort>);
+template MAGNUM_EXPORT void unpackNormalized<Byte>(Containers::ArrayView<const Byte>, Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackNormalized<UnsignedByte>(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackNormalized<Short>(Containers::ArrayView<const Short>, Containers::ArrayView<Float>);
+template MAGNUM_EXPORT void unpackNormalized<UnsignedShort>(Containers::ArrayView<const UnsignedShort>, Containers::ArrayView<Float>);
+
+}}
@@ -0,0 +1,153 @@
+#ifndef Magnum_Math_Packing_h
+#define Magnum_Math_Packing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf(), @ref Magnum::Math::packNormalized(), @ref Magnum::Math::unpackNormalized()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Vector.h"
+
+namespace Magnum { namespace Math {
+
+/** @{ @name Packing functions */
+
+/**
+@brief Pack 32-bit float value into 16-bit half-float representation
+
+Rounds to nearest even, values larger than the largest representable
+half-float are converted to infinity, NaNs are kept as NaNs. Values too small
+to be represented are converted to half-float denormals or zero. The result
+can be directly uploaded as @ref PixelType::HalfFloat or
+@ref Attribute::DataType::HalfFloat.
+@see @ref unpackHalf(), @ref packHalf(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedShort>)
+*/
+MAGNUM_EXPORT UnsignedShort packHalf(Float value);
+
+/** @overload */
+template<std::size_t size> Vector<size, UnsignedShort> packHalf(const Vector<size, Float>& value) {
+    Vector<size, UnsignedShort> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = packHalf(value[i]);
+    return out;
+}
+
+/**
+@brief Unpack 16-bit half-float value into 32-bit float
+
+The conversion is exact, including denormals, infinities and NaNs.
+@see @ref packHalf(), @ref unpackHalf(Containers::ArrayView<const UnsignedShort>, Containers::ArrayView<Float>)
+*/
+MAGNUM_EXPORT Float unpackHalf(UnsignedShort value);
+
+/** @overload */
+template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, UnsignedShort>& value) {
+    Vector<size, Float> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = unpackHalf(value[i]);
+    return out;
+}
+
+/**
+@brief Pack array of 32-bit float values into half-floats
+@param[in]  in      Input values
+@param[out] out     Output values, expected to have the same size as @p in
+
+Same as calling @ref packHalf(Float) for each value, but uses the F16C
+instruction set on x86 or NEON on ARM64 if enabled in compiler flags. Useful
+for preparing data for @ref MeshTools::interleave() or converting whole
+images, for example:
+@code
+std::vector<Vector3> positions;
+std::vector<Math::Vector3<UnsignedShort>> packed(positions.size());
+Math::packHalf({positions.front().data(), positions.size()*3},
+               {packed.front().data(), packed.size()*3});
+
+Buffer vertexBuffer;
+vertexBuffer.setData(MeshTools::interleave(packed, 2), BufferUsage::StaticDraw);
+mesh.addVertexBuffer(vertexBuffer, 0, Shaders::Generic3D::Position{
+    Shaders::Generic3D::Position::DataType::HalfFloat}, 2);
+@endcode
+@see @ref unpackHalf(Containers::ArrayView<const UnsignedShort>, Containers::ArrayView<Float>)
+*/
+MAGNUM_EXPORT void packHalf(Containers::ArrayView<const Float> in, Containers::ArrayView<UnsignedShort> out);
+
+/**
+@brief Unpack array of half-float values into 32-bit floats
+@param[in]  in      Input values
+@param[out] out     Output values, expected to have the same size as @p in
+
+Same as calling @ref unpackHalf(UnsignedShort) for each value, but uses the
+F16C instruction set on x86 or NEON on ARM64 if enabled in compiler flags.
+@see @ref packHalf(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedShort>)
+*/
+MAGNUM_EXPORT void unpackHalf(Containers::ArrayView<const UnsignedShort> in, Containers::ArrayView<Float> out);
+
+/**
+@brief Pack array of float values into normalized integers
+@param[in]  in      Input values
+@param[out] out     Output values, expected to have the same size as @p in
+
+Converts values in range @f$ [0, 1] @f$ to full range of *unsigned* `Integral`
+type or values in range @f$ [-1, 1] @f$ to full range of *signed* `Integral`
+type, ready for upload as normalized vertex attribute or pixel data. Unlike
+@ref denormalize(), the values are rounded to nearest and values outside of
+the range are clamped. `Integral` can be one of @ref Magnum::Byte "Byte",
+@ref Magnum::UnsignedByte "UnsignedByte", @ref Magnum::Short "Short" or
+@ref Magnum::UnsignedShort "UnsignedShort".
+@see @ref unpackNormalized()
+*/
+template<class Integral> void packNormalized(Containers::ArrayView<const Float> in, Containers::ArrayView<Integral> out);
+
+/**
+@brief Unpack array of normalized integers into float values
+@param[in]  in      Input values
+@param[out] out     Output values, expected to have the same size as @p in
+
+Inverse to @ref packNormalized(), same as calling @ref normalize() for each
+value.
+*/
+template<class Integral> void unpackNormalized(Containers::ArrayView<const Integral> in, Containers::ArrayView<Float> out);
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+extern template MAGNUM_EXPORT void packNormalized<Byte>(Containers::ArrayView<const Float>, Containers::ArrayView<Byte>);
+extern template MAGNUM_EXPORT void packNormalized<UnsignedByte>(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>);
+extern template MAGNUM_EXPORT void packNormalized<Short>(Containers::ArrayView<const Float>, Containers::ArrayView<Short>);
+extern template MAGNUM_EXPORT void packNormalized<UnsignedShort>(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedShort>);
+extern template MAGNUM_EXPORT void unpackNormalized<Byte>(Containers::ArrayView<const Byte>, Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackNormalized<UnsignedByte>(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackNormalized<Short>(Containers::ArrayView<const Short>, Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackNormalized<UnsignedShort>(Containers::ArrayView<const UnsignedShort>, Containers::ArrayView<Float>);
+#endif
+
+/*@}*/
+
+}}
+
+#endif
@@ -30,6 +30,7 @@
  */
 
 #include <cmath>
+#include <type_traits>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -96,6 +97,27 @@ template<class T> inline Quaternion<T> lerp(const Quaternion<T>& normalizedA, co
     return ((T(1) - t)*normalizedA + t*normalizedB).normalized();
 }
 
+/** @relatesalso Quaternion
+@brief Fast approximate linear interpolation of two quaternions
+@param normalizedA  First quaternion
+@param normalizedB  Second quaternion
+@param t            Interpolation phase (from range @f$ [0; 1] @f$)
+
+Same as @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T), but the
+result is normalized using @ref sqrtInvertedFast() instead of an exact square
+root and the inputs are not checked to be normalized. The result is normalized
+with relative error below @f$ 5 \cdot 10^{-6} @f$. Unlike @ref slerp() the
+interpolation doesn't have constant angular velocity, but for small angles
+between the quaternions the difference is negligible. Available only for
+@ref Magnum::Float "Float" quaternions.
+*/
+template<class T> inline Quaternion<T> lerpFast(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, T t) {
+    static_assert(std::is_same<T, Float>::value,
+        "Math::lerpFast(): only Float quaternions are supported");
+    const Quaternion<T> out = (T(1) - t)*normalizedA + t*normalizedB;
+    return out*Implementation::sqrtInvertedFast(out.dot());
+}
+
 /** @relatesalso Quaternion
 @brief Spherical linear interpolation of two quaternions
 @param normalizedA  First quaternion
@@ -630,9 +652,32 @@ template<class T> Matrix3x3<T> Quaternion<T>::toMatrix() const {
     };
 }
 
+namespace Implementation {
+
+template<class T> struct QuaternionMultiplication {
+    Quaternion<T> operator()(const Quaternion<T>& a, const Quaternion<T>& b) const {
+        return {a.scalar()*b.vector() + b.scalar()*a.vector() + Math::cross(a.vector(), b.vector()),
+                a.scalar()*b.scalar() - Math::dot(a.vector(), b.vector())};
+    }
+};
+
+#ifdef MAGNUM_MATH_SIMD_SSE2
+template<> struct QuaternionMultiplication<Float> {
+    Quaternion<Float> operator()(const Quaternion<Float>& a, const Quaternion<Float>& b) const {
+        const Vector3<Float> av = a.vector(), bv = b.vector();
+        const Float in[]{av.x(), av.y(), av.z(), a.scalar(),
+                         bv.x(), bv.y(), bv.z(), b.scalar()};
+        Float out[4];
+        Simd::multiplyQuaternion(in, in + 4, out);
+        return {{out[0], out[1], out[2]}, out[3]};
+    }
+};
+#endif
+
+}
+
 template<class T> inline Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& other) const {
-    return {_scalar*other._vector + other._scalar*_vector + Math::cross(_vector, other._vector),
-            _scalar*other._scalar - Math::dot(_vector, other._vector)};
+    return Implementation::QuaternionMultiplication<T>{}(*this, other);
 }
 
 template<class T> inline Quaternion<T> Quaternion<T>::invertedNormalized() const {
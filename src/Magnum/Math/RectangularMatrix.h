@@ -30,11 +30,13 @@
  */
 
 #include "Magnum/Math/Vector.h"
+#include "Magnum/Math/Implementation/Simd.h"
 
 namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, std::size_t, class, class> struct RectangularMatrixConverter;
+    template<std::size_t, std::size_t, std::size_t, class> struct RectangularMatrixMultiplication;
 }
 
 /**
@@ -637,15 +639,45 @@ template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<c
     return out;
 }
 
-template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
-    RectangularMatrix<size, rows, T> out;
+namespace Implementation {
 
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != rows; ++row)
-            for(std::size_t pos = 0; pos != cols; ++pos)
-                out[col][row] += _data[pos][row]*other._data[col][pos];
+template<std::size_t cols, std::size_t rows, std::size_t size, class T> struct RectangularMatrixMultiplication {
+    RectangularMatrix<size, rows, T> operator()(const RectangularMatrix<cols, rows, T>& a, const RectangularMatrix<size, cols, T>& b) const {
+        RectangularMatrix<size, rows, T> out;
 
-    return out;
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != rows; ++row)
+                for(std::size_t pos = 0; pos != cols; ++pos)
+                    out[col][row] += a[pos][row]*b[col][pos];
+
+        return out;
+    }
+};
+
+#ifdef MAGNUM_MATH_SIMD
+/* Matrix4 multiplication and Matrix4 * Vector4 (which is done through
+   one-column matrix) */
+template<> struct RectangularMatrixMultiplication<4, 4, 4, Float> {
+    RectangularMatrix<4, 4, Float> operator()(const RectangularMatrix<4, 4, Float>& a, const RectangularMatrix<4, 4, Float>& b) const {
+        RectangularMatrix<4, 4, Float> out{NoInit};
+        Simd::multiplyMatrix4(a.data(), b.data(), out.data());
+        return out;
+    }
+};
+
+template<> struct RectangularMatrixMultiplication<4, 4, 1, Float> {
+    RectangularMatrix<1, 4, Float> operator()(const RectangularMatrix<4, 4, Float>& a, const RectangularMatrix<1, 4, Float>& b) const {
+        RectangularMatrix<1, 4, Float> out{NoInit};
+        Simd::multiplyMatrix4Vector4(a.data(), b.data(), out.data());
+        return out;
+    }
+};
+#endif
+
+}
+
+template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
+    return Implementation::RectangularMatrixMultiplication<cols, rows, size, T>{}(*this, other);
 }
 
 template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<rows, cols, T> RectangularMatrix<cols, rows, T>::transposed() const {
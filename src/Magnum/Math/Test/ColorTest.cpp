@@ -23,11 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Configuration.h>
 
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/ColorBatch.h"
 
 namespace Magnum { namespace Math { namespace Test {
 
@@ -60,6 +62,11 @@ struct ColorTest: Corrade::TestSuite::Tester {
     void hsvOverflow();
     void hsvAlpha();
 
+    void srgb();
+    void srgbIntegral();
+    void srgbAlpha();
+    void srgbBatch();
+
     void swizzleType();
     void debug();
     void configuration();
@@ -104,6 +111,11 @@ ColorTest::ColorTest() {
               &ColorTest::hsvOverflow,
               &ColorTest::hsvAlpha,
 
+              &ColorTest::srgb,
+              &ColorTest::srgbIntegral,
+              &ColorTest::srgbAlpha,
+              &ColorTest::srgbBatch,
+
               &ColorTest::swizzleType,
               &ColorTest::debug,
               &ColorTest::configuration});
@@ -339,6 +351,78 @@ void ColorTest::hsvAlpha() {
     CORRADE_COMPARE(Color4ub::fromHSV(230.0_degf, 0.749f, 0.427f), Color4ub(27, 40, 108, 255));
 }
 
+void ColorTest::srgb() {
+    const Color3 linear{0.0331048f, 0.445201f, 0.212231f};
+    const Vector3 srgb{0.2f, 0.698039f, 0.498039f};
+    CORRADE_COMPARE(Color3::fromSrgb(srgb), linear);
+    CORRADE_COMPARE(linear.toSrgb(), srgb);
+
+    /* Linear segment of the curve */
+    CORRADE_COMPARE(Color3::fromSrgb(Vector3(0.02f)), Color3(0.00154799f));
+    CORRADE_COMPARE(Color3(0.002f).toSrgb(), Vector3(0.02584f));
+}
+
+void ColorTest::srgbIntegral() {
+    /* Integral input */
+    CORRADE_COMPARE(Color3::fromSrgb(0x33b27f_rgb), Color3(0.0331048f, 0.445201f, 0.212231f));
+
+    /* Integral color */
+    CORRADE_COMPARE(Color3ub::fromSrgb(Vector3{0.2f, 0.698039f, 0.498039f}), Color3ub(8, 113, 54));
+    CORRADE_COMPARE(Color3ub(8, 113, 54).toSrgb(), Vector3(0.194353f, 0.696583f, 0.497533f));
+
+    /* Integral output */
+    CORRADE_COMPARE(Color3(0.0f, 1.0f, 0.0f).toSrgb<UnsignedByte>(), Math::Vector3<UnsignedByte>(0, 255, 0));
+}
+
+void ColorTest::srgbAlpha() {
+    const Color4 linear{0.0331048f, 0.445201f, 0.212231f, 0.5f};
+    const Vector4 srgb{0.2f, 0.698039f, 0.498039f, 0.5f};
+    CORRADE_COMPARE(Color4::fromSrgbAlpha(srgb), linear);
+    CORRADE_COMPARE(Color4::fromSrgb(srgb.rgb(), 0.5f), linear);
+    CORRADE_COMPARE(linear.toSrgbAlpha(), srgb);
+
+    /* Default alpha */
+    CORRADE_COMPARE(Color4::fromSrgb(srgb.rgb()), (Color4{linear.rgb(), 1.0f}));
+
+    /* Alpha is kept linear also for integral types */
+    CORRADE_COMPARE(Color4::fromSrgbAlpha(0x33b27f80_rgba), (Color4{linear.rgb(), 0.501961f}));
+    CORRADE_COMPARE(Color4ub::fromSrgbAlpha(srgb), Color4ub(8, 113, 54, 127));
+    CORRADE_COMPARE(Color4ub(8, 113, 54, 51).toSrgbAlpha(), Vector4(0.194353f, 0.696583f, 0.497533f, 0.2f));
+}
+
+void ColorTest::srgbBatch() {
+    /* Decoding from the table is the same as the exact calculation */
+    UnsignedByte bytes[256];
+    for(std::size_t i = 0; i != 256; ++i) bytes[i] = UnsignedByte(i);
+    Float decoded[256];
+    Math::srgbToLinear(bytes, decoded);
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(decoded[i], Color3::fromSrgb(Vector3(i/255.0f)).r());
+
+    /* Encoding to bytes is the same as rounding the exact calculation, with
+       out-of-range values clamped */
+    Float linear[1003];
+    for(std::size_t i = 0; i != 1001; ++i) linear[i] = i/1000.0f;
+    linear[1001] = -1.0f;
+    linear[1002] = 2.0f;
+    UnsignedByte encoded[1003];
+    Math::linearToSrgb(linear, encoded);
+    for(std::size_t i = 0; i != 1001; ++i)
+        CORRADE_COMPARE(Int(encoded[i]), Int(Math::round(Color3(linear[i]).toSrgb().r()*255.0f)));
+    CORRADE_COMPARE(Int(encoded[1001]), 0);
+    CORRADE_COMPARE(Int(encoded[1002]), 255);
+
+    /* Absolute error bound documented in linearToSrgb(), the output can be
+       the same as the input */
+    Float srgb[1001];
+    std::copy(linear, linear + 1001, srgb);
+    Math::linearToSrgb({srgb, 1001}, {srgb, 1001});
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != 1001; ++i)
+        maxError = Math::max(maxError, std::abs(srgb[i] - Color3(linear[i]).toSrgb().r()));
+    CORRADE_VERIFY(maxError < 2.5e-4f);
+}
+
 void ColorTest::swizzleType() {
     constexpr Color3 origColor3;
     constexpr Color4ub origColor4;
@@ -27,6 +27,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Test {
@@ -51,6 +52,8 @@ struct FunctionsTest: Corrade::TestSuite::Tester {
 
     void sqrt();
     void sqrtInverted();
+    void sqrtInvertedFast();
+    void lengthNormalizedFast();
     void lerp();
     void lerpBool();
     void lerpInverted();
@@ -73,6 +76,9 @@ struct FunctionsTest: Corrade::TestSuite::Tester {
     void div();
     void trigonometric();
     void trigonometricWithBase();
+    void trigonometricFast();
+
+    void batchFast();
 };
 
 typedef Math::Constants<Float> Constants;
@@ -102,6 +108,8 @@ FunctionsTest::FunctionsTest() {
 
               &FunctionsTest::sqrt,
               &FunctionsTest::sqrtInverted,
+              &FunctionsTest::sqrtInvertedFast,
+              &FunctionsTest::lengthNormalizedFast,
               &FunctionsTest::lerp,
               &FunctionsTest::lerpBool,
               &FunctionsTest::lerpInverted,
@@ -123,7 +131,10 @@ FunctionsTest::FunctionsTest() {
               &FunctionsTest::exp,
               &FunctionsTest::div,
               &FunctionsTest::trigonometric,
-              &FunctionsTest::trigonometricWithBase});
+              &FunctionsTest::trigonometricWithBase,
+              &FunctionsTest::trigonometricFast,
+
+              &FunctionsTest::batchFast});
 }
 
 void FunctionsTest::min() {
@@ -231,6 +242,24 @@ void FunctionsTest::sqrtInverted() {
     CORRADE_COMPARE(Math::sqrtInverted(Vector3(1.0f, 4.0f, 16.0f)), Vector3(1.0f, 0.5f, 0.25f));
 }
 
+void FunctionsTest::sqrtInvertedFast() {
+    CORRADE_COMPARE(Math::sqrtInvertedFast(16.0f), 0.25f);
+    CORRADE_COMPARE(Math::sqrtInvertedFast(Vector3(1.0f, 4.0f, 16.0f)), Vector3(1.0f, 0.5f, 0.25f));
+
+    /* Relative error bound documented in sqrtInvertedFast() */
+    Float maxError = 0.0f;
+    for(Float a = 1.0e-20f; a < 1.0e20f; a *= 1.0013f)
+        maxError = Math::max(maxError, std::abs(Math::sqrtInvertedFast(a)*std::sqrt(a) - 1.0f));
+    CORRADE_VERIFY(maxError < 5.0e-6f);
+}
+
+void FunctionsTest::lengthNormalizedFast() {
+    const Vector3 a{1.0f, -2.0f, 3.5f};
+    CORRADE_COMPARE(Math::lengthFast(a), a.length());
+    CORRADE_COMPARE(Vector3{Math::normalizedFast(a)}, a.normalized());
+    CORRADE_VERIFY(Vector3{Math::normalizedFast(a)}.isNormalized());
+}
+
 void FunctionsTest::lerp() {
     /* Floating-point / integral scalar */
     CORRADE_COMPARE(Math::lerp(2.0f, 5.0f, 0.5f), 3.5f);
@@ -514,6 +543,48 @@ void FunctionsTest::trigonometricWithBase() {
     CORRADE_COMPARE(Math::tan(2*Rad(Constants::pi()/8)), 1.0f);
 }
 
+void FunctionsTest::trigonometricFast() {
+    CORRADE_COMPARE(Math::sinFast(Deg(30.0f)), 0.5f);
+    CORRADE_COMPARE(Math::sinFast(2*Rad(Constants::pi()/12)), 0.5f);
+    CORRADE_COMPARE(Math::sinFast(Deg(-270.0f)), 1.0f);
+    CORRADE_COMPARE(Math::cosFast(Deg(60.0f)), 0.5f);
+    CORRADE_COMPARE(Math::cosFast(2*Rad(Constants::pi()/6)), 0.5f);
+    CORRADE_COMPARE(Math::cosFast(Deg(540.0f)), -1.0f);
+    CORRADE_COMPARE(Math::sinFast(Math::Deg<Double>(30.0)), 0.5);
+
+    /* Absolute error bound documented in sinFast() */
+    Float maxError = 0.0f;
+    for(Float a = -1000.0f; a < 1000.0f; a += 0.0173f) {
+        maxError = Math::max(maxError, std::abs(Math::sinFast(Rad(a)) - std::sin(a)));
+        maxError = Math::max(maxError, std::abs(Math::cosFast(Rad(a)) - std::cos(a)));
+    }
+    CORRADE_VERIFY(maxError < 5.0e-6f);
+}
+
+void FunctionsTest::batchFast() {
+    /* More than four items to test both the SIMD and the remainder loop */
+    const Float in[]{1.0f, 4.0f, 16.0f, 0.25f, 100.0f, 0.01f, 2.0f};
+    Float out[7];
+
+    Math::sqrtInvertedFast(in, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Math::sqrtInverted(in[i]));
+
+    Math::sinFast(in, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Math::sinFast(Rad(in[i])));
+
+    Math::cosFast(in, out);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Math::cosFast(Rad(in[i])));
+
+    Vector3 vectors[]{{1.0f, -2.0f, 3.5f}, {0.0f, 0.0f, 4.0f}, {-0.1f, 0.2f, 0.0f}};
+    Math::normalizedFast(vectors, vectors);
+    CORRADE_COMPARE(vectors[0], (Vector3{1.0f, -2.0f, 3.5f}.normalized()));
+    CORRADE_COMPARE(vectors[1], Vector3::zAxis());
+    CORRADE_COMPARE(vectors[2], (Vector3{-0.1f, 0.2f, 0.0f}.normalized()));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsTest)
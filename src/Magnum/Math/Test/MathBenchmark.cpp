@@ -0,0 +1,269 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Every benchmark feeds the result of one iteration into the next one so the
+   compiler can't hoist the operation out of the loop or remove it */
+
+struct MathBenchmark: Corrade::TestSuite::Tester {
+    explicit MathBenchmark();
+
+    template<class T> void matrix4Multiply();
+    template<class T> void matrix4Inverted();
+    template<class T> void matrix4InvertedRigid();
+    template<class T> void quaternionMultiply();
+    template<class T> void quaternionSlerp();
+    void quaternionLerp();
+    void quaternionLerpFast();
+    template<class T> void dualQuaternionMultiply();
+    template<class T> void dualQuaternionTransformPoint();
+    template<class T> void svd();
+
+    void sqrtInverted();
+    void sqrtInvertedFast();
+    void sin();
+    void sinFast();
+    void vectorNormalized();
+    void vectorNormalizedFast();
+};
+
+namespace {
+    enum: std::size_t { Iterations = 10000 };
+}
+
+MathBenchmark::MathBenchmark() {
+    addBenchmarks<MathBenchmark>({&MathBenchmark::matrix4Multiply<Float>,
+                                  &MathBenchmark::matrix4Multiply<Double>,
+                                  &MathBenchmark::matrix4Inverted<Float>,
+                                  &MathBenchmark::matrix4Inverted<Double>,
+                                  &MathBenchmark::matrix4InvertedRigid<Float>,
+                                  &MathBenchmark::matrix4InvertedRigid<Double>,
+                                  &MathBenchmark::quaternionMultiply<Float>,
+                                  &MathBenchmark::quaternionMultiply<Double>,
+                                  &MathBenchmark::quaternionSlerp<Float>,
+                                  &MathBenchmark::quaternionSlerp<Double>,
+                                  &MathBenchmark::quaternionLerp,
+                                  &MathBenchmark::quaternionLerpFast,
+                                  &MathBenchmark::dualQuaternionMultiply<Float>,
+                                  &MathBenchmark::dualQuaternionMultiply<Double>,
+                                  &MathBenchmark::dualQuaternionTransformPoint<Float>,
+                                  &MathBenchmark::dualQuaternionTransformPoint<Double>,
+                                  &MathBenchmark::svd<Float>,
+                                  &MathBenchmark::svd<Double>,
+
+                                  &MathBenchmark::sqrtInverted,
+                                  &MathBenchmark::sqrtInvertedFast,
+                                  &MathBenchmark::sin,
+                                  &MathBenchmark::sinFast,
+                                  &MathBenchmark::vectorNormalized,
+                                  &MathBenchmark::vectorNormalizedFast}, 100);
+}
+
+namespace {
+
+template<class T> Matrix4<T> rigidTransformation() {
+    return Matrix4<T>::translation({T(1.0), T(-2.0), T(3.5)})*
+        Matrix4<T>::rotation(Rad<T>(T(0.35)), Vector3<T>(T(1.0), T(2.0), T(-0.5)).normalized());
+}
+
+}
+
+template<class T> void MathBenchmark::matrix4Multiply() {
+    const Matrix4<T> a = rigidTransformation<T>();
+    Matrix4<T> b;
+    CORRADE_BENCHMARK(Iterations) {
+        b = a*b;
+    }
+
+    CORRADE_VERIFY(b != Matrix4<T>());
+}
+
+template<class T> void MathBenchmark::matrix4Inverted() {
+    Matrix4<T> a = rigidTransformation<T>()*Matrix4<T>::scaling(Vector3<T>(T(2.0)));
+    CORRADE_BENCHMARK(Iterations) {
+        a = a.inverted();
+    }
+
+    CORRADE_VERIFY(a != Matrix4<T>());
+}
+
+template<class T> void MathBenchmark::matrix4InvertedRigid() {
+    Matrix4<T> a = rigidTransformation<T>();
+    CORRADE_BENCHMARK(Iterations) {
+        a = a.invertedRigid();
+    }
+
+    CORRADE_VERIFY(a != Matrix4<T>());
+}
+
+template<class T> void MathBenchmark::quaternionMultiply() {
+    const Quaternion<T> a = Quaternion<T>::rotation(Rad<T>(T(0.35)), Vector3<T>(T(1.0), T(2.0), T(-0.5)).normalized());
+    Quaternion<T> b;
+    CORRADE_BENCHMARK(Iterations) {
+        b = a*b;
+    }
+
+    CORRADE_VERIFY(b != Quaternion<T>());
+}
+
+template<class T> void MathBenchmark::quaternionSlerp() {
+    const Quaternion<T> a = Quaternion<T>::rotation(Rad<T>(T(0.35)), Vector3<T>(T(1.0), T(2.0), T(-0.5)).normalized());
+    const Quaternion<T> b = Quaternion<T>::rotation(Rad<T>(T(2.5)), Vector3<T>(T(-1.0), T(0.0), T(1.0)).normalized());
+    Quaternion<T> c = a;
+    CORRADE_BENCHMARK(Iterations) {
+        /* Renormalizing to avoid assertions due to accumulated error */
+        c = Math::slerp(c, b, T(0.01)).normalized();
+    }
+
+    CORRADE_VERIFY(c != a);
+}
+
+void MathBenchmark::quaternionLerp() {
+    const Quaternion<Float> a = Quaternion<Float>::rotation(Rad<Float>(0.35f), Vector3<Float>(1.0f, 2.0f, -0.5f).normalized());
+    const Quaternion<Float> b = Quaternion<Float>::rotation(Rad<Float>(2.5f), Vector3<Float>(-1.0f, 0.0f, 1.0f).normalized());
+    Quaternion<Float> c = a;
+    CORRADE_BENCHMARK(Iterations) {
+        c = Math::lerp(c, b, 0.01f).normalized();
+    }
+
+    CORRADE_VERIFY(c != a);
+}
+
+void MathBenchmark::quaternionLerpFast() {
+    const Quaternion<Float> a = Quaternion<Float>::rotation(Rad<Float>(0.35f), Vector3<Float>(1.0f, 2.0f, -0.5f).normalized());
+    const Quaternion<Float> b = Quaternion<Float>::rotation(Rad<Float>(2.5f), Vector3<Float>(-1.0f, 0.0f, 1.0f).normalized());
+    Quaternion<Float> c = a;
+    CORRADE_BENCHMARK(Iterations) {
+        c = Math::lerpFast(c, b, 0.01f);
+    }
+
+    CORRADE_VERIFY(c != a);
+}
+
+template<class T> void MathBenchmark::dualQuaternionMultiply() {
+    const DualQuaternion<T> a = DualQuaternion<T>::translation({T(1.0), T(-2.0), T(3.5)})*
+        DualQuaternion<T>::rotation(Rad<T>(T(0.35)), Vector3<T>(T(1.0), T(2.0), T(-0.5)).normalized());
+    DualQuaternion<T> b;
+    CORRADE_BENCHMARK(Iterations) {
+        b = a*b;
+    }
+
+    CORRADE_VERIFY(b != DualQuaternion<T>());
+}
+
+template<class T> void MathBenchmark::dualQuaternionTransformPoint() {
+    const DualQuaternion<T> a = DualQuaternion<T>::translation({T(1.0), T(-2.0), T(3.5)})*
+        DualQuaternion<T>::rotation(Rad<T>(T(0.35)), Vector3<T>(T(1.0), T(2.0), T(-0.5)).normalized());
+    Vector3<T> b{T(0.5), T(1.0), T(-1.5)};
+    CORRADE_BENCHMARK(Iterations) {
+        b = a.transformPointNormalized(b);
+    }
+
+    CORRADE_VERIFY(b != Vector3<T>());
+}
+
+template<class T> void MathBenchmark::svd() {
+    /* Same matrix as in SvdTest */
+    const RectangularMatrix<5, 8, T> a(
+        Vector<8, T>(T(22.0), T(14.0), T( -1.0), T(-3.0), T( 9.0), T( 9.0), T( 2.0), T( 4.0)),
+        Vector<8, T>(T(10.0), T( 7.0), T( 13.0), T(-2.0), T( 8.0), T( 1.0), T(-6.0), T( 5.0)),
+        Vector<8, T>(T( 2.0), T(10.0), T( -1.0), T(13.0), T( 1.0), T(-7.0), T( 6.0), T( 0.0)),
+        Vector<8, T>(T( 3.0), T( 0.0), T(-11.0), T(-2.0), T(-2.0), T( 5.0), T( 5.0), T(-2.0)),
+        Vector<8, T>(T( 7.0), T( 8.0), T(  3.0), T( 4.0), T( 4.0), T(-1.0), T( 1.0), T( 2.0)));
+
+    T sum{};
+    CORRADE_BENCHMARK(100) {
+        sum += std::get<1>(Algorithms::svd(a)).sum();
+    }
+
+    CORRADE_VERIFY(sum > T(0.0));
+}
+
+void MathBenchmark::sqrtInverted() {
+    Float a = 2.5f;
+    CORRADE_BENCHMARK(Iterations) {
+        a = Math::sqrtInverted(a) + 1.0f;
+    }
+
+    CORRADE_VERIFY(a > 1.0f);
+}
+
+void MathBenchmark::sqrtInvertedFast() {
+    Float a = 2.5f;
+    CORRADE_BENCHMARK(Iterations) {
+        a = Math::sqrtInvertedFast(a) + 1.0f;
+    }
+
+    CORRADE_VERIFY(a > 1.0f);
+}
+
+void MathBenchmark::sin() {
+    Float a = 2.5f;
+    CORRADE_BENCHMARK(Iterations) {
+        a = Math::sin(Rad<Float>(a))*3.0f;
+    }
+
+    CORRADE_VERIFY(a != 2.5f);
+}
+
+void MathBenchmark::sinFast() {
+    Float a = 2.5f;
+    CORRADE_BENCHMARK(Iterations) {
+        a = Math::sinFast(Rad<Float>(a))*3.0f;
+    }
+
+    CORRADE_VERIFY(a != 2.5f);
+}
+
+void MathBenchmark::vectorNormalized() {
+    Vector3<Float> a{1.0f, -2.0f, 3.5f};
+    CORRADE_BENCHMARK(Iterations) {
+        a = (a + Vector3<Float>::xAxis()).normalized();
+    }
+
+    CORRADE_VERIFY(a != Vector3<Float>{});
+}
+
+void MathBenchmark::vectorNormalizedFast() {
+    Vector3<Float> a{1.0f, -2.0f, 3.5f};
+    CORRADE_BENCHMARK(Iterations) {
+        a = Math::normalizedFast(a + Vector3<Float>::xAxis());
+    }
+
+    CORRADE_VERIFY(a != Vector3<Float>{});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MathBenchmark)
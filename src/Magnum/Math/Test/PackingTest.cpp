@@ -0,0 +1,216 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cmath>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct PackingTest: Corrade::TestSuite::Tester {
+    explicit PackingTest();
+
+    void packHalf();
+    void packHalfRounding();
+    void packHalfSpecial();
+    void unpackHalf();
+    void unpackHalfSpecial();
+    void packHalfVector();
+    void packHalfBatch();
+    void unpackHalfBatch();
+
+    void packNormalizedUnsigned();
+    void packNormalizedSigned();
+    void unpackNormalized();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<UnsignedShort> Vector3us;
+
+PackingTest::PackingTest() {
+    addTests({&PackingTest::packHalf,
+              &PackingTest::packHalfRounding,
+              &PackingTest::packHalfSpecial,
+              &PackingTest::unpackHalf,
+              &PackingTest::unpackHalfSpecial,
+              &PackingTest::packHalfVector,
+              &PackingTest::packHalfBatch,
+              &PackingTest::unpackHalfBatch,
+
+              &PackingTest::packNormalizedUnsigned,
+              &PackingTest::packNormalizedSigned,
+              &PackingTest::unpackNormalized});
+}
+
+void PackingTest::packHalf() {
+    CORRADE_COMPARE(Math::packHalf(0.0f), 0x0000);
+    CORRADE_COMPARE(Math::packHalf(-0.0f), 0x8000);
+    CORRADE_COMPARE(Math::packHalf(1.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(-2.0f), 0xc000);
+    CORRADE_COMPARE(Math::packHalf(0.5f), 0x3800);
+    CORRADE_COMPARE(Math::packHalf(65504.0f), 0x7bff);
+
+    /* Smallest normal and largest and smallest denormal */
+    CORRADE_COMPARE(Math::packHalf(6.103515625e-5f), 0x0400);
+    CORRADE_COMPARE(Math::packHalf(6.097555160522461e-5f), 0x03ff);
+    CORRADE_COMPARE(Math::packHalf(5.960464477539063e-8f), 0x0001);
+}
+
+void PackingTest::packHalfRounding() {
+    /* Exactly halfway between 1.0 and the next half, rounds to even */
+    CORRADE_COMPARE(Math::packHalf(1.0f + 1.0f/2048.0f), 0x3c00);
+    CORRADE_COMPARE(Math::packHalf(1.0f + 3.0f/2048.0f), 0x3c02);
+    CORRADE_COMPARE(Math::packHalf(1.0f + 1.1f/2048.0f), 0x3c01);
+
+    /* Too small to be represented even as a denormal */
+    CORRADE_COMPARE(Math::packHalf(1.0e-8f), 0x0000);
+    CORRADE_COMPARE(Math::packHalf(-1.0e-8f), 0x8000);
+}
+
+void PackingTest::packHalfSpecial() {
+    /* Too large values become infinity */
+    CORRADE_COMPARE(Math::packHalf(65520.0f), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(1.0e10f), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(-1.0e10f), 0xfc00);
+
+    CORRADE_COMPARE(Math::packHalf(Constants<Float>::inf()), 0x7c00);
+    CORRADE_COMPARE(Math::packHalf(-Constants<Float>::inf()), 0xfc00);
+    CORRADE_COMPARE(Math::packHalf(Constants<Float>::nan()) & 0x7fff, 0x7e00);
+}
+
+void PackingTest::unpackHalf() {
+    CORRADE_COMPARE(Math::unpackHalf(0x0000), 0.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x3c00), 1.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0xc000), -2.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x3555), 0.333251953125f);
+    CORRADE_COMPARE(Math::unpackHalf(0x7bff), 65504.0f);
+    CORRADE_COMPARE(Math::unpackHalf(0x0400), 6.103515625e-5f);
+    CORRADE_COMPARE(Math::unpackHalf(0x0001), 5.960464477539063e-8f);
+}
+
+void PackingTest::unpackHalfSpecial() {
+    CORRADE_VERIFY(std::signbit(Math::unpackHalf(0x8000)));
+    CORRADE_COMPARE(Math::unpackHalf(0x7c00), Constants<Float>::inf());
+    CORRADE_COMPARE(Math::unpackHalf(0xfc00), -Constants<Float>::inf());
+    CORRADE_VERIFY(Math::unpackHalf(0x7e00) != Math::unpackHalf(0x7e00));
+
+    /* Round trip for all finite values */
+    for(UnsignedInt i = 0; i != 0x7c00; ++i) {
+        if(Math::packHalf(Math::unpackHalf(i)) == i) continue;
+        CORRADE_COMPARE(Math::packHalf(Math::unpackHalf(i)), i);
+    }
+}
+
+void PackingTest::packHalfVector() {
+    CORRADE_COMPARE(Math::packHalf(Vector3(1.0f, -2.0f, 0.5f)), Vector3us(0x3c00, 0xc000, 0x3800));
+    CORRADE_COMPARE(Math::unpackHalf(Vector3us(0x3c00, 0xc000, 0x3800)), Vector3(1.0f, -2.0f, 0.5f));
+}
+
+void PackingTest::packHalfBatch() {
+    /* Size not divisible by four to test the remainder as well */
+    Float in[11];
+    UnsignedShort out[11];
+    for(std::size_t i = 0; i != 11; ++i) in[i] = (Float(i) - 5.0f)*1.37f + 1.0f/4096.0f;
+
+    Math::packHalf(in, out);
+
+    for(std::size_t i = 0; i != 11; ++i)
+        CORRADE_COMPARE(out[i], Math::packHalf(in[i]));
+}
+
+void PackingTest::unpackHalfBatch() {
+    const UnsignedShort in[]{0x0000, 0x3c00, 0xc000, 0x3555, 0x7bff, 0x0400, 0x0001};
+    Float out[7];
+
+    Math::unpackHalf(in, out);
+
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(out[i], Math::unpackHalf(in[i]));
+}
+
+void PackingTest::packNormalizedUnsigned() {
+    const Float in[]{0.0f, 1.0f, 0.5f, 0.2f, -0.3f, 1.7f};
+    UnsignedByte out[6];
+
+    Math::packNormalized<UnsignedByte>(in, out);
+
+    /* Rounded to nearest and clamped */
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 255);
+    CORRADE_COMPARE(out[2], 128);
+    CORRADE_COMPARE(out[3], 51);
+    CORRADE_COMPARE(out[4], 0);
+    CORRADE_COMPARE(out[5], 255);
+
+    UnsignedShort outShort[6];
+    Math::packNormalized<UnsignedShort>(in, outShort);
+    CORRADE_COMPARE(outShort[1], 65535);
+    CORRADE_COMPARE(outShort[2], 32768);
+}
+
+void PackingTest::packNormalizedSigned() {
+    const Float in[]{0.0f, 1.0f, -1.0f, 0.5f, -0.5f, -1.5f};
+    Byte out[6];
+
+    Math::packNormalized<Byte>(in, out);
+
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 127);
+    CORRADE_COMPARE(out[2], -127);
+    CORRADE_COMPARE(out[3], 64);
+    CORRADE_COMPARE(out[4], -64);
+    CORRADE_COMPARE(out[5], -127);
+
+    Short outShort[6];
+    Math::packNormalized<Short>(in, outShort);
+    CORRADE_COMPARE(outShort[1], 32767);
+    CORRADE_COMPARE(outShort[2], -32767);
+}
+
+void PackingTest::unpackNormalized() {
+    const Byte in[]{0, 127, -127, -128};
+    Float out[4];
+
+    Math::unpackNormalized<Byte>(in, out);
+
+    CORRADE_COMPARE(out[0], 0.0f);
+    CORRADE_COMPARE(out[1], 1.0f);
+    CORRADE_COMPARE(out[2], -1.0f);
+    CORRADE_COMPARE(out[3], -1.0f);
+
+    const UnsignedShort inShort[]{0, 65535, 32768};
+    Float outShort[3];
+    Math::unpackNormalized<UnsignedShort>(inShort, outShort);
+    CORRADE_COMPARE(outShort[1], 1.0f);
+    CORRADE_COMPARE(outShort[2], 0.500008f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
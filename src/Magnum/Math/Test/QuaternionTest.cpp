@@ -87,6 +87,7 @@ struct QuaternionTest: Corrade::TestSuite::Tester {
     void angle();
     void matrix();
     void lerp();
+    void lerpFast();
     void slerp();
     void transformVector();
     void transformVectorNormalized();
@@ -133,6 +134,7 @@ QuaternionTest::QuaternionTest() {
               &QuaternionTest::angle,
               &QuaternionTest::matrix,
               &QuaternionTest::lerp,
+              &QuaternionTest::lerpFast,
               &QuaternionTest::slerp,
               &QuaternionTest::transformVector,
               &QuaternionTest::transformVectorNormalized,
@@ -428,6 +430,15 @@ void QuaternionTest::lerp() {
 #pragma GCC pop_options
 #endif
 
+void QuaternionTest::lerpFast() {
+    Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3(1.0f/Constants<Float>::sqrt3()));
+    Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
+
+    Quaternion lerp = Math::lerpFast(a, b, 0.35f);
+    CORRADE_VERIFY(lerp.isNormalized());
+    CORRADE_COMPARE(lerp, Math::lerp(a, b, 0.35f));
+}
+
 void QuaternionTest::slerp() {
     Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3(1.0f/Constants<Float>::sqrt3()));
     Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
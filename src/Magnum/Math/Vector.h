@@ -30,6 +30,7 @@
  */
 
 #include <cmath>
+#include <cstring>
 #ifdef _MSC_VER
 #include <algorithm> /* std::max() */
 #endif
@@ -55,6 +56,21 @@ namespace Implementation {
         return T((U(1) - t)*a + t*b);
     }
 
+    /* Needed by Quaternion and Functions.h (to avoid dependency between them).
+       Initial estimate from the floating-point representation, refined with
+       two Newton-Raphson iterations. */
+    inline Float sqrtInvertedFast(const Float a) {
+        UnsignedInt bits;
+        std::memcpy(&bits, &a, sizeof(Float));
+        bits = 0x5f375a86u - (bits >> 1);
+        Float out;
+        std::memcpy(&out, &bits, sizeof(Float));
+
+        const Float half = a*0.5f;
+        out *= 1.5f - half*out*out;
+        return out*(1.5f - half*out*out);
+    }
+
     template<bool integral> struct IsZero;
     template<> struct IsZero<false> {
         template<std::size_t size, class T> bool operator()(const Vector<size, T>& vec) const {
@@ -31,6 +31,7 @@
 #include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Tracing.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
@@ -38,6 +39,8 @@
 #include "Implementation/BufferState.h"
 #include "Implementation/MeshState.h"
 #include "Implementation/State.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 namespace Magnum {
 
@@ -162,6 +165,9 @@ Mesh::Mesh(Mesh&& other) noexcept: _id(other._id), _primitive(other._primitive),
     _indexStart(other._indexStart), _indexEnd(other._indexEnd),
     #endif
     _indexOffset(other._indexOffset), _indexType(other._indexType), _indexBuffer(other._indexBuffer), _attributes(std::move(other._attributes))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexBindingStrides(std::move(other._vertexBindingStrides))
+    #endif
 {
     other._id = 0;
 }
@@ -185,6 +191,9 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     swap(_indexType, other._indexType);
     swap(_indexBuffer, other._indexBuffer);
     swap(_attributes, other._attributes);
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_vertexBindingStrides, other._vertexBindingStrides);
+    #endif
 
     return *this;
 }
@@ -245,6 +254,8 @@ Mesh& Mesh::setIndexBuffer(Buffer& buffer, GLintptr offset, IndexType type, Unsi
 }
 
 void Mesh::draw(AbstractShaderProgram& shader) {
+    MAGNUM_TRACE_ZONE("Mesh::draw");
+
     shader.use();
 
     #ifndef MAGNUM_TARGET_GLES
@@ -270,6 +281,8 @@ void Mesh::drawInternal(Int count, Int baseVertex, Int instanceCount, GLintptr i
     if(!count || !instanceCount) return;
 
     (this->*state.bindImplementation)();
+    MAGNUM_STATISTICS_INCREMENT(drawCalls);
+    MAGNUM_CAPTURE(draw(_id, GLenum(_primitive), count, baseVertex, instanceCount, _indexBuffer ? _indexBuffer->id() : 0, _indexBuffer ? GLenum(_indexType) : 0, indexOffset));
 
     /* Non-instanced mesh */
     if(instanceCount == 1) {
@@ -368,6 +381,7 @@ void Mesh::bindVAO() {
     if(current != _id) {
         /* Binding the VAO finally creates it */
         _flags |= ObjectFlag::Created;
+        MAGNUM_STATISTICS_INCREMENT(meshBinds);
         #ifndef MAGNUM_TARGET_GLES2
         glBindVertexArray(current = _id);
         #elif !defined(CORRADE_TARGET_NACL)
@@ -442,6 +456,25 @@ void Mesh::attributePointerImplementationVAO(AttributeLayout& attribute) {
 }
 
 #ifndef MAGNUM_TARGET_GLES
+void Mesh::attributePointerImplementationDSA(AttributeLayout& attribute) {
+    glEnableVertexArrayAttrib(_id, attribute.location);
+
+    /* Each attribute gets its own binding point so the buffer, offset and
+       stride can be specified without any bind */
+    if(attribute.kind == AttributeKind::Integral)
+        glVertexArrayAttribIFormat(_id, attribute.location, attribute.size, attribute.type, 0);
+    else if(attribute.kind == AttributeKind::Long)
+        glVertexArrayAttribLFormat(_id, attribute.location, attribute.size, attribute.type, 0);
+    else
+        glVertexArrayAttribFormat(_id, attribute.location, attribute.size, attribute.type, attribute.kind == AttributeKind::GenericNormalized, 0);
+
+    glVertexArrayAttribBinding(_id, attribute.location, attribute.location);
+    glVertexArrayVertexBuffer(_id, attribute.location, attribute.buffer.id(), attribute.offset, attribute.stride);
+
+    if(attribute.divisor)
+        vertexAttribDivisorImplementationDSA(attribute.location, attribute.divisor);
+}
+
 void Mesh::attributePointerImplementationDSAEXT(AttributeLayout& attribute) {
     _flags |= ObjectFlag::Created;
     glEnableVertexArrayAttribEXT(_id, attribute.location);
@@ -467,7 +500,11 @@ void Mesh::attributePointerImplementationDSAEXT(AttributeLayout& attribute) {
 void Mesh::vertexAttribPointer(AttributeLayout& attribute) {
     glEnableVertexAttribArray(attribute.location);
     attribute.buffer.bindInternal(Buffer::TargetHint::Array);
+    vertexAttribPointerFormat(attribute);
+    if(attribute.divisor) vertexAttribDivisor(attribute.location, attribute.divisor);
+}
 
+void Mesh::vertexAttribPointerFormat(const AttributeLayout& attribute) {
     #ifndef MAGNUM_TARGET_GLES2
     if(attribute.kind == AttributeKind::Integral)
         glVertexAttribIPointer(attribute.location, attribute.size, attribute.type, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
@@ -480,14 +517,14 @@ void Mesh::vertexAttribPointer(AttributeLayout& attribute) {
     {
         glVertexAttribPointer(attribute.location, attribute.size, attribute.type, attribute.kind == AttributeKind::GenericNormalized, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
     }
+}
 
-    if(attribute.divisor) {
-        #ifndef MAGNUM_TARGET_GLES2
-        glVertexAttribDivisor(attribute.location, attribute.divisor);
-        #else
-        (this->*Context::current().state().mesh->vertexAttribDivisorImplementation)(attribute.location, attribute.divisor);
-        #endif
-    }
+void Mesh::vertexAttribDivisor(const GLuint location, const GLuint divisor) {
+    #ifndef MAGNUM_TARGET_GLES2
+    glVertexAttribDivisor(location, divisor);
+    #else
+    (this->*Context::current().state().mesh->vertexAttribDivisorImplementation)(location, divisor);
+    #endif
 }
 
 #ifndef MAGNUM_TARGET_GLES
@@ -495,6 +532,10 @@ void Mesh::vertexAttribDivisorImplementationVAO(const GLuint index, const GLuint
     bindVAO();
     glVertexAttribDivisor(index, divisor);
 }
+void Mesh::vertexAttribDivisorImplementationDSA(const GLuint index, const GLuint divisor) {
+    /* Binding point index is the same as attribute location, see above */
+    glVertexArrayBindingDivisor(_id, index, divisor);
+}
 void Mesh::vertexAttribDivisorImplementationDSAEXT(const GLuint index, const GLuint divisor) {
     glVertexArrayVertexAttribDivisorEXT(_id, index, divisor);
 }
@@ -530,6 +571,77 @@ void Mesh::vertexAttribDivisorImplementationNV(const GLuint index, const GLuint
 #endif
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Mesh& Mesh::setVertexBuffer(const UnsignedInt binding, Buffer& buffer, const GLintptr offset) {
+    CORRADE_ASSERT(binding < _vertexBindingStrides.size(),
+        "Mesh::setVertexBuffer(): no vertex format added for binding" << binding, *this);
+
+    (this->*Context::current().state().mesh->bindVertexBufferImplementation)(binding, buffer.id(), offset, _vertexBindingStrides[binding]);
+    return *this;
+}
+
+void Mesh::vertexFormatInternal(const GLuint binding, const GLuint location, const GLint size, const GLenum type, const AttributeKind kind, const GLuint relativeOffset) {
+    (this->*Context::current().state().mesh->vertexFormatImplementation)(binding, location, size, type, kind, relativeOffset);
+}
+
+void Mesh::vertexBindingInternal(const GLuint binding, const GLsizei stride, const GLuint divisor) {
+    if(_vertexBindingStrides.size() <= binding)
+        _vertexBindingStrides.resize(binding + 1, 0);
+    _vertexBindingStrides[binding] = stride;
+
+    (this->*Context::current().state().mesh->vertexBindingDivisorImplementation)(binding, divisor);
+}
+
+void Mesh::vertexFormatImplementationDefault(const GLuint binding, const GLuint location, const GLint size, const GLenum type, const AttributeKind kind, const GLuint relativeOffset) {
+    bindVAO();
+    glEnableVertexAttribArray(location);
+
+    if(kind == AttributeKind::Integral)
+        glVertexAttribIFormat(location, size, type, relativeOffset);
+    #ifndef MAGNUM_TARGET_GLES
+    else if(kind == AttributeKind::Long)
+        glVertexAttribLFormat(location, size, type, relativeOffset);
+    #endif
+    else
+        glVertexAttribFormat(location, size, type, kind == AttributeKind::GenericNormalized, relativeOffset);
+
+    glVertexAttribBinding(location, binding);
+}
+
+void Mesh::vertexBindingDivisorImplementationDefault(const GLuint binding, const GLuint divisor) {
+    bindVAO();
+    glVertexBindingDivisor(binding, divisor);
+}
+
+void Mesh::bindVertexBufferImplementationDefault(const GLuint binding, const GLuint buffer, const GLintptr offset, const GLsizei stride) {
+    bindVAO();
+    glBindVertexBuffer(binding, buffer, offset, stride);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void Mesh::vertexFormatImplementationDSA(const GLuint binding, const GLuint location, const GLint size, const GLenum type, const AttributeKind kind, const GLuint relativeOffset) {
+    glEnableVertexArrayAttrib(_id, location);
+
+    if(kind == AttributeKind::Integral)
+        glVertexArrayAttribIFormat(_id, location, size, type, relativeOffset);
+    else if(kind == AttributeKind::Long)
+        glVertexArrayAttribLFormat(_id, location, size, type, relativeOffset);
+    else
+        glVertexArrayAttribFormat(_id, location, size, type, kind == AttributeKind::GenericNormalized, relativeOffset);
+
+    glVertexArrayAttribBinding(_id, location, binding);
+}
+
+void Mesh::vertexBindingDivisorImplementationDSA(const GLuint binding, const GLuint divisor) {
+    glVertexArrayBindingDivisor(_id, binding, divisor);
+}
+
+void Mesh::bindVertexBufferImplementationDSA(const GLuint binding, const GLuint buffer, const GLintptr offset, const GLsizei stride) {
+    glVertexArrayVertexBuffer(_id, binding, buffer, offset, stride);
+}
+#endif
+#endif
+
 void Mesh::bindIndexBufferImplementationDefault(Buffer&) {}
 
 void Mesh::bindIndexBufferImplementationVAO(Buffer& buffer) {
@@ -542,10 +654,63 @@ void Mesh::bindIndexBufferImplementationVAO(Buffer& buffer) {
     buffer.bindInternal(Buffer::TargetHint::ElementArray);
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void Mesh::bindIndexBufferImplementationDSA(Buffer& buffer) {
+    glVertexArrayElementBuffer(_id, buffer.id());
+
+    /* The ElementArray binding is part of VAO state, update the tracked value
+       if this VAO is currently bound */
+    Implementation::State& state = Context::current().state();
+    if(state.mesh->currentVAO == _id)
+        state.buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = buffer.id();
+}
+#endif
+
 void Mesh::bindImplementationDefault() {
-    /* Specify vertex attributes */
-    for(AttributeLayout& attribute: _attributes)
-        vertexAttribPointer(attribute);
+    MAGNUM_STATISTICS_INCREMENT(meshBinds);
+
+    Implementation::MeshState& state = *Context::current().state().mesh;
+    ++state.bindCount;
+
+    /* Specify only vertex attributes that differ from what the previously
+       drawn meshes left there */
+    for(AttributeLayout& attribute: _attributes) {
+        if(attribute.location >= state.vertexAttributes.size())
+            state.vertexAttributes.resize(attribute.location + 1);
+
+        Implementation::MeshState::VertexAttribute& current = state.vertexAttributes[attribute.location];
+        current.bindCount = state.bindCount;
+
+        if(current.enabled != 1) {
+            glEnableVertexAttribArray(attribute.location);
+            current.enabled = 1;
+        }
+
+        if(current.buffer != attribute.buffer.id() || current.offset != attribute.offset || current.stride != attribute.stride || current.size != attribute.size || current.type != attribute.type || current.kind != attribute.kind) {
+            attribute.buffer.bindInternal(Buffer::TargetHint::Array);
+            vertexAttribPointerFormat(attribute);
+            current.buffer = attribute.buffer.id();
+            current.offset = attribute.offset;
+            current.stride = attribute.stride;
+            current.size = attribute.size;
+            current.type = attribute.type;
+            current.kind = attribute.kind;
+        }
+
+        if(current.divisor != attribute.divisor) {
+            vertexAttribDivisor(attribute.location, attribute.divisor);
+            current.divisor = attribute.divisor;
+        }
+    }
+
+    /* Disable attributes left enabled by previously drawn meshes */
+    for(std::size_t i = 0; i != state.vertexAttributes.size(); ++i) {
+        Implementation::MeshState::VertexAttribute& current = state.vertexAttributes[i];
+        if(current.enabled == 0 || current.bindCount == state.bindCount) continue;
+
+        glDisableVertexAttribArray(i);
+        current.enabled = 0;
+    }
 
     /* Bind index buffer, if the mesh is indexed */
     if(_indexBuffer) _indexBuffer->bindInternal(Buffer::TargetHint::ElementArray);
@@ -556,8 +721,8 @@ void Mesh::bindImplementationVAO() {
 }
 
 void Mesh::unbindImplementationDefault() {
-    for(const AttributeLayout& attribute: _attributes)
-        glDisableVertexAttribArray(attribute.location);
+    /* Attributes are kept enabled, the next bindImplementationDefault()
+       disables the ones that the next mesh doesn't use */
 }
 
 void Mesh::unbindImplementationVAO() {}
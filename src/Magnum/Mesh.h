@@ -781,6 +781,90 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             return *this;
         }
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Add (interleaved) vertex attribute format sourced from given binding
+         * @return Reference to self (for method chaining)
+         *
+         * Alternative to @ref addVertexBuffer() that specifies only the
+         * attribute layout, without baking any buffer into it. The attribute
+         * list has the same meaning as in @ref addVertexBuffer(), with offsets
+         * relative to the beginning of each vertex. The buffer is then
+         * attached to the @p binding using @ref setVertexBuffer() and can be
+         * swapped at any time without re-specifying the attributes:
+         * @code
+         * Mesh mesh;
+         * mesh.addVertexFormat(0, Shaders::Phong::Position{}, Shaders::Phong::Normal{})
+         *     .setCount(vertexCount);
+         *
+         * // For each frame, draw from a different part of a streamed buffer
+         * mesh.setVertexBuffer(0, ringBuffer, frameOffset)
+         *     .draw(shader);
+         * @endcode
+         *
+         * Don't mix this with @ref addVertexBuffer() on the same attribute
+         * locations. The vertex array object is always used to hold the
+         * parameters.
+         * @see @ref addVertexFormatInstanced(), @fn_gl{BindVertexArray},
+         *      @fn_gl{EnableVertexAttribArray}, @fn_gl{VertexAttribFormat},
+         *      @fn_gl{VertexAttribBinding} or
+         *      @fn_gl{EnableVertexArrayAttrib}, @fn_gl{VertexArrayAttribFormat},
+         *      @fn_gl{VertexArrayAttribBinding}
+         * @requires_gl43 Extension @extension{ARB,vertex_attrib_binding}
+         * @requires_gles31 Separate attribute format is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Separate attribute format is not available in WebGL.
+         */
+        template<class ...T> Mesh& addVertexFormat(UnsignedInt binding, const T&... attributes) {
+            addVertexFormatInternal(binding, 0, attributes...);
+            vertexBindingInternal(binding, strideOfInterleaved(attributes...), 0);
+            return *this;
+        }
+
+        /**
+         * @brief Add instanced vertex attribute format
+         * @return Reference to self (for method chaining)
+         *
+         * Similar to @ref addVertexFormat(), the @p divisor parameter
+         * specifies number of instances that will pass until new data are
+         * fetched from the buffer attached to @p binding.
+         * @see @fn_gl{VertexBindingDivisor} or
+         *      @fn_gl{VertexArrayBindingDivisor}
+         * @requires_gl43 Extension @extension{ARB,vertex_attrib_binding}
+         * @requires_gles31 Separate attribute format is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Separate attribute format is not available in WebGL.
+         */
+        template<class ...T> Mesh& addVertexFormatInstanced(UnsignedInt binding, UnsignedInt divisor, const T&... attributes) {
+            addVertexFormatInternal(binding, 0, attributes...);
+            vertexBindingInternal(binding, strideOfInterleaved(attributes...), divisor);
+            return *this;
+        }
+
+        /**
+         * @brief Attach vertex buffer to given binding
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches @p buffer at @p offset to a binding previously set up with
+         * @ref addVertexFormat() or @ref addVertexFormatInstanced(), using the
+         * stride of the attribute format. This is a single GL call, so it's
+         * cheap enough to be done before every draw --- e.g. for switching
+         * level of detail or for drawing from a ring buffer.
+         *
+         * @attention The buffer passed as parameter is not managed by the
+         *      mesh, you must ensure it will exist for whole lifetime of the
+         *      mesh or until another buffer is attached to the binding.
+         *
+         * @see @fn_gl{BindVertexArray}, @fn_gl{BindVertexBuffer} or
+         *      @fn_gl{VertexArrayVertexBuffer}
+         * @requires_gl43 Extension @extension{ARB,vertex_attrib_binding}
+         * @requires_gles31 Separate attribute format is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Separate attribute format is not available in WebGL.
+         */
+        Mesh& setVertexBuffer(UnsignedInt binding, Buffer& buffer, GLintptr offset);
+        #endif
+
         /**
          * @brief Set index buffer
          * @param buffer        Index buffer
@@ -899,6 +983,55 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         }
         void addVertexBufferInternal(Buffer&, GLsizei, GLuint, GLintptr) {}
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Adding interleaved vertex attribute formats */
+        template<UnsignedInt location, class T, class ...U> void addVertexFormatInternal(GLuint binding, GLuint relativeOffset, const Attribute<location, T>& attribute, const U&... attributes) {
+            addVertexFormatAttribute(binding, attribute, relativeOffset);
+
+            /* Add size of this attribute to offset for next attribute */
+            addVertexFormatInternal(binding, relativeOffset+attribute.vectorSize()*Attribute<location, T>::VectorCount, attributes...);
+        }
+        template<class ...T> void addVertexFormatInternal(GLuint binding, GLuint relativeOffset, GLintptr gap, const T&... attributes) {
+            /* Add the gap to offset for next attribute */
+            addVertexFormatInternal(binding, GLuint(relativeOffset+gap), attributes...);
+        }
+        void addVertexFormatInternal(GLuint, GLuint) {}
+
+        template<UnsignedInt location, class T> void addVertexFormatAttribute(GLuint binding, const Attribute<location, T>& attribute, typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::ScalarType, Float>::value, GLuint>::type relativeOffset) {
+            for(UnsignedInt i = 0; i != Attribute<location, T>::VectorCount; ++i)
+                vertexFormatInternal(binding,
+                    location+i,
+                    GLint(attribute.components()),
+                    GLenum(attribute.dataType()),
+                    attribute.dataOptions() & Attribute<location, T>::DataOption::Normalized ? AttributeKind::GenericNormalized : AttributeKind::Generic,
+                    relativeOffset+i*attribute.vectorSize());
+        }
+
+        template<UnsignedInt location, class T> void addVertexFormatAttribute(GLuint binding, const Attribute<location, T>& attribute, typename std::enable_if<std::is_integral<typename Implementation::Attribute<T>::ScalarType>::value, GLuint>::type relativeOffset) {
+            vertexFormatInternal(binding,
+                location,
+                GLint(attribute.components()),
+                GLenum(attribute.dataType()),
+                AttributeKind::Integral,
+                relativeOffset);
+        }
+
+        #ifndef MAGNUM_TARGET_GLES
+        template<UnsignedInt location, class T> void addVertexFormatAttribute(GLuint binding, const Attribute<location, T>& attribute, typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::ScalarType, Double>::value, GLuint>::type relativeOffset) {
+            for(UnsignedInt i = 0; i != Attribute<location, T>::VectorCount; ++i)
+                vertexFormatInternal(binding,
+                    location+i,
+                    GLint(attribute.components()),
+                    GLenum(attribute.dataType()),
+                    AttributeKind::Long,
+                    relativeOffset+i*attribute.vectorSize());
+        }
+        #endif
+
+        void vertexFormatInternal(GLuint binding, GLuint location, GLint size, GLenum type, AttributeKind kind, GLuint relativeOffset);
+        void vertexBindingInternal(GLuint binding, GLsizei stride, GLuint divisor);
+        #endif
+
         template<UnsignedInt location, class T> void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::ScalarType, Float>::value, Buffer&>::type buffer, const Attribute<location, T>& attribute, GLintptr offset, GLsizei stride, GLuint divisor) {
             for(UnsignedInt i = 0; i != Attribute<location, T>::VectorCount; ++i)
                 attributePointerInternal(buffer,
@@ -962,12 +1095,16 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         void MAGNUM_LOCAL attributePointerImplementationDefault(AttributeLayout& attribute);
         void MAGNUM_LOCAL attributePointerImplementationVAO(AttributeLayout& attribute);
         #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL attributePointerImplementationDSA(AttributeLayout& attribute);
         void MAGNUM_LOCAL attributePointerImplementationDSAEXT(AttributeLayout& attribute);
         #endif
         void MAGNUM_LOCAL vertexAttribPointer(AttributeLayout& attribute);
+        void MAGNUM_LOCAL vertexAttribPointerFormat(const AttributeLayout& attribute);
+        void MAGNUM_LOCAL vertexAttribDivisor(GLuint location, GLuint divisor);
 
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL vertexAttribDivisorImplementationVAO(GLuint index, GLuint divisor);
+        void MAGNUM_LOCAL vertexAttribDivisorImplementationDSA(GLuint index, GLuint divisor);
         void MAGNUM_LOCAL vertexAttribDivisorImplementationDSAEXT(GLuint index, GLuint divisor);
         #elif defined(MAGNUM_TARGET_GLES2)
         void MAGNUM_LOCAL vertexAttribDivisorImplementationANGLE(GLuint index, GLuint divisor);
@@ -977,8 +1114,22 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         #endif
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        void MAGNUM_LOCAL vertexFormatImplementationDefault(GLuint binding, GLuint location, GLint size, GLenum type, AttributeKind kind, GLuint relativeOffset);
+        void MAGNUM_LOCAL vertexBindingDivisorImplementationDefault(GLuint binding, GLuint divisor);
+        void MAGNUM_LOCAL bindVertexBufferImplementationDefault(GLuint binding, GLuint buffer, GLintptr offset, GLsizei stride);
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL vertexFormatImplementationDSA(GLuint binding, GLuint location, GLint size, GLenum type, AttributeKind kind, GLuint relativeOffset);
+        void MAGNUM_LOCAL vertexBindingDivisorImplementationDSA(GLuint binding, GLuint divisor);
+        void MAGNUM_LOCAL bindVertexBufferImplementationDSA(GLuint binding, GLuint buffer, GLintptr offset, GLsizei stride);
+        #endif
+        #endif
+
         void MAGNUM_LOCAL bindIndexBufferImplementationDefault(Buffer&);
         void MAGNUM_LOCAL bindIndexBufferImplementationVAO(Buffer& buffer);
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL bindIndexBufferImplementationDSA(Buffer& buffer);
+        #endif
 
         void MAGNUM_LOCAL bindImplementationDefault();
         void MAGNUM_LOCAL bindImplementationVAO();
@@ -1015,6 +1166,9 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         Buffer* _indexBuffer;
 
         std::vector<AttributeLayout> _attributes;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        std::vector<GLsizei> _vertexBindingStrides;
+        #endif
 };
 
 /** @debugoperatorenum{Magnum::MeshPrimitive} */
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshPool.h"
+
+#include <iterator>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+
+namespace Magnum {
+
+MeshPool::Heap::Heap(const Buffer::TargetHint targetHint, const GLsizeiptr requestedCapacity): buffer{targetHint}, capacity{requestedCapacity}, pageSize{}, committedPageCount{} {
+    /* Sparse storage of zero size is an error, so e.g. an index heap of
+       non-indexed meshes is always a regular empty buffer */
+    if(requestedCapacity &&
+       Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_buffer>() &&
+       Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) {
+        pageSize = Buffer::sparsePageSize();
+        capacity = (capacity + pageSize - 1)/pageSize*pageSize;
+        pageUses.resize(capacity/pageSize);
+        buffer.setStorage({nullptr, std::size_t(capacity)}, Buffer::StorageFlag::Sparse|Buffer::StorageFlag::DynamicStorage);
+    } else buffer.setData({nullptr, std::size_t(capacity)}, BufferUsage::StaticDraw);
+
+    if(capacity) free.emplace(0, capacity);
+}
+
+GLintptr MeshPool::Heap::allocate(const GLsizeiptr size, const GLintptr alignment) {
+    /* First fit. The part of the block before the aligned offset stays
+       free and gets merged back in release(). */
+    for(auto it = free.begin(); it != free.end(); ++it) {
+        const GLintptr offset = (it->first + alignment - 1)/alignment*alignment;
+        const GLintptr end = it->first + it->second;
+        if(offset + size > end) continue;
+
+        const GLintptr blockOffset = it->first;
+        free.erase(it);
+        if(offset != blockOffset) free.emplace(blockOffset, offset - blockOffset);
+        if(offset + size != end) free.emplace(offset + size, end - offset - size);
+        return offset;
+    }
+
+    return -1;
+}
+
+void MeshPool::Heap::release(const GLintptr offset, GLsizeiptr size) {
+    /* Merge with the following block */
+    auto next = free.lower_bound(offset);
+    if(next != free.end() && offset + size == next->first) {
+        size += next->second;
+        next = free.erase(next);
+    }
+
+    /* Merge with the preceding block */
+    if(next != free.begin()) {
+        const auto previous = std::prev(next);
+        if(previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+
+    free.emplace_hint(next, offset, size);
+}
+
+/* Pages are committed one by one so the decommit calls match the commit
+   calls, which is needed for precise memory usage tracking */
+void MeshPool::Heap::commit(const GLintptr offset, const GLsizeiptr size) {
+    if(!pageSize) return;
+
+    for(GLintptr i = offset/pageSize, end = (offset + size - 1)/pageSize; i <= end; ++i) {
+        if(pageUses[i]++) continue;
+        buffer.commitPages(i*pageSize, pageSize);
+        ++committedPageCount;
+    }
+}
+
+void MeshPool::Heap::decommit(const GLintptr offset, const GLsizeiptr size) {
+    if(!pageSize) return;
+
+    for(GLintptr i = offset/pageSize, end = (offset + size - 1)/pageSize; i <= end; ++i) {
+        CORRADE_INTERNAL_ASSERT(pageUses[i]);
+        if(--pageUses[i]) continue;
+        buffer.decommitPages(i*pageSize, pageSize);
+        --committedPageCount;
+    }
+}
+
+MeshPool::MeshPool(const GLsizeiptr vertexCapacity, const GLsizeiptr indexCapacity): _vertices{Buffer::TargetHint::Array, vertexCapacity}, _indices{Buffer::TargetHint::ElementArray, indexCapacity} {}
+
+GLsizeiptr MeshPool::committedSize() const {
+    if(!isSparse()) return _vertices.capacity + _indices.capacity;
+    return _vertices.committedPageCount*_vertices.pageSize + _indices.committedPageCount*_indices.pageSize;
+}
+
+std::optional<MeshPool::Allocation> MeshPool::add(const Containers::ArrayView<const void> vertexData, const GLintptr vertexAlignment, const Containers::ArrayView<const void> indexData, const GLintptr indexAlignment) {
+    CORRADE_ASSERT(vertexAlignment > 0 && indexAlignment > 0,
+        "MeshPool::add(): alignment must be positive", std::nullopt);
+    CORRADE_ASSERT(!vertexData.empty(),
+        "MeshPool::add(): no vertex data", std::nullopt);
+
+    Allocation allocation{};
+    allocation.vertexSize = vertexData.size();
+    allocation.vertexOffset = _vertices.allocate(allocation.vertexSize, vertexAlignment);
+    if(allocation.vertexOffset == -1) return std::nullopt;
+
+    if(!indexData.empty()) {
+        allocation.indexSize = indexData.size();
+        allocation.indexOffset = _indices.allocate(allocation.indexSize, indexAlignment);
+
+        /* Roll back the vertex allocation so the pool is left untouched */
+        if(allocation.indexOffset == -1) {
+            _vertices.release(allocation.vertexOffset, allocation.vertexSize);
+            return std::nullopt;
+        }
+
+        _indices.commit(allocation.indexOffset, allocation.indexSize);
+        _indices.buffer.setSubData(allocation.indexOffset, indexData);
+    }
+
+    _vertices.commit(allocation.vertexOffset, allocation.vertexSize);
+    _vertices.buffer.setSubData(allocation.vertexOffset, vertexData);
+
+    return allocation;
+}
+
+void MeshPool::remove(const Allocation& allocation) {
+    _vertices.decommit(allocation.vertexOffset, allocation.vertexSize);
+    _vertices.release(allocation.vertexOffset, allocation.vertexSize);
+
+    if(allocation.indexSize) {
+        _indices.decommit(allocation.indexOffset, allocation.indexSize);
+        _indices.release(allocation.indexOffset, allocation.indexSize);
+    }
+}
+
+}
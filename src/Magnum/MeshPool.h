@@ -0,0 +1,220 @@
+#ifndef Magnum_MeshPool_h
+#define Magnum_MeshPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::MeshPool
+ */
+#endif
+
+#include <map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Buffer.h"
+
+#include "MagnumExternal/Optional/optional.hpp"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Growable pool of mesh data
+
+Sub-allocates vertex and index data of many meshes from a single pair of
+buffers with large capacity, so all of them can be drawn through a single
+@ref Mesh (and thus a single vertex array object) using @ref MeshView with
+base vertex and index offset. Meshes can be added and removed at any time
+without reallocating the buffers, copying the data with @ref Buffer::copy()
+or reconfiguring the mesh.
+
+## Usage
+
+Create the pool with a capacity large enough for all data that can ever be
+resident, configure the mesh with the pool buffers once and then add the data
+of each mesh, using the vertex stride as vertex alignment:
+@code
+MeshPool pool{512*1024*1024, 128*1024*1024};
+
+Mesh mesh;
+mesh.addVertexBuffer(pool.vertexBuffer(), 0, Shaders::Phong::Position{}, Shaders::Phong::Normal{})
+    .setIndexBuffer(pool.indexBuffer(), 0, Mesh::IndexType::UnsignedInt);
+
+std::optional<MeshPool::Allocation> a = pool.add(vertices, sizeof(Vertex), indices, sizeof(UnsignedInt));
+
+MeshView view{mesh};
+view.setCount(indices.size())
+    .setBaseVertex(a->vertexOffset/sizeof(Vertex))
+    .setIndexRange(a->indexOffset/sizeof(UnsignedInt));
+view.draw(shader);
+
+// later
+pool.remove(*a);
+@endcode
+
+Freed space is merged with neighboring free space and reused for subsequent
+allocations.
+
+@anchor MeshPool-implementation
+## Implementation
+
+If @extension{ARB,sparse_buffer} together with @extension{ARB,buffer_storage}
+(part of OpenGL 4.4) is supported, the capacity is only reserved as virtual
+address space using @ref Buffer::StorageFlag::Sparse and the pages are
+committed with @ref Buffer::commitPages() when the first allocation touches
+them. Pages that are not used by any allocation anymore are decommitted in
+@ref remove(), so the memory usage follows the actual amount of data in the
+pool. The capacity is rounded up to a multiple of @ref Buffer::sparsePageSize().
+
+Otherwise the whole capacity is allocated upfront.
+
+@see @ref isSparse()
+@requires_gl32 Extension @extension{ARB,draw_elements_base_vertex} for
+    drawing the meshes with base vertex.
+@requires_gl Sparse buffers and base vertex are not available in OpenGL ES
+    and WebGL.
+*/
+class MAGNUM_EXPORT MeshPool {
+    public:
+        /** @brief Allocated mesh data */
+        struct Allocation {
+            GLintptr vertexOffset;      /**< @brief Vertex data offset */
+            GLsizeiptr vertexSize;      /**< @brief Vertex data size */
+            GLintptr indexOffset;       /**< @brief Index data offset */
+            GLsizeiptr indexSize;       /**< @brief Index data size */
+        };
+
+        /**
+         * @brief Constructor
+         * @param vertexCapacity    Vertex buffer capacity in bytes
+         * @param indexCapacity     Index buffer capacity in bytes
+         *
+         * Creates the buffers and reserves their storage. The
+         * @p indexCapacity can be `0` for pools of non-indexed meshes.
+         * @see @ref Buffer::setStorage(), @ref Buffer::setData()
+         */
+        explicit MeshPool(GLsizeiptr vertexCapacity, GLsizeiptr indexCapacity);
+
+        /** @brief Copying is not allowed */
+        MeshPool(const MeshPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        MeshPool(MeshPool&&) = delete;
+
+        /** @brief Copying is not allowed */
+        MeshPool& operator=(const MeshPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        MeshPool& operator=(MeshPool&&) = delete;
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertices.buffer; }
+
+        /** @brief Index buffer */
+        Buffer& indexBuffer() { return _indices.buffer; }
+
+        /** @brief Vertex buffer capacity in bytes */
+        GLsizeiptr vertexCapacity() const { return _vertices.capacity; }
+
+        /** @brief Index buffer capacity in bytes */
+        GLsizeiptr indexCapacity() const { return _indices.capacity; }
+
+        /**
+         * @brief Whether the buffers are sparse
+         *
+         * See @ref MeshPool-implementation "class documentation" for more
+         * information.
+         */
+        bool isSparse() const { return _vertices.pageSize != 0; }
+
+        /**
+         * @brief Size of committed memory in bytes
+         *
+         * Sum of committed pages in both buffers. If the buffers are not
+         * sparse, returns sum of their capacities.
+         */
+        GLsizeiptr committedSize() const;
+
+        /**
+         * @brief Add mesh data
+         * @param vertexData        Vertex data
+         * @param vertexAlignment   Vertex data offset alignment, usually
+         *      the vertex stride
+         * @param indexData         Index data
+         * @param indexAlignment    Index data offset alignment, usually the
+         *      index type size
+         * @return Location of the data in the buffers or
+         *      @ref std::nullopt if there's no space left for them. In that
+         *      case the pool is not modified.
+         *
+         * Commits pages covering the data, if the buffers are sparse, and
+         * uploads the data using @ref Buffer::setSubData(). Both
+         * @p vertexAlignment and @p indexAlignment are expected to be
+         * positive. Empty @p indexData are allowed for non-indexed meshes,
+         * the index offset and size is then `0`.
+         */
+        std::optional<Allocation> add(Containers::ArrayView<const void> vertexData, GLintptr vertexAlignment, Containers::ArrayView<const void> indexData, GLintptr indexAlignment);
+
+        /**
+         * @brief Remove mesh data
+         *
+         * Frees space occupied by @p allocation and decommits pages that are
+         * not used by any other allocation, if the buffers are sparse. The
+         * data must not be used by OpenGL after this call.
+         */
+        void remove(const Allocation& allocation);
+
+    private:
+        struct MAGNUM_LOCAL Heap {
+            explicit Heap(Buffer::TargetHint targetHint, GLsizeiptr capacity);
+
+            /* Returns -1 if there's no space */
+            GLintptr allocate(GLsizeiptr size, GLintptr alignment);
+            void release(GLintptr offset, GLsizeiptr size);
+
+            void commit(GLintptr offset, GLsizeiptr size);
+            void decommit(GLintptr offset, GLsizeiptr size);
+
+            Buffer buffer;
+            GLsizeiptr capacity, pageSize;
+
+            /* Free blocks, ordered by offset, and count of allocations in
+               each page */
+            std::map<GLintptr, GLsizeiptr> free;
+            std::vector<UnsignedInt> pageUses;
+            std::size_t committedPageCount;
+        };
+
+        Heap _vertices, _indices;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
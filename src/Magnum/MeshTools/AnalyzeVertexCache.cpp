@@ -0,0 +1,80 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "AnalyzeVertexCache.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace MeshTools {
+
+VertexCacheStatistics analyzeVertexCache(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(indices.size()%3 == 0,
+        "MeshTools::analyzeVertexCache(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::analyzeVertexCache(): cache size can't be zero", {});
+
+    /* Simulated cache, the most recently added vertex is at the end */
+    std::vector<UnsignedInt> cache;
+    cache.reserve(cacheSize + 1);
+
+    /* Per-vertex flag whether the vertex was referenced */
+    std::vector<bool> referenced(vertexCount);
+
+    std::size_t transformedVertexCount = 0;
+    std::size_t referencedVertexCount = 0;
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::analyzeVertexCache(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+
+        if(!referenced[index]) {
+            referenced[index] = true;
+            ++referencedVertexCount;
+        }
+
+        /* Cache hit, with LRU move the vertex to the front again */
+        auto found = std::find(cache.begin(), cache.end(), index);
+        if(found != cache.end()) {
+            if(model == VertexCacheModel::Lru) {
+                cache.erase(found);
+                cache.push_back(index);
+            }
+            continue;
+        }
+
+        /* Cache miss, transform the vertex and evict the oldest one */
+        ++transformedVertexCount;
+        cache.push_back(index);
+        if(cache.size() > cacheSize) cache.erase(cache.begin());
+    }
+
+    const std::size_t triangleCount = indices.size()/3;
+    return {transformedVertexCount,
+        triangleCount ? Float(transformedVertexCount)/triangleCount : 0.0f,
+        referencedVertexCount ? Float(transformedVertexCount)/referencedVertexCount : 0.0f};
+}
+
+}}
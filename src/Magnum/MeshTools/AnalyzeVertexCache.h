@@ -0,0 +1,123 @@
+#ifndef Magnum_MeshTools_AnalyzeVertexCache_h
+#define Magnum_MeshTools_AnalyzeVertexCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::analyzeVertexCache(), struct @ref Magnum::MeshTools::VertexCacheStatistics, enum @ref Magnum::MeshTools::VertexCacheModel
+ */
+
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Post-transform vertex cache model
+
+@see @ref analyzeVertexCache()
+*/
+enum class VertexCacheModel: UnsignedByte {
+    /**
+     * First-in first-out cache. A cache hit doesn't change the position of
+     * the vertex in the cache. This is how most of the hardware behaves.
+     */
+    Fifo,
+
+    /**
+     * Least-recently-used cache. A cache hit moves the vertex to the front
+     * of the cache. This models an ideal cache and is used by
+     * @ref optimizeVertexCache().
+     */
+    Lru
+};
+
+/**
+@brief Post-transform vertex cache statistics
+
+@see @ref analyzeVertexCache()
+*/
+struct VertexCacheStatistics {
+    /** @brief Count of vertex shader invocations */
+    std::size_t transformedVertexCount;
+
+    /**
+     * @brief Average cache miss ratio
+     *
+     * Count of transformed vertices per triangle. Ranges from `3.0` (every
+     * vertex of every triangle is transformed) to roughly `0.5` for large
+     * regular grids.
+     */
+    Float acmr;
+
+    /**
+     * @brief Average transform to vertex ratio
+     *
+     * Count of transformed vertices per each referenced vertex. The ideal
+     * value is `1.0`, which means that every vertex is transformed exactly
+     * once. Unlike @ref acmr it doesn't depend on mesh topology, so it's
+     * better suited for comparing different meshes.
+     */
+    Float atvr;
+};
+
+/**
+@brief Analyze post-transform vertex cache efficiency
+@param indices      Triangle index array
+@param vertexCount  Vertex count
+@param cacheSize    Simulated post-transform vertex cache size
+@param model        Simulated cache model
+
+Simulates post-transform vertex cache of given size and returns the count of
+vertex shader invocations needed to render given index array. Useful for
+verifying results of @ref tipsify() and @ref optimizeVertexCache() or for
+picking the better one for particular mesh. Example usage:
+@code
+std::vector<UnsignedInt> indices;
+UnsignedInt vertexCount;
+
+std::vector<UnsignedInt> tipsified = indices;
+MeshTools::tipsify(tipsified, vertexCount, 24);
+std::vector<UnsignedInt> optimized = indices;
+MeshTools::optimizeVertexCache(optimized, vertexCount, 24);
+
+if(MeshTools::analyzeVertexCache(tipsified, vertexCount, 24).acmr <
+   MeshTools::analyzeVertexCache(optimized, vertexCount, 24).acmr)
+    indices = std::move(tipsified);
+else
+    indices = std::move(optimized);
+@endcode
+
+Expects that the index count is divisible by 3 and all indices are smaller
+than @p vertexCount.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+}}
+
+#endif
@@ -0,0 +1,252 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BuildMeshlets.h"
+
+#include <cmath>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+constexpr UnsignedInt NoTriangle = ~UnsignedInt{};
+
+/* Ritter's bounding sphere, not optimal but at most a few percent larger */
+void boundingSphere(const std::vector<Vector3>& positions, const std::vector<UnsignedInt>& vertices, Meshlet& meshlet) {
+    /* Find the farthest point from the first one and the farthest point from
+       that one */
+    const Vector3 first = positions[vertices.front()];
+    Vector3 a = first;
+    for(const UnsignedInt v: vertices)
+        if((positions[v] - first).dot() > (a - first).dot()) a = positions[v];
+    Vector3 b = a;
+    for(const UnsignedInt v: vertices)
+        if((positions[v] - a).dot() > (b - a).dot()) b = positions[v];
+
+    /* Grow the sphere around them to include all points */
+    Vector3 center = (a + b)*0.5f;
+    Float radius = (b - a).length()*0.5f;
+    for(const UnsignedInt v: vertices) {
+        const Float distance = (positions[v] - center).length();
+        if(distance <= radius) continue;
+
+        const Float newRadius = (radius + distance)*0.5f;
+        center += (positions[v] - center)*((newRadius - radius)/distance);
+        radius = newRadius;
+    }
+
+    meshlet.center = center;
+    meshlet.radius = radius;
+}
+
+void normalCone(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, Meshlet& meshlet) {
+    const std::size_t end = meshlet.indexOffset + meshlet.indexCount;
+
+    /* Average of all normals, degenerate triangles are skipped */
+    Vector3 sum;
+    for(std::size_t i = meshlet.indexOffset; i != end; i += 3) {
+        const Vector3 normal = Math::cross(positions[indices[i + 2]] - positions[indices[i + 1]], positions[indices[i]] - positions[indices[i + 1]]);
+        const Float length = normal.length();
+        if(length > 0.0f) sum += normal/length;
+    }
+
+    const Float sumLength = sum.length();
+    if(sumLength <= std::numeric_limits<Float>::epsilon()) {
+        meshlet.coneAxis = Vector3::zAxis();
+        meshlet.coneCutoff = 1.0f;
+        return;
+    }
+
+    /* The cone half-angle is given by the normal most deviating from the
+       axis */
+    meshlet.coneAxis = sum/sumLength;
+    Float minDot = 1.0f;
+    for(std::size_t i = meshlet.indexOffset; i != end; i += 3) {
+        const Vector3 normal = Math::cross(positions[indices[i + 2]] - positions[indices[i + 1]], positions[indices[i]] - positions[indices[i + 1]]);
+        const Float length = normal.length();
+        if(length > 0.0f) minDot = Math::min(minDot, Math::dot(normal/length, meshlet.coneAxis));
+    }
+
+    meshlet.coneCutoff = minDot > 0.0f ? std::sqrt(1.0f - minDot*minDot) : 1.0f;
+}
+
+}
+
+std::vector<Meshlet> buildMeshlets(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.size()%3 == 0,
+        "MeshTools::buildMeshlets(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxTriangleCount >= 1,
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per meshlet but got" << maxVertexCount << "and" << maxTriangleCount, {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::buildMeshlets(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+    #endif
+
+    /* Neighboring triangles for each vertex */
+    const UnsignedInt vertexCount = positions.size();
+    std::vector<UnsignedInt> triangleCount, neighborOffset, neighbors;
+    Implementation::Tipsify(indices, vertexCount).buildAdjacency(triangleCount, neighborOffset, neighbors);
+
+    /* Triangle centroids for spatial tie-breaking */
+    const std::size_t inputTriangleCount = indices.size()/3;
+    std::vector<Vector3> centroids;
+    centroids.reserve(inputTriangleCount);
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        centroids.push_back((positions[indices[i]] + positions[indices[i + 1]] + positions[indices[i + 2]])/3.0f);
+
+    /* Per-triangle emitted flag, per-vertex ID of the last meshlet that
+       contains it */
+    std::vector<bool> emitted(inputTriangleCount);
+    std::vector<UnsignedInt> vertexMeshlet(vertexCount, ~UnsignedInt{});
+
+    std::vector<UnsignedInt> outputIndices;
+    outputIndices.reserve(indices.size());
+    std::vector<Meshlet> meshlets;
+
+    /* Vertices of current meshlet */
+    std::vector<UnsignedInt> vertices;
+    vertices.reserve(maxVertexCount);
+
+    std::size_t cursor = 0;
+    for(;;) {
+        /* Find a triangle for a new meshlet, if any */
+        while(cursor != inputTriangleCount && emitted[cursor]) ++cursor;
+        if(cursor == inputTriangleCount) break;
+
+        const UnsignedInt id = meshlets.size();
+        const UnsignedInt indexOffset = outputIndices.size();
+        vertices.clear();
+        Vector3 centroidSum;
+        UnsignedInt meshletTriangleCount = 0;
+
+        /* Count of vertices the triangle would add to current meshlet */
+        auto newVertexCount = [&](const UnsignedInt t) {
+            const UnsignedInt a = indices[t*3], b = indices[t*3 + 1], c = indices[t*3 + 2];
+            return UnsignedInt(vertexMeshlet[a] != id) +
+                   UnsignedInt(vertexMeshlet[b] != id && b != a) +
+                   UnsignedInt(vertexMeshlet[c] != id && c != a && c != b);
+        };
+
+        UnsignedInt t = cursor;
+        for(;;) {
+            /* Add the triangle to the meshlet */
+            emitted[t] = true;
+            for(UnsignedInt vi = 0; vi != 3; ++vi) {
+                const UnsignedInt v = indices[t*3 + vi];
+                outputIndices.push_back(v);
+                if(vertexMeshlet[v] != id) {
+                    vertexMeshlet[v] = id;
+                    vertices.push_back(v);
+                }
+            }
+            centroidSum += centroids[t];
+            if(++meshletTriangleCount == maxTriangleCount) break;
+
+            /* Pick the neighbor triangle adding the least new vertices, the
+               closest one to the meshlet centroid on a tie */
+            const Vector3 centroid = centroidSum/Float(meshletTriangleCount);
+            UnsignedInt best = NoTriangle;
+            UnsignedInt bestNewVertexCount = 4;
+            Float bestDistance = 0.0f;
+            for(const UnsignedInt v: vertices) {
+                for(UnsignedInt ti = neighborOffset[v]; ti != neighborOffset[v + 1]; ++ti) {
+                    const UnsignedInt candidate = neighbors[ti];
+                    if(emitted[candidate]) continue;
+
+                    const UnsignedInt count = newVertexCount(candidate);
+                    if(vertices.size() + count > maxVertexCount || count > bestNewVertexCount) continue;
+
+                    const Float distance = (centroids[candidate] - centroid).dot();
+                    if(count < bestNewVertexCount || distance < bestDistance) {
+                        best = candidate;
+                        bestNewVertexCount = count;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            /* No suitable neighbor, try the next triangle in the index array
+               instead of ending up with a lot of tiny meshlets for meshes
+               made of disconnected parts. Take it only if it's not farther
+               than twice the current meshlet extent, as the bounding sphere
+               would be unnecessarily large otherwise. */
+            if(best == NoTriangle) {
+                while(cursor != inputTriangleCount && emitted[cursor]) ++cursor;
+                if(cursor == inputTriangleCount || vertices.size() + newVertexCount(cursor) > maxVertexCount) break;
+
+                Float extentSquared = 0.0f;
+                for(const UnsignedInt v: vertices)
+                    extentSquared = Math::max(extentSquared, (positions[v] - centroid).dot());
+                if((centroids[cursor] - centroid).dot() > 4.0f*extentSquared) break;
+
+                best = cursor;
+            }
+
+            t = best;
+        }
+
+        Meshlet meshlet;
+        meshlet.indexOffset = indexOffset;
+        meshlet.indexCount = outputIndices.size() - indexOffset;
+        meshlet.vertexCount = vertices.size();
+        boundingSphere(positions, vertices, meshlet);
+        normalCone(outputIndices, positions, meshlet);
+        meshlets.push_back(meshlet);
+    }
+
+    /* Swap original index buffer with reordered */
+    using std::swap;
+    swap(indices, outputIndices);
+
+    return meshlets;
+}
+
+std::vector<Meshlet> buildMeshlets(Trade::MeshData3D& meshData, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles && meshData.isIndexed(),
+        "MeshTools::buildMeshlets(): expected indexed triangle mesh", {});
+
+    return buildMeshlets(meshData.indices(), meshData.positions(0), maxVertexCount, maxTriangleCount);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+std::vector<MeshView::DrawElementsIndirectCommand> meshletIndirectCommands(const std::vector<Meshlet>& meshlets) {
+    std::vector<MeshView::DrawElementsIndirectCommand> commands;
+    commands.reserve(meshlets.size());
+    for(const Meshlet& meshlet: meshlets)
+        commands.push_back({meshlet.indexCount, 1, meshlet.indexOffset, 0, 0});
+    return commands;
+}
+#endif
+
+}}
@@ -0,0 +1,168 @@
+#ifndef Magnum_MeshTools_BuildMeshlets_h
+#define Magnum_MeshTools_BuildMeshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, function @ref Magnum::MeshTools::buildMeshlets(), @ref Magnum::MeshTools::meshletIndirectCommands()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/MeshView.h"
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+
+Spatially coherent cluster of triangles produced by @ref buildMeshlets().
+Triangles of the meshlet occupy a contiguous range of the index array.
+*/
+struct Meshlet {
+    /** @brief Offset of the first index in the index array */
+    UnsignedInt indexOffset;
+
+    /** @brief Index count */
+    UnsignedInt indexCount;
+
+    /** @brief Count of unique vertices referenced by the meshlet */
+    UnsignedInt vertexCount;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average direction of all triangle normals.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Sine of the cone half-angle, `1.0` if the cone would be wider than a
+     * hemisphere and thus can't be used for culling. See
+     * @ref isBackFacing() for usage.
+     */
+    Float coneCutoff;
+
+    /**
+     * @brief Whether the meshlet is back-facing
+     * @param cameraPosition    Camera position, in the same coordinate
+     *      system as the mesh
+     *
+     * Returns `true` if all triangles in the meshlet are facing away from
+     * the camera and thus can be culled. The test is conservative, i.e. it
+     * may return `false` even for back-facing meshlets. The same test can
+     * be done in a compute shader.
+     */
+    bool isBackFacing(const Vector3& cameraPosition) const {
+        const Vector3 direction = center - cameraPosition;
+        return Math::dot(direction, coneAxis) > coneCutoff*direction.length() + radius;
+    }
+};
+
+/**
+@brief Split mesh into meshlets
+@param[in,out] indices      Triangle index array to operate on
+@param[in] positions        Vertex positions
+@param[in] maxVertexCount   Max count of unique vertices in one meshlet
+@param[in] maxTriangleCount Max count of triangles in one meshlet
+@return Meshlets, in order of the index array
+
+Reorders triangles in the index array so triangles of each meshlet are
+contiguous and computes bounding sphere and normal cone of each of them.
+Meshlets are built greedily by adding neighboring triangles that introduce
+the least count of new vertices, spatially closest triangles are preferred
+on a tie. When the meshlet runs out of neighbors, the next not yet added
+triangle in the index array is taken if it's close enough. The order of vertices in each triangle
+is preserved, so is the face winding.
+
+The default limits fit well both the mesh shader hardware limits and
+the granularity that's reasonable for culling with
+@ref MeshView::drawIndirect(), see @ref meshletIndirectCommands() for an
+example. Expects that the index count is divisible by 3, all indices are
+in bounds of @p positions and both limits are at least 3 and 1, respectively.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Meshlet> buildMeshlets(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Split mesh data into meshlets
+
+Convenience alternative to @ref buildMeshlets(std::vector<UnsignedInt>&, const std::vector<Vector3>&, UnsignedInt, UnsignedInt)
+operating on indices and first position array of @p meshData. Expects that
+the mesh is indexed and has @ref MeshPrimitive::Triangles primitive.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Meshlet> buildMeshlets(Trade::MeshData3D& meshData, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Indirect draw commands for meshlets
+
+Creates one @ref MeshView::DrawElementsIndirectCommand for each meshlet, with
+zero base vertex and base instance and instance count set to `1`. Usable
+directly in @ref MeshView::drawIndirect(), a compute shader can then cull the
+meshlets by setting instance count of invisible meshlets to `0`. Example
+usage:
+@code
+Trade::MeshData3D meshData;
+std::vector<MeshTools::Meshlet> meshlets = MeshTools::buildMeshlets(meshData);
+
+Mesh mesh{NoCreate};
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(mesh, vertices, indices) = MeshTools::compile(meshData, BufferUsage::StaticDraw);
+
+Buffer commands{Buffer::TargetHint::DrawIndirect};
+commands.setData(MeshTools::meshletIndirectCommands(meshlets), BufferUsage::DynamicDraw);
+
+MeshView::drawIndirect(shader, mesh, commands, 0, meshlets.size());
+@endcode
+
+Note that @ref compile() doesn't change order of the indices, so the
+meshlets can be used with the compiled mesh directly.
+@requires_gl43 Extension @extension{ARB,multi_draw_indirect}
+@requires_gles31 Indirect drawing is not available in OpenGL ES 3.0 and
+    older.
+@requires_gles Indirect drawing is not available in WebGL.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<MeshView::DrawElementsIndirectCommand> meshletIndirectCommands(const std::vector<Meshlet>& meshlets);
+#endif
+
+}}
+
+#endif
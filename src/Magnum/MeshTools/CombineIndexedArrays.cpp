@@ -25,11 +25,11 @@
 
 #include "CombineIndexedArrays.h"
 
-#include <cstring>
-#include <unordered_map>
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/Magnum.h"
 
 namespace Magnum { namespace MeshTools {
@@ -87,68 +87,175 @@ std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::ve
 
 namespace {
 
-class IndexHash {
-    public:
-        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+/* Below this many index combinations the deduplication is done on a single
+   thread */
+enum: std::size_t { MinChunkSize = 32*1024 };
 
-        std::size_t operator()(UnsignedInt key) const {
-            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
-        }
+/* Stride known at compile time, used for the common cases of two and three
+   interleaved arrays so the hash and comparison loops get fully unrolled */
+template<UnsignedInt value> struct FixedStride {
+    constexpr UnsignedInt operator()() const { return value; }
+};
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
+struct RuntimeStride {
+    UnsignedInt operator()() const { return value; }
+
+    UnsignedInt value;
 };
 
-class IndexEqual {
+/* Open-addressing table with linear probing, containing index of the unique
+   combination for each combination. The combinations themselves are not
+   stored, they are compared directly in the input array using the position
+   of their first occurrence. */
+template<class Stride> class CombinationTable {
     public:
-        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+        explicit CombinationTable(const UnsignedInt* const data, const Stride stride, const std::size_t capacity): _data{data}, _stride(stride) {
+            /* Keep the table at most half full so the probe sequences are
+               short */
+            std::size_t slotCount = 16;
+            while(slotCount < 2*capacity) slotCount <<= 1;
+            _mask = slotCount - 1;
+            _slots.assign(slotCount, Empty);
+        }
+
+        /* Returns index of combination at given position in @p uniques,
+           appending the position there if the combination wasn't seen yet */
+        UnsignedInt find(const UnsignedInt position, std::vector<UnsignedInt>& uniques) {
+            const UnsignedInt* const combination = _data + std::size_t(position)*_stride();
+
+            std::size_t slot = hash(combination) & _mask;
+            UnsignedInt index;
+            while((index = _slots[slot]) != Empty && !equal(_data + std::size_t(uniques[index])*_stride(), combination))
+                slot = (slot + 1) & _mask;
+
+            if(index == Empty) {
+                index = _slots[slot] = uniques.size();
+                uniques.push_back(position);
+            }
 
-        bool operator()(UnsignedInt a, UnsignedInt b) const {
-            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+            return index;
         }
 
     private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
+        enum: UnsignedInt { Empty = ~UnsignedInt{} };
+
+        std::size_t hash(const UnsignedInt* const combination) const {
+            /* Same mixing as in removeDuplicates() */
+            unsigned long long hash = 0;
+            for(UnsignedInt i = 0; i != _stride(); ++i)
+                hash = (hash ^ combination[i])*0x9e3779b97f4a7c15ull;
+            return std::size_t(hash ^ (hash >> 29));
+        }
+
+        bool equal(const UnsignedInt* const a, const UnsignedInt* const b) const {
+            for(UnsignedInt i = 0; i != _stride(); ++i)
+                if(a[i] != b[i]) return false;
+            return true;
+        }
+
+        const UnsignedInt* _data;
+        Stride _stride;
+        std::size_t _mask;
+        std::vector<UnsignedInt> _slots;
 };
 
+/* Fills @p combinedIndices with index of unique combination for each of
+   @p count combinations and returns positions of the unique combinations in
+   the input in order of their first occurrence. Large inputs are split into
+   chunks that are deduplicated in parallel, the per-chunk unique
+   combinations are then merged into a single table and the per-chunk indices
+   remapped. The result is the same as with a single sequential pass. */
+template<class Stride> std::vector<UnsignedInt> combine(const UnsignedInt* const data, const std::size_t count, const Stride stride, UnsignedInt* const combinedIndices) {
+    std::vector<UnsignedInt> uniques;
+    if(!count) return uniques;
+
+    const std::size_t size = Magnum::Implementation::chunkSize(count, MinChunkSize);
+    const std::size_t chunkCount = (count + size - 1)/size;
+
+    /* Single chunk, no merging needed */
+    if(chunkCount == 1) {
+        uniques.reserve(count);
+        CombinationTable<Stride> table{data, stride, count};
+        for(std::size_t i = 0; i != count; ++i)
+            combinedIndices[i] = table.find(i, uniques);
+        return uniques;
+    }
+
+    /* Deduplicate each chunk separately, the indices are local to the chunk */
+    std::vector<std::vector<UnsignedInt>> chunkUniques(chunkCount);
+    Magnum::Implementation::parallelChunks(count, size, [data, stride, combinedIndices, &chunkUniques](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+        std::vector<UnsignedInt>& out = chunkUniques[chunk];
+        out.reserve(end - begin);
+        CombinationTable<Stride> table{data, stride, end - begin};
+        for(std::size_t i = begin; i != end; ++i)
+            combinedIndices[i] = table.find(i, out);
+    });
+
+    /* Merge the chunk-local unique combinations in order, replacing each with
+       its global index so the list can be used for remapping */
+    std::size_t uniqueCount = 0;
+    for(const std::vector<UnsignedInt>& chunk: chunkUniques)
+        uniqueCount += chunk.size();
+    uniques.reserve(uniqueCount);
+    CombinationTable<Stride> table{data, stride, uniqueCount};
+    for(std::vector<UnsignedInt>& chunk: chunkUniques)
+        for(UnsignedInt& i: chunk) i = table.find(i, uniques);
+
+    /* Remap the chunk-local indices to global ones */
+    Magnum::Implementation::parallelChunks(count, size, [combinedIndices, &chunkUniques](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+        const std::vector<UnsignedInt>& remap = chunkUniques[chunk];
+        for(std::size_t i = begin; i != end; ++i)
+            combinedIndices[i] = remap[combinedIndices[i]];
+    });
+
+    return uniques;
+}
+
+std::vector<UnsignedInt> combine(const UnsignedInt* const data, const std::size_t count, const UnsignedInt stride, UnsignedInt* const combinedIndices) {
+    switch(stride) {
+        case 2: return combine(data, count, FixedStride<2>{}, combinedIndices);
+        case 3: return combine(data, count, FixedStride<3>{}, combinedIndices);
+    }
+
+    return combine(data, count, RuntimeStride{stride}, combinedIndices);
+}
+
+/* Copies the unique combinations to a new interleaved array */
+void copyUniques(const UnsignedInt* const data, const std::vector<UnsignedInt>& uniques, const UnsignedInt stride, UnsignedInt* const out) {
+    for(std::size_t i = 0; i != uniques.size(); ++i)
+        std::copy_n(data + std::size_t(uniques[i])*stride, stride, out + i*stride);
+}
+
 }
 
 std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
     CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
     CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
 
-    /* Hash map with index combinations, containing just indices into
-       interleavedArrays vector, hashing and comparison is done using IndexHash
-       and IndexEqual functors. Reserving more buckets than necessary (i.e. as
-       if each combination was unique). */
-    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
-        interleavedArrays.size()/stride,
-        IndexHash(interleavedArrays, stride),
-        IndexEqual(interleavedArrays, stride));
-
     /* Make the index combinations unique. Original indices into original
        `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
        contains new ones into new (shorter) `newInterleavedArrays` array. */
-    std::vector<UnsignedInt> combinedIndices;
-    combinedIndices.reserve(interleavedArrays.size()/stride);
-    std::vector<UnsignedInt> newInterleavedArrays;
-    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
-        /* Try to insert new index combination to the map */
-        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
-
-        /* Add the (either new or already existing) index to resulting index array */
-        combinedIndices.push_back(result.first->second);
-
-        /* If this is new combination, copy it to new interleaved arrays */
-        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
-            interleavedArrays.begin()+oldIndex*stride,
-            interleavedArrays.begin()+(oldIndex+1)*stride);
-    }
+    std::vector<UnsignedInt> combinedIndices(interleavedArrays.size()/stride);
+    const std::vector<UnsignedInt> uniques = combine(interleavedArrays.data(), combinedIndices.size(), stride, combinedIndices.data());
+
+    /* Copy the unique combinations to new interleaved arrays */
+    std::vector<UnsignedInt> newInterleavedArrays(uniques.size()*stride);
+    copyUniques(interleavedArrays.data(), uniques, stride, newInterleavedArrays.data());
+
+    CORRADE_INTERNAL_ASSERT(newInterleavedArrays.size() <= interleavedArrays.size());
+
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
+
+std::pair<Containers::Array<UnsignedInt>, Containers::Array<UnsignedInt>> combineIndexArraysAsArray(const Containers::ArrayView<const UnsignedInt> interleavedArrays, const UnsignedInt stride) {
+    CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArraysAsArray(): stride can't be zero", {});
+    CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArraysAsArray(): array size is not divisible by stride", {});
+
+    Containers::Array<UnsignedInt> combinedIndices(interleavedArrays.size()/stride);
+    const std::vector<UnsignedInt> uniques = combine(interleavedArrays.data(), combinedIndices.size(), stride, combinedIndices.data());
 
-    CORRADE_INTERNAL_ASSERT(combinedIndices.size() == interleavedArrays.size()/stride &&
-                            newInterleavedArrays.size() <= interleavedArrays.size());
+    Containers::Array<UnsignedInt> newInterleavedArrays(uniques.size()*stride);
+    copyUniques(interleavedArrays.data(), uniques, stride, newInterleavedArrays.data());
 
     return {std::move(combinedIndices), std::move(newInterleavedArrays)};
 }
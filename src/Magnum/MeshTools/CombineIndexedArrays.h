@@ -26,12 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexedArrays()
+ * @brief Function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexArraysAsArray(), @ref Magnum::MeshTools::combineIndexedArrays()
  */
 
 #include <functional>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Types.h"
@@ -110,10 +111,25 @@ And second pair value is the cleaned up interleaved array:
 
     0 1 2 3 5 4 0 4 1 6 3 1 2 1
 
-@see @ref combineIndexedArrays()
+The combinations are deduplicated using an open-addressing hash table, with
+the common cases of @p stride being `2` and `3` specialized. Large arrays are
+split into chunks that are processed in parallel and then merged, the result
+is the same as when processed sequentially.
+@see @ref combineIndexArraysAsArray(), @ref combineIndexedArrays()
 */
 MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride);
 
+/**
+@brief Combine index arrays into @ref Corrade::Containers::Array "Containers::Array"
+
+Same as @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt),
+but takes a view on arbitrary memory and returns the combined index array and
+the cleaned up interleaved array as @ref Corrade::Containers::Array "Containers::Array",
+avoiding a copy when the result is uploaded to a buffer or used for creating
+@ref Trade::MeshData.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, Containers::Array<UnsignedInt>> combineIndexArraysAsArray(Containers::ArrayView<const UnsignedInt> interleavedArrays, UnsignedInt stride);
+
 namespace Implementation {
 
 MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end);
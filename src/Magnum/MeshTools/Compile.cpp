@@ -25,10 +25,17 @@
 
 #include "Compile.h"
 
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Buffer.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Vector4.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Implementation/PackVertices.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -165,4 +172,259 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
+namespace {
+
+/* Signed normalized 10-bit components, the W component is unused */
+UnsignedInt packNormal(const Vector3& normal) {
+    UnsignedInt out = 0;
+    for(std::size_t i = 0; i != 3; ++i)
+        out |= (UnsignedInt(Int(Math::round(Math::clamp(normal[i], -1.0f, 1.0f)*511.0f))) & 0x3ff) << (i*10);
+    return out;
+}
+
+}
+
+namespace Implementation {
+
+PackedVertices packVertices(const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoords, const CompilePackingFlags packing) {
+    PackedVertices out;
+    out.hasNormals = !normals.empty();
+    out.hasTextureCoords = !textureCoords.empty();
+    out.packedPositions = !!(packing & CompilePackingFlag::Positions);
+    out.packedNormals = out.hasNormals && (packing & CompilePackingFlag::Normals);
+
+    /* Texture coordinates can be packed only if they are all in [0, 1],
+       there's no texture transformation in the shader to undo anything
+       else */
+    out.packedTextureCoords = out.hasTextureCoords && (packing & CompilePackingFlag::TextureCoordinates);
+    if(out.packedTextureCoords) for(const Vector2& coords: textureCoords) {
+        if(coords.min() < 0.0f || coords.max() > 1.0f) {
+            out.packedTextureCoords = false;
+            break;
+        }
+    }
+
+    /* Quantization range for positions */
+    Vector3 min, extent{1.0f};
+    if(out.packedPositions && !positions.empty()) {
+        min = positions[0];
+        Vector3 max = positions[0];
+        for(const Vector3& position: positions) {
+            min = Math::min(min, position);
+            max = Math::max(max, position);
+        }
+        extent = max - min;
+
+        /* Avoid division by zero for flat meshes */
+        for(std::size_t i = 0; i != 3; ++i)
+            if(extent[i] == 0.0f) extent[i] = 1.0f;
+    }
+    out.dequantization = out.packedPositions ?
+        Matrix4::translation(min)*Matrix4::scaling(extent) : Matrix4{};
+
+    /* Decide about stride and offsets, everything is kept four-byte
+       aligned */
+    const UnsignedInt positionSize = out.packedPositions ? 8 : sizeof(Vector3);
+    const UnsignedInt normalSize = !out.hasNormals ? 0 : out.packedNormals ? 4 : sizeof(Vector3);
+    const UnsignedInt textureCoordsSize = !out.hasTextureCoords ? 0 : out.packedTextureCoords ? 4 : sizeof(Vector2);
+    out.normalOffset = positionSize;
+    out.textureCoordsOffset = out.normalOffset + normalSize;
+    out.stride = out.textureCoordsOffset + textureCoordsSize;
+
+    /* Pack the data */
+    out.data = Containers::Array<char>{Containers::ValueInit, out.stride*positions.size()};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        char* const vertex = out.data + i*out.stride;
+
+        if(out.packedPositions) {
+            const Math::Vector3<UnsignedShort> position = Math::denormalize<Math::Vector3<UnsignedShort>>((positions[i] - min)/extent);
+            std::memcpy(vertex, position.data(), sizeof(position));
+        } else std::memcpy(vertex, positions[i].data(), sizeof(Vector3));
+
+        if(out.packedNormals) {
+            #ifndef MAGNUM_TARGET_GLES2
+            const UnsignedInt normal = packNormal(normals[i]);
+            std::memcpy(vertex + out.normalOffset, &normal, sizeof(normal));
+            #else
+            const Math::Vector3<Byte> normal = Math::denormalize<Math::Vector3<Byte>>(Math::clamp(normals[i], -1.0f, 1.0f));
+            std::memcpy(vertex + out.normalOffset, normal.data(), sizeof(normal));
+            #endif
+        } else if(out.hasNormals)
+            std::memcpy(vertex + out.normalOffset, normals[i].data(), sizeof(Vector3));
+
+        if(out.packedTextureCoords) {
+            const Math::Vector2<UnsignedShort> packed = Math::denormalize<Math::Vector2<UnsignedShort>>(textureCoords[i]);
+            std::memcpy(vertex + out.textureCoordsOffset, packed.data(), sizeof(packed));
+        } else if(out.hasTextureCoords)
+            std::memcpy(vertex + out.textureCoordsOffset, textureCoords[i].data(), sizeof(Vector2));
+    }
+
+    return out;
+}
+
+void addPackedVertexBuffer(Mesh& mesh, Buffer& buffer, const PackedVertices& vertices) {
+    const UnsignedInt stride = vertices.stride;
+    const UnsignedInt normalOffset = vertices.normalOffset;
+    const UnsignedInt textureCoordsOffset = vertices.textureCoordsOffset;
+
+    if(vertices.packedPositions) mesh.addVertexBuffer(buffer, 0,
+        Shaders::Generic3D::Position{
+            Shaders::Generic3D::Position::DataType::UnsignedShort,
+            Shaders::Generic3D::Position::DataOption::Normalized},
+        stride - sizeof(Math::Vector3<UnsignedShort>));
+    else mesh.addVertexBuffer(buffer, 0,
+        Shaders::Generic3D::Position{},
+        stride - sizeof(Vector3));
+
+    if(vertices.packedNormals) {
+        #ifndef MAGNUM_TARGET_GLES2
+        /* The packed type has four components, so it needs to be bound
+           through a four-component attribute, the shader ignores the last
+           one */
+        typedef Attribute<Shaders::Generic3D::Normal::Location, Vector4> PackedNormal;
+        mesh.addVertexBuffer(buffer, 0,
+            normalOffset,
+            PackedNormal{PackedNormal::DataType::Int2101010Rev, PackedNormal::DataOption::Normalized},
+            stride - normalOffset - 4);
+        #else
+        mesh.addVertexBuffer(buffer, 0,
+            normalOffset,
+            Shaders::Generic3D::Normal{
+                Shaders::Generic3D::Normal::DataType::Byte,
+                Shaders::Generic3D::Normal::DataOption::Normalized},
+            stride - normalOffset - sizeof(Math::Vector3<Byte>));
+        #endif
+    } else if(vertices.hasNormals) mesh.addVertexBuffer(buffer, 0,
+        normalOffset,
+        Shaders::Generic3D::Normal{},
+        stride - normalOffset - sizeof(Vector3));
+
+    if(vertices.packedTextureCoords) mesh.addVertexBuffer(buffer, 0,
+        textureCoordsOffset,
+        Shaders::Generic3D::TextureCoordinates{
+            Shaders::Generic3D::TextureCoordinates::DataType::UnsignedShort,
+            Shaders::Generic3D::TextureCoordinates::DataOption::Normalized},
+        stride - textureCoordsOffset - sizeof(Math::Vector2<UnsignedShort>));
+    else if(vertices.hasTextureCoords) mesh.addVertexBuffer(buffer, 0,
+        textureCoordsOffset,
+        Shaders::Generic3D::TextureCoordinates{},
+        stride - textureCoordsOffset - sizeof(Vector2));
+}
+
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix4> compile(const Trade::MeshData3D& meshData, const BufferUsage usage, const CompilePackingFlags packing) {
+    static const std::vector<Vector3> noNormals;
+    static const std::vector<Vector2> noTextureCoords;
+    const Implementation::PackedVertices vertices = Implementation::packVertices(meshData.positions(0),
+        meshData.hasNormals() ? meshData.normals(0) : noNormals,
+        meshData.hasTextureCoords2D() ? meshData.textureCoords2D(0) : noTextureCoords,
+        packing);
+
+    /* Create vertex buffer and configure the attributes */
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    vertexBuffer->setData(vertices.data, usage);
+    Implementation::addPackedVertexBuffer(mesh, *vertexBuffer, vertices);
+
+    /* If indexed, fill index buffer and configure indexed mesh */
+    std::unique_ptr<Buffer> indexBuffer;
+    if(meshData.isIndexed()) {
+        Containers::Array<char> indexData;
+        Mesh::IndexType indexType;
+        UnsignedInt indexStart, indexEnd;
+        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(meshData.indices());
+
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        indexBuffer->setData(indexData, usage);
+        mesh.setCount(meshData.indices().size())
+            .setIndexBuffer(*indexBuffer, 0, indexType, indexStart, indexEnd);
+
+    /* Else set vertex count */
+    } else mesh.setCount(meshData.positions(0).size());
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer), vertices.dequantization);
+}
+
+namespace {
+
+template<UnsignedInt location> void addAttribute(Mesh& mesh, Buffer& buffer, const Trade::MeshAttributeData& attribute) {
+    switch(attribute.type()) {
+        #define _c(type)                                                    \
+            case Trade::MeshAttributeType::type:                            \
+                mesh.addVertexBuffer(buffer, attribute.offset(),            \
+                    Attribute<location, type>{},                            \
+                    attribute.stride() - sizeof(type));                     \
+                return;
+        _c(Vector2)
+        _c(Vector3)
+        _c(Vector4)
+        #undef _c
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+Mesh::IndexType indexType(const Trade::MeshIndexType type) {
+    switch(type) {
+        case Trade::MeshIndexType::UnsignedByte: return Mesh::IndexType::UnsignedByte;
+        case Trade::MeshIndexType::UnsignedShort: return Mesh::IndexType::UnsignedShort;
+        case Trade::MeshIndexType::UnsignedInt: return Mesh::IndexType::UnsignedInt;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, const BufferUsage usage) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    /* The whole data in one go, the index data (if any) are there too, but
+       they are just ignored */
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    vertexBuffer->setData(meshData.data(), usage);
+
+    /* Bind first attribute of each name */
+    bool used[4]{};
+    for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i) {
+        const Trade::MeshAttributeData& attribute = meshData.attributeData(i);
+        bool& alreadyUsed = used[UnsignedByte(attribute.name())];
+        if(alreadyUsed) continue;
+        alreadyUsed = true;
+
+        switch(attribute.name()) {
+            case Trade::MeshAttributeName::Position:
+                addAttribute<Shaders::Generic3D::Position::Location>(mesh, *vertexBuffer, attribute);
+                break;
+            case Trade::MeshAttributeName::Normal:
+                addAttribute<Shaders::Generic3D::Normal::Location>(mesh, *vertexBuffer, attribute);
+                break;
+            case Trade::MeshAttributeName::TextureCoordinates:
+                addAttribute<Shaders::Generic3D::TextureCoordinates::Location>(mesh, *vertexBuffer, attribute);
+                break;
+            case Trade::MeshAttributeName::Color:
+                addAttribute<Shaders::Generic3D::Color::Location>(mesh, *vertexBuffer, attribute);
+                break;
+        }
+    }
+
+    /* If indexed, upload the index range and configure indexed mesh. WebGL
+       doesn't allow the same buffer to be used for both vertices and
+       indices, so it has to be a separate buffer. */
+    std::unique_ptr<Buffer> indexBuffer;
+    if(meshData.isIndexed()) {
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        indexBuffer->setData(meshData.indexData(), usage);
+        mesh.setCount(meshData.indexCount())
+            .setIndexBuffer(*indexBuffer, 0, indexType(meshData.indexType()));
+
+    /* Else set vertex count */
+    } else mesh.setCount(meshData.vertexCount());
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
+}
+
 }}
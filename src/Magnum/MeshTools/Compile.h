@@ -26,11 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), enum @ref Magnum::MeshTools::CompilePackingFlag, enum set @ref Magnum::MeshTools::CompilePackingFlags
  */
 
 #include <tuple>
 #include <memory>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Trade/Trade.h"
@@ -74,12 +75,101 @@ The second returned buffer may be `nullptr` if the mesh is not indexed.
 
 This is just a convenience function for creating generic meshes, you might want
 to use @ref interleave() and @ref compressIndices() functions instead for
-greater flexibility.
+greater flexibility. See @ref CompilePipeline for an alternative that
+optimizes the data on worker threads before uploading them.
 
 @see @ref shaders-generic
 */
 MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, BufferUsage usage);
 
+/**
+@brief Vertex data packing
+
+@see @ref CompilePackingFlags,
+    @ref compile(const Trade::MeshData3D&, BufferUsage, CompilePackingFlags)
+*/
+enum class CompilePackingFlag: UnsignedByte {
+    /**
+     * Positions are quantized to normalized 16-bit unsigned integers over
+     * the mesh bounding box, padded to 8 bytes. The returned dequantization
+     * matrix needs to be applied to transformation matrix in the shader.
+     */
+    Positions = 1 << 0,
+
+    /**
+     * Normals are packed to normalized
+     * @ref Attribute::DataType::Int2101010Rev "Int2101010Rev", taking
+     * 4 bytes. On OpenGL ES 2.0 and WebGL 1.0 normalized bytes padded to 4
+     * bytes are used instead.
+     */
+    Normals = 1 << 1,
+
+    /**
+     * Texture coordinates are packed to normalized 16-bit unsigned integers.
+     * Done only if all texture coordinates are in range @f$ [0, 1] @f$,
+     * otherwise they are kept as floats.
+     */
+    TextureCoordinates = 1 << 2
+};
+
+/**
+@brief Vertex data packing
+
+@see @ref compile(const Trade::MeshData3D&, BufferUsage, CompilePackingFlags)
+*/
+typedef Containers::EnumSet<CompilePackingFlag> CompilePackingFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompilePackingFlags)
+
+/**
+@brief Compile 3D mesh data with packed vertex attributes
+
+Like @ref compile(const Trade::MeshData3D&, BufferUsage), but packs the
+vertex attributes selected by @p packing into smaller types, see
+@ref CompilePackingFlag for details. With all flags set, the vertex size goes
+down from 32 to 16 bytes. The fourth returned value is a matrix converting
+packed positions back to the original coordinates, it's identity if
+@ref CompilePackingFlag::Positions is not set. Usage with
+@ref Shaders::Phong:
+@code
+Mesh mesh;
+std::unique_ptr<Buffer> vertices, indices;
+Matrix4 dequantization;
+std::tie(mesh, vertices, indices, dequantization) = MeshTools::compile(meshData, BufferUsage::StaticDraw,
+    MeshTools::CompilePackingFlag::Positions|MeshTools::CompilePackingFlag::Normals|MeshTools::CompilePackingFlag::TextureCoordinates);
+
+// ...
+shader.setTransformationMatrix(transformationMatrix*dequantization)
+    .setNormalMatrix(transformationMatrix.rotation())
+    .setProjectionMatrix(camera.projectionMatrix());
+@endcode
+
+The normal matrix is calculated from the original transformation, as the
+dequantization matrix only scales and translates the positions and the
+normals are not affected by it.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix4> compile(const Trade::MeshData3D& meshData, BufferUsage usage, CompilePackingFlags packing);
+
+/**
+@brief Compile mesh data
+
+Uploads the whole @ref Trade::MeshData::data() array into the vertex buffer
+with a single @ref Buffer::setData() call without any intermediate copies and
+configures the attributes directly from their offsets and strides.
+@ref Trade::MeshAttributeName::Position is bound to
+@ref Shaders::Generic3D::Position, @ref Trade::MeshAttributeName::Normal to
+@ref Shaders::Generic3D::Normal,
+@ref Trade::MeshAttributeName::TextureCoordinates to
+@ref Shaders::Generic3D::TextureCoordinates and
+@ref Trade::MeshAttributeName::Color to @ref Shaders::Generic3D::Color. If
+there is more than one attribute of the same name, only the first is used.
+If the mesh is indexed, the index range of the data is uploaded into the
+index buffer, otherwise the second returned buffer is `nullptr`. The
+@p usage parameter is used for both vertex and index buffer.
+@see @ref shaders-generic
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, BufferUsage usage);
+
 }}
 
 #endif
@@ -0,0 +1,227 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompilePipeline.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Implementation/PackVertices.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+struct CompilePipeline::Job {
+    TaskScheduler::TaskId task;
+
+    /* Input, processed in place by the task */
+    CompileStages stages;
+    CompilePackingFlags packing;
+    MeshPrimitive primitive;
+    bool indexed;
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector2> textureCoords;
+
+    /* Output of the task */
+    Implementation::PackedVertices vertices;
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    Timings timings;
+
+    void process();
+};
+
+namespace {
+
+typedef std::chrono::high_resolution_clock Clock;
+
+void removeDuplicatesStage(std::vector<UnsignedInt>& indices, bool& indexed, std::vector<Vector3>& positions, std::vector<Vector3>& normals, std::vector<Vector2>& textureCoords) {
+    /* Deduplicate each attribute separately and make their index arrays
+       relative to the mesh indices, if any */
+    auto attributeIndices = [&](std::vector<UnsignedInt> remap) {
+        return indexed ? duplicate(indices, remap) : remap;
+    };
+    const std::vector<UnsignedInt> positionIndices = attributeIndices(removeDuplicates(positions));
+
+    /* Then combine the index arrays into one. Unique combinations are
+       collected again, so the resulting vertex count is at most the
+       original. */
+    if(!normals.empty() && !textureCoords.empty()) {
+        const std::vector<UnsignedInt> normalIndices = attributeIndices(removeDuplicates(normals));
+        const std::vector<UnsignedInt> textureCoordIndices = attributeIndices(removeDuplicates(textureCoords));
+        indices = combineIndexedArrays(
+            std::make_pair(std::cref(positionIndices), std::ref(positions)),
+            std::make_pair(std::cref(normalIndices), std::ref(normals)),
+            std::make_pair(std::cref(textureCoordIndices), std::ref(textureCoords)));
+    } else if(!normals.empty()) {
+        const std::vector<UnsignedInt> normalIndices = attributeIndices(removeDuplicates(normals));
+        indices = combineIndexedArrays(
+            std::make_pair(std::cref(positionIndices), std::ref(positions)),
+            std::make_pair(std::cref(normalIndices), std::ref(normals)));
+    } else if(!textureCoords.empty()) {
+        const std::vector<UnsignedInt> textureCoordIndices = attributeIndices(removeDuplicates(textureCoords));
+        indices = combineIndexedArrays(
+            std::make_pair(std::cref(positionIndices), std::ref(positions)),
+            std::make_pair(std::cref(textureCoordIndices), std::ref(textureCoords)));
+    } else indices = positionIndices;
+
+    indexed = true;
+}
+
+}
+
+CompilePipeline::CompilePipeline(TaskScheduler& scheduler): _scheduler(scheduler), _stages{CompileStage::RemoveDuplicates|CompileStage::OptimizeVertexCache|CompileStage::OptimizeVertexFetch|CompileStage::PackAttributes|CompileStage::CompressIndices}, _usage{BufferUsage::StaticDraw}, _nextId{} {}
+
+CompilePipeline::CompilePipeline(): CompilePipeline{TaskScheduler::global()} {}
+
+CompilePipeline::~CompilePipeline() {
+    /* The tasks write into the jobs */
+    for(const auto& job: _jobs) _scheduler.wait(job.second->task);
+}
+
+CompilePipeline::Id CompilePipeline::add(Trade::MeshData3D meshData) {
+    CORRADE_ASSERT(meshData.positionArrayCount(),
+        "MeshTools::CompilePipeline::add(): the mesh has no positions", {});
+
+    std::unique_ptr<Job> job{new Job};
+    job->stages = _stages;
+    job->packing = _packing;
+    job->primitive = meshData.primitive();
+    job->indexed = meshData.isIndexed();
+    if(job->indexed) job->indices = std::move(meshData.indices());
+    job->positions = std::move(meshData.positions(0));
+    if(meshData.hasNormals()) job->normals = std::move(meshData.normals(0));
+    if(meshData.hasTextureCoords2D()) job->textureCoords = std::move(meshData.textureCoords2D(0));
+    job->timings = {};
+
+    /* The job is heap-allocated, so its address doesn't change when the map
+       is modified */
+    Job* const data = job.get();
+    job->task = _scheduler.add([data]() { data->process(); });
+
+    const Id id = _nextId++;
+    _jobs.emplace(id, std::move(job));
+    return id;
+}
+
+bool CompilePipeline::isFinished(const Id id) {
+    const auto found = _jobs.find(id);
+    CORRADE_ASSERT(found != _jobs.end(),
+        "MeshTools::CompilePipeline::isFinished(): unknown mesh ID" << id, {});
+
+    return _scheduler.isFinished(found->second->task);
+}
+
+CompilePipeline::CompiledMesh CompilePipeline::finish(const Id id) {
+    const auto found = _jobs.find(id);
+    CORRADE_ASSERT(found != _jobs.end(),
+        "MeshTools::CompilePipeline::finish(): unknown mesh ID" << id, CompiledMesh());
+
+    _scheduler.wait(found->second->task);
+    const std::unique_ptr<Job> job = std::move(found->second);
+    _jobs.erase(found);
+
+    const Clock::time_point begin = Clock::now();
+
+    CompiledMesh out;
+    out.mesh.setPrimitive(job->primitive);
+    out.vertices.reset(new Buffer{Buffer::TargetHint::Array});
+    out.vertices->setData(job->vertices.data, _usage);
+    Implementation::addPackedVertexBuffer(out.mesh, *out.vertices, job->vertices);
+
+    if(job->indexed) {
+        out.indices.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        out.indices->setData(job->indexData, _usage);
+        out.mesh.setCount(job->indices.size())
+            .setIndexBuffer(*out.indices, 0, job->indexType, job->indexStart, job->indexEnd);
+    } else out.mesh.setCount(job->positions.size());
+
+    out.dequantization = job->vertices.dequantization;
+    out.timings = job->timings;
+    out.timings.upload = Clock::now() - begin;
+    return out;
+}
+
+void CompilePipeline::Job::process() {
+    Clock::time_point begin = Clock::now();
+
+    if(stages & CompileStage::RemoveDuplicates) {
+        removeDuplicatesStage(indices, indexed, positions, normals, textureCoords);
+
+        const Clock::time_point end = Clock::now();
+        timings.removeDuplicates = end - begin;
+        begin = end;
+    }
+
+    if(indexed && primitive == MeshPrimitive::Triangles && (stages & CompileStage::OptimizeVertexCache)) {
+        optimizeVertexCache(indices, UnsignedInt(positions.size()));
+
+        const Clock::time_point end = Clock::now();
+        timings.optimizeVertexCache = end - begin;
+        begin = end;
+    }
+
+    if(indexed && (stages & CompileStage::OptimizeVertexFetch)) {
+        const std::vector<UnsignedInt> remap = optimizeVertexFetch(indices, UnsignedInt(positions.size()));
+        positions = duplicate(remap, positions);
+        if(!normals.empty()) normals = duplicate(remap, normals);
+        if(!textureCoords.empty()) textureCoords = duplicate(remap, textureCoords);
+
+        const Clock::time_point end = Clock::now();
+        timings.optimizeVertexFetch = end - begin;
+        begin = end;
+    }
+
+    vertices = Implementation::packVertices(positions, normals, textureCoords,
+        stages & CompileStage::PackAttributes ? packing : CompilePackingFlags{});
+    const Clock::time_point packed = Clock::now();
+    timings.packAttributes = packed - begin;
+
+    if(indexed) {
+        if(stages & CompileStage::CompressIndices)
+            std::tie(indexData, indexType, indexStart, indexEnd) = compressIndices(indices);
+        else {
+            indexData = Containers::Array<char>{Containers::NoInit, indices.size()*sizeof(UnsignedInt)};
+            std::memcpy(indexData.data(), indices.data(), indexData.size());
+            indexType = Mesh::IndexType::UnsignedInt;
+            indexStart = 0;
+            indexEnd = UnsignedInt(positions.size());
+            if(indexEnd) --indexEnd;
+        }
+
+        timings.compressIndices = Clock::now() - packed;
+    }
+}
+
+}}
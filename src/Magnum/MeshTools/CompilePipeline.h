@@ -0,0 +1,312 @@
+#ifndef Magnum_MeshTools_CompilePipeline_h
+#define Magnum_MeshTools_CompilePipeline_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::CompilePipeline, enum @ref Magnum::MeshTools::CompileStage, enum set @ref Magnum::MeshTools::CompileStages
+ */
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh compilation stage
+
+@see @ref CompileStages, @ref CompilePipeline
+*/
+enum class CompileStage: UnsignedByte {
+    /**
+     * Vertices with the same position, normal and texture coordinates are
+     * merged using @ref removeDuplicates() and @ref combineIndexedArrays().
+     * Non-indexed meshes become indexed.
+     */
+    RemoveDuplicates = 1 << 0,
+
+    /**
+     * Triangles are reordered for post-transform vertex cache using
+     * @ref optimizeVertexCache(). Done only for indexed
+     * @ref MeshPrimitive::Triangles meshes.
+     */
+    OptimizeVertexCache = 1 << 1,
+
+    /**
+     * Vertices are reordered for vertex fetch using
+     * @ref optimizeVertexFetch(), removing the unused ones. Done only for
+     * indexed meshes.
+     */
+    OptimizeVertexFetch = 1 << 2,
+
+    /**
+     * Vertex attributes are packed according to
+     * @ref CompilePipeline::packing(), see @ref CompilePackingFlag for
+     * details. If not set, the attributes are interleaved as floats.
+     */
+    PackAttributes = 1 << 3,
+
+    /**
+     * Indices are stored in the smallest possible type using
+     * @ref compressIndices(). If not set, 32-bit indices are used.
+     */
+    CompressIndices = 1 << 4
+};
+
+/**
+@brief Mesh compilation stages
+
+@see @ref CompilePipeline::setStages()
+*/
+typedef Containers::EnumSet<CompileStage> CompileStages;
+
+CORRADE_ENUMSET_OPERATORS(CompileStages)
+
+/**
+@brief Background mesh compilation pipeline
+
+Unlike @ref compile(), which uploads the mesh data as they are, the pipeline
+optimizes them first. The CPU stages run as tasks on a @ref TaskScheduler, so
+many meshes can be processed in parallel while the application keeps
+rendering, and only the upload is done on the thread owning the OpenGL
+context:
+@code
+MeshTools::CompilePipeline pipeline;
+MeshTools::CompilePipeline::Id id = pipeline.add(std::move(*importer.mesh3D(0)));
+
+// ... later, for example once per frame
+if(pipeline.isFinished(id)) {
+    MeshTools::CompilePipeline::CompiledMesh compiled = pipeline.finish(id);
+    // compiled.mesh is ready to draw
+}
+@endcode
+
+The stages, see @ref CompileStage, are run in the order they are listed.
+Stage and upload durations of each mesh are reported in
+@ref CompiledMesh::timings, so asset processing can be budgeted. Positions
+are bound to @ref Shaders::Generic3D::Position, normals to
+@ref Shaders::Generic3D::Normal and texture coordinates to
+@ref Shaders::Generic3D::TextureCoordinates, only the first array of each is
+used.
+
+The pipeline itself is not thread-safe, all functions need to be called from
+the same thread, the one owning the OpenGL context.
+*/
+class MAGNUM_MESHTOOLS_EXPORT CompilePipeline {
+    public:
+        /**
+         * @brief Mesh ID
+         *
+         * @see @ref add()
+         */
+        typedef UnsignedInt Id;
+
+        /** @brief Stage durations */
+        struct Timings {
+            /** @brief @ref CompileStage::RemoveDuplicates duration */
+            std::chrono::high_resolution_clock::duration removeDuplicates;
+
+            /** @brief @ref CompileStage::OptimizeVertexCache duration */
+            std::chrono::high_resolution_clock::duration optimizeVertexCache;
+
+            /** @brief @ref CompileStage::OptimizeVertexFetch duration */
+            std::chrono::high_resolution_clock::duration optimizeVertexFetch;
+
+            /**
+             * @brief Vertex interleaving duration
+             *
+             * Includes the @ref CompileStage::PackAttributes stage, if
+             * enabled.
+             */
+            std::chrono::high_resolution_clock::duration packAttributes;
+
+            /**
+             * @brief Index conversion duration
+             *
+             * Includes the @ref CompileStage::CompressIndices stage, if
+             * enabled.
+             */
+            std::chrono::high_resolution_clock::duration compressIndices;
+
+            /** @brief Buffer upload and mesh setup duration */
+            std::chrono::high_resolution_clock::duration upload;
+        };
+
+        /** @brief Compiled mesh */
+        struct CompiledMesh {
+            Mesh mesh;                          /**< @brief Mesh */
+            std::unique_ptr<Buffer> vertices;   /**< @brief Vertex buffer */
+
+            /**
+             * @brief Index buffer
+             *
+             * `nullptr` if the mesh is not indexed.
+             */
+            std::unique_ptr<Buffer> indices;
+
+            /**
+             * @brief Dequantization matrix
+             *
+             * Identity if positions are not packed, see
+             * @ref compile(const Trade::MeshData3D&, BufferUsage, CompilePackingFlags)
+             * for details.
+             */
+            Matrix4 dequantization;
+
+            Timings timings;                    /**< @brief Stage durations */
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * All stages are enabled by default, @ref packing() is empty and
+         * @ref usage() is @ref BufferUsage::StaticDraw.
+         */
+        explicit CompilePipeline(TaskScheduler& scheduler);
+
+        /**
+         * @brief Construct with the global scheduler
+         *
+         * Same as calling @ref CompilePipeline(TaskScheduler&) with
+         * @ref TaskScheduler::global().
+         */
+        explicit CompilePipeline();
+
+        /** @brief Copying is not allowed */
+        CompilePipeline(const CompilePipeline&) = delete;
+
+        /** @brief Moving is not allowed */
+        CompilePipeline(CompilePipeline&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for meshes that are still being processed, the results of
+         * unfinished meshes are discarded.
+         */
+        ~CompilePipeline();
+
+        /** @brief Copying is not allowed */
+        CompilePipeline& operator=(const CompilePipeline&) = delete;
+
+        /** @brief Moving is not allowed */
+        CompilePipeline& operator=(CompilePipeline&&) = delete;
+
+        /** @brief Enabled stages */
+        CompileStages stages() const { return _stages; }
+
+        /**
+         * @brief Set enabled stages
+         * @return Reference to self (for method chaining)
+         *
+         * Affects only meshes added after this call.
+         */
+        CompilePipeline& setStages(CompileStages stages) {
+            _stages = stages;
+            return *this;
+        }
+
+        /** @brief Vertex data packing */
+        CompilePackingFlags packing() const { return _packing; }
+
+        /**
+         * @brief Set vertex data packing
+         * @return Reference to self (for method chaining)
+         *
+         * Used only if @ref CompileStage::PackAttributes is enabled. Affects
+         * only meshes added after this call.
+         */
+        CompilePipeline& setPacking(CompilePackingFlags packing) {
+            _packing = packing;
+            return *this;
+        }
+
+        /** @brief Buffer usage */
+        BufferUsage usage() const { return _usage; }
+
+        /**
+         * @brief Set buffer usage
+         * @return Reference to self (for method chaining)
+         *
+         * Used for both vertex and index buffer.
+         */
+        CompilePipeline& setUsage(BufferUsage usage) {
+            _usage = usage;
+            return *this;
+        }
+
+        /** @brief Count of meshes that weren't finished yet */
+        std::size_t pendingCount() const { return _jobs.size(); }
+
+        /**
+         * @brief Add a mesh
+         *
+         * Takes over the data and schedules the CPU stages on the scheduler.
+         * Expects that the mesh has at least one position array.
+         * @see @ref isFinished(), @ref finish()
+         */
+        Id add(Trade::MeshData3D meshData);
+
+        /**
+         * @brief Whether the CPU stages of given mesh finished
+         *
+         * If this returns `true`, @ref finish() doesn't block. Expects that
+         * @p id was returned from @ref add() and wasn't finished yet.
+         */
+        bool isFinished(Id id);
+
+        /**
+         * @brief Finish given mesh
+         *
+         * Waits for the CPU stages, running queued scheduler tasks
+         * meanwhile, then uploads the data and configures the mesh. Expects
+         * that @p id was returned from @ref add() and wasn't finished yet.
+         */
+        CompiledMesh finish(Id id);
+
+    private:
+        struct Job;
+
+        TaskScheduler& _scheduler;
+        CompileStages _stages;
+        CompilePackingFlags _packing;
+        BufferUsage _usage;
+        Id _nextId;
+        std::unordered_map<Id, std::unique_ptr<Job>> _jobs;
+};
+
+}}
+
+#endif
@@ -29,49 +29,144 @@
 #include <algorithm>
 #include <Corrade/Containers/Array.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MESHTOOLS_USE_SSE2
+#endif
+
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace {
 
-template<class T> inline Containers::Array<char> compress(const std::vector<UnsignedInt>& indices) {
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i]);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+/* Below this many indices the conversion is done on a single thread */
+enum: std::size_t { MinChunkSize = 256*1024 };
+
+std::pair<UnsignedInt, UnsignedInt> minmax(const std::vector<UnsignedInt>& indices) {
+    if(indices.empty()) return {0, 0};
+
+    /* Per-chunk minimum and maximum. Written as a plain loop without
+       branches so the compiler can vectorize it. */
+    const std::size_t size = Magnum::Implementation::chunkSize(indices.size(), MinChunkSize);
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> chunks((indices.size() + size - 1)/size);
+    const UnsignedInt* const data = indices.data();
+    Magnum::Implementation::parallelChunks(indices.size(), size, [data, &chunks](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+        UnsignedInt min = data[begin], max = data[begin];
+        for(std::size_t i = begin; i != end; ++i) {
+            min = std::min(min, data[i]);
+            max = std::max(max, data[i]);
+        }
+        chunks[chunk] = {min, max};
+    });
+
+    std::pair<UnsignedInt, UnsignedInt> out = chunks[0];
+    for(const auto& chunk: chunks) {
+        out.first = std::min(out.first, chunk.first);
+        out.second = std::max(out.second, chunk.second);
     }
 
+    return out;
+}
+
+/* Subtracts the offset and narrows the values to the output type. All values
+   are expected to fit. */
+inline void convert(const UnsignedInt* in, UnsignedByte* out, std::size_t count, const UnsignedInt offset) {
+    #ifdef MAGNUM_MESHTOOLS_USE_SSE2
+    /* The values fit into 8 bits, so signed saturation to 16 bits and then
+       unsigned saturation to 8 bits is lossless */
+    const __m128i vOffset = _mm_set1_epi32(offset);
+    for(; count >= 16; count -= 16, in += 16, out += 16) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), vOffset);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4)), vOffset);
+        const __m128i c = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8)), vOffset);
+        const __m128i d = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), vOffset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+    #endif
+
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = UnsignedByte(in[i] - offset);
+}
+
+inline void convert(const UnsignedInt* in, UnsignedShort* out, std::size_t count, const UnsignedInt offset) {
+    #ifdef MAGNUM_MESHTOOLS_USE_SSE2
+    /* SSE2 has only signed saturation, so the values are shifted to the
+       signed 16-bit range first and back after packing */
+    const __m128i vOffset = _mm_set1_epi32(offset + 0x8000);
+    const __m128i bias = _mm_set1_epi16(-0x8000);
+    for(; count >= 8; count -= 8, in += 8, out += 8) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), vOffset);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4)), vOffset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm_xor_si128(_mm_packs_epi32(a, b), bias));
+    }
+    #endif
+
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = UnsignedShort(in[i] - offset);
+}
+
+inline void convert(const UnsignedInt* in, UnsignedInt* out, const std::size_t count, const UnsignedInt offset) {
+    if(!offset) {
+        std::memcpy(out, in, count*sizeof(UnsignedInt));
+        return;
+    }
+
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = in[i] - offset;
+}
+
+template<class T> void compressInto(const std::vector<UnsignedInt>& indices, T* const out, const UnsignedInt offset) {
+    const UnsignedInt* const in = indices.data();
+    Magnum::Implementation::parallelChunks(indices.size(), Magnum::Implementation::chunkSize(indices.size(), MinChunkSize), [in, out, offset](std::size_t, const std::size_t begin, const std::size_t end) {
+        convert(in + begin, out + begin, end - begin, offset);
+    });
+}
+
+template<class T> inline Containers::Array<char> compress(const std::vector<UnsignedInt>& indices, const UnsignedInt offset) {
+    Containers::Array<char> buffer(indices.size()*sizeof(T));
+    compressInto(indices, reinterpret_cast<T*>(buffer.data()), offset);
     return buffer;
 }
 
 }
 
 std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
-    /** @todo Performance hint when range can be represented by smaller value? */
-    const auto minmax = std::minmax_element(indices.begin(), indices.end());
+    return compressIndices(indices, 0);
+}
+
+std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices, const UnsignedInt offset) {
+    const std::pair<UnsignedInt, UnsignedInt> range = minmax(indices);
+    CORRADE_ASSERT(indices.empty() || range.first >= offset,
+        "MeshTools::compressIndices(): can't offset index" << range.first << "by" << offset, {});
+
+    const UnsignedInt start = range.first - offset;
+    const UnsignedInt end = range.second - offset;
     Containers::Array<char> data;
     Mesh::IndexType type;
-    switch(Math::log(256, *minmax.second)) {
+    switch(Math::log(256, end)) {
         case 0:
-            data = compress<UnsignedByte>(indices);
+            data = compress<UnsignedByte>(indices, offset);
             type = Mesh::IndexType::UnsignedByte;
             break;
         case 1:
-            data = compress<UnsignedShort>(indices);
+            data = compress<UnsignedShort>(indices, offset);
             type = Mesh::IndexType::UnsignedShort;
             break;
         case 2:
         case 3:
-            data = compress<UnsignedInt>(indices);
+            data = compress<UnsignedInt>(indices, offset);
             type = Mesh::IndexType::UnsignedInt;
             break;
 
         default:
-            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << *minmax.second << "elements.", {});
+            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << end << "elements.", {});
     }
 
-    return std::make_tuple(std::move(data), type, *minmax.first, *minmax.second);
+    return std::make_tuple(std::move(data), type, start, end);
 }
 
 template<class T> Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices) {
@@ -81,9 +176,7 @@ template<class T> Containers::Array<T> compressIndicesAs(const std::vector<Unsig
     #endif
 
     Containers::Array<T> buffer(indices.size());
-    for(std::size_t i = 0; i != indices.size(); ++i)
-        buffer[i] = T(indices[i]);
-
+    compressInto(indices, buffer.data(), 0);
     return buffer;
 }
 
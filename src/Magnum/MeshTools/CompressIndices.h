@@ -44,7 +44,8 @@ namespace Magnum { namespace MeshTools {
 This function takes index array and outputs them compressed to smallest
 possible size. For example when your indices have maximum number 463, it's
 wasteful to store them in array of 32bit integers, array of 16bit integers is
-sufficient.
+sufficient. The conversion is vectorized and large index arrays are
+processed on multiple threads.
 
 Example usage:
 @code
@@ -63,11 +64,47 @@ mesh.setCount(indices.size())
     .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
 @endcode
 
-@see @ref compressIndicesAs()
+@see @ref compressIndicesAs(),
+    @ref compressIndices(const std::vector<UnsignedInt>&, UnsignedInt)
 @todo Extract IndexType out of Mesh class
 */
 std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices with an offset
+@param indices  Index array
+@param offset   Offset subtracted from all indices
+@return Index range, type and compressed index array
+
+Like @ref compressIndices(const std::vector<UnsignedInt>&), but subtracts
+@p offset from all indices first, so for example indices in range
+@f$ [ 100000, 100200 ] @f$ can be stored in 8bit integers. The returned index
+range is also offset. The mesh then needs to have its vertex buffers offset
+by the same value, either with @ref Mesh::setBaseVertex() or directly by
+specifying vertex buffer offset in @ref Mesh::addVertexBuffer(). Expects that
+all indices are not smaller than @p offset.
+
+Example usage:
+@code
+std::vector<UnsignedInt> indices;
+const UnsignedInt baseVertex = *std::min_element(indices.begin(), indices.end());
+
+Containers::Array<char> indexData;
+Mesh::IndexType indexType;
+UnsignedInt indexStart, indexEnd;
+std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(indices, baseVertex);
+
+Buffer indexBuffer;
+indexBuffer.setData(indexData, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(indices.size())
+    .setBaseVertex(baseVertex)
+    .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
+@endcode
+*/
+std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices, UnsignedInt offset);
+
 /**
 @brief Compress vertex indices as given type
 
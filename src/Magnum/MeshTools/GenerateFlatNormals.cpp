@@ -25,30 +25,31 @@
 
 #include "GenerateFlatNormals.h"
 
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Implementation/FaceNormals.h"
 
 namespace Magnum { namespace MeshTools {
 
 std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateFlatNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateFlatNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
 
-    /* Create normal for every triangle (assuming counterclockwise winding) */
-    std::vector<UnsignedInt> normalIndices;
-    normalIndices.reserve(indices.size());
-    std::vector<Vector3> normals;
-    normals.reserve(indices.size()/3);
-    for(std::size_t i = 0; i != indices.size(); i += 3) {
-        const Vector3 normal = Math::cross(positions[indices[i+2]]-positions[indices[i+1]],
-                                           positions[indices[i]]-positions[indices[i+1]]).normalized();
-
-        /* Use the same normal for all three vertices of the face */
-        normalIndices.push_back(normals.size());
-        normalIndices.push_back(normals.size());
-        normalIndices.push_back(normals.size());
-        normals.push_back(normal);
-    }
+    /* Create normal for every triangle, with the same normal for all three
+       vertices of the face. The triangles are processed in parallel chunks. */
+    const std::size_t triangleCount = indices.size()/3;
+    std::vector<UnsignedInt> normalIndices(indices.size());
+    std::vector<Vector3> normals(triangleCount);
+    const UnsignedInt* const indexData = indices.data();
+    const Vector3* const positionData = positions.data();
+    UnsignedInt* const normalIndexData = normalIndices.data();
+    Vector3* const normalData = normals.data();
+    Magnum::Implementation::parallelChunks(triangleCount, Magnum::Implementation::chunkSize(triangleCount, 16*1024), [indexData, positionData, normalIndexData, normalData](std::size_t, const std::size_t begin, const std::size_t end) {
+        Implementation::faceNormals(indexData, positionData, begin, end, normalData);
+        for(std::size_t i = begin; i != end; ++i)
+            normalIndexData[i*3] = normalIndexData[i*3 + 1] = normalIndexData[i*3 + 2] = i;
+    });
 
     /* Remove duplicate normals and return */
     normalIndices = MeshTools::duplicate(normalIndices, MeshTools::removeDuplicates(normals));
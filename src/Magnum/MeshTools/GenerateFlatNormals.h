@@ -56,6 +56,10 @@ std::tie(normalIndices, normals) = MeshTools::generateFlatNormals(vertexIndices,
 You can then use @ref combineIndexedArrays() to combine normal and vertex array
 to use the same indices.
 
+The triangles are processed in parallel on large meshes. See
+@ref generateSmoothNormals() for a variant interpolating the normals across
+faces.
+
 @attention The function requires the mesh to have triangle faces, thus index
     count must be divisible by 3.
 */
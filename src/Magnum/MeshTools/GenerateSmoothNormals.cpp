@@ -0,0 +1,186 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <cmath>
+
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/FaceNormals.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Below this many triangles or vertices everything is done on a single
+   thread */
+enum: std::size_t { MinChunkSize = 16*1024 };
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormalsInternal(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const bool crease, const Float creaseCos) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+
+    const std::size_t triangleCount = indices.size()/3;
+    const UnsignedInt* const indexData = indices.data();
+    const Vector3* const positionData = positions.data();
+
+    /* Normal of each face and angle of each face corner. Degenerate faces
+       get zero normal and zero weight so they don't contribute anything. */
+    std::vector<Vector3> faceNormals(triangleCount);
+    std::vector<Float> cornerAngles(indices.size());
+    {
+        Vector3* const faceNormalData = faceNormals.data();
+        Float* const cornerAngleData = cornerAngles.data();
+        Magnum::Implementation::parallelChunks(triangleCount, Magnum::Implementation::chunkSize(triangleCount, MinChunkSize), [indexData, positionData, faceNormalData, cornerAngleData](std::size_t, const std::size_t begin, const std::size_t end) {
+            Implementation::faceNormals(indexData, positionData, begin, end, faceNormalData);
+            for(std::size_t i = begin; i != end; ++i) {
+                /* Also catches NaNs */
+                if(!(faceNormalData[i].dot() > 0.0f)) {
+                    faceNormalData[i] = {};
+                    cornerAngleData[i*3] = cornerAngleData[i*3 + 1] = cornerAngleData[i*3 + 2] = 0.0f;
+                    continue;
+                }
+
+                for(std::size_t j = 0; j != 3; ++j) {
+                    const Vector3& position = positionData[indexData[i*3 + j]];
+                    const Vector3 a = positionData[indexData[i*3 + (j + 1)%3]] - position;
+                    const Vector3 b = positionData[indexData[i*3 + (j + 2)%3]] - position;
+                    cornerAngleData[i*3 + j] = std::acos(Math::clamp(Math::dot(a, b)/std::sqrt(a.dot()*b.dot()), -1.0f, 1.0f));
+                }
+            }
+        });
+    }
+
+    /* Corners sharing each vertex, in a compressed form. The corner list for
+       vertex `i` is `[cornerOffsets[i], cornerOffsets[i + 1])` in
+       `vertexCorners`. */
+    const std::size_t vertexCount = positions.size();
+    std::vector<UnsignedInt> cornerOffsets(vertexCount + 1);
+    for(const UnsignedInt index: indices) ++cornerOffsets[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i) cornerOffsets[i + 1] += cornerOffsets[i];
+    std::vector<UnsignedInt> vertexCorners(indices.size());
+    {
+        std::vector<UnsignedInt> position{cornerOffsets.begin(), cornerOffsets.end() - 1};
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            vertexCorners[position[indices[i]]++] = i;
+    }
+
+    /* Calculate normal of each corner as angle-weighted sum of face normals
+       of all corners sharing the vertex and not separated by a crease. Each
+       distinct normal of given vertex gets a local ID. */
+    std::vector<Vector3> cornerNormals(indices.size());
+    std::vector<UnsignedInt> cornerNormalIds(indices.size());
+    std::vector<UnsignedInt> normalOffsets(vertexCount + 1);
+    const std::size_t vertexChunkSize = Magnum::Implementation::chunkSize(vertexCount, MinChunkSize);
+    {
+        const UnsignedInt* const cornerOffsetData = cornerOffsets.data();
+        const UnsignedInt* const vertexCornerData = vertexCorners.data();
+        const Vector3* const faceNormalData = faceNormals.data();
+        const Float* const cornerAngleData = cornerAngles.data();
+        Vector3* const cornerNormalData = cornerNormals.data();
+        UnsignedInt* const cornerNormalIdData = cornerNormalIds.data();
+        UnsignedInt* const normalCountData = normalOffsets.data() + 1;
+        Magnum::Implementation::parallelChunks(vertexCount, vertexChunkSize, [=](std::size_t, const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) {
+                const UnsignedInt* const corners = vertexCornerData + cornerOffsetData[i];
+                const std::size_t cornerCount = cornerOffsetData[i + 1] - cornerOffsetData[i];
+                UnsignedInt normalCount = 0;
+
+                for(std::size_t j = 0; j != cornerCount; ++j) {
+                    const UnsignedInt face = corners[j]/3;
+
+                    /* Without crease all corners get the same normal */
+                    if(!crease && j) {
+                        cornerNormalData[corners[j]] = cornerNormalData[corners[0]];
+                        cornerNormalIdData[corners[j]] = 0;
+                        continue;
+                    }
+
+                    Vector3 normal;
+                    for(std::size_t k = 0; k != cornerCount; ++k) {
+                        const UnsignedInt otherFace = corners[k]/3;
+                        if(crease && otherFace != face && Math::dot(faceNormalData[face], faceNormalData[otherFace]) < creaseCos)
+                            continue;
+                        normal += faceNormalData[otherFace]*cornerAngleData[corners[k]];
+                    }
+                    if(normal.dot() > 0.0f) normal = normal.normalized();
+
+                    /* Reuse ID of the same normal calculated for a previous
+                       corner, if any */
+                    UnsignedInt id = normalCount;
+                    for(std::size_t k = 0; k != j; ++k) if(cornerNormalData[corners[k]] == normal) {
+                        id = cornerNormalIdData[corners[k]];
+                        break;
+                    }
+                    if(id == normalCount) ++normalCount;
+
+                    cornerNormalData[corners[j]] = normal;
+                    cornerNormalIdData[corners[j]] = id;
+                }
+
+                normalCountData[i] = crease ? normalCount : UnsignedInt(cornerCount != 0);
+            }
+        });
+    }
+
+    /* Place normals of each vertex one after another */
+    for(std::size_t i = 0; i != vertexCount; ++i) normalOffsets[i + 1] += normalOffsets[i];
+    std::vector<UnsignedInt> normalIndices(indices.size());
+    std::vector<Vector3> normals(normalOffsets.back());
+    {
+        const UnsignedInt* const cornerOffsetData = cornerOffsets.data();
+        const UnsignedInt* const vertexCornerData = vertexCorners.data();
+        const Vector3* const cornerNormalData = cornerNormals.data();
+        const UnsignedInt* const cornerNormalIdData = cornerNormalIds.data();
+        const UnsignedInt* const normalOffsetData = normalOffsets.data();
+        UnsignedInt* const normalIndexData = normalIndices.data();
+        Vector3* const normalData = normals.data();
+        Magnum::Implementation::parallelChunks(vertexCount, vertexChunkSize, [=](std::size_t, const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) {
+                for(std::size_t j = cornerOffsetData[i]; j != cornerOffsetData[i + 1]; ++j) {
+                    const UnsignedInt corner = vertexCornerData[j];
+                    const UnsignedInt id = normalOffsetData[i] + cornerNormalIdData[corner];
+                    normalIndexData[corner] = id;
+                    normalData[id] = cornerNormalData[corner];
+                }
+            }
+        });
+    }
+
+    return std::make_tuple(std::move(normalIndices), std::move(normals));
+}
+
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    return generateSmoothNormalsInternal(indices, positions, false, -1.0f);
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Rad creaseAngle) {
+    return generateSmoothNormalsInternal(indices, positions, true, Math::cos(creaseAngle));
+}
+
+}}
@@ -0,0 +1,82 @@
+#ifndef Magnum_MeshTools_Implementation_FaceNormals_h
+#define Magnum_MeshTools_Implementation_FaceNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MESHTOOLS_FACENORMALS_USE_SSE2
+#endif
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Calculates normalized normals of triangles `[begin, end)` (assuming
+   counterclockwise winding). With SSE2 four triangles are processed at once
+   in a structure-of-arrays layout, doing exactly the same operations as
+   Math::cross() and Vector::normalized() so the result doesn't depend on the
+   code path. */
+inline void faceNormals(const UnsignedInt* const indices, const Vector3* const positions, std::size_t begin, const std::size_t end, Vector3* const out) {
+    #ifdef MAGNUM_MESHTOOLS_FACENORMALS_USE_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    for(; begin + 4 <= end; begin += 4) {
+        /* Gather the edge vectors of four triangles */
+        alignas(16) Float ax[4], ay[4], az[4], bx[4], by[4], bz[4];
+        for(std::size_t i = 0; i != 4; ++i) {
+            const UnsignedInt* const triangle = indices + (begin + i)*3;
+            const Vector3 a = positions[triangle[2]] - positions[triangle[1]];
+            const Vector3 b = positions[triangle[0]] - positions[triangle[1]];
+            ax[i] = a.x(); ay[i] = a.y(); az[i] = a.z();
+            bx[i] = b.x(); by[i] = b.y(); bz[i] = b.z();
+        }
+
+        const __m128 vax = _mm_load_ps(ax), vay = _mm_load_ps(ay), vaz = _mm_load_ps(az);
+        const __m128 vbx = _mm_load_ps(bx), vby = _mm_load_ps(by), vbz = _mm_load_ps(bz);
+        const __m128 x = _mm_sub_ps(_mm_mul_ps(vay, vbz), _mm_mul_ps(vby, vaz));
+        const __m128 y = _mm_sub_ps(_mm_mul_ps(vaz, vbx), _mm_mul_ps(vbz, vax));
+        const __m128 z = _mm_sub_ps(_mm_mul_ps(vax, vby), _mm_mul_ps(vbx, vay));
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 lengthInverted = _mm_div_ps(one, _mm_sqrt_ps(dot));
+
+        alignas(16) Float nx[4], ny[4], nz[4];
+        _mm_store_ps(nx, _mm_mul_ps(x, lengthInverted));
+        _mm_store_ps(ny, _mm_mul_ps(y, lengthInverted));
+        _mm_store_ps(nz, _mm_mul_ps(z, lengthInverted));
+        for(std::size_t i = 0; i != 4; ++i)
+            out[begin + i] = {nx[i], ny[i], nz[i]};
+    }
+    #endif
+
+    for(; begin != end; ++begin) {
+        const UnsignedInt* const triangle = indices + begin*3;
+        out[begin] = Math::cross(positions[triangle[2]] - positions[triangle[1]],
+                                 positions[triangle[0]] - positions[triangle[1]]).normalized();
+    }
+}
+
+}}}
+
+#endif
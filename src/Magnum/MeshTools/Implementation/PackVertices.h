@@ -0,0 +1,56 @@
+#ifndef Magnum_MeshTools_Implementation_PackVertices_h
+#define Magnum_MeshTools_Implementation_PackVertices_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Interleaved and possibly packed vertex data, shared between compile() and
+   CompilePipeline so the CPU part can run outside of the GL thread */
+struct PackedVertices {
+    Containers::Array<char> data;
+    UnsignedInt stride, normalOffset, textureCoordsOffset;
+    bool hasNormals, hasTextureCoords;
+    bool packedPositions, packedNormals, packedTextureCoords;
+    Matrix4 dequantization;
+};
+
+/* The normals and texture coordinates are optional, pass empty arrays if
+   the mesh doesn't have them */
+PackedVertices packVertices(const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoords, CompilePackingFlags packing);
+
+/* Configures attributes of the mesh for data uploaded to given buffer */
+void addPackedVertexBuffer(Mesh& mesh, Buffer& buffer, const PackedVertices& vertices);
+
+}}}
+
+#endif
@@ -125,6 +125,10 @@ auto data = MeshTools::interleave(positions, weights, 2, textureCoordinates, 1);
 All gap bytes are set zero. This way vertex stride is 24 bytes, without gaps it
 would be 21 bytes, causing possible performance loss.
 
+To reduce vertex data size, the attributes can be packed to half-floats or
+normalized integers first using @ref Math::packHalf() or
+@ref Math::packNormalized() and then interleaved.
+
 @attention The function expects that all arrays have the same size.
 
 @note The only requirements to attribute array type is that it must have
@@ -162,6 +166,9 @@ parameters.
 @attention Similarly to @ref interleave(), this function expects that all
     arrays have the same size. The passed buffer must also be large enough to
     contain the interleaved data.
+
+@see @ref interleaveIntoParallel(),
+    @ref interleaveInto(Buffer&, GLintptr, const T&, const U&...)
 */
 template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> buffer, const T& first, const U&... next) {
     /* Verify expected buffer size */
@@ -0,0 +1,47 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InterleaveBuffer.h"
+
+#include "Magnum/Implementation/Parallel.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+namespace {
+    /* Copying is cheap, so the chunks need to be large to make spawning the
+       threads worth it */
+    enum: std::size_t { MinChunkSize = 32*1024 };
+}
+
+void interleaveParallel(const InterleaveAttribute* const attributes, const std::size_t attributeCount, const std::size_t vertexCount, const std::size_t stride, char* const data) {
+    /* Each thread writes whole vertices of its own range, so no two threads
+       ever write to the same cache line except at the chunk boundaries */
+    Magnum::Implementation::parallelChunks(vertexCount, Magnum::Implementation::chunkSize(vertexCount, MinChunkSize), [=](std::size_t, const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = 0; i != attributeCount; ++i)
+            attributes[i].write(attributes[i].attribute, data + attributes[i].offset, stride, begin, end);
+    });
+}
+
+}}}
@@ -0,0 +1,168 @@
+#ifndef Magnum_MeshTools_InterleaveBuffer_h
+#define Magnum_MeshTools_InterleaveBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::interleaveIntoParallel(), @ref Magnum::MeshTools::interleaveInto(Buffer&, GLintptr, const T&, const U&...)
+ */
+
+#include <iterator>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+/* Type-erased attribute array, so the threading can be done in a single
+   non-templated function */
+struct InterleaveAttribute {
+    void(*write)(const void*, char*, std::size_t, std::size_t, std::size_t);
+    const void* attribute;
+    std::size_t offset;
+};
+
+/* Copies items `[begin, end)` of given attribute array to `data` with given
+   stride */
+template<class T> void writeInterleavedRange(const void* attribute, char* data, const std::size_t stride, const std::size_t begin, const std::size_t end) {
+    const T& attributeList = *static_cast<const T*>(attribute);
+    auto it = attributeList.begin();
+    std::advance(it, begin);
+    for(std::size_t i = begin; i != end; ++i, ++it)
+        std::memcpy(data + i*stride, reinterpret_cast<const char*>(&*it), sizeof(typename T::value_type));
+}
+
+/* Fills the type-erased attribute list, skipping gaps. Returns count of
+   filled attributes. */
+inline std::size_t interleaveAttributes(InterleaveAttribute*, std::size_t) { return 0; }
+template<class ...U> std::size_t interleaveAttributes(InterleaveAttribute* out, std::size_t offset, std::size_t gap, const U&... next);
+template<class T, class ...U> typename std::enable_if<!std::is_convertible<T, std::size_t>::value, std::size_t>::type interleaveAttributes(InterleaveAttribute* out, const std::size_t offset, const T& first, const U&... next) {
+    *out = InterleaveAttribute{writeInterleavedRange<T>, &first, offset};
+    return 1 + interleaveAttributes(out + 1, offset + sizeof(typename T::value_type), next...);
+}
+template<class ...U> std::size_t interleaveAttributes(InterleaveAttribute* out, const std::size_t offset, const std::size_t gap, const U&... next) {
+    return interleaveAttributes(out, offset + gap, next...);
+}
+
+/* Writes all attributes to `data`, large meshes are split into consecutive
+   vertex ranges processed in parallel */
+MAGNUM_MESHTOOLS_EXPORT void interleaveParallel(const InterleaveAttribute* attributes, std::size_t attributeCount, std::size_t vertexCount, std::size_t stride, char* data);
+
+}
+
+/**
+@brief Interleave vertex attributes into existing buffer in parallel
+
+Same as @ref interleaveInto(Containers::ArrayView<char>, const T&, const U&...),
+but for large meshes the vertices are split into consecutive ranges, each
+interleaved on a separate thread. Every thread thus writes whole vertices to
+a contiguous memory range, which makes it suitable also for writing directly
+to write-combined memory, such as a view returned from
+@ref RingBuffer::allocate():
+@code
+RingBuffer ring{4*1024*1024};
+std::vector<Vector3> positions;
+std::vector<Vector2> textureCoordinates;
+
+std::pair<GLintptr, Containers::ArrayView<char>> vertices = ring.allocate(positions.size()*(sizeof(Vector3) + sizeof(Vector2)));
+MeshTools::interleaveIntoParallel(vertices.second, positions, textureCoordinates);
+ring.flush();
+
+mesh.addVertexBuffer(ring.buffer(), vertices.first, MyShader::Position{}, MyShader::TextureCoordinates{});
+@endcode
+
+The attribute arrays need to support `std::advance()` on their iterators,
+which is a constant-time operation for `std::vector` and `std::array`. Gaps
+are left untouched.
+
+@attention The function expects that all arrays have the same size. The passed
+    buffer must also be large enough to contain the interleaved data.
+
+@see @ref interleaveInto(Buffer&, GLintptr, const T&, const U&...)
+*/
+template<class T, class ...U> void interleaveIntoParallel(Containers::ArrayView<char> buffer, const T& first, const U&... next) {
+    const std::size_t vertexCount = Implementation::AttributeCount{}(first, next...);
+    const std::size_t stride = Implementation::Stride{}(first, next...);
+    CORRADE_ASSERT(vertexCount == ~std::size_t(0) || vertexCount*stride <= buffer.size(), "MeshTools::interleaveIntoParallel(): the data buffer is too small, expected" << vertexCount*stride << "but got" << buffer.size(), );
+
+    /* Nothing to do if there are just gaps */
+    if(!vertexCount || vertexCount == ~std::size_t(0)) return;
+
+    Implementation::InterleaveAttribute attributes[sizeof...(next) + 1];
+    const std::size_t attributeCount = Implementation::interleaveAttributes(attributes, 0, first, next...);
+    Implementation::interleaveParallel(attributes, attributeCount, vertexCount, stride, buffer.data());
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+/**
+@brief Interleave vertex attributes directly into mapped buffer memory
+
+Maps @p buffer range starting at @p offset with @ref Buffer::MapFlag::Write and
+@ref Buffer::MapFlag::InvalidateRange, interleaves the attributes directly into
+it using @ref interleaveIntoParallel() and unmaps it again. Compared to
+uploading the result of @ref interleave() with @ref Buffer::setData(), this
+avoids the intermediate allocation and one full copy of the data, which is
+useful for dynamic geometry updated every frame:
+@code
+Buffer vertexBuffer;
+vertexBuffer.setData({nullptr, maxVertexCount*(sizeof(Vector3) + sizeof(Color4))}, BufferUsage::DynamicDraw);
+
+// every frame
+MeshTools::interleaveInto(vertexBuffer, 0, positions, colors);
+mesh.setCount(positions.size());
+@endcode
+
+The buffer must be large enough to contain the interleaved data. Contents of
+the gaps are undefined after the call, as the whole mapped range is
+invalidated. Returns the result of @ref Buffer::unmap(), i.e. `false` if the
+buffer contents became corrupt during the operation and need to be uploaded
+again.
+@requires_gl30 Extension @extension{ARB,map_buffer_range}
+@requires_gles30 Extension @es_extension{EXT,map_buffer_range} in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+template<class T, class ...U> bool interleaveInto(Buffer& buffer, const GLintptr offset, const T& first, const U&... next) {
+    const std::size_t vertexCount = Implementation::AttributeCount{}(first, next...);
+    const std::size_t stride = Implementation::Stride{}(first, next...);
+
+    /* Nothing to do if there are just gaps */
+    if(!vertexCount || vertexCount == ~std::size_t(0)) return true;
+
+    const std::size_t size = vertexCount*stride;
+    char* const data = buffer.map<char>(offset, size, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateRange);
+    CORRADE_ASSERT(data, "MeshTools::interleaveInto(): can't map the buffer", false);
+
+    interleaveIntoParallel({data, size}, first, next...);
+    return buffer.unmap();
+}
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCache.h"
+
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+MeshCache::MeshCache(const BufferUsage usage): _usage{usage}, _hitCount{}, _missCount{} {}
+
+std::shared_ptr<MeshCache::CompiledMesh> MeshCache::find(const std::string& key) {
+    auto found = _meshes.find(key);
+    if(found == _meshes.end()) {
+        ++_missCount;
+        return nullptr;
+    }
+
+    ++_hitCount;
+    return found->second;
+}
+
+std::shared_ptr<MeshCache::CompiledMesh> MeshCache::get2D(const std::string& key, const std::function<Trade::MeshData2D()>& generator) {
+    if(std::shared_ptr<CompiledMesh> mesh = find(key)) return mesh;
+
+    std::shared_ptr<CompiledMesh> mesh{new CompiledMesh};
+    std::tie(mesh->mesh, mesh->vertices, mesh->indices) = compile(generator(), _usage);
+    _meshes.emplace(key, mesh);
+    return mesh;
+}
+
+std::shared_ptr<MeshCache::CompiledMesh> MeshCache::get3D(const std::string& key, const std::function<Trade::MeshData3D()>& generator) {
+    if(std::shared_ptr<CompiledMesh> mesh = find(key)) return mesh;
+
+    std::shared_ptr<CompiledMesh> mesh{new CompiledMesh};
+    std::tie(mesh->mesh, mesh->vertices, mesh->indices) = compile(generator(), _usage);
+    _meshes.emplace(key, mesh);
+    return mesh;
+}
+
+std::size_t MeshCache::prune() {
+    std::size_t count = 0;
+    for(auto it = _meshes.begin(); it != _meshes.end(); ) {
+        if(it->second.use_count() == 1) {
+            it = _meshes.erase(it);
+            ++count;
+        } else ++it;
+    }
+
+    return count;
+}
+
+void MeshCache::clear() { _meshes.clear(); }
+
+}}
@@ -0,0 +1,177 @@
+#ifndef Magnum_MeshTools_MeshCache_h
+#define Magnum_MeshTools_MeshCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::MeshCache
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Cache of compiled meshes
+
+Generating a primitive such as @ref Primitives::UVSphere::solid() and
+compiling it with @ref compile() every time the same mesh is needed wastes
+both CPU time and GPU memory. The cache compiles each combination of a
+generator function and its parameters only once and then returns a shared
+instance:
+@code
+MeshTools::MeshCache cache;
+
+std::shared_ptr<MeshTools::MeshCache::CompiledMesh> sphere =
+    cache.get(Primitives::UVSphere::solid, 16, 32, Primitives::UVSphere::TextureCoords::DontGenerate);
+std::shared_ptr<MeshTools::MeshCache::CompiledMesh> same =
+    cache.get(Primitives::UVSphere::solid, 16, 32, Primitives::UVSphere::TextureCoords::DontGenerate);
+// sphere == same
+@endcode
+
+The parameters are compared bitwise, so only functions taking plain integer,
+floating-point, enum and enum set parameters can be used, which is the case
+for all functions in the @ref Primitives namespace. The meshes are configured
+the same way as with @ref compile(), the returned instance is shared by all
+users, so it shouldn't be modified. For instanced drawing, create a
+@ref MeshView from the mesh, add the per-instance data to a separate mesh or
+set the instance count right before drawing.
+
+OpenGL objects are not shared between contexts in general, so use one
+instance of the cache per OpenGL context. Meshes that are not used anywhere
+else stay in the cache until @ref prune() or @ref clear() is called.
+*/
+class MAGNUM_MESHTOOLS_EXPORT MeshCache {
+    public:
+        /** @brief Compiled mesh */
+        struct CompiledMesh {
+            Mesh mesh;                          /**< @brief Mesh */
+            std::unique_ptr<Buffer> vertices;   /**< @brief Vertex buffer */
+
+            /** @brief Index buffer, `nullptr` if the mesh is not indexed */
+            std::unique_ptr<Buffer> indices;
+        };
+
+        /**
+         * @brief Constructor
+         * @param usage     Usage passed to @ref compile()
+         */
+        explicit MeshCache(BufferUsage usage = BufferUsage::StaticDraw);
+
+        /** @brief Count of cached meshes */
+        std::size_t size() const { return _meshes.size(); }
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of @ref get() calls that returned an already compiled mesh.
+         */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of @ref get() calls that had to generate and compile the
+         * mesh.
+         */
+        UnsignedInt missCount() const { return _missCount; }
+
+        /**
+         * @brief Get compiled 2D mesh
+         * @param generator     Function generating the mesh data
+         * @param args          Arguments for the generator
+         *
+         * If a mesh for the same @p generator and @p args is in the cache,
+         * returns it, otherwise calls @p generator, compiles the result with
+         * @ref compile(const Trade::MeshData2D&, BufferUsage) and caches it.
+         */
+        template<class ...Args> std::shared_ptr<CompiledMesh> get(Trade::MeshData2D(*generator)(Args...), typename std::common_type<Args>::type... args);
+
+        /**
+         * @brief Get compiled 3D mesh
+         *
+         * Like above, the mesh is compiled with
+         * @ref compile(const Trade::MeshData3D&, BufferUsage).
+         */
+        template<class ...Args> std::shared_ptr<CompiledMesh> get(Trade::MeshData3D(*generator)(Args...), typename std::common_type<Args>::type... args);
+
+        /**
+         * @brief Remove meshes not used outside of the cache
+         * @return Count of removed meshes
+         */
+        std::size_t prune();
+
+        /**
+         * @brief Remove all meshes
+         *
+         * The meshes still used outside of the cache stay alive until their
+         * last user releases them.
+         */
+        void clear();
+
+    private:
+        template<class T> static void appendKey(std::string& key, const T& value) {
+            key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        std::shared_ptr<CompiledMesh> get2D(const std::string& key, const std::function<Trade::MeshData2D()>& generator);
+        std::shared_ptr<CompiledMesh> get3D(const std::string& key, const std::function<Trade::MeshData3D()>& generator);
+        std::shared_ptr<CompiledMesh> find(const std::string& key);
+
+        BufferUsage _usage;
+        std::unordered_map<std::string, std::shared_ptr<CompiledMesh>> _meshes;
+        UnsignedInt _hitCount, _missCount;
+};
+
+template<class ...Args> std::shared_ptr<MeshCache::CompiledMesh> MeshCache::get(Trade::MeshData2D(*generator)(Args...), typename std::common_type<Args>::type... args) {
+    std::string key;
+    appendKey(key, generator);
+    const int expand[]{(appendKey(key, args), 0)..., 0};
+    static_cast<void>(expand);
+
+    return get2D(key, [&]() { return generator(args...); });
+}
+
+template<class ...Args> std::shared_ptr<MeshCache::CompiledMesh> MeshCache::get(Trade::MeshData3D(*generator)(Args...), typename std::common_type<Args>::type... args) {
+    std::string key;
+    appendKey(key, generator);
+    const int expand[]{(appendKey(key, args), 0)..., 0};
+    static_cast<void>(expand);
+
+    return get3D(key, [&]() { return generator(args...); });
+}
+
+}}
+
+#endif
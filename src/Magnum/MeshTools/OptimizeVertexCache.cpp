@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "OptimizeVertexCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+constexpr UnsignedInt NotInCache = ~UnsignedInt{};
+constexpr UnsignedInt NoTriangle = ~UnsignedInt{};
+
+/* Scoring constants from the paper */
+constexpr Float LastTriangleScore = 0.75f;
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+
+Float vertexScore(const UnsignedInt cachePosition, const UnsignedInt liveTriangleCount, const std::size_t cacheSize) {
+    /* No triangles left, the vertex doesn't need to be considered anymore */
+    if(!liveTriangleCount) return -1.0f;
+
+    Float score = 0.0f;
+    if(cachePosition != NotInCache) {
+        /* Vertices of the last emitted triangle have fixed score so the
+           algorithm doesn't prefer using the triangle in the same direction */
+        if(cachePosition < 3) score = LastTriangleScore;
+        else if(cacheSize > 3)
+            score = std::pow(1.0f - Float(cachePosition - 3)/(cacheSize - 3), CacheDecayPower);
+    }
+
+    /* Boost vertices with only few triangles left so they don't stay
+       lonely for too long */
+    return score + ValenceBoostScale*std::pow(Float(liveTriangleCount), -ValenceBoostPower);
+}
+
+}
+
+void optimizeVertexCache(std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize) {
+    CORRADE_ASSERT(indices.size()%3 == 0,
+        "MeshTools::optimizeVertexCache(): index count is not divisible by 3", );
+    CORRADE_ASSERT(cacheSize >= 3,
+        "MeshTools::optimizeVertexCache(): cache size has to be at least 3", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCache(): index" << index << "out of bounds for" << vertexCount << "vertices", );
+    #endif
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count.
+       Live triangles of vertex v are kept at the beginning of its neighbor
+       range, emitted triangles are swapped to the end. */
+    std::vector<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::Tipsify(indices, vertexCount).buildAdjacency(liveTriangleCount, neighborOffset, neighbors);
+
+    /* Initial vertex and triangle scores */
+    const std::size_t triangleCount = indices.size()/3;
+    std::vector<UnsignedInt> cachePosition(vertexCount, NotInCache);
+    std::vector<Float> score(vertexCount);
+    for(UnsignedInt v = 0; v != vertexCount; ++v)
+        score[v] = vertexScore(NotInCache, liveTriangleCount[v], cacheSize);
+    std::vector<Float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount);
+    for(std::size_t t = 0; t != triangleCount; ++t)
+        triangleScore[t] = score[indices[t*3]] + score[indices[t*3 + 1]] + score[indices[t*3 + 2]];
+
+    /* Simulated LRU cache, most recent vertex first. The three extra slots are
+       for vertices of the newly added triangle before they get evicted. */
+    std::vector<UnsignedInt> cache, newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    /* Output index buffer */
+    std::vector<UnsignedInt> outputIndices;
+    outputIndices.reserve(indices.size());
+
+    /* Cursor for finding next triangle on dead-end */
+    std::size_t cursor = 0;
+
+    /* Start with the best triangle overall */
+    UnsignedInt best = NoTriangle;
+    for(std::size_t t = 0; t != triangleCount; ++t)
+        if(best == NoTriangle || triangleScore[t] > triangleScore[best]) best = t;
+
+    while(best != NoTriangle) {
+        /* Emit the triangle and remove it from the live triangle list of all
+           its vertices */
+        emitted[best] = true;
+        newCache.clear();
+        for(UnsignedInt vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[best*3 + vi];
+            outputIndices.push_back(v);
+
+            const UnsignedInt begin = neighborOffset[v];
+            const UnsignedInt end = begin + liveTriangleCount[v];
+            for(UnsignedInt ti = begin; ti != end; ++ti) if(neighbors[ti] == best) {
+                std::swap(neighbors[ti], neighbors[end - 1]);
+                break;
+            }
+            --liveTriangleCount[v];
+
+            /* Put the vertex at the front of the new cache, skipping
+               degenerate triangles */
+            if(std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+                newCache.push_back(v);
+        }
+
+        /* Move the rest of the old cache after the triangle vertices */
+        const std::size_t triangleVertexCount = newCache.size();
+        for(const UnsignedInt v: cache)
+            if(std::find(newCache.begin(), newCache.begin() + triangleVertexCount, v) == newCache.begin() + triangleVertexCount)
+                newCache.push_back(v);
+
+        /* Recalculate cache positions and scores for all vertices that were
+           in the cache, including the evicted ones */
+        for(std::size_t i = 0; i != newCache.size(); ++i)
+            cachePosition[newCache[i]] = i < cacheSize ? UnsignedInt(i) : NotInCache;
+        for(const UnsignedInt v: newCache)
+            score[v] = vertexScore(cachePosition[v], liveTriangleCount[v], cacheSize);
+
+        /* Update scores of live triangles touching affected vertices and pick
+           the best one of them for the next step */
+        best = NoTriangle;
+        Float bestScore = 0.0f;
+        for(const UnsignedInt v: newCache) {
+            const UnsignedInt begin = neighborOffset[v];
+            const UnsignedInt end = begin + liveTriangleCount[v];
+            for(UnsignedInt ti = begin; ti != end; ++ti) {
+                const UnsignedInt t = neighbors[ti];
+                triangleScore[t] = score[indices[t*3]] + score[indices[t*3 + 1]] + score[indices[t*3 + 2]];
+                if(best == NoTriangle || triangleScore[t] > bestScore) {
+                    best = t;
+                    bestScore = triangleScore[t];
+                }
+            }
+        }
+
+        /* Drop evicted vertices from the cache */
+        if(newCache.size() > cacheSize) newCache.resize(cacheSize);
+        using std::swap;
+        swap(cache, newCache);
+
+        /* On dead-end take the next not yet emitted triangle */
+        if(best == NoTriangle) {
+            while(cursor != triangleCount && emitted[cursor]) ++cursor;
+            if(cursor != triangleCount) best = cursor;
+        }
+    }
+
+    /* Swap original index buffer with optimized */
+    using std::swap;
+    swap(indices, outputIndices);
+}
+
+}}
@@ -0,0 +1,63 @@
+#ifndef Magnum_MeshTools_OptimizeVertexCache_h
+#define Magnum_MeshTools_OptimizeVertexCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexCache()
+ */
+
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for post-transform vertex cache
+@param[in,out] indices  Triangle index array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+
+Rearranges the index array for better usage of post-transform vertex cache.
+The greedy algorithm picks the next triangle based on how recently its
+vertices were used and how many unprocessed triangles are left for them.
+Algorithm used: *Tom Forsyth - Linear-Speed Vertex Cache Optimisation,
+https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+
+Compared to @ref tipsify() the result doesn't depend that much on the exact
+cache size, which makes it a good default if the target hardware is not known.
+Use @ref analyzeVertexCache() to pick the better one for particular mesh.
+Expects that the index count is
+divisible by 3 and all indices are smaller than @p vertexCount.
+@see @ref optimizeVertexFetch()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCache(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize = 32);
+
+}}
+
+#endif
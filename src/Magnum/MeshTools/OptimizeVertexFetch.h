@@ -0,0 +1,109 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexFetch()
+ */
+
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for vertex fetch
+@param[in,out] indices  Index array to operate on
+@param[in] vertexCount  Vertex count
+@return Remapping array
+
+Renumbers the vertices in order of their first use in the index array so the
+vertex data are fetched from memory as linearly as possible. Should be done
+after @ref tipsify() or @ref optimizeVertexCache(), as these change the order
+of indices. Vertices that are not referenced by any index are removed.
+
+Returned array contains for each new vertex index of the original vertex, so
+the vertex data can be reordered using @ref duplicate():
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+std::vector<UnsignedInt> remap = MeshTools::optimizeVertexFetch(indices, positions.size());
+positions = MeshTools::duplicate(remap, positions);
+normals = MeshTools::duplicate(remap, normals);
+@endcode
+
+See also @ref optimizeVertexFetch(std::vector<UnsignedInt>&, std::vector<T>&, std::vector<U>&...)
+which does the above in one step. Expects that all indices are smaller than
+@p vertexCount.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> optimizeVertexFetch(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Optimize the mesh for vertex fetch and reorder vertex data
+@param[in,out] indices      Index array to operate on
+@param[in,out] attribute    First vertex attribute array
+@param[in,out] attributes   Other vertex attribute arrays
+
+Convenience alternative to @ref optimizeVertexFetch(std::vector<UnsignedInt>&, UnsignedInt)
+which reorders all passed attribute arrays directly. Expects that all
+attribute arrays have the same size.
+*/
+template<class T, class ...U> void optimizeVertexFetch(std::vector<UnsignedInt>& indices, std::vector<T>& attribute, std::vector<U>&... attributes);
+
+namespace Implementation {
+
+template<class T> inline void reorderVertices(const std::vector<UnsignedInt>& remap, std::vector<T>& attribute) {
+    attribute = duplicate(remap, attribute);
+}
+
+template<class T, class ...U> inline void reorderVertices(const std::vector<UnsignedInt>& remap, std::vector<T>& attribute, std::vector<U>&... attributes) {
+    reorderVertices(remap, attribute);
+    reorderVertices(remap, attributes...);
+}
+
+inline bool sameVertexCount(std::size_t) { return true; }
+
+template<class T, class ...U> inline bool sameVertexCount(const std::size_t vertexCount, const std::vector<T>& attribute, const std::vector<U>&... attributes) {
+    return attribute.size() == vertexCount && sameVertexCount(vertexCount, attributes...);
+}
+
+}
+
+template<class T, class ...U> void optimizeVertexFetch(std::vector<UnsignedInt>& indices, std::vector<T>& attribute, std::vector<U>&... attributes) {
+    CORRADE_ASSERT(Implementation::sameVertexCount(attribute.size(), attributes...),
+        "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same size", );
+    Implementation::reorderVertices(optimizeVertexFetch(indices, attribute.size()), attribute, attributes...);
+}
+
+}}
+
+#endif
@@ -31,9 +31,8 @@
 
 #include <limits>
 #include <numeric>
-#include <unordered_map>
 #include <vector>
-#include <Corrade/Utility/MurmurHash2.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Functions.h"
@@ -44,7 +43,12 @@ namespace Implementation {
     template<std::size_t size> class VectorHash {
         public:
             std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
-                return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+                /* Multiplicative mixing of all components, the high bits are
+                   folded back as the table index is taken from the low ones */
+                unsigned long long hash = 0;
+                for(std::size_t i = 0; i != size; ++i)
+                    hash = (hash ^ data[i])*0x9e3779b97f4a7c15ull;
+                return std::size_t(hash ^ (hash >> 29));
             }
     };
 }
@@ -93,6 +97,11 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 @endcode
 */
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    typedef Math::Vector<Vector::Size, std::size_t> Key;
+    constexpr UnsignedInt Empty = ~UnsignedInt{};
+
+    if(data.empty()) return {};
+
     /* Get bounds */
     Vector min = data[0], max = data[0];
     for(const auto& v: data) {
@@ -108,36 +117,51 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
     std::vector<UnsignedInt> resultIndices(data.size());
     std::iota(resultIndices.begin(), resultIndices.end(), 0);
 
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
-    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, Implementation::VectorHash<Vector::Size>> table(data.size());
+    /* Open-addressing table with linear probing, containing index of the
+       unique vector for each discretized vector. The discretized keys are not
+       stored, they are recalculated from the already compacted part of the
+       data array instead. */
+    std::vector<UnsignedInt> table;
+    const Implementation::VectorHash<Vector::Size> hash;
 
-    /* Index array for each pass, new data array */
-    std::vector<UnsignedInt> indices;
-    indices.reserve(data.size());
+    /* Index array for each pass */
+    std::vector<UnsignedInt> indices(data.size());
 
     /* First go with original coordinates, then move them by epsilon/2 in each
        direction. */
     Vector moved;
     for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
+        /* Keep the table at most half full so the probe sequences are short */
+        std::size_t slotCount = 16;
+        while(slotCount < 2*data.size()) slotCount <<= 1;
+        const std::size_t mask = slotCount - 1;
+        table.assign(slotCount, Empty);
+
         /* Go through all vectors */
+        UnsignedInt uniqueCount = 0;
         for(std::size_t i = 0; i != data.size(); ++i) {
-            /* Try to insert new vertex to the table */
-            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
-            const auto result = table.emplace(v, table.size());
+            const Key v((data[i] + moved - min)/epsilon);
 
-            /* Add the (either new or already existing) index to index array */
-            indices.push_back(result.first->second);
+            /* Find the vector in the table or an empty slot for it */
+            std::size_t slot = hash(v) & mask;
+            UnsignedInt index;
+            while((index = table[slot]) != Empty && Key((data[index] + moved - min)/epsilon) != v)
+                slot = (slot + 1) & mask;
 
             /* If this is new combination, copy the data to new (earlier)
-               possition in the array */
-            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
+               position in the array */
+            if(index == Empty) {
+                index = table[slot] = uniqueCount++;
+                if(i != index) data[index] = data[i];
+            }
+
+            /* Add the (either new or already existing) index to index array */
+            indices[i] = index;
         }
 
         /* Shrink the data array */
-        CORRADE_INTERNAL_ASSERT(data.size() >= table.size());
-        data.resize(table.size());
+        CORRADE_INTERNAL_ASSERT(data.size() >= uniqueCount);
+        data.resize(uniqueCount);
 
         /* Remap the resulting index array */
         for(auto& i: resultIndices) i = indices[i];
@@ -148,10 +172,6 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
         /* Move vertex coordinates by epsilon/2 in next direction */
         moved = Vector();
         moved[moving] = epsilon/2;
-
-        /* Clear the structures for next pass */
-        table.clear();
-        indices.clear();
     }
 
     return resultIndices;
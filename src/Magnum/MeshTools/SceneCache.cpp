@@ -0,0 +1,274 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SceneCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/FlatSceneData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* 64-bit FNV-1a, used only to find candidates, equality is then verified on
+   the actual data */
+class Hasher {
+    public:
+        void add(const void* const data, const std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for(std::size_t i = 0; i != size; ++i)
+                _hash = (_hash ^ bytes[i])*1099511628211ull;
+        }
+
+        template<class T> void add(const T& value) { add(&value, sizeof(T)); }
+
+        template<class T> void add(const std::vector<T>& values) {
+            add(values.size());
+            add(values.data(), values.size()*sizeof(T));
+        }
+
+        std::size_t hash() const { return std::size_t(_hash); }
+
+    private:
+        unsigned long long _hash = 14695981039346656037ull;
+};
+
+/* Bitwise, as the data are either copies of each other or not */
+template<class T> bool equal(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()*sizeof(T)) == 0);
+}
+
+std::size_t hash(const Trade::MeshData3D& mesh) {
+    Hasher hasher;
+    hasher.add(mesh.primitive());
+    hasher.add(mesh.indices());
+    hasher.add(mesh.positionArrayCount());
+    for(UnsignedInt i = 0; i != mesh.positionArrayCount(); ++i)
+        hasher.add(mesh.positions(i));
+    hasher.add(mesh.normalArrayCount());
+    for(UnsignedInt i = 0; i != mesh.normalArrayCount(); ++i)
+        hasher.add(mesh.normals(i));
+    hasher.add(mesh.textureCoords2DArrayCount());
+    for(UnsignedInt i = 0; i != mesh.textureCoords2DArrayCount(); ++i)
+        hasher.add(mesh.textureCoords2D(i));
+    if(mesh.hasJoints()) {
+        hasher.add(mesh.jointIds());
+        hasher.add(mesh.jointWeights());
+    }
+    return hasher.hash();
+}
+
+bool equal(const Trade::MeshData3D& a, const Trade::MeshData3D& b) {
+    if(a.primitive() != b.primitive() ||
+       a.positionArrayCount() != b.positionArrayCount() ||
+       a.normalArrayCount() != b.normalArrayCount() ||
+       a.textureCoords2DArrayCount() != b.textureCoords2DArrayCount() ||
+       a.hasJoints() != b.hasJoints() ||
+       !equal(a.indices(), b.indices())) return false;
+
+    for(UnsignedInt i = 0; i != a.positionArrayCount(); ++i)
+        if(!equal(a.positions(i), b.positions(i))) return false;
+    for(UnsignedInt i = 0; i != a.normalArrayCount(); ++i)
+        if(!equal(a.normals(i), b.normals(i))) return false;
+    for(UnsignedInt i = 0; i != a.textureCoords2DArrayCount(); ++i)
+        if(!equal(a.textureCoords2D(i), b.textureCoords2D(i))) return false;
+    return !a.hasJoints() || (equal(a.jointIds(), b.jointIds()) && equal(a.jointWeights(), b.jointWeights()));
+}
+
+std::size_t hash(const Trade::ImageData2D& image) {
+    Hasher hasher;
+    hasher.add(image.isCompressed());
+    if(image.isCompressed()) hasher.add(image.compressedFormat());
+    else {
+        hasher.add(image.format());
+        hasher.add(image.type());
+    }
+    hasher.add(image.size());
+    hasher.add(image.data().size());
+    hasher.add(image.data().data(), image.data().size());
+    return hasher.hash();
+}
+
+bool equal(const Trade::ImageData2D& a, const Trade::ImageData2D& b) {
+    if(a.isCompressed() != b.isCompressed() || a.size() != b.size() || a.data().size() != b.data().size()) return false;
+    if(a.isCompressed() ? a.compressedFormat() != b.compressedFormat() :
+        (a.format() != b.format() || a.type() != b.type())) return false;
+    return std::memcmp(a.data().data(), b.data().data(), a.data().size()) == 0;
+}
+
+/* The image ID is replaced with the canonical one before hashing */
+std::size_t hash(const Trade::TextureData& texture, const UnsignedInt image) {
+    Hasher hasher;
+    hasher.add(texture.type());
+    hasher.add(texture.minificationFilter());
+    hasher.add(texture.magnificationFilter());
+    hasher.add(texture.mipmapFilter());
+    hasher.add(texture.wrapping());
+    hasher.add(image);
+    return hasher.hash();
+}
+
+bool equal(const Trade::TextureData& a, const Trade::TextureData& b) {
+    return a.type() == b.type() &&
+        a.minificationFilter() == b.minificationFilter() &&
+        a.magnificationFilter() == b.magnificationFilter() &&
+        a.mipmapFilter() == b.mipmapFilter() &&
+        a.wrapping() == b.wrapping();
+}
+
+}
+
+SceneCache::SceneCache(Trade::AbstractImporter& importer, std::string keyPrefix): _importer(importer), _keyPrefix{std::move(keyPrefix)}, _duplicateCount{} {
+    CORRADE_ASSERT(importer.isOpened(), "MeshTools::SceneCache: the importer is not opened", );
+
+    _meshIds.assign(importer.mesh3DCount(), NotImported);
+    _imageIds.assign(importer.image2DCount(), NotImported);
+    _textureIds.assign(importer.textureCount(), NotImported);
+    _meshes.resize(_meshIds.size());
+    _images.resize(_imageIds.size());
+    _textures.resize(_textureIds.size());
+}
+
+Int SceneCache::mesh3D(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _meshIds.size(),
+        "MeshTools::SceneCache::mesh3D(): index" << id << "out of range for" << _meshIds.size() << "meshes", -1);
+    if(_meshIds[id] != NotImported) return _meshIds[id];
+
+    std::optional<Trade::MeshData3D> mesh = _importer.mesh3D(id);
+    if(!mesh) return _meshIds[id] = -1;
+
+    const std::size_t contentHash = hash(*mesh);
+    auto candidates = _meshHashes.equal_range(contentHash);
+    for(auto it = candidates.first; it != candidates.second; ++it) if(equal(*_meshes[it->second], *mesh)) {
+        ++_duplicateCount;
+        return _meshIds[id] = it->second;
+    }
+
+    _meshHashes.emplace(contentHash, id);
+    _meshes[id] = std::move(mesh);
+    return _meshIds[id] = id;
+}
+
+Int SceneCache::image2D(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _imageIds.size(),
+        "MeshTools::SceneCache::image2D(): index" << id << "out of range for" << _imageIds.size() << "images", -1);
+    if(_imageIds[id] != NotImported) return _imageIds[id];
+
+    std::optional<Trade::ImageData2D> image = _importer.image2D(id);
+    if(!image) return _imageIds[id] = -1;
+
+    const std::size_t contentHash = hash(*image);
+    auto candidates = _imageHashes.equal_range(contentHash);
+    for(auto it = candidates.first; it != candidates.second; ++it) if(equal(*_images[it->second], *image)) {
+        ++_duplicateCount;
+        return _imageIds[id] = it->second;
+    }
+
+    _imageHashes.emplace(contentHash, id);
+    _images[id] = std::move(image);
+    return _imageIds[id] = id;
+}
+
+Int SceneCache::texture(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _textureIds.size(),
+        "MeshTools::SceneCache::texture(): index" << id << "out of range for" << _textureIds.size() << "textures", -1);
+    if(_textureIds[id] != NotImported) return _textureIds[id];
+
+    std::optional<Trade::TextureData> texture = _importer.texture(id);
+    if(!texture || texture->image() >= _imageIds.size()) return _textureIds[id] = -1;
+
+    const Int image = image2D(texture->image());
+    if(image == -1) return _textureIds[id] = -1;
+
+    const std::size_t contentHash = hash(*texture, image);
+    auto candidates = _textureHashes.equal_range(contentHash);
+    for(auto it = candidates.first; it != candidates.second; ++it)
+        if(equal(*_textures[it->second], *texture) && _imageIds[_textures[it->second]->image()] == image) {
+            ++_duplicateCount;
+            return _textureIds[id] = it->second;
+        }
+
+    _textureHashes.emplace(contentHash, id);
+    _textures[id] = std::move(texture);
+    return _textureIds[id] = id;
+}
+
+const Trade::MeshData3D& SceneCache::mesh3DData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _meshes.size() && _meshes[id],
+        "MeshTools::SceneCache::mesh3DData(): mesh" << id << "is not imported or not canonical", *_meshes[0]);
+    return *_meshes[id];
+}
+
+const Trade::ImageData2D& SceneCache::image2DData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _images.size() && _images[id],
+        "MeshTools::SceneCache::image2DData(): image" << id << "is not imported or not canonical", *_images[0]);
+    return *_images[id];
+}
+
+const Trade::TextureData& SceneCache::textureData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size() && _textures[id],
+        "MeshTools::SceneCache::textureData(): texture" << id << "is not imported or not canonical", *_textures[0]);
+    return *_textures[id];
+}
+
+std::vector<SceneCache::InstanceGroup> SceneCache::instanceGroups(const Trade::FlatSceneData3D& scene) {
+    std::vector<InstanceGroup> groups;
+    std::unordered_map<unsigned long long, std::size_t> groupForKey;
+    for(std::size_t i = 0; i != scene.size(); ++i) {
+        if(scene.instanceTypes()[i] != Trade::ObjectInstanceType3D::Mesh ||
+           UnsignedInt(scene.instances()[i]) >= _meshIds.size()) continue;
+
+        const Int mesh = mesh3D(scene.instances()[i]);
+        if(mesh == -1) continue;
+
+        const Int material = scene.materials()[i];
+        const unsigned long long key = (static_cast<unsigned long long>(mesh) << 32)|UnsignedInt(material);
+        auto found = groupForKey.emplace(key, groups.size());
+        if(found.second) groups.push_back({UnsignedInt(mesh), material, {}});
+        groups[found.first->second].objects.push_back(i);
+    }
+
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const InstanceGroup& group) {
+        return group.objects.size() < 2;
+    }), groups.end());
+    return groups;
+}
+
+std::string SceneCache::key(const char* const type, const UnsignedInt id, const char* const suffix) const {
+    return _keyPrefix + type + '/' + std::to_string(id) + suffix;
+}
+
+ResourceKey SceneCache::meshKey(const UnsignedInt id) {
+    /* Failed imports get their own key, so they're just not found in the
+       manager */
+    const Int canonical = mesh3D(id);
+    return key("mesh3D", canonical == -1 ? id : canonical, "");
+}
+
+}}
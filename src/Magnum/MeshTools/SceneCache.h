@@ -0,0 +1,237 @@
+#ifndef Magnum_MeshTools_SceneCache_h
+#define Magnum_MeshTools_SceneCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::SceneCache
+ */
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/ResourceManager.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/TextureData.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Deduplicating cache of imported scene data
+
+Scenes often reference the same mesh, texture or image from many objects and
+files exported by some tools contain the same data several times under
+different IDs. The cache imports each mesh, texture and image from given
+importer only once and additionally maps IDs with identical content to a
+single *canonical* ID, found by comparing content hashes and then the data
+itself:
+@code
+MeshTools::SceneCache cache{importer, "level1/"};
+std::optional<Trade::FlatSceneData3D> scene = importer.flatScene3D(0);
+
+// Compile each unique mesh only once
+ResourceManager<Buffer, Mesh> manager;
+cache.compile(manager, BufferUsage::StaticDraw);
+
+for(std::size_t i = 0; i != scene->size(); ++i) {
+    if(scene->instanceTypes()[i] != Trade::ObjectInstanceType3D::Mesh) continue;
+    Resource<Mesh> mesh = manager.get<Mesh>(cache.meshKey(scene->instances()[i]));
+    // ...
+}
+@endcode
+
+Objects using the same canonical mesh with the same material are candidates
+for instanced drawing, @ref instanceGroups() lists them.
+
+The importer has to stay opened for the whole lifetime of the cache.
+*/
+class MAGNUM_MESHTOOLS_EXPORT SceneCache {
+    public:
+        /** @brief Group of objects that can be drawn instanced */
+        struct InstanceGroup {
+            UnsignedInt mesh;   /**< @brief Canonical mesh ID */
+            Int material;       /**< @brief Material ID or `-1` */
+
+            /** @brief Object indices in the flattened scene */
+            std::vector<UnsignedInt> objects;
+        };
+
+        /**
+         * @brief Constructor
+         * @param importer      Opened importer
+         * @param keyPrefix     Prefix for resource keys, should be unique
+         *      for each file put into the same @ref ResourceManager
+         */
+        explicit SceneCache(Trade::AbstractImporter& importer, std::string keyPrefix = {});
+
+        /** @brief Copying is not allowed */
+        SceneCache(const SceneCache&) = delete;
+
+        /** @brief Copying is not allowed */
+        SceneCache& operator=(const SceneCache&) = delete;
+
+        /**
+         * @brief Count of imports that turned out to be duplicates
+         *
+         * Count of meshes, textures and images that had the same content
+         * as some already imported data and thus were mapped to it.
+         */
+        UnsignedInt duplicateCount() const { return _duplicateCount; }
+
+        /**
+         * @brief Canonical mesh ID
+         *
+         * Imports the mesh if it wasn't imported already and returns ID of
+         * the first mesh with the same content. Returns `-1` if the import
+         * failed.
+         */
+        Int mesh3D(UnsignedInt id);
+
+        /**
+         * @brief Canonical image ID
+         *
+         * Imports the image if it wasn't imported already and returns ID of
+         * the first image with the same content. Returns `-1` if the import
+         * failed.
+         */
+        Int image2D(UnsignedInt id);
+
+        /**
+         * @brief Canonical texture ID
+         *
+         * Imports the texture if it wasn't imported already and returns ID
+         * of the first texture with the same sampler parameters, referencing
+         * the same canonical image. Returns `-1` if the import of the texture
+         * or its image failed.
+         */
+        Int texture(UnsignedInt id);
+
+        /**
+         * @brief Mesh data
+         *
+         * Expects that the mesh was successfully imported using
+         * @ref mesh3D() and @p id is its canonical ID.
+         */
+        const Trade::MeshData3D& mesh3DData(UnsignedInt id) const;
+
+        /**
+         * @brief Image data
+         *
+         * Expects that the image was successfully imported using
+         * @ref image2D() and @p id is its canonical ID.
+         */
+        const Trade::ImageData2D& image2DData(UnsignedInt id) const;
+
+        /**
+         * @brief Texture data
+         *
+         * Expects that the texture was successfully imported using
+         * @ref texture() and @p id is its canonical ID. Note that
+         * @ref Trade::TextureData::image() is the original image ID, use
+         * @ref image2D() to get the canonical one.
+         */
+        const Trade::TextureData& textureData(UnsignedInt id) const;
+
+        /**
+         * @brief Instance groups
+         *
+         * Imports all meshes referenced by @p scene and groups the objects
+         * by canonical mesh and material. Only groups with more than one
+         * object are returned, in order of their first object.
+         */
+        std::vector<InstanceGroup> instanceGroups(const Trade::FlatSceneData3D& scene);
+
+        /**
+         * @brief Resource key for given mesh
+         *
+         * Meshes with the same content get the same key. The vertex and
+         * index buffer get the key suffixed with `/vertices` and `/indices`.
+         * @see @ref compile()
+         */
+        ResourceKey meshKey(UnsignedInt id);
+
+        /**
+         * @brief Compile imported meshes into a resource manager
+         * @return Count of newly compiled meshes
+         *
+         * Compiles each canonical mesh imported so far using
+         * @ref MeshTools::compile(const Trade::MeshData3D&, BufferUsage) and
+         * puts the mesh and its buffers into @p manager under
+         * @ref meshKey(). Meshes already present in the manager are
+         * skipped, thus repeated calls compile only the newly imported
+         * ones.
+         */
+        template<class ...Types> std::size_t compile(ResourceManager<Types...>& manager, BufferUsage usage, ResourcePolicy policy = ResourcePolicy::Resident);
+
+    private:
+        enum: Int { NotImported = -2 };
+
+        std::string key(const char* type, UnsignedInt id, const char* suffix) const;
+
+        Trade::AbstractImporter& _importer;
+        std::string _keyPrefix;
+        UnsignedInt _duplicateCount;
+
+        /* Canonical ID for each ID, -1 if the import failed */
+        std::vector<Int> _meshIds, _imageIds, _textureIds;
+
+        /* Data for canonical IDs, content hash mapping to candidates */
+        std::vector<std::optional<Trade::MeshData3D>> _meshes;
+        std::vector<std::optional<Trade::ImageData2D>> _images;
+        std::vector<std::optional<Trade::TextureData>> _textures;
+        std::unordered_multimap<std::size_t, UnsignedInt> _meshHashes, _imageHashes, _textureHashes;
+};
+
+template<class ...Types> std::size_t SceneCache::compile(ResourceManager<Types...>& manager, const BufferUsage usage, const ResourcePolicy policy) {
+    std::size_t count = 0;
+    for(UnsignedInt i = 0; i != _meshes.size(); ++i) {
+        if(!_meshes[i] || manager.template state<Mesh>(meshKey(i)) != ResourceState::NotLoaded) continue;
+
+        Mesh mesh{NoCreate};
+        std::unique_ptr<Buffer> vertices, indices;
+        std::tie(mesh, vertices, indices) = MeshTools::compile(*_meshes[i], usage);
+
+        manager.set(key("mesh3D", i, "/vertices"), vertices.release(), ResourceDataState::Final, policy);
+        if(indices) manager.set(key("mesh3D", i, "/indices"), indices.release(), ResourceDataState::Final, policy);
+        manager.set(meshKey(i), new Mesh{std::move(mesh)}, ResourceDataState::Final, policy);
+        ++count;
+    }
+
+    return count;
+}
+
+}}
+
+#endif
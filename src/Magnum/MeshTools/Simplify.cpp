@@ -0,0 +1,333 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix of the quadric, only the upper triangle is stored */
+struct Quadric {
+    Float a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+
+    Quadric& operator+=(const Quadric& other) {
+        a2 += other.a2; b2 += other.b2; c2 += other.c2;
+        ab += other.ab; ac += other.ac; bc += other.bc;
+        ad += other.ad; bd += other.bd; cd += other.cd;
+        d2 += other.d2;
+        return *this;
+    }
+
+    Quadric operator+(const Quadric& other) const {
+        return Quadric(*this) += other;
+    }
+
+    /* Weighted squared distance of the point from all accumulated planes */
+    Float operator()(const Vector3& p) const {
+        const Float x = p.x(), y = p.y(), z = p.z();
+        return Math::max(0.0f,
+            x*x*a2 + y*y*b2 + z*z*c2 +
+            2.0f*(x*y*ab + x*z*ac + y*z*bc) +
+            2.0f*(x*ad + y*bd + z*cd) + d2);
+    }
+};
+
+/* Quadric of a plane with given unit normal going through given point */
+Quadric planeQuadric(const Vector3& n, const Vector3& point, const Float weight) {
+    const Float d = -Math::dot(n, point);
+    return {
+        weight*n.x()*n.x(), weight*n.y()*n.y(), weight*n.z()*n.z(),
+        weight*n.x()*n.y(), weight*n.x()*n.z(), weight*n.y()*n.z(),
+        weight*n.x()*d, weight*n.y()*d, weight*n.z()*d,
+        weight*d*d};
+}
+
+Vector3 triangleNormal(const Vector3& a, const Vector3& b, const Vector3& c) {
+    return Math::cross(c - b, a - b);
+}
+
+/* Relative weight of attribute differences, difference of 1.0 is
+   equivalent to 1% of mesh size */
+constexpr Float AttributeWeight = 0.0001f;
+
+struct Collapse {
+    Float error;
+    UnsignedInt from, to;
+
+    bool operator<(const Collapse& other) const { return error < other.error; }
+};
+
+}
+
+Float simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates) {
+    CORRADE_ASSERT(indices.size()%3 == 0,
+        "MeshTools::simplify(): index count is not divisible by 3", {});
+    CORRADE_ASSERT((normals.empty() || normals.size() == positions.size()) &&
+                   (textureCoordinates.empty() || textureCoordinates.size() == positions.size()),
+        "MeshTools::simplify(): attribute arrays don't have the same size as positions", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::simplify(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+    #endif
+
+    if(indices.size() <= targetIndexCount || positions.empty()) return 0.0f;
+
+    const UnsignedInt vertexCount = positions.size();
+
+    /* Positions normalized to a unit cube so the error is relative to mesh
+       size */
+    Vector3 min = positions[0], max = positions[0];
+    for(const Vector3& p: positions) {
+        min = Math::min(min, p);
+        max = Math::max(max, p);
+    }
+    const Float extent = (max - min).max();
+    const Float scale = extent > 0.0f ? 1.0f/extent : 1.0f;
+    std::vector<Vector3> scaled;
+    scaled.reserve(vertexCount);
+    for(const Vector3& p: positions) scaled.push_back((p - min)*scale);
+
+    /* Group vertices with the same position. If all vertices in the group
+       have the same attributes, they are welded together, otherwise the
+       group is an attribute seam and gets locked. */
+    std::vector<UnsignedInt> sorted(vertexCount);
+    for(UnsignedInt i = 0; i != vertexCount; ++i) sorted[i] = i;
+    std::sort(sorted.begin(), sorted.end(), [&positions](UnsignedInt a, UnsignedInt b) {
+        const Vector3& pa = positions[a];
+        const Vector3& pb = positions[b];
+        if(pa.x() != pb.x()) return pa.x() < pb.x();
+        if(pa.y() != pb.y()) return pa.y() < pb.y();
+        if(pa.z() != pb.z()) return pa.z() < pb.z();
+        return a < b;
+    });
+    std::vector<UnsignedInt> weld(vertexCount);
+    std::vector<bool> locked(vertexCount);
+    for(std::size_t begin = 0, end; begin != vertexCount; begin = end) {
+        const UnsignedInt first = sorted[begin];
+        bool seam = false;
+        for(end = begin; end != vertexCount && positions[sorted[end]] == positions[first]; ++end) {
+            const UnsignedInt v = sorted[end];
+            if((!normals.empty() && normals[v] != normals[first]) ||
+               (!textureCoordinates.empty() && textureCoordinates[v] != textureCoordinates[first]))
+                seam = true;
+        }
+        for(std::size_t i = begin; i != end; ++i) {
+            weld[sorted[i]] = seam ? sorted[i] : first;
+            locked[sorted[i]] = seam;
+        }
+    }
+    for(UnsignedInt& index: indices) index = weld[index];
+
+    /* Lock vertices on border edges, i.e. edges that are used only by one
+       triangle */
+    {
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> edges;
+        edges.reserve(indices.size());
+        for(std::size_t i = 0; i != indices.size(); i += 3) for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i + j], b = indices[i + (j + 1)%3];
+            edges.emplace_back(Math::min(a, b), Math::max(a, b));
+        }
+        std::sort(edges.begin(), edges.end());
+        for(std::size_t begin = 0, end; begin != edges.size(); begin = end) {
+            for(end = begin + 1; end != edges.size() && edges[end] == edges[begin]; ++end);
+            if(end - begin == 1) locked[edges[begin].first] = locked[edges[begin].second] = true;
+        }
+    }
+
+    /* Quadric for each vertex, sum of planes of all adjacent triangles
+       weighted by their area */
+    std::vector<Quadric> quadrics(vertexCount, Quadric{});
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3 normal = triangleNormal(scaled[indices[i]], scaled[indices[i + 1]], scaled[indices[i + 2]]);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+
+        const Quadric q = planeQuadric(normal/length, scaled[indices[i]], length*0.5f);
+        for(std::size_t j = 0; j != 3; ++j) quadrics[indices[i + j]] += q;
+    }
+
+    auto attributeError = [&normals, &textureCoordinates](const UnsignedInt from, const UnsignedInt to) {
+        Float error = 0.0f;
+        if(!normals.empty()) error += (normals[from] - normals[to]).dot();
+        if(!textureCoordinates.empty()) error += (textureCoordinates[from] - textureCoordinates[to]).dot();
+        return error*AttributeWeight;
+    };
+
+    const Float targetErrorSquared = targetError*targetError;
+    Float resultErrorSquared = 0.0f;
+    std::vector<UnsignedInt> triangleCount, neighborOffset, neighbors;
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched(vertexCount);
+    std::vector<UnsignedInt> remap(vertexCount);
+
+    /* Each pass collapses a set of edges with non-overlapping neighborhoods,
+       in order of increasing error */
+    while(indices.size() > targetIndexCount) {
+        Implementation::Tipsify(indices, vertexCount).buildAdjacency(triangleCount, neighborOffset, neighbors);
+
+        /* Cheaper direction of each edge. Every interior edge is in two
+           triangles in opposite directions, so taking only one direction
+           lists each of them once. */
+        collapses.clear();
+        for(std::size_t i = 0; i != indices.size(); i += 3) for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i + j], b = indices[i + (j + 1)%3];
+            if(a >= b || (locked[a] && locked[b])) continue;
+
+            const Quadric q = quadrics[a] + quadrics[b];
+            const Float errorAB = locked[a] ? Constants::inf() : q(scaled[b]) + attributeError(a, b);
+            const Float errorBA = locked[b] ? Constants::inf() : q(scaled[a]) + attributeError(b, a);
+            if(errorAB <= errorBA) collapses.push_back({errorAB, a, b});
+            else collapses.push_back({errorBA, b, a});
+        }
+        std::sort(collapses.begin(), collapses.end());
+
+        std::fill(touched.begin(), touched.end(), false);
+        for(UnsignedInt i = 0; i != vertexCount; ++i) remap[i] = i;
+        std::size_t indexCount = indices.size();
+        std::size_t collapsed = 0;
+        for(const Collapse& collapse: collapses) {
+            if(indexCount <= targetIndexCount || collapse.error > targetErrorSquared) break;
+
+            const UnsignedInt from = collapse.from, to = collapse.to;
+            if(touched[from] || touched[to]) continue;
+
+            /* Reject the collapse if it would flip any triangle, count the
+               triangles that would get removed */
+            bool flipped = false;
+            std::size_t removed = 0;
+            for(UnsignedInt ti = neighborOffset[from]; ti != neighborOffset[from + 1]; ++ti) {
+                const UnsignedInt* const t = indices.data() + neighbors[ti]*3;
+                if(t[0] == to || t[1] == to || t[2] == to) {
+                    ++removed;
+                    continue;
+                }
+
+                const Vector3 before = triangleNormal(scaled[t[0]], scaled[t[1]], scaled[t[2]]);
+                const Vector3 after = triangleNormal(
+                    scaled[t[0] == from ? to : t[0]],
+                    scaled[t[1] == from ? to : t[1]],
+                    scaled[t[2] == from ? to : t[2]]);
+                if(Math::dot(before, after) <= 0.0f) {
+                    flipped = true;
+                    break;
+                }
+            }
+            if(flipped) continue;
+
+            /* Lock the whole neighborhood for this pass so the adjacency
+               stays valid */
+            for(UnsignedInt ti = neighborOffset[from]; ti != neighborOffset[from + 1]; ++ti)
+                for(std::size_t j = 0; j != 3; ++j) touched[indices[neighbors[ti]*3 + j]] = true;
+
+            remap[from] = to;
+            quadrics[to] += quadrics[from];
+            resultErrorSquared = Math::max(resultErrorSquared, collapse.error);
+            indexCount -= removed*3;
+            ++collapsed;
+        }
+
+        if(!collapsed) break;
+
+        /* Apply the collapses and remove degenerate triangles */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            const UnsignedInt a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+            if(a == b || a == c || b == c) continue;
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+        indices.resize(out);
+    }
+
+    return std::sqrt(resultErrorSquared);
+}
+
+std::vector<LodLevel> generateLods(const Trade::MeshData3D& meshData, const UnsignedInt levelCount, const Float triangleRatio, const Float maxError) {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles && meshData.isIndexed(),
+        "MeshTools::generateLods(): expected indexed triangle mesh", {});
+
+    std::vector<LodLevel> levels;
+    if(!levelCount) return levels;
+
+    /* Copy of all the data for the first level */
+    {
+        std::vector<std::vector<Vector3>> positions, normals;
+        std::vector<std::vector<Vector2>> textureCoords2D;
+        for(UnsignedInt i = 0; i != meshData.positionArrayCount(); ++i)
+            positions.push_back(meshData.positions(i));
+        for(UnsignedInt i = 0; i != meshData.normalArrayCount(); ++i)
+            normals.push_back(meshData.normals(i));
+        for(UnsignedInt i = 0; i != meshData.textureCoords2DArrayCount(); ++i)
+            textureCoords2D.push_back(meshData.textureCoords2D(i));
+        levels.push_back({Trade::MeshData3D{MeshPrimitive::Triangles, meshData.indices(), std::move(positions), std::move(normals), std::move(textureCoords2D)}, 0.0f});
+    }
+
+    while(levels.size() < levelCount) {
+        const Trade::MeshData3D& previous = levels.back().mesh;
+        const Float previousError = levels.back().error;
+
+        /* The errors add up, so each level gets only what's left */
+        std::vector<UnsignedInt> indices = previous.indices();
+        const std::size_t targetIndexCount = std::size_t(indices.size()/3*triangleRatio)*3;
+        const Float error = simplify(indices, previous.positions(0), targetIndexCount, maxError - previousError,
+            previous.hasNormals() ? previous.normals(0) : std::vector<Vector3>{},
+            previous.hasTextureCoords2D() ? previous.textureCoords2D(0) : std::vector<Vector2>{});
+
+        /* Stop if the mesh can't be simplified any further */
+        if(indices.size() == previous.indices().size() || indices.empty()) break;
+
+        /* Remove unreferenced vertex data */
+        const std::vector<UnsignedInt> remap = optimizeVertexFetch(indices, previous.positions(0).size());
+        std::vector<std::vector<Vector3>> positions, normals;
+        std::vector<std::vector<Vector2>> textureCoords2D;
+        for(UnsignedInt i = 0; i != previous.positionArrayCount(); ++i)
+            positions.push_back(duplicate(remap, previous.positions(i)));
+        for(UnsignedInt i = 0; i != previous.normalArrayCount(); ++i)
+            normals.push_back(duplicate(remap, previous.normals(i)));
+        for(UnsignedInt i = 0; i != previous.textureCoords2DArrayCount(); ++i)
+            textureCoords2D.push_back(duplicate(remap, previous.textureCoords2D(i)));
+
+        levels.push_back({Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), std::move(positions), std::move(normals), std::move(textureCoords2D)}, previousError + error});
+    }
+
+    return levels;
+}
+
+}}
@@ -0,0 +1,136 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLods(), struct @ref Magnum::MeshTools::LodLevel
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify the mesh
+@param[in,out] indices          Triangle index array to operate on
+@param[in] positions            Vertex positions
+@param[in] targetIndexCount     Target index count
+@param[in] targetError          Max allowed error, relative to mesh size
+@param[in] normals              Vertex normals or empty array
+@param[in] textureCoordinates   Vertex texture coordinates or empty array
+@return Resulting error, relative to mesh size
+
+Reduces the triangle count by collapsing edges in order given by quadric
+error metric, until the index count is not larger than @p targetIndexCount
+or until the next collapse would cause larger error than @p targetError.
+Algorithm used: *Michael Garland, Paul S. Heckbert --- Surface
+Simplification Using Quadric Error Metrics, SIGGRAPH 1997*. The error is
+an approximate distance of the simplified surface from the original,
+relative to the largest dimension of the mesh bounding box, so e.g. value of
+`0.01f` means one percent of the mesh size.
+
+Edges are always collapsed to one of their endpoints, so no new vertices are
+created and the vertex data don't need to be modified --- only the index
+array changes, unreferenced vertices can be removed afterwards with
+@ref optimizeVertexFetch(). To preserve the appearance:
+
+-   vertices on mesh borders and vertices on attribute seams (i.e., multiple
+    vertices sharing the same position but having different normals or
+    texture coordinates) are never moved,
+-   collapses that would flip orientation of any triangle are rejected,
+-   if @p normals or @p textureCoordinates are specified, their squared
+    difference between the collapsed vertex and the one it collapses to is
+    added to the error, so the collapses are done preferrably in areas with
+    smooth normals and small texture distortion.
+
+Expects that the index count is divisible by 3, all indices are in bounds of
+@p positions and attribute arrays, if not empty, have the same size as
+@p positions.
+@see @ref generateLods()
+*/
+MAGNUM_MESHTOOLS_EXPORT Float simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf(), const std::vector<Vector3>& normals = {}, const std::vector<Vector2>& textureCoordinates = {});
+
+/**
+@brief Level of detail
+
+@see @ref generateLods()
+*/
+struct LodLevel {
+    /** @brief Mesh data */
+    Trade::MeshData3D mesh;
+
+    /**
+     * @brief Error
+     *
+     * Approximate distance from the original surface, relative to the
+     * mesh size. Multiplying it by the mesh size and dividing it by distance
+     * from the camera gives an estimate of screen-space error, which can be
+     * then used for picking a level.
+     */
+    Float error;
+};
+
+/**
+@brief Generate a chain of levels of detail
+@param meshData         Indexed triangle mesh
+@param levelCount       Max count of generated levels, including the
+    original
+@param triangleRatio    Triangle count ratio between consecutive levels
+@param maxError         Max allowed error, relative to mesh size
+
+The first level is a copy of @p meshData, each next level is created with
+@ref simplify() from the previous one to have at most @p triangleRatio of
+its triangles, with all vertex data not referenced anymore removed. The
+generation stops early if the next level would exceed @p maxError or if the
+mesh can't be simplified any further. Normals and texture coordinates of
+the first array are taken into account, if present. Example usage with
+selection based on projected error:
+@code
+Trade::MeshData3D meshData;
+Float meshSize;
+
+std::vector<MeshTools::LodLevel> lods = MeshTools::generateLods(meshData, 5);
+
+// ...
+std::size_t level = 0;
+while(level + 1 < lods.size() && lods[level + 1].error*meshSize/distance < maxScreenError)
+    ++level;
+@endcode
+
+Expects that the mesh is indexed and has @ref MeshPrimitive::Triangles
+primitive.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<LodLevel> generateLods(const Trade::MeshData3D& meshData, UnsignedInt levelCount, Float triangleRatio = 0.5f, Float maxError = Constants::inf());
+
+}}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SkinDualQuaternions.h"
+
+#include <cmath>
+
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+    enum: std::size_t {
+        LaneCount = 16,
+        MinChunkSize = 8*1024
+    };
+}
+
+void skinDualQuaternionsInto(const Containers::ArrayView<const DualQuaternion> joints, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> weights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<Vector3> skinnedPositions, const Containers::ArrayView<Vector3> skinnedNormals) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && weights.size() == positions.size() && skinnedPositions.size() == positions.size(),
+        "MeshTools::skinDualQuaternionsInto(): expected" << positions.size() << "joint IDs, weights and skinned positions but got" << jointIds.size() << Debug::nospace << "," << weights.size() << "and" << skinnedPositions.size(), );
+    CORRADE_ASSERT(skinnedNormals.size() == normals.size() && (normals.empty() || normals.size() == positions.size()),
+        "MeshTools::skinDualQuaternionsInto(): expected either no normals or" << positions.size() << "normals and skinned normals but got" << normals.size() << "and" << skinnedNormals.size(), );
+
+    const DualQuaternion* const jointData = joints.data();
+    const Vector4ui* const jointIdData = jointIds.data();
+    const Vector4* const weightData = weights.data();
+    const Vector3* const positionData = positions.data();
+    const Vector3* const normalData = normals.data();
+    Vector3* const skinnedPositionData = skinnedPositions.data();
+    Vector3* const skinnedNormalData = skinnedNormals.data();
+    const bool hasNormals = !normals.empty();
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t jointCount = joints.size();
+    #endif
+
+    const std::size_t count = positions.size();
+    Magnum::Implementation::parallelChunks(count, Magnum::Implementation::chunkSize(count, MinChunkSize), [=](std::size_t, const std::size_t begin, const std::size_t end) {
+        /* Structure-of-arrays lanes so the normalization and transformation
+           loops below get vectorized. Unused lanes of the last block are
+           identity transforming zero vectors. */
+        Float rx[LaneCount], ry[LaneCount], rz[LaneCount], rw[LaneCount];
+        Float dx[LaneCount], dy[LaneCount], dz[LaneCount], dw[LaneCount];
+        Float px[LaneCount], py[LaneCount], pz[LaneCount];
+        Float nx[LaneCount], ny[LaneCount], nz[LaneCount];
+
+        for(std::size_t blockBegin = begin; blockBegin < end; blockBegin += LaneCount) {
+            const std::size_t blockSize = std::min(std::size_t(LaneCount), end - blockBegin);
+
+            /* Gather and blend the joints. The sign of each joint is flipped
+               if it's in the other hemisphere than the first one, as both
+               represent the same transformation but blending them would
+               cancel out. */
+            for(std::size_t l = 0; l != blockSize; ++l) {
+                const std::size_t i = blockBegin + l;
+                const Vector4ui& ids = jointIdData[i];
+                const Vector4& w = weightData[i];
+                CORRADE_ASSERT(ids.x() < jointCount && ids.y() < jointCount && ids.z() < jointCount && ids.w() < jointCount,
+                    "MeshTools::skinDualQuaternionsInto(): joint IDs" << ids << "of vertex" << i << "out of range for" << jointCount << "joints", );
+
+                const Quaternion& first = jointData[ids[0]].real();
+                DualQuaternion blended = w[0]*jointData[ids[0]];
+                for(std::size_t j = 1; j != 4; ++j) {
+                    const DualQuaternion& joint = jointData[ids[j]];
+                    blended += (Math::dot(first, joint.real()) < 0.0f ? -w[j] : w[j])*joint;
+                }
+
+                rx[l] = blended.real().vector().x();
+                ry[l] = blended.real().vector().y();
+                rz[l] = blended.real().vector().z();
+                rw[l] = blended.real().scalar();
+                dx[l] = blended.dual().vector().x();
+                dy[l] = blended.dual().vector().y();
+                dz[l] = blended.dual().vector().z();
+                dw[l] = blended.dual().scalar();
+                px[l] = positionData[i].x();
+                py[l] = positionData[i].y();
+                pz[l] = positionData[i].z();
+                if(hasNormals) {
+                    nx[l] = normalData[i].x();
+                    ny[l] = normalData[i].y();
+                    nz[l] = normalData[i].z();
+                } else nx[l] = ny[l] = nz[l] = 0.0f;
+            }
+            for(std::size_t l = blockSize; l != LaneCount; ++l) {
+                rx[l] = ry[l] = rz[l] = 0.0f;
+                rw[l] = 1.0f;
+                dx[l] = dy[l] = dz[l] = dw[l] = 0.0f;
+                px[l] = py[l] = pz[l] = nx[l] = ny[l] = nz[l] = 0.0f;
+            }
+
+            /* Normalize the blended dual quaternion by length of the real
+               part, then rotate the position and normal by the real part and
+               translate the position by 2 d r*, which is equivalent to
+               DualQuaternion::transformPointNormalized() */
+            for(std::size_t l = 0; l != LaneCount; ++l) {
+                const Float invLength = 1.0f/std::sqrt(rx[l]*rx[l] + ry[l]*ry[l] + rz[l]*rz[l] + rw[l]*rw[l]);
+                const Float qx = rx[l]*invLength, qy = ry[l]*invLength, qz = rz[l]*invLength, qw = rw[l]*invLength;
+                const Float ex = dx[l]*invLength, ey = dy[l]*invLength, ez = dz[l]*invLength, ew = dw[l]*invLength;
+
+                /* v' = v + 2 q.xyz x (q.xyz x v + q.w v) */
+                const Float pcx = qy*pz[l] - qz*py[l] + qw*px[l];
+                const Float pcy = qz*px[l] - qx*pz[l] + qw*py[l];
+                const Float pcz = qx*py[l] - qy*px[l] + qw*pz[l];
+                const Float ncx = qy*nz[l] - qz*ny[l] + qw*nx[l];
+                const Float ncy = qz*nx[l] - qx*nz[l] + qw*ny[l];
+                const Float ncz = qx*ny[l] - qy*nx[l] + qw*nz[l];
+
+                /* t = 2 (q.w e.xyz - e.w q.xyz + q.xyz x e.xyz) */
+                const Float tx = 2.0f*(qw*ex - ew*qx + qy*ez - qz*ey);
+                const Float ty = 2.0f*(qw*ey - ew*qy + qz*ex - qx*ez);
+                const Float tz = 2.0f*(qw*ez - ew*qz + qx*ey - qy*ex);
+
+                px[l] += 2.0f*(qy*pcz - qz*pcy) + tx;
+                py[l] += 2.0f*(qz*pcx - qx*pcz) + ty;
+                pz[l] += 2.0f*(qx*pcy - qy*pcx) + tz;
+                nx[l] += 2.0f*(qy*ncz - qz*ncy);
+                ny[l] += 2.0f*(qz*ncx - qx*ncz);
+                nz[l] += 2.0f*(qx*ncy - qy*ncx);
+            }
+
+            for(std::size_t l = 0; l != blockSize; ++l)
+                skinnedPositionData[blockBegin + l] = {px[l], py[l], pz[l]};
+            if(hasNormals) for(std::size_t l = 0; l != blockSize; ++l)
+                skinnedNormalData[blockBegin + l] = {nx[l], ny[l], nz[l]};
+        }
+    });
+}
+
+}}
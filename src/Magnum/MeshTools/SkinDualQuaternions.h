@@ -0,0 +1,90 @@
+#ifndef Magnum_MeshTools_SkinDualQuaternions_h
+#define Magnum_MeshTools_SkinDualQuaternions_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::skinDualQuaternionsInto()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin a mesh using dual quaternion linear blending
+@param[in] joints           Joint transformations
+@param[in] jointIds         IDs of up to four joints affecting each vertex
+@param[in] weights          Weights of joints from @p jointIds
+@param[in] positions        Vertex positions in bind pose
+@param[in] normals          Vertex normals in bind pose or empty view
+@param[out] skinnedPositions Skinned vertex positions
+@param[out] skinnedNormals  Skinned vertex normals or empty view
+
+For each vertex blends the dual quaternions of its joints, taking the sign of
+each joint relative to the first one so the blend follows the shortest path,
+normalizes the result and transforms the position and normal with it. Unlike
+blending matrices, this doesn't make the skin collapse around twisted joints.
+The @p joints are expected to be normalized and to contain the inverse bind
+pose already, weights of each vertex are expected to sum up to `1.0f`.
+
+Expects that @p jointIds, @p weights and @p skinnedPositions have the same size
+as @p positions and @p skinnedNormals the same size as @p normals, which is
+either the same as @p positions or zero. The vertices are processed in blocks
+of SIMD-friendly layout and in parallel on large meshes. Example usage with
+@ref Trade::MeshData3D:
+@code
+Trade::MeshData3D data = ...;
+std::vector<DualQuaternion> joints = ...;
+
+const std::vector<Vector4ui>& jointIds = data.jointIds();
+const std::vector<Vector4>& weights = data.jointWeights();
+const std::vector<Vector3>& positions = data.positions(0);
+const std::vector<Vector3>& normals = data.normals(0);
+
+std::vector<Vector3> skinnedPositions(positions.size());
+std::vector<Vector3> skinnedNormals(normals.size());
+MeshTools::skinDualQuaternionsInto({joints.data(), joints.size()},
+    {jointIds.data(), jointIds.size()}, {weights.data(), weights.size()},
+    {positions.data(), positions.size()}, {normals.data(), normals.size()},
+    {skinnedPositions.data(), skinnedPositions.size()},
+    {skinnedNormals.data(), skinnedNormals.size()});
+@endcode
+
+This is meant for the cases where the skinned mesh is needed on the CPU, for
+example for collision detection. For rendering, use
+@ref Shaders::Phong::Flag::DualQuaternionSkinning or
+@ref Shaders::Flat::Flag::DualQuaternionSkinning, which do the same on the GPU.
+@see @ref DualQuaternion::transformPointNormalized(),
+    @ref transformPointsInPlace()
+*/
+void MAGNUM_MESHTOOLS_EXPORT skinDualQuaternionsInto(Containers::ArrayView<const DualQuaternion> joints, Containers::ArrayView<const Vector4ui> jointIds, Containers::ArrayView<const Vector4> weights, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals, Containers::ArrayView<Vector3> skinnedPositions, Containers::ArrayView<Vector3> skinnedNormals);
+
+}}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StaticBatch.h"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Transform.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+StaticBatch::StaticBatch(const Float cellSize): _cellSize{cellSize}, _primitive{MeshPrimitive::Triangles} {
+    CORRADE_ASSERT(cellSize > 0.0f,
+        "MeshTools::StaticBatch: expected positive cell size but got" << cellSize, );
+}
+
+UnsignedInt StaticBatch::add(const Trade::MeshData3D& mesh, const Matrix4& transformation, const Int material) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Points || mesh.primitive() == MeshPrimitive::Lines || mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::StaticBatch::add(): can't batch" << mesh.primitive(), {});
+    CORRADE_ASSERT(_sources.empty() || mesh.primitive() == _primitive,
+        "MeshTools::StaticBatch::add(): expected" << _primitive << "but got" << mesh.primitive(), {});
+    _primitive = mesh.primitive();
+
+    Data data;
+    data.material = material;
+
+    /* Transform the positions and normals. Normals are transformed with the
+       inverse transpose to stay perpendicular under non-uniform scaling. */
+    data.positions = mesh.positions(0);
+    transformPointsInPlace(transformation, data.positions);
+    if(mesh.hasNormals()) {
+        data.normals = mesh.normals(0);
+        transformVectorsInPlace(Matrix4::from(transformation.rotationScaling().inverted().transposed(), {}), data.normals);
+        for(Vector3& normal: data.normals) normal = normal.normalized();
+    }
+    if(mesh.hasTextureCoords2D())
+        data.textureCoords = mesh.textureCoords2D(0);
+
+    /* Non-indexed meshes get a trivial index array so everything can be
+       concatenated into a single indexed mesh */
+    if(mesh.isIndexed()) {
+        data.indices = mesh.indices();
+        #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+        for(const UnsignedInt index: data.indices)
+            CORRADE_ASSERT(index < data.positions.size(),
+                "MeshTools::StaticBatch::add(): index" << index << "out of range for" << data.positions.size() << "vertices", {});
+        #endif
+    } else {
+        data.indices.resize(data.positions.size());
+        std::iota(data.indices.begin(), data.indices.end(), 0);
+    }
+
+    /* Bounding box and the cell containing its center */
+    if(!data.positions.empty()) {
+        Vector3 min = data.positions[0], max = data.positions[0];
+        for(const Vector3& position: data.positions) {
+            min = Math::min(min, position);
+            max = Math::max(max, position);
+        }
+        data.bounds = {min, max};
+    }
+    data.cell = Vector3i{Math::floor(data.bounds.center()/_cellSize)};
+
+    _sources.push_back(std::move(data));
+    return _sources.size() - 1;
+}
+
+Trade::MeshData3D StaticBatch::combine() {
+    /* Order the meshes by material and cell, otherwise in the order they were
+       added */
+    std::vector<UnsignedInt> order(_sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](const UnsignedInt a, const UnsignedInt b) {
+        const Data& da = _sources[a];
+        const Data& db = _sources[b];
+        return std::make_tuple(da.material, da.cell.x(), da.cell.y(), da.cell.z()) <
+               std::make_tuple(db.material, db.cell.x(), db.cell.y(), db.cell.z());
+    });
+
+    /* Normals and texture coordinates are kept only if all meshes have
+       them */
+    bool hasNormals = true, hasTextureCoords = true;
+    std::size_t vertexCount = 0, indexCount = 0;
+    for(const Data& data: _sources) {
+        hasNormals = hasNormals && data.normals.size() == data.positions.size();
+        hasTextureCoords = hasTextureCoords && data.textureCoords.size() == data.positions.size();
+        vertexCount += data.positions.size();
+        indexCount += data.indices.size();
+    }
+    hasNormals = hasNormals && !_sources.empty();
+    hasTextureCoords = hasTextureCoords && !_sources.empty();
+
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector2> textureCoords;
+    indices.reserve(indexCount);
+    positions.reserve(vertexCount);
+    if(hasNormals) normals.reserve(vertexCount);
+    if(hasTextureCoords) textureCoords.reserve(vertexCount);
+
+    _bins.clear();
+    _combinedSources.assign(_sources.size(), Source{});
+    for(const UnsignedInt id: order) {
+        const Data& data = _sources[id];
+        const UnsignedInt vertexOffset = positions.size();
+        const UnsignedInt indexOffset = indices.size();
+
+        /* Start a new bin if the material or cell differs from the previous
+           mesh */
+        if(_bins.empty() || _bins.back().material != data.material || _bins.back().cell != data.cell)
+            _bins.push_back(Bin{data.material, data.cell, indexOffset, 0, vertexOffset, vertexOffset, data.bounds});
+        Bin& bin = _bins.back();
+
+        /* Concatenate the data */
+        for(const UnsignedInt index: data.indices)
+            indices.push_back(vertexOffset + index);
+        positions.insert(positions.end(), data.positions.begin(), data.positions.end());
+        if(hasNormals)
+            normals.insert(normals.end(), data.normals.begin(), data.normals.end());
+        if(hasTextureCoords)
+            textureCoords.insert(textureCoords.end(), data.textureCoords.begin(), data.textureCoords.end());
+
+        const UnsignedInt vertexEnd = data.positions.empty() ? vertexOffset : positions.size() - 1;
+        _combinedSources[id] = Source{UnsignedInt(_bins.size() - 1), indexOffset, UnsignedInt(data.indices.size()), vertexOffset, vertexEnd, data.bounds};
+
+        /* Update the bin. Empty meshes don't contribute to the bounds. */
+        if(!data.positions.empty()) {
+            bin.bounds = bin.vertexStart == vertexOffset ? data.bounds : Math::join(bin.bounds, data.bounds);
+            bin.vertexEnd = vertexEnd;
+        }
+        bin.indexCount = indices.size() - bin.indexOffset;
+    }
+
+    std::vector<std::vector<Vector3>> positionArrays(1);
+    positionArrays[0] = std::move(positions);
+    std::vector<std::vector<Vector3>> normalArrays;
+    if(hasNormals) {
+        normalArrays.resize(1);
+        normalArrays[0] = std::move(normals);
+    }
+    std::vector<std::vector<Vector2>> textureCoordArrays;
+    if(hasTextureCoords) {
+        textureCoordArrays.resize(1);
+        textureCoordArrays[0] = std::move(textureCoords);
+    }
+
+    return Trade::MeshData3D{_primitive, std::move(indices), std::move(positionArrays), std::move(normalArrays), std::move(textureCoordArrays)};
+}
+
+}}
@@ -0,0 +1,191 @@
+#ifndef Magnum_MeshTools_StaticBatch_h
+#define Magnum_MeshTools_StaticBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::StaticBatch
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Static geometry batch
+
+Merges many small static meshes into a single one, so they can be drawn with
+one draw call instead of one for each. The meshes are transformed to a common
+coordinate system when added and then concatenated into one vertex and index
+array, grouped into *bins* by material and spatial cell. Each bin is a
+contiguous range of indices, so the whole cell can be drawn at once using
+@ref MeshView. Ranges of the original meshes are available as well, for
+example for finer-grained culling:
+@code
+MeshTools::StaticBatch batch{16.0f};
+for(const Prop& prop: props)
+    batch.add(prop.meshData, prop.transformation, prop.material);
+
+Mesh mesh;
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(mesh, vertices, indices) = MeshTools::compile(batch.combine(), BufferUsage::StaticDraw);
+
+for(const MeshTools::StaticBatch::Bin& bin: batch.bins()) {
+    if(!frustum.intersects(bin.bounds)) continue;
+
+    MeshView view{mesh};
+    view.setCount(bin.indexCount)
+        .setIndexRange(bin.indexOffset, bin.vertexStart, bin.vertexEnd);
+    shaders[bin.material].draw(view);
+}
+@endcode
+
+The positions are transformed using @ref transformPointsInPlace() and normals
+using the normal matrix with @ref transformVectorsInPlace() and then
+renormalized. The combined mesh has normals and texture coordinates only if
+all added meshes have them, only the first position, normal and texture
+coordinate array is used.
+@see @ref compile(), @ref SceneCache
+*/
+class MAGNUM_MESHTOOLS_EXPORT StaticBatch {
+    public:
+        /** @brief Meshes with the same material in the same cell */
+        struct Bin {
+            Int material;               /**< @brief Material ID or `-1` */
+            Vector3i cell;              /**< @brief Spatial cell */
+            UnsignedInt indexOffset;    /**< @brief Offset of the first index */
+            UnsignedInt indexCount;     /**< @brief Index count */
+            UnsignedInt vertexStart;    /**< @brief Minimal referenced vertex */
+            UnsignedInt vertexEnd;      /**< @brief Maximal referenced vertex */
+            Range3D bounds;             /**< @brief Bounding box */
+        };
+
+        /** @brief Range of one added mesh */
+        struct Source {
+            UnsignedInt bin;            /**< @brief Bin containing the mesh */
+            UnsignedInt indexOffset;    /**< @brief Offset of the first index */
+            UnsignedInt indexCount;     /**< @brief Index count */
+            UnsignedInt vertexStart;    /**< @brief Minimal referenced vertex */
+            UnsignedInt vertexEnd;      /**< @brief Maximal referenced vertex */
+            Range3D bounds;             /**< @brief Bounding box */
+        };
+
+        /**
+         * @brief Constructor
+         * @param cellSize  Size of the spatial cells. Each mesh goes into
+         *      the cell containing center of its bounding box. Pass
+         *      @ref Constants::inf() to group the meshes just by material.
+         *
+         * Expects that @p cellSize is positive.
+         */
+        explicit StaticBatch(Float cellSize);
+
+        /** @brief Copying is not allowed */
+        StaticBatch(const StaticBatch&) = delete;
+
+        /** @brief Move constructor */
+        StaticBatch(StaticBatch&&) = default;
+
+        /** @brief Copying is not allowed */
+        StaticBatch& operator=(const StaticBatch&) = delete;
+
+        /** @brief Move assignment */
+        StaticBatch& operator=(StaticBatch&&) = default;
+
+        /** @brief Cell size */
+        Float cellSize() const { return _cellSize; }
+
+        /** @brief Count of added meshes */
+        std::size_t sourceCount() const { return _sources.size(); }
+
+        /**
+         * @brief Add a mesh
+         * @param mesh              Mesh data
+         * @param transformation    Transformation of the mesh
+         * @param material          Material ID or `-1`
+         * @return ID of the mesh, usable as index into @ref sources()
+         *
+         * Copies and transforms the data, @p mesh doesn't need to be kept
+         * around afterwards. Expects that the mesh has the same primitive as
+         * all meshes added before and that the primitive is
+         * @ref MeshPrimitive::Points, @ref MeshPrimitive::Lines or
+         * @ref MeshPrimitive::Triangles, as strips and fans can't be
+         * concatenated.
+         */
+        UnsignedInt add(const Trade::MeshData3D& mesh, const Matrix4& transformation, Int material = -1);
+
+        /**
+         * @brief Combine the meshes
+         *
+         * Sorts the meshes into bins by material and cell and returns indexed
+         * mesh data with all of them, suitable for @ref compile(). Fills
+         * @ref bins() and @ref sources().
+         */
+        Trade::MeshData3D combine();
+
+        /**
+         * @brief Bins
+         *
+         * Ordered by material and cell. Empty before @ref combine() is
+         * called.
+         */
+        const std::vector<Bin>& bins() const { return _bins; }
+
+        /**
+         * @brief Ranges of added meshes
+         *
+         * In order the meshes were added. Empty before @ref combine() is
+         * called.
+         */
+        const std::vector<Source>& sources() const { return _combinedSources; }
+
+    private:
+        struct Data {
+            Int material;
+            Vector3i cell;
+            Range3D bounds;
+            std::vector<UnsignedInt> indices;
+            std::vector<Vector3> positions;
+            std::vector<Vector3> normals;
+            std::vector<Vector2> textureCoords;
+        };
+
+        Float _cellSize;
+        MeshPrimitive _primitive;
+        std::vector<Data> _sources;
+        std::vector<Bin> _bins;
+        std::vector<Source> _combinedSources;
+};
+
+}}
+
+#endif
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MESHTOOLS_USE_SSE2
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Values are decoded in chunks of this size so the intermediate buffer stays
+   in L1 cache */
+enum: std::size_t { ChunkSize = 1024 };
+
+/* Vertex stream header, followed by componentCount pairs of minimum and
+   quantization step */
+struct VertexStreamHeader {
+    UnsignedInt componentCount;
+    UnsignedInt bits;
+};
+
+inline UnsignedInt zigzag(const UnsignedInt difference) {
+    return (difference << 1) ^ (0u - (difference >> 31));
+}
+
+inline UnsignedInt unzigzag(const UnsignedInt value) {
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+void appendVarint(std::vector<char>& out, UnsignedInt value) {
+    while(value >= 0x80) {
+        out.push_back(char(value|0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+/* Decodes count values, returns pointer after the last one or nullptr if the
+   data end sooner or a value is longer than five bytes */
+const UnsignedByte* decodeVarints(const UnsignedByte* in, const UnsignedByte* const end, UnsignedInt* out, std::size_t count) {
+    while(count) {
+        #ifdef MAGNUM_MESHTOOLS_USE_SSE2
+        /* If the next sixteen values are all single-byte, expand them at
+           once */
+        if(count >= 16 && end - in >= 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            if(!_mm_movemask_epi8(bytes)) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+                in += 16;
+                out += 16;
+                count -= 16;
+                continue;
+            }
+        }
+        #endif
+
+        UnsignedInt value = 0;
+        for(UnsignedInt shift = 0; ; shift += 7) {
+            if(in == end || shift > 28) return nullptr;
+            const UnsignedByte byte = *in++;
+            value |= UnsignedInt(byte & 0x7f) << shift;
+            if(!(byte & 0x80)) break;
+        }
+
+        *out++ = value;
+        --count;
+    }
+
+    return in;
+}
+
+template<class T> bool decodeIndexStreamInto(const Containers::ArrayView<const char> data, const Containers::ArrayView<T> out) {
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data());
+    const UnsignedByte* const end = in + data.size();
+    UnsignedInt codes[ChunkSize];
+
+    /* Zero is the next not yet referenced vertex, the rest is difference to
+       the previous index */
+    UnsignedInt next = 0, last = 0;
+    for(std::size_t i = 0; i < out.size(); i += ChunkSize) {
+        const std::size_t count = std::min<std::size_t>(out.size() - i, ChunkSize);
+        if(!(in = decodeVarints(in, end, codes, count))) {
+            Error() << "MeshTools::decodeIndexStream(): the data are too short for" << out.size() << "indices";
+            return false;
+        }
+
+        for(std::size_t j = 0; j != count; ++j) {
+            const UnsignedInt code = codes[j];
+            const UnsignedInt index = code ? last + unzigzag(code - 1) : next;
+            if(index > std::numeric_limits<T>::max()) {
+                Error() << "MeshTools::decodeIndexStream(): index" << index << "doesn't fit into" << sizeof(T)*8 << "bits";
+                return false;
+            }
+
+            out[i + j] = T(index);
+            last = index;
+            next = std::max(next, index + 1);
+        }
+    }
+
+    return true;
+}
+
+}
+
+Containers::Array<char> encodeIndexStream(const std::vector<UnsignedInt>& indices) {
+    std::vector<char> out;
+    out.reserve(indices.size());
+
+    UnsignedInt next = 0, last = 0;
+    for(const UnsignedInt index: indices) {
+        appendVarint(out, index == next ? 0 : zigzag(index - last) + 1);
+        last = index;
+        next = std::max(next, index + 1);
+    }
+
+    Containers::Array<char> data{out.size()};
+    std::copy(out.begin(), out.end(), data.begin());
+    return data;
+}
+
+bool decodeIndexStream(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedByte> out) {
+    return decodeIndexStreamInto(data, out);
+}
+
+bool decodeIndexStream(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedShort> out) {
+    return decodeIndexStreamInto(data, out);
+}
+
+bool decodeIndexStream(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedInt> out) {
+    return decodeIndexStreamInto(data, out);
+}
+
+Containers::Array<char> encodeVertexStream(const Containers::ArrayView<const Float> data, const UnsignedInt componentCount, const UnsignedInt bits) {
+    CORRADE_ASSERT(componentCount && data.size() % componentCount == 0,
+        "MeshTools::encodeVertexStream(): data size" << data.size() << "is not divisible by" << componentCount << "components", {});
+    CORRADE_ASSERT(bits >= 1 && bits <= 24,
+        "MeshTools::encodeVertexStream(): expected 1 to 24 bits, got" << bits, {});
+
+    /* Component ranges */
+    std::vector<Float> min(componentCount, std::numeric_limits<Float>::max());
+    std::vector<Float> max(componentCount, std::numeric_limits<Float>::lowest());
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const std::size_t component = i % componentCount;
+        min[component] = std::min(min[component], data[i]);
+        max[component] = std::max(max[component], data[i]);
+    }
+
+    std::vector<char> out(sizeof(VertexStreamHeader) + componentCount*2*sizeof(Float));
+    const VertexStreamHeader header{componentCount, bits};
+    std::memcpy(out.data(), &header, sizeof(VertexStreamHeader));
+
+    /* Quantization step for each component, zero if all values are the same
+       or there are no vertices */
+    std::vector<Float> step(componentCount);
+    const Float levels = Float((1u << bits) - 1);
+    for(UnsignedInt i = 0; i != componentCount; ++i) {
+        if(min[i] >= max[i]) {
+            min[i] = data.empty() ? 0.0f : min[i];
+            step[i] = 0.0f;
+        } else step[i] = (max[i] - min[i])/levels;
+
+        const Float range[]{min[i], step[i]};
+        std::memcpy(out.data() + sizeof(VertexStreamHeader) + i*sizeof(range), range, sizeof(range));
+    }
+
+    /* Differences of quantized values to the previous vertex */
+    std::vector<UnsignedInt> previous(componentCount);
+    out.reserve(out.size() + data.size());
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const std::size_t component = i % componentCount;
+        const UnsignedInt quantized = step[component] == 0.0f ? 0 :
+            UnsignedInt(std::round((data[i] - min[component])/step[component]));
+        appendVarint(out, zigzag(quantized - previous[component]));
+        previous[component] = quantized;
+    }
+
+    Containers::Array<char> encoded{out.size()};
+    std::copy(out.begin(), out.end(), encoded.begin());
+    return encoded;
+}
+
+bool decodeVertexStream(const Containers::ArrayView<const char> data, const Containers::ArrayView<Float> out, const UnsignedInt componentCount) {
+    VertexStreamHeader header;
+    if(data.size() < sizeof(VertexStreamHeader)) {
+        Error() << "MeshTools::decodeVertexStream(): the data are too short for a header";
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(VertexStreamHeader));
+
+    if(header.componentCount != componentCount || !componentCount || out.size() % componentCount) {
+        Error() << "MeshTools::decodeVertexStream(): expected" << componentCount << "components with output size divisible by them but got" << header.componentCount << "components and output size" << out.size();
+        return false;
+    }
+
+    const std::size_t rangeSize = componentCount*2*sizeof(Float);
+    if(data.size() < sizeof(VertexStreamHeader) + rangeSize) {
+        Error() << "MeshTools::decodeVertexStream(): the data are too short for" << componentCount << "component ranges";
+        return false;
+    }
+
+    std::vector<Float> range(componentCount*2);
+    std::memcpy(range.data(), data.data() + sizeof(VertexStreamHeader), rangeSize);
+
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data() + sizeof(VertexStreamHeader) + rangeSize);
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.data() + data.size());
+    std::vector<UnsignedInt> quantized(componentCount);
+    UnsignedInt codes[ChunkSize];
+    UnsignedInt component = 0;
+    for(std::size_t i = 0; i < out.size(); i += ChunkSize) {
+        const std::size_t count = std::min<std::size_t>(out.size() - i, ChunkSize);
+        if(!(in = decodeVarints(in, end, codes, count))) {
+            Error() << "MeshTools::decodeVertexStream(): the data are too short for" << out.size()/componentCount << "vertices";
+            return false;
+        }
+
+        for(std::size_t j = 0; j != count; ++j) {
+            quantized[component] += unzigzag(codes[j]);
+            out[i + j] = range[component*2] + Float(quantized[component])*range[component*2 + 1];
+            if(++component == componentCount) component = 0;
+        }
+    }
+
+    return true;
+}
+
+}}
@@ -0,0 +1,117 @@
+#ifndef Magnum_MeshTools_StreamCodec_h
+#define Magnum_MeshTools_StreamCodec_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeIndexStream(), @ref Magnum::MeshTools::decodeIndexStream(), @ref Magnum::MeshTools::encodeVertexStream(), @ref Magnum::MeshTools::decodeVertexStream()
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode an index stream
+@param indices  Index array
+
+@ref compressIndices() only picks the smallest index type, the indices still
+take at least one byte each and large meshes need 32-bit ones. This function
+encodes each index relative to the previous one into a variable-length integer
+of 7 bits per byte. An index referencing a vertex that wasn't referenced yet
+is encoded as a single zero byte, so after @ref optimizeVertexCache() and
+@ref optimizeVertexFetch(), which make vertices appear in the order of first
+use and keep the references local, most indices take just one byte regardless
+of mesh size. The output consists mostly of small repeating values, so it also
+compresses well with general-purpose compressors used for asset delivery.
+
+Decode the data using @ref decodeIndexStream(). The index count is not stored
+in the output.
+@see @ref encodeVertexStream()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndexStream(const std::vector<UnsignedInt>& indices);
+
+/**
+@brief Decode an index stream
+@param data     Data encoded with @ref encodeIndexStream()
+@param out      Where to put the indices
+@return `False` if the data can't be decoded, `true` otherwise
+
+Decodes `out.size()` indices. Prints a message to @ref Error and
+returns `false` if the data are too short or any index doesn't fit into the
+output type, in which case contents of @p out are unspecified. Runs of
+single-byte values are expanded using SSE2, if available.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndexStream(Containers::ArrayView<const char> data, Containers::ArrayView<UnsignedByte> out);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndexStream(Containers::ArrayView<const char> data, Containers::ArrayView<UnsignedShort> out);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndexStream(Containers::ArrayView<const char> data, Containers::ArrayView<UnsignedInt> out);
+
+/**
+@brief Encode a vertex stream
+@param data             Interleaved vertex data
+@param componentCount   Count of float components per vertex
+@param bits             Quantization precision, in range @f$ [1, 24] @f$
+
+Each component is quantized to @p bits bits over its range in the whole data
+and encoded as a difference to the same component of the previous vertex,
+stored as a variable-length integer. Neighboring vertices are close to each
+other after @ref optimizeVertexFetch(), so the differences are small. The
+encoding is lossy, the maximal error of each component is half of its range
+divided by @f$ 2^{bits} - 1 @f$. Size of @p data is expected to be divisible
+by @p componentCount.
+
+The output starts with the component count, precision and per-component
+ranges, decode it using @ref decodeVertexStream(). The vertex count is not
+stored in the output.
+@see @ref encodeIndexStream()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertexStream(Containers::ArrayView<const Float> data, UnsignedInt componentCount, UnsignedInt bits);
+
+/**
+@brief Decode a vertex stream
+@param data             Data encoded with @ref encodeVertexStream()
+@param out              Where to put the interleaved vertex data
+@param componentCount   Expected count of float components per vertex
+@return `False` if the data can't be decoded, `true` otherwise
+
+Decodes `out.size()/componentCount` vertices. Prints a message to
+@ref Error and returns `false` if the data are too short, the component count
+doesn't match or size of @p out is not divisible by it, in which case
+contents of @p out are unspecified. Runs of single-byte values are expanded
+using SSE2, if available.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVertexStream(Containers::ArrayView<const char> data, Containers::ArrayView<Float> out, UnsignedInt componentCount);
+
+}}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Subdivide.h"
+
+#include "Magnum/Implementation/Parallel.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+namespace {
+    enum: std::size_t {
+        MinFaceChunkSize = 16*1024,
+        /* The interpolator is usually more expensive than copying indices */
+        MinVertexChunkSize = 4*1024
+    };
+
+    /* Both vertices are smaller than the maximal index, so this is never
+       a valid key */
+    constexpr UnsignedLong EmptyKey = ~UnsignedLong{};
+
+    /* Fibonacci hashing, the upper bits are the best mixed */
+    inline std::size_t hashEdge(const UnsignedLong key, const UnsignedInt shift) {
+        return std::size_t((key*0x9e3779b97f4a7c15ull) >> shift);
+    }
+}
+
+void subdivideEdges(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, std::vector<UnsignedInt>& midpoints, std::vector<std::pair<UnsignedInt, UnsignedInt>>& edges) {
+    /* Open addressing with linear probing, at most half full. A closed mesh
+       has half as many edges as indices, an open one at most as many. */
+    UnsignedInt bits = 4;
+    while((std::size_t{1} << bits) < indices.size()*2) ++bits;
+    const std::size_t mask = (std::size_t{1} << bits) - 1;
+    std::vector<UnsignedLong> keys(mask + 1, EmptyKey);
+    std::vector<UnsignedInt> values(mask + 1);
+
+    midpoints.resize(indices.size());
+    edges.clear();
+    edges.reserve(indices.size()/2);
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt a = indices[i];
+        const UnsignedInt b = indices[i - i%3 + (i%3 + 1)%3];
+        const UnsignedLong key = a < b ? (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+
+        std::size_t slot = hashEdge(key, 64 - bits);
+        while(keys[slot] != key && keys[slot] != EmptyKey)
+            slot = (slot + 1) & mask;
+
+        if(keys[slot] == EmptyKey) {
+            keys[slot] = key;
+            values[slot] = vertexCount + edges.size();
+            edges.emplace_back(a, b);
+        }
+
+        midpoints[i] = values[slot];
+    }
+}
+
+void subdivideFaces(std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& midpoints) {
+    const std::size_t indexCount = indices.size();
+    indices.resize(indexCount*4);
+
+    /* Same face layout as subdivide(): the middle face replaces the original
+       one, the corner faces are appended */
+    UnsignedInt* const data = indices.data();
+    const UnsignedInt* const midpointData = midpoints.data();
+    const std::size_t chunk = Magnum::Implementation::chunkSize(indexCount/3, MinFaceChunkSize);
+    Magnum::Implementation::parallelChunks(indexCount/3, chunk, [data, midpointData, indexCount](std::size_t, const std::size_t begin, const std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            UnsignedInt* const original = data + face*3;
+            const UnsignedInt* const middle = midpointData + face*3;
+            const UnsignedInt a = original[0], b = original[1], c = original[2];
+
+            UnsignedInt* const corners = data + indexCount + face*9;
+            corners[0] = a;         corners[1] = middle[0]; corners[2] = middle[2];
+            corners[3] = middle[0]; corners[4] = b;         corners[5] = middle[1];
+            corners[6] = middle[2]; corners[7] = middle[1]; corners[8] = c;
+
+            original[0] = middle[0];
+            original[1] = middle[1];
+            original[2] = middle[2];
+        }
+    });
+}
+
+void subdivideParallel(const std::size_t count, void(*const f)(void*, std::size_t, std::size_t), void* const state) {
+    const std::size_t chunk = Magnum::Implementation::chunkSize(count, MinVertexChunkSize);
+    Magnum::Implementation::parallelChunks(count, chunk, [f, state](std::size_t, const std::size_t begin, const std::size_t end) {
+        f(state, begin, end);
+    });
+}
+
+}}}
@@ -26,12 +26,17 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideShared()
  */
 
+#include <utility>
 #include <vector>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -71,13 +76,51 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see @ref subdivideShared()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief Subdivide the mesh, sharing edge midpoints between faces
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+
+Same as @ref subdivide(), but the midpoint of each edge is created only once
+and shared by all faces adjacent to the edge, so the result doesn't contain
+any duplicate vertices if the input didn't and there's no need to call
+@ref removeDuplicates() afterwards. The face layout is the same as with
+@ref subdivide(), new vertices are appended in order of first occurrence of
+their edge in @p indices.
+
+The midpoints are looked up in a flat hash table keyed by the packed vertex
+index pair. For large meshes the vertex interpolation and the index buffer
+construction are split among all available hardware threads, so the
+@p interpolator has to be safe to call concurrently. The @p Vertex type needs
+to be default-constructible.
+*/
+template<class Vertex, class Interpolator> void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator);
+
 namespace Implementation {
 
+/* Assigns a new vertex index to each unique edge, in order of first
+   occurrence. For each index fills `midpoints` with the new vertex on the
+   edge starting at given index, for each new vertex fills `edges` with the
+   vertex pair to interpolate. */
+MAGNUM_MESHTOOLS_EXPORT void subdivideEdges(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::vector<UnsignedInt>& midpoints, std::vector<std::pair<UnsignedInt, UnsignedInt>>& edges);
+
+/* Replaces each face with four new using the midpoints calculated above */
+MAGNUM_MESHTOOLS_EXPORT void subdivideFaces(std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& midpoints);
+
+/* Calls `f(state, begin, end)` for consecutive chunks of `[0, count)`, in
+   parallel if the range is large enough */
+MAGNUM_MESHTOOLS_EXPORT void subdivideParallel(std::size_t count, void(*f)(void*, std::size_t, std::size_t), void* state);
+
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivide(): index count is not divisible by 3!", );
 
@@ -114,6 +157,32 @@ template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>:
 
 }
 
+template<class Vertex, class Interpolator> void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3!", );
+
+    std::vector<UnsignedInt> midpoints;
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> edges;
+    Implementation::subdivideEdges(indices, vertices.size(), midpoints, edges);
+
+    /* Interpolate the new vertices */
+    struct State {
+        std::vector<Vertex>& vertices;
+        const std::vector<std::pair<UnsignedInt, UnsignedInt>>& edges;
+        Interpolator& interpolator;
+        std::size_t offset;
+    } state{vertices, edges, interpolator, vertices.size()};
+    vertices.resize(vertices.size() + edges.size());
+    Implementation::subdivideParallel(edges.size(), [](void* data, std::size_t begin, const std::size_t end) {
+        State& state = *static_cast<State*>(data);
+        for(; begin != end; ++begin) {
+            const std::pair<UnsignedInt, UnsignedInt>& edge = state.edges[begin];
+            state.vertices[state.offset + begin] = state.interpolator(state.vertices[edge.first], state.vertices[edge.second]);
+        }
+    }, &state);
+
+    Implementation::subdivideFaces(indices, midpoints);
+}
+
 }}
 
 #endif
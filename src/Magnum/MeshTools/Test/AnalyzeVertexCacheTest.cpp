@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/AnalyzeVertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct AnalyzeVertexCacheTest: TestSuite::Tester {
+    explicit AnalyzeVertexCacheTest();
+
+    void wrongIndexCount();
+    void indexOutOfBounds();
+    void empty();
+
+    void fifo();
+    void lru();
+};
+
+AnalyzeVertexCacheTest::AnalyzeVertexCacheTest() {
+    addTests({&AnalyzeVertexCacheTest::wrongIndexCount,
+              &AnalyzeVertexCacheTest::indexOutOfBounds,
+              &AnalyzeVertexCacheTest::empty,
+
+              &AnalyzeVertexCacheTest::fifo,
+              &AnalyzeVertexCacheTest::lru});
+}
+
+namespace {
+    /*
+        0 --- 1 --- 2
+        | \ 0 | \ 2 |
+        | 1 \ | 3 \ |
+        3 --- 4 --- 5
+    */
+    const std::vector<UnsignedInt> Indices{
+        0, 4, 1,
+        0, 3, 4,
+        1, 5, 2,
+        1, 4, 5
+    };
+}
+
+void AnalyzeVertexCacheTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    MeshTools::analyzeVertexCache({0, 1}, 2, 16);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::analyzeVertexCache(): index count is not divisible by 3\n");
+}
+
+void AnalyzeVertexCacheTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    MeshTools::analyzeVertexCache({0, 1, 3}, 3, 16);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::analyzeVertexCache(): index 3 out of bounds for 3 vertices\n");
+}
+
+void AnalyzeVertexCacheTest::empty() {
+    const VertexCacheStatistics statistics = MeshTools::analyzeVertexCache({}, 0, 16);
+
+    CORRADE_COMPARE(statistics.transformedVertexCount, 0);
+    CORRADE_COMPARE(statistics.acmr, 0.0f);
+    CORRADE_COMPARE(statistics.atvr, 0.0f);
+}
+
+void AnalyzeVertexCacheTest::fifo() {
+    /* Large enough cache, every vertex is transformed just once */
+    VertexCacheStatistics statistics = MeshTools::analyzeVertexCache(Indices, 6, 16);
+    CORRADE_COMPARE(statistics.transformedVertexCount, 6);
+    CORRADE_COMPARE(statistics.acmr, 1.5f);
+    CORRADE_COMPARE(statistics.atvr, 1.0f);
+
+    /* Cache with three entries: 0 4 1 | 0 hit, 3 evicts 0, 4 hit | 1 hit,
+       5, 2 | 1, 4, 5 are already evicted */
+    statistics = MeshTools::analyzeVertexCache(Indices, 6, 3);
+    CORRADE_COMPARE(statistics.transformedVertexCount, 9);
+    CORRADE_COMPARE(statistics.acmr, 2.25f);
+    CORRADE_COMPARE(statistics.atvr, 1.5f);
+}
+
+void AnalyzeVertexCacheTest::lru() {
+    /* With LRU the hit on 0 in the second triangle moves it to the front,
+       so 4 is evicted by 3 instead and has to be transformed again right
+       after: 0 4 1 | 0 hit, 3, 4 | 1, 5, 2 | 1 hit, 4, 5 */
+    const VertexCacheStatistics statistics = MeshTools::analyzeVertexCache(Indices, 6, 3, VertexCacheModel::Lru);
+    CORRADE_COMPARE(statistics.transformedVertexCount, 10);
+    CORRADE_COMPARE(statistics.acmr, 2.5f);
+    CORRADE_COMPARE(statistics.atvr, 10.0f/6.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::AnalyzeVertexCacheTest)
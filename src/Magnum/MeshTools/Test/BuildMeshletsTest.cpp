@@ -0,0 +1,258 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/BuildMeshlets.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BuildMeshletsTest: TestSuite::Tester {
+    explicit BuildMeshletsTest();
+
+    void wrongIndexCount();
+    void limitsTooSmall();
+    void indexOutOfBounds();
+    void notIndexed();
+
+    void empty();
+    void grid();
+    void disconnected();
+    void cone();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void indirectCommands();
+    #endif
+};
+
+BuildMeshletsTest::BuildMeshletsTest() {
+    addTests({&BuildMeshletsTest::wrongIndexCount,
+              &BuildMeshletsTest::limitsTooSmall,
+              &BuildMeshletsTest::indexOutOfBounds,
+              &BuildMeshletsTest::notIndexed,
+
+              &BuildMeshletsTest::empty,
+              &BuildMeshletsTest::grid,
+              &BuildMeshletsTest::disconnected,
+              &BuildMeshletsTest::cone,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &BuildMeshletsTest::indirectCommands
+              #endif
+              });
+}
+
+namespace {
+    /* Grid of size*size quads in the XY plane, facing +Z */
+    void makeGrid(const UnsignedInt size, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+        for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x)
+            positions.push_back({Float(x), Float(y), 0.0f});
+        for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt i = y*(size + 1) + x;
+            indices.insert(indices.end(), {i, i + 1, i + size + 2,
+                                           i, i + size + 2, i + size + 1});
+        }
+    }
+
+    std::vector<std::vector<UnsignedInt>> sortedTriangles(const std::vector<UnsignedInt>& indices) {
+        std::vector<std::vector<UnsignedInt>> triangles;
+        for(std::size_t i = 0; i != indices.size(); i += 3)
+            triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+void BuildMeshletsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::buildMeshlets(indices, {{}, {}});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::buildMeshlets(): index count is not divisible by 3\n");
+}
+
+void BuildMeshletsTest::limitsTooSmall() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::buildMeshlets(indices, {{}, {}, {}}, 2, 1);
+    MeshTools::buildMeshlets(indices, {{}, {}, {}}, 3, 0);
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per meshlet but got 2 and 1\n"
+        "MeshTools::buildMeshlets(): expected at least 3 vertices and 1 triangle per meshlet but got 3 and 0\n");
+}
+
+void BuildMeshletsTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    MeshTools::buildMeshlets(indices, {{}, {}, {}});
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::buildMeshlets(): index 3 out of bounds for 3 vertices\n");
+}
+
+void BuildMeshletsTest::notIndexed() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    Trade::MeshData3D data{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}};
+    MeshTools::buildMeshlets(data);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::buildMeshlets(): expected indexed triangle mesh\n");
+}
+
+void BuildMeshletsTest::empty() {
+    std::vector<UnsignedInt> indices;
+    CORRADE_VERIFY(MeshTools::buildMeshlets(indices, {}).empty());
+    CORRADE_VERIFY(indices.empty());
+}
+
+void BuildMeshletsTest::grid() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(32, indices, positions);
+    const std::vector<UnsignedInt> original = indices;
+
+    const std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions, 32, 40);
+
+    /* All triangles are preserved, including their winding */
+    CORRADE_COMPARE(sortedTriangles(indices), sortedTriangles(original));
+
+    /* The meshlets are contiguous and respect the limits */
+    UnsignedInt offset = 0;
+    for(const Meshlet& meshlet: meshlets) {
+        CORRADE_COMPARE(meshlet.indexOffset, offset);
+        CORRADE_VERIFY(meshlet.vertexCount <= 32);
+        CORRADE_VERIFY(meshlet.indexCount <= 40*3);
+        offset += meshlet.indexCount;
+
+        std::vector<UnsignedInt> unique{indices.begin() + meshlet.indexOffset, indices.begin() + meshlet.indexOffset + meshlet.indexCount};
+        std::sort(unique.begin(), unique.end());
+        CORRADE_COMPARE(std::unique(unique.begin(), unique.end()) - unique.begin(), meshlet.vertexCount);
+
+        /* Bounding sphere contains all vertices */
+        for(const UnsignedInt index: unique)
+            CORRADE_VERIFY((positions[index] - meshlet.center).length() <= meshlet.radius*1.0001f);
+
+        /* Flat grid, the cone is infinitely narrow */
+        CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(meshlet.coneCutoff, 0.0f);
+    }
+    CORRADE_COMPARE(offset, indices.size());
+    /* A 32-vertex meshlet of a regular grid could have at most around 40
+       triangles, verify they aren't unnecessarily small */
+    CORRADE_VERIFY(meshlets.size() < 2*32*32/25);
+
+    /* Camera behind the grid sees only back faces, camera in front of it
+       doesn't */
+    CORRADE_VERIFY(meshlets.front().isBackFacing({16.0f, 16.0f, -10.0f}));
+    CORRADE_VERIFY(!meshlets.front().isBackFacing({16.0f, 16.0f, 10.0f}));
+}
+
+void BuildMeshletsTest::disconnected() {
+    /* Three nearby triangles without any shared vertex, they should still
+       end up in a single meshlet */
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {1.2f, 0.0f, 0.0f}, {2.2f, 0.0f, 0.0f}, {1.2f, 1.0f, 0.0f},
+        {2.4f, 0.0f, 0.0f}, {3.4f, 0.0f, 0.0f}, {2.4f, 1.0f, 0.0f}};
+
+    std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions);
+    CORRADE_COMPARE(meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets[0].indexCount, 9);
+    CORRADE_COMPARE(meshlets[0].vertexCount, 9);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    /* With a smaller vertex limit they're split */
+    meshlets = MeshTools::buildMeshlets(indices, positions, 6);
+    CORRADE_COMPARE(meshlets.size(), 2);
+    CORRADE_COMPARE(meshlets[0].indexCount, 6);
+    CORRADE_COMPARE(meshlets[1].indexOffset, 6);
+    CORRADE_COMPARE(meshlets[1].indexCount, 3);
+
+    /* A triangle too far away gets its own meshlet */
+    for(std::size_t i = 6; i != 9; ++i) positions[i].x() += 100.0f;
+    meshlets = MeshTools::buildMeshlets(indices, positions);
+    CORRADE_COMPARE(meshlets.size(), 2);
+    CORRADE_COMPARE(meshlets[0].indexCount, 6);
+    CORRADE_COMPARE(meshlets[1].indexCount, 3);
+    CORRADE_COMPARE(meshlets[1].center, (Vector3{102.9f, 0.5f, 0.0f}));
+}
+
+void BuildMeshletsTest::cone() {
+    /* Two triangles forming a roof with 90° between their normals */
+    std::vector<UnsignedInt> indices{0, 1, 2, 0, 2, 3};
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 1.0f}};
+
+    std::vector<Meshlet> meshlets = MeshTools::buildMeshlets(indices, positions);
+    CORRADE_COMPARE(meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets[0].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(meshlets[0].coneCutoff, std::sqrt(0.5f));
+
+    /* Adding a third triangle facing down makes the cone unusable. It
+       doesn't share any vertex but is close enough to be added. */
+    indices.insert(indices.end(), {4, 5, 6});
+    std::vector<Vector3> positions2 = positions;
+    positions2.insert(positions2.end(), {{0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, -1.0f}, {1.0f, 0.0f, -1.0f}});
+    meshlets = MeshTools::buildMeshlets(indices, positions2);
+    CORRADE_COMPARE(meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets[0].coneCutoff, 1.0f);
+    CORRADE_VERIFY(!meshlets[0].isBackFacing({0.0f, 0.0f, 100.0f}));
+    CORRADE_VERIFY(!meshlets[0].isBackFacing({0.0f, 0.0f, -100.0f}));
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void BuildMeshletsTest::indirectCommands() {
+    Meshlet a{}, b{};
+    a.indexOffset = 0;
+    a.indexCount = 96;
+    b.indexOffset = 96;
+    b.indexCount = 33;
+
+    const std::vector<MeshView::DrawElementsIndirectCommand> commands = MeshTools::meshletIndirectCommands({a, b});
+    CORRADE_COMPARE(commands.size(), 2);
+    CORRADE_COMPARE(commands[0].count, 96);
+    CORRADE_COMPARE(commands[0].instanceCount, 1);
+    CORRADE_COMPARE(commands[0].firstIndex, 0);
+    CORRADE_COMPARE(commands[0].baseVertex, 0);
+    CORRADE_COMPARE(commands[0].baseInstance, 0);
+    CORRADE_COMPARE(commands[1].count, 33);
+    CORRADE_COMPARE(commands[1].firstIndex, 96);
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BuildMeshletsTest)
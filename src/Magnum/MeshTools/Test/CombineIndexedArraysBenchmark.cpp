@@ -0,0 +1,168 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CombineIndexedArraysBenchmark: TestSuite::Tester {
+    explicit CombineIndexedArraysBenchmark();
+
+    void stride2();
+    void stride2UnorderedMap();
+    void stride3();
+    void stride3UnorderedMap();
+    void stride3AsArray();
+
+    private:
+        void benchmark(UnsignedInt stride);
+        void benchmarkReference(UnsignedInt stride);
+};
+
+CombineIndexedArraysBenchmark::CombineIndexedArraysBenchmark() {
+    addBenchmarks<CombineIndexedArraysBenchmark>({&CombineIndexedArraysBenchmark::stride2,
+                                                  &CombineIndexedArraysBenchmark::stride2UnorderedMap,
+                                                  &CombineIndexedArraysBenchmark::stride3,
+                                                  &CombineIndexedArraysBenchmark::stride3UnorderedMap,
+                                                  &CombineIndexedArraysBenchmark::stride3AsArray}, 10);
+}
+
+namespace {
+
+enum: UnsignedInt {
+    Count = 1024*1024,
+    UniqueCount = 256*1024 - 3
+};
+
+/* Each combination is present four times in a scattered order, similarly
+   to position/normal/texture coordinate indices of an imported OBJ mesh */
+std::vector<UnsignedInt> data(const UnsignedInt stride) {
+    std::vector<UnsignedInt> out;
+    out.reserve(Count*stride);
+    for(UnsignedInt i = 0; i != Count; ++i) {
+        const UnsignedInt j = (i*40503ull)%UniqueCount;
+        for(UnsignedInt k = 0; k != stride; ++k)
+            out.push_back(j/(k + 1));
+    }
+    return out;
+}
+
+/* The original std::unordered_map-based implementation, for comparison */
+class IndexHash {
+    public:
+        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        std::size_t operator()(UnsignedInt key) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+class IndexEqual {
+    public:
+        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        bool operator()(UnsignedInt a, UnsignedInt b) const {
+            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArraysReference(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
+        interleavedArrays.size()/stride,
+        IndexHash(interleavedArrays, stride),
+        IndexEqual(interleavedArrays, stride));
+
+    std::vector<UnsignedInt> combinedIndices;
+    combinedIndices.reserve(interleavedArrays.size()/stride);
+    std::vector<UnsignedInt> newInterleavedArrays;
+    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
+        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
+        combinedIndices.push_back(result.first->second);
+        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
+            interleavedArrays.begin()+oldIndex*stride,
+            interleavedArrays.begin()+(oldIndex+1)*stride);
+    }
+
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
+
+}
+
+void CombineIndexedArraysBenchmark::benchmark(const UnsignedInt stride) {
+    const std::vector<UnsignedInt> input = data(stride);
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> result;
+    CORRADE_BENCHMARK(1) {
+        result = MeshTools::combineIndexArrays(input, stride);
+    }
+
+    /* Verify the same semantics as the original implementation */
+    const auto expected = combineIndexArraysReference(input, stride);
+    CORRADE_COMPARE_AS(result.second.size(), UniqueCount*stride, std::size_t);
+    CORRADE_VERIFY(result.first == expected.first);
+    CORRADE_VERIFY(result.second == expected.second);
+}
+
+void CombineIndexedArraysBenchmark::benchmarkReference(const UnsignedInt stride) {
+    const std::vector<UnsignedInt> input = data(stride);
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> result;
+    CORRADE_BENCHMARK(1) {
+        result = combineIndexArraysReference(input, stride);
+    }
+
+    CORRADE_COMPARE_AS(result.second.size(), UniqueCount*stride, std::size_t);
+}
+
+void CombineIndexedArraysBenchmark::stride2() { benchmark(2); }
+void CombineIndexedArraysBenchmark::stride2UnorderedMap() { benchmarkReference(2); }
+void CombineIndexedArraysBenchmark::stride3() { benchmark(3); }
+void CombineIndexedArraysBenchmark::stride3UnorderedMap() { benchmarkReference(3); }
+
+void CombineIndexedArraysBenchmark::stride3AsArray() {
+    const std::vector<UnsignedInt> input = data(3);
+    std::pair<Containers::Array<UnsignedInt>, Containers::Array<UnsignedInt>> result;
+    CORRADE_BENCHMARK(1) {
+        result = MeshTools::combineIndexArraysAsArray({input.data(), input.size()}, 3);
+    }
+
+    CORRADE_COMPARE_AS(result.second.size(), UniqueCount*3, std::size_t);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysBenchmark)
@@ -38,12 +38,28 @@ struct CombineIndexedArraysTest: TestSuite::Tester {
     void wrongIndexCount();
     void indexArrays();
     void indexedArrays();
+
+    void interleavedStride2();
+    void interleavedStride3();
+    void interleavedStride4();
+    void interleavedEmpty();
+    void interleavedLarge();
+    void interleavedAsArray();
+    void interleavedAsArrayInvalidStride();
 };
 
 CombineIndexedArraysTest::CombineIndexedArraysTest() {
     addTests({&CombineIndexedArraysTest::wrongIndexCount,
               &CombineIndexedArraysTest::indexArrays,
-              &CombineIndexedArraysTest::indexedArrays});
+              &CombineIndexedArraysTest::indexedArrays,
+
+              &CombineIndexedArraysTest::interleavedStride2,
+              &CombineIndexedArraysTest::interleavedStride3,
+              &CombineIndexedArraysTest::interleavedStride4,
+              &CombineIndexedArraysTest::interleavedEmpty,
+              &CombineIndexedArraysTest::interleavedLarge,
+              &CombineIndexedArraysTest::interleavedAsArray,
+              &CombineIndexedArraysTest::interleavedAsArrayInvalidStride});
 }
 
 void CombineIndexedArraysTest::wrongIndexCount() {
@@ -87,6 +103,97 @@ void CombineIndexedArraysTest::indexedArrays() {
     CORRADE_COMPARE(array3, (std::vector<UnsignedInt>{6, 7}));
 }
 
+void CombineIndexedArraysTest::interleavedStride2() {
+    /* The example from the documentation */
+    std::vector<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(
+        std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 1, 0, 4, 1, 6, 3, 1, 2, 3, 2, 1}, 2);
+
+    CORRADE_COMPARE(combinedIndices, (std::vector<UnsignedInt>{0, 1, 2, 0, 3, 4, 5, 1, 6}));
+    CORRADE_COMPARE(interleavedArrays, (std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 4, 1, 6, 3, 1, 2, 1}));
+}
+
+void CombineIndexedArraysTest::interleavedStride3() {
+    std::vector<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(
+        std::vector<UnsignedInt>{0, 3, 6, 1, 4, 7, 0, 3, 6, 0, 3, 7}, 3);
+
+    CORRADE_COMPARE(combinedIndices, (std::vector<UnsignedInt>{0, 1, 0, 2}));
+    CORRADE_COMPARE(interleavedArrays, (std::vector<UnsignedInt>{0, 3, 6, 1, 4, 7, 0, 3, 7}));
+}
+
+void CombineIndexedArraysTest::interleavedStride4() {
+    std::vector<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(
+        std::vector<UnsignedInt>{1, 2, 3, 4, 1, 2, 3, 5, 1, 2, 3, 4}, 4);
+
+    CORRADE_COMPARE(combinedIndices, (std::vector<UnsignedInt>{0, 1, 0}));
+    CORRADE_COMPARE(interleavedArrays, (std::vector<UnsignedInt>{1, 2, 3, 4, 1, 2, 3, 5}));
+}
+
+void CombineIndexedArraysTest::interleavedEmpty() {
+    std::vector<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(std::vector<UnsignedInt>{}, 2);
+
+    CORRADE_VERIFY(combinedIndices.empty());
+    CORRADE_VERIFY(interleavedArrays.empty());
+}
+
+void CombineIndexedArraysTest::interleavedLarge() {
+    /* Large enough to be processed in multiple chunks (if there's more than
+       one core), with each combination repeated across chunk boundaries */
+    constexpr UnsignedInt Count = 256*1024;
+    constexpr UnsignedInt UniqueCount = 5003;
+    std::vector<UnsignedInt> input;
+    input.reserve(Count*2);
+    for(UnsignedInt i = 0; i != Count; ++i) {
+        const UnsignedInt j = (i*7919)%UniqueCount;
+        input.push_back(j%97);
+        input.push_back(j);
+    }
+
+    std::vector<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(input, 2);
+
+    CORRADE_COMPARE(combinedIndices.size(), Count);
+    CORRADE_COMPARE(interleavedArrays.size(), UniqueCount*2);
+
+    /* Unique combinations are in order of first occurrence, so the first
+       UniqueCount indices are sequential */
+    for(UnsignedInt i = 0; i != UniqueCount; ++i)
+        CORRADE_COMPARE(combinedIndices[i], i);
+
+    /* All indices point to the original combination */
+    for(UnsignedInt i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(interleavedArrays[combinedIndices[i]*2 + 0], input[i*2 + 0]);
+        CORRADE_COMPARE(interleavedArrays[combinedIndices[i]*2 + 1], input[i*2 + 1]);
+    }
+}
+
+void CombineIndexedArraysTest::interleavedAsArray() {
+    const UnsignedInt data[]{0, 3, 6, 1, 4, 7, 0, 3, 6, 0, 3, 7};
+
+    Containers::Array<UnsignedInt> combinedIndices, interleavedArrays;
+    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArraysAsArray(data, 3);
+
+    CORRADE_COMPARE(std::vector<UnsignedInt>(combinedIndices.begin(), combinedIndices.end()),
+        (std::vector<UnsignedInt>{0, 1, 0, 2}));
+    CORRADE_COMPARE(std::vector<UnsignedInt>(interleavedArrays.begin(), interleavedArrays.end()),
+        (std::vector<UnsignedInt>{0, 3, 6, 1, 4, 7, 0, 3, 7}));
+}
+
+void CombineIndexedArraysTest::interleavedAsArrayInvalidStride() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    const UnsignedInt data[]{0, 1, 2};
+    MeshTools::combineIndexArraysAsArray(data, 0);
+    MeshTools::combineIndexArraysAsArray(data, 2);
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::combineIndexArraysAsArray(): stride can't be zero\n"
+        "MeshTools::combineIndexArraysAsArray(): array size is not divisible by stride\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysTest)
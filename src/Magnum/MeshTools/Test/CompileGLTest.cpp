@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CompileGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit CompileGLTest();
+
+    void packedPositions();
+    void packedPositionsFlat();
+    void packedNormals();
+    void packedTextureCoordinates();
+    void packedTextureCoordinatesOutOfRange();
+};
+
+CompileGLTest::CompileGLTest() {
+    addTests({&CompileGLTest::packedPositions,
+              &CompileGLTest::packedPositionsFlat,
+              &CompileGLTest::packedNormals,
+              &CompileGLTest::packedTextureCoordinates,
+              &CompileGLTest::packedTextureCoordinatesOutOfRange});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+namespace {
+    /* Compiles the mesh and reads the vertex buffer back */
+    Containers::Array<char> compileAndRead(const Trade::MeshData3D& meshData, const CompilePackingFlags packing, Matrix4& dequantization) {
+        Mesh mesh;
+        std::unique_ptr<Buffer> vertices, indices;
+        std::tie(mesh, vertices, indices, dequantization) = compile(meshData, BufferUsage::StaticDraw, packing);
+        return vertices->data();
+    }
+
+    /* Normalized 16-bit unsigned integers, vertex data are not aligned */
+    template<class T> T unpackUnsignedShort(const char* const data) {
+        Math::Vector<T::Size, UnsignedShort> packed;
+        std::memcpy(packed.data(), data, sizeof(packed));
+        return Math::normalize<T>(packed);
+    }
+
+    /* Signed normalized 10-bit components, the W component is unused */
+    Vector3 unpackInt2101010Rev(const char* const data) {
+        UnsignedInt packed;
+        std::memcpy(&packed, data, sizeof(packed));
+
+        Vector3 out;
+        for(std::size_t i = 0; i != 3; ++i)
+            out[i] = Math::max(Float(Int(packed << (22 - i*10)) >> 22)/511.0f, -1.0f);
+        return out;
+    }
+
+    std::vector<Vector3> unpackFloat3(const Containers::Array<char>& data, const std::size_t offset, const std::size_t stride) {
+        std::vector<Vector3> out(data.size()/stride);
+        for(std::size_t i = 0; i != out.size(); ++i)
+            std::memcpy(out[i].data(), data + i*stride + offset, sizeof(Vector3));
+        return out;
+    }
+
+    std::vector<Vector2> unpackFloat2(const Containers::Array<char>& data, const std::size_t offset, const std::size_t stride) {
+        std::vector<Vector2> out(data.size()/stride);
+        for(std::size_t i = 0; i != out.size(); ++i)
+            std::memcpy(out[i].data(), data + i*stride + offset, sizeof(Vector2));
+        return out;
+    }
+}
+#endif
+
+void CompileGLTest::packedPositions() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available in OpenGL ES.");
+    #else
+    /* Non-unit bounding box away from the origin */
+    const std::vector<Vector3> positions{
+        {-2.0f, 3.0f, 10.0f},
+        {6.0f, 4.0f, 12.0f},
+        {1.5f, 3.25f, 11.0f},
+        {0.3f, 3.9f, 10.7f}};
+
+    Matrix4 dequantization;
+    const Containers::Array<char> data = compileAndRead(Trade::MeshData3D{MeshPrimitive::Points, {}, {positions}, {}, {}, nullptr}, CompilePackingFlag::Positions, dequantization);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Three 16-bit components padded to 8 bytes */
+    CORRADE_COMPARE(data.size(), 4*8);
+    CORRADE_COMPARE(dequantization, Matrix4::translation({-2.0f, 3.0f, 10.0f})*Matrix4::scaling({8.0f, 1.0f, 2.0f}));
+
+    /* The dequantized positions are within one quantization step of the
+       original */
+    const Vector3 step = Vector3{8.0f, 1.0f, 2.0f}/65535.0f;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3 decoded = dequantization.transformPoint(unpackUnsignedShort<Vector3>(data + i*8));
+        CORRADE_VERIFY((Math::abs(decoded - positions[i]) <= step).all());
+    }
+
+    /* The bounding box corners are represented exactly */
+    CORRADE_COMPARE(unpackUnsignedShort<Vector3>(data + 0*8), Vector3{});
+    CORRADE_COMPARE(unpackUnsignedShort<Vector3>(data + 1*8), Vector3{1.0f});
+    #endif
+}
+
+void CompileGLTest::packedPositionsFlat() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available in OpenGL ES.");
+    #else
+    /* Flat in Y and Z, the zero extent is treated as unit */
+    const std::vector<Vector3> positions{
+        {1.0f, -1.0f, 5.0f},
+        {3.0f, -1.0f, 5.0f},
+        {2.0f, -1.0f, 5.0f}};
+
+    Matrix4 dequantization;
+    const Containers::Array<char> data = compileAndRead(Trade::MeshData3D{MeshPrimitive::Points, {}, {positions}, {}, {}, nullptr}, CompilePackingFlag::Positions, dequantization);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(data.size(), 3*8);
+    CORRADE_COMPARE(dequantization, Matrix4::translation({1.0f, -1.0f, 5.0f})*Matrix4::scaling({2.0f, 1.0f, 1.0f}));
+
+    /* The flat axes are packed to zero and dequantized back to the original
+       coordinate */
+    const Vector3 step = Vector3{2.0f, 1.0f, 1.0f}/65535.0f;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3 packed = unpackUnsignedShort<Vector3>(data + i*8);
+        CORRADE_COMPARE(packed.yz(), Vector2{});
+
+        const Vector3 decoded = dequantization.transformPoint(packed);
+        CORRADE_VERIFY((Math::abs(decoded - positions[i]) <= step).all());
+    }
+    #endif
+}
+
+void CompileGLTest::packedNormals() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available in OpenGL ES.");
+    #else
+    const std::vector<Vector3> normals{
+        {-1.0f, 0.0f, 1.0f},
+        {1.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, -1.0f},
+        {0.0f, 0.6f, -0.8f}};
+
+    Matrix4 dequantization;
+    const Containers::Array<char> data = compileAndRead(Trade::MeshData3D{MeshPrimitive::Points, {}, {std::vector<Vector3>(4)}, {normals}, {}, nullptr}, CompilePackingFlag::Normals, dequantization);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Positions are kept as floats, normals take 4 bytes */
+    CORRADE_COMPARE(data.size(), 4*16);
+    CORRADE_COMPARE(dequantization, Matrix4{});
+    CORRADE_COMPARE(unpackFloat3(data, 0, 16), std::vector<Vector3>(4));
+
+    /* -1, 0 and +1 are represented exactly, the unused W component is zero */
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(unpackInt2101010Rev(data + i*16 + 12), normals[i]);
+        CORRADE_COMPARE(UnsignedByte(data[i*16 + 15]) >> 6, 0);
+    }
+
+    /* Anything else is within one quantization step */
+    const Vector3 decoded = unpackInt2101010Rev(data + 3*16 + 12);
+    CORRADE_VERIFY((Math::abs(decoded - normals[3]) <= Vector3{1.0f/511.0f}).all());
+    #endif
+}
+
+void CompileGLTest::packedTextureCoordinates() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available in OpenGL ES.");
+    #else
+    const std::vector<Vector2> textureCoordinates{
+        {0.0f, 1.0f},
+        {1.0f, 0.0f},
+        {0.25f, 0.7f}};
+
+    Matrix4 dequantization;
+    const Containers::Array<char> data = compileAndRead(Trade::MeshData3D{MeshPrimitive::Points, {}, {std::vector<Vector3>(3)}, {}, {textureCoordinates}, nullptr}, CompilePackingFlag::TextureCoordinates, dequantization);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Two 16-bit components after the float positions */
+    CORRADE_COMPARE(data.size(), 3*16);
+    CORRADE_COMPARE(unpackUnsignedShort<Vector2>(data + 0*16 + 12), textureCoordinates[0]);
+    CORRADE_COMPARE(unpackUnsignedShort<Vector2>(data + 1*16 + 12), textureCoordinates[1]);
+    const Vector2 decoded = unpackUnsignedShort<Vector2>(data + 2*16 + 12);
+    CORRADE_VERIFY((Math::abs(decoded - textureCoordinates[2]) <= Vector2{1.0f/65535.0f}).all());
+    #endif
+}
+
+void CompileGLTest::packedTextureCoordinatesOutOfRange() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available in OpenGL ES.");
+    #else
+    /* A single coordinate outside of [0, 1] makes all of them floats */
+    const std::vector<Vector2> textureCoordinates{
+        {0.0f, 1.0f},
+        {0.5f, 0.5f},
+        {-0.5f, 2.0f}};
+
+    Matrix4 dequantization;
+    const Containers::Array<char> data = compileAndRead(Trade::MeshData3D{MeshPrimitive::Points, {}, {std::vector<Vector3>(3)}, {}, {textureCoordinates}, nullptr}, CompilePackingFlag::TextureCoordinates, dequantization);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(data.size(), 3*20);
+    CORRADE_COMPARE(unpackFloat2(data, 12, 20), textureCoordinates);
+    #endif
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::MeshTools::Test::CompileGLTest)
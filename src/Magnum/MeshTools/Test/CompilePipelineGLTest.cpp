@@ -0,0 +1,237 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/MeshTools/CompilePipeline.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CompilePipelineGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit CompilePipelineGLTest();
+
+    void construct();
+    void noStages();
+    void removeDuplicates();
+    void removeDuplicatesIndexed();
+    void packAttributes();
+    void uncompressedIndices();
+    void nonTriangles();
+    void multiple();
+    void finishUnknown();
+};
+
+CompilePipelineGLTest::CompilePipelineGLTest() {
+    addTests({&CompilePipelineGLTest::construct,
+              &CompilePipelineGLTest::noStages,
+              &CompilePipelineGLTest::removeDuplicates,
+              &CompilePipelineGLTest::removeDuplicatesIndexed,
+              &CompilePipelineGLTest::packAttributes,
+              &CompilePipelineGLTest::uncompressedIndices,
+              &CompilePipelineGLTest::nonTriangles,
+              &CompilePipelineGLTest::multiple,
+              &CompilePipelineGLTest::finishUnknown});
+}
+
+namespace {
+    /* Two triangles sharing an edge, with each vertex specified separately */
+    Trade::MeshData3D quad() {
+        return Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{
+            {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f},
+            {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}
+        }}, {std::vector<Vector3>(6, Vector3::zAxis())}, {{
+            {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f},
+            {0.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}
+        }}, nullptr};
+    }
+}
+
+void CompilePipelineGLTest::construct() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+
+    CORRADE_COMPARE(pipeline.stages(), CompileStage::RemoveDuplicates|CompileStage::OptimizeVertexCache|CompileStage::OptimizeVertexFetch|CompileStage::PackAttributes|CompileStage::CompressIndices);
+    CORRADE_COMPARE(pipeline.packing(), CompilePackingFlags{});
+    CORRADE_COMPARE(pipeline.usage(), BufferUsage::StaticDraw);
+    CORRADE_COMPARE(pipeline.pendingCount(), 0);
+}
+
+void CompilePipelineGLTest::noStages() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+    pipeline.setStages({});
+
+    const CompilePipeline::Id id = pipeline.add(quad());
+    CORRADE_COMPARE(pipeline.pendingCount(), 1);
+
+    /* Nothing is run until the scheduler is waited on */
+    CORRADE_VERIFY(!pipeline.isFinished(id));
+
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(id);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(pipeline.pendingCount(), 0);
+    CORRADE_VERIFY(!compiled.mesh.isIndexed());
+    CORRADE_VERIFY(!compiled.indices);
+    CORRADE_COMPARE(compiled.mesh.count(), 6);
+    CORRADE_COMPARE(compiled.vertices->size(), 6*32);
+    CORRADE_COMPARE(compiled.dequantization, Matrix4{});
+}
+
+void CompilePipelineGLTest::removeDuplicates() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(pipeline.add(quad()));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Four unique vertices, indices compressed to bytes */
+    CORRADE_VERIFY(compiled.mesh.isIndexed());
+    CORRADE_COMPARE(compiled.mesh.count(), 6);
+    CORRADE_COMPARE(compiled.vertices->size(), 4*32);
+    CORRADE_COMPARE(compiled.indices->size(), 6);
+}
+
+void CompilePipelineGLTest::removeDuplicatesIndexed() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+
+    /* Position 4 is the same as position 0, position 3 isn't used at all */
+    const CompilePipeline::Id id = pipeline.add(Trade::MeshData3D{MeshPrimitive::Triangles,
+        {0, 1, 2, 4, 2, 5}, {{
+            {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f},
+            {5.0f, 5.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}
+        }}, {}, {}, nullptr});
+
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(id);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(compiled.mesh.count(), 6);
+    CORRADE_COMPARE(compiled.vertices->size(), 4*12);
+    CORRADE_COMPARE(compiled.indices->size(), 6);
+}
+
+void CompilePipelineGLTest::packAttributes() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+    pipeline.setPacking(CompilePackingFlag::Positions|CompilePackingFlag::Normals|CompilePackingFlag::TextureCoordinates);
+
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(pipeline.add(quad()));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* 8 bytes for position, 4 for normal and 4 for texture coordinates */
+    CORRADE_COMPARE(compiled.mesh.count(), 6);
+    CORRADE_COMPARE(compiled.vertices->size(), 4*16);
+    /* The quad is in the unit range already and flat extent is treated as
+       unit */
+    CORRADE_COMPARE(compiled.dequantization, Matrix4{});
+
+    /* Packing flags are ignored if the stage is disabled */
+    pipeline.setStages(CompileStage::RemoveDuplicates);
+    CompilePipeline::CompiledMesh unpacked = pipeline.finish(pipeline.add(quad()));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(unpacked.vertices->size(), 4*32);
+    CORRADE_COMPARE(unpacked.indices->size(), 6*4);
+}
+
+void CompilePipelineGLTest::uncompressedIndices() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+    pipeline.setStages(CompileStage::RemoveDuplicates|CompileStage::OptimizeVertexCache|CompileStage::OptimizeVertexFetch);
+
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(pipeline.add(quad()));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(compiled.mesh.count(), 6);
+    CORRADE_COMPARE(compiled.indices->size(), 6*4);
+}
+
+void CompilePipelineGLTest::nonTriangles() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+
+    /* Vertex cache optimization is skipped for lines, the rest works */
+    CompilePipeline::CompiledMesh compiled = pipeline.finish(pipeline.add(Trade::MeshData3D{MeshPrimitive::Lines, {}, {{
+            {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}
+        }}, {}, {}, nullptr}));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(compiled.mesh.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(compiled.mesh.count(), 4);
+    CORRADE_COMPARE(compiled.vertices->size(), 2*12);
+}
+
+void CompilePipelineGLTest::multiple() {
+    TaskScheduler scheduler{2};
+    CompilePipeline pipeline{scheduler};
+
+    const CompilePipeline::Id a = pipeline.add(quad());
+    const CompilePipeline::Id b = pipeline.add(quad());
+    const CompilePipeline::Id c = pipeline.add(quad());
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(b != c);
+    CORRADE_COMPARE(pipeline.pendingCount(), 3);
+
+    /* Finishing in different order than added */
+    scheduler.wait();
+    CORRADE_VERIFY(pipeline.isFinished(b));
+    CompilePipeline::CompiledMesh compiledB = pipeline.finish(b);
+    CompilePipeline::CompiledMesh compiledC = pipeline.finish(c);
+    CompilePipeline::CompiledMesh compiledA = pipeline.finish(a);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(pipeline.pendingCount(), 0);
+    CORRADE_COMPARE(compiledA.mesh.count(), 6);
+    CORRADE_COMPARE(compiledB.mesh.count(), 6);
+    CORRADE_COMPARE(compiledC.mesh.count(), 6);
+
+    /* Added after a wait, the destructor waits for it */
+    pipeline.add(quad());
+}
+
+void CompilePipelineGLTest::finishUnknown() {
+    TaskScheduler scheduler{0};
+    CompilePipeline pipeline{scheduler};
+    const CompilePipeline::Id id = pipeline.add(quad());
+    pipeline.finish(id);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pipeline.isFinished(id);
+    pipeline.finish(id);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::CompilePipeline::isFinished(): unknown mesh ID 0\n"
+        "MeshTools::CompilePipeline::finish(): unknown mesh ID 0\n");
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::MeshTools::Test::CompilePipelineGLTest)
@@ -39,16 +39,28 @@ struct CompressIndicesTest: TestSuite::Tester {
     void compressChar();
     void compressShort();
     void compressInt();
+    void compressEmpty();
+    void compressOffsetChar();
+    void compressOffsetShort();
+    void compressOffsetTooLarge();
+    void compressLarge();
 
     void compressAsShort();
+    void compressAsLarge();
 };
 
 CompressIndicesTest::CompressIndicesTest() {
     addTests({&CompressIndicesTest::compressChar,
               &CompressIndicesTest::compressShort,
               &CompressIndicesTest::compressInt,
-
-              &CompressIndicesTest::compressAsShort});
+              &CompressIndicesTest::compressEmpty,
+              &CompressIndicesTest::compressOffsetChar,
+              &CompressIndicesTest::compressOffsetShort,
+              &CompressIndicesTest::compressOffsetTooLarge,
+              &CompressIndicesTest::compressLarge,
+
+              &CompressIndicesTest::compressAsShort,
+              &CompressIndicesTest::compressAsLarge});
 }
 
 void CompressIndicesTest::compressChar() {
@@ -114,6 +126,89 @@ void CompressIndicesTest::compressInt() {
     }
 }
 
+void CompressIndicesTest::compressEmpty() {
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(
+        std::vector<UnsignedInt>{});
+
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_VERIFY(data.empty());
+}
+
+void CompressIndicesTest::compressOffsetChar() {
+    /* More than 16 values to test the vectorized path as well */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt i = 0; i != 21; ++i) indices.push_back(100000 + i*10);
+
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(indices, 99990);
+
+    CORRADE_COMPARE(start, 10);
+    CORRADE_COMPARE(end, 210);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(data.size(), 21);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        CORRADE_COMPARE(UnsignedByte(data[i]), 10 + i*10);
+}
+
+void CompressIndicesTest::compressOffsetShort() {
+    /* Values over 32767 after the offset to verify that the vectorized
+       narrowing doesn't saturate */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt i = 0; i != 19; ++i) indices.push_back(1000000 + i*3600);
+
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(indices, 1000000);
+
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 64800);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(data.size(), 19*2);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_COMPARE(reinterpret_cast<const UnsignedShort*>(data.data())[i], i*3600);
+}
+
+void CompressIndicesTest::compressOffsetTooLarge() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::compressIndices(std::vector<UnsignedInt>{5, 3, 7}, 4);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndices(): can't offset index 3 by 4\n");
+}
+
+void CompressIndicesTest::compressLarge() {
+    /* Large enough to be processed on multiple threads, with a tail that
+       isn't a multiple of the vector size */
+    std::vector<UnsignedInt> indices(2*1024*1024 + 7);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = 70000 + (i*7919)%60000;
+    indices[1234567] = 69999;
+    indices[indices.size() - 1] = 69999 + 65535;
+
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(indices, 69999);
+
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 65535);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(data.size(), indices.size()*2);
+
+    const UnsignedShort* compressed = reinterpret_cast<const UnsignedShort*>(data.data());
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        if(compressed[i] != indices[i] - 69999) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
 void CompressIndicesTest::compressAsShort() {
     CORRADE_COMPARE_AS(MeshTools::compressIndicesAs<UnsignedShort>({123, 456}),
         Containers::Array<UnsignedShort>::from(123, 456),
@@ -125,6 +220,20 @@ void CompressIndicesTest::compressAsShort() {
     CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesAs(): type too small to represent value 65536\n");
 }
 
+void CompressIndicesTest::compressAsLarge() {
+    std::vector<UnsignedInt> indices(1024*1024 + 13);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = (i*31)%256;
+
+    const Containers::Array<UnsignedByte> compressed = MeshTools::compressIndicesAs<UnsignedByte>(indices);
+    CORRADE_COMPARE(compressed.size(), indices.size());
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        if(compressed[i] != indices[i]) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateSmoothNormalsTest: TestSuite::Tester {
+    explicit GenerateSmoothNormalsTest();
+
+    void wrongIndexCount();
+    void flat();
+    void smooth();
+    void crease();
+    void creaseLarge();
+    void degenerate();
+};
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::flat,
+              &GenerateSmoothNormalsTest::smooth,
+              &GenerateSmoothNormalsTest::crease,
+              &GenerateSmoothNormalsTest::creaseLarge,
+              &GenerateSmoothNormalsTest::degenerate});
+}
+
+namespace {
+
+/* Two faces sharing the edge between vertices 0 and 1, one with +Z normal and
+   the other with -Y normal */
+const std::vector<UnsignedInt> TentIndices{
+    0, 1, 2,
+    1, 0, 3
+};
+
+const std::vector<Vector3> TentPositions{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f}
+};
+
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals({
+        0, 1
+    }, {});
+
+    CORRADE_COMPARE(indices.size(), 0);
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n");
+}
+
+void GenerateSmoothNormalsTest::flat() {
+    /* Quad made of two triangles, all normals should be the same */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals({
+        0, 1, 2,
+        0, 2, 3
+    }, {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    });
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        0, 2, 3
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::smooth() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals(TentIndices, TentPositions);
+
+    /* Both faces have the same corner angle at the shared vertices */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        1, 0, 3
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{0.0f, -1.0f, 1.0f}.normalized(),
+        Vector3{0.0f, -1.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        -Vector3::yAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::crease() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals(TentIndices, TentPositions, Rad(Deg(45.0f)));
+
+    /* The faces are at right angle, so the shared vertices get two normals */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 2, 4,
+        3, 1, 5
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3::zAxis(),
+        -Vector3::yAxis(),
+        Vector3::zAxis(),
+        -Vector3::yAxis(),
+        Vector3::zAxis(),
+        -Vector3::yAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::creaseLarge() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals(TentIndices, TentPositions, Rad(Deg(135.0f)));
+
+    /* Same as without crease */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        1, 0, 3
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{0.0f, -1.0f, 1.0f}.normalized(),
+        Vector3{0.0f, -1.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        -Vector3::yAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::degenerate() {
+    /* The second face has zero area and shouldn't affect anything */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals({
+        0, 1, 2,
+        0, 1, 1
+    }, {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    });
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        0, 1, 1
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis()
+    }));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
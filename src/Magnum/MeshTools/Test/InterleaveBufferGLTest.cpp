@@ -0,0 +1,74 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MeshTools/InterleaveBuffer.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct InterleaveBufferGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit InterleaveBufferGLTest();
+
+    void interleaveInto();
+};
+
+InterleaveBufferGLTest::InterleaveBufferGLTest() {
+    addTests({&InterleaveBufferGLTest::interleaveInto});
+}
+
+void InterleaveBufferGLTest::interleaveInto() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::EXT::map_buffer_range::string() + std::string(" is not supported"));
+    #endif
+
+    constexpr UnsignedShort data[] = {0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::DynamicDraw);
+
+    /* Interleaving into a range, the data around should stay untouched */
+    CORRADE_VERIFY(MeshTools::interleaveInto(buffer, 2,
+        std::vector<UnsignedShort>{1, 3, 5},
+        std::vector<UnsignedShort>{2, 4, 6}));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<UnsignedShort> contents = buffer.data<UnsignedShort>();
+    CORRADE_COMPARE(std::vector<UnsignedShort>(contents.begin(), contents.end()),
+        (std::vector<UnsignedShort>{0xffff, 1, 2, 3, 4, 5, 6}));
+    #endif
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::MeshTools::Test::InterleaveBufferGLTest)
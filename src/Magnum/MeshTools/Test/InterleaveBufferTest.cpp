@@ -0,0 +1,118 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/MeshTools/InterleaveBuffer.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct InterleaveBufferTest: Corrade::TestSuite::Tester {
+    explicit InterleaveBufferTest();
+
+    void interleaveIntoParallel();
+    void interleaveIntoParallelLarge();
+    void interleaveIntoParallelOnlyGaps();
+    void interleaveIntoParallelTooSmall();
+};
+
+InterleaveBufferTest::InterleaveBufferTest() {
+    addTests({&InterleaveBufferTest::interleaveIntoParallel,
+              &InterleaveBufferTest::interleaveIntoParallelLarge,
+              &InterleaveBufferTest::interleaveIntoParallelOnlyGaps,
+              &InterleaveBufferTest::interleaveIntoParallelTooSmall});
+}
+
+void InterleaveBufferTest::interleaveIntoParallel() {
+    auto data = Containers::Array<char>::from(
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77
+    );
+
+    MeshTools::interleaveIntoParallel(data, 2, std::vector<Int>{4, 5, 6, 7}, 1, std::vector<Short>{0, 1, 2, 3}, 3);
+
+    if(!Utility::Endianness::isBigEndian()) {
+        /*  _______gap, int___________________, _gap, short_____, _____________gap */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x04, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x05, 0x00, 0x00, 0x00, 0x55, 0x01, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x06, 0x00, 0x00, 0x00, 0x55, 0x02, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x07, 0x00, 0x00, 0x00, 0x55, 0x03, 0x00, 0x33, 0x55, 0x77
+        }));
+    } else {
+        /*  _______gap, ___________________int, _gap, _____short, _____________gap */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x04, 0x55, 0x00, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x05, 0x55, 0x00, 0x01, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x06, 0x55, 0x00, 0x02, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x07, 0x55, 0x00, 0x03, 0x33, 0x55, 0x77
+        }));
+    }
+}
+
+void InterleaveBufferTest::interleaveIntoParallelLarge() {
+    /* Large enough to be split into more chunks on multi-core machines, the
+       output must be the same as from the serial version */
+    std::vector<UnsignedInt> a(200000);
+    std::vector<UnsignedShort> b(a.size());
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        a[i] = UnsignedInt(i*7);
+        b[i] = UnsignedShort(i);
+    }
+
+    Containers::Array<char> expected{Containers::ValueInit, a.size()*8};
+    MeshTools::interleaveInto(expected, a, 1, b, 1);
+
+    Containers::Array<char> actual{Containers::ValueInit, a.size()*8};
+    MeshTools::interleaveIntoParallel(actual, a, 1, b, 1);
+
+    CORRADE_VERIFY(std::equal(actual.begin(), actual.end(), expected.begin()));
+}
+
+void InterleaveBufferTest::interleaveIntoParallelOnlyGaps() {
+    auto data = Containers::Array<char>::from(0x11, 0x33, 0x55);
+
+    /* Nothing to write, the buffer is left untouched */
+    MeshTools::interleaveIntoParallel(data, 2, 1);
+    CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{0x11, 0x33, 0x55}));
+}
+
+void InterleaveBufferTest::interleaveIntoParallelTooSmall() {
+    Containers::Array<char> data{7};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveIntoParallel(data, std::vector<Int>{4, 5}, std::vector<Short>{0, 1});
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveIntoParallel(): the data buffer is too small, expected 12 but got 7\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveBufferTest)
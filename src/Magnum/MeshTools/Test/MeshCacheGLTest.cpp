@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/MeshCache.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshCacheGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit MeshCacheGLTest();
+
+    void get2D();
+    void get3D();
+    void differentArguments();
+    void differentGenerators();
+    void prune();
+    void clear();
+};
+
+MeshCacheGLTest::MeshCacheGLTest() {
+    addTests({&MeshCacheGLTest::get2D,
+              &MeshCacheGLTest::get3D,
+              &MeshCacheGLTest::differentArguments,
+              &MeshCacheGLTest::differentGenerators,
+              &MeshCacheGLTest::prune,
+              &MeshCacheGLTest::clear});
+}
+
+namespace {
+    UnsignedInt generatorCallCount = 0;
+
+    Trade::MeshData2D line2D() {
+        ++generatorCallCount;
+        return Trade::MeshData2D{MeshPrimitive::Lines, {}, {{{0.0f, 0.0f}, {1.0f, 0.0f}}}, {}, nullptr};
+    }
+
+    Trade::MeshData3D triangle3D(const UnsignedInt count, const Float scale) {
+        ++generatorCallCount;
+        std::vector<Vector3> positions;
+        for(UnsignedInt i = 0; i != count*3; ++i)
+            positions.push_back(Vector3::xAxis(Float(i)*scale));
+        return Trade::MeshData3D{MeshPrimitive::Triangles, {}, {positions}, {}, {}, nullptr};
+    }
+
+    Trade::MeshData3D indexedTriangle3D(const UnsignedInt count, const Float scale) {
+        ++generatorCallCount;
+        std::vector<UnsignedInt> indices;
+        for(UnsignedInt i = 0; i != count*3; ++i) indices.push_back(0);
+        return Trade::MeshData3D{MeshPrimitive::Triangles, indices, {{Vector3::xAxis(scale)}}, {}, {}, nullptr};
+    }
+}
+
+void MeshCacheGLTest::get2D() {
+    generatorCallCount = 0;
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(line2D);
+    std::shared_ptr<MeshCache::CompiledMesh> b = cache.get(line2D);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(a == b);
+    CORRADE_COMPARE(a->mesh.count(), 2);
+    CORRADE_VERIFY(a->vertices);
+    CORRADE_VERIFY(!a->indices);
+    CORRADE_COMPARE(generatorCallCount, 1);
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void MeshCacheGLTest::get3D() {
+    generatorCallCount = 0;
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(indexedTriangle3D, 2, 1.0f);
+    std::shared_ptr<MeshCache::CompiledMesh> b = cache.get(indexedTriangle3D, 2, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(a == b);
+    CORRADE_COMPARE(a->mesh.count(), 6);
+    CORRADE_VERIFY(a->mesh.isIndexed());
+    CORRADE_VERIFY(a->indices);
+    CORRADE_COMPARE(generatorCallCount, 1);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void MeshCacheGLTest::differentArguments() {
+    generatorCallCount = 0;
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(triangle3D, 1, 1.0f);
+    std::shared_ptr<MeshCache::CompiledMesh> b = cache.get(triangle3D, 2, 1.0f);
+    std::shared_ptr<MeshCache::CompiledMesh> c = cache.get(triangle3D, 1, 2.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(a != c);
+    CORRADE_VERIFY(b != c);
+    CORRADE_COMPARE(a->mesh.count(), 3);
+    CORRADE_COMPARE(b->mesh.count(), 6);
+    CORRADE_COMPARE(generatorCallCount, 3);
+    CORRADE_COMPARE(cache.size(), 3);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+}
+
+void MeshCacheGLTest::differentGenerators() {
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(triangle3D, 1, 1.0f);
+    std::shared_ptr<MeshCache::CompiledMesh> b = cache.get(indexedTriangle3D, 1, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(!a->mesh.isIndexed());
+    CORRADE_VERIFY(b->mesh.isIndexed());
+    CORRADE_COMPARE(cache.size(), 2);
+}
+
+void MeshCacheGLTest::prune() {
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(triangle3D, 1, 1.0f);
+    cache.get(triangle3D, 2, 1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.size(), 2);
+
+    /* Only the mesh that's not used outside is removed */
+    CORRADE_COMPARE(cache.prune(), 1);
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_VERIFY(cache.get(triangle3D, 1, 1.0f) == a);
+}
+
+void MeshCacheGLTest::clear() {
+    MeshCache cache;
+
+    std::shared_ptr<MeshCache::CompiledMesh> a = cache.get(triangle3D, 1, 1.0f);
+    cache.clear();
+    CORRADE_COMPARE(cache.size(), 0);
+
+    /* The mesh is still alive for its user, a new one is created */
+    CORRADE_COMPARE(a->mesh.count(), 3);
+    CORRADE_VERIFY(cache.get(triangle3D, 1, 1.0f) != a);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshCacheGLTest)
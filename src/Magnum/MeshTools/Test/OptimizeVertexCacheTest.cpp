@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/AnalyzeVertexCache.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct OptimizeVertexCacheTest: TestSuite::Tester {
+    explicit OptimizeVertexCacheTest();
+
+    void wrongIndexCount();
+    void cacheTooSmall();
+    void indexOutOfBounds();
+
+    void empty();
+    void degenerate();
+    void grid();
+};
+
+OptimizeVertexCacheTest::OptimizeVertexCacheTest() {
+    addTests({&OptimizeVertexCacheTest::wrongIndexCount,
+              &OptimizeVertexCacheTest::cacheTooSmall,
+              &OptimizeVertexCacheTest::indexOutOfBounds,
+
+              &OptimizeVertexCacheTest::empty,
+              &OptimizeVertexCacheTest::degenerate,
+              &OptimizeVertexCacheTest::grid});
+}
+
+namespace {
+    /* Triangle grid with triangles in scrambled order */
+    std::vector<UnsignedInt> scrambledGrid(const UnsignedInt size) {
+        std::vector<UnsignedInt> grid;
+        for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt i = y*(size + 1) + x;
+            grid.insert(grid.end(), {i, i + size + 2, i + 1,
+                                     i, i + size + 1, i + size + 2});
+        }
+
+        /* 97 is coprime with the triangle count, so this is a permutation */
+        const std::size_t triangleCount = grid.size()/3;
+        std::vector<UnsignedInt> scrambled;
+        for(std::size_t t = 0; t != triangleCount; ++t) {
+            const std::size_t source = (t*97)%triangleCount;
+            scrambled.insert(scrambled.end(), grid.begin() + source*3, grid.begin() + source*3 + 3);
+        }
+
+        return scrambled;
+    }
+
+    std::vector<std::vector<UnsignedInt>> sortedTriangles(const std::vector<UnsignedInt>& indices) {
+        std::vector<std::vector<UnsignedInt>> triangles;
+        for(std::size_t i = 0; i != indices.size(); i += 3)
+            triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+void OptimizeVertexCacheTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::optimizeVertexCache(indices, 2);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexCache(): index count is not divisible by 3\n");
+}
+
+void OptimizeVertexCacheTest::cacheTooSmall() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::optimizeVertexCache(indices, 3, 2);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexCache(): cache size has to be at least 3\n");
+}
+
+void OptimizeVertexCacheTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    MeshTools::optimizeVertexCache(indices, 3);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexCache(): index 3 out of bounds for 3 vertices\n");
+}
+
+void OptimizeVertexCacheTest::empty() {
+    std::vector<UnsignedInt> indices;
+    MeshTools::optimizeVertexCache(indices, 0);
+
+    CORRADE_VERIFY(indices.empty());
+}
+
+void OptimizeVertexCacheTest::degenerate() {
+    /* Degenerate triangles and unreferenced vertices shouldn't cause any
+       trouble */
+    std::vector<UnsignedInt> indices{
+        0, 0, 0,
+        5, 1, 5,
+        0, 1, 5};
+    MeshTools::optimizeVertexCache(indices, 7);
+
+    CORRADE_COMPARE(sortedTriangles(indices), (std::vector<std::vector<UnsignedInt>>{
+        {0, 0, 0}, {0, 1, 5}, {5, 1, 5}}));
+}
+
+void OptimizeVertexCacheTest::grid() {
+    const std::vector<UnsignedInt> original = scrambledGrid(16);
+    const UnsignedInt vertexCount = 17*17;
+
+    std::vector<UnsignedInt> indices = original;
+    MeshTools::optimizeVertexCache(indices, vertexCount, 16);
+
+    /* All triangles are preserved, including their winding */
+    CORRADE_COMPARE(sortedTriangles(indices), sortedTriangles(original));
+
+    /* The scrambled grid has ACMR of 3.0, a perfectly ordered infinite grid
+       would have 0.5 */
+    CORRADE_COMPARE(MeshTools::analyzeVertexCache(original, vertexCount, 16).acmr, 3.0f);
+    CORRADE_VERIFY(MeshTools::analyzeVertexCache(indices, vertexCount, 16).acmr < 0.75f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexCacheTest)
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct OptimizeVertexFetchTest: TestSuite::Tester {
+    explicit OptimizeVertexFetchTest();
+
+    void indexOutOfBounds();
+    void attributeSizeMismatch();
+
+    void optimize();
+    void optimizeAttributes();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::indexOutOfBounds,
+              &OptimizeVertexFetchTest::attributeSizeMismatch,
+
+              &OptimizeVertexFetchTest::optimize,
+              &OptimizeVertexFetchTest::optimizeAttributes});
+}
+
+void OptimizeVertexFetchTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    MeshTools::optimizeVertexFetch(indices, 3);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexFetch(): index 3 out of bounds for 3 vertices\n");
+}
+
+void OptimizeVertexFetchTest::attributeSizeMismatch() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    std::vector<Int> a{0, 1, 2};
+    std::vector<Float> b{0.0f, 1.0f};
+    MeshTools::optimizeVertexFetch(indices, a, b);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same size\n");
+}
+
+void OptimizeVertexFetchTest::optimize() {
+    /* Vertex 2 is not referenced */
+    std::vector<UnsignedInt> indices{
+        4, 1, 3,
+        3, 1, 0,
+        0, 4, 3};
+    const std::vector<UnsignedInt> remap = MeshTools::optimizeVertexFetch(indices, 5);
+
+    CORRADE_COMPARE(remap, (std::vector<UnsignedInt>{4, 1, 3, 0}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        2, 1, 3,
+        3, 0, 2}));
+}
+
+void OptimizeVertexFetchTest::optimizeAttributes() {
+    std::vector<UnsignedInt> indices{
+        4, 1, 3,
+        3, 1, 0,
+        0, 4, 3};
+    std::vector<Int> a{0, 10, 20, 30, 40};
+    std::vector<Float> b{0.0f, 0.5f, 1.0f, 1.5f, 2.0f};
+    MeshTools::optimizeVertexFetch(indices, a, b);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        2, 1, 3,
+        3, 0, 2}));
+    CORRADE_COMPARE(a, (std::vector<Int>{40, 10, 30, 0}));
+    CORRADE_COMPARE(b, (std::vector<Float>{2.0f, 0.5f, 1.5f, 0.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <unordered_map>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct RemoveDuplicatesBenchmark: TestSuite::Tester {
+    explicit RemoveDuplicatesBenchmark();
+
+    void removeDuplicates();
+    void removeDuplicatesUnorderedMap();
+};
+
+RemoveDuplicatesBenchmark::RemoveDuplicatesBenchmark() {
+    addBenchmarks<RemoveDuplicatesBenchmark>({&RemoveDuplicatesBenchmark::removeDuplicates,
+                                              &RemoveDuplicatesBenchmark::removeDuplicatesUnorderedMap}, 10);
+}
+
+namespace {
+
+/* Grid of 64x64x64 points, each of them present three times with a slight
+   offset, in a scattered order */
+std::vector<Vector3> data() {
+    std::vector<Vector3> out;
+    out.reserve(3*64*64*64);
+    for(const Vector3& offset: {Vector3{}, Vector3::xAxis(0.01f), Vector3::zAxis(-0.01f)})
+        for(UnsignedInt i = 0; i != 64*64*64; ++i) {
+            const UnsignedInt j = (i*40503)%(64*64*64);
+            out.push_back(Vector3(j%64, (j/64)%64, j/(64*64)) + offset);
+        }
+    return out;
+}
+
+/* The original std::unordered_map-based implementation, for comparison */
+template<std::size_t size> struct MurmurVectorHash {
+    std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
+        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+    }
+};
+
+template<class Vector> std::vector<UnsignedInt> removeDuplicatesReference(std::vector<Vector>& data, typename Vector::Type epsilon) {
+    Vector min = data[0], max = data[0];
+    for(const auto& v: data) {
+        min = Math::min(v, min);
+        max = Math::max(v, max);
+    }
+
+    std::vector<UnsignedInt> resultIndices(data.size());
+    std::iota(resultIndices.begin(), resultIndices.end(), 0);
+    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, MurmurVectorHash<Vector::Size>> table(data.size());
+    std::vector<UnsignedInt> indices;
+    indices.reserve(data.size());
+
+    Vector moved;
+    for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
+        for(std::size_t i = 0; i != data.size(); ++i) {
+            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
+            const auto result = table.emplace(v, table.size());
+            indices.push_back(result.first->second);
+            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
+        }
+
+        data.resize(table.size());
+        for(auto& i: resultIndices) i = indices[i];
+        if(moving == Vector::Size) continue;
+
+        moved = Vector();
+        moved[moving] = epsilon/2;
+        table.clear();
+        indices.clear();
+    }
+
+    return resultIndices;
+}
+
+}
+
+void RemoveDuplicatesBenchmark::removeDuplicates() {
+    const std::vector<Vector3> original = data();
+    std::vector<Vector3> unique;
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        unique = original;
+        indices = MeshTools::removeDuplicates(unique, 0.1f);
+    }
+
+    CORRADE_COMPARE(unique.size(), 64*64*64);
+
+    /* Verify the same semantics as the original implementation */
+    std::vector<Vector3> expectedUnique = original;
+    const std::vector<UnsignedInt> expectedIndices = removeDuplicatesReference(expectedUnique, 0.1f);
+    CORRADE_COMPARE(indices, expectedIndices);
+    CORRADE_COMPARE(unique, expectedUnique);
+}
+
+void RemoveDuplicatesBenchmark::removeDuplicatesUnorderedMap() {
+    const std::vector<Vector3> original = data();
+    std::vector<Vector3> unique;
+    CORRADE_BENCHMARK(1) {
+        unique = original;
+        removeDuplicatesReference(unique, 0.1f);
+    }
+
+    CORRADE_COMPARE(unique.size(), 64*64*64);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesBenchmark)
@@ -26,6 +26,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -34,10 +35,14 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     explicit RemoveDuplicatesTest();
 
     void removeDuplicates();
+    void removeDuplicatesEmpty();
+    void removeDuplicatesLarge();
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::removeDuplicates});
+    addTests({&RemoveDuplicatesTest::removeDuplicates,
+              &RemoveDuplicatesTest::removeDuplicatesEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesLarge});
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -59,6 +64,34 @@ void RemoveDuplicatesTest::removeDuplicates() {
     }));
 }
 
+void RemoveDuplicatesTest::removeDuplicatesEmpty() {
+    std::vector<Vector3> data;
+    CORRADE_VERIFY(MeshTools::removeDuplicates(data).empty());
+    CORRADE_VERIFY(data.empty());
+}
+
+void RemoveDuplicatesTest::removeDuplicatesLarge() {
+    /* Grid of 32x32x32 points, each of them four times with a slight offset
+       in a different direction, enough to exercise collisions in the table */
+    std::vector<Vector3> data;
+    for(const Vector3& offset: {Vector3{}, Vector3::xAxis(0.01f), Vector3::yAxis(-0.01f), Vector3::zAxis(0.01f)})
+        for(Int z = 0; z != 32; ++z) for(Int y = 0; y != 32; ++y) for(Int x = 0; x != 32; ++x)
+            data.push_back(Vector3(x, y, z) + offset);
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, 0.1f);
+    CORRADE_COMPARE(data.size(), 32*32*32);
+    CORRADE_COMPARE(indices.size(), 4*32*32*32);
+
+    /* The first occurence is kept, all offset copies point to it */
+    for(std::size_t i = 0; i != 32*32*32; ++i) {
+        CORRADE_COMPARE(indices[i], i);
+        CORRADE_COMPARE(indices[i + 1*32*32*32], i);
+        CORRADE_COMPARE(indices[i + 2*32*32*32], i);
+        CORRADE_COMPARE(indices[i + 3*32*32*32], i);
+    }
+    CORRADE_COMPARE(data[32*32*32 - 1], (Vector3{31.0f, 31.0f, 31.0f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,187 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/SceneCache.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/FlatSceneData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SceneCacheTest: TestSuite::Tester {
+    explicit SceneCacheTest();
+
+    void mesh();
+    void meshFailed();
+    void image();
+    void texture();
+    void instanceGroups();
+    void meshKey();
+};
+
+SceneCacheTest::SceneCacheTest() {
+    addTests({&SceneCacheTest::mesh,
+              &SceneCacheTest::meshFailed,
+              &SceneCacheTest::image,
+              &SceneCacheTest::texture,
+              &SceneCacheTest::instanceGroups,
+              &SceneCacheTest::meshKey});
+}
+
+namespace {
+    /* Meshes 0 and 2 are the same, mesh 3 fails to import. Images 0 and 1
+       are the same, textures 0 and 2 reference different but equivalent
+       images and texture 1 has different sampler parameters. */
+    class Importer: public Trade::AbstractImporter {
+        public:
+            UnsignedInt meshImportCount = 0;
+
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            UnsignedInt doMesh3DCount() const override { return 4; }
+            std::optional<Trade::MeshData3D> doMesh3D(UnsignedInt id) override {
+                ++meshImportCount;
+                if(id == 3) return std::nullopt;
+                return Trade::MeshData3D{MeshPrimitive::Triangles, {0, 1, 2}, {{
+                    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, id == 1 ? 2.0f : 1.0f, 0.0f}
+                }}, {}, {}};
+            }
+
+            UnsignedInt doImage2DCount() const override { return 3; }
+            std::optional<Trade::ImageData2D> doImage2D(UnsignedInt id) override {
+                Containers::Array<char> data{4};
+                for(char& i: data) i = id == 2 ? '\x33' : '\xff';
+                return Trade::ImageData2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, std::move(data)};
+            }
+
+            UnsignedInt doTextureCount() const override { return 3; }
+            std::optional<Trade::TextureData> doTexture(UnsignedInt id) override {
+                return Trade::TextureData{Trade::TextureData::Type::Texture2D,
+                    id == 1 ? Sampler::Filter::Nearest : Sampler::Filter::Linear,
+                    Sampler::Filter::Linear, Sampler::Mipmap::Base,
+                    Sampler::Wrapping::ClampToEdge, id == 2 ? 1u : 0u};
+            }
+    };
+}
+
+void SceneCacheTest::mesh() {
+    Importer importer;
+    SceneCache cache{importer};
+
+    CORRADE_COMPARE(cache.mesh3D(0), 0);
+    CORRADE_COMPARE(cache.mesh3D(1), 1);
+    CORRADE_COMPARE(cache.mesh3D(2), 0);
+    CORRADE_COMPARE(cache.duplicateCount(), 1);
+
+    /* Each mesh is imported only once */
+    CORRADE_COMPARE(cache.mesh3D(2), 0);
+    CORRADE_COMPARE(importer.meshImportCount, 3);
+
+    CORRADE_COMPARE(cache.mesh3DData(1).positions(0)[2], (Vector3{0.0f, 2.0f, 0.0f}));
+}
+
+void SceneCacheTest::meshFailed() {
+    Importer importer;
+    SceneCache cache{importer};
+
+    CORRADE_COMPARE(cache.mesh3D(3), -1);
+    CORRADE_COMPARE(cache.mesh3D(3), -1);
+    CORRADE_COMPARE(importer.meshImportCount, 1);
+}
+
+void SceneCacheTest::image() {
+    Importer importer;
+    SceneCache cache{importer};
+
+    CORRADE_COMPARE(cache.image2D(0), 0);
+    CORRADE_COMPARE(cache.image2D(1), 0);
+    CORRADE_COMPARE(cache.image2D(2), 2);
+    CORRADE_COMPARE(cache.duplicateCount(), 1);
+    CORRADE_COMPARE(cache.image2DData(2).data()[0], '\x33');
+}
+
+void SceneCacheTest::texture() {
+    Importer importer;
+    SceneCache cache{importer};
+
+    /* Texture 2 references image 1, which is the same as image 0 */
+    CORRADE_COMPARE(cache.texture(0), 0);
+    CORRADE_COMPARE(cache.texture(1), 1);
+    CORRADE_COMPARE(cache.texture(2), 0);
+    CORRADE_COMPARE(cache.duplicateCount(), 2);
+    CORRADE_COMPARE(cache.textureData(1).minificationFilter(), Sampler::Filter::Nearest);
+}
+
+void SceneCacheTest::instanceGroups() {
+    Importer importer;
+    SceneCache cache{importer};
+
+    Trade::FlatSceneData3D scene{
+        {0, 1, 2, 3, 4, 5, 6},
+        {-1, 0, 0, -1, 3, 3, -1},
+        std::vector<Matrix4>(7),
+        {Trade::ObjectInstanceType3D::Empty,
+         Trade::ObjectInstanceType3D::Mesh,
+         Trade::ObjectInstanceType3D::Mesh,
+         Trade::ObjectInstanceType3D::Mesh,
+         Trade::ObjectInstanceType3D::Mesh,
+         Trade::ObjectInstanceType3D::Mesh,
+         Trade::ObjectInstanceType3D::Mesh},
+        {-1, 0, 1, 2, 0, 3, 1},
+        {-1, 5, 5, 5, 4, 5, 5}};
+
+    /* Objects 1 and 3 use the same mesh content with the same material,
+       object 4 has a different material, object 5 has a broken mesh */
+    std::vector<SceneCache::InstanceGroup> groups = cache.instanceGroups(scene);
+    CORRADE_COMPARE(groups.size(), 2);
+    CORRADE_COMPARE(groups[0].mesh, 0);
+    CORRADE_COMPARE(groups[0].material, 5);
+    CORRADE_COMPARE(groups[0].objects, (std::vector<UnsignedInt>{1, 3}));
+    CORRADE_COMPARE(groups[1].mesh, 1);
+    CORRADE_COMPARE(groups[1].material, 5);
+    CORRADE_COMPARE(groups[1].objects, (std::vector<UnsignedInt>{2, 6}));
+}
+
+void SceneCacheTest::meshKey() {
+    Importer importer;
+    SceneCache a{importer, "a/"};
+    SceneCache b{importer, "b/"};
+
+    CORRADE_COMPARE(a.meshKey(2), a.meshKey(0));
+    CORRADE_VERIFY(a.meshKey(1) != a.meshKey(0));
+    CORRADE_VERIFY(a.meshKey(0) != b.meshKey(0));
+    CORRADE_COMPARE(a.meshKey(0), ResourceKey{"a/mesh3D/0"});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SceneCacheTest)
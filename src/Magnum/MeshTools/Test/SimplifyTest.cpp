@@ -0,0 +1,257 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void wrongIndexCount();
+    void indexOutOfBounds();
+    void attributeSizeMismatch();
+    void lodsNotIndexed();
+
+    void empty();
+    void planar();
+    void border();
+    void targetError();
+    void seam();
+    void lods();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::wrongIndexCount,
+              &SimplifyTest::indexOutOfBounds,
+              &SimplifyTest::attributeSizeMismatch,
+              &SimplifyTest::lodsNotIndexed,
+
+              &SimplifyTest::empty,
+              &SimplifyTest::planar,
+              &SimplifyTest::border,
+              &SimplifyTest::targetError,
+              &SimplifyTest::seam,
+              &SimplifyTest::lods});
+}
+
+namespace {
+    /* Grid of size*size quads in the XY plane, facing +Z, with height given
+       by a function */
+    template<class F> void makeGrid(const UnsignedInt size, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions, F height) {
+        for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x)
+            positions.push_back({Float(x), Float(y), height(x, y)});
+        for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt i = y*(size + 1) + x;
+            indices.insert(indices.end(), {i, i + 1, i + size + 2,
+                                           i, i + size + 2, i + size + 1});
+        }
+    }
+
+    Float flat(UnsignedInt, UnsignedInt) { return 0.0f; }
+
+    /* Vertices that are on the border of the grid */
+    bool isBorder(const Vector3& p, const UnsignedInt size) {
+        return p.x() == 0.0f || p.y() == 0.0f || p.x() == Float(size) || p.y() == Float(size);
+    }
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::simplify(indices, {{}, {}}, 0);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): index count is not divisible by 3\n");
+}
+
+void SimplifyTest::indexOutOfBounds() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    MeshTools::simplify(indices, {{}, {}, {}}, 0);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): index 3 out of bounds for 3 vertices\n");
+}
+
+void SimplifyTest::attributeSizeMismatch() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::simplify(indices, {{}, {}, {}}, 0, Constants::inf(), {{}, {}});
+    MeshTools::simplify(indices, {{}, {}, {}}, 0, Constants::inf(), {}, {{}});
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::simplify(): attribute arrays don't have the same size as positions\n"
+        "MeshTools::simplify(): attribute arrays don't have the same size as positions\n");
+}
+
+void SimplifyTest::lodsNotIndexed() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    Trade::MeshData3D data{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}};
+    MeshTools::generateLods(data, 3);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateLods(): expected indexed triangle mesh\n");
+}
+
+void SimplifyTest::empty() {
+    std::vector<UnsignedInt> indices;
+    CORRADE_COMPARE(MeshTools::simplify(indices, {}, 0), 0.0f);
+    CORRADE_VERIFY(indices.empty());
+}
+
+void SimplifyTest::planar() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(16, indices, positions, flat);
+
+    /* Everything inside is coplanar, so it can be collapsed without any
+       error down to the border */
+    const Float error = MeshTools::simplify(indices, positions, 0);
+    CORRADE_VERIFY(error < 1.0e-5f);
+    CORRADE_VERIFY(indices.size() < 16*16*6/4);
+
+    /* All triangles still face +Z */
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3 normal = Math::cross(positions[indices[i + 2]] - positions[indices[i + 1]], positions[indices[i]] - positions[indices[i + 1]]);
+        CORRADE_VERIFY(normal.z() > 0.0f);
+    }
+}
+
+void SimplifyTest::border() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(8, indices, positions, flat);
+
+    MeshTools::simplify(indices, positions, 0);
+
+    /* All border vertices are still referenced, no interior vertices are */
+    std::vector<bool> used(positions.size());
+    for(const UnsignedInt index: indices) used[index] = true;
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        CORRADE_COMPARE(bool(used[i]), isBorder(positions[i], 8));
+}
+
+void SimplifyTest::targetError() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(8, indices, positions, [](UnsignedInt x, UnsignedInt y) {
+        return (x + y) % 2 ? 0.5f : 0.0f;
+    });
+
+    /* Bumpy surface, error threshold limits the collapses */
+    const std::size_t originalSize = indices.size();
+    CORRADE_VERIFY(MeshTools::simplify(indices, positions, 0, 0.001f) <= 0.001f);
+    const std::size_t limitedSize = indices.size();
+    CORRADE_VERIFY(limitedSize > 8*2*3);
+
+    /* Without threshold it's simplified further, error is above it */
+    const Float error = MeshTools::simplify(indices, positions, 0);
+    CORRADE_VERIFY(indices.size() < limitedSize);
+    CORRADE_VERIFY(limitedSize <= originalSize);
+    CORRADE_VERIFY(error > 0.001f);
+}
+
+void SimplifyTest::seam() {
+    /* Two halves of a flat grid with a duplicated column of vertices in the
+       middle, having different texture coordinates on each side */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(8, indices, positions, flat);
+    std::vector<Vector2> textureCoordinates(positions.size());
+    for(UnsignedInt y = 0; y <= 8; ++y) {
+        positions.push_back({4.0f, Float(y), 0.0f});
+        textureCoordinates.push_back({1.0f, 0.0f});
+    }
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const bool right = positions[indices[i]].x() + positions[indices[i + 1]].x() + positions[indices[i + 2]].x() > 12.0f;
+        if(!right) continue;
+        for(std::size_t j = 0; j != 3; ++j) if(positions[indices[i + j]].x() == 4.0f)
+            indices[i + j] = 81 + indices[i + j]/9;
+    }
+
+    MeshTools::simplify(indices, positions, 0, Constants::inf(), {}, textureCoordinates);
+
+    /* All seam vertices are still there on both sides */
+    std::vector<bool> used(positions.size());
+    for(const UnsignedInt index: indices) used[index] = true;
+    for(UnsignedInt y = 0; y <= 8; ++y) {
+        CORRADE_VERIFY(used[y*9 + 4]);
+        CORRADE_VERIFY(used[81 + y]);
+    }
+}
+
+void SimplifyTest::lods() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    makeGrid(16, indices, positions, [](UnsignedInt x, UnsignedInt y) {
+        return std::sin(Float(x)*0.4f)*std::cos(Float(y)*0.3f);
+    });
+    std::vector<Vector3> normals(positions.size(), Vector3::zAxis());
+    Trade::MeshData3D data{MeshPrimitive::Triangles, indices, {positions}, {normals}, {}};
+
+    std::vector<LodLevel> levels = MeshTools::generateLods(data, 4);
+    CORRADE_COMPARE(levels.size(), 4);
+
+    /* First level is a copy of the original */
+    CORRADE_VERIFY(levels[0].mesh.indices() == indices);
+    CORRADE_VERIFY(levels[0].mesh.positions(0) == positions);
+    CORRADE_COMPARE(levels[0].error, 0.0f);
+
+    for(std::size_t i = 1; i != levels.size(); ++i) {
+        const Trade::MeshData3D& mesh = levels[i].mesh;
+        const Trade::MeshData3D& previous = levels[i - 1].mesh;
+        CORRADE_VERIFY(mesh.indices().size() <= previous.indices().size()/2 + 2);
+        CORRADE_VERIFY(levels[i].error >= levels[i - 1].error);
+
+        /* Vertex data are compacted */
+        CORRADE_VERIFY(mesh.positions(0).size() < previous.positions(0).size());
+        CORRADE_COMPARE(mesh.normals(0).size(), mesh.positions(0).size());
+        std::vector<bool> used(mesh.positions(0).size());
+        for(const UnsignedInt index: mesh.indices()) used[index] = true;
+        CORRADE_VERIFY(std::find(used.begin(), used.end(), false) == used.end());
+    }
+
+    /* Error threshold stops the generation early */
+    CORRADE_VERIFY(MeshTools::generateLods(data, 10, 0.5f, levels[2].error*0.5f).size() < 4);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
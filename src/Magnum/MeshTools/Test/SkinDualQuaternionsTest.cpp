@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/SkinDualQuaternions.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SkinDualQuaternionsTest: TestSuite::Tester {
+    explicit SkinDualQuaternionsTest();
+
+    void singleJoint();
+    void blend();
+    void blendAntipodal();
+    void noNormals();
+    void wrongSize();
+    void jointOutOfRange();
+};
+
+SkinDualQuaternionsTest::SkinDualQuaternionsTest() {
+    addTests({&SkinDualQuaternionsTest::singleJoint,
+              &SkinDualQuaternionsTest::blend,
+              &SkinDualQuaternionsTest::blendAntipodal,
+              &SkinDualQuaternionsTest::noNormals,
+              &SkinDualQuaternionsTest::wrongSize,
+              &SkinDualQuaternionsTest::jointOutOfRange});
+}
+
+using namespace Math::Literals;
+
+void SkinDualQuaternionsTest::singleJoint() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, -2.0f, 0.5f})*DualQuaternion::rotation(35.0_degf, Vector3{1.0f, 2.0f, 3.0f}.normalized()),
+        DualQuaternion::rotation(-120.0_degf, Vector3::xAxis())
+    };
+
+    /* More than one block of vertices, with the last block incomplete */
+    std::vector<Vector4ui> jointIds;
+    std::vector<Vector4> weights;
+    std::vector<Vector3> positions, normals;
+    for(UnsignedInt i = 0; i != 37; ++i) {
+        jointIds.emplace_back(i%2, 0, 0, 0);
+        weights.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+        positions.emplace_back(Float(i), 1.0f - Float(i), 0.5f*Float(i));
+        normals.push_back(Vector3{1.0f, Float(i), 2.0f}.normalized());
+    }
+
+    std::vector<Vector3> skinnedPositions(37), skinnedNormals(37);
+    MeshTools::skinDualQuaternionsInto(joints,
+        {jointIds.data(), jointIds.size()}, {weights.data(), weights.size()},
+        {positions.data(), positions.size()}, {normals.data(), normals.size()},
+        {skinnedPositions.data(), skinnedPositions.size()},
+        {skinnedNormals.data(), skinnedNormals.size()});
+
+    for(std::size_t i = 0; i != 37; ++i) {
+        CORRADE_COMPARE(skinnedPositions[i], joints[i%2].transformPointNormalized(positions[i]));
+        CORRADE_COMPARE(skinnedNormals[i], joints[i%2].rotation().transformVectorNormalized(normals[i]));
+    }
+}
+
+void SkinDualQuaternionsTest::blend() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f}),
+        DualQuaternion::translation({3.0f, 0.0f, 0.0f}),
+        DualQuaternion::rotation(90.0_degf, Vector3::zAxis())
+    };
+    const Vector4ui jointIds[]{{0, 1, 0, 0}, {0, 2, 0, 0}};
+    const Vector4 weights[]{{0.5f, 0.5f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+    const Vector3 normals[]{Vector3::yAxis(), Vector3::xAxis()};
+
+    Vector3 skinnedPositions[2];
+    Vector3 skinnedNormals[2];
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, normals, skinnedPositions, skinnedNormals);
+
+    /* Blended translations */
+    CORRADE_COMPARE(skinnedPositions[0], (Vector3{2.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(skinnedNormals[0], Vector3::yAxis());
+
+    /* Blending translation with a rotation results in a screw motion that
+       rotates by half of the angle */
+    const DualQuaternion expected = DualQuaternion::rotation(45.0_degf, Vector3::zAxis());
+    CORRADE_COMPARE(skinnedNormals[1], expected.rotation().transformVectorNormalized(Vector3::xAxis()));
+    CORRADE_COMPARE(skinnedPositions[1], (Vector3{1.207107f, 0.914214f, 0.0f}));
+}
+
+void SkinDualQuaternionsTest::blendAntipodal() {
+    /* Both quaternions represent the same transformation, without taking the
+       shortest path they would cancel out */
+    const DualQuaternion a = DualQuaternion::translation({0.0f, 2.0f, 0.0f})*DualQuaternion::rotation(30.0_degf, Vector3::yAxis());
+    const DualQuaternion joints[]{a, -1.0f*a};
+    const Vector4ui jointIds[]{{0, 1, 0, 0}};
+    const Vector4 weights[]{{0.25f, 0.75f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}};
+    const Vector3 normals[]{Vector3::zAxis()};
+
+    Vector3 skinnedPositions[1];
+    Vector3 skinnedNormals[1];
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, normals, skinnedPositions, skinnedNormals);
+
+    CORRADE_COMPARE(skinnedPositions[0], a.transformPointNormalized(positions[0]));
+    CORRADE_COMPARE(skinnedNormals[0], a.rotation().transformVectorNormalized(normals[0]));
+}
+
+void SkinDualQuaternionsTest::noNormals() {
+    const DualQuaternion joints[]{DualQuaternion::translation({1.0f, 2.0f, 3.0f})};
+    const Vector4ui jointIds[]{{}, {}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{}, {1.0f, 1.0f, 1.0f}};
+
+    Vector3 skinnedPositions[2];
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, nullptr, skinnedPositions, nullptr);
+
+    CORRADE_COMPARE(skinnedPositions[0], (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(skinnedPositions[1], (Vector3{2.0f, 3.0f, 4.0f}));
+}
+
+void SkinDualQuaternionsTest::wrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const DualQuaternion joints[1];
+    const Vector4ui jointIds[2]{};
+    const Vector4 weights[2]{};
+    const Vector3 positions[2]{};
+    const Vector3 normals[2]{};
+    Vector3 skinnedPositions[2];
+    Vector3 skinnedNormals[2];
+    MeshTools::skinDualQuaternionsInto(joints, {jointIds, 1}, weights, positions, normals, skinnedPositions, skinnedNormals);
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, normals, skinnedPositions, {skinnedNormals, 1});
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, {normals, 1}, skinnedPositions, {skinnedNormals, 1});
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinDualQuaternionsInto(): expected 2 joint IDs, weights and skinned positions but got 1, 2 and 2\n"
+        "MeshTools::skinDualQuaternionsInto(): expected either no normals or 2 normals and skinned normals but got 2 and 1\n"
+        "MeshTools::skinDualQuaternionsInto(): expected either no normals or 2 normals and skinned normals but got 1 and 1\n");
+}
+
+void SkinDualQuaternionsTest::jointOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const DualQuaternion joints[2];
+    const Vector4ui jointIds[]{{0, 1, 2, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[1]{};
+    Vector3 skinnedPositions[1];
+    MeshTools::skinDualQuaternionsInto(joints, jointIds, weights, positions, nullptr, skinnedPositions, nullptr);
+
+    CORRADE_COMPARE(out.str(), "MeshTools::skinDualQuaternionsInto(): joint IDs Vector(0, 1, 2, 0) of vertex 0 out of range for 2 joints\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinDualQuaternionsTest)
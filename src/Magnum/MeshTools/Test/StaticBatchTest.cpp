@@ -0,0 +1,268 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/StaticBatch.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StaticBatchTest: TestSuite::Tester {
+    explicit StaticBatchTest();
+
+    void empty();
+    void combine();
+    void bins();
+    void nonIndexed();
+    void normals();
+    void attributesNotInAllMeshes();
+
+    void invalidCellSize();
+    void invalidPrimitive();
+    void differentPrimitive();
+    void indexOutOfRange();
+};
+
+StaticBatchTest::StaticBatchTest() {
+    addTests({&StaticBatchTest::empty,
+              &StaticBatchTest::combine,
+              &StaticBatchTest::bins,
+              &StaticBatchTest::nonIndexed,
+              &StaticBatchTest::normals,
+              &StaticBatchTest::attributesNotInAllMeshes,
+
+              &StaticBatchTest::invalidCellSize,
+              &StaticBatchTest::invalidPrimitive,
+              &StaticBatchTest::differentPrimitive,
+              &StaticBatchTest::indexOutOfRange});
+}
+
+namespace {
+
+Trade::MeshData3D triangle() {
+    return Trade::MeshData3D{MeshPrimitive::Triangles, {0, 1, 2}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }}, {{
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f}
+    }}, {{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f}
+    }}};
+}
+
+}
+
+void StaticBatchTest::empty() {
+    StaticBatch batch{10.0f};
+    Trade::MeshData3D data = batch.combine();
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_VERIFY(data.positions(0).empty());
+    CORRADE_VERIFY(!data.hasNormals());
+    CORRADE_VERIFY(batch.bins().empty());
+    CORRADE_VERIFY(batch.sources().empty());
+}
+
+void StaticBatchTest::combine() {
+    StaticBatch batch{10.0f};
+    CORRADE_COMPARE(batch.add(triangle(), Matrix4::translation({1.0f, 2.0f, 3.0f}), 3), 0);
+    CORRADE_COMPARE(batch.add(triangle(), Matrix4::scaling(Vector3{2.0f}), 3), 1);
+    CORRADE_COMPARE(batch.sourceCount(), 2);
+
+    Trade::MeshData3D data = batch.combine();
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data.indices(), (std::vector<UnsignedInt>{0, 1, 2, 3, 4, 5}));
+    CORRADE_COMPARE(data.positions(0), (std::vector<Vector3>{
+        {1.0f, 2.0f, 3.0f},
+        {2.0f, 2.0f, 3.0f},
+        {1.0f, 3.0f, 3.0f},
+        {0.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f}
+    }));
+    CORRADE_VERIFY(data.hasNormals());
+    CORRADE_VERIFY(data.hasTextureCoords2D());
+    CORRADE_COMPARE(data.textureCoords2D(0).size(), 6);
+
+    /* Both in the same cell, so a single bin */
+    CORRADE_COMPARE(batch.bins().size(), 1);
+    const StaticBatch::Bin& bin = batch.bins()[0];
+    CORRADE_COMPARE(bin.material, 3);
+    CORRADE_COMPARE(bin.cell, Vector3i{});
+    CORRADE_COMPARE(bin.indexOffset, 0);
+    CORRADE_COMPARE(bin.indexCount, 6);
+    CORRADE_COMPARE(bin.vertexStart, 0);
+    CORRADE_COMPARE(bin.vertexEnd, 5);
+    CORRADE_COMPARE(bin.bounds, (Range3D{{0.0f, 0.0f, 0.0f}, {2.0f, 3.0f, 3.0f}}));
+
+    CORRADE_COMPARE(batch.sources().size(), 2);
+    CORRADE_COMPARE(batch.sources()[1].bin, 0);
+    CORRADE_COMPARE(batch.sources()[1].indexOffset, 3);
+    CORRADE_COMPARE(batch.sources()[1].indexCount, 3);
+    CORRADE_COMPARE(batch.sources()[1].vertexStart, 3);
+    CORRADE_COMPARE(batch.sources()[1].vertexEnd, 5);
+    CORRADE_COMPARE(batch.sources()[1].bounds, (Range3D{{0.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 0.0f}}));
+}
+
+void StaticBatchTest::bins() {
+    StaticBatch batch{10.0f};
+    batch.add(triangle(), Matrix4::translation({25.0f, 0.0f, 0.0f}), 1);
+    batch.add(triangle(), Matrix4::translation({-5.0f, 0.0f, 0.0f}), 1);
+    batch.add(triangle(), Matrix4{}, 0);
+    batch.add(triangle(), Matrix4::translation({21.0f, 0.0f, 0.0f}), 1);
+
+    batch.combine();
+
+    /* Ordered by material and cell, meshes in the same bin keep their
+       relative order */
+    CORRADE_COMPARE(batch.bins().size(), 3);
+    CORRADE_COMPARE(batch.bins()[0].material, 0);
+    CORRADE_COMPARE(batch.bins()[0].cell, (Vector3i{0, 0, 0}));
+    CORRADE_COMPARE(batch.bins()[0].indexOffset, 0);
+    CORRADE_COMPARE(batch.bins()[0].indexCount, 3);
+    CORRADE_COMPARE(batch.bins()[1].material, 1);
+    CORRADE_COMPARE(batch.bins()[1].cell, (Vector3i{-1, 0, 0}));
+    CORRADE_COMPARE(batch.bins()[1].indexOffset, 3);
+    CORRADE_COMPARE(batch.bins()[1].indexCount, 3);
+    CORRADE_COMPARE(batch.bins()[2].material, 1);
+    CORRADE_COMPARE(batch.bins()[2].cell, (Vector3i{2, 0, 0}));
+    CORRADE_COMPARE(batch.bins()[2].indexOffset, 6);
+    CORRADE_COMPARE(batch.bins()[2].indexCount, 6);
+    CORRADE_COMPARE(batch.bins()[2].vertexStart, 6);
+    CORRADE_COMPARE(batch.bins()[2].vertexEnd, 11);
+    CORRADE_COMPARE(batch.bins()[2].bounds, (Range3D{{21.0f, 0.0f, 0.0f}, {26.0f, 1.0f, 0.0f}}));
+
+    CORRADE_COMPARE(batch.sources()[0].bin, 2);
+    CORRADE_COMPARE(batch.sources()[0].indexOffset, 6);
+    CORRADE_COMPARE(batch.sources()[1].bin, 1);
+    CORRADE_COMPARE(batch.sources()[2].bin, 0);
+    CORRADE_COMPARE(batch.sources()[3].bin, 2);
+    CORRADE_COMPARE(batch.sources()[3].indexOffset, 9);
+}
+
+void StaticBatchTest::nonIndexed() {
+    StaticBatch batch{10.0f};
+    batch.add(Trade::MeshData3D{MeshPrimitive::Lines, {}, {{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}
+    }}, {}, {}}, Matrix4{});
+    batch.add(Trade::MeshData3D{MeshPrimitive::Lines, {1, 0}, {{
+        {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}
+    }}, {}, {}}, Matrix4{});
+
+    Trade::MeshData3D data = batch.combine();
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(data.indices(), (std::vector<UnsignedInt>{0, 1, 3, 2}));
+    CORRADE_COMPARE(data.positions(0).size(), 4);
+}
+
+void StaticBatchTest::normals() {
+    /* Non-uniform scaling, the normal has to stay perpendicular to the
+       surface and normalized */
+    StaticBatch batch{10.0f};
+    batch.add(Trade::MeshData3D{MeshPrimitive::Triangles, {0, 1, 2}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    }}, {{
+        Vector3{1.0f, -1.0f, 0.0f}.normalized(),
+        Vector3{1.0f, -1.0f, 0.0f}.normalized(),
+        Vector3{1.0f, -1.0f, 0.0f}.normalized()
+    }}, {}}, Matrix4::scaling({2.0f, 1.0f, 1.0f}));
+
+    Trade::MeshData3D data = batch.combine();
+    CORRADE_VERIFY(data.hasNormals());
+    CORRADE_VERIFY(!data.hasTextureCoords2D());
+    CORRADE_COMPARE(data.normals(0)[0], Vector3(1.0f, -2.0f, 0.0f).normalized());
+    CORRADE_COMPARE(Math::dot(data.normals(0)[0], data.positions(0)[1] - data.positions(0)[0]), 0.0f);
+}
+
+void StaticBatchTest::attributesNotInAllMeshes() {
+    StaticBatch batch{10.0f};
+    batch.add(triangle(), Matrix4{});
+    batch.add(Trade::MeshData3D{MeshPrimitive::Triangles, {0, 1, 2}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }}, {}, {}}, Matrix4{});
+
+    Trade::MeshData3D data = batch.combine();
+    CORRADE_COMPARE(data.positions(0).size(), 6);
+    CORRADE_VERIFY(!data.hasNormals());
+    CORRADE_VERIFY(!data.hasTextureCoords2D());
+}
+
+void StaticBatchTest::invalidCellSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch{0.0f};
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch: expected positive cell size but got 0\n");
+}
+
+void StaticBatchTest::invalidPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{10.0f};
+    batch.add(Trade::MeshData3D{MeshPrimitive::TriangleStrip, {}, {{}}, {}, {}}, Matrix4{});
+    CORRADE_COMPARE(batch.sourceCount(), 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): can't batch MeshPrimitive::TriangleStrip\n");
+}
+
+void StaticBatchTest::differentPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{10.0f};
+    batch.add(triangle(), Matrix4{});
+    batch.add(Trade::MeshData3D{MeshPrimitive::Points, {}, {{}}, {}, {}}, Matrix4{});
+    CORRADE_COMPARE(batch.sourceCount(), 1);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): expected MeshPrimitive::Triangles but got MeshPrimitive::Points\n");
+}
+
+void StaticBatchTest::indexOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{10.0f};
+    batch.add(Trade::MeshData3D{MeshPrimitive::Triangles, {0, 1, 3}, {{
+        {}, {}, {}
+    }}, {}, {}}, Matrix4{});
+    CORRADE_COMPARE(batch.sourceCount(), 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): index 3 out of range for 3 vertices\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StaticBatchTest)
@@ -0,0 +1,128 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/StreamCodec.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StreamCodecBenchmark: TestSuite::Tester {
+    explicit StreamCodecBenchmark();
+
+    void decodeIndices();
+    void decodeIndicesMemcpy();
+    void decodeVertices();
+    void decodeVerticesMemcpy();
+};
+
+StreamCodecBenchmark::StreamCodecBenchmark() {
+    addBenchmarks<StreamCodecBenchmark>({&StreamCodecBenchmark::decodeIndices,
+                                         &StreamCodecBenchmark::decodeIndicesMemcpy,
+                                         &StreamCodecBenchmark::decodeVertices,
+                                         &StreamCodecBenchmark::decodeVerticesMemcpy}, 10);
+}
+
+namespace {
+
+enum: UnsignedInt { Count = 1024*1024 };
+
+/* Grid of quads in a vertex cache friendly order, similar to what
+   optimizeVertexCache() produces */
+std::vector<UnsignedInt> indices() {
+    enum: UnsignedInt { Width = 512 };
+    std::vector<UnsignedInt> out;
+    out.reserve(Count*6);
+    for(UnsignedInt i = 0; i != Count; ++i) {
+        const UnsignedInt a = i + i/(Width - 1);
+        out.insert(out.end(), {a, a + 1, a + Width, a + Width, a + 1, a + Width + 1});
+    }
+    return out;
+}
+
+/* Terrain-like positions with small differences between neighbors */
+std::vector<Float> positions() {
+    std::vector<Float> out;
+    out.reserve(Count*3);
+    for(UnsignedInt i = 0; i != Count; ++i)
+        out.insert(out.end(), {Float(i%1024), std::sin(Float(i)*0.001f)*100.0f, Float(i/1024)});
+    return out;
+}
+
+}
+
+void StreamCodecBenchmark::decodeIndices() {
+    const std::vector<UnsignedInt> input = indices();
+    Containers::Array<char> data = MeshTools::encodeIndexStream(input);
+
+    std::vector<UnsignedInt> out(input.size());
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(MeshTools::decodeIndexStream(data, {out.data(), out.size()}));
+    }
+
+    CORRADE_VERIFY(out == input);
+}
+
+void StreamCodecBenchmark::decodeIndicesMemcpy() {
+    const std::vector<UnsignedInt> input = indices();
+
+    /* Upper bound for the decoder, copying the uncompressed data */
+    std::vector<UnsignedInt> out(input.size());
+    CORRADE_BENCHMARK(1) {
+        std::memcpy(out.data(), input.data(), input.size()*sizeof(UnsignedInt));
+    }
+
+    CORRADE_VERIFY(out == input);
+}
+
+void StreamCodecBenchmark::decodeVertices() {
+    const std::vector<Float> input = positions();
+    Containers::Array<char> data = MeshTools::encodeVertexStream({input.data(), input.size()}, 3, 16);
+
+    std::vector<Float> out(input.size());
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(MeshTools::decodeVertexStream(data, {out.data(), out.size()}, 3));
+    }
+
+    CORRADE_COMPARE(out[0], input[0]);
+}
+
+void StreamCodecBenchmark::decodeVerticesMemcpy() {
+    const std::vector<Float> input = positions();
+
+    std::vector<Float> out(input.size());
+    CORRADE_BENCHMARK(1) {
+        std::memcpy(out.data(), input.data(), input.size()*sizeof(Float));
+    }
+
+    CORRADE_VERIFY(out == input);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StreamCodecBenchmark)
@@ -0,0 +1,227 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/StreamCodec.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StreamCodecTest: TestSuite::Tester {
+    explicit StreamCodecTest();
+
+    void encodeIndices();
+    void decodeIndices();
+    void decodeIndicesLarge();
+    void decodeIndicesTooShort();
+    void decodeIndicesTypeTooSmall();
+
+    void encodeVertices();
+    void encodeVerticesInvalid();
+    void decodeVerticesLarge();
+    void decodeVerticesComponentMismatch();
+    void decodeVerticesTooShort();
+};
+
+StreamCodecTest::StreamCodecTest() {
+    addTests({&StreamCodecTest::encodeIndices,
+              &StreamCodecTest::decodeIndices,
+              &StreamCodecTest::decodeIndicesLarge,
+              &StreamCodecTest::decodeIndicesTooShort,
+              &StreamCodecTest::decodeIndicesTypeTooSmall,
+
+              &StreamCodecTest::encodeVertices,
+              &StreamCodecTest::encodeVerticesInvalid,
+              &StreamCodecTest::decodeVerticesLarge,
+              &StreamCodecTest::decodeVerticesComponentMismatch,
+              &StreamCodecTest::decodeVerticesTooShort});
+}
+
+namespace {
+    const std::vector<UnsignedInt> Indices{0, 1, 2, 2, 1, 3, 3, 1, 4, 100, 4};
+}
+
+void StreamCodecTest::encodeIndices() {
+    Containers::Array<char> data = MeshTools::encodeIndexStream(Indices);
+
+    /* New vertices are zero, the rest are zigzag-encoded differences plus
+       one, the last two take two bytes */
+    CORRADE_COMPARE(std::vector<UnsignedByte>(data.begin(), data.end()),
+        (std::vector<UnsignedByte>{0, 0, 0, 1, 2, 0, 1, 4, 0, 193, 1, 192, 1}));
+}
+
+void StreamCodecTest::decodeIndices() {
+    Containers::Array<char> data = MeshTools::encodeIndexStream(Indices);
+
+    UnsignedByte bytes[11];
+    CORRADE_VERIFY(MeshTools::decodeIndexStream(data, bytes));
+    CORRADE_COMPARE(std::vector<UnsignedInt>(bytes, bytes + 11), Indices);
+
+    UnsignedShort shorts[11];
+    CORRADE_VERIFY(MeshTools::decodeIndexStream(data, shorts));
+    CORRADE_COMPARE(std::vector<UnsignedInt>(shorts, shorts + 11), Indices);
+
+    UnsignedInt ints[11];
+    CORRADE_VERIFY(MeshTools::decodeIndexStream(data, ints));
+    CORRADE_COMPARE(std::vector<UnsignedInt>(ints, ints + 11), Indices);
+}
+
+void StreamCodecTest::decodeIndicesLarge() {
+    /* Triangle strip-like mesh with an occasional far reference, so both
+       the bulk single-byte path and multi-byte values are used across many
+       chunks */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt i = 0; i != 100000; ++i) {
+        indices.push_back(i);
+        indices.push_back(i + 1);
+        indices.push_back(i % 997 ? i + 2 : i*3);
+    }
+
+    Containers::Array<char> data = MeshTools::encodeIndexStream(indices);
+    CORRADE_VERIFY(data.size() < indices.size()*2);
+
+    std::vector<UnsignedInt> decoded(indices.size());
+    CORRADE_VERIFY(MeshTools::decodeIndexStream(data, {decoded.data(), decoded.size()}));
+    CORRADE_COMPARE_AS(decoded, indices, TestSuite::Compare::Container);
+}
+
+void StreamCodecTest::decodeIndicesTooShort() {
+    Containers::Array<char> data = MeshTools::encodeIndexStream(Indices);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedInt indices[11];
+    CORRADE_VERIFY(!MeshTools::decodeIndexStream(data.prefix(12), indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndexStream(): the data are too short for 11 indices\n");
+}
+
+void StreamCodecTest::decodeIndicesTypeTooSmall() {
+    Containers::Array<char> data = MeshTools::encodeIndexStream({0, 256, 1});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte indices[3];
+    CORRADE_VERIFY(!MeshTools::decodeIndexStream(data, indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndexStream(): index 256 doesn't fit into 8 bits\n");
+}
+
+void StreamCodecTest::encodeVertices() {
+    /* The second component is constant */
+    const Float vertices[]{0.0f, 10.0f,
+                           1.0f, 10.0f,
+                           0.5f, 10.0f};
+    Containers::Array<char> data = MeshTools::encodeVertexStream(vertices, 2, 8);
+
+    /* 8-byte header, two ranges and six values, two of them taking two
+       bytes */
+    CORRADE_COMPARE(data.size(), 32);
+
+    Float decoded[6];
+    CORRADE_VERIFY(MeshTools::decodeVertexStream(data, decoded, 2));
+    CORRADE_COMPARE(decoded[0], 0.0f);
+    CORRADE_COMPARE(decoded[1], 10.0f);
+    CORRADE_COMPARE(decoded[2], 1.0f);
+    CORRADE_COMPARE(decoded[3], 10.0f);
+    CORRADE_COMPARE(decoded[5], 10.0f);
+
+    /* The quantization error is at most half of the step */
+    CORRADE_COMPARE(decoded[4], 128.0f/255.0f);
+    CORRADE_VERIFY(Math::abs(decoded[4] - 0.5f) <= 0.5f/255.0f);
+}
+
+void StreamCodecTest::encodeVerticesInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Float vertices[5]{};
+    MeshTools::encodeVertexStream(vertices, 2, 8);
+    MeshTools::encodeVertexStream({vertices, 4}, 2, 25);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertexStream(): data size 5 is not divisible by 2 components\n"
+        "MeshTools::encodeVertexStream(): expected 1 to 24 bits, got 25\n");
+}
+
+void StreamCodecTest::decodeVerticesLarge() {
+    /* Positions on a spiral, neighboring vertices are close to each other */
+    std::vector<Float> vertices;
+    for(std::size_t i = 0; i != 30000; ++i) {
+        const Float t = Float(i)*0.01f;
+        vertices.push_back(std::cos(t)*t);
+        vertices.push_back(std::sin(t)*t);
+        vertices.push_back(t);
+    }
+
+    Containers::Array<char> data = MeshTools::encodeVertexStream(vertices, 3, 16);
+    CORRADE_VERIFY(data.size() < vertices.size()*sizeof(Float)/2);
+
+    std::vector<Float> decoded(vertices.size());
+    CORRADE_VERIFY(MeshTools::decodeVertexStream(data, {decoded.data(), decoded.size()}, 3));
+
+    /* Each component spans less than 600 units, so the error is below
+       600/65535/2 */
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        maxError = Math::max(maxError, Math::abs(decoded[i] - vertices[i]));
+    CORRADE_VERIFY(maxError < 0.005f);
+}
+
+void StreamCodecTest::decodeVerticesComponentMismatch() {
+    const Float vertices[6]{};
+    Containers::Array<char> data = MeshTools::encodeVertexStream(vertices, 2, 8);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Float decoded[6];
+    CORRADE_VERIFY(!MeshTools::decodeVertexStream(data, decoded, 3));
+    CORRADE_VERIFY(!MeshTools::decodeVertexStream(data, {decoded, 5}, 2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVertexStream(): expected 3 components with output size divisible by them but got 2 components and output size 6\n"
+        "MeshTools::decodeVertexStream(): expected 2 components with output size divisible by them but got 2 components and output size 5\n");
+}
+
+void StreamCodecTest::decodeVerticesTooShort() {
+    const Float vertices[6]{};
+    Containers::Array<char> data = MeshTools::encodeVertexStream(vertices, 2, 8);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Float decoded[6];
+    CORRADE_VERIFY(!MeshTools::decodeVertexStream(data.prefix(4), decoded, 2));
+    CORRADE_VERIFY(!MeshTools::decodeVertexStream(data.prefix(20), decoded, 2));
+    CORRADE_VERIFY(!MeshTools::decodeVertexStream(data.prefix(data.size() - 1), decoded, 2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVertexStream(): the data are too short for a header\n"
+        "MeshTools::decodeVertexStream(): the data are too short for 2 component ranges\n"
+        "MeshTools::decodeVertexStream(): the data are too short for 3 vertices\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StreamCodecTest)
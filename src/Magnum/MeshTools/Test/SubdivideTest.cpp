@@ -36,6 +36,10 @@ struct SubdivideTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void subdivide();
+
+    void sharedWrongIndexCount();
+    void shared();
+    void sharedLarge();
 };
 
 namespace {
@@ -48,7 +52,11 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+
+              &SubdivideTest::sharedWrongIndexCount,
+              &SubdivideTest::shared,
+              &SubdivideTest::sharedLarge});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -72,6 +80,53 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 7, 8, 9, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 7, 9, 7, 2, 8, 9, 8, 3}));
 }
 
+void SubdivideTest::sharedWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+    CORRADE_COMPARE(ss.str(), "MeshTools::subdivideShared(): index count is not divisible by 3!\n");
+}
+
+void SubdivideTest::shared() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+
+    /* The midpoint of the shared edge 1-2 is created only once */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::sharedLarge() {
+    /* Triangle strip large enough to be processed in parallel */
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices;
+    for(Int i = 0; i != 100002; ++i) positions.push_back(i*4);
+    for(UnsignedInt i = 0; i != 100000; ++i) {
+        indices.push_back(i);
+        indices.push_back(i + 1);
+        indices.push_back(i + 2);
+    }
+
+    std::vector<Vector1> expectedPositions{positions};
+    std::vector<UnsignedInt> expectedIndices{indices};
+    MeshTools::subdivide(expectedIndices, expectedPositions, interpolator);
+    MeshTools::subdivideShared(indices, positions, interpolator);
+
+    /* A strip of n faces has 2n + 1 unique edges */
+    CORRADE_COMPARE(positions.size(), 100002 + 200001);
+    CORRADE_COMPARE(indices.size(), expectedIndices.size());
+
+    /* Same layout as subdivide(), only the duplicates are shared */
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        if(positions[indices[i]] != expectedPositions[expectedIndices[i]]) ++mismatches;
+    CORRADE_COMPARE(mismatches, 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
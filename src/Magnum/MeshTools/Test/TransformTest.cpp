@@ -24,6 +24,8 @@
 */
 
 #include <array>
+#include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
@@ -40,6 +42,13 @@ struct TransformTest: TestSuite::Tester {
 
     void transformPoints2D();
     void transformPoints3D();
+
+    void transformVectorsContiguous();
+    void transformPointsContiguous();
+    void transformPointsProjective();
+    void transformSeparate();
+    void transformSeparateWrongSize();
+    void transformLarge();
 };
 
 TransformTest::TransformTest() {
@@ -47,7 +56,14 @@ TransformTest::TransformTest() {
               &TransformTest::transformVectors3D,
 
               &TransformTest::transformPoints2D,
-              &TransformTest::transformPoints3D});
+              &TransformTest::transformPoints3D,
+
+              &TransformTest::transformVectorsContiguous,
+              &TransformTest::transformPointsContiguous,
+              &TransformTest::transformPointsProjective,
+              &TransformTest::transformSeparate,
+              &TransformTest::transformSeparateWrongSize,
+              &TransformTest::transformLarge});
 }
 
 constexpr static std::array<Vector2, 2> points2D{{
@@ -116,6 +132,92 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+void TransformTest::transformVectorsContiguous() {
+    const std::vector<Vector3> points(points3D.begin(), points3D.end());
+    const std::vector<Vector3> expected(points3DRotated.begin(), points3DRotated.end());
+
+    std::vector<Vector3> matrix = points;
+    MeshTools::transformVectorsInPlace(Matrix4::rotationZ(Deg(90.0f)), matrix);
+    std::vector<Vector3> quaternion = points;
+    MeshTools::transformVectorsInPlace(Quaternion::rotation(Deg(90.0f), Vector3::zAxis()), Containers::ArrayView<Vector3>{quaternion.data(), quaternion.size()});
+
+    CORRADE_COMPARE(matrix, expected);
+    CORRADE_COMPARE(quaternion, expected);
+}
+
+void TransformTest::transformPointsContiguous() {
+    const std::vector<Vector3> points(points3D.begin(), points3D.end());
+    const std::vector<Vector3> expected(points3DRotatedTranslated.begin(), points3DRotatedTranslated.end());
+
+    std::vector<Vector3> matrix = points;
+    MeshTools::transformPointsInPlace(
+        Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f)), matrix);
+    std::vector<Vector3> quaternion = points;
+    MeshTools::transformPointsInPlace(
+        DualQuaternion::translation(Vector3::yAxis(-1.0f))*DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis()), quaternion);
+
+    CORRADE_COMPARE(matrix, expected);
+    CORRADE_COMPARE(quaternion, expected);
+}
+
+void TransformTest::transformPointsProjective() {
+    /* The division by W has to be done as well */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(35.0f), 1.333f, 0.1f, 100.0f);
+    std::vector<Vector3> points(points3D.begin(), points3D.end());
+    MeshTools::transformPointsInPlace(projection, points);
+
+    CORRADE_COMPARE(points[0], projection.transformPoint(points3D[0]));
+    CORRADE_COMPARE(points[1], projection.transformPoint(points3D[1]));
+}
+
+void TransformTest::transformSeparate() {
+    Float x[]{-3.0f, 2.5f};
+    Float y[]{4.0f, -15.0f};
+    Float z[]{34.0f, 1.5f};
+
+    MeshTools::transformPointsInPlace(
+        Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f)), x, y, z);
+    CORRADE_COMPARE(Vector3(x[0], y[0], z[0]), points3DRotatedTranslated[0]);
+    CORRADE_COMPARE(Vector3(x[1], y[1], z[1]), points3DRotatedTranslated[1]);
+
+    MeshTools::transformVectorsInPlace(Matrix4::rotationZ(Deg(-90.0f)), x, y, z);
+    CORRADE_COMPARE(Vector3(x[0], y[0], z[0]), (Vector3{-4.0f, 4.0f, 34.0f}));
+    CORRADE_COMPARE(Vector3(x[1], y[1], z[1]), (Vector3{1.5f, -15.0f, 1.5f}));
+}
+
+void TransformTest::transformSeparateWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Float x[3]{}, y[2]{}, z[3]{};
+    MeshTools::transformPointsInPlace(Matrix4{}, x, y, z);
+    MeshTools::transformVectorsInPlace(Matrix4{}, x, y, z);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::transformPointsInPlace(): expected arrays of the same size but got 3, 2 and 3\n"
+        "MeshTools::transformVectorsInPlace(): expected arrays of the same size but got 3, 2 and 3\n");
+}
+
+void TransformTest::transformLarge() {
+    /* Enough points to be processed in multiple chunks (if there's more than
+       one core) and with an incomplete last block */
+    std::vector<Vector3> points;
+    for(std::size_t i = 0; i != 256*1024 + 3; ++i)
+        points.emplace_back(Float(i%7) - 3.0f, Float(i%5) - 2.0f, Float(i%3));
+
+    const Matrix4 matrix = Matrix4::translation({1.0f, 2.0f, -3.0f})*Matrix4::rotationY(Deg(35.0f))*Matrix4::scaling({2.0f, 1.0f, 0.5f});
+    const DualQuaternion dualQuaternion = DualQuaternion::translation({1.0f, 2.0f, -3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis());
+
+    std::vector<Vector3> transformedMatrix = points;
+    MeshTools::transformPointsInPlace(matrix, transformedMatrix);
+    std::vector<Vector3> transformedDualQuaternion = points;
+    MeshTools::transformPointsInPlace(dualQuaternion, transformedDualQuaternion);
+
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        CORRADE_COMPARE(transformedMatrix[i], matrix.transformPoint(points[i]));
+        CORRADE_COMPARE(transformedDualQuaternion[i], dualQuaternion.transformPointNormalized(points[i]));
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Transform.h"
+
+#include <algorithm>
+
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+enum: std::size_t {
+    LaneCount = 8,
+    MinChunkSize = 64*1024
+};
+
+/* Calls `transform(x, y, z)` on blocks of LaneCount coordinates gathered from
+   the interleaved array to structure-of-arrays lanes, so the transformation
+   loops get vectorized. Unused lanes of the last block are zero. */
+template<class F> void transformInterleaved(Vector3* const data, const std::size_t count, const F& transform) {
+    Magnum::Implementation::parallelChunks(count, Magnum::Implementation::chunkSize(count, MinChunkSize), [data, &transform](std::size_t, const std::size_t begin, const std::size_t end) {
+        Float x[LaneCount], y[LaneCount], z[LaneCount];
+        for(std::size_t blockBegin = begin; blockBegin < end; blockBegin += LaneCount) {
+            const std::size_t blockSize = std::min(std::size_t(LaneCount), end - blockBegin);
+
+            for(std::size_t l = 0; l != blockSize; ++l) {
+                x[l] = data[blockBegin + l].x();
+                y[l] = data[blockBegin + l].y();
+                z[l] = data[blockBegin + l].z();
+            }
+            for(std::size_t l = blockSize; l != LaneCount; ++l)
+                x[l] = y[l] = z[l] = 0.0f;
+
+            transform(x, y, z);
+
+            for(std::size_t l = 0; l != blockSize; ++l)
+                data[blockBegin + l] = {x[l], y[l], z[l]};
+        }
+    });
+}
+
+/* Calls `transform(x, y, z)` directly on the separate arrays, only the last
+   incomplete block goes through temporary lanes */
+template<class F> void transformSeparate(Float* const dataX, Float* const dataY, Float* const dataZ, const std::size_t count, const F& transform) {
+    Magnum::Implementation::parallelChunks(count, Magnum::Implementation::chunkSize(count, MinChunkSize), [dataX, dataY, dataZ, &transform](std::size_t, const std::size_t begin, const std::size_t end) {
+        std::size_t blockBegin = begin;
+        for(; blockBegin + LaneCount <= end; blockBegin += LaneCount)
+            transform(dataX + blockBegin, dataY + blockBegin, dataZ + blockBegin);
+
+        if(blockBegin == end) return;
+
+        Float x[LaneCount]{}, y[LaneCount]{}, z[LaneCount]{};
+        const std::size_t blockSize = end - blockBegin;
+        std::copy_n(dataX + blockBegin, blockSize, x);
+        std::copy_n(dataY + blockBegin, blockSize, y);
+        std::copy_n(dataZ + blockBegin, blockSize, z);
+
+        transform(x, y, z);
+
+        std::copy_n(x, blockSize, dataX + blockBegin);
+        std::copy_n(y, blockSize, dataY + blockBegin);
+        std::copy_n(z, blockSize, dataZ + blockBegin);
+    });
+}
+
+/* Equivalent to Matrix4::transformVector() */
+class MatrixVectorTransform {
+    public:
+        explicit MatrixVectorTransform(const Matrix4& matrix): _m(matrix) {}
+
+        void operator()(Float* const x, Float* const y, Float* const z) const {
+            const Matrix4& m = _m;
+            for(std::size_t l = 0; l != LaneCount; ++l) {
+                const Float vx = x[l], vy = y[l], vz = z[l];
+                x[l] = m[0][0]*vx + m[1][0]*vy + m[2][0]*vz;
+                y[l] = m[0][1]*vx + m[1][1]*vy + m[2][1]*vz;
+                z[l] = m[0][2]*vx + m[1][2]*vy + m[2][2]*vz;
+            }
+        }
+
+    private:
+        Matrix4 _m;
+};
+
+/* Equivalent to Matrix4::transformPoint(), including the division by W */
+class MatrixPointTransform {
+    public:
+        explicit MatrixPointTransform(const Matrix4& matrix): _m(matrix) {}
+
+        void operator()(Float* const x, Float* const y, Float* const z) const {
+            const Matrix4& m = _m;
+            for(std::size_t l = 0; l != LaneCount; ++l) {
+                const Float px = x[l], py = y[l], pz = z[l];
+                const Float w = m[0][3]*px + m[1][3]*py + m[2][3]*pz + m[3][3];
+                x[l] = (m[0][0]*px + m[1][0]*py + m[2][0]*pz + m[3][0])/w;
+                y[l] = (m[0][1]*px + m[1][1]*py + m[2][1]*pz + m[3][1])/w;
+                z[l] = (m[0][2]*px + m[1][2]*py + m[2][2]*pz + m[3][2])/w;
+            }
+        }
+
+    private:
+        Matrix4 _m;
+};
+
+/* Equivalent to Quaternion::transformVectorNormalized(), with the
+   translation added for DualQuaternion::transformPointNormalized() */
+class QuaternionTransform {
+    public:
+        explicit QuaternionTransform(const Quaternion& rotation, const Vector3& translation): _q(rotation), _t(translation) {}
+
+        void operator()(Float* const x, Float* const y, Float* const z) const {
+            const Float qx = _q.vector().x(), qy = _q.vector().y(), qz = _q.vector().z(), qw = _q.scalar();
+            const Float tx = _t.x(), ty = _t.y(), tz = _t.z();
+            for(std::size_t l = 0; l != LaneCount; ++l) {
+                const Float vx = x[l], vy = y[l], vz = z[l];
+
+                /* t = 2 q.xyz x v; v' = v + q.w t + q.xyz x t */
+                const Float cx = 2.0f*(qy*vz - qz*vy);
+                const Float cy = 2.0f*(qz*vx - qx*vz);
+                const Float cz = 2.0f*(qx*vy - qy*vx);
+                x[l] = vx + qw*cx + qy*cz - qz*cy + tx;
+                y[l] = vy + qw*cy + qz*cx - qx*cz + ty;
+                z[l] = vz + qw*cz + qx*cy - qy*cx + tz;
+            }
+        }
+
+    private:
+        Quaternion _q;
+        Vector3 _t;
+};
+
+}
+
+void transformVectorsInPlace(const Quaternion& normalizedQuaternion, const Containers::ArrayView<Vector3> vectors) {
+    CORRADE_ASSERT(normalizedQuaternion.isNormalized(),
+        "MeshTools::transformVectorsInPlace(): quaternion must be normalized", );
+
+    transformInterleaved(vectors.data(), vectors.size(), QuaternionTransform{normalizedQuaternion, Vector3{}});
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> vectors) {
+    transformInterleaved(vectors.data(), vectors.size(), MatrixVectorTransform{matrix});
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayView<Float> x, const Containers::ArrayView<Float> y, const Containers::ArrayView<Float> z) {
+    CORRADE_ASSERT(y.size() == x.size() && z.size() == x.size(),
+        "MeshTools::transformVectorsInPlace(): expected arrays of the same size but got" << x.size() << Debug::nospace << "," << y.size() << "and" << z.size(), );
+
+    transformSeparate(x.data(), y.data(), z.data(), x.size(), MatrixVectorTransform{matrix});
+}
+
+void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, const Containers::ArrayView<Vector3> points) {
+    CORRADE_ASSERT(normalizedDualQuaternion.isNormalized(),
+        "MeshTools::transformPointsInPlace(): dual quaternion must be normalized", );
+
+    transformInterleaved(points.data(), points.size(), QuaternionTransform{normalizedDualQuaternion.rotation(), normalizedDualQuaternion.translation()});
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> points) {
+    transformInterleaved(points.data(), points.size(), MatrixPointTransform{matrix});
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayView<Float> x, const Containers::ArrayView<Float> y, const Containers::ArrayView<Float> z) {
+    CORRADE_ASSERT(y.size() == x.size() && z.size() == x.size(),
+        "MeshTools::transformPointsInPlace(): expected arrays of the same size but got" << x.size() << Debug::nospace << "," << y.size() << "and" << z.size(), );
+
+    transformSeparate(x.data(), y.data(), z.data(), x.size(), MatrixPointTransform{matrix});
+}
+
+}}
@@ -29,8 +29,13 @@
  * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
  */
 
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -77,6 +82,43 @@ template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>&
     for(auto& vector: vectors) vector = matrix.transformVector(vector);
 }
 
+/**
+@brief Transform contiguous vectors in-place using given quaternion
+
+Same as @ref transformVectorsInPlace(const Math::Quaternion<T>&, U&), but the
+vectors are processed in blocks of SIMD-friendly layout and in parallel on
+large arrays.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Quaternion& normalizedQuaternion, Containers::ArrayView<Vector3> vectors);
+
+/** @overload */
+inline void transformVectorsInPlace(const Quaternion& normalizedQuaternion, std::vector<Vector3>& vectors) {
+    transformVectorsInPlace(normalizedQuaternion, Containers::ArrayView<Vector3>{vectors.data(), vectors.size()});
+}
+
+/**
+@brief Transform contiguous vectors in-place using given matrix
+
+Same as @ref transformVectorsInPlace(const Math::Matrix4<T>&, U&), but the
+vectors are processed in blocks of SIMD-friendly layout and in parallel on
+large arrays.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> vectors);
+
+/** @overload */
+inline void transformVectorsInPlace(const Matrix4& matrix, std::vector<Vector3>& vectors) {
+    transformVectorsInPlace(matrix, Containers::ArrayView<Vector3>{vectors.data(), vectors.size()});
+}
+
+/**
+@brief Transform vectors in structure-of-arrays layout in-place using given matrix
+
+Like @ref transformVectorsInPlace(const Matrix4&, Containers::ArrayView<Vector3>),
+but with the vector components in separate arrays. Expects that all arrays have
+the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayView<Float> x, Containers::ArrayView<Float> y, Containers::ArrayView<Float> z);
+
 /**
 @brief Transform vectors using given transformation
 
@@ -132,6 +174,43 @@ template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& m
     for(auto& point: points) point = matrix.transformPoint(point);
 }
 
+/**
+@brief Transform contiguous points in-place using given dual quaternion
+
+Same as @ref transformPointsInPlace(const Math::DualQuaternion<T>&, U&), but
+the points are processed in blocks of SIMD-friendly layout and in parallel on
+large arrays.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, Containers::ArrayView<Vector3> points);
+
+/** @overload */
+inline void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, std::vector<Vector3>& points) {
+    transformPointsInPlace(normalizedDualQuaternion, Containers::ArrayView<Vector3>{points.data(), points.size()});
+}
+
+/**
+@brief Transform contiguous points in-place using given matrix
+
+Same as @ref transformPointsInPlace(const Math::Matrix4<T>&, U&), but the
+points are processed in blocks of SIMD-friendly layout and in parallel on
+large arrays.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> points);
+
+/** @overload */
+inline void transformPointsInPlace(const Matrix4& matrix, std::vector<Vector3>& points) {
+    transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{points.data(), points.size()});
+}
+
+/**
+@brief Transform points in structure-of-arrays layout in-place using given matrix
+
+Like @ref transformPointsInPlace(const Matrix4&, Containers::ArrayView<Vector3>),
+but with the point coordinates in separate arrays. Expects that all arrays have
+the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const Matrix4& matrix, Containers::ArrayView<Float> x, Containers::ArrayView<Float> y, Containers::ArrayView<Float> z);
+
 /**
 @brief Transform points using given transformation
 
@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <tuple>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/MeshTools/StreamCodec.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+#include "meshbakerConfigure.h"
+
+namespace Magnum {
+
+/** @page magnum-meshbaker Mesh baking utility
+@brief Converts a mesh to a binary blob ready to be uploaded to the GPU
+
+@section magnum-meshbaker-usage Usage
+
+    magnum-meshbaker [-h|--help] [--importer IMPORTER] [--plugin-dir DIR] [--mesh N] [--no-optimize] [--encode] [--quantization-bits N] [--] input output
+
+Arguments:
+
+-   `input` -- input file
+-   `output` -- output mesh blob
+-   `-h`, `--help` -- display help message and exit
+-   `--importer IMPORTER` -- scene importer plugin (default:
+    @ref Trade::ObjImporter "ObjImporter")
+-   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
+    Magnum install location)
+-   `--mesh N` -- ID of the 3D mesh to bake (default: `0`)
+-   `--no-optimize` -- don't optimize the mesh for vertex cache and vertex
+    fetch
+-   `--encode` -- compress the vertex and index data, see below
+-   `--quantization-bits N` -- quantization bits for each vertex component of
+    encoded data, from `1` to `24` (default: `16`)
+
+The 3D mesh is imported using @ref Trade::AbstractImporter::mesh3D(),
+non-indexed meshes get a trivial index buffer. Indexed triangle meshes are
+then reordered using @ref MeshTools::optimizeVertexCache() and
+@ref MeshTools::optimizeVertexFetch(), positions, normals and first set of
+texture coordinates are interleaved into a single vertex buffer and the
+indices are compressed to the smallest possible type using
+@ref MeshTools::compressIndices(). The result is saved in a format
+described by @ref Trade::MeshBlobHeader and can be loaded without any
+processing using the @ref Trade::MeshBlobImporter "MeshBlobImporter" plugin.
+
+With `--encode`, the vertex data are quantized and compressed using
+@ref MeshTools::encodeVertexStream() and the indices using
+@ref MeshTools::encodeIndexStream(). Thanks to the vertex cache and vertex
+fetch optimization the differences between consecutive items are small, so
+the file is usually a fraction of the original size. The data are then
+decoded by the importer on load, see @ref Trade::MeshBlobFlag for details.
+
+@section magnum-meshbaker-example Example usage
+
+    magnum-meshbaker scene.obj scene.blob
+
+This will import the first mesh from `scene.obj` using the
+@ref Trade::ObjImporter "ObjImporter" plugin and saves the optimized mesh to
+`scene.blob`.
+
+*/
+
+namespace MeshTools {
+
+namespace {
+
+template<class T> void copyAttribute(char* const data, const std::size_t offset, const std::size_t stride, const std::vector<T>& attribute) {
+    for(std::size_t i = 0; i != attribute.size(); ++i)
+        std::memcpy(data + offset + i*stride, &attribute[i], sizeof(T));
+}
+
+template<class T> void addAttribute(std::vector<Trade::MeshBlobAttribute>& attributes, std::size_t& stride, const Trade::MeshAttributeName name, const Trade::MeshAttributeType type) {
+    attributes.push_back({UnsignedByte(name), UnsignedByte(type), 0, 0, stride});
+    stride += sizeof(T);
+}
+
+Trade::MeshIndexType meshIndexType(const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: return Trade::MeshIndexType::UnsignedByte;
+        case Mesh::IndexType::UnsignedShort: return Trade::MeshIndexType::UnsignedShort;
+        case Mesh::IndexType::UnsignedInt: return Trade::MeshIndexType::UnsignedInt;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+}
+
+}
+
+int main(int argc, char** argv) {
+    using namespace Magnum;
+
+    Utility::Arguments args;
+    args.addArgument("input").setHelp("input", "input file")
+        .addArgument("output").setHelp("output", "output mesh blob")
+        .addOption("importer", "ObjImporter").setHelp("importer", "scene importer plugin")
+        .addOption("plugin-dir", MAGNUM_PLUGINS_DIR).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addOption("mesh", "0").setHelp("mesh", "ID of the 3D mesh to bake", "N")
+        .addBooleanOption("no-optimize").setHelp("no-optimize", "don't optimize the mesh for vertex cache and vertex fetch")
+        .addBooleanOption("encode").setHelp("encode", "compress the vertex and index data")
+        .addOption("quantization-bits", "16").setHelp("quantization-bits", "quantization bits for each vertex component of encoded data", "N")
+        .setHelp("Converts a mesh to a binary blob ready to be uploaded to the GPU.")
+        .parse(argc, argv);
+
+    /* Load importer plugin */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager(Utility::Directory::join(args.value("plugin-dir"), "importers/"));
+    if(!(importerManager.load(args.value("importer")) & PluginManager::LoadState::Loaded))
+        return 1;
+    std::unique_ptr<Trade::AbstractImporter> importer = importerManager.instance(args.value("importer"));
+
+    /* Open input file */
+    std::optional<Trade::MeshData3D> mesh;
+    const UnsignedInt id = args.value<UnsignedInt>("mesh");
+    if(!importer->openFile(args.value("input")) || id >= importer->mesh3DCount() || !(mesh = importer->mesh3D(id))) {
+        Error() << "Cannot import mesh" << id << "from" << args.value("input");
+        return 1;
+    }
+
+    /* Take the first array of each attribute */
+    std::vector<Vector3> positions = std::move(mesh->positions(0));
+    std::vector<Vector3> normals;
+    std::vector<Vector2> textureCoordinates;
+    if(mesh->hasNormals()) normals = std::move(mesh->normals(0));
+    if(mesh->hasTextureCoords2D()) textureCoordinates = std::move(mesh->textureCoords2D(0));
+
+    /* Generate trivial indices for non-indexed meshes */
+    std::vector<UnsignedInt> indices;
+    if(mesh->isIndexed()) indices = std::move(mesh->indices());
+    else {
+        indices.resize(positions.size());
+        for(std::size_t i = 0; i != indices.size(); ++i) indices[i] = i;
+    }
+
+    /* Reorder the indices and vertices */
+    if(!args.isSet("no-optimize") && mesh->primitive() == MeshPrimitive::Triangles && indices.size() % 3 == 0) {
+        Debug() << "Optimizing" << indices.size()/3 << "triangles and" << positions.size() << "vertices...";
+        MeshTools::optimizeVertexCache(indices, positions.size());
+
+        const std::vector<UnsignedInt> remap = MeshTools::optimizeVertexFetch(indices, positions.size());
+        positions = MeshTools::duplicate(remap, positions);
+        if(!normals.empty()) normals = MeshTools::duplicate(remap, normals);
+        if(!textureCoordinates.empty()) textureCoordinates = MeshTools::duplicate(remap, textureCoordinates);
+    }
+
+    /* Attribute layout */
+    std::vector<Trade::MeshBlobAttribute> attributes;
+    std::size_t stride = 0;
+    MeshTools::addAttribute<Vector3>(attributes, stride, Trade::MeshAttributeName::Position, Trade::MeshAttributeType::Vector3);
+    if(!normals.empty())
+        MeshTools::addAttribute<Vector3>(attributes, stride, Trade::MeshAttributeName::Normal, Trade::MeshAttributeType::Vector3);
+    if(!textureCoordinates.empty())
+        MeshTools::addAttribute<Vector2>(attributes, stride, Trade::MeshAttributeName::TextureCoordinates, Trade::MeshAttributeType::Vector2);
+    for(Trade::MeshBlobAttribute& attribute: attributes)
+        attribute.stride = stride;
+
+    const UnsignedInt quantizationBits = args.value<UnsignedInt>("quantization-bits");
+    if(args.isSet("encode") && (quantizationBits < 1 || quantizationBits > 24)) {
+        Error() << "Expected 1 to 24 quantization bits, got" << quantizationBits;
+        return 1;
+    }
+
+    /* Compress the indices */
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(indices);
+
+    /* Interleave the vertex data and put the aligned index data after */
+    const std::size_t vertexDataSize = positions.size()*stride;
+    const std::size_t indexOffset = (vertexDataSize + Trade::MeshBlobAlignment - 1)/Trade::MeshBlobAlignment*Trade::MeshBlobAlignment;
+    Containers::Array<char> data{Containers::ValueInit, indexOffset + indexData.size()};
+    std::size_t attributeId = 0;
+    MeshTools::copyAttribute(data, attributes[attributeId++].offset, stride, positions);
+    if(!normals.empty())
+        MeshTools::copyAttribute(data, attributes[attributeId++].offset, stride, normals);
+    if(!textureCoordinates.empty())
+        MeshTools::copyAttribute(data, attributes[attributeId++].offset, stride, textureCoordinates);
+    std::copy(indexData.begin(), indexData.end(), data + indexOffset);
+
+    /* Replace the data with encoded vertex and index streams, the attribute
+       table still describes the decoded layout */
+    UnsignedInt flags = 0;
+    std::size_t dataIndexOffset = indexOffset;
+    if(args.isSet("encode")) {
+        const Containers::Array<char> vertexStream = MeshTools::encodeVertexStream({reinterpret_cast<const Float*>(data.data()), vertexDataSize/sizeof(Float)}, stride/sizeof(Float), quantizationBits);
+        const Containers::Array<char> indexStream = MeshTools::encodeIndexStream(indices);
+        Debug() << "Encoded" << data.size() << "bytes of data into" << vertexStream.size() + indexStream.size() << "bytes";
+
+        data = Containers::Array<char>{vertexStream.size() + indexStream.size()};
+        std::copy(vertexStream.begin(), vertexStream.end(), data.begin());
+        std::copy(indexStream.begin(), indexStream.end(), data + vertexStream.size());
+        dataIndexOffset = vertexStream.size();
+        flags = UnsignedInt(Trade::MeshBlobFlag::EncodedVertices)|UnsignedInt(Trade::MeshBlobFlag::EncodedIndices);
+    }
+
+    /* Header */
+    Trade::MeshBlobHeader header{};
+    std::copy_n(Trade::MeshBlobIdentifier, sizeof(Trade::MeshBlobIdentifier), header.identifier);
+    header.version = Trade::MeshBlobVersion;
+    header.endianness = 0x04030201;
+    header.primitive = UnsignedInt(mesh->primitive());
+    header.vertexCount = positions.size();
+    header.indexType = UnsignedInt(MeshTools::meshIndexType(indexType));
+    header.indexCount = indices.size();
+    header.indexOffset = dataIndexOffset;
+    header.attributeCount = attributes.size();
+    header.flags = flags;
+    header.dataOffset = (sizeof(Trade::MeshBlobHeader) + attributes.size()*sizeof(Trade::MeshBlobAttribute) + Trade::MeshBlobAlignment - 1)/Trade::MeshBlobAlignment*Trade::MeshBlobAlignment;
+    header.dataSize = data.size();
+
+    /* Save the file */
+    std::ofstream out{args.value("output"), std::ofstream::binary};
+    if(!out.good()) {
+        Error() << "Cannot open file" << args.value("output") << "for writing";
+        return 1;
+    }
+
+    const char padding[Trade::MeshBlobAlignment]{};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(attributes.data()), attributes.size()*sizeof(Trade::MeshBlobAttribute));
+    out.write(padding, header.dataOffset - sizeof(header) - attributes.size()*sizeof(Trade::MeshBlobAttribute));
+    out.write(data, data.size());
+
+    Debug() << "Saved" << header.vertexCount << "vertices with stride" << stride << "and" << header.indexCount << indexType << "indices to" << args.value("output");
+    return 0;
+}
@@ -29,11 +29,15 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/Tracing.h"
 
 #include "Implementation/State.h"
 #include "Implementation/MeshState.h"
+#include "Implementation/capture.h"
+#include "Implementation/statistics.h"
 
 namespace Magnum {
 
@@ -41,6 +45,8 @@ void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::re
     /* Why std::initializer_list doesn't have empty()? */
     if(!meshes.size()) return;
 
+    MAGNUM_TRACE_ZONE("MeshView::draw");
+
     shader.use();
 
     #ifndef CORRADE_NO_ASSERT
@@ -87,10 +93,15 @@ void MeshView::multiDrawImplementationDefault(std::initializer_list<std::referen
             #endif
         }
 
+        /* Multi-draws are captured as separate draws, the replay has no
+           concept of views */
+        MAGNUM_CAPTURE(draw(original._id, GLenum(original._primitive), mesh._count, mesh._baseVertex, 1, original._indexBuffer ? original._indexBuffer->id() : 0, original._indexBuffer ? GLenum(original._indexType) : 0, mesh._indexOffset));
+
         ++i;
     }
 
     (original.*state.bindImplementation)();
+    MAGNUM_STATISTICS_INCREMENT(drawCalls);
 
     /* Non-indexed meshes */
     if(!original._indexBuffer) {
@@ -139,12 +150,106 @@ void MeshView::multiDrawImplementationFallback(std::initializer_list<std::refere
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshView::drawIndirect(AbstractShaderProgram& shader, Mesh& mesh, Buffer& buffer, const GLintptr offset, const Int drawCount, const GLsizei stride) {
+    if(!drawCount) return;
+
+    shader.use();
+
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    (mesh.*state.bindImplementation)();
+
+    /* Non-indexed meshes */
+    if(!mesh._indexBuffer) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_STATISTICS_INCREMENT(drawCalls);
+        glMultiDrawArraysIndirect(GLenum(mesh._primitive), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+        #else
+        MAGNUM_STATISTICS_ADD(drawCalls, drawCount);
+        const GLintptr actualStride = stride ? stride : sizeof(DrawArraysIndirectCommand);
+        for(Int i = 0; i != drawCount; ++i)
+            glDrawArraysIndirect(GLenum(mesh._primitive), reinterpret_cast<GLvoid*>(offset + i*actualStride));
+        #endif
+
+    /* Indexed meshes */
+    } else {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_STATISTICS_INCREMENT(drawCalls);
+        glMultiDrawElementsIndirect(GLenum(mesh._primitive), GLenum(mesh._indexType), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+        #else
+        MAGNUM_STATISTICS_ADD(drawCalls, drawCount);
+        const GLintptr actualStride = stride ? stride : sizeof(DrawElementsIndirectCommand);
+        for(Int i = 0; i != drawCount; ++i)
+            glDrawElementsIndirect(GLenum(mesh._primitive), GLenum(mesh._indexType), reinterpret_cast<GLvoid*>(offset + i*actualStride));
+        #endif
+    }
+
+    (mesh.*state.unbindImplementation)();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshView::drawIndirect(AbstractShaderProgram& shader, Mesh& mesh, Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const Int maxDrawCount, const GLsizei stride) {
+    CORRADE_ASSERT(countOffset % 4 == 0,
+        "MeshView::drawIndirect(): count offset" << countOffset << "is not a multiple of 4", );
+
+    if(!maxDrawCount) return;
+
+    shader.use();
+
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    countBuffer.bindInternal(Buffer::TargetHint::Parameter);
+    (mesh.*state.bindImplementation)();
+
+    MAGNUM_STATISTICS_INCREMENT(drawCalls);
+
+    /* Non-indexed meshes */
+    if(!mesh._indexBuffer)
+        glMultiDrawArraysIndirectCountARB(GLenum(mesh._primitive), offset, countOffset, maxDrawCount, stride);
+
+    /* Indexed meshes */
+    else
+        glMultiDrawElementsIndirectCountARB(GLenum(mesh._primitive), GLenum(mesh._indexType), offset, countOffset, maxDrawCount, stride);
+
+    (mesh.*state.unbindImplementation)();
+}
+#endif
+
+MeshView::DrawArraysIndirectCommand MeshView::arraysIndirectCommand() const {
+    CORRADE_ASSERT(!_original.get()._indexBuffer,
+        "MeshView::arraysIndirectCommand(): the mesh is indexed", {});
+
+    #ifndef MAGNUM_TARGET_GLES
+    return {UnsignedInt(_count), UnsignedInt(_instanceCount), UnsignedInt(_baseVertex), _baseInstance};
+    #else
+    return {UnsignedInt(_count), UnsignedInt(_instanceCount), UnsignedInt(_baseVertex), 0};
+    #endif
+}
+
+MeshView::DrawElementsIndirectCommand MeshView::elementsIndirectCommand() const {
+    CORRADE_ASSERT(_original.get()._indexBuffer,
+        "MeshView::elementsIndirectCommand(): the mesh is not indexed", {});
+
+    const UnsignedInt firstIndex = _indexOffset/_original.get().indexSize();
+    #ifndef MAGNUM_TARGET_GLES
+    return {UnsignedInt(_count), UnsignedInt(_instanceCount), firstIndex, _baseVertex, _baseInstance};
+    #else
+    return {UnsignedInt(_count), UnsignedInt(_instanceCount), firstIndex, _baseVertex, 0};
+    #endif
+}
+#endif
+
 MeshView& MeshView::setIndexRange(Int first) {
     _indexOffset = _original.get()._indexOffset + first*_original.get().indexSize();
     return *this;
 }
 
 void MeshView::draw(AbstractShaderProgram& shader) {
+    MAGNUM_TRACE_ZONE("MeshView::draw");
+
     shader.use();
 
     #ifndef MAGNUM_TARGET_GLES
@@ -55,11 +55,157 @@ no draw commands are issued when calling @ref draw().
 
 You must ensure that the original mesh remains available for whole view
 lifetime.
+
+@anchor MeshView-indirect
+## Indirect drawing
+
+Besides @ref draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>),
+which gathers the draw parameters on the CPU on every call, it's possible to
+have the draw commands stored in a buffer and submit all of them with a single
+@ref drawIndirect() call. The buffer can be filled on the CPU from
+@ref arraysIndirectCommand() or @ref elementsIndirectCommand() of each view
+or generated on the GPU, for example by culling in a compute shader:
+@code
+std::vector<MeshView::DrawElementsIndirectCommand> data;
+for(const MeshView& view: views) data.push_back(view.elementsIndirectCommand());
+
+Buffer commands{Buffer::TargetHint::DrawIndirect};
+commands.setData(data, BufferUsage::StaticDraw);
+
+MeshView::drawIndirect(shader, mesh, commands, 0, data.size());
+@endcode
 */
 class MAGNUM_EXPORT MeshView {
     friend Implementation::MeshState;
 
     public:
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Indirect draw command for non-indexed meshes
+         *
+         * Layout of a single command in the buffer passed to
+         * @ref drawIndirect() for non-indexed meshes.
+         * @see @ref arraysIndirectCommand()
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        struct DrawArraysIndirectCommand {
+            UnsignedInt count;          /**< @brief Vertex count */
+            UnsignedInt instanceCount;  /**< @brief Instance count */
+            UnsignedInt first;          /**< @brief First vertex */
+
+            /**
+             * @brief Base instance
+             *
+             * Reserved and expected to be `0` in OpenGL ES.
+             */
+            UnsignedInt baseInstance;
+        };
+
+        /**
+         * @brief Indirect draw command for indexed meshes
+         *
+         * Layout of a single command in the buffer passed to
+         * @ref drawIndirect() for indexed meshes.
+         * @see @ref elementsIndirectCommand()
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        struct DrawElementsIndirectCommand {
+            UnsignedInt count;          /**< @brief Index count */
+            UnsignedInt instanceCount;  /**< @brief Instance count */
+
+            /** @brief First index, relative to start of the index buffer */
+            UnsignedInt firstIndex;
+
+            Int baseVertex;             /**< @brief Base vertex */
+
+            /**
+             * @brief Base instance
+             *
+             * Reserved and expected to be `0` in OpenGL ES.
+             */
+            UnsignedInt baseInstance;
+        };
+
+        /**
+         * @brief Draw meshes using commands from a buffer
+         * @param shader    Shader to draw with
+         * @param mesh      Mesh to draw
+         * @param buffer    Buffer with the commands
+         * @param offset    Offset of first command in the buffer
+         * @param drawCount Count of commands
+         * @param stride    Distance between commands in the buffer. If `0`,
+         *      the commands are assumed to be tightly packed.
+         *
+         * The buffer is expected to contain @ref DrawElementsIndirectCommand
+         * if the mesh is indexed and @ref DrawArraysIndirectCommand
+         * otherwise. The remaining parameters of the mesh are ignored. If
+         * @p drawCount is `0`, no draw commands are issued. In OpenGL ES the
+         * functionality is emulated using a sequence of single indirect draw
+         * calls. See @ref MeshView-indirect "class documentation" for an
+         * example.
+         * @attention All vertex and index data need to be in buffers, the
+         *      mesh must not use client-side arrays.
+         * @see @fn_gl{UseProgram}, @fn_gl{BindBuffer} with
+         *      @def_gl{DRAW_INDIRECT_BUFFER}, @fn_gl{BindVertexArray},
+         *      @fn_gl{MultiDrawArraysIndirect}/@fn_gl{DrawArraysIndirect} or
+         *      @fn_gl{MultiDrawElementsIndirect}/@fn_gl{DrawElementsIndirect}
+         * @requires_gl43 Extension @extension{ARB,multi_draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        static void drawIndirect(AbstractShaderProgram& shader, Mesh& mesh, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0);
+
+        /** @overload */
+        static void drawIndirect(AbstractShaderProgram&& shader, Mesh& mesh, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0) {
+            drawIndirect(shader, mesh, buffer, offset, drawCount, stride);
+        }
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Draw meshes using commands and draw count from a buffer
+         * @param shader        Shader to draw with
+         * @param mesh          Mesh to draw
+         * @param buffer        Buffer with the commands
+         * @param offset        Offset of first command in the buffer
+         * @param countBuffer   Buffer with the draw count
+         * @param countOffset   Offset of the draw count in @p countBuffer
+         * @param maxDrawCount  Upper bound on the draw count
+         * @param stride        Distance between commands in the buffer. If
+         *      `0`, the commands are assumed to be tightly packed.
+         *
+         * Like @ref drawIndirect(AbstractShaderProgram&, Mesh&, Buffer&, GLintptr, Int, GLsizei),
+         * but the count of commands is read from an
+         * @ref Magnum::UnsignedInt "UnsignedInt" at @p countOffset in
+         * @p countBuffer, clamped to @p maxDrawCount. That allows the
+         * commands to be compacted on the GPU, for example by
+         * @ref Shaders::FrustumCulling, without reading the count back. The
+         * @p countOffset is expected to be a multiple of `4`. If
+         * @p maxDrawCount is `0`, no draw commands are issued.
+         * @see @ref Buffer::TargetHint::Parameter, @fn_gl{UseProgram},
+         *      @fn_gl{BindBuffer} with @def_gl{DRAW_INDIRECT_BUFFER} and
+         *      @def_gl{PARAMETER_BUFFER_ARB}, @fn_gl{BindVertexArray},
+         *      @fn_gl_extension{MultiDrawArraysIndirectCount,ARB,indirect_parameters}
+         *      or @fn_gl_extension{MultiDrawElementsIndirectCount,ARB,indirect_parameters}
+         * @requires_extension Extension @extension{ARB,indirect_parameters}
+         * @requires_gl Indirect draw count is not available in OpenGL ES or
+         *      WebGL.
+         */
+        static void drawIndirect(AbstractShaderProgram& shader, Mesh& mesh, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, Int maxDrawCount, GLsizei stride = 0);
+
+        /** @overload */
+        static void drawIndirect(AbstractShaderProgram&& shader, Mesh& mesh, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, Int maxDrawCount, GLsizei stride = 0) {
+            drawIndirect(shader, mesh, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+        }
+        #endif
+
         /**
          * @brief Draw multiple meshes at once
          *
@@ -199,6 +345,24 @@ class MAGNUM_EXPORT MeshView {
         }
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Indirect draw command for non-indexed view
+         *
+         * Expects that the original mesh is not indexed.
+         * @see @ref drawIndirect()
+         */
+        DrawArraysIndirectCommand arraysIndirectCommand() const;
+
+        /**
+         * @brief Indirect draw command for indexed view
+         *
+         * Expects that the original mesh is indexed.
+         * @see @ref drawIndirect()
+         */
+        DrawElementsIndirectCommand elementsIndirectCommand() const;
+        #endif
+
         /**
          * @brief Draw the mesh
          *
@@ -0,0 +1,119 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MultisampleFramebuffer.h"
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+
+namespace Magnum {
+
+MultisampleFramebuffer::MultisampleFramebuffer(Texture2D& texture, const Vector2i& size, const Int samples, const RenderbufferFormat colorFormat, const RenderbufferFormat depthFormat): _framebuffer{{{}, size}}, _resolveFramebuffer{NoCreate}, _color{NoCreate}, _size{size}, _samples{samples}, _implicitResolve{false}, _depthStencil{
+    depthFormat == RenderbufferFormat::Depth24Stencil8
+    #ifndef MAGNUM_TARGET_GLES2
+    || depthFormat == RenderbufferFormat::Depth32FStencil8
+    #endif
+    } {
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    _implicitResolve = Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>();
+    #endif
+
+    /* With implicit resolve the texture is rendered to directly, otherwise
+       render to multisample color buffer and blit to the texture attached to
+       another framebuffer */
+    if(_implicitResolve) {
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        _framebuffer.attachTextureImplicitResolve(Framebuffer::ColorAttachment{0}, texture, 0, samples);
+        _depth.setStorageMultisampleImplicitResolve(samples, depthFormat, size);
+        #endif
+    } else {
+        _color = Renderbuffer{};
+        _color.setStorageMultisample(samples, colorFormat, size);
+        _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, _color);
+        _depth.setStorageMultisample(samples, depthFormat, size);
+
+        _resolveFramebuffer = Framebuffer{{{}, size}};
+        _resolveFramebuffer.attachTexture(Framebuffer::ColorAttachment{0}, texture, 0);
+    }
+
+    /* ES2 has no combined depth/stencil attachment point */
+    #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+    _framebuffer.attachRenderbuffer(_depthStencil ?
+        Framebuffer::BufferAttachment::DepthStencil :
+        Framebuffer::BufferAttachment::Depth, _depth);
+    #else
+    _framebuffer.attachRenderbuffer(Framebuffer::BufferAttachment::Depth, _depth);
+    if(_depthStencil)
+        _framebuffer.attachRenderbuffer(Framebuffer::BufferAttachment::Stencil, _depth);
+    #endif
+}
+
+void MultisampleFramebuffer::resolve(const Range2Di& rectangle) {
+    if(!_implicitResolve)
+        AbstractFramebuffer::blit(_framebuffer, _resolveFramebuffer, rectangle, FramebufferBlit::Color);
+
+    #ifndef MAGNUM_TARGET_GLES2
+    invalidate(!_implicitResolve, rectangle);
+    #endif
+}
+
+void MultisampleFramebuffer::resolve() {
+    if(!_implicitResolve)
+        AbstractFramebuffer::blit(_framebuffer, _resolveFramebuffer, {{}, _size}, FramebufferBlit::Color);
+
+    invalidate(!_implicitResolve);
+}
+
+void MultisampleFramebuffer::invalidate(const bool color) {
+    /* The color attachment is skipped if it's the implicitly resolved
+       texture, stencil if there's none */
+    const Framebuffer::InvalidationAttachment attachments[]{
+        Framebuffer::ColorAttachment{0},
+        Framebuffer::InvalidationAttachment::Depth,
+        Framebuffer::InvalidationAttachment::Stencil};
+    const std::size_t offset = color ? 0 : 1;
+    _framebuffer.invalidate(Containers::ArrayView<const Framebuffer::InvalidationAttachment>{attachments + offset, 3 - offset - (_depthStencil ? 0 : 1)});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void MultisampleFramebuffer::invalidate(const bool color, const Range2Di& rectangle) {
+    if(color && _depthStencil)
+        _framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth,
+                                 Framebuffer::InvalidationAttachment::Stencil,
+                                 Framebuffer::ColorAttachment{0}}, rectangle);
+    else if(color)
+        _framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth,
+                                 Framebuffer::ColorAttachment{0}}, rectangle);
+    else if(_depthStencil)
+        _framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth,
+                                 Framebuffer::InvalidationAttachment::Stencil}, rectangle);
+    else
+        _framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth}, rectangle);
+}
+#endif
+
+}
@@ -0,0 +1,185 @@
+#ifndef Magnum_MultisampleFramebuffer_h
+#define Magnum_MultisampleFramebuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MultisampleFramebuffer
+ */
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum {
+
+/**
+@brief Multisample framebuffer with resolve into a texture
+
+Renders with multisampling and resolves the result into a single-sample
+@ref Texture2D, picking the cheapest way the implementation offers.
+
+## Usage
+
+The texture needs to have its storage set up before passing it to the
+constructor, the framebuffer then renders into it through a multisample color
+attachment and a multisample depth attachment:
+@code
+Texture2D texture;
+texture.setStorage(1, TextureFormat::RGBA8, size);
+
+MultisampleFramebuffer msaa{texture, size, 4, RenderbufferFormat::RGBA8,
+    RenderbufferFormat::Depth24Stencil8};
+
+// each frame
+msaa.framebuffer()
+    .clear(FramebufferClear::Color|FramebufferClear::Depth)
+    .bind();
+// draw ...
+msaa.resolve();
+@endcode
+
+## Performance optimizations
+
+If @es_extension{EXT,multisampled_render_to_texture} is available on OpenGL
+ES, the texture is attached directly with
+@ref Framebuffer::attachTextureImplicitResolve() and the depth buffer is
+created with @ref Renderbuffer::setStorageMultisampleImplicitResolve(). The
+samples then exist only in on-chip tile memory and are resolved when the tile
+is written out, so there is no separate multisample storage and no blit, see
+@ref isImplicitResolve().
+
+Otherwise the color and depth are multisample @ref Renderbuffer "Renderbuffers"
+and @ref resolve() blits only the color attachment and only the requested
+region into the texture. Depth is never resolved.
+
+In both cases the multisample attachments which are no longer needed are
+invalidated after the resolve, so tiled GPUs don't need to write them back to
+memory.
+
+@requires_gles30 Extension @es_extension{ANGLE,framebuffer_multisample} or
+    @es_extension{NV,framebuffer_multisample} and
+    @es_extension{ANGLE,framebuffer_blit} or
+    @es_extension{NV,framebuffer_blit} in OpenGL ES 2.0, if
+    @es_extension{EXT,multisampled_render_to_texture} is not available.
+@requires_webgl20 Multisample framebuffers are not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT MultisampleFramebuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param texture       Texture to resolve into
+         * @param size          Framebuffer size
+         * @param samples       Sample count
+         * @param colorFormat   Format of the multisample color buffer. Should
+         *      match format of @p texture. Not used with implicit resolve.
+         * @param depthFormat   Format of the multisample depth buffer. If
+         *      @ref RenderbufferFormat::Depth24Stencil8 or
+         *      @ref RenderbufferFormat::Depth32FStencil8, it's attached also
+         *      as stencil buffer.
+         *
+         * The texture is expected to have its storage set up already and to
+         * be at least as large as @p size. Only the reference is used during
+         * construction, the texture is not owned.
+         * @see @ref framebuffer(), @ref Framebuffer::checkStatus()
+         */
+        explicit MultisampleFramebuffer(Texture2D& texture, const Vector2i& size, Int samples, RenderbufferFormat colorFormat, RenderbufferFormat depthFormat);
+
+        /** @brief Copying is not allowed */
+        MultisampleFramebuffer(const MultisampleFramebuffer&) = delete;
+
+        /** @brief Moving is not allowed */
+        MultisampleFramebuffer(MultisampleFramebuffer&&) = delete;
+
+        /** @brief Copying is not allowed */
+        MultisampleFramebuffer& operator=(const MultisampleFramebuffer&) = delete;
+
+        /** @brief Moving is not allowed */
+        MultisampleFramebuffer& operator=(MultisampleFramebuffer&&) = delete;
+
+        /**
+         * @brief Framebuffer to render into
+         *
+         * Has the multisample color buffer attached to
+         * @ref Framebuffer::ColorAttachment "Framebuffer::ColorAttachment(0)".
+         */
+        Framebuffer& framebuffer() { return _framebuffer; }
+
+        /** @brief Framebuffer size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Sample count */
+        Int samples() const { return _samples; }
+
+        /**
+         * @brief Whether the resolve is implicit
+         *
+         * If @es_extension{EXT,multisampled_render_to_texture} is used, the
+         * samples are resolved into the texture implicitly and
+         * @ref resolve() only invalidates the depth buffer. Always `false`
+         * on desktop OpenGL and WebGL.
+         */
+        bool isImplicitResolve() const { return _implicitResolve; }
+
+        /**
+         * @brief Resolve given region into the texture
+         *
+         * If the resolve is not implicit, blits the color attachment in
+         * @p rectangle into the texture with
+         * @ref AbstractFramebuffer::blit() and then invalidates the
+         * multisample color and depth buffers in @p rectangle. Otherwise only
+         * invalidates the depth buffer.
+         * @see @ref isImplicitResolve(), @ref Framebuffer::invalidate()
+         * @requires_gles30 Invalidating only a region is not available in
+         *      OpenGL ES 2.0, nothing is invalidated there.
+         */
+        void resolve(const Range2Di& rectangle);
+
+        /**
+         * @brief Resolve whole framebuffer into the texture
+         *
+         * Same as above, but resolves and invalidates the whole framebuffer.
+         */
+        void resolve();
+
+    private:
+        void MAGNUM_LOCAL invalidate(bool color);
+        #ifndef MAGNUM_TARGET_GLES2
+        void MAGNUM_LOCAL invalidate(bool color, const Range2Di& rectangle);
+        #endif
+
+        Framebuffer _framebuffer, _resolveFramebuffer;
+        Renderbuffer _color, _depth;
+        Vector2i _size;
+        Int _samples;
+        bool _implicitResolve, _depthStencil;
+};
+
+}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef Magnum_PipelineStatisticsQuery_h
+#define Magnum_PipelineStatisticsQuery_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::PipelineStatisticsQuery
+ */
+#endif
+
+#include "Magnum/AbstractQuery.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Query for pipeline statistics
+
+Queries count of vertices, primitives and shader invocations processed by
+given pipeline stage. Useful for finding overdraw (high count of fragment
+shader invocations compared to the covered area) or vertex-bound passes (high
+count of vertex shader invocations compared to the submitted vertices, which
+means poor post-transform cache usage). Example usage:
+@code
+PipelineStatisticsQuery q{PipelineStatisticsQuery::Target::FragmentShaderInvocations};
+
+q.begin();
+// rendering...
+q.end();
+
+if(!q.resultAvailable()) {
+    // do some work until to give OpenGL some time...
+}
+
+// ...or block until the result is available
+UnsignedLong invocationCount = q.result<UnsignedLong>();
+@endcode
+
+Only one query of each target can be active at a time, but queries of
+different targets can be active together. See @ref QueryPool for a way to
+reuse the query objects without waiting for the results and
+@ref DebugTools::Profiler for per-section statistics.
+@see @ref PrimitiveQuery, @ref SampleQuery, @ref TimeQuery
+@requires_extension Extension @extension{ARB,pipeline_statistics_query}
+@requires_gl Pipeline statistics queries are not available in OpenGL ES and
+    WebGL.
+*/
+class PipelineStatisticsQuery: public AbstractQuery {
+    public:
+        /** @brief Query target */
+        enum class Target: GLenum {
+            /** Count of vertices submitted to the primitive assembler. */
+            VerticesSubmitted = GL_VERTICES_SUBMITTED_ARB,
+
+            /** Count of primitives submitted to the primitive assembler. */
+            PrimitivesSubmitted = GL_PRIMITIVES_SUBMITTED_ARB,
+
+            /** Count of vertex shader invocations. */
+            VertexShaderInvocations = GL_VERTEX_SHADER_INVOCATIONS_ARB,
+
+            /** Count of patches processed by tessellation control shader. */
+            TessellationControlShaderPatches = GL_TESS_CONTROL_SHADER_PATCHES_ARB,
+
+            /** Count of tessellation evaluation shader invocations. */
+            TessellationEvaluationShaderInvocations = GL_TESS_EVALUATION_SHADER_INVOCATIONS_ARB,
+
+            /** Count of geometry shader invocations. */
+            GeometryShaderInvocations = GL_GEOMETRY_SHADER_INVOCATIONS,
+
+            /** Count of primitives emitted by geometry shader. */
+            GeometryShaderPrimitivesEmitted = GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED_ARB,
+
+            /** Count of fragment shader invocations. */
+            FragmentShaderInvocations = GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+
+            /** Count of compute shader invocations. */
+            ComputeShaderInvocations = GL_COMPUTE_SHADER_INVOCATIONS_ARB,
+
+            /** Count of primitives entering the clipping stage. */
+            ClippingInputPrimitives = GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+
+            /**
+             * Count of primitives leaving the clipping stage. Compared to
+             * @ref Target::ClippingInputPrimitives tells how much geometry is
+             * culled or clipped away.
+             */
+            ClippingOutputPrimitives = GL_CLIPPING_OUTPUT_PRIMITIVES_ARB
+        };
+
+        /**
+         * @brief Wrap existing OpenGL pipeline statistics query object
+         * @param id            OpenGL pipeline statistics query ID
+         * @param target        Query target
+         * @param flags         Object creation flags
+         *
+         * The @p id is expected to be of an existing OpenGL query object.
+         * Unlike query created using constructor, the OpenGL object is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static PipelineStatisticsQuery wrap(GLuint id, Target target, ObjectFlags flags = {}) {
+            return PipelineStatisticsQuery{id, target, flags};
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Creates new OpenGL query object. If @extension{ARB,direct_state_access}
+         * (part of OpenGL 4.5) is not available, the query is created on first
+         * use.
+         * @see @ref PipelineStatisticsQuery(NoCreateT), @ref wrap(),
+         *      @fn_gl{CreateQueries}, eventually @fn_gl{GenQueries}
+         */
+        explicit PipelineStatisticsQuery(Target target): AbstractQuery(GLenum(target)) {}
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         * @see @ref PipelineStatisticsQuery(Target), @ref wrap()
+         */
+        explicit PipelineStatisticsQuery(NoCreateT) noexcept: AbstractQuery{NoCreate, GLenum(Target::VerticesSubmitted)} {}
+
+        /* Overloads to remove WTF-factor from method chaining order */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        PipelineStatisticsQuery& setLabel(const std::string& label) {
+            AbstractQuery::setLabel(label);
+            return *this;
+        }
+        template<std::size_t size> PipelineStatisticsQuery& setLabel(const char(&label)[size]) {
+            AbstractQuery::setLabel<size>(label);
+            return *this;
+        }
+        #endif
+
+    private:
+        explicit PipelineStatisticsQuery(GLuint id, Target target, ObjectFlags flags) noexcept: AbstractQuery{id, GLenum(target), flags} {}
+};
+
+}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
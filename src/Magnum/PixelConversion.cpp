@@ -0,0 +1,365 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PixelConversion.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Implementation/Parallel.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MAGNUM_PIXELCONVERSION_USE_NEON
+#endif
+
+namespace Magnum {
+
+namespace {
+
+enum: Int {
+    /* Channel semantics, used as index into Layout::index */
+    Red = 0, Green = 1, Blue = 2, Alpha = 3,
+
+    /* Source for output channels that are not in the input */
+    Zero = -1, One = -2
+};
+
+struct Layout {
+    std::size_t channelCount;
+    Int semantic[4];    /* Red, Green, Blue or Alpha for each channel */
+    Int index[4];       /* Channel with red, green, blue and alpha or -1 */
+    bool luminance;
+};
+
+/* Channel layout from a string such as "bgra", channelCount is zero for
+   unsupported formats */
+Layout layoutFor(const PixelFormat format) {
+    const char* channels;
+    bool luminance = false;
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case PixelFormat::Red: channels = "r"; break;
+        case PixelFormat::RG: channels = "rg"; break;
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case PixelFormat::Luminance: channels = "r"; luminance = true; break;
+        case PixelFormat::LuminanceAlpha: channels = "ra"; luminance = true; break;
+        #endif
+        case PixelFormat::RGB: channels = "rgb"; break;
+        case PixelFormat::RGBA: channels = "rgba"; break;
+        #ifndef MAGNUM_TARGET_GLES
+        case PixelFormat::BGR: channels = "bgr"; break;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case PixelFormat::BGRA: channels = "bgra"; break;
+        #endif
+        default: return Layout{};
+    }
+
+    Layout layout{0, {}, {-1, -1, -1, -1}, luminance};
+    for(; channels[layout.channelCount]; ++layout.channelCount) {
+        const Int semantic = channels[layout.channelCount] == 'r' ? Red :
+                             channels[layout.channelCount] == 'g' ? Green :
+                             channels[layout.channelCount] == 'b' ? Blue : Alpha;
+        layout.semantic[layout.channelCount] = semantic;
+        layout.index[semantic] = layout.channelCount;
+    }
+    return layout;
+}
+
+std::size_t channelSize(const PixelType type) {
+    switch(type) {
+        case PixelType::UnsignedByte: return 1;
+        case PixelType::HalfFloat: return 2;
+        case PixelType::Float: return 4;
+        default: return 0;
+    }
+}
+
+struct Conversion {
+    Layout from, to;
+    PixelType fromType, toType;
+    PixelConversionFlags flags;
+
+    /* Input channel for each output channel, Zero or One */
+    Int map[4];
+};
+
+/* Returns false if the conversion is not supported */
+bool conversion(Conversion& out, const PixelFormat fromFormat, const PixelType fromType, const PixelFormat toFormat, const PixelType toType, const PixelConversionFlags flags) {
+    out.from = layoutFor(fromFormat);
+    out.to = layoutFor(toFormat);
+    out.fromType = fromType;
+    out.toType = toType;
+    out.flags = flags;
+    if(!out.from.channelCount || !out.to.channelCount || !channelSize(fromType) || !channelSize(toType))
+        return false;
+
+    if(flags & PixelConversionFlag::SwapRedBlue && out.from.index[Red] != -1 && out.from.index[Blue] != -1)
+        std::swap(out.from.index[Red], out.from.index[Blue]);
+
+    for(std::size_t c = 0; c != out.to.channelCount; ++c) {
+        const Int semantic = out.to.semantic[c];
+        if(out.from.index[semantic] != -1)
+            out.map[c] = out.from.index[semantic];
+        else if(semantic != Alpha && out.from.luminance)
+            out.map[c] = out.from.index[Red];
+        else
+            out.map[c] = semantic == Alpha ? One : Zero;
+    }
+
+    return true;
+}
+
+/* Reorders channels of count pixels. With equal channel count the input and
+   output can be the same memory. */
+template<class T> void shuffle(const T* const from, T* const to, std::size_t i, const std::size_t count, const std::size_t fromChannelCount, const std::size_t toChannelCount, const Int(&map)[4], const T one) {
+    for(; i != count; ++i) {
+        T pixel[4];
+        std::copy_n(from + i*fromChannelCount, fromChannelCount, pixel);
+        for(std::size_t c = 0; c != toChannelCount; ++c)
+            to[i*toChannelCount + c] = map[c] >= 0 ? pixel[map[c]] : map[c] == One ? one : T{};
+    }
+}
+
+void shuffleBytes(const UnsignedByte* const from, UnsignedByte* const to, const std::size_t count, const std::size_t fromChannelCount, const std::size_t toChannelCount, const Int(&map)[4]) {
+    std::size_t i = 0;
+    const bool vectorizable = (fromChannelCount == 3 || fromChannelCount == 4) && (toChannelCount == 3 || toChannelCount == 4);
+    if(vectorizable) {
+        #ifdef __AVX2__
+        /* Eight pixels in a 32-byte block. The shuffle works only within each
+           16-byte lane, so it's done only for four-channel pixels that don't
+           cross the lane boundary. */
+        if(fromChannelCount == 4 && toChannelCount == 4) {
+            alignas(32) char mask[32], fill[32];
+            for(std::size_t j = 0; j != 32; ++j) {
+                const std::size_t p = (j%16)/4, c = j%4;
+                mask[j] = map[c] >= 0 ? char(p*4 + map[c]) : char(0x80);
+                fill[j] = map[c] == One ? char(0xff) : 0;
+            }
+            const __m256i mask256 = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask));
+            const __m256i fill256 = _mm256_load_si256(reinterpret_cast<const __m256i*>(fill));
+            for(; i + 8 <= count; i += 8) {
+                const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i*4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i*4), _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask256), fill256));
+            }
+        }
+        #endif
+
+        #ifdef __SSSE3__
+        /* Five three-channel pixels in a 16-byte block if both the input and
+           output has three channels, the last byte is kept and overwritten
+           by the next block. Four pixels otherwise, with the load or store
+           not using the last four bytes. Both the load and the store need to
+           stay inside the data. */
+        const std::size_t blockPixelCount = fromChannelCount == 3 && toChannelCount == 3 ? 5 : 4;
+        alignas(16) char mask[16], fill[16];
+        for(std::size_t j = 0; j != 16; ++j) {
+            const std::size_t p = j/toChannelCount, c = j%toChannelCount;
+            fill[j] = 0;
+            if(p >= blockPixelCount)
+                mask[j] = fromChannelCount == toChannelCount ? char(j) : char(0x80);
+            else if(map[c] >= 0)
+                mask[j] = char(p*fromChannelCount + map[c]);
+            else {
+                mask[j] = char(0x80);
+                if(map[c] == One) fill[j] = char(0xff);
+            }
+        }
+        const __m128i mask128 = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+        const __m128i fill128 = _mm_load_si128(reinterpret_cast<const __m128i*>(fill));
+        for(; i*fromChannelCount + 16 <= count*fromChannelCount && i*toChannelCount + 16 <= count*toChannelCount; i += blockPixelCount) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i*fromChannelCount));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i*toChannelCount), _mm_or_si128(_mm_shuffle_epi8(pixels, mask128), fill128));
+        }
+        #elif defined(MAGNUM_PIXELCONVERSION_USE_NEON)
+        /* Sixteen pixels deinterleaved into one register per channel */
+        for(; i + 16 <= count; i += 16) {
+            uint8x16_t in[4];
+            if(fromChannelCount == 3) {
+                const uint8x16x3_t pixels = vld3q_u8(from + i*3);
+                for(std::size_t c = 0; c != 3; ++c) in[c] = pixels.val[c];
+            } else {
+                const uint8x16x4_t pixels = vld4q_u8(from + i*4);
+                for(std::size_t c = 0; c != 4; ++c) in[c] = pixels.val[c];
+            }
+
+            uint8x16_t out[4];
+            for(std::size_t c = 0; c != toChannelCount; ++c)
+                out[c] = map[c] >= 0 ? in[map[c]] : vdupq_n_u8(map[c] == One ? 0xff : 0);
+
+            if(toChannelCount == 3)
+                vst3q_u8(to + i*3, uint8x16x3_t{{out[0], out[1], out[2]}});
+            else
+                vst4q_u8(to + i*4, uint8x16x4_t{{out[0], out[1], out[2], out[3]}});
+        }
+        #endif
+    }
+
+    shuffle(from, to, i, count, fromChannelCount, toChannelCount, map, UnsignedByte(0xff));
+}
+
+/* Decodes count pixels into floats with the input channel layout */
+void decode(const PixelType type, const char* const from, Float* const to, const std::size_t size) {
+    if(type == PixelType::UnsignedByte)
+        Math::unpackNormalized<UnsignedByte>({reinterpret_cast<const UnsignedByte*>(from), size}, {to, size});
+    else if(type == PixelType::HalfFloat)
+        Math::unpackHalf({reinterpret_cast<const UnsignedShort*>(from), size}, {to, size});
+    else std::memcpy(to, from, size*sizeof(Float));
+}
+
+void encode(const PixelType type, const Float* const from, char* const to, const std::size_t size) {
+    if(type == PixelType::UnsignedByte)
+        Math::packNormalized<UnsignedByte>({from, size}, {reinterpret_cast<UnsignedByte*>(to), size});
+    else if(type == PixelType::HalfFloat)
+        Math::packHalf({from, size}, {reinterpret_cast<UnsignedShort*>(to), size});
+    else std::memcpy(to, from, size*sizeof(Float));
+}
+
+/* Converts count pixels, the scratch vectors are reused between calls */
+void convert(const Conversion& conversion, const char* const from, char* const to, const std::size_t count, std::vector<Float>& input, std::vector<Float>& output) {
+    const std::size_t fromChannelCount = conversion.from.channelCount;
+    const std::size_t toChannelCount = conversion.to.channelCount;
+    const Int(&map)[4] = conversion.map;
+
+    /* Just reordering the channels, no need to go through floats */
+    if(conversion.fromType == conversion.toType && !(conversion.flags & (PixelConversionFlag::PremultiplyAlpha|PixelConversionFlag::UnpremultiplyAlpha))) {
+        if(conversion.fromType == PixelType::UnsignedByte)
+            shuffleBytes(reinterpret_cast<const UnsignedByte*>(from), reinterpret_cast<UnsignedByte*>(to), count, fromChannelCount, toChannelCount, map);
+        else if(conversion.fromType == PixelType::HalfFloat)
+            shuffle(reinterpret_cast<const UnsignedShort*>(from), reinterpret_cast<UnsignedShort*>(to), 0, count, fromChannelCount, toChannelCount, map, UnsignedShort(0x3c00));
+        else
+            shuffle(reinterpret_cast<const Float*>(from), reinterpret_cast<Float*>(to), 0, count, fromChannelCount, toChannelCount, map, 1.0f);
+        return;
+    }
+
+    input.resize(count*fromChannelCount);
+    output.resize(count*toChannelCount);
+    decode(conversion.fromType, from, input.data(), input.size());
+
+    const Int alphaIndex = conversion.from.index[Alpha];
+    const bool premultiply = !!(conversion.flags & PixelConversionFlag::PremultiplyAlpha);
+    const bool unpremultiply = !!(conversion.flags & PixelConversionFlag::UnpremultiplyAlpha);
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float* const in = input.data() + i*fromChannelCount;
+        Float* const out = output.data() + i*toChannelCount;
+        const Float alpha = alphaIndex == -1 ? 1.0f : in[alphaIndex];
+        for(std::size_t c = 0; c != toChannelCount; ++c) {
+            Float value = map[c] >= 0 ? in[map[c]] : map[c] == One ? 1.0f : 0.0f;
+            if(conversion.to.semantic[c] != Alpha) {
+                if(premultiply) value *= alpha;
+                if(unpremultiply) value = alpha != 0.0f ? value/alpha : 0.0f;
+            }
+            out[c] = value;
+        }
+    }
+
+    encode(conversion.toType, output.data(), to, output.size());
+}
+
+/* Images smaller than this are converted on a single thread by default */
+constexpr std::size_t ParallelThreshold = 1024*1024;
+
+}
+
+Debug& operator<<(Debug& debug, const PixelConversionFlag value) {
+    switch(value) {
+        #define _c(value) case PixelConversionFlag::value: return debug << "PixelConversionFlag::" #value;
+        _c(SwapRedBlue)
+        _c(PremultiplyAlpha)
+        _c(UnpremultiplyAlpha)
+        #undef _c
+    }
+
+    return debug << "PixelConversionFlag::(invalid)";
+}
+
+bool isPixelConversionSupported(const PixelFormat fromFormat, const PixelType fromType, const PixelFormat toFormat, const PixelType toType) {
+    Conversion c;
+    return conversion(c, fromFormat, fromType, toFormat, toType, {});
+}
+
+void convertPixels(const PixelFormat fromFormat, const PixelType fromType, const Containers::ArrayView<const char> from, const PixelFormat toFormat, const PixelType toType, const Containers::ArrayView<char> to, const PixelConversionFlags flags) {
+    Conversion c;
+    CORRADE_ASSERT(conversion(c, fromFormat, fromType, toFormat, toType, flags),
+        "convertPixels(): can't convert from" << fromFormat << fromType << "to" << toFormat << toType, );
+
+    const std::size_t fromPixelSize = c.from.channelCount*channelSize(fromType);
+    const std::size_t toPixelSize = c.to.channelCount*channelSize(toType);
+    const std::size_t count = from.size()/fromPixelSize;
+    CORRADE_ASSERT(from.size() == count*fromPixelSize && to.size() == count*toPixelSize,
+        "convertPixels(): expected output size" << count*toPixelSize << "for" << count << "pixels but got" << to.size(), );
+    CORRADE_ASSERT(from.data() != to.data() || fromPixelSize == toPixelSize,
+        "convertPixels(): can't convert in place to a different pixel size", );
+
+    std::vector<Float> input, output;
+    convert(c, from.data(), to.data(), count, input, output);
+}
+
+Image2D convertPixels(const ImageView2D& image, const PixelFormat format, const PixelType type, const PixelConversionFlags flags, UnsignedInt threadCount) {
+    Conversion c;
+    CORRADE_ASSERT(conversion(c, image.format(), image.type(), format, type, flags),
+        "convertPixels(): can't convert from" << image.format() << image.type() << "to" << format << type,
+        (Image2D{format, type}));
+    CORRADE_ASSERT(image.data() || !image.size().product(),
+        "convertPixels(): expected image with data", (Image2D{format, type}));
+
+    /* Output keeps the input alignment */
+    const Vector2i size = image.size();
+    const std::size_t alignment = image.storage().alignment();
+    const std::size_t outputRowSize = size.x()*c.to.channelCount*channelSize(type);
+    const std::size_t outputRowStride = (outputRowSize + alignment - 1)/alignment*alignment;
+    Containers::Array<char> outputData{Containers::ValueInit, outputRowStride*size.y()};
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = image.dataProperties();
+    const char* const data = image.data() + offset.sum();
+
+    if(!threadCount && outputData.size() < ParallelThreshold) threadCount = 1;
+
+    Implementation::parallelFor(size.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Float> input, output;
+        for(std::size_t y = begin; y != end; ++y)
+            convert(c, data + y*dataSize.x(), outputData.data() + y*outputRowStride, size.x(), input, output);
+    });
+
+    return Image2D{PixelStorage{}.setAlignment(alignment), format, type, size, std::move(outputData)};
+}
+
+}
@@ -0,0 +1,156 @@
+#ifndef Magnum_PixelConversion_h
+#define Magnum_PixelConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Enum @ref Magnum::PixelConversionFlag, enum set @ref Magnum::PixelConversionFlags, function @ref Magnum::convertPixels()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pixel conversion flag
+
+@see @ref PixelConversionFlags, @ref convertPixels()
+*/
+enum class PixelConversionFlag: UnsignedByte {
+    /**
+     * Swap red and blue channel of the input. Useful for BGR(A) data on
+     * platforms where @ref PixelFormat::BGR or @ref PixelFormat::BGRA is not
+     * available. Ignored if the input format doesn't have both red and blue
+     * channel.
+     */
+    SwapRedBlue = 1 << 0,
+
+    /**
+     * Multiply color channels with alpha. If the input has no alpha channel,
+     * it is treated as `1.0`.
+     */
+    PremultiplyAlpha = 1 << 1,
+
+    /**
+     * Divide color channels by alpha, pixels with zero alpha become black.
+     * If the input has no alpha channel, it is treated as `1.0`.
+     */
+    UnpremultiplyAlpha = 1 << 2
+};
+
+/** @debugoperatorenum{Magnum::PixelConversionFlag} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, PixelConversionFlag value);
+
+/**
+@brief Pixel conversion flags
+
+@see @ref convertPixels()
+*/
+typedef Containers::EnumSet<PixelConversionFlag> PixelConversionFlags;
+
+CORRADE_ENUMSET_OPERATORS(PixelConversionFlags)
+
+/**
+@brief Check whether conversion between given formats is supported
+
+Conversion between any of @ref PixelFormat::Red, @ref PixelFormat::RG,
+@ref PixelFormat::RGB, @ref PixelFormat::RGBA, @ref PixelFormat::BGR,
+@ref PixelFormat::BGRA, @ref PixelFormat::Luminance and
+@ref PixelFormat::LuminanceAlpha (where available) with
+@ref PixelType::UnsignedByte, @ref PixelType::HalfFloat or
+@ref PixelType::Float channels is supported.
+@see @ref convertPixels()
+*/
+MAGNUM_EXPORT bool isPixelConversionSupported(PixelFormat fromFormat, PixelType fromType, PixelFormat toFormat, PixelType toType);
+
+/**
+@brief Convert contiguous pixel data
+@param[in]  fromFormat  Input format
+@param[in]  fromType    Input type
+@param[in]  from        Input pixels
+@param[in]  toFormat    Output format
+@param[in]  toType      Output type
+@param[out] to          Output pixels, expected to contain the same count of
+    pixels as @p from
+@param[in]  flags       Conversion flags
+
+Channels missing in the input are set to `0` for color and to `1` for alpha,
+luminance is replicated into all color channels. @ref PixelType::UnsignedByte
+values are normalized to @f$ [0, 1] @f$ and rounded to nearest when converted
+back, @ref PixelType::HalfFloat values are converted using
+@ref Math::packHalf() and @ref Math::unpackHalf(). Channel reordering of
+@ref PixelType::UnsignedByte pixels with three or four channels, such as
+BGR(A) to RGB(A) or RGB to RGBA, is done with SSSE3 or AVX2 shuffles on x86
+and NEON loads and stores on ARM if enabled in compiler flags, other
+conversions go through 32-bit floats.
+
+The @p from and @p to views can point to the same memory if the input and
+output pixel size is the same, in that case the conversion is done in place:
+@code
+// BGR data from a file
+Containers::Array<char> data = ...;
+convertPixels(PixelFormat::RGB, PixelType::UnsignedByte, data,
+              PixelFormat::RGB, PixelType::UnsignedByte, data,
+              PixelConversionFlag::SwapRedBlue);
+@endcode
+
+Expects that the conversion is supported, see
+@ref isPixelConversionSupported().
+@see @ref convertPixels(const ImageView2D&, PixelFormat, PixelType, PixelConversionFlags, UnsignedInt)
+*/
+MAGNUM_EXPORT void convertPixels(PixelFormat fromFormat, PixelType fromType, Containers::ArrayView<const char> from, PixelFormat toFormat, PixelType toType, Containers::ArrayView<char> to, PixelConversionFlags flags = {});
+
+/**
+@brief Convert image to another pixel format
+@param image        Input image
+@param format       Output format
+@param type         Output type
+@param flags        Conversion flags
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread for images larger than a megabyte, smaller images are converted
+    on the calling thread.
+
+Converts pixels of each row the same way as
+@ref convertPixels(PixelFormat, PixelType, Containers::ArrayView<const char>, PixelFormat, PixelType, Containers::ArrayView<char>, PixelConversionFlags),
+all @ref PixelStorage properties of @p image are taken into account. The
+output has the same @ref PixelStorage::alignment() as the input, other
+storage properties are default. The rows are converted in parallel on
+@p threadCount threads. Useful for example for dropping the alpha channel of
+a framebuffer read, which is on OpenGL ES guaranteed to work only with
+@ref PixelFormat::RGBA :
+@code
+Image2D rgba = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA, PixelType::UnsignedByte});
+Image2D rgb = convertPixels(rgba, PixelFormat::RGB, PixelType::UnsignedByte);
+@endcode
+*/
+MAGNUM_EXPORT Image2D convertPixels(const ImageView2D& image, PixelFormat format, PixelType type, PixelConversionFlags flags = {}, UnsignedInt threadCount = 0);
+
+}
+
+#endif
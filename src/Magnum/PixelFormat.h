@@ -374,7 +374,8 @@ enum class PixelType: GLenum {
     #endif
 
     /**
-     * Each component half float.
+     * Each component half float. Float data can be converted to it using
+     * @ref Math::packHalf().
      * @requires_gl30 Extension @extension{ARB,half_float_pixel}
      * @requires_gles30 For texture data only, extension
      *      @es_extension2{OES,texture_half_float,OES_texture_float} in OpenGL
@@ -64,6 +64,9 @@ class MAGNUM_EXPORT PixelStorage {
     friend AbstractFramebuffer;
     friend AbstractTexture;
     friend CubeMapTexture;
+    #ifndef MAGNUM_TARGET_GLES2
+    friend TextureStreamer;
+    #endif
 
     public:
         /**
@@ -27,6 +27,7 @@
 
 #include <Corrade/Utility/System.h>
 
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Version.h"
 
@@ -111,6 +112,8 @@ AbstractXApplication::~AbstractXApplication() {
 }
 
 void AbstractXApplication::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+
     _contextHandler->swapBuffers();
 }
 
@@ -25,9 +25,17 @@
 
 #include "AndroidApplication.h"
 
+#include <algorithm>
+#include <cstring>
+#include <android/api-level.h>
+#if __ANDROID_API__ >= 24
+#include <android/choreographer.h>
+#endif
 #include <Corrade/Utility/AndroidStreamBuffer.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
 
@@ -35,6 +43,19 @@
 
 namespace Magnum { namespace Platform {
 
+namespace {
+    const EGLint contextAttributes[] = {
+        #ifdef MAGNUM_TARGET_GLES2
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        #elif defined(MAGNUM_TARGET_GLES3)
+        EGL_CONTEXT_CLIENT_VERSION, 3,
+        #else
+        #error Android with desktop OpenGL? Wow, that is a new thing.
+        #endif
+        EGL_NONE
+    };
+}
+
 struct AndroidApplication::LogOutput {
     LogOutput();
 
@@ -61,7 +82,7 @@ AndroidApplication::AndroidApplication(const Arguments& arguments, const Configu
     createContext(configuration);
 }
 
-AndroidApplication::AndroidApplication(const Arguments& arguments, std::nullptr_t): _state{arguments}, _context{new Context{NoCreate, 0, nullptr}} {
+AndroidApplication::AndroidApplication(const Arguments& arguments, std::nullptr_t): _state{arguments}, _vsyncTime{0}, _refreshPeriod{16666667}, _presentationTime{}, _context{new Context{NoCreate, 0, nullptr}} {
     /* Redirect debug output to Android log */
     _logOutput.reset(new LogOutput);
 }
@@ -69,7 +90,8 @@ AndroidApplication::AndroidApplication(const Arguments& arguments, std::nullptr_
 AndroidApplication::~AndroidApplication() {
     eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     eglDestroyContext(_display, _glContext);
-    eglDestroySurface(_display, _surface);
+    /* The surface is already destroyed if paused */
+    if(!(_flags & Flag::Paused)) eglDestroySurface(_display, _surface);
     eglTerminate(_display);
 }
 
@@ -100,37 +122,44 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
         EGL_NONE
     };
     EGLint configCount;
-    EGLConfig config;
-    if(!eglChooseConfig(_display, configAttributes, &config, 1, &configCount)) {
+    if(!eglChooseConfig(_display, configAttributes, &_config, 1, &configCount)) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot choose EGL config:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
     }
 
+    /* Saved for recreating the surface on resume */
+    _configuredSize = configuration.size();
+    if(configuration.flags() & Configuration::Flag::PreserveContextOnPause)
+        _flags |= Flag::PreserveContext;
+    if(configuration.flags() & Configuration::Flag::VsyncAlignedDrawing) {
+        #if __ANDROID_API__ >= 24
+        _flags |= Flag::VsyncAligned;
+        #else
+        Warning() << "Platform::AndroidApplication::tryCreateContext(): vsync-aligned drawing needs API level 24, ignoring";
+        #endif
+    }
+    if(configuration.flags() & Configuration::Flag::PresentationTime) {
+        const char* const extensions = eglQueryString(_display, EGL_EXTENSIONS);
+        if(extensions && std::strstr(extensions, "EGL_ANDROID_presentation_time"))
+            _presentationTime = reinterpret_cast<PresentationTimeFunction>(eglGetProcAddress("eglPresentationTimeANDROID"));
+        else Warning() << "Platform::AndroidApplication::tryCreateContext(): EGL_ANDROID_presentation_time is not supported, ignoring";
+    }
+
     /* Resize native window and match it to the selected format */
     EGLint format;
-    CORRADE_INTERNAL_ASSERT_OUTPUT(eglGetConfigAttrib(_display, config, EGL_NATIVE_VISUAL_ID, &format));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(eglGetConfigAttrib(_display, _config, EGL_NATIVE_VISUAL_ID, &format));
     ANativeWindow_setBuffersGeometry(_state->window,
-        configuration.size().isZero() ? 0 : configuration.size().x(),
-        configuration.size().isZero() ? 0 : configuration.size().y(), format);
+        _configuredSize.isZero() ? 0 : _configuredSize.x(),
+        _configuredSize.isZero() ? 0 : _configuredSize.y(), format);
 
     /* Create surface and context */
-    if(!(_surface = eglCreateWindowSurface(_display, config, _state->window, nullptr))) {
+    if(!(_surface = eglCreateWindowSurface(_display, _config, _state->window, nullptr))) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot create EGL window surface:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
     }
-    const EGLint contextAttributes[] = {
-        #ifdef MAGNUM_TARGET_GLES2
-        EGL_CONTEXT_CLIENT_VERSION, 2,
-        #elif defined(MAGNUM_TARGET_GLES3)
-        EGL_CONTEXT_CLIENT_VERSION, 3,
-        #else
-        #error Android with desktop OpenGL? Wow, that is a new thing.
-        #endif
-        EGL_NONE
-    };
-    if(!(_glContext = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes))) {
+    if(!(_glContext = eglCreateContext(_display, _config, EGL_NO_CONTEXT, contextAttributes))) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot create EGL context:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
@@ -144,10 +173,82 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
 }
 
 void AndroidApplication::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+
+    /* Don't show the frame before the next vsync, so faster frames don't
+       disturb the pacing */
+    if(_presentationTime && _vsyncTime)
+        _presentationTime(_display, _surface, frameDeadline());
+
+    if(!(_flags & Flag::InvalidateFramebuffer)) {
+        eglSwapBuffers(_display, _surface);
+        return;
+    }
+
+    defaultFramebuffer.invalidate({DefaultFramebuffer::InvalidationAttachment::Depth, DefaultFramebuffer::InvalidationAttachment::Stencil});
     eglSwapBuffers(_display, _surface);
+    defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth|FramebufferClear::Stencil);
+}
+
+void AndroidApplication::pause() {
+    pauseEvent();
+
+    /* Only the surface is tied to the window that's being destroyed, the
+       context with all its objects stays alive */
+    eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(_display, _surface);
+    _surface = EGL_NO_SURFACE;
+    _flags |= Flag::Paused;
+}
+
+bool AndroidApplication::resume() {
+    EGLint format;
+    CORRADE_INTERNAL_ASSERT_OUTPUT(eglGetConfigAttrib(_display, _config, EGL_NATIVE_VISUAL_ID, &format));
+    ANativeWindow_setBuffersGeometry(_state->window,
+        _configuredSize.isZero() ? 0 : _configuredSize.x(),
+        _configuredSize.isZero() ? 0 : _configuredSize.y(), format);
+
+    if(!(_surface = eglCreateWindowSurface(_display, _config, _state->window, nullptr))) {
+        Error() << "Platform::AndroidApplication: cannot recreate EGL window surface:"
+                << Implementation::eglErrorString(eglGetError());
+        return false;
+    }
+    _flags &= ~Flag::Paused;
+
+    if(eglMakeCurrent(_display, _surface, _surface, _glContext)) {
+        resumeEvent();
+        return true;
+    }
+
+    const EGLint error = eglGetError();
+    if(error != EGL_CONTEXT_LOST) {
+        Error() << "Platform::AndroidApplication: cannot make the preserved context current:"
+                << Implementation::eglErrorString(error);
+        return false;
+    }
+
+    /* The system discarded the context in the meantime, create a new one.
+       Magnum's state tracker refers to the old context, so it's created anew
+       as well. */
+    eglDestroyContext(_display, _glContext);
+    if(!(_glContext = eglCreateContext(_display, _config, EGL_NO_CONTEXT, contextAttributes))) {
+        Error() << "Platform::AndroidApplication: cannot recreate EGL context:"
+                << Implementation::eglErrorString(eglGetError());
+        return false;
+    }
+    CORRADE_INTERNAL_ASSERT_OUTPUT(eglMakeCurrent(_display, _surface, _surface, _glContext));
+    _context.reset(new Context{NoCreate, 0, nullptr});
+    if(!_context->tryCreate()) return false;
+
+    contextLostEvent();
+    resumeEvent();
+    return true;
 }
 
 void AndroidApplication::viewportEvent(const Vector2i&) {}
+void AndroidApplication::pauseEvent() {}
+void AndroidApplication::contextLostEvent() {}
+void AndroidApplication::resumeEvent() {}
 void AndroidApplication::mousePressEvent(MouseEvent&) {}
 void AndroidApplication::mouseReleaseEvent(MouseEvent&) {}
 void AndroidApplication::mouseMoveEvent(MouseMoveEvent&) {}
@@ -170,6 +271,17 @@ void AndroidApplication::commandEvent(android_app* state, int32_t cmd) {
             break;
 
         case APP_CMD_INIT_WINDOW:
+            /* Resume the paused application, if that fails create it again
+               from scratch */
+            if(data.instance && (data.instance->_flags & Flag::Paused)) {
+                if(data.instance->resume()) {
+                    data.instance->drawEvent();
+                    break;
+                }
+
+                data.instance.reset();
+            }
+
             /* Create the application */
             if(!data.instance) {
                 data.instance = data.instancer(state);
@@ -178,8 +290,11 @@ void AndroidApplication::commandEvent(android_app* state, int32_t cmd) {
             break;
 
         case APP_CMD_TERM_WINDOW:
-            /* Destroy the application */
-            data.instance.reset();
+            /* Keep the application with its context if requested, destroy it
+               otherwise */
+            if(data.instance && (data.instance->_flags & Flag::PreserveContext))
+                data.instance->pause();
+            else data.instance.reset();
             break;
 
         case APP_CMD_GAINED_FOCUS:
@@ -189,6 +304,50 @@ void AndroidApplication::commandEvent(android_app* state, int32_t cmd) {
     }
 }
 
+void AndroidApplication::postFrameCallback() {
+    #if __ANDROID_API__ >= 24
+    if(_flags & Flag::FramePending) return;
+    _flags |= Flag::FramePending;
+
+    /* The callback gets the glue state, as the instance might be destroyed
+       before the callback is called */
+    #if __ANDROID_API__ >= 29
+    AChoreographer_postFrameCallback64(AChoreographer_getInstance(), [](std::int64_t frameTime, void* state) {
+        frameCallback(frameTime, state);
+    }, _state);
+    #else
+    AChoreographer_postFrameCallback(AChoreographer_getInstance(), [](long frameTime, void* state) {
+        frameCallback(frameTime, state);
+    }, _state);
+    #endif
+    #endif
+}
+
+void AndroidApplication::frameCallback(const Long frameTime, void* const state) {
+    Data& data = *static_cast<Data*>(static_cast<android_app*>(state)->userData);
+
+    /* The instance that posted the callback is gone */
+    if(!data.instance || !(data.instance->_flags & Flag::FramePending)) return;
+
+    AndroidApplication& app = *data.instance;
+    app._flags &= ~Flag::FramePending;
+
+    /* Estimate the refresh period from consecutive vsyncs, accounting for
+       the skipped ones. The time wraps around on 32-bit platforms below API
+       level 29, start over in that case. */
+    if(app._vsyncTime && frameTime > app._vsyncTime) {
+        const Long delta = frameTime - app._vsyncTime;
+        const Long vsyncs = std::max(Long{1}, (delta + app._refreshPeriod/2)/app._refreshPeriod);
+        app._refreshPeriod = (7*app._refreshPeriod + delta/vsyncs)/8;
+    }
+    app._vsyncTime = frameTime;
+
+    if(!(app._flags & Flag::Redraw) || (app._flags & Flag::Paused)) return;
+
+    app._flags &= ~Flag::Redraw;
+    app.drawEvent();
+}
+
 std::int32_t AndroidApplication::inputEvent(android_app* state, AInputEvent* event) {
     CORRADE_INTERNAL_ASSERT(static_cast<Data*>(state->userData)->instance);
     AndroidApplication& app = *static_cast<Data*>(state->userData)->instance;
@@ -228,6 +387,12 @@ void AndroidApplication::exec(android_app* state, std::unique_ptr<AndroidApplica
     state->userData = &data;
 
     for(;;) {
+        /* With vsync-aligned drawing the redraw is done from the choreographer
+           callback, which is called from ALooper_pollAll() below */
+        const bool vsyncAligned = data.instance && (data.instance->_flags & Flag::VsyncAligned);
+        const bool redraw = data.instance && (data.instance->_flags & Flag::Redraw) && !(data.instance->_flags & Flag::Paused);
+        if(vsyncAligned && redraw) data.instance->postFrameCallback();
+
         /* Read all pending events. Block and wait for them only if the app
            doesn't want to redraw immediately WHY THIS GODDAMN THING DOESNT
            HAVE SOMETHING LIKE WAIT FOR EVENT SO I NEED TO TANGLE THIS TANGLED
@@ -235,7 +400,7 @@ void AndroidApplication::exec(android_app* state, std::unique_ptr<AndroidApplica
         int ident, events;
         android_poll_source* source;
         while((ident = ALooper_pollAll(
-            data.instance && (data.instance->_flags & Flag::Redraw) ? 0 : -1,
+            redraw && !vsyncAligned ? 0 : -1,
             nullptr, &events, reinterpret_cast<void**>(&source))) >= 0)
         {
             /* Process this event OH SIR MAY MY POOR EXISTENCE CALL THIS
@@ -249,7 +414,7 @@ void AndroidApplication::exec(android_app* state, std::unique_ptr<AndroidApplica
 
         /* Redraw the app if it wants to be redrawn. Frame limiting is done by
            Android itself */
-        if(data.instance && (data.instance->_flags & Flag::Redraw))
+        if(data.instance && !(data.instance->_flags & Flag::VsyncAligned) && (data.instance->_flags & Flag::Redraw) && !(data.instance->_flags & Flag::Paused))
             data.instance->drawEvent();
     }
 
@@ -161,6 +161,65 @@ file will be named `NativeActivity.apk` by default, you can change that either
 by passing `-n` parameter to `android update project` or later by editing first
 line of the generated `build.xml` file.
 
+@anchor Platform-AndroidApplication-vsync
+## Vsync-aligned drawing
+
+By default @ref drawEvent() is called as soon as the event loop is idle and
+the application requested a redraw, with frame limiting done by blocking in
+@ref swapBuffers(). This makes frame times jittery, as the drawing starts at
+arbitrary times relative to the display refresh. With
+@ref Configuration::Flag::VsyncAlignedDrawing the drawing is driven by
+`AChoreographer` instead (available since API level 24), so each
+@ref drawEvent() starts right after a display vsync and the event loop
+sleeps in between. @ref vsyncTime(), @ref refreshPeriod() and
+@ref frameDeadline() then tell how much time the frame has. Additionally,
+with @ref Configuration::Flag::PresentationTime and the
+`EGL_ANDROID_presentation_time` extension available, each frame is presented
+at the next vsync and not earlier, which keeps the frame pacing even if some
+frames are rendered faster than others.
+@code
+MyApplication::MyApplication(const Arguments& arguments): Platform::Application{arguments, Configuration{}
+    .setFlags(Configuration::Flag::VsyncAlignedDrawing|Configuration::Flag::PresentationTime)} {}
+
+void MyApplication::drawEvent() {
+    // Skip optional work if frameDeadline() is too close
+
+    // draw ...
+
+    swapBuffers();
+    redraw();
+}
+@endcode
+
+@anchor Platform-AndroidApplication-pause
+## Pausing and resuming
+
+Android destroys the application window each time the application goes to
+background. By default the application instance is destroyed together with
+the window and created again from scratch when the application is resumed,
+which means all resources need to be loaded again. If
+@ref Configuration::Flag::PreserveContextOnPause is set, only the EGL surface
+is destroyed on pause and the context with all resources is kept, so resuming
+is nearly instant. @ref pauseEvent() and @ref resumeEvent() are called around
+that.
+
+The system can still discard the context while the application is in
+background. In that case a new context is created on resume and
+@ref contextLostEvent() is called before @ref resumeEvent(). All OpenGL
+objects created before are invalid at that point and have to be created
+again, resources kept in a @ref ResourceManager can be reloaded using
+@ref ResourceManager::reload(), which asks the loader for the resources that
+are in use first:
+@code
+void MyApplication::contextLostEvent() {
+    MyResourceManager::instance().reload();
+}
+@endcode
+
+With a loader that decodes on worker threads, such as
+@ref ThreadedResourceLoader, the first frame after resume shows the fallbacks
+and the data stream in during the following frames.
+
 ## Redirecting output to Android log buffer
 
 The application by default redirects @ref Corrade::Utility::Debug "Debug",
@@ -237,12 +296,54 @@ class AndroidApplication {
          * @brief Swap buffers
          *
          * Paints currently rendered framebuffer on screen.
+         * @see @ref setFramebufferInvalidationEnabled()
          */
         void swapBuffers();
 
+        /** @copydoc Sdl2Application::isFramebufferInvalidationEnabled() */
+        bool isFramebufferInvalidationEnabled() const {
+            return !!(_flags & Flag::InvalidateFramebuffer);
+        }
+
+        /** @copydoc Sdl2Application::setFramebufferInvalidationEnabled() */
+        void setFramebufferInvalidationEnabled(bool enabled) {
+            if(enabled) _flags |= Flag::InvalidateFramebuffer;
+            else _flags &= ~Flag::InvalidateFramebuffer;
+        }
+
         /** @copydoc Sdl2Application::redraw() */
         void redraw() { _flags |= Flag::Redraw; }
 
+        /**
+         * @brief Time of the last display vsync
+         *
+         * In nanoseconds, in the `CLOCK_MONOTONIC` time base. Available only
+         * with @ref Configuration::Flag::VsyncAlignedDrawing, otherwise
+         * returns `0`. See @ref Platform-AndroidApplication-vsync "class documentation"
+         * for more information.
+         * @see @ref refreshPeriod(), @ref frameDeadline()
+         */
+        Long vsyncTime() const { return _vsyncTime; }
+
+        /**
+         * @brief Display refresh period
+         *
+         * In nanoseconds, estimated from the vsync times. Before enough
+         * vsyncs are seen, returns period for 60 Hz.
+         * @see @ref vsyncTime(), @ref frameDeadline()
+         */
+        Long refreshPeriod() const { return _refreshPeriod; }
+
+        /**
+         * @brief Deadline for current frame
+         *
+         * Time of the next expected vsync, in nanoseconds in the
+         * `CLOCK_MONOTONIC` time base. Available only with
+         * @ref Configuration::Flag::VsyncAlignedDrawing, otherwise returns
+         * `0`.
+         */
+        Long frameDeadline() const { return _vsyncTime ? _vsyncTime + _refreshPeriod : 0; }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -254,6 +355,38 @@ class AndroidApplication {
         /** @copydoc Sdl2Application::drawEvent() */
         virtual void drawEvent() = 0;
 
+        /**
+         * @brief Pause event
+         *
+         * Called when the application goes to background with
+         * @ref Configuration::Flag::PreserveContextOnPause set, before the
+         * surface is destroyed. The context is still current. Default
+         * implementation does nothing. See
+         * @ref Platform-AndroidApplication-pause "class documentation" for
+         * more information.
+         */
+        virtual void pauseEvent();
+
+        /**
+         * @brief Context lost event
+         *
+         * Called on resume if the context was discarded while the
+         * application was paused, after a new context was created and made
+         * current. All OpenGL objects created before are invalid. Default
+         * implementation does nothing.
+         * @see @ref resumeEvent(), @ref ResourceManager::reload()
+         */
+        virtual void contextLostEvent();
+
+        /**
+         * @brief Resume event
+         *
+         * Called when the application is back in foreground after
+         * @ref pauseEvent(), with a new surface current. Default
+         * implementation does nothing.
+         */
+        virtual void resumeEvent();
+
         /*@}*/
 
         /** @{ @name Mouse handling */
@@ -292,19 +425,37 @@ class AndroidApplication {
         struct LogOutput;
 
         enum class Flag: UnsignedByte {
-            Redraw = 1 << 0
+            Redraw = 1 << 0,
+            InvalidateFramebuffer = 1 << 1,
+            PreserveContext = 1 << 2,
+            Paused = 1 << 3,
+            VsyncAligned = 1 << 4,
+            FramePending = 1 << 5
         };
         typedef Containers::EnumSet<Flag> Flags;
 
         static void commandEvent(android_app* state, std::int32_t cmd);
         static std::int32_t inputEvent(android_app* state, AInputEvent* event);
 
+        static void frameCallback(Long frameTime, void* state);
+
+        void pause();
+        bool resume();
+        void postFrameCallback();
+
+        typedef EGLBoolean(EGLAPIENTRY *PresentationTimeFunction)(EGLDisplay, EGLSurface, Long);
+
         android_app* const _state;
         Flags _flags;
 
         EGLDisplay _display;
+        EGLConfig _config;
         EGLSurface _surface;
         EGLContext _glContext;
+        Vector2i _configuredSize;
+
+        Long _vsyncTime, _refreshPeriod;
+        PresentationTimeFunction _presentationTime;
 
         std::unique_ptr<Platform::Context> _context;
         std::unique_ptr<LogOutput> _logOutput;
@@ -322,7 +473,45 @@ Double-buffered RGBA canvas with depth and stencil buffers.
 */
 class AndroidApplication::Configuration {
     public:
-        constexpr /*implicit*/ Configuration() {}
+        /**
+         * @brief Context flag
+         *
+         * @see @ref Flags, @ref setFlags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Keep the context and all resources when the application goes
+             * to background and recreate only the surface. See
+             * @ref Platform-AndroidApplication-pause "class documentation"
+             * for more information.
+             */
+            PreserveContextOnPause = 1 << 0,
+
+            /**
+             * Drive drawing by display vsync using `AChoreographer`. Ignored
+             * with a warning if built for API level lower than 24. See
+             * @ref Platform-AndroidApplication-vsync "class documentation"
+             * for more information.
+             */
+            VsyncAlignedDrawing = 1 << 1,
+
+            /**
+             * Present each frame at the next vsync using
+             * `EGL_ANDROID_presentation_time`. Ignored with a warning if the
+             * extension is not available, has effect only together with
+             * @ref Flag::VsyncAlignedDrawing.
+             */
+            PresentationTime = 1 << 2
+        };
+
+        /**
+         * @brief Context flags
+         *
+         * @see @ref setFlags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        constexpr /*implicit*/ Configuration(): _flags{} {}
 
         /**
          * @brief Set window title
@@ -360,10 +549,27 @@ class AndroidApplication::Configuration {
          */
         Configuration& setVersion(Version) { return *this; }
 
+        /** @brief Context flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set context flags
+         * @return Reference to self (for method chaining)
+         *
+         * Default is no flag.
+         */
+        Configuration& setFlags(Flags flags) {
+            _flags = flags;
+            return *this;
+        }
+
     private:
         Vector2i _size;
+        Flags _flags;
 };
 
+CORRADE_ENUMSET_OPERATORS(AndroidApplication::Configuration::Flags)
+
 /**
 @brief Base for input events
 
@@ -28,9 +28,14 @@
 
 #include <tuple>
 
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
+#include "Magnum/Platform/Implementation/FramePacer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Platform/WorkerContextPool.h"
+#endif
 
 namespace Magnum { namespace Platform {
 
@@ -51,7 +56,8 @@ GlfwApplication::GlfwApplication(const Arguments& arguments, const Configuration
 
 GlfwApplication::GlfwApplication(const Arguments& arguments, std::nullptr_t):
     _context{new Context{NoCreate, arguments.argc, arguments.argv}},
-    _needsRedraw(true)
+    _framePacer{new Implementation::FramePacer},
+    _needsRedraw(true), _vsyncEnabled(false)
 {
     /* Save global instance */
     _instance = this;
@@ -147,12 +153,79 @@ GlfwApplication::~GlfwApplication() {
     glfwTerminate();
 }
 
-void GlfwApplication::setSwapInterval(const Int interval) {
+void GlfwApplication::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+
+    if(_framePacer->isEnabled()) {
+        _framePacer->swapStarted();
+        glfwSwapBuffers(_window);
+        _framePacer->swapFinished();
+    } else glfwSwapBuffers(_window);
+}
+
+void GlfwApplication::setSwapInterval(Int interval) {
+    /* Adaptive VSync is not supported everywhere, fall back to the ordinary
+       one */
+    if(interval == -1 && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+        Warning() << "Platform::GlfwApplication::setSwapInterval(): adaptive VSync not supported, falling back to swap interval 1";
+        interval = 1;
+    }
+
     glfwSwapInterval(interval);
+    _vsyncEnabled = interval != 0;
+    _framePacer->reset();
+}
+
+bool GlfwApplication::isFramePacingEnabled() const {
+    return _framePacer->isEnabled();
+}
+
+void GlfwApplication::setFramePacingEnabled(const bool enabled) {
+    _framePacer->setEnabled(enabled);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+std::unique_ptr<WorkerContextPool> GlfwApplication::createWorkerContextPool(const UnsignedInt count) {
+    std::vector<WorkerContextPool::WorkerContext> contexts;
+    contexts.reserve(count);
+
+    /* Window hints set in tryCreateContext() are still in effect, so the
+       contexts get the same version and flags as the main one */
+    glfwWindowHint(GLFW_VISIBLE, false);
+    for(UnsignedInt i = 0; i != count; ++i) {
+        GLFWwindow* const window = glfwCreateWindow(1, 1, "", nullptr, _window);
+        if(!window) {
+            Error() << "Platform::GlfwApplication::createWorkerContextPool(): cannot create shared context";
+            break;
+        }
+
+        contexts.push_back({
+            [window]() { glfwMakeContextCurrent(window); return true; },
+            []() { glfwMakeContextCurrent(nullptr); },
+            [window]() { glfwDestroyWindow(window); }});
+    }
+    glfwWindowHint(GLFW_VISIBLE, true);
+
+    if(contexts.empty()) return nullptr;
+
+    std::unique_ptr<WorkerContextPool> pool{new WorkerContextPool{std::move(contexts)}};
+    if(!pool->threadCount()) return nullptr;
+    return pool;
+}
+#endif
+
 int GlfwApplication::exec() {
     while(!glfwWindowShouldClose(_window)) {
+        /* Sleep until the last moment in which the frame can still make it
+           for the next vblank and poll input right before drawing */
+        if(_framePacer->isEnabled() && _vsyncEnabled) {
+            _framePacer->wait();
+            _framePacer->frameStarted();
+            glfwPollEvents();
+            if(_needsRedraw) drawEvent();
+            continue;
+        }
+
         if(_needsRedraw) {
             drawEvent();
         }
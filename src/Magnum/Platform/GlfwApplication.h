@@ -44,6 +44,11 @@
 
 namespace Magnum { namespace Platform {
 
+namespace Implementation { class FramePacer; }
+#ifndef MAGNUM_TARGET_GLES2
+class WorkerContextPool;
+#endif
+
 /** @nosubgrouping
 @brief GLFW application
 
@@ -172,16 +177,52 @@ class GlfwApplication {
          *
          * Paints currently rendered framebuffer on screen.
          */
-        void swapBuffers() { glfwSwapBuffers(_window); }
+        void swapBuffers();
 
         /**
          * @brief Set swap interval
          *
          * Set `0` for no VSync, `1` for enabled VSync. Some platforms support
-         * `-1` for late swap tearing. Default is driver-dependent.
+         * `-1` for adaptive VSync (late swap tearing), if it is not supported,
+         * a warning is printed and the interval falls back to `1`. Default is
+         * driver-dependent.
+         * @see @ref setFramePacingEnabled()
          */
         void setSwapInterval(Int interval);
 
+        /**
+         * @brief Whether frame pacing is enabled
+         *
+         * @see @ref setFramePacingEnabled()
+         */
+        bool isFramePacingEnabled() const;
+
+        /**
+         * @brief Enable or disable frame pacing
+         *
+         * See @ref Sdl2Application::setFramePacingEnabled() for details. With
+         * frame pacing enabled, input events are polled right before
+         * @ref drawEvent() instead of after it. Has no effect if VSync is not
+         * enabled using @ref setSwapInterval(). Disabled by default.
+         */
+        void setFramePacingEnabled(bool enabled);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Create pool of worker contexts
+         *
+         * Creates @p count hidden windows with OpenGL contexts sharing
+         * objects with the main one, using the same context configuration,
+         * and a @ref WorkerContextPool running a thread for each of them.
+         * Prints a message to error output and returns `nullptr` if no
+         * worker context could be created. The pool has to be destroyed
+         * before the application. Include @ref Magnum/Platform/WorkerContextPool.h
+         * to use it.
+         * @note Not available in OpenGL ES 2.0 builds.
+         */
+        std::unique_ptr<WorkerContextPool> createWorkerContextPool(UnsignedInt count);
+        #endif
+
         /** @copydoc Sdl2Application::redraw() */
         void redraw() { _needsRedraw = true; }
 
@@ -259,7 +300,8 @@ class GlfwApplication {
 
         GLFWwindow* _window;
         std::unique_ptr<Platform::Context> _context;
-        bool _needsRedraw;
+        std::unique_ptr<Implementation::FramePacer> _framePacer;
+        bool _needsRedraw, _vsyncEnabled;
 };
 
 /**
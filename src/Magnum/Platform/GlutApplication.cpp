@@ -27,6 +27,7 @@
 
 #include <tuple>
 
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
@@ -102,6 +103,11 @@ bool GlutApplication::tryCreateContext(const Configuration& configuration) {
 
 GlutApplication::~GlutApplication() = default;
 
+void GlutApplication::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+    glutSwapBuffers();
+}
+
 void GlutApplication::staticKeyPressEvent(unsigned char key, int x, int y) {
     KeyEvent e(static_cast<KeyEvent::Key>(key), {x, y});
     _instance->keyPressEvent(e);
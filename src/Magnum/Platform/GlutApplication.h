@@ -167,7 +167,7 @@ class GlutApplication {
          *
          * Paints currently rendered framebuffer on screen.
          */
-        void swapBuffers() { glutSwapBuffers(); }
+        void swapBuffers();
 
         /** @copydoc Sdl2Application::redraw() */
         void redraw() { glutPostRedisplay(); }
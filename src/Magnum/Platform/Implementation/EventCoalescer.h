@@ -0,0 +1,106 @@
+#ifndef Magnum_Platform_Implementation_EventCoalescer_h
+#define Magnum_Platform_Implementation_EventCoalescer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+/*
+    Merges consecutive mouse move events and consecutive mouse scroll events
+    into one. Moves keep the latest position and button state and sum the
+    relative positions, scrolls sum the offsets. At most one event is pending
+    at a time and any other event needs to flush it first, so the order of
+    events as seen by the application is preserved, just with the
+    consecutive runs collapsed.
+*/
+struct CoalescedEvent {
+    enum class Type: UnsignedByte { None, Move, Scroll };
+
+    Type type;
+    Vector2i position;
+    Vector2i relativePosition;
+    UnsignedInt buttons;
+    Vector2 offset;
+};
+
+class EventCoalescer {
+    public:
+        typedef CoalescedEvent::Type Type;
+
+        explicit EventCoalescer(): _pending{Type::None, {}, {}, 0, {}}, _coalescedCount{0} {}
+
+        /* If a scroll event is pending, it's returned through `out` and the
+           function returns true, the caller is then expected to dispatch it */
+        bool move(const Vector2i& position, const Vector2i& relativePosition, UnsignedInt buttons, CoalescedEvent& out) {
+            if(_pending.type == Type::Move) {
+                _pending.position = position;
+                _pending.relativePosition += relativePosition;
+                _pending.buttons = buttons;
+                ++_coalescedCount;
+                return false;
+            }
+
+            const bool flushed = flush(out);
+            _pending = {Type::Move, position, relativePosition, buttons, {}};
+            return flushed;
+        }
+
+        /* If a move event is pending, it's returned through `out` and the
+           function returns true, the caller is then expected to dispatch it */
+        bool scroll(const Vector2& offset, CoalescedEvent& out) {
+            if(_pending.type == Type::Scroll) {
+                _pending.offset += offset;
+                ++_coalescedCount;
+                return false;
+            }
+
+            const bool flushed = flush(out);
+            _pending = {Type::Scroll, {}, {}, 0, offset};
+            return flushed;
+        }
+
+        /* Returns true and the pending event, if any */
+        bool flush(CoalescedEvent& out) {
+            if(_pending.type == Type::None) return false;
+
+            out = _pending;
+            _pending.type = Type::None;
+            return true;
+        }
+
+        /* Count of events merged into a previous one */
+        std::size_t coalescedCount() const { return _coalescedCount; }
+
+    private:
+        CoalescedEvent _pending;
+        std::size_t _coalescedCount;
+};
+
+}}}
+
+#endif
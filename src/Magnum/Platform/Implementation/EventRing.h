@@ -0,0 +1,94 @@
+#ifndef Magnum_Platform_Implementation_EventRing_h
+#define Magnum_Platform_Implementation_EventRing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+/*
+    Lock-free single-producer single-consumer queue of fixed capacity. Used
+    for passing input events from the browser main thread to the worker
+    thread that owns the GL context. In Emscripten pthread builds the whole
+    heap is a SharedArrayBuffer, so the ring is visible to both threads
+    without any copying or message passing.
+
+    The producer only ever writes the write index and the consumer only ever
+    writes the read index, so no locks are needed. If the consumer can't keep
+    up, new events are dropped (and counted) instead of blocking the producer,
+    as the producer is the browser main thread.
+*/
+template<class T, std::size_t size> class EventRing {
+    static_assert(size && !(size & (size - 1)), "size must be a power of two");
+
+    public:
+        explicit EventRing(): _read{0}, _write{0}, _droppedCount{0} {}
+
+        EventRing(const EventRing<T, size>&) = delete;
+        EventRing<T, size>& operator=(const EventRing<T, size>&) = delete;
+
+        /* Called from the producer thread only */
+        bool push(const T& event) {
+            const std::size_t write = _write.load(std::memory_order_relaxed);
+            if(write - _read.load(std::memory_order_acquire) == size) {
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _data[write & (size - 1)] = event;
+            _write.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Called from the consumer thread only */
+        bool pop(T& event) {
+            const std::size_t read = _read.load(std::memory_order_relaxed);
+            if(read == _write.load(std::memory_order_acquire)) return false;
+
+            event = _data[read & (size - 1)];
+            _read.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Approximate when called concurrently with push() or pop() */
+        std::size_t count() const {
+            return _write.load(std::memory_order_acquire) - _read.load(std::memory_order_acquire);
+        }
+
+        std::size_t droppedCount() const {
+            return _droppedCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<T, size> _data;
+        std::atomic<std::size_t> _read, _write, _droppedCount;
+};
+
+}}}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef Magnum_Platform_Implementation_FramePacer_h
+#define Magnum_Platform_Implementation_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+/*
+    Predicts when the next vertical blank happens and how long it takes to
+    produce a frame, so the main loop can sleep right until the last moment
+    in which input can be polled and the frame still gets ready in time.
+
+    The application calls frameStarted() before polling input, swapStarted()
+    right before and swapFinished() right after the buffer swap. With VSync
+    enabled the swap returns at vblank, so the distance between two
+    consecutive swapFinished() calls is the refresh period and the distance
+    between frameStarted() and swapStarted() is the CPU cost of the frame.
+    Both are kept in a short history; the refresh period is estimated with a
+    median (to be robust against missed vblanks) and the frame cost with a
+    maximum (as finishing late costs a whole refresh period).
+*/
+class FramePacer {
+    public:
+        typedef std::chrono::high_resolution_clock Clock;
+
+        enum: std::size_t { HistorySize = 16 };
+
+        bool isEnabled() const { return _enabled; }
+
+        void setEnabled(bool enabled) {
+            _enabled = enabled;
+            reset();
+        }
+
+        /* Additional safety margin subtracted from the wake-up time */
+        Clock::duration margin() const { return _margin; }
+        void setMargin(Clock::duration margin) { _margin = margin; }
+
+        void reset() {
+            _periodCount = _costCount = 0;
+            _hasFrame = _hasSwap = false;
+        }
+
+        /* Predicted refresh period, zero if not known yet */
+        Clock::duration predictedPeriod() const {
+            if(_periodCount < MinimalSampleCount) return {};
+
+            std::array<Clock::duration, HistorySize> sorted;
+            const std::size_t count = std::min(_periodCount, std::size_t(HistorySize));
+            std::copy(_periods.begin(), _periods.begin() + count, sorted.begin());
+            std::nth_element(sorted.begin(), sorted.begin() + count/2, sorted.begin() + count);
+            return sorted[count/2];
+        }
+
+        /* Predicted cost of producing a frame, zero if not known yet */
+        Clock::duration predictedCost() const {
+            if(_costCount < MinimalSampleCount) return {};
+
+            const std::size_t count = std::min(_costCount, std::size_t(HistorySize));
+            return *std::max_element(_costs.begin(), _costs.begin() + count);
+        }
+
+        /* How long to sleep at given time before starting the next frame */
+        Clock::duration delay(Clock::time_point now) const {
+            const Clock::duration period = predictedPeriod();
+            if(!_enabled || !_hasSwap || period == Clock::duration{}) return {};
+
+            /* Next vblank after the last swap, skipping the ones that were
+               already missed */
+            Clock::time_point vblank = _lastSwapFinished + period;
+            if(vblank <= now) vblank += period*((now - vblank)/period + 1);
+
+            const Clock::time_point wakeUp = vblank - predictedCost() - _margin;
+            return wakeUp > now ? wakeUp - now : Clock::duration{};
+        }
+
+        /* Sleep until the predicted wake-up time. The OS scheduler is coarse,
+           so sleep only until a millisecond before and yield for the rest. */
+        void wait() {
+            const Clock::time_point now = Clock::now();
+            const Clock::duration duration = delay(now);
+            if(duration == Clock::duration{}) return;
+
+            const Clock::time_point until = now + duration;
+            if(duration > std::chrono::milliseconds{1})
+                std::this_thread::sleep_for(duration - std::chrono::milliseconds{1});
+            while(Clock::now() < until) std::this_thread::yield();
+        }
+
+        void frameStarted(Clock::time_point time = Clock::now()) {
+            _frameStarted = time;
+            _hasFrame = true;
+        }
+
+        /* Swaps done outside of a paced frame don't contribute to the cost */
+        void swapStarted(Clock::time_point time = Clock::now()) {
+            if(!_hasFrame) return;
+            _costs[_costCount++ % HistorySize] = time - _frameStarted;
+            _hasFrame = false;
+        }
+
+        void swapFinished(Clock::time_point time = Clock::now()) {
+            if(_hasSwap) _periods[_periodCount++ % HistorySize] = time - _lastSwapFinished;
+            _lastSwapFinished = time;
+            _hasSwap = true;
+        }
+
+    private:
+        enum: std::size_t { MinimalSampleCount = 4 };
+
+        bool _enabled{}, _hasFrame{}, _hasSwap{};
+        Clock::duration _margin{std::chrono::microseconds{500}};
+        Clock::time_point _frameStarted, _lastSwapFinished;
+        std::size_t _periodCount{}, _costCount{};
+        std::array<Clock::duration, HistorySize> _periods, _costs;
+};
+
+}}}
+
+#endif
@@ -30,6 +30,7 @@
 #include <ppapi/cpp/completion_callback.h>
 #include <Corrade/Utility/NaClStreamBuffer.h>
 
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
 
@@ -230,6 +231,8 @@ bool NaClApplication::HandleInputEvent(const pp::InputEvent& event) {
 }
 
 void NaClApplication::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+
     /* Swap already in progress, do nothing */
     if(_flags & Flag::SwapInProgress) return;
 
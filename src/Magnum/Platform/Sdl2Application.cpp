@@ -30,12 +30,28 @@
 #include <tuple>
 #else
 #include <emscripten/emscripten.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/html5.h>
+#include <emscripten/threading.h>
+#endif
 #endif
 
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Version.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include "Magnum/Platform/Implementation/EventRing.h"
+#endif
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/Platform/Implementation/EventCoalescer.h"
+#include "Magnum/Platform/Implementation/FramePacer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Platform/WorkerContextPool.h"
+#endif
+#endif
 
 namespace Magnum { namespace Platform {
 
@@ -58,6 +74,162 @@ Sdl2Application::InputEvent::Modifiers fixedModifiers(Uint16 mod) {
 
 }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+namespace Implementation {
+
+/* Input event captured on the browser main thread, processed in the worker */
+struct WorkerEvent {
+    enum class Type: UnsignedByte {
+        KeyPress, KeyRelease, MousePress, MouseRelease, MouseMove,
+        MouseScroll, Viewport
+    };
+
+    Type type;
+    Uint16 modifiers;
+    Int code; /* key, mouse button or mouse button mask */
+    Vector2i position, relativePosition;
+    Vector2 offset;
+};
+
+struct WorkerEventQueue {
+    EventRing<WorkerEvent, 256> events;
+    EMSCRIPTEN_WEBGL_CONTEXT_HANDLE glContext{};
+
+    /* Modifiers of the last processed input event, for lazily populated
+       MouseEvent::modifiers() and others */
+    Uint16 modifiers{};
+};
+
+}
+
+namespace {
+
+/* Canvas ID from EmscriptenApplication.js */
+constexpr const char CanvasTarget[] = "#module";
+
+Uint16 domModifiers(const EM_BOOL shift, const EM_BOOL ctrl, const EM_BOOL alt, const EM_BOOL meta) {
+    return Uint16((shift ? KMOD_LSHIFT : 0)|(ctrl ? KMOD_LCTRL : 0)|(alt ? KMOD_LALT : 0)|(meta ? KMOD_LGUI : 0));
+}
+
+/* SDL isn't available in the worker to do this for us, so translate at least
+   the keys that have an enum value in KeyEvent::Key */
+SDL_Keycode keyFromDom(const unsigned long keyCode) {
+    /* Letters are lowercase ASCII in SDL, numbers are the same */
+    if(keyCode >= 'A' && keyCode <= 'Z') return SDL_Keycode(keyCode - 'A' + 'a');
+    if(keyCode >= '0' && keyCode <= '9') return SDL_Keycode(keyCode);
+
+    constexpr SDL_Keycode functionKeys[]{SDLK_F1, SDLK_F2, SDLK_F3, SDLK_F4,
+        SDLK_F5, SDLK_F6, SDLK_F7, SDLK_F8, SDLK_F9, SDLK_F10, SDLK_F11, SDLK_F12};
+    if(keyCode >= 112 && keyCode <= 123) return functionKeys[keyCode - 112];
+
+    switch(keyCode) {
+        case 8: return SDLK_BACKSPACE;
+        case 9: return SDLK_TAB;
+        case 13: return SDLK_RETURN;
+        case 16: return SDLK_LSHIFT;
+        case 17: return SDLK_LCTRL;
+        case 18: return SDLK_LALT;
+        case 27: return SDLK_ESCAPE;
+        case 32: return SDLK_SPACE;
+        case 33: return SDLK_PAGEUP;
+        case 34: return SDLK_PAGEDOWN;
+        case 35: return SDLK_END;
+        case 36: return SDLK_HOME;
+        case 37: return SDLK_LEFT;
+        case 38: return SDLK_UP;
+        case 39: return SDLK_RIGHT;
+        case 40: return SDLK_DOWN;
+        case 45: return SDLK_INSERT;
+        case 46: return SDLK_DELETE;
+        case 187: return SDLK_EQUALS;
+        case 188: return SDLK_COMMA;
+        case 189: return SDLK_MINUS;
+        case 190: return SDLK_PERIOD;
+        case 191: return SDLK_SLASH;
+    }
+
+    return SDLK_UNKNOWN;
+}
+
+/* The callbacks are called on the browser main thread and only push the
+   events to the queue */
+EM_BOOL workerKeyCallback(const int eventType, const EmscriptenKeyboardEvent* const event, void* const queue) {
+    Implementation::WorkerEvent e;
+    e.type = eventType == EMSCRIPTEN_EVENT_KEYDOWN ?
+        Implementation::WorkerEvent::Type::KeyPress :
+        Implementation::WorkerEvent::Type::KeyRelease;
+    e.modifiers = domModifiers(event->shiftKey, event->ctrlKey, event->altKey, event->metaKey);
+    e.code = keyFromDom(event->keyCode);
+    static_cast<Implementation::WorkerEventQueue*>(queue)->events.push(e);
+
+    /* Let the browser handle keys we don't know about */
+    return e.code != SDLK_UNKNOWN;
+}
+
+EM_BOOL workerMouseCallback(const int eventType, const EmscriptenMouseEvent* const event, void* const queue) {
+    Implementation::WorkerEvent e;
+    e.modifiers = domModifiers(event->shiftKey, event->ctrlKey, event->altKey, event->metaKey);
+    e.position = {Int(event->targetX), Int(event->targetY)};
+    if(eventType == EMSCRIPTEN_EVENT_MOUSEMOVE) {
+        e.type = Implementation::WorkerEvent::Type::MouseMove;
+        e.relativePosition = {Int(event->movementX), Int(event->movementY)};
+        /* DOM has the right and middle button bits swapped compared to SDL */
+        e.code = (event->buttons & 1 ? SDL_BUTTON_LMASK : 0)|
+                 (event->buttons & 2 ? SDL_BUTTON_RMASK : 0)|
+                 (event->buttons & 4 ? SDL_BUTTON_MMASK : 0);
+    } else {
+        e.type = eventType == EMSCRIPTEN_EVENT_MOUSEDOWN ?
+            Implementation::WorkerEvent::Type::MousePress :
+            Implementation::WorkerEvent::Type::MouseRelease;
+        /* DOM numbers the buttons from zero, SDL from one */
+        e.code = event->button + 1;
+    }
+    static_cast<Implementation::WorkerEventQueue*>(queue)->events.push(e);
+    return true;
+}
+
+EM_BOOL workerWheelCallback(int, const EmscriptenWheelEvent* const event, void* const queue) {
+    Implementation::WorkerEvent e;
+    e.type = Implementation::WorkerEvent::Type::MouseScroll;
+    e.modifiers = domModifiers(event->mouse.shiftKey, event->mouse.ctrlKey, event->mouse.altKey, event->mouse.metaKey);
+    e.position = {Int(event->mouse.targetX), Int(event->mouse.targetY)};
+
+    /* DOM reports the delta in pixels, lines or pages with Y going down, SDL
+       in wheel steps with Y going up */
+    const Float scale = event->deltaMode == DOM_DELTA_PIXEL ? 0.01f :
+        event->deltaMode == DOM_DELTA_LINE ? 1.0f/3.0f : 1.0f;
+    e.offset = {Float(event->deltaX)*scale, -Float(event->deltaY)*scale};
+    static_cast<Implementation::WorkerEventQueue*>(queue)->events.push(e);
+    return true;
+}
+
+EM_BOOL workerResizeCallback(int, const EmscriptenUiEvent*, void* const queue) {
+    double width, height;
+    emscripten_get_element_css_size(CanvasTarget, &width, &height);
+
+    Implementation::WorkerEvent e;
+    e.type = Implementation::WorkerEvent::Type::Viewport;
+    e.modifiers = 0;
+    e.position = {Int(width), Int(height)};
+    static_cast<Implementation::WorkerEventQueue*>(queue)->events.push(e);
+    return false;
+}
+
+/* Passing nullptr unregisters the callbacks */
+void setWorkerCallbacks(Implementation::WorkerEventQueue* const queue) {
+    const pthread_t thread = EM_CALLBACK_THREAD_CONTEXT_MAIN_BROWSER_THREAD;
+    emscripten_set_keydown_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, queue, true, queue ? workerKeyCallback : nullptr, thread);
+    emscripten_set_keyup_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, queue, true, queue ? workerKeyCallback : nullptr, thread);
+    emscripten_set_mousedown_callback_on_thread(CanvasTarget, queue, true, queue ? workerMouseCallback : nullptr, thread);
+    emscripten_set_mouseup_callback_on_thread(CanvasTarget, queue, true, queue ? workerMouseCallback : nullptr, thread);
+    emscripten_set_mousemove_callback_on_thread(CanvasTarget, queue, true, queue ? workerMouseCallback : nullptr, thread);
+    emscripten_set_wheel_callback_on_thread(CanvasTarget, queue, true, queue ? workerWheelCallback : nullptr, thread);
+    emscripten_set_resize_callback_on_thread(EMSCRIPTEN_EVENT_TARGET_WINDOW, queue, false, queue ? workerResizeCallback : nullptr, thread);
+}
+
+}
+#endif
+
 #ifdef CORRADE_TARGET_EMSCRIPTEN
 Sdl2Application* Sdl2Application::_instance = nullptr;
 void Sdl2Application::staticMainLoop() {
@@ -75,8 +247,9 @@ Sdl2Application::Sdl2Application(const Arguments& arguments, const Configuration
 
 Sdl2Application::Sdl2Application(const Arguments& arguments, std::nullptr_t): _glContext{nullptr},
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    _minimalLoopPeriod{0},
+    _minimalLoopPeriod{0}, _framePacer{new Implementation::FramePacer},
     #endif
+    _coalescer{new Implementation::EventCoalescer},
     _context{new Context{NoCreate, arguments.argc, arguments.argv}}, _flags{Flag::Redraw}
 {
     #ifdef CORRADE_TARGET_EMSCRIPTEN
@@ -84,6 +257,16 @@ Sdl2Application::Sdl2Application(const Arguments& arguments, std::nullptr_t): _g
     _instance = this;
     #endif
 
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    /* Running in a worker, SDL needs DOM access so it can't be used. Render
+       to an OffscreenCanvas and get input events from the main thread
+       instead. */
+    if(!emscripten_is_main_browser_thread()) {
+        _worker.reset(new Implementation::WorkerEventQueue);
+        return;
+    }
+    #endif
+
     if(SDL_Init(SDL_INIT_VIDEO) < 0) {
         Error() << "Cannot initialize SDL.";
         std::exit(1);
@@ -99,6 +282,10 @@ void Sdl2Application::createContext(const Configuration& configuration) {
 bool Sdl2Application::tryCreateContext(const Configuration& configuration) {
     CORRADE_ASSERT(_context->version() == Version::None, "Platform::Sdl2Application::tryCreateContext(): context already created", false);
 
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_worker) return tryCreateWorkerContext(configuration);
+    #endif
+
     /* Enable double buffering and 24bt depth buffer */
     SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
     SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
@@ -280,6 +467,39 @@ bool Sdl2Application::tryCreateContext(const Configuration& configuration) {
     return true;
 }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+bool Sdl2Application::tryCreateWorkerContext(const Configuration& configuration) {
+    EmscriptenWebGLContextAttributes attributes;
+    emscripten_webgl_init_context_attributes(&attributes);
+    attributes.antialias = configuration.sampleCount() > 1;
+    #ifndef MAGNUM_TARGET_GLES2
+    attributes.majorVersion = 2;
+    #endif
+    /* Fail instead of silently proxying all GL calls back to the main
+       thread, which would be slower than not using the worker at all */
+    attributes.proxyContextToMainThread = EMSCRIPTEN_WEBGL_CONTEXT_PROXY_DISALLOW;
+
+    if((_worker->glContext = emscripten_webgl_create_context(CanvasTarget, &attributes)) <= 0) {
+        Error() << "Platform::Sdl2Application::tryCreateContext(): cannot create WebGL context on OffscreenCanvas:" << _worker->glContext;
+        _worker->glContext = 0;
+        return false;
+    }
+
+    emscripten_webgl_make_context_current(_worker->glContext);
+    emscripten_set_canvas_element_size(CanvasTarget, configuration.size().x(), configuration.size().y());
+
+    /* Destroy everything also when the Magnum context creation fails */
+    if(!_context->tryCreate()) {
+        emscripten_webgl_destroy_context(_worker->glContext);
+        _worker->glContext = 0;
+        return false;
+    }
+
+    setWorkerCallbacks(_worker.get());
+    return true;
+}
+#endif
+
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 Vector2i Sdl2Application::windowSize() {
     Vector2i size;
@@ -289,11 +509,30 @@ Vector2i Sdl2Application::windowSize() {
 #endif
 
 void Sdl2Application::swapBuffers() {
+    FrameAllocator::current().nextFrame();
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    if(_flags & Flag::InvalidateFramebuffer)
+        defaultFramebuffer.invalidate({DefaultFramebuffer::InvalidationAttachment::Depth, DefaultFramebuffer::InvalidationAttachment::Stencil});
+    #endif
+
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    SDL_GL_SwapWindow(_window);
+    if(_framePacer->isEnabled()) {
+        _framePacer->swapStarted();
+        SDL_GL_SwapWindow(_window);
+        _framePacer->swapFinished();
+    } else SDL_GL_SwapWindow(_window);
     #else
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    /* The OffscreenCanvas is presented once the worker returns back to the
+       browser, the same as the canvas on the main thread */
+    if(!_worker)
+    #endif
     SDL_Flip(_glContext);
     #endif
+
+    if(_flags & Flag::InvalidateFramebuffer)
+        defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth|FramebufferClear::Stencil);
 }
 
 Int Sdl2Application::swapInterval() const {
@@ -302,6 +541,13 @@ Int Sdl2Application::swapInterval() const {
 
 bool Sdl2Application::setSwapInterval(const Int interval) {
     if(SDL_GL_SetSwapInterval(interval) == -1) {
+        /* Adaptive VSync is not supported everywhere, fall back to the
+           ordinary one */
+        if(interval == -1) {
+            Warning() << "Platform::Sdl2Application::setSwapInterval(): adaptive VSync not supported, falling back to swap interval 1";
+            return setSwapInterval(1);
+        }
+
         Error() << "Platform::Sdl2Application::setSwapInterval(): cannot set swap interval:" << SDL_GetError();
         _flags &= ~Flag::VSyncEnabled;
         return false;
@@ -314,12 +560,67 @@ bool Sdl2Application::setSwapInterval(const Int interval) {
     }
 
     _flags |= Flag::VSyncEnabled;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _framePacer->reset();
+    #endif
     return true;
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+bool Sdl2Application::isFramePacingEnabled() const {
+    return _framePacer->isEnabled();
+}
+
+void Sdl2Application::setFramePacingEnabled(const bool enabled) {
+    _framePacer->setEnabled(enabled);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+std::unique_ptr<WorkerContextPool> Sdl2Application::createWorkerContextPool(const UnsignedInt count) {
+    std::vector<WorkerContextPool::WorkerContext> contexts;
+    contexts.reserve(count);
+
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    for(UnsignedInt i = 0; i != count; ++i) {
+        /* Creating the context makes it current, switch back to the main one
+           so the next context is shared with it as well */
+        SDL_GLContext glContext = SDL_GL_CreateContext(_window);
+        SDL_GL_MakeCurrent(_window, _glContext);
+        if(!glContext) {
+            Error() << "Platform::Sdl2Application::createWorkerContextPool(): cannot create shared context:" << SDL_GetError();
+            break;
+        }
+
+        SDL_Window* const window = _window;
+        contexts.push_back({
+            [window, glContext]() { return SDL_GL_MakeCurrent(window, glContext) == 0; },
+            [window]() { SDL_GL_MakeCurrent(window, nullptr); },
+            [glContext]() { SDL_GL_DeleteContext(glContext); }});
+    }
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+    if(contexts.empty()) return nullptr;
+
+    std::unique_ptr<WorkerContextPool> pool{new WorkerContextPool{std::move(contexts)}};
+    if(!pool->threadCount()) return nullptr;
+    return pool;
+}
+#endif
+#endif
+
 Sdl2Application::~Sdl2Application() {
     _context.reset();
 
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_worker) {
+        setWorkerCallbacks(nullptr);
+        if(_worker->glContext) emscripten_webgl_destroy_context(_worker->glContext);
+        CORRADE_INTERNAL_ASSERT(_instance == this);
+        _instance = nullptr;
+        return;
+    }
+    #endif
+
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     SDL_GL_DeleteContext(_glContext);
     SDL_DestroyWindow(_window);
@@ -350,11 +651,27 @@ void Sdl2Application::exit() {
 
 void Sdl2Application::mainLoop() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Sleep until the last moment before polling input so the frame is
+       still ready for the next vblank */
+    if(_framePacer->isEnabled() && (_flags & Flag::VSyncEnabled)) {
+        _framePacer->wait();
+        _framePacer->frameStarted();
+    }
+
     const UnsignedInt timeBefore = _minimalLoopPeriod ? SDL_GetTicks() : 0;
     #endif
 
     SDL_Event event;
+    Implementation::CoalescedEvent coalesced;
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_worker) processWorkerEvents();
+    else
+    #endif
     while(SDL_PollEvent(&event)) {
+        /* Dispatch the pending coalesced event before any other */
+        if(event.type != SDL_MOUSEMOTION && event.type != SDL_MOUSEWHEEL && _coalescer->flush(coalesced))
+            dispatchCoalescedEvent(coalesced);
+
         switch(event.type) {
             case SDL_WINDOWEVENT:
                 switch(event.window.event) {
@@ -392,31 +709,18 @@ void Sdl2Application::mainLoop() {
             } break;
 
             case SDL_MOUSEWHEEL: {
-                MouseScrollEvent e{{Float(event.wheel.x), Float(event.wheel.y)}};
-                mouseScrollEvent(e);
-
-                #ifdef MAGNUM_BUILD_DEPRECATED
-                if(event.wheel.y != 0) {
-                    #ifdef __GNUC__
-                    #pragma GCC diagnostic push
-                    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-                    #endif
-                    MouseEvent e(event.wheel.y > 0 ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, {event.wheel.x, event.wheel.y}
-                        #ifndef CORRADE_TARGET_EMSCRIPTEN
-                        , 0
-                        #endif
-                        );
-                    #ifdef __GNUC__
-                    #pragma GCC diagnostic pop
-                    #endif
-                    mousePressEvent(e);
-                }
-                #endif
+                const Vector2 offset{Float(event.wheel.x), Float(event.wheel.y)};
+                if(!(_flags & Flag::CoalesceEvents)) callMouseScrollEvent(offset);
+                else if(_coalescer->scroll(offset, coalesced))
+                    dispatchCoalescedEvent(coalesced);
             } break;
 
             case SDL_MOUSEMOTION: {
-                MouseMoveEvent e({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state));
-                mouseMoveEvent(e);
+                if(!(_flags & Flag::CoalesceEvents)) {
+                    MouseMoveEvent e({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state));
+                    mouseMoveEvent(e);
+                } else if(_coalescer->move({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, event.motion.state, coalesced))
+                    dispatchCoalescedEvent(coalesced);
                 break;
             }
 
@@ -446,6 +750,9 @@ void Sdl2Application::mainLoop() {
         }
     }
 
+    /* Dispatch the last coalesced event */
+    if(_coalescer->flush(coalesced)) dispatchCoalescedEvent(coalesced);
+
     /* Tick event */
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
 
@@ -480,6 +787,90 @@ void Sdl2Application::mainLoop() {
     #endif
 }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+void Sdl2Application::processWorkerEvents() {
+    typedef Implementation::WorkerEvent::Type Type;
+
+    Implementation::WorkerEvent event;
+    Implementation::CoalescedEvent coalesced;
+    while(_worker->events.pop(event)) {
+        if(event.type != Type::Viewport) _worker->modifiers = event.modifiers;
+
+        /* Dispatch the pending coalesced event before any other */
+        if(event.type != Type::MouseMove && event.type != Type::MouseScroll && _coalescer->flush(coalesced))
+            dispatchCoalescedEvent(coalesced);
+
+        switch(event.type) {
+            case Type::Viewport:
+                emscripten_set_canvas_element_size(CanvasTarget, event.position.x(), event.position.y());
+                viewportEvent(event.position);
+                _flags |= Flag::Redraw;
+                break;
+
+            case Type::KeyPress:
+            case Type::KeyRelease: {
+                KeyEvent e(static_cast<KeyEvent::Key>(event.code), fixedModifiers(event.modifiers));
+                event.type == Type::KeyPress ? keyPressEvent(e) : keyReleaseEvent(e);
+            } break;
+
+            case Type::MousePress:
+            case Type::MouseRelease: {
+                MouseEvent e(static_cast<MouseEvent::Button>(event.code), event.position);
+                event.type == Type::MousePress ? mousePressEvent(e) : mouseReleaseEvent(e);
+            } break;
+
+            case Type::MouseMove: {
+                if(!(_flags & Flag::CoalesceEvents)) {
+                    MouseMoveEvent e(event.position, event.relativePosition, static_cast<MouseMoveEvent::Button>(event.code));
+                    mouseMoveEvent(e);
+                } else if(_coalescer->move(event.position, event.relativePosition, event.code, coalesced))
+                    dispatchCoalescedEvent(coalesced);
+            } break;
+
+            case Type::MouseScroll: {
+                if(!(_flags & Flag::CoalesceEvents)) callMouseScrollEvent(event.offset);
+                else if(_coalescer->scroll(event.offset, coalesced))
+                    dispatchCoalescedEvent(coalesced);
+            } break;
+        }
+    }
+}
+#endif
+
+void Sdl2Application::dispatchCoalescedEvent(const Implementation::CoalescedEvent& event) {
+    if(event.type == Implementation::CoalescedEvent::Type::Move) {
+        MouseMoveEvent e(event.position, event.relativePosition, static_cast<MouseMoveEvent::Button>(event.buttons));
+        mouseMoveEvent(e);
+    } else callMouseScrollEvent(event.offset);
+}
+
+void Sdl2Application::callMouseScrollEvent(const Vector2& offset) {
+    MouseScrollEvent e{offset};
+    mouseScrollEvent(e);
+
+    #ifdef MAGNUM_BUILD_DEPRECATED
+    if(offset.y() != 0.0f) {
+        #ifdef __GNUC__
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        #endif
+        MouseEvent e(offset.y() > 0.0f ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, Vector2i{offset}
+            #ifndef CORRADE_TARGET_EMSCRIPTEN
+            , 0
+            #endif
+            );
+        #ifdef __GNUC__
+        #pragma GCC diagnostic pop
+        #endif
+        mousePressEvent(e);
+    }
+    #endif
+}
+
+std::size_t Sdl2Application::coalescedEventCount() const {
+    return _coalescer->coalescedCount();
+}
+
 void Sdl2Application::setMouseLocked(bool enabled) {
     /** @todo Implement this in Emscripten */
     #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -500,6 +891,10 @@ bool Sdl2Application::isTextInputActive() {
 }
 
 void Sdl2Application::startTextInput() {
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    /* No text input events are delivered in the worker */
+    if(!_worker)
+    #endif
     SDL_StartTextInput();
     #ifdef CORRADE_TARGET_EMSCRIPTEN
     _isTextInputActive = true;
@@ -507,6 +902,9 @@ void Sdl2Application::startTextInput() {
 }
 
 void Sdl2Application::stopTextInput() {
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(!_worker)
+    #endif
     SDL_StopTextInput();
     #ifdef CORRADE_TARGET_EMSCRIPTEN
     _isTextInputActive = false;
@@ -514,6 +912,9 @@ void Sdl2Application::stopTextInput() {
 }
 
 void Sdl2Application::setTextInputRect(const Range2Di& rect) {
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_worker) return;
+    #endif
     SDL_Rect r{rect.min().x(), rect.min().y(), rect.sizeX(), rect.sizeY()};
     SDL_SetTextInputRect(&r);
 }
@@ -555,18 +956,27 @@ Sdl2Application::Configuration::~Configuration() = default;
 Sdl2Application::InputEvent::Modifiers Sdl2Application::MouseEvent::modifiers() {
     if(_modifiersLoaded) return _modifiers;
     _modifiersLoaded = true;
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_instance->_worker) return _modifiers = fixedModifiers(_instance->_worker->modifiers);
+    #endif
     return _modifiers = fixedModifiers(Uint16(SDL_GetModState()));
 }
 
 Sdl2Application::InputEvent::Modifiers Sdl2Application::MouseMoveEvent::modifiers() {
     if(_modifiersLoaded) return _modifiers;
     _modifiersLoaded = true;
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_instance->_worker) return _modifiers = fixedModifiers(_instance->_worker->modifiers);
+    #endif
     return _modifiers = fixedModifiers(Uint16(SDL_GetModState()));
 }
 
 Sdl2Application::InputEvent::Modifiers Sdl2Application::MouseScrollEvent::modifiers() {
     if(_modifiersLoaded) return _modifiers;
     _modifiersLoaded = true;
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_instance->_worker) return _modifiers = fixedModifiers(_instance->_worker->modifiers);
+    #endif
     return _modifiers = fixedModifiers(Uint16(SDL_GetModState()));
 }
 
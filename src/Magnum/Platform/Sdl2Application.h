@@ -50,6 +50,18 @@
 
 namespace Magnum { namespace Platform {
 
+namespace Implementation {
+    class EventCoalescer;
+    struct CoalescedEvent;
+    class FramePacer;
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    struct WorkerEventQueue;
+    #endif
+}
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+class WorkerContextPool;
+#endif
+
 /** @nosubgrouping
 @brief SDL2 application
 
@@ -110,6 +122,22 @@ webserver, e.g.  `/srv/http/emscripten`).
 You can then open `MyApplication.html` in Chrome or Firefox (through webserver,
 e.g. `http://localhost/emscripten/MyApplication.html`).
 
+@anchor Platform-Sdl2Application-emscripten-worker
+## Rendering in a worker on Emscripten
+
+By default the application runs on the browser main thread, where heavy
+drawing competes with DOM updates and input handling of the whole page. If
+Magnum and the application are compiled with `-s USE_PTHREADS=1` and the
+application is linked with `-s PROXY_TO_PTHREAD=1 -s OFFSCREENCANVAS_SUPPORT=1`,
+`main()` runs in a Web Worker, the canvas is transferred to it as an
+`OffscreenCanvas` and the application detects that at runtime and renders
+there. SDL can't be used outside of the main thread, so the input events are
+captured on the main thread instead and passed to the worker through a
+lock-free queue in the shared heap, being delivered at the beginning of the
+next main loop iteration. Keyboard, mouse and viewport events are supported,
+text input is not available in this mode. The browser needs to support
+`SharedArrayBuffer` and `OffscreenCanvas` with WebGL.
+
 ## Bootstrap application for iOS
 
 Fully contained base application using @ref Sdl2Application for both desktop
@@ -437,11 +465,78 @@ class Sdl2Application {
         /**
          * @brief Swap buffers
          *
-         * Paints currently rendered framebuffer on screen.
-         * @see @ref setSwapInterval()
+         * Paints currently rendered framebuffer on screen. Also calls
+         * @ref FrameAllocator::nextFrame() on allocator of current thread.
+         * @see @ref setSwapInterval(), @ref setFramebufferInvalidationEnabled()
          */
         void swapBuffers();
 
+        /**
+         * @brief Whether default framebuffer invalidation is enabled
+         *
+         * @see @ref setFramebufferInvalidationEnabled()
+         */
+        bool isFramebufferInvalidationEnabled() const {
+            return !!(_flags & Flag::InvalidateFramebuffer);
+        }
+
+        /**
+         * @brief Enable or disable default framebuffer invalidation
+         *
+         * Tiled GPUs (common on mobile) keep the framebuffer in on-chip
+         * memory while rendering, write it back to memory at the end of the
+         * frame and load it again at the beginning of the next one. If
+         * enabled, @ref swapBuffers() invalidates depth and stencil buffer
+         * of @ref defaultFramebuffer right before the swap so they aren't
+         * written back and clears all buffers right after it so nothing is
+         * loaded again. Contents of the default framebuffer are thus not
+         * preserved across frames and the clear is affected by the current
+         * clear values and write masks. Disabled by default.
+         * @see @ref DefaultFramebuffer::invalidate(),
+         *      @ref Framebuffer::setRenderPassPolicy()
+         */
+        void setFramebufferInvalidationEnabled(bool enabled) {
+            if(enabled) _flags |= Flag::InvalidateFramebuffer;
+            else _flags &= ~Flag::InvalidateFramebuffer;
+        }
+
+        /**
+         * @brief Whether input event coalescing is enabled
+         *
+         * @see @ref setEventCoalescingEnabled()
+         */
+        bool isEventCoalescingEnabled() const {
+            return !!(_flags & Flag::CoalesceEvents);
+        }
+
+        /**
+         * @brief Enable or disable input event coalescing
+         *
+         * High polling rate mice can deliver a thousand or more move events
+         * per second, each of them triggering work such as picking or camera
+         * updates in @ref mouseMoveEvent(). If enabled, consecutive mouse
+         * move events polled in one main loop iteration are merged into a
+         * single @ref mouseMoveEvent() with the latest position and button
+         * state and relative position being the sum of all merged events.
+         * Consecutive scroll events are merged the same way into a single
+         * @ref mouseScrollEvent() with the offsets summed. Any other event
+         * is dispatched only after the pending merged event, so the order is
+         * preserved. Disabled by default.
+         */
+        void setEventCoalescingEnabled(bool enabled) {
+            if(enabled) _flags |= Flag::CoalesceEvents;
+            else _flags &= ~Flag::CoalesceEvents;
+        }
+
+        /**
+         * @brief Count of coalesced input events
+         *
+         * Count of mouse move and scroll events merged into a previous one
+         * since the application started.
+         * @see @ref setEventCoalescingEnabled()
+         */
+        std::size_t coalescedEventCount() const;
+
         /** @brief Swap interval */
         Int swapInterval() const;
 
@@ -449,13 +544,60 @@ class Sdl2Application {
          * @brief Set swap interval
          *
          * Set `0` for no VSync, `1` for enabled VSync. Some platforms support
-         * `-1` for late swap tearing. Prints error message and returns `false`
-         * if swap interval cannot be set, `true` otherwise. Default is
-         * driver-dependent, you can query the value with @ref swapInterval().
-         * @see @ref setMinimalLoopPeriod()
+         * `-1` for adaptive VSync (late swap tearing), if it is not supported,
+         * a warning is printed and the interval falls back to `1`. Prints
+         * error message and returns `false` if swap interval cannot be set,
+         * `true` otherwise. Default is driver-dependent, you can query the
+         * value with @ref swapInterval().
+         * @see @ref setMinimalLoopPeriod(), @ref setFramePacingEnabled()
          */
         bool setSwapInterval(Int interval);
 
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /**
+         * @brief Whether frame pacing is enabled
+         *
+         * @see @ref setFramePacingEnabled()
+         */
+        bool isFramePacingEnabled() const;
+
+        /**
+         * @brief Enable or disable frame pacing
+         *
+         * With VSync enabled, the buffer swap blocks until the next vertical
+         * blank, so input events polled at the beginning of the frame are
+         * already almost a whole refresh period old when the frame gets on
+         * screen. With frame pacing enabled the application measures the
+         * refresh period and the time it takes to produce a frame (from
+         * polling input to @ref swapBuffers()) and sleeps at the start of
+         * each main loop iteration until the predicted next vertical blank
+         * minus the predicted frame time. Input is then polled as late as
+         * possible, reducing the latency without introducing tearing. Has
+         * no effect if VSync is not enabled using @ref setSwapInterval().
+         * Disabled by default.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the frequency instead.
+         */
+        void setFramePacingEnabled(bool enabled);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        /**
+         * @brief Create pool of worker contexts
+         *
+         * Creates @p count OpenGL contexts sharing objects with the main one
+         * and a @ref WorkerContextPool running a thread for each of them. The
+         * worker contexts are made current with the application window, but
+         * never render to it. Prints a message to error output and returns
+         * `nullptr` if no worker context could be created. The pool has to be
+         * destroyed before the application. Include
+         * @ref Magnum/Platform/WorkerContextPool.h to use it.
+         * @note Not available in OpenGL ES 2.0 builds and in
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        std::unique_ptr<WorkerContextPool> createWorkerContextPool(UnsignedInt count);
+        #endif
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         /**
          * @brief Set minimal loop period
@@ -678,8 +820,10 @@ class Sdl2Application {
             VSyncEnabled = 1 << 1,
             NoTickEvent = 1 << 2,
             #ifndef CORRADE_TARGET_EMSCRIPTEN
-            Exit = 1 << 3
+            Exit = 1 << 3,
             #endif
+            InvalidateFramebuffer = 1 << 4,
+            CoalesceEvents = 1 << 5
         };
 
         typedef Containers::EnumSet<Flag> Flags;
@@ -690,17 +834,29 @@ class Sdl2Application {
         static void staticMainLoop();
         #endif
 
+        #ifdef __EMSCRIPTEN_PTHREADS__
+        bool tryCreateWorkerContext(const Configuration& configuration);
+        void processWorkerEvents();
+        #endif
+
         void mainLoop();
+        void dispatchCoalescedEvent(const Implementation::CoalescedEvent& event);
+        void callMouseScrollEvent(const Vector2& offset);
 
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Window* _window;
         SDL_GLContext _glContext;
         UnsignedInt _minimalLoopPeriod;
+        std::unique_ptr<Implementation::FramePacer> _framePacer;
         #else
         SDL_Surface* _glContext;
         bool _isTextInputActive = false;
         #endif
+        #ifdef __EMSCRIPTEN_PTHREADS__
+        std::unique_ptr<Implementation::WorkerEventQueue> _worker;
+        #endif
 
+        std::unique_ptr<Implementation::EventCoalescer> _coalescer;
         std::unique_ptr<Platform::Context> _context;
 
         Flags _flags;
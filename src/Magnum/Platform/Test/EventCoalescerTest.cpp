@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Platform/Implementation/EventCoalescer.h"
+
+namespace Magnum { namespace Platform { namespace Test {
+
+struct EventCoalescerTest: TestSuite::Tester {
+    explicit EventCoalescerTest();
+
+    void empty();
+    void move();
+    void scroll();
+    void interleaved();
+    void flushTwice();
+};
+
+EventCoalescerTest::EventCoalescerTest() {
+    addTests({&EventCoalescerTest::empty,
+              &EventCoalescerTest::move,
+              &EventCoalescerTest::scroll,
+              &EventCoalescerTest::interleaved,
+              &EventCoalescerTest::flushTwice});
+}
+
+typedef Implementation::CoalescedEvent::Type Type;
+
+void EventCoalescerTest::empty() {
+    Implementation::EventCoalescer coalescer;
+
+    Implementation::CoalescedEvent event{};
+    CORRADE_VERIFY(!coalescer.flush(event));
+    CORRADE_COMPARE(coalescer.coalescedCount(), 0);
+}
+
+void EventCoalescerTest::move() {
+    Implementation::EventCoalescer coalescer;
+
+    Implementation::CoalescedEvent event{};
+    CORRADE_VERIFY(!coalescer.move({10, 20}, {1, 2}, 0, event));
+    CORRADE_VERIFY(!coalescer.move({13, 18}, {3, -2}, 1, event));
+    CORRADE_VERIFY(!coalescer.move({15, 21}, {2, 3}, 1, event));
+    CORRADE_COMPARE(coalescer.coalescedCount(), 2);
+
+    /* Latest position and buttons, summed relative position */
+    CORRADE_VERIFY(coalescer.flush(event));
+    CORRADE_VERIFY(event.type == Type::Move);
+    CORRADE_COMPARE(event.position, (Vector2i{15, 21}));
+    CORRADE_COMPARE(event.relativePosition, (Vector2i{6, 3}));
+    CORRADE_COMPARE(event.buttons, 1);
+}
+
+void EventCoalescerTest::scroll() {
+    Implementation::EventCoalescer coalescer;
+
+    Implementation::CoalescedEvent event{};
+    CORRADE_VERIFY(!coalescer.scroll({0.0f, 1.0f}, event));
+    CORRADE_VERIFY(!coalescer.scroll({0.5f, 1.0f}, event));
+    CORRADE_VERIFY(!coalescer.scroll({0.0f, -3.0f}, event));
+    CORRADE_COMPARE(coalescer.coalescedCount(), 2);
+
+    CORRADE_VERIFY(coalescer.flush(event));
+    CORRADE_VERIFY(event.type == Type::Scroll);
+    CORRADE_COMPARE(event.offset, (Vector2{0.5f, -1.0f}));
+}
+
+void EventCoalescerTest::interleaved() {
+    Implementation::EventCoalescer coalescer;
+
+    /* A scroll in between flushes the pending move and vice versa */
+    Implementation::CoalescedEvent event{};
+    CORRADE_VERIFY(!coalescer.move({1, 1}, {1, 1}, 0, event));
+    CORRADE_VERIFY(!coalescer.move({2, 2}, {1, 1}, 0, event));
+    CORRADE_VERIFY(coalescer.scroll({0.0f, 1.0f}, event));
+    CORRADE_VERIFY(event.type == Type::Move);
+    CORRADE_COMPARE(event.position, (Vector2i{2, 2}));
+    CORRADE_COMPARE(event.relativePosition, (Vector2i{2, 2}));
+
+    CORRADE_VERIFY(coalescer.move({5, 5}, {3, 3}, 0, event));
+    CORRADE_VERIFY(event.type == Type::Scroll);
+    CORRADE_COMPARE(event.offset, (Vector2{0.0f, 1.0f}));
+
+    CORRADE_VERIFY(coalescer.flush(event));
+    CORRADE_VERIFY(event.type == Type::Move);
+    CORRADE_COMPARE(event.position, (Vector2i{5, 5}));
+    CORRADE_COMPARE(event.relativePosition, (Vector2i{3, 3}));
+    CORRADE_COMPARE(coalescer.coalescedCount(), 1);
+}
+
+void EventCoalescerTest::flushTwice() {
+    Implementation::EventCoalescer coalescer;
+
+    Implementation::CoalescedEvent event{};
+    CORRADE_VERIFY(!coalescer.move({1, 1}, {1, 1}, 0, event));
+    CORRADE_VERIFY(coalescer.flush(event));
+    CORRADE_VERIFY(!coalescer.flush(event));
+
+    /* A new event after the flush isn't merged with the flushed one */
+    CORRADE_VERIFY(!coalescer.move({4, 4}, {3, 3}, 0, event));
+    CORRADE_VERIFY(coalescer.flush(event));
+    CORRADE_COMPARE(event.relativePosition, (Vector2i{3, 3}));
+    CORRADE_COMPARE(coalescer.coalescedCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Platform::Test::EventCoalescerTest)
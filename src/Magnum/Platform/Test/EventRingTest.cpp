@@ -0,0 +1,140 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Platform/Implementation/EventRing.h"
+
+namespace Magnum { namespace Platform { namespace Test {
+
+struct EventRingTest: TestSuite::Tester {
+    explicit EventRingTest();
+
+    void pushPop();
+    void empty();
+    void full();
+    void wrapAround();
+    void threaded();
+};
+
+EventRingTest::EventRingTest() {
+    addTests({&EventRingTest::pushPop,
+              &EventRingTest::empty,
+              &EventRingTest::full,
+              &EventRingTest::wrapAround,
+              &EventRingTest::threaded});
+}
+
+typedef Implementation::EventRing<UnsignedInt, 4> EventRing;
+
+void EventRingTest::pushPop() {
+    EventRing ring;
+    CORRADE_VERIFY(ring.push(3));
+    CORRADE_VERIFY(ring.push(7));
+    CORRADE_COMPARE(ring.count(), 2);
+
+    UnsignedInt event{};
+    CORRADE_VERIFY(ring.pop(event));
+    CORRADE_COMPARE(event, 3);
+    CORRADE_VERIFY(ring.pop(event));
+    CORRADE_COMPARE(event, 7);
+    CORRADE_COMPARE(ring.count(), 0);
+}
+
+void EventRingTest::empty() {
+    EventRing ring;
+
+    UnsignedInt event = 42;
+    CORRADE_VERIFY(!ring.pop(event));
+    CORRADE_COMPARE(event, 42);
+}
+
+void EventRingTest::full() {
+    EventRing ring;
+    for(UnsignedInt i = 0; i != 4; ++i) CORRADE_VERIFY(ring.push(i));
+
+    /* The new event is dropped, the old ones are kept */
+    CORRADE_VERIFY(!ring.push(4));
+    CORRADE_VERIFY(!ring.push(5));
+    CORRADE_COMPARE(ring.count(), 4);
+    CORRADE_COMPARE(ring.droppedCount(), 2);
+
+    UnsignedInt event{};
+    CORRADE_VERIFY(ring.pop(event));
+    CORRADE_COMPARE(event, 0);
+    CORRADE_VERIFY(ring.push(6));
+    CORRADE_COMPARE(ring.count(), 4);
+}
+
+void EventRingTest::wrapAround() {
+    EventRing ring;
+
+    UnsignedInt event{};
+    for(UnsignedInt i = 0; i != 25; ++i) {
+        CORRADE_VERIFY(ring.push(i));
+        CORRADE_VERIFY(ring.push(i*10));
+        CORRADE_VERIFY(ring.pop(event));
+        CORRADE_COMPARE(event, i);
+        CORRADE_VERIFY(ring.pop(event));
+        CORRADE_COMPARE(event, i*10);
+    }
+
+    CORRADE_COMPARE(ring.count(), 0);
+    CORRADE_COMPARE(ring.droppedCount(), 0);
+}
+
+void EventRingTest::threaded() {
+    Implementation::EventRing<UnsignedInt, 64> ring;
+    constexpr UnsignedInt count = 100000;
+
+    std::thread producer{[&ring]() {
+        for(UnsignedInt i = 0; i != count; ++i)
+            while(!ring.push(i)) std::this_thread::yield();
+    }};
+
+    /* Events arrive complete and in order */
+    UnsignedInt expected = 0;
+    bool ordered = true;
+    while(expected != count) {
+        UnsignedInt event;
+        if(!ring.pop(event)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if(event != expected) ordered = false;
+        ++expected;
+    }
+
+    producer.join();
+    CORRADE_VERIFY(ordered);
+    CORRADE_COMPARE(ring.count(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Platform::Test::EventRingTest)
@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Platform/Implementation/FramePacer.h"
+
+namespace Magnum { namespace Platform { namespace Test {
+
+struct FramePacerTest: TestSuite::Tester {
+    explicit FramePacerTest();
+
+    void notEnoughSamples();
+    void disabled();
+    void delay();
+    void delayMissedVblank();
+    void delayTooExpensive();
+    void periodOutlier();
+    void swapOutsideOfFrame();
+};
+
+FramePacerTest::FramePacerTest() {
+    addTests({&FramePacerTest::notEnoughSamples,
+              &FramePacerTest::disabled,
+              &FramePacerTest::delay,
+              &FramePacerTest::delayMissedVblank,
+              &FramePacerTest::delayTooExpensive,
+              &FramePacerTest::periodOutlier,
+              &FramePacerTest::swapOutsideOfFrame});
+}
+
+typedef Implementation::FramePacer FramePacer;
+using std::chrono::microseconds;
+
+namespace {
+    /* Simulates frames taking given CPU time, with swaps blocking until
+       vblank on 10 ms boundaries */
+    FramePacer::Clock::time_point simulate(FramePacer& pacer, std::size_t count, microseconds cost) {
+        FramePacer::Clock::time_point time{std::chrono::seconds{1}};
+        for(std::size_t i = 0; i != count; ++i) {
+            pacer.frameStarted(time);
+            time += cost;
+            pacer.swapStarted(time);
+            time = FramePacer::Clock::time_point{std::chrono::seconds{1}} + microseconds{10000*(i + 1)};
+            pacer.swapFinished(time);
+        }
+        return time;
+    }
+}
+
+void FramePacerTest::notEnoughSamples() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+
+    const auto time = simulate(pacer, 2, microseconds{2000});
+    CORRADE_VERIFY(pacer.predictedPeriod() == FramePacer::Clock::duration{});
+    CORRADE_VERIFY(pacer.predictedCost() == FramePacer::Clock::duration{});
+    CORRADE_VERIFY(pacer.delay(time) == FramePacer::Clock::duration{});
+}
+
+void FramePacerTest::disabled() {
+    FramePacer pacer;
+
+    const auto time = simulate(pacer, 10, microseconds{2000});
+    CORRADE_VERIFY(pacer.predictedPeriod() == microseconds{10000});
+    CORRADE_VERIFY(pacer.delay(time) == FramePacer::Clock::duration{});
+}
+
+void FramePacerTest::delay() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+    pacer.setMargin(microseconds{500});
+
+    const auto time = simulate(pacer, 10, microseconds{2000});
+    CORRADE_VERIFY(pacer.predictedPeriod() == microseconds{10000});
+    CORRADE_VERIFY(pacer.predictedCost() == microseconds{2000});
+
+    /* Next vblank is in 10 ms, the frame takes 2 ms plus the margin */
+    CORRADE_COMPARE(std::chrono::duration_cast<microseconds>(pacer.delay(time)).count(), 7500);
+    CORRADE_COMPARE(std::chrono::duration_cast<microseconds>(pacer.delay(time + microseconds{3000})).count(), 4500);
+}
+
+void FramePacerTest::delayMissedVblank() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+    pacer.setMargin(microseconds{500});
+
+    /* Event processing took so long that the next vblank was missed, aim for
+       the one after */
+    const auto time = simulate(pacer, 10, microseconds{2000});
+    CORRADE_COMPARE(std::chrono::duration_cast<microseconds>(pacer.delay(time + microseconds{11000})).count(), 6500);
+}
+
+void FramePacerTest::delayTooExpensive() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+
+    /* The frame takes nearly whole period, no time to sleep */
+    const auto time = simulate(pacer, 10, microseconds{9800});
+    CORRADE_VERIFY(pacer.delay(time) == FramePacer::Clock::duration{});
+}
+
+void FramePacerTest::periodOutlier() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+
+    FramePacer::Clock::time_point time{std::chrono::seconds{1}};
+    pacer.swapFinished(time);
+    for(std::size_t i = 0; i != 8; ++i) {
+        /* Every fourth frame misses a vblank */
+        time += microseconds{i % 4 == 3 ? 20000 : 10000};
+        pacer.swapFinished(time);
+    }
+
+    /* The median is not affected by the missed frames */
+    CORRADE_VERIFY(pacer.predictedPeriod() == microseconds{10000});
+}
+
+void FramePacerTest::swapOutsideOfFrame() {
+    FramePacer pacer;
+    pacer.setEnabled(true);
+
+    simulate(pacer, 10, microseconds{2000});
+
+    /* Swap without frameStarted() shouldn't record bogus cost */
+    pacer.swapStarted(FramePacer::Clock::time_point{std::chrono::seconds{5}});
+    CORRADE_VERIFY(pacer.predictedCost() == microseconds{2000});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Platform::Test::FramePacerTest)
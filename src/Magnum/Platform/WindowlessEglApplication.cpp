@@ -25,19 +25,58 @@
 
 #include "WindowlessEglApplication.h"
 
+#include <vector>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Platform/WorkerContextPool.h"
+#endif
 
 #include "Implementation/Egl.h"
 
 namespace Magnum { namespace Platform {
 
+namespace {
+
+std::vector<EGLDeviceEXT> eglDevices() {
+    const auto eglQueryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    EGLint count;
+    if(!eglQueryDevices || !eglQueryDevices(0, nullptr, &count))
+        return {};
+
+    std::vector<EGLDeviceEXT> devices(count);
+    eglQueryDevices(count, devices.data(), &count);
+    return devices;
+}
+
+}
+
+UnsignedInt WindowlessEglContext::deviceCount() {
+    return eglDevices().size();
+}
+
 WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, Context*) {
+    /* Get display for given device, if requested */
+    if(configuration.device() != -1) {
+        const std::vector<EGLDeviceEXT> devices = eglDevices();
+        if(UnsignedInt(configuration.device()) >= devices.size()) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): requested device" << configuration.device() << "but only" << devices.size() << "available";
+            return;
+        }
+
+        const auto eglGetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if(!eglGetPlatformDisplay) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): EGL_EXT_platform_device is not supported";
+            return;
+        }
+
+        _display = eglGetPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[configuration.device()], nullptr);
+    } else _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
     /* Initialize */
-    _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
     if(!eglInitialize(_display, nullptr, nullptr)) {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot initialize EGL:" << Implementation::eglErrorString(eglGetError());
         return;
@@ -96,26 +135,31 @@ WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, C
         EGL_NONE
     };
 
-    if(!(_context = eglCreateContext(_display, config, EGL_NO_CONTEXT, attributes))) {
+    /* The shared context uses the same display, don't terminate it in
+       destructor */
+    _sharedDisplay = configuration.sharedContext() != EGL_NO_CONTEXT;
+
+    if(!(_context = eglCreateContext(_display, config, configuration.sharedContext(), attributes))) {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot create EGL context:" << Implementation::eglErrorString(eglGetError());
         return;
     }
 }
 
-WindowlessEglContext::WindowlessEglContext(WindowlessEglContext&& other): _display{other._display}, _context{other._context} {
+WindowlessEglContext::WindowlessEglContext(WindowlessEglContext&& other): _display{other._display}, _context{other._context}, _sharedDisplay{other._sharedDisplay} {
     other._display = {};
     other._context = {};
 }
 
 WindowlessEglContext::~WindowlessEglContext() {
     if(_context) eglDestroyContext(_display, _context);
-    if(_display) eglTerminate(_display);
+    if(_display && !_sharedDisplay) eglTerminate(_display);
 }
 
 WindowlessEglContext& WindowlessEglContext::operator=(WindowlessEglContext && other) {
     using std::swap;
     swap(other._display, _display);
     swap(other._context, _context);
+    swap(other._sharedDisplay, _sharedDisplay);
     return *this;
 }
 
@@ -151,9 +195,41 @@ bool WindowlessEglApplication::tryCreateContext(const Configuration& configurati
         return false;
 
     _glContext = std::move(glContext);
+    _device = configuration.device();
     return true;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+std::unique_ptr<WorkerContextPool> WindowlessEglApplication::createWorkerContextPool(const UnsignedInt count) {
+    std::vector<WorkerContextPool::WorkerContext> contexts;
+    contexts.reserve(count);
+
+    for(UnsignedInt i = 0; i != count; ++i) {
+        Configuration configuration;
+        configuration.setSharedContext(_glContext.glContext());
+        if(_device != -1) configuration.setDevice(_device);
+
+        std::shared_ptr<WindowlessEglContext> glContext = std::make_shared<WindowlessEglContext>(configuration, _context.get());
+        if(!glContext->isCreated()) {
+            Error() << "Platform::WindowlessEglApplication::createWorkerContextPool(): cannot create shared context";
+            break;
+        }
+
+        /* The context is destroyed together with the pool */
+        contexts.push_back({
+            [glContext]() { return glContext->makeCurrent(); },
+            []() { eglMakeCurrent(eglGetCurrentDisplay(), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT); },
+            {}});
+    }
+
+    if(contexts.empty()) return nullptr;
+
+    std::unique_ptr<WorkerContextPool> pool{new WorkerContextPool{std::move(contexts)}};
+    if(!pool->threadCount()) return nullptr;
+    return pool;
+}
+#endif
+
 WindowlessEglApplication::~WindowlessEglApplication() = default;
 
 }}
@@ -46,6 +46,10 @@
 
 namespace Magnum { namespace Platform {
 
+#ifndef MAGNUM_TARGET_GLES2
+class WorkerContextPool;
+#endif
+
 /**
 @brief Windowless EGL context
 
@@ -81,6 +85,15 @@ class WindowlessEglContext {
          */
         explicit WindowlessEglContext(NoCreateT) {}
 
+        /**
+         * @brief Count of available rendering devices
+         *
+         * Returns `0` if @extension{EXT,device_enumeration} is not
+         * supported.
+         * @see @ref Configuration::setDevice()
+         */
+        static UnsignedInt deviceCount();
+
         /** @brief Copying is not allowed */
         WindowlessEglContext(const WindowlessEglContext&) = delete;
 
@@ -111,9 +124,20 @@ class WindowlessEglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call EGL functionality directly or
+         * in order to create a shared context. Returns `nullptr` in case the
+         * context was not created yet.
+         * @see @ref Configuration::setSharedContext()
+         */
+        EGLContext glContext() { return _context; }
+
     private:
         EGLDisplay _display{};
         EGLContext _context{};
+        bool _sharedDisplay{};
 };
 
 /**
@@ -162,8 +186,50 @@ class WindowlessEglContext::Configuration {
             return *this;
         }
 
+        /** @brief Device ID */
+        Int device() const { return _device; }
+
+        /**
+         * @brief Set device ID
+         * @return Reference to self (for method chaining)
+         *
+         * Selects a rendering device from the list returned by
+         * @extension{EXT,device_enumeration}, allowing to use more GPUs in a
+         * single process without any display server. Requires also
+         * @extension{EXT,platform_device}. Default is `-1`, which uses
+         * `EGL_DEFAULT_DISPLAY`.
+         * @see @ref WindowlessEglContext::deviceCount()
+         */
+        Configuration& setDevice(UnsignedInt id) {
+            _device = id;
+            return *this;
+        }
+
+        /** @brief Shared context */
+        EGLContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set shared context
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. The context has to be created
+         * on the same @ref setDevice() "device". Default is `nullptr`, i.e.
+         * no sharing.
+         * @see @ref WindowlessEglContext::glContext(),
+         *      @ref WindowlessEglApplication::createWorkerContextPool()
+         */
+        Configuration& setSharedContext(EGLContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        Int _device{-1};
+        EGLContext _sharedContext{};
 };
 
 /**
@@ -213,6 +279,32 @@ MAGNUM_WINDOWLESSEGLAPPLICATION_MAIN(MyApplication)
 If no other application header is included, this class is also aliased to
 `Platform::WindowlessApplication` and the macro is aliased to
 `MAGNUM_WINDOWLESSAPPLICATION_MAIN()` to simplify porting.
+
+## Batch rendering
+
+For render farms it's better to keep one long-running process per GPU instead
+of creating the context and compiling the shaders for each job. Select the GPU
+with @ref Configuration::setDevice(), load the shaders once (possibly using a
+@ref ProgramBinaryCache) and render the jobs using @ref BatchRenderer, which
+overlaps rendering with reading back and encoding of the previous jobs:
+@code
+class RenderServer: public Platform::WindowlessEglApplication {
+    public:
+        explicit RenderServer(const Arguments& arguments): Platform::WindowlessEglApplication{arguments, Configuration{}.setDevice(deviceFromArguments(arguments))} {}
+
+        int exec() override {
+            BatchRenderer renderer{{512, 512}};
+            Shaders::Phong shader;
+
+            while(Job job = waitForJob()) renderer.submit(
+                [&](Framebuffer&) { render(shader, job); },
+                [job](Image2D& image) { encode(image, job); });
+
+            renderer.finish();
+            return 0;
+        }
+};
+@endcode
 */
 class WindowlessEglApplication {
     public:
@@ -320,9 +412,25 @@ class WindowlessEglApplication {
          */
         bool tryCreateContext(const Configuration& configuration);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Create pool of worker contexts
+         *
+         * Creates @p count contexts with default @ref Configuration on the
+         * same device as the main context, sharing objects with it, and a @ref WorkerContextPool running a
+         * thread for each of them. Prints a message to error output and
+         * returns `nullptr` if no worker context could be created. The pool
+         * has to be destroyed before the application. Include
+         * @ref Magnum/Platform/WorkerContextPool.h to use it.
+         * @note Not available in OpenGL ES 2.0 builds.
+         */
+        std::unique_ptr<WorkerContextPool> createWorkerContextPool(UnsignedInt count);
+        #endif
+
     private:
         WindowlessEglContext _glContext;
         std::unique_ptr<Platform::Context> _context;
+        Int _device{-1};
 };
 
 /** @hideinitializer
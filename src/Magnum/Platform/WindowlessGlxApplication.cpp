@@ -31,6 +31,9 @@
 
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Platform/WorkerContextPool.h"
+#endif
 
 /* Saner way to define the None Xlib macro (anyway, FUCK YOU XLIB) */
 namespace { enum { None = 0L }; }
@@ -89,7 +92,7 @@ WindowlessGlxContext::WindowlessGlxContext(const WindowlessGlxContext::Configura
         #endif
         0
     };
-    _context = glXCreateContextAttribsARB(_display, configs[0], nullptr, True, contextAttributes);
+    _context = glXCreateContextAttribsARB(_display, configs[0], configuration.sharedContext(), True, contextAttributes);
 
     #ifndef MAGNUM_TARGET_GLES
     /* Fall back to (forward compatible) GL 2.1 if core context creation fails */
@@ -100,7 +103,7 @@ WindowlessGlxContext::WindowlessGlxContext(const WindowlessGlxContext::Configura
             GLX_CONTEXT_FLAGS_ARB, GLint(configuration.flags()),
             0
         };
-        _context = glXCreateContextAttribsARB(_display, configs[0], nullptr, True, fallbackContextAttributes);
+        _context = glXCreateContextAttribsARB(_display, configs[0], configuration.sharedContext(), True, fallbackContextAttributes);
 
     /* Fall back to (forward compatible) GL 2.1 if we are on binary NVidia/AMD
        drivers on Linux. Instead of creating forward-compatible context with
@@ -133,7 +136,7 @@ WindowlessGlxContext::WindowlessGlxContext(const WindowlessGlxContext::Configura
                 GLX_CONTEXT_FLAGS_ARB, GLint(configuration.flags()),
                 0
             };
-            _context = glXCreateContextAttribsARB(_display, configs[0], nullptr, True, fallbackContextAttributes);
+            _context = glXCreateContextAttribsARB(_display, configs[0], configuration.sharedContext(), True, fallbackContextAttributes);
         }
 
         /* Revert back the old context */
@@ -207,6 +210,33 @@ bool WindowlessGlxApplication::tryCreateContext(const Configuration& configurati
     return true;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+std::unique_ptr<WorkerContextPool> WindowlessGlxApplication::createWorkerContextPool(const UnsignedInt count) {
+    std::vector<WorkerContextPool::WorkerContext> contexts;
+    contexts.reserve(count);
+
+    for(UnsignedInt i = 0; i != count; ++i) {
+        std::shared_ptr<WindowlessGlxContext> glContext = std::make_shared<WindowlessGlxContext>(Configuration{}.setSharedContext(_glContext.glContext()), _context.get());
+        if(!glContext->isCreated()) {
+            Error() << "Platform::WindowlessGlxApplication::createWorkerContextPool(): cannot create shared context";
+            break;
+        }
+
+        /* The context is destroyed together with the pool */
+        contexts.push_back({
+            [glContext]() { return glContext->makeCurrent(); },
+            []() { glXMakeContextCurrent(glXGetCurrentDisplay(), None, None, nullptr); },
+            {}});
+    }
+
+    if(contexts.empty()) return nullptr;
+
+    std::unique_ptr<WorkerContextPool> pool{new WorkerContextPool{std::move(contexts)}};
+    if(!pool->threadCount()) return nullptr;
+    return pool;
+}
+#endif
+
 WindowlessGlxApplication::~WindowlessGlxApplication() = default;
 
 }}
@@ -48,6 +48,10 @@
 
 namespace Magnum { namespace Platform {
 
+#ifndef MAGNUM_TARGET_GLES2
+class WorkerContextPool;
+#endif
+
 /**
 @brief Windowless GLX context
 
@@ -123,6 +127,16 @@ class WindowlessGlxContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call GLX functionality directly or
+         * in order to create a shared context. Returns `nullptr` in case the
+         * context was not created yet.
+         * @see @ref Configuration::setSharedContext()
+         */
+        GLXContext glContext() { return _context; }
+
     private:
         Display* _display{};
         GLXPbuffer _pbuffer{};
@@ -175,8 +189,29 @@ class WindowlessGlxContext::Configuration {
             return *this;
         }
 
+        /** @brief Shared context */
+        GLXContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set shared context
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. Default is `nullptr`, i.e. no
+         * sharing.
+         * @see @ref WindowlessGlxContext::glContext(),
+         *      @ref WindowlessGlxApplication::createWorkerContextPool()
+         */
+        Configuration& setSharedContext(GLXContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        GLXContext _sharedContext{};
 };
 
 /**
@@ -333,6 +368,21 @@ class WindowlessGlxApplication {
          */
         bool tryCreateContext(const Configuration& configuration);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Create pool of worker contexts
+         *
+         * Creates @p count contexts with default @ref Configuration sharing
+         * objects with the main one and a @ref WorkerContextPool running a
+         * thread for each of them. Prints a message to error output and
+         * returns `nullptr` if no worker context could be created. The pool
+         * has to be destroyed before the application. Include
+         * @ref Magnum/Platform/WorkerContextPool.h to use it.
+         * @note Not available in OpenGL ES 2.0 builds.
+         */
+        std::unique_ptr<WorkerContextPool> createWorkerContextPool(UnsignedInt count);
+        #endif
+
     private:
         WindowlessGlxContext _glContext;
         std::unique_ptr<Platform::Context> _context;
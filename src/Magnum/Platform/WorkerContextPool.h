@@ -0,0 +1,399 @@
+#ifndef Magnum_Platform_WorkerContextPool_h
+#define Magnum_Platform_WorkerContextPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Platform::WorkerContextPool
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Platform/Context.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+namespace Magnum { namespace Platform {
+
+/**
+@brief Pool of worker threads with shared OpenGL contexts
+
+Runs jobs on worker threads, each having its own OpenGL context that shares
+objects with the main one and its own @ref Platform::Context instance, so
+data uploads and shader compilation can run in parallel with rendering. The
+pool is created by the application, see
+@ref Sdl2Application::createWorkerContextPool(),
+@ref GlfwApplication::createWorkerContextPool(),
+@ref WindowlessGlxApplication::createWorkerContextPool() and
+@ref WindowlessEglApplication::createWorkerContextPool().
+
+## Usage
+
+The job is a function returning the created object. After it returns, the
+worker inserts a fence into its command stream and hands the object over to
+the main thread using a @ref Handoff instance:
+@code
+std::unique_ptr<Platform::WorkerContextPool> workers = createWorkerContextPool(2);
+
+Platform::WorkerContextPool::Handoff<Texture2D> handoff = workers->submit([]() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {1024, 1024})
+        .setSubImage(0, {}, image);
+    return texture;
+});
+
+// Later, in drawEvent()
+if(handoff.isReady()) _texture = handoff.get();
+@endcode
+
+@ref Handoff::isReady() returns `true` only after the job finished and the GPU
+executed all commands issued by it, so the main thread never stalls on an
+upload in progress. @ref Handoff::get() additionally makes the main context
+wait for the fence on the GPU side, so it's safe to call it also before the
+upload is done.
+
+## Shareable objects
+
+Only buffers, textures, renderbuffers, samplers, shaders and shader programs
+are shared between contexts. Container objects --- @ref Mesh "meshes" (vertex
+array objects), @ref Framebuffer "framebuffers", @ref TransformFeedback
+"transform feedback objects" --- and queries are not shared and have to be
+created on the main thread. The jobs are executed in an unspecified order by
+any of the workers, the submitted function must not access any state shared
+with other threads without its own synchronization.
+
+@attention Each thread needs its own current @ref Context instance, so the
+    pool requires Magnum to be built with @ref MAGNUM_BUILD_MULTITHREADED.
+    Fences require @extension{ARB,sync} (part of OpenGL 3.2), OpenGL ES 3.0 or
+    WebGL 2.0, the class is not available in OpenGL ES 2.0 builds nor in
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class WorkerContextPool {
+    public:
+        template<class T> class Handoff;
+
+        /**
+         * @brief Worker context
+         *
+         * Functions managing one shared OpenGL context, provided by the
+         * application.
+         */
+        struct WorkerContext {
+            /**
+             * @brief Make the context current in calling thread
+             *
+             * Called from the worker thread. Should return `false` on
+             * failure.
+             */
+            std::function<bool()> makeCurrent;
+
+            /** @brief Release the context from calling thread */
+            std::function<void()> release;
+
+            /**
+             * @brief Destroy the context
+             *
+             * Called from the thread destroying the pool after all workers
+             * finished. Can be empty.
+             */
+            std::function<void()> destroy;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Spawns one worker thread for each context and waits until all of
+         * them are initialized. Workers whose context can't be made current
+         * or whose @ref Platform::Context can't be created print a message to
+         * error output and exit, see @ref threadCount().
+         */
+        explicit WorkerContextPool(std::vector<WorkerContext> contexts);
+
+        /** @brief Copying is not allowed */
+        WorkerContextPool(const WorkerContextPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        WorkerContextPool(WorkerContextPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits until all submitted jobs are done, joins the worker threads
+         * and destroys the contexts.
+         */
+        ~WorkerContextPool();
+
+        /** @brief Copying is not allowed */
+        WorkerContextPool& operator=(const WorkerContextPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        WorkerContextPool& operator=(WorkerContextPool&&) = delete;
+
+        /** @brief Count of successfully initialized worker threads */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Count of jobs not yet finished
+         *
+         * Jobs waiting in the queue plus jobs being executed. Thread-safe.
+         */
+        std::size_t pendingCount();
+
+        /**
+         * @brief Submit a job
+         *
+         * The function @p f is executed on one of the worker threads and its
+         * return value is passed to returned @ref Handoff instance. The
+         * return type must not be `void`. Expects that there is at least one
+         * worker thread.
+         * @see @fn_gl{FenceSync}, @fn_gl{Flush}
+         */
+        template<class F> auto submit(F f) -> Handoff<decltype(f())>;
+
+    private:
+        void run(WorkerContext& context, std::promise<bool>& started);
+
+        std::vector<WorkerContext> _contexts;
+        std::vector<std::thread> _threads;
+        UnsignedInt _threadCount;
+
+        /* Shared with the worker threads */
+        std::mutex _mutex;
+        std::condition_variable _jobCondition;
+        std::deque<std::function<void()>> _jobs;
+        std::size_t _running;
+        bool _stopped;
+};
+
+/**
+@brief Object handed over from a worker thread
+
+@see @ref WorkerContextPool::submit()
+*/
+template<class T> class WorkerContextPool::Handoff {
+    friend WorkerContextPool;
+
+    public:
+        /** @brief Copying is not allowed */
+        Handoff(const Handoff<T>&) = delete;
+
+        /** @brief Move constructor */
+        Handoff(Handoff<T>&& other): _future{std::move(other._future)}, _data{std::move(other._data)} {
+            other._data = std::nullopt;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * If the object was not retrieved using @ref get(), waits until the
+         * job is finished and destroys the object together with the fence.
+         * Must be called with the main context current.
+         */
+        ~Handoff();
+
+        /** @brief Copying is not allowed */
+        Handoff<T>& operator=(const Handoff<T>&) = delete;
+
+        /** @brief Move assignment */
+        Handoff<T>& operator=(Handoff<T>&& other) {
+            using std::swap;
+            swap(_future, other._future);
+            swap(_data, other._data);
+            return *this;
+        }
+
+        /**
+         * @brief Whether the object is ready
+         *
+         * Returns `true` if the job is finished and the GPU executed all
+         * commands issued by it. Doesn't block.
+         * @see @fn_gl{ClientWaitSync}
+         */
+        bool isReady();
+
+        /**
+         * @brief Retrieve the object
+         *
+         * Blocks until the job is finished and makes the current context wait
+         * for the fence on the GPU side, so subsequent commands using the
+         * object are executed after the upload is done. Can be called only
+         * once.
+         * @see @fn_gl{WaitSync}, @fn_gl{DeleteSync}
+         */
+        T get();
+
+    private:
+        explicit Handoff(std::future<std::pair<T, GLsync>>&& future): _future{std::move(future)} {}
+
+        void receive() {
+            if(!_data) _data = _future.get();
+        }
+
+        std::future<std::pair<T, GLsync>> _future;
+        std::optional<std::pair<T, GLsync>> _data;
+};
+
+inline WorkerContextPool::WorkerContextPool(std::vector<WorkerContext> contexts): _contexts{std::move(contexts)}, _threadCount{}, _running{}, _stopped{} {
+    #ifndef MAGNUM_BUILD_MULTITHREADED
+    CORRADE_ASSERT(false, "Platform::WorkerContextPool: Magnum is not built with MAGNUM_BUILD_MULTITHREADED", );
+    #endif
+
+    /* Wait until all workers initialized so the main context isn't used
+       concurrently with the context setup */
+    std::vector<std::promise<bool>> started(_contexts.size());
+    std::vector<std::future<bool>> startedFutures;
+    startedFutures.reserve(_contexts.size());
+    for(std::promise<bool>& s: started) startedFutures.push_back(s.get_future());
+
+    _threads.reserve(_contexts.size());
+    for(std::size_t i = 0; i != _contexts.size(); ++i)
+        _threads.emplace_back(&WorkerContextPool::run, this, std::ref(_contexts[i]), std::ref(started[i]));
+    for(std::future<bool>& s: startedFutures)
+        if(s.get()) ++_threadCount;
+}
+
+inline WorkerContextPool::~WorkerContextPool() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopped = true;
+    }
+    _jobCondition.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+
+    for(WorkerContext& context: _contexts)
+        if(context.destroy) context.destroy();
+}
+
+inline std::size_t WorkerContextPool::pendingCount() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _jobs.size() + _running;
+}
+
+inline void WorkerContextPool::run(WorkerContext& context, std::promise<bool>& started) {
+    if(!context.makeCurrent()) {
+        Error() << "Platform::WorkerContextPool: cannot make worker context current";
+        started.set_value(false);
+        return;
+    }
+
+    {
+        Platform::Context magnumContext{NoCreate, 0, nullptr};
+        const bool created = magnumContext.tryCreate();
+        if(!created) Error() << "Platform::WorkerContextPool: cannot initialize worker context";
+        started.set_value(created);
+
+        /* Finish all remaining jobs before exiting, as there might be
+           handoffs waiting for them */
+        if(created) for(;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _jobCondition.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+                if(_jobs.empty()) break;
+
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                ++_running;
+            }
+
+            job();
+
+            std::lock_guard<std::mutex> lock{_mutex};
+            --_running;
+        }
+    }
+
+    context.release();
+}
+
+template<class F> auto WorkerContextPool::submit(F f) -> Handoff<decltype(f())> {
+    typedef decltype(f()) T;
+    CORRADE_ASSERT(_threadCount, "Platform::WorkerContextPool::submit(): no worker threads", (Handoff<T>{{}}));
+
+    /* std::function needs a copyable functor, so the promise is shared */
+    auto promise = std::make_shared<std::promise<std::pair<T, GLsync>>>();
+    Handoff<T> handoff{promise->get_future()};
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _jobs.emplace_back([promise, f]() mutable {
+            T result = f();
+
+            /* The flush ensures the fence reaches the GPU, otherwise waiting
+               for it from the main context could block forever */
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            promise->set_value(std::make_pair(std::move(result), fence));
+        });
+    }
+    _jobCondition.notify_one();
+
+    return handoff;
+}
+
+template<class T> WorkerContextPool::Handoff<T>::~Handoff() {
+    if(_future.valid()) receive();
+    if(_data) glDeleteSync(_data->second);
+}
+
+template<class T> bool WorkerContextPool::Handoff<T>::isReady() {
+    if(!_data) {
+        if(!_future.valid() || _future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+            return false;
+        receive();
+    }
+
+    const GLenum status = glClientWaitSync(_data->second, 0, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+template<class T> T WorkerContextPool::Handoff<T>::get() {
+    CORRADE_ASSERT(_data || _future.valid(), "Platform::WorkerContextPool::Handoff::get(): the object was already retrieved", T{});
+
+    receive();
+    glWaitSync(_data->second, 0, GL_TIMEOUT_IGNORED);
+    glDeleteSync(_data->second);
+
+    T out = std::move(_data->first);
+    _data = std::nullopt;
+    return out;
+}
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and Emscripten build
+#endif
+
+#endif
@@ -0,0 +1,444 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/CommandCapture.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Version.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector4.h"
+
+#ifdef MAGNUM_TARGET_HEADLESS
+#include "Magnum/Platform/WindowlessEglApplication.h"
+#elif defined(CORRADE_TARGET_APPLE)
+#include "Magnum/Platform/WindowlessCglApplication.h"
+#elif defined(CORRADE_TARGET_UNIX)
+#include "Magnum/Platform/WindowlessGlxApplication.h"
+#elif defined(CORRADE_TARGET_WINDOWS)
+#include "Magnum/Platform/WindowlessWglApplication.h"
+#else
+#error no windowless application available on this platform
+#endif
+
+namespace Magnum {
+
+/** @page magnum-capturereplay Capture replay
+@brief Replays a GL command capture with timing
+
+@section magnum-capturereplay-usage Usage
+
+    magnum-capturereplay [--magnum-...] [-h|--help] [--size "X Y"] [--repeat N] [--per-frame] [--] input
+
+Arguments:
+
+-   `input` -- capture file created with @ref CommandCapture
+-   `-h`, `--help` -- display help message and exit
+-   `--size "X Y"` -- size of the offscreen framebuffer the capture is
+    rendered into (default: `"1920 1080"`)
+-   `--repeat N` -- replay the whole capture given count of times (default:
+    `1`)
+-   `--per-frame` -- print timing of each frame, not just the summary
+-   `--magnum-...` -- engine-specific options (see @ref Context for details)
+
+The capture is replayed on an offscreen framebuffer in a windowless context.
+Buffers and two-dimensional textures are recreated from the recorded uploads,
+with zero-filled data if the capture was done with
+@ref CommandCapture::Flag::ElidePayload. As the original shaders and vertex
+layouts are not part of the capture, draws are replayed with the recorded
+primitive, vertex count, index buffer and instance count using a trivial
+attribute-less shader, uniform uploads go to an equivalently-sized uniform
+array of that shader and shader switches alternate between two copies of it.
+The replay thus reproduces the driver-side cost of the command stream, not the
+shading cost of the original application. Buffers and textures that were
+created before the capture started are not available and commands referencing
+them are skipped.
+
+For each frame the CPU time spent submitting the commands and the total time
+until the GPU finished are measured.
+
+@section magnum-capturereplay-example Example usage
+
+    magnum-capturereplay --repeat 10 --per-frame frames.capture
+
+Replays the capture ten times, printing timing of each frame.
+
+@see @ref CommandCapture, @ref MAGNUM_BUILD_CAPTURE
+*/
+
+namespace {
+
+class ReplayShader: public AbstractShaderProgram {
+    public:
+        enum: std::size_t { UniformSize = 16 };
+
+        explicit ReplayShader();
+
+        ReplayShader& setValues(Containers::ArrayView<const Math::Vector<4, Float>> values) {
+            setUniform(_valuesUniform, values);
+            return *this;
+        }
+
+    private:
+        Int _valuesUniform;
+};
+
+ReplayShader::ReplayShader() {
+    #ifndef CORRADE_TARGET_APPLE
+    constexpr Version version = Version::GL300;
+    #else
+    constexpr Version version = Version::GL310;
+    #endif
+
+    Shader vert{version, Shader::Type::Vertex};
+    Shader frag{version, Shader::Type::Fragment};
+    vert.addSource(
+        "uniform vec4 values[16];\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    color = values[gl_VertexID % 16];\n"
+        "    gl_Position = vec4(float(gl_VertexID % 2), float(gl_VertexID/2 % 2), 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "in vec4 color;\n"
+        "out vec4 fragmentColor;\n"
+        "void main() { fragmentColor = color; }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _valuesUniform = uniformLocation("values");
+}
+
+struct ReplayMesh {
+    Mesh mesh;
+    UnsignedInt indexBuffer{};
+    UnsignedInt indexType{};
+    UnsignedLong indexOffset{};
+};
+
+struct FrameTime {
+    std::chrono::high_resolution_clock::duration submit, total;
+};
+
+class Replayer {
+    public:
+        explicit Replayer(CommandCaptureReader& reader): _reader(reader) {}
+
+        /* Replays commands until the end of a frame, returns false if
+           there's no more frames */
+        bool frame();
+
+        std::size_t commandCount() const { return _commandCount; }
+        std::size_t skippedCount() const { return _skippedCount; }
+
+    private:
+        Containers::ArrayView<const void> payloadOrZeros(std::size_t size);
+        void draw(const CommandCapture::DrawRecord& record);
+        void state(const CommandCapture::StateRecord& record);
+
+        CommandCaptureReader& _reader;
+        std::unordered_map<UnsignedInt, Buffer> _buffers;
+        std::unordered_map<UnsignedInt, Texture2D> _textures;
+        std::unordered_map<UnsignedInt, ReplayMesh> _meshes;
+        ReplayShader _shaders[2];
+        std::size_t _currentShader{};
+        std::vector<char> _zeros;
+        std::vector<Vector4> _uniformValues;
+        std::size_t _commandCount{}, _skippedCount{};
+};
+
+Containers::ArrayView<const void> Replayer::payloadOrZeros(const std::size_t size) {
+    if(_reader.payload().size() == size) return _reader.payload();
+
+    if(_zeros.size() < size) _zeros.resize(size);
+    return {_zeros.data(), size};
+}
+
+void Replayer::draw(const CommandCapture::DrawRecord& record) {
+    ReplayMesh& mesh = _meshes[record.mesh];
+
+    /* Index buffers uploaded before the capture started have no data, these
+       meshes are drawn as non-indexed. A mesh can't go back from indexed to
+       non-indexed, so it's recreated in that case. */
+    const auto indexBuffer = record.indexBuffer ? _buffers.find(record.indexBuffer) : _buffers.end();
+    if(indexBuffer != _buffers.end()) {
+        if(mesh.indexBuffer != record.indexBuffer || mesh.indexType != record.indexType || mesh.indexOffset != record.indexOffset) {
+            mesh.mesh.setIndexBuffer(indexBuffer->second, record.indexOffset, Mesh::IndexType(record.indexType));
+            mesh.indexBuffer = record.indexBuffer;
+            mesh.indexType = record.indexType;
+            mesh.indexOffset = record.indexOffset;
+        }
+    } else if(mesh.indexBuffer) mesh = ReplayMesh{};
+
+    mesh.mesh.setPrimitive(MeshPrimitive(record.primitive))
+        .setCount(record.count)
+        .setBaseVertex(record.baseVertex)
+        .setInstanceCount(record.instanceCount)
+        .draw(_shaders[_currentShader]);
+}
+
+void Replayer::state(const CommandCapture::StateRecord& record) {
+    const UnsignedInt* const a = record.arguments;
+    switch(record.function) {
+        case CommandCapture::StateFunction::Enable:
+            Renderer::enable(Renderer::Feature(a[0]));
+            return;
+        case CommandCapture::StateFunction::Disable:
+            Renderer::disable(Renderer::Feature(a[0]));
+            return;
+        case CommandCapture::StateFunction::FrontFace:
+            Renderer::setFrontFace(Renderer::FrontFace(a[0]));
+            return;
+        case CommandCapture::StateFunction::FaceCullingMode:
+            Renderer::setFaceCullingMode(Renderer::PolygonFacing(a[0]));
+            return;
+        case CommandCapture::StateFunction::DepthFunction:
+            Renderer::setDepthFunction(Renderer::DepthFunction(a[0]));
+            return;
+        case CommandCapture::StateFunction::DepthMask:
+            Renderer::setDepthMask(a[0]);
+            return;
+        case CommandCapture::StateFunction::ColorMask:
+            Renderer::setColorMask(a[0], a[1], a[2], a[3]);
+            return;
+        case CommandCapture::StateFunction::BlendEquation:
+            Renderer::setBlendEquation(Renderer::BlendEquation(a[0]), Renderer::BlendEquation(a[1]));
+            return;
+        case CommandCapture::StateFunction::BlendFunction:
+            Renderer::setBlendFunction(Renderer::BlendFunction(a[0]), Renderer::BlendFunction(a[1]), Renderer::BlendFunction(a[2]), Renderer::BlendFunction(a[3]));
+            return;
+    }
+
+    ++_skippedCount;
+}
+
+bool Replayer::frame() {
+    while(_reader.nextCommand()) {
+        ++_commandCount;
+
+        switch(_reader.command()) {
+            case CommandCapture::Command::EndFrame:
+                return true;
+
+            case CommandCapture::Command::BufferData: {
+                const auto r = _reader.record<CommandCapture::BufferDataRecord>();
+                _buffers[r.buffer].setData(payloadOrZeros(r.size), r.usage ? BufferUsage(r.usage) : BufferUsage::StaticDraw);
+            } break;
+
+            case CommandCapture::Command::BufferSubData: {
+                const auto r = _reader.record<CommandCapture::BufferSubDataRecord>();
+                auto found = _buffers.find(r.buffer);
+                if(found == _buffers.end()) {
+                    ++_skippedCount;
+                    break;
+                }
+                found->second.setSubData(r.offset, payloadOrZeros(r.size));
+            } break;
+
+            case CommandCapture::Command::TextureStorage: {
+                const auto r = _reader.record<CommandCapture::TextureStorageRecord>();
+                if(r.target != GL_TEXTURE_2D) {
+                    ++_skippedCount;
+                    break;
+                }
+
+                /* Immutable storage can't be respecified, the ID got reused
+                   for a new texture */
+                _textures.erase(r.texture);
+                _textures[r.texture].setStorage(r.levels, TextureFormat(r.format), r.size.xy());
+            } break;
+
+            case CommandCapture::Command::TextureSubImage: {
+                const auto r = _reader.record<CommandCapture::TextureSubImageRecord>();
+                auto found = _textures.find(r.texture);
+                if(found == _textures.end()) {
+                    ++_skippedCount;
+                    break;
+                }
+                found->second.setSubImage(r.level, r.offset.xy(), ImageView2D{PixelStorage{}.setAlignment(r.alignment), PixelFormat(r.format), PixelType(r.type), r.size.xy(), payloadOrZeros(r.dataSize)});
+            } break;
+
+            case CommandCapture::Command::Draw:
+                draw(_reader.record<CommandCapture::DrawRecord>());
+                break;
+
+            case CommandCapture::Command::UseProgram:
+                _currentShader = 1 - _currentShader;
+                break;
+
+            case CommandCapture::Command::Uniform: {
+                const std::size_t count = std::min<std::size_t>((_reader.payload().size() + sizeof(Vector4) - 1)/sizeof(Vector4), ReplayShader::UniformSize);
+                _uniformValues.assign(count, Vector4{});
+                std::copy_n(_reader.payload().data(), std::min(_reader.payload().size(), count*sizeof(Vector4)), reinterpret_cast<char*>(_uniformValues.data()));
+                _shaders[_currentShader].setValues({_uniformValues.data(), _uniformValues.size()});
+            } break;
+
+            case CommandCapture::Command::BindTexture: {
+                const auto r = _reader.record<CommandCapture::BindTextureRecord>();
+                auto found = _textures.find(r.texture);
+                if(found != _textures.end()) found->second.bind(r.unit);
+                else AbstractTexture::unbind(r.unit);
+            } break;
+
+            /* All rendering goes to the offscreen framebuffer */
+            case CommandCapture::Command::BindFramebuffer:
+                ++_skippedCount;
+                break;
+
+            case CommandCapture::Command::State:
+                state(_reader.record<CommandCapture::StateRecord>());
+                break;
+        }
+    }
+
+    return false;
+}
+
+}
+
+class CaptureReplay: public Platform::WindowlessApplication {
+    public:
+        explicit CaptureReplay(const Arguments& arguments);
+
+        int exec() override;
+
+    private:
+        Utility::Arguments _args;
+};
+
+CaptureReplay::CaptureReplay(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
+    _args.addArgument("input").setHelp("input", "capture file")
+        .addOption("size", "1920 1080").setHelp("size", "size of the offscreen framebuffer", "\"X Y\"")
+        .addOption("repeat", "1").setHelp("repeat", "replay the capture given count of times", "N")
+        .addBooleanOption("per-frame").setHelp("per-frame", "print timing of each frame")
+        .addSkippedPrefix("magnum", "engine-specific options")
+        .setHelp("Replays a GL command capture with timing.")
+        .parse(arguments.argc, arguments.argv);
+
+    createContext();
+}
+
+int CaptureReplay::exec() {
+    if(!Utility::Directory::fileExists(_args.value("input"))) {
+        Error() << "Cannot open file" << _args.value("input");
+        return 1;
+    }
+
+    const Containers::Array<char> data = Utility::Directory::read(_args.value("input"));
+    {
+        CommandCaptureReader reader{data};
+        if(!reader.isValid()) return 1;
+    }
+
+    const Vector2i size = _args.value<Vector2i>("size");
+    Renderbuffer color, depthStencil;
+    color.setStorage(RenderbufferFormat::RGBA8, size);
+    depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, size);
+    Framebuffer framebuffer{{{}, size}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, depthStencil)
+        .bind();
+
+    const bool perFrame = _args.isSet("per-frame");
+    const UnsignedInt repeat = _args.value<UnsignedInt>("repeat");
+    std::vector<FrameTime> times;
+    std::size_t commandCount{}, skippedCount{};
+    for(UnsignedInt i = 0; i != repeat; ++i) {
+        /* Each run starts from scratch so the uploads are replayed again */
+        CommandCaptureReader reader{data};
+        Replayer replayer{reader};
+
+        for(;;) {
+            const auto begin = std::chrono::high_resolution_clock::now();
+            if(!replayer.frame()) break;
+            const auto submitted = std::chrono::high_resolution_clock::now();
+            Renderer::finish();
+            const auto finished = std::chrono::high_resolution_clock::now();
+
+            times.push_back({submitted - begin, finished - begin});
+            if(perFrame) Debug() << "Frame" << times.size() - 1 << "submit"
+                << std::chrono::duration<Double, std::milli>(times.back().submit).count()
+                << "ms, total"
+                << std::chrono::duration<Double, std::milli>(times.back().total).count()
+                << "ms";
+        }
+
+        if(!reader.isValid()) return 1;
+
+        commandCount += replayer.commandCount();
+        skippedCount += replayer.skippedCount();
+    }
+
+    if(times.empty()) {
+        Error() << "No complete frames in" << _args.value("input");
+        return 1;
+    }
+
+    std::chrono::high_resolution_clock::duration submitSum{}, totalSum{};
+    auto submitMinMax = std::minmax_element(times.begin(), times.end(),
+        [](const FrameTime& a, const FrameTime& b) { return a.submit < b.submit; });
+    auto totalMinMax = std::minmax_element(times.begin(), times.end(),
+        [](const FrameTime& a, const FrameTime& b) { return a.total < b.total; });
+    for(const FrameTime& time: times) {
+        submitSum += time.submit;
+        totalSum += time.total;
+    }
+
+    using Milliseconds = std::chrono::duration<Double, std::milli>;
+    Debug() << "Replayed" << times.size() << "frames," << commandCount << "commands," << skippedCount << "skipped";
+    Debug() << "Submit min/avg/max:"
+        << Milliseconds(submitMinMax.first->submit).count() << "/"
+        << Milliseconds(submitSum).count()/times.size() << "/"
+        << Milliseconds(submitMinMax.second->submit).count() << "ms";
+    Debug() << "Total min/avg/max:"
+        << Milliseconds(totalMinMax.first->total).count() << "/"
+        << Milliseconds(totalSum).count()/times.size() << "/"
+        << Milliseconds(totalMinMax.second->total).count() << "ms";
+
+    return 0;
+}
+
+}
+
+MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::CaptureReplay)
@@ -23,6 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
 #ifdef CORRADE_TARGET_NACL
@@ -31,6 +37,9 @@
 
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/BufferImage.h"
+#endif
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 #include "Magnum/BufferTexture.h"
 #endif
@@ -42,16 +51,22 @@
 #include "Magnum/DebugOutput.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/MultisampleTexture.h"
 #endif
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/RectangleTexture.h"
 #endif
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/TextureArray.h"
 #include "Magnum/TransformFeedback.h"
@@ -88,15 +103,62 @@ namespace Magnum {
 
 @section magnum-info-usage Usage
 
-    magnum-info [--magnum-...] [-h|--help] [-s|--short] [--all-extensions] [--limits]
+    magnum-info [--magnum-...] [-h|--help] [-s|--short] [--all-extensions] [--limits] [--benchmark]
 
 Arguments:
 -   `-h`, `--help` -- display this help message and exit
 -   `-s`, `--short` -- display just essential info and exit
 -   `--all-extensions` -- display extensions also for fully supported versions
 -   `--limits` -- display also limits and implementation-defined values
+-   `--benchmark` -- run a short suite of driver micro-benchmarks and exit
+    (implies `--short`)
 -   `--magnum-...` -- engine-specific options (see @ref Context for details)
 
+@section magnum-info-benchmark Benchmark mode
+
+With `--benchmark` the utility measures the throughput of the data upload
+paths and the overhead of the draw paths the engine can choose from, so the
+fastest one for given driver can be picked at runtime. The suite measures:
+
+-   buffer upload using @ref Buffer::setData(), @ref Buffer::setSubData(),
+    @ref Buffer::map() with @ref Buffer::MapFlag::InvalidateBuffer and a
+    persistently mapped buffer created with @ref Buffer::setStorage(), if
+    supported
+-   texture upload directly from client memory and through a pixel buffer
+    (@ref BufferImage), if supported
+-   draw call overhead with no state changes and with four textures rebound
+    before each draw either one by one or using a single multi-bind call
+-   drawing a batch of @ref MeshView instances one by one and using
+    @ref MeshView::draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>)
+
+The results are printed as `key=value` lines, one per measurement, followed by
+`recommended.*` lines naming the fastest path for each category. Upload
+throughput is in megabytes per second, draw overhead in microseconds per draw.
+The `path.*` lines show whether the DSA and multi-bind code paths were used;
+run the benchmark again with for example
+`--magnum-disable-extensions "GL_ARB_direct_state_access GL_ARB_multi_bind"`
+to measure the fallback paths for comparison.
+
+```
+benchmark.buffer.setData=5832.17
+benchmark.buffer.setSubData=6913.4
+benchmark.buffer.mapRange=4120.55
+benchmark.buffer.persistentMap=9875.02
+benchmark.texture.direct=3318.9
+benchmark.texture.pixelBuffer=4087.31
+benchmark.draw.plain=0.781
+benchmark.draw.individualBind=2.104
+benchmark.draw.multiBind=1.322
+benchmark.draw.meshViews=0.803
+benchmark.draw.multiDraw=0.126
+path.directStateAccess=1
+path.multiBind=1
+recommended.bufferUpload=persistentMap
+recommended.textureUpload=pixelBuffer
+recommended.textureBind=multiBind
+recommended.meshViewDraw=multiDraw
+```
+
 @section magnum-info-example Example output
 
 ```
@@ -138,11 +200,80 @@ Vendor extension support:
 
 */
 
+namespace {
+
+class BenchmarkShader: public AbstractShaderProgram {
+    public:
+        explicit BenchmarkShader();
+};
+
+BenchmarkShader::BenchmarkShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    #ifndef CORRADE_TARGET_APPLE
+    constexpr Version version = Version::GL210;
+    #else
+    constexpr Version version = Version::GL310;
+    #endif
+    #else
+    constexpr Version version = Version::GLES200;
+    #endif
+
+    Shader vert{version, Shader::Type::Vertex};
+    Shader frag{version, Shader::Type::Fragment};
+    vert.addSource("void main() { gl_Position = vec4(0.0); }");
+    frag.addSource(
+        #ifndef CORRADE_TARGET_APPLE
+        "void main() { gl_FragColor = vec4(1.0); }"
+        #else
+        "out vec4 color;\n"
+        "void main() { color = vec4(1.0); }"
+        #endif
+        );
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+
+typedef std::vector<std::pair<const char*, Double>> BenchmarkResults;
+
+/* Runs the operation once to warm up, then given number of times. Returns
+   duration in seconds including the time the GPU needed to finish the work. */
+template<class F> Double measure(const Int iterations, F operation) {
+    operation(0);
+    Renderer::finish();
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for(Int i = 0; i != iterations; ++i) operation(i);
+    Renderer::finish();
+    return std::chrono::duration<Double>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+void printResults(const char* const prefix, const BenchmarkResults& results) {
+    for(const auto& result: results)
+        Debug() << prefix << Debug::nospace << result.first << Debug::nospace << "=" << Debug::nospace << result.second;
+}
+
+/* Name of the result with largest throughput or smallest duration */
+const char* fastest(const BenchmarkResults& results, const bool higherIsBetter) {
+    CORRADE_INTERNAL_ASSERT(!results.empty());
+    auto best = results.begin();
+    for(auto it = results.begin() + 1; it != results.end(); ++it)
+        if(higherIsBetter ? it->second > best->second : it->second < best->second)
+            best = it;
+    return best->first;
+}
+
+}
+
 class MagnumInfo: public Platform::WindowlessApplication {
     public:
         explicit MagnumInfo(const Arguments& arguments);
 
         int exec() override { return 0; }
+
+    private:
+        void benchmark();
 };
 
 MagnumInfo::MagnumInfo(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
@@ -151,6 +282,7 @@ MagnumInfo::MagnumInfo(const Arguments& arguments): Platform::WindowlessApplicat
         .addBooleanOption("extension-strings").setHelp("extension-strings", "list all extension strings provided by the driver (implies --short)")
         .addBooleanOption("all-extensions").setHelp("all-extensions", "display extensions also for fully supported versions")
         .addBooleanOption("limits").setHelp("limits", "display also limits and implementation-defined values")
+        .addBooleanOption("benchmark").setHelp("benchmark", "run a short suite of driver micro-benchmarks and exit (implies --short)")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Displays information about Magnum engine and OpenGL capabilities.");
 
@@ -295,6 +427,12 @@ MagnumInfo::MagnumInfo(const Arguments& arguments): Platform::WindowlessApplicat
         return;
     }
 
+    if(args.isSet("benchmark")) {
+        Debug() << "";
+        benchmark();
+        return;
+    }
+
     if(args.isSet("short")) return;
 
     Debug() << "";
@@ -729,6 +867,177 @@ MagnumInfo::MagnumInfo(const Arguments& arguments): Platform::WindowlessApplicat
     #undef _h
 }
 
+void MagnumInfo::benchmark() {
+    Context& c = Context::current();
+
+    Debug() << "device.renderer=" << Debug::nospace << c.rendererString();
+    Debug() << "device.version=" << Debug::nospace << c.versionString();
+
+    /* Buffer upload throughput in MB/s */
+    constexpr std::size_t BufferSize = 4*1024*1024;
+    constexpr Int BufferIterations = 32;
+    Containers::Array<char> data{Containers::ValueInit, BufferSize};
+    const Double bufferMegabytes = Double(BufferSize*BufferIterations)/(1024.0*1024.0);
+    BenchmarkResults bufferResults;
+
+    {
+        Buffer buffer;
+        bufferResults.emplace_back("setData", bufferMegabytes/measure(BufferIterations, [&](Int) {
+            buffer.setData(data, BufferUsage::StreamDraw);
+        }));
+    } {
+        Buffer buffer;
+        buffer.setData({nullptr, BufferSize}, BufferUsage::StreamDraw);
+        bufferResults.emplace_back("setSubData", bufferMegabytes/measure(BufferIterations, [&](Int) {
+            buffer.setSubData(0, data);
+        }));
+    }
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(c.isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(c.isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+    #endif
+    {
+        Buffer buffer;
+        buffer.setData({nullptr, BufferSize}, BufferUsage::StreamDraw);
+        bufferResults.emplace_back("mapRange", bufferMegabytes/measure(BufferIterations, [&](Int) {
+            char* const mapped = buffer.map<char>(0, BufferSize, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+            CORRADE_INTERNAL_ASSERT(mapped);
+            std::memcpy(mapped, data.data(), BufferSize);
+            CORRADE_INTERNAL_ASSERT_OUTPUT(buffer.unmap());
+        }));
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(c.isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) {
+        Buffer buffer;
+        buffer.setStorage({nullptr, BufferSize}, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+        char* const mapped = buffer.map<char>(0, BufferSize, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+        CORRADE_INTERNAL_ASSERT(mapped);
+        bufferResults.emplace_back("persistentMap", bufferMegabytes/measure(BufferIterations, [&](Int) {
+            std::memcpy(mapped, data.data(), BufferSize);
+        }));
+        CORRADE_INTERNAL_ASSERT_OUTPUT(buffer.unmap());
+    }
+    #endif
+
+    printResults("benchmark.buffer.", bufferResults);
+
+    /* Texture upload throughput in MB/s */
+    const Vector2i textureSize{512};
+    constexpr Int TextureIterations = 32;
+    Containers::Array<char> pixels{Containers::ValueInit, std::size_t(textureSize.product()*4)};
+    const Double textureMegabytes = Double(pixels.size()*TextureIterations)/(1024.0*1024.0);
+    BenchmarkResults textureResults;
+
+    {
+        Texture2D texture;
+        texture.setImage(0,
+            #ifndef MAGNUM_TARGET_GLES2
+            TextureFormat::RGBA8,
+            #else
+            TextureFormat::RGBA,
+            #endif
+            ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, textureSize, pixels});
+        textureResults.emplace_back("direct", textureMegabytes/measure(TextureIterations, [&](Int) {
+            texture.setSubImage(0, {}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, textureSize, pixels});
+        }));
+
+        #ifndef MAGNUM_TARGET_GLES2
+        BufferImage2D image{PixelFormat::RGBA, PixelType::UnsignedByte, textureSize, pixels, BufferUsage::StreamDraw};
+        textureResults.emplace_back("pixelBuffer", textureMegabytes/measure(TextureIterations, [&](Int) {
+            image.setData(PixelFormat::RGBA, PixelType::UnsignedByte, textureSize, pixels, BufferUsage::StreamDraw);
+            texture.setSubImage(0, {}, image);
+        }));
+        #endif
+    }
+
+    printResults("benchmark.texture.", textureResults);
+
+    /* Draw overhead in microseconds per draw. Everything is rendered into a
+       tiny offscreen framebuffer with a degenerate triangle to measure just
+       the CPU-side cost. */
+    constexpr Int DrawIterations = 10000;
+    constexpr Int MeshViewCount = 8;
+    BenchmarkResults drawResults;
+
+    Renderbuffer color;
+    color.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{64});
+    Framebuffer framebuffer{{{}, Vector2i{64}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+        .bind();
+
+    BenchmarkShader shader;
+    Mesh mesh;
+    mesh.setCount(3);
+
+    /* Two sets of four textures, alternated on every draw so the bindings
+       are not filtered out by the state tracker */
+    const char pixel[4]{};
+    Texture2D textures[8];
+    for(Texture2D& texture: textures) texture.setImage(0,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{1}, pixel});
+
+    drawResults.emplace_back("plain", 1.0e6*measure(DrawIterations, [&](Int) {
+        mesh.draw(shader);
+    })/DrawIterations);
+    drawResults.emplace_back("individualBind", 1.0e6*measure(DrawIterations, [&](Int i) {
+        Texture2D* const set = textures + (i % 2)*4;
+        for(Int j = 0; j != 4; ++j) set[j].bind(j);
+        mesh.draw(shader);
+    })/DrawIterations);
+    drawResults.emplace_back("multiBind", 1.0e6*measure(DrawIterations, [&](Int i) {
+        Texture2D* const set = textures + (i % 2)*4;
+        AbstractTexture::bind(0, {set, set + 1, set + 2, set + 3});
+        mesh.draw(shader);
+    })/DrawIterations);
+
+    /* Time per view, drawn one by one and in a single multi-draw call */
+    std::vector<MeshView> views;
+    views.reserve(MeshViewCount);
+    for(Int i = 0; i != MeshViewCount; ++i) {
+        views.emplace_back(mesh);
+        views.back().setCount(3);
+    }
+    drawResults.emplace_back("meshViews", 1.0e6*measure(DrawIterations/MeshViewCount, [&](Int) {
+        for(MeshView& view: views) view.draw(shader);
+    })/DrawIterations);
+    drawResults.emplace_back("multiDraw", 1.0e6*measure(DrawIterations/MeshViewCount, [&](Int) {
+        MeshView::draw(shader, {views[0], views[1], views[2], views[3],
+                                views[4], views[5], views[6], views[7]});
+    })/DrawIterations);
+
+    printResults("benchmark.draw.", drawResults);
+
+    /* Code paths the draw benchmarks went through */
+    #ifndef MAGNUM_TARGET_GLES
+    Debug() << "path.directStateAccess=" << Debug::nospace << UnsignedInt(c.isExtensionSupported<Extensions::GL::ARB::direct_state_access>());
+    Debug() << "path.multiBind=" << Debug::nospace << UnsignedInt(c.isExtensionSupported<Extensions::GL::ARB::multi_bind>());
+    #else
+    Debug() << "path.directStateAccess=0";
+    Debug() << "path.multiBind=0";
+    #endif
+
+    Debug() << "recommended.bufferUpload=" << Debug::nospace << fastest(bufferResults, true);
+    Debug() << "recommended.textureUpload=" << Debug::nospace << fastest(textureResults, true);
+    Debug() << "recommended.textureBind=" << Debug::nospace << fastest({drawResults[1], drawResults[2]}, false);
+    Debug() << "recommended.meshViewDraw=" << Debug::nospace << fastest({drawResults[3], drawResults[4]}, false);
+}
+
 }
 
 MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::MagnumInfo)
@@ -0,0 +1,156 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Octree.h"
+
+#include <algorithm>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace PointCloud {
+
+Octree::Octree(): _pointCount{} {}
+
+bool Octree::open(const std::string& filename) {
+    close();
+
+    _file.open(filename, std::ios::binary);
+    if(!_file) {
+        Error() << "PointCloud::Octree::open(): can't open file" << filename;
+        _file.close();
+        return false;
+    }
+
+    if(!parse()) {
+        _file.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool Octree::parse() {
+    std::ifstream& file = _file;
+    file.seekg(0, std::ios::end);
+    const UnsignedLong fileSize = UnsignedLong(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    OctreeHeader header;
+    if(fileSize < sizeof(OctreeHeader) || !file.read(reinterpret_cast<char*>(&header), sizeof(OctreeHeader))) {
+        Error() << "PointCloud::Octree::open(): the file is too short:" << fileSize << "bytes";
+        return false;
+    }
+
+    if(!std::equal(header.identifier, header.identifier + sizeof(OctreeIdentifier), OctreeIdentifier)) {
+        Error() << "PointCloud::Octree::open(): invalid file identifier";
+        return false;
+    }
+
+    if(header.endianness != 0x04030201) {
+        Error() << "PointCloud::Octree::open(): files with different endianness are not supported";
+        return false;
+    }
+
+    if(!header.version || header.version > OctreeVersion) {
+        Error() << "PointCloud::Octree::open(): unsupported version" << header.version << Debug::nospace << ", expected" << OctreeVersion << "or older";
+        return false;
+    }
+
+    if(!header.nodeCount || fileSize < sizeof(OctreeHeader) + UnsignedLong(header.nodeCount)*sizeof(OctreeNode)) {
+        Error() << "PointCloud::Octree::open(): the file is too short for" << header.nodeCount << "nodes";
+        return false;
+    }
+
+    Containers::Array<OctreeNode> nodes(header.nodeCount);
+    if(!file.read(reinterpret_cast<char*>(nodes.data()), header.nodeCount*sizeof(OctreeNode))) {
+        Error() << "PointCloud::Octree::open(): can't read the nodes";
+        return false;
+    }
+
+    /* Check that the hierarchy is a tree in breadth-first order and all point
+       data are inside the file */
+    UnsignedLong pointCount = 0;
+    for(std::size_t i = 0; i != nodes.size(); ++i) {
+        const OctreeNode& node = nodes[i];
+        if(node.childCount > 8 || (node.childCount && (node.firstChild <= i || UnsignedLong(node.firstChild) + node.childCount > header.nodeCount))) {
+            Error() << "PointCloud::Octree::open(): invalid children of node" << i;
+            return false;
+        }
+
+        if(node.pointOffset > fileSize || (fileSize - node.pointOffset)/sizeof(Point) < node.pointCount) {
+            Error() << "PointCloud::Octree::open(): point data of node" << i << "are out of file bounds";
+            return false;
+        }
+
+        pointCount += node.pointCount;
+    }
+
+    if(pointCount != header.pointCount) {
+        Error() << "PointCloud::Octree::open(): expected" << header.pointCount << "points but nodes contain" << pointCount;
+        return false;
+    }
+
+    _pointCount = header.pointCount;
+    _nodes = std::move(nodes);
+    return true;
+}
+
+void Octree::close() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _file.close();
+    _pointCount = 0;
+    _nodes = nullptr;
+}
+
+UnsignedLong Octree::pointCount() const {
+    CORRADE_ASSERT(isOpened(), "PointCloud::Octree::pointCount(): no file opened", {});
+    return _pointCount;
+}
+
+Containers::ArrayView<const OctreeNode> Octree::nodes() const {
+    CORRADE_ASSERT(isOpened(), "PointCloud::Octree::nodes(): no file opened", nullptr);
+    return {_nodes.data(), _nodes.size()};
+}
+
+Containers::Array<Point> Octree::points(const UnsignedInt node) {
+    CORRADE_ASSERT(isOpened(), "PointCloud::Octree::points(): no file opened", nullptr);
+    CORRADE_ASSERT(node < _nodes.size(),
+        "PointCloud::Octree::points(): index" << node << "out of range for" << _nodes.size() << "nodes", nullptr);
+
+    Containers::Array<Point> points(_nodes[node].pointCount);
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    _file.seekg(_nodes[node].pointOffset);
+    if(!_file.read(reinterpret_cast<char*>(points.data()), points.size()*sizeof(Point))) {
+        Error() << "PointCloud::Octree::points(): can't read data of node" << node;
+        _file.clear();
+        return nullptr;
+    }
+
+    return points;
+}
+
+}}
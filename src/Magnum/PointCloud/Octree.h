@@ -0,0 +1,134 @@
+#ifndef Magnum_PointCloud_Octree_h
+#define Magnum_PointCloud_Octree_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::PointCloud::Octree
+ */
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PointCloud/OctreeFormat.h"
+#include "Magnum/PointCloud/visibility.h"
+
+namespace Magnum { namespace PointCloud {
+
+/**
+@brief Octree file
+
+Reads octree files produced by @ref OctreeBuilder. Only the header and the
+node hierarchy are loaded into memory in @ref open(), point data of
+particular nodes are read on demand using @ref points(), which makes it
+possible to work with files much larger than the available memory:
+@code
+PointCloud::Octree octree;
+if(!octree.open("scan.octree")) return;
+
+for(const PointCloud::OctreeNode& node: octree.nodes()) {
+    // ...
+}
+
+Containers::Array<PointCloud::Point> root = octree.points(0);
+@endcode
+
+@see @ref OctreeRenderer
+*/
+class MAGNUM_POINTCLOUD_EXPORT Octree {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty instance, use @ref open() to open a file.
+         */
+        explicit Octree();
+
+        /** @brief Copying is not allowed */
+        Octree(const Octree&) = delete;
+
+        /** @brief Moving is not allowed */
+        Octree(Octree&&) = delete;
+
+        /** @brief Copying is not allowed */
+        Octree& operator=(const Octree&) = delete;
+
+        /** @brief Moving is not allowed */
+        Octree& operator=(Octree&&) = delete;
+
+        /**
+         * @brief Open a file
+         *
+         * Closes previous file, if any, reads the header and the node
+         * hierarchy and validates them. Prints message to error output and
+         * returns `false` if the file can't be read or is invalid.
+         */
+        bool open(const std::string& filename);
+
+        /** @brief Whether any file is opened */
+        bool isOpened() const { return _file.is_open(); }
+
+        /** @brief Close the file */
+        void close();
+
+        /**
+         * @brief Total point count
+         *
+         * Expects that a file is opened.
+         */
+        UnsignedLong pointCount() const;
+
+        /**
+         * @brief Nodes
+         *
+         * The first node is root, see @ref OctreeNode for details about the
+         * hierarchy. Expects that a file is opened.
+         */
+        Containers::ArrayView<const OctreeNode> nodes() const;
+
+        /**
+         * @brief Read points of given node
+         *
+         * Expects that a file is opened and @p node is less than size of
+         * @ref nodes(). Prints message to error output and returns empty
+         * array if the data can't be read. Can be called from multiple
+         * threads at once, the reads are serialized.
+         */
+        Containers::Array<Point> points(UnsignedInt node);
+
+    private:
+        bool MAGNUM_POINTCLOUD_LOCAL parse();
+
+        std::ifstream _file;
+        std::mutex _mutex;
+        UnsignedLong _pointCount;
+        Containers::Array<OctreeNode> _nodes;
+};
+
+}}
+
+#endif
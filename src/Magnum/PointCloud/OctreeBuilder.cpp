@@ -0,0 +1,410 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OctreeBuilder.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace PointCloud {
+
+namespace {
+
+/* Count of points buffered in memory for each bucket before they're appended
+   to its temporary file */
+constexpr std::size_t BucketBufferSize = 16384;
+
+/* Nodes deeper than this aren't subdivided anymore, which limits the
+   recursion for many points at the same position */
+constexpr UnsignedInt MaxDepth = 24;
+
+struct BuildNode {
+    Vector3 min;
+    Float size;
+    std::vector<UnsignedInt> children;
+
+    /* Index of the bucket in whose chunk file the points are or -1 if they
+       are in the points array */
+    Int bucket;
+    UnsignedLong pointOffset;
+    UnsignedInt pointCount;
+    std::vector<Point> points;
+};
+
+struct BucketResult {
+    /* Subtree of the bucket, the first node is the bucket itself */
+    std::vector<BuildNode> nodes;
+    /* Points for the nodes above the bucket, from the root down */
+    std::vector<std::vector<Point>> ancestorPoints;
+    UnsignedLong chunkSize;
+    bool success;
+};
+
+BuildNode buildNode(const Vector3& min, const Float size) {
+    return BuildNode{min, size, {}, -1, 0, 0, {}};
+}
+
+Vector3ui cellCoordinates(const Vector3& position, const Vector3& min, const Float size, const UnsignedInt count) {
+    return Vector3ui{Math::clamp((position - min)*(Float(count)/size), 0.0f, Float(count - 1))};
+}
+
+/* Moves at most one point from each cell of a grid with given size to the
+   front of the range, returns their count */
+std::size_t subsample(Point* const begin, Point* const end, const Vector3& min, const Float size, const UnsignedInt gridSize) {
+    std::unordered_set<UnsignedLong> cells;
+    Point* selected = begin;
+    for(Point* it = begin; it != end; ++it) {
+        const Vector3ui cell = cellCoordinates(it->position, min, size, gridSize);
+        if(!cells.insert(cell.x() + (UnsignedLong(cell.y()) << 20) + (UnsignedLong(cell.z()) << 40)).second)
+            continue;
+
+        std::swap(*selected++, *it);
+    }
+
+    return selected - begin;
+}
+
+/* Partitions the range into octants around given center, octant i is between
+   i-th and (i + 1)-th returned pointer. Bit 0 of the octant index is set for
+   points with X coordinate not less than the center, bit 1 for Y and bit 2
+   for Z. */
+std::array<Point*, 9> partition(Point* const begin, Point* const end, const Vector3& center) {
+    std::array<Point*, 9> octants;
+    octants[0] = begin;
+    octants[8] = end;
+    octants[4] = std::partition(begin, end, [&center](const Point& p) {
+        return p.position.z() < center.z();
+    });
+    for(std::size_t i: {0, 4}) octants[i + 2] = std::partition(octants[i], octants[i + 4], [&center](const Point& p) {
+        return p.position.y() < center.y();
+    });
+    for(std::size_t i: {0, 2, 4, 6}) octants[i + 1] = std::partition(octants[i], octants[i + 2], [&center](const Point& p) {
+        return p.position.x() < center.x();
+    });
+    return octants;
+}
+
+/* The point offset is temporarily an index into the data array */
+void buildSubtree(std::vector<BuildNode>& nodes, const UnsignedInt id, Point* const data, Point* const begin, Point* const end, const UnsignedInt gridSize, const UnsignedInt leafPointCount, const UnsignedInt depth) {
+    /* Copied, as the vector gets reallocated below */
+    const Vector3 min = nodes[id].min;
+    const Float size = nodes[id].size;
+
+    std::size_t count = end - begin;
+    if(count > leafPointCount && depth < MaxDepth)
+        count = subsample(begin, end, min, size, gridSize);
+    nodes[id].pointOffset = begin - data;
+    nodes[id].pointCount = count;
+    if(begin + count == end) return;
+
+    const Float half = size*0.5f;
+    const std::array<Point*, 9> octants = partition(begin + count, end, min + Vector3{half});
+    for(UnsignedInt i = 0; i != 8; ++i) {
+        if(octants[i] == octants[i + 1]) continue;
+
+        const UnsignedInt child = nodes.size();
+        nodes[id].children.push_back(child);
+        nodes.push_back(buildNode(min + Vector3{Float(i & 1), Float((i >> 1) & 1), Float(i >> 2)}*half, half));
+        buildSubtree(nodes, child, data, octants[i], octants[i + 1], gridSize, leafPointCount, depth + 1);
+    }
+}
+
+}
+
+OctreeBuilder::OctreeBuilder(const Range3D& bounds, const std::string& temporaryDirectory, const UnsignedInt bucketLevel): _min{bounds.min()}, _size{bounds.size().max()}, _temporaryDirectory{temporaryDirectory}, _bucketLevel{bucketLevel}, _gridSize{128}, _leafPointCount{16384}, _pointCount{}, _ignoredPointCount{} {
+    CORRADE_ASSERT(_size > 0.0f,
+        "PointCloud::OctreeBuilder::OctreeBuilder(): the bounds are empty", );
+    CORRADE_ASSERT(bucketLevel <= 6,
+        "PointCloud::OctreeBuilder::OctreeBuilder(): expected bucket level at most 6 but got" << bucketLevel, );
+
+    _buckets.resize(std::size_t{1} << 3*bucketLevel);
+}
+
+OctreeBuilder::~OctreeBuilder() { reset(); }
+
+Range3D OctreeBuilder::bounds() const {
+    return Range3D::fromSize(_min, Vector3{_size});
+}
+
+OctreeBuilder& OctreeBuilder::setGridSize(const UnsignedInt size) {
+    CORRADE_ASSERT(size && size <= 65536,
+        "PointCloud::OctreeBuilder::setGridSize(): expected size between 1 and 65536 but got" << size, *this);
+    _gridSize = size;
+    return *this;
+}
+
+std::string OctreeBuilder::bucketFilename(const std::size_t bucket) const {
+    return Utility::Directory::join(_temporaryDirectory, "bucket" + std::to_string(bucket) + ".tmp");
+}
+
+std::string OctreeBuilder::chunkFilename(const std::size_t bucket) const {
+    return Utility::Directory::join(_temporaryDirectory, "chunk" + std::to_string(bucket) + ".tmp");
+}
+
+bool OctreeBuilder::add(const Containers::ArrayView<const Point> points) {
+    const Vector3 max = _min + Vector3{_size};
+    const UnsignedInt bucketCount = 1 << _bucketLevel;
+
+    for(const Point& point: points) {
+        /* Written this way to also ignore NaNs */
+        if(!(point.position >= _min).all() || !(point.position <= max).all()) {
+            ++_ignoredPointCount;
+            continue;
+        }
+
+        const Vector3ui coordinates = cellCoordinates(point.position, _min, _size, bucketCount);
+        const std::size_t bucket = coordinates.x() + (std::size_t(coordinates.y()) << _bucketLevel) + (std::size_t(coordinates.z()) << 2*_bucketLevel);
+        _buckets[bucket].points.push_back(point);
+        ++_pointCount;
+
+        if(_buckets[bucket].points.size() >= BucketBufferSize && !flush(bucket))
+            return false;
+    }
+
+    return true;
+}
+
+bool OctreeBuilder::flush(const std::size_t bucket) {
+    Bucket& b = _buckets[bucket];
+    std::ofstream out{bucketFilename(bucket), std::ios::binary|std::ios::app};
+    if(!out.write(reinterpret_cast<const char*>(b.points.data()), b.points.size()*sizeof(Point))) {
+        Error() << "PointCloud::OctreeBuilder::add(): can't write" << bucketFilename(bucket);
+        return false;
+    }
+
+    b.writtenCount += b.points.size();
+    b.points.clear();
+    return true;
+}
+
+void OctreeBuilder::reset() {
+    for(std::size_t i = 0; i != _buckets.size(); ++i) {
+        if(_buckets[i].writtenCount) Utility::Directory::rm(bucketFilename(i));
+        _buckets[i] = Bucket{};
+    }
+
+    _pointCount = _ignoredPointCount = 0;
+}
+
+bool OctreeBuilder::build(const std::string& filename) {
+    return build(filename, TaskScheduler::global());
+}
+
+bool OctreeBuilder::build(const std::string& filename, TaskScheduler& scheduler) {
+    const UnsignedInt mask = (1 << _bucketLevel) - 1;
+
+    std::vector<std::size_t> used;
+    for(std::size_t i = 0; i != _buckets.size(); ++i)
+        if(_buckets[i].writtenCount || !_buckets[i].points.empty()) used.push_back(i);
+
+    /* Build the subtree of each bucket and write its points into a chunk
+       file */
+    std::vector<BucketResult> results(used.size());
+    scheduler.parallelFor(used.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const std::size_t b = used[i];
+            Bucket& bucket = _buckets[b];
+            BucketResult& result = results[i];
+
+            /* Points written to the temporary file followed by the buffered
+               ones */
+            std::vector<Point> points(bucket.writtenCount + bucket.points.size());
+            if(bucket.writtenCount) {
+                std::ifstream in{bucketFilename(b), std::ios::binary};
+                if(!in.read(reinterpret_cast<char*>(points.data()), bucket.writtenCount*sizeof(Point))) {
+                    Error() << "PointCloud::OctreeBuilder::build(): can't read" << bucketFilename(b);
+                    continue;
+                }
+            }
+            std::copy(bucket.points.begin(), bucket.points.end(), points.begin() + bucket.writtenCount);
+            std::vector<Point>{}.swap(bucket.points);
+
+            /* Take the subsamples for the nodes above the bucket. Each grid
+               cell is fully inside a single bucket unless the grid is too
+               coarse, so these can be taken independently of other
+               buckets. */
+            const Vector3ui coordinates{UnsignedInt(b) & mask, UnsignedInt(b >> _bucketLevel) & mask, UnsignedInt(b >> 2*_bucketLevel)};
+            Point* first = points.data();
+            Point* const last = points.data() + points.size();
+            result.ancestorPoints.resize(_bucketLevel);
+            for(UnsignedInt level = 0; level != _bucketLevel; ++level) {
+                const Float size = _size/Float(1 << level);
+                const Vector3 min = _min + Vector3{coordinates >> (_bucketLevel - level)}*size;
+                const std::size_t count = subsample(first, last, min, size, _gridSize);
+                result.ancestorPoints[level].assign(first, first + count);
+                first += count;
+            }
+
+            const Float size = _size/Float(1 << _bucketLevel);
+            result.nodes.push_back(buildNode(_min + Vector3{coordinates}*size, size));
+            buildSubtree(result.nodes, 0, points.data(), first, last, _gridSize, _leafPointCount, _bucketLevel);
+
+            std::ofstream out{chunkFilename(b), std::ios::binary};
+            UnsignedLong offset = 0;
+            for(BuildNode& node: result.nodes) {
+                out.write(reinterpret_cast<const char*>(points.data() + node.pointOffset), node.pointCount*sizeof(Point));
+                node.pointOffset = offset;
+                offset += node.pointCount*sizeof(Point);
+            }
+
+            if(!out) {
+                Error() << "PointCloud::OctreeBuilder::build(): can't write" << chunkFilename(b);
+                continue;
+            }
+
+            result.chunkSize = offset;
+            result.success = true;
+        }
+    });
+
+    const auto cleanup = [&]() {
+        for(const std::size_t b: used) Utility::Directory::rm(chunkFilename(b));
+        reset();
+    };
+
+    for(const BucketResult& result: results) if(!result.success) {
+        cleanup();
+        return false;
+    }
+
+    /* Create the nodes above the buckets and attach the bucket subtrees to
+       them */
+    std::vector<BuildNode> nodes;
+    std::vector<std::unordered_map<UnsignedInt, UnsignedInt>> ancestors(_bucketLevel);
+    for(std::size_t i = 0; i != used.size(); ++i) {
+        const std::size_t b = used[i];
+        BucketResult& result = results[i];
+        const Vector3ui coordinates{UnsignedInt(b) & mask, UnsignedInt(b >> _bucketLevel) & mask, UnsignedInt(b >> 2*_bucketLevel)};
+
+        UnsignedInt parent = 0;
+        for(UnsignedInt level = 0; level != _bucketLevel; ++level) {
+            const Vector3ui cell = coordinates >> (_bucketLevel - level);
+            const UnsignedInt key = cell.x() + (cell.y() << level) + (cell.z() << 2*level);
+
+            UnsignedInt id;
+            auto found = ancestors[level].find(key);
+            if(found == ancestors[level].end()) {
+                id = nodes.size();
+                const Float size = _size/Float(1 << level);
+                nodes.push_back(buildNode(_min + Vector3{cell}*size, size));
+                ancestors[level].emplace(key, id);
+                if(level) nodes[parent].children.push_back(id);
+            } else id = found->second;
+
+            nodes[id].points.insert(nodes[id].points.end(), result.ancestorPoints[level].begin(), result.ancestorPoints[level].end());
+            parent = id;
+        }
+
+        /* All points of the bucket went to the nodes above */
+        if(result.nodes.size() == 1 && !result.nodes[0].pointCount) continue;
+
+        const UnsignedInt offset = nodes.size();
+        if(_bucketLevel) nodes[parent].children.push_back(offset);
+        for(BuildNode& node: result.nodes) {
+            for(UnsignedInt& child: node.children) child += offset;
+            node.bucket = Int(i);
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    /* Empty point cloud */
+    if(nodes.empty()) nodes.push_back(buildNode(_min, _size));
+
+    /* Order the nodes breadth-first, so children of each node are
+       contiguous */
+    std::vector<OctreeNode> output(nodes.size());
+    std::vector<UnsignedInt> order{0};
+    for(std::size_t i = 0; i != order.size(); ++i) {
+        const BuildNode& node = nodes[order[i]];
+        output[i].min = node.min;
+        output[i].size = node.size;
+        output[i].spacing = node.size/Float(_gridSize);
+        output[i].firstChild = node.children.empty() ? 0 : UnsignedInt(order.size());
+        output[i].childCount = node.children.size();
+        order.insert(order.end(), node.children.begin(), node.children.end());
+    }
+
+    /* Points of the nodes above the buckets go first, then the chunk files
+       in bucket order */
+    UnsignedLong offset = sizeof(OctreeHeader) + output.size()*sizeof(OctreeNode);
+    for(std::size_t i = 0; i != output.size(); ++i) {
+        const BuildNode& node = nodes[order[i]];
+        if(node.bucket != -1) continue;
+        output[i].pointCount = node.points.size();
+        output[i].pointOffset = offset;
+        offset += node.points.size()*sizeof(Point);
+    }
+    std::vector<UnsignedLong> chunkOffsets(results.size());
+    for(std::size_t i = 0; i != results.size(); ++i) {
+        chunkOffsets[i] = offset;
+        offset += results[i].chunkSize;
+    }
+    for(std::size_t i = 0; i != output.size(); ++i) {
+        const BuildNode& node = nodes[order[i]];
+        if(node.bucket == -1) continue;
+        output[i].pointCount = node.pointCount;
+        output[i].pointOffset = chunkOffsets[node.bucket] + node.pointOffset;
+    }
+
+    OctreeHeader header{};
+    std::copy(OctreeIdentifier, OctreeIdentifier + sizeof(OctreeIdentifier), header.identifier);
+    header.version = OctreeVersion;
+    header.endianness = 0x04030201;
+    header.nodeCount = output.size();
+    header.pointCount = _pointCount;
+
+    std::ofstream out{filename, std::ios::binary};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(OctreeHeader));
+    out.write(reinterpret_cast<const char*>(output.data()), output.size()*sizeof(OctreeNode));
+    for(std::size_t i = 0; i != output.size(); ++i) {
+        const BuildNode& node = nodes[order[i]];
+        if(node.bucket == -1) out.write(reinterpret_cast<const char*>(node.points.data()), node.points.size()*sizeof(Point));
+    }
+    for(std::size_t i = 0; i != used.size() && out; ++i) {
+        if(!results[i].chunkSize) continue;
+        std::ifstream in{chunkFilename(used[i]), std::ios::binary};
+        out << in.rdbuf();
+    }
+
+    if(!out) {
+        Error() << "PointCloud::OctreeBuilder::build(): can't write" << filename;
+        cleanup();
+        return false;
+    }
+
+    cleanup();
+    return true;
+}
+
+}}
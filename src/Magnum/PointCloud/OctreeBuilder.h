@@ -0,0 +1,213 @@
+#ifndef Magnum_PointCloud_OctreeBuilder_h
+#define Magnum_PointCloud_OctreeBuilder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::PointCloud::OctreeBuilder
+ */
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/PointCloud/OctreeFormat.h"
+#include "Magnum/PointCloud/visibility.h"
+
+namespace Magnum {
+
+class TaskScheduler;
+
+namespace PointCloud {
+
+/**
+@brief Octree builder
+
+Builds an octree file for @ref Octree and @ref OctreeRenderer out of an
+arbitrarily large point cloud:
+@code
+PointCloud::OctreeBuilder builder{scanBounds, "/tmp"};
+while(reader.hasMore()) {
+    std::vector<PointCloud::Point> points = reader.read(1000000);
+    builder.add({points.data(), points.size()});
+}
+
+builder.build("scan.octree");
+@endcode
+
+## Out-of-core construction
+
+The bounds passed to the constructor are extended to a cube, which becomes the
+root node. The cube is split into a regular grid of @f$ 8^l @f$ buckets,
+where @f$ l @f$ is the bucket level passed to the constructor, and
+@ref add() partitions the points into the buckets, appending them to
+temporary files once the in-memory buffer of a bucket gets large enough. Only
+a single bucket at a time needs to fit into memory for each thread used by
+@ref build(), so the bucket level should be chosen according to point count
+and available memory.
+
+@ref build() then processes the buckets in parallel on the
+@ref TaskScheduler. A node keeps at most one point in each cell of a grid with
+@ref gridSize() cells along each side, the rest of the points is distributed
+to its children. Nodes with at most @ref leafPointCount() points keep all of
+them. Nodes above the bucket level are filled from each bucket independently,
+subtrees of the buckets are built entirely in memory and written to temporary
+chunk files, which are then concatenated into the output file. See
+@ref OctreeNode for details about the resulting hierarchy.
+*/
+class MAGNUM_POINTCLOUD_EXPORT OctreeBuilder {
+    public:
+        /**
+         * @brief Constructor
+         * @param bounds                Bounds of the point cloud
+         * @param temporaryDirectory    Directory for temporary files
+         * @param bucketLevel           Octree level at which the points are
+         *      partitioned into temporary files
+         *
+         * Expects that @p bounds are not empty and @p bucketLevel is at most
+         * `6`.
+         */
+        explicit OctreeBuilder(const Range3D& bounds, const std::string& temporaryDirectory, UnsignedInt bucketLevel = 3);
+
+        /** @brief Copying is not allowed */
+        OctreeBuilder(const OctreeBuilder&) = delete;
+
+        /** @brief Moving is not allowed */
+        OctreeBuilder(OctreeBuilder&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the temporary files, if any.
+         */
+        ~OctreeBuilder();
+
+        /** @brief Copying is not allowed */
+        OctreeBuilder& operator=(const OctreeBuilder&) = delete;
+
+        /** @brief Moving is not allowed */
+        OctreeBuilder& operator=(OctreeBuilder&&) = delete;
+
+        /**
+         * @brief Bounds of the root node
+         *
+         * Cube containing the bounds passed to the constructor.
+         */
+        Range3D bounds() const;
+
+        /** @brief Bucket level */
+        UnsignedInt bucketLevel() const { return _bucketLevel; }
+
+        /** @brief Subsampling grid size */
+        UnsignedInt gridSize() const { return _gridSize; }
+
+        /**
+         * @brief Set subsampling grid size
+         * @return Reference to self (for method chaining)
+         *
+         * Each node keeps at most one point in each cell of a grid with
+         * @p size cells along each side, the spacing of points in a node is
+         * thus its size divided by @p size. Expects that @p size is between
+         * `1` and `65536`. Default is `128`.
+         */
+        OctreeBuilder& setGridSize(UnsignedInt size);
+
+        /** @brief Leaf point count */
+        UnsignedInt leafPointCount() const { return _leafPointCount; }
+
+        /**
+         * @brief Set leaf point count
+         * @return Reference to self (for method chaining)
+         *
+         * Nodes with at most @p count points are not subdivided further.
+         * Default is `16384`.
+         */
+        OctreeBuilder& setLeafPointCount(UnsignedInt count) {
+            _leafPointCount = count;
+            return *this;
+        }
+
+        /** @brief Count of added points */
+        UnsignedLong pointCount() const { return _pointCount; }
+
+        /**
+         * @brief Count of ignored points
+         *
+         * Points outside of @ref bounds() passed to @ref add().
+         */
+        UnsignedLong ignoredPointCount() const { return _ignoredPointCount; }
+
+        /**
+         * @brief Add points
+         *
+         * Points outside of @ref bounds() are ignored. Prints message to
+         * error output and returns `false` if a temporary file can't be
+         * written.
+         */
+        bool add(Containers::ArrayView<const Point> points);
+
+        /**
+         * @brief Build the octree
+         * @param filename      Output file
+         * @param scheduler     Scheduler for processing the buckets
+         *
+         * Writes the octree into @p filename, removes all temporary files
+         * and resets the builder to empty state. Prints message to error
+         * output and returns `false` if a file can't be read or written.
+         */
+        bool build(const std::string& filename, TaskScheduler& scheduler);
+
+        /**
+         * @brief Build the octree using global scheduler
+         *
+         * Same as calling @ref build(const std::string&, TaskScheduler&)
+         * with @ref TaskScheduler::global().
+         */
+        bool build(const std::string& filename);
+
+    private:
+        struct Bucket {
+            std::vector<Point> points;
+            UnsignedLong writtenCount;
+        };
+
+        std::string MAGNUM_POINTCLOUD_LOCAL bucketFilename(std::size_t bucket) const;
+        std::string MAGNUM_POINTCLOUD_LOCAL chunkFilename(std::size_t bucket) const;
+        bool MAGNUM_POINTCLOUD_LOCAL flush(std::size_t bucket);
+        void MAGNUM_POINTCLOUD_LOCAL reset();
+
+        Vector3 _min;
+        Float _size;
+        std::string _temporaryDirectory;
+        UnsignedInt _bucketLevel, _gridSize, _leafPointCount;
+        UnsignedLong _pointCount, _ignoredPointCount;
+        std::vector<Bucket> _buckets;
+};
+
+}}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef Magnum_PointCloud_OctreeFormat_h
+#define Magnum_PointCloud_OctreeFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::PointCloud::Point, @ref Magnum::PointCloud::OctreeHeader, @ref Magnum::PointCloud::OctreeNode
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace PointCloud {
+
+/**
+@brief Point
+
+Layout of a single point both in the octree file and in the vertex buffer
+used by @ref OctreeRenderer.
+@see @ref OctreeBuilder::add()
+*/
+struct Point {
+    Vector3 position;   /**< @brief Position */
+    Color4ub color;     /**< @brief Color */
+};
+
+/**
+@brief Octree file header
+
+The header is followed by @ref OctreeHeader::nodeCount @ref OctreeNode
+entries, the first of them being the root node. Point data of each node are
+stored as a contiguous run of @ref Point items at
+@ref OctreeNode::pointOffset. Files with different endianness than the
+platform aren't supported.
+@see @ref OctreeBuilder, @ref Octree
+*/
+/** @todoc Enable @c INLINE_SIMPLE_STRUCTS again when unclosed &lt;component&gt; in tagfile is fixed*/
+struct OctreeHeader {
+    char            identifier[8];      /**< @brief File identifier */
+    UnsignedInt     version;            /**< @brief Format version */
+    UnsignedInt     endianness;         /**< @brief `0x04030201` in file endianness */
+    UnsignedInt     nodeCount;          /**< @brief Count of node entries following the header */
+    UnsignedInt     reserved;           /**< @brief Reserved, zero */
+    UnsignedLong    pointCount;         /**< @brief Total point count in all nodes */
+};
+
+/**
+@brief Octree file node entry
+
+Nodes are stored in breadth-first order, so children of each node are
+contiguous and always have larger index than their parent. The octree is
+additive --- each point is stored in exactly one node and a node at given
+level contains a subsample of the points with roughly
+@ref OctreeNode::spacing distance between them, which is half of the parent
+spacing. Rendering a node together with all its ancestors gives the point
+density of its level.
+*/
+struct OctreeNode {
+    Vector3         min;                /**< @brief Minimal corner of the node cube */
+    Float           size;               /**< @brief Edge length of the node cube */
+    Float           spacing;            /**< @brief Distance between subsampled points */
+    UnsignedInt     firstChild;         /**< @brief Index of first child node, zero for leaf nodes */
+    UnsignedInt     childCount;         /**< @brief Child node count, zero for leaf nodes */
+    UnsignedInt     pointCount;         /**< @brief Count of points in this node */
+    UnsignedLong    pointOffset;        /**< @brief Offset of point data from file start */
+};
+
+/** @brief Octree file identifier */
+constexpr char OctreeIdentifier[8]{'\x89', 'M', 'G', 'N', 'P', 'C', 'O', '\n'};
+
+/** @brief Current octree file format version */
+constexpr UnsignedInt OctreeVersion = 1;
+
+static_assert(sizeof(Point) == 16, "Point size is not 16 bytes");
+static_assert(sizeof(OctreeHeader) == 32, "OctreeHeader size is not 32 bytes");
+static_assert(sizeof(OctreeNode) == 40, "OctreeNode size is not 40 bytes");
+
+}}
+
+#endif
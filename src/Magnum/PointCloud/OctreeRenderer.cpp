@@ -0,0 +1,214 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OctreeRenderer.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/PointCloud/Octree.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+
+namespace Magnum { namespace PointCloud {
+
+OctreeRenderer::OctreeRenderer(Octree& octree, const GLsizeiptr capacity, TaskScheduler& scheduler): _octree(octree), _scheduler(scheduler), _pool{capacity, 0}, _commandBuffer{Buffer::TargetHint::DrawIndirect}, _maxScreenSpaceError{2.0f}, _readBudget{4}, _uploadBudget{16*1024*1024}, _frame{}, _residentNodeCount{} {
+    CORRADE_ASSERT(octree.isOpened(),
+        "PointCloud::OctreeRenderer::OctreeRenderer(): the octree is not opened", );
+
+    _nodes.resize(octree.nodes().size());
+    _mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(_pool.vertexBuffer(), 0,
+            Position{},
+            Color{Color::DataType::UnsignedByte, Color::DataOption::Normalized});
+}
+
+OctreeRenderer::OctreeRenderer(Octree& octree, const GLsizeiptr capacity): OctreeRenderer{octree, capacity, TaskScheduler::global()} {}
+
+OctreeRenderer::~OctreeRenderer() {
+    /* The tasks write into the nodes */
+    for(const UnsignedInt id: _reading) _scheduler.wait(_nodes[id].task);
+}
+
+UnsignedLong OctreeRenderer::drawPointCount() const {
+    UnsignedLong count = 0;
+    for(const UnsignedInt id: _draw) count += _nodes[id].allocation.vertexSize/sizeof(Point);
+    return count;
+}
+
+void OctreeRenderer::update(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
+    ++_frame;
+
+    /* Collect finished reads */
+    for(std::size_t i = 0; i < _reading.size(); ) {
+        Node& node = _nodes[_reading[i]];
+        if(!_scheduler.isFinished(node.task)) {
+            ++i;
+            continue;
+        }
+
+        node.status = Status::Read;
+        _read.push_back(_reading[i]);
+        _reading[i] = _reading.back();
+        _reading.pop_back();
+    }
+
+    /* The frustum planes and node bounds are in octree space */
+    const Containers::ArrayView<const OctreeNode> nodes = _octree.nodes();
+    const Matrix4 projectionMatrix = camera.projectionMatrix();
+    const auto planes = SceneGraph::Implementation::frustumPlanes<3, Float>(projectionMatrix*transformationMatrix);
+    const Vector4 w = projectionMatrix.row(3);
+    const Float scaling = transformationMatrix.uniformScaling();
+    const Float pixelsPerUnit = projectionMatrix[1][1]*camera.viewport().y()*0.5f;
+
+    /* Select the nodes, requesting the missing ones */
+    _draw.clear();
+    _requests.clear();
+    _stack.assign(1, 0);
+    while(!_stack.empty()) {
+        const UnsignedInt id = _stack.back();
+        _stack.pop_back();
+
+        const OctreeNode& octreeNode = nodes[id];
+        const Vector3 center = octreeNode.min + Vector3{octreeNode.size*0.5f};
+        const Float radius = octreeNode.size*Constants::sqrt3()*0.5f;
+        if(!SceneGraph::Implementation::sphereInFrustum<3, Float>(planes, center, radius))
+            continue;
+
+        /* Clip-space W of the bounding sphere point nearest to the camera,
+           which is its distance for perspective projection and 1 for
+           orthographic projection. If the camera is inside the sphere, the
+           node is always refined. */
+        const Float distance = Math::dot(w, Vector4{transformationMatrix.transformPoint(center), 1.0f}) - radius*scaling*w.xyz().length();
+        const Float error = distance > 0.0f ? octreeNode.spacing*scaling*pixelsPerUnit/distance : Constants::inf();
+
+        Node& node = _nodes[id];
+        node.lastUsed = _frame;
+        if(node.status == Status::NotLoaded) _requests.emplace_back(error, id);
+        if(node.status != Status::Resident) continue;
+
+        if(node.allocation.vertexSize) _draw.push_back(id);
+        if(error > _maxScreenSpaceError)
+            for(UnsignedInt i = 0; i != octreeNode.childCount; ++i)
+                _stack.push_back(octreeNode.firstChild + i);
+    }
+
+    /* Start reading the missing nodes, largest error first */
+    std::sort(_requests.begin(), _requests.end(), [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+        return a.first > b.first;
+    });
+    for(std::size_t i = 0; i != _requests.size() && _reading.size() < _readBudget; ++i) {
+        const UnsignedInt id = _requests[i].second;
+        Node& node = _nodes[id];
+        node.status = Status::Reading;
+        node.task = _scheduler.add([this, id]() {
+            _nodes[id].points = _octree.points(id);
+        });
+        _reading.push_back(id);
+    }
+
+    /* Upload the data that finished reading. If the pool is full, evict
+       nodes that weren't selected for the longest time, children before
+       their parents. */
+    std::vector<UnsignedInt> evictable;
+    bool evictableCollected = false;
+    std::size_t uploaded = 0;
+    std::size_t i = 0;
+    for(; i != _read.size() && (!i || uploaded < _uploadBudget); ++i) {
+        Node& node = _nodes[_read[i]];
+
+        /* Empty node or a failed read */
+        if(node.points.empty()) {
+            node.status = Status::Resident;
+            ++_residentNodeCount;
+            continue;
+        }
+
+        const Containers::ArrayView<const void> data{node.points.data(), node.points.size()*sizeof(Point)};
+        std::optional<MeshPool::Allocation> allocation = _pool.add(data, sizeof(Point), nullptr, 1);
+        while(!allocation) {
+            if(!evictableCollected) {
+                for(UnsignedInt id = 0; id != _nodes.size(); ++id)
+                    if(_nodes[id].status == Status::Resident && _nodes[id].lastUsed != _frame)
+                        evictable.push_back(id);
+                std::sort(evictable.begin(), evictable.end(), [this](const UnsignedInt a, const UnsignedInt b) {
+                    return _nodes[a].lastUsed > _nodes[b].lastUsed ||
+                        (_nodes[a].lastUsed == _nodes[b].lastUsed && a < b);
+                });
+                evictableCollected = true;
+            }
+
+            if(evictable.empty()) break;
+            evict(_nodes[evictable.back()]);
+            evictable.pop_back();
+            allocation = _pool.add(data, sizeof(Point), nullptr, 1);
+        }
+
+        /* No space left, try again next time */
+        if(!allocation) break;
+
+        node.status = Status::Resident;
+        node.allocation = *allocation;
+        node.points = nullptr;
+        uploaded += data.size();
+        ++_residentNodeCount;
+    }
+
+    _read.erase(_read.begin(), _read.begin() + i);
+}
+
+void OctreeRenderer::evict(Node& node) {
+    if(node.allocation.vertexSize) _pool.remove(node.allocation);
+    node.allocation = {};
+    node.status = Status::NotLoaded;
+    --_residentNodeCount;
+}
+
+void OctreeRenderer::draw(AbstractShaderProgram& shader) {
+    if(_draw.empty()) return;
+
+    /* All nodes in a single draw call */
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>()) {
+        _commands.clear();
+        for(const UnsignedInt id: _draw) {
+            const MeshPool::Allocation& allocation = _nodes[id].allocation;
+            _commands.push_back({UnsignedInt(allocation.vertexSize/sizeof(Point)), 1, UnsignedInt(allocation.vertexOffset/sizeof(Point)), 0});
+        }
+
+        _commandBuffer.setData(_commands, BufferUsage::StreamDraw);
+        MeshView::drawIndirect(shader, _mesh, _commandBuffer, 0, _commands.size());
+
+    /* Draw call for each node */
+    } else for(const UnsignedInt id: _draw) {
+        const MeshPool::Allocation& allocation = _nodes[id].allocation;
+        MeshView view{_mesh};
+        view.setCount(Int(allocation.vertexSize/sizeof(Point)))
+            .setBaseVertex(Int(allocation.vertexOffset/sizeof(Point)));
+        view.draw(shader);
+    }
+}
+
+}}
@@ -0,0 +1,282 @@
+#ifndef Magnum_PointCloud_OctreeRenderer_h
+#define Magnum_PointCloud_OctreeRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::PointCloud::OctreeRenderer
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Attribute.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshPool.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/PointCloud/OctreeFormat.h"
+#include "Magnum/PointCloud/PointCloud.h"
+#include "Magnum/PointCloud/visibility.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace PointCloud {
+
+/**
+@brief Streaming octree renderer
+
+Renders point clouds stored in an @ref Octree file that are too large to fit
+into memory. Each frame, @ref update() selects nodes to render based on the
+camera and streams their data into a vertex buffer of fixed capacity,
+@ref draw() then renders them:
+@code
+PointCloud::Octree octree;
+octree.open("scan.octree");
+
+PointCloud::OctreeRenderer renderer{octree, 256*1024*1024};
+Shaders::VertexColor3D shader;
+
+// each frame
+renderer.update(transformationMatrix, camera);
+shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix);
+renderer.draw(shader);
+@endcode
+
+The vertex data contain @ref Position and @ref Color attributes at the
+generic locations, so @ref Shaders::VertexColor3D can be used to draw them.
+The transformation matrix is from octree space to camera space, same as is
+passed to @ref SceneGraph::Drawable::draw(), so the renderer can be simply
+used from inside a drawable. It is expected to have uniform scaling.
+
+## Node selection
+
+Nodes are traversed from the root. Nodes whose bounding sphere is outside of
+the camera frustum are skipped together with their children, otherwise the
+point spacing of the node is projected onto the screen at the point of the
+bounding sphere nearest to the camera. If the projected spacing is larger than
+@ref maxScreenSpaceError() pixels, the children are traversed as well. As the
+octree is additive, all selected nodes are drawn. Children of nodes that are
+not yet resident in the buffer are not traversed, so the cloud is refined
+gradually from coarse to fine while the data are streamed in.
+
+## Streaming
+
+Point data of missing nodes are read from the file asynchronously on the
+@ref TaskScheduler, at most @ref readBudget() nodes at a time, nodes with
+larger screen-space error first. Data that finished reading are uploaded into
+a @ref MeshPool during @ref update(), at most @ref uploadBudget() bytes per
+frame. If the pool is full, nodes that were not selected for the longest time
+are evicted from it.
+
+## Drawing
+
+If @extension{ARB,multi_draw_indirect} (part of OpenGL 4.3) is supported, all
+selected nodes are drawn with a single @ref MeshView::drawIndirect() call.
+Otherwise each node is drawn with a separate @ref MeshView.
+
+@requires_gl Sparse buffers and base vertex used by @ref MeshPool are not
+    available in OpenGL ES and WebGL.
+*/
+class MAGNUM_POINTCLOUD_EXPORT OctreeRenderer {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref Vector3, same as @ref Shaders::Generic3D::Position.
+         */
+        typedef Attribute<0, Vector3> Position;
+
+        /**
+         * @brief Vertex color
+         *
+         * @ref Color4, same location as @ref Shaders::Generic3D::Color.
+         * Stored as normalized @ref Color4ub.
+         */
+        typedef Attribute<3, Color4> Color;
+
+        /**
+         * @brief Constructor
+         * @param octree        Octree file
+         * @param capacity      Vertex buffer capacity in bytes
+         * @param scheduler     Scheduler for reading the point data
+         *
+         * Expects that @p octree is opened. The octree and the scheduler
+         * are expected to stay alive for the whole lifetime of the renderer.
+         */
+        explicit OctreeRenderer(Octree& octree, GLsizeiptr capacity, TaskScheduler& scheduler);
+
+        /**
+         * @brief Constructor using global scheduler
+         *
+         * Same as calling @ref OctreeRenderer(Octree&, GLsizeiptr, TaskScheduler&)
+         * with @ref TaskScheduler::global().
+         */
+        explicit OctreeRenderer(Octree& octree, GLsizeiptr capacity);
+
+        /** @brief Copying is not allowed */
+        OctreeRenderer(const OctreeRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        OctreeRenderer(OctreeRenderer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for all pending reads to finish.
+         */
+        ~OctreeRenderer();
+
+        /** @brief Copying is not allowed */
+        OctreeRenderer& operator=(const OctreeRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        OctreeRenderer& operator=(OctreeRenderer&&) = delete;
+
+        /** @brief Octree */
+        Octree& octree() { return _octree; }
+
+        /** @brief Pool with the vertex data */
+        MeshPool& pool() { return _pool; }
+
+        /** @brief Mesh with the vertex data */
+        Mesh& mesh() { return _mesh; }
+
+        /** @brief Max screen-space error */
+        Float maxScreenSpaceError() const { return _maxScreenSpaceError; }
+
+        /**
+         * @brief Set max screen-space error
+         * @return Reference to self (for method chaining)
+         *
+         * Max projected point spacing in pixels before children of a node
+         * are drawn. Default is `2.0f`.
+         */
+        OctreeRenderer& setMaxScreenSpaceError(Float pixels) {
+            _maxScreenSpaceError = pixels;
+            return *this;
+        }
+
+        /** @brief Read budget */
+        UnsignedInt readBudget() const { return _readBudget; }
+
+        /**
+         * @brief Set read budget
+         * @return Reference to self (for method chaining)
+         *
+         * Max count of nodes being read at the same time. Default is `4`.
+         */
+        OctreeRenderer& setReadBudget(UnsignedInt count) {
+            _readBudget = count;
+            return *this;
+        }
+
+        /** @brief Upload budget */
+        std::size_t uploadBudget() const { return _uploadBudget; }
+
+        /**
+         * @brief Set upload budget
+         * @return Reference to self (for method chaining)
+         *
+         * Max count of bytes uploaded in a single @ref update(). At least
+         * one node is uploaded each time if there is any. Default is 16 MB.
+         */
+        OctreeRenderer& setUploadBudget(std::size_t bytes) {
+            _uploadBudget = bytes;
+            return *this;
+        }
+
+        /** @brief Count of nodes resident in the vertex buffer */
+        std::size_t residentNodeCount() const { return _residentNodeCount; }
+
+        /** @brief Count of nodes being read */
+        std::size_t readingNodeCount() const { return _reading.size(); }
+
+        /** @brief Count of nodes selected for drawing in last @ref update() */
+        std::size_t drawNodeCount() const { return _draw.size(); }
+
+        /** @brief Count of points selected for drawing in last @ref update() */
+        UnsignedLong drawPointCount() const;
+
+        /**
+         * @brief Update node selection and stream the data
+         * @param transformationMatrix  Transformation from octree space to
+         *      camera space
+         * @param camera                Camera
+         *
+         * Collects finished reads, selects nodes for drawing, starts new
+         * reads and uploads the read data to the vertex buffer. See
+         * @ref OctreeRenderer "class documentation" for details.
+         */
+        void update(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera);
+
+        /**
+         * @brief Draw the selected nodes
+         *
+         * Draws nodes selected in last @ref update() with given shader.
+         */
+        void draw(AbstractShaderProgram& shader);
+
+    private:
+        enum class Status: UnsignedByte {
+            NotLoaded, Reading, Read, Resident
+        };
+
+        struct Node {
+            Status status;
+            UnsignedInt lastUsed;
+            TaskScheduler::TaskId task;
+            Containers::Array<Point> points;
+            MeshPool::Allocation allocation;
+        };
+
+        void MAGNUM_POINTCLOUD_LOCAL evict(Node& node);
+
+        Octree& _octree;
+        TaskScheduler& _scheduler;
+        MeshPool _pool;
+        Mesh _mesh;
+        Buffer _commandBuffer;
+
+        Float _maxScreenSpaceError;
+        UnsignedInt _readBudget;
+        std::size_t _uploadBudget;
+
+        UnsignedInt _frame;
+        std::size_t _residentNodeCount;
+        std::vector<Node> _nodes;
+        std::vector<UnsignedInt> _reading, _read, _draw, _stack;
+        std::vector<std::pair<Float, UnsignedInt>> _requests;
+        std::vector<MeshView::DrawArraysIndirectCommand> _commands;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/PointCloud/Octree.h"
+#include "Magnum/PointCloud/OctreeBuilder.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace PointCloud { namespace Test {
+
+struct OctreeBuilderTest: TestSuite::Tester {
+    explicit OctreeBuilderTest();
+
+    void bounds();
+    void setGridSizeInvalid();
+    void addOutOfBounds();
+
+    void buildEmpty();
+    void buildSingleNode();
+    void build();
+    void buildBucketLevel();
+    void buildTemporaryFiles();
+    void buildDeterministic();
+    void buildSamePosition();
+};
+
+OctreeBuilderTest::OctreeBuilderTest() {
+    addTests({&OctreeBuilderTest::bounds,
+              &OctreeBuilderTest::setGridSizeInvalid,
+              &OctreeBuilderTest::addOutOfBounds,
+
+              &OctreeBuilderTest::buildEmpty,
+              &OctreeBuilderTest::buildSingleNode,
+              &OctreeBuilderTest::build,
+              &OctreeBuilderTest::buildBucketLevel,
+              &OctreeBuilderTest::buildTemporaryFiles,
+              &OctreeBuilderTest::buildDeterministic,
+              &OctreeBuilderTest::buildSamePosition});
+}
+
+namespace {
+    /* Regular lattice of count^3 points in the unit cube with unique colors */
+    std::vector<Point> lattice(const UnsignedInt count) {
+        std::vector<Point> points;
+        for(UnsignedInt z = 0; z != count; ++z)
+            for(UnsignedInt y = 0; y != count; ++y)
+                for(UnsignedInt x = 0; x != count; ++x)
+                    points.push_back({(Vector3{Vector3ui{x, y, z}} + Vector3{0.5f})/Float(count),
+                        {UnsignedByte(x), UnsignedByte(y), UnsignedByte(z), 0xff}});
+        return points;
+    }
+
+    bool pointLess(const Point& a, const Point& b) {
+        return std::make_tuple(a.position.x(), a.position.y(), a.position.z()) <
+               std::make_tuple(b.position.x(), b.position.y(), b.position.z());
+    }
+
+    /* Checks the hierarchy and returns all points in the octree */
+    std::vector<Point> verify(Octree& octree, const UnsignedInt gridSize, bool& valid) {
+        valid = true;
+        std::vector<Point> all;
+        const Containers::ArrayView<const OctreeNode> nodes = octree.nodes();
+        for(UnsignedInt i = 0; i != nodes.size(); ++i) {
+            const OctreeNode& node = nodes[i];
+            if(node.spacing != node.size/Float(gridSize)) valid = false;
+
+            /* Children are half the size and inside the parent */
+            for(UnsignedInt j = node.firstChild; j != node.firstChild + node.childCount; ++j) {
+                const OctreeNode& child = nodes[j];
+                if(child.size != node.size*0.5f) valid = false;
+                if(!(child.min >= node.min).all() || !(child.min + Vector3{child.size} <= node.min + Vector3{node.size}).all())
+                    valid = false;
+            }
+
+            /* Points are inside the node */
+            Containers::Array<Point> points = octree.points(i);
+            for(const Point& point: points) {
+                if(!(point.position >= node.min).all() || !(point.position <= node.min + Vector3{node.size}).all())
+                    valid = false;
+                all.push_back(point);
+            }
+        }
+
+        std::sort(all.begin(), all.end(), pointLess);
+        return all;
+    }
+}
+
+void OctreeBuilderTest::bounds() {
+    OctreeBuilder builder{{{-1.0f, 2.0f, 0.0f}, {3.0f, 3.0f, 0.5f}}, POINTCLOUD_TEST_DIR};
+    CORRADE_COMPARE(builder.bucketLevel(), 3);
+    CORRADE_COMPARE(builder.gridSize(), 128);
+    CORRADE_COMPARE(builder.leafPointCount(), 16384);
+
+    /* Extended to a cube */
+    CORRADE_COMPARE(builder.bounds(), (Range3D{{-1.0f, 2.0f, 0.0f}, {3.0f, 6.0f, 4.0f}}));
+}
+
+void OctreeBuilderTest::setGridSizeInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR};
+    builder.setGridSize(0);
+    builder.setGridSize(65537);
+    CORRADE_COMPARE(out.str(),
+        "PointCloud::OctreeBuilder::setGridSize(): expected size between 1 and 65536 but got 0\n"
+        "PointCloud::OctreeBuilder::setGridSize(): expected size between 1 and 65536 but got 65537\n");
+}
+
+void OctreeBuilderTest::addOutOfBounds() {
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR};
+    const Point points[]{
+        {{0.5f, 0.5f, 0.5f}, {}},
+        {{1.5f, 0.5f, 0.5f}, {}},
+        {{0.0f, 0.0f, 0.0f}, {}},
+        {{1.0f, 1.0f, 1.0f}, {}},
+        {{0.5f, Constants::nan(), 0.5f}, {}},
+        {{0.5f, 0.5f, -0.1f}, {}}
+    };
+    CORRADE_VERIFY(builder.add(points));
+    CORRADE_COMPARE(builder.pointCount(), 3);
+    CORRADE_COMPARE(builder.ignoredPointCount(), 3);
+}
+
+void OctreeBuilderTest::buildEmpty() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "empty.octree");
+
+    OctreeBuilder builder{{{}, Vector3{2.0f}}, POINTCLOUD_TEST_DIR};
+    CORRADE_VERIFY(builder.build(filename));
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 0);
+    CORRADE_COMPARE(octree.nodes().size(), 1);
+    CORRADE_COMPARE(octree.nodes()[0].min, Vector3{});
+    CORRADE_COMPARE(octree.nodes()[0].size, 2.0f);
+    CORRADE_COMPARE(octree.nodes()[0].childCount, 0);
+}
+
+void OctreeBuilderTest::buildSingleNode() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "single.octree");
+    std::vector<Point> points = lattice(4);
+
+    /* Fewer points than the leaf size, everything is in the root */
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 0};
+    builder.setLeafPointCount(64);
+    CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+    CORRADE_VERIFY(builder.build(filename));
+    CORRADE_COMPARE(builder.pointCount(), 0);
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 64);
+    CORRADE_COMPARE(octree.nodes().size(), 1);
+    CORRADE_COMPARE(octree.nodes()[0].pointCount, 64);
+    CORRADE_COMPARE(octree.nodes()[0].spacing, 1.0f/128.0f);
+}
+
+void OctreeBuilderTest::build() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "lattice.octree");
+    std::vector<Point> points = lattice(16);
+
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 0};
+    builder.setGridSize(4)
+        .setLeafPointCount(100);
+    CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+    CORRADE_VERIFY(builder.build(filename));
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 4096);
+
+    /* The root has one point in each cell of the 4x4x4 grid, the children
+       one in each cell of theirs, leafs have the rest */
+    const Containers::ArrayView<const OctreeNode> nodes = octree.nodes();
+    CORRADE_COMPARE(nodes[0].pointCount, 64);
+    CORRADE_COMPARE(nodes[0].childCount, 8);
+    CORRADE_COMPARE(nodes[1].size, 0.5f);
+    CORRADE_COMPARE(nodes[1].pointCount, 64);
+    CORRADE_COMPARE(nodes[1].childCount, 8);
+    CORRADE_COMPARE(nodes.size(), 1 + 8 + 64);
+    CORRADE_COMPARE(nodes[9].childCount, 0);
+    CORRADE_COMPARE(nodes[9].pointCount, 64 - 1 - 8);
+
+    bool valid;
+    std::vector<Point> all = verify(octree, 4, valid);
+    CORRADE_VERIFY(valid);
+    std::sort(points.begin(), points.end(), pointLess);
+    CORRADE_COMPARE(all.size(), points.size());
+    CORRADE_VERIFY(std::equal(all.begin(), all.end(), points.begin(), [](const Point& a, const Point& b) {
+        return a.position == b.position && a.color == b.color;
+    }));
+}
+
+void OctreeBuilderTest::buildBucketLevel() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "lattice-buckets.octree");
+    std::vector<Point> points = lattice(16);
+
+    /* Same as above, but the root and its children are filled from the
+       buckets, which are leafs */
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 2};
+    builder.setGridSize(4)
+        .setLeafPointCount(100);
+    CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+    CORRADE_VERIFY(builder.build(filename));
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 4096);
+
+    const Containers::ArrayView<const OctreeNode> nodes = octree.nodes();
+    CORRADE_COMPARE(nodes.size(), 1 + 8 + 64);
+    CORRADE_COMPARE(nodes[0].pointCount, 64);
+    CORRADE_COMPARE(nodes[1].pointCount, 64);
+    CORRADE_COMPARE(nodes[9].size, 0.25f);
+    CORRADE_COMPARE(nodes[9].pointCount, 64 - 1 - 8);
+    CORRADE_COMPARE(nodes[9].childCount, 0);
+
+    bool valid;
+    std::vector<Point> all = verify(octree, 4, valid);
+    CORRADE_VERIFY(valid);
+    std::sort(points.begin(), points.end(), pointLess);
+    CORRADE_COMPARE(all.size(), points.size());
+    CORRADE_VERIFY(std::equal(all.begin(), all.end(), points.begin(), [](const Point& a, const Point& b) {
+        return a.position == b.position && a.color == b.color;
+    }));
+}
+
+void OctreeBuilderTest::buildTemporaryFiles() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "large.octree");
+    const std::string bucketFilename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "bucket0.tmp");
+    const std::string chunkFilename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "chunk0.tmp");
+    std::vector<Point> points = lattice(32);
+
+    /* Enough points to not fit into the in-memory buffer */
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 0};
+    builder.setGridSize(8)
+        .setLeafPointCount(1000);
+    CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+    CORRADE_VERIFY(Utility::Directory::fileExists(bucketFilename));
+
+    CORRADE_VERIFY(builder.build(filename));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(bucketFilename));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(chunkFilename));
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 32768);
+
+    bool valid;
+    std::vector<Point> all = verify(octree, 8, valid);
+    CORRADE_VERIFY(valid);
+    std::sort(points.begin(), points.end(), pointLess);
+    CORRADE_COMPARE(all.size(), points.size());
+    CORRADE_VERIFY(std::equal(all.begin(), all.end(), points.begin(), [](const Point& a, const Point& b) {
+        return a.position == b.position && a.color == b.color;
+    }));
+}
+
+void OctreeBuilderTest::buildDeterministic() {
+    const std::string serialFilename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "serial.octree");
+    const std::string parallelFilename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "parallel.octree");
+    const std::vector<Point> points = lattice(16);
+
+    /* The output doesn't depend on order in which the buckets get
+       processed */
+    {
+        TaskScheduler scheduler{0};
+        OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 1};
+        builder.setGridSize(4)
+            .setLeafPointCount(100);
+        CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+        CORRADE_VERIFY(builder.build(serialFilename, scheduler));
+    } {
+        TaskScheduler scheduler{3};
+        OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 1};
+        builder.setGridSize(4)
+            .setLeafPointCount(100);
+        CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+        CORRADE_VERIFY(builder.build(parallelFilename, scheduler));
+    }
+
+    const Containers::Array<char> serial = Utility::Directory::read(serialFilename);
+    const Containers::Array<char> parallel = Utility::Directory::read(parallelFilename);
+    CORRADE_COMPARE(serial.size(), sizeof(OctreeHeader) + 73*sizeof(OctreeNode) + 4096*sizeof(Point));
+    CORRADE_COMPARE((std::string{parallel.data(), parallel.size()}),
+                    (std::string{serial.data(), serial.size()}));
+}
+
+void OctreeBuilderTest::buildSamePosition() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "same.octree");
+    const std::vector<Point> points(1000, Point{{0.3f, 0.3f, 0.3f}, {}});
+
+    /* The subdivision stops at max depth */
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 0};
+    builder.setGridSize(4)
+        .setLeafPointCount(10);
+    CORRADE_VERIFY(builder.add({points.data(), points.size()}));
+    CORRADE_VERIFY(builder.build(filename));
+
+    Octree octree;
+    CORRADE_VERIFY(octree.open(filename));
+    CORRADE_COMPARE(octree.pointCount(), 1000);
+    CORRADE_COMPARE(octree.nodes().size(), 25);
+    CORRADE_COMPARE(octree.nodes()[0].pointCount, 1);
+    CORRADE_COMPARE(octree.nodes()[23].pointCount, 1);
+    CORRADE_COMPARE(octree.nodes()[24].pointCount, 1000 - 24);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::PointCloud::Test::OctreeBuilderTest)
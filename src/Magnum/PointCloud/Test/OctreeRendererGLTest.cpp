@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/PointCloud/Octree.h"
+#include "Magnum/PointCloud/OctreeBuilder.h"
+#include "Magnum/PointCloud/OctreeRenderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/VertexColor.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace PointCloud { namespace Test {
+
+struct OctreeRendererGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit OctreeRendererGLTest();
+
+    void stream();
+    void screenSpaceError();
+    void cull();
+    void evict();
+
+    std::string _filename;
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+/* Lattice of 64x64x64 points with 16x16x16 subsampling grid and leaf size of
+   4096 gives the root and eight level 1 nodes with 4096 points each and 64
+   leaf level 2 nodes with 4096 - 64 - 512 points each */
+OctreeRendererGLTest::OctreeRendererGLTest(): _filename{Utility::Directory::join(POINTCLOUD_TEST_DIR, "renderer.octree")} {
+    addTests({&OctreeRendererGLTest::stream,
+              &OctreeRendererGLTest::screenSpaceError,
+              &OctreeRendererGLTest::cull,
+              &OctreeRendererGLTest::evict});
+
+    std::vector<Point> points;
+    for(UnsignedInt z = 0; z != 64; ++z)
+        for(UnsignedInt y = 0; y != 64; ++y)
+            for(UnsignedInt x = 0; x != 64; ++x)
+                points.push_back({(Vector3{Vector3ui{x, y, z}} + Vector3{0.5f})/64.0f, {0xff, 0xff, 0xff, 0xff}});
+
+    OctreeBuilder builder{{{}, Vector3{1.0f}}, POINTCLOUD_TEST_DIR, 1};
+    builder.setGridSize(16)
+        .setLeafPointCount(4096);
+    builder.add({points.data(), points.size()});
+    builder.build(_filename);
+}
+
+void OctreeRendererGLTest::stream() {
+    Octree octree;
+    CORRADE_VERIFY(octree.open(_filename));
+    CORRADE_COMPARE(octree.nodes().size(), 73);
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({1.2f, 1.2f}, 0.1f, 10.0f))
+        .setViewport({64, 64});
+    const Matrix4 transformationMatrix = Matrix4::translation({-0.5f, -0.5f, -2.0f});
+
+    /* Refine everything, read all nodes of a level at once */
+    TaskScheduler scheduler{0};
+    OctreeRenderer renderer{octree, 8*1024*1024, scheduler};
+    renderer.setMaxScreenSpaceError(0.0f)
+        .setReadBudget(100);
+
+    /* Root requested, then uploaded */
+    renderer.update(transformationMatrix, camera);
+    CORRADE_COMPARE(renderer.drawNodeCount(), 0);
+    CORRADE_COMPARE(renderer.readingNodeCount(), 1);
+    scheduler.wait();
+    renderer.update(transformationMatrix, camera);
+    CORRADE_COMPARE(renderer.residentNodeCount(), 1);
+    scheduler.wait();
+
+    /* Root drawn, children requested */
+    renderer.update(transformationMatrix, camera);
+    CORRADE_COMPARE(renderer.drawNodeCount(), 1);
+    CORRADE_COMPARE(renderer.drawPointCount(), 4096);
+    CORRADE_COMPARE(renderer.readingNodeCount(), 8);
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        scheduler.wait();
+        renderer.update(transformationMatrix, camera);
+    }
+
+    CORRADE_COMPARE(renderer.drawNodeCount(), 73);
+    CORRADE_COMPARE(renderer.drawPointCount(), 262144);
+    CORRADE_COMPARE(renderer.residentNodeCount(), 73);
+    CORRADE_COMPARE(renderer.readingNodeCount(), 0);
+
+    Shaders::VertexColor3D shader;
+    shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix);
+    renderer.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OctreeRendererGLTest::screenSpaceError() {
+    Octree octree;
+    CORRADE_VERIFY(octree.open(_filename));
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({1.2f, 1.2f}, 0.1f, 10.0f))
+        .setViewport({64, 64});
+    const Matrix4 transformationMatrix = Matrix4::translation({-0.5f, -0.5f, -2.0f});
+
+    TaskScheduler scheduler{0};
+    OctreeRenderer renderer{octree, 8*1024*1024, scheduler};
+    renderer.setReadBudget(100);
+    CORRADE_COMPARE(renderer.maxScreenSpaceError(), 2.0f);
+
+    for(std::size_t i = 0; i != 10; ++i) {
+        renderer.update(transformationMatrix, camera);
+        scheduler.wait();
+    }
+
+    /* Root point spacing is 1/16 units, which is 3.3 pixels on the screen,
+       the children have half of that and thus aren't refined */
+    CORRADE_COMPARE(renderer.drawNodeCount(), 9);
+    CORRADE_COMPARE(renderer.drawPointCount(), 9*4096);
+    CORRADE_COMPARE(renderer.residentNodeCount(), 9);
+}
+
+void OctreeRendererGLTest::cull() {
+    Octree octree;
+    CORRADE_VERIFY(octree.open(_filename));
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 10.0f))
+        .setViewport({64, 64});
+
+    /* Behind the camera */
+    const Matrix4 transformationMatrix = Matrix4::translation({-0.5f, -0.5f, 5.0f});
+
+    TaskScheduler scheduler{0};
+    OctreeRenderer renderer{octree, 8*1024*1024, scheduler};
+    for(std::size_t i = 0; i != 5; ++i) {
+        renderer.update(transformationMatrix, camera);
+        scheduler.wait();
+    }
+
+    CORRADE_COMPARE(renderer.drawNodeCount(), 0);
+    CORRADE_COMPARE(renderer.readingNodeCount(), 0);
+    CORRADE_COMPARE(renderer.residentNodeCount(), 0);
+
+    Shaders::VertexColor3D shader;
+    renderer.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OctreeRendererGLTest::evict() {
+    Octree octree;
+    CORRADE_VERIFY(octree.open(_filename));
+
+    /* A narrow view selects the root, two level 1 nodes and four level 2
+       nodes in the corner */
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({0.1f, 0.1f}, 0.1f, 10.0f))
+        .setViewport({64, 64});
+    const Matrix4 a = Matrix4::translation({-0.05f, -0.05f, -2.0f});
+    const Matrix4 b = Matrix4::translation({-0.95f, -0.95f, -2.0f});
+    constexpr UnsignedLong pointCount = 3*4096 + 4*(4096 - 64 - 512);
+
+    /* The pool can't fit the nodes of both corners */
+    TaskScheduler scheduler{0};
+    OctreeRenderer renderer{octree, 512*1024, scheduler};
+    renderer.setReadBudget(100);
+    for(std::size_t i = 0; i != 10; ++i) {
+        renderer.update(a, camera);
+        scheduler.wait();
+    }
+
+    CORRADE_COMPARE(renderer.drawNodeCount(), 7);
+    CORRADE_COMPARE(renderer.drawPointCount(), pointCount);
+    CORRADE_COMPARE(renderer.residentNodeCount(), 7);
+
+    /* Nodes of the first corner are evicted to make space for the second */
+    for(std::size_t i = 0; i != 10; ++i) {
+        renderer.update(b, camera);
+        scheduler.wait();
+    }
+
+    CORRADE_COMPARE(renderer.drawNodeCount(), 7);
+    CORRADE_COMPARE(renderer.drawPointCount(), pointCount);
+    CORRADE_VERIFY(renderer.residentNodeCount() < 13);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::PointCloud::Test::OctreeRendererGLTest)
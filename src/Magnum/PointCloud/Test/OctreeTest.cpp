@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PointCloud/Octree.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace PointCloud { namespace Test {
+
+struct OctreeTest: TestSuite::Tester {
+    explicit OctreeTest();
+
+    void open();
+    void openNonexistent();
+    void openTooShort();
+    void openInvalidIdentifier();
+    void openInvalidEndianness();
+    void openInvalidVersion();
+    void openTooShortNodes();
+    void openInvalidChildren();
+    void openPointsOutOfBounds();
+    void openPointCountMismatch();
+    void close();
+};
+
+OctreeTest::OctreeTest() {
+    addTests({&OctreeTest::open,
+              &OctreeTest::openNonexistent,
+              &OctreeTest::openTooShort,
+              &OctreeTest::openInvalidIdentifier,
+              &OctreeTest::openInvalidEndianness,
+              &OctreeTest::openInvalidVersion,
+              &OctreeTest::openTooShortNodes,
+              &OctreeTest::openInvalidChildren,
+              &OctreeTest::openPointsOutOfBounds,
+              &OctreeTest::openPointCountMismatch,
+              &OctreeTest::close});
+}
+
+namespace {
+    /* Root with two children, each node with points */
+    constexpr UnsignedLong DataOffset = sizeof(OctreeHeader) + 3*sizeof(OctreeNode);
+
+    const OctreeNode Nodes[]{
+        {{0.0f, 0.0f, 0.0f}, 2.0f, 0.5f, 1, 2, 2, DataOffset},
+        {{0.0f, 0.0f, 0.0f}, 1.0f, 0.25f, 0, 0, 1, DataOffset + 2*sizeof(Point)},
+        {{1.0f, 0.0f, 0.0f}, 1.0f, 0.25f, 0, 0, 1, DataOffset + 3*sizeof(Point)}
+    };
+
+    const Point Points[]{
+        {{0.5f, 0.5f, 0.5f}, {0xff, 0x00, 0x00, 0xff}},
+        {{1.5f, 1.5f, 1.5f}, {0x00, 0xff, 0x00, 0xff}},
+        {{0.25f, 0.5f, 0.75f}, {0x00, 0x00, 0xff, 0xff}},
+        {{1.75f, 0.5f, 0.25f}, {0xff, 0xff, 0xff, 0x80}}
+    };
+
+    OctreeHeader header(UnsignedInt nodeCount, UnsignedLong pointCount) {
+        OctreeHeader header{};
+        std::copy(OctreeIdentifier, OctreeIdentifier + sizeof(OctreeIdentifier), header.identifier);
+        header.version = OctreeVersion;
+        header.endianness = 0x04030201;
+        header.nodeCount = nodeCount;
+        header.pointCount = pointCount;
+        return header;
+    }
+
+    std::string write(const OctreeHeader& header, const std::vector<OctreeNode>& nodes, const std::vector<Point>& points) {
+        const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "octree.bin");
+        std::ofstream out{filename, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(OctreeHeader));
+        out.write(reinterpret_cast<const char*>(nodes.data()), nodes.size()*sizeof(OctreeNode));
+        out.write(reinterpret_cast<const char*>(points.data()), points.size()*sizeof(Point));
+        return filename;
+    }
+
+    std::string writeValid() {
+        return write(header(3, 4), {std::begin(Nodes), std::end(Nodes)}, {std::begin(Points), std::end(Points)});
+    }
+}
+
+void OctreeTest::open() {
+    Octree octree;
+    CORRADE_VERIFY(!octree.isOpened());
+    CORRADE_VERIFY(octree.open(writeValid()));
+    CORRADE_VERIFY(octree.isOpened());
+    CORRADE_COMPARE(octree.pointCount(), 4);
+    CORRADE_COMPARE(octree.nodes().size(), 3);
+    CORRADE_COMPARE(octree.nodes()[0].firstChild, 1);
+    CORRADE_COMPARE(octree.nodes()[0].childCount, 2);
+    CORRADE_COMPARE(octree.nodes()[2].min, (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(octree.nodes()[2].spacing, 0.25f);
+
+    Containers::Array<Point> root = octree.points(0);
+    CORRADE_COMPARE(root.size(), 2);
+    CORRADE_COMPARE(root[0].position, Points[0].position);
+    CORRADE_COMPARE(root[1].color, Points[1].color);
+
+    Containers::Array<Point> child = octree.points(2);
+    CORRADE_COMPARE(child.size(), 1);
+    CORRADE_COMPARE(child[0].position, Points[3].position);
+    CORRADE_COMPARE(child[0].color, Points[3].color);
+}
+
+void OctreeTest::openNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open("nonexistent.octree"));
+    CORRADE_VERIFY(!octree.isOpened());
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): can't open file nonexistent.octree\n");
+}
+
+void OctreeTest::openTooShort() {
+    const std::string filename = Utility::Directory::join(POINTCLOUD_TEST_DIR, "octree.bin");
+    std::ofstream{filename, std::ios::binary}.write("\x89MGNPCO\n", 8);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(filename));
+    CORRADE_VERIFY(!octree.isOpened());
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): the file is too short: 8 bytes\n");
+}
+
+void OctreeTest::openInvalidIdentifier() {
+    OctreeHeader h = header(3, 4);
+    h.identifier[1] = 'N';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(h, {std::begin(Nodes), std::end(Nodes)}, {std::begin(Points), std::end(Points)})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): invalid file identifier\n");
+}
+
+void OctreeTest::openInvalidEndianness() {
+    OctreeHeader h = header(3, 4);
+    h.endianness = 0x01020304;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(h, {std::begin(Nodes), std::end(Nodes)}, {std::begin(Points), std::end(Points)})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): files with different endianness are not supported\n");
+}
+
+void OctreeTest::openInvalidVersion() {
+    OctreeHeader h = header(3, 4);
+    h.version = OctreeVersion + 1;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(h, {std::begin(Nodes), std::end(Nodes)}, {std::begin(Points), std::end(Points)})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): unsupported version 2, expected 1 or older\n");
+}
+
+void OctreeTest::openTooShortNodes() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(header(4, 4), {std::begin(Nodes), std::end(Nodes)}, {})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): the file is too short for 4 nodes\n");
+}
+
+void OctreeTest::openInvalidChildren() {
+    std::vector<OctreeNode> nodes{std::begin(Nodes), std::end(Nodes)};
+    nodes[1].firstChild = 1;
+    nodes[1].childCount = 1;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(header(3, 4), nodes, {std::begin(Points), std::end(Points)})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): invalid children of node 1\n");
+}
+
+void OctreeTest::openPointsOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(header(3, 4), {std::begin(Nodes), std::end(Nodes)}, {Points[0], Points[1], Points[2]})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): point data of node 2 are out of file bounds\n");
+}
+
+void OctreeTest::openPointCountMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Octree octree;
+    CORRADE_VERIFY(!octree.open(write(header(3, 5), {std::begin(Nodes), std::end(Nodes)}, {std::begin(Points), std::end(Points)})));
+    CORRADE_COMPARE(out.str(), "PointCloud::Octree::open(): expected 5 points but nodes contain 4\n");
+}
+
+void OctreeTest::close() {
+    Octree octree;
+    CORRADE_VERIFY(octree.open(writeValid()));
+    CORRADE_VERIFY(octree.isOpened());
+
+    octree.close();
+    CORRADE_VERIFY(!octree.isOpened());
+
+    /* Opening again after close works */
+    CORRADE_VERIFY(octree.open(writeValid()));
+    CORRADE_COMPARE(octree.nodes().size(), 3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::PointCloud::Test::OctreeTest)
@@ -25,15 +25,50 @@
 
 #include "Icosphere.h"
 
+#include <unordered_map>
+
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
-#include "Magnum/MeshTools/Duplicate.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
-#include "Magnum/MeshTools/Subdivide.h"
 #include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives {
 
+namespace {
+
+/* Like MeshTools::subdivide(), but each edge midpoint is created only once
+   and shared by both adjacent faces, so there's no need to remove duplicate
+   vertices afterwards */
+void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    std::unordered_map<UnsignedLong, UnsignedInt> midpoints;
+    midpoints.reserve(indices.size()/2);
+    auto midpoint = [&](const UnsignedInt a, const UnsignedInt b) {
+        const UnsignedLong key = a < b ? (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+        const auto inserted = midpoints.emplace(key, UnsignedInt(positions.size()));
+        if(inserted.second)
+            positions.push_back((positions[a] + positions[b]).normalized());
+        return inserted.first->second;
+    };
+
+    const std::size_t indexCount = indices.size();
+    indices.reserve(indexCount*4);
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        const UnsignedInt original[]{indices[i], indices[i + 1], indices[i + 2]};
+        UnsignedInt newVertices[3];
+        for(std::size_t j = 0; j != 3; ++j)
+            newVertices[j] = midpoint(original[j], original[(j + 1)%3]);
+
+        /* Same face layout as MeshTools::subdivide(): the middle face
+           replaces the original one, corner faces are appended */
+        indices.insert(indices.end(), {original[0], newVertices[0], newVertices[2],
+                                       newVertices[0], original[1], newVertices[1],
+                                       newVertices[2], newVertices[1], original[2]});
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i + j] = newVertices[j];
+    }
+}
+
+}
+
 Trade::MeshData3D Icosphere::solid(const UnsignedInt subdivisions) {
     std::vector<UnsignedInt> indices{
         1, 2, 6,
@@ -74,11 +109,7 @@ Trade::MeshData3D Icosphere::solid(const UnsignedInt subdivisions) {
     };
 
     for(std::size_t i = 0; i != subdivisions; ++i)
-        MeshTools::subdivide(indices, positions, [](const Vector3& a, const Vector3& b) {
-            return (a+b).normalized();
-        });
-
-    indices = MeshTools::duplicate(indices, MeshTools::removeDuplicates(positions));
+        subdivide(indices, positions);
 
     std::vector<Vector3> normals(positions);
     return Trade::MeshData3D(MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {std::move(normals)}, {});
@@ -35,10 +35,12 @@ struct IcosphereTest: TestSuite::Tester {
     explicit IcosphereTest();
 
     void count();
+    void subdivisions();
 };
 
 IcosphereTest::IcosphereTest() {
-    addTests({&IcosphereTest::count});
+    addTests({&IcosphereTest::count,
+              &IcosphereTest::subdivisions});
 }
 
 void IcosphereTest::count() {
@@ -52,6 +54,25 @@ void IcosphereTest::count() {
     CORRADE_COMPARE(data.normals(0).size(), 162);
 }
 
+void IcosphereTest::subdivisions() {
+    /* Each subdivision shares the edge midpoints between adjacent faces, so
+       there are no duplicate vertices */
+    const std::size_t expected[]{12, 42, 162, 642};
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        Trade::MeshData3D data = Primitives::Icosphere::solid(i);
+
+        const std::vector<Vector3>& positions = data.positions(0);
+        CORRADE_COMPARE(positions.size(), expected[i]);
+        CORRADE_COMPARE(data.indices().size(), std::size_t(60) << 2*i);
+
+        for(std::size_t j = 0; j != positions.size(); ++j) {
+            CORRADE_COMPARE(positions[j].length(), 1.0f);
+            for(std::size_t k = j + 1; k != positions.size(); ++k)
+                CORRADE_VERIFY(positions[j] != positions[k]);
+        }
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Primitives::Test::IcosphereTest)
@@ -0,0 +1,110 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProgramBinaryCache.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Shader.h"
+
+namespace Magnum {
+
+namespace {
+    ProgramBinaryCache* currentCache = nullptr;
+}
+
+bool ProgramBinaryCache::hasCurrent() { return currentCache; }
+
+ProgramBinaryCache& ProgramBinaryCache::current() {
+    CORRADE_ASSERT(currentCache, "ProgramBinaryCache::current(): no current cache", *currentCache);
+    return *currentCache;
+}
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory): _directory{std::move(directory)}, _hitCount{0}, _missCount{0} {
+    CORRADE_ASSERT(!currentCache, "ProgramBinaryCache: another cache currently active", );
+    if(!Utility::Directory::fileExists(_directory) && !Utility::Directory::mkpath(_directory))
+        Warning() << "ProgramBinaryCache: can't create directory" << _directory;
+    currentCache = this;
+}
+
+ProgramBinaryCache::~ProgramBinaryCache() {
+    if(currentCache == this) currentCache = nullptr;
+}
+
+std::string ProgramBinaryCache::key(std::initializer_list<std::reference_wrapper<const Shader>> shaders) const {
+    /* Null bytes separate all strings so their boundaries are part of the
+       hash as well */
+    const Context& context = Context::current();
+    const std::string separator(1, '\0');
+    Utility::Sha1 sha1;
+    sha1 << context.vendorString() << separator
+         << context.rendererString() << separator
+         << context.versionString() << separator;
+    for(const Shader& shader: shaders) {
+        const GLenum type = GLenum(shader.type());
+        sha1 << std::string{reinterpret_cast<const char*>(&type), sizeof(GLenum)};
+        for(const std::string& source: shader.sources())
+            sha1 << source << separator;
+    }
+
+    return sha1.digest().hexString();
+}
+
+std::pair<GLenum, Containers::Array<char>> ProgramBinaryCache::find(const std::string& key) const {
+    const std::string filename = this->filename(key);
+    if(!Utility::Directory::fileExists(filename)) return {};
+
+    /* The file is format followed by the binary, treat truncated files as
+       not found */
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    if(data.size() <= sizeof(GLenum)) return {};
+
+    GLenum format;
+    std::memcpy(&format, data, sizeof(GLenum));
+    Containers::Array<char> binary{data.size() - sizeof(GLenum)};
+    std::memcpy(binary, data + sizeof(GLenum), binary.size());
+    return {format, std::move(binary)};
+}
+
+bool ProgramBinaryCache::insert(const std::string& key, const GLenum format, const Containers::ArrayView<const char> binary) {
+    Containers::Array<char> data{sizeof(GLenum) + binary.size()};
+    std::memcpy(data, &format, sizeof(GLenum));
+    std::memcpy(data + sizeof(GLenum), binary, binary.size());
+    return Utility::Directory::write(filename(key), data);
+}
+
+bool ProgramBinaryCache::remove(const std::string& key) {
+    return Utility::Directory::rm(filename(key));
+}
+
+std::string ProgramBinaryCache::filename(const std::string& key) const {
+    return Utility::Directory::join(_directory, key + ".bin");
+}
+
+}
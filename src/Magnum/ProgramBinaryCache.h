@@ -0,0 +1,181 @@
+#ifndef Magnum_ProgramBinaryCache_h
+#define Magnum_ProgramBinaryCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ProgramBinaryCache
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief On-disk cache of linked shader program binaries
+
+Stores program binaries retrieved with @fn_gl{GetProgramBinary} in a
+directory, so subsequent runs can load them with @fn_gl{ProgramBinary}
+instead of compiling and linking the shaders again. The binaries are keyed by
+hash of all shader sources and vendor, renderer and version string of the
+driver, so a driver update or a change in the sources never loads a stale
+binary.
+
+## Usage
+
+Create an instance after the OpenGL context is created and keep it alive for
+as long as the shaders are created. While it exists, it's available through
+@ref current() and all builtin shaders in the @ref Shaders namespace consult
+it transparently before compiling:
+
+@code
+ProgramBinaryCache cache{Utility::Directory::join(Utility::Directory::home(), ".cache/myapp")};
+
+Shaders::Phong phong; // loaded from the cache or compiled and saved into it
+
+Debug() << cache.hitCount() << "hits," << cache.missCount() << "misses";
+@endcode
+
+Custom @ref AbstractShaderProgram subclasses can use the cache the same way
+with @ref AbstractShaderProgram::loadCachedBinary() and
+@ref AbstractShaderProgram::saveCachedBinary(), see
+@ref AbstractShaderProgram-binary-cache "its documentation" for an example.
+
+The cache is used only if @extension{ARB,get_program_binary} (part of OpenGL
+4.1) or OpenGL ES 3.0 is available, otherwise the shaders are always compiled.
+Binary program representations are not supported in WebGL.
+*/
+class MAGNUM_EXPORT ProgramBinaryCache {
+    friend AbstractShaderProgram;
+
+    public:
+        /** @brief Whether there is any current cache */
+        static bool hasCurrent();
+
+        /**
+         * @brief Current cache
+         *
+         * Expect that there is current cache.
+         * @see @ref hasCurrent()
+         */
+        static ProgramBinaryCache& current();
+
+        /**
+         * @brief Constructor
+         * @param directory     Directory where to store the binaries
+         *
+         * Creates the directory if it doesn't exist and makes the instance
+         * current. Expects that there is no other current cache.
+         */
+        explicit ProgramBinaryCache(std::string directory);
+
+        /** @brief Copying is not allowed */
+        ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProgramBinaryCache(ProgramBinaryCache&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * The stored binaries are kept on disk.
+         */
+        ~ProgramBinaryCache();
+
+        /** @brief Copying is not allowed */
+        ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProgramBinaryCache& operator=(ProgramBinaryCache&&) = delete;
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Count of programs loaded from the cache
+         *
+         * @see @ref missCount()
+         */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /**
+         * @brief Count of programs not found in the cache
+         *
+         * Includes also binaries that were found but the driver refused to
+         * load them.
+         * @see @ref hitCount()
+         */
+        UnsignedInt missCount() const { return _missCount; }
+
+        /**
+         * @brief Cache key for given shaders
+         *
+         * SHA-1 hash of type and sources of all @p shaders and vendor,
+         * renderer and version string of current context.
+         * @see @ref Context::vendorString(), @ref Context::rendererString(),
+         *      @ref Context::versionString()
+         */
+        std::string key(std::initializer_list<std::reference_wrapper<const Shader>> shaders) const;
+
+        /**
+         * @brief Find program binary
+         * @return Binary format and the binary or empty array if there is no
+         *      binary stored for given key
+         */
+        std::pair<GLenum, Containers::Array<char>> find(const std::string& key) const;
+
+        /**
+         * @brief Insert program binary
+         *
+         * Replaces binary with the same key, if any. Returns `false` if the
+         * file couldn't be written, `true` otherwise.
+         */
+        bool insert(const std::string& key, GLenum format, Containers::ArrayView<const char> binary);
+
+        /**
+         * @brief Remove program binary
+         *
+         * Returns `false` if there was nothing to remove, `true` otherwise.
+         */
+        bool remove(const std::string& key);
+
+    private:
+        std::string MAGNUM_LOCAL filename(const std::string& key) const;
+
+        std::string _directory;
+        UnsignedInt _hitCount, _missCount;
+};
+
+}
+
+#endif
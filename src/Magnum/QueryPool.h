@@ -0,0 +1,234 @@
+#ifndef Magnum_QueryPool_h
+#define Magnum_QueryPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/** @file
+ * @brief Class @ref Magnum::QueryPool
+ */
+#endif
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum {
+
+/**
+@brief Pool of reusable queries
+
+Reading a query result right after the query ended stalls the pipeline until
+the GPU catches up. The usual solution is to keep several queries in flight
+and read them a few frames later, which requires a growing set of query
+objects. This class manages such set for @ref SampleQuery, @ref PrimitiveQuery,
+@ref TimeQuery or @ref PipelineStatisticsQuery: @ref begin() takes a free query
+(or creates a new one if all are in flight) and returns a handle to it,
+@ref result() fetches the result only if it is already available and then
+returns the query back to the pool. Example usage:
+@code
+QueryPool<TimeQuery> pool{TimeQuery::Target::TimeElapsed};
+std::deque<UnsignedInt> pending;
+
+// each frame
+pending.push_back(pool.begin());
+// rendering...
+pool.end(pending.back());
+
+UnsignedLong time;
+while(!pending.empty() && pool.result(pending.front(), time)) {
+    // process the time...
+    pending.pop_front();
+}
+@endcode
+
+The pool never blocks and never deletes the queries until destruction, so in
+steady state no query objects are created.
+@see @ref DebugTools::Profiler
+*/
+template<class T> class QueryPool {
+    public:
+        /** @brief Query target */
+        typedef typename T::Target Target;
+
+        /**
+         * @brief Constructor
+         *
+         * No query objects are created until the first call to @ref begin().
+         */
+        explicit QueryPool(Target target): _target{target} {}
+
+        /** @brief Copying is not allowed */
+        QueryPool(const QueryPool<T>&) = delete;
+
+        /** @brief Move constructor */
+        QueryPool(QueryPool<T>&&) = default;
+
+        /** @brief Copying is not allowed */
+        QueryPool<T>& operator=(const QueryPool<T>&) = delete;
+
+        /** @brief Move assignment */
+        QueryPool<T>& operator=(QueryPool<T>&&) = default;
+
+        /** @brief Query target */
+        Target target() const { return _target; }
+
+        /**
+         * @brief Count of query objects
+         *
+         * Both free and in-flight.
+         * @see @ref activeCount()
+         */
+        std::size_t size() const { return _queries.size(); }
+
+        /**
+         * @brief Count of query objects in flight
+         *
+         * Queries for which @ref begin() was called and which weren't yet
+         * returned back to the pool by @ref result() or @ref release().
+         */
+        std::size_t activeCount() const { return _queries.size() - _free.size(); }
+
+        /**
+         * @brief Begin a query
+         * @return Query handle
+         *
+         * Takes a free query from the pool, creating new one if there is
+         * none, and begins it.
+         * @see @ref AbstractQuery::begin()
+         */
+        UnsignedInt begin();
+
+        /**
+         * @brief End a query
+         *
+         * Expects that @p handle was returned from @ref begin() and was not
+         * released yet.
+         * @see @ref AbstractQuery::end()
+         */
+        void end(UnsignedInt handle);
+
+        /**
+         * @brief Whether the result is available
+         *
+         * Doesn't block. Expects that @p handle was returned from
+         * @ref begin() and was not released yet.
+         * @see @ref AbstractQuery::resultAvailable()
+         */
+        bool resultAvailable(UnsignedInt handle);
+
+        /**
+         * @brief Fetch query result if available
+         *
+         * If the result is available, saves it into @p result, returns the
+         * query back to the pool and returns `true`. Otherwise doesn't block,
+         * leaves @p result untouched and returns `false`. Expects that the
+         * query was ended.
+         * @see @ref AbstractQuery::result()
+         */
+        template<class U> bool result(UnsignedInt handle, U& result);
+
+        /**
+         * @brief Return a query back to the pool
+         *
+         * Discards the result. Useful for queries which were begun but whose
+         * result is not needed anymore.
+         */
+        void release(UnsignedInt handle);
+
+        /**
+         * @brief Query object for given handle
+         *
+         * Expects that @p handle was returned from @ref begin() and was not
+         * released yet.
+         */
+        T& query(UnsignedInt handle);
+
+    private:
+        Target _target;
+        std::vector<T> _queries;
+        std::vector<UnsignedInt> _free;
+        std::vector<bool> _active;
+};
+
+template<class T> UnsignedInt QueryPool<T>::begin() {
+    UnsignedInt handle;
+    if(_free.empty()) {
+        handle = _queries.size();
+        _queries.emplace_back(_target);
+        _active.push_back(true);
+    } else {
+        handle = _free.back();
+        _free.pop_back();
+        _active[handle] = true;
+    }
+
+    _queries[handle].begin();
+    return handle;
+}
+
+template<class T> void QueryPool<T>::end(const UnsignedInt handle) {
+    CORRADE_ASSERT(handle < _queries.size() && _active[handle],
+        "QueryPool::end(): invalid handle" << handle, );
+    _queries[handle].end();
+}
+
+template<class T> bool QueryPool<T>::resultAvailable(const UnsignedInt handle) {
+    CORRADE_ASSERT(handle < _queries.size() && _active[handle],
+        "QueryPool::resultAvailable(): invalid handle" << handle, false);
+    return _queries[handle].resultAvailable();
+}
+
+template<class T> template<class U> bool QueryPool<T>::result(const UnsignedInt handle, U& result) {
+    CORRADE_ASSERT(handle < _queries.size() && _active[handle],
+        "QueryPool::result(): invalid handle" << handle, false);
+    if(!_queries[handle].resultAvailable()) return false;
+
+    result = _queries[handle].template result<U>();
+    release(handle);
+    return true;
+}
+
+template<class T> void QueryPool<T>::release(const UnsignedInt handle) {
+    CORRADE_ASSERT(handle < _queries.size() && _active[handle],
+        "QueryPool::release(): invalid handle" << handle, );
+    _active[handle] = false;
+    _free.push_back(handle);
+}
+
+template<class T> T& QueryPool<T>::query(const UnsignedInt handle) {
+    CORRADE_ASSERT(handle < _queries.size() && _active[handle],
+        "QueryPool::query(): invalid handle" << handle, _queries[0]);
+    return _queries[handle];
+}
+
+}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderQueue.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/RenderState.h"
+#include "Magnum/Renderer.h"
+
+namespace Magnum {
+
+namespace {
+
+/* Monotonic for non-negative floats, the upper half of the bits is enough for
+   depth ordering */
+UnsignedLong quantizeDepth(const Float depth) {
+    if(!(depth > 0.0f)) return 0;
+    UnsignedInt bits;
+    std::memcpy(&bits, &depth, sizeof(Float));
+    return bits >> 16;
+}
+
+struct ShaderStateHash {
+    std::size_t operator()(const std::pair<const AbstractShaderProgram*, const RenderState*>& key) const {
+        return std::hash<const AbstractShaderProgram*>{}(key.first)*31 + std::hash<const RenderState*>{}(key.second);
+    }
+};
+
+/* Dense index in order of first appearance, so the values fit into 16 bits */
+template<class T, class Hash> UnsignedLong denseIndex(std::unordered_map<T, UnsignedInt, Hash>& indices, const T& key) {
+    return indices.emplace(key, indices.size()).first->second & 0xffff;
+}
+
+}
+
+RenderQueue::RenderQueue(const Order order): _order{order}, _prePassShader{}, _prePassSetup{}, _prePassDepthFunction{Renderer::DepthFunction::LessOrEqual}, _drawCount{}, _prePassDrawCount{}, _shaderBindsAvoided{}, _textureBindsAvoided{}, _meshBindsAvoided{} {}
+
+RenderQueue& RenderQueue::setDepthPrePass(AbstractShaderProgram& shader, const DepthPrePassSetup setup, const Renderer::DepthFunction function) {
+    CORRADE_ASSERT(setup, "RenderQueue::setDepthPrePass(): setup function must not be null", *this);
+    _prePassShader = &shader;
+    _prePassSetup = setup;
+    _prePassDepthFunction = function;
+    return *this;
+}
+
+RenderQueue& RenderQueue::disableDepthPrePass() {
+    _prePassShader = nullptr;
+    _prePassSetup = nullptr;
+    return *this;
+}
+
+RenderQueue& RenderQueue::add(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const Float depth, std::function<void()> setup) {
+    _items.push_back({&shader, &mesh, _textures.size(), textures.size(), depth, std::move(setup), nullptr, nullptr, nullptr, NoPrePass});
+    _textures.insert(_textures.end(), textures.begin(), textures.end());
+    return *this;
+}
+
+RenderQueue& RenderQueue::addOpaque(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const Matrix4& transformationProjectionMatrix, const Float depth, std::function<void()> setup) {
+    _items.push_back({&shader, &mesh, _textures.size(), textures.size(), depth, std::move(setup), nullptr, nullptr, nullptr, UnsignedInt(_prePassMatrices.size())});
+    _textures.insert(_textures.end(), textures.begin(), textures.end());
+    _prePassMatrices.push_back(transformationProjectionMatrix);
+    return *this;
+}
+
+RenderQueue& RenderQueue::add(const CommandBuffer& buffer) {
+    const std::size_t textureOffset = _textures.size();
+    _items.reserve(_items.size() + buffer.size());
+    for(const CommandBuffer::Packet& packet: buffer.packets())
+        _items.push_back({packet.shader, packet.mesh, textureOffset + packet.textureOffset, packet.textureCount, packet.depth, {}, packet.state, packet.setup, packet.uniforms, NoPrePass});
+    _textures.insert(_textures.end(), buffer.textures().begin(), buffer.textures().end());
+    return *this;
+}
+
+void RenderQueue::clear() {
+    _items.clear();
+    _textures.clear();
+    _prePassMatrices.clear();
+}
+
+void RenderQueue::sort() {
+    /* LSD radix sort, eight bits at a time. Stable, so the draws with the
+       same key stay in the order they were added. */
+    _keysTemporary.resize(_keys.size());
+    _indicesTemporary.resize(_indices.size());
+    for(UnsignedInt shift = 0; shift != 64; shift += 8) {
+        std::size_t counts[256]{};
+        for(const UnsignedLong key: _keys) ++counts[(key >> shift) & 0xff];
+
+        /* All keys have the same digit, nothing to do in this pass */
+        if(counts[(_keys.empty() ? 0 : _keys.front() >> shift) & 0xff] == _keys.size())
+            continue;
+
+        std::size_t offset = 0;
+        for(std::size_t& count: counts) {
+            const std::size_t current = count;
+            count = offset;
+            offset += current;
+        }
+
+        for(std::size_t i = 0; i != _keys.size(); ++i) {
+            const std::size_t position = counts[(_keys[i] >> shift) & 0xff]++;
+            _keysTemporary[position] = _keys[i];
+            _indicesTemporary[position] = _indices[i];
+        }
+
+        std::swap(_keys, _keysTemporary);
+        std::swap(_indices, _indicesTemporary);
+    }
+}
+
+void RenderQueue::draw() {
+    _drawCount = _prePassDrawCount = _shaderBindsAvoided = _textureBindsAvoided = _meshBindsAvoided = 0;
+
+    /* Depth pre-pass, front to back regardless of the order, as the state
+       changes are minimal with just one shader */
+    const bool prePass = _prePassShader && !_prePassMatrices.empty();
+    if(prePass) {
+        _keys.clear();
+        _indices.clear();
+        for(std::size_t i = 0; i != _items.size(); ++i) {
+            if(_items[i].prePassMatrix == NoPrePass) continue;
+            _keys.push_back(quantizeDepth(_items[i].depth));
+            _indices.push_back(i);
+        }
+        sort();
+
+        Renderer::setColorMask(false, false, false, false);
+        for(const UnsignedInt index: _indices) {
+            const Item& item = _items[index];
+            _prePassSetup(*_prePassShader, _prePassMatrices[item.prePassMatrix]);
+            item.mesh->draw(*_prePassShader);
+            ++_prePassDrawCount;
+        }
+        Renderer::setColorMask(true, true, true, true);
+    }
+
+    /* Build the sort keys */
+    {
+        std::unordered_map<std::pair<const AbstractShaderProgram*, const RenderState*>, UnsignedInt, ShaderStateHash> shaders;
+        std::unordered_map<const Mesh*, UnsignedInt> meshes;
+        std::unordered_map<std::size_t, UnsignedInt> textureSets;
+
+        _keys.resize(_items.size());
+        _indices.resize(_items.size());
+        for(std::size_t i = 0; i != _items.size(); ++i) {
+            const Item& item = _items[i];
+
+            /* Hash collisions only make the grouping worse, the bindings are
+               checked against the actual textures */
+            std::size_t textureHash = 0;
+            for(std::size_t j = 0; j != item.textureCount; ++j)
+                textureHash = textureHash*31 + std::hash<AbstractTexture*>{}(_textures[item.textureOffset + j]);
+
+            const UnsignedLong state =
+                (denseIndex(shaders, std::make_pair(static_cast<const AbstractShaderProgram*>(item.shader), item.state)) << 32)|
+                (denseIndex(textureSets, textureHash) << 16)|
+                 denseIndex(meshes, static_cast<const Mesh*>(item.mesh));
+            const UnsignedLong depth = quantizeDepth(item.depth);
+
+            switch(_order) {
+                case Order::State:
+                    _keys[i] = (state << 16)|depth;
+                    break;
+                case Order::FrontToBack:
+                    _keys[i] = (depth << 48)|state;
+                    break;
+                case Order::BackToFront:
+                    _keys[i] = ((0xffff - depth) << 48)|state;
+                    break;
+            }
+
+            _indices[i] = i;
+        }
+    }
+
+    sort();
+
+    /* Submit, binding only textures that changed. The bindings done outside
+       of the queue are not known, so start from scratch each time. */
+    _boundTextures.clear();
+    const AbstractShaderProgram* previousShader = nullptr;
+    const Mesh* previousMesh = nullptr;
+    const RenderState* previousState = nullptr;
+    bool previousPrePassed = false;
+    for(const UnsignedInt index: _indices) {
+        Item& item = _items[index];
+        const bool prePassed = prePass && item.prePassMatrix != NoPrePass;
+
+        /* Draws that aren't in the pre-pass get the default depth function
+           back. Their render state is applied again in case it sets the
+           depth function too. */
+        if(previousPrePassed && !prePassed) {
+            Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+            previousState = nullptr;
+        }
+        previousPrePassed = prePassed;
+
+        if(item.shader == previousShader) ++_shaderBindsAvoided;
+        if(item.mesh == previousMesh) ++_meshBindsAvoided;
+        previousShader = item.shader;
+        previousMesh = item.mesh;
+
+        /* Renderer filters redundant state changes itself, this only avoids
+           going through the whole state block again */
+        if(item.state && item.state != previousState) {
+            Renderer::setState(*item.state);
+            previousState = item.state;
+        }
+
+        /* Renderer filters the redundant calls */
+        if(prePassed) Renderer::setDepthFunction(_prePassDepthFunction);
+
+        if(_boundTextures.size() < item.textureCount)
+            _boundTextures.resize(item.textureCount, nullptr);
+        for(std::size_t i = 0; i != item.textureCount; ++i) {
+            AbstractTexture* const texture = _textures[item.textureOffset + i];
+            if(!texture) continue;
+
+            if(_boundTextures[i] == texture) ++_textureBindsAvoided;
+            else {
+                texture->bind(i);
+                _boundTextures[i] = texture;
+            }
+        }
+
+        if(item.setup) item.setup();
+        if(item.uniformSetup) item.uniformSetup(*item.shader, item.uniforms);
+
+        item.mesh->draw(*item.shader);
+        ++_drawCount;
+    }
+
+    if(previousPrePassed) Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+
+    clear();
+}
+
+}
@@ -0,0 +1,381 @@
+#ifndef Magnum_RenderQueue_h
+#define Magnum_RenderQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RenderQueue
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include "Magnum/CommandBuffer.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum {
+
+/**
+@brief Sorting render queue
+
+Drawing objects in the order they were added (for example in order of a
+@ref SceneGraph::DrawableGroup) causes the shader, texture and mesh bindings
+to change with nearly every draw. The queue collects the draws, sorts them by
+the state they need and then submits them so that draws using the same state
+are done one after another and the textures are bound only when they differ
+from the previously bound ones.
+
+## Usage
+
+Instead of drawing directly, the drawables add themselves to the queue, with
+the per-object uniform setup done in a callback. The depth is used for
+ordering draws with the same state or, optionally, all draws:
+@code
+RenderQueue queue;
+
+class RedCube: public Object3D, public SceneGraph::Drawable3D {
+    public:
+        explicit RedCube(Object3D* parent, SceneGraph::DrawableGroup3D* group, RenderQueue& queue);
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            Shaders::Phong& shader = _shader;
+            const Matrix4 projectionMatrix = camera.projectionMatrix();
+            _queue.add(_shader, _mesh, {&_texture}, -transformationMatrix.translation().z(), [&shader, transformationMatrix, projectionMatrix]() {
+                shader.setTransformationMatrix(transformationMatrix)
+                    .setNormalMatrix(transformationMatrix.rotation())
+                    .setProjectionMatrix(projectionMatrix);
+            });
+        }
+
+        RenderQueue& _queue;
+        // ...
+};
+
+// each frame
+camera.draw(drawables);
+queue.draw();
+Debug() << queue.shaderBindsAvoided() << queue.textureBindsAvoided() << queue.meshBindsAvoided();
+@endcode
+
+The callback should not bind any textures itself, as the queue tracks the
+bindings it did. The order of draws with the same sort key is preserved.
+
+## Multi-threaded recording
+
+The draws can also be recorded on worker threads into a @ref CommandBuffer
+and then added to the queue with @ref add(const CommandBuffer&) on the GL
+thread, see its documentation for an example. Such draws can also carry a
+@ref RenderState, which is applied only when it differs from the state of the
+previous draw.
+
+## Sorting
+
+The draws are sorted using a radix sort on 64-bit keys consisting of a
+shader and render state, texture set, mesh and quantized depth index. With @ref Order::State
+the depth is used only to order draws sharing the same state front to back.
+@ref Order::FrontToBack makes the depth the most significant part of the key,
+which reduces overdraw of opaque geometry at the cost of more state changes,
+and @ref Order::BackToFront is meant for blended geometry.
+
+@anchor RenderQueue-depth-pre-pass
+## Depth pre-pass
+
+For fragment-heavy opaque geometry, a depth pre-pass avoids shading of
+occluded fragments completely, while keeping the draws grouped by state.
+Enable it with a depth-only shader, for example @ref Shaders::ShadowDepth,
+and a function that sets its transformation and projection matrix, then add
+the opaque draws using @ref addOpaque():
+@code
+Shaders::ShadowDepth depthShader;
+queue.setDepthPrePass(depthShader, [](AbstractShaderProgram& shader, const Matrix4& transformationProjectionMatrix) {
+    static_cast<Shaders::ShadowDepth&>(shader)
+        .setTransformationProjectionMatrix(transformationProjectionMatrix);
+});
+
+// in RedCube::draw()
+Shaders::Phong& shader = _shader;
+const Matrix4 projectionMatrix = camera.projectionMatrix();
+_queue.addOpaque(_shader, _mesh, {&_texture}, projectionMatrix*transformationMatrix, -transformationMatrix.translation().z(), [&shader, transformationMatrix, projectionMatrix]() {
+    shader.setTransformationMatrix(transformationMatrix)
+        .setNormalMatrix(transformationMatrix.rotation())
+        .setProjectionMatrix(projectionMatrix);
+});
+@endcode
+
+In @ref draw(), the opaque draws are first submitted with the depth-only
+shader and color writes disabled, ordered front to back regardless of
+@ref order(). Then all draws are submitted in @ref order() as usual, with
+the opaque ones using the depth function passed to @ref setDepthPrePass().
+Depth test needs to be enabled and depth writes allowed. Draws added with
+@ref add() don't take part in the pre-pass and use the default
+@ref Renderer::DepthFunction::Less, unless their @ref RenderState says
+otherwise. Render state of the draws is not applied in the pre-pass, draws
+recorded in a @ref CommandBuffer don't take part in it.
+*/
+class MAGNUM_EXPORT RenderQueue {
+    public:
+        /**
+         * @brief Draw order
+         *
+         * @see @ref setOrder()
+         */
+        enum class Order: UnsignedByte {
+            /**
+             * Group draws by state, draws with the same state are ordered
+             * front to back.
+             */
+            State,
+
+            /**
+             * Order draws front to back, draws with the same depth are
+             * grouped by state.
+             */
+            FrontToBack,
+
+            /**
+             * Order draws back to front, draws with the same depth are
+             * grouped by state.
+             */
+            BackToFront
+        };
+
+        /**
+         * @brief Depth pre-pass setup function
+         *
+         * Called before each draw in the depth pre-pass with the shader and
+         * the matrix passed to @ref addOpaque().
+         * @see @ref setDepthPrePass()
+         */
+        typedef void(*DepthPrePassSetup)(AbstractShaderProgram&, const Matrix4&);
+
+        /**
+         * @brief Constructor
+         * @param order     Draw order
+         */
+        explicit RenderQueue(Order order = Order::State);
+
+        /** @brief Draw order */
+        Order order() const { return _order; }
+
+        /**
+         * @brief Set draw order
+         * @return Reference to self (for method chaining)
+         *
+         * Default is set in constructor.
+         */
+        RenderQueue& setOrder(Order order) {
+            _order = order;
+            return *this;
+        }
+
+        /**
+         * @brief Whether depth pre-pass is enabled
+         *
+         * @see @ref setDepthPrePass(), @ref disableDepthPrePass()
+         */
+        bool isDepthPrePassEnabled() const { return _prePassShader; }
+
+        /**
+         * @brief Enable depth pre-pass
+         * @param shader    Depth-only shader
+         * @param setup     Function setting the transformation and
+         *      projection matrix of @p shader
+         * @param function  Depth function for the draws in the main pass.
+         *      @ref Renderer::DepthFunction::Equal rejects the most
+         *      fragments, but needs the depth-only shader to calculate
+         *      exactly the same positions as the main shaders.
+         * @return Reference to self (for method chaining)
+         *
+         * The shader needs to be kept alive until the pre-pass is disabled
+         * or the queue is destroyed. See @ref RenderQueue-depth-pre-pass "class documentation"
+         * for more information.
+         */
+        RenderQueue& setDepthPrePass(AbstractShaderProgram& shader, DepthPrePassSetup setup, Renderer::DepthFunction function = Renderer::DepthFunction::LessOrEqual);
+
+        /**
+         * @brief Disable depth pre-pass
+         * @return Reference to self (for method chaining)
+         *
+         * Draws added using @ref addOpaque() are then treated the same as
+         * draws added using @ref add().
+         */
+        RenderQueue& disableDepthPrePass();
+
+        /** @brief Count of queued draws */
+        std::size_t size() const { return _items.size(); }
+
+        /**
+         * @brief Add a draw to the queue
+         * @param shader    Shader to draw with
+         * @param mesh      Mesh to draw
+         * @param textures  Textures to bind to consecutive layers starting
+         *      from `0`. Null pointers are skipped.
+         * @param depth     Distance from camera. Negative values are treated
+         *      as `0.0f`.
+         * @param setup     Function called right before the draw, for
+         *      setting uniforms
+         * @return Reference to self (for method chaining)
+         *
+         * The shader, mesh and textures need to be kept alive until
+         * @ref draw() is called.
+         */
+        RenderQueue& add(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, Float depth, std::function<void()> setup = {});
+
+        /** @overload */
+        RenderQueue& add(AbstractShaderProgram& shader, Mesh& mesh, Float depth, std::function<void()> setup = {}) {
+            return add(shader, mesh, {}, depth, std::move(setup));
+        }
+
+        /**
+         * @brief Add an opaque draw to the queue
+         * @param shader    Shader to draw with
+         * @param mesh      Mesh to draw
+         * @param textures  Textures to bind to consecutive layers starting
+         *      from `0`. Null pointers are skipped.
+         * @param transformationProjectionMatrix Transformation and projection
+         *      matrix for the depth pre-pass
+         * @param depth     Distance from camera. Negative values are treated
+         *      as `0.0f`.
+         * @param setup     Function called right before the draw, for
+         *      setting uniforms
+         * @return Reference to self (for method chaining)
+         *
+         * Same as @ref add(), but the draw takes part in the depth pre-pass,
+         * if enabled.
+         * @see @ref setDepthPrePass()
+         */
+        RenderQueue& addOpaque(AbstractShaderProgram& shader, Mesh& mesh, std::initializer_list<AbstractTexture*> textures, const Matrix4& transformationProjectionMatrix, Float depth, std::function<void()> setup = {});
+
+        /** @overload */
+        RenderQueue& addOpaque(AbstractShaderProgram& shader, Mesh& mesh, const Matrix4& transformationProjectionMatrix, Float depth, std::function<void()> setup = {}) {
+            return addOpaque(shader, mesh, {}, transformationProjectionMatrix, depth, std::move(setup));
+        }
+
+        /**
+         * @brief Add recorded draw packets to the queue
+         * @return Reference to self (for method chaining)
+         *
+         * Copies the packets recorded in @p buffer into the queue. Meant to be
+         * called on the GL thread after the worker threads filling the
+         * buffers are done. The packets point into arena of @p buffer, so it
+         * can't be cleared or destroyed until @ref draw() or @ref clear() is
+         * called.
+         */
+        RenderQueue& add(const CommandBuffer& buffer);
+
+        /**
+         * @brief Sort and submit queued draws
+         *
+         * If depth pre-pass is enabled, first draws the opaque draws with the
+         * depth-only shader. Sorts the draws according to @ref order(), then
+         * for each of them
+         * applies the render state if it differs from the previous draw,
+         * binds the textures that differ from the ones bound by previous
+         * draws, calls the setup function and draws the mesh. Clears the
+         * queue afterwards, the statistics are available until next call.
+         * @see @ref Mesh::draw(), @ref AbstractTexture::bind(),
+         *      @ref Renderer::setState()
+         */
+        void draw();
+
+        /**
+         * @brief Discard queued draws
+         *
+         * Keeps the allocated memory for reuse in next frame.
+         */
+        void clear();
+
+        /** @brief Count of draws submitted in last @ref draw() */
+        std::size_t drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Count of depth pre-pass draws submitted in last @ref draw()
+         *
+         * Not included in @ref drawCount().
+         */
+        std::size_t prePassDrawCount() const { return _prePassDrawCount; }
+
+        /**
+         * @brief Count of shader changes avoided in last @ref draw()
+         *
+         * Count of draws that use the same shader as the draw before.
+         */
+        std::size_t shaderBindsAvoided() const { return _shaderBindsAvoided; }
+
+        /**
+         * @brief Count of texture binds avoided in last @ref draw()
+         *
+         * Count of textures that were already bound to given layer by the
+         * draw before.
+         */
+        std::size_t textureBindsAvoided() const { return _textureBindsAvoided; }
+
+        /**
+         * @brief Count of mesh binds avoided in last @ref draw()
+         *
+         * Count of draws that use the same mesh as the draw before.
+         */
+        std::size_t meshBindsAvoided() const { return _meshBindsAvoided; }
+
+    private:
+        struct Item {
+            AbstractShaderProgram* shader;
+            Mesh* mesh;
+            std::size_t textureOffset, textureCount;
+            Float depth;
+            std::function<void()> setup;
+            const RenderState* state;
+            CommandBuffer::UniformSetup uniformSetup;
+            const void* uniforms;
+            UnsignedInt prePassMatrix;
+        };
+
+        enum: UnsignedInt { NoPrePass = ~UnsignedInt{} };
+
+        void MAGNUM_LOCAL sort();
+
+        Order _order;
+        std::vector<Item> _items;
+        std::vector<AbstractTexture*> _textures;
+        std::vector<Matrix4> _prePassMatrices;
+
+        AbstractShaderProgram* _prePassShader;
+        DepthPrePassSetup _prePassSetup;
+        Renderer::DepthFunction _prePassDepthFunction;
+
+        /* Temporary storage for draw(), reused to avoid allocations */
+        std::vector<UnsignedLong> _keys, _keysTemporary;
+        std::vector<UnsignedInt> _indices, _indicesTemporary;
+        std::vector<AbstractTexture*> _boundTextures;
+
+        std::size_t _drawCount, _prePassDrawCount, _shaderBindsAvoided, _textureBindsAvoided, _meshBindsAvoided;
+};
+
+}
+
+#endif
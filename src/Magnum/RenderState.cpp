@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderState.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+namespace {
+    /* Tracked features, the slots for features not available on given target
+       are zero */
+    constexpr Renderer::Feature Features[]{
+        #ifndef MAGNUM_TARGET_WEBGL
+        Renderer::Feature::BlendAdvancedCoherent,
+        #else
+        Renderer::Feature{},
+        #endif
+        Renderer::Feature::Blending,
+        #ifndef MAGNUM_TARGET_WEBGL
+        Renderer::Feature::DebugOutput,
+        Renderer::Feature::DebugOutputSynchronous,
+        #else
+        Renderer::Feature{},
+        Renderer::Feature{},
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Renderer::Feature::DepthClamp,
+        #else
+        Renderer::Feature{},
+        #endif
+        Renderer::Feature::DepthTest,
+        Renderer::Feature::Dithering,
+        Renderer::Feature::FaceCulling,
+        #ifndef MAGNUM_TARGET_WEBGL
+        Renderer::Feature::FramebufferSRGB,
+        #else
+        Renderer::Feature{},
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Renderer::Feature::LogicOperation,
+        Renderer::Feature::Multisampling,
+        #else
+        Renderer::Feature{},
+        Renderer::Feature{},
+        #endif
+        Renderer::Feature::PolygonOffsetFill,
+        #ifndef MAGNUM_TARGET_WEBGL
+        Renderer::Feature::PolygonOffsetLine,
+        Renderer::Feature::PolygonOffsetPoint,
+        #else
+        Renderer::Feature{},
+        Renderer::Feature{},
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Renderer::Feature::ProgramPointSize,
+        #else
+        Renderer::Feature{},
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        Renderer::Feature::RasterizerDiscard,
+        #else
+        Renderer::Feature{},
+        #endif
+        Renderer::Feature::ScissorTest,
+        #ifndef MAGNUM_TARGET_GLES
+        Renderer::Feature::SeamlessCubeMapTexture,
+        #else
+        Renderer::Feature{},
+        #endif
+        Renderer::Feature::StencilTest
+    };
+}
+
+RenderState::RenderState() = default;
+
+std::size_t RenderState::featureIndex(const Renderer::Feature feature) {
+    static_assert(sizeof(Features)/sizeof(Features[0]) == FeatureCount,
+        "improper size of the feature table");
+
+    for(std::size_t i = 0; i != FeatureCount; ++i)
+        if(Features[i] == feature) return i;
+
+    /* Feature value cast from some other GL enum */
+    return FeatureCount;
+}
+
+Renderer::Feature RenderState::feature(const std::size_t index) {
+    return Features[index];
+}
+
+std::pair<std::size_t, std::size_t> RenderState::stencilFaces(const Renderer::PolygonFacing facing) {
+    switch(facing) {
+        case Renderer::PolygonFacing::Front: return {0, 1};
+        case Renderer::PolygonFacing::Back: return {1, 2};
+        case Renderer::PolygonFacing::FrontAndBack: return {0, 2};
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+RenderState& RenderState::setFeature(const Renderer::Feature feature, const bool enabled) {
+    const std::size_t index = featureIndex(feature);
+    CORRADE_ASSERT(index != FeatureCount,
+        "RenderState::setFeature(): feature" << GLenum(feature) << "can't be tracked", *this);
+    _features[index] = enabled;
+    return *this;
+}
+
+RenderState& RenderState::setStencilFunction(const Renderer::PolygonFacing facing, const Renderer::StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    const std::pair<std::size_t, std::size_t> faces = stencilFaces(facing);
+    for(std::size_t i = faces.first; i != faces.second; ++i)
+        _stencilFunction[i] = Vector3ui{GLenum(function), UnsignedInt(referenceValue), mask};
+    return *this;
+}
+
+RenderState& RenderState::setStencilOperation(const Renderer::PolygonFacing facing, const Renderer::StencilOperation stencilFail, const Renderer::StencilOperation depthFail, const Renderer::StencilOperation depthPass) {
+    const std::pair<std::size_t, std::size_t> faces = stencilFaces(facing);
+    for(std::size_t i = faces.first; i != faces.second; ++i)
+        _stencilOperation[i] = Vector3ui{GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)};
+    return *this;
+}
+
+RenderState& RenderState::setStencilMask(const Renderer::PolygonFacing facing, const UnsignedInt allowBits) {
+    const std::pair<std::size_t, std::size_t> faces = stencilFaces(facing);
+    for(std::size_t i = faces.first; i != faces.second; ++i)
+        _stencilMask[i] = allowBits;
+    return *this;
+}
+
+}
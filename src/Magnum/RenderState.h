@@ -0,0 +1,305 @@
+#ifndef Magnum_RenderState_h
+#define Magnum_RenderState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RenderState
+ */
+
+#include <utility>
+
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum {
+
+/**
+@brief Render state block
+
+Describes a subset of the fixed-function state set through @ref Renderer ---
+enabled features, face culling, polygon offset, depth, stencil and blending
+state. The object is meant to be created once for each distinct way of
+rendering and then applied using @ref Renderer::setState() before drawing:
+@code
+const RenderState transparentState = RenderState{}
+    .enable(Renderer::Feature::Blending)
+    .enable(Renderer::Feature::DepthTest)
+    .setDepthMask(false)
+    .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha);
+
+// in draw()
+Renderer::setState(transparentState);
+mesh.draw(shader);
+@endcode
+
+State that wasn't set in the object is left untouched when applying it, so
+each drawable should describe all state it depends on.
+
+## Redundant state filtering
+
+@ref Renderer keeps a shadow copy of all state listed above and skips the GL
+calls that wouldn't change anything, both when applying a state block and
+when calling @ref Renderer::enable(), @ref Renderer::setBlendFunction() and
+others directly. Applying a state block thus costs only the calls for state
+that actually differs from what the previous drawable used. If the state is
+modified by other means than through @ref Renderer (for example by a
+third-party library sharing the context), call
+@ref Context::resetState() "Context::resetState(Context::State::Renderer)"
+to invalidate the shadow copy.
+
+Only the features listed in @ref Renderer::Feature can be tracked, other
+(cast) feature values are always passed through directly to GL in
+@ref Renderer::enable() and @ref Renderer::disable() and can't be put in a
+state block.
+*/
+class MAGNUM_EXPORT RenderState {
+    friend Renderer;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty state block that changes nothing when applied.
+         */
+        /*implicit*/ RenderState();
+
+        /**
+         * @brief Enable feature
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::enable()
+         */
+        RenderState& enable(Renderer::Feature feature) {
+            return setFeature(feature, true);
+        }
+
+        /**
+         * @brief Disable feature
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::disable()
+         */
+        RenderState& disable(Renderer::Feature feature) {
+            return setFeature(feature, false);
+        }
+
+        /**
+         * @brief Enable or disable feature
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFeature()
+         */
+        RenderState& setFeature(Renderer::Feature feature, bool enabled);
+
+        /**
+         * @brief Set front-facing polygon winding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFrontFace()
+         */
+        RenderState& setFrontFace(Renderer::FrontFace mode) {
+            _frontFace = GLenum(mode);
+            return *this;
+        }
+
+        /**
+         * @brief Set which polygon facing to cull
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFaceCullingMode()
+         */
+        RenderState& setFaceCullingMode(Renderer::PolygonFacing mode) {
+            _faceCullingMode = GLenum(mode);
+            return *this;
+        }
+
+        /**
+         * @brief Set polygon offset
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setPolygonOffset()
+         */
+        RenderState& setPolygonOffset(Float factor, Float units) {
+            _polygonOffset = Vector2{factor, units};
+            return *this;
+        }
+
+        /**
+         * @brief Set stencil function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilFunction()
+         */
+        RenderState& setStencilFunction(Renderer::PolygonFacing facing, Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask);
+
+        /** @overload */
+        RenderState& setStencilFunction(Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask) {
+            return setStencilFunction(Renderer::PolygonFacing::FrontAndBack, function, referenceValue, mask);
+        }
+
+        /**
+         * @brief Set stencil operation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilOperation()
+         */
+        RenderState& setStencilOperation(Renderer::PolygonFacing facing, Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass);
+
+        /** @overload */
+        RenderState& setStencilOperation(Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass) {
+            return setStencilOperation(Renderer::PolygonFacing::FrontAndBack, stencilFail, depthFail, depthPass);
+        }
+
+        /**
+         * @brief Mask stencil writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilMask()
+         */
+        RenderState& setStencilMask(Renderer::PolygonFacing facing, UnsignedInt allowBits);
+
+        /** @overload */
+        RenderState& setStencilMask(UnsignedInt allowBits) {
+            return setStencilMask(Renderer::PolygonFacing::FrontAndBack, allowBits);
+        }
+
+        /**
+         * @brief Set depth function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthFunction()
+         */
+        RenderState& setDepthFunction(Renderer::DepthFunction function) {
+            _depthFunction = GLenum(function);
+            return *this;
+        }
+
+        /**
+         * @brief Mask color writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setColorMask()
+         */
+        RenderState& setColorMask(GLboolean allowRed, GLboolean allowGreen, GLboolean allowBlue, GLboolean allowAlpha) {
+            _colorMask = Math::Vector4<GLboolean>{allowRed, allowGreen, allowBlue, allowAlpha};
+            return *this;
+        }
+
+        /**
+         * @brief Mask depth writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthMask()
+         */
+        RenderState& setDepthMask(GLboolean allow) {
+            _depthMask = allow;
+            return *this;
+        }
+
+        /**
+         * @brief Set blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation()
+         */
+        RenderState& setBlendEquation(Renderer::BlendEquation equation) {
+            return setBlendEquation(equation, equation);
+        }
+
+        /**
+         * @brief Set blend equation separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation()
+         */
+        RenderState& setBlendEquation(Renderer::BlendEquation rgb, Renderer::BlendEquation alpha) {
+            _blendEquation = Vector2ui{GLenum(rgb), GLenum(alpha)};
+            return *this;
+        }
+
+        /**
+         * @brief Set blend function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction()
+         */
+        RenderState& setBlendFunction(Renderer::BlendFunction source, Renderer::BlendFunction destination) {
+            return setBlendFunction(source, destination, source, destination);
+        }
+
+        /**
+         * @brief Set blend function separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction()
+         */
+        RenderState& setBlendFunction(Renderer::BlendFunction sourceRgb, Renderer::BlendFunction destinationRgb, Renderer::BlendFunction sourceAlpha, Renderer::BlendFunction destinationAlpha) {
+            _blendFunction = Vector4ui{GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)};
+            return *this;
+        }
+
+        /**
+         * @brief Set blend color
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendColor()
+         */
+        RenderState& setBlendColor(const Color4& color) {
+            _blendColor = color;
+            return *this;
+        }
+
+    private:
+        /* Features from Renderer::Feature enum, in order. Not all of them are
+           available on all targets, the unused slots are never set. */
+        enum: std::size_t { FeatureCount = 19 };
+
+        /* Index into the feature array or FeatureCount if the feature is not
+           tracked */
+        static MAGNUM_LOCAL std::size_t featureIndex(Renderer::Feature feature);
+        static MAGNUM_LOCAL Renderer::Feature feature(std::size_t index);
+
+        /* Range of affected stencil state indices for given facing */
+        static MAGNUM_LOCAL std::pair<std::size_t, std::size_t> stencilFaces(Renderer::PolygonFacing facing);
+
+        std::optional<bool> _features[FeatureCount];
+        std::optional<GLenum> _frontFace, _faceCullingMode, _depthFunction;
+        std::optional<Vector2> _polygonOffset;
+        /* Index 0 is front face, 1 is back face. Stencil function is stored
+           as function, reference value and mask. */
+        std::optional<Vector3ui> _stencilFunction[2], _stencilOperation[2];
+        std::optional<UnsignedInt> _stencilMask[2];
+        std::optional<Math::Vector4<GLboolean>> _colorMask;
+        std::optional<GLboolean> _depthMask;
+        std::optional<Vector2ui> _blendEquation;
+        std::optional<Vector4ui> _blendFunction;
+        std::optional<Color4> _blendColor;
+};
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum {
+
+namespace {
+
+bool isDepthFormat(const TextureFormat format) {
+    switch(format) {
+        case TextureFormat::DepthComponent:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::DepthComponent16:
+        case TextureFormat::DepthComponent24:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::DepthComponent32F:
+        #endif
+        case TextureFormat::DepthStencil:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::Depth32FStencil8:
+        #endif
+            return true;
+
+        default: return false;
+    }
+}
+
+struct PooledTexture {
+    TextureFormat format;
+    Vector2i size;
+    std::unique_ptr<Texture2D> texture;
+    UnsignedLong lastUsed;
+};
+
+struct PooledRenderbuffer {
+    RenderbufferFormat format;
+    Vector2i size;
+    Int samples;
+    std::unique_ptr<Renderbuffer> renderbuffer;
+    UnsignedLong lastUsed;
+};
+
+/* Attachment set of a cached framebuffer. Only targets owned by the pool can
+   be attached, so the addresses are stable and framebuffers referencing a
+   target are deleted together with it, which makes the address a safe key. */
+struct CachedAttachment {
+    GLenum attachment;
+    const void* target;
+
+    bool operator==(const CachedAttachment& other) const {
+        return attachment == other.attachment && target == other.target;
+    }
+};
+
+struct CachedFramebuffer {
+    std::vector<CachedAttachment> attachments;
+    std::unique_ptr<Framebuffer> framebuffer;
+    UnsignedLong lastUsed;
+};
+
+}
+
+struct RenderTargetPool::State {
+    UnsignedInt maxIdleFrames;
+    UnsignedLong frame{};
+    std::size_t activeCount{};
+    std::vector<PooledTexture> textures;
+    std::vector<PooledRenderbuffer> renderbuffers;
+    std::vector<CachedFramebuffer> framebuffers;
+
+    /* Temporary storage for framebuffer(), reused to avoid allocations */
+    std::vector<CachedAttachment> attachments;
+};
+
+RenderTargetPool::RenderTargetPool(const UnsignedInt maxIdleFrames): _state{new State} {
+    _state->maxIdleFrames = maxIdleFrames;
+}
+
+RenderTargetPool::RenderTargetPool(RenderTargetPool&&) noexcept = default;
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+RenderTargetPool& RenderTargetPool::operator=(RenderTargetPool&&) noexcept = default;
+
+UnsignedInt RenderTargetPool::maxIdleFrames() const { return _state->maxIdleFrames; }
+
+RenderTargetPool& RenderTargetPool::setMaxIdleFrames(const UnsignedInt frames) {
+    _state->maxIdleFrames = frames;
+    return *this;
+}
+
+UnsignedLong RenderTargetPool::frame() const { return _state->frame; }
+
+std::size_t RenderTargetPool::textureCount() const { return _state->textures.size(); }
+
+std::size_t RenderTargetPool::renderbufferCount() const { return _state->renderbuffers.size(); }
+
+std::size_t RenderTargetPool::framebufferCount() const { return _state->framebuffers.size(); }
+
+std::size_t RenderTargetPool::activeCount() const { return _state->activeCount; }
+
+Texture2D& RenderTargetPool::texture(const TextureFormat format, const Vector2i& size) {
+    State& state = *_state;
+    ++state.activeCount;
+
+    for(PooledTexture& p: state.textures) if(p.lastUsed != state.frame && p.format == format && p.size == size) {
+        p.lastUsed = state.frame;
+        return *p.texture;
+    }
+
+    std::unique_ptr<Texture2D> texture{new Texture2D};
+    const Sampler::Filter filter = isDepthFormat(format) ? Sampler::Filter::Nearest : Sampler::Filter::Linear;
+    texture->setMinificationFilter(filter)
+        .setMagnificationFilter(filter)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, format, size);
+    state.textures.push_back({format, size, std::move(texture), state.frame});
+    return *state.textures.back().texture;
+}
+
+Renderbuffer& RenderTargetPool::renderbuffer(const RenderbufferFormat format, const Vector2i& size, const Int samples) {
+    #if defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    CORRADE_ASSERT(!samples,
+        "RenderTargetPool::renderbuffer(): multisample renderbuffers are not available in WebGL 1.0", *static_cast<Renderbuffer*>(nullptr));
+    #endif
+
+    State& state = *_state;
+    ++state.activeCount;
+
+    for(PooledRenderbuffer& p: state.renderbuffers) if(p.lastUsed != state.frame && p.format == format && p.size == size && p.samples == samples) {
+        p.lastUsed = state.frame;
+        return *p.renderbuffer;
+    }
+
+    std::unique_ptr<Renderbuffer> renderbuffer{new Renderbuffer};
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    if(samples) renderbuffer->setStorageMultisample(samples, format, size);
+    else
+    #endif
+        renderbuffer->setStorage(format, size);
+    state.renderbuffers.push_back({format, size, samples, std::move(renderbuffer), state.frame});
+    return *state.renderbuffers.back().renderbuffer;
+}
+
+Framebuffer& RenderTargetPool::framebuffer(const std::initializer_list<Attachment> attachments) {
+    CORRADE_ASSERT(attachments.size(),
+        "RenderTargetPool::framebuffer(): no attachments given", *static_cast<Framebuffer*>(nullptr));
+
+    State& state = *_state;
+
+    /* Gather the attachment set and verify that the targets are ours */
+    state.attachments.clear();
+    Vector2i size;
+    for(const Attachment& a: attachments) {
+        Vector2i attachmentSize;
+        const void* target = nullptr;
+        if(a.texture()) {
+            for(const PooledTexture& p: state.textures) if(p.texture.get() == a.texture()) {
+                target = p.texture.get();
+                attachmentSize = p.size;
+                break;
+            }
+        } else {
+            for(const PooledRenderbuffer& p: state.renderbuffers) if(p.renderbuffer.get() == a.renderbuffer()) {
+                target = p.renderbuffer.get();
+                attachmentSize = p.size;
+                break;
+            }
+        }
+        CORRADE_ASSERT(target,
+            "RenderTargetPool::framebuffer(): attachment" << state.attachments.size() << "is not owned by the pool", *static_cast<Framebuffer*>(nullptr));
+        CORRADE_ASSERT(state.attachments.empty() || attachmentSize == size,
+            "RenderTargetPool::framebuffer(): attachments have different sizes", *static_cast<Framebuffer*>(nullptr));
+
+        size = attachmentSize;
+        state.attachments.push_back({GLenum(a.attachment()), target});
+    }
+
+    /* Cached framebuffer with the same attachment set */
+    for(CachedFramebuffer& f: state.framebuffers) if(f.attachments == state.attachments) {
+        f.lastUsed = state.frame;
+        return *f.framebuffer;
+    }
+
+    std::unique_ptr<Framebuffer> framebuffer{new Framebuffer{{{}, size}}};
+    std::vector<std::pair<UnsignedInt, Framebuffer::DrawAttachment>> drawAttachments;
+    for(const Attachment& a: attachments) {
+        if(a.texture()) framebuffer->attachTexture(a.attachment(), *a.texture(), 0);
+        else framebuffer->attachRenderbuffer(a.attachment(), *a.renderbuffer());
+
+        const UnsignedInt colorIndex = GLenum(a.attachment()) - GL_COLOR_ATTACHMENT0;
+        if(colorIndex < 32)
+            drawAttachments.emplace_back(UnsignedInt(drawAttachments.size()), Framebuffer::ColorAttachment{colorIndex});
+    }
+    if(drawAttachments.size() > 1)
+        framebuffer->mapForDraw(drawAttachments);
+
+    /* Checked only once, the attachment set never changes afterwards */
+    const Framebuffer::Status status = framebuffer->checkStatus(FramebufferTarget::Draw);
+    if(status != Framebuffer::Status::Complete)
+        Error() << "RenderTargetPool::framebuffer(): framebuffer is not complete:" << status;
+
+    state.framebuffers.push_back({state.attachments, std::move(framebuffer), state.frame});
+    return *state.framebuffers.back().framebuffer;
+}
+
+void RenderTargetPool::nextFrame() {
+    State& state = *_state;
+    ++state.frame;
+    state.activeCount = 0;
+
+    /* Used in the frame that just ended has no idle frames */
+    const auto expired = [&state](const UnsignedLong lastUsed) {
+        return state.frame - lastUsed - 1 > state.maxIdleFrames;
+    };
+
+    /* Delete framebuffers first, either because they are not used anymore or
+       because some of their attachments are about to be deleted */
+    std::vector<const void*> deleted;
+    for(const PooledTexture& p: state.textures)
+        if(expired(p.lastUsed)) deleted.push_back(p.texture.get());
+    for(const PooledRenderbuffer& p: state.renderbuffers)
+        if(expired(p.lastUsed)) deleted.push_back(p.renderbuffer.get());
+    state.framebuffers.erase(std::remove_if(state.framebuffers.begin(), state.framebuffers.end(), [&](const CachedFramebuffer& f) {
+        if(expired(f.lastUsed)) return true;
+        for(const CachedAttachment& a: f.attachments)
+            if(std::find(deleted.begin(), deleted.end(), a.target) != deleted.end()) return true;
+        return false;
+    }), state.framebuffers.end());
+
+    state.textures.erase(std::remove_if(state.textures.begin(), state.textures.end(), [&](const PooledTexture& p) {
+        return expired(p.lastUsed);
+    }), state.textures.end());
+    state.renderbuffers.erase(std::remove_if(state.renderbuffers.begin(), state.renderbuffers.end(), [&](const PooledRenderbuffer& p) {
+        return expired(p.lastUsed);
+    }), state.renderbuffers.end());
+}
+
+}
@@ -0,0 +1,239 @@
+#ifndef Magnum_RenderTargetPool_h
+#define Magnum_RenderTargetPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RenderTargetPool
+ */
+
+#include <initializer_list>
+#include <memory>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pool of transient render targets
+
+Post-processing, picking, shadow or tiled capture passes usually need a few
+textures and renderbuffers only for the duration of a frame. Allocating them
+separately in each subsystem and reallocating all of them on every window
+resize fragments the video memory and causes hitches. This class keeps a
+shared pool of such render targets keyed by format, size and sample count:
+@ref texture() and @ref renderbuffer() hand out a target that is not yet used
+in the current frame (creating a new one if there is none) and
+@ref framebuffer() returns a framebuffer with given attachments, created and
+checked for completeness only the first time given attachment set is
+requested. Example usage:
+@code
+RenderTargetPool pool;
+
+// each frame
+Texture2D& color = pool.texture(TextureFormat::RGBA8, viewport);
+Renderbuffer& depth = pool.renderbuffer(RenderbufferFormat::DepthComponent24, viewport);
+pool.framebuffer({{Framebuffer::ColorAttachment{0}, color},
+                  {Framebuffer::BufferAttachment::Depth, depth}})
+    .clear(FramebufferClear::Color|FramebufferClear::Depth)
+    .bind();
+// rendering...
+
+pool.nextFrame();
+@endcode
+
+Targets handed out in a frame are returned back to the pool in
+@ref nextFrame(). Targets that were not used for more than
+@ref maxIdleFrames() frames are deleted there together with all framebuffers
+referencing them, so after a resize the targets with the old size go away
+after a few frames while in steady state no GL objects are created. The
+returned references stay valid until the target is deleted.
+
+Textures are created with a single level, clamp-to-edge wrapping and linear
+filtering (nearest for depth formats). Multisampled targets are supported only
+through @ref renderbuffer(), use them together with
+@ref AbstractFramebuffer::blit() to resolve the result.
+@see @ref FrameGraph
+*/
+class MAGNUM_EXPORT RenderTargetPool {
+    public:
+        /**
+         * @brief Framebuffer attachment
+         *
+         * @see @ref framebuffer()
+         */
+        class Attachment {
+            public:
+                /** @brief Texture attachment */
+                /*implicit*/ Attachment(Framebuffer::BufferAttachment attachment, Texture2D& texture): _attachment{attachment}, _texture{&texture}, _renderbuffer{} {}
+
+                /** @brief Renderbuffer attachment */
+                /*implicit*/ Attachment(Framebuffer::BufferAttachment attachment, Renderbuffer& renderbuffer): _attachment{attachment}, _texture{}, _renderbuffer{&renderbuffer} {}
+
+                /** @brief Attachment point */
+                Framebuffer::BufferAttachment attachment() const { return _attachment; }
+
+                /** @brief Attached texture or `nullptr` if this is a renderbuffer attachment */
+                Texture2D* texture() const { return _texture; }
+
+                /** @brief Attached renderbuffer or `nullptr` if this is a texture attachment */
+                Renderbuffer* renderbuffer() const { return _renderbuffer; }
+
+            private:
+                Framebuffer::BufferAttachment _attachment;
+                Texture2D* _texture;
+                Renderbuffer* _renderbuffer;
+        };
+
+        /**
+         * @brief Constructor
+         * @param maxIdleFrames     How many frames can a target stay unused
+         *      before it's deleted
+         *
+         * No GL objects are created until the first call to @ref texture(),
+         * @ref renderbuffer() or @ref framebuffer().
+         */
+        explicit RenderTargetPool(UnsignedInt maxIdleFrames = 3);
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool(const RenderTargetPool&) = delete;
+
+        /** @brief Move constructor */
+        RenderTargetPool(RenderTargetPool&&) noexcept;
+
+        ~RenderTargetPool();
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        /** @brief Move assignment */
+        RenderTargetPool& operator=(RenderTargetPool&&) noexcept;
+
+        /** @brief Max idle frame count */
+        UnsignedInt maxIdleFrames() const;
+
+        /**
+         * @brief Set max idle frame count
+         * @return Reference to self (for method chaining)
+         *
+         * Targets and framebuffers not used for more than @p frames frames are
+         * deleted in @ref nextFrame(). With `0` everything that was
+         * not used in the frame that just ended is deleted. Default is
+         * `3`.
+         */
+        RenderTargetPool& setMaxIdleFrames(UnsignedInt frames);
+
+        /**
+         * @brief Count of frames passed
+         *
+         * Count of @ref nextFrame() calls.
+         */
+        UnsignedLong frame() const;
+
+        /**
+         * @brief Count of pooled textures
+         *
+         * Both free and used in current frame.
+         * @see @ref activeCount()
+         */
+        std::size_t textureCount() const;
+
+        /**
+         * @brief Count of pooled renderbuffers
+         *
+         * Both free and used in current frame.
+         * @see @ref activeCount()
+         */
+        std::size_t renderbufferCount() const;
+
+        /** @brief Count of cached framebuffers */
+        std::size_t framebufferCount() const;
+
+        /**
+         * @brief Count of textures and renderbuffers used in current frame
+         *
+         * Targets returned from @ref texture() or @ref renderbuffer() since
+         * the last call to @ref nextFrame().
+         */
+        std::size_t activeCount() const;
+
+        /**
+         * @brief Texture for current frame
+         *
+         * Returns a pooled texture with given format and size that was not
+         * yet returned in current frame, creating a new one if there is none.
+         * The contents are undefined.
+         */
+        Texture2D& texture(TextureFormat format, const Vector2i& size);
+
+        /**
+         * @brief Renderbuffer for current frame
+         *
+         * Returns a pooled renderbuffer with given format, size and sample
+         * count that was not yet returned in current frame, creating a new
+         * one if there is none. If @p samples is non-zero, storage is
+         * allocated using @ref Renderbuffer::setStorageMultisample(). The
+         * contents are undefined.
+         * @requires_gles30 Extension @es_extension{ANGLE,framebuffer_multisample}
+         *      or @es_extension{NV,framebuffer_multisample} for non-zero
+         *      @p samples in OpenGL ES 2.0.
+         * @requires_webgl20 Non-zero @p samples are not supported in WebGL
+         *      1.0.
+         */
+        Renderbuffer& renderbuffer(RenderbufferFormat format, const Vector2i& size, Int samples = 0);
+
+        /**
+         * @brief Framebuffer with given attachments
+         *
+         * Expects that all attachments were returned from @ref texture() or
+         * @ref renderbuffer() of this pool and that @p attachments is not
+         * empty. If a framebuffer with the same attachment set was already
+         * requested, it's returned as-is, otherwise a new one is created,
+         * its viewport is set to size of the first attachment, color
+         * attachments are mapped to consecutive draw buffers in the order they
+         * were specified and completeness is checked. The framebuffer is
+         * deleted when any of its attachments is deleted in @ref nextFrame()
+         * or when it was not used for more than @ref maxIdleFrames() frames.
+         */
+        Framebuffer& framebuffer(std::initializer_list<Attachment> attachments);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Returns all targets used in current frame back to the pool and
+         * deletes targets and framebuffers that were not used for more than
+         * @ref maxIdleFrames() frames.
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+};
+
+}
+
+#endif
@@ -27,11 +27,13 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Math/Vector3.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
 #include "Implementation/FramebufferState.h"
+#include "Implementation/MemoryState.h"
 #include "Implementation/State.h"
 
 namespace Magnum {
@@ -69,7 +71,9 @@ Int Renderbuffer::maxSamples() {
 #endif
 
 Renderbuffer::Renderbuffer(): _flags{ObjectFlag::DeleteOnDestruction} {
-    (this->*Context::current().state().framebuffer->createRenderbufferImplementation)();
+    Implementation::State& state = Context::current().state();
+    (this->*state.framebuffer->createRenderbufferImplementation)();
+    state.memory->created(Context::MemoryObject::Renderbuffer, _id);
 }
 
 void Renderbuffer::createImplementationDefault() {
@@ -88,9 +92,11 @@ Renderbuffer::~Renderbuffer() {
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
     /* If bound, remove itself from state */
-    GLuint& binding = Context::current().state().framebuffer->renderbufferBinding;
+    Implementation::State& state = Context::current().state();
+    GLuint& binding = state.framebuffer->renderbufferBinding;
     if(binding == _id) binding = 0;
 
+    state.memory->destroyed(Context::MemoryObject::Renderbuffer, _id);
     glDeleteRenderbuffers(1, &_id);
 }
 
@@ -119,12 +125,29 @@ Renderbuffer& Renderbuffer::setLabelInternal(const Containers::ArrayView<const c
 #endif
 
 void Renderbuffer::setStorage(const RenderbufferFormat internalFormat, const Vector2i& size) {
-    (this->*Context::current().state().framebuffer->renderbufferStorageImplementation)(internalFormat, size);
+    Implementation::State& state = Context::current().state();
+    (this->*state.framebuffer->renderbufferStorageImplementation)(internalFormat, size);
+    state.memory->setImageSize(Context::MemoryObject::Renderbuffer, _id, 0,
+        Implementation::MemoryState::textureStorageSize(GL_RENDERBUFFER, GLenum(internalFormat), 1, {size, 1}));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderbuffer::setStorageMultisample(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
-    (this->*Context::current().state().framebuffer->renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    Implementation::State& state = Context::current().state();
+    (this->*state.framebuffer->renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    state.memory->setImageSize(Context::MemoryObject::Renderbuffer, _id, 0,
+        Implementation::MemoryState::textureStorageSize(GL_RENDERBUFFER, GLenum(internalFormat), 1, {size, 1})*std::size_t(samples));
+}
+#endif
+
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+void Renderbuffer::setStorageMultisampleImplicitResolve(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
+    bind();
+    glRenderbufferStorageMultisampleEXT(GL_RENDERBUFFER, samples, GLenum(internalFormat), size.x(), size.y());
+
+    /* The samples stay in tile memory, only the resolved data are stored */
+    Context::current().state().memory->setImageSize(Context::MemoryObject::Renderbuffer, _id, 0,
+        Implementation::MemoryState::textureStorageSize(GL_RENDERBUFFER, GLenum(internalFormat), 1, {size, 1}));
 }
 #endif
 
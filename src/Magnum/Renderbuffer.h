@@ -235,11 +235,32 @@ class MAGNUM_EXPORT Renderbuffer: public AbstractObject {
          * @requires_webgl20 Multisample framebuffers are not available in
          *      WebGL 1.0.
          * @todo How about @es_extension{APPLE,framebuffer_multisample}?
-         * @todo NaCl has @fn_gl_extension{RenderbufferStorageMultisample,EXT,multisampled_render_to_texture}
          */
         void setStorageMultisample(Int samples, RenderbufferFormat internalFormat, const Vector2i& size);
         #endif
 
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set implicitly resolved multisample renderbuffer storage
+         * @param samples           Sample count
+         * @param internalFormat    Internal format
+         * @param size              Renderbuffer size
+         *
+         * Unlike @ref setStorageMultisample(), the multisample data live only
+         * in on-chip tile memory and are resolved implicitly when the tile is
+         * flushed, so no memory for the samples is allocated. Meant to be
+         * used together with @ref Framebuffer::attachTextureImplicitResolve().
+         * The renderbuffer is bound before the operation (if not already).
+         * @see @ref maxSize(), @ref MultisampleFramebuffer,
+         *      @fn_gl{BindRenderbuffer},
+         *      @fn_gl_extension{RenderbufferStorageMultisample,EXT,multisampled_render_to_texture}
+         * @requires_es_extension Extension @es_extension{EXT,multisampled_render_to_texture}
+         * @requires_gles Not available in desktop OpenGL or WebGL, use
+         *      @ref setStorageMultisample() and an explicit blit instead.
+         */
+        void setStorageMultisampleImplicitResolve(Int samples, RenderbufferFormat internalFormat, const Vector2i& size);
+        #endif
+
     private:
         explicit Renderbuffer(GLuint id, ObjectFlags flags) noexcept: _id{id}, _flags{flags} {}
 
@@ -29,22 +29,50 @@
 #include "Magnum/Extensions.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/RenderState.h"
 
 #include "Implementation/State.h"
 #include "Implementation/RendererState.h"
+#include "Implementation/capture.h"
 
 namespace Magnum {
 
+namespace {
+    /* Updates the shadowed state, returns false if it's already the same */
+    template<class T> bool updateState(std::optional<T>& state, const T& value) {
+        if(state == value) return false;
+        state = value;
+        return true;
+    }
+
+    template<class T> bool updateState(std::optional<T>(&state)[2], const std::pair<std::size_t, std::size_t> faces, const T& value) {
+        bool changed = false;
+        for(std::size_t i = faces.first; i != faces.second; ++i)
+            changed = updateState(state[i], value) || changed;
+        return changed;
+    }
+
+    RenderState& shadow() {
+        return Context::current().state().renderer->shadow;
+    }
+}
+
 void Renderer::enable(const Feature feature) {
-    glEnable(GLenum(feature));
+    setFeature(feature, true);
 }
 
 void Renderer::disable(const Feature feature) {
-    glDisable(GLenum(feature));
+    setFeature(feature, false);
 }
 
 void Renderer::setFeature(const Feature feature, const bool enabled) {
-    enabled ? enable(feature) : disable(feature);
+    /* Features that can't be tracked are passed through */
+    const std::size_t index = RenderState::featureIndex(feature);
+    if(index != RenderState::FeatureCount && !updateState(shadow()._features[index], enabled))
+        return;
+
+    MAGNUM_CAPTURE(state(enabled ? CommandCapture::StateFunction::Enable : CommandCapture::StateFunction::Disable, GLenum(feature)));
+    enabled ? glEnable(GLenum(feature)) : glDisable(GLenum(feature));
 }
 
 void Renderer::setHint(const Hint target, const HintMode mode) {
@@ -70,10 +98,14 @@ void Renderer::setClearStencil(const Int stencil) {
 }
 
 void Renderer::setFrontFace(const FrontFace mode) {
+    if(!updateState(shadow()._frontFace, GLenum(mode))) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::FrontFace, GLenum(mode)));
     glFrontFace(GLenum(mode));
 }
 
 void Renderer::setFaceCullingMode(const PolygonFacing mode) {
+    if(!updateState(shadow()._faceCullingMode, GLenum(mode))) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::FaceCullingMode, GLenum(mode)));
     glCullFace(GLenum(mode));
 }
 
@@ -100,6 +132,7 @@ void Renderer::setPolygonMode(const PolygonMode mode) {
 #endif
 
 void Renderer::setPolygonOffset(const Float factor, const Float units) {
+    if(!updateState(shadow()._polygonOffset, Vector2{factor, units})) return;
     glPolygonOffset(factor, units);
 }
 
@@ -118,58 +151,79 @@ void Renderer::setScissor(const Range2Di& rectangle) {
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    if(!updateState(shadow()._stencilFunction, RenderState::stencilFaces(facing), Vector3ui{GLenum(function), UnsignedInt(referenceValue), mask})) return;
     glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    if(!updateState(shadow()._stencilFunction, {0, 2}, Vector3ui{GLenum(function), UnsignedInt(referenceValue), mask})) return;
     glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    if(!updateState(shadow()._stencilOperation, RenderState::stencilFaces(facing), Vector3ui{GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)})) return;
     glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    if(!updateState(shadow()._stencilOperation, {0, 2}, Vector3ui{GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)})) return;
     glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
+    if(!updateState(shadow()._depthFunction, GLenum(function))) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::DepthFunction, GLenum(function)));
     glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    if(!updateState(shadow()._colorMask, Math::Vector4<GLboolean>{allowRed, allowGreen, allowBlue, allowAlpha})) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::ColorMask, allowRed, allowGreen, allowBlue, allowAlpha));
     glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 void Renderer::setDepthMask(const GLboolean allow) {
+    if(!updateState(shadow()._depthMask, allow)) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::DepthMask, allow));
     glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
+    if(!updateState(shadow()._stencilMask, RenderState::stencilFaces(facing), allowBits)) return;
     glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
+    if(!updateState(shadow()._stencilMask, {0, 2}, allowBits)) return;
     glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
+    if(!updateState(shadow()._blendEquation, Vector2ui{GLenum(equation)})) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::BlendEquation, GLenum(equation), GLenum(equation)));
     glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
+    if(!updateState(shadow()._blendEquation, Vector2ui{GLenum(rgb), GLenum(alpha)})) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::BlendEquation, GLenum(rgb), GLenum(alpha)));
     glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
+    if(!updateState(shadow()._blendFunction, Vector4ui{GLenum(source), GLenum(destination), GLenum(source), GLenum(destination)})) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::BlendFunction, GLenum(source), GLenum(destination), GLenum(source), GLenum(destination)));
     glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    if(!updateState(shadow()._blendFunction, Vector4ui{GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)})) return;
+    MAGNUM_CAPTURE(state(CommandCapture::StateFunction::BlendFunction, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)));
     glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 void Renderer::setBlendColor(const Color4& color) {
+    if(!updateState(shadow()._blendColor, color)) return;
     glBlendColor(color.r(), color.g(), color.b(), color.a());
 }
 
@@ -179,6 +233,48 @@ void Renderer::setLogicOperation(const LogicOperation operation) {
 }
 #endif
 
+void Renderer::setState(const RenderState& state) {
+    for(std::size_t i = 0; i != RenderState::FeatureCount; ++i)
+        if(state._features[i]) setFeature(RenderState::feature(i), *state._features[i]);
+
+    if(state._frontFace) setFrontFace(FrontFace(*state._frontFace));
+    if(state._faceCullingMode) setFaceCullingMode(PolygonFacing(*state._faceCullingMode));
+    if(state._polygonOffset) setPolygonOffset(state._polygonOffset->x(), state._polygonOffset->y());
+
+    /* Use the non-separate variants if both faces are the same */
+    for(std::size_t i = 0; i != 2; ++i) {
+        const PolygonFacing facing = state._stencilFunction[0] == state._stencilFunction[1] ?
+            PolygonFacing::FrontAndBack : (i == 0 ? PolygonFacing::Front : PolygonFacing::Back);
+        if(const auto& function = state._stencilFunction[i])
+            setStencilFunction(facing, StencilFunction((*function)[0]), Int((*function)[1]), (*function)[2]);
+        if(facing == PolygonFacing::FrontAndBack) break;
+    }
+    for(std::size_t i = 0; i != 2; ++i) {
+        const PolygonFacing facing = state._stencilOperation[0] == state._stencilOperation[1] ?
+            PolygonFacing::FrontAndBack : (i == 0 ? PolygonFacing::Front : PolygonFacing::Back);
+        if(const auto& operation = state._stencilOperation[i])
+            setStencilOperation(facing, StencilOperation((*operation)[0]), StencilOperation((*operation)[1]), StencilOperation((*operation)[2]));
+        if(facing == PolygonFacing::FrontAndBack) break;
+    }
+    for(std::size_t i = 0; i != 2; ++i) {
+        const PolygonFacing facing = state._stencilMask[0] == state._stencilMask[1] ?
+            PolygonFacing::FrontAndBack : (i == 0 ? PolygonFacing::Front : PolygonFacing::Back);
+        if(state._stencilMask[i]) setStencilMask(facing, *state._stencilMask[i]);
+        if(facing == PolygonFacing::FrontAndBack) break;
+    }
+
+    if(state._depthFunction) setDepthFunction(DepthFunction(*state._depthFunction));
+    if(const auto& mask = state._colorMask)
+        setColorMask((*mask)[0], (*mask)[1], (*mask)[2], (*mask)[3]);
+    if(state._depthMask) setDepthMask(*state._depthMask);
+
+    if(const auto& equation = state._blendEquation)
+        setBlendEquation(BlendEquation((*equation)[0]), BlendEquation((*equation)[1]));
+    if(const auto& function = state._blendFunction)
+        setBlendFunction(BlendFunction((*function)[0]), BlendFunction((*function)[1]), BlendFunction((*function)[2]), BlendFunction((*function)[3]));
+    if(state._blendColor) setBlendColor(*state._blendColor);
+}
+
 #ifndef MAGNUM_TARGET_WEBGL
 Renderer::ResetNotificationStrategy Renderer::resetNotificationStrategy() {
     #ifndef MAGNUM_TARGET_GLES
@@ -42,6 +42,16 @@ namespace Implementation { struct RendererState; }
 /** @nosubgrouping
 @brief Global renderer configuration.
 
+## Redundant state filtering
+
+Enabled features, face culling, polygon offset, depth, stencil and blending
+state is shadowed and the GL calls are done only if the value differs from
+what was set previously. Multiple pieces of the state can be set at once
+using @ref RenderState and @ref setState(). If the state gets changed by
+other means than through this class, call
+@ref Context::resetState() "Context::resetState(Context::State::Renderer)"
+to invalidate the shadow copy.
+
 @todo @extension{ARB,viewport_array}
 @todo `GL_POINT_SIZE_GRANULARITY`, `GL_POINT_SIZE_RANGE` (?)
 @todo `GL_STEREO`, `GL_DOUBLEBUFFER` (?)
@@ -299,6 +309,15 @@ class MAGNUM_EXPORT Renderer {
          */
         static void setFeature(Feature feature, bool enabled);
 
+        /**
+         * @brief Apply render state block
+         *
+         * Sets all state that is set in @p state, skipping calls for state
+         * that doesn't differ from the current value.
+         * @see @ref RenderState
+         */
+        static void setState(const RenderState& state);
+
         /**
          * @brief Hint
          *
@@ -1279,7 +1298,25 @@ class MAGNUM_EXPORT Renderer {
              *      3.0 and older.
              * @requires_gles Shader storage is not available in WebGL.
              */
-            ShaderStorage = GL_ATOMIC_COUNTER_BARRIER_BIT
+            ShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Persistently mapped buffers accessed by client
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Persistently mapped buffers are not available in
+             *      OpenGL ES.
+             */
+            ClientMappedBuffer = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
+
+            /**
+             * Query results written to a buffer
+             * @requires_gl44 Extension @extension{ARB,query_buffer_object}
+             * @requires_gl Query buffer objects are not available in OpenGL
+             *      ES.
+             */
+            QueryBuffer = GL_QUERY_BUFFER_BARRIER_BIT
+            #endif
         };
 
         /**
@@ -1293,7 +1330,10 @@ class MAGNUM_EXPORT Renderer {
          */
         typedef Containers::EnumSet<MemoryBarrier
             #ifndef DOXYGEN_GENERATING_OUTPUT
-            , GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT|GL_ELEMENT_ARRAY_BARRIER_BIT|GL_UNIFORM_BARRIER_BIT|GL_TEXTURE_FETCH_BARRIER_BIT|GL_SHADER_IMAGE_ACCESS_BARRIER_BIT|GL_COMMAND_BARRIER_BIT|GL_PIXEL_BUFFER_BARRIER_BIT|GL_TEXTURE_UPDATE_BARRIER_BIT|GL_BUFFER_UPDATE_BARRIER_BIT|GL_FRAMEBUFFER_BARRIER_BIT|GL_TRANSFORM_FEEDBACK_BARRIER_BIT|GL_ATOMIC_COUNTER_BARRIER_BIT|GL_ATOMIC_COUNTER_BARRIER_BIT
+            , GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT|GL_ELEMENT_ARRAY_BARRIER_BIT|GL_UNIFORM_BARRIER_BIT|GL_TEXTURE_FETCH_BARRIER_BIT|GL_SHADER_IMAGE_ACCESS_BARRIER_BIT|GL_COMMAND_BARRIER_BIT|GL_PIXEL_BUFFER_BARRIER_BIT|GL_TEXTURE_UPDATE_BARRIER_BIT|GL_BUFFER_UPDATE_BARRIER_BIT|GL_FRAMEBUFFER_BARRIER_BIT|GL_TRANSFORM_FEEDBACK_BARRIER_BIT|GL_ATOMIC_COUNTER_BARRIER_BIT|GL_SHADER_STORAGE_BARRIER_BIT
+            #ifndef MAGNUM_TARGET_GLES
+            |GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT|GL_QUERY_BUFFER_BARRIER_BIT
+            #endif
             #endif
             > MemoryBarriers;
 
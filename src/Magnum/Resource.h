@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::ResourceKey, @ref Magnum::Resource, enum @ref Magnum::ResourceState
+ * @brief Class @ref Magnum::ResourceKey, @ref Magnum::Resource, @ref Magnum::PinnedResource, enum @ref Magnum::ResourceState
  */
 
+#include <atomic>
+#include <utility>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
@@ -106,6 +108,27 @@ inline Debug& operator<<(Debug& debug, const ResourceKey& value) {
 
 namespace Implementation {
     template<class> class ResourceManagerData;
+
+    /* Base of PinnedResource, linked into a list in the manager so all pinned
+       resources of given type can be refreshed at once */
+    template<class T> class ResourcePin {
+        friend ResourceManagerData<T>;
+
+        protected:
+            explicit ResourcePin(): _manager(nullptr), _previous(nullptr), _next(nullptr) {}
+
+            ~ResourcePin() = default;
+
+            void link(ResourceManagerData<T>* manager);
+            void unlink();
+
+        private:
+            virtual void refreshPin() = 0;
+
+            ResourceManagerData<T>* _manager;
+            ResourcePin<T>* _previous;
+            ResourcePin<T>* _next;
+    };
 }
 
 /**
@@ -120,6 +143,7 @@ template<class T, class U>
 #endif
 class Resource {
     friend Implementation::ResourceManagerData<T>;
+    template<class, class> friend class PinnedResource;
 
     public:
         /**
@@ -128,22 +152,29 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): manager(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
+        explicit Resource(): manager(nullptr), node(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr), readers(nullptr) {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
-            if(manager) manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): manager(other.manager), node(other.node), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data), readers(other.readers) {
+            if(node) manager->incrementReferenceCount(*node);
+
+            /* The other instance keeps its epoch pinned, so it's safe to
+               join it */
+            if(readers) readers->fetch_add(1, std::memory_order_relaxed);
         }
 
         /** @brief Move constructor */
-        Resource(Resource<T, U>&& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+        Resource(Resource<T, U>&& other): manager(other.manager), node(other.node), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data), readers(other.readers) {
             /** @brief Make other's state well-defined */
             other.manager = nullptr;
+            other.node = nullptr;
+            other.readers = nullptr;
         }
 
         /** @brief Destructor */
         ~Resource() {
-            if(manager) manager->decrementReferenceCount(_key);
+            unpin();
+            if(node) manager->decrementReferenceCount(*node);
         }
 
         /** @brief Copy assignment */
@@ -215,43 +246,176 @@ class Resource {
         }
 
     private:
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), _key(key), lastCheck(0), _state(ResourceState::NotLoaded), data(nullptr) {
-            manager->incrementReferenceCount(key);
+        /* The node is null if the resource was requested from other than the
+           owner thread before the manager knew about it, looked up again in
+           acquire() then. Last check is set to a value that the generation
+           counter won't reach to force the first acquire() to happen. */
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, typename Implementation::ResourceManagerData<T>::Data* node): manager(manager), node(node), _key(key), lastCheck(~std::size_t{}), _state(ResourceState::NotLoaded), data(nullptr), readers(nullptr) {
+            if(node) manager->incrementReferenceCount(*node);
         }
 
         void acquire();
 
+        void unpin() {
+            if(readers) readers->fetch_sub(1, std::memory_order_release);
+            readers = nullptr;
+        }
+
         Implementation::ResourceManagerData<T>* manager;
+        typename Implementation::ResourceManagerData<T>::Data* node;
         ResourceKey _key;
         std::size_t lastCheck;
         ResourceState _state;
         T* data;
+
+        /* Reader count of the epoch in which the data were acquired, keeps
+           the manager from deleting them when they get replaced. Null if
+           there are no data or they are final. */
+        std::atomic<std::size_t>* readers;
+};
+
+/**
+@brief Pinned resource reference
+
+Unlike @ref Resource, which asks the manager for changes on every access, this
+class caches pointer to the resource data, so accessing them is just a pointer
+dereference. The pointer is updated on construction and in @ref refresh(), or
+for all pinned resources at once in @ref ResourceManager::refreshPinned(),
+which is meant to be called once per frame:
+@code
+PinnedResource<Mesh> cube{manager.get<Mesh>("cube")};
+PinnedResource<AbstractShaderProgram, MyShader> shader{manager.get<AbstractShaderProgram, MyShader>("shader")};
+
+// Each frame
+manager.refreshPinned();
+for(const Matrix4& transformation: transformations) {
+    shader->setTransformationMatrix(transformation);
+    cube->draw(*shader);
+}
+@endcode
+
+Data of @ref ResourceDataState::Mutable resources replaced in the manager are
+not deleted until the pinned resource is refreshed, so the cached pointer is
+valid until the next refresh. Pinned resources need to be created, refreshed
+and destroyed in the thread that owns the manager.
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T, class U = T>
+#else
+template<class T, class U>
+#endif
+class PinnedResource: private Implementation::ResourcePin<T> {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates empty resource.
+         */
+        explicit PinnedResource(): _data(nullptr) {}
+
+        /** @brief Pin given resource */
+        explicit PinnedResource(Resource<T, U> resource): _resource(std::move(resource)), _data(static_cast<U*>(_resource)) {
+            this->link(_resource.manager);
+        }
+
+        /** @brief Copy constructor */
+        PinnedResource(const PinnedResource<T, U>& other): Implementation::ResourcePin<T>{}, _resource(other._resource), _data(other._data) {
+            this->link(_resource.manager);
+        }
+
+        /** @brief Destructor */
+        ~PinnedResource() { this->unlink(); }
+
+        /** @brief Copy assignment */
+        PinnedResource<T, U>& operator=(const PinnedResource<T, U>& other) {
+            this->unlink();
+            _resource = other._resource;
+            _data = other._data;
+            this->link(_resource.manager);
+            return *this;
+        }
+
+        /** @brief Resource key */
+        ResourceKey key() const { return _resource.key(); }
+
+        /** @brief Underlying resource */
+        Resource<T, U>& resource() { return _resource; }
+
+        /**
+         * @brief Refresh the cached pointer
+         *
+         * @see @ref ResourceManager::refreshPinned()
+         */
+        void refresh() { _data = static_cast<U*>(_resource); }
+
+        /**
+         * @brief Whether the resource was available at last refresh
+         *
+         * @see @ref Resource::operator bool()
+         */
+        operator bool() const { return _data; }
+
+        /**
+         * @brief Pointer to resource data
+         *
+         * Returns `nullptr` if the resource was not loaded at last refresh.
+         */
+        operator U*() const { return _data; }
+
+        /**
+         * @brief Reference to resource data
+         *
+         * The resource must be loaded at last refresh, there is no check.
+         */
+        U& operator*() const { return *_data; }
+
+        /**
+         * @brief Access to resource data
+         *
+         * The resource must be loaded at last refresh, there is no check.
+         */
+        U* operator->() const { return _data; }
+
+    private:
+        void refreshPin() override { refresh(); }
+
+        Resource<T, U> _resource;
+        U* _data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(manager) manager->decrementReferenceCount(_key);
+    /* Increment first so self-assignment doesn't release the resource */
+    if(other.node) other.manager->incrementReferenceCount(*other.node);
+    if(other.readers) other.readers->fetch_add(1, std::memory_order_relaxed);
+    unpin();
+    if(node) manager->decrementReferenceCount(*node);
 
     manager = other.manager;
+    node = other.node;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
     data = other.data;
-
-    if(manager) manager->incrementReferenceCount(_key);
+    readers = other.readers;
     return *this;
 }
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T, U>&& other) {
     /** @todo Just swap the values */
-    if(manager) manager->decrementReferenceCount(_key);
+    unpin();
+    if(node) manager->decrementReferenceCount(*node);
 
     manager = other.manager;
+    node = other.node;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
     data = other.data;
+    readers = other.readers;
 
     other.manager = nullptr;
+    other.node = nullptr;
+    other.readers = nullptr;
     return *this;
 }
 
@@ -259,16 +423,33 @@ template<class T, class U> void Resource<T, U>::acquire() {
     /* The data are already final, nothing to do */
     if(_state == ResourceState::Final) return;
 
-    /* Nothing changed since last check */
-    if(manager->lastChange() < lastCheck) return;
-
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = manager->data(_key);
-    lastCheck = manager->lastChange();
-
-    /* Try to get the data */
-    data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    /* Nothing changed since last check. The generation counter is loaded
+       before the data so changes done after that are caught next time. */
+    const std::size_t lastChange = manager->lastChange();
+    if(lastChange == lastCheck) return;
+
+    /* The resource wasn't known to the manager when requested from another
+       thread, try to look it up again */
+    if(!node && (node = manager->find(_key)))
+        manager->incrementReferenceCount(*node);
+
+    /* The previously acquired data are not used anymore. Pin the current
+       epoch before reading the pointers, so data replaced from now on are
+       not deleted until this instance is accessed again or destroyed. */
+    unpin();
+    readers = manager->pin();
+
+    /* Try to get the data. If the manager is just deleting them, treat them
+       as not loaded and try again next time. */
+    if(node && !(node->referenceCount.load(std::memory_order_acquire) & Implementation::ResourceManagerData<T>::Data::Busy)) {
+        lastCheck = lastChange;
+        data = node->data.load(std::memory_order_acquire);
+        _state = static_cast<ResourceState>(node->state.load(std::memory_order_acquire));
+    } else {
+        if(!node) lastCheck = lastChange;
+        data = nullptr;
+        _state = ResourceState::NotLoaded;
+    }
 
     /* Data are not available */
     if(!data) {
@@ -284,6 +465,33 @@ template<class T, class U> void Resource<T, U>::acquire() {
         } else if(_state != ResourceState::Loading && _state != ResourceState::NotFound)
             _state = ResourceState::NotLoaded;
     }
+
+    /* Nothing to protect. Final data are never replaced while referenced. */
+    if(!data || _state == ResourceState::Final) unpin();
+}
+
+namespace Implementation {
+
+template<class T> void ResourcePin<T>::link(ResourceManagerData<T>* const manager) {
+    _manager = manager;
+    if(!manager) return;
+
+    _next = manager->_pins;
+    if(_next) _next->_previous = this;
+    manager->_pins = this;
+}
+
+template<class T> void ResourcePin<T>::unlink() {
+    if(!_manager) return;
+
+    if(_previous) _previous->_next = _next;
+    else _manager->_pins = _next;
+    if(_next) _next->_previous = _previous;
+
+    _manager = nullptr;
+    _previous = _next = nullptr;
+}
+
 }
 
 }
@@ -29,7 +29,11 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
 
 #include "Magnum/Resource.h"
 
@@ -85,7 +89,16 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * The resource will be unloaded if nothing references it and memory
+     * usage of given resource type is over the budget. Least recently used
+     * resources are unloaded first. Also unloaded when manually calling
+     * @ref ResourceManager::free(). See @ref ResourceManager::setBudget() for
+     * more information.
+     */
+    Budgeted
 };
 
 template<class> class AbstractResourceLoader;
@@ -97,6 +110,7 @@ namespace Implementation {
 template<class T> class ResourceManagerData {
     template<class, class> friend class Magnum::Resource;
     friend AbstractResourceLoader<T>;
+    friend ResourcePin<T>;
 
     public:
         ResourceManagerData(const ResourceManagerData<T>&) = delete;
@@ -107,9 +121,9 @@ template<class T> class ResourceManagerData {
         ResourceManagerData<T>& operator=(const ResourceManagerData<T>&) = delete;
         ResourceManagerData<T>& operator=(ResourceManagerData<T>&&) = delete;
 
-        std::size_t lastChange() const { return _lastChange; }
+        std::size_t lastChange() const { return _lastChange.load(std::memory_order_acquire); }
 
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const { return _count; }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -117,16 +131,24 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t cost = 0);
+
+        std::size_t memoryUsage() const { return _memoryUsage; }
+
+        std::size_t budget() const { return _budget; }
+
+        void setBudget(std::size_t budget);
 
-        T* fallback() { return _fallback; }
-        const T* fallback() const { return _fallback; }
+        std::size_t evictedCount() const { return _evictedCount; }
+
+        T* fallback() { return _fallback.load(std::memory_order_acquire); }
+        const T* fallback() const { return _fallback.load(std::memory_order_acquire); }
 
         void setFallback(T* data);
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -135,24 +157,75 @@ template<class T> class ResourceManagerData {
 
         void setLoader(AbstractResourceLoader<T>* loader);
 
+        void refreshPinned();
+
+        void reload();
+
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData();
 
     private:
         struct Data;
+        struct Table;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        static void insert(Table& table, Data* data);
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        Data* find(ResourceKey key) const;
+
+        Data& findOrInsert(ResourceKey key);
+
+        void incrementReferenceCount(Data& data) {
+            data.referenceCount.fetch_add(1, std::memory_order_acq_rel);
         }
 
-        void decrementReferenceCount(ResourceKey key);
+        void decrementReferenceCount(Data& data);
+
+        std::atomic<std::size_t>* pin();
 
-        std::unordered_map<ResourceKey, Data> _data;
-        T* _fallback;
+        void retire(T* data);
+
+        void reclaim();
+
+        void released(Data& data);
+
+        void collectReleased();
+
+        bool erase(Data& data);
+
+        void evict();
+
+        void destroy();
+
+        /* Lookup table, replaced with a larger one when growing. Readers can
+           still use the previous tables, so they are kept alive until
+           destruction. */
+        std::atomic<Table*> _table;
+        std::size_t _nodeCount, _count;
+
+        /* Resources whose last reference was removed on another thread,
+           processed on the owner thread */
+        std::atomic<Data*> _released;
+        std::thread::id _owner;
+
+        std::atomic<T*> _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        std::atomic<std::size_t> _lastChange;
+
+        /* Count of readers pinned in even and odd epochs and replaced data
+           together with epoch in which they were replaced, deleted once no
+           reader can see them anymore */
+        std::atomic<std::size_t> _epoch;
+        std::atomic<std::size_t> _readers[2];
+        std::vector<std::pair<T*, std::size_t>> _retired;
+
+        /* Unreferenced budgeted resources, least recently used first */
+        std::list<Data*> _evictable;
+        std::size_t _memoryUsage, _budget, _evictedCount;
+
+        /* Live pinned resources and value of the generation counter at the
+           time of last refreshPinned() */
+        ResourcePin<T>* _pins;
+        std::size_t _pinnedCheck;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -201,11 +274,13 @@ instead of failing on null pointer dereference. Availability and state of each
 resource can be queried through function @ref state() on the manager or
 @ref Resource::state() on each resource.
 
-The resources can be managed in three ways - resident resources, which stay in
+The resources can be managed in four ways - resident resources, which stay in
 memory for whole lifetime of the manager, manually managed resources, which
-can be deleted by calling @ref free() if nothing references them anymore, and
+can be deleted by calling @ref free() if nothing references them anymore,
 reference counted resources, which are deleted as soon as the last reference
-to them is removed.
+to them is removed, and budgeted resources, which are deleted in least
+recently used order when nothing references them and memory usage of their
+type is over budget set using @ref setBudget().
 
 Resource state and policy is configured when setting the resource data in
 @ref set() and can be changed each time the data are updated, although already
@@ -242,6 +317,35 @@ cube->draw(*shader);
 -   Destroying resource references and deleting manager instance when nothing
     references the resources anymore.
 
+## Thread safety
+
+The manager is modified only from the thread that created it (the owner
+thread), but other threads can look up resources and use @ref Resource
+instances concurrently. Lookups go through an open-addressing table that
+is never modified in place by the owner thread --- it only fills empty slots
+and publishes a larger table when growing, so lookups never wait for the owner
+thread. Changes are detected by @ref Resource instances using a single atomic
+generation counter.
+
+Calling @ref get() from other threads doesn't call the loader and if the
+resource is not yet known to the manager, the returned @ref Resource looks it
+up again after the next change. When the last reference to a
+@ref ResourcePolicy::ReferenceCounted or @ref ResourcePolicy::Budgeted
+resource is removed on another thread, the resource is deleted next time the
+owner thread calls @ref set(), @ref free() or @ref get(). All other functions
+need to be called from the owner thread.
+
+Data replaced with @ref set() or @ref setFallback() are not deleted while a
+@ref Resource on any thread could still be using them. Each @ref Resource
+instance announces the epoch in which it last accessed the data and the
+previous data are deleted only after all instances that could have seen them
+were accessed again or destroyed, next time the owner thread calls
+@ref set(), @ref setFallback(), @ref free() or @ref get(). Neither the owner
+thread nor the other threads ever wait for each other. A pointer to
+@ref ResourceDataState::Mutable data obtained from a @ref Resource is thus
+valid until that instance is accessed again or destroyed. Data deleted by
+@ref reload() are deleted immediately.
+
 @see @ref AbstractResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
@@ -335,6 +439,26 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
         }
 
+        /**
+         * @brief Set resource data with memory cost
+         * @return Reference to self (for method chaining)
+         *
+         * Same as above, additionally specifying memory cost of the
+         * resource, for example @ref Buffer::size() or size of texture
+         * image data. The cost is accounted in @ref memoryUsage() and used
+         * for evicting @ref ResourcePolicy::Budgeted resources.
+         * @see @ref setBudget()
+         */
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t cost) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, cost);
+            return *this;
+        }
+
+        /** @overload */
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t cost) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, cost);
+        }
+
         /**
          * @brief Set resource data
          * @return Reference to self (for method chaining)
@@ -351,6 +475,56 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Memory usage of given resource type
+         *
+         * Sum of costs passed to @ref set() for all resources of given type,
+         * regardless of their policy.
+         * @see @ref budget(), @ref evictedCount()
+         */
+        template<class T> std::size_t memoryUsage() const {
+            return this->Implementation::ResourceManagerData<T>::memoryUsage();
+        }
+
+        /**
+         * @brief Memory budget for given resource type
+         *
+         * If no budget is set, returns maximal value of @ref std::size_t.
+         * @see @ref setBudget()
+         */
+        template<class T> std::size_t budget() const {
+            return this->Implementation::ResourceManagerData<T>::budget();
+        }
+
+        /**
+         * @brief Set memory budget for given resource type
+         * @return Reference to self (for method chaining)
+         *
+         * If @ref memoryUsage() is over the budget, unreferenced resources
+         * with @ref ResourcePolicy::Budgeted are deleted in least recently
+         * used order until it fits. The same is done every time a resource is
+         * set and every time last reference to a budgeted resource is
+         * removed. A resource is considered used when it is set or when last
+         * reference to it is removed, a resource that was just set is never
+         * deleted by the same call. Deleted resources are requested again from
+         * the loader on next @ref get().
+         * @see @ref evictedCount()
+         */
+        template<class T> ResourceManager<Types...>& setBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setBudget(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Count of evicted resources of given type
+         *
+         * Count of resources deleted because of being over the budget.
+         * @see @ref setBudget()
+         */
+        template<class T> std::size_t evictedCount() const {
+            return this->Implementation::ResourceManagerData<T>::evictedCount();
+        }
+
         /** @brief Fallback for not found resources */
         template<class T> T* fallback() {
             return this->Implementation::ResourceManagerData<T>::fallback();
@@ -417,6 +591,66 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return *this;
         }
 
+        /**
+         * @brief Refresh pinned resources of given type
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref PinnedResource::refresh() on all live pinned resources
+         * of given type, if anything of given type changed in the manager
+         * since the last call.
+         */
+        template<class T> ResourceManager<Types...>& refreshPinned() {
+            this->Implementation::ResourceManagerData<T>::refreshPinned();
+            return *this;
+        }
+
+        /**
+         * @brief Refresh all pinned resources
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref refreshPinned() for all types. Meant to be called once
+         * per frame, see @ref PinnedResource for more information.
+         */
+        ResourceManager<Types...>& refreshPinned() {
+            refreshPinnedInternal(typename Implementation::ResourceManagerImplementation<Types...>::TypePack{});
+            return *this;
+        }
+
+        /**
+         * @brief Reload resources of given type
+         * @return Reference to self (for method chaining)
+         *
+         * Deletes data of all loaded resources of given type and requests
+         * them again from the loader, referenced resources first, ordered by
+         * reference count. Meant to be used after the OpenGL context was lost
+         * and all objects in the manager became invalid. All data are deleted
+         * before the loader is called, so the stale objects can't delete
+         * newly created objects that got the same ID. Existing @ref Resource
+         * instances show the fallback until the data are loaded again.
+         *
+         * Does nothing if there is no loader for given type. Resources which
+         * are loading or were not found are not affected, the same goes for
+         * @ref ResourceDataState::Final resources that are referenced, as
+         * @ref Resource instances don't check the manager for changes of
+         * final resources. Use @ref ResourceDataState::Mutable for resources
+         * that should survive a context loss.
+         */
+        template<class T> ResourceManager<Types...>& reload() {
+            this->Implementation::ResourceManagerData<T>::reload();
+            return *this;
+        }
+
+        /**
+         * @brief Reload all resources
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref reload() for all types.
+         */
+        ResourceManager<Types...>& reload() {
+            reloadInternal(typename Implementation::ResourceManagerImplementation<Types...>::TypePack{});
+            return *this;
+        }
+
         /** @brief Loader for given type of resources */
         template<class T> AbstractResourceLoader<T>* loader() {
             return this->Implementation::ResourceManagerData<T>::loader();
@@ -454,6 +688,18 @@ template<class... Types> class ResourceManager: private Implementation::Resource
         }
         void clearInternal(Implementation::ResourceTypePack<>) const {}
 
+        template<class FirstType, class ...NextTypes> void refreshPinnedInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
+            refreshPinned<FirstType>();
+            refreshPinnedInternal(Implementation::ResourceTypePack<NextTypes...>{});
+        }
+        void refreshPinnedInternal(Implementation::ResourceTypePack<>) const {}
+
+        template<class FirstType, class ...NextTypes> void reloadInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
+            reload<FirstType>();
+            reloadInternal(Implementation::ResourceTypePack<NextTypes...>{});
+        }
+        void reloadInternal(Implementation::ResourceTypePack<>) const {}
+
         template<class FirstType, class ...NextTypes> void freeLoaders(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             Implementation::ResourceManagerData<FirstType>::freeLoader();
             freeLoaders(Implementation::ResourceTypePack<NextTypes...>{});
@@ -473,83 +719,280 @@ template<class T> void safeDelete(T* data) {
     delete data;
 }
 
+template<class T> struct ResourceManagerData<T>::Data {
+    /* Set in the reference count while the manager is deleting the data */
+    enum: std::size_t { Busy = std::size_t{1} << (sizeof(std::size_t)*8 - 1) };
+
+    explicit Data(ResourceKey key): key(key), data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), queued(false), nextReleased(nullptr), cost(0), evictable(false), present(false) {}
+
+    Data(const Data&) = delete;
+    Data(Data&&) = delete;
+
+    ~Data();
+
+    Data& operator=(const Data&) = delete;
+    Data& operator=(Data&&) = delete;
+
+    const ResourceKey key;
+
+    /* Accessed from all threads */
+    std::atomic<T*> data;
+    std::atomic<ResourceDataState> state;
+    std::atomic<ResourcePolicy> policy;
+    std::atomic<std::size_t> referenceCount;
+    std::atomic<bool> queued;
+    Data* nextReleased;
+
+    /* Accessed only from the owner thread */
+    std::size_t cost;
+    typename std::list<Data*>::iterator lru;
+    bool evictable;
+    bool present;
+};
+
+template<class T> inline ResourceManagerData<T>::Data::~Data() {
+    CORRADE_ASSERT(!(referenceCount.load(std::memory_order_relaxed) & ~std::size_t(Busy)),
+        "ResourceManager: cleared/destroyed while data are still referenced", );
+    safeDelete(data.load(std::memory_order_relaxed));
+}
+
+template<class T> struct ResourceManagerData<T>::Table {
+    /* Value-initialization zeroes the atomic pointers */
+    explicit Table(std::size_t capacity, Table* previous): mask(capacity - 1), slots(new std::atomic<Data*>[capacity]()), previous(previous) {}
+
+    Table(const Table&) = delete;
+    Table(Table&&) = delete;
+
+    ~Table() {
+        delete[] slots;
+        delete previous;
+    }
+
+    Table& operator=(const Table&) = delete;
+    Table& operator=(Table&&) = delete;
+
+    const std::size_t mask;
+    std::atomic<Data*>* const slots;
+    Table* const previous;
+};
+
+template<class T> ResourceManagerData<T>::ResourceManagerData(): _table(new Table{16, nullptr}), _nodeCount(0), _count(0), _released(nullptr), _owner(std::this_thread::get_id()), _fallback(nullptr), _loader(nullptr), _lastChange(0), _epoch(0), _readers{}, _memoryUsage(0), _budget(~std::size_t{}), _evictedCount(0), _pins(nullptr), _pinnedCheck(0) {}
+
 template<class T> ResourceManagerData<T>::~ResourceManagerData() {
-    /* Loaders are already deleted via freeLoaders() from ResourceManager */
-    safeDelete(_fallback);
+    /* Loaders are already deleted via freeLoader() from ResourceManager */
+    destroy();
+    delete _table.load(std::memory_order_relaxed);
+    safeDelete(_fallback.load(std::memory_order_relaxed));
+}
+
+template<class T> void ResourceManagerData<T>::insert(Table& table, Data* const data) {
+    std::size_t i = std::hash<ResourceKey>{}(data->key) & table.mask;
+    while(table.slots[i].load(std::memory_order_relaxed))
+        i = (i + 1) & table.mask;
+    table.slots[i].store(data, std::memory_order_release);
+}
+
+template<class T> auto ResourceManagerData<T>::find(const ResourceKey key) const -> Data* {
+    /* Linear probing, the table is never more than half full so this always
+       terminates */
+    const Table* const table = _table.load(std::memory_order_acquire);
+    for(std::size_t i = std::hash<ResourceKey>{}(key) & table->mask; ; i = (i + 1) & table->mask) {
+        Data* const data = table->slots[i].load(std::memory_order_acquire);
+        if(!data || data->key == key) return data;
+    }
+}
+
+template<class T> auto ResourceManagerData<T>::findOrInsert(const ResourceKey key) -> Data& {
+    if(Data* const data = find(key)) return *data;
+
+    /* Publish a twice as large table if this would make it more than half
+       full */
+    Table* table = _table.load(std::memory_order_relaxed);
+    if(2*(_nodeCount + 1) > table->mask + 1) {
+        Table* const grown = new Table{2*(table->mask + 1), table};
+        for(std::size_t i = 0; i <= table->mask; ++i)
+            if(Data* const data = table->slots[i].load(std::memory_order_relaxed))
+                insert(*grown, data);
+        _table.store(table = grown, std::memory_order_release);
+    }
+
+    Data* const data = new Data{key};
+    insert(*table, data);
+    ++_nodeCount;
+    return *data;
 }
 
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    const Data* const data = find(key);
+    if(!data) return 0;
+    return data->referenceCount.load(std::memory_order_acquire) & ~std::size_t(Data::Busy);
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const Data* const data = find(key);
+    const ResourceDataState state = data ? data->state.load(std::memory_order_acquire) : ResourceDataState::Mutable;
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(!data || !data->data.load(std::memory_order_acquire)) {
         /* Fallback found, add *Fallback to state */
-        if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+        if(fallback()) {
+            if(data && state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(data && state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(!data || (state != ResourceDataState::Loading && state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(state);
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
+    /* Other threads can only look up resources the manager already knows
+       about, the rest is looked up again in Resource::acquire() */
+    if(std::this_thread::get_id() != _owner)
+        return Resource<T, U>(this, key, find(key));
+
+    collectReleased();
+    Data& data = findOrInsert(key);
+
     /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    if(!data.present) {
+        data.present = true;
+        ++_count;
+        if(_loader) _loader->load(key);
+    }
 
-    return Resource<T, U>(this, key);
+    return Resource<T, U>(this, key, &data);
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
-
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t cost) {
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    #ifndef CORRADE_NO_ASSERT
+    const Data* const existing = find(key);
+    #endif
+    CORRADE_ASSERT(!existing || existing->state.load(std::memory_order_relaxed) != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
+    collectReleased();
+
     /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    Data& d = findOrInsert(key);
+    if(!d.present) {
+        d.present = true;
+        ++_count;
+    }
+
+    /* Otherwise delete previous data once nobody reads them */
+    retire(d.data.exchange(data, std::memory_order_seq_cst));
+    _memoryUsage -= d.cost;
+    if(d.evictable) {
+        _evictable.erase(d.lru);
+        d.evictable = false;
+    }
 
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    d.state.store(state, std::memory_order_release);
+    d.policy.store(policy, std::memory_order_release);
+    d.cost = cost;
+    _memoryUsage += cost;
+    _lastChange.fetch_add(1, std::memory_order_release);
+
+    /* Make room for the new data, only then make them a candidate for
+       eviction so they aren't deleted right after being set */
+    evict();
+    if(policy == ResourcePolicy::Budgeted && data && !d.referenceCount.load(std::memory_order_acquire)) {
+        d.lru = _evictable.insert(_evictable.end(), &d);
+        d.evictable = true;
+    }
+}
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+template<class T> void ResourceManagerData<T>::setBudget(const std::size_t budget) {
+    _budget = budget;
+    collectReleased();
+    evict();
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
-    safeDelete(_fallback);
-    _fallback = data;
+    retire(_fallback.exchange(data, std::memory_order_seq_cst));
+    _lastChange.fetch_add(1, std::memory_order_release);
 }
 
 template<class T> void ResourceManagerData<T>::free() {
+    collectReleased();
+
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    const Table* const table = _table.load(std::memory_order_relaxed);
+    for(std::size_t i = 0; i <= table->mask; ++i) {
+        Data* const data = table->slots[i].load(std::memory_order_relaxed);
+        if(data && data->present && data->policy.load(std::memory_order_relaxed) != ResourcePolicy::Resident)
+            erase(*data);
+    }
+}
+
+template<class T> void ResourceManagerData<T>::clear() {
+    destroy();
+    delete _table.exchange(new Table{16, nullptr}, std::memory_order_acq_rel);
+}
+
+template<class T> void ResourceManagerData<T>::destroy() {
+    const Table* const table = _table.load(std::memory_order_relaxed);
+    for(std::size_t i = 0; i <= table->mask; ++i)
+        delete table->slots[i].load(std::memory_order_relaxed);
+
+    _nodeCount = _count = _memoryUsage = 0;
+    _released.store(nullptr, std::memory_order_relaxed);
+    _evictable.clear();
+
+    /* Nothing references the data anymore */
+    for(const std::pair<T*, std::size_t>& retired: _retired)
+        safeDelete(retired.first);
+    _retired.clear();
+}
+
+template<class T> bool ResourceManagerData<T>::erase(Data& data) {
+    /* Mark the data as being deleted so other threads don't pick them up.
+       Fails if anything references them. */
+    std::size_t expected = 0;
+    if(!data.referenceCount.compare_exchange_strong(expected, Data::Busy, std::memory_order_acq_rel))
+        return false;
+
+    /* The node itself stays in the table as other threads might be looking
+       at it, it's reused when the resource is set again */
+    safeDelete(data.data.exchange(nullptr, std::memory_order_relaxed));
+    data.state.store(ResourceDataState::Mutable, std::memory_order_relaxed);
+    data.policy.store(ResourcePolicy::Manual, std::memory_order_relaxed);
+    _memoryUsage -= data.cost;
+    data.cost = 0;
+    if(data.evictable) {
+        _evictable.erase(data.lru);
+        data.evictable = false;
+    }
+    if(data.present) {
+        data.present = false;
+        --_count;
+    }
+
+    data.referenceCount.fetch_sub(Data::Busy, std::memory_order_release);
+    return true;
+}
+
+template<class T> void ResourceManagerData<T>::evict() {
+    /* Resources referenced again since they got into the list are removed
+       from it without deleting, they get back once released */
+    while(_memoryUsage > _budget && !_evictable.empty()) {
+        Data& data = *_evictable.front();
+        _evictable.pop_front();
+        data.evictable = false;
+        if(erase(data)) ++_evictedCount;
     }
 }
 
@@ -561,6 +1004,57 @@ template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<
     if((_loader = loader)) _loader->manager = this;
 }
 
+template<class T> void ResourceManagerData<T>::refreshPinned() {
+    /* Pinned resources created since the last change are up-to-date */
+    const std::size_t lastChange = this->lastChange();
+    if(lastChange == _pinnedCheck) return;
+
+    _pinnedCheck = lastChange;
+    for(ResourcePin<T>* pin = _pins; pin; pin = pin->_next)
+        pin->refreshPin();
+}
+
+template<class T> void ResourceManagerData<T>::reload() {
+    if(!_loader) return;
+
+    collectReleased();
+
+    /* Gather loaded resources that can be safely replaced */
+    std::vector<Data*> reloaded;
+    const Table* const table = _table.load(std::memory_order_relaxed);
+    for(std::size_t i = 0; i <= table->mask; ++i) {
+        Data* const data = table->slots[i].load(std::memory_order_relaxed);
+        if(!data || !data->present || !data->data.load(std::memory_order_relaxed))
+            continue;
+        if(data->state.load(std::memory_order_relaxed) == ResourceDataState::Final && data->referenceCount.load(std::memory_order_acquire))
+            continue;
+
+        reloaded.push_back(data);
+    }
+
+    /* Most referenced resources are likely the ones on the screen, ask for
+       them first */
+    std::stable_sort(reloaded.begin(), reloaded.end(), [](const Data* a, const Data* b) {
+        return a->referenceCount.load(std::memory_order_relaxed) > b->referenceCount.load(std::memory_order_relaxed);
+    });
+
+    /* Delete everything before the loader creates anything, otherwise a stale
+       object could delete a new one that got the same ID */
+    for(Data* const data: reloaded) {
+        safeDelete(data->data.exchange(nullptr, std::memory_order_acq_rel));
+        data->state.store(ResourceDataState::Loading, std::memory_order_release);
+        _memoryUsage -= data->cost;
+        data->cost = 0;
+        if(data->evictable) {
+            _evictable.erase(data->lru);
+            data->evictable = false;
+        }
+    }
+    _lastChange.fetch_add(1, std::memory_order_release);
+
+    for(Data* const data: reloaded) _loader->load(data->key);
+}
+
 template<class T> void ResourceManagerData<T>::freeLoader() {
     if(!_loader) return;
 
@@ -568,40 +1062,103 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(Data& data) {
+    if(data.referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    /* Only reference counted and budgeted resources are affected */
+    const ResourcePolicy policy = data.policy.load(std::memory_order_acquire);
+    if(policy != ResourcePolicy::ReferenceCounted && policy != ResourcePolicy::Budgeted)
+        return;
+
+    /* Other threads can't modify the manager, push the resource to a list
+       processed by the owner thread next time it modifies the manager. A
+       resource is pushed only once until processed, so there's no ABA
+       problem. */
+    if(std::this_thread::get_id() != _owner) {
+        if(data.queued.exchange(true, std::memory_order_acq_rel)) return;
+        data.nextReleased = _released.load(std::memory_order_relaxed);
+        while(!_released.compare_exchange_weak(data.nextReleased, &data, std::memory_order_release, std::memory_order_relaxed)) {}
+        return;
+    }
 
-    /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    released(data);
 }
 
-template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+template<class T> std::atomic<std::size_t>* ResourceManagerData<T>::pin() {
+    /* If the epoch changed in the meantime, the owner thread might have
+       already checked the count, try again with the new one */
+    for(;;) {
+        const std::size_t epoch = _epoch.load(std::memory_order_seq_cst);
+        std::atomic<std::size_t>& readers = _readers[epoch & 1];
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        if(_epoch.load(std::memory_order_seq_cst) == epoch) return &readers;
+        readers.fetch_sub(1, std::memory_order_release);
+    }
+}
 
-    Data(const Data&) = delete;
+template<class T> void ResourceManagerData<T>::retire(T* const data) {
+    if(!data) return;
+
+    _retired.emplace_back(data, _epoch.load(std::memory_order_relaxed));
+    reclaim();
+}
 
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
-        other.data = nullptr;
-        other.referenceCount = 0;
+template<class T> void ResourceManagerData<T>::reclaim() {
+    if(_retired.empty()) return;
+
+    /* Readers pinned in epoch e or e - 1 can see data replaced in epoch e,
+       readers pinned later see only newer data. The epoch can be advanced
+       only if no reader is pinned in the previous one, which gets reused, so
+       the data are safe to delete once the epoch was advanced twice. The
+       owner thread never waits for readers, it just tries again next time. */
+    for(std::size_t i = 0; i != 2; ++i) {
+        const std::size_t epoch = _epoch.load(std::memory_order_relaxed);
+        if(_retired.back().second + 2 <= epoch || _readers[(epoch + 1) & 1].load(std::memory_order_seq_cst))
+            break;
+        _epoch.store(epoch + 1, std::memory_order_seq_cst);
     }
 
-    ~Data();
+    /* The retired data are ordered by epoch */
+    const std::size_t epoch = _epoch.load(std::memory_order_relaxed);
+    auto it = _retired.begin();
+    for(; it != _retired.end() && it->second + 2 <= epoch; ++it)
+        safeDelete(it->first);
+    _retired.erase(_retired.begin(), it);
+}
 
-    Data& operator=(const Data&) = delete;
-    Data& operator=(Data&&) = delete;
+template<class T> void ResourceManagerData<T>::released(Data& data) {
+    /* Referenced again in the meantime */
+    if(data.referenceCount.load(std::memory_order_acquire)) return;
 
-    T* data;
-    ResourceDataState state;
-    ResourcePolicy policy;
-    std::size_t referenceCount;
-};
+    /* Free the resource if it is reference counted */
+    const ResourcePolicy policy = data.policy.load(std::memory_order_relaxed);
+    if(policy == ResourcePolicy::ReferenceCounted)
+        erase(data);
+
+    /* Make budgeted resource the most recently used eviction candidate and
+       evict if over the budget */
+    else if(policy == ResourcePolicy::Budgeted && data.data.load(std::memory_order_relaxed)) {
+        if(data.evictable)
+            _evictable.splice(_evictable.end(), _evictable, data.lru);
+        else {
+            data.lru = _evictable.insert(_evictable.end(), &data);
+            data.evictable = true;
+        }
+        evict();
+    }
+}
 
-template<class T> inline ResourceManagerData<T>::Data::~Data() {
-    CORRADE_ASSERT(referenceCount == 0,
-        "ResourceManager: cleared/destroyed while data are still referenced", );
-    safeDelete(data);
+template<class T> void ResourceManagerData<T>::collectReleased() {
+    /* Delete replaced data that nobody reads anymore */
+    reclaim();
+
+    Data* data = _released.exchange(nullptr, std::memory_order_acquire);
+    while(data) {
+        Data* const next = data->nextReleased;
+        data->queued.store(false, std::memory_order_release);
+        released(*data);
+        data = next;
+    }
 }
 
 }
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+
+namespace Magnum {
+
+RingBuffer::RingBuffer(const GLsizeiptr size): _size{size}, _position{0}, _frameBegin{0}, _flushBegin{0}, _mapped{nullptr} {
+    CORRADE_ASSERT(size > 0, "RingBuffer::RingBuffer(): size must be positive", );
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) {
+        _buffer.setStorage({nullptr, std::size_t(size)}, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+        _mapped = _buffer.map<char>(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+        CORRADE_INTERNAL_ASSERT(_mapped);
+        return;
+    }
+    #endif
+
+    _data = Containers::Array<char>{std::size_t(size)};
+    orphan();
+}
+
+RingBuffer::~RingBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    for(const auto& fence: _fences) glDeleteSync(fence.first);
+    #endif
+}
+
+std::pair<GLintptr, Containers::ArrayView<char>> RingBuffer::allocate(const GLsizeiptr size, const GLintptr alignment) {
+    CORRADE_ASSERT(size <= _size,
+        "RingBuffer::allocate(): can't allocate" << size << "bytes in a buffer of" << _size << "bytes", {});
+    CORRADE_ASSERT(alignment > 0,
+        "RingBuffer::allocate(): alignment must be positive", {});
+
+    /* Align the physical offset. If the allocation doesn't fit into the rest
+       of the buffer, wrap around to the beginning. */
+    const UnsignedLong bufferSize = _size;
+    UnsignedLong position = _position + (alignment - _position % bufferSize % alignment) % alignment;
+    const UnsignedLong end = (_position/bufferSize + 1)*bufferSize;
+    if(position + size > end) position = end;
+
+    /* The allocation would overwrite data of current frame */
+    CORRADE_ASSERT(position + size <= _frameBegin + bufferSize,
+        "RingBuffer::allocate(): allocations since last fence() don't fit into" << _size << "bytes", {});
+
+    if(_mapped) {
+        #ifndef MAGNUM_TARGET_GLES
+        /* Wait until OpenGL is done with the same region in the previous
+           cycle */
+        if(position + size > bufferSize) wait(position + size - bufferSize);
+        #endif
+
+    /* Wrapped around in client memory mode (the last allocated byte is in
+       another cycle than the new allocation), upload what's pending and
+       orphan the buffer */
+    } else if(_position && position/bufferSize != (_position - 1)/bufferSize) {
+        flush();
+        orphan();
+
+        /* The skipped space at the end of previous cycle doesn't need to be
+           uploaded */
+        _flushBegin = position;
+    }
+
+    _position = position + size;
+
+    const std::size_t offset = position % bufferSize;
+    return {GLintptr(offset), {(_mapped ? _mapped : _data.data()) + offset, std::size_t(size)}};
+}
+
+GLintptr RingBuffer::upload(const Containers::ArrayView<const void> data, const GLintptr alignment) {
+    const std::pair<GLintptr, Containers::ArrayView<char>> allocation = allocate(data.size(), alignment);
+    if(allocation.second) std::memcpy(allocation.second.data(), data.data(), data.size());
+    return allocation.first;
+}
+
+RingBuffer& RingBuffer::flush() {
+    /* Nothing to upload with persistent mapping */
+    if(!_mapped && _position != _flushBegin) {
+        /* Pending data are never split across the end of the buffer, as
+           wrapping around flushes them */
+        const std::size_t offset = _flushBegin % _size;
+        const std::size_t size = std::min(std::size_t(_position - _flushBegin), std::size_t(_size) - offset);
+        _buffer.setSubData(offset, {_data + offset, size});
+    }
+
+    _flushBegin = _position;
+    return *this;
+}
+
+RingBuffer& RingBuffer::fence() {
+    flush();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_mapped && _position != _frameBegin)
+        _fences.emplace_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _frameBegin);
+    #endif
+
+    _frameBegin = _position;
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void RingBuffer::wait(const UnsignedLong position) {
+    /* Fences are ordered by position of the region they protect, wait for
+       all that begin before given position */
+    while(!_fences.empty() && _fences.front().second < position) {
+        while(glClientWaitSync(_fences.front().first, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(_fences.front().first);
+        _fences.pop_front();
+    }
+}
+#endif
+
+void RingBuffer::orphan() {
+    /* Drawing from the previous storage can continue while the new one is
+       being filled */
+    _buffer.setData({nullptr, std::size_t(_size)}, BufferUsage::StreamDraw);
+
+    /* Data of current frame that were already uploaded are still needed, put
+       them into the new storage as well. The frame can't span more than the
+       buffer size, so they are never split across the end of the buffer. */
+    if(_frameBegin != _flushBegin) {
+        const std::size_t offset = _frameBegin % _size;
+        const std::size_t size = std::min(std::size_t(_flushBegin - _frameBegin), std::size_t(_size) - offset);
+        _buffer.setSubData(offset, {_data + offset, size});
+    }
+}
+
+}
@@ -0,0 +1,202 @@
+#ifndef Magnum_RingBuffer_h
+#define Magnum_RingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RingBuffer
+ */
+
+#include <deque>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+
+namespace Magnum {
+
+/**
+@brief Ring buffer for streaming data
+
+Sub-allocates dynamic data such as text, debug lines or particles from a
+single fixed-size @ref Buffer instead of mapping or reallocating a buffer each
+frame. The returned offsets can be passed directly to
+@ref Mesh::addVertexBuffer() or @ref Buffer::bind(Target, UnsignedInt, GLintptr, GLsizeiptr).
+
+## Usage
+
+Allocate the memory, fill it, call @ref flush() before the data are used and
+@ref fence() after all draw calls using the data in current frame were
+submitted:
+@code
+RingBuffer ring{4*1024*1024};
+
+// each frame
+std::pair<GLintptr, Containers::ArrayView<char>> vertices = ring.allocate(vertexCount*sizeof(Vector3));
+fillVertices(Containers::arrayCast<Vector3>(vertices.second));
+GLintptr uniforms = ring.upload(uniformData, Buffer::uniformOffsetAlignment());
+ring.flush();
+
+mesh.addVertexBuffer(ring.buffer(), vertices.first, Shaders::Flat3D::Position{})
+    .setCount(vertexCount);
+ring.buffer().bind(Buffer::Target::Uniform, 0, uniforms, uniformData.size());
+mesh.draw(shader);
+
+ring.fence();
+@endcode
+
+All allocations done between two calls to @ref fence() must fit into the
+buffer together.
+
+@anchor RingBuffer-implementation
+## Implementation
+
+If @extension{ARB,buffer_storage} (part of OpenGL 4.4) is supported, the
+buffer storage is mapped persistently and coherently and the allocations point
+directly to the mapped memory, thus @ref flush() does nothing. Region used in
+given frame is protected with a fence sync object in @ref fence() and
+@ref allocate() waits on the fence only when it's about to reuse the region
+while it's still being used by OpenGL.
+
+Otherwise the allocations point to client memory which is uploaded to the
+buffer in @ref flush(). When the allocations wrap around to the beginning of
+the buffer, the buffer is orphaned, so the driver can allocate new storage
+instead of waiting until drawing from the previous one is finished.
+
+@see @ref isPersistent()
+*/
+class MAGNUM_EXPORT RingBuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Buffer size in bytes
+         *
+         * Creates the buffer and its storage.
+         * @see @ref Buffer::setStorage(), @ref Buffer::map(),
+         *      @ref Buffer::setData()
+         */
+        explicit RingBuffer(GLsizeiptr size);
+
+        /** @brief Copying is not allowed */
+        RingBuffer(const RingBuffer&) = delete;
+
+        /** @brief Moving is not allowed */
+        RingBuffer(RingBuffer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fence sync objects and the buffer.
+         */
+        ~RingBuffer();
+
+        /** @brief Copying is not allowed */
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /** @brief Moving is not allowed */
+        RingBuffer& operator=(RingBuffer&&) = delete;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Buffer size in bytes */
+        GLsizeiptr size() const { return _size; }
+
+        /**
+         * @brief Whether the buffer is persistently mapped
+         *
+         * See @ref RingBuffer-implementation "class documentation" for more
+         * information.
+         */
+        bool isPersistent() const { return _mapped; }
+
+        /**
+         * @brief Allocate memory
+         * @param size          Size in bytes
+         * @param alignment     Offset alignment in bytes
+         * @return Offset of the allocation in the buffer and memory to which
+         *      the data should be written
+         *
+         * Expects that @p size is not larger than @ref size(). The memory
+         * stays writable until next call to @ref flush().
+         */
+        std::pair<GLintptr, Containers::ArrayView<char>> allocate(GLsizeiptr size, GLintptr alignment = 1);
+
+        /**
+         * @brief Allocate memory and copy data into it
+         * @return Offset of the allocation in the buffer
+         *
+         * Convenience alternative to @ref allocate().
+         */
+        GLintptr upload(Containers::ArrayView<const void> data, GLintptr alignment = 1);
+
+        /**
+         * @brief Make the allocated data available to OpenGL
+         * @return Reference to self (for method chaining)
+         *
+         * Needs to be called before the data allocated since last call are
+         * used by OpenGL. Does nothing if the buffer is persistently mapped,
+         * otherwise uploads the data to the buffer.
+         * @see @ref Buffer::setSubData()
+         */
+        RingBuffer& flush();
+
+        /**
+         * @brief Finish current frame
+         * @return Reference to self (for method chaining)
+         *
+         * Call after all commands using data allocated in current frame were
+         * submitted. If the buffer is persistently mapped, inserts a fence
+         * sync object that protects the region from being overwritten until
+         * the commands are finished. Implicitly calls @ref flush().
+         * @see @fn_gl{FenceSync}
+         */
+        RingBuffer& fence();
+
+    private:
+        void MAGNUM_LOCAL wait(UnsignedLong position);
+        void MAGNUM_LOCAL orphan();
+
+        Buffer _buffer;
+        GLsizeiptr _size;
+
+        /* Positions are virtual, increasing monotonically, physical offset is
+           position modulo size. Makes checking for overlaps trivial. 64-bit
+           so it doesn't overflow on 32-bit systems. */
+        UnsignedLong _position, _frameBegin, _flushBegin;
+
+        /* Persistently mapped memory or client memory copy */
+        char* _mapped;
+        Containers::Array<char> _data;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /* Pending fences with begin position of the region they protect */
+        std::deque<std::pair<GLsync, UnsignedLong>> _fences;
+        #endif
+};
+
+}
+
+#endif
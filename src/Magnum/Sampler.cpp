@@ -60,6 +60,185 @@ Float Sampler::maxMaxAnisotropy() {
     return value;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+bool Sampler::Parameters::operator==(const Parameters& other) const {
+    return minificationFilter == other.minificationFilter &&
+        mipmap == other.mipmap &&
+        magnificationFilter == other.magnificationFilter &&
+        wrapping == other.wrapping &&
+        minLod == other.minLod &&
+        maxLod == other.maxLod &&
+        #ifndef MAGNUM_TARGET_GLES
+        lodBias == other.lodBias &&
+        borderColor == other.borderColor &&
+        #endif
+        maxAnisotropy == other.maxAnisotropy &&
+        compareMode == other.compareMode &&
+        compareFunction == other.compareFunction;
+}
+
+Sampler& Sampler::cached(const Parameters& parameters) {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* Already have a sampler with the same state */
+    const auto found = textureState.samplerCache.find(parameters);
+    if(found != textureState.samplerCache.end()) return found->second;
+
+    /* Otherwise create and set up a new one */
+    Sampler sampler;
+    sampler.setParameters(parameters);
+    return textureState.samplerCache.emplace(parameters, std::move(sampler)).first->second;
+}
+
+void Sampler::unbind(const Int textureUnit) {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* If given texture unit is already unbound, nothing to do */
+    if(textureState.samplerBindings[textureUnit] == 0) return;
+
+    /* Update state tracker, unbind the sampler from the unit */
+    textureState.samplerBindings[textureUnit] = 0;
+    glBindSampler(textureUnit, 0);
+}
+
+void Sampler::unbind(const Int firstTextureUnit, const std::size_t count) {
+    /* State tracker is updated in the implementations */
+    Context::current().state().texture->bindSamplersImplementation(firstTextureUnit, {nullptr, count});
+}
+
+/** @todoc const std::initializer_list makes Doxygen grumpy */
+void Sampler::bind(const Int firstTextureUnit, std::initializer_list<Sampler*> samplers) {
+    /* State tracker is updated in the implementations */
+    Context::current().state().texture->bindSamplersImplementation(firstTextureUnit, {samplers.begin(), samplers.size()});
+}
+
+void Sampler::bindImplementationFallback(const GLint firstTextureUnit, const Containers::ArrayView<Sampler* const> samplers) {
+    for(std::size_t i = 0; i != samplers.size(); ++i)
+        samplers && samplers[i] ? samplers[i]->bind(firstTextureUnit + i) : unbind(firstTextureUnit + i);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+/** @todoc const Containers::ArrayView makes Doxygen grumpy */
+void Sampler::bindImplementationMulti(const GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers) {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* Create array of IDs and also update bindings in state tracker */
+    Containers::Array<GLuint> ids{samplers ? samplers.size() : 0};
+    bool different = false;
+    for(std::size_t i = 0; i != samplers.size(); ++i) {
+        const GLuint id = samplers && samplers[i] ? samplers[i]->_id : 0;
+        if(samplers) ids[i] = id;
+
+        if(textureState.samplerBindings[firstTextureUnit + i] != id) {
+            different = true;
+            textureState.samplerBindings[firstTextureUnit + i] = id;
+        }
+    }
+
+    /* Avoid doing the binding if there is nothing different */
+    if(different) glBindSamplers(firstTextureUnit, samplers.size(), ids);
+}
+#endif
+
+Sampler::Sampler(): _flags{ObjectFlag::DeleteOnDestruction} {
+    glGenSamplers(1, &_id);
+}
+
+Sampler::~Sampler() {
+    /* Moved out, nothing to do */
+    if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
+
+    /* Deleting the sampler unbinds it from all units, update state tracker */
+    for(GLuint& binding: Context::current().state().texture->samplerBindings)
+        if(binding == _id) binding = 0;
+
+    glDeleteSamplers(1, &_id);
+}
+
+Sampler& Sampler::setMinificationFilter(const Filter filter, const Mipmap mipmap) {
+    glSamplerParameteri(_id, GL_TEXTURE_MIN_FILTER, GLint(filter)|GLint(mipmap));
+    return *this;
+}
+
+Sampler& Sampler::setMagnificationFilter(const Filter filter) {
+    glSamplerParameteri(_id, GL_TEXTURE_MAG_FILTER, GLint(filter));
+    return *this;
+}
+
+Sampler& Sampler::setMinLod(const Float lod) {
+    glSamplerParameterf(_id, GL_TEXTURE_MIN_LOD, lod);
+    return *this;
+}
+
+Sampler& Sampler::setMaxLod(const Float lod) {
+    glSamplerParameterf(_id, GL_TEXTURE_MAX_LOD, lod);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Sampler& Sampler::setLodBias(const Float bias) {
+    glSamplerParameterf(_id, GL_TEXTURE_LOD_BIAS, bias);
+    return *this;
+}
+#endif
+
+Sampler& Sampler::setWrapping(const Array3D<Wrapping>& wrapping) {
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_S, GLint(wrapping.x()));
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_T, GLint(wrapping.y()));
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_R, GLint(wrapping.z()));
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Sampler& Sampler::setBorderColor(const Color4& color) {
+    glSamplerParameterfv(_id, GL_TEXTURE_BORDER_COLOR, color.data());
+    return *this;
+}
+#endif
+
+Sampler& Sampler::setMaxAnisotropy(const Float anisotropy) {
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::texture_filter_anisotropic>())
+        glSamplerParameterf(_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    return *this;
+}
+
+Sampler& Sampler::setCompareMode(const CompareMode mode) {
+    glSamplerParameteri(_id, GL_TEXTURE_COMPARE_MODE, GLenum(mode));
+    return *this;
+}
+
+Sampler& Sampler::setCompareFunction(const CompareFunction function) {
+    glSamplerParameteri(_id, GL_TEXTURE_COMPARE_FUNC, GLenum(function));
+    return *this;
+}
+
+Sampler& Sampler::setParameters(const Parameters& parameters) {
+    setMinificationFilter(parameters.minificationFilter, parameters.mipmap);
+    setMagnificationFilter(parameters.magnificationFilter);
+    setWrapping(parameters.wrapping);
+    setMinLod(parameters.minLod);
+    setMaxLod(parameters.maxLod);
+    #ifndef MAGNUM_TARGET_GLES
+    setLodBias(parameters.lodBias);
+    setBorderColor(parameters.borderColor);
+    #endif
+    setMaxAnisotropy(parameters.maxAnisotropy);
+    setCompareMode(parameters.compareMode);
+    return setCompareFunction(parameters.compareFunction);
+}
+
+void Sampler::bind(const Int textureUnit) {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* If already bound in given texture unit, nothing to do */
+    if(textureState.samplerBindings[textureUnit] == _id) return;
+
+    /* Update state tracker, bind the sampler to the unit */
+    textureState.samplerBindings[textureUnit] = _id;
+    glBindSampler(textureUnit, _id);
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Sampler::Filter value) {
     switch(value) {
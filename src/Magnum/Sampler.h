@@ -29,19 +29,85 @@
  * @brief Class @ref Magnum::Sampler
  */
 
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/AbstractObject.h"
+#include "Magnum/Array.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
+#include "Magnum/Tags.h"
 #include "Magnum/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Math/Color.h"
+#endif
+
 namespace Magnum {
 
+namespace Implementation { struct TextureState; }
+
 /**
 @brief Texture sampler
 
+Contains sampling-related enums and limits used by texture classes and, on
+OpenGL 3.3+ and OpenGL ES 3.0+, wraps OpenGL sampler objects.
+
+## Sampler objects
+
+Sampling state set directly on a texture with for example
+@ref Texture::setMinificationFilter() is stored in each texture and every
+change results in a separate @fn_gl{TexParameter} call. A sampler object holds
+the same state independently of any texture and, when bound to a texture unit,
+overrides the sampling state of whatever texture is bound there. Many textures
+sharing the same sampling then don't need to carry or update any state
+themselves:
+@code
+Sampler sampler;
+sampler.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+    .setMagnificationFilter(Sampler::Filter::Linear)
+    .setWrapping(Sampler::Wrapping::ClampToEdge);
+
+texture.bind(0);
+sampler.bind(0);
+@endcode
+
+### Sampler cache
+
+As the number of distinct sampling states in a typical scene is small,
+@ref cached() returns a sampler object for given @ref Parameters from a
+per-context cache, creating it on first use. Identical parameters always give
+back the same object, so textures with the same sampling share a single sampler
+and binding it for a unit that already has it bound is a no-op:
+@code
+Sampler::Parameters parameters;
+parameters.minificationFilter = Sampler::Filter::Linear;
+parameters.magnificationFilter = Sampler::Filter::Linear;
+
+Sampler& sampler = Sampler::cached(parameters);
+@endcode
+
+Cached samplers are owned by the context and deleted together with it.
+
+## Performance optimizations
+
+Sampler bindings are tracked per texture unit, so binding a sampler to a unit
+where it is already bound doesn't result in any OpenGL call. Samplers for
+several consecutive texture units can be bound at once using
+@ref bind(Int, std::initializer_list<Sampler*>), alongside the textures bound
+with @ref AbstractTexture::bind(Int, std::initializer_list<AbstractTexture*>).
+If @extension{ARB,multi_bind} (part of OpenGL 4.4) is available, the units are
+bound with a single @fn_gl{BindSamplers} call.
+
 @see @ref Texture, @ref TextureArray, @ref CubeMapTexture,
     @ref CubeMapTextureArray, @ref RectangleTexture
+@requires_gl33 Extension @extension{ARB,sampler_objects} for sampler objects
+@requires_gles30 Sampler objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sampler objects are not available in WebGL 1.0.
 */
-class MAGNUM_EXPORT Sampler {
+class MAGNUM_EXPORT Sampler: public AbstractObject {
+    friend Implementation::TextureState;
+
     public:
         /**
          * @brief Texture filtering
@@ -253,8 +319,346 @@ class MAGNUM_EXPORT Sampler {
          * @see @fn_gl{Get} with @def_gl{MAX_TEXTURE_MAX_ANISOTROPY_EXT}
          */
         static Float maxMaxAnisotropy();
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Sampler parameters
+         *
+         * Complete sampling state of a sampler object, used as a key in
+         * @ref cached(). Default values are the same as OpenGL defaults.
+         */
+        struct MAGNUM_EXPORT Parameters {
+            /** @brief Minification filter */
+            Filter minificationFilter = Filter::Nearest;
+
+            /** @brief Mip level selection */
+            Mipmap mipmap = Mipmap::Linear;
+
+            /** @brief Magnification filter */
+            Filter magnificationFilter = Filter::Linear;
+
+            /** @brief Wrapping in all three dimensions */
+            Array3D<Wrapping> wrapping{Wrapping::Repeat};
+
+            /** @brief Minimal level of detail */
+            Float minLod = -1000.0f;
+
+            /** @brief Maximal level of detail */
+            Float maxLod = 1000.0f;
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * @brief Level of detail bias
+             *
+             * @requires_gl Texture LOD bias can be specified only directly
+             *      in fragment shader in OpenGL ES and WebGL.
+             */
+            Float lodBias = 0.0f;
+
+            /**
+             * @brief Border color
+             *
+             * @requires_gl Border color is not available for sampler objects
+             *      in OpenGL ES and WebGL.
+             */
+            Color4 borderColor{0.0f, 0.0f, 0.0f, 0.0f};
+            #endif
+
+            /**
+             * @brief Max anisotropy
+             *
+             * Ignored if @extension{EXT,texture_filter_anisotropic} is not
+             * available.
+             */
+            Float maxAnisotropy = 1.0f;
+
+            /** @brief Depth texture comparison mode */
+            CompareMode compareMode = CompareMode::None;
+
+            /** @brief Depth texture comparison function */
+            CompareFunction compareFunction = CompareFunction::LessOrEqual;
+
+            /** @brief Equality comparison */
+            bool operator==(const Parameters& other) const;
+
+            /** @brief Non-equality comparison */
+            bool operator!=(const Parameters& other) const {
+                return !operator==(other);
+            }
+        };
+
+        /**
+         * @brief Sampler object for given parameters
+         *
+         * Returns a sampler object with given parameters from a per-context
+         * cache, creating and setting it up if it's not there yet. The
+         * returned object is owned by the context and stays valid until the
+         * context is destroyed. Don't modify its parameters, as that would
+         * affect all other users of the same cache entry. See
+         * @ref Sampler-sampler-cache "class documentation" for more
+         * information.
+         */
+        static Sampler& cached(const Parameters& parameters);
+
+        /**
+         * @brief Bind samplers to given range of texture units
+         * @param firstTextureUnit  First texture unit
+         * @param samplers          Samplers. If the sampler is `nullptr`,
+         *      given texture unit is unbound.
+         *
+         * Binds first sampler in the list to @p firstTextureUnit, second to
+         * `firstTextureUnit + 1` etc. If @extension{ARB,multi_bind} (part of
+         * OpenGL 4.4) is available, the units are bound with single call,
+         * units that already have given sampler bound are skipped otherwise.
+         * @see @ref bind(Int), @ref unbind(),
+         *      @ref AbstractTexture::bind(Int, std::initializer_list<AbstractTexture*>),
+         *      @fn_gl{BindSamplers} or @fn_gl{BindSampler}
+         */
+        static void bind(Int firstTextureUnit, std::initializer_list<Sampler*> samplers);
+
+        /**
+         * @brief Unbind any sampler from given texture unit
+         *
+         * The texture bound to given unit then uses its own sampling state.
+         * @see @ref bind(), @fn_gl{BindSampler}
+         */
+        static void unbind(Int textureUnit);
+
+        /**
+         * @brief Unbind samplers from given range of texture units
+         *
+         * @see @ref bind(Int, std::initializer_list<Sampler*>),
+         *      @fn_gl{BindSamplers} or @fn_gl{BindSampler}
+         */
+        static void unbind(Int firstTextureUnit, std::size_t count);
+
+        /**
+         * @brief Wrap existing OpenGL sampler object
+         * @param id            OpenGL sampler ID
+         * @param flags         Object creation flags
+         *
+         * The @p id is expected to be of an existing OpenGL sampler object.
+         * Unlike sampler created using constructor, the OpenGL object is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static Sampler wrap(GLuint id, ObjectFlags flags = {}) {
+            return Sampler{id, flags};
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Creates new OpenGL sampler object with default parameters.
+         * @see @ref Sampler(NoCreateT), @ref wrap(), @ref cached(),
+         *      @fn_gl{GenSamplers}
+         */
+        explicit Sampler();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Sampler(NoCreateT) noexcept: _id{0}, _flags{ObjectFlag::DeleteOnDestruction} {}
+
+        /** @brief Copying is not allowed */
+        Sampler(const Sampler&) = delete;
+
+        /** @brief Move constructor */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline Sampler(Sampler&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated OpenGL sampler object.
+         * @see @ref wrap(), @ref release(), @fn_gl{DeleteSamplers}
+         */
+        ~Sampler();
+
+        /** @brief Copying is not allowed */
+        Sampler& operator=(const Sampler&) = delete;
+
+        /** @brief Move assignment */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline Sampler& operator=(Sampler&& other) noexcept;
+
+        /** @brief OpenGL sampler ID */
+        GLuint id() const { return _id; }
+
+        /**
+         * @brief Release OpenGL object
+         *
+         * Releases ownership of OpenGL sampler object and returns its ID so
+         * it is not deleted on destruction. The internal state is then
+         * equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline GLuint release();
+
+        /**
+         * @brief Set minification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is {@ref Filter::Nearest, @ref Mipmap::Linear}.
+         * @see @ref Texture::setMinificationFilter(),
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MIN_FILTER}
+         */
+        Sampler& setMinificationFilter(Filter filter, Mipmap mipmap = Mipmap::Base);
+
+        /**
+         * @brief Set magnification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Filter::Linear.
+         * @see @ref Texture::setMagnificationFilter(),
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MAG_FILTER}
+         */
+        Sampler& setMagnificationFilter(Filter filter);
+
+        /**
+         * @brief Set minimum level-of-detail parameter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `-1000.0f`.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MIN_LOD}
+         */
+        Sampler& setMinLod(Float lod);
+
+        /**
+         * @brief Set maximum level-of-detail parameter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `1000.0f`.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MAX_LOD}
+         */
+        Sampler& setMaxLod(Float lod);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set level-of-detail bias
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `0.0f`.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_LOD_BIAS}
+         * @requires_gl Texture LOD bias can be specified only directly in
+         *      fragment shader in OpenGL ES and WebGL.
+         */
+        Sampler& setLodBias(Float bias);
+        #endif
+
+        /**
+         * @brief Set wrapping
+         * @return Reference to self (for method chaining)
+         *
+         * Sets wrapping type for coordinates out of range @f$ [ 0, 1 ] @f$.
+         * Initial value is @ref Wrapping::Repeat in all dimensions.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_WRAP_S},
+         *      @def_gl{TEXTURE_WRAP_T}, @def_gl{TEXTURE_WRAP_R}
+         */
+        Sampler& setWrapping(const Array3D<Wrapping>& wrapping);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set border color
+         * @return Reference to self (for method chaining)
+         *
+         * Border color when wrapping is set to @ref Wrapping::ClampToBorder.
+         * Initial value is `0x00000000_rgbaf`.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_BORDER_COLOR}
+         * @requires_gl Border color is not available for sampler objects
+         *      in OpenGL ES and WebGL.
+         */
+        Sampler& setBorderColor(const Color4& color);
+        #endif
+
+        /**
+         * @brief Set max anisotropy
+         * @return Reference to self (for method chaining)
+         *
+         * Default value is `1.0f`, which means no anisotropy. Set to value
+         * greater than `1.0f` for anisotropic filtering. If extension
+         * @extension{EXT,texture_filter_anisotropic} (desktop or ES) is not
+         * available, this function does nothing.
+         * @see @ref maxMaxAnisotropy(), @fn_gl{SamplerParameter} with
+         *      @def_gl{TEXTURE_MAX_ANISOTROPY_EXT}
+         */
+        Sampler& setMaxAnisotropy(Float anisotropy);
+
+        /**
+         * @brief Set depth texture comparison mode
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref CompareMode::None.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_COMPARE_MODE}
+         */
+        Sampler& setCompareMode(CompareMode mode);
+
+        /**
+         * @brief Set depth texture comparison function
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref CompareFunction::LessOrEqual.
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_COMPARE_FUNC}
+         */
+        Sampler& setCompareFunction(CompareFunction function);
+
+        /**
+         * @brief Set all parameters at once
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling all setters above with values from
+         * @p parameters.
+         */
+        Sampler& setParameters(const Parameters& parameters);
+
+        /**
+         * @brief Bind sampler to given texture unit
+         *
+         * If the sampler is already bound to given unit, the function does
+         * nothing.
+         * @see @ref bind(Int, std::initializer_list<Sampler*>),
+         *      @ref unbind(), @fn_gl{BindSampler}
+         */
+        void bind(Int textureUnit);
+
+    private:
+        explicit Sampler(GLuint id, ObjectFlags flags) noexcept: _id{id}, _flags{flags} {}
+
+        static void MAGNUM_LOCAL bindImplementationFallback(GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers);
+        #ifndef MAGNUM_TARGET_GLES
+        static void MAGNUM_LOCAL bindImplementationMulti(GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers);
+        #endif
+
+        GLuint _id;
+        ObjectFlags _flags;
+        #endif
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+inline Sampler::Sampler(Sampler&& other) noexcept: _id{other._id}, _flags{other._flags} {
+    other._id = 0;
+}
+
+inline Sampler& Sampler::operator=(Sampler&& other) noexcept {
+    using std::swap;
+    swap(_id, other._id);
+    swap(_flags, other._flags);
+    return *this;
+}
+
+inline GLuint Sampler::release() {
+    const GLuint id = _id;
+    _id = 0;
+    return id;
+}
+#endif
+
 /** @debugoperatorclassenum{Magnum::Sampler,Magnum::Sampler::Filter} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Sampler::Filter value);
 
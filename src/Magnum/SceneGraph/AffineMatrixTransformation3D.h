@@ -0,0 +1,429 @@
+#ifndef Magnum_SceneGraph_AffineMatrixTransformation3D_h
+#define Magnum_SceneGraph_AffineMatrixTransformation3D_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::AffineMatrix4x3, @ref Magnum::SceneGraph::BasicAffineMatrixTransformation3D, typedef @ref Magnum::SceneGraph::AffineMatrixTransformation3D
+ */
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractTranslationRotationScaling3D.h"
+#include "Magnum/SceneGraph/Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Affine 3D transformation matrix
+
+@ref Math::Matrix4x3 with implied @f$ (0, 0, 0, 1) @f$ bottom row. The only
+difference from @ref Math::Matrix4x3 is that default constructor creates
+identity transformation instead of zero matrix, as @ref Object expects
+default-constructed transformation to be identity.
+@see @ref BasicAffineMatrixTransformation3D
+*/
+template<class T> class AffineMatrix4x3: public Math::Matrix4x3<T> {
+    public:
+        /** @brief Default constructor, creates identity transformation */
+        constexpr /*implicit*/ AffineMatrix4x3() noexcept: Math::Matrix4x3<T>{Math::Vector3<T>::xAxis(), Math::Vector3<T>::yAxis(), Math::Vector3<T>::zAxis(), Math::Vector3<T>{}} {}
+
+        /** @brief Construct from columns */
+        constexpr /*implicit*/ AffineMatrix4x3(const Math::Vector3<T>& first, const Math::Vector3<T>& second, const Math::Vector3<T>& third, const Math::Vector3<T>& fourth) noexcept: Math::Matrix4x3<T>{first, second, third, fourth} {}
+
+        /** @brief Construct from base type */
+        constexpr /*implicit*/ AffineMatrix4x3(const Math::Matrix4x3<T>& other) noexcept: Math::Matrix4x3<T>{other} {}
+};
+
+namespace Implementation {
+    /* Affine transformation matrix product, assuming (0, 0, 0, 1) as the
+       implicit bottom row of both operands -- 36 multiplications instead of
+       64 for full 4x4 matrices */
+    template<class T> AffineMatrix4x3<T> affineCompose(const Math::Matrix4x3<T>& a, const Math::Matrix4x3<T>& b) {
+        return {a[0]*b[0][0] + a[1]*b[0][1] + a[2]*b[0][2],
+                a[0]*b[1][0] + a[1]*b[1][1] + a[2]*b[1][2],
+                a[0]*b[2][0] + a[1]*b[2][1] + a[2]*b[2][2],
+                a[0]*b[3][0] + a[1]*b[3][1] + a[2]*b[3][2] + a[3]};
+    }
+
+    /* Inverse of affine transformation, inverting only the upper-left 3x3
+       part and transforming the translation with it */
+    template<class T> AffineMatrix4x3<T> affineInverted(const Math::Matrix4x3<T>& matrix) {
+        const Math::Matrix3x3<T> inverted = Math::Matrix3x3<T>{matrix[0], matrix[1], matrix[2]}.inverted();
+        return {inverted[0], inverted[1], inverted[2], -(inverted*matrix[3])};
+    }
+
+    template<class T> AffineMatrix4x3<T> affineFromMatrix(const Math::Matrix4<T>& matrix) {
+        return {matrix[0].xyz(), matrix[1].xyz(), matrix[2].xyz(), matrix[3].xyz()};
+    }
+
+    template<class T> Math::Matrix4<T> affineToMatrix(const Math::Matrix4x3<T>& matrix) {
+        return {{Math::Vector3<T>{matrix[0]}, T(0)},
+                {Math::Vector3<T>{matrix[1]}, T(0)},
+                {Math::Vector3<T>{matrix[2]}, T(0)},
+                {Math::Vector3<T>{matrix[3]}, T(1)}};
+    }
+}
+
+/**
+@brief Three-dimensional affine transformation implemented using matrices
+
+Uses @ref AffineMatrix4x3 as underlying transformation type, i.e. stores only
+the upper three rows of the transformation matrix and assumes the bottom row
+is always @f$ (0, 0, 0, 1) @f$. Compared to @ref BasicMatrixTransformation3D
+this takes 25% less memory per object and transformation composition and
+inversion done in @ref Object::setClean() and in @ref Camera::draw() is
+significantly cheaper. Conversion to @ref Math::Matrix4 is done only for the
+final absolute transformation passed to features and drawables. Projective
+transformations can't be represented, use @ref BasicMatrixTransformation3D if
+you need them.
+@see @ref scenegraph, @ref AffineMatrixTransformation3D,
+    @ref BasicMatrixTransformation3D, @ref BasicRigidMatrixTransformation3D
+*/
+template<class T> class BasicAffineMatrixTransformation3D: public AbstractBasicTranslationRotationScaling3D<T> {
+    public:
+        /** @brief Underlying transformation type */
+        typedef AffineMatrix4x3<T> DataType;
+
+        /** @brief Object transformation */
+        AffineMatrix4x3<T> transformation() const { return _transformation; }
+
+        /**
+         * @brief Set transformation
+         * @return Reference to self (for method chaining)
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& setTransformation(const Math::Matrix4x3<T>& transformation) {
+            /* Setting transformation is forbidden for the scene */
+            /** @todo Assert for this? */
+            if(!static_cast<Object<BasicAffineMatrixTransformation3D<T>>*>(this)->isScene()) {
+                _transformation = transformation;
+                static_cast<Object<BasicAffineMatrixTransformation3D<T>>*>(this)->setDirty();
+            }
+
+            return static_cast<Object<BasicAffineMatrixTransformation3D<T>>&>(*this);
+        }
+
+        /**
+         * @brief Set transformation from full matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the matrix represents affine transformation, i.e. its
+         * bottom row is @f$ (0, 0, 0, 1) @f$.
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& setTransformation(const Math::Matrix4<T>& transformation);
+
+        /** @copydoc AbstractTranslationRotationScaling3D::resetTransformation() */
+        Object<BasicAffineMatrixTransformation3D<T>>& resetTransformation() {
+            return setTransformation(AffineMatrix4x3<T>{});
+        }
+
+        /**
+         * @brief Transform object
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref transformLocal()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& transform(const Math::Matrix4x3<T>& transformation) {
+            return setTransformation(Implementation::affineCompose(transformation, _transformation));
+        }
+
+        /**
+         * @overload
+         *
+         * The bottom row of the matrix is ignored.
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& transform(const Math::Matrix4<T>& transformation) {
+            return transform(Implementation::affineFromMatrix(transformation));
+        }
+
+        /**
+         * @brief Transform object as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others.
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& transformLocal(const Math::Matrix4x3<T>& transformation) {
+            return setTransformation(Implementation::affineCompose(_transformation, transformation));
+        }
+
+        /**
+         * @overload
+         *
+         * The bottom row of the matrix is ignored.
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& transformLocal(const Math::Matrix4<T>& transformation) {
+            return transformLocal(Implementation::affineFromMatrix(transformation));
+        }
+
+        /**
+         * @brief Translate object
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref transform() with
+         * @ref Math::Matrix4::translation(), but only the translation part is
+         * touched.
+         * @see @ref translateLocal(), @ref Math::Vector3::xAxis(),
+         *      @ref Math::Vector3::yAxis(), @ref Math::Vector3::zAxis()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& translate(const Math::Vector3<T>& vector) {
+            AffineMatrix4x3<T> transformation = _transformation;
+            transformation[3] += vector;
+            return setTransformation(transformation);
+        }
+
+        /**
+         * @brief Translate object as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others.
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& translateLocal(const Math::Vector3<T>& vector) {
+            AffineMatrix4x3<T> transformation = _transformation;
+            transformation[3] += _transformation[0]*vector[0] + _transformation[1]*vector[1] + _transformation[2]*vector[2];
+            return setTransformation(transformation);
+        }
+
+        /**
+         * @brief Rotate object
+         * @param angle             Angle (counterclockwise)
+         * @param normalizedAxis    Normalized rotation axis
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::rotation().
+         * @see @ref rotateLocal(), @ref rotateX(), @ref rotateY(),
+         *      @ref rotateZ(), @ref Math::Vector3::xAxis(),
+         *      @ref Math::Vector3::yAxis(), @ref Math::Vector3::zAxis()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotate(Math::Rad<T> angle, const Math::Vector3<T>& normalizedAxis) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::rotation(angle, normalizedAxis)));
+        }
+
+        /**
+         * @brief Rotate object as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::rotation().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateLocal(Math::Rad<T> angle, const Math::Vector3<T>& normalizedAxis) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::rotation(angle, normalizedAxis)));
+        }
+
+        /**
+         * @brief Rotate object around X axis
+         * @param angle             Angle (counterclockwise)
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::rotationX().
+         * @see @ref rotateXLocal()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateX(Math::Rad<T> angle) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationX(angle)));
+        }
+
+        /**
+         * @brief Rotate object around X axis as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::rotationX().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateXLocal(Math::Rad<T> angle) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationX(angle)));
+        }
+
+        /**
+         * @brief Rotate object around Y axis
+         * @param angle             Angle (counterclockwise)
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::rotationY().
+         * @see @ref rotateYLocal()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateY(Math::Rad<T> angle) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationY(angle)));
+        }
+
+        /**
+         * @brief Rotate object around Y axis as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::rotationY().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateYLocal(Math::Rad<T> angle) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationY(angle)));
+        }
+
+        /**
+         * @brief Rotate object around Z axis
+         * @param angle             Angle (counterclockwise)
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::rotationZ().
+         * @see @ref rotateZLocal()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateZ(Math::Rad<T> angle) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationZ(angle)));
+        }
+
+        /**
+         * @brief Rotate object around Z axis as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::rotationZ().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& rotateZLocal(Math::Rad<T> angle) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::rotationZ(angle)));
+        }
+
+        /**
+         * @brief Scale object
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::scaling().
+         * @see @ref scaleLocal(), @ref Math::Vector3::xScale(),
+         *      @ref Math::Vector3::yScale(), @ref Math::Vector3::zScale()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& scale(const Math::Vector3<T>& vector) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::scaling(vector)));
+        }
+
+        /**
+         * @brief Scale object as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::scaling().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& scaleLocal(const Math::Vector3<T>& vector) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::scaling(vector)));
+        }
+
+        /**
+         * @brief Reflect object
+         * @param normal    Normal of the plane through which to reflect
+         *      (normalized)
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref transform() with @ref Math::Matrix4::reflection().
+         * @see @ref reflectLocal()
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& reflect(const Math::Vector3<T>& normal) {
+            return transform(Implementation::affineFromMatrix(Math::Matrix4<T>::reflection(normal)));
+        }
+
+        /**
+         * @brief Reflect object as a local transformation
+         *
+         * Similar to the above, except that the transformation is applied
+         * before all others. Same as calling @ref transformLocal() with
+         * @ref Math::Matrix4::reflection().
+         */
+        Object<BasicAffineMatrixTransformation3D<T>>& reflectLocal(const Math::Vector3<T>& normal) {
+            return transformLocal(Implementation::affineFromMatrix(Math::Matrix4<T>::reflection(normal)));
+        }
+
+    protected:
+        /* Allow construction only from Object */
+        explicit BasicAffineMatrixTransformation3D() = default;
+
+    private:
+        void doResetTransformation() override final { resetTransformation(); }
+
+        void doTranslate(const Math::Vector3<T>& vector) override final { translate(vector); }
+        void doTranslateLocal(const Math::Vector3<T>& vector) override final { translateLocal(vector); }
+
+        void doRotate(Math::Rad<T> angle, const Math::Vector3<T>& normalizedAxis) override final {
+            rotate(angle, normalizedAxis);
+        }
+        void doRotateLocal(Math::Rad<T> angle, const Math::Vector3<T>& normalizedAxis) override final {
+            rotateLocal(angle, normalizedAxis);
+        }
+
+        void doRotateX(Math::Rad<T> angle) override final { rotateX(angle); }
+        void doRotateXLocal(Math::Rad<T> angle) override final { rotateXLocal(angle); }
+
+        void doRotateY(Math::Rad<T> angle) override final { rotateY(angle); }
+        void doRotateYLocal(Math::Rad<T> angle) override final { rotateYLocal(angle); }
+
+        void doRotateZ(Math::Rad<T> angle) override final { rotateZ(angle); }
+        void doRotateZLocal(Math::Rad<T> angle) override final { rotateZLocal(angle); }
+
+        void doScale(const Math::Vector3<T>& vector) override final { scale(vector); }
+        void doScaleLocal(const Math::Vector3<T>& vector) override final { scaleLocal(vector); }
+
+        AffineMatrix4x3<T> _transformation;
+};
+
+/**
+@brief Three-dimensional affine transformation for float scenes implemented using matrices
+
+@see @ref MatrixTransformation3D
+*/
+typedef BasicAffineMatrixTransformation3D<Float> AffineMatrixTransformation3D;
+
+template<class T> Object<BasicAffineMatrixTransformation3D<T>>& BasicAffineMatrixTransformation3D<T>::setTransformation(const Math::Matrix4<T>& transformation) {
+    CORRADE_ASSERT(transformation.row(3) == Math::Vector4<T>{T(0), T(0), T(0), T(1)},
+        "SceneGraph::AffineMatrixTransformation3D::setTransformation(): the matrix doesn't represent affine transformation",
+        static_cast<Object<BasicAffineMatrixTransformation3D<T>>&>(*this));
+    return setTransformation(Implementation::affineFromMatrix(transformation));
+}
+
+namespace Implementation {
+
+template<class T> struct Transformation<BasicAffineMatrixTransformation3D<T>> {
+    static AffineMatrix4x3<T> fromMatrix(const Math::Matrix4<T>& matrix) {
+        CORRADE_ASSERT(matrix.row(3) == Math::Vector4<T>{T(0), T(0), T(0), T(1)},
+            "SceneGraph::AffineMatrixTransformation3D: the matrix doesn't represent affine transformation", {});
+        return affineFromMatrix(matrix);
+    }
+
+    static Math::Matrix4<T> toMatrix(const Math::Matrix4x3<T>& transformation) {
+        return affineToMatrix(transformation);
+    }
+
+    static AffineMatrix4x3<T> compose(const Math::Matrix4x3<T>& parent, const Math::Matrix4x3<T>& child) {
+        return affineCompose(parent, child);
+    }
+
+    static AffineMatrix4x3<T> inverted(const Math::Matrix4x3<T>& transformation) {
+        return affineInverted(transformation);
+    }
+
+    static Math::Matrix4<T> invertedMatrix(const Math::Matrix4<T>& matrix) {
+        return affineToMatrix(affineInverted(affineFromMatrix(matrix)));
+    }
+};
+
+}
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicAffineMatrixTransformation3D<Float>>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph {
+
+Arena::Arena(const std::size_t blockSize): _blockSize{blockSize}, _blockOffset{} {}
+
+Arena::~Arena() { clear(); }
+
+void* Arena::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_INTERNAL_ASSERT(alignment <= alignof(std::max_align_t));
+
+    /* Try to fit into the current block */
+    if(!_blocks.empty()) {
+        const std::size_t offset = (_blockOffset + alignment - 1)/alignment*alignment;
+        if(offset + size <= _blocks.back().second) {
+            _blockOffset = offset + size;
+            return _blocks.back().first.get() + offset;
+        }
+    }
+
+    /* Allocate a new one, large enough for the instance */
+    const std::size_t blockSize = std::max(_blockSize, size);
+    _blocks.emplace_back(std::unique_ptr<char[]>{new char[blockSize]}, blockSize);
+    _blockOffset = size;
+    return _blocks.back().first.get();
+}
+
+void Arena::clear() {
+    /* Detach everything first, so no instance gets deleted by its parent
+       regardless of the destruction order */
+    for(auto it = _instances.rbegin(); it != _instances.rend(); ++it)
+        it->detach(it->pointer);
+    for(auto it = _instances.rbegin(); it != _instances.rend(); ++it)
+        it->destroy(it->pointer);
+    _instances.clear();
+
+    /* Keep the first block for reuse */
+    if(_blocks.size() > 1) _blocks.erase(_blocks.begin() + 1, _blocks.end());
+    _blockOffset = 0;
+}
+
+}}
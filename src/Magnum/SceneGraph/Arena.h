@@ -0,0 +1,158 @@
+#ifndef Magnum_SceneGraph_Arena_h
+#define Magnum_SceneGraph_Arena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Arena
+ */
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    /* Cut objects and features from their parents so destroying the parent
+       doesn't try to delete them. Types deriving from both Object and
+       AbstractFeature get both overloads called, other types none. */
+    template<class Transformation> void arenaDetachObject(Object<Transformation>* object) {
+        if(object->parent()) object->parent()->children().cut(object);
+    }
+    inline void arenaDetachObject(const void*) {}
+
+    template<UnsignedInt dimensions, class T> void arenaDetachFeature(AbstractFeature<dimensions, T>* feature) {
+        feature->object().features().cut(feature);
+    }
+    inline void arenaDetachFeature(const void*) {}
+}
+
+/**
+@brief Arena allocator for objects and features
+
+Allocates objects and features in large contiguous blocks instead of
+individually on the heap, making hierarchy traversal more cache-friendly and
+scene teardown faster. Each @ref Scene has its own arena accessible through
+@ref Scene::arena(), but the class can be used standalone as well.
+@code
+Scene3D scene;
+Object3D& object = scene.arena().create<Object3D>(&scene);
+Drawable& drawable = scene.arena().create<MyDrawable>(object, &drawables);
+@endcode
+
+Objects and features created in the arena are owned by it, not by their
+parents --- they are destroyed in reverse creation order when the arena is
+destroyed or @ref clear() is called, after being detached from the
+hierarchy, so it doesn't matter whether their parent was created in the arena
+or on the heap. Heap-allocated children of arena-allocated objects are
+deleted by their parents as usual. Objects and features created in the arena
+must not be deleted explicitly and the arena has to be destroyed before any
+heap-allocated parents of its instances, which is always the case for
+@ref Scene::arena().
+*/
+class MAGNUM_SCENEGRAPH_EXPORT Arena {
+    public:
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a single memory block in bytes
+         *
+         * Objects larger than @p blockSize get a dedicated block.
+         */
+        explicit Arena(std::size_t blockSize = 65536);
+
+        /** @brief Copying is not allowed */
+        Arena(const Arena&) = delete;
+
+        /** @brief Moving is not allowed */
+        Arena(Arena&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref clear().
+         */
+        ~Arena();
+
+        /** @brief Copying is not allowed */
+        Arena& operator=(const Arena&) = delete;
+
+        /** @brief Moving is not allowed */
+        Arena& operator=(Arena&&) = delete;
+
+        /** @brief Count of instances living in the arena */
+        std::size_t size() const { return _instances.size(); }
+
+        /** @brief Count of allocated memory blocks */
+        std::size_t blockCount() const { return _blocks.size(); }
+
+        /**
+         * @brief Create an instance in the arena
+         *
+         * Constructs @p T with given arguments in arena memory and returns
+         * reference to it. The instance is owned by the arena.
+         */
+        template<class T, class ...Args> T& create(Args&&... args) {
+            T* const instance = new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            _instances.push_back({instance,
+                [](void* p) {
+                    Implementation::arenaDetachObject(static_cast<T*>(p));
+                    Implementation::arenaDetachFeature(static_cast<T*>(p));
+                },
+                [](void* p) { static_cast<T*>(p)->~T(); }});
+            return *instance;
+        }
+
+        /**
+         * @brief Destroy all instances
+         *
+         * Detaches all instances from their parents and objects, destroys
+         * them in reverse creation order and releases all memory except for
+         * the first block, which is reused.
+         */
+        void clear();
+
+    private:
+        struct Instance {
+            void* pointer;
+            void(*detach)(void*);
+            void(*destroy)(void*);
+        };
+
+        void* allocate(std::size_t size, std::size_t alignment);
+
+        std::size_t _blockSize, _blockOffset;
+        std::vector<std::pair<std::unique_ptr<char[]>, std::size_t>> _blocks;
+        std::vector<Instance> _instances;
+};
+
+}}
+
+#endif
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
  */
 
+#include <array>
+
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
@@ -235,11 +237,52 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. Transformations of the drawables
+         * are computed into temporary storage kept in the camera and reused
+         * for subsequent calls, thus drawing the same group again doesn't
+         * need any allocations.
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw with frustum culling
+         * @return Count of drawn and culled drawables
+         *
+         * Similar to @ref draw(), but drawables that have a bounding sphere
+         * set with @ref Drawable::setBoundingSphere() and are completely
+         * outside of the view frustum defined by
+         * @ref projectionMatrix()*@ref cameraMatrix() are skipped before
+         * their transformation relative to the camera is computed. Drawables
+         * without bounding sphere are always drawn. The drawables are drawn
+         * in the same order as in @ref draw(). Cameras with more views, such
+         * as @ref MultiViewCamera3D, cull only drawables that are outside of
+         * all views.
+         */
+        std::pair<std::size_t, std::size_t> drawCulled(DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Transformation matrices of drawables relative to the camera
+         *
+         * Puts transformations of all drawables in given group relative to
+         * the camera into @p out, in the same order as in the group, without
+         * calling @ref Drawable::draw(). Temporary data are reused between
+         * calls the same way as in @ref draw(), if @p out has enough capacity
+         * no allocations are done.
+         *
+         * Useful for instanced drawing of groups where all drawables share
+         * the same mesh and shader --- the matrices can be uploaded into
+         * a per-instance buffer and the whole group drawn with a single draw
+         * call, see @ref SceneGraph-Drawable-instanced "Drawable documentation"
+         * for an example.
+         */
+        void drawableTransformationMatrices(DrawableGroup<dimensions, T>& group, std::vector<MatrixTypeFor<dimensions, T>>& out);
+
     private:
+        /* Views used for culling in drawCulled(), projection*view of each is
+           applied after the camera matrix. There's just one by default. */
+        virtual std::size_t doViewCount() const { return 1; }
+        virtual MatrixTypeFor<dimensions, T> doViewProjectionMatrix(std::size_t) const { return _projectionMatrix; }
+
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
             _cameraMatrix = invertedAbsoluteTransformationMatrix;
@@ -254,6 +297,12 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+
+        /* Temporary storage for draw(), drawCulled() and
+           drawableTransformationMatrices(), reused to avoid allocations */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _drawableObjects;
+        std::vector<MatrixTypeFor<dimensions, T>> _drawableTransformations;
+        std::vector<std::array<Math::Vector<dimensions + 1, T>, dimensions*2>> _frustumPlanes;
 };
 
 /**
@@ -29,6 +29,9 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include <array>
+
+#include "Magnum/Tracing.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -53,6 +56,37 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+/* Frustum planes in world space extracted from combined projection and camera
+   matrix. The point is inside if -w <= x_i <= w for all i in clip
+   coordinates, i.e. (row_w +/- row_i)*p >= 0. The planes are normalized so
+   dot product with a point gives signed distance. */
+template<UnsignedInt dimensions, class T> std::array<Math::Vector<dimensions + 1, T>, dimensions*2> frustumPlanes(const MatrixTypeFor<dimensions, T>& matrix) {
+    std::array<Math::Vector<dimensions + 1, T>, dimensions*2> planes;
+    const Math::Vector<dimensions + 1, T> w = matrix.row(dimensions);
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        const Math::Vector<dimensions + 1, T> row = matrix.row(i);
+        planes[i*2] = w + row;
+        planes[i*2 + 1] = w - row;
+    }
+
+    for(Math::Vector<dimensions + 1, T>& plane: planes) {
+        const T length = Math::Vector<dimensions, T>::pad(plane).length();
+        if(length != T(0)) plane /= length;
+    }
+
+    return planes;
+}
+
+/* Whether given sphere in world space is at least partially inside given
+   frustum */
+template<UnsignedInt dimensions, class T> bool sphereInFrustum(const std::array<Math::Vector<dimensions + 1, T>, dimensions*2>& planes, const VectorTypeFor<dimensions, T>& center, const T radius) {
+    for(const Math::Vector<dimensions + 1, T>& plane: planes)
+        if(Math::dot(Math::Vector<dimensions, T>::pad(plane), center) + plane[dimensions] < -radius)
+            return false;
+
+    return true;
+}
+
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
@@ -83,23 +117,94 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
 }
 
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+    CORRADE_ASSERT(this->object().scene(), "Camera::draw(): cannot draw when camera is not part of any scene", );
+    MAGNUM_TRACE_ZONE("SceneGraph::Camera::draw");
+
+    /* Compute transformations of all objects in the group relative to the
+       camera, reusing the storage from previous calls */
+    drawableTransformationMatrices(group, _drawableTransformations);
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != _drawableTransformations.size(); ++i)
+        group[i].draw(_drawableTransformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::drawableTransformationMatrices(DrawableGroup<dimensions, T>& group, std::vector<MatrixTypeFor<dimensions, T>>& out) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
-    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+    CORRADE_ASSERT(scene, "Camera::drawableTransformationMatrices(): camera is not part of any scene", );
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
+    _drawableObjects.clear();
+    _drawableObjects.reserve(group.size());
     for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+        _drawableObjects.push_back(group[i].object());
+    scene->transformationMatrices(_drawableObjects, out, _cameraMatrix);
+}
 
-    /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+template<UnsignedInt dimensions, class T> std::pair<std::size_t, std::size_t> Camera<dimensions, T>::drawCulled(DrawableGroup<dimensions, T>& group) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "Camera::drawCulled(): cannot draw when camera is not part of any scene", {});
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Clean cached absolute transformations of all cullable drawables. This
+       is a no-op for objects that didn't move since last time. */
+    _drawableObjects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i)
+        if(group[i].hasBoundingSphere() && (group[i].cachedTransformations() & CachedTransformation::Absolute))
+            _drawableObjects.push_back(group[i].object());
+    AbstractObject<dimensions, T>::setClean(_drawableObjects);
+
+    /* Compute transformations of all non-cullable drawables relative to the
+       camera in a batch */
+    _drawableObjects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i)
+        if(!group[i].hasBoundingSphere() || !(group[i].cachedTransformations() & CachedTransformation::Absolute))
+            _drawableObjects.push_back(group[i].object());
+    scene->transformationMatrices(_drawableObjects, _drawableTransformations, _cameraMatrix);
+
+    /* Frustum planes of all views */
+    _frustumPlanes.clear();
+    for(std::size_t i = 0, viewCount = doViewCount(); i != viewCount; ++i)
+        _frustumPlanes.push_back(Implementation::frustumPlanes<dimensions, T>(doViewProjectionMatrix(i)*_cameraMatrix));
+
+    /* Draw the culled and non-cullable drawables in the original order */
+    std::size_t drawn = 0, culled = 0, nonCullable = 0;
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        Drawable<dimensions, T>& drawable = group[i];
+        if(!drawable.hasBoundingSphere() || !(drawable.cachedTransformations() & CachedTransformation::Absolute)) {
+            drawable.draw(_drawableTransformations[nonCullable++], *this);
+            ++drawn;
+            continue;
+        }
+
+        /* Transform the sphere to world space, take the largest scaling for
+           the radius */
+        const MatrixTypeFor<dimensions, T>& absolute = drawable._absoluteTransformationMatrix;
+        T scaling{};
+        for(std::size_t j = 0; j != dimensions; ++j)
+            scaling = Math::max(scaling, Math::Vector<dimensions, T>::pad(absolute[j]).length());
+        const VectorTypeFor<dimensions, T> center = absolute.transformPoint(drawable._boundingSphereCenter);
+        const T radius = drawable._boundingSphereRadius*scaling;
+        bool visible = false;
+        for(const auto& planes: _frustumPlanes) {
+            if(!Implementation::sphereInFrustum<dimensions, T>(planes, center, radius)) continue;
+            visible = true;
+            break;
+        }
+        if(!visible) {
+            ++culled;
+            continue;
+        }
+
+        drawable.draw(_cameraMatrix*absolute, *this);
+        ++drawn;
+    }
+
+    return {drawn, culled};
 }
 
 }}
@@ -155,6 +155,65 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+## Frustum culling
+
+If the drawable has a bounding sphere set using @ref setBoundingSphere(), it
+can be skipped by @ref Camera::drawCulled() when it's completely outside of
+the view frustum. The culling is done before any transformation relative to
+the camera is computed, which is then done only for the visible drawables.
+@code
+auto cube = new RedCube(&scene, &drawables);
+cube->setBoundingSphere({}, Constants::sqrt3());
+
+// ...
+
+std::pair<std::size_t, std::size_t> stats = camera->drawCulled(drawables);
+Debug() << "Drawn" << stats.first << "objects, culled" << stats.second;
+@endcode
+
+The absolute transformation of the drawable is cached for this purpose, see
+@ref setBoundingSphere() for more information.
+
+@anchor SceneGraph-Drawable-instanced
+## Instanced drawing
+
+If many drawables share the same mesh and shader, calling @ref draw() for each
+of them means one draw call and a set of uniform uploads per object. Instead,
+put all of them into a dedicated group and use
+@ref Camera::drawableTransformationMatrices() to get their transformations
+relative to the camera. The matrices can then be uploaded into a per-instance
+buffer and the whole group drawn with a single instanced draw call, for
+example using @ref Shaders::Phong::Flag::InstancedTransformation:
+@code
+Buffer instances;
+mesh.addVertexBufferInstanced(instances, 1, 0,
+    Shaders::Phong::TransformationMatrix{});
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation};
+SceneGraph::DrawableGroup3D crowd;
+std::vector<Matrix4> transformations;
+
+void MyApplication::drawEvent() {
+    camera.drawableTransformationMatrices(crowd, transformations);
+    instances.setData(transformations, BufferUsage::StreamDraw);
+    mesh.setInstanceCount(transformations.size());
+
+    shader.setProjectionMatrix(camera.projectionMatrix())
+        .setTransformationMatrix({})
+        .setNormalMatrix({});
+    mesh.draw(shader);
+
+    // ...
+}
+@endcode
+
+The @ref draw() function of drawables in such group is never called, so it
+can be left empty.
+
+If there are many such groups, each needing its own instance buffer, the
+transformations of all of them can be put into a single
+@ref TransformationPalette instead, which is then indexed by instance ID in
+the shader using @ref Shaders::Phong::Flag::TransformationTexture.
+
 ## Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -169,6 +228,8 @@ errors. See also @ref compilation-speedup-hpp for more information.
     @ref Drawable2D, @ref Drawable3D, @ref DrawableGroup
 */
 template<UnsignedInt dimensions, class T> class Drawable: public AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T> {
+    friend Camera<dimensions, T>;
+
     public:
         /**
          * @brief Constructor
@@ -203,6 +264,61 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+        /**
+         * @brief Whether the drawable has bounding sphere
+         *
+         * @see @ref setBoundingSphere()
+         */
+        bool hasBoundingSphere() const { return _boundingSphereRadius >= T(0); }
+
+        /**
+         * @brief Bounding sphere center
+         *
+         * In object local coordinates.
+         * @see @ref hasBoundingSphere(), @ref setBoundingSphere()
+         */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const {
+            return _boundingSphereCenter;
+        }
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * In object local coordinates. Negative if the drawable has no
+         * bounding sphere.
+         * @see @ref hasBoundingSphere(), @ref setBoundingSphere()
+         */
+        T boundingSphereRadius() const { return _boundingSphereRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @param center    Sphere center in object local coordinates
+         * @param radius    Sphere radius in object local coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * The sphere is used by @ref Camera::drawCulled() to skip drawables
+         * outside of the view frustum. Non-uniform scaling of the object is
+         * accounted for by taking the largest scaling factor. Negative
+         * @p radius removes the bounding sphere, drawables without bounding
+         * sphere are never culled.
+         *
+         * Enables caching of @ref CachedTransformation::Absolute "absolute transformation"
+         * and sets the object as dirty. If you override @ref clean() in a
+         * subclass, you need to call the original implementation. If the
+         * absolute transformation caching is disabled afterwards, the
+         * drawable is not culled.
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+    protected:
+        /** Caches absolute transformation for frustum culling */
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+    private:
+        VectorTypeFor<dimensions, T> _boundingSphereCenter;
+        T _boundingSphereRadius;
+        MatrixTypeFor<dimensions, T> _absoluteTransformationMatrix;
 };
 
 /**
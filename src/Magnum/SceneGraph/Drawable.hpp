@@ -33,7 +33,24 @@
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _boundingSphereRadius(T(-1)) {}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _boundingSphereCenter = center;
+    _boundingSphereRadius = radius;
+
+    /* Ensure the cached absolute transformation gets computed */
+    if(radius >= T(0)) {
+        AbstractFeature<dimensions, T>::setCachedTransformations(AbstractFeature<dimensions, T>::cachedTransformations()|CachedTransformation::Absolute);
+        AbstractFeature<dimensions, T>::object().setDirty();
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    _absoluteTransformationMatrix = absoluteTransformationMatrix;
+}
 
 }}
 
@@ -271,6 +271,13 @@ template<class T> struct Transformation<BasicDualComplexTransformation<T>> {
     static Math::DualComplex<T> inverted(const Math::DualComplex<T>& transformation) {
         return transformation.invertedNormalized();
     }
+
+    /* The matrix is rigid by construction, not using invertedRigid() to
+       avoid asserting on accumulated floating-point drift */
+    static Math::Matrix3<T> invertedMatrix(const Math::Matrix3<T>& matrix) {
+        const Math::Matrix2x2<T> inverseRotation = matrix.rotationScaling().transposed();
+        return Math::Matrix3<T>::from(inverseRotation, inverseRotation*-matrix.translation());
+    }
 };
 
 }
@@ -346,6 +346,13 @@ template<class T> struct Transformation<BasicDualQuaternionTransformation<T>> {
     static Math::DualQuaternion<T> inverted(const Math::DualQuaternion<T>& transformation) {
         return transformation.invertedNormalized();
     }
+
+    /* The matrix is rigid by construction, not using invertedRigid() to
+       avoid asserting on accumulated floating-point drift */
+    static Math::Matrix4<T> invertedMatrix(const Math::Matrix4<T>& matrix) {
+        const Math::Matrix3x3<T> inverseRotation = matrix.rotationScaling().transposed();
+        return Math::Matrix4<T>::from(inverseRotation, inverseRotation*-matrix.translation());
+    }
 };
 
 }
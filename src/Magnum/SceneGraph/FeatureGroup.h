@@ -29,7 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::AbstractFeatureGroup, @ref Magnum::SceneGraph::FeatureGroup, alias @ref Magnum::SceneGraph::BasicFeatureGroup2D, @ref Magnum::SceneGraph::BasicFeatureGroup3D, @ref Magnum::SceneGraph::FeatureGroup2D, @ref Magnum::SceneGraph::FeatureGroup3D
  */
 
+#include <initializer_list>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/SceneGraph/SceneGraph.h"
@@ -49,7 +51,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
     virtual ~AbstractFeatureGroup();
 
     void add(AbstractFeature<dimensions, T>& feature);
-    void remove(AbstractFeature<dimensions, T>& feature);
+    void remove(std::size_t index);
 
     std::vector<std::reference_wrapper<AbstractFeature<dimensions, T>>> features;
 };
@@ -58,6 +60,17 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
 @brief Group of features
 
 See @ref AbstractGroupedFeature for more information.
+
+## Removing features
+
+Each feature knows its position in the group, so removing it is a
+constant-time operation. By default the last feature of the group is moved
+into place of the removed one, thus the order of features is not preserved.
+If the order matters (for example when drawing transparent objects), enable
+it using @ref setOrdered(), removal is then linear in the number of features
+following the removed one. To remove many features at once, use
+@ref remove(Containers::ArrayView<const std::reference_wrapper<Feature>>),
+which in ordered groups compacts the whole group in a single pass.
 @see @ref scenegraph, @ref BasicFeatureGroup2D, @ref BasicFeatureGroup3D,
     @ref FeatureGroup2D, @ref FeatureGroup3D
 */
@@ -94,6 +107,27 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
             return static_cast<Feature&>(AbstractFeatureGroup<dimensions, T>::features[index].get());
         }
 
+        /**
+         * @brief Whether the group preserves order of features on removal
+         *
+         * @see @ref setOrdered()
+         */
+        bool isOrdered() const { return _ordered; }
+
+        /**
+         * @brief Preserve order of features on removal
+         * @return Reference to self (for method chaining)
+         *
+         * If disabled, @ref remove() moves the last feature into place of the
+         * removed one, which is a constant-time operation. If enabled, all
+         * features following the removed one are shifted. Disabled by
+         * default.
+         */
+        FeatureGroup<dimensions, Feature, T>& setOrdered(bool ordered) {
+            _ordered = ordered;
+            return *this;
+        }
+
         /**
          * @brief Add feature to the group
          * @return Reference to self (for method chaining)
@@ -103,14 +137,43 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          */
         FeatureGroup<dimensions, Feature, T>& add(Feature& feature);
 
+        /**
+         * @brief Add features to the group
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref add(Feature&) for each feature, but
+         * reserves the memory only once.
+         */
+        FeatureGroup<dimensions, Feature, T>& add(Containers::ArrayView<const std::reference_wrapper<Feature>> features);
+
+        /** @overload */
+        FeatureGroup<dimensions, Feature, T>& add(std::initializer_list<std::reference_wrapper<Feature>> features);
+
         /**
          * @brief Remove feature from the group
          * @return Reference to self (for method chaining)
          *
-         * The feature must be part of the group.
+         * The feature must be part of the group. Order of remaining features
+         * is preserved only if @ref isOrdered() is set.
          * @see @ref add()
          */
         FeatureGroup<dimensions, Feature, T>& remove(Feature& feature);
+
+        /**
+         * @brief Remove features from the group
+         * @return Reference to self (for method chaining)
+         *
+         * All features must be part of the group. If @ref isOrdered() is
+         * set, the group is compacted in a single pass instead of shifting
+         * the features for each removal.
+         */
+        FeatureGroup<dimensions, Feature, T>& remove(Containers::ArrayView<const std::reference_wrapper<Feature>> features);
+
+        /** @overload */
+        FeatureGroup<dimensions, Feature, T>& remove(std::initializer_list<std::reference_wrapper<Feature>> features);
+
+    private:
+        bool _ordered{};
 };
 
 /**
@@ -167,20 +230,77 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
         feature._group->remove(feature);
 
     /* Crossreference the feature and group together */
+    feature._groupIndex = AbstractFeatureGroup<dimensions, T>::features.size();
     AbstractFeatureGroup<dimensions, T>::add(feature);
     feature._group = this;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::add(Containers::ArrayView<const std::reference_wrapper<Feature>> features) {
+    AbstractFeatureGroup<dimensions, T>::features.reserve(AbstractFeatureGroup<dimensions, T>::features.size() + features.size());
+    for(Feature& feature: features) add(feature);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class Feature, class T> inline FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::add(std::initializer_list<std::reference_wrapper<Feature>> features) {
+    return add(Containers::ArrayView<const std::reference_wrapper<Feature>>{features.begin(), features.size()});
+}
+
 template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(Feature& feature) {
     CORRADE_ASSERT(feature._group == this,
         "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
 
-    AbstractFeatureGroup<dimensions, T>::remove(feature);
+    auto& features = AbstractFeatureGroup<dimensions, T>::features;
+    const std::size_t index = feature._groupIndex;
+
+    /* Shift all following features and update their indices */
+    if(_ordered) {
+        features.erase(features.begin() + index);
+        for(std::size_t i = index; i != features.size(); ++i)
+            static_cast<Feature&>(features[i].get())._groupIndex = i;
+
+    /* Move the last feature in place of the removed one */
+    } else {
+        AbstractFeatureGroup<dimensions, T>::remove(index);
+        if(index != features.size())
+            static_cast<Feature&>(features[index].get())._groupIndex = index;
+    }
+
     feature._group = nullptr;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(Containers::ArrayView<const std::reference_wrapper<Feature>> features) {
+    /* Swap-and-pop is constant for each feature already */
+    if(!_ordered) {
+        for(Feature& feature: features) remove(feature);
+        return *this;
+    }
+
+    /* Detach the features, then compact the group in a single pass, keeping
+       only features that still belong here */
+    for(Feature& feature: features) {
+        CORRADE_ASSERT(feature._group == this,
+            "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
+        feature._group = nullptr;
+    }
+
+    auto& groupFeatures = AbstractFeatureGroup<dimensions, T>::features;
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != groupFeatures.size(); ++i) {
+        Feature& feature = static_cast<Feature&>(groupFeatures[i].get());
+        if(feature._group != this) continue;
+        feature._groupIndex = out;
+        groupFeatures[out++] = groupFeatures[i];
+    }
+    groupFeatures.erase(groupFeatures.begin() + out, groupFeatures.end());
+    return *this;
+}
+
+template<UnsignedInt dimensions, class Feature, class T> inline FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(std::initializer_list<std::reference_wrapper<Feature>> features) {
+    return remove(Containers::ArrayView<const std::reference_wrapper<Feature>>{features.begin(), features.size()});
+}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<2, Float>;
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<3, Float>;
@@ -0,0 +1,224 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatScene
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat scene
+
+Alternative scene representation for large numbers of objects that don't need
+features attached directly. Instead of a linked hierarchy of @ref Object
+instances, parent indices, local and absolute transformations are stored in
+contiguous arrays, indexed by object ID. The same transformation classes as
+for @ref Object are supported, e.g.:
+@code
+SceneGraph::FlatScene<SceneGraph::DualQuaternionTransformation> scene;
+UnsignedInt body = scene.add(-1, DualQuaternion::translation({0.0f, 1.0f, 0.0f}));
+UnsignedInt arm = scene.add(body, DualQuaternion::rotation(15.0_degf, Vector3::zAxis()));
+// ...
+
+scene.setTransformation(body, DualQuaternion::translation({2.0f, 1.0f, 0.0f}));
+scene.setClean();
+Matrix4 armMatrix = scene.absoluteTransformationMatrix(arm);
+@endcode
+
+@section SceneGraph-FlatScene-ordering Object ordering
+
+Parent of each object must be added before the object itself, so object with
+ID @f$ i @f$ always has parent with ID less than @f$ i @f$. Thanks to that, all
+absolute transformations can be updated in @ref setClean() with a single
+linear pass over the arrays, without any recursion or pointer chasing. Adding
+the objects in depth-first order additionally keeps subtrees close together
+in memory.
+
+Objects can't be removed or reparented, for highly dynamic hierarchies use
+@ref Object instead.
+
+@anchor SceneGraph-FlatScene-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref FlatScene.hpp implementation file to avoid linker
+errors. See @ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "FlatScene<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "FlatScene<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "FlatScene<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "FlatScene<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "FlatScene<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "FlatScene<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "FlatScene<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "FlatScene<TranslationTransformation3D>"
+
+@see @ref Scene, @ref Object
+*/
+template<class Transformation> class FlatScene {
+    public:
+        /** @brief Transformation underlying type */
+        typedef typename Transformation::DataType DataType;
+
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
+
+        /** @brief Constructor */
+        explicit FlatScene();
+
+        /** @brief Count of objects in the scene */
+        std::size_t size() const { return _parents.size(); }
+
+        /**
+         * @brief Reserve memory for given count of objects
+         *
+         * @see @ref add()
+         */
+        void reserve(std::size_t size);
+
+        /**
+         * @brief Add object
+         * @param parent            Parent object ID or `-1` for object
+         *      directly in the scene root
+         * @param transformation    Local transformation
+         * @return ID of the newly added object
+         *
+         * The parent must be already present in the scene, see
+         * @ref SceneGraph-FlatScene-ordering "class documentation" for more
+         * information. The object is marked as dirty.
+         */
+        UnsignedInt add(Int parent = -1, const DataType& transformation = DataType());
+
+        /**
+         * @brief Add objects in bulk
+         * @param parents           Parent indices relative to the added
+         *      objects or `-1` for objects attached directly to @p parent
+         * @param transformations   Local transformations as matrices
+         * @param parent            Parent object ID for top-level added
+         *      objects or `-1` for the scene root
+         * @return ID of the first added object, the remaining ones have
+         *      consecutive IDs
+         *
+         * Equivalent to calling @ref add(Int, const DataType&) for each
+         * object, but with a single allocation. The arrays are expected to
+         * have the same size and each parent index is expected to be less
+         * than index of the object itself, which is the case for example
+         * with @ref Trade::FlatSceneData3D::parents() and
+         * @ref Trade::FlatSceneData3D::transformations(). The matrices are
+         * converted to the transformation representation, expecting they
+         * are representable with it.
+         */
+        UnsignedInt add(Containers::ArrayView<const Int> parents, Containers::ArrayView<const MatrixType> transformations, Int parent = -1);
+
+        /** @brief Parent object ID or `-1` if the object is in scene root */
+        Int parent(UnsignedInt id) const;
+
+        /** @brief Parent object IDs */
+        Containers::ArrayView<const Int> parents() const {
+            return {_parents.data(), _parents.size()};
+        }
+
+        /** @brief Local transformation of given object */
+        DataType transformation(UnsignedInt id) const;
+
+        /**
+         * @brief Set local transformation of given object
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the object and all its children as dirty.
+         */
+        FlatScene<Transformation>& setTransformation(UnsignedInt id, const DataType& transformation);
+
+        /** @brief Local transformations of all objects */
+        Containers::ArrayView<const DataType> transformations() const {
+            return {_transformations.data(), _transformations.size()};
+        }
+
+        /**
+         * @brief Absolute transformation of given object
+         *
+         * Expects that the object is not dirty.
+         * @see @ref setClean()
+         */
+        DataType absoluteTransformation(UnsignedInt id) const;
+
+        /**
+         * @brief Absolute transformation matrix of given object
+         *
+         * Expects that the object is not dirty.
+         * @see @ref setClean()
+         */
+        MatrixType absoluteTransformationMatrix(UnsignedInt id) const;
+
+        /**
+         * @brief Absolute transformations of all objects
+         *
+         * Values for dirty objects are stale, call @ref setClean() first.
+         */
+        Containers::ArrayView<const DataType> absoluteTransformations() const {
+            return {_absoluteTransformations.data(), _absoluteTransformations.size()};
+        }
+
+        /** @brief Whether any object in the scene is dirty */
+        bool isDirty() const { return _dirty; }
+
+        /**
+         * @brief Whether given object is dirty
+         *
+         * Returns `true` if transformation of the object or any of its
+         * parents changed since last call to @ref setClean().
+         */
+        bool isDirty(UnsignedInt id) const;
+
+        /**
+         * @brief Clean absolute transformations of all objects
+         *
+         * Recomputes absolute transformations of all dirty objects in a
+         * single linear pass. Does nothing if the scene is not dirty.
+         */
+        void setClean();
+
+    private:
+        std::vector<Int> _parents;
+        std::vector<DataType> _transformations;
+        std::vector<DataType> _absoluteTransformations;
+        std::vector<UnsignedByte> _dirtyObjects;
+        bool _dirty;
+};
+
+}}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef Magnum_SceneGraph_FlatScene_hpp
+#define Magnum_SceneGraph_FlatScene_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatScene.h
+ */
+
+#include <algorithm>
+
+#include "Magnum/SceneGraph/FlatScene.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class Transformation> FlatScene<Transformation>::FlatScene(): _dirty{false} {}
+
+template<class Transformation> void FlatScene<Transformation>::reserve(const std::size_t size) {
+    _parents.reserve(size);
+    _transformations.reserve(size);
+    _absoluteTransformations.reserve(size);
+    _dirtyObjects.reserve(size);
+}
+
+template<class Transformation> UnsignedInt FlatScene<Transformation>::add(const Int parent, const DataType& transformation) {
+    CORRADE_ASSERT(parent >= -1 && parent < Int(_parents.size()),
+        "SceneGraph::FlatScene::add(): parent" << parent << "out of range for" << _parents.size() << "objects", {});
+
+    _parents.push_back(parent);
+    _transformations.push_back(transformation);
+    _absoluteTransformations.emplace_back();
+    _dirtyObjects.push_back(1);
+    _dirty = true;
+    return _parents.size() - 1;
+}
+
+template<class Transformation> UnsignedInt FlatScene<Transformation>::add(const Containers::ArrayView<const Int> parents, const Containers::ArrayView<const MatrixType> transformations, const Int parent) {
+    CORRADE_ASSERT(parents.size() == transformations.size(),
+        "SceneGraph::FlatScene::add(): expected the same count of parents and transformations but got" << parents.size() << "and" << transformations.size(), {});
+    CORRADE_ASSERT(parent >= -1 && parent < Int(_parents.size()),
+        "SceneGraph::FlatScene::add(): parent" << parent << "out of range for" << _parents.size() << "objects", {});
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != parents.size(); ++i)
+        CORRADE_ASSERT(parents[i] >= -1 && parents[i] < Int(i),
+            "SceneGraph::FlatScene::add(): parent" << parents[i] << "of object" << i << "doesn't precede it", {});
+    #endif
+
+    const std::size_t offset = _parents.size();
+    reserve(offset + parents.size());
+    for(std::size_t i = 0; i != parents.size(); ++i) {
+        _parents.push_back(parents[i] == -1 ? parent : Int(offset) + parents[i]);
+        _transformations.push_back(Implementation::Transformation<Transformation>::fromMatrix(transformations[i]));
+    }
+
+    _absoluteTransformations.resize(_parents.size());
+    _dirtyObjects.resize(_parents.size(), 1);
+    _dirty = _dirty || !parents.empty();
+    return offset;
+}
+
+template<class Transformation> Int FlatScene<Transformation>::parent(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::parent(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    return _parents[id];
+}
+
+template<class Transformation> auto FlatScene<Transformation>::transformation(const UnsignedInt id) const -> DataType {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::transformation(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    return _transformations[id];
+}
+
+template<class Transformation> FlatScene<Transformation>& FlatScene<Transformation>::setTransformation(const UnsignedInt id, const DataType& transformation) {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::setTransformation(): index" << id << "out of range for" << _parents.size() << "objects", *this);
+
+    /* Children are marked dirty lazily in setClean() */
+    _transformations[id] = transformation;
+    _dirtyObjects[id] = 1;
+    _dirty = true;
+    return *this;
+}
+
+template<class Transformation> auto FlatScene<Transformation>::absoluteTransformation(const UnsignedInt id) const -> DataType {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::absoluteTransformation(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    CORRADE_ASSERT(!isDirty(id),
+        "SceneGraph::FlatScene::absoluteTransformation(): object" << id << "is dirty", {});
+    return _absoluteTransformations[id];
+}
+
+template<class Transformation> auto FlatScene<Transformation>::absoluteTransformationMatrix(const UnsignedInt id) const -> MatrixType {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::absoluteTransformationMatrix(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    CORRADE_ASSERT(!isDirty(id),
+        "SceneGraph::FlatScene::absoluteTransformationMatrix(): object" << id << "is dirty", {});
+    return Implementation::Transformation<Transformation>::toMatrix(_absoluteTransformations[id]);
+}
+
+template<class Transformation> bool FlatScene<Transformation>::isDirty(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatScene::isDirty(): index" << id << "out of range for" << _parents.size() << "objects", {});
+
+    /* Nothing is dirty, don't bother walking up the hierarchy */
+    if(!_dirty) return false;
+
+    for(Int i = id; i != -1; i = _parents[i])
+        if(_dirtyObjects[i]) return true;
+    return false;
+}
+
+template<class Transformation> void FlatScene<Transformation>::setClean() {
+    if(!_dirty) return;
+
+    /* Parent always precedes its children, so when we get to an object, its
+       parent already has the final dirty flag and absolute transformation */
+    for(std::size_t i = 0; i != _parents.size(); ++i) {
+        const Int parent = _parents[i];
+        if(parent != -1 && _dirtyObjects[parent]) _dirtyObjects[i] = 1;
+        if(!_dirtyObjects[i]) continue;
+
+        _absoluteTransformations[i] = parent == -1 ? _transformations[i] :
+            Implementation::Transformation<Transformation>::compose(_absoluteTransformations[parent], _transformations[i]);
+    }
+
+    /* The flags are needed for children during the pass, so reset them only
+       afterwards */
+    std::fill(_dirtyObjects.begin(), _dirtyObjects.end(), 0);
+    _dirty = false;
+}
+
+}}
+
+#endif
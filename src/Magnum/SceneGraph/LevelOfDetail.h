@@ -0,0 +1,288 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_h
+#define Magnum_SceneGraph_LevelOfDetail_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LevelOfDetail, alias @ref Magnum::SceneGraph::BasicLevelOfDetail2D, @ref Magnum::SceneGraph::BasicLevelOfDetail3D, typedef @ref Magnum::SceneGraph::LevelOfDetail2D, @ref Magnum::SceneGraph::LevelOfDetail3D
+ */
+
+#include <vector>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail
+
+Selects one of several levels of detail based on the size of the object on
+the screen. The size is computed from a bounding sphere, the transformation
+relative to camera that is passed to @ref Drawable::draw() and the camera
+projection matrix, so the selection can be done directly in the draw
+function.
+
+## Usage
+
+Add the feature to the drawable object, set its bounding sphere and add the
+levels, ordered from the most detailed one. Each level has a threshold ---
+minimal size of the bounding sphere diameter on the screen, relative to
+viewport height, at which it is still used. If the object is smaller than
+threshold of the last level, @ref level() returns `-1` and the object doesn't
+need to be drawn at all. The meshes for particular levels can be generated
+for example using @ref MeshTools::generateLods().
+@code
+class Building: public Object3D, public SceneGraph::Drawable3D {
+    public:
+        explicit Building(Object3D* parent, SceneGraph::DrawableGroup3D* group): Object3D{parent}, SceneGraph::Drawable3D{*this, group} {
+            (_lod = new SceneGraph::LevelOfDetail3D{*this})
+                ->setBoundingSphere({}, 10.0f)
+                .setHysteresis(0.1f)
+                .addLevel(0.5f)     // _meshes[0] covering at least half the screen
+                .addLevel(0.1f)     // _meshes[1]
+                .addLevel(0.01f);   // _meshes[2], not drawn if smaller
+        }
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            const Int level = _lod->level(transformationMatrix, camera);
+            if(level == -1) return;
+
+            _shader.setTransformationMatrix(transformationMatrix)
+                // ...
+                ;
+            _meshes[level].draw(_shader);
+        }
+
+        SceneGraph::LevelOfDetail3D* _lod;
+        Mesh _meshes[3];
+        Shaders::Phong _shader;
+}
+@endcode
+
+The feature only selects the level index, so it can be used with @ref Mesh,
+@ref MeshView or any other representation of the levels.
+
+## Hysteresis and caching
+
+The previously selected level is remembered. To avoid popping when the
+object stays near a threshold, @ref setHysteresis() can be used to make
+switches away from the current level require the screen size to cross the
+threshold by given relative amount. With hysteresis of `0.1`, the object
+needs to be 10% larger than the threshold of a more detailed level to switch
+to it and 10% smaller than threshold of the current level to switch to a
+less detailed one. Use @ref resetLevel() to discard the remembered level,
+for example after a camera cut.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref LevelOfDetail.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref LevelOfDetail2D
+-   @ref LevelOfDetail3D
+
+@see @ref scenegraph, @ref BasicLevelOfDetail2D, @ref BasicLevelOfDetail3D,
+    @ref LevelOfDetail2D, @ref LevelOfDetail3D
+*/
+template<UnsignedInt dimensions, class T> class LevelOfDetail: public AbstractFeature<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this feature belongs to
+         *
+         * Creates a feature with no levels, unit bounding sphere at object
+         * origin and no hysteresis.
+         */
+        explicit LevelOfDetail(AbstractObject<dimensions, T>& object);
+
+        /**
+         * @brief Bounding sphere center
+         *
+         * In object local coordinates.
+         * @see @ref setBoundingSphere()
+         */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const {
+            return _boundingSphereCenter;
+        }
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * In object local coordinates.
+         * @see @ref setBoundingSphere()
+         */
+        T boundingSphereRadius() const { return _boundingSphereRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @param center    Sphere center in object local coordinates
+         * @param radius    Sphere radius in object local coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * Non-uniform scaling of the object is accounted for by taking the
+         * largest scaling factor.
+         */
+        LevelOfDetail<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /** @brief Hysteresis */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Relative amount by which the screen size needs to cross a
+         * threshold to switch away from the current level. Expects that the
+         * value is in range @f$ [0, 1) @f$. Default is `0`, i.e. no
+         * hysteresis.
+         */
+        LevelOfDetail<dimensions, T>& setHysteresis(T hysteresis);
+
+        /** @brief Level count */
+        std::size_t levelCount() const { return _thresholds.size(); }
+
+        /**
+         * @brief Level threshold
+         *
+         * Expects that @p level is less than @ref levelCount().
+         */
+        T levelThreshold(std::size_t level) const;
+
+        /**
+         * @brief Add level
+         * @param threshold     Minimal screen size at which the level is
+         *      used
+         * @return Reference to self (for method chaining)
+         *
+         * The threshold is size of the bounding sphere diameter relative to
+         * viewport height. Expects that the threshold is smaller than the
+         * threshold of previously added level, i.e. the levels are added
+         * from the most detailed one.
+         */
+        LevelOfDetail<dimensions, T>& addLevel(T threshold);
+
+        /**
+         * @brief Screen size of the bounding sphere
+         * @param transformationMatrix  Object transformation relative to
+         *      camera
+         * @param camera                Camera
+         *
+         * Size of the bounding sphere diameter relative to the viewport
+         * height, computed from @p transformationMatrix and
+         * @ref Camera::projectionMatrix(). Returns infinity if the sphere
+         * center is at or behind the camera plane.
+         */
+        T screenSize(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera) const;
+
+        /**
+         * @brief Select the level
+         * @param transformationMatrix  Object transformation relative to
+         *      camera
+         * @param camera                Camera
+         *
+         * Returns index of the first level with threshold not larger than
+         * @ref screenSize(), taking @ref hysteresis() into account, or `-1`
+         * if the object is smaller than all thresholds. The result is
+         * remembered and available through @ref currentLevel().
+         */
+        Int level(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera);
+
+        /**
+         * @brief Currently selected level
+         *
+         * Level selected by the last call to @ref level(), `-1` if the
+         * object was too small or if no level was selected yet.
+         */
+        Int currentLevel() const { return _hasLevel ? _currentLevel : -1; }
+
+        /**
+         * @brief Reset the selected level
+         * @return Reference to self (for method chaining)
+         *
+         * The next call to @ref level() then selects the level without
+         * taking @ref hysteresis() into account.
+         */
+        LevelOfDetail<dimensions, T>& resetLevel() {
+            _hasLevel = false;
+            return *this;
+        }
+
+    private:
+        VectorTypeFor<dimensions, T> _boundingSphereCenter;
+        T _boundingSphereRadius;
+        T _hysteresis;
+        std::vector<T> _thresholds;
+        Int _currentLevel;
+        bool _hasLevel;
+};
+
+/**
+@brief Level of detail for two-dimensional scenes
+
+Convenience alternative to `LevelOfDetail<2, T>`. See @ref LevelOfDetail for
+more information.
+@see @ref LevelOfDetail2D, @ref BasicLevelOfDetail3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+#endif
+
+/**
+@brief Level of detail for two-dimensional float scenes
+
+@see @ref LevelOfDetail3D
+*/
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+
+/**
+@brief Level of detail for three-dimensional scenes
+
+Convenience alternative to `LevelOfDetail<3, T>`. See @ref LevelOfDetail for
+more information.
+@see @ref LevelOfDetail3D, @ref BasicLevelOfDetail2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+#endif
+
+/**
+@brief Level of detail for three-dimensional float scenes
+
+@see @ref LevelOfDetail2D
+*/
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<3, Float>;
+#endif
+
+}}
+
+#endif
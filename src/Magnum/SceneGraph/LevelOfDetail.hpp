@@ -0,0 +1,120 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_hpp
+#define Magnum_SceneGraph_LevelOfDetail_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref LevelOfDetail.h
+ */
+
+#include <cmath>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>::LevelOfDetail(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _boundingSphereRadius(T(1)), _hysteresis(T(0)), _currentLevel(-1), _hasLevel(false) {}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _boundingSphereCenter = center;
+    _boundingSphereRadius = radius;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::setHysteresis(const T hysteresis) {
+    CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1),
+        "SceneGraph::LevelOfDetail::setHysteresis(): expected value in range [0, 1) but got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> T LevelOfDetail<dimensions, T>::levelThreshold(const std::size_t level) const {
+    CORRADE_ASSERT(level < _thresholds.size(),
+        "SceneGraph::LevelOfDetail::levelThreshold(): index" << level << "out of range for" << _thresholds.size() << "levels", {});
+    return _thresholds[level];
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::addLevel(const T threshold) {
+    CORRADE_ASSERT(_thresholds.empty() || threshold < _thresholds.back(),
+        "SceneGraph::LevelOfDetail::addLevel(): expected threshold smaller than" << _thresholds.back() << "but got" << threshold, *this);
+    _thresholds.push_back(threshold);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> T LevelOfDetail<dimensions, T>::screenSize(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera) const {
+    const MatrixTypeFor<dimensions, T> projectionMatrix = camera.projectionMatrix();
+
+    /* Largest scaling for the radius, the same as in Camera::drawCulled() */
+    T scaling{};
+    for(std::size_t i = 0; i != dimensions; ++i)
+        scaling = Math::max(scaling, Math::Vector<dimensions, T>::pad(transformationMatrix[i]).length());
+
+    /* The W component of the sphere center in clip space. It's distance from
+       the camera plane for perspective projection and 1 for orthographic
+       projection. */
+    const VectorTypeFor<dimensions, T> center = transformationMatrix.transformPoint(_boundingSphereCenter);
+    T w = projectionMatrix[dimensions][dimensions];
+    for(std::size_t i = 0; i != dimensions; ++i)
+        w += projectionMatrix[i][dimensions]*center[i];
+    if(w <= T(0)) return Math::Constants<T>::inf();
+
+    /* Viewport height is 2 in NDC, so the diameter relative to it is equal
+       to projected radius */
+    return _boundingSphereRadius*scaling*std::abs(projectionMatrix[1][1])/w;
+}
+
+template<UnsignedInt dimensions, class T> Int LevelOfDetail<dimensions, T>::level(const MatrixTypeFor<dimensions, T>& transformationMatrix, const Camera<dimensions, T>& camera) {
+    const T size = screenSize(transformationMatrix, camera);
+
+    /* Current level, the one past the last if the object was too small. With
+       hysteresis, the thresholds of more detailed levels are raised and the
+       threshold of current level is lowered, so crossing the original
+       threshold by a small amount doesn't cause a switch. */
+    const std::size_t current = !_hasLevel ? 0 : _currentLevel == -1 ? _thresholds.size() : std::size_t(_currentLevel);
+    Int selected = -1;
+    for(std::size_t i = 0; i != _thresholds.size(); ++i) {
+        T threshold = _thresholds[i];
+        if(_hasLevel) {
+            if(i < current) threshold *= T(1) + _hysteresis;
+            else if(i == current) threshold *= T(1) - _hysteresis;
+        }
+
+        if(size >= threshold) {
+            selected = Int(i);
+            break;
+        }
+    }
+
+    _currentLevel = selected;
+    _hasLevel = true;
+    return selected;
+}
+
+}}
+
+#endif
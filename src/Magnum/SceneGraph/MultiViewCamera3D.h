@@ -0,0 +1,203 @@
+#ifndef Magnum_SceneGraph_MultiViewCamera3D_h
+#define Magnum_SceneGraph_MultiViewCamera3D_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicMultiViewCamera3D, typedef @ref Magnum::SceneGraph::MultiViewCamera3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+
+#ifdef CORRADE_TARGET_WINDOWS /* I so HATE windef.h */
+#undef near
+#undef far
+#endif
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Camera rendering into multiple views at once
+
+Camera for single-pass stereo and cube map rendering. Besides the usual
+@ref projectionMatrix() it has a list of views, each consisting of a view
+matrix relative to the camera object and a projection matrix. Transformations
+of the drawables are computed only once relative to the camera object, same as
+with @ref Camera, and each drawable is drawn once. The drawable then submits a
+single instanced draw call with a shader that selects view by instance index
+and writes to framebuffer layer of the same index, such as
+@ref Shaders::Phong or @ref Shaders::Flat3D with
+@ref Shaders::Phong::Flag::MultiView enabled:
+@code
+class Drawable: public SceneGraph::Drawable3D {
+    // ...
+
+    void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D&) override {
+        _shader.setViewProjectionMatrices(_camera.viewProjectionMatrices())
+            .setTransformationMatrix(transformationMatrix)
+            .setNormalMatrix(transformationMatrix.rotation());
+        _mesh.setInstanceCount(_camera.viewCount())
+            .draw(_shader);
+    }
+
+    SceneGraph::MultiViewCamera3D& _camera;
+};
+
+SceneGraph::MultiViewCamera3D camera{cameraObject};
+camera.setStereoViews(0.065f, Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.01f, 100.0f));
+
+framebuffer.attachLayeredTexture(Framebuffer::ColorAttachment{0}, eyes, 0);
+camera.drawCulled(drawables);
+@endcode
+
+@ref drawCulled() culls against union of all views --- a drawable is skipped
+only if it's outside of all of them. If there are no views, the camera behaves
+the same as @ref Camera.
+
+@anchor SceneGraph-MultiViewCamera3D-explicit-specializations
+## Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref MultiViewCamera3D.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref MultiViewCamera3D
+
+@see @ref scenegraph, @ref MultiViewCamera3D, @ref Camera, @ref Drawable
+*/
+template<class T> class BasicMultiViewCamera3D: public Camera<3, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object        Object holding the camera
+         *
+         * The camera has no views.
+         * @see @ref addView(), @ref setStereoViews(), @ref setCubeMapViews()
+         */
+        explicit BasicMultiViewCamera3D(AbstractObject<3, T>& object);
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* This is here to avoid ambiguity with deleted copy constructor when
+           passing `*this` from class subclassing both Camera and AbstractObject */
+        template<class U, class = typename std::enable_if<std::is_base_of<AbstractObject<3, T>, U>::value>::type> BasicMultiViewCamera3D(U& object): BasicMultiViewCamera3D<T>(static_cast<AbstractObject<3, T>&>(object)) {}
+        #endif
+
+        ~BasicMultiViewCamera3D();
+
+        /** @brief View count */
+        std::size_t viewCount() const { return _viewMatrices.size(); }
+
+        /**
+         * @brief View matrix
+         *
+         * Transformation from camera object space to space of given view.
+         * @see @ref viewProjectionMatrix()
+         */
+        Math::Matrix4<T> viewMatrix(std::size_t id) const { return _viewMatrices[id]; }
+
+        /**
+         * @brief View projection matrix
+         *
+         * Projection matrix of given view multiplied with its
+         * @ref viewMatrix(). Applied after @ref cameraMatrix() and object
+         * transformation matrix.
+         */
+        Math::Matrix4<T> viewProjectionMatrix(std::size_t id) const { return _viewProjectionMatrices[id]; }
+
+        /**
+         * @brief View projection matrices of all views
+         *
+         * Suitable for passing directly to
+         * @ref Shaders::Phong::setViewProjectionMatrices().
+         */
+        Containers::ArrayView<const Math::Matrix4<T>> viewProjectionMatrices() const {
+            return {_viewProjectionMatrices.data(), _viewProjectionMatrices.size()};
+        }
+
+        /**
+         * @brief Add view
+         * @return Reference to self (for method chaining)
+         *
+         * The @p viewMatrix transforms from camera object space to space of
+         * the view, @p projectionMatrix is applied after it. Aspect ratio
+         * policy set on the camera is not applied to the views.
+         */
+        BasicMultiViewCamera3D<T>& addView(const Math::Matrix4<T>& viewMatrix, const Math::Matrix4<T>& projectionMatrix);
+
+        /**
+         * @brief Remove all views
+         * @return Reference to self (for method chaining)
+         */
+        BasicMultiViewCamera3D<T>& clearViews();
+
+        /**
+         * @brief Set stereo views
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces all views with left and right eye, offset by half of
+         * @p eyeDistance along negative and positive X axis of the camera
+         * object, both using @p projectionMatrix. The projection matrix is
+         * set also as @ref projectionMatrix().
+         */
+        BasicMultiViewCamera3D<T>& setStereoViews(T eyeDistance, const Math::Matrix4<T>& projectionMatrix);
+
+        /**
+         * @brief Set cube map views
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces all views with six 90° views looking along the axes of the
+         * camera object, in order of @ref CubeMapTexture::Coordinate, i.e.
+         * +X, -X, +Y, -Y, +Z, -Z, oriented according to the cube map
+         * conventions. The views have given @p near and @p far clipping
+         * planes.
+         */
+        BasicMultiViewCamera3D<T>& setCubeMapViews(T near, T far);
+
+    private:
+        std::size_t doViewCount() const override;
+        Math::Matrix4<T> doViewProjectionMatrix(std::size_t id) const override;
+
+        std::vector<Math::Matrix4<T>> _viewMatrices;
+        std::vector<Math::Matrix4<T>> _viewProjectionMatrices;
+};
+
+/**
+@brief Camera rendering into multiple views at once for float scenes
+
+@see @ref Camera3D
+*/
+typedef BasicMultiViewCamera3D<Float> MultiViewCamera3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicMultiViewCamera3D<Float>;
+#endif
+
+}}
+
+#endif
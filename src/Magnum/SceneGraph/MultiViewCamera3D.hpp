@@ -0,0 +1,94 @@
+#ifndef Magnum_SceneGraph_MultiViewCamera3D_hpp
+#define Magnum_SceneGraph_MultiViewCamera3D_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref MultiViewCamera3D.h
+ */
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+#include "Magnum/SceneGraph/MultiViewCamera3D.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicMultiViewCamera3D<T>::BasicMultiViewCamera3D(AbstractObject<3, T>& object): Camera<3, T>{object} {}
+
+template<class T> BasicMultiViewCamera3D<T>::~BasicMultiViewCamera3D() = default;
+
+template<class T> BasicMultiViewCamera3D<T>& BasicMultiViewCamera3D<T>::addView(const Math::Matrix4<T>& viewMatrix, const Math::Matrix4<T>& projectionMatrix) {
+    _viewMatrices.push_back(viewMatrix);
+    _viewProjectionMatrices.push_back(projectionMatrix*viewMatrix);
+    return *this;
+}
+
+template<class T> BasicMultiViewCamera3D<T>& BasicMultiViewCamera3D<T>::clearViews() {
+    _viewMatrices.clear();
+    _viewProjectionMatrices.clear();
+    return *this;
+}
+
+template<class T> BasicMultiViewCamera3D<T>& BasicMultiViewCamera3D<T>::setStereoViews(const T eyeDistance, const Math::Matrix4<T>& projectionMatrix) {
+    /* The eyes are at -eyeDistance/2 and +eyeDistance/2, the view matrices
+       are the inverse of that */
+    clearViews();
+    addView(Math::Matrix4<T>::translation(Math::Vector3<T>::xAxis(eyeDistance/T(2))), projectionMatrix);
+    addView(Math::Matrix4<T>::translation(Math::Vector3<T>::xAxis(-eyeDistance/T(2))), projectionMatrix);
+    Camera<3, T>::setProjectionMatrix(projectionMatrix);
+    return *this;
+}
+
+template<class T> BasicMultiViewCamera3D<T>& BasicMultiViewCamera3D<T>::setCubeMapViews(const T near, const T far) {
+    /* Direction and up vector of each face, the cube map faces have Y going
+       down */
+    const Math::Vector3<T> faces[][2]{
+        {{ T(1),  T(0),  T(0)}, {T(0), T(-1),  T(0)}},
+        {{T(-1),  T(0),  T(0)}, {T(0), T(-1),  T(0)}},
+        {{ T(0),  T(1),  T(0)}, {T(0),  T(0),  T(1)}},
+        {{ T(0), T(-1),  T(0)}, {T(0),  T(0), T(-1)}},
+        {{ T(0),  T(0),  T(1)}, {T(0), T(-1),  T(0)}},
+        {{ T(0),  T(0), T(-1)}, {T(0), T(-1),  T(0)}}
+    };
+
+    const Math::Matrix4<T> projectionMatrix = Math::Matrix4<T>::perspectiveProjection(Math::Rad<T>{Math::Deg<T>{T(90)}}, T(1), near, far);
+    clearViews();
+    for(const auto& face: faces)
+        addView(Math::Matrix4<T>::lookAt({}, face[0], face[1]).invertedRigid(), projectionMatrix);
+    return *this;
+}
+
+template<class T> std::size_t BasicMultiViewCamera3D<T>::doViewCount() const {
+    /* Without any views behave the same as the base camera */
+    return _viewProjectionMatrices.empty() ? 1 : _viewProjectionMatrices.size();
+}
+
+template<class T> Math::Matrix4<T> BasicMultiViewCamera3D<T>::doViewProjectionMatrix(const std::size_t id) const {
+    return _viewProjectionMatrices.empty() ? Camera<3, T>::projectionMatrix() : _viewProjectionMatrices[id];
+}
+
+}}
+
+#endif
@@ -41,7 +41,8 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        NoFeatureNotification = 1 << 3
     };
 
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
@@ -295,6 +296,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object into given vector
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const,
+         * but puts the result into @p out, resizing it to size of
+         * @p objects. Temporary data needed for the computation are kept in
+         * the @ref Scene and reused between calls, so if @p out has enough
+         * capacity and the function was called before with similarly large
+         * set of objects, no allocations are done.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& out, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
@@ -302,9 +315,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          * if specified.
          * @see @ref transformationMatrices()
          */
-        /* `objects` passed by copy intentionally (to allow move from
-           transformationMatrices() and avoid copy in the function itself) */
-        std::vector<typename Transformation::DataType> transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation =
+        std::vector<typename Transformation::DataType> transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation =
             #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
             typename Transformation::DataType()
             #else
@@ -312,6 +323,28 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Transformations of given group of objects relative to this object into given vector
+         *
+         * Same as @ref transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const typename Transformation::DataType&) const,
+         * but puts the result into @p out, resizing it to size of
+         * @p objects. See @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, std::vector<MatrixType>&, const MatrixType&) const
+         * for more information about allocations.
+         *
+         * If @p threadCount is not `1`, transformations of independent parts
+         * of the hierarchy are computed on given count of worker threads, `0`
+         * meaning count of hardware threads. The result is the same as with
+         * the serial computation. The computation is always serial on
+         * platforms without thread support.
+         */
+        void transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<typename Transformation::DataType>& out, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            , UnsignedInt threadCount = 1) const;
+
         /*@}*/
 
         /**
@@ -327,14 +360,95 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          * @see @ref setClean()
          */
         /* `objects` passed by copy intentionally (to avoid copy internally) */
-        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects);
+        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
+            setClean(std::move(objects), 1);
+        }
+
+        /**
+         * @brief Clean absolute transformations of given set of objects in parallel
+         * @param objects       Objects to clean
+         * @param threadCount   Count of worker threads. If `0`, all
+         *      workers of @ref TaskScheduler::global() are used.
+         *
+         * Same as @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * but both the absolute transformations and the cleaning of features
+         * are distributed across worker threads, see
+         * @ref transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>&, std::vector<typename Transformation::DataType>&, const typename Transformation::DataType&, UnsignedInt) const
+         * for details. The result is the same as with serial cleaning, but
+         * @ref AbstractFeature::clean() and @ref AbstractFeature::cleanInverted()
+         * of features attached to the objects may be called concurrently for
+         * different objects, so they must not modify any shared state.
+         * @see @ref scenegraph-features-caching
+         */
+        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, UnsignedInt threadCount);
 
         /** @copydoc AbstractObject::isDirty() */
         bool isDirty() const { return !!(flags & Flag::Dirty); }
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features
+         * (unless disabled with @ref setFeatureNotificationEnabled()) and does
+         * the same for all children which are not already dirty. The
+         * hierarchy is traversed iteratively, subtrees which are already
+         * dirty are skipped. If the object is already marked as dirty, the
+         * function does nothing.
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty(), @ref dirtyGeneration()
+         */
+        /* note: doc adapted from AbstractObject::setDirty() */
         void setDirty();
 
+        /**
+         * @brief Set absolute transformations of given set of objects as dirty
+         *
+         * Same as calling @ref setDirty() on each object, but the hierarchy
+         * is traversed only once, so objects shared by more subtrees are
+         * visited just once. Useful when many objects are moved in a single
+         * frame. All objects are expected to be part of the same scene.
+         */
+        static void setDirty(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects);
+
+        /**
+         * @brief Generation in which the object was marked as dirty
+         *
+         * Value of @ref Scene::generation() at the time the object (or any
+         * of its parents) was marked as dirty from clean state, `0` if it
+         * was never marked dirty or is not part of any scene. Features which
+         * have notifications disabled using @ref setFeatureNotificationEnabled()
+         * can remember the generation they last looked at the object in and
+         * consider it changed if the object is dirty or if this value is
+         * greater or equal to the remembered one.
+         */
+        UnsignedInt dirtyGeneration() const { return generation; }
+
+        /**
+         * @brief Whether features are notified about the object becoming dirty
+         *
+         * @see @ref setFeatureNotificationEnabled()
+         */
+        bool isFeatureNotificationEnabled() const {
+            return !(flags & Flag::NoFeatureNotification);
+        }
+
+        /**
+         * @brief Enable or disable feature notification
+         * @return Reference to self (for method chaining)
+         *
+         * If disabled, @ref setDirty() doesn't call
+         * @ref AbstractFeature::markDirty() on features of this object, saving
+         * a virtual call for each of them. The features can check
+         * @ref dirtyGeneration() instead. Features having
+         * @ref AbstractFeature::cachedTransformations() are cleaned in
+         * @ref setClean() regardless of this setting. Enabled by default.
+         */
+        Object<Transformation>& setFeatureNotificationEnabled(bool enabled) {
+            if(enabled) flags &= ~Flag::NoFeatureNotification;
+            else flags |= Flag::NoFeatureNotification;
+            return *this;
+        }
+
         /**
          * @brief Clean object absolute transformation
          *
@@ -370,7 +484,9 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return absoluteTransformationMatrix();
         }
 
-        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        void doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& out, const MatrixType& initialTransformationMatrix) const override final;
+
+        void MAGNUM_SCENEGRAPH_LOCAL computeJointTransformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& initialTransformation, UnsignedInt threadCount) const;
 
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
 
@@ -381,10 +497,13 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
 
+        static void MAGNUM_SCENEGRAPH_LOCAL setDirtyInternal(std::vector<Object<Transformation>*>& stack, UnsignedInt generation);
+
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
         UnsignedShort counter;
         Flags flags;
+        UnsignedInt generation;
 };
 
 }}
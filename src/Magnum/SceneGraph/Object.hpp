@@ -30,20 +30,55 @@
  */
 
 #include <algorithm>
+#include <numeric>
 #include <stack>
+#include <type_traits>
 
+#include "Magnum/FrameAllocator.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Tracing.h"
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
+namespace Implementation {
+    /* Whether the transformation implementation can cheaply invert the
+       absolute transformation matrix (e.g. rigid transformations using
+       Matrix4::invertedRigid()) */
+    template<class T> class HasInvertedMatrix {
+        template<class U> static char get(decltype(&U::invertedMatrix));
+        template<class> static short get(...);
+
+        public:
+            enum: bool { Value = sizeof(get<T>(nullptr)) == sizeof(char) };
+    };
+
+    /* Inverting the matrix directly, reusing (or computing and remembering)
+       the absolute matrix for features which need it too */
+    template<class TransformationType, class MatrixType> void invertedAbsoluteMatrix(std::true_type, const typename TransformationType::DataType& absoluteTransformation, CachedTransformations& cached, MatrixType& matrix, MatrixType& invertedMatrix) {
+        if(!(cached & CachedTransformation::Absolute)) {
+            cached |= CachedTransformation::Absolute;
+            matrix = Transformation<TransformationType>::toMatrix(absoluteTransformation);
+        }
+
+        invertedMatrix = Transformation<TransformationType>::invertedMatrix(matrix);
+    }
+
+    /* Generic inversion of the transformation and conversion to matrix */
+    template<class TransformationType, class MatrixType> void invertedAbsoluteMatrix(std::false_type, const typename TransformationType::DataType& absoluteTransformation, CachedTransformations&, MatrixType&, MatrixType& invertedMatrix) {
+        invertedMatrix = Transformation<TransformationType>::toMatrix(
+            Transformation<TransformationType>::inverted(absoluteTransformation));
+    }
+}
+
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::AbstractObject() {}
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~AbstractObject() {}
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty), generation(0) {
     setParent(parent);
 }
 
@@ -113,22 +148,69 @@ template<class Transformation> void Object<Transformation>::setDirty() {
        nothing to do */
     if(flags & Flag::Dirty) return;
 
-    /* Make all features dirty */
-    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
-        feature.markDirty();
+    /* Borrow the traversal stack from the scene to avoid allocations. If
+       markDirty() of some feature calls setDirty() again, the nested call
+       just gets an empty one. */
+    Scene<Transformation>* scene = this->scene();
+    std::vector<Object<Transformation>*> stack;
+    if(scene) std::swap(stack, scene->_dirtyObjects);
+
+    stack.push_back(this);
+    setDirtyInternal(stack, scene ? scene->_generation : 0);
+
+    if(scene) std::swap(stack, scene->_dirtyObjects);
+}
+
+template<class Transformation> void Object<Transformation>::setDirty(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects) {
+    if(objects.empty()) return;
+
+    Scene<Transformation>* scene = objects.front().get().scene();
+    std::vector<Object<Transformation>*> stack;
+    if(scene) std::swap(stack, scene->_dirtyObjects);
+
+    /* Objects which are already dirty have dirty subtrees as well */
+    for(Object<Transformation>& o: objects) {
+        CORRADE_ASSERT(o.scene() == scene, "SceneGraph::Object::setDirty(): all objects must be in the same scene", );
+        if(!(o.flags & Flag::Dirty)) stack.push_back(&o);
+    }
+
+    setDirtyInternal(stack, scene ? scene->_generation : 0);
+
+    if(scene) std::swap(stack, scene->_dirtyObjects);
+}
+
+template<class Transformation> void Object<Transformation>::setDirtyInternal(std::vector<Object<Transformation>*>& stack, const UnsignedInt generation) {
+    /* Depth-first traversal with explicit stack, deep hierarchies would
+       overflow the call stack otherwise */
+    while(!stack.empty()) {
+        Object<Transformation>& o = *stack.back();
+        stack.pop_back();
+
+        /* Could have been reached through another root already */
+        if(o.flags & Flag::Dirty) continue;
+
+        o.flags |= Flag::Dirty;
+        o.generation = generation;
 
-    /* Make all children dirty */
-    for(Object<Transformation>& child: children())
-        child.setDirty();
+        /* Make all features dirty */
+        if(!(o.flags & Flag::NoFeatureNotification))
+            for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: o.features())
+                feature.markDirty();
+
+        /* Schedule all children which aren't dirty yet */
+        for(Object<Transformation>& child: o.children())
+            if(!(child.flags & Flag::Dirty)) stack.push_back(&child);
+    }
 
-    /* Mark object as dirty */
-    flags |= Flag::Dirty;
+    stack.clear();
 }
 
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
     if(!(flags & Flag::Dirty)) return;
 
+    MAGNUM_TRACE_CPU_ZONE("SceneGraph::Object::setClean");
+
     /* Collect all parents, compute base transformation */
     std::stack<Object<Transformation>*> objects;
     typename Transformation::DataType absoluteTransformation;
@@ -162,24 +244,42 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 }
 
-template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
+template<class Transformation> void Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, std::vector<MatrixType>& out, const MatrixType& initialTransformationMatrix) const {
+    const Scene<Transformation>* scene = this->scene();
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    std::vector<std::reference_wrapper<Object<Transformation>>>& castObjects = scene->_transformationCastObjects;
+    castObjects.clear();
     castObjects.reserve(objects.size());
     /** @todo Ensure this doesn't crash, somehow */
     for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    transformationMatrices(castObjects, out, initialTransformationMatrix);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
-    std::vector<MatrixType> transformationMatrices(transformations.size());
-    for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
-
+    std::vector<MatrixType> transformationMatrices;
+    this->transformationMatrices(objects, transformationMatrices, initialTransformationMatrix);
     return transformationMatrices;
 }
 
+template<class Transformation> void Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<MatrixType>& out, const MatrixType& initialTransformationMatrix) const {
+    const Scene<Transformation>* scene = this->scene();
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    std::vector<typename Transformation::DataType>& transformations = scene->_transformations;
+    this->transformations(objects, transformations, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    out.resize(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation) const {
+    std::vector<typename Transformation::DataType> transformations;
+    this->transformations(objects, transformations, initialTransformation);
+    return transformations;
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -194,8 +294,14 @@ Then for all joints their transformation (relative to parent joint) is
 computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> void Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, std::vector<typename Transformation::DataType>& out, const typename Transformation::DataType& initialTransformation, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", );
+
+    /* Scene object */
+    const Scene<Transformation>* scene = this->scene();
+
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
 
     /* Remember object count for later */
     std::size_t objectCount = objects.size();
@@ -210,22 +316,25 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         objects[i].get().counter = UnsignedShort(i);
         objects[i].get().flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
 
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
-
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
-
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
+    /* Reuse the temporary storage in the scene, assign() doesn't reallocate
+       if the capacity is large enough */
+    std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects = scene->_transformationJointObjects;
+    jointObjects.assign(objects.begin(), objects.end());
+    std::vector<std::reference_wrapper<Object<Transformation>>>& remaining = scene->_transformationObjects;
+    remaining.assign(objects.begin(), objects.end());
+
+    /* Mark all objects up the hierarchy as visited. Each object is walked up
+       until it's removed and the remaining ones are not yet processed, so the
+       order doesn't matter and we can remove by swapping with the last one
+       instead of expensive erase() from the middle. */
+    auto it = remaining.begin();
+    while(!remaining.empty()) {
         /* Already visited, remove and continue to next (duplicate occurence) */
         if(it->get().flags & Flag::Visited) {
-            it = objects.erase(it);
+            *it = remaining.back();
+            remaining.pop_back();
+            if(it == remaining.end()) it = remaining.begin();
             continue;
         }
 
@@ -236,18 +345,20 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         /* If this is root object, remove from list */
         if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
-            it = objects.erase(it);
+            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", );
+            *it = remaining.back();
+            remaining.pop_back();
 
         /* Parent is an joint or already visited - remove current from list */
         } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
+            *it = remaining.back();
+            remaining.pop_back();
 
             /* If not already marked as joint, mark it as such and add it to
                list of joint objects */
             if(!(parent->flags & Flag::Joint)) {
                 CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
+                               "SceneGraph::Object::transformations(): too large scene", );
                 CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
                 parent->counter = UnsignedShort(jointObjects.size());
                 parent->flags |= Flag::Joint;
@@ -258,15 +369,17 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         } else *it = *parent;
 
         /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+        if(it == remaining.end()) it = remaining.begin();
     }
 
     /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    std::vector<typename Transformation::DataType>& jointTransformations = out;
+    jointTransformations.resize(jointObjects.size());
 
     /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
+    if(threadCount == 1) for(std::size_t i = 0; i != jointTransformations.size(); ++i)
         computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
+    else computeJointTransformations(jointObjects, jointTransformations, initialTransformation, threadCount);
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
@@ -284,9 +397,8 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         i.get().counter = 0xFFFFu;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
+    /* Shrink the array to contain only transformations of requested objects */
     jointTransformations.resize(objectCount);
-    return jointTransformations;
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
@@ -326,6 +438,108 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
     }
 }
 
+/*
+Parallel variant of the above. First, transformation of each joint relative
+to its parent joint is computed. Paths between joints are disjoint, so each
+joint can be processed independently. Then the relative transformations are
+composed with absolute transformations of parent joints, level by level from
+the top of the joint hierarchy. Joints on the same level don't depend on each
+other, so again each can be processed independently. The operations are done
+in the same order as in the serial variant, so the result is the same.
+*/
+template<class Transformation> void Object<Transformation>::computeJointTransformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& initialTransformation, const UnsignedInt threadCount) const {
+    const std::size_t jointCount = jointObjects.size();
+
+    /* Transformations relative to parent joints. Parent joint index is
+       0xFFFF if the path ends in the root, in which case the transformation
+       is already absolute. Each worker modifies flags only of objects on its
+       own path. Whether the parent is a joint is decided from its counter and
+       not the flags, as the flags of the parent joint may be modified by
+       another worker at the same time. */
+    FrameVector<UnsignedShort> parentJoints(jointCount, 0xFFFFu);
+    Magnum::Implementation::parallelForEach(jointCount, threadCount, [&jointObjects, &jointTransformations, &initialTransformation, &parentJoints](const std::size_t joint) {
+        Object<Transformation>* o = &jointObjects[joint].get();
+
+        /* Duplicate occurence, copied from the first one afterwards */
+        if(o->counter != joint) return;
+
+        typename Transformation::DataType transformation = o->transformation();
+        for(;;) {
+            /* Clean visited mark */
+            CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
+            o->flags &= ~Flag::Visited;
+
+            Object<Transformation>* parent = o->parent();
+
+            /* Root object, compose transformation with initial, done */
+            if(!parent) {
+                CORRADE_INTERNAL_ASSERT(o->isScene());
+                transformation = Implementation::Transformation<Transformation>::compose(initialTransformation, transformation);
+                break;
+
+            /* Joint object, remember it for later, done */
+            } else if(parent->counter != 0xFFFFu) {
+                parentJoints[joint] = parent->counter;
+                break;
+
+            /* Else compose transformation with parent, go up the hierarchy */
+            } else {
+                transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+                o = parent;
+            }
+        }
+
+        jointTransformations[joint] = transformation;
+    });
+
+    /* Depth of each joint in the joint hierarchy, top-level joints have depth
+       0. For each joint go up until a joint with already known depth or the
+       top-level joint is found, then walk the same path again and fill in the
+       depths. Duplicate occurences have no depth. */
+    FrameVector<UnsignedShort> depths(jointCount, 0xFFFFu);
+    UnsignedShort maxDepth = 0;
+    for(std::size_t i = 0; i != jointCount; ++i) {
+        if(jointObjects[i].get().counter != i) continue;
+
+        std::size_t joint = i;
+        UnsignedShort depth = 0;
+        while(depths[joint] == 0xFFFFu && parentJoints[joint] != 0xFFFFu) {
+            joint = parentJoints[joint];
+            ++depth;
+        }
+        if(depths[joint] != 0xFFFFu) depth += depths[joint];
+        maxDepth = std::max(maxDepth, depth);
+
+        for(joint = i; depths[joint] == 0xFFFFu; --depth) {
+            depths[joint] = depth;
+            if(parentJoints[joint] == 0xFFFFu) break;
+            joint = parentJoints[joint];
+        }
+    }
+
+    /* Sort the joints by depth */
+    FrameVector<std::size_t> levelOffsets(maxDepth + 2);
+    for(std::size_t i = 0; i != jointCount; ++i)
+        if(depths[i] != 0xFFFFu) ++levelOffsets[depths[i] + 1];
+    std::partial_sum(levelOffsets.begin(), levelOffsets.end(), levelOffsets.begin());
+    FrameVector<UnsignedShort> sortedJoints(levelOffsets.back());
+    {
+        FrameVector<std::size_t> levelPositions(levelOffsets.begin(), levelOffsets.end() - 1);
+        for(std::size_t i = 0; i != jointCount; ++i)
+            if(depths[i] != 0xFFFFu) sortedJoints[levelPositions[depths[i]]++] = UnsignedShort(i);
+    }
+
+    /* Compose with parent joints level by level, top-level joints are
+       already done */
+    for(std::size_t depth = 1; depth <= maxDepth; ++depth) {
+        const UnsignedShort* const level = sortedJoints.data() + levelOffsets[depth];
+        Magnum::Implementation::parallelForEach(levelOffsets[depth + 1] - levelOffsets[depth], threadCount, [level, &jointTransformations, &parentJoints](const std::size_t i) {
+            const UnsignedShort joint = level[i];
+            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(jointTransformations[parentJoints[joint]], jointTransformations[joint]);
+        });
+    }
+}
+
 template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
     std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
     castObjects.reserve(objects.size());
@@ -335,10 +549,19 @@ template<class Transformation> void Object<Transformation>::doSetClean(const std
     setClean(std::move(castObjects));
 }
 
-template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
-    /* Remove all clean objects from the list */
-    auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
-    objects.erase(firstClean, objects.end());
+template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const UnsignedInt threadCount) {
+    /* Remove all clean objects and duplicate occurences from the list. Mark
+       each kept object as visited, so it isn't there more than once. The
+       objects are moved only to the front, so it can be done in place. */
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        Object<Transformation>& o = objects[i];
+        if(!o.isDirty() || (o.flags & Flag::Visited)) continue;
+
+        o.flags |= Flag::Visited;
+        objects[count++] = o;
+    }
+    objects.erase(objects.begin() + count, objects.end());
 
     /* No dirty objects left, done */
     if(objects.empty()) return;
@@ -346,11 +569,9 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
     /* Add non-clean parents to the list. Mark each added object as visited, so
        they aren't added more than once */
     for(std::size_t end = objects.size(), i = 0; i != end; ++i) {
-        Object<Transformation>& o = objects[i];
-        o.flags |= Flag::Visited;
-
-        Object<Transformation>* parent = o.parent();
+        Object<Transformation>* parent = objects[i].get().parent();
         while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
+            parent->flags |= Flag::Visited;
             objects.push_back(*parent);
             parent = parent->parent();
         }
@@ -362,20 +583,24 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
     /* Compute absolute transformations */
     Scene<Transformation>* scene = objects[0].get().scene();
     CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
-
-    /* Go through all objects and clean them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
-        /* The object might be duplicated in the list, don't clean it more than once */
-        if(!objects[i].get().isDirty()) continue;
+    std::vector<typename Transformation::DataType> transformations;
+    std::swap(transformations, scene->_cleanTransformations);
+    scene->transformations(objects, transformations, typename Transformation::DataType(), threadCount);
 
+    /* Go through all objects and clean them. Each object is in the list only
+       once, so this can be done in parallel as well. */
+    Magnum::Implementation::parallelForEach(objects.size(), threadCount, [&objects, &transformations](const std::size_t i) {
         objects[i].get().setCleanInternal(transformations[i]);
         CORRADE_ASSERT(!objects[i].get().isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
-    }
+    });
+
+    /* Give the storage back for the next time */
+    std::swap(transformations, scene->_cleanTransformations);
 }
 
 template<class Transformation> void Object<Transformation>::setCleanInternal(const typename Transformation::DataType& absoluteTransformation) {
-    /* "Lazy storage" for transformation matrix and inverted transformation matrix */
+    /* "Lazy storage" for transformation matrix and inverted transformation
+       matrix, each is computed only when first feature asks for it */
     CachedTransformations cached;
     MatrixType matrix, invertedMatrix;
 
@@ -397,8 +622,9 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
         if(feature.cachedTransformations() & CachedTransformation::InvertedAbsolute) {
             if(!(cached & CachedTransformation::InvertedAbsolute)) {
                 cached |= CachedTransformation::InvertedAbsolute;
-                invertedMatrix = Implementation::Transformation<Transformation>::toMatrix(
-                    Implementation::Transformation<Transformation>::inverted(absoluteTransformation));
+                Implementation::invertedAbsoluteMatrix<Transformation>(
+                    std::integral_constant<bool, Implementation::HasInvertedMatrix<Implementation::Transformation<Transformation>>::Value>{},
+                    absoluteTransformation, cached, matrix, invertedMatrix);
             }
 
             feature.cleanInverted(invertedMatrix);
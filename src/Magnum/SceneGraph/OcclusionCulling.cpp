@@ -0,0 +1,310 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "OcclusionCulling.h"
+
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SampleQuery.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Version.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importSceneGraphResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumSceneGraph_RESOURCES)
+}
+#endif
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+class ProxyShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector3> Position;
+
+        explicit ProxyShader() {
+            #ifdef MAGNUM_BUILD_STATIC
+            /* Import resources on static build, if not already */
+            if(!Utility::Resource::hasGroup("MagnumSceneGraph"))
+                importSceneGraphResources();
+            #endif
+            Utility::Resource rs("MagnumSceneGraph");
+
+            #ifndef MAGNUM_TARGET_GLES
+            const Version version = Context::current().supportedVersion({Version::GL330, Version::GL210});
+            #else
+            const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
+            #endif
+
+            Shader vert{version, Shader::Type::Vertex};
+            Shader frag{version, Shader::Type::Fragment};
+            vert.addSource(rs.get("OcclusionProxy.vert"));
+            frag.addSource(rs.get("OcclusionProxy.frag"));
+
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+            attachShaders({vert, frag});
+            bindAttributeLocation(Position::Location, "position");
+            CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        }
+
+        ProxyShader& setTransformationProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+    private:
+        Int _transformationProjectionMatrixUniform;
+};
+
+/* Unit cube, used as a box around the bounding sphere */
+constexpr const Vector3 ProxyVertices[]{
+    {-1.0f, -1.0f,  1.0f}, { 1.0f, -1.0f,  1.0f},
+    { 1.0f,  1.0f,  1.0f}, {-1.0f,  1.0f,  1.0f},
+    {-1.0f, -1.0f, -1.0f}, { 1.0f, -1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f}, {-1.0f,  1.0f, -1.0f}
+};
+constexpr const UnsignedByte ProxyIndices[]{
+    0, 1, 2, 0, 2, 3, /* +Z */
+    1, 5, 6, 1, 6, 2, /* +X */
+    5, 4, 7, 5, 7, 6, /* -Z */
+    4, 0, 3, 4, 3, 7, /* -X */
+    3, 2, 6, 3, 6, 7, /* +Y */
+    4, 5, 1, 4, 1, 0  /* -Y */
+};
+
+struct DrawableState {
+    explicit DrawableState(SampleQuery::Target target, UnsignedInt phase): query{target}, phase{phase} {}
+
+    SampleQuery query;
+    bool visible{true}, pending{};
+    UnsignedInt phase;
+    std::size_t lastFrame{};
+};
+
+}
+
+struct OcclusionCulling::State {
+    explicit State();
+
+    ProxyShader shader;
+    Buffer vertices, indices;
+    Mesh mesh;
+
+    SampleQuery::Target queryTarget;
+    UnsignedInt requeryInterval{4};
+    #ifndef MAGNUM_TARGET_GLES
+    bool conditionalRendering;
+    #endif
+
+    std::size_t frame{}, issuedQueryCount{};
+    UnsignedInt nextPhase{};
+
+    std::unordered_map<Drawable3D*, DrawableState> drawables;
+
+    /* Temporary storage, reused to avoid allocations */
+    std::vector<Matrix4> transformations;
+    std::vector<std::pair<DrawableState*, Matrix4>> proxies;
+};
+
+OcclusionCulling::State::State() {
+    #ifdef MAGNUM_TARGET_GLES2
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::occlusion_query_boolean);
+    #endif
+
+    vertices.setData(ProxyVertices, BufferUsage::StaticDraw);
+    indices.setData(ProxyIndices, BufferUsage::StaticDraw);
+    mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(Containers::arraySize(ProxyIndices))
+        .addVertexBuffer(vertices, 0, ProxyShader::Position{})
+        .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedByte, 0, 7);
+
+    #ifndef MAGNUM_TARGET_GLES
+    queryTarget = Context::current().isExtensionSupported<Extensions::GL::ARB::occlusion_query2>() ?
+        SampleQuery::Target::AnySamplesPassed : SampleQuery::Target::SamplesPassed;
+    conditionalRendering = Context::current().isExtensionSupported<Extensions::GL::NV::conditional_render>();
+    #else
+    queryTarget = SampleQuery::Target::AnySamplesPassed;
+    #endif
+}
+
+OcclusionCulling::OcclusionCulling(): _state{new State} {}
+
+OcclusionCulling::OcclusionCulling(OcclusionCulling&&) noexcept = default;
+
+OcclusionCulling::~OcclusionCulling() = default;
+
+OcclusionCulling& OcclusionCulling::operator=(OcclusionCulling&&) noexcept = default;
+
+UnsignedInt OcclusionCulling::requeryInterval() const { return _state->requeryInterval; }
+
+OcclusionCulling& OcclusionCulling::setRequeryInterval(const UnsignedInt interval) {
+    CORRADE_ASSERT(interval, "SceneGraph::OcclusionCulling::setRequeryInterval(): interval can't be zero", *this);
+    _state->requeryInterval = interval;
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+bool OcclusionCulling::isConditionalRenderingEnabled() const { return _state->conditionalRendering; }
+
+OcclusionCulling& OcclusionCulling::setConditionalRenderingEnabled(const bool enabled) {
+    _state->conditionalRendering = enabled;
+    return *this;
+}
+#endif
+
+std::size_t OcclusionCulling::issuedQueryCount() const { return _state->issuedQueryCount; }
+
+void OcclusionCulling::reset() {
+    _state->drawables.clear();
+    _state->nextPhase = 0;
+}
+
+std::pair<std::size_t, std::size_t> OcclusionCulling::draw(Camera3D& camera, DrawableGroup3D& group) {
+    State& state = *_state;
+    ++state.frame;
+    state.issuedQueryCount = 0;
+    state.proxies.clear();
+
+    /* Transformations relative to camera, the frustum is thus extracted from
+       the projection matrix only */
+    camera.drawableTransformationMatrices(group, state.transformations);
+    if(state.transformations.size() != group.size()) return {};
+    const auto planes = Implementation::frustumPlanes<3, Float>(camera.projectionMatrix());
+
+    std::size_t drawn = 0;
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        Drawable3D& drawable = group[i];
+        const Matrix4& transformation = state.transformations[i];
+
+        /* Drawables without bounding sphere are always drawn */
+        if(!drawable.hasBoundingSphere()) {
+            drawable.draw(transformation, camera);
+            ++drawn;
+            continue;
+        }
+
+        const Vector3 center = transformation.transformPoint(drawable.boundingSphereCenter());
+        const Float radius = drawable.boundingSphereRadius()*Math::sqrt(Math::max(Math::max(
+            transformation[0].xyz().dot(), transformation[1].xyz().dot()), transformation[2].xyz().dot()));
+
+        auto found = state.drawables.find(&drawable);
+        if(found == state.drawables.end())
+            found = state.drawables.emplace(std::piecewise_construct, std::forward_as_tuple(&drawable), std::forward_as_tuple(state.queryTarget, state.nextPhase++)).first;
+        DrawableState& s = found->second;
+        s.lastFrame = state.frame;
+
+        /* Outside of the frustum, consider it visible so it's drawn right
+           away when it gets back in */
+        if(!Implementation::sphereInFrustum<3, Float>(planes, center, radius)) {
+            s.visible = true;
+            continue;
+        }
+
+        /* Fetch the result only if it's already there, never wait for it */
+        if(s.pending && s.query.resultAvailable()) {
+            s.visible = s.query.result<bool>();
+            s.pending = false;
+        }
+
+        /* The proxy box is crossing the near plane, the query would report
+           it hidden even though the camera is inside */
+        if(Math::dot(Vector3::pad(planes[4]), center) + planes[4][3] < radius*Constants::sqrt3()) {
+            s.visible = true;
+            drawable.draw(transformation, camera);
+            ++drawn;
+            continue;
+        }
+
+        /* Visible drawables are requeried only once in a while, each frame
+           for a different subset */
+        const Matrix4 proxyTransformation = camera.projectionMatrix()*Matrix4::translation(center)*Matrix4::scaling(Vector3{radius});
+        if(s.visible) {
+            drawable.draw(transformation, camera);
+            ++drawn;
+            if(!s.pending && (state.frame + s.phase) % state.requeryInterval == 0)
+                state.proxies.emplace_back(&s, proxyTransformation);
+            continue;
+        }
+
+        /* Hidden drawable with the result not known yet, let the GPU decide */
+        #ifndef MAGNUM_TARGET_GLES
+        if(s.pending && state.conditionalRendering) {
+            s.query.beginConditionalRender(SampleQuery::ConditionalRenderMode::NoWait);
+            drawable.draw(transformation, camera);
+            s.query.endConditionalRender();
+            ++drawn;
+            continue;
+        }
+        #endif
+
+        /* Hidden drawables are queried every frame */
+        if(!s.pending) state.proxies.emplace_back(&s, proxyTransformation);
+    }
+
+    /* Render the proxies after everything else so they are tested against
+       the complete depth buffer */
+    if(!state.proxies.empty()) {
+        Renderer::setColorMask(false, false, false, false);
+        Renderer::setDepthMask(false);
+
+        for(const std::pair<DrawableState*, Matrix4>& proxy: state.proxies) {
+            state.shader.setTransformationProjectionMatrix(proxy.second);
+            proxy.first->query.begin();
+            state.mesh.draw(state.shader);
+            proxy.first->query.end();
+            proxy.first->pending = true;
+        }
+
+        Renderer::setDepthMask(true);
+        Renderer::setColorMask(true, true, true, true);
+        state.issuedQueryCount = state.proxies.size();
+    }
+
+    /* Forget drawables that were removed from the group */
+    for(auto it = state.drawables.begin(); it != state.drawables.end(); ) {
+        if(it->second.lastFrame != state.frame) it = state.drawables.erase(it);
+        else ++it;
+    }
+
+    return {drawn, group.size() - drawn};
+}
+
+}}
@@ -0,0 +1,193 @@
+#ifndef Magnum_SceneGraph_OcclusionCulling_h
+#define Magnum_SceneGraph_OcclusionCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::OcclusionCulling
+ */
+#endif
+
+#include <memory>
+#include <utility>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Occlusion culling
+
+Draws a @ref DrawableGroup3D, skipping drawables that were hidden behind
+other geometry in previous frames. Visibility of each drawable is
+determined by rendering a cheap proxy --- a box around its bounding sphere
+--- with color and depth writes disabled into a @ref SampleQuery after all
+visible drawables were drawn. Query results are fetched only when they are
+already available, so the CPU never waits for the GPU.
+
+## Usage
+
+Set bounding spheres of the drawables using @ref Drawable::setBoundingSphere()
+and draw the group using @ref draw() instead of @ref Camera::draw().
+Drawables without bounding sphere are always drawn. It's advised to draw the
+large occluders (terrain, buildings) first, either in a separate group
+using @ref Camera::draw() or by ordering the group, as they provide the
+depth information the proxies are tested against.
+@code
+SceneGraph::DrawableGroup3D drawables;
+SceneGraph::OcclusionCulling culling;
+
+void MyApplication::drawEvent() {
+    defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+
+    camera->draw(occluders);
+    std::pair<std::size_t, std::size_t> stats = culling.draw(*camera, drawables);
+    Debug() << "Drawn" << stats.first << "objects, culled" << stats.second;
+
+    swapBuffers();
+}
+@endcode
+
+@anchor SceneGraph-OcclusionCulling-temporal-coherence
+## Temporal coherence
+
+Objects that are not in the view frustum are culled right away and not
+queried at all. Objects that were hidden are queried every frame, as they
+need to be drawn as soon as they become visible. Visibility of objects that
+were visible usually doesn't change quickly, so these are queried only once
+every @ref requeryInterval() frames, each frame for a different subset, which
+spreads the query cost evenly. Objects crossing the camera near plane are
+always considered visible.
+
+A hidden object becoming visible is drawn at the earliest one frame later
+when the query result arrives. On desktop OpenGL @ref SampleQuery::beginConditionalRender()
+"conditional rendering" can be used to hide the latency: if the result of a
+hidden object query didn't arrive yet, the object is drawn with
+@ref SampleQuery::ConditionalRenderMode::NoWait, letting the GPU discard it
+when the result becomes known. See @ref setConditionalRenderingEnabled().
+
+@requires_gl33 Extension @extension{ARB,occlusion_query2} for boolean
+    queries, otherwise sample count queries are used.
+@requires_gles30 Extension @es_extension{EXT,occlusion_query_boolean} in
+    OpenGL ES 2.0.
+@requires_webgl20 Queries are not available in WebGL 1.0.
+@see @ref scenegraph, @ref Camera::drawCulled()
+*/
+class MAGNUM_SCENEGRAPH_EXPORT OcclusionCulling {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates the proxy mesh and shader. Requires an active context.
+         */
+        explicit OcclusionCulling();
+
+        /** @brief Copying is not allowed */
+        OcclusionCulling(const OcclusionCulling&) = delete;
+
+        /** @brief Move constructor */
+        OcclusionCulling(OcclusionCulling&&) noexcept;
+
+        ~OcclusionCulling();
+
+        /** @brief Copying is not allowed */
+        OcclusionCulling& operator=(const OcclusionCulling&) = delete;
+
+        /** @brief Move assignment */
+        OcclusionCulling& operator=(OcclusionCulling&&) noexcept;
+
+        /** @brief Requery interval for visible drawables */
+        UnsignedInt requeryInterval() const;
+
+        /**
+         * @brief Set requery interval for visible drawables
+         * @return Reference to self (for method chaining)
+         *
+         * Visible drawables are queried once every @p interval frames.
+         * Value of `1` queries all drawables every frame. Expects that the
+         * value is not zero. Default is `4`.
+         */
+        OcclusionCulling& setRequeryInterval(UnsignedInt interval);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /** @brief Whether conditional rendering is enabled */
+        bool isConditionalRenderingEnabled() const;
+
+        /**
+         * @brief Enable or disable conditional rendering
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, hidden drawables with pending query are drawn under
+         * conditional rendering. See @ref SceneGraph-OcclusionCulling-temporal-coherence "class documentation"
+         * for more information. Enabled by default if
+         * @extension{NV,conditional_render} (part of OpenGL 3.0) is
+         * supported.
+         * @requires_gl Conditional rendering is not available in OpenGL ES
+         *      or WebGL.
+         */
+        OcclusionCulling& setConditionalRenderingEnabled(bool enabled);
+        #endif
+
+        /**
+         * @brief Draw the drawable group
+         * @return Count of drawn and culled drawables
+         *
+         * Draws the visible drawables and then renders proxies for the
+         * drawables that are due to be queried. Color and depth mask is
+         * disabled for the proxies and enabled again afterwards.
+         */
+        std::pair<std::size_t, std::size_t> draw(Camera3D& camera, DrawableGroup3D& group);
+
+        /**
+         * @brief Count of queries issued in the last @ref draw() call
+         *
+         * Useful for tuning @ref setRequeryInterval().
+         */
+        std::size_t issuedQueryCount() const;
+
+        /**
+         * @brief Forget all visibility information
+         *
+         * All drawables are considered visible again. Useful after a camera
+         * cut, where the results from previous frames don't make sense
+         * anymore.
+         */
+        void reset();
+
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+};
+
+}}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
@@ -317,6 +317,10 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation2D<T>> {
     static Math::Matrix3<T> inverted(const Math::Matrix3<T>& transformation) {
         return transformation.invertedRigid();
     }
+
+    static Math::Matrix3<T> invertedMatrix(const Math::Matrix3<T>& matrix) {
+        return matrix.invertedRigid();
+    }
 };
 
 }
@@ -452,6 +452,10 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation3D<T>> {
     static Math::Matrix4<T> inverted(const Math::Matrix4<T>& transformation) {
         return transformation.invertedRigid();
     }
+
+    static Math::Matrix4<T> invertedMatrix(const Math::Matrix4<T>& matrix) {
+        return matrix.invertedRigid();
+    }
 };
 
 }
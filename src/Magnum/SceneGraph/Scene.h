@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::SceneGraph::Scene
  */
 
+#include "Magnum/SceneGraph/Arena.h"
 #include "Magnum/SceneGraph/Object.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -38,13 +39,67 @@ namespace Magnum { namespace SceneGraph {
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+## Arena allocation
+
+Objects and features can be allocated in an @ref Arena owned by the scene
+instead of on the heap. They are then destroyed together with the scene, see
+@ref arena() for details.
 */
 template<class Transformation> class Scene: public Object<Transformation> {
+    friend Object<Transformation>;
+
     public:
         explicit Scene() = default;
 
+        /**
+         * @brief Current generation
+         *
+         * Objects marked as dirty record this value in
+         * @ref Object::dirtyGeneration(). Initial value is `1`.
+         * @see @ref nextGeneration()
+         */
+        UnsignedInt generation() const { return _generation; }
+
+        /**
+         * @brief Advance to next generation
+         * @return Reference to self (for method chaining)
+         *
+         * Usually called once per frame.
+         */
+        Scene<Transformation>& nextGeneration() {
+            ++_generation;
+            return *this;
+        }
+
+        /**
+         * @brief Arena for allocating objects and features
+         *
+         * Instances created in the arena are destroyed when the scene is
+         * destroyed, before any heap-allocated children of the scene. See
+         * @ref Arena for more information.
+         */
+        Arena& arena() { return _arena; }
+
     private:
         bool isScene() const override final { return true; }
+
+        /* Temporary storage for Object::transformations() and friends, kept
+           here to avoid allocations on every call. The computation modifies
+           object flags anyway, so it's not reentrant even without these. */
+        mutable std::vector<std::reference_wrapper<Object<Transformation>>> _transformationObjects, _transformationJointObjects, _transformationCastObjects;
+        mutable std::vector<typename Transformation::DataType> _transformations;
+
+        /* Borrowed by Object::setClean(), a nested call gets an empty one */
+        std::vector<typename Transformation::DataType> _cleanTransformations;
+
+        /* Traversal stack for Object::setDirty() */
+        std::vector<Object<Transformation>*> _dirtyObjects;
+        UnsignedInt _generation{1};
+
+        /* Destroyed before the Object base, thus before heap-allocated
+           children */
+        Arena _arena;
 };
 
 }}
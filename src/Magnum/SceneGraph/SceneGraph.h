@@ -98,6 +98,8 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+class Arena;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
@@ -135,13 +137,32 @@ template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+template<UnsignedInt, class> class LevelOfDetail;
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+
+template<class> class AffineMatrix4x3;
+template<class> class BasicAffineMatrixTransformation3D;
+typedef BasicAffineMatrixTransformation3D<Float> AffineMatrixTransformation3D;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
+template<class> class BasicMultiViewCamera3D;
+typedef BasicMultiViewCamera3D<Float> MultiViewCamera3D;
+
+template<class Transformation> class FlatScene;
+
 template<class Transformation> class Object;
 
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class OcclusionCulling;
+#endif
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
@@ -149,6 +170,32 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<UnsignedInt, class> class Spatial;
+template<class T> using BasicSpatial2D = Spatial<2, T>;
+template<class T> using BasicSpatial3D = Spatial<3, T>;
+typedef BasicSpatial2D<Float> Spatial2D;
+typedef BasicSpatial3D<Float> Spatial3D;
+
+template<UnsignedInt, class> class SpatialGroup;
+template<class T> using BasicSpatialGroup2D = SpatialGroup<2, T>;
+template<class T> using BasicSpatialGroup3D = SpatialGroup<3, T>;
+typedef BasicSpatialGroup2D<Float> SpatialGroup2D;
+typedef BasicSpatialGroup3D<Float> SpatialGroup3D;
+
+class Sprite;
+class SpriteBatch;
+
+template<class> class BasicTrackAnimator3D;
+typedef BasicTrackAnimator3D<Float> TrackAnimator3D;
+
+template<class> class TransformationInterpolator;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt> class TransformationPalette;
+typedef TransformationPalette<2> TransformationPalette2D;
+typedef TransformationPalette<3> TransformationPalette3D;
+#endif
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
@@ -0,0 +1,213 @@
+#ifndef Magnum_SceneGraph_Spatial_h
+#define Magnum_SceneGraph_Spatial_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Spatial, alias @ref Magnum::SceneGraph::BasicSpatial2D, @ref Magnum::SceneGraph::BasicSpatial3D, typedef @ref Magnum::SceneGraph::Spatial2D, @ref Magnum::SceneGraph::Spatial3D
+ */
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Spatially indexed feature
+
+Makes the object findable by position using neighbor queries on
+@ref SpatialGroup. The object is represented by a bounding sphere in its
+local coordinates, which is transformed with the absolute object
+transformation when the object is cleaned.
+
+## Usage
+
+Add the feature to the object, set its bounding sphere and add it to a
+group. The group then answers which objects are in given radius, in given
+box or nearest to given point without going through all of them.
+@code
+SceneGraph::SpatialGroup3D spatials;
+
+class Enemy: public Object3D {
+    public:
+        explicit Enemy(Object3D* parent, SceneGraph::SpatialGroup3D& spatials): Object3D{parent} {
+            (new SceneGraph::Spatial3D{*this, &spatials})
+                ->setBoundingSphere({}, 0.5f);
+        }
+};
+
+// ...
+for(SceneGraph::Spatial3D& spatial: spatials.withinRadius(player.absoluteTransformation().translation(), 10.0f))
+    alert(spatial.object());
+@endcode
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref Spatial.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref Spatial2D
+-   @ref Spatial3D
+
+@see @ref scenegraph, @ref BasicSpatial2D, @ref BasicSpatial3D,
+    @ref Spatial2D, @ref Spatial3D, @ref SpatialGroup
+*/
+template<UnsignedInt dimensions, class T> class Spatial: public AbstractGroupedFeature<dimensions, Spatial<dimensions, T>, T> {
+    friend SpatialGroup<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this feature belongs to
+         * @param group     Group this feature belongs to
+         *
+         * Adds the feature to the object and to the group, if specified.
+         * The bounding sphere is a point at object origin.
+         * @see @ref setBoundingSphere(), @ref FeatureGroup::add()
+         */
+        explicit Spatial(AbstractObject<dimensions, T>& object, SpatialGroup<dimensions, T>* group = nullptr);
+
+        ~Spatial();
+
+        /**
+         * @brief Group containing this feature
+         *
+         * If the feature doesn't belong to any group, returns `nullptr`.
+         */
+        SpatialGroup<dimensions, T>* spatials();
+        const SpatialGroup<dimensions, T>* spatials() const; /**< @overload */
+
+        /**
+         * @brief Bounding sphere center
+         *
+         * In object local coordinates.
+         * @see @ref setBoundingSphere()
+         */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const {
+            return _boundingSphereCenter;
+        }
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * In object local coordinates.
+         * @see @ref setBoundingSphere()
+         */
+        T boundingSphereRadius() const { return _boundingSphereRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @param center    Sphere center in object local coordinates
+         * @param radius    Sphere radius in object local coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * Non-uniform scaling of the object is accounted for by taking the
+         * largest scaling factor. The feature is updated in the group on
+         * next @ref SpatialGroup::setClean().
+         */
+        Spatial<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Transformed bounding sphere center
+         *
+         * In absolute coordinates, updated when the object is cleaned.
+         */
+        VectorTypeFor<dimensions, T> transformedCenter() const {
+            return _transformedCenter;
+        }
+
+        /**
+         * @brief Transformed bounding sphere radius
+         *
+         * Updated when the object is cleaned.
+         */
+        T transformedRadius() const { return _transformedRadius; }
+
+    private:
+        /* Queues the feature for update in the group */
+        void markDirty() override;
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+        VectorTypeFor<dimensions, T> _boundingSphereCenter;
+        T _boundingSphereRadius;
+        VectorTypeFor<dimensions, T> _transformedCenter;
+        T _transformedRadius;
+        bool _transformedDirty;
+
+        /* Group in which this feature is queued for update, to avoid queuing
+           it more than once */
+        SpatialGroup<dimensions, T>* _queuedIn;
+
+        /* Cell of the group index and position in its list */
+        Math::Vector<dimensions, Int> _cell;
+        std::size_t _cellIndex;
+};
+
+/**
+@brief Spatially indexed feature for two-dimensional scenes
+
+Convenience alternative to `Spatial<2, T>`. See @ref Spatial for more
+information.
+@see @ref Spatial2D, @ref BasicSpatial3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatial2D = Spatial<2, T>;
+#endif
+
+/**
+@brief Spatially indexed feature for two-dimensional float scenes
+
+@see @ref Spatial3D
+*/
+typedef BasicSpatial2D<Float> Spatial2D;
+
+/**
+@brief Spatially indexed feature for three-dimensional scenes
+
+Convenience alternative to `Spatial<3, T>`. See @ref Spatial for more
+information.
+@see @ref Spatial3D, @ref BasicSpatial2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatial3D = Spatial<3, T>;
+#endif
+
+/**
+@brief Spatially indexed feature for three-dimensional float scenes
+
+@see @ref Spatial2D
+*/
+typedef BasicSpatial3D<Float> Spatial3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT Spatial<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Spatial<3, Float>;
+#endif
+
+}}
+
+#endif
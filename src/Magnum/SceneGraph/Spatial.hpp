@@ -0,0 +1,335 @@
+#ifndef Magnum_SceneGraph_Spatial_hpp
+#define Magnum_SceneGraph_Spatial_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Spatial.h and @ref SpatialGroup.h
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Spatial.h"
+#include "Magnum/SceneGraph/SpatialGroup.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+template<UnsignedInt dimensions> UnsignedLong spatialCellKey(const Math::Vector<dimensions, Int>& cell) {
+    /* Coordinates wrap around, which is fine as long as no query spans more
+       cells in one direction than fits into the bits */
+    constexpr UnsignedInt bits = 64/dimensions;
+    constexpr UnsignedLong mask = (UnsignedLong(1) << bits) - 1;
+    UnsignedLong key = 0;
+    for(std::size_t i = 0; i != dimensions; ++i)
+        key |= (UnsignedLong(UnsignedInt(cell[i])) & mask) << (bits*i);
+    return key;
+}
+
+/* Calls f for all cells in given inclusive range */
+template<UnsignedInt dimensions, class F> void spatialForEachCell(const Math::Vector<dimensions, Int>& min, const Math::Vector<dimensions, Int>& max, F f) {
+    Math::Vector<dimensions, Int> cell = min;
+    for(;;) {
+        f(cell);
+
+        std::size_t i = 0;
+        for(; i != dimensions; ++i) {
+            if(cell[i] != max[i]) {
+                ++cell[i];
+                break;
+            }
+            cell[i] = min[i];
+        }
+        if(i == dimensions) return;
+    }
+}
+
+/* Distance of a point from a sphere surface, zero if inside */
+template<UnsignedInt dimensions, class T> T spatialDistance(const Spatial<dimensions, T>& spatial, const VectorTypeFor<dimensions, T>& point) {
+    return Math::max((spatial.transformedCenter() - point).length() - spatial.transformedRadius(), T(0));
+}
+
+}
+
+template<UnsignedInt dimensions, class T> Spatial<dimensions, T>::Spatial(AbstractObject<dimensions, T>& object, SpatialGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Spatial<dimensions, T>, T>(object, group), _boundingSphereRadius(T(0)), _transformedRadius(T(0)), _transformedDirty(true), _queuedIn(nullptr), _cellIndex(0) {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+}
+
+template<UnsignedInt dimensions, class T> Spatial<dimensions, T>::~Spatial() = default;
+
+template<UnsignedInt dimensions, class T> SpatialGroup<dimensions, T>* Spatial<dimensions, T>::spatials() {
+    return static_cast<SpatialGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Spatial<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const SpatialGroup<dimensions, T>* Spatial<dimensions, T>::spatials() const {
+    return static_cast<const SpatialGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Spatial<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> Spatial<dimensions, T>& Spatial<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _boundingSphereCenter = center;
+    _boundingSphereRadius = radius;
+    markDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void Spatial<dimensions, T>::markDirty() {
+    _transformedDirty = true;
+
+    SpatialGroup<dimensions, T>* const group = spatials();
+    if(!group || _queuedIn == group) return;
+
+    group->_dirtySpatials.push_back(this);
+    _queuedIn = group;
+}
+
+template<UnsignedInt dimensions, class T> void Spatial<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    /* Largest scaling for the radius, the same as in LevelOfDetail */
+    T scaling{};
+    for(std::size_t i = 0; i != dimensions; ++i)
+        scaling = Math::max(scaling, Math::Vector<dimensions, T>::pad(absoluteTransformationMatrix[i]).length());
+
+    _transformedCenter = absoluteTransformationMatrix.transformPoint(_boundingSphereCenter);
+    _transformedRadius = _boundingSphereRadius*scaling;
+    _transformedDirty = false;
+}
+
+template<UnsignedInt dimensions, class T> SpatialGroup<dimensions, T>::SpatialGroup(): _cellSize(T(1)), _maxRadius(T(0)), _rebuild(true), _cleanedCount(0) {}
+
+template<UnsignedInt dimensions, class T> SpatialGroup<dimensions, T>::~SpatialGroup() {
+    for(std::size_t i = 0; i != this->size(); ++i)
+        if((*this)[i]._queuedIn == this) (*this)[i]._queuedIn = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> SpatialGroup<dimensions, T>& SpatialGroup<dimensions, T>::setCellSize(const T size) {
+    CORRADE_ASSERT(size > T(0),
+        "SceneGraph::SpatialGroup::setCellSize(): expected positive size but got" << size, *this);
+    _cellSize = size;
+    _rebuild = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> auto SpatialGroup<dimensions, T>::cellFor(const VectorTypeFor<dimensions, T>& position) const -> Cell {
+    return Cell{Math::floor(position/_cellSize)};
+}
+
+template<UnsignedInt dimensions, class T> void SpatialGroup<dimensions, T>::insert(Spatial<dimensions, T>& spatial) {
+    spatial._cell = cellFor(spatial._transformedCenter);
+    std::vector<Spatial<dimensions, T>*>& cell = _cells[Implementation::spatialCellKey(spatial._cell)];
+    spatial._cellIndex = cell.size();
+    cell.push_back(&spatial);
+    _maxRadius = Math::max(_maxRadius, spatial._transformedRadius);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialGroup<dimensions, T>::erase(Spatial<dimensions, T>& spatial) {
+    /* Move the last feature of the cell into place of the removed one */
+    auto found = _cells.find(Implementation::spatialCellKey(spatial._cell));
+    CORRADE_INTERNAL_ASSERT(found != _cells.end());
+    std::vector<Spatial<dimensions, T>*>& cell = found->second;
+    cell.back()->_cellIndex = spatial._cellIndex;
+    cell[spatial._cellIndex] = cell.back();
+    cell.pop_back();
+    if(cell.empty()) _cells.erase(found);
+}
+
+template<UnsignedInt dimensions, class T> void SpatialGroup<dimensions, T>::setClean() {
+    /* If any feature was added, removed or the group was reordered, the
+       dirty list and the index might contain features which are not in the
+       group anymore, so don't touch them and rebuild everything */
+    bool changed = _rebuild || _indexedSpatials.size() != this->size();
+    for(std::size_t i = 0; !changed && i != this->size(); ++i)
+        if(_indexedSpatials[i] != &(*this)[i]) changed = true;
+
+    std::vector<Spatial<dimensions, T>*> spatials;
+    if(changed) {
+        _indexedSpatials.clear();
+        _indexedSpatials.reserve(this->size());
+        for(std::size_t i = 0; i != this->size(); ++i)
+            _indexedSpatials.push_back(&(*this)[i]);
+        spatials = _indexedSpatials;
+    } else spatials.swap(_dirtySpatials);
+    _dirtySpatials.clear();
+
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(spatials.size());
+    for(Spatial<dimensions, T>* spatial: spatials) {
+        objects.push_back(spatial->object());
+        spatial->_queuedIn = nullptr;
+    }
+    if(!objects.empty())
+        AbstractObject<dimensions, T>::setClean(objects);
+
+    /* Features whose objects were already clean, but the bounding sphere
+       changed, need to be transformed explicitly */
+    for(Spatial<dimensions, T>* spatial: spatials)
+        if(spatial->_transformedDirty)
+            spatial->clean(spatial->object().absoluteTransformationMatrix());
+
+    if(changed) {
+        _cells.clear();
+        _maxRadius = T(0);
+        for(Spatial<dimensions, T>* spatial: spatials) insert(*spatial);
+    } else for(Spatial<dimensions, T>* spatial: spatials) {
+        if(cellFor(spatial->_transformedCenter) != spatial->_cell) {
+            erase(*spatial);
+            insert(*spatial);
+        } else _maxRadius = Math::max(_maxRadius, spatial->_transformedRadius);
+    }
+
+    _cleanedCount = spatials.size();
+    _rebuild = false;
+}
+
+template<UnsignedInt dimensions, class T> bool SpatialGroup<dimensions, T>::cellRange(const RangeTypeFor<dimensions, T>& range, Cell& min, Cell& max) const {
+    const VectorTypeFor<dimensions, T> minf = Math::floor((range.min() - VectorTypeFor<dimensions, T>{_maxRadius})/_cellSize);
+    const VectorTypeFor<dimensions, T> maxf = Math::floor((range.max() + VectorTypeFor<dimensions, T>{_maxRadius})/_cellSize);
+
+    /* Going through all features is faster than going through more cells
+       than there are features. This also avoids overflows for huge
+       queries. */
+    T count{1};
+    for(std::size_t i = 0; i != dimensions; ++i)
+        count *= maxf[i] - minf[i] + T(1);
+    if(!(count <= T(this->size()))) return false;
+
+    min = Cell{minf};
+    max = Cell{maxf};
+    return true;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::reference_wrapper<Spatial<dimensions, T>>> SpatialGroup<dimensions, T>::withinRadius(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    setClean();
+
+    std::vector<std::reference_wrapper<Spatial<dimensions, T>>> out;
+    auto test = [&](Spatial<dimensions, T>& spatial) {
+        const T distance = radius + spatial._transformedRadius;
+        if((spatial._transformedCenter - center).dot() <= distance*distance)
+            out.push_back(spatial);
+    };
+
+    Cell min, max;
+    if(!cellRange({center - VectorTypeFor<dimensions, T>{radius}, center + VectorTypeFor<dimensions, T>{radius}}, min, max)) {
+        for(std::size_t i = 0; i != this->size(); ++i) test((*this)[i]);
+        return out;
+    }
+
+    Implementation::spatialForEachCell<dimensions>(min, max, [&](const Cell& cell) {
+        auto found = _cells.find(Implementation::spatialCellKey(cell));
+        if(found == _cells.end()) return;
+        for(Spatial<dimensions, T>* spatial: found->second) test(*spatial);
+    });
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::reference_wrapper<Spatial<dimensions, T>>> SpatialGroup<dimensions, T>::withinRange(const RangeTypeFor<dimensions, T>& range) {
+    setClean();
+
+    std::vector<std::reference_wrapper<Spatial<dimensions, T>>> out;
+    auto test = [&](Spatial<dimensions, T>& spatial) {
+        const VectorTypeFor<dimensions, T> closest = Math::min(Math::max(spatial._transformedCenter, range.min()), range.max());
+        if((spatial._transformedCenter - closest).dot() <= spatial._transformedRadius*spatial._transformedRadius)
+            out.push_back(spatial);
+    };
+
+    Cell min, max;
+    if(!cellRange(range, min, max)) {
+        for(std::size_t i = 0; i != this->size(); ++i) test((*this)[i]);
+        return out;
+    }
+
+    Implementation::spatialForEachCell<dimensions>(min, max, [&](const Cell& cell) {
+        auto found = _cells.find(Implementation::spatialCellKey(cell));
+        if(found == _cells.end()) return;
+        for(Spatial<dimensions, T>* spatial: found->second) test(*spatial);
+    });
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::reference_wrapper<Spatial<dimensions, T>>> SpatialGroup<dimensions, T>::nearest(const VectorTypeFor<dimensions, T>& point, const std::size_t count) {
+    setClean();
+
+    /* Max-heap of the best candidates so far */
+    std::vector<std::pair<T, Spatial<dimensions, T>*>> best;
+    best.reserve(count + 1);
+    auto compare = [](const std::pair<T, Spatial<dimensions, T>*>& a, const std::pair<T, Spatial<dimensions, T>*>& b) {
+        return a.first < b.first;
+    };
+    auto test = [&](Spatial<dimensions, T>& spatial) {
+        const T distance = Implementation::spatialDistance(spatial, point);
+        if(best.size() == count && !(distance < best.front().first)) return;
+        best.emplace_back(distance, &spatial);
+        std::push_heap(best.begin(), best.end(), compare);
+        if(best.size() > count) {
+            std::pop_heap(best.begin(), best.end(), compare);
+            best.pop_back();
+        }
+    };
+
+    if(count) {
+        /* Go through rings of cells around the point. All features in cells
+           of ring r are at least (r - 1)*cellSize - maxRadius far from the
+           point, so stop once the candidates found so far are all closer.
+           If the rings get larger than the feature count, go through all
+           features instead. */
+        const Cell origin = cellFor(point);
+        std::size_t visited = 0;
+        for(Int ring = 0; visited < this->size(); ++ring) {
+            if(best.size() == count && best.front().first <= T(ring - 1)*_cellSize - _maxRadius)
+                break;
+
+            if(!(std::pow(T(2*ring + 1), T(dimensions)) <= T(this->size()))) {
+                best.clear();
+                for(std::size_t i = 0; i != this->size(); ++i) test((*this)[i]);
+                break;
+            }
+
+            Implementation::spatialForEachCell<dimensions>(origin - Cell{ring}, origin + Cell{ring}, [&](const Cell& cell) {
+                /* Only the cells on the ring boundary */
+                if((cell - origin).max() != ring && (origin - cell).max() != ring)
+                    return;
+
+                auto found = _cells.find(Implementation::spatialCellKey(cell));
+                if(found == _cells.end()) return;
+                for(Spatial<dimensions, T>* spatial: found->second) test(*spatial);
+                visited += found->second.size();
+            });
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end(), compare);
+    std::vector<std::reference_wrapper<Spatial<dimensions, T>>> out;
+    out.reserve(best.size());
+    for(const auto& candidate: best) out.push_back(*candidate.second);
+    return out;
+}
+
+}}
+
+#endif
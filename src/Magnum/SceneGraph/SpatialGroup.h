@@ -0,0 +1,205 @@
+#ifndef Magnum_SceneGraph_SpatialGroup_h
+#define Magnum_SceneGraph_SpatialGroup_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialGroup, alias @ref Magnum::SceneGraph::BasicSpatialGroup2D, @ref Magnum::SceneGraph::BasicSpatialGroup3D, typedef @ref Magnum::SceneGraph::SpatialGroup2D, @ref Magnum::SceneGraph::SpatialGroup3D
+ */
+
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Group of spatially indexed features
+
+See @ref Spatial for more information.
+
+## Spatial index
+
+The features are kept in a hashed grid of cells with size set by
+@ref setCellSize(), each feature is put into the cell containing its
+transformed bounding sphere center. The grid is loose --- queries look also
+into neighboring cells up to the largest bounding sphere radius in the group,
+so a feature is found even if its sphere overlaps cells it's not in. The cell
+size should be roughly the size of typical query radius. Cell coordinates
+are expected to fit into 32 bits in 2D and 21 bits in 3D.
+
+The index is updated in @ref setClean(), which is called before every query.
+If features were added to or removed from the group since the last call, the
+index is rebuilt. Otherwise only features whose objects were marked dirty
+in the meantime are updated and moved to another cell if needed, which is
+cheap if only a small part of the scene moves each frame. The largest radius
+is only increased in incremental updates, so the queries stay conservative.
+@see @ref scenegraph, @ref BasicSpatialGroup2D, @ref BasicSpatialGroup3D,
+    @ref SpatialGroup2D, @ref SpatialGroup3D
+*/
+template<UnsignedInt dimensions, class T> class SpatialGroup: public FeatureGroup<dimensions, Spatial<dimensions, T>, T> {
+    friend Spatial<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Cell size is set to `1`.
+         */
+        explicit SpatialGroup();
+
+        ~SpatialGroup();
+
+        /** @brief Cell size */
+        T cellSize() const { return _cellSize; }
+
+        /**
+         * @brief Set cell size
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the size is positive. The index is rebuilt on next
+         * @ref setClean().
+         */
+        SpatialGroup<dimensions, T>& setCellSize(T size);
+
+        /**
+         * @brief Update the index
+         *
+         * Cleans objects of features that were marked dirty since the last
+         * call and moves the features to their new cells. If features were
+         * added or removed, all objects are cleaned and the index is
+         * rebuilt.
+         * @see @ref cleanedCount()
+         */
+        void setClean();
+
+        /**
+         * @brief Count of features updated in last @ref setClean() call
+         *
+         * If the index was rebuilt, equal to count of all features in the
+         * group.
+         */
+        std::size_t cleanedCount() const { return _cleanedCount; }
+
+        /**
+         * @brief Features in given radius
+         *
+         * Returns features whose transformed bounding sphere intersects
+         * sphere with given @p center and @p radius, in unspecified order.
+         * Calls @ref setClean() before the operation.
+         */
+        std::vector<std::reference_wrapper<Spatial<dimensions, T>>> withinRadius(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Features in given range
+         *
+         * Returns features whose transformed bounding sphere intersects given
+         * axis-aligned box, in unspecified order. Calls @ref setClean()
+         * before the operation.
+         */
+        std::vector<std::reference_wrapper<Spatial<dimensions, T>>> withinRange(const RangeTypeFor<dimensions, T>& range);
+
+        /**
+         * @brief Features nearest to given point
+         *
+         * Returns at most @p count features sorted by distance of their
+         * transformed bounding sphere from @p point, nearest first. Features
+         * containing the point have zero distance. Calls @ref setClean()
+         * before the operation.
+         */
+        std::vector<std::reference_wrapper<Spatial<dimensions, T>>> nearest(const VectorTypeFor<dimensions, T>& point, std::size_t count);
+
+    private:
+        typedef Math::Vector<dimensions, Int> Cell;
+
+        Cell MAGNUM_SCENEGRAPH_LOCAL cellFor(const VectorTypeFor<dimensions, T>& position) const;
+        void MAGNUM_SCENEGRAPH_LOCAL insert(Spatial<dimensions, T>& spatial);
+        void MAGNUM_SCENEGRAPH_LOCAL erase(Spatial<dimensions, T>& spatial);
+        /* Cell range covering given range extended by the largest radius,
+           false if it has more cells than there are features */
+        bool MAGNUM_SCENEGRAPH_LOCAL cellRange(const RangeTypeFor<dimensions, T>& range, Cell& min, Cell& max) const;
+
+        T _cellSize, _maxRadius;
+        bool _rebuild;
+        std::size_t _cleanedCount;
+
+        /* Features marked dirty since last setClean(), and all features in
+           group order at the time of last rebuild to detect added and
+           removed features, which would make the list and the index
+           unreliable */
+        std::vector<Spatial<dimensions, T>*> _dirtySpatials;
+        std::vector<Spatial<dimensions, T>*> _indexedSpatials;
+
+        /* Features in each non-empty cell, keyed by packed cell coordinates */
+        std::unordered_map<UnsignedLong, std::vector<Spatial<dimensions, T>*>> _cells;
+};
+
+/**
+@brief Spatial group for two-dimensional scenes
+
+Convenience alternative to `SpatialGroup<2, T>`. See @ref Spatial for more
+information.
+@see @ref SpatialGroup2D, @ref BasicSpatialGroup3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialGroup2D = SpatialGroup<2, T>;
+#endif
+
+/**
+@brief Spatial group for two-dimensional float scenes
+
+@see @ref SpatialGroup3D
+*/
+typedef BasicSpatialGroup2D<Float> SpatialGroup2D;
+
+/**
+@brief Spatial group for three-dimensional scenes
+
+Convenience alternative to `SpatialGroup<3, T>`. See @ref Spatial for more
+information.
+@see @ref SpatialGroup3D, @ref BasicSpatialGroup2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialGroup3D = SpatialGroup<3, T>;
+#endif
+
+/**
+@brief Spatial group for three-dimensional float scenes
+
+@see @ref SpatialGroup2D
+*/
+typedef BasicSpatialGroup3D<Float> SpatialGroup3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialGroup<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialGroup<3, Float>;
+#endif
+
+}}
+
+#endif
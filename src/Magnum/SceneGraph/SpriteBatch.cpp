@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/MeshView.h"
+#include "Magnum/RingBuffer.h"
+#include "Magnum/SceneGraph/Camera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+template<class T> std::vector<T> quadIndices(const UnsignedInt capacity) {
+    std::vector<T> indices(capacity*6);
+    for(UnsignedInt i = 0; i != capacity; ++i) {
+        const T first = T(i*4);
+        indices[i*6 + 0] = first + 0;
+        indices[i*6 + 1] = first + 1;
+        indices[i*6 + 2] = first + 2;
+        indices[i*6 + 3] = first + 2;
+        indices[i*6 + 4] = first + 1;
+        indices[i*6 + 5] = first + 3;
+    }
+    return indices;
+}
+
+}
+
+Range2D SpriteBatch::textureCoordinates(const Range2Di& rectangle, const Vector2i& textureSize) {
+    return {Vector2{rectangle.min()}/Vector2{textureSize},
+            Vector2{rectangle.max()}/Vector2{textureSize}};
+}
+
+SpriteBatch::SpriteBatch(RingBuffer& ring, const UnsignedInt capacity): _ring(ring), _capacity{capacity}, _indices{Buffer::TargetHint::ElementArray}, _drawCallCount{0} {
+    CORRADE_ASSERT(capacity, "SceneGraph::SpriteBatch: capacity must be positive", );
+
+    if(capacity*4 <= 65536) {
+        _indexType = Mesh::IndexType::UnsignedShort;
+        _indices.setData(quadIndices<UnsignedShort>(capacity), BufferUsage::StaticDraw);
+    } else {
+        _indexType = Mesh::IndexType::UnsignedInt;
+        _indices.setData(quadIndices<UnsignedInt>(capacity), BufferUsage::StaticDraw);
+    }
+}
+
+SpriteBatch::~SpriteBatch() = default;
+
+SpriteBatch& SpriteBatch::add(const Matrix3& transformationMatrix, const Range2D& rectangle, const Range2D& textureCoordinates, const Color4ub& color, const UnsignedInt page, const Int layer) {
+    /* Transform one corner and the edges instead of all four corners */
+    const Vector2 origin = transformationMatrix.transformPoint(rectangle.min());
+    const Vector2 right = transformationMatrix.right()*rectangle.sizeX();
+    const Vector2 up = transformationMatrix.up()*rectangle.sizeY();
+
+    _vertices.push_back({origin, textureCoordinates.bottomLeft(), color});
+    _vertices.push_back({origin + right, textureCoordinates.bottomRight(), color});
+    _vertices.push_back({origin + up, textureCoordinates.topLeft(), color});
+    _vertices.push_back({origin + right + up, textureCoordinates.topRight(), color});
+
+    /* Flip the sign bit so negative layers are sorted before positive ones */
+    _keys.push_back(UnsignedLong(UnsignedInt(layer) ^ 0x80000000u) << 32 | page);
+    return *this;
+}
+
+SpriteBatch& SpriteBatch::draw(AbstractShaderProgram& shader, const BindPageFunction& bindPage) {
+    _drawCallCount = 0;
+    const std::size_t count = _keys.size();
+
+    /* Sort by layer and page, keeping the order of sprites with the same
+       key. In the common case of sprites being already added in order
+       there's nothing to do. */
+    _order.resize(count);
+    std::iota(_order.begin(), _order.end(), 0);
+    if(!std::is_sorted(_keys.begin(), _keys.end()))
+        std::stable_sort(_order.begin(), _order.end(), [this](UnsignedInt a, UnsignedInt b) {
+            return _keys[a] < _keys[b];
+        });
+
+    for(std::size_t chunkBegin = 0; chunkBegin < count; chunkBegin += _capacity) {
+        const std::size_t chunkCount = std::min(std::size_t(_capacity), count - chunkBegin);
+
+        /* Align the allocation to vertex size, copy the vertices in sorted
+           order */
+        const std::pair<GLintptr, Containers::ArrayView<char>> allocation = _ring.allocate(chunkCount*4*sizeof(Vertex), 4);
+        for(std::size_t i = 0; i != chunkCount; ++i)
+            std::memcpy(allocation.second.data() + i*4*sizeof(Vertex), &_vertices[_order[chunkBegin + i]*4], 4*sizeof(Vertex));
+        _ring.flush();
+
+        Mesh mesh;
+        mesh.setPrimitive(MeshPrimitive::Triangles)
+            .setCount(Int(chunkCount*6))
+            .addVertexBuffer(_ring.buffer(), allocation.first,
+                Position{},
+                TextureCoordinates{},
+                Color{Color::DataType::UnsignedByte, Color::DataOption::Normalized})
+            .setIndexBuffer(_indices, 0, _indexType);
+
+        /* Draw each run of sprites with the same page at once */
+        std::size_t runBegin = 0;
+        for(std::size_t i = 1; i <= chunkCount; ++i) {
+            const UnsignedInt page = UnsignedInt(_keys[_order[chunkBegin + runBegin]]);
+            if(i != chunkCount && UnsignedInt(_keys[_order[chunkBegin + i]]) == page)
+                continue;
+
+            if(bindPage) bindPage(page);
+            MeshView view{mesh};
+            view.setCount(Int((i - runBegin)*6))
+                .setIndexRange(Int(runBegin*6));
+            view.draw(shader);
+
+            ++_drawCallCount;
+            runBegin = i;
+        }
+    }
+
+    return clear();
+}
+
+SpriteBatch& SpriteBatch::clear() {
+    _vertices.clear();
+    _keys.clear();
+    return *this;
+}
+
+Sprite::Sprite(AbstractObject2D& object, SpriteBatch& batch, DrawableGroup2D* drawables): Drawable2D{object, drawables}, _batch(batch), _rectangle{{-1.0f, -1.0f}, {1.0f, 1.0f}}, _textureCoordinates{{0.0f, 0.0f}, {1.0f, 1.0f}}, _color{255}, _page{0}, _layer{0} {}
+
+Sprite::~Sprite() = default;
+
+void Sprite::draw(const Matrix3& transformationMatrix, Camera2D&) {
+    _batch.add(transformationMatrix, _rectangle, _textureCoordinates, _color, _page, _layer);
+}
+
+}}
@@ -0,0 +1,351 @@
+#ifndef Magnum_SceneGraph_SpriteBatch_h
+#define Magnum_SceneGraph_SpriteBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpriteBatch, @ref Magnum::SceneGraph::Sprite
+ */
+
+#include <functional>
+#include <vector>
+
+#include "Magnum/Attribute.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Sprite batch
+
+Collects textured and colored quads of a 2D scene and draws them with a few
+draw calls instead of one draw call per sprite. The quads are transformed on
+the CPU, sorted by texture page and streamed through a @ref RingBuffer, so
+all sprites using the same page are drawn at once.
+
+## Usage
+
+Add a @ref Sprite feature to each object instead of a custom drawable, draw
+the group with the camera, which only puts the sprites into the batch, and
+then draw the batch. The vertex data contain @ref Position,
+@ref TextureCoordinates and @ref Color attributes at the generic locations,
+so for example @ref Shaders::Flat2D with @ref Shaders::Flat2D::Flag::Textured
+and @ref Shaders::Flat2D::Flag::InstancedColor can be used to draw them. The
+page binding function is called before drawing each run of sprites with
+the same page:
+@code
+RingBuffer ring{16*1024*1024};
+SceneGraph::SpriteBatch batch{ring};
+Shaders::Flat2D shader{Shaders::Flat2D::Flag::Textured|Shaders::Flat2D::Flag::InstancedColor};
+Texture2D pages[2];
+
+SceneGraph::DrawableGroup2D sprites;
+(new SceneGraph::Sprite{ship, batch, &sprites})
+    ->setRectangle({{-16.0f, -16.0f}, {16.0f, 16.0f}})
+    .setTextureCoordinates(shipTextureCoordinates)
+    .setPage(1);
+
+// each frame
+camera.draw(sprites);
+shader.setTransformationProjectionMatrix(camera.projectionMatrix());
+batch.draw(shader, [&](UnsignedInt page) { shader.setTexture(pages[page]); });
+ring.fence();
+@endcode
+
+## Sprite sheets
+
+Images of individual sprites are usually packed into larger textures using
+@ref TextureTools::AtlasPacker. If a page gets full, a new packer and texture
+is created for the next page. Use @ref textureCoordinates() to convert the
+packed rectangles to texture coordinates:
+@code
+TextureTools::AtlasPacker packer{{2048, 2048}, Vector2i{1}};
+std::optional<Range2Di> rectangle = packer.add(image.size());
+Range2D textureCoordinates = SceneGraph::SpriteBatch::textureCoordinates(*rectangle, packer.size());
+@endcode
+
+@anchor SceneGraph-SpriteBatch-ordering
+## Ordering
+
+Sprites are drawn ordered by layer set via @ref Sprite::setLayer() and then
+by page, sprites with the same layer and page are drawn in the order they
+were added. Sprites with the same layer but different pages might be thus
+reordered, put sprites that need to be blended in a particular order to
+different layers.
+
+All sprites added between two calls to @ref draw() need to fit into the
+ring buffer. If there are more sprites than @ref capacity(), they are drawn
+in multiple chunks.
+@see @ref scenegraph
+*/
+class MAGNUM_SCENEGRAPH_EXPORT SpriteBatch {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref Vector2, same as @ref Shaders::Generic2D::Position.
+         */
+        typedef Attribute<0, Vector2> Position;
+
+        /**
+         * @brief Texture coordinates
+         *
+         * @ref Vector2, same as @ref Shaders::Generic2D::TextureCoordinates.
+         */
+        typedef Attribute<1, Vector2> TextureCoordinates;
+
+        /**
+         * @brief Vertex color
+         *
+         * @ref Color4, same location as @ref Shaders::Generic2D::Color.
+         * Stored as normalized @ref Color4ub.
+         */
+        typedef Attribute<3, Color4> Color;
+
+        /**
+         * @brief Page binding function
+         *
+         * Called with page index before drawing sprites using that page.
+         * @see @ref draw()
+         */
+        typedef std::function<void(UnsignedInt)> BindPageFunction;
+
+        /**
+         * @brief Texture coordinates of a rectangle in a texture
+         *
+         * Converts pixel rectangle, for example returned from
+         * @ref TextureTools::AtlasPacker::add(), to texture coordinates.
+         */
+        static Range2D textureCoordinates(const Range2Di& rectangle, const Vector2i& textureSize);
+
+        /**
+         * @brief Constructor
+         * @param ring      Ring buffer from which the vertex data are
+         *      allocated
+         * @param capacity  Max count of sprites drawn at once
+         *
+         * Creates an index buffer for @p capacity quads. If there's more
+         * than 65536 vertices, @ref Mesh::IndexType::UnsignedInt is used.
+         */
+        explicit SpriteBatch(RingBuffer& ring, UnsignedInt capacity = 16384);
+
+        /** @brief Copying is not allowed */
+        SpriteBatch(const SpriteBatch&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpriteBatch(SpriteBatch&&) = delete;
+
+        ~SpriteBatch();
+
+        /** @brief Copying is not allowed */
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpriteBatch& operator=(SpriteBatch&&) = delete;
+
+        /** @brief Max count of sprites drawn at once */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Count of sprites added since last @ref draw() */
+        std::size_t spriteCount() const { return _keys.size(); }
+
+        /**
+         * @brief Count of draw calls done in last @ref draw()
+         *
+         * One draw call is done for each run of sprites with the same page
+         * in each chunk of @ref capacity() sprites.
+         */
+        UnsignedInt drawCallCount() const { return _drawCallCount; }
+
+        /**
+         * @brief Add sprite
+         * @param transformationMatrix  Sprite transformation, usually
+         *      relative to camera
+         * @param rectangle             Quad in sprite local coordinates
+         * @param textureCoordinates    Texture coordinates of the quad
+         * @param color                 Quad color
+         * @param page                  Texture page
+         * @param layer                 Layer
+         * @return Reference to self (for method chaining)
+         *
+         * Transforms the quad corners and stores them until next
+         * @ref draw(). See @ref SceneGraph-SpriteBatch-ordering "class documentation"
+         * for information about @p layer.
+         */
+        SpriteBatch& add(const Matrix3& transformationMatrix, const Range2D& rectangle, const Range2D& textureCoordinates, const Color4ub& color = Color4ub{255}, UnsignedInt page = 0, Int layer = 0);
+
+        /**
+         * @brief Draw the sprites
+         * @param shader    Shader to draw with
+         * @param bindPage  Page binding function
+         * @return Reference to self (for method chaining)
+         *
+         * Sorts the sprites added since last call, copies their vertices to
+         * the ring buffer, flushes it and draws them. Then removes all
+         * sprites from the batch. The ring buffer is not fenced, call
+         * @ref RingBuffer::fence() after all other drawing using it in
+         * current frame is submitted.
+         * @see @ref RingBuffer::flush()
+         */
+        SpriteBatch& draw(AbstractShaderProgram& shader, const BindPageFunction& bindPage);
+
+        /**
+         * @brief Remove all sprites
+         * @return Reference to self (for method chaining)
+         *
+         * Removes sprites added since last @ref draw() without drawing
+         * them.
+         */
+        SpriteBatch& clear();
+
+    private:
+        struct Vertex {
+            Vector2 position;
+            Vector2 textureCoordinates;
+            Color4ub color;
+        };
+
+        RingBuffer& _ring;
+        UnsignedInt _capacity;
+        Buffer _indices;
+        Mesh::IndexType _indexType;
+        UnsignedInt _drawCallCount;
+
+        /* Four vertices and a sort key (layer in upper half, page in lower
+           half) for each sprite */
+        std::vector<Vertex> _vertices;
+        std::vector<UnsignedLong> _keys;
+        std::vector<UnsignedInt> _order;
+};
+
+/**
+@brief Sprite
+
+Drawable that puts a textured and colored quad into a @ref SpriteBatch
+instead of drawing it directly. See @ref SpriteBatch for more information.
+@see @ref scenegraph
+*/
+class MAGNUM_SCENEGRAPH_EXPORT Sprite: public Drawable2D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this sprite belongs to
+         * @param batch     Batch to which the sprite is added when drawn
+         * @param drawables Group this sprite belongs to
+         *
+         * Creates a white sprite covering @f$ [-1, 1]^2 @f$ with whole
+         * texture of page `0` in layer `0`.
+         */
+        explicit Sprite(AbstractObject2D& object, SpriteBatch& batch, DrawableGroup2D* drawables = nullptr);
+
+        ~Sprite();
+
+        /** @brief Batch to which the sprite is added */
+        SpriteBatch& batch() { return _batch; }
+
+        /** @brief Quad in object local coordinates */
+        Range2D rectangle() const { return _rectangle; }
+
+        /**
+         * @brief Set quad in object local coordinates
+         * @return Reference to self (for method chaining)
+         */
+        Sprite& setRectangle(const Range2D& rectangle) {
+            _rectangle = rectangle;
+            return *this;
+        }
+
+        /** @brief Texture coordinates */
+        Range2D textureCoordinates() const { return _textureCoordinates; }
+
+        /**
+         * @brief Set texture coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref SpriteBatch::textureCoordinates()
+         */
+        Sprite& setTextureCoordinates(const Range2D& textureCoordinates) {
+            _textureCoordinates = textureCoordinates;
+            return *this;
+        }
+
+        /** @brief Color */
+        Color4ub color() const { return _color; }
+
+        /**
+         * @brief Set color
+         * @return Reference to self (for method chaining)
+         */
+        Sprite& setColor(const Color4ub& color) {
+            _color = color;
+            return *this;
+        }
+
+        /** @brief Texture page */
+        UnsignedInt page() const { return _page; }
+
+        /**
+         * @brief Set texture page
+         * @return Reference to self (for method chaining)
+         */
+        Sprite& setPage(UnsignedInt page) {
+            _page = page;
+            return *this;
+        }
+
+        /** @brief Layer */
+        Int layer() const { return _layer; }
+
+        /**
+         * @brief Set layer
+         * @return Reference to self (for method chaining)
+         *
+         * Sprites in lower layers are drawn first. See
+         * @ref SceneGraph-SpriteBatch-ordering "SpriteBatch documentation"
+         * for more information.
+         */
+        Sprite& setLayer(Int layer) {
+            _layer = layer;
+            return *this;
+        }
+
+    private:
+        void draw(const Matrix3& transformationMatrix, Camera2D& camera) override;
+
+        SpriteBatch& _batch;
+        Range2D _rectangle, _textureCoordinates;
+        Color4ub _color;
+        UnsignedInt _page;
+        Int _layer;
+};
+
+}}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AffineMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef Object<AffineMatrixTransformation3D> Object3D;
+typedef Scene<AffineMatrixTransformation3D> Scene3D;
+
+struct AffineMatrixTransformation3DTest: TestSuite::Tester {
+    explicit AffineMatrixTransformation3DTest();
+
+    void fromMatrix();
+    void toMatrix();
+    void compose();
+    void inverted();
+    void defaultConstructed();
+
+    void setTransformation();
+    void resetTransformation();
+    void transform();
+    void translate();
+    void rotate();
+    void scale();
+    void reflect();
+};
+
+AffineMatrixTransformation3DTest::AffineMatrixTransformation3DTest() {
+    addTests({&AffineMatrixTransformation3DTest::fromMatrix,
+              &AffineMatrixTransformation3DTest::toMatrix,
+              &AffineMatrixTransformation3DTest::compose,
+              &AffineMatrixTransformation3DTest::inverted,
+              &AffineMatrixTransformation3DTest::defaultConstructed,
+
+              &AffineMatrixTransformation3DTest::setTransformation,
+              &AffineMatrixTransformation3DTest::resetTransformation,
+              &AffineMatrixTransformation3DTest::transform,
+              &AffineMatrixTransformation3DTest::translate,
+              &AffineMatrixTransformation3DTest::rotate,
+              &AffineMatrixTransformation3DTest::scale,
+              &AffineMatrixTransformation3DTest::reflect});
+}
+
+void AffineMatrixTransformation3DTest::fromMatrix() {
+    std::ostringstream o;
+    Error redirectError{&o};
+    Implementation::Transformation<AffineMatrixTransformation3D>::fromMatrix(Matrix4::perspectiveProjection({2.0f, 2.0f}, 1.0f, 100.0f));
+    CORRADE_COMPARE(o.str(), "SceneGraph::AffineMatrixTransformation3D: the matrix doesn't represent affine transformation\n");
+
+    Matrix4 m = Matrix4::rotationX(Deg(17.0f))*Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::scaling({2.0f, 1.4f, -2.1f});
+    CORRADE_COMPARE(Matrix4x3{Implementation::Transformation<AffineMatrixTransformation3D>::fromMatrix(m)}, (Matrix4x3{m[0].xyz(), m[1].xyz(), m[2].xyz(), m[3].xyz()}));
+}
+
+void AffineMatrixTransformation3DTest::toMatrix() {
+    Matrix4 m = Matrix4::rotationX(Deg(17.0f))*Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::scaling({2.0f, 1.4f, -2.1f});
+    Matrix4x3 a{m[0].xyz(), m[1].xyz(), m[2].xyz(), m[3].xyz()};
+    CORRADE_COMPARE(Implementation::Transformation<AffineMatrixTransformation3D>::toMatrix(a), m);
+}
+
+void AffineMatrixTransformation3DTest::compose() {
+    typedef Implementation::Transformation<AffineMatrixTransformation3D> Transformation;
+    Matrix4 parent = Matrix4::rotationX(Deg(17.0f))*Matrix4::scaling({2.0f, 1.4f, -2.1f});
+    Matrix4 child = Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::rotationY(Deg(-35.0f));
+    CORRADE_COMPARE(Transformation::toMatrix(Transformation::compose(Transformation::fromMatrix(parent), Transformation::fromMatrix(child))), parent*child);
+}
+
+void AffineMatrixTransformation3DTest::inverted() {
+    typedef Implementation::Transformation<AffineMatrixTransformation3D> Transformation;
+    Matrix4 m = Matrix4::rotationX(Deg(17.0f))*Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::scaling({2.0f, 1.4f, -2.1f});
+    CORRADE_COMPARE(Transformation::toMatrix(Transformation::inverted(Transformation::fromMatrix(m))), m.inverted());
+    CORRADE_COMPARE(Transformation::invertedMatrix(m), m.inverted());
+}
+
+void AffineMatrixTransformation3DTest::defaultConstructed() {
+    /* Object expects default-constructed transformation to be identity */
+    CORRADE_COMPARE(Implementation::Transformation<AffineMatrixTransformation3D>::toMatrix(AffineMatrixTransformation3D::DataType{}), Matrix4());
+
+    Scene3D s;
+    Object3D o{&s};
+    o.translate({1.0f, -0.3f, 2.3f});
+    CORRADE_COMPARE(o.absoluteTransformationMatrix(), Matrix4::translation({1.0f, -0.3f, 2.3f}));
+}
+
+void AffineMatrixTransformation3DTest::setTransformation() {
+    Object3D o;
+
+    /* Can't set projective transformation */
+    std::ostringstream out;
+    Error redirectError{&out};
+    o.setTransformation(Matrix4::perspectiveProjection({2.0f, 2.0f}, 1.0f, 100.0f));
+    CORRADE_COMPARE(out.str(), "SceneGraph::AffineMatrixTransformation3D::setTransformation(): the matrix doesn't represent affine transformation\n");
+
+    /* Dirty after setting transformation */
+    o.setClean();
+    CORRADE_VERIFY(!o.isDirty());
+    o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+    CORRADE_VERIFY(o.isDirty());
+    CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f)));
+
+    /* Scene cannot be transformed */
+    Scene3D s;
+    s.setClean();
+    CORRADE_VERIFY(!s.isDirty());
+    s.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+    CORRADE_VERIFY(!s.isDirty());
+    CORRADE_COMPARE(s.transformationMatrix(), Matrix4());
+}
+
+void AffineMatrixTransformation3DTest::resetTransformation() {
+    Object3D o;
+    o.rotateX(Deg(17.0f));
+    CORRADE_VERIFY(o.transformationMatrix() != Matrix4());
+    o.resetTransformation();
+    CORRADE_COMPARE(o.transformationMatrix(), Matrix4());
+}
+
+void AffineMatrixTransformation3DTest::transform() {
+    {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.transform(Matrix4::translation({1.0f, -0.3f, 2.3f}));
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::rotationX(Deg(17.0f)));
+    } {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.transformLocal(Matrix4::translation({1.0f, -0.3f, 2.3f}));
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f))*Matrix4::translation({1.0f, -0.3f, 2.3f}));
+    }
+}
+
+void AffineMatrixTransformation3DTest::translate() {
+    {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.translate({1.0f, -0.3f, 2.3f});
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::translation({1.0f, -0.3f, 2.3f})*Matrix4::rotationX(Deg(17.0f)));
+    } {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.translateLocal({1.0f, -0.3f, 2.3f});
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f))*Matrix4::translation({1.0f, -0.3f, 2.3f}));
+    }
+}
+
+void AffineMatrixTransformation3DTest::rotate() {
+    {
+        Object3D o;
+        o.setTransformation(Matrix4::translation({1.0f, -0.3f, 2.3f}));
+        o.rotateX(Deg(17.0f))
+            .rotateY(Deg(25.0f))
+            .rotateZ(Deg(-23.0f))
+            .rotate(Deg(96.0f), Vector3(1.0f/Constants::sqrt3()));
+        CORRADE_COMPARE(o.transformationMatrix(),
+            Matrix4::rotation(Deg(96.0f), Vector3(1.0f/Constants::sqrt3()))*
+            Matrix4::rotationZ(Deg(-23.0f))*
+            Matrix4::rotationY(Deg(25.0f))*
+            Matrix4::rotationX(Deg(17.0f))*
+            Matrix4::translation({1.0f, -0.3f, 2.3f}));
+    } {
+        Object3D o;
+        o.setTransformation(Matrix4::translation({1.0f, -0.3f, 2.3f}));
+        o.rotateXLocal(Deg(17.0f))
+            .rotateYLocal(Deg(25.0f))
+            .rotateZLocal(Deg(-23.0f))
+            .rotateLocal(Deg(96.0f), Vector3(1.0f/Constants::sqrt3()));
+        CORRADE_COMPARE(o.transformationMatrix(),
+            Matrix4::translation({1.0f, -0.3f, 2.3f})*
+            Matrix4::rotationX(Deg(17.0f))*
+            Matrix4::rotationY(Deg(25.0f))*
+            Matrix4::rotationZ(Deg(-23.0f))*
+            Matrix4::rotation(Deg(96.0f), Vector3(1.0f/Constants::sqrt3())));
+    }
+}
+
+void AffineMatrixTransformation3DTest::scale() {
+    {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.scale({1.0f, -0.3f, 2.3f});
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::scaling({1.0f, -0.3f, 2.3f})*Matrix4::rotationX(Deg(17.0f)));
+    } {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.scaleLocal({1.0f, -0.3f, 2.3f});
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f))*Matrix4::scaling({1.0f, -0.3f, 2.3f}));
+    }
+}
+
+void AffineMatrixTransformation3DTest::reflect() {
+    {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.reflect(Vector3(-1.0f/Constants::sqrt3()));
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::reflection(Vector3(-1.0f/Constants::sqrt3()))*Matrix4::rotationX(Deg(17.0f)));
+    } {
+        Object3D o;
+        o.setTransformation(Matrix4::rotationX(Deg(17.0f)));
+        o.reflectLocal(Vector3(-1.0f/Constants::sqrt3()));
+        CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f))*Matrix4::reflection(Vector3(-1.0f/Constants::sqrt3())));
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AffineMatrixTransformation3DTest)
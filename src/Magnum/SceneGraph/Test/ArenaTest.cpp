@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct ArenaTest: TestSuite::Tester {
+    explicit ArenaTest();
+
+    void create();
+    void blocks();
+    void destroyHierarchy();
+    void destroyReparented();
+    void clear();
+    void sceneArena();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class CountedObject: public Object3D {
+    public:
+        explicit CountedObject(Object3D* parent, Int& counter): Object3D{parent}, _counter(counter) {}
+        ~CountedObject() { ++_counter; }
+
+    private:
+        Int& _counter;
+};
+
+class CountedFeature: public AbstractFeature3D {
+    public:
+        explicit CountedFeature(AbstractObject3D& object, Int& counter): AbstractFeature3D{object}, _counter(counter) {}
+        ~CountedFeature() { ++_counter; }
+
+    private:
+        Int& _counter;
+};
+
+ArenaTest::ArenaTest() {
+    addTests({&ArenaTest::create,
+              &ArenaTest::blocks,
+              &ArenaTest::destroyHierarchy,
+              &ArenaTest::destroyReparented,
+              &ArenaTest::clear,
+              &ArenaTest::sceneArena});
+}
+
+void ArenaTest::create() {
+    Scene3D scene;
+    Int objects = 0, features = 0;
+    {
+        Arena arena;
+        Object3D& a = arena.create<CountedObject>(&scene, objects);
+        Object3D& b = arena.create<CountedObject>(&a, objects);
+        arena.create<CountedFeature>(b, features);
+
+        CORRADE_COMPARE(arena.size(), 3);
+        CORRADE_VERIFY(b.parent() == &a);
+        CORRADE_VERIFY(a.parent() == &scene);
+        CORRADE_VERIFY(!b.features().isEmpty());
+    }
+
+    /* Everything is destroyed and detached from the scene */
+    CORRADE_COMPARE(objects, 2);
+    CORRADE_COMPARE(features, 1);
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void ArenaTest::blocks() {
+    Arena arena{sizeof(Object3D)*3};
+    CORRADE_COMPARE(arena.blockCount(), 0);
+
+    Object3D& a = arena.create<Object3D>();
+    CORRADE_COMPARE(arena.blockCount(), 1);
+
+    /* Neighbors in the same block */
+    Object3D& b = arena.create<Object3D>();
+    CORRADE_COMPARE(arena.blockCount(), 1);
+    CORRADE_COMPARE(std::size_t(reinterpret_cast<char*>(&b) - reinterpret_cast<char*>(&a)), sizeof(Object3D));
+
+    arena.create<Object3D>();
+    arena.create<Object3D>();
+    CORRADE_COMPARE(arena.blockCount(), 2);
+    CORRADE_COMPARE(arena.size(), 4);
+}
+
+void ArenaTest::destroyHierarchy() {
+    Int objects = 0, features = 0;
+    {
+        Scene3D scene;
+        Arena arena;
+        Object3D& a = arena.create<Object3D>(&scene);
+
+        /* Heap-allocated child and feature of arena object are deleted by it */
+        new CountedObject{&a, objects};
+        new CountedFeature{a, features};
+
+        /* Arena-allocated child and feature of heap object are detached
+           before the heap object gets deleted */
+        Object3D* heap = new Object3D{&scene};
+        arena.create<CountedObject>(heap, objects);
+        arena.create<CountedFeature>(*heap, features);
+    }
+
+    CORRADE_COMPARE(objects, 2);
+    CORRADE_COMPARE(features, 2);
+}
+
+void ArenaTest::destroyReparented() {
+    Int objects = 0;
+    {
+        Scene3D scene;
+        Arena arena;
+
+        /* Child created before the parent, would be deleted by it if it
+           wasn't detached first */
+        Object3D& child = arena.create<CountedObject>(&scene, objects);
+        Object3D& parent = arena.create<CountedObject>(&scene, objects);
+        child.setParent(&parent);
+    }
+
+    CORRADE_COMPARE(objects, 2);
+}
+
+void ArenaTest::clear() {
+    Scene3D scene;
+    Int objects = 0;
+    Arena arena{sizeof(CountedObject)};
+
+    for(std::size_t i = 0; i != 5; ++i)
+        arena.create<CountedObject>(&scene, objects);
+    CORRADE_COMPARE(arena.blockCount(), 5);
+
+    arena.clear();
+    CORRADE_COMPARE(objects, 5);
+    CORRADE_COMPARE(arena.size(), 0);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+    CORRADE_VERIFY(scene.children().isEmpty());
+
+    /* The remaining block is reused */
+    arena.create<CountedObject>(&scene, objects);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+}
+
+void ArenaTest::sceneArena() {
+    Int objects = 0, features = 0;
+    {
+        Scene3D scene;
+        Object3D& a = scene.arena().create<CountedObject>(&scene, objects);
+        scene.arena().create<CountedFeature>(a, features);
+
+        /* Heap-allocated sibling is deleted by the scene afterwards */
+        new CountedObject{&scene, objects};
+        CORRADE_COMPARE(scene.arena().size(), 2);
+    }
+
+    CORRADE_COMPARE(objects, 2);
+    CORRADE_COMPARE(features, 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ArenaTest)
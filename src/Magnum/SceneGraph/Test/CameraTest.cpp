@@ -46,10 +46,14 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizePerspective();
     void projectionSizeViewport();
     void draw();
+    void drawCulled();
+    void drawCulled2D();
+    void drawableTransformationMatrices();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -61,7 +65,10 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawCulled,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawableTransformationMatrices});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -210,6 +217,173 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+void CameraTest::drawCulled() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<std::pair<Int, Matrix4>>& result, Int id): SceneGraph::Drawable3D(object, group), result(result), id(id) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result.emplace_back(id, transformationMatrix);
+            }
+
+        private:
+            std::vector<std::pair<Int, Matrix4>>& result;
+            Int id;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<std::pair<Int, Matrix4>> drawn;
+
+    /* In front of the camera */
+    Object3D first(&scene);
+    first.translate(Vector3::zAxis(-5.0f));
+    (new Drawable(first, &group, drawn, 0))->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera */
+    Object3D second(&scene);
+    second.translate(Vector3::zAxis(5.0f));
+    (new Drawable(second, &group, drawn, 1))->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera, but without bounding sphere, so not culled */
+    Object3D third(&scene);
+    third.translate(Vector3::zAxis(5.0f));
+    new Drawable(third, &group, drawn, 2);
+
+    /* Far to the left with the center outside, but scaled so it intersects
+       the frustum */
+    Object3D fourth(&scene);
+    fourth.scale(Vector3(3.0f))
+        .translate({-7.0f, 0.0f, -5.0f});
+    (new Drawable(fourth, &group, drawn, 3))->setBoundingSphere({}, 1.0f);
+
+    /* Far to the right, completely outside */
+    Object3D fifth(&scene);
+    fifth.translate({7.0f, 0.0f, -5.0f});
+    (new Drawable(fifth, &group, drawn, 4))->setBoundingSphere({}, 1.0f);
+
+    /* Camera at origin looking to -Z, 90 degree FoV */
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    std::pair<std::size_t, std::size_t> stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 3);
+    CORRADE_COMPARE(stats.second, 2);
+    CORRADE_COMPARE(drawn.size(), 3);
+    CORRADE_COMPARE(drawn[0].first, 0);
+    CORRADE_COMPARE(drawn[0].second, Matrix4::translation(Vector3::zAxis(-5.0f)));
+    CORRADE_COMPARE(drawn[1].first, 2);
+    CORRADE_COMPARE(drawn[1].second, Matrix4::translation(Vector3::zAxis(5.0f)));
+    CORRADE_COMPARE(drawn[2].first, 3);
+    CORRADE_COMPARE(drawn[2].second, Matrix4::translation({-7.0f, 0.0f, -5.0f})*Matrix4::scaling(Vector3(3.0f)));
+
+    /* Turn the camera around, the cached transformations are updated */
+    drawn.clear();
+    cameraObject.rotateY(Deg(180.0f));
+    fourth.translate(Vector3::zAxis(10.0f));
+    stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 3);
+    CORRADE_COMPARE(stats.second, 2);
+    CORRADE_COMPARE(drawn.size(), 3);
+    CORRADE_COMPARE(drawn[0].first, 1);
+    CORRADE_COMPARE(drawn[1].first, 2);
+    CORRADE_COMPARE(drawn[2].first, 3);
+    CORRADE_COMPARE(drawn[2].second, Matrix4::rotationY(Deg(180.0f))*Matrix4::translation({-7.0f, 0.0f, 5.0f})*Matrix4::scaling(Vector3(3.0f)));
+}
+
+void CameraTest::drawCulled2D() {
+    class Drawable: public SceneGraph::Drawable2D {
+        public:
+            Drawable(AbstractObject2D& object, DrawableGroup2D* group, Int& count): SceneGraph::Drawable2D(object, group), count(count) {}
+
+        protected:
+            void draw(const Matrix3&, Camera2D&) override { ++count; }
+
+        private:
+            Int& count;
+    };
+
+    DrawableGroup2D group;
+    Scene2D scene;
+    Int count = 0;
+
+    Object2D first(&scene);
+    first.translate({0.5f, 0.5f});
+    (new Drawable(first, &group, count))->setBoundingSphere({}, 0.25f);
+
+    Object2D second(&scene);
+    second.translate({3.0f, 0.0f});
+    (new Drawable(second, &group, count))->setBoundingSphere({}, 0.25f);
+
+    /* Bounding sphere center is offset into the view */
+    Object2D third(&scene);
+    third.translate({0.0f, -3.0f});
+    auto thirdDrawable = new Drawable(third, &group, count);
+    thirdDrawable->setBoundingSphere({0.0f, 2.5f}, 0.25f);
+    CORRADE_VERIFY(thirdDrawable->hasBoundingSphere());
+    CORRADE_COMPARE(thirdDrawable->boundingSphereCenter(), Vector2(0.0f, 2.5f));
+    CORRADE_COMPARE(thirdDrawable->boundingSphereRadius(), 0.25f);
+
+    Object2D cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix3::projection({2.0f, 2.0f}));
+
+    std::pair<std::size_t, std::size_t> stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 2);
+    CORRADE_COMPARE(stats.second, 1);
+    CORRADE_COMPARE(count, 2);
+
+    /* Removing the bounding sphere disables culling */
+    count = 0;
+    thirdDrawable->setBoundingSphere({}, -1.0f);
+    CORRADE_VERIFY(!thirdDrawable->hasBoundingSphere());
+    stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 2);
+    CORRADE_COMPARE(stats.second, 1);
+    CORRADE_COMPARE(count, 2);
+}
+
+void CameraTest::drawableTransformationMatrices() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Int& count): SceneGraph::Drawable3D(object, group), count(count) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override { ++count; }
+
+        private:
+            Int& count;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    Int count = 0;
+
+    Object3D first(&scene);
+    first.scale(Vector3(5.0f));
+    new Drawable(first, &group, count);
+
+    Object3D second(&scene);
+    second.translate(Vector3::yAxis(3.0f));
+    new Drawable(second, &group, count);
+
+    Object3D third(&second);
+    third.translate(Vector3::zAxis(-1.5f));
+    new Drawable(third, &group, count);
+
+    /* Same as in draw() above, but drawables are not called */
+    Camera3D camera(third);
+    std::vector<Matrix4> transformations;
+    camera.drawableTransformationMatrices(group, transformations);
+    CORRADE_COMPARE(count, 0);
+    CORRADE_COMPARE(transformations.size(), 3);
+    CORRADE_COMPARE(transformations[0], Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(transformations[1], Matrix4::translation(Vector3::zAxis(1.5f)));
+    CORRADE_COMPARE(transformations[2], Matrix4());
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct FeatureGroupTest: TestSuite::Tester {
+    explicit FeatureGroupTest();
+
+    void add();
+    void remove();
+    void removeOrdered();
+    void removeMultiple();
+    void removeMultipleOrdered();
+    void moveToAnotherGroup();
+    void destruct();
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+class Feature: public SceneGraph::AbstractGroupedFeature3D<Feature> {
+    public:
+        explicit Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group = nullptr): SceneGraph::AbstractGroupedFeature3D<Feature>{object, group} {}
+};
+
+typedef FeatureGroup3D<Feature> Group;
+
+FeatureGroupTest::FeatureGroupTest() {
+    addTests({&FeatureGroupTest::add,
+              &FeatureGroupTest::remove,
+              &FeatureGroupTest::removeOrdered,
+              &FeatureGroupTest::removeMultiple,
+              &FeatureGroupTest::removeMultipleOrdered,
+              &FeatureGroupTest::moveToAnotherGroup,
+              &FeatureGroupTest::destruct});
+}
+
+void FeatureGroupTest::add() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+
+    Feature a{object, &group};
+    Feature b{object};
+    Feature c{object};
+    group.add({b, c});
+
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &b);
+    CORRADE_VERIFY(&group[2] == &c);
+    CORRADE_VERIFY(c.group() == &group);
+}
+
+void FeatureGroupTest::remove() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+    CORRADE_VERIFY(!group.isOrdered());
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+
+    /* Last feature is moved in place of the removed one */
+    group.remove(b);
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_VERIFY(!b.group());
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &d);
+    CORRADE_VERIFY(&group[2] == &c);
+
+    /* Index of the moved feature is updated */
+    group.remove(d);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &c);
+
+    /* Removing the last one */
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(&group[0] == &a);
+}
+
+void FeatureGroupTest::removeOrdered() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+    group.setOrdered(true);
+    CORRADE_VERIFY(group.isOrdered());
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+
+    group.remove(b);
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &c);
+    CORRADE_VERIFY(&group[2] == &d);
+
+    /* Indices of the shifted features are updated */
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &d);
+}
+
+void FeatureGroupTest::removeMultiple() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+    Feature e{object, &group};
+
+    group.remove({b, e, a});
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(!a.group());
+    CORRADE_VERIFY(!b.group());
+    CORRADE_VERIFY(!e.group());
+    CORRADE_VERIFY((&group[0] == &c && &group[1] == &d) ||
+                   (&group[0] == &d && &group[1] == &c));
+
+    /* Indices are consistent after that */
+    group.remove(group[0]);
+    group.remove(group[0]);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+void FeatureGroupTest::removeMultipleOrdered() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+    group.setOrdered(true);
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+    Feature e{object, &group};
+
+    group.remove({d, b});
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_VERIFY(!b.group());
+    CORRADE_VERIFY(!d.group());
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &c);
+    CORRADE_VERIFY(&group[2] == &e);
+
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(&group[0] == &a);
+    CORRADE_VERIFY(&group[1] == &e);
+}
+
+void FeatureGroupTest::moveToAnotherGroup() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group1, group2;
+
+    Feature a{object, &group1};
+    Feature b{object, &group1};
+    Feature c{object, &group2};
+
+    group2.add(a);
+    CORRADE_VERIFY(a.group() == &group2);
+    CORRADE_COMPARE(group1.size(), 1);
+    CORRADE_VERIFY(&group1[0] == &b);
+    CORRADE_COMPARE(group2.size(), 2);
+    CORRADE_VERIFY(&group2[1] == &a);
+
+    group2.remove(a);
+    CORRADE_COMPARE(group2.size(), 1);
+    CORRADE_VERIFY(&group2[0] == &c);
+}
+
+void FeatureGroupTest::destruct() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Group group;
+
+    Feature a{object, &group};
+    {
+        Feature b{object, &group};
+        Feature c{object, &group};
+    }
+
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(&group[0] == &a);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FeatureGroupTest)
@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct FlatSceneTest: TestSuite::Tester {
+    explicit FlatSceneTest();
+
+    void add();
+    void addInvalidParent();
+    void addBulk();
+    void addBulkInvalid();
+
+    void matrix();
+    void dualQuaternion();
+    void translation();
+
+    void dirty();
+    void absoluteTransformationDirty();
+
+    private:
+        template<class T> void compareWithObjects(const typename T::DataType& a, const typename T::DataType& b, const typename T::DataType& c);
+};
+
+typedef FlatScene<MatrixTransformation3D> FlatScene3D;
+
+FlatSceneTest::FlatSceneTest() {
+    addTests({&FlatSceneTest::add,
+              &FlatSceneTest::addInvalidParent,
+              &FlatSceneTest::addBulk,
+              &FlatSceneTest::addBulkInvalid,
+
+              &FlatSceneTest::matrix,
+              &FlatSceneTest::dualQuaternion,
+              &FlatSceneTest::translation,
+
+              &FlatSceneTest::dirty,
+              &FlatSceneTest::absoluteTransformationDirty});
+}
+
+void FlatSceneTest::add() {
+    FlatScene3D scene;
+    CORRADE_VERIFY(!scene.isDirty());
+
+    CORRADE_COMPARE(scene.add(), 0);
+    CORRADE_COMPARE(scene.add(0, Matrix4::translation(Vector3::xAxis())), 1);
+    CORRADE_COMPARE(scene.add(-1), 2);
+    CORRADE_COMPARE(scene.size(), 3);
+    CORRADE_VERIFY(scene.isDirty());
+
+    CORRADE_COMPARE(scene.parent(0), -1);
+    CORRADE_COMPARE(scene.parent(1), 0);
+    CORRADE_COMPARE(scene.parent(2), -1);
+    CORRADE_COMPARE(scene.parents().size(), 3);
+    CORRADE_COMPARE(scene.parents()[1], 0);
+    CORRADE_COMPARE(scene.transformation(1), Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(scene.transformations().size(), 3);
+}
+
+void FlatSceneTest::addInvalidParent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FlatScene3D scene;
+    scene.add();
+    scene.add(1);
+    CORRADE_COMPARE(scene.size(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatScene::add(): parent 1 out of range for 1 objects\n");
+}
+
+void FlatSceneTest::addBulk() {
+    FlatScene<DualQuaternionTransformation> scene;
+    scene.add();
+    scene.setClean();
+
+    const Int parents[]{-1, 0, 0, -1};
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::xAxis()),
+        Matrix4::rotationZ(Deg(90.0f)),
+        Matrix4::translation(Vector3::yAxis()),
+        Matrix4::translation(Vector3::zAxis())
+    };
+    CORRADE_COMPARE(scene.add(parents, transformations, 0), 1);
+    CORRADE_COMPARE(scene.size(), 5);
+    CORRADE_VERIFY(scene.isDirty());
+    CORRADE_VERIFY(!scene.isDirty(0));
+    CORRADE_VERIFY(scene.isDirty(4));
+
+    /* Parents are shifted by the offset, top-level ones get attached to the
+       specified parent */
+    CORRADE_COMPARE(scene.parent(1), 0);
+    CORRADE_COMPARE(scene.parent(2), 1);
+    CORRADE_COMPARE(scene.parent(3), 1);
+    CORRADE_COMPARE(scene.parent(4), 0);
+    CORRADE_COMPARE(scene.transformation(2), DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis()));
+
+    scene.setClean();
+    CORRADE_COMPARE(scene.absoluteTransformationMatrix(3), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
+void FlatSceneTest::addBulkInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FlatScene3D scene;
+    const Int parents[]{-1, 1};
+    const Matrix4 transformations[2];
+    scene.add(parents, {transformations, 1});
+    scene.add(parents, transformations, 0);
+    scene.add(parents, transformations);
+    CORRADE_COMPARE(scene.size(), 0);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::add(): expected the same count of parents and transformations but got 2 and 1\n"
+        "SceneGraph::FlatScene::add(): parent 0 out of range for 0 objects\n"
+        "SceneGraph::FlatScene::add(): parent 1 of object 1 doesn't precede it\n");
+}
+
+/* Builds the same hierarchy as Object instances and as FlatScene, verifying
+   that both give the same absolute transformations */
+template<class T> void FlatSceneTest::compareWithObjects(const typename T::DataType& a, const typename T::DataType& b, const typename T::DataType& c) {
+    Scene<T> scene;
+    Object<T> o0{&scene};
+    o0.setTransformation(a);
+    Object<T> o1{&o0};
+    o1.setTransformation(b);
+    Object<T> o2{&o1};
+    o2.setTransformation(c);
+    Object<T> o3{&o0};
+    o3.setTransformation(c);
+    Object<T> o4{&scene};
+    o4.setTransformation(b);
+
+    FlatScene<T> flat;
+    CORRADE_COMPARE_AS(flat.add(-1, a), 0, UnsignedInt);
+    flat.add(0, b);
+    flat.add(1, c);
+    flat.add(0, c);
+    flat.add(-1, b);
+    flat.setClean();
+    CORRADE_VERIFY(!flat.isDirty());
+
+    Object<T>* objects[]{&o0, &o1, &o2, &o3, &o4};
+    for(UnsignedInt i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(flat.absoluteTransformation(i), objects[i]->absoluteTransformation());
+        CORRADE_COMPARE(flat.absoluteTransformationMatrix(i), objects[i]->absoluteTransformationMatrix());
+    }
+
+    /* Changing the middle of the hierarchy updates only that subtree */
+    o1.setTransformation(a);
+    flat.setTransformation(1, a);
+    CORRADE_VERIFY(flat.isDirty(2));
+    CORRADE_VERIFY(!flat.isDirty(3));
+    flat.setClean();
+    for(UnsignedInt i = 0; i != 5; ++i)
+        CORRADE_COMPARE(flat.absoluteTransformations()[i], objects[i]->absoluteTransformation());
+}
+
+void FlatSceneTest::matrix() {
+    compareWithObjects<MatrixTransformation3D>(
+        Matrix4::translation({1.0f, 2.0f, 3.0f}),
+        Matrix4::rotationZ(Deg(35.0f))*Matrix4::scaling(Vector3{2.0f}),
+        Matrix4::rotationX(Deg(-15.0f))*Matrix4::translation({0.5f, 0.0f, -1.0f}));
+}
+
+void FlatSceneTest::dualQuaternion() {
+    compareWithObjects<DualQuaternionTransformation>(
+        DualQuaternion::translation({1.0f, 2.0f, 3.0f}),
+        DualQuaternion::rotation(Deg(35.0f), Vector3::zAxis()),
+        DualQuaternion::rotation(Deg(-15.0f), Vector3::xAxis())*DualQuaternion::translation({0.5f, 0.0f, -1.0f}));
+}
+
+void FlatSceneTest::translation() {
+    compareWithObjects<TranslationTransformation3D>(
+        {1.0f, 2.0f, 3.0f},
+        {-0.5f, 0.0f, 1.0f},
+        {0.0f, 3.0f, 0.25f});
+}
+
+void FlatSceneTest::dirty() {
+    FlatScene3D scene;
+    scene.add();
+    scene.add(0);
+    scene.add(-1);
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!scene.isDirty(1));
+
+    /* Dirty parent makes the child dirty as well, but not unrelated objects */
+    scene.setTransformation(0, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_VERIFY(scene.isDirty());
+    CORRADE_VERIFY(scene.isDirty(0));
+    CORRADE_VERIFY(scene.isDirty(1));
+    CORRADE_VERIFY(!scene.isDirty(2));
+
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!scene.isDirty(1));
+    CORRADE_COMPARE(scene.absoluteTransformation(1), Matrix4::translation(Vector3::yAxis()));
+}
+
+void FlatSceneTest::absoluteTransformationDirty() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FlatScene3D scene;
+    scene.add();
+    scene.absoluteTransformation(0);
+    scene.absoluteTransformationMatrix(0);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::absoluteTransformation(): object 0 is dirty\n"
+        "SceneGraph::FlatScene::absoluteTransformationMatrix(): object 0 is dirty\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatSceneTest)
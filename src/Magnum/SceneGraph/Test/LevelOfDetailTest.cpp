@@ -0,0 +1,249 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct LevelOfDetailTest: TestSuite::Tester {
+    explicit LevelOfDetailTest();
+
+    void screenSizePerspective();
+    void screenSizeOrthographic();
+    void screenSizeBehindCamera();
+    void screenSize2D();
+    void level();
+    void hysteresis();
+    void resetLevel();
+    void addLevelNotDecreasing();
+    void levelThresholdOutOfRange();
+    void invalidHysteresis();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+LevelOfDetailTest::LevelOfDetailTest() {
+    addTests({&LevelOfDetailTest::screenSizePerspective,
+              &LevelOfDetailTest::screenSizeOrthographic,
+              &LevelOfDetailTest::screenSizeBehindCamera,
+              &LevelOfDetailTest::screenSize2D,
+              &LevelOfDetailTest::level,
+              &LevelOfDetailTest::hysteresis,
+              &LevelOfDetailTest::resetLevel,
+              &LevelOfDetailTest::addLevelNotDecreasing,
+              &LevelOfDetailTest::levelThresholdOutOfRange,
+              &LevelOfDetailTest::invalidHysteresis});
+}
+
+using namespace Math::Literals;
+
+void LevelOfDetailTest::screenSizePerspective() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.setBoundingSphere({0.0f, 0.0f, 1.0f}, 1.0f);
+
+    /* Unit sphere ten units in front of the camera covers one tenth of the
+       screen height, scaling is taken into account */
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-11.0f)), camera), 0.1f);
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-12.0f))*Matrix4::scaling({1.0f, 3.0f, 2.0f}), camera), 0.3f);
+}
+
+void LevelOfDetailTest::screenSizeOrthographic() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({8.0f, 4.0f}, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.setBoundingSphere({}, 0.5f);
+
+    /* Independent on distance */
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-5.0f)), camera), 0.25f);
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-50.0f)), camera), 0.25f);
+}
+
+void LevelOfDetailTest::screenSizeBehindCamera() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.5f);
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(5.0f)), camera), Constants::inf());
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(5.0f)), camera), 0);
+}
+
+void LevelOfDetailTest::screenSize2D() {
+    Scene2D scene;
+    Object2D object{&scene};
+    Camera2D camera{object};
+    camera.setProjectionMatrix(Matrix3::projection({8.0f, 4.0f}));
+
+    LevelOfDetail2D lod{object};
+    lod.setBoundingSphere({}, 0.5f);
+    CORRADE_COMPARE(lod.screenSize(Matrix3::translation({1.0f, 2.0f})*Matrix3::scaling(Vector2{2.0f}), camera), 0.5f);
+}
+
+void LevelOfDetailTest::level() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.5f)
+       .addLevel(0.1f)
+       .addLevel(0.01f);
+    CORRADE_COMPARE(lod.levelCount(), 3);
+    CORRADE_COMPARE(lod.levelThreshold(1), 0.1f);
+    CORRADE_COMPARE(lod.currentLevel(), -1);
+
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-1.0f)), camera), 0);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-5.0f)), camera), 1);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-50.0f)), camera), 2);
+    CORRADE_COMPARE(lod.currentLevel(), 2);
+
+    /* Too small */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-200.0f)), camera), -1);
+    CORRADE_COMPARE(lod.currentLevel(), -1);
+
+    /* Back to the most detailed one */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-1.0f)), camera), 0);
+}
+
+void LevelOfDetailTest::hysteresis() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.setHysteresis(0.2f)
+       .addLevel(0.1f)
+       .addLevel(0.05f);
+    CORRADE_COMPARE(lod.hysteresis(), 0.2f);
+
+    /* Without previous level there's no hysteresis */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-9.0f)), camera), 0);
+
+    /* Slightly below threshold of level 0 (size 0.0952), stays */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-10.5f)), camera), 0);
+
+    /* Well below (size 0.0769), switches */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-13.0f)), camera), 1);
+
+    /* Slightly above (size 0.1053), stays */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-9.5f)), camera), 1);
+
+    /* Well above (size 0.125), switches */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-8.0f)), camera), 0);
+
+    /* Too small (size 0.0435), culled and needs to get to 0.06 to appear
+       again */
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-23.0f)), camera), -1);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-19.0f)), camera), -1);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-16.0f)), camera), 1);
+}
+
+void LevelOfDetailTest::resetLevel() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    LevelOfDetail3D lod{object};
+    lod.setHysteresis(0.2f)
+       .addLevel(0.1f)
+       .addLevel(0.05f);
+
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-13.0f)), camera), 1);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-9.5f)), camera), 1);
+
+    /* Hysteresis is not applied after reset */
+    lod.resetLevel();
+    CORRADE_COMPARE(lod.currentLevel(), -1);
+    CORRADE_COMPARE(lod.level(Matrix4::translation(Vector3::zAxis(-9.5f)), camera), 0);
+}
+
+void LevelOfDetailTest::addLevelNotDecreasing() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.5f)
+       .addLevel(0.5f);
+
+    CORRADE_COMPARE(lod.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): expected threshold smaller than 0.5 but got 0.5\n");
+}
+
+void LevelOfDetailTest::levelThresholdOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.5f);
+    lod.levelThreshold(1);
+
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::levelThreshold(): index 1 out of range for 1 levels\n");
+}
+
+void LevelOfDetailTest::invalidHysteresis() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail3D lod{object};
+    lod.setHysteresis(1.0f);
+
+    CORRADE_COMPARE(lod.hysteresis(), 0.0f);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::setHysteresis(): expected value in range [0, 1) but got 1\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LevelOfDetailTest)
@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/MultiViewCamera3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct MultiViewCamera3DTest: TestSuite::Tester {
+    explicit MultiViewCamera3DTest();
+
+    void addView();
+    void stereoViews();
+    void cubeMapViews();
+    void drawCulled();
+    void drawCulledNoViews();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+MultiViewCamera3DTest::MultiViewCamera3DTest() {
+    addTests({&MultiViewCamera3DTest::addView,
+              &MultiViewCamera3DTest::stereoViews,
+              &MultiViewCamera3DTest::cubeMapViews,
+              &MultiViewCamera3DTest::drawCulled,
+              &MultiViewCamera3DTest::drawCulledNoViews});
+}
+
+namespace {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<std::pair<Int, Matrix4>>& result, Int id): SceneGraph::Drawable3D(object, group), result(result), id(id) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result.emplace_back(id, transformationMatrix);
+            }
+
+        private:
+            std::vector<std::pair<Int, Matrix4>>& result;
+            Int id;
+    };
+}
+
+void MultiViewCamera3DTest::addView() {
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    MultiViewCamera3D camera(cameraObject);
+    CORRADE_COMPARE(camera.viewCount(), 0);
+    CORRADE_VERIFY(camera.viewProjectionMatrices().empty());
+
+    const Matrix4 view = Matrix4::rotationY(Deg(90.0f));
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 10.0f);
+    camera.addView({}, projection)
+        .addView(view, projection);
+    CORRADE_COMPARE(camera.viewCount(), 2);
+    CORRADE_COMPARE(camera.viewMatrix(0), Matrix4());
+    CORRADE_COMPARE(camera.viewMatrix(1), view);
+    CORRADE_COMPARE(camera.viewProjectionMatrix(0), projection);
+    CORRADE_COMPARE(camera.viewProjectionMatrix(1), projection*view);
+    CORRADE_COMPARE(camera.viewProjectionMatrices().size(), 2);
+    CORRADE_COMPARE(camera.viewProjectionMatrices()[1], projection*view);
+
+    camera.clearViews();
+    CORRADE_COMPARE(camera.viewCount(), 0);
+}
+
+void MultiViewCamera3DTest::stereoViews() {
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    MultiViewCamera3D camera(cameraObject);
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 10.0f);
+    camera.addView({}, {})
+        .setStereoViews(0.5f, projection);
+    CORRADE_COMPARE(camera.viewCount(), 2);
+    CORRADE_COMPARE(camera.projectionMatrix(), projection);
+
+    /* Left eye is on the left, so the world moves right relative to it */
+    CORRADE_COMPARE(camera.viewMatrix(0).transformPoint({}), Vector3::xAxis(0.25f));
+    CORRADE_COMPARE(camera.viewMatrix(1).transformPoint({}), Vector3::xAxis(-0.25f));
+    CORRADE_COMPARE(camera.viewProjectionMatrix(1), projection*Matrix4::translation(Vector3::xAxis(-0.25f)));
+}
+
+void MultiViewCamera3DTest::cubeMapViews() {
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    MultiViewCamera3D camera(cameraObject);
+
+    camera.setCubeMapViews(0.1f, 10.0f);
+    CORRADE_COMPARE(camera.viewCount(), 6);
+
+    /* Each view looks along its axis, which is -Z in the view space, with Y
+       going down for side faces */
+    CORRADE_COMPARE(camera.viewMatrix(0).transformVector(Vector3::xAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(0).transformVector(-Vector3::yAxis()), Vector3::yAxis());
+    CORRADE_COMPARE(camera.viewMatrix(1).transformVector(-Vector3::xAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(2).transformVector(Vector3::yAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(2).transformVector(Vector3::zAxis()), Vector3::yAxis());
+    CORRADE_COMPARE(camera.viewMatrix(3).transformVector(-Vector3::yAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(4).transformVector(Vector3::zAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(5).transformVector(-Vector3::zAxis()), -Vector3::zAxis());
+    CORRADE_COMPARE(camera.viewMatrix(5), Matrix4::rotationZ(Deg(180.0f)));
+
+    /* A point in the +X face center ends up in the center of the clip space */
+    const Vector3 clip = camera.viewProjectionMatrix(0).transformPoint(Vector3::xAxis(5.0f));
+    CORRADE_COMPARE(clip.xy(), Vector2());
+}
+
+void MultiViewCamera3DTest::drawCulled() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<std::pair<Int, Matrix4>> drawn;
+
+    /* In front of the camera */
+    Object3D first(&scene);
+    first.translate(Vector3::zAxis(-5.0f));
+    (new Drawable(first, &group, drawn, 0))->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera */
+    Object3D second(&scene);
+    second.translate(Vector3::zAxis(5.0f));
+    (new Drawable(second, &group, drawn, 1))->setBoundingSphere({}, 1.0f);
+
+    /* To the side, outside of both views */
+    Object3D third(&scene);
+    third.translate({7.0f, 0.0f, -5.0f});
+    (new Drawable(third, &group, drawn, 2))->setBoundingSphere({}, 1.0f);
+
+    /* Camera at origin with a view looking forward and a view looking
+       back, 90 degree FoV */
+    Object3D cameraObject(&scene);
+    MultiViewCamera3D camera(cameraObject);
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    camera.addView({}, projection)
+        .addView(Matrix4::rotationY(Deg(180.0f)), projection);
+
+    /* The transformations are relative to the camera object, not to the
+       views */
+    std::pair<std::size_t, std::size_t> stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 2);
+    CORRADE_COMPARE(stats.second, 1);
+    CORRADE_COMPARE(drawn.size(), 2);
+    CORRADE_COMPARE(drawn[0].first, 0);
+    CORRADE_COMPARE(drawn[0].second, Matrix4::translation(Vector3::zAxis(-5.0f)));
+    CORRADE_COMPARE(drawn[1].first, 1);
+    CORRADE_COMPARE(drawn[1].second, Matrix4::translation(Vector3::zAxis(5.0f)));
+}
+
+void MultiViewCamera3DTest::drawCulledNoViews() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<std::pair<Int, Matrix4>> drawn;
+
+    Object3D first(&scene);
+    first.translate(Vector3::zAxis(-5.0f));
+    (new Drawable(first, &group, drawn, 0))->setBoundingSphere({}, 1.0f);
+
+    Object3D second(&scene);
+    second.translate(Vector3::zAxis(5.0f));
+    (new Drawable(second, &group, drawn, 1))->setBoundingSphere({}, 1.0f);
+
+    /* Without views the projection matrix is used, same as in Camera */
+    Object3D cameraObject(&scene);
+    MultiViewCamera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    std::pair<std::size_t, std::size_t> stats = camera.drawCulled(group);
+    CORRADE_COMPARE(stats.first, 1);
+    CORRADE_COMPARE(stats.second, 1);
+    CORRADE_COMPARE(drawn.size(), 1);
+    CORRADE_COMPARE(drawn[0].first, 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::MultiViewCamera3DTest)
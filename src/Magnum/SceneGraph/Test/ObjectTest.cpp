@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -45,9 +46,17 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsIntoVector();
+    void transformationsParallel();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanListParallel();
+    void setCleanInvertedRigid();
+    void setDirtyDeep();
+    void setDirtyList();
+    void dirtyGeneration();
+    void featureNotification();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -82,9 +91,17 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsIntoVector,
+              &ObjectTest::transformationsParallel,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListParallel,
+              &ObjectTest::setCleanInvertedRigid,
+              &ObjectTest::setDirtyDeep,
+              &ObjectTest::setDirtyList,
+              &ObjectTest::dirtyGeneration,
+              &ObjectTest::featureNotification,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
@@ -304,6 +321,73 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsIntoVector() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    Matrix4 secondExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f));
+    Matrix4 thirdExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f));
+
+    /* Previous contents are overwritten */
+    std::vector<Matrix4> out{Matrix4{Math::ZeroInit}, Matrix4{Math::ZeroInit}, Matrix4{Math::ZeroInit}};
+    s.transformations({second, third}, out, initial);
+    CORRADE_COMPARE(out, (std::vector<Matrix4>{secondExpected, thirdExpected}));
+
+    /* Memory is reused for subsequent calls */
+    const Matrix4* data = out.data();
+    s.transformationMatrices({third, second}, out, initial);
+    CORRADE_COMPARE(out, (std::vector<Matrix4>{thirdExpected, secondExpected}));
+    CORRADE_VERIFY(out.data() == data);
+
+    /* Type-erased variant */
+    const AbstractObject3D& abstractScene = s;
+    abstractScene.transformationMatrices({second, s}, out, initial);
+    CORRADE_COMPARE(out, (std::vector<Matrix4>{secondExpected, initial}));
+    CORRADE_VERIFY(out.data() == data);
+}
+
+void ObjectTest::transformationsParallel() {
+    /* Many independent subtrees, so each level of the joint hierarchy is
+       large enough to be distributed across more threads */
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(Int i = 0; i != 1000; ++i) {
+        Object3D* root = new Object3D{&scene};
+        root->translate(Vector3::xAxis(Float(i)));
+        Object3D* a = new Object3D{root};
+        a->rotateY(Deg(Float(i)));
+        Object3D* b = new Object3D{a};
+        b->scale(Vector3{2.0f});
+        Object3D* c = new Object3D{a};
+        c->translate(Vector3::zAxis(-1.0f));
+        Object3D* d = new Object3D{c};
+        d->rotateX(Deg(-Float(i)));
+
+        /* Path from d to a goes through non-joint c, b is there twice */
+        objects.push_back(*b);
+        objects.push_back(*d);
+        if(i % 3 == 0) objects.push_back(*b);
+    }
+
+    std::vector<Matrix4> expected, actual;
+    scene.transformations(objects, expected);
+    scene.transformations(objects, actual, Matrix4{}, 4);
+    CORRADE_COMPARE(actual.size(), objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        CORRADE_COMPARE(actual[i], expected[i]);
+
+    /* Hardware thread count */
+    scene.transformations(objects, actual, Matrix4{}, 0);
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        CORRADE_COMPARE(actual[i], objects[i].get().absoluteTransformation());
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -484,6 +568,202 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanListParallel() {
+    Scene3D scene;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::vector<CachingObject*> leaves;
+    for(Int i = 0; i != 1000; ++i) {
+        Object3D* root = new Object3D{&scene};
+        root->translate(Vector3::xAxis(Float(i)));
+        CachingObject* a = new CachingObject{root};
+        a->rotateY(Deg(Float(i)));
+        CachingObject* b = new CachingObject{a};
+        b->scale(Vector3{2.0f});
+        leaves.push_back(b);
+
+        /* Parents are added implicitly, a is there twice */
+        objects.push_back(*b);
+        if(i % 2 == 0) objects.push_back(*a);
+    }
+
+    Object3D::setClean(objects, 4);
+    for(CachingObject* leaf: leaves) {
+        CORRADE_VERIFY(!leaf->isDirty());
+        CORRADE_VERIFY(!leaf->parent()->isDirty());
+        CORRADE_VERIFY(!leaf->parent()->parent()->isDirty());
+        CORRADE_COMPARE(leaf->cleanedAbsoluteTransformation, leaf->absoluteTransformationMatrix());
+    }
+}
+
+void ObjectTest::setDirtyDeep() {
+    Scene3D scene;
+    Object3D* root = new Object3D{&scene};
+    Object3D* leaf = root;
+    for(std::size_t i = 0; i != 5000; ++i)
+        leaf = new Object3D{leaf};
+
+    scene.setClean();
+    leaf->setClean();
+    CORRADE_VERIFY(!root->isDirty());
+    CORRADE_VERIFY(!leaf->isDirty());
+
+    /* Propagates through the whole chain */
+    root->setDirty();
+    CORRADE_VERIFY(root->isDirty());
+    CORRADE_VERIFY(leaf->isDirty());
+    CORRADE_VERIFY(leaf->parent()->isDirty());
+}
+
+void ObjectTest::setDirtyList() {
+    class CountingFeature: public AbstractFeature3D {
+        public:
+            explicit CountingFeature(AbstractObject3D& object, Int& counter): AbstractFeature3D{object}, _counter(counter) {}
+
+        protected:
+            void markDirty() override { ++_counter; }
+
+        private:
+            Int& _counter;
+    };
+
+    /* Verify it doesn't crash when passed empty list */
+    Object3D::setDirty({});
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    Object3D c{&b};
+    Object3D d{&scene};
+    Object3D e{&scene};
+    Int counter = 0;
+    CountingFeature featureC{c, counter};
+    Object3D::setClean({c, d, e});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!e.isDirty());
+
+    /* Child listed together with its parent is notified only once, e is
+       untouched */
+    Object3D::setDirty({c, a, d});
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_VERIFY(d.isDirty());
+    CORRADE_VERIFY(!e.isDirty());
+    CORRADE_COMPARE(counter, 1);
+}
+
+void ObjectTest::dirtyGeneration() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    Object3D orphan;
+    CORRADE_COMPARE(scene.generation(), 1);
+    CORRADE_COMPARE(b.dirtyGeneration(), 0);
+
+    b.setClean();
+    a.setDirty();
+    CORRADE_COMPARE(a.dirtyGeneration(), 1);
+    CORRADE_COMPARE(b.dirtyGeneration(), 1);
+
+    /* Already dirty objects are not updated */
+    scene.nextGeneration();
+    CORRADE_COMPARE(scene.generation(), 2);
+    b.setDirty();
+    CORRADE_COMPARE(b.dirtyGeneration(), 1);
+
+    /* Parent stays clean */
+    b.setClean();
+    b.setDirty();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(a.dirtyGeneration(), 1);
+    CORRADE_COMPARE(b.dirtyGeneration(), 2);
+
+    /* Objects without scene have no generation */
+    orphan.setClean();
+    orphan.setDirty();
+    CORRADE_COMPARE(orphan.dirtyGeneration(), 0);
+}
+
+void ObjectTest::featureNotification() {
+    class CountingFeature: public AbstractFeature3D {
+        public:
+            explicit CountingFeature(AbstractObject3D& object, Int& counter): AbstractFeature3D{object}, _counter(counter) {}
+
+        protected:
+            void markDirty() override { ++_counter; }
+
+        private:
+            Int& _counter;
+    };
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+    Int counterA = 0, counterB = 0;
+    CountingFeature featureA{a, counterA};
+    CountingFeature featureB{b, counterB};
+
+    CORRADE_VERIFY(b.isFeatureNotificationEnabled());
+    b.setFeatureNotificationEnabled(false);
+    CORRADE_VERIFY(!b.isFeatureNotificationEnabled());
+
+    /* Object is dirtied, but its features are not notified */
+    b.setClean();
+    a.setDirty();
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_COMPARE(counterA, 1);
+    CORRADE_COMPARE(counterB, 0);
+
+    b.setFeatureNotificationEnabled(true);
+    b.setClean();
+    a.setDirty();
+    CORRADE_COMPARE(counterA, 2);
+    CORRADE_COMPARE(counterB, 1);
+}
+
+void ObjectTest::setCleanInvertedRigid() {
+    typedef SceneGraph::Object<SceneGraph::DualQuaternionTransformation> Object3DQ;
+    typedef SceneGraph::Scene<SceneGraph::DualQuaternionTransformation> Scene3DQ;
+
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            explicit CachingFeature(AbstractObject3D& object, CachedTransformations transformations): AbstractFeature3D{object} {
+                setCachedTransformations(transformations);
+            }
+
+            Matrix4 absolute, invertedAbsolute;
+
+        protected:
+            void clean(const Matrix4& absoluteTransformation) override {
+                absolute = absoluteTransformation;
+            }
+
+            void cleanInverted(const Matrix4& invertedAbsoluteTransformation) override {
+                invertedAbsolute = invertedAbsoluteTransformation;
+            }
+    };
+
+    Scene3DQ scene;
+    Object3DQ parent{&scene};
+    parent.rotateY(Deg(35.0f))
+        .translate({1.0f, 2.0f, -3.0f});
+    Object3DQ object{&parent};
+    object.rotateX(Deg(-12.0f))
+        .translate({0.5f, 0.0f, 1.5f});
+
+    /* The inverted matrix is requested first, the absolute one is then
+       reused */
+    CachingFeature inverted{object, CachedTransformation::InvertedAbsolute};
+    CachingFeature both{object, CachedTransformation::Absolute|CachedTransformation::InvertedAbsolute};
+    object.setClean();
+
+    const Matrix4 expected = object.absoluteTransformationMatrix();
+    CORRADE_COMPARE(both.absolute, expected);
+    CORRADE_COMPARE(both.invertedAbsolute, expected.inverted());
+    CORRADE_COMPARE(inverted.invertedAbsolute, expected.inverted());
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
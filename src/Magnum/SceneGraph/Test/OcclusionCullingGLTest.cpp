@@ -0,0 +1,254 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <memory>
+#include <vector>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/OcclusionCulling.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct OcclusionCullingGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit OcclusionCullingGLTest();
+
+    void cull();
+    void requeryInterval();
+    void noBoundingSphere();
+    void outsideFrustum();
+};
+
+typedef Scene<MatrixTransformation3D> Scene3D;
+typedef Object<MatrixTransformation3D> Object3D;
+
+OcclusionCullingGLTest::OcclusionCullingGLTest() {
+    addTests({&OcclusionCullingGLTest::cull,
+              &OcclusionCullingGLTest::requeryInterval,
+              &OcclusionCullingGLTest::noBoundingSphere,
+              &OcclusionCullingGLTest::outsideFrustum});
+}
+
+namespace {
+    class CountingDrawable: public Object3D, public Drawable3D {
+        public:
+            explicit CountingDrawable(Object3D* parent, DrawableGroup3D& group, std::size_t& count): Object3D{parent}, Drawable3D{*this, &group}, _count(count) {}
+
+        private:
+            void draw(const Matrix4&, Camera3D&) override { ++_count; }
+
+            std::size_t& _count;
+    };
+
+    struct Setup {
+        explicit Setup();
+
+        Renderbuffer color, depth;
+        Framebuffer framebuffer;
+        Scene3D scene;
+        Object3D cameraObject;
+        Camera3D camera;
+    };
+
+    Setup::Setup(): framebuffer{{{}, Vector2i{32}}}, cameraObject{&scene}, camera{cameraObject} {
+        #ifndef MAGNUM_TARGET_GLES2
+        color.setStorage(RenderbufferFormat::RGBA8, Vector2i{32});
+        depth.setStorage(RenderbufferFormat::DepthComponent24, Vector2i{32});
+        #else
+        color.setStorage(RenderbufferFormat::RGBA4, Vector2i{32});
+        depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{32});
+        #endif
+        framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+            .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth)
+            .bind();
+
+        camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+        Renderer::enable(Renderer::Feature::DepthTest);
+    }
+
+    /* Everything is behind the depth buffer cleared to 0, nothing behind the
+       depth buffer cleared to 1 */
+    void clearDepth(Framebuffer& framebuffer, Float depth) {
+        Renderer::setClearDepth(depth);
+        framebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+    }
+}
+
+void OcclusionCullingGLTest::cull() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    DrawableGroup3D group;
+    std::size_t count{};
+    CountingDrawable drawable{&s.scene, group, count};
+    drawable.setBoundingSphere({}, 1.0f);
+    drawable.translate(Vector3::zAxis(-5.0f));
+
+    OcclusionCulling culling;
+    culling.setRequeryInterval(1);
+    #ifndef MAGNUM_TARGET_GLES
+    culling.setConditionalRenderingEnabled(false);
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Visible by default, query against empty depth buffer */
+    clearDepth(s.framebuffer, 1.0f);
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(1), std::size_t(0)));
+    CORRADE_COMPARE(culling.issuedQueryCount(), 1);
+    CORRADE_COMPARE(count, 1);
+    Renderer::finish();
+
+    /* Still visible, query against full depth buffer */
+    clearDepth(s.framebuffer, 0.0f);
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(1), std::size_t(0)));
+    CORRADE_COMPARE(culling.issuedQueryCount(), 1);
+    CORRADE_COMPARE(count, 2);
+    Renderer::finish();
+
+    /* Hidden now, but queried again */
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(0), std::size_t(1)));
+    CORRADE_COMPARE(culling.issuedQueryCount(), 1);
+    CORRADE_COMPARE(count, 2);
+    Renderer::finish();
+
+    /* Still hidden based on previous query, query against empty buffer */
+    clearDepth(s.framebuffer, 1.0f);
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(0), std::size_t(1)));
+    CORRADE_COMPARE(count, 2);
+    Renderer::finish();
+
+    /* Visible again */
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(1), std::size_t(0)));
+    CORRADE_COMPARE(count, 3);
+
+    /* Color and depth mask is enabled again */
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OcclusionCullingGLTest::requeryInterval() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    DrawableGroup3D group;
+    std::size_t count{};
+    std::vector<std::unique_ptr<CountingDrawable>> drawables;
+    for(Int i = 0; i != 8; ++i) {
+        drawables.emplace_back(new CountingDrawable{&s.scene, group, count});
+        drawables.back()->setBoundingSphere({}, 0.25f);
+        drawables.back()->translate({i - 3.5f, 0.0f, -10.0f});
+    }
+
+    OcclusionCulling culling;
+    culling.setRequeryInterval(4);
+    CORRADE_COMPARE(culling.requeryInterval(), 4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Visible drawables are queried in a rotating subset */
+    clearDepth(s.framebuffer, 1.0f);
+    for(std::size_t frame = 0; frame != 8; ++frame) {
+        CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(8), std::size_t(0)));
+        CORRADE_COMPARE(culling.issuedQueryCount(), 2);
+        Renderer::finish();
+    }
+
+    CORRADE_COMPARE(count, 64);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OcclusionCullingGLTest::noBoundingSphere() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    DrawableGroup3D group;
+    std::size_t count{};
+    CountingDrawable drawable{&s.scene, group, count};
+    drawable.translate(Vector3::zAxis(-5.0f));
+
+    OcclusionCulling culling;
+    culling.setRequeryInterval(1);
+
+    /* Always drawn, never queried */
+    clearDepth(s.framebuffer, 0.0f);
+    for(std::size_t frame = 0; frame != 3; ++frame) {
+        CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(1), std::size_t(0)));
+        CORRADE_COMPARE(culling.issuedQueryCount(), 0);
+        Renderer::finish();
+    }
+
+    CORRADE_COMPARE(count, 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OcclusionCullingGLTest::outsideFrustum() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    DrawableGroup3D group;
+    std::size_t count{};
+    CountingDrawable drawable{&s.scene, group, count};
+    drawable.setBoundingSphere({}, 1.0f);
+    drawable.translate(Vector3::zAxis(5.0f));
+
+    OcclusionCulling culling;
+    culling.setRequeryInterval(1);
+
+    /* Behind the camera, culled without a query */
+    clearDepth(s.framebuffer, 1.0f);
+    CORRADE_COMPARE(culling.draw(s.camera, group), std::make_pair(std::size_t(0), std::size_t(1)));
+    CORRADE_COMPARE(culling.issuedQueryCount(), 0);
+    CORRADE_COMPARE(count, 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionCullingGLTest)
@@ -0,0 +1,358 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/Spatial.h"
+#include "Magnum/SceneGraph/SpatialGroup.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SpatialTest: TestSuite::Tester {
+    explicit SpatialTest();
+
+    void transformedBoundingSphere();
+    void withinRadius();
+    void withinRadiusLarge();
+    void withinRange();
+    void nearest();
+    void grid();
+    void nearestFar();
+    void nearestMoreThanAvailable();
+    void incrementalUpdate();
+    void addRemove();
+    void setBoundingSphere();
+    void setCellSize();
+    void setCellSizeInvalid();
+    void twoDimensions();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialTest::SpatialTest() {
+    addTests({&SpatialTest::transformedBoundingSphere,
+              &SpatialTest::withinRadius,
+              &SpatialTest::withinRadiusLarge,
+              &SpatialTest::withinRange,
+              &SpatialTest::nearest,
+              &SpatialTest::grid,
+              &SpatialTest::nearestFar,
+              &SpatialTest::nearestMoreThanAvailable,
+              &SpatialTest::incrementalUpdate,
+              &SpatialTest::addRemove,
+              &SpatialTest::setBoundingSphere,
+              &SpatialTest::setCellSize,
+              &SpatialTest::setCellSizeInvalid,
+              &SpatialTest::twoDimensions});
+}
+
+namespace {
+    template<UnsignedInt dimensions> bool contains(const std::vector<std::reference_wrapper<Spatial<dimensions, Float>>>& features, const Spatial<dimensions, Float>& feature) {
+        return std::find_if(features.begin(), features.end(), [&](const Spatial<dimensions, Float>& a) { return &a == &feature; }) != features.end();
+    }
+}
+
+void SpatialTest::transformedBoundingSphere() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D object{&scene};
+    object.scale({1.0f, 3.0f, 2.0f})
+        .translate({1.0f, 2.0f, 3.0f});
+    Spatial3D spatial{object, &group};
+    spatial.setBoundingSphere({1.0f, 0.0f, 0.0f}, 0.5f);
+
+    group.setClean();
+    CORRADE_COMPARE(spatial.transformedCenter(), (Vector3{2.0f, 2.0f, 3.0f}));
+
+    /* Largest scaling is taken */
+    CORRADE_COMPARE(spatial.transformedRadius(), 1.5f);
+}
+
+void SpatialTest::withinRadius() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene}, d{&scene};
+    a.translate({0.5f, 0.0f, 0.0f});
+    b.translate({2.0f, 0.0f, 0.0f});
+    c.translate({0.0f, 3.5f, 0.0f});
+    d.translate({-10.0f, 0.0f, 0.0f});
+    Spatial3D sa{a, &group}, sb{b, &group}, sc{c, &group}, sd{d, &group};
+    sc.setBoundingSphere({}, 1.0f);
+
+    /* c touches the query with its bounding sphere */
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 2.5f);
+    CORRADE_COMPARE(result.size(), 3);
+    CORRADE_VERIFY(contains(result, sa));
+    CORRADE_VERIFY(contains(result, sb));
+    CORRADE_VERIFY(contains(result, sc));
+    CORRADE_VERIFY(!contains(result, sd));
+}
+
+void SpatialTest::withinRadiusLarge() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({-1000.0f, 0.0f, 0.0f});
+    b.translate({0.0f, 0.0f, 1000.0f});
+    Spatial3D sa{a, &group}, sb{b, &group};
+
+    /* Spans way more cells than there are features, goes through all of
+       them instead */
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 1.0e6f);
+    CORRADE_COMPARE(result.size(), 2);
+}
+
+void SpatialTest::withinRange() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate({0.5f, 0.5f, 0.5f});
+    b.translate({3.0f, 0.5f, 0.5f});
+    c.translate({2.5f, 2.5f, 0.5f});
+    Spatial3D sa{a, &group}, sb{b, &group}, sc{c, &group};
+    sb.setBoundingSphere({}, 1.1f);
+    /* Overlaps the box in both X and Y, but not at the corner */
+    sc.setBoundingSphere({}, 0.6f);
+
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRange({{}, Vector3{2.0f}});
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_VERIFY(contains(result, sa));
+    CORRADE_VERIFY(contains(result, sb));
+    CORRADE_VERIFY(!contains(result, sc));
+}
+
+void SpatialTest::nearest() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene}, d{&scene};
+    a.translate({3.0f, 0.0f, 0.0f});
+    b.translate({0.0f, -1.0f, 0.0f});
+    c.translate({0.0f, 0.0f, 5.0f});
+    d.translate({2.0f, 2.0f, 0.0f});
+    Spatial3D sa{a, &group}, sb{b, &group}, sc{c, &group}, sd{d, &group};
+    /* Farther than a, but large */
+    sc.setBoundingSphere({}, 3.0f);
+
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.nearest({}, 3);
+    CORRADE_COMPARE(result.size(), 3);
+    CORRADE_COMPARE(&result[0].get(), &sb);
+    CORRADE_COMPARE(&result[1].get(), &sc);
+    CORRADE_COMPARE(&result[2].get(), &sd);
+    CORRADE_VERIFY(!contains(result, sa));
+
+    CORRADE_VERIFY(group.nearest({}, 0).empty());
+}
+
+void SpatialTest::grid() {
+    SpatialGroup3D group;
+    Scene3D scene;
+
+    /* Enough features for the queries to go through the cells */
+    for(Int z = 0; z != 5; ++z) for(Int y = 0; y != 5; ++y) for(Int x = 0; x != 5; ++x) {
+        Object3D* o = new Object3D{&scene};
+        o->translate(Vector3{Vector3i{x, y, z}});
+        new Spatial3D{*o, &group};
+    }
+
+    CORRADE_COMPARE(group.withinRadius(Vector3{2.0f}, 1.0f).size(), 7);
+    CORRADE_COMPARE(group.withinRange({Vector3{0.5f}, {1.5f, 2.5f, 1.5f}}).size(), 2);
+
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.nearest({0.1f, 0.2f, 0.3f}, 4);
+    CORRADE_COMPARE(result.size(), 4);
+    CORRADE_COMPARE(result[0].get().transformedCenter(), (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(result[1].get().transformedCenter(), (Vector3{0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(result[2].get().transformedCenter(), (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(result[3].get().transformedCenter(), (Vector3{1.0f, 0.0f, 0.0f}));
+}
+
+void SpatialTest::nearestFar() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate({50.0f, 0.0f, 0.0f});
+    b.translate({0.0f, -40.0f, 0.0f});
+    c.translate({0.0f, 0.0f, 1.0f});
+    Spatial3D sa{a, &group}, sb{b, &group}, sc{c, &group};
+
+    /* The rings get larger than feature count before reaching a and b */
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.nearest({}, 2);
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_COMPARE(&result[0].get(), &sc);
+    CORRADE_COMPARE(&result[1].get(), &sb);
+    CORRADE_VERIFY(!contains(result, sa));
+}
+
+void SpatialTest::nearestMoreThanAvailable() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({2.0f, 0.0f, 0.0f});
+    b.translate({1.0f, 0.0f, 0.0f});
+    Spatial3D sa{a, &group}, sb{b, &group};
+
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.nearest({}, 5);
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_COMPARE(&result[0].get(), &sb);
+    CORRADE_COMPARE(&result[1].get(), &sa);
+}
+
+void SpatialTest::incrementalUpdate() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    b.translate({5.0f, 0.0f, 0.0f});
+    c.translate({10.0f, 0.0f, 0.0f});
+    Spatial3D sa{a, &group}, sb{b, &group}, sc{c, &group};
+
+    /* First call builds the index */
+    group.setClean();
+    CORRADE_COMPARE(group.cleanedCount(), 3);
+
+    /* Nothing changed */
+    group.setClean();
+    CORRADE_COMPARE(group.cleanedCount(), 0);
+
+    /* Only the moved object is updated */
+    c.translate({-9.5f, 0.0f, 0.0f});
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 1.0f);
+    CORRADE_COMPARE(group.cleanedCount(), 1);
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_VERIFY(contains(result, sa));
+    CORRADE_VERIFY(contains(result, sc));
+
+    /* Moving away from the query */
+    a.translate({100.0f, 0.0f, 0.0f});
+    result = group.withinRadius({}, 1.0f);
+    CORRADE_COMPARE(group.cleanedCount(), 1);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_VERIFY(contains(result, sc));
+    CORRADE_VERIFY(!contains(result, sb));
+}
+
+void SpatialTest::addRemove() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    b.translate({0.5f, 0.0f, 0.0f});
+    Spatial3D sa{a, &group};
+
+    group.setClean();
+    CORRADE_COMPARE(group.cleanedCount(), 1);
+
+    {
+        Spatial3D sb{b, &group};
+        std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 1.0f);
+        CORRADE_COMPARE(group.cleanedCount(), 2);
+        CORRADE_COMPARE(result.size(), 2);
+    }
+
+    /* Removed feature is not in the index anymore */
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 1.0f);
+    CORRADE_COMPARE(group.cleanedCount(), 1);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_VERIFY(contains(result, sa));
+}
+
+void SpatialTest::setBoundingSphere() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate({5.0f, 0.0f, 0.0f});
+    Spatial3D sa{a, &group};
+
+    CORRADE_VERIFY(group.withinRadius({}, 1.0f).empty());
+
+    /* The object is clean, but the feature gets updated */
+    sa.setBoundingSphere({-4.0f, 0.0f, 0.0f}, 0.5f);
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.withinRadius({}, 1.0f);
+    CORRADE_COMPARE(group.cleanedCount(), 1);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_COMPARE(sa.transformedCenter(), (Vector3{1.0f, 0.0f, 0.0f}));
+}
+
+void SpatialTest::setCellSize() {
+    SpatialGroup3D group;
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    b.translate({0.0f, 0.0f, 7.0f});
+    Spatial3D sa{a, &group}, sb{b, &group};
+
+    group.setClean();
+    group.setCellSize(10.0f);
+    CORRADE_COMPARE(group.cellSize(), 10.0f);
+
+    /* Changing cell size rebuilds the index */
+    std::vector<std::reference_wrapper<Spatial3D>> result = group.nearest({0.0f, 0.0f, 3.0f}, 1);
+    CORRADE_COMPARE(group.cleanedCount(), 2);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_COMPARE(&result[0].get(), &sa);
+}
+
+void SpatialTest::setCellSizeInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SpatialGroup3D group;
+    group.setCellSize(0.0f);
+
+    CORRADE_COMPARE(group.cellSize(), 1.0f);
+    CORRADE_COMPARE(out.str(), "SceneGraph::SpatialGroup::setCellSize(): expected positive size but got 0\n");
+}
+
+void SpatialTest::twoDimensions() {
+    SpatialGroup2D group;
+    Scene2D scene;
+    Object2D a{&scene}, b{&scene}, c{&scene};
+    a.translate({1.0f, 1.0f});
+    b.translate({-3.0f, 0.0f});
+    c.translate({0.0f, 8.0f});
+    Spatial2D sa{a, &group}, sb{b, &group}, sc{c, &group};
+
+    std::vector<std::reference_wrapper<Spatial2D>> result = group.withinRadius({}, 2.0f);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_VERIFY(contains(result, sa));
+
+    result = group.withinRange({{-4.0f, -1.0f}, {0.0f, 1.0f}});
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_VERIFY(contains(result, sb));
+
+    result = group.nearest({0.0f, 10.0f}, 2);
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_COMPARE(&result[0].get(), &sc);
+    CORRADE_COMPARE(&result[1].get(), &sa);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialTest)
@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/RingBuffer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpriteBatch.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SpriteBatchGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit SpriteBatchGLTest();
+
+    void construct();
+    void constructLarge();
+    void textureCoordinates();
+
+    void drawPages();
+    void drawLayers();
+    void drawChunks();
+    void drawSprites();
+};
+
+typedef Scene<MatrixTransformation2D> Scene2D;
+typedef Object<MatrixTransformation2D> Object2D;
+
+SpriteBatchGLTest::SpriteBatchGLTest() {
+    addTests({&SpriteBatchGLTest::construct,
+              &SpriteBatchGLTest::constructLarge,
+              &SpriteBatchGLTest::textureCoordinates,
+
+              &SpriteBatchGLTest::drawPages,
+              &SpriteBatchGLTest::drawLayers,
+              &SpriteBatchGLTest::drawChunks,
+              &SpriteBatchGLTest::drawSprites});
+}
+
+namespace {
+    struct Setup {
+        explicit Setup();
+
+        Renderbuffer color;
+        Framebuffer framebuffer;
+        RingBuffer ring;
+        Shaders::Flat2D shader;
+    };
+
+    Setup::Setup(): framebuffer{{{}, Vector2i{32}}}, ring{64*1024}, shader{Shaders::Flat2D::Flag::InstancedColor} {
+        #ifndef MAGNUM_TARGET_GLES2
+        color.setStorage(RenderbufferFormat::RGBA8, Vector2i{32});
+        #else
+        color.setStorage(RenderbufferFormat::RGBA4, Vector2i{32});
+        #endif
+        framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+            .bind();
+        framebuffer.clear(FramebufferClear::Color);
+    }
+
+    const Range2D Quad{{-1.0f, -1.0f}, {1.0f, 1.0f}};
+}
+
+void SpriteBatchGLTest::construct() {
+    RingBuffer ring{1024};
+    SpriteBatch batch{ring, 16};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.capacity(), 16);
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+    CORRADE_COMPARE(batch.drawCallCount(), 0);
+}
+
+void SpriteBatchGLTest::constructLarge() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::OES::element_index_uint>())
+        CORRADE_SKIP(Extensions::GL::OES::element_index_uint::string() + std::string(" is not available."));
+    #endif
+
+    /* More than 65536 vertices, needs 32-bit indices */
+    RingBuffer ring{1024};
+    SpriteBatch batch{ring, 32768};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.capacity(), 32768);
+}
+
+void SpriteBatchGLTest::textureCoordinates() {
+    CORRADE_COMPARE(SpriteBatch::textureCoordinates({{32, 16}, {64, 48}}, {128, 64}),
+        (Range2D{{0.25f, 0.25f}, {0.5f, 0.75f}}));
+}
+
+void SpriteBatchGLTest::drawPages() {
+    Setup s;
+    SpriteBatch batch{s.ring, 16};
+
+    batch.add({}, Quad, {}, Color4ub{255}, 1)
+        .add({}, Quad, {}, Color4ub{255}, 0)
+        .add({}, Quad, {}, Color4ub{255}, 1)
+        .add({}, Quad, {}, Color4ub{255}, 2);
+    CORRADE_COMPARE(batch.spriteCount(), 4);
+
+    /* Sorted by page, sprites with the same page drawn at once */
+    std::vector<UnsignedInt> pages;
+    batch.draw(s.shader, [&](UnsignedInt page) { pages.push_back(page); });
+    s.ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.drawCallCount(), 3);
+    CORRADE_COMPARE(pages, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+}
+
+void SpriteBatchGLTest::drawLayers() {
+    Setup s;
+    SpriteBatch batch{s.ring, 16};
+
+    /* Layer takes precedence over page */
+    batch.add({}, Quad, {}, Color4ub{255}, 0, 1)
+        .add({}, Quad, {}, Color4ub{255}, 1, -1)
+        .add({}, Quad, {}, Color4ub{255}, 0, 0)
+        .add({}, Quad, {}, Color4ub{255}, 1, 1);
+
+    std::vector<UnsignedInt> pages;
+    batch.draw(s.shader, [&](UnsignedInt page) { pages.push_back(page); });
+    s.ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.drawCallCount(), 4);
+    CORRADE_COMPARE(pages, (std::vector<UnsignedInt>{1, 0, 0, 1}));
+}
+
+void SpriteBatchGLTest::drawChunks() {
+    Setup s;
+    SpriteBatch batch{s.ring, 2};
+
+    for(Int i = 0; i != 5; ++i) batch.add({}, Quad, {});
+
+    /* Five sprites with capacity of two are drawn in three chunks */
+    batch.draw(s.shader, nullptr);
+    s.ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.drawCallCount(), 3);
+}
+
+void SpriteBatchGLTest::drawSprites() {
+    Setup s;
+    SpriteBatch batch{s.ring, 16};
+
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    DrawableGroup2D drawables;
+
+    /* Left half red, right half green */
+    Object2D left{&scene}, right{&scene};
+    left.scale({0.5f, 1.0f}).translate({-0.5f, 0.0f});
+    right.scale({0.5f, 1.0f}).translate({0.5f, 0.0f});
+    Sprite leftSprite{left, batch, &drawables};
+    leftSprite.setColor({255, 0, 0, 255});
+    Sprite rightSprite{right, batch, &drawables};
+    rightSprite.setColor({0, 255, 0, 255})
+        .setPage(1);
+
+    camera.draw(drawables);
+    CORRADE_COMPARE(batch.spriteCount(), 2);
+
+    batch.draw(s.shader, nullptr);
+    s.ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.drawCallCount(), 2);
+
+    Image2D image = s.framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image.data<Color4ub>()[16*32 + 4], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(image.data<Color4ub>()[16*32 + 28], (Color4ub{0, 255, 0, 255}));
+    #endif
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::SceneGraph::Test::SpriteBatchGLTest)
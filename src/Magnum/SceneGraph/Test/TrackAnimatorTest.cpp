@@ -0,0 +1,200 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TrackAnimator.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TrackAnimatorTest: TestSuite::Tester {
+    explicit TrackAnimatorTest();
+
+    void interpolate();
+    void clamp();
+    void looping();
+    void stop();
+    void object();
+    void parallel();
+    void addTrackInvalidSize();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+TrackAnimatorTest::TrackAnimatorTest() {
+    addTests({&TrackAnimatorTest::interpolate,
+              &TrackAnimatorTest::clamp,
+              &TrackAnimatorTest::looping,
+              &TrackAnimatorTest::stop,
+              &TrackAnimatorTest::object,
+              &TrackAnimatorTest::parallel,
+              &TrackAnimatorTest::addTrackInvalidSize});
+}
+
+namespace {
+    using namespace Math::Literals;
+
+    constexpr Float Times[]{0.0f, 1.0f, 3.0f};
+    constexpr Vector3 Translations[]{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {2.0f, 4.0f, 0.0f}};
+    const Quaternion Rotations[]{{}, Quaternion::rotation(90.0_degf, Vector3::zAxis()), Quaternion::rotation(90.0_degf, Vector3::zAxis())};
+    constexpr Vector3 Scalings[]{{1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {3.0f, 3.0f, 3.0f}};
+}
+
+void TrackAnimatorTest::interpolate() {
+    TrackAnimator3D animator;
+    const UnsignedInt track = animator.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+    CORRADE_COMPARE(track, 0);
+    CORRADE_COMPARE(animator.trackCount(), 1);
+    CORRADE_COMPARE(animator.duration(track), 3.0f);
+    CORRADE_VERIFY(!animator.isPlaying(track));
+
+    animator.play(track, 10.0f);
+    CORRADE_VERIFY(animator.isPlaying(track));
+
+    animator.step(10.5f);
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(45.0_degf));
+
+    /* Going backwards uses the same keyframe search */
+    animator.step(12.0f);
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({2.0f, 2.0f, 0.0f})*
+        Matrix4::rotationZ(90.0_degf)*
+        Matrix4::scaling(Vector3{2.0f}));
+    animator.step(10.5f);
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(45.0_degf));
+}
+
+void TrackAnimatorTest::clamp() {
+    TrackAnimator3D animator;
+    animator.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+
+    /* Before the track start the first keyframe is used */
+    animator.play(0, 10.0f);
+    animator.step(9.0f);
+    CORRADE_COMPARE(animator.transformationMatrices()[0], Matrix4{});
+
+    /* Non-looping track stops after reaching its end and keeps the last
+       keyframe */
+    animator.step(14.0f);
+    CORRADE_VERIFY(!animator.isPlaying(0));
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({2.0f, 4.0f, 0.0f})*
+        Matrix4::rotationZ(90.0_degf)*
+        Matrix4::scaling(Vector3{3.0f}));
+}
+
+void TrackAnimatorTest::looping() {
+    TrackAnimator3D animator;
+    animator.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+    animator.setLooping(0, true)
+        .play(0, 10.0f);
+    CORRADE_VERIFY(animator.isLooping(0));
+
+    animator.step(16.5f);
+    CORRADE_VERIFY(animator.isPlaying(0));
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(45.0_degf));
+}
+
+void TrackAnimatorTest::stop() {
+    TrackAnimator3D animator;
+    animator.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+    animator.play(0, 0.0f)
+        .step(0.5f);
+    animator.stop(0);
+    CORRADE_VERIFY(!animator.isPlaying(0));
+
+    /* Stopped tracks are not updated */
+    animator.step(1.0f);
+    CORRADE_COMPARE(animator.transformationMatrices()[0],
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(45.0_degf));
+}
+
+void TrackAnimatorTest::object() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(&a, Times, Translations, Rotations, Scalings);
+    animator.addTrack(&b, Times, Translations, Rotations, Scalings);
+    CORRADE_COMPARE(animator.object(0), &a);
+
+    b.setTransformation(Matrix4::translation(Vector3::yAxis()));
+    b.setClean();
+    animator.play(0, 0.0f)
+        .step(1.0f);
+    CORRADE_COMPARE(a.transformationMatrix(),
+        Matrix4::translation({2.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(90.0_degf));
+    CORRADE_VERIFY(a.isDirty());
+
+    /* Track that's not playing doesn't touch the object */
+    CORRADE_COMPARE(b.transformationMatrix(), Matrix4::translation(Vector3::yAxis()));
+    CORRADE_VERIFY(!b.isDirty());
+}
+
+void TrackAnimatorTest::parallel() {
+    /* Enough tracks to be split among more threads, the result should be
+       the same as when done on a single thread */
+    TrackAnimator3D parallel, serial;
+    serial.setThreadCount(1);
+    CORRADE_COMPARE(serial.threadCount(), 1);
+    for(UnsignedInt i = 0; i != 5000; ++i) {
+        parallel.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+        serial.addTrack(nullptr, Times, Translations, Rotations, Scalings);
+        parallel.setLooping(i, true).play(i, i*0.001f);
+        serial.setLooping(i, true).play(i, i*0.001f);
+    }
+
+    parallel.step(7.0f);
+    serial.step(7.0f);
+    for(UnsignedInt i = 0; i != 5000; ++i)
+        CORRADE_COMPARE(parallel.transformationMatrices()[i], serial.transformationMatrices()[i]);
+}
+
+void TrackAnimatorTest::addTrackInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TrackAnimator3D animator;
+    animator.addTrack(nullptr, Times, Containers::ArrayView<const Vector3>{Translations, 2}, Rotations, Scalings);
+    CORRADE_COMPARE(animator.trackCount(), 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::TrackAnimator3D::addTrack(): expected the same non-zero count of times, translations, rotations and scalings but got 3, 2, 3 and 3\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackAnimatorTest)
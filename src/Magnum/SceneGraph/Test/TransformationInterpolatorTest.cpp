@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/SceneGraph/DualComplexTransformation.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TransformationInterpolator.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TransformationInterpolatorTest: TestSuite::Tester {
+    explicit TransformationInterpolatorTest();
+
+    void addRemove();
+    void saveRestore();
+
+    void translation();
+    void dualComplex();
+    void dualQuaternion();
+    void matrix2D();
+    void matrix3D();
+    void matrix3DMirrored();
+};
+
+TransformationInterpolatorTest::TransformationInterpolatorTest() {
+    addTests({&TransformationInterpolatorTest::addRemove,
+              &TransformationInterpolatorTest::saveRestore,
+
+              &TransformationInterpolatorTest::translation,
+              &TransformationInterpolatorTest::dualComplex,
+              &TransformationInterpolatorTest::dualQuaternion,
+              &TransformationInterpolatorTest::matrix2D,
+              &TransformationInterpolatorTest::matrix3D,
+              &TransformationInterpolatorTest::matrix3DMirrored});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+void TransformationInterpolatorTest::addRemove() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+
+    TransformationInterpolator<MatrixTransformation3D> interpolator;
+    CORRADE_VERIFY(interpolator.isEmpty());
+
+    interpolator.add(a)
+        .add(b);
+    CORRADE_COMPARE(interpolator.size(), 2);
+
+    interpolator.remove(a);
+    CORRADE_COMPARE(interpolator.size(), 1);
+
+    /* Removing an object that's not there does nothing */
+    interpolator.remove(a);
+    CORRADE_COMPARE(interpolator.size(), 1);
+}
+
+void TransformationInterpolatorTest::saveRestore() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate(Vector3::xAxis(1.0f));
+
+    TransformationInterpolator<MatrixTransformation3D> interpolator;
+    interpolator.add(object);
+
+    /* Nothing saved yet, both states are the initial transformation */
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Two simulation steps */
+    interpolator.restore();
+    object.translate(Vector3::xAxis(1.0f));
+    interpolator.save();
+    object.translate(Vector3::xAxis(1.0f));
+    interpolator.save();
+
+    interpolator.interpolate(0.25f);
+    CORRADE_COMPARE(object.transformation(), Matrix4::translation(Vector3::xAxis(2.25f)));
+
+    /* Restoring goes back to the last simulated state */
+    interpolator.restore();
+    CORRADE_COMPARE(object.transformation(), Matrix4::translation(Vector3::xAxis(3.0f)));
+}
+
+void TransformationInterpolatorTest::translation() {
+    typedef SceneGraph::Object<SceneGraph::TranslationTransformation2D> Object2D;
+    typedef SceneGraph::Scene<SceneGraph::TranslationTransformation2D> Scene2D;
+
+    Scene2D scene;
+    Object2D object{&scene};
+
+    TransformationInterpolator<TranslationTransformation2D> interpolator;
+    interpolator.add(object);
+    object.setTransformation({2.0f, -4.0f});
+    interpolator.save();
+
+    interpolator.interpolate(0.75f);
+    CORRADE_COMPARE(object.transformation(), (Vector2{1.5f, -3.0f}));
+}
+
+void TransformationInterpolatorTest::dualComplex() {
+    typedef SceneGraph::Object<SceneGraph::DualComplexTransformation> Object2D;
+    typedef SceneGraph::Scene<SceneGraph::DualComplexTransformation> Scene2D;
+
+    Scene2D scene;
+    Object2D object{&scene};
+    object.setTransformation(DualComplex::rotation(Deg(170.0f)));
+
+    TransformationInterpolator<DualComplexTransformation> interpolator;
+    interpolator.add(object);
+
+    /* Goes the short way over 180° */
+    object.setTransformation(DualComplex::translation({4.0f, 0.0f})*DualComplex::rotation(Deg(-170.0f)));
+    interpolator.save();
+
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), DualComplex::translation({2.0f, 0.0f})*DualComplex::rotation(Deg(180.0f)));
+}
+
+void TransformationInterpolatorTest::dualQuaternion() {
+    typedef SceneGraph::Object<SceneGraph::DualQuaternionTransformation> Object3D;
+    typedef SceneGraph::Scene<SceneGraph::DualQuaternionTransformation> Scene3D;
+
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TransformationInterpolator<DualQuaternionTransformation> interpolator;
+    interpolator.add(object);
+
+    const DualQuaternion b = DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis());
+    object.setTransformation(b);
+    interpolator.save();
+
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), Math::sclerp(DualQuaternion{}, b, 0.5f));
+    CORRADE_COMPARE(object.transformation(), DualQuaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+}
+
+void TransformationInterpolatorTest::matrix2D() {
+    typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+    typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+
+    Scene2D scene;
+    Object2D object{&scene};
+    object.setTransformation(Matrix3::rotation(Deg(10.0f)));
+
+    TransformationInterpolator<MatrixTransformation2D> interpolator;
+    interpolator.add(object);
+
+    object.setTransformation(Matrix3::translation({2.0f, 4.0f})*Matrix3::rotation(Deg(50.0f))*Matrix3::scaling({3.0f, 5.0f}));
+    interpolator.save();
+
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), Matrix3::translation({1.0f, 2.0f})*Matrix3::rotation(Deg(30.0f))*Matrix3::scaling({2.0f, 3.0f}));
+}
+
+void TransformationInterpolatorTest::matrix3D() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TransformationInterpolator<MatrixTransformation3D> interpolator;
+    interpolator.add(object);
+
+    object.setTransformation(Matrix4::translation({2.0f, 4.0f, 6.0f})*Matrix4::rotationX(Deg(90.0f))*Matrix4::scaling({3.0f, 5.0f, 1.0f}));
+    interpolator.save();
+
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationX(Deg(45.0f))*Matrix4::scaling({2.0f, 3.0f, 1.0f}));
+}
+
+void TransformationInterpolatorTest::matrix3DMirrored() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.setTransformation(Matrix4::scaling({-1.0f, 1.0f, 1.0f}));
+
+    TransformationInterpolator<MatrixTransformation3D> interpolator;
+    interpolator.add(object);
+
+    /* Mirroring is kept in the scaling, not turned into a rotation */
+    object.setTransformation(Matrix4::scaling({-3.0f, 1.0f, 1.0f}));
+    interpolator.save();
+
+    interpolator.interpolate(0.5f);
+    CORRADE_COMPARE(object.transformation(), Matrix4::scaling({-2.0f, 1.0f, 1.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TransformationInterpolatorTest)
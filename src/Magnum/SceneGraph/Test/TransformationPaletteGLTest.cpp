@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TransformationPalette.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TransformationPaletteGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit TransformationPaletteGLTest();
+
+    void add2D();
+    void add3D();
+    void clear();
+};
+
+typedef Scene<MatrixTransformation2D> Scene2D;
+typedef Object<MatrixTransformation2D> Object2D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+typedef Object<MatrixTransformation3D> Object3D;
+
+TransformationPaletteGLTest::TransformationPaletteGLTest() {
+    addTests({&TransformationPaletteGLTest::add2D,
+              &TransformationPaletteGLTest::add3D,
+              &TransformationPaletteGLTest::clear});
+}
+
+namespace {
+    template<UnsignedInt dimensions> class EmptyDrawable: public Drawable<dimensions, Float> {
+        public:
+            using Drawable<dimensions, Float>::Drawable;
+
+        private:
+            void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {}
+    };
+}
+
+void TransformationPaletteGLTest::add2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    cameraObject.translate({0.0f, 1.0f});
+    Camera2D camera{cameraObject};
+
+    DrawableGroup2D group;
+    Object2D a{&scene}, b{&scene};
+    a.translate({2.0f, 0.0f});
+    b.translate({0.0f, 3.0f});
+    EmptyDrawable<2> da{a, &group}, db{b, &group};
+
+    TransformationPalette2D palette;
+    CORRADE_COMPARE(palette.add(camera, group), 0);
+    CORRADE_COMPARE(palette.add(camera, group), 2);
+    CORRADE_COMPARE(palette.size(), 4);
+
+    palette.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Three padded columns per matrix */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Vector4> data = palette.buffer().data<Vector4>();
+    CORRADE_COMPARE(data.size(), 12);
+    CORRADE_COMPARE(data[2], (Vector4{2.0f, -1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(data[5], (Vector4{0.0f, 2.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(data[8], (Vector4{2.0f, -1.0f, 1.0f, 0.0f}));
+    #endif
+}
+
+void TransformationPaletteGLTest::add3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    cameraObject.translate({0.0f, 0.0f, 5.0f});
+    Camera3D camera{cameraObject};
+
+    DrawableGroup3D first, second;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate({1.0f, 0.0f, 0.0f});
+    b.translate({0.0f, 2.0f, 0.0f});
+    c.translate({0.0f, 0.0f, 3.0f});
+    EmptyDrawable<3> da{a, &first}, db{b, &second}, dc{c, &second};
+
+    TransformationPalette3D palette;
+    CORRADE_COMPARE(palette.add(camera, first), 0);
+    CORRADE_COMPARE(palette.add(camera, second), 1);
+    CORRADE_COMPARE(palette.size(), 3);
+
+    palette.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Four columns per matrix */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Vector4> data = palette.buffer().data<Vector4>();
+    CORRADE_COMPARE(data.size(), 12);
+    CORRADE_COMPARE(data[3], (Vector4{1.0f, 0.0f, -5.0f, 1.0f}));
+    CORRADE_COMPARE(data[7], (Vector4{0.0f, 2.0f, -5.0f, 1.0f}));
+    CORRADE_COMPARE(data[11], (Vector4{0.0f, 0.0f, -2.0f, 1.0f}));
+    #endif
+}
+
+void TransformationPaletteGLTest::clear() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    DrawableGroup3D group;
+    Object3D a{&scene};
+    EmptyDrawable<3> da{a, &group};
+
+    TransformationPalette3D palette;
+    palette.add(camera, group);
+    palette.add(camera, group);
+    CORRADE_COMPARE(palette.size(), 2);
+
+    /* Offsets start from zero again */
+    palette.clear();
+    CORRADE_COMPARE(palette.size(), 0);
+    CORRADE_COMPARE(palette.add(camera, group), 0);
+    CORRADE_COMPARE(palette.size(), 1);
+
+    palette.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::SceneGraph::Test::TransformationPaletteGLTest)
@@ -0,0 +1,228 @@
+#ifndef Magnum_SceneGraph_TrackAnimator_h
+#define Magnum_SceneGraph_TrackAnimator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicTrackAnimator3D, typedef @ref Magnum::SceneGraph::TrackAnimator3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe track animator for three-dimensional scenes
+
+Alternative to @ref Animable for large numbers of simple transformation
+animations. Instead of calling virtual @ref Animable::animationStep() on each
+feature, keyframes of all tracks (times, translations, rotations and scaling)
+are stored in contiguous arrays and @ref step() samples all playing tracks at
+once, distributing them among multiple threads. Translation and scaling is
+interpolated using @ref Math::lerp(), rotation using @ref Math::slerp().
+@code
+SceneGraph::TrackAnimator3D animator;
+
+Float times[]{0.0f, 1.0f, 2.0f};
+Vector3 translations[]{{}, Vector3::yAxis(), {}};
+Quaternion rotations[]{{}, Quaternion::rotation(90.0_degf, Vector3::yAxis()), {}};
+Vector3 scalings[]{Vector3{1.0f}, Vector3{1.5f}, Vector3{1.0f}};
+
+for(Object3D* prop: props) {
+    UnsignedInt track = animator.addTrack(prop, times, translations, rotations, scalings);
+    animator.setLooping(track, true)
+        .play(track, timeline.previousFrameTime());
+}
+
+// every frame:
+animator.step(timeline.previousFrameTime());
+@endcode
+
+Resulting transformations are available through @ref transformationMatrices()
+and, for tracks with an object attached, set on the objects as a whole at the
+end of @ref step(). Setting the objects is done on the calling thread, as
+marking them dirty isn't thread-safe. Custom animations that can't be
+expressed with keyframes should still use @ref Animable.
+
+@anchor SceneGraph-TrackAnimator3D-explicit-specializations
+## Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref TrackAnimator.hpp implementation file to avoid
+linker errors. See @ref compilation-speedup-hpp for more information.
+
+-   @ref TrackAnimator3D
+
+@see @ref scenegraph, @ref TrackAnimator3D
+*/
+template<class T> class BasicTrackAnimator3D {
+    public:
+        /** @brief Type of animated objects */
+        typedef Object<BasicMatrixTransformation3D<T>> ObjectType;
+
+        /** @brief Constructor */
+        explicit BasicTrackAnimator3D();
+
+        /** @brief Count of tracks */
+        std::size_t trackCount() const { return _keyframeOffsets.size(); }
+
+        /**
+         * @brief Add track
+         * @param object        Object to animate or `nullptr`
+         * @param times         Keyframe times, in ascending order
+         * @param translations  Keyframe translations
+         * @param rotations     Keyframe rotations, expected to be normalized
+         * @param scalings      Keyframe scalings
+         * @return ID of the newly added track
+         *
+         * Expects that all arrays have the same non-zero size. The data are
+         * copied. Duration of the track is the time of its last keyframe. The
+         * track is not playing by default.
+         * @see @ref play()
+         */
+        UnsignedInt addTrack(ObjectType* object, Containers::ArrayView<const T> times, Containers::ArrayView<const Math::Vector3<T>> translations, Containers::ArrayView<const Math::Quaternion<T>> rotations, Containers::ArrayView<const Math::Vector3<T>> scalings);
+
+        /** @brief Object animated by given track or `nullptr` */
+        ObjectType* object(UnsignedInt id) const { return _objects[id]; }
+
+        /** @brief Duration of given track */
+        T duration(UnsignedInt id) const {
+            return _times[_keyframeOffsets[id] + _keyframeCounts[id] - 1];
+        }
+
+        /** @brief Whether given track is playing */
+        bool isPlaying(UnsignedInt id) const { return _flags[id] & Playing; }
+
+        /**
+         * @brief Play given track
+         * @param id        Track ID
+         * @param time      Absolute start time (e.g. @ref Timeline::previousFrameTime())
+         * @return Reference to self (for method chaining)
+         */
+        BasicTrackAnimator3D<T>& play(UnsignedInt id, T time);
+
+        /**
+         * @brief Stop given track
+         * @return Reference to self (for method chaining)
+         *
+         * The object keeps its last transformation.
+         */
+        BasicTrackAnimator3D<T>& stop(UnsignedInt id);
+
+        /** @brief Whether given track is looping */
+        bool isLooping(UnsignedInt id) const { return _flags[id] & Looping; }
+
+        /**
+         * @brief Set given track looping
+         * @return Reference to self (for method chaining)
+         *
+         * Non-looping tracks are stopped after reaching their duration.
+         * Default is `false`.
+         */
+        BasicTrackAnimator3D<T>& setLooping(UnsignedInt id, bool looping);
+
+        /** @brief Thread count */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set thread count
+         * @return Reference to self (for method chaining)
+         *
+         * Maximal count of threads used in @ref step(), `0` means all
+         * workers of @ref TaskScheduler::global(). Small track counts are
+         * always processed on the calling thread only. Default is `0`.
+         */
+        BasicTrackAnimator3D<T>& setThreadCount(UnsignedInt count) {
+            _threadCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Transformation matrices
+         *
+         * Transformations of all tracks from last @ref step(), indexed by
+         * track ID. Values for tracks that weren't playing are stale.
+         */
+        Containers::ArrayView<const Math::Matrix4<T>> transformationMatrices() const {
+            return {_transformationMatrices.data(), _transformationMatrices.size()};
+        }
+
+        /**
+         * @brief Perform animation step
+         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
+         *
+         * Samples all playing tracks, updates @ref transformationMatrices()
+         * and sets transformation of all attached objects.
+         */
+        void step(T time);
+
+    private:
+        enum: UnsignedByte {
+            Playing = 1 << 0,
+            Looping = 1 << 1
+        };
+
+        Math::Matrix4<T> sample(std::size_t id, T time);
+
+        /* Keyframes of all tracks */
+        std::vector<T> _times;
+        std::vector<Math::Vector3<T>> _translations;
+        std::vector<Math::Quaternion<T>> _rotations;
+        std::vector<Math::Vector3<T>> _scalings;
+
+        /* Per-track data */
+        std::vector<ObjectType*> _objects;
+        std::vector<std::size_t> _keyframeOffsets;
+        std::vector<UnsignedInt> _keyframeCounts;
+        std::vector<UnsignedInt> _keyframeHints;
+        std::vector<T> _startTimes;
+        std::vector<UnsignedByte> _flags;
+        std::vector<Math::Matrix4<T>> _transformationMatrices;
+
+        UnsignedInt _threadCount;
+};
+
+/**
+@brief Keyframe track animator for three-dimensional float scenes
+
+@see @ref BasicTrackAnimator3D
+*/
+typedef BasicTrackAnimator3D<Float> TrackAnimator3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicTrackAnimator3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef Magnum_SceneGraph_TrackAnimator_hpp
+#define Magnum_SceneGraph_TrackAnimator_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref TrackAnimator.h
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/TrackAnimator.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicTrackAnimator3D<T>::BasicTrackAnimator3D(): _threadCount{0} {}
+
+template<class T> UnsignedInt BasicTrackAnimator3D<T>::addTrack(ObjectType* const object, const Containers::ArrayView<const T> times, const Containers::ArrayView<const Math::Vector3<T>> translations, const Containers::ArrayView<const Math::Quaternion<T>> rotations, const Containers::ArrayView<const Math::Vector3<T>> scalings) {
+    CORRADE_ASSERT(!times.empty() && translations.size() == times.size() && rotations.size() == times.size() && scalings.size() == times.size(),
+        "SceneGraph::TrackAnimator3D::addTrack(): expected the same non-zero count of times, translations, rotations and scalings but got" << times.size() << Debug::nospace << "," << translations.size() << Debug::nospace << "," << rotations.size() << "and" << scalings.size(), {});
+
+    _keyframeOffsets.push_back(_times.size());
+    _keyframeCounts.push_back(times.size());
+    _times.insert(_times.end(), times.begin(), times.end());
+    _translations.insert(_translations.end(), translations.begin(), translations.end());
+    _rotations.insert(_rotations.end(), rotations.begin(), rotations.end());
+    _scalings.insert(_scalings.end(), scalings.begin(), scalings.end());
+
+    _objects.push_back(object);
+    _keyframeHints.push_back(0);
+    _startTimes.push_back(T(0));
+    _flags.push_back(0);
+    _transformationMatrices.push_back(sample(_objects.size() - 1, T(0)));
+
+    return _objects.size() - 1;
+}
+
+template<class T> BasicTrackAnimator3D<T>& BasicTrackAnimator3D<T>::play(const UnsignedInt id, const T time) {
+    _startTimes[id] = time;
+    _flags[id] |= Playing;
+    return *this;
+}
+
+template<class T> BasicTrackAnimator3D<T>& BasicTrackAnimator3D<T>::stop(const UnsignedInt id) {
+    _flags[id] &= ~Playing;
+    return *this;
+}
+
+template<class T> BasicTrackAnimator3D<T>& BasicTrackAnimator3D<T>::setLooping(const UnsignedInt id, const bool looping) {
+    if(looping) _flags[id] |= Looping;
+    else _flags[id] &= ~Looping;
+    return *this;
+}
+
+template<class T> void BasicTrackAnimator3D<T>::step(const T time) {
+    /* Each track touches only its own data, so they can be sampled in
+       parallel */
+    Magnum::Implementation::parallelForEach(_objects.size(), _threadCount, [this, time](const std::size_t id) {
+        if(_flags[id] & Playing)
+            _transformationMatrices[id] = sample(id, time);
+    });
+
+    /* Setting the transformation marks the object subtree dirty, which can't
+       be done from multiple threads */
+    for(std::size_t id = 0; id != _objects.size(); ++id) {
+        if(!(_flags[id] & Playing)) continue;
+
+        if(_objects[id]) _objects[id]->setTransformation(_transformationMatrices[id]);
+
+        /* Non-looping track reached its end */
+        if(!(_flags[id] & Looping) && time - _startTimes[id] >= duration(id))
+            _flags[id] &= ~Playing;
+    }
+}
+
+template<class T> Math::Matrix4<T> BasicTrackAnimator3D<T>::sample(const std::size_t id, T time) {
+    const std::size_t offset = _keyframeOffsets[id];
+    const UnsignedInt count = _keyframeCounts[id];
+    const T* const times = _times.data() + offset;
+
+    time -= _startTimes[id];
+    const T duration = times[count - 1];
+    if((_flags[id] & Looping) && duration > T(0))
+        time = std::fmod(time, duration);
+
+    /* Find the keyframe pair surrounding the time. Playback is mostly
+       sequential, so try the one from previous step first. */
+    UnsignedInt first, second;
+    T factor;
+    if(count == 1 || time <= times[0]) {
+        first = second = 0;
+        factor = T(0);
+    } else if(time >= times[count - 1]) {
+        first = second = count - 1;
+        factor = T(0);
+    } else {
+        first = _keyframeHints[id];
+        if(first + 1 >= count || !(times[first] <= time && time < times[first + 1]))
+            first = UnsignedInt(std::upper_bound(times, times + count, time) - times) - 1;
+        second = first + 1;
+        _keyframeHints[id] = first;
+        factor = (time - times[first])/(times[second] - times[first]);
+    }
+
+    const Math::Vector3<T> translation = Math::lerp(_translations[offset + first], _translations[offset + second], factor);
+    const Math::Quaternion<T> rotation = Math::slerp(_rotations[offset + first], _rotations[offset + second], factor);
+    const Math::Vector3<T> scaling = Math::lerp(_scalings[offset + first], _scalings[offset + second], factor);
+
+    return Math::Matrix4<T>::from(rotation.toMatrix(), translation)*Math::Matrix4<T>::scaling(scaling);
+}
+
+}}
+
+#endif
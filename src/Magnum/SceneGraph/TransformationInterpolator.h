@@ -0,0 +1,248 @@
+#ifndef Magnum_SceneGraph_TransformationInterpolator_h
+#define Magnum_SceneGraph_TransformationInterpolator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::TransformationInterpolator
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/DualComplex.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Translation-only transformation */
+template<std::size_t size, class T> Math::Vector<size, T> interpolateTransformation(const Math::Vector<size, T>& a, const Math::Vector<size, T>& b, Float t) {
+    return Math::lerp(a, b, t);
+}
+
+/* Rotation angle difference wrapped to shortest path */
+template<class T> T shortestAngle(T a, T b) {
+    T delta = b - a;
+    while(delta > Math::Constants<T>::pi()) delta -= T(2)*Math::Constants<T>::pi();
+    while(delta < -Math::Constants<T>::pi()) delta += T(2)*Math::Constants<T>::pi();
+    return delta;
+}
+
+template<class T> Math::DualComplex<T> interpolateTransformation(const Math::DualComplex<T>& a, const Math::DualComplex<T>& b, Float t) {
+    const T delta = shortestAngle(T(a.rotation().angle()), T(b.rotation().angle()));
+    return Math::DualComplex<T>::translation(Math::lerp(a.translation(), b.translation(), T(t)))*
+        Math::DualComplex<T>::rotation(Math::Rad<T>{T(a.rotation().angle()) + T(t)*delta});
+}
+
+template<class T> Math::DualQuaternion<T> interpolateTransformation(const Math::DualQuaternion<T>& a, const Math::DualQuaternion<T>& b, Float t) {
+    return Math::sclerp(a, b, T(t));
+}
+
+/* Matrices are decomposed into translation, rotation and scaling, which are
+   interpolated separately. Shear is not supported. */
+template<class T> Math::Matrix3<T> interpolateTransformation(const Math::Matrix3<T>& a, const Math::Matrix3<T>& b, Float t) {
+    const Math::Vector2<T> scalingA{a.right().length(), a.up().length()};
+    const Math::Vector2<T> scalingB{b.right().length(), b.up().length()};
+    const T angleA = std::atan2(a.right().y(), a.right().x());
+    const T angleB = std::atan2(b.right().y(), b.right().x());
+
+    return Math::Matrix3<T>::translation(Math::lerp(a.translation(), b.translation(), T(t)))*
+        Math::Matrix3<T>::rotation(Math::Rad<T>{angleA + T(t)*shortestAngle(angleA, angleB)})*
+        Math::Matrix3<T>::scaling(Math::lerp(scalingA, scalingB, T(t)));
+}
+
+template<class T> void decomposeTransformation(const Math::Matrix4<T>& matrix, Math::Quaternion<T>& rotation, Math::Vector3<T>& scaling) {
+    scaling = {matrix.right().length(), matrix.up().length(), matrix.backward().length()};
+    Math::Matrix3x3<T> normalized{matrix.right()/scaling.x(), matrix.up()/scaling.y(), matrix.backward()/scaling.z()};
+
+    /* Mirroring can't be represented by a quaternion, move it to scaling */
+    if(normalized.determinant() < T(0)) {
+        normalized[0] = -normalized[0];
+        scaling.x() = -scaling.x();
+    }
+
+    rotation = Math::Quaternion<T>::fromMatrix(normalized);
+}
+
+template<class T> Math::Matrix4<T> interpolateTransformation(const Math::Matrix4<T>& a, const Math::Matrix4<T>& b, Float t) {
+    Math::Quaternion<T> rotationA, rotationB;
+    Math::Vector3<T> scalingA, scalingB;
+    decomposeTransformation(a, rotationA, scalingA);
+    decomposeTransformation(b, rotationB, scalingB);
+
+    /* Shortest path */
+    if(Math::dot(rotationA, rotationB) < T(0)) rotationB = -rotationB;
+
+    Math::Matrix3x3<T> rotationScaling = Math::slerp(rotationA, rotationB, T(t)).toMatrix();
+    const Math::Vector3<T> scaling = Math::lerp(scalingA, scalingB, T(t));
+    for(std::size_t i = 0; i != 3; ++i) rotationScaling[i] *= scaling[i];
+
+    return Math::Matrix4<T>::from(rotationScaling, Math::lerp(a.translation(), b.translation(), T(t)));
+}
+
+}
+
+/**
+@brief Transformation interpolator
+
+Blends transformations of a set of objects between the last two simulation
+steps at render time. Meant to be used together with
+@ref Magnum::FixedStepTimeline "FixedStepTimeline", which runs the simulation
+at a fixed rate independent of the framerate. Without interpolation the
+objects would move only when a simulation step is run, which is visible as
+stutter whenever the framerate is not a multiple of the simulation rate.
+
+## Usage
+
+Add the simulated objects to the interpolator. Each frame, call
+@ref restore() before running the simulation steps to undo the interpolation
+done in the previous frame, @ref save() after each step to record the
+simulated transformations and @ref interpolate() with
+@ref Magnum::FixedStepTimeline::alpha() "FixedStepTimeline::alpha()" before
+drawing:
+@code
+SceneGraph::TransformationInterpolator<SceneGraph::MatrixTransformation3D> interpolator;
+interpolator.add(ship)
+    .add(asteroid);
+
+// each frame
+fixed.advance(timeline.previousFrameDuration());
+interpolator.restore();
+while(fixed.step()) {
+    // move the objects ...
+    interpolator.save();
+}
+interpolator.interpolate(fixed.alpha());
+
+camera.draw(drawables);
+@endcode
+
+The rendered state thus lags at most one simulation step behind the simulated
+one. Matrix transformations are decomposed into translation, rotation and
+scaling, which are interpolated separately, so shear is not supported. Dual
+complex numbers and dual quaternions are interpolated along the shortest path,
+translations linearly.
+
+The interpolator doesn't own the objects and doesn't track their lifetime,
+remove them using @ref remove() before they are destroyed.
+*/
+template<class Transformation> class TransformationInterpolator {
+    public:
+        /** @brief Transformation data type */
+        typedef typename Transformation::DataType DataType;
+
+        /** @brief Constructor */
+        explicit TransformationInterpolator() = default;
+
+        /** @brief Count of objects */
+        std::size_t size() const { return _objects.size(); }
+
+        /** @brief Whether the interpolator is empty */
+        bool isEmpty() const { return _objects.empty(); }
+
+        /**
+         * @brief Add an object
+         * @return Reference to self (for method chaining)
+         *
+         * The current transformation is used as both previous and current
+         * simulated state.
+         */
+        TransformationInterpolator<Transformation>& add(Object<Transformation>& object) {
+            const DataType transformation = object.transformation();
+            _objects.push_back({&object, transformation, transformation});
+            return *this;
+        }
+
+        /**
+         * @brief Remove an object
+         * @return Reference to self (for method chaining)
+         *
+         * Does nothing if the object was not added.
+         */
+        TransformationInterpolator<Transformation>& remove(Object<Transformation>& object) {
+            _objects.erase(std::remove_if(_objects.begin(), _objects.end(),
+                [&object](const Entry& entry) { return entry.object == &object; }), _objects.end());
+            return *this;
+        }
+
+        /**
+         * @brief Save simulated state
+         *
+         * Call after each simulation step. The transformation saved by the
+         * previous call becomes the previous state and the current object
+         * transformation the current state.
+         */
+        void save() {
+            for(Entry& entry: _objects) {
+                entry.previous = entry.current;
+                entry.current = entry.object->transformation();
+            }
+        }
+
+        /**
+         * @brief Restore simulated state
+         *
+         * Sets object transformations back to the state saved by the last
+         * @ref save(), undoing the effect of @ref interpolate(). Call before
+         * running the simulation steps.
+         */
+        void restore() {
+            for(Entry& entry: _objects)
+                entry.object->setTransformation(entry.current);
+        }
+
+        /**
+         * @brief Interpolate the transformations
+         * @param alpha     Interpolation factor in range @f$ [0, 1] @f$
+         *
+         * Sets each object transformation to a blend of the previous and
+         * current simulated state, @p alpha of `0.0f` being the previous
+         * state.
+         */
+        void interpolate(Float alpha) {
+            for(Entry& entry: _objects)
+                entry.object->setTransformation(Implementation::interpolateTransformation(entry.previous, entry.current, alpha));
+        }
+
+    private:
+        struct Entry {
+            Object<Transformation>* object;
+            DataType previous, current;
+        };
+
+        std::vector<Entry> _objects;
+};
+
+}}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransformationPalette.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Camera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions> TransformationPalette<dimensions>::TransformationPalette(const BufferUsage usage): _usage{usage} {}
+
+template<UnsignedInt dimensions> TransformationPalette<dimensions>& TransformationPalette<dimensions>::clear() {
+    _texels.clear();
+    return *this;
+}
+
+template<UnsignedInt dimensions> UnsignedInt TransformationPalette<dimensions>::add(Camera<dimensions, Float>& camera, DrawableGroup<dimensions, Float>& group) {
+    const UnsignedInt offset = size();
+
+    camera.drawableTransformationMatrices(group, _matrices);
+
+    /* One RGBA texel per column, 2D columns padded with zero */
+    _texels.reserve(_texels.size() + _matrices.size()*(dimensions + 1));
+    for(const MatrixTypeFor<dimensions, Float>& matrix: _matrices)
+        for(std::size_t i = 0; i != dimensions + 1; ++i)
+            _texels.push_back(Vector4::pad(matrix[i]));
+
+    return offset;
+}
+
+template<UnsignedInt dimensions> TransformationPalette<dimensions>& TransformationPalette<dimensions>::upload() {
+    CORRADE_ASSERT(_texels.size() <= std::size_t(BufferTexture::maxSize()),
+        "SceneGraph::TransformationPalette::upload(): expected at most" << BufferTexture::maxSize() << "texels, got" << _texels.size(), *this);
+
+    /* Respecifying the whole storage orphans the previous one */
+    _buffer.setData(_texels, _usage);
+    _texture.setBuffer(BufferTextureFormat::RGBA32F, _buffer);
+    return *this;
+}
+
+template class TransformationPalette<2>;
+template class TransformationPalette<3>;
+
+}}
@@ -0,0 +1,191 @@
+#ifndef Magnum_SceneGraph_TransformationPalette_h
+#define Magnum_SceneGraph_TransformationPalette_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::TransformationPalette, typedef @ref Magnum::SceneGraph::TransformationPalette2D, @ref Magnum::SceneGraph::TransformationPalette3D
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/BufferTexture.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Transformation palette
+
+Collects transformations of drawables relative to the camera into a
+@ref BufferTexture, from which they are fetched by
+@ref Shaders::Phong::Flag::TransformationTexture "Shaders::Phong" and
+@ref Shaders::Flat::Flag::TransformationTexture "Shaders::Flat" shaders.
+Unlike per-instance vertex attributes, a single palette can hold the
+transformations of all instanced groups in the scene and is limited only by
+@ref BufferTexture::maxSize(), which makes it suitable for tens of thousands
+of moving objects on GL 3 class hardware.
+
+## Usage
+
+Each frame, @ref clear() the palette, @ref add() all groups drawn with the
+palette and @ref upload() it. Each draw then uses the offset returned from
+@ref add() and draws as many instances as there were drawables in the group:
+@code
+SceneGraph::TransformationPalette3D palette;
+Shaders::Phong shader{Shaders::Phong::Flag::TransformationTexture};
+
+void MyApplication::drawEvent() {
+    palette.clear();
+    const UnsignedInt rocks = palette.add(camera, rockDrawables);
+    const UnsignedInt trees = palette.add(camera, treeDrawables);
+    palette.upload();
+
+    shader.setTransformationTexture(palette.texture())
+        .setProjectionMatrix(camera.projectionMatrix());
+    shader.setTransformationTextureOffset(rocks);
+    rockMesh.setInstanceCount(rockDrawables.size())
+        .draw(shader);
+    shader.setTransformationTextureOffset(trees);
+    treeMesh.setInstanceCount(treeDrawables.size())
+        .draw(shader);
+
+    // ...
+}
+@endcode
+
+The data are stored in @ref BufferTextureFormat::RGBA32F format, with one
+texel per matrix column. Columns of 2D matrices are padded to four
+components. The buffer is orphaned on each @ref upload(), so the driver can
+hand out new storage instead of waiting for draws using the previous frame's
+data to finish.
+
+@requires_gl31 Extension @extension{ARB,texture_buffer_object}
+@requires_gles31 Extension @es_extension{EXT,texture_buffer}
+@requires_gles Buffer textures are not available in WebGL.
+@see @ref TransformationPalette2D, @ref TransformationPalette3D,
+    @ref SceneGraph-Drawable-instanced
+*/
+template<UnsignedInt dimensions> class MAGNUM_SCENEGRAPH_EXPORT TransformationPalette {
+    public:
+        /**
+         * @brief Constructor
+         * @param usage     Buffer usage passed to @ref Buffer::setData()
+         *
+         * Requires an active context.
+         */
+        explicit TransformationPalette(BufferUsage usage = BufferUsage::StreamDraw);
+
+        /** @brief Copying is not allowed */
+        TransformationPalette(const TransformationPalette<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        TransformationPalette(TransformationPalette<dimensions>&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        TransformationPalette<dimensions>& operator=(const TransformationPalette<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        TransformationPalette<dimensions>& operator=(TransformationPalette<dimensions>&&) noexcept = default;
+
+        /** @brief Count of matrices in the palette */
+        UnsignedInt size() const { return _texels.size()/(dimensions + 1); }
+
+        /**
+         * @brief Clear the palette
+         * @return Reference to self (for method chaining)
+         *
+         * Doesn't free the memory, so filling the palette again in the next
+         * frame doesn't allocate.
+         */
+        TransformationPalette<dimensions>& clear();
+
+        /**
+         * @brief Add transformations of a drawable group
+         * @return Offset of the first transformation of the group
+         *
+         * Appends transformations of all drawables in @p group relative to
+         * @p camera, in the same order as in the group, using
+         * @ref Camera::drawableTransformationMatrices(). Pass the returned
+         * offset to @ref Shaders::Phong::setTransformationTextureOffset() or
+         * @ref Shaders::Flat::setTransformationTextureOffset().
+         */
+        UnsignedInt add(Camera<dimensions, Float>& camera, DrawableGroup<dimensions, Float>& group);
+
+        /**
+         * @brief Upload the palette
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the palette fits into @ref BufferTexture::maxSize()
+         * texels. Needs to be called after all @ref add() calls and before
+         * drawing.
+         */
+        TransformationPalette<dimensions>& upload();
+
+        /** @brief Buffer with the palette data */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Buffer texture to pass to the shader */
+        BufferTexture& texture() { return _texture; }
+
+    private:
+        BufferUsage _usage;
+        Buffer _buffer;
+        BufferTexture _texture;
+        std::vector<Vector4> _texels;
+        std::vector<MatrixTypeFor<dimensions, Float>> _matrices;
+};
+
+/**
+@brief Transformation palette for two-dimensional scenes
+
+@requires_gl31 Extension @extension{ARB,texture_buffer_object}
+@requires_gles31 Extension @es_extension{EXT,texture_buffer}
+@requires_gles Buffer textures are not available in WebGL.
+*/
+typedef TransformationPalette<2> TransformationPalette2D;
+
+/**
+@brief Transformation palette for three-dimensional scenes
+
+@requires_gl31 Extension @extension{ARB,texture_buffer_object}
+@requires_gles31 Extension @es_extension{EXT,texture_buffer}
+@requires_gles Buffer textures are not available in WebGL.
+*/
+typedef TransformationPalette<3> TransformationPalette3D;
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -807,22 +807,43 @@ Shader& Shader::addFile(const std::string& filename) {
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Shader& Shader::setSpirvBinary(const Containers::ArrayView<const char> binary, std::string entryPoint) {
+    CORRADE_ASSERT(!entryPoint.empty(),
+        "Shader::setSpirvBinary(): empty entry point name", *this);
+
+    glShaderBinary(1, &_id, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, binary.data(), binary.size());
+    _spirvEntryPoint = std::move(entryPoint);
+    return *this;
+}
+#endif
+
 bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
-    bool allSuccess = true;
+    submitCompile(shaders);
+    return checkCompile(shaders);
+}
 
+void Shader::submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
     /* Allocate large enough array for source pointers and sizes (to avoid
        reallocating it for each of them) */
     std::size_t maxSourceCount = 0;
     for(Shader& shader: shaders) {
-        CORRADE_ASSERT(shader._sources.size() > 1, "Shader::compile(): no files added", false);
+        #ifndef MAGNUM_TARGET_GLES
+        if(shader.isSpirv()) continue;
+        #endif
+        CORRADE_ASSERT(shader._sources.size() > 1, "Shader::compile(): no files added", );
         maxSourceCount = std::max(shader._sources.size(), maxSourceCount);
     }
     /** @todo ArrayTuple/VLAs */
     Containers::Array<const GLchar*> pointers(maxSourceCount);
     Containers::Array<GLint> sizes(maxSourceCount);
 
-    /* Upload sources of all shaders */
+    /* Upload sources of all shaders, SPIR-V binaries were already uploaded
+       in setSpirvBinary() */
     for(Shader& shader: shaders) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(shader.isSpirv()) continue;
+        #endif
         for(std::size_t i = 0; i != shader._sources.size(); ++i) {
             pointers[i] = static_cast<const GLchar*>(shader._sources[i].data());
             sizes[i] = shader._sources[i].size();
@@ -831,8 +852,22 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
         glShaderSource(shader._id, shader._sources.size(), pointers, sizes);
     }
 
-    /* Invoke (possibly parallel) compilation on all shaders */
-    for(Shader& shader: shaders) glCompileShader(shader._id);
+    /* Invoke (possibly parallel) compilation on all shaders. SPIR-V
+       binaries are only specialized, the compile status is queried the same
+       way afterwards. */
+    for(Shader& shader: shaders) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(shader.isSpirv()) {
+            glSpecializeShaderARB(shader._id, shader._spirvEntryPoint.data(), 0, nullptr, nullptr);
+            continue;
+        }
+        #endif
+        glCompileShader(shader._id);
+    }
+}
+
+bool Shader::checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
+    bool allSuccess = true;
 
     /* After compilation phase, check status of all shaders */
     Int i = 1;
@@ -889,6 +924,20 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
     return allSuccess;
 }
 
+bool Shader::isCompileFinished() {
+    #if !defined(MAGNUM_TARGET_WEBGL) && !defined(CORRADE_TARGET_NACL)
+    if(Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>()) {
+        GLint finished;
+        glGetShaderiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+        return finished == GL_TRUE;
+    }
+    #endif
+
+    /* Status query in checkCompile() will block until the compilation is
+       done */
+    return true;
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Shader::Type value) {
     switch(value) {
@@ -507,6 +507,33 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         static bool compile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
 
+        /**
+         * @brief Submit multiple shaders for compilation
+         *
+         * Uploads the sources and starts compilation of all @p shaders
+         * without waiting for the result. Use @ref isCompileFinished() to
+         * check whether the compilation finished and @ref checkCompile() to
+         * retrieve the result. The shaders can be attached and linked
+         * right after the submission, see
+         * @ref AbstractShaderProgram-async "AbstractShaderProgram documentation"
+         * for more information.
+         * @see @ref compile(), @fn_gl{ShaderSource}, @fn_gl{CompileShader}
+         */
+        static void submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
+        /**
+         * @brief Check compilation status of multiple shaders
+         *
+         * Expects that the shaders were submitted with @ref submitCompile().
+         * Returns `false` if compilation of any shader failed, `true` if
+         * everything succeeded. Compiler messages (if any) are printed to
+         * error output. Blocks until the compilation finishes.
+         * @see @ref isCompileFinished(), @fn_gl{GetShader} with
+         *      @def_gl{COMPILE_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl{GetShaderInfoLog}
+         */
+        static bool checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
         /**
          * @brief Constructor
          * @param version   Target version
@@ -610,6 +637,40 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         Shader& addFile(const std::string& filename);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set SPIR-V binary
+         * @param binary        SPIR-V module
+         * @param entryPoint    Name of the entry point in the module
+         * @return Reference to self (for method chaining)
+         *
+         * Uploads the module right away. @ref compile() and
+         * @ref submitCompile() then specialize the shader instead of
+         * compiling the sources, skipping the GLSL front-end entirely.
+         * Sources added with @ref addSource() are not uploaded but are kept,
+         * so they can still be used to identify the shader, for example in
+         * @ref ProgramBinaryCache::key(). The module is expected to use
+         * explicit attribute, uniform and binding locations, as names of
+         * program resources might not be available.
+         * @see @ref isSpirv(), @fn_gl{ShaderBinary} with
+         *      @def_gl{SHADER_BINARY_FORMAT_SPIR_V_ARB},
+         *      @fn_gl_extension{SpecializeShader,ARB,gl_spirv}
+         * @requires_extension Extension @extension{ARB,gl_spirv}
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Shader& setSpirvBinary(Containers::ArrayView<const char> binary, std::string entryPoint = "main");
+
+        /**
+         * @brief Whether the shader is a SPIR-V binary
+         *
+         * @see @ref setSpirvBinary()
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        bool isSpirv() const { return !_spirvEntryPoint.empty(); }
+        #endif
+
         /**
          * @brief Compile shader
          *
@@ -620,6 +681,18 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         bool compile() { return compile({*this}); }
 
+        /**
+         * @brief Whether compilation finished
+         *
+         * If @extension{KHR,parallel_shader_compile} is available, queries
+         * the completion status without blocking. Otherwise always returns
+         * `true` and the status check in @ref checkCompile() blocks until
+         * the compilation is done.
+         * @see @ref submitCompile(), @fn_gl{GetShader} with
+         *      @def_gl{COMPLETION_STATUS_KHR}
+         */
+        bool isCompileFinished();
+
     private:
         Shader& setLabelInternal(Containers::ArrayView<const char> label);
 
@@ -627,12 +700,19 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
         GLuint _id;
 
         std::vector<std::string> _sources;
+        #ifndef MAGNUM_TARGET_GLES
+        std::string _spirvEntryPoint;
+        #endif
 };
 
 /** @debugoperatorclassenum{Magnum::Shader,Magnum::Shader::Type} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Shader::Type value);
 
-inline Shader::Shader(Shader&& other) noexcept: _type(other._type), _id(other._id), _sources(std::move(other._sources)) {
+inline Shader::Shader(Shader&& other) noexcept: _type(other._type), _id(other._id), _sources(std::move(other._sources))
+    #ifndef MAGNUM_TARGET_GLES
+    , _spirvEntryPoint(std::move(other._spirvEntryPoint))
+    #endif
+{
     other._id = 0;
 }
 
@@ -641,6 +721,9 @@ inline Shader& Shader::operator=(Shader&& other) noexcept {
     swap(_type, other._type);
     swap(_id, other._id);
     swap(_sources, other._sources);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_spirvEntryPoint, other._spirvEntryPoint);
+    #endif
     return *this;
 }
 
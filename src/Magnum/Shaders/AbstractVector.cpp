@@ -26,6 +26,9 @@
 #include "AbstractVector.h"
 
 #include "Magnum/Texture.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#endif
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
@@ -35,6 +38,13 @@ template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dime
     return *this;
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dimensions>::setGlyphRectangleTexture(BufferTexture& texture) {
+    texture.bind(GlyphRectangleTextureLayer);
+    return *this;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHADERS_EXPORT AbstractVector<2>;
 template class MAGNUM_SHADERS_EXPORT AbstractVector<3>;
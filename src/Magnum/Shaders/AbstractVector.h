@@ -56,14 +56,65 @@ template<UnsignedInt dimensions> class AbstractVector: public AbstractShaderProg
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Glyph position
+         *
+         * Per-instance bottom left corner of the glyph quad, @ref Vector2.
+         * Used instead of @ref Position and @ref TextureCoordinates if the
+         * shader is created with instanced glyphs enabled, see for example
+         * @ref Vector::Flag::InstancedGlyphs.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Instanced arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        typedef Attribute<4, Vector2> GlyphPosition;
+
+        /**
+         * @brief Glyph rectangle ID
+         *
+         * Per-instance index into the texture set via
+         * @ref setGlyphRectangleTexture(), @ref UnsignedInt.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Instanced arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        typedef Attribute<5, UnsignedInt> GlyphRectangleId;
+        #endif
+
         /**
          * @brief Set vector texture
          * @return Reference to self (for method chaining)
          */
         AbstractVector<dimensions>& setVectorTexture(Texture2D& texture);
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set glyph rectangle texture
+         * @return Reference to self (for method chaining)
+         *
+         * Used only if the shader is created with instanced glyphs enabled.
+         * Expects a @ref BufferTextureFormat::RGBA32F texture with two texels
+         * for each glyph rectangle ID --- texture coordinate rectangle
+         * (bottom left and top right corner) in the first and quad size in
+         * the first two components of the second. See
+         * @ref Text::InstancedRenderer for an implementation.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        AbstractVector<dimensions>& setGlyphRectangleTexture(BufferTexture& texture);
+        #endif
+
     protected:
-        enum: Int { VectorTextureLayer = 15 };
+        enum: Int {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            GlyphRectangleTextureLayer = 14,
+            #endif
+            VectorTextureLayer = 15
+        };
 
         explicit AbstractVector() = default;
         ~AbstractVector() = default;
@@ -33,6 +33,22 @@ layout(location = 0)
 #endif
 uniform highp mat4 transformationProjectionMatrix;
 
+#ifdef INSTANCED_GLYPHS
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 14)
+#endif
+uniform highp samplerBuffer glyphRectangles;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_POSITION_ATTRIBUTE_LOCATION)
+#endif
+in highp vec2 glyphPosition;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_RECTANGLE_ID_ATTRIBUTE_LOCATION)
+#endif
+in highp uint glyphRectangleId;
+#else
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -42,10 +58,22 @@ in highp vec4 position;
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
+#endif
 
 out mediump vec2 fragmentTextureCoordinates;
 
 void main() {
+    #ifdef INSTANCED_GLYPHS
+    /* Quad drawn as a triangle strip, vertex 0 is bottom left, 3 top right.
+       The glyph table has texture coordinate rectangle in the first texel
+       and quad size in the second. */
+    highp vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    highp vec4 textureRectangle = texelFetch(glyphRectangles, int(glyphRectangleId)*2);
+    highp vec2 quadSize = texelFetch(glyphRectangles, int(glyphRectangleId)*2 + 1).xy;
+    highp vec4 position = vec4(glyphPosition + corner*quadSize, 0.0, 1.0);
+    mediump vec2 textureCoordinates = mix(textureRectangle.xy, textureRectangle.zw, corner);
+    #endif
+
     gl_Position = transformationProjectionMatrix*position;
     fragmentTextureCoordinates = textureCoordinates;
 }
@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DeferredGeometry.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int { DiffuseTextureLayer = 0 };
+}
+
+DeferredGeometry::DeferredGeometry(const Flags flags): _flags{flags} {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL300);
+    const Version version = Context::current().supportedVersion({Version::GL330, Version::GL300});
+    #else
+    const Version version = Version::GLES300;
+    #endif
+
+    Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+
+    vert.addSource(flags & Flag::DiffuseTexture ? "#define TEXTURED\n" : "")
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("DeferredGeometry.vert"));
+    frag.addSource(flags & Flag::DiffuseTexture ? "#define DIFFUSE_TEXTURE\n" : "")
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("DeferredGeometry.frag"));
+
+    if(!loadCachedBinary({vert, frag})) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version)) {
+            bindAttributeLocation(Position::Location, "position");
+            bindAttributeLocation(Normal::Location, "normal");
+            if(flags & Flag::DiffuseTexture)
+                bindAttributeLocation(TextureCoordinates::Location, "textureCoords");
+            bindFragmentDataLocation(AlbedoOutput, "albedo");
+            bindFragmentDataLocation(NormalOutput, "packedNormal");
+            bindFragmentDataLocation(MaterialOutput, "material");
+        }
+        #endif
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({vert, frag});
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationMatrixUniform = uniformLocation("transformationMatrix");
+        _projectionMatrixUniform = uniformLocation("projectionMatrix");
+        _normalMatrixUniform = uniformLocation("normalMatrix");
+        _diffuseColorUniform = uniformLocation("diffuseColor");
+        _specularIntensityUniform = uniformLocation("specularIntensity");
+        _shininessUniform = uniformLocation("shininess");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::DiffuseTexture && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #else
+    if(flags & Flag::DiffuseTexture)
+    #endif
+    {
+        setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
+    }
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setDiffuseColor(Color3{1.0f});
+    setSpecularIntensity(1.0f);
+    setShininess(80.0f);
+    #endif
+}
+
+DeferredGeometry& DeferredGeometry::setDiffuseTexture(Texture2D& texture) {
+    if(_flags & Flag::DiffuseTexture) texture.bind(DiffuseTextureLayer);
+    return *this;
+}
+
+}}
@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform lowp vec3 diffuseColor
+    #ifndef GL_ES
+    = vec3(1.0)
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 4)
+#endif
+uniform lowp float specularIntensity
+    #ifndef GL_ES
+    = 1.0
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 5)
+#endif
+uniform mediump float shininess
+    #ifndef GL_ES
+    = 80.0
+    #endif
+    ;
+
+#ifdef DIFFUSE_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform lowp sampler2D diffuseTexture;
+
+in mediump vec2 interpolatedTextureCoords;
+#endif
+
+in mediump vec3 transformedNormal;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0)
+#endif
+out lowp vec4 albedo;
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 1)
+#endif
+out mediump vec2 packedNormal;
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 2)
+#endif
+out lowp vec2 material;
+
+/* Octahedral normal encoding, unpacked in DeferredLight.frag */
+mediump vec2 packNormal(mediump vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx))*vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n.xy;
+}
+
+void main() {
+    albedo = vec4(
+        #ifdef DIFFUSE_TEXTURE
+        texture(diffuseTexture, interpolatedTextureCoords).rgb*
+        #endif
+        diffuseColor, 1.0);
+    packedNormal = packNormal(normalize(transformedNormal));
+    material = vec2(specularIntensity, shininess/256.0);
+}
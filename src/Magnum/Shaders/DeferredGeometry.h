@@ -0,0 +1,265 @@
+#ifndef Magnum_Shaders_DeferredGeometry_h
+#define Magnum_Shaders_DeferredGeometry_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::DeferredGeometry
+ */
+#endif
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+namespace Implementation {
+    enum class DeferredGeometryFlag: UnsignedByte {
+        DiffuseTexture = 1 << 0
+    };
+    typedef Containers::EnumSet<DeferredGeometryFlag> DeferredGeometryFlags;
+}
+
+/**
+@brief Deferred shading G-buffer shader
+
+Fills the G-buffer for deferred shading with @ref DeferredLight and
+@ref DeferredResolve. Unlike @ref Phong it doesn't do any lighting, it just
+writes the surface properties into three color outputs:
+
+-   @ref AlbedoOutput --- diffuse color in RGB, expected to be attached to a
+    @ref TextureFormat::RGBA8 texture
+-   @ref NormalOutput --- camera-space normal packed into two components
+    using octahedral encoding, expected to be attached to a
+    @ref TextureFormat::RG16F texture
+-   @ref MaterialOutput --- specular intensity and shininess divided by
+    `256.0f`, expected to be attached to a @ref TextureFormat::RG8 texture
+
+Camera-space position is reconstructed from the depth buffer in the light
+pass, so it's not stored. The lighting cost then doesn't depend on the
+scene complexity, each light shades only the pixels its light volume covers.
+
+## Example usage
+
+G-buffer setup, the depth attachment has also a stencil component for the
+light volume culling in @ref DeferredLight:
+@code
+Texture2D albedo, normal, material, depthStencil, light;
+albedo.setStorage(1, TextureFormat::RGBA8, size);
+normal.setStorage(1, TextureFormat::RG16F, size);
+material.setStorage(1, TextureFormat::RG8, size);
+depthStencil.setStorage(1, TextureFormat::Depth24Stencil8, size);
+light.setStorage(1, TextureFormat::RGBA16F, size);
+
+Framebuffer gbuffer{{{}, size}};
+gbuffer.attachTexture(Framebuffer::ColorAttachment{0}, albedo, 0)
+    .attachTexture(Framebuffer::ColorAttachment{1}, normal, 0)
+    .attachTexture(Framebuffer::ColorAttachment{2}, material, 0)
+    .attachTexture(Framebuffer::BufferAttachment::DepthStencil, depthStencil, 0)
+    .mapForDraw({{Shaders::DeferredGeometry::AlbedoOutput, Framebuffer::ColorAttachment{0}},
+                 {Shaders::DeferredGeometry::NormalOutput, Framebuffer::ColorAttachment{1}},
+                 {Shaders::DeferredGeometry::MaterialOutput, Framebuffer::ColorAttachment{2}}});
+@endcode
+
+Geometry pass:
+@code
+Shaders::DeferredGeometry shader;
+
+gbuffer.clear(FramebufferClear::Color|FramebufferClear::Depth|FramebufferClear::Stencil)
+    .bind();
+shader.setDiffuseColor(Color3::fromHSV(216.0_degf, 0.85f, 1.0f))
+    .setSpecularIntensity(0.5f)
+    .setShininess(80.0f)
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.rotation())
+    .setProjectionMatrix(projectionMatrix);
+mesh.draw(shader);
+@endcode
+
+See @ref DeferredLight and @ref DeferredResolve for the rest of the pipeline.
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4}
+@requires_gles30 Multiple render targets are not available in OpenGL ES
+    2.0.
+@requires_webgl20 Multiple render targets are not available in WebGL 1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT DeferredGeometry: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3.
+         */
+        typedef Generic3D::Position Position;
+
+        /**
+         * @brief Normal direction
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3.
+         */
+        typedef Generic3D::Normal Normal;
+
+        /**
+         * @brief 2D texture coordinates
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector2, used only if
+         * @ref Flag::DiffuseTexture is set.
+         */
+        typedef Generic3D::TextureCoordinates TextureCoordinates;
+
+        enum: UnsignedInt {
+            AlbedoOutput = 0,   /**< Albedo output */
+            NormalOutput = 1,   /**< Packed normal output */
+            MaterialOutput = 2  /**< Material output */
+        };
+
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /** The shader multiplies diffuse color with a texture */
+            DiffuseTexture = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::DeferredGeometryFlag Flag;
+        typedef Implementation::DeferredGeometryFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DeferredGeometry(Flags flags = {});
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set transformation matrix
+         * @return Reference to self (for method chaining)
+         */
+        DeferredGeometry& setTransformationMatrix(const Matrix4& matrix) {
+            setUniform(_transformationMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set normal matrix
+         * @return Reference to self (for method chaining)
+         */
+        DeferredGeometry& setNormalMatrix(const Matrix3x3& matrix) {
+            setUniform(_normalMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         */
+        DeferredGeometry& setProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_projectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set diffuse color
+         * @return Reference to self (for method chaining)
+         *
+         * If not set, default value is `{1.0f, 1.0f, 1.0f}`. The color is
+         * multiplied with diffuse texture if @ref Flag::DiffuseTexture is
+         * set.
+         */
+        DeferredGeometry& setDiffuseColor(const Color3& color) {
+            setUniform(_diffuseColorUniform, color);
+            return *this;
+        }
+
+        /**
+         * @brief Set diffuse texture
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if @ref Flag::DiffuseTexture is set.
+         */
+        DeferredGeometry& setDiffuseTexture(Texture2D& texture);
+
+        /**
+         * @brief Set specular intensity
+         * @return Reference to self (for method chaining)
+         *
+         * If not set, default value is `1.0f`.
+         */
+        DeferredGeometry& setSpecularIntensity(Float intensity) {
+            setUniform(_specularIntensityUniform, intensity);
+            return *this;
+        }
+
+        /**
+         * @brief Set shininess
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be in range @f$ [0, 255] @f$. If not set, default
+         * value is `80.0f`.
+         */
+        DeferredGeometry& setShininess(Float shininess) {
+            setUniform(_shininessUniform, shininess);
+            return *this;
+        }
+
+    private:
+        Flags _flags;
+        Int _transformationMatrixUniform{0},
+            _projectionMatrixUniform{1},
+            _normalMatrixUniform{2},
+            _diffuseColorUniform{3},
+            _specularIntensityUniform{4},
+            _shininessUniform{5};
+};
+
+CORRADE_ENUMSET_OPERATORS(Implementation::DeferredGeometryFlags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
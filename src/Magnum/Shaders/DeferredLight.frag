@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp mat4 inverseProjectionMatrix;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp vec2 viewportSize;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform lowp sampler2D albedoTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform mediump sampler2D normalTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 2)
+#endif
+uniform lowp sampler2D materialTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 3)
+#endif
+uniform highp sampler2D depthTexture;
+
+flat in highp vec4 interpolatedLightPosition;
+flat in lowp vec3 interpolatedLightColor;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out lowp vec4 color;
+
+/* Inverse of packNormal() in DeferredGeometry.frag */
+mediump vec3 unpackNormal(mediump vec2 e) {
+    mediump vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if(n.z < 0.0) n.xy = (1.0 - abs(n.yx))*vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    /* Reconstruct camera-space position from depth */
+    highp vec4 position = inverseProjectionMatrix*vec4(
+        gl_FragCoord.xy/viewportSize*2.0 - vec2(1.0),
+        texelFetch(depthTexture, pixel, 0).r*2.0 - 1.0, 1.0);
+    position.xyz /= position.w;
+
+    /* Smooth falloff reaching zero at light range */
+    highp vec3 lightDirection = interpolatedLightPosition.xyz - position.xyz;
+    highp float distanceSquared = dot(lightDirection, lightDirection);
+    highp float falloff = clamp(1.0 - distanceSquared/(interpolatedLightPosition.w*interpolatedLightPosition.w), 0.0, 1.0);
+    falloff *= falloff;
+    if(falloff == 0.0) discard;
+
+    lowp vec3 albedo = texelFetch(albedoTexture, pixel, 0).rgb;
+    mediump vec3 normal = unpackNormal(texelFetch(normalTexture, pixel, 0).rg);
+    lowp vec2 material = texelFetch(materialTexture, pixel, 0).rg;
+
+    /* Diffuse */
+    mediump vec3 normalizedLightDirection = normalize(lightDirection);
+    lowp float intensity = max(0.0, dot(normal, normalizedLightDirection));
+    lowp vec3 result = albedo*interpolatedLightColor*intensity;
+
+    /* Specular, the camera is at origin */
+    if(intensity > 0.001) {
+        highp vec3 reflection = reflect(-normalizedLightDirection, normal);
+        mediump float specularity = pow(max(0.0, dot(normalize(-position.xyz), reflection)), material.g*256.0);
+        result += interpolatedLightColor*material.r*specularity;
+    }
+
+    color = vec4(result*falloff, 1.0);
+}
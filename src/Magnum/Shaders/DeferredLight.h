@@ -0,0 +1,219 @@
+#ifndef Magnum_Shaders_DeferredLight_h
+#define Magnum_Shaders_DeferredLight_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::DeferredLight
+ */
+#endif
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Deferred shading light volume shader
+
+Accumulates contribution of point lights using a G-buffer filled by
+@ref DeferredGeometry. Each light is drawn as a proxy sphere mesh covering
+its range, so only pixels inside the light volume are shaded. The proxy is
+expected to be a mesh with unit radius, such as @ref Primitives::Icosphere,
+the shader scales it so even the coarsest icosphere with no subdivisions
+fully contains the light range. Light positions and ranges are passed as
+per-instance @ref LightPosition attribute and light colors as per-instance
+@ref LightColor attribute, so all lights can be drawn in one instanced draw
+call. The lights are expected to be in camera space. Light intensity falls
+off smoothly with distance and reaches zero at the light range.
+
+The output is meant to be additively blended into a light accumulation
+buffer, which is then combined with the albedo in @ref DeferredResolve.
+
+## Example usage
+
+Common setup, using the G-buffer from the @ref DeferredGeometry example:
+@code
+struct Light {
+    Vector4 positionRange;
+    Color3 color;
+};
+std::vector<Light> lights;
+
+Buffer lightBuffer;
+Mesh sphere = MeshTools::compile(Primitives::Icosphere::solid(1), BufferUsage::StaticDraw);
+sphere.addVertexBufferInstanced(lightBuffer, 1, 0,
+    Shaders::DeferredLight::LightPosition{},
+    Shaders::DeferredLight::LightColor{});
+
+Framebuffer lightFramebuffer{{{}, size}};
+lightFramebuffer.attachTexture(Framebuffer::ColorAttachment{0}, light, 0)
+    .attachTexture(Framebuffer::BufferAttachment::DepthStencil, depthStencil, 0);
+
+Shaders::DeferredLight shader;
+@endcode
+
+Light pass. Drawing back faces of the light volumes with reversed depth test
+skips pixels where the scene is in front of the whole volume and, unlike
+front faces, works also when the camera is inside the volume:
+@code
+lightBuffer.setData(lights, BufferUsage::StreamDraw);
+sphere.setInstanceCount(lights.size());
+
+lightFramebuffer.clearColor(0, Color4{0.0f})
+    .bind();
+Renderer::setDepthMask(false);
+Renderer::setDepthFunction(Renderer::DepthFunction::GreaterOrEqual);
+Renderer::setFaceCullingMode(Renderer::PolygonFacing::Front);
+Renderer::enable(Renderer::Feature::Blending);
+Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::One);
+
+shader.setProjectionMatrix(projectionMatrix)
+    .setViewportSize(size)
+    .setGBufferTextures(albedo, normal, material, depthStencil);
+sphere.draw(shader);
+@endcode
+
+### Stencil culling
+
+The depth test above doesn't reject pixels where the scene is behind the
+whole light volume. For large lights covering a lot of the screen this can
+be done with a stencil pre-pass for each light, drawn with
+@ref MeshView::setInstanceRange() "a single instance". The first pass marks
+pixels where the scene is inside the volume without writing any color, the
+second shades only the marked pixels and resets the stencil back to zero:
+@code
+Renderer::enable(Renderer::Feature::StencilTest);
+for(std::size_t i = 0; i != lights.size(); ++i) {
+    // ...set up a single-instance view of the sphere for light i
+
+    Renderer::setColorMask(false, false, false, false);
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+    Renderer::disable(Renderer::Feature::FaceCulling);
+    Renderer::setStencilFunction(Renderer::StencilFunction::Always, 0, 0xff);
+    Renderer::setStencilOperation(Renderer::PolygonFacing::Back,
+        Renderer::StencilOperation::Keep, Renderer::StencilOperation::IncrementWrap, Renderer::StencilOperation::Keep);
+    Renderer::setStencilOperation(Renderer::PolygonFacing::Front,
+        Renderer::StencilOperation::Keep, Renderer::StencilOperation::DecrementWrap, Renderer::StencilOperation::Keep);
+    view.draw(shader);
+
+    Renderer::setColorMask(true, true, true, true);
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::enable(Renderer::Feature::FaceCulling);
+    Renderer::setFaceCullingMode(Renderer::PolygonFacing::Front);
+    Renderer::setStencilFunction(Renderer::StencilFunction::NotEqual, 0, 0xff);
+    Renderer::setStencilOperation(Renderer::StencilOperation::Zero,
+        Renderer::StencilOperation::Zero, Renderer::StencilOperation::Zero);
+    view.draw(shader);
+}
+@endcode
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4}
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Multiple render targets are not available in OpenGL ES
+    2.0.
+@requires_webgl20 Multiple render targets are not available in WebGL 1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT DeferredLight: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Light proxy vertex position
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3.
+         */
+        typedef Generic3D::Position Position;
+
+        /**
+         * @brief Light position and range
+         *
+         * Per-instance @ref Vector4 attribute, camera-space light position
+         * in XYZ and light range in W.
+         */
+        typedef Attribute<4, Vector4> LightPosition;
+
+        /**
+         * @brief Light color
+         *
+         * @ref shaders-generic "Generic attribute", per-instance
+         * @ref Color3.
+         */
+        typedef Generic3D::Color LightColor;
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always.
+             */
+            ColorOutput = Generic3D::ColorOutput
+        };
+
+        explicit DeferredLight();
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Used for transforming the light volumes and for reconstructing
+         * camera-space position from depth.
+         */
+        DeferredLight& setProjectionMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         *
+         * The viewport is expected to start at origin.
+         */
+        DeferredLight& setViewportSize(const Vector2i& size);
+
+        /**
+         * @brief Set G-buffer textures
+         * @return Reference to self (for method chaining)
+         *
+         * Textures filled by @ref DeferredGeometry and the depth buffer. The
+         * textures are read with `texelFetch()`, so their filtering doesn't
+         * matter.
+         */
+        DeferredLight& setGBufferTextures(Texture2D& albedo, Texture2D& normal, Texture2D& material, Texture2D& depth);
+
+    private:
+        Int _projectionMatrixUniform{0},
+            _inverseProjectionMatrixUniform{1},
+            _viewportSizeUniform{2};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
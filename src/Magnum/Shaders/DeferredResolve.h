@@ -0,0 +1,108 @@
+#ifndef Magnum_Shaders_DeferredResolve_h
+#define Magnum_Shaders_DeferredResolve_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::DeferredResolve
+ */
+#endif
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Deferred shading resolve shader
+
+Combines the albedo from @ref DeferredGeometry with the light accumulated by
+@ref DeferredLight and adds an ambient term. Draws a full screen triangle
+generated from `gl_VertexID`, so it's meant to be used with
+@ref MeshTools::fullScreenTriangle():
+@code
+std::unique_ptr<Buffer> buffer;
+Mesh triangle;
+std::tie(buffer, triangle) = MeshTools::fullScreenTriangle();
+
+Shaders::DeferredResolve shader;
+
+defaultFramebuffer.bind();
+Renderer::disable(Renderer::Feature::DepthTest);
+Renderer::disable(Renderer::Feature::Blending);
+shader.setAmbientColor(Color3{0.1f})
+    .setTextures(albedo, light);
+triangle.draw(shader);
+@endcode
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_webgl20 Not available in WebGL 1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT DeferredResolve: public AbstractShaderProgram {
+    public:
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always.
+             */
+            ColorOutput = Generic3D::ColorOutput
+        };
+
+        explicit DeferredResolve();
+
+        /**
+         * @brief Set ambient color
+         * @return Reference to self (for method chaining)
+         *
+         * Multiplied with the albedo. If not set, default value is
+         * `{0.0f, 0.0f, 0.0f}`.
+         */
+        DeferredResolve& setAmbientColor(const Color3& color) {
+            setUniform(_ambientColorUniform, color);
+            return *this;
+        }
+
+        /**
+         * @brief Set albedo and light accumulation textures
+         * @return Reference to self (for method chaining)
+         */
+        DeferredResolve& setTextures(Texture2D& albedo, Texture2D& light);
+
+    private:
+        Int _ambientColorUniform{0};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
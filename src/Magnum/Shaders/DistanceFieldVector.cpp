@@ -30,8 +30,12 @@
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#endif
 
 #include "Implementation/CreateCompatibilityShader.h"
+#include "Implementation/PrecompiledSpirv.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -41,7 +45,23 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "AbstractVector3D.vert"; }
 }
 
-template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(): transformationProjectionMatrixUniform(0), colorUniform(1), outlineColorUniform(2), outlineRangeUniform(3), smoothnessUniform(4) {
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(const Flags flags): transformationProjectionMatrixUniform(0), colorUniform(1), outlineColorUniform(2), outlineRangeUniform(3), smoothnessUniform(4),
+    #ifndef MAGNUM_TARGET_GLES2
+    textureArrayLayerUniform(5),
+    #endif
+    _flags(flags)
+{
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::InstancedGlyphs) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::instanced_arrays);
+        #else
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+        #endif
+    }
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -49,8 +69,16 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    /* Array samplers need GLSL 1.30 */
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    const Version version = flags & Flag::TextureArray ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    /* Buffer textures need ESSL 3.10 */
+    const Version version = flags & Flag::InstancedGlyphs ?
+        Context::current().supportedVersion({Version::GLES310, Version::GLES300}) :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -58,25 +86,50 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    frag.addSource(rs.get("generic.glsl"))
-        .addSource(rs.get(vertexShaderName<dimensions>()));
-    vert.addSource(rs.get("DistanceFieldVector.frag"));
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({frag, vert}));
-
-    AbstractShaderProgram::attachShaders({frag, vert});
-
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::InstancedGlyphs)
+        frag.addSource("#extension GL_EXT_texture_buffer: require\n");
     #endif
-    {
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
-    }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
+    frag
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get(vertexShaderName<dimensions>()));
+    vert.addSource(flags & Flag::MultiChannel ? "#define MULTI_CHANNEL\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::TextureArray ? "#define TEXTURE_ARRAY\n" : "")
+        #endif
+        .addSource(rs.get("DistanceFieldVector.frag"));
+
+    if(!AbstractShaderProgram::loadCachedBinary({frag, vert})) {
+        Implementation::usePrecompiledSpirv({frag, vert});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({frag, vert}));
+
+        AbstractShaderProgram::attachShaders({frag, vert});
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(flags & Flag::InstancedGlyphs) {
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphPosition::Location, "glyphPosition");
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphRectangleId::Location, "glyphRectangleId");
+            } else
+            #endif
+            {
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+            }
+        }
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
+        AbstractShaderProgram::saveCachedBinary({frag, vert});
+    }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
@@ -87,6 +140,10 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
         outlineColorUniform = AbstractShaderProgram::uniformLocation("outlineColor");
         outlineRangeUniform = AbstractShaderProgram::uniformLocation("outlineRange");
         smoothnessUniform = AbstractShaderProgram::uniformLocation("smoothness");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::TextureArray)
+            textureArrayLayerUniform = AbstractShaderProgram::uniformLocation("textureArrayLayer");
+        #endif
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -95,6 +152,11 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     {
         AbstractShaderProgram::setUniform(AbstractShaderProgram::uniformLocation("vectorTexture"),
                                           AbstractVector<dimensions>::VectorTextureLayer);
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::InstancedGlyphs)
+            AbstractShaderProgram::setUniform(AbstractShaderProgram::uniformLocation("glyphRectangles"),
+                                              AbstractVector<dimensions>::GlyphRectangleTextureLayer);
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
@@ -104,6 +166,22 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setVectorTexture(Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::TextureArray,
+        "Shaders::DistanceFieldVector::setVectorTexture(): the shader was not created with texture array enabled", *this);
+    texture.bind(AbstractVector<dimensions>::VectorTextureLayer);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setTextureArrayLayer(const Int layer) {
+    CORRADE_ASSERT(_flags & Flag::TextureArray,
+        "Shaders::DistanceFieldVector::setTextureArrayLayer(): the shader was not created with texture array enabled", *this);
+    AbstractShaderProgram::setUniform(textureArrayLayerUniform, layer);
+    return *this;
+}
+#endif
+
 template class DistanceFieldVector<2>;
 template class DistanceFieldVector<3>;
 
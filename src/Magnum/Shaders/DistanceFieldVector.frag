@@ -57,10 +57,21 @@ uniform lowp float smoothness
     #endif
     ;
 
+#ifdef TEXTURE_ARRAY
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 5)
+#endif
+uniform mediump int textureArrayLayer; /* defaults to zero */
+#endif
+
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 15)
 #endif
+#ifdef TEXTURE_ARRAY
+uniform lowp sampler2DArray vectorTexture;
+#else
 uniform lowp sampler2D vectorTexture;
+#endif
 
 in mediump vec2 fragmentTextureCoordinates;
 
@@ -68,8 +79,24 @@ in mediump vec2 fragmentTextureCoordinates;
 out lowp vec4 fragmentColor;
 #endif
 
+#ifdef MULTI_CHANNEL
+lowp float median(lowp vec3 value) {
+    return max(min(value.r, value.g), min(max(value.r, value.g), value.b));
+}
+#endif
+
 void main() {
-    lowp float intensity = texture(vectorTexture, fragmentTextureCoordinates).r;
+    #ifdef TEXTURE_ARRAY
+    lowp vec4 value = texture(vectorTexture, vec3(fragmentTextureCoordinates, float(textureArrayLayer)));
+    #else
+    lowp vec4 value = texture(vectorTexture, fragmentTextureCoordinates);
+    #endif
+
+    #ifdef MULTI_CHANNEL
+    lowp float intensity = median(value.rgb);
+    #else
+    lowp float intensity = value.r;
+    #endif
 
     /* Fill color */
     fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
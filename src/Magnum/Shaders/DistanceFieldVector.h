@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::DistanceFieldVector, typedef @ref Magnum::Shaders::DistanceFieldVector2D, @ref Magnum::Shaders::DistanceFieldVector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -38,6 +40,19 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class DistanceFieldVectorFlag: UnsignedByte {
+        MultiChannel = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureArray = 1 << 1,
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        InstancedGlyphs = 1 << 2
+        #endif
+    };
+    typedef Containers::EnumSet<DistanceFieldVectorFlag> DistanceFieldVectorFlags;
+}
+
 /**
 @brief Distance field vector shader
 
@@ -86,6 +101,40 @@ shader.setColor(Color3::fromHSV(216.0_degf, 0.85f, 1.0f))
 mesh.draw(shader);
 @endcode
 
+@anchor Shaders-DistanceFieldVector-multi-channel
+## Multi-channel distance field
+
+With @ref Flag::MultiChannel the shader expects a distance field created
+with @ref TextureTools::multiChannelDistanceField() and reconstructs the
+distance from median of its red, green and blue channel. Sharp corners are
+preserved even with heavy magnification, so a much smaller texture gives the
+same visual quality as a single-channel one.
+
+@anchor Shaders-DistanceFieldVector-texture-array
+## Texture arrays
+
+With @ref Flag::TextureArray the shader samples given layer of a
+@ref Texture2DArray instead of a @ref Texture2D. Glyph caches of many fonts
+can be put into layers of a single array (see
+@ref Text::GlyphCache::GlyphCache(Texture2DArray&, Int, const Vector2i&, const Vector2i&, const Vector2i&)),
+which is then bound just once and only the layer is changed when switching
+fonts:
+@code
+Texture2DArray glyphs;
+glyphs.setStorage(1, TextureFormat::R8, {1024, 1024, 4});
+Text::GlyphCache titleCache{glyphs, 0, Vector2i{1024}};
+Text::GlyphCache labelCache{glyphs, 1, Vector2i{1024}};
+// fill the caches, lay out titleMesh and labelMesh ...
+
+Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::TextureArray};
+shader.setVectorTexture(glyphs);
+
+shader.setTextureArrayLayer(0);
+titleMesh.draw(shader);
+shader.setTextureArrayLayer(1);
+labelMesh.draw(shader);
+@endcode
+
 @see @ref shaders, @ref DistanceFieldVector2D, @ref DistanceFieldVector3D
 @todo Use fragment shader derivations to have proper smoothness in perspective/
     large zoom levels, make it optional as it might have negative performance
@@ -93,7 +142,63 @@ mesh.draw(shader);
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector: public AbstractVector<dimensions> {
     public:
-        DistanceFieldVector();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * The texture is a multi-channel distance field. See
+             * @ref Shaders-DistanceFieldVector-multi-channel "Multi-channel distance field"
+             * for more information.
+             */
+            MultiChannel = 1 << 0,
+
+            /**
+             * The texture is a layer of @ref Texture2DArray. See
+             * @ref Shaders-DistanceFieldVector-texture-array "Texture arrays"
+             * for more information.
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Texture arrays are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Texture arrays are not available in WebGL
+             *      1.0.
+             */
+            TextureArray = 1 << 1,
+
+            /**
+             * Expand glyph quads from per-instance data. See
+             * @ref Shaders-Vector-instanced-glyphs "Instanced glyphs" in
+             * @ref Vector documentation for more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+             *      @extension{ARB,texture_buffer_object}
+             * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            InstancedGlyphs = 1 << 2
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::DistanceFieldVectorFlag Flag;
+        typedef Implementation::DistanceFieldVectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DistanceFieldVector(Flags flags = Flags());
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
 
         /**
          * @brief Set transformation and projection matrix
@@ -158,12 +263,46 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set vector texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::TextureArray.
+         * @see @ref setTextureArrayLayer()
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& setVectorTexture(Texture2DArray& texture);
+
+        /**
+         * @brief Set texture array layer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::TextureArray.
+         * Initial value is `0`.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& setTextureArrayLayer(Int layer);
+        #endif
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Overloads to remove WTF-factor from method chaining order */
         DistanceFieldVector<dimensions>& setVectorTexture(Texture2D& texture) {
             AbstractVector<dimensions>::setVectorTexture(texture);
             return *this;
         }
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        DistanceFieldVector<dimensions>& setGlyphRectangleTexture(BufferTexture& texture) {
+            AbstractVector<dimensions>::setGlyphRectangleTexture(texture);
+            return *this;
+        }
+        #endif
         #endif
 
     private:
@@ -172,6 +311,11 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             outlineColorUniform,
             outlineRangeUniform,
             smoothnessUniform;
+        #ifndef MAGNUM_TARGET_GLES2
+        Int textureArrayLayerUniform;
+        #endif
+
+        Flags _flags;
 };
 
 /** @brief Two-dimensional distance field vector shader */
@@ -180,6 +324,8 @@ typedef DistanceFieldVector<2> DistanceFieldVector2D;
 /** @brief Three-dimensional distance field vector shader */
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::DistanceFieldVectorFlags)
+
 }}
 
 #endif
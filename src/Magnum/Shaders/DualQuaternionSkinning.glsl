@@ -0,0 +1,73 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Included by Phong.vert and Flat3D.vert if DUAL_QUATERNION_SKINNING is
+   defined. Each joint is a real and dual part of a dual quaternion, each in
+   one vec4 with the scalar in w, matching the DualQuaternion memory layout. */
+
+#define JOINT_IDS_ATTRIBUTE_LOCATION 8
+#define WEIGHTS_ATTRIBUTE_LOCATION 9
+
+layout(std140) uniform Joints {
+    highp vec4 joints[2*MAX_JOINT_COUNT];
+};
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINT_IDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+/* Blends the joints, taking the shortest path relative to the first joint,
+   and normalizes the result */
+void blendJoints(out highp vec4 real, out highp vec4 dual) {
+    highp vec4 firstReal = joints[2*int(jointIds.x)];
+    real = firstReal*weights.x;
+    dual = joints[2*int(jointIds.x) + 1]*weights.x;
+
+    for(int i = 1; i != 4; ++i) {
+        highp vec4 jointReal = joints[2*int(jointIds[i])];
+        highp float weight = dot(firstReal, jointReal) < 0.0 ? -weights[i] : weights[i];
+        real += jointReal*weight;
+        dual += joints[2*int(jointIds[i]) + 1]*weight;
+    }
+
+    highp float invLength = 1.0/length(real);
+    real *= invLength;
+    dual *= invLength;
+}
+
+highp vec3 rotateVector(highp vec4 real, highp vec3 vector) {
+    return vector + 2.0*cross(real.xyz, cross(real.xyz, vector) + real.w*vector);
+}
+
+highp vec4 transformPoint(highp vec4 real, highp vec4 dual, highp vec4 point) {
+    highp vec3 translation = 2.0*(real.w*dual.xyz - dual.w*real.xyz + cross(real.xyz, dual.xyz));
+    return vec4(rotateVector(real, point.xyz) + translation*point.w, point.w);
+}
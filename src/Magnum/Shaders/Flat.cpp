@@ -25,26 +25,81 @@
 
 #include "Flat.h"
 
+#include <string>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#endif
 
 #include "Implementation/CreateCompatibilityShader.h"
+#include "Implementation/PrecompiledSpirv.h"
 
 namespace Magnum { namespace Shaders {
 
 namespace {
-    enum: Int { TextureLayer = 0 };
+    enum: Int {
+        TextureLayer = 0,
+        TransformationTextureLayer = 1
+    };
 
     template<UnsignedInt> constexpr const char* vertexShaderName();
     template<> constexpr const char* vertexShaderName<2>() { return "Flat2D.vert"; }
     template<> constexpr const char* vertexShaderName<3>() { return "Flat3D.vert"; }
 }
 
-template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): transformationProjectionMatrixUniform(0), colorUniform(1), _flags(flags) {
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): transformationProjectionMatrixUniform(0), colorUniform(1),
+    #ifndef MAGNUM_TARGET_GLES2
+    objectIdUniform(flags & Flag::ObjectId ? 2 : -1),
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    viewProjectionMatricesUniform(flags & Flag::MultiView ? 3 : -1),
+    viewCountUniform(flags & Flag::MultiView ? 3 + MaxViewCount : -1),
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    transformationTextureOffsetUniform(flags & Flag::TransformationTexture ? 10 : -1),
+    #endif
+    _flags(flags)
+{
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(dimensions == 3 || !(flags & Flag::DualQuaternionSkinning),
+        "Shaders::Flat: dual quaternion skinning is available only in 3D", );
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(dimensions == 3 || !(flags & Flag::MultiView),
+        "Shaders::Flat: multi-view rendering is available only in 3D", );
+    if(flags & Flag::MultiView)
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::AMD::vertex_shader_layer);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+
+    /* Texture arrays make sense only if there's a texture */
+    const bool textureArrays = (flags & Flag::Textured) && (flags & Flag::TextureArrays);
+    #endif
+
+    /* The palette replaces the per-instance transformation attribute */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::TransformationTexture) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        #else
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+        #endif
+    }
+    const bool instancedTransformation = (flags & Flag::InstancedTransformation) && !(flags & Flag::TransformationTexture);
+    #else
+    const bool instancedTransformation = bool(flags & Flag::InstancedTransformation);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -52,8 +107,20 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): tran
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    /* Integer outputs and attributes and texture arrays need GLSL 1.30,
+       buffer textures GLSL 1.40, instance ID and layered rendering GLSL
+       1.50 */
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    const Version version = flags & Flag::MultiView ?
+        Context::current().supportedVersion({Version::GL320}) :
+        flags & Flag::TransformationTexture ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310}) :
+        flags & (Flag::ObjectId|Flag::DualQuaternionSkinning|Flag::TextureArrays) ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const Version version = flags & Flag::TransformationTexture ? Version::GLES310 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -61,41 +128,138 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): tran
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::TransformationTexture)
+        vert.addSource("#extension GL_EXT_texture_buffer: require\n");
+    #endif
+
     vert.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
-        .addSource(rs.get(vertexShaderName<dimensions>()));
+        .addSource(instancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::UniformBuffers ? "#define UNIFORM_BUFFERS\n" : "")
+        .addSource(textureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::TransformationTexture ? "#define TRANSFORMATION_TEXTURE\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"));
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::MultiView)
+        vert.addSource("#extension GL_AMD_vertex_shader_layer: require\n#define MULTI_VIEW\n#define MAX_VIEW_COUNT " + std::to_string(MaxViewCount) + "\n");
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::DualQuaternionSkinning)
+        vert.addSource("#define DUAL_QUATERNION_SKINNING\n#define MAX_JOINT_COUNT " + std::to_string(MaxJointCount) + "\n")
+            .addSource(rs.get("DualQuaternionSkinning.glsl"));
+    #endif
+    vert.addSource(rs.get(vertexShaderName<dimensions>()));
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::UniformBuffers ? "#define UNIFORM_BUFFERS\n" : "")
+        .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
+        .addSource(textureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    if(!loadCachedBinary({vert, frag})) {
+        Implementation::usePrecompiledSpirv({vert, frag});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
 
-    attachShaders({vert, frag});
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            bindAttributeLocation(Position::Location, "position");
+            if(flags & Flag::Textured) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(instancedTransformation) bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            if(flags & Flag::InstancedColor) bindAttributeLocation(InstanceColor::Location, "instanceColor");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::DualQuaternionSkinning) {
+                bindAttributeLocation(JointIds::Location, "jointIds");
+                bindAttributeLocation(Weights::Location, "weights");
+            }
+            if(textureArrays)
+                bindAttributeLocation(TextureArrayLayer::Location, "textureArrayLayer");
+            #endif
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags & Flag::ObjectId) {
+                bindFragmentDataLocation(ColorOutput, "fragmentColor");
+                bindFragmentDataLocation(ObjectIdOutput, "fragmentObjectId");
+            }
+            #endif
+        }
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({vert, frag});
+    }
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* The joints are always in a block */
+    if(flags & Flag::DualQuaternionSkinning)
+        setUniformBlockBinding(uniformBlockIndex("Joints"), JointBufferBinding);
+
+    /* The uniforms are in blocks, make the setters do nothing */
+    if(flags & Flag::UniformBuffers) {
+        setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+        transformationProjectionMatrixUniform = colorUniform = -1;
+    } else
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        colorUniform = uniformLocation("color");
+    }
 
+    /* Object ID is not in any uniform block */
+    #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+    if(flags & Flag::ObjectId && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    if(flags & Flag::ObjectId)
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
-        if(flags & Flag::Textured) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        objectIdUniform = uniformLocation("objectId");
     }
+    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    /* Neither are the views */
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::MultiView && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version)) {
+        viewProjectionMatricesUniform = uniformLocation("viewProjectionMatrices");
+        viewCountUniform = uniformLocation("viewCount");
+    }
+    #endif
 
+    /* Nor is the transformation palette */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    if(flags & Flag::TransformationTexture && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #else
+    if(flags & Flag::TransformationTexture)
     #endif
     {
-        transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        colorUniform = uniformLocation("color");
+        transformationTextureOffsetUniform = uniformLocation("transformationTextureOffset");
     }
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
         if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureLayer);
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::TransformationTexture) setUniform(uniformLocation("transformationTexture"), TransformationTextureLayer);
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
@@ -110,6 +274,87 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTexture(
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTexture(Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::Flat::setTexture(): the shader was not created with texture arrays enabled", *this);
+    if(_flags & Flag::Textured) texture.bind(TextureLayer);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setViewProjectionMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(_flags & Flag::MultiView,
+        "Shaders::Flat::setViewProjectionMatrices(): the shader was not created with multi-view rendering enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= MaxViewCount,
+        "Shaders::Flat::setViewProjectionMatrices(): expected at most" << MaxViewCount << "matrices, got" << matrices.size(), *this);
+    setUniform(viewProjectionMatricesUniform, Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>>{matrices.data(), matrices.size()});
+    setUniform(viewCountUniform, Int(matrices.size()));
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationTexture(BufferTexture& texture) {
+    CORRADE_ASSERT(_flags & Flag::TransformationTexture,
+        "Shaders::Flat::setTransformationTexture(): the shader was not created with transformation texture enabled", *this);
+    texture.bind(TransformationTextureLayer);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationTextureOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::TransformationTexture,
+        "Shaders::Flat::setTransformationTextureOffset(): the shader was not created with transformation texture enabled", *this);
+    setUniform(transformationTextureOffsetUniform, Int(offset));
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindJointBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::DualQuaternionSkinning,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with dual quaternion skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindJointBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::DualQuaternionSkinning,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with dual quaternion skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 template class Flat<2>;
 template class Flat<3>;
 
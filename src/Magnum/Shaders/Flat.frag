@@ -33,9 +33,18 @@
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 0)
 #endif
+#ifdef TEXTURE_ARRAYS
+uniform lowp sampler2DArray textureData;
+#else
 uniform lowp sampler2D textureData;
 #endif
+#endif
 
+#ifdef UNIFORM_BUFFERS
+layout(std140) uniform Material {
+    lowp vec4 color;
+};
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
@@ -44,19 +53,53 @@ uniform lowp vec4 color
     = vec4(1.0)
     #endif
     ;
+#endif
+
+#ifdef OBJECT_ID
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp uint objectId; /* defaults to zero */
+#endif
 
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef TEXTURE_ARRAYS
+flat in highp float interpolatedTextureArrayLayer;
+#endif
+
+#ifdef INSTANCED_COLOR
+in lowp vec4 interpolatedInstanceColor;
+#endif
+
 #ifdef NEW_GLSL
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
 out lowp vec4 fragmentColor;
 #endif
+#ifdef OBJECT_ID
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = OBJECT_ID_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out highp uint fragmentObjectId;
+#endif
 
 void main() {
     fragmentColor =
-        #ifdef TEXTURED
+        #ifdef TEXTURE_ARRAYS
+        texture(textureData, vec3(interpolatedTextureCoordinates, interpolatedTextureArrayLayer))*
+        #elif defined(TEXTURED)
         texture(textureData, interpolatedTextureCoordinates)*
         #endif
+        #ifdef INSTANCED_COLOR
+        interpolatedInstanceColor*
+        #endif
         color;
+
+    #ifdef OBJECT_ID
+    fragmentObjectId = objectId;
+    #endif
 }
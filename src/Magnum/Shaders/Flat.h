@@ -39,8 +39,43 @@
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte { Textured = 1 << 0 };
+    enum class FlatFlag: UnsignedShort {
+        Textured = 1 << 0,
+        InstancedTransformation = 1 << 1,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 2,
+        ObjectId = 1 << 3,
+        #endif
+        InstancedColor = 1 << 4,
+        #ifndef MAGNUM_TARGET_GLES2
+        DualQuaternionSkinning = 1 << 5,
+        TextureArrays = 1 << 6,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        MultiView = 1 << 7,
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        TransformationTexture = 1 << 8
+        #endif
+    };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* std140 pads each column of mat3 to four components */
+    template<UnsignedInt> struct FlatUniformMatrix;
+    template<> struct FlatUniformMatrix<2> {
+        typedef Matrix3x4 Type;
+        static Type from(const Matrix3& matrix) {
+            return {Vector4{matrix[0], 0.0f},
+                    Vector4{matrix[1], 0.0f},
+                    Vector4{matrix[2], 0.0f}};
+        }
+    };
+    template<> struct FlatUniformMatrix<3> {
+        typedef Matrix4 Type;
+        static Type from(const Matrix4& matrix) { return matrix; }
+    };
+    #endif
 }
 
 /**
@@ -122,6 +157,208 @@ shader.setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
 mesh.draw(shader);
 @endcode
 
+@anchor Flat-instanced
+### Instanced rendering
+
+With @ref Flag::InstancedTransformation the shader takes additional
+per-instance @ref TransformationMatrix attribute, which is multiplied with the
+matrix set via @ref setTransformationProjectionMatrix(). That allows drawing
+many copies of the same mesh with a single draw call, for example all objects
+of a @ref SceneGraph::DrawableGroup using
+@ref SceneGraph::Camera::drawableTransformationMatrices():
+@code
+Buffer instances;
+mesh.addVertexBufferInstanced(instances, 1, 0,
+    Shaders::Flat3D::TransformationMatrix{});
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::InstancedTransformation};
+
+// each frame
+std::vector<Matrix4> transformations;
+camera.drawableTransformationMatrices(drawables, transformations);
+instances.setData(transformations, BufferUsage::StreamDraw);
+mesh.setInstanceCount(transformations.size());
+shader.setTransformationProjectionMatrix(camera.projectionMatrix());
+mesh.draw(shader);
+@endcode
+
+With @ref Flag::InstancedColor the color set via @ref setColor() is further
+multiplied with per-instance @ref InstanceColor attribute, so each instance
+can have a different color. Both attributes can be interleaved in a single
+buffer.
+
+@anchor Flat-uniform-buffers
+### Uniform buffers
+
+With @ref Flag::UniformBuffers the transformation and color are taken from
+uniform buffers bound via @ref bindTransformationProjectionBuffer() and
+@ref bindMaterialBuffer() instead of being set through
+@ref setTransformationProjectionMatrix() and @ref setColor(), which then do
+nothing. Contents of the buffers are described by
+@ref TransformationProjectionUniform and @ref MaterialUniform. Many draws can
+share a single buffer, each binding its own range at an offset aligned to
+@ref Buffer::uniformOffsetAlignment():
+@code
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers};
+
+Shaders::Flat3D::MaterialUniform materialData{Color3::fromHSV(216.0_degf, 0.85f, 1.0f)};
+Buffer material;
+material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+shader.bindMaterialBuffer(material);
+
+Buffer transformations;
+// fill with one Shaders::Flat3D::TransformationProjectionUniform per draw,
+// each at a multiple of stride
+for(std::size_t i = 0; i != meshes.size(); ++i) {
+    shader.bindTransformationProjectionBuffer(transformations, i*stride, sizeof(Shaders::Flat3D::TransformationProjectionUniform));
+    meshes[i].draw(shader);
+}
+@endcode
+
+@anchor Flat-skinning
+### Dual quaternion skinning
+
+With @ref Flag::DualQuaternionSkinning the 3D shader transforms each vertex by
+a blend of joints given by the @ref JointIds and @ref Weights attributes,
+taking joint @ref DualQuaternion "DualQuaternion"s from a buffer bound with
+@ref bindJointBuffer(). The setup is the same as for @ref Phong, see
+@ref Phong-skinning "its documentation" for an example. The flag is not
+available in 2D.
+
+@anchor Flat-texture-arrays
+### Texture arrays
+
+With @ref Flag::TextureArrays the texture is a
+@ref Texture2DArray "Texture2DArray" and the layer is taken from the
+@ref TextureArrayLayer attribute. Supplying the layer per instance together
+with @ref Flag::InstancedTransformation allows drawing objects with different
+textures in a single instanced draw. With @ref MeshView::setBaseInstance()
+pointing each view to a different range of instances, meshes of different
+materials can be drawn using a single @ref MeshView::multiDraw() call.
+The arrays can be created from separate textures using
+@ref TextureTools::TextureArrayPacker.
+@code
+struct {
+    Matrix4 transformation;
+    Float layer;
+} instanceData[] = { ... };
+
+Buffer instances;
+instances.setData(instanceData, BufferUsage::StaticDraw);
+mesh.setInstanceCount(Containers::arraySize(instanceData))
+    .addVertexBufferInstanced(instances, 1, 0,
+        Shaders::Flat3D::TransformationMatrix{},
+        Shaders::Flat3D::TextureArrayLayer{});
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|
+                       Shaders::Flat3D::Flag::TextureArrays|
+                       Shaders::Flat3D::Flag::InstancedTransformation};
+shader.setTransformationProjectionMatrix(projection*camera)
+    .setTexture(array);
+mesh.draw(shader);
+@endcode
+
+@anchor Flat-object-id
+### Object ID picking
+
+With @ref Flag::ObjectId the shader writes a value set via @ref setObjectId()
+to an additional @ref ObjectIdOutput, which can be mapped to an integer
+framebuffer attachment. The object under cursor is then found by reading a
+single pixel, independently of scene complexity. Using
+@ref FramebufferReader the read doesn't stall the pipeline and the result is
+available a frame or two later:
+@code
+Renderbuffer color, objectId, depth;
+color.setStorage(RenderbufferFormat::RGBA8, size);
+objectId.setStorage(RenderbufferFormat::R32UI, size);
+depth.setStorage(RenderbufferFormat::DepthComponent24, size);
+
+Framebuffer framebuffer{{{}, size}};
+framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+    .attachRenderbuffer(Framebuffer::ColorAttachment{1}, objectId)
+    .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth)
+    .mapForDraw({{Shaders::Flat3D::ColorOutput, Framebuffer::ColorAttachment{0}},
+                 {Shaders::Flat3D::ObjectIdOutput, Framebuffer::ColorAttachment{1}}});
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::ObjectId};
+
+// each frame, zero meaning nothing was picked
+framebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth)
+    .clearColor(Shaders::Flat3D::ObjectIdOutput, Vector4ui{0});
+for(std::size_t i = 0; i != meshes.size(); ++i) {
+    shader.setObjectId(i + 1);
+    meshes[i].draw(shader);
+}
+
+framebuffer.mapForRead(Framebuffer::ColorAttachment{1});
+pending.push_back(reader.read(framebuffer, Range2Di::fromSize(cursor, {1, 1}),
+    PixelFormat::RedInteger, PixelType::UnsignedInt));
+
+while(!pending.empty() && reader.isReady(pending.front())) {
+    UnsignedInt id = reader.retrieve(pending.front()).data<UnsignedInt>()[0];
+    pending.pop_front();
+    if(id) select(id - 1);
+}
+@endcode
+
+@anchor Flat-multi-view
+### Multi-view rendering
+
+With @ref Flag::MultiView the 3D shader draws the mesh into several views in a
+single instanced draw call --- instance @f$ i @f$ is transformed with view
+projection matrix @f$ i \bmod n @f$ set via @ref setViewProjectionMatrices()
+and written to layer of the same index of a layered framebuffer, such as the
+two layers of a stereo @ref Texture2DArray "Texture2DArray" or the six faces of
+a @ref CubeMapTexture. The matrix set via
+@ref setTransformationProjectionMatrix() is then only the transformation
+relative to the camera. The views are usually taken from
+@ref SceneGraph::MultiViewCamera3D:
+@code
+Texture2DArray color, depth;
+// ... two layers for left and right eye
+Framebuffer framebuffer{{{}, size}};
+framebuffer.attachLayeredTexture(Framebuffer::ColorAttachment{0}, color, 0)
+    .attachLayeredTexture(Framebuffer::BufferAttachment::Depth, depth, 0);
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::MultiView};
+shader.setViewProjectionMatrices(camera.viewProjectionMatrices())
+    .setTransformationProjectionMatrix(transformationMatrix);
+mesh.setInstanceCount(camera.viewCount())
+    .draw(shader);
+@endcode
+
+With @ref Flag::InstancedTransformation or @ref Flag::InstancedColor each
+instance is drawn into all views, so the per-instance attributes need to have
+a divisor equal to view count and the instance count is multiplied by it.
+
+@anchor Flat-transformation-texture
+### Transformation texture
+
+Per-instance attributes need a separate buffer for each batch of instances and
+get impractical with tens of thousands of objects that move every frame. With
+@ref Flag::TransformationTexture the per-instance transformation is instead
+fetched from a palette of matrices in a @ref BufferTexture, indexed by
+instance ID plus an offset set via @ref setTransformationTextureOffset(). The
+whole palette is streamed from the camera once per frame with
+@ref SceneGraph::TransformationPalette and each batch then needs just a single
+uniform update:
+
+@code
+SceneGraph::TransformationPalette3D palette;
+const UnsignedInt offset = palette.add(camera, drawables);
+palette.upload();
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::TransformationTexture};
+shader.setTransformationTexture(palette.texture())
+    .setTransformationTextureOffset(offset)
+    .setTransformationProjectionMatrix(camera.projectionMatrix());
+mesh.setInstanceCount(drawables.size())
+    .draw(shader);
+@endcode
+
+With @ref Flag::MultiView each instance is drawn into all views, same as with
+the per-instance attributes.
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public AbstractShaderProgram {
@@ -142,14 +379,211 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3 in 2D,
+         * @ref Matrix4 in 3D. Used only if @ref Flag::InstancedTransformation
+         * is set.
+         */
+        typedef typename Generic<dimensions>::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief Per-instance color
+         *
+         * @ref Color4, occupies the same location as the
+         * @ref shaders-generic "generic" vertex color attribute. Used only if
+         * @ref Flag::InstancedColor is set.
+         */
+        typedef Attribute<Generic<dimensions>::Color::Location, Color4> InstanceColor;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint IDs
+         *
+         * @ref Magnum::Vector4ui "Vector4ui", the same location as
+         * @ref Phong::JointIds. Used only if
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Integer attributes are not available in OpenGL
+         *      ES 2.0.
+         * @requires_webgl20 Integer attributes are not available in WebGL
+         *      1.0.
+         */
+        typedef Attribute<8, Vector4ui> JointIds;
+
+        /**
+         * @brief Joint weights
+         *
+         * @ref Magnum::Vector4 "Vector4", the same location as
+         * @ref Phong::Weights. Used only if
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Attribute<9, Vector4> Weights;
+
+        /**
+         * @brief Texture array layer
+         *
+         * @ref Magnum::Float "Float", the same location as
+         * @ref Phong::TextureArrayLayer. Usually supplied per-instance. Used
+         * only if @ref Flag::TextureArrays is set.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        typedef Attribute<10, Float> TextureArrayLayer;
+
+        enum: UnsignedInt {
+            /**
+             * Max count of joints in the buffer bound with
+             * @ref bindJointBuffer()
+             */
+            MaxJointCount = 256
+        };
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        enum: UnsignedInt {
+            /**
+             * Max count of views set with @ref setViewProjectionMatrices()
+             */
+            MaxViewCount = 6
+        };
+        #endif
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always.
+             */
+            ColorOutput = Generic<dimensions>::ColorOutput,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Object ID shader output. @ref shaders-generic "Generic output",
+             * present only if @ref Flag::ObjectId is set.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Object ID output is not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Object ID output is not available in WebGL
+             *      1.0.
+             */
+            ObjectIdOutput = Generic<dimensions>::ObjectIdOutput
+            #endif
+        };
+
         #ifdef DOXYGEN_GENERATING_OUTPUT
         /**
          * @brief Flag
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
-            Textured = 1 << 0   /**< The shader uses texture instead of color */
+        enum class Flag: UnsignedShort {
+            Textured = 1 << 0,  /**< The shader uses texture instead of color */
+
+            /**
+             * The shader multiplies the transformation and projection matrix
+             * with per-instance @ref TransformationMatrix attribute.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+             *      @es_extension{EXT,instanced_arrays} or
+             *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 1,
+
+            /**
+             * The shader takes transformation and color from uniform buffers.
+             * See @ref Flat-uniform-buffers "Uniform buffers" for more
+             * information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            UniformBuffers = 1 << 2,
+
+            /**
+             * The shader writes object ID set via @ref setObjectId() to
+             * @ref ObjectIdOutput. See @ref Flat-object-id "Object ID picking"
+             * for more information.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Object ID output is not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Object ID output is not available in WebGL
+             *      1.0.
+             */
+            ObjectId = 1 << 3,
+
+            /**
+             * The shader multiplies the color with per-instance
+             * @ref InstanceColor attribute.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+             *      @es_extension{EXT,instanced_arrays} or
+             *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedColor = 1 << 4,
+
+            /**
+             * The vertices are transformed by a blend of joint dual
+             * quaternions from a buffer bound with @ref bindJointBuffer().
+             * Available only in 3D. See @ref Flat-skinning for more
+             * information.
+             * @requires_gl31 Extensions @extension{EXT,gpu_shader4} and
+             *      @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Integer attributes and uniform buffers are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Integer attributes and uniform buffers are
+             *      not available in WebGL 1.0.
+             */
+            DualQuaternionSkinning = 1 << 5,
+
+            /**
+             * The texture is a @ref Texture2DArray "Texture2DArray" set via
+             * @ref setTexture(Texture2DArray&), with layer taken from the
+             * @ref TextureArrayLayer attribute. Has effect only together
+             * with @ref Flag::Textured. See @ref Flat-texture-arrays for more
+             * information.
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Texture arrays are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Texture arrays are not available in WebGL
+             *      1.0.
+             */
+            TextureArrays = 1 << 6,
+
+            /**
+             * The mesh is drawn into all views set via
+             * @ref setViewProjectionMatrices() in a single instanced draw
+             * call, each view going to a different framebuffer layer.
+             * Available only in 3D. See @ref Flat-multi-view for more
+             * information.
+             * @requires_gl32 Extension @extension{ARB,geometry_shader4} for
+             *      layered framebuffers
+             * @requires_extension Extension @extension{AMD,vertex_shader_layer}
+             * @requires_gl Layered rendering from the vertex shader is not
+             *      available in OpenGL ES or WebGL.
+             */
+            MultiView = 1 << 7,
+
+            /**
+             * Per-instance transformation is fetched from a palette in a
+             * buffer texture set via @ref setTransformationTexture() instead
+             * of the @ref TransformationMatrix attribute.
+             * @ref Flag::InstancedTransformation is ignored if this flag is
+             * set. See @ref Flat-transformation-texture for more information.
+             * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+             * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            TransformationTexture = 1 << 8
         };
 
         /**
@@ -163,6 +597,50 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         typedef Implementation::FlatFlags Flags;
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Uniform buffer binding
+         *
+         * Used if @ref Flag::UniformBuffers or
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         */
+        enum BufferBinding: UnsignedInt {
+            /** @ref TransformationProjectionUniform */
+            TransformationProjectionBufferBinding = 0,
+            MaterialBufferBinding = 1,  /**< @ref MaterialUniform */
+            JointBufferBinding = 2      /**< Joint dual quaternions */
+        };
+
+        /**
+         * @brief Transformation and projection uniform block
+         *
+         * Has `std140` layout, in 2D each matrix column is padded to four
+         * components. Used if @ref Flag::UniformBuffers is set.
+         * @see @ref bindTransformationProjectionBuffer()
+         */
+        struct TransformationProjectionUniform {
+            /** @brief Constructor */
+            /*implicit*/ TransformationProjectionUniform(const MatrixTypeFor<dimensions, Float>& matrix = MatrixTypeFor<dimensions, Float>{}): transformationProjectionMatrix{Implementation::FlatUniformMatrix<dimensions>::from(matrix)} {}
+
+            /** @brief Transformation and projection matrix */
+            typename Implementation::FlatUniformMatrix<dimensions>::Type transformationProjectionMatrix;
+        };
+
+        /**
+         * @brief Material uniform block
+         *
+         * Has `std140` layout. Used if @ref Flag::UniformBuffers is set.
+         * @see @ref bindMaterialBuffer()
+         */
+        struct MaterialUniform {
+            /** @brief Constructor */
+            /*implicit*/ MaterialUniform(const Color4& color = Color4{1.0f}): color{color} {}
+
+            Color4 color;   /**< @brief Color */
+        };
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -175,6 +653,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
+         *
+         * If @ref Flag::InstancedTransformation is set, the matrix is further
+         * multiplied with per-instance @ref TransformationMatrix attribute.
+         * Does nothing if @ref Flag::UniformBuffers is set.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
             setUniform(transformationProjectionMatrixUniform, matrix);
@@ -186,7 +668,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          * @return Reference to self (for method chaining)
          *
          * If @ref Flag::Textured is set, default value is `{1.0f, 1.0f, 1.0f}`
-         * and the color will be multiplied with texture.
+         * and the color will be multiplied with texture. Does nothing if
+         * @ref Flag::UniformBuffers is set.
          * @see @ref setTexture()
          */
         Flat<dimensions>& setColor(const Color4& color){
@@ -198,14 +681,205 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          * @brief Set texture
          * @return Reference to self (for method chaining)
          *
-         * Has effect only if @ref Flag::Textured is set.
+         * Has effect only if @ref Flag::Textured is set and
+         * @ref Flag::TextureArrays is not set.
          * @see @ref setColor()
          */
         Flat<dimensions>& setTexture(Texture2D& texture);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureArrays is set, has effect only if
+         * @ref Flag::Textured is set as well. The layer is taken from the
+         * @ref TextureArrayLayer attribute.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& setTexture(Texture2DArray& texture);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set object ID
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if @ref Flag::ObjectId is set, the value is written
+         * to @ref ObjectIdOutput. If not set, default value is `0`.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Object ID output is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Object ID output is not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& setObjectId(UnsignedInt id) {
+            setUniform(objectIdUniform, id);
+            return *this;
+        }
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set view projection matrices
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::MultiView is set and that there's at most
+         * @ref MaxViewCount matrices. Instance @f$ i @f$ of the draw goes
+         * through matrix @f$ i \bmod n @f$, where @f$ n @f$ is the matrix
+         * count, and is rendered into framebuffer layer of the same index.
+         * The matrix set via @ref setTransformationProjectionMatrix() is then
+         * expected to contain only the transformation relative to the
+         * camera. See @ref Flat-multi-view for more information.
+         * @requires_extension Extension @extension{AMD,vertex_shader_layer}
+         * @requires_gl Layered rendering from the vertex shader is not
+         *      available in OpenGL ES or WebGL.
+         */
+        Flat<dimensions>& setViewProjectionMatrices(Containers::ArrayView<const Matrix4> matrices);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set transformation texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TransformationTexture is set. The texture
+         * is expected to have @ref BufferTextureFormat::RGBA32F format with
+         * three texels for each @ref Matrix3 in 2D, the last component being
+         * unused, and four texels for each @ref Matrix4 in 3D. See
+         * @ref Flat-transformation-texture for more information.
+         * @see @ref SceneGraph::TransformationPalette
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        Flat<dimensions>& setTransformationTexture(BufferTexture& texture);
+
+        /**
+         * @brief Set transformation texture offset
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TransformationTexture is set. Instance
+         * @f$ i @f$ of the draw uses matrix at index @f$ o + i @f$ of the
+         * palette, where @f$ o @f$ is the offset. Initial value is `0`.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        Flat<dimensions>& setTransformationTextureOffset(UnsignedInt offset);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref TransformationProjectionUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind transformation and projection uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The @p offset is
+         * expected to be aligned to @ref Buffer::uniformOffsetAlignment().
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind material uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref MaterialUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindMaterialBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind material uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The @p offset is
+         * expected to be aligned to @ref Buffer::uniformOffsetAlignment().
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindMaterialBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind joint uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::DualQuaternionSkinning is set. The buffer
+         * is expected to contain at most @ref MaxJointCount
+         * @ref DualQuaternion "DualQuaternion"s.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindJointBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind joint uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::DualQuaternionSkinning is set. The
+         * @p offset is expected to be aligned to
+         * @ref Buffer::uniformOffsetAlignment().
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL
+         *      1.0.
+         */
+        Flat<dimensions>& bindJointBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
     private:
         Int transformationProjectionMatrixUniform,
             colorUniform;
+        #ifndef MAGNUM_TARGET_GLES2
+        Int objectIdUniform;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Int viewProjectionMatricesUniform,
+            viewCountUniform;
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int transformationTextureOffsetUniform;
+        #endif
 
         Flags _flags;
 };
@@ -28,16 +28,50 @@
 #define out varying
 #endif
 
+#ifdef UNIFORM_BUFFERS
+layout(std140) uniform TransformationProjection {
+    highp mat3 transformationProjectionMatrix;
+};
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat3 transformationProjectionMatrix;
+#endif
+
+#ifdef TRANSFORMATION_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform highp samplerBuffer transformationTexture;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform highp int transformationTextureOffset; /* defaults to zero */
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec2 position;
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat3 instancedTransformationMatrix;
+#endif
+
+#ifdef INSTANCED_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 instanceColor;
+
+out lowp vec4 interpolatedInstanceColor;
+#endif
+
 #ifdef TEXTURED
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
@@ -47,11 +81,42 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef TEXTURE_ARRAYS
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURE_ARRAY_LAYER_ATTRIBUTE_LOCATION)
+#endif
+in highp float textureArrayLayer;
+
+flat out highp float interpolatedTextureArrayLayer;
+#endif
+
 void main() {
+    #ifdef TRANSFORMATION_TEXTURE
+    /* Per-instance transformation fetched from the palette, three texels
+       per matrix with the last component unused */
+    highp int transformationTexel = (transformationTextureOffset + gl_InstanceID)*3;
+    highp mat3 instancedTransformationMatrix = mat3(
+        texelFetch(transformationTexture, transformationTexel).xyz,
+        texelFetch(transformationTexture, transformationTexel + 1).xyz,
+        texelFetch(transformationTexture, transformationTexel + 2).xyz);
+    #endif
+
+    #if defined(INSTANCED_TRANSFORMATION) || defined(TRANSFORMATION_TEXTURE)
+    gl_Position.xywz = vec4(transformationProjectionMatrix*instancedTransformationMatrix*vec3(position, 1.0), 0.0);
+    #else
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
+    #endif
+
+    #ifdef INSTANCED_COLOR
+    interpolatedInstanceColor = instanceColor;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
     interpolatedTextureCoordinates = textureCoordinates;
     #endif
+
+    #ifdef TEXTURE_ARRAYS
+    interpolatedTextureArrayLayer = textureArrayLayer;
+    #endif
 }
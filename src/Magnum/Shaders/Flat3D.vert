@@ -28,16 +28,62 @@
 #define out varying
 #endif
 
+#ifdef UNIFORM_BUFFERS
+layout(std140) uniform TransformationProjection {
+    highp mat4 transformationProjectionMatrix;
+};
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat4 transformationProjectionMatrix;
+#endif
+
+#ifdef MULTI_VIEW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform highp mat4 viewProjectionMatrices[MAX_VIEW_COUNT];
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 9)
+#endif
+uniform highp int viewCount = 1;
+#endif
+
+#ifdef TRANSFORMATION_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform highp samplerBuffer transformationTexture;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform highp int transformationTextureOffset; /* defaults to zero */
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
+#ifdef INSTANCED_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 instanceColor;
+
+out lowp vec4 interpolatedInstanceColor;
+#endif
+
 #ifdef TEXTURED
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
@@ -47,11 +93,64 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef TEXTURE_ARRAYS
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURE_ARRAY_LAYER_ATTRIBUTE_LOCATION)
+#endif
+in highp float textureArrayLayer;
+
+flat out highp float interpolatedTextureArrayLayer;
+#endif
+
 void main() {
-    gl_Position = transformationProjectionMatrix*position;
+    #ifdef DUAL_QUATERNION_SKINNING
+    highp vec4 jointReal, jointDual;
+    blendJoints(jointReal, jointDual);
+    highp vec4 vertexPosition = transformPoint(jointReal, jointDual, position);
+    #else
+    highp vec4 vertexPosition = position;
+    #endif
+
+    #ifdef TRANSFORMATION_TEXTURE
+    /* Per-instance transformation fetched from the palette, four texels per
+       matrix. With multiple views each instance is drawn into all of
+       them. */
+    #ifdef MULTI_VIEW
+    highp int transformationTexel = (transformationTextureOffset + gl_InstanceID/viewCount)*4;
+    #else
+    highp int transformationTexel = (transformationTextureOffset + gl_InstanceID)*4;
+    #endif
+    highp mat4 instancedTransformationMatrix = mat4(
+        texelFetch(transformationTexture, transformationTexel),
+        texelFetch(transformationTexture, transformationTexel + 1),
+        texelFetch(transformationTexture, transformationTexel + 2),
+        texelFetch(transformationTexture, transformationTexel + 3));
+    #endif
+
+    #if defined(INSTANCED_TRANSFORMATION) || defined(TRANSFORMATION_TEXTURE)
+    gl_Position = transformationProjectionMatrix*instancedTransformationMatrix*vertexPosition;
+    #else
+    gl_Position = transformationProjectionMatrix*vertexPosition;
+    #endif
+
+    #ifdef MULTI_VIEW
+    /* The matrix above is only the transformation relative to the camera,
+       each instance goes into a different view and layer */
+    int view = gl_InstanceID % viewCount;
+    gl_Position = viewProjectionMatrices[view]*gl_Position;
+    gl_Layer = view;
+    #endif
+
+    #ifdef INSTANCED_COLOR
+    interpolatedInstanceColor = instanceColor;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
     interpolatedTextureCoordinates = textureCoordinates;
     #endif
+
+    #ifdef TEXTURE_ARRAYS
+    interpolatedTextureArrayLayer = textureArrayLayer;
+    #endif
 }
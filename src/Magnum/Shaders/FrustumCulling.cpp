@@ -0,0 +1,121 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FrustumCulling.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int { DepthPyramidTextureLayer = 0 };
+}
+
+FrustumCulling::FrustumCulling(const Flags flags): _flags{flags} {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::compute_shader);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::shader_storage_buffer_object);
+    const Version version = Context::current().supportedVersion({Version::GL430, Version::GL420});
+    #else
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES310);
+    const Version version = Version::GLES310;
+    #endif
+
+    Shader comp = Implementation::createCompatibilityShader(rs, version, Shader::Type::Compute);
+    comp.addSource(flags & Flag::OcclusionCulling ? "#define OCCLUSION_CULLING\n" : "")
+        .addSource(rs.get("FrustumCulling.comp"));
+
+    if(!loadCachedBinary({comp})) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+        attachShader(comp);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({comp});
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _frustumPlanesUniform = uniformLocation("frustumPlanes");
+        _objectCountUniform = uniformLocation("objectCount");
+        if(flags & Flag::OcclusionCulling)
+            _depthPyramidProjectionCameraMatrixUniform = uniformLocation("depthPyramidProjectionCameraMatrix");
+    }
+}
+
+FrustumCulling& FrustumCulling::setProjectionCameraMatrix(const Matrix4& matrix) {
+    /* A point is inside if -w <= x_i <= w in clip coordinates, i.e.
+       (row_w +/- row_i)*p >= 0. The planes are normalized so the dot product
+       gives signed distance. */
+    Vector4 planes[6];
+    for(std::size_t i = 0; i != 3; ++i) {
+        planes[i*2] = matrix.row(3) + matrix.row(i);
+        planes[i*2 + 1] = matrix.row(3) - matrix.row(i);
+    }
+    for(Vector4& plane: planes) {
+        const Float length = plane.xyz().length();
+        if(length != 0.0f) plane /= length;
+    }
+
+    setUniform(_frustumPlanesUniform, planes);
+    return *this;
+}
+
+FrustumCulling& FrustumCulling::setDepthPyramidProjectionCameraMatrix(const Matrix4& matrix) {
+    CORRADE_ASSERT(_flags & Flag::OcclusionCulling,
+        "Shaders::FrustumCulling::setDepthPyramidProjectionCameraMatrix(): the shader was not created with occlusion culling enabled", *this);
+    setUniform(_depthPyramidProjectionCameraMatrixUniform, matrix);
+    return *this;
+}
+
+FrustumCulling& FrustumCulling::setDepthPyramidTexture(Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::OcclusionCulling,
+        "Shaders::FrustumCulling::setDepthPyramidTexture(): the shader was not created with occlusion culling enabled", *this);
+    texture.bind(DepthPyramidTextureLayer);
+    return *this;
+}
+
+FrustumCulling& FrustumCulling::cull(const UnsignedInt objectCount) {
+    setUniform(_objectCountUniform, objectCount);
+    dispatchComputeInvocations({objectCount, 1, 1});
+    return *this;
+}
+
+}}
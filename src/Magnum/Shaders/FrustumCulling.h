@@ -0,0 +1,314 @@
+#ifndef Magnum_Shaders_FrustumCulling_h
+#define Magnum_Shaders_FrustumCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::FrustumCulling
+ */
+#endif
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/AbstractComputeShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU frustum culling
+
+Compute shader that tests bounding spheres of objects against the view
+frustum and writes indirect draw commands of the visible objects, compacted,
+into a buffer usable by @ref MeshView::drawIndirect(). Together with
+@ref MeshView::drawIndirect(AbstractShaderProgram&, Mesh&, Buffer&, GLintptr, Buffer&, GLintptr, Int, GLsizei)
+the draw count is read directly from GPU memory and no per-object work is
+done on the CPU, which makes it suitable for large static scenes where
+@ref SceneGraph::Camera::drawCulled() would spend most of the frame
+iterating the drawables.
+
+The input consists of a buffer of @ref Object structures with world
+transformation and object-space bounding sphere of each object and a buffer
+with one @ref MeshView::DrawElementsIndirectCommand for each object. All
+objects are expected to be packed in a single indexed mesh, for example
+using @ref MeshPool. The output is a buffer with
+@ref MeshView::DrawElementsIndirectCommand "DrawElementsIndirectCommand"s of
+visible objects and a single @ref Magnum::UnsignedInt "UnsignedInt" with
+their count, which needs to be reset to zero before each culling pass. The
+order of the visible commands is not preserved.
+
+To know which object is being drawn in the vertex shader, set
+@ref MeshView::DrawElementsIndirectCommand::baseInstance "baseInstance" of
+each command to index of the object. The transformation can then be fetched
+from the object buffer used as an instanced vertex buffer.
+
+## Example usage
+
+Common setup:
+@code
+std::vector<Shaders::FrustumCulling::Object> objectData;
+std::vector<MeshView::DrawElementsIndirectCommand> commandData;
+// ...
+
+Buffer objects, commands, visibleCommands, drawCount;
+objects.setData(objectData, BufferUsage::StaticDraw);
+commands.setData(commandData, BufferUsage::StaticDraw);
+visibleCommands.setData({nullptr, commandData.size()*sizeof(MeshView::DrawElementsIndirectCommand)}, BufferUsage::DynamicCopy);
+drawCount.setData({nullptr, 4}, BufferUsage::DynamicCopy);
+
+// baseInstance of each command is index of the object
+mesh.addVertexBufferInstanced(objects, 1, 0,
+    Shaders::Phong::TransformationMatrix{}, 16);
+
+Shaders::FrustumCulling culling;
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation};
+@endcode
+
+Each frame:
+@code
+constexpr UnsignedInt zero[]{0};
+drawCount.setSubData(0, zero);
+
+culling.setProjectionCameraMatrix(camera.projectionMatrix()*camera.cameraMatrix())
+    .bindObjectBuffer(objects)
+    .bindCommandBuffer(commands)
+    .bindVisibleCommandBuffer(visibleCommands)
+    .bindDrawCountBuffer(drawCount)
+    .cull(objectData.size());
+
+Renderer::setMemoryBarrier(Renderer::MemoryBarrier::Command);
+
+shader.setTransformationMatrix(camera.cameraMatrix())
+    .setProjectionMatrix(camera.projectionMatrix());
+MeshView::drawIndirect(shader, mesh, visibleCommands, 0, drawCount, 0, objectData.size());
+@endcode
+
+@anchor FrustumCulling-occlusion
+## Occlusion culling
+
+If @ref Flag::OcclusionCulling is enabled, objects passing the frustum test
+are additionally tested against a hierarchical depth buffer, usually
+created from depth of the previous frame. The depth pyramid is expected to
+be a single-channel floating-point texture with a full mip chain where the
+base level contains the depth buffer and each following level contains the
+maximal depth of the corresponding 2x2 texel block in the previous level.
+The texture is expected to use nearest filtering both for texels and
+mip levels. Pass the depth pyramid using @ref setDepthPyramidTexture() and
+the projection and camera matrix the depth was rendered with using
+@ref setDepthPyramidProjectionCameraMatrix(). Objects crossing the near
+plane are never considered occluded. Objects that became visible only in
+the current frame get culled for one frame, which is the usual trade-off of
+reusing previous frame depth.
+
+@requires_gl43 Extension @extension{ARB,compute_shader} and
+    @extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Compute shaders are not available in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+@see @ref shaders, @ref AbstractComputeShaderProgram
+*/
+class MAGNUM_SHADERS_EXPORT FrustumCulling: public AbstractComputeShaderProgram {
+    public:
+        /**
+         * @brief Object data
+         *
+         * Layout matches the `std430` struct in the shader, the stride is
+         * 80 bytes.
+         */
+        struct Object {
+            /** @brief Object transformation in world space */
+            Matrix4 transformation;
+
+            /** @brief Bounding sphere center in object space */
+            Vector3 boundingSphereCenter;
+
+            /**
+             * @brief Bounding sphere radius in object space
+             *
+             * Scaled by the largest scaling of @ref transformation.
+             */
+            Float boundingSphereRadius;
+        };
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Test objects also against a depth pyramid. See
+             * @ref FrustumCulling-occlusion "class documentation"
+             * for more information.
+             */
+            OcclusionCulling = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /** @brief Shader storage buffer binding points */
+        enum: UnsignedInt {
+            /** Binding point for the @ref Object buffer */
+            ObjectBufferBinding = 0,
+
+            /** Binding point for the input command buffer */
+            CommandBufferBinding = 1,
+
+            /** Binding point for the visible command buffer */
+            VisibleCommandBufferBinding = 2,
+
+            /** Binding point for the draw count buffer */
+            DrawCountBufferBinding = 3
+        };
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit FrustumCulling(Flags flags = {});
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set projection and camera matrix
+         * @return Reference to self (for method chaining)
+         *
+         * The view frustum planes are extracted from @p matrix on the CPU.
+         */
+        FrustumCulling& setProjectionCameraMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Set depth pyramid projection and camera matrix
+         * @return Reference to self (for method chaining)
+         *
+         * The matrix the depth in the depth pyramid was rendered with.
+         * Expects that @ref Flag::OcclusionCulling is set.
+         */
+        FrustumCulling& setDepthPyramidProjectionCameraMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Set depth pyramid texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::OcclusionCulling is set.
+         */
+        FrustumCulling& setDepthPyramidTexture(Texture2D& texture);
+
+        /**
+         * @brief Bind object buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain tightly packed @ref Object
+         * structures.
+         */
+        FrustumCulling& bindObjectBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, ObjectBufferBinding);
+            return *this;
+        }
+
+        /**
+         * @brief Bind command buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain tightly packed
+         * @ref MeshView::DrawElementsIndirectCommand structures, one for
+         * each object.
+         */
+        FrustumCulling& bindCommandBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, CommandBufferBinding);
+            return *this;
+        }
+
+        /**
+         * @brief Bind visible command buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to have space for a
+         * @ref MeshView::DrawElementsIndirectCommand for each object.
+         */
+        FrustumCulling& bindVisibleCommandBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, VisibleCommandBufferBinding);
+            return *this;
+        }
+
+        /**
+         * @brief Bind draw count buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Count of visible objects is atomically incremented in the first
+         * four bytes of the buffer, the value is expected to be reset to
+         * zero before calling @ref cull().
+         */
+        FrustumCulling& bindDrawCountBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, DrawCountBufferBinding);
+            return *this;
+        }
+
+        /**
+         * @brief Bind draw count buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * The @p offset is expected to respect
+         * @ref Buffer::shaderStorageOffsetAlignment().
+         */
+        FrustumCulling& bindDrawCountBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+            buffer.bind(Buffer::Target::ShaderStorage, DrawCountBufferBinding, offset, size);
+            return *this;
+        }
+
+        /**
+         * @brief Cull given count of objects
+         * @return Reference to self (for method chaining)
+         *
+         * Put @ref Renderer::MemoryBarrier::Command barrier before using
+         * the visible commands and draw count for drawing.
+         * @see @ref dispatchComputeInvocations()
+         */
+        FrustumCulling& cull(UnsignedInt objectCount);
+
+    private:
+        Flags _flags;
+        Int _frustumPlanesUniform{0},
+            _objectCountUniform{6},
+            _depthPyramidProjectionCameraMatrixUniform{7};
+};
+
+CORRADE_ENUMSET_OPERATORS(FrustumCulling::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
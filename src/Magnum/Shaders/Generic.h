@@ -73,6 +73,38 @@ template<UnsignedInt dimensions> struct Generic {
      * @ref Color3.
      */
     typedef Attribute<3, Color3> Color;
+
+    /**
+     * @brief Per-instance transformation matrix
+     *
+     * @ref Matrix3 in 2D and @ref Matrix4 in 3D, occupies three or four
+     * consecutive locations. Meant to be used together with
+     * @ref Mesh::addVertexBufferInstanced(), see for example
+     * @ref Flat::Flag::InstancedTransformation.
+     */
+    typedef Attribute<4, T> TransformationMatrix;
+
+    enum: UnsignedInt {
+        /**
+         * Color shader output. Present always, expects three- or
+         * four-component floating-point or normalized buffer attachment.
+         */
+        ColorOutput = 0,
+
+        /**
+         * Object ID shader output. Present only if the shader is created
+         * with object ID enabled, for example @ref Flat::Flag::ObjectId,
+         * expects a single-component unsigned integral attachment, such as
+         * @ref RenderbufferFormat::R32UI. Meant to be mapped to a framebuffer
+         * attachment using @ref Framebuffer::mapForDraw() for picking, see
+         * @ref Flat-object-id for an example.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Object ID output is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Object ID output is not available in WebGL 1.0.
+         */
+        ObjectIdOutput = 1
+    };
 };
 #endif
 
@@ -86,15 +118,24 @@ typedef Generic<3> Generic3D;
 struct BaseGeneric {
     typedef Attribute<1, Vector2> TextureCoordinates;
     typedef Attribute<3, Color3> Color;
+
+    enum: UnsignedInt {
+        ColorOutput = 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        ObjectIdOutput = 1
+        #endif
+    };
 };
 
 template<> struct Generic<2>: BaseGeneric {
     typedef Attribute<0, Vector2> Position;
+    typedef Attribute<4, Matrix3> TransformationMatrix;
 };
 
 template<> struct Generic<3>: BaseGeneric {
     typedef Attribute<0, Vector3> Position;
     typedef Attribute<2, Vector3> Normal;
+    typedef Attribute<4, Matrix4> TransformationMatrix;
 };
 #endif
 
@@ -0,0 +1,133 @@
+#ifndef Magnum_Shaders_Implementation_PrecompiledSpirv_h
+#define Magnum_Shaders_Implementation_PrecompiledSpirv_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Resource.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+
+/* The resource group exists only if the library was built with
+   WITH_SPIRV_SHADERS, which defines MAGNUM_SHADERS_SPIRV */
+#if defined(MAGNUM_BUILD_STATIC) && defined(MAGNUM_SHADERS_EXPORT) && defined(MAGNUM_SHADERS_SPIRV)
+static void importSpirvShaderResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumShadersSpirv_RCS)
+}
+#endif
+
+namespace Magnum { namespace Shaders { namespace Implementation {
+
+#ifndef MAGNUM_TARGET_GLES
+/* File extension of given stage, the same as glslangValidator expects */
+inline const char* spirvStageExtension(const Shader::Type type) {
+    switch(type) {
+        case Shader::Type::Vertex: return "vert";
+        case Shader::Type::TessellationControl: return "tesc";
+        case Shader::Type::TessellationEvaluation: return "tese";
+        case Shader::Type::Geometry: return "geom";
+        case Shader::Type::Compute: return "comp";
+        case Shader::Type::Fragment: return "frag";
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+/* SHA-1 of all GLSL sources, which include the #version directive, the
+   disabled extensions and the variant defines, so a module is never used
+   for anything else than what it was compiled from. Unlike
+   ProgramBinaryCache::key() the driver strings are not included, as SPIR-V
+   is driver-independent. */
+inline std::string spirvKey(const Shader& shader) {
+    const std::string separator(1, '\0');
+    Utility::Sha1 sha1;
+    for(const std::string& source: shader.sources())
+        sha1 << source << separator;
+    return sha1.digest().hexString() + '.' + spirvStageExtension(shader.type());
+}
+#endif
+
+/* Replaces GLSL compilation of all shaders of one program with modules from
+   the MagnumShadersSpirv resource group. Returns false and leaves the
+   shaders untouched if ARB_gl_spirv is not supported or a module is missing
+   for any of them, as a program can't mix SPIR-V and GLSL shaders. If the
+   MAGNUM_SHADERS_SPIRV_EXPORT_DIR environment variable is set, the
+   assembled GLSL of each shader is written there to be compiled offline. */
+inline bool usePrecompiledSpirv(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(const char* const exportDirectory = std::getenv("MAGNUM_SHADERS_SPIRV_EXPORT_DIR")) {
+        for(const Shader& shader: shaders) {
+            std::string source;
+            for(const std::string& s: shader.sources()) source += s;
+            Utility::Directory::writeString(Utility::Directory::join(exportDirectory, spirvKey(shader)), source);
+        }
+    }
+
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::gl_spirv>())
+        return false;
+
+    #if defined(MAGNUM_BUILD_STATIC) && defined(MAGNUM_SHADERS_SPIRV)
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersSpirv"))
+        importSpirvShaderResources();
+    #endif
+    if(!Utility::Resource::hasGroup("MagnumShadersSpirv")) return false;
+
+    /* Look up all modules first, Resource::getRaw() complains about missing
+       files */
+    Utility::Resource rs("MagnumShadersSpirv");
+    const std::vector<std::string> available = rs.list();
+    std::vector<std::string> filenames;
+    filenames.reserve(shaders.size());
+    for(const Shader& shader: shaders) {
+        filenames.push_back(spirvKey(shader) + ".spv");
+        if(std::find(available.begin(), available.end(), filenames.back()) == available.end())
+            return false;
+    }
+
+    std::size_t i = 0;
+    for(Shader& shader: shaders)
+        shader.setSpirvBinary(rs.getRaw(filenames[i++]));
+    return true;
+    #else
+    static_cast<void>(shaders);
+    return false;
+    #endif
+}
+
+}}}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusters.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Shaders {
+
+LightClusters::LightClusters(const Vector3i& clusterCount): _clusterCount{clusterCount}, _near{}, _far{}, _lightBuffer{Buffer::TargetHint::ShaderStorage}, _clusterBuffer{Buffer::TargetHint::ShaderStorage}, _lightIndexBuffer{Buffer::TargetHint::ShaderStorage} {
+    CORRADE_ASSERT(clusterCount.product() > 0,
+        "Shaders::LightClusters: expected non-zero cluster count but got" << clusterCount, );
+}
+
+LightClusters& LightClusters::setProjection(const Matrix4& projectionMatrix, const Float near, const Float far, const Vector2i& viewportSize) {
+    CORRADE_ASSERT(near > 0.0f && far > near,
+        "Shaders::LightClusters::setProjection(): expected 0 < near < far but got" << near << "and" << far, *this);
+    _projectionMatrix = projectionMatrix;
+    _near = near;
+    _far = far;
+    _viewportSize = viewportSize;
+    return *this;
+}
+
+Range3Di LightClusters::clusterRange(const Light& light) const {
+    /* Depth range of the bounding sphere, camera looks in -Z */
+    const Float depth = -light.position.z();
+    const Float minDepth = depth - light.range;
+    const Float maxDepth = depth + light.range;
+    if(maxDepth < _near || minDepth > _far) return {};
+
+    /* Depth slices are distributed exponentially, the same calculation is
+       done in the shader */
+    const Float sliceScale = _clusterCount.z()/std::log(_far/_near);
+    const Int minSlice = minDepth <= _near ? 0 :
+        Math::min(Int(std::log(minDepth/_near)*sliceScale), _clusterCount.z() - 1);
+    const Int maxSlice =
+        Math::min(Int(std::log(Math::min(maxDepth, _far)/_near)*sliceScale), _clusterCount.z() - 1);
+
+    /* Screen-space bounds of the sphere. If it crosses the near plane, the
+       projection is not well defined, so conservatively cover the whole
+       screen. Otherwise project the corners of its bounding box. */
+    Vector2 min{-1.0f}, max{1.0f};
+    if(minDepth > _near) {
+        min = Vector2{Constants::inf()};
+        max = Vector2{-Constants::inf()};
+        for(Int i = 0; i != 8; ++i) {
+            const Vector3 corner = light.position + Vector3{
+                i & 1 ? light.range : -light.range,
+                i & 2 ? light.range : -light.range,
+                i & 4 ? light.range : -light.range};
+            const Vector4 clip = _projectionMatrix*Vector4{corner, 1.0f};
+            const Vector2 ndc = clip.xy()/clip.w();
+            min = Math::min(min, ndc);
+            max = Math::max(max, ndc);
+        }
+
+        if((max < Vector2{-1.0f}).any() || (min > Vector2{1.0f}).any())
+            return {};
+    }
+
+    const Vector2i lastTile = _clusterCount.xy() - Vector2i{1};
+    const Vector2 tileScale = Vector2{_clusterCount.xy()}*0.5f;
+    const Vector2i minTile = Math::max(Math::min(Vector2i{Math::floor((min + Vector2{1.0f})*tileScale)}, lastTile), Vector2i{0});
+    const Vector2i maxTile = Math::max(Math::min(Vector2i{Math::floor((max + Vector2{1.0f})*tileScale)}, lastTile), Vector2i{0});
+
+    return {{minTile, minSlice}, {maxTile + Vector2i{1}, maxSlice + 1}};
+}
+
+LightClusters& LightClusters::update(const std::vector<Light>& lights) {
+    CORRADE_ASSERT(_far > _near,
+        "Shaders::LightClusters::update(): projection was not set", *this);
+
+    /* Count lights in each cluster first, so the index list can be
+       allocated at once */
+    _clusters.assign(_clusterCount.product(), {});
+    std::vector<Range3Di> ranges;
+    ranges.reserve(lights.size());
+    for(const Light& light: lights) {
+        const Range3Di range = clusterRange(light);
+        ranges.push_back(range);
+        for(Int z = range.min().z(); z < range.max().z(); ++z)
+            for(Int y = range.min().y(); y < range.max().y(); ++y)
+                for(Int x = range.min().x(); x < range.max().x(); ++x)
+                    ++_clusters[x + _clusterCount.x()*(y + _clusterCount.y()*z)].y();
+    }
+
+    /* Calculate offsets of each cluster and reset the counts back to zero,
+       they are incremented again when filling the indices */
+    UnsignedInt offset = 0;
+    for(Vector2ui& cluster: _clusters) {
+        cluster.x() = offset;
+        offset += cluster.y();
+        cluster.y() = 0;
+    }
+
+    /* Fill the indices. Lights are added in order, so each cluster has them
+       sorted by index. */
+    _lightIndices.assign(offset, 0);
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        const Range3Di& range = ranges[i];
+        for(Int z = range.min().z(); z < range.max().z(); ++z)
+            for(Int y = range.min().y(); y < range.max().y(); ++y)
+                for(Int x = range.min().x(); x < range.max().x(); ++x) {
+                    Vector2ui& cluster = _clusters[x + _clusterCount.x()*(y + _clusterCount.y()*z)];
+                    _lightIndices[cluster.x() + cluster.y()++] = UnsignedInt(i);
+                }
+    }
+
+    /* Empty buffers can't be bound as shader storage, upload at least one
+       item to each */
+    if(lights.empty())
+        _lightBuffer.setData({nullptr, sizeof(Light)}, BufferUsage::DynamicDraw);
+    else
+        _lightBuffer.setData(lights, BufferUsage::DynamicDraw);
+    _clusterBuffer.setData(_clusters, BufferUsage::DynamicDraw);
+    if(_lightIndices.empty())
+        _lightIndexBuffer.setData({nullptr, sizeof(UnsignedInt)}, BufferUsage::DynamicDraw);
+    else
+        _lightIndexBuffer.setData(_lightIndices, BufferUsage::DynamicDraw);
+
+    return *this;
+}
+
+}}
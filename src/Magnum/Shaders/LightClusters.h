@@ -0,0 +1,206 @@
+#ifndef Magnum_Shaders_LightClusters_h
+#define Magnum_Shaders_LightClusters_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::LightClusters
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Light clusters for clustered forward shading
+
+Bins point lights into clusters for @ref Phong with
+@ref Phong::Flag::ClusteredLights. The view frustum is divided into a grid
+of clusters --- @ref clusterCount() tiles in screen space and depth slices
+distributed exponentially between the near and far plane, so the clusters
+are roughly cubical. Each light is added to all clusters its bounding
+sphere overlaps and the fragment shader then iterates only the lights in
+the cluster the fragment is in, making the shading cost depend on the
+count of lights affecting given part of the screen instead of the total
+light count.
+
+The binning is done on the CPU in @ref update(), which then uploads the
+lights, the per-cluster light ranges and the light index list into three
+shader storage buffers. Light positions are expected in camera space, the
+same as with @ref Phong::setLightPosition().
+
+## Example usage
+
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::ClusteredLights};
+Shaders::LightClusters clusters;
+
+// each frame
+std::vector<Shaders::LightClusters::Light> lights;
+for(const PointLight& light: sceneLights)
+    lights.emplace_back(camera.cameraMatrix().transformPoint(light.position), light.range, light.color);
+
+clusters.setProjection(camera.projectionMatrix(), 0.1f, 100.0f, defaultFramebuffer.viewport().size())
+    .update(lights);
+shader.bindLightClusters(clusters)
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.rotation())
+    .setProjectionMatrix(camera.projectionMatrix());
+mesh.draw(shader);
+@endcode
+
+@requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Shader storage is not available in OpenGL ES 3.0 and
+    older.
+@requires_gles Shader storage is not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT LightClusters {
+    public:
+        /**
+         * @brief Point light
+         *
+         * Layout matches the `std430` struct in the shader.
+         */
+        struct Light {
+            /** @brief Constructor */
+            /*implicit*/ Light(const Vector3& position = {}, Float range = 1.0f, const Color4& color = Color4{1.0f}): position{position}, range{range}, color{color} {}
+
+            Vector3 position;   /**< @brief Position in camera space */
+
+            /**
+             * @brief Range
+             *
+             * The light intensity falls off smoothly with distance and
+             * reaches zero at this distance.
+             */
+            Float range;
+
+            Color4 color;       /**< @brief Light color */
+        };
+
+        /**
+         * @brief Constructor
+         * @param clusterCount  Count of clusters in horizontal, vertical and
+         *      depth direction
+         */
+        explicit LightClusters(const Vector3i& clusterCount = {16, 9, 24});
+
+        /** @brief Cluster count */
+        Vector3i clusterCount() const { return _clusterCount; }
+
+        /** @brief Projection matrix */
+        Matrix4 projectionMatrix() const { return _projectionMatrix; }
+
+        /** @brief Near plane distance */
+        Float near() const { return _near; }
+
+        /** @brief Far plane distance */
+        Float far() const { return _far; }
+
+        /** @brief Viewport size */
+        Vector2i viewportSize() const { return _viewportSize; }
+
+        /**
+         * @brief Set projection
+         * @param projectionMatrix  Perspective projection matrix
+         * @param near          Near plane distance
+         * @param far           Far plane distance
+         * @param viewportSize  Viewport size
+         * @return Reference to self (for method chaining)
+         *
+         * Needs to be called at least once before @ref update() and again
+         * every time the projection or viewport changes. The viewport is
+         * expected to start at origin.
+         */
+        LightClusters& setProjection(const Matrix4& projectionMatrix, Float near, Float far, const Vector2i& viewportSize);
+
+        /**
+         * @brief Bin the lights into clusters and upload them
+         * @return Reference to self (for method chaining)
+         *
+         * Lights that are completely outside of the view frustum are not
+         * added to any cluster.
+         */
+        LightClusters& update(const std::vector<Light>& lights);
+
+        /**
+         * @brief Light range of each cluster
+         *
+         * Offset into @ref lightIndices() and light count for each cluster.
+         * Clusters are ordered by X, then Y, then depth slice. Filled in
+         * @ref update().
+         */
+        const std::vector<Vector2ui>& clusters() const { return _clusters; }
+
+        /**
+         * @brief Light indices of all clusters
+         *
+         * Filled in @ref update().
+         */
+        const std::vector<UnsignedInt>& lightIndices() const { return _lightIndices; }
+
+        /**
+         * @brief Cluster range overlapped by a light
+         *
+         * Returns an empty range if the light is outside of the view
+         * frustum. Used internally by @ref update().
+         */
+        Range3Di clusterRange(const Light& light) const;
+
+        /** @brief Light buffer */
+        Buffer& lightBuffer() { return _lightBuffer; }
+
+        /** @brief Cluster buffer */
+        Buffer& clusterBuffer() { return _clusterBuffer; }
+
+        /** @brief Light index buffer */
+        Buffer& lightIndexBuffer() { return _lightIndexBuffer; }
+
+    private:
+        Vector3i _clusterCount;
+        Matrix4 _projectionMatrix;
+        Float _near, _far;
+        Vector2i _viewportSize;
+
+        std::vector<Vector2ui> _clusters;
+        std::vector<UnsignedInt> _lightIndices;
+        Buffer _lightBuffer, _clusterBuffer, _lightIndexBuffer;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
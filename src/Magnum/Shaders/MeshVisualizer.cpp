@@ -27,15 +27,26 @@
 
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/BufferTexture.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
 #include "MagnumExternal/Optional/optional.hpp"
 
 #include "Implementation/CreateCompatibilityShader.h"
+#include "Implementation/PrecompiledSpirv.h"
 
 namespace Magnum { namespace Shaders {
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace {
+    enum: Int {
+        IndexTextureLayer = 0,
+        PositionTextureLayer = 1
+    };
+}
+#endif
+
 MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationProjectionMatrixUniform(0), viewportSizeUniform(1), colorUniform(2), wireframeColorUniform(3), wireframeWidthUniform(4), smoothnessUniform(5) {
     #ifndef MAGNUM_TARGET_GLES2
     if(flags & Flag::Wireframe && !(flags & Flag::NoGeometryShader)) {
@@ -51,6 +62,16 @@ MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationP
         MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::OES::standard_derivatives);
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::VertexPulling) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        #else
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+        #endif
+    }
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -71,8 +92,16 @@ MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationP
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::VertexPulling)
+        vert.addSource("#extension GL_EXT_texture_buffer: require\n");
+    #endif
+
     vert.addSource(flags & Flag::Wireframe ? "#define WIREFRAME_RENDERING\n" : "")
         .addSource(flags & Flag::NoGeometryShader ? "#define NO_GEOMETRY_SHADER\n" : "")
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::VertexPulling ? "#define VERTEX_PULLING\n" : "")
+        #endif
         #ifdef MAGNUM_TARGET_WEBGL
         .addSource("#define SUBSCRIPTING_WORKAROUND\n")
         #elif defined(MAGNUM_TARGET_GLES2)
@@ -94,36 +123,56 @@ MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationP
     #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, *geom, frag}));
-    else
-    #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+    const bool cached = geom ? loadCachedBinary({vert, *geom, frag}) : loadCachedBinary({vert, frag});
     #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    const bool cached = loadCachedBinary({vert, frag});
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
+    if(!cached) {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) {
+            Implementation::usePrecompiledSpirv({vert, *geom, frag});
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, *geom, frag}));
+        } else
+        #endif
+        {
+            Implementation::usePrecompiledSpirv({vert, frag});
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+        }
+
+        attachShaders({vert, frag});
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) attachShader(*geom);
+        #endif
 
-        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!Context::current().isVersionSupported(Version::GL310))
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(!(flags & Flag::VertexPulling))
+            #endif
+                bindAttributeLocation(Position::Location, "position");
+
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!Context::current().isVersionSupported(Version::GL310))
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) saveCachedBinary({vert, *geom, frag});
+        else
         #endif
+            saveCachedBinary({vert, frag});
     }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
-
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
@@ -139,6 +188,18 @@ MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationP
         }
     }
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::VertexPulling && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #else
+    if(flags & Flag::VertexPulling)
+    #endif
+    {
+        setUniform(uniformLocation("indexTexture"), IndexTextureLayer);
+        setUniform(uniformLocation("positionTexture"), PositionTextureLayer);
+    }
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     setColor(Color3(1.0f));
@@ -150,4 +211,16 @@ MeshVisualizer::MeshVisualizer(const Flags flags): flags(flags), transformationP
     #endif
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+MeshVisualizer& MeshVisualizer::setIndexTexture(BufferTexture& texture) {
+    if(flags & Flag::VertexPulling) texture.bind(IndexTextureLayer);
+    return *this;
+}
+
+MeshVisualizer& MeshVisualizer::setPositionTexture(BufferTexture& texture) {
+    if(flags & Flag::VertexPulling) texture.bind(PositionTextureLayer);
+    return *this;
+}
+#endif
+
 }}
@@ -148,6 +148,45 @@ mesh.addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{});
 
 Rendering setup the same as above.
 
+@anchor MeshVisualizer-vertex-pulling
+### Wireframe visualization of indexed meshes with vertex pulling
+
+De-indexing the mesh duplicates every vertex, which for large meshes costs
+a lot of memory. With @ref Flag::VertexPulling the shader instead fetches
+the indices and positions from buffer textures using `gl_VertexID` and the
+mesh is drawn non-indexed, without any vertex attributes, with vertex count
+equal to the index count. The barycentric coordinates are derived from
+`gl_VertexID` as well, so the original buffers can be used directly and no
+geometry shader is needed. Positions can be stored as three or four
+component floats, indices as 16-bit or 32-bit unsigned integers:
+@code
+Buffer indices, positions;
+indices.setData(indexData, BufferUsage::StaticDraw);
+positions.setData(positionData, BufferUsage::StaticDraw);
+
+BufferTexture indexTexture, positionTexture;
+indexTexture.setBuffer(BufferTextureFormat::R32UI, indices);
+positionTexture.setBuffer(BufferTextureFormat::RGB32F, positions);
+
+Mesh mesh;
+mesh.setCount(indexData.size());
+
+Shaders::MeshVisualizer shader{Shaders::MeshVisualizer::Flag::Wireframe|
+                               Shaders::MeshVisualizer::Flag::VertexPulling};
+shader.setIndexTexture(indexTexture)
+    .setPositionTexture(positionTexture)
+    .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix);
+
+mesh.draw(shader);
+@endcode
+
+@requires_gl31 Extension @extension{ARB,texture_buffer_object} for vertex
+    pulling. @ref BufferTextureFormat::RGB32F positions need
+    @extension{ARB,texture_buffer_object_rgb32}.
+@requires_gles31 Extension @es_extension{EXT,texture_buffer} for vertex
+    pulling.
+@requires_gles Buffer textures are not available in WebGL.
+
 @see @ref shaders
 @todo Understand and add support wireframe width/smoothness without GS
 */
@@ -194,7 +233,22 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
              * attribute in the mesh. In OpenGL ES enabled alongside
              * @ref Flag::Wireframe.
              */
-            NoGeometryShader = 1 << 1
+            NoGeometryShader = 1 << 1,
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Fetch indices and positions from buffer textures set via
+             * @ref setIndexTexture() and @ref setPositionTexture() instead
+             * of the @ref Position attribute. Implies
+             * @ref Flag::NoGeometryShader. See
+             * @ref MeshVisualizer-vertex-pulling "above" for more
+             * information.
+             * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+             * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            VertexPulling = (1 << 2) | (1 << 1)
+            #endif
         };
 
         /** @brief Flags */
@@ -272,6 +326,35 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
          */
         MeshVisualizer& setSmoothness(Float smoothness);
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set index texture
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if @ref Flag::VertexPulling is enabled. Expects
+         * a texture with @ref BufferTextureFormat::R16UI or
+         * @ref BufferTextureFormat::R32UI format.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        MeshVisualizer& setIndexTexture(BufferTexture& texture);
+
+        /**
+         * @brief Set position texture
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if @ref Flag::VertexPulling is enabled. Expects
+         * a texture with @ref BufferTextureFormat::RGB32F or
+         * @ref BufferTextureFormat::RGBA32F format, the fourth component is
+         * ignored.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        MeshVisualizer& setPositionTexture(BufferTexture& texture);
+        #endif
+
     private:
         Flags flags;
         Int transformationProjectionMatrixUniform,
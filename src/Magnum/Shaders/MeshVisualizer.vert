@@ -33,10 +33,22 @@ layout(location = 0)
 #endif
 uniform highp mat4 transformationProjectionMatrix;
 
+#ifdef VERTEX_PULLING
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform highp usamplerBuffer indexTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform highp samplerBuffer positionTexture;
+#else
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
+#endif
 
 #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
 #if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
@@ -51,6 +63,12 @@ out vec3 barycentric;
 #endif
 
 void main() {
+    #ifdef VERTEX_PULLING
+    /* The mesh is drawn non-indexed, so gl_VertexID is the position in the
+       index buffer */
+    highp vec4 position = vec4(texelFetch(positionTexture, int(texelFetch(indexTexture, gl_VertexID).r)).xyz, 1.0);
+    #endif
+
     gl_Position = transformationProjectionMatrix*position;
 
     #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
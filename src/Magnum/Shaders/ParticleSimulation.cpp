@@ -0,0 +1,93 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ParticleSimulation.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+ParticleSimulation::ParticleSimulation() {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::compute_shader);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::shader_storage_buffer_object);
+    const Version version = Context::current().supportedVersion({Version::GL430, Version::GL420});
+    #else
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES310);
+    const Version version = Version::GLES310;
+    #endif
+
+    Shader comp = Implementation::createCompatibilityShader(rs, version, Shader::Type::Compute);
+    comp.addSource(rs.get("ParticleSimulation.comp"));
+
+    if(!loadCachedBinary({comp})) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+        attachShader(comp);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({comp});
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _timeDeltaUniform = uniformLocation("timeDelta");
+        _gravityUniform = uniformLocation("gravity");
+        _dampingUniform = uniformLocation("damping");
+        _emitterPositionUniform = uniformLocation("emitterPosition");
+        _emitterVelocityUniform = uniformLocation("emitterVelocity");
+        _spreadUniform = uniformLocation("spread");
+        _lifetimeUniform = uniformLocation("lifetime");
+        _seedUniform = uniformLocation("seed");
+    }
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setTimeDelta(0.0f);
+    setGravity({0.0f, -9.81f, 0.0f});
+    setDamping(0.0f);
+    setEmitterPosition({});
+    setEmitterVelocity({0.0f, 1.0f, 0.0f});
+    setSpread(1.0f);
+    setLifetime(1.0f);
+    setSeed(0);
+    #endif
+}
+
+}}
@@ -0,0 +1,264 @@
+#ifndef Magnum_Shaders_ParticleSimulation_h
+#define Magnum_Shaders_ParticleSimulation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleSimulation
+ */
+#endif
+
+#include "Magnum/AbstractComputeShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU particle simulation
+
+Compute shader that integrates a buffer of @ref Particle structures under
+constant gravity and linear damping. Particles with exhausted lifetime are
+respawned at the emitter position with randomized velocity and lifetime, so a
+zero-filled buffer is a valid initial state --- all particles are emitted in
+the first step.
+
+The particle data are never transferred to the CPU, the same buffer can be
+directly used as a vertex buffer for rendering.
+
+## Example usage
+
+Common setup:
+@code
+std::vector<Shaders::ParticleSimulation::Particle> data(100000);
+
+Buffer particles;
+particles.setData(data, BufferUsage::DynamicCopy);
+
+Mesh mesh;
+mesh.setPrimitive(MeshPrimitive::Points)
+    .setCount(100000)
+    .addVertexBuffer(particles, 0, Shaders::Flat3D::Position{}, 20);
+
+Shaders::ParticleSimulation simulation;
+simulation.setEmitterPosition({0.0f, 1.0f, 0.0f})
+    .setEmitterVelocity({0.0f, 5.0f, 0.0f})
+    .setSpread(1.5f)
+    .setLifetime(3.0f);
+@endcode
+
+Each frame:
+@code
+simulation.setTimeDelta(timeDelta)
+    .setSeed(frameIndex)
+    .bindParticleBuffer(particles)
+    .simulate(100000);
+
+Renderer::setMemoryBarrier(Renderer::MemoryBarrier::VertexAttributeArray);
+mesh.draw(flatShader);
+@endcode
+
+@requires_gl43 Extension @extension{ARB,compute_shader}
+@requires_gles31 Compute shaders are not available in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+@see @ref shaders, @ref AbstractComputeShaderProgram
+*/
+class MAGNUM_SHADERS_EXPORT ParticleSimulation: public AbstractComputeShaderProgram {
+    public:
+        /**
+         * @brief Particle data
+         *
+         * Layout matches the `std430` struct in the shader, the stride is
+         * 32 bytes.
+         */
+        struct Particle {
+            Vector3 position;   /**< Position */
+            Float lifetime;     /**< Remaining lifetime in seconds */
+            Vector3 velocity;   /**< Velocity */
+            Float reserved;     /**< Reserved, ignored by the shader */
+        };
+
+        /** @brief Shader storage buffer binding points */
+        enum: UnsignedInt {
+            /** Binding point for the particle buffer */
+            ParticleBufferBinding = 0
+        };
+
+        explicit ParticleSimulation();
+
+        /**
+         * @brief Set time delta
+         * @return Reference to self (for method chaining)
+         *
+         * Time in seconds to advance the simulation by. Default is `0.0f`.
+         */
+        ParticleSimulation& setTimeDelta(Float delta) {
+            setUniform(_timeDeltaUniform, delta);
+            return *this;
+        }
+
+        /**
+         * @brief Set gravity
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `{0.0f, -9.81f, 0.0f}`.
+         */
+        ParticleSimulation& setGravity(const Vector3& gravity) {
+            setUniform(_gravityUniform, gravity);
+            return *this;
+        }
+
+        /**
+         * @brief Set damping
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction of velocity lost per second. Default is `0.0f`.
+         */
+        ParticleSimulation& setDamping(Float damping) {
+            setUniform(_dampingUniform, damping);
+            return *this;
+        }
+
+        /**
+         * @brief Set emitter position
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `{0.0f, 0.0f, 0.0f}`.
+         */
+        ParticleSimulation& setEmitterPosition(const Vector3& position) {
+            setUniform(_emitterPositionUniform, position);
+            return *this;
+        }
+
+        /**
+         * @brief Set emitter velocity
+         * @return Reference to self (for method chaining)
+         *
+         * Base velocity of respawned particles. Default is
+         * `{0.0f, 1.0f, 0.0f}`.
+         */
+        ParticleSimulation& setEmitterVelocity(const Vector3& velocity) {
+            setUniform(_emitterVelocityUniform, velocity);
+            return *this;
+        }
+
+        /**
+         * @brief Set velocity spread
+         * @return Reference to self (for method chaining)
+         *
+         * Maximal random deviation added to the emitter velocity in each
+         * axis. Default is `1.0f`.
+         */
+        ParticleSimulation& setSpread(Float spread) {
+            setUniform(_spreadUniform, spread);
+            return *this;
+        }
+
+        /**
+         * @brief Set particle lifetime
+         * @return Reference to self (for method chaining)
+         *
+         * Maximal lifetime in seconds, respawned particles get a random
+         * lifetime between half and full of this value. Default is `1.0f`.
+         */
+        ParticleSimulation& setLifetime(Float lifetime) {
+            setUniform(_lifetimeUniform, lifetime);
+            return *this;
+        }
+
+        /**
+         * @brief Set random seed
+         * @return Reference to self (for method chaining)
+         *
+         * Should be changed every step, otherwise particles respawned at
+         * the same index get the same random values. Default is `0`.
+         */
+        ParticleSimulation& setSeed(UnsignedInt seed) {
+            setUniform(_seedUniform, seed);
+            return *this;
+        }
+
+        /**
+         * @brief Bind particle buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain tightly packed @ref Particle
+         * structures.
+         * @see @ref Buffer::bind()
+         */
+        ParticleSimulation& bindParticleBuffer(Buffer& buffer) {
+            buffer.bind(Buffer::Target::ShaderStorage, ParticleBufferBinding);
+            return *this;
+        }
+
+        /**
+         * @brief Bind particle buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * The @p offset is expected to respect
+         * @ref Buffer::shaderStorageOffsetAlignment().
+         * @see @ref Buffer::bind()
+         */
+        ParticleSimulation& bindParticleBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+            buffer.bind(Buffer::Target::ShaderStorage, ParticleBufferBinding, offset, size);
+            return *this;
+        }
+
+        /**
+         * @brief Run one simulation step
+         * @return Reference to self (for method chaining)
+         *
+         * Dispatches enough workgroups to process @p count particles. Put
+         * a @ref Renderer::setMemoryBarrier() "memory barrier" matching the
+         * way the buffer is going to be used afterwards, e.g.
+         * @ref Renderer::MemoryBarrier::VertexAttributeArray when rendering
+         * from it.
+         * @see @ref dispatchComputeInvocations()
+         */
+        ParticleSimulation& simulate(UnsignedInt count) {
+            dispatchComputeInvocations({count, 1, 1});
+            return *this;
+        }
+
+    private:
+        Int _timeDeltaUniform{0},
+            _gravityUniform{1},
+            _dampingUniform{2},
+            _emitterPositionUniform{3},
+            _emitterVelocityUniform{4},
+            _spreadUniform{5},
+            _lifetimeUniform{6},
+            _seedUniform{7};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -25,14 +25,31 @@
 
 #include "Phong.h"
 
+#include <cmath>
+#include <string>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/LightClusters.h"
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Shaders/ShadowCascades.h"
+#endif
+
 #include "Implementation/CreateCompatibilityShader.h"
+#include "Implementation/PrecompiledSpirv.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -40,11 +57,23 @@ namespace {
     enum: Int {
         AmbientTextureLayer = 0,
         DiffuseTextureLayer = 1,
-        SpecularTextureLayer = 2
+        SpecularTextureLayer = 2,
+        ShadowTextureLayer = 3,
+        TransformationTextureLayer = 4
     };
+
+    /* With bindless textures the texture units are not used at all */
+    bool usesTextureUnits(const Phong::Flags flags) {
+        #ifndef MAGNUM_TARGET_GLES
+        return !(flags & Phong::Flag::BindlessTextures);
+        #else
+        static_cast<void>(flags);
+        return true;
+        #endif
+    }
 }
 
-Phong::Phong(const Flags flags): transformationMatrixUniform(0), projectionMatrixUniform(1), normalMatrixUniform(2), lightUniform(3), diffuseColorUniform(4), ambientColorUniform(5), specularColorUniform(6), lightColorUniform(7), shininessUniform(8), _flags(flags) {
+Phong::CompileState Phong::compile(Flags flags) {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -52,8 +81,63 @@ Phong::Phong(const Flags flags): transformationMatrixUniform(0), projectionMatri
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    /* Texture arrays are bound to texture units, so bindless textures are
+       not used with them */
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::TextureArrays) flags &= ~Flag::BindlessTextures;
+    #endif
+
+    /* Bindless texture handles are stored in uniform buffers */
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    if(flags & Flag::BindlessTextures) flags |= Flag::UniformBuffers;
+    #endif
+
+    /* The light clusters are built for a single view */
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::MultiView) {
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::AMD::vertex_shader_layer);
+        flags &= ~Flag::ClusteredLights;
+    }
+    #endif
+
+    /* Shadows are only for the single light */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ClusteredLights) flags &= ~Flag::Shadows;
+    #endif
+
+    /* The palette replaces the per-instance transformation attribute */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::TransformationTexture) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        #else
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+        #endif
+        flags &= ~Flag::InstancedTransformation;
+    }
+    #endif
+
+    /* Integer outputs and attributes, array shadow samplers and texture
+       arrays need GLSL 1.30, buffer textures GLSL 1.40, instance ID and
+       layered rendering GLSL 1.50, bindless textures GLSL 4.00, shader storage GLSL 4.30 or an
+       extension */
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = flags & Flag::ClusteredLights ?
+        Context::current().supportedVersion({Version::GL430, Version::GL420}) :
+        flags & Flag::BindlessTextures ?
+        Context::current().supportedVersion({Version::GL400, Version::GL320}) :
+        flags & Flag::MultiView ?
+        Context::current().supportedVersion({Version::GL320}) :
+        flags & Flag::TransformationTexture ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310}) :
+        flags & (Flag::ObjectId|Flag::Shadows|Flag::DualQuaternionSkinning|Flag::TextureArrays) ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ClusteredLights)
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES310);
+    const Version version = flags & (Flag::ClusteredLights|Flag::TransformationTexture) ? Version::GLES310 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -61,31 +145,160 @@ Phong::Phong(const Flags flags): transformationMatrixUniform(0), projectionMatri
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    vert.addSource(flags ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
-        .addSource(rs.get("Phong.vert"));
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::ClusteredLights && version < Version::GL430)
+        frag.addSource("#extension GL_ARB_shader_storage_buffer_object: require\n");
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::TransformationTexture)
+        vert.addSource("#extension GL_EXT_texture_buffer: require\n");
+    #endif
+
+    vert.addSource(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture) ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::UniformBuffers ? "#define UNIFORM_BUFFERS\n" : "")
+        .addSource(flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::ClusteredLights ? "#define CLUSTERED_LIGHTS\n" : "")
+        .addSource(flags & Flag::TransformationTexture ? "#define TRANSFORMATION_TEXTURE\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"));
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::MultiView)
+        vert.addSource("#extension GL_AMD_vertex_shader_layer: require\n#define MULTI_VIEW\n#define MAX_VIEW_COUNT " + std::to_string(MaxViewCount) + "\n");
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::DualQuaternionSkinning)
+        vert.addSource("#define DUAL_QUATERNION_SKINNING\n#define MAX_JOINT_COUNT " + std::to_string(MaxJointCount) + "\n")
+            .addSource(rs.get("DualQuaternionSkinning.glsl"));
+    #endif
+    vert.addSource(rs.get("Phong.vert"));
     frag.addSource(flags & Flag::AmbientTexture ? "#define AMBIENT_TEXTURE\n" : "")
         .addSource(flags & Flag::DiffuseTexture ? "#define DIFFUSE_TEXTURE\n" : "")
         .addSource(flags & Flag::SpecularTexture ? "#define SPECULAR_TEXTURE\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::UniformBuffers ? "#define UNIFORM_BUFFERS\n" : "")
+        .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
+        .addSource(flags & Flag::Shadows ? "#define SHADOWS\n" : "")
+        .addSource(flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::ClusteredLights ? "#define CLUSTERED_LIGHTS\n" : "")
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        .addSource(flags & Flag::BindlessTextures ? "#extension GL_ARB_bindless_texture: require\n#define BINDLESS_TEXTURES\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    Phong out{SubmitTag{}, flags};
+
+    const bool cached = out.loadCachedBinary({vert, frag});
+    if(!cached) {
+        Implementation::usePrecompiledSpirv({vert, frag});
+        Shader::submitCompile({vert, frag});
+
+        out.attachShaders({vert, frag});
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            out.bindAttributeLocation(Normal::Location, "normal");
+            if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture))
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags & Flag::InstancedTransformation)
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::DualQuaternionSkinning) {
+                out.bindAttributeLocation(JointIds::Location, "jointIds");
+                out.bindAttributeLocation(Weights::Location, "weights");
+            }
+            if(flags & Flag::TextureArrays)
+                out.bindAttributeLocation(TextureArrayLayer::Location, "textureArrayLayer");
+            #endif
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags & Flag::ObjectId) {
+                out.bindFragmentDataLocation(ColorOutput, "color");
+                out.bindFragmentDataLocation(ObjectIdOutput, "fragmentObjectId");
+            }
+            #endif
+        }
+
+        submitLink({out});
+    }
 
-    attachShaders({vert, frag});
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
 
+Phong::Phong(SubmitTag, const Flags flags): transformationMatrixUniform(0), projectionMatrixUniform(1), normalMatrixUniform(2), lightUniform(3), diffuseColorUniform(4), ambientColorUniform(5), specularColorUniform(6), lightColorUniform(7), shininessUniform(8),
+    #ifndef MAGNUM_TARGET_GLES2
+    objectIdUniform(flags & Flag::ObjectId ? 9 : -1),
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    clusterCountUniform(flags & Flag::ClusteredLights ? 10 : -1),
+    clusterParametersUniform(flags & Flag::ClusteredLights ? 11 : -1),
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    shadowMatricesUniform(flags & Flag::Shadows ? 12 : -1),
+    shadowSplitsUniform(flags & Flag::Shadows ? 16 : -1),
+    shadowCascadeCountUniform(flags & Flag::Shadows ? 17 : -1),
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    viewProjectionMatricesUniform(flags & Flag::MultiView ? 18 : -1),
+    viewCountUniform(flags & Flag::MultiView ? 18 + MaxViewCount : -1),
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(Normal::Location, "normal");
-        if(flags) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    transformationTextureOffsetUniform(flags & Flag::TransformationTexture ? 25 : -1),
+    #endif
+    _flags(flags) {}
+
+Phong::Phong(const Flags flags): Phong{compile(flags)} {}
+
+Phong::Phong(CompileState&& state): Phong{static_cast<Phong&&>(std::move(state))} {
+    /* The state was moved only partially, the shaders are still there */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::checkCompile({state._vert, state._frag}) && checkLink({*this}));
+        saveCachedBinary({state._vert, state._frag});
     }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    const Flags flags = _flags;
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = state._version;
+    #else
+    static_cast<void>(state._version);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* The joints are always in a block */
+    if(flags & Flag::DualQuaternionSkinning)
+        setUniformBlockBinding(uniformBlockIndex("Joints"), JointBufferBinding);
 
+    /* The uniforms are in blocks, make the setters do nothing */
+    if(flags & Flag::UniformBuffers) {
+        #ifndef MAGNUM_TARGET_GLES
+        /* The projection block is not used with multiple views */
+        if(!(flags & Flag::MultiView))
+        #endif
+            setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* The light block is not used with clustered lights */
+        if(!(flags & Flag::ClusteredLights))
+        #endif
+            setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+        #ifndef MAGNUM_TARGET_GLES
+        if(flags & Flag::BindlessTextures)
+            setUniformBlockBinding(uniformBlockIndex("Textures"), TextureBufferBinding);
+        #endif
+        transformationMatrixUniform = projectionMatrixUniform = normalMatrixUniform = lightUniform = ambientColorUniform = diffuseColorUniform = specularColorUniform = lightColorUniform = shininessUniform = -1;
+    } else
+    #endif
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
@@ -93,16 +306,103 @@ Phong::Phong(const Flags flags): transformationMatrixUniform(0), projectionMatri
         transformationMatrixUniform = uniformLocation("transformationMatrix");
         projectionMatrixUniform = uniformLocation("projectionMatrix");
         normalMatrixUniform = uniformLocation("normalMatrix");
-        lightUniform = uniformLocation("light");
         ambientColorUniform = uniformLocation("ambientColor");
         diffuseColorUniform = uniformLocation("diffuseColor");
         specularColorUniform = uniformLocation("specularColor");
-        lightColorUniform = uniformLocation("lightColor");
         shininessUniform = uniformLocation("shininess");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(!(flags & Flag::ClusteredLights))
+        #endif
+        {
+            lightUniform = uniformLocation("light");
+            lightColorUniform = uniformLocation("lightColor");
+        }
     }
 
+    /* The single light is not used with clustered lights */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ClusteredLights) lightUniform = lightColorUniform = -1;
+    #endif
+
+    /* Object ID is not in any uniform block */
+    #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    if(flags & Flag::ObjectId && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #else
+    if(flags & Flag::ObjectId)
+    #endif
+    {
+        objectIdUniform = uniformLocation("objectId");
+    }
+    #endif
+
+    /* Cluster parameters are not in any uniform block either */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::ClusteredLights && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #else
+    if(flags & Flag::ClusteredLights)
+    #endif
+    {
+        clusterCountUniform = uniformLocation("clusterCount");
+        clusterParametersUniform = uniformLocation("clusterParameters");
+    }
+    #endif
+
+    /* Neither are shadow parameters */
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::Shadows && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #else
+    if(flags & Flag::Shadows)
+    #endif
+    {
+        shadowMatricesUniform = uniformLocation("shadowMatrices");
+        shadowSplitsUniform = uniformLocation("shadowSplits");
+        shadowCascadeCountUniform = uniformLocation("shadowCascadeCount");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::Shadows && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #else
+    if(flags & Flag::Shadows)
+    #endif
+    {
+        setUniform(uniformLocation("shadowTexture"), ShadowTextureLayer);
+    }
+    #endif
+
+    /* Nor are the views */
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::MultiView && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version)) {
+        viewProjectionMatricesUniform = uniformLocation("viewProjectionMatrices");
+        viewCountUniform = uniformLocation("viewCount");
+    }
+    #endif
+
+    /* Nor is the transformation palette */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::TransformationTexture && !Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #else
+    if(flags & Flag::TransformationTexture)
+    #endif
+    {
+        transformationTextureOffsetUniform = uniformLocation("transformationTextureOffset");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::TransformationTexture && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #else
+    if(flags & Flag::TransformationTexture)
+    #endif
+    {
+        setUniform(uniformLocation("transformationTexture"), TransformationTextureLayer);
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture) && usesTextureUnits(flags) && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
         if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
@@ -124,24 +424,211 @@ Phong::Phong(const Flags flags): transformationMatrixUniform(0), projectionMatri
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Phong& Phong::setViewProjectionMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(_flags & Flag::MultiView,
+        "Shaders::Phong::setViewProjectionMatrices(): the shader was not created with multi-view rendering enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= MaxViewCount,
+        "Shaders::Phong::setViewProjectionMatrices(): expected at most" << MaxViewCount << "matrices, got" << matrices.size(), *this);
+    setUniform(viewProjectionMatricesUniform, Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>>{matrices.data(), matrices.size()});
+    setUniform(viewCountUniform, Int(matrices.size()));
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Phong& Phong::setTransformationTexture(BufferTexture& texture) {
+    CORRADE_ASSERT(_flags & Flag::TransformationTexture,
+        "Shaders::Phong::setTransformationTexture(): the shader was not created with transformation texture enabled", *this);
+    texture.bind(TransformationTextureLayer);
+    return *this;
+}
+
+Phong& Phong::setTransformationTextureOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::TransformationTexture,
+        "Shaders::Phong::setTransformationTextureOffset(): the shader was not created with transformation texture enabled", *this);
+    setUniform(transformationTextureOffsetUniform, Int(offset));
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::bindProjectionBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, ProjectionBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, ProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, LightBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Phong& Phong::bindLightClusters(LightClusters& clusters) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::bindLightClusters(): the shader was not created with clustered lights enabled", *this);
+    const Vector3i count = clusters.clusterCount();
+    const Vector2i viewportSize = clusters.viewportSize();
+    setUniform(clusterCountUniform, Vector3ui{count});
+    setUniform(clusterParametersUniform, Vector4{
+        Float(viewportSize.x()), Float(viewportSize.y()), clusters.near(),
+        count.z()/std::log(clusters.far()/clusters.near())});
+    clusters.lightBuffer().bind(Buffer::Target::ShaderStorage, ClusterLightBufferBinding);
+    clusters.clusterBuffer().bind(Buffer::Target::ShaderStorage, ClusterBufferBinding);
+    clusters.lightIndexBuffer().bind(Buffer::Target::ShaderStorage, ClusterLightIndexBufferBinding);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setShadowCascades(ShadowCascades& cascades) {
+    CORRADE_ASSERT(_flags & Flag::Shadows,
+        "Shaders::Phong::setShadowCascades(): the shader was not created with shadows enabled", *this);
+
+    /* Unused cascades start at infinity so they're never selected */
+    Math::RectangularMatrix<4, 4, Float> matrices[ShadowCascades::MaxCascadeCount];
+    Vector4 splits{Constants::inf()};
+    for(Int i = 0; i != cascades.cascadeCount(); ++i) {
+        matrices[i] = cascades.shadowMatrix(i);
+        splits[i] = cascades.splitDistance(i);
+    }
+
+    setUniform(shadowMatricesUniform, Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>>{matrices});
+    setUniform(shadowSplitsUniform, splits);
+    setUniform(shadowCascadeCountUniform, cascades.cascadeCount());
+    cascades.depthTexture().bind(ShadowTextureLayer);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+Phong& Phong::bindTextureBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::BindlessTextures,
+        "Shaders::Phong::bindTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TextureBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTextureBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::BindlessTextures,
+        "Shaders::Phong::bindTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, TextureBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::bindJointBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::DualQuaternionSkinning,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with dual quaternion skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::DualQuaternionSkinning,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with dual quaternion skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 Phong& Phong::setAmbientTexture(Texture2D& texture) {
-    if(_flags & Flag::AmbientTexture) texture.bind(AmbientTextureLayer);
+    if(_flags & Flag::AmbientTexture && usesTextureUnits(_flags)) texture.bind(AmbientTextureLayer);
     return *this;
 }
 
 Phong& Phong::setDiffuseTexture(Texture2D& texture) {
-    if(_flags & Flag::DiffuseTexture) texture.bind(DiffuseTextureLayer);
+    if(_flags & Flag::DiffuseTexture && usesTextureUnits(_flags)) texture.bind(DiffuseTextureLayer);
     return *this;
 }
 
 Phong& Phong::setSpecularTexture(Texture2D& texture) {
-    if(_flags & Flag::SpecularTexture) texture.bind(SpecularTextureLayer);
+    if(_flags & Flag::SpecularTexture && usesTextureUnits(_flags)) texture.bind(SpecularTextureLayer);
     return *this;
 }
 
 Phong& Phong::setTextures(Texture2D* ambient, Texture2D* diffuse, Texture2D* specular) {
+    if(usesTextureUnits(_flags))
+        AbstractTexture::bind(AmbientTextureLayer, {ambient, diffuse, specular});
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setAmbientTexture(Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::Phong::setAmbientTexture(): the shader was not created with texture arrays enabled", *this);
+    if(_flags & Flag::AmbientTexture) texture.bind(AmbientTextureLayer);
+    return *this;
+}
+
+Phong& Phong::setDiffuseTexture(Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::Phong::setDiffuseTexture(): the shader was not created with texture arrays enabled", *this);
+    if(_flags & Flag::DiffuseTexture) texture.bind(DiffuseTextureLayer);
+    return *this;
+}
+
+Phong& Phong::setSpecularTexture(Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::Phong::setSpecularTexture(): the shader was not created with texture arrays enabled", *this);
+    if(_flags & Flag::SpecularTexture) texture.bind(SpecularTextureLayer);
+    return *this;
+}
+
+Phong& Phong::setTextures(Texture2DArray* ambient, Texture2DArray* diffuse, Texture2DArray* specular) {
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::Phong::setTextures(): the shader was not created with texture arrays enabled", *this);
     AbstractTexture::bind(AmbientTextureLayer, {ambient, diffuse, specular});
     return *this;
 }
+#endif
 
 }}
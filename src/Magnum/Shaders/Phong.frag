@@ -33,6 +33,43 @@
 #define const
 #endif
 
+#ifdef UNIFORM_BUFFERS
+#ifndef CLUSTERED_LIGHTS
+layout(std140) uniform Light {
+    highp vec3 light;
+    lowp vec4 lightColor;
+};
+#endif
+
+layout(std140) uniform Material {
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    mediump float shininess;
+};
+#endif
+
+#ifdef BINDLESS_TEXTURES
+layout(std140) uniform Textures {
+    highp uvec2 ambientTextureHandle;
+    highp uvec2 diffuseTextureHandle;
+    highp uvec2 specularTextureHandle;
+};
+
+#define ambientTexture sampler2D(ambientTextureHandle)
+#define diffuseTexture sampler2D(diffuseTextureHandle)
+#define specularTexture sampler2D(specularTextureHandle)
+#endif
+
+#ifdef TEXTURE_ARRAYS
+#define textureSampler sampler2DArray
+#define textureCoords vec3(interpolatedTextureCoords, interpolatedTextureArrayLayer)
+#else
+#define textureSampler sampler2D
+#define textureCoords interpolatedTextureCoords
+#endif
+
+#if !defined(UNIFORM_BUFFERS) && !defined(CLUSTERED_LIGHTS)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 7)
 #endif
@@ -41,7 +78,66 @@ uniform lowp vec4 lightColor
     = vec4(1.0)
     #endif
     ;
+#endif
+
+#ifdef CLUSTERED_LIGHTS
+/* Matches Shaders::LightClusters::Light */
+struct ClusterLight {
+    highp vec4 positionRange;
+    lowp vec4 color;
+};
+
+layout(std430, binding = 0) readonly buffer ClusterLights {
+    ClusterLight clusterLights[];
+};
+
+/* Offset into clusterLightIndices and light count for each cluster */
+layout(std430, binding = 1) readonly buffer Clusters {
+    highp uvec2 clusters[];
+};
+
+layout(std430, binding = 2) readonly buffer ClusterLightIndices {
+    highp uint clusterLightIndices[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform highp uvec3 clusterCount;
 
+/* Viewport size, near plane distance and depth slice count divided by
+   log(far/near) */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 11)
+#endif
+uniform highp vec4 clusterParameters;
+#endif
+
+#ifdef SHADOWS
+/* Transform camera coordinates to shadow map coordinates of each cascade */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 12)
+#endif
+uniform highp mat4 shadowMatrices[4];
+
+/* Distances where the cascades end, unused cascades are at infinity */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 16)
+#endif
+uniform highp vec4 shadowSplits;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 17)
+#endif
+uniform highp int shadowCascadeCount; /* defaults to zero */
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 3)
+#endif
+uniform lowp sampler2DArrayShadow shadowTexture;
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 8)
 #endif
@@ -50,14 +146,16 @@ uniform mediump float shininess
     = 80.0
     #endif
     ;
+#endif
 
-#ifdef AMBIENT_TEXTURE
+#if defined(AMBIENT_TEXTURE) && !defined(BINDLESS_TEXTURES)
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 0)
 #endif
-uniform lowp sampler2D ambientTexture;
+uniform lowp textureSampler ambientTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
@@ -70,14 +168,16 @@ uniform lowp vec4 ambientColor
     #endif
     #endif
     ;
+#endif
 
-#ifdef DIFFUSE_TEXTURE
+#if defined(DIFFUSE_TEXTURE) && !defined(BINDLESS_TEXTURES)
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 1)
 #endif
-uniform lowp sampler2D diffuseTexture;
+uniform lowp textureSampler diffuseTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -86,14 +186,16 @@ uniform lowp vec4 diffuseColor
     = vec4(1.0)
     #endif
     ;
+#endif
 
-#ifdef SPECULAR_TEXTURE
+#if defined(SPECULAR_TEXTURE) && !defined(BINDLESS_TEXTURES)
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 2)
 #endif
-uniform lowp sampler2D specularTexture;
+uniform lowp textureSampler specularTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -102,33 +204,78 @@ uniform lowp vec4 specularColor
     = vec4(1.0)
     #endif
     ;
+#endif
 
 in mediump vec3 transformedNormal;
+#ifdef CLUSTERED_LIGHTS
+in highp vec3 viewPosition;
+#else
 in highp vec3 lightDirection;
+#endif
 in highp vec3 cameraDirection;
 
 #if defined(AMBIENT_TEXTURE) || defined(DIFFUSE_TEXTURE) || defined(SPECULAR_TEXTURE)
 in mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifdef TEXTURE_ARRAYS
+flat in highp float interpolatedTextureArrayLayer;
+#endif
+
+#ifdef OBJECT_ID
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 9)
+#endif
+uniform highp uint objectId; /* defaults to zero */
+#endif
+
 #ifdef NEW_GLSL
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
 out lowp vec4 color;
 #endif
+#ifdef OBJECT_ID
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = OBJECT_ID_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out highp uint fragmentObjectId;
+#endif
+
+#ifdef SHADOWS
+lowp float shadow() {
+    /* Find the cascade, camera looks in -Z */
+    highp vec3 position = -cameraDirection;
+    highp int cascade = int(dot(vec4(greaterThan(vec4(-position.z), shadowSplits)), vec4(1.0)));
+    if(cascade >= shadowCascadeCount) return 1.0;
+
+    /* The projection is orthographic, no need to divide by W. Percentage
+       closer filtering over 3x3 texels, each sample is additionally
+       bilinearly filtered by the hardware. */
+    highp vec3 shadowPosition = (shadowMatrices[cascade]*vec4(position, 1.0)).xyz;
+    highp vec2 texelSize = 1.0/vec2(textureSize(shadowTexture, 0).xy);
+    lowp float visibility = 0.0;
+    for(int x = -1; x <= 1; ++x)
+        for(int y = -1; y <= 1; ++y)
+            visibility += texture(shadowTexture, vec4(shadowPosition.xy + vec2(x, y)*texelSize, float(cascade), shadowPosition.z));
+    return visibility/9.0;
+}
+#endif
 
 void main() {
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
-        texture(ambientTexture, interpolatedTextureCoords)*
+        texture(ambientTexture, textureCoords)*
         #endif
         ambientColor;
     lowp const vec4 finalDiffuseColor =
         #ifdef DIFFUSE_TEXTURE
-        texture(diffuseTexture, interpolatedTextureCoords)*
+        texture(diffuseTexture, textureCoords)*
         #endif
         diffuseColor;
     lowp const vec4 finalSpecularColor =
         #ifdef SPECULAR_TEXTURE
-        texture(specularTexture, interpolatedTextureCoords)*
+        texture(specularTexture, textureCoords)*
         #endif
         specularColor;
 
@@ -136,16 +283,62 @@ void main() {
     color = finalAmbientColor;
 
     mediump vec3 normalizedTransformedNormal = normalize(transformedNormal);
+
+    #ifdef CLUSTERED_LIGHTS
+    /* Find the cluster, depth slices are distributed exponentially. The
+       same calculation is done in Shaders::LightClusters. */
+    highp vec3 clusterPosition = vec3(
+        gl_FragCoord.xy/clusterParameters.xy*vec2(clusterCount.xy),
+        log(max(-viewPosition.z/clusterParameters.z, 1.0))*clusterParameters.w);
+    highp uvec3 cluster = min(uvec3(clusterPosition), clusterCount - uvec3(1u));
+    highp uvec2 lightRange = clusters[cluster.x + clusterCount.x*(cluster.y + clusterCount.y*cluster.z)];
+    highp vec3 normalizedCameraDirection = normalize(cameraDirection);
+
+    for(highp uint i = lightRange.x, end = lightRange.x + lightRange.y; i != end; ++i) {
+        ClusterLight clusterLight = clusterLights[clusterLightIndices[i]];
+
+        /* Smooth falloff reaching zero at the light range */
+        highp vec3 direction = clusterLight.positionRange.xyz - viewPosition;
+        highp float distanceSquared = dot(direction, direction);
+        highp float falloff = clamp(1.0 - distanceSquared/(clusterLight.positionRange.w*clusterLight.positionRange.w), 0.0, 1.0);
+        falloff *= falloff;
+        if(falloff == 0.0) continue;
+
+        /* Add diffuse color */
+        highp vec3 normalizedLightDirection = direction*inversesqrt(distanceSquared);
+        lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection));
+        color += finalDiffuseColor*clusterLight.color*intensity*falloff;
+
+        /* Add specular color, if needed */
+        if(intensity > 0.001) {
+            highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
+            mediump float specularity = pow(max(0.0, dot(normalizedCameraDirection, reflection)), shininess);
+            color += finalSpecularColor*clusterLight.color*specularity*falloff;
+        }
+    }
+    #else
     highp vec3 normalizedLightDirection = normalize(lightDirection);
 
+    /* Diffuse and specular are attenuated by shadow */
+    #ifdef SHADOWS
+    lowp float visibility = shadow();
+    #else
+    lowp const float visibility = 1.0;
+    #endif
+
     /* Add diffuse color */
     lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection));
-    color += finalDiffuseColor*lightColor*intensity;
+    color += finalDiffuseColor*lightColor*intensity*visibility;
 
     /* Add specular color, if needed */
     if(intensity > 0.001) {
         highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
         mediump float specularity = pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess);
-        color += finalSpecularColor*specularity;
+        color += finalSpecularColor*specularity*visibility;
     }
+    #endif
+
+    #ifdef OBJECT_ID
+    fragmentObjectId = objectId;
+    #endif
 }
@@ -29,9 +29,11 @@
  * @brief Class @ref Magnum::Shaders::Phong
  */
 
+#include "Magnum/Shader.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Shaders.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
@@ -144,6 +146,238 @@ shader.setTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr)
     .setSpecularColor(Color4{specularRgb, 0.0f});
 @endcode
 
+### Instanced rendering
+
+With @ref Flag::InstancedTransformation the shader takes additional
+per-instance @ref TransformationMatrix attribute. The transformation matrix
+set via @ref setTransformationMatrix() is multiplied with it and the normal
+matrix set via @ref setNormalMatrix() with its upper-left 3x3 part, so the
+per-instance transformations are expected to not contain non-uniform scaling.
+See @ref Flat-instanced "Flat shader documentation" for an example.
+
+@anchor Phong-uniform-buffers
+### Uniform buffers
+
+With @ref Flag::UniformBuffers the uniforms are not set one by one with the
+`set*()` functions (which then do nothing), but are taken from buffers bound
+to uniform buffer binding points. The per-frame @ref ProjectionUniform and
+@ref LightUniform and per-material @ref MaterialUniform data are uploaded
+once and shared by all draws, the per-draw @ref TransformationUniform data
+can be all put into a single buffer and each draw then needs just a single
+range bind. The offsets need to be aligned to
+@ref Buffer::uniformOffsetAlignment():
+
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::UniformBuffers};
+
+Shaders::Phong::ProjectionUniform projectionData{projectionMatrix};
+Shaders::Phong::LightUniform lightData{{5.0f, 5.0f, 7.0f}};
+Shaders::Phong::MaterialUniform materialData;
+
+Buffer projection, light, material;
+projection.setData({&projectionData, 1}, BufferUsage::DynamicDraw);
+light.setData({&lightData, 1}, BufferUsage::DynamicDraw);
+material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+shader.bindProjectionBuffer(projection)
+    .bindLightBuffer(light)
+    .bindMaterialBuffer(material);
+
+const GLintptr stride = ...; // sizeof(TransformationUniform) rounded up to the alignment
+Buffer transformations;
+// fill with a TransformationUniform for each drawable at i*stride
+
+for(std::size_t i = 0; i != meshes.size(); ++i) {
+    shader.bindTransformationBuffer(transformations, i*stride, sizeof(Shaders::Phong::TransformationUniform));
+    meshes[i].draw(shader);
+}
+@endcode
+
+The buffers are bound to indexed binding points listed in @ref BufferBinding,
+which are global state, so the per-frame buffers need to be bound again only
+after another shader used the same binding points.
+
+@anchor Phong-bindless-textures
+### Bindless textures
+
+With @ref Flag::BindlessTextures (which implies @ref Flag::UniformBuffers) the
+textures are not bound to texture units, but referenced by handles from
+@ref AbstractTexture::handle() stored in a @ref TextureUniform buffer. The
+textures need to be made resident first. The handles of all materials can be
+put into a single buffer, switching to a different set of textures is then
+just a range bind, with no texture binds at all:
+
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|
+                      Shaders::Phong::Flag::BindlessTextures};
+
+std::vector<Shaders::Phong::TextureUniform> textureData;
+for(Texture2D& texture: diffuseTextures) {
+    texture.setResident(true);
+    textureData.emplace_back(0, texture.handle());
+}
+Buffer textures;
+// upload textureData, each item padded to Buffer::uniformOffsetAlignment()
+
+for(std::size_t i = 0; i != meshes.size(); ++i) {
+    shader.bindTextureBuffer(textures, materialIds[i]*stride, sizeof(Shaders::Phong::TextureUniform));
+    meshes[i].draw(shader);
+}
+@endcode
+
+@anchor Phong-texture-arrays
+### Texture arrays
+
+With @ref Flag::TextureArrays the textures are
+@ref Texture2DArray "Texture2DArray"s and the layer is taken from the
+@ref TextureArrayLayer attribute, which is the same for all textures. If the
+layer is supplied per instance, objects with different materials can be
+drawn in a single instanced draw, or with @ref MeshView::setBaseInstance()
+and @ref MeshView::multiDraw() even if they have different meshes. The
+arrays can be created from separate textures using
+@ref TextureTools::TextureArrayPacker, the textures of one material are
+expected to be at the same layer in all arrays.
+
+@code
+Mesh mesh;
+mesh.addVertexBuffer(vertices, 0,
+    Shaders::Phong::Position{},
+    Shaders::Phong::Normal{},
+    Shaders::Phong::TextureCoordinates{})
+    .addVertexBufferInstanced(instances, 1, 0,
+        Shaders::Phong::TransformationMatrix{},
+        Shaders::Phong::TextureArrayLayer{})
+    .setInstanceCount(instanceCount);
+
+Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|
+                      Shaders::Phong::Flag::TextureArrays|
+                      Shaders::Phong::Flag::InstancedTransformation};
+shader.setDiffuseTexture(diffuseArray);
+mesh.draw(shader);
+@endcode
+
+@anchor Phong-clustered-lights
+### Clustered lights
+
+With @ref Flag::ClusteredLights the shader doesn't use the single light set
+via @ref setLightPosition() and @ref setLightColor(), but an arbitrary count
+of point lights binned into view-space clusters by @ref LightClusters. Each
+fragment iterates only the lights affecting its cluster, so scenes with
+hundreds of small lights can be drawn in a single pass. See the
+@ref LightClusters documentation for an example. The light intensity falls
+off smoothly with distance from the light and reaches zero at
+@ref LightClusters::Light::range.
+
+@anchor Phong-shadows
+### Shadows
+
+With @ref Flag::Shadows the light is shadowed using cascaded shadow maps
+rendered with @ref ShadowCascades. The cascade is selected based on the
+fragment depth and the shadow map is sampled with 3x3 percentage-closer
+filtering on top of hardware depth comparison, giving soft shadow edges.
+Ambient color is not affected by shadows. See the @ref ShadowCascades
+documentation for an example. The shadow maps are rendered for a
+directional light, so the light position should be set far away in the
+opposite of @ref ShadowCascades::lightDirection().
+
+@anchor Phong-skinning
+### Dual quaternion skinning
+
+With @ref Flag::DualQuaternionSkinning each vertex is transformed by a blend
+of up to four joints given by the @ref JointIds and @ref Weights attributes
+before applying the transformation matrix. The joints are taken as an array of
+normalized @ref DualQuaternion "DualQuaternion"s, containing the inverse bind
+pose already, from a buffer bound with @ref bindJointBuffer(). Unlike blending
+matrices, blending dual quaternions doesn't make the skin collapse around
+twisted joints and the joint data are half the size. The joint data layout is
+the same as @ref MeshTools::skinDualQuaternionsInto() takes, so the
+same data can be used for skinning on the CPU when needed:
+
+@code
+Mesh mesh;
+mesh.addVertexBuffer(vertices, 0,
+    Shaders::Phong::Position{},
+    Shaders::Phong::Normal{},
+    Shaders::Phong::JointIds{},
+    Shaders::Phong::Weights{});
+
+Shaders::Phong shader{Shaders::Phong::Flag::DualQuaternionSkinning};
+
+std::vector<DualQuaternion> jointData; // at most Phong::MaxJointCount
+Buffer joints;
+joints.setData(jointData, BufferUsage::StreamDraw);
+
+// each frame, after updating the joints
+shader.bindJointBuffer(joints);
+mesh.draw(shader);
+@endcode
+
+The joints of all characters can be put into a single buffer, each draw then
+needs just a range bind aligned to @ref Buffer::uniformOffsetAlignment().
+
+### Object ID picking
+
+With @ref Flag::ObjectId the shader writes a value set via @ref setObjectId()
+to an additional @ref ObjectIdOutput. See @ref Flat-object-id "Flat shader
+documentation" for an example of the picking setup, which is the same for this
+shader.
+
+@anchor Phong-multi-view
+### Multi-view rendering
+
+With @ref Flag::MultiView the mesh is drawn into several views, such as two
+eyes of a stereo pair or six faces of a cube map, in a single instanced draw
+call. Instance @f$ i @f$ is projected with view projection matrix
+@f$ i \bmod n @f$ set via @ref setViewProjectionMatrices() and written to
+layer of the same index of a layered framebuffer. The transformation, normal
+matrix and light position stay relative to the camera object, so the lighting
+is computed only once for all views, from the camera position. See
+@ref Flat-multi-view "Flat shader documentation" for a complete example,
+which is the same for this shader:
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::MultiView};
+shader.setViewProjectionMatrices(camera.viewProjectionMatrices())
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.rotation());
+mesh.setInstanceCount(camera.viewCount())
+    .draw(shader);
+@endcode
+
+@anchor Phong-transformation-texture
+### Transformation texture
+
+With @ref Flag::TransformationTexture the per-instance transformations are not
+taken from a vertex attribute, but fetched from a palette of matrices in a
+@ref BufferTexture, which is not limited by attribute or uniform block sizes
+and can thus hold transformations of all drawables in the scene. The palette
+is usually filled from the camera once per frame using
+@ref SceneGraph::TransformationPalette and each draw then only sets an offset
+into it:
+
+@code
+SceneGraph::TransformationPalette3D palette;
+const UnsignedInt rocks = palette.add(camera, rockDrawables);
+const UnsignedInt trees = palette.add(camera, treeDrawables);
+palette.upload();
+
+Shaders::Phong shader{Shaders::Phong::Flag::TransformationTexture};
+shader.setTransformationTexture(palette.texture())
+    .setTransformationMatrix({})
+    .setNormalMatrix({})
+    .setProjectionMatrix(camera.projectionMatrix());
+
+shader.setTransformationTextureOffset(rocks);
+rockMesh.setInstanceCount(rockDrawables.size())
+    .draw(shader);
+shader.setTransformationTextureOffset(trees);
+treeMesh.setInstanceCount(treeDrawables.size())
+    .draw(shader);
+@endcode
+
+As with @ref Flag::InstancedTransformation, the matrices are expected to not
+contain non-uniform scaling. Combined with @ref Flag::MultiView, each instance
+is drawn into all views, so the instance count needs to be multiplied by
+@ref SceneGraph::Camera::viewCount().
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
@@ -171,15 +405,239 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Generic3D::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint IDs
+         *
+         * @ref Magnum::Vector4ui "Vector4ui", indices into the joint buffer
+         * bound with @ref bindJointBuffer(). Used only if
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Integer attributes are not available in OpenGL
+         *      ES 2.0.
+         * @requires_webgl20 Integer attributes are not available in WebGL
+         *      1.0.
+         */
+        typedef Attribute<8, Vector4ui> JointIds;
+
+        /**
+         * @brief Joint weights
+         *
+         * @ref Magnum::Vector4 "Vector4", weight of each joint from
+         * @ref JointIds. The weights are expected to sum up to `1.0f`,
+         * unused joints should have zero weight. Used only if
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Attribute<9, Vector4> Weights;
+
+        /**
+         * @brief Texture array layer
+         *
+         * @ref Magnum::Float "Float", layer of the texture arrays set via
+         * @ref setDiffuseTexture(Texture2DArray&) and others. Usually
+         * supplied per-instance. Used only if @ref Flag::TextureArrays is
+         * set.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        typedef Attribute<10, Float> TextureArrayLayer;
+
+        enum: UnsignedInt {
+            /**
+             * Max count of joints in the buffer bound with
+             * @ref bindJointBuffer()
+             */
+            MaxJointCount = 256
+        };
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        enum: UnsignedInt {
+            /**
+             * Max count of views set with @ref setViewProjectionMatrices()
+             */
+            MaxViewCount = 6
+        };
+        #endif
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always.
+             */
+            ColorOutput = Generic3D::ColorOutput,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Object ID shader output. @ref shaders-generic "Generic output",
+             * present only if @ref Flag::ObjectId is set.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Object ID output is not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Object ID output is not available in WebGL
+             *      1.0.
+             */
+            ObjectIdOutput = Generic3D::ObjectIdOutput
+            #endif
+        };
+
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix4. Used only
+         * if @ref Flag::InstancedTransformation is set.
+         */
+        typedef Generic3D::TransformationMatrix TransformationMatrix;
+
         /**
          * @brief Flag
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
+        enum class Flag: UnsignedShort {
             AmbientTexture = 1 << 0,    /**< The shader uses ambient texture instead of color */
             DiffuseTexture = 1 << 1,    /**< The shader uses diffuse texture instead of color */
-            SpecularTexture = 1 << 2    /**< The shader uses specular texture instead of color */
+            SpecularTexture = 1 << 2,   /**< The shader uses specular texture instead of color */
+
+            /**
+             * The shader multiplies the transformation matrix with
+             * per-instance @ref TransformationMatrix attribute and the
+             * normal matrix with its upper-left 3x3 part.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+             *      @es_extension{EXT,instanced_arrays} or
+             *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 3,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * The shader takes the uniforms from uniform buffers instead of
+             * individual uniforms. See @ref Phong-uniform-buffers for more
+             * information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            UniformBuffers = 1 << 4,
+
+            /**
+             * The shader writes object ID set via @ref setObjectId() to
+             * @ref ObjectIdOutput.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Object ID output is not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Object ID output is not available in WebGL
+             *      1.0.
+             */
+            ObjectId = 1 << 5,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * The textures are taken from bindless handles in
+             * @ref TextureUniform buffer instead of texture units. Implies
+             * @ref Flag::UniformBuffers. See @ref Phong-bindless-textures for
+             * more information.
+             * @requires_extension Extension @extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             */
+            BindlessTextures = 1 << 6,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * The shader iterates over lights binned into clusters by
+             * @ref LightClusters instead of using a single light. See
+             * @ref Phong-clustered-lights for more information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage is not available in OpenGL ES
+             *      3.0 and older. The implementation also needs to support
+             *      shader storage blocks in fragment shaders.
+             * @requires_gles Shader storage is not available in WebGL.
+             */
+            ClusteredLights = 1 << 7,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * The light is shadowed using cascaded shadow maps from
+             * @ref ShadowCascades. See @ref Phong-shadows for more
+             * information. Ignored if @ref Flag::ClusteredLights is set.
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Texture arrays and shadow samplers are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Texture arrays and shadow samplers are not
+             *      available in WebGL 1.0.
+             */
+            Shadows = 1 << 8,
+
+            /**
+             * The vertices are transformed by a blend of joint dual
+             * quaternions from a buffer bound with @ref bindJointBuffer().
+             * See @ref Phong-skinning for more information.
+             * @requires_gl31 Extensions @extension{EXT,gpu_shader4} and
+             *      @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Integer attributes and uniform buffers are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Integer attributes and uniform buffers are
+             *      not available in WebGL 1.0.
+             */
+            DualQuaternionSkinning = 1 << 9,
+
+            /**
+             * The textures are @ref Texture2DArray "Texture2DArray"s set via
+             * @ref setTextures(Texture2DArray*, Texture2DArray*, Texture2DArray*)
+             * and others, with layer taken from the @ref TextureArrayLayer
+             * attribute. @ref Flag::BindlessTextures is ignored if this flag
+             * is set. See @ref Phong-texture-arrays for more information.
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Texture arrays are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Texture arrays are not available in WebGL
+             *      1.0.
+             */
+            TextureArrays = 1 << 10,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * The mesh is drawn into all views set via
+             * @ref setViewProjectionMatrices() in a single instanced draw
+             * call, each view going to a different framebuffer layer.
+             * @ref Flag::ClusteredLights is ignored if this flag is set. See
+             * @ref Phong-multi-view for more information.
+             * @requires_gl32 Extension @extension{ARB,geometry_shader4} for
+             *      layered framebuffers
+             * @requires_extension Extension @extension{AMD,vertex_shader_layer}
+             * @requires_gl Layered rendering from the vertex shader is not
+             *      available in OpenGL ES or WebGL.
+             */
+            MultiView = 1 << 11,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Per-instance transformation is fetched from a palette in a
+             * buffer texture set via @ref setTransformationTexture() instead
+             * of the @ref TransformationMatrix attribute.
+             * @ref Flag::InstancedTransformation is ignored if this flag is
+             * set. See @ref Phong-transformation-texture for more
+             * information.
+             * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+             * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            TransformationTexture = 1 << 12
+            #endif
         };
 
         /**
@@ -189,12 +647,197 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Uniform buffer binding points
+         *
+         * Used if @ref Flag::UniformBuffers or
+         * @ref Flag::DualQuaternionSkinning is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         */
+        enum BufferBinding: UnsignedInt {
+            ProjectionBufferBinding = 0,     /**< @ref ProjectionUniform */
+            TransformationBufferBinding = 1, /**< @ref TransformationUniform */
+            LightBufferBinding = 2,          /**< @ref LightUniform */
+            MaterialBufferBinding = 3,       /**< @ref MaterialUniform */
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * @ref TextureUniform. Used only if @ref Flag::BindlessTextures
+             * is set.
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             */
+            TextureBufferBinding = 4,
+            #endif
+
+            /**
+             * Joint dual quaternions. Used only if
+             * @ref Flag::DualQuaternionSkinning is set.
+             */
+            JointBufferBinding = 5
+        };
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Shader storage buffer binding points
+         *
+         * Used if @ref Flag::ClusteredLights is set.
+         * @see @ref bindLightClusters()
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        enum StorageBufferBinding: UnsignedInt {
+            /** @ref LightClusters::lightBuffer() */
+            ClusterLightBufferBinding = 0,
+
+            /** @ref LightClusters::clusterBuffer() */
+            ClusterBufferBinding = 1,
+
+            /** @ref LightClusters::lightIndexBuffer() */
+            ClusterLightIndexBufferBinding = 2
+        };
+        #endif
+
+        /**
+         * @brief Per-frame projection uniform buffer data
+         *
+         * Has `std140` layout. Used if @ref Flag::UniformBuffers is set.
+         * @see @ref bindProjectionBuffer()
+         */
+        struct ProjectionUniform {
+            /** @brief Constructor */
+            /*implicit*/ ProjectionUniform(const Matrix4& projectionMatrix = {}): projectionMatrix{projectionMatrix} {}
+
+            Matrix4 projectionMatrix;   /**< @brief Projection matrix */
+        };
+
+        /**
+         * @brief Per-draw transformation uniform buffer data
+         *
+         * Has `std140` layout, the normal matrix columns are padded to four
+         * components. Used if @ref Flag::UniformBuffers is set.
+         * @see @ref bindTransformationBuffer()
+         */
+        struct TransformationUniform {
+            /** @brief Constructor */
+            /*implicit*/ TransformationUniform(const Matrix4& transformationMatrix = {}, const Matrix3x3& normalMatrix = {}): transformationMatrix{transformationMatrix}, normalMatrix{Vector4{normalMatrix[0], 0.0f}, Vector4{normalMatrix[1], 0.0f}, Vector4{normalMatrix[2], 0.0f}} {}
+
+            Matrix4 transformationMatrix;   /**< @brief Transformation matrix */
+            Matrix3x4 normalMatrix;         /**< @brief Normal matrix */
+        };
+
+        /**
+         * @brief Per-frame light uniform buffer data
+         *
+         * Has `std140` layout. Used if @ref Flag::UniformBuffers is set.
+         * @see @ref bindLightBuffer()
+         */
+        struct LightUniform {
+            /** @brief Constructor */
+            /*implicit*/ LightUniform(const Vector3& position = {}, const Color4& color = Color4{1.0f}): position{position}, _padding{}, color{color} {}
+
+            Vector3 position;   /**< @brief Light position */
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            Float _padding;
+            #endif
+            Color4 color;       /**< @brief Light color */
+        };
+
+        /**
+         * @brief Per-material uniform buffer data
+         *
+         * Has `std140` layout, padded to 64 bytes so it can be put into
+         * arrays. Used if @ref Flag::UniformBuffers is set. Unlike with the
+         * individual uniforms, the defaults don't depend on the texture
+         * flags.
+         * @see @ref bindMaterialBuffer()
+         */
+        struct MaterialUniform {
+            /** @brief Constructor */
+            /*implicit*/ MaterialUniform(const Color4& ambientColor = Color4{0.0f, 1.0f}, const Color4& diffuseColor = Color4{1.0f}, const Color4& specularColor = Color4{1.0f}, Float shininess = 80.0f): ambientColor{ambientColor}, diffuseColor{diffuseColor}, specularColor{specularColor}, shininess{shininess}, _padding{} {}
+
+            Color4 ambientColor;    /**< @brief Ambient color */
+            Color4 diffuseColor;    /**< @brief Diffuse color */
+            Color4 specularColor;   /**< @brief Specular color */
+            Float shininess;        /**< @brief Shininess */
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            Float _padding[3];
+            #endif
+        };
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Per-material bindless texture uniform buffer data
+         *
+         * Has `std140` layout, padded to 32 bytes. Contains handles returned
+         * by @ref AbstractTexture::handle(), the handles for textures that
+         * are not enabled in @ref Flags are ignored. Used if
+         * @ref Flag::BindlessTextures is set.
+         * @see @ref bindTextureBuffer()
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        struct TextureUniform {
+            /** @brief Constructor */
+            /*implicit*/ TextureUniform(UnsignedLong ambientTextureHandle = 0, UnsignedLong diffuseTextureHandle = 0, UnsignedLong specularTextureHandle = 0): ambientTextureHandle{ambientTextureHandle}, diffuseTextureHandle{diffuseTextureHandle}, specularTextureHandle{specularTextureHandle}, _padding{} {}
+
+            UnsignedLong ambientTextureHandle;  /**< @brief Ambient texture handle */
+            UnsignedLong diffuseTextureHandle;  /**< @brief Diffuse texture handle */
+            UnsignedLong specularTextureHandle; /**< @brief Specular texture handle */
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            UnsignedLong _padding;
+            #endif
+        };
+        #endif
+
+        class CompileState;
+
+        /**
+         * @brief Compile the shader asynchronously
+         * @param flags     Flags
+         *
+         * Submits compilation and linking of the shader without waiting
+         * for the result. Poll @ref CompileState::isLinkFinished() and pass
+         * the state to @ref Phong(CompileState&&) once it returns `true` to
+         * get a usable shader. This allows creating many shader variants
+         * without blocking, for example:
+         *
+         * @code
+         * std::vector<Shaders::Phong::CompileState> states;
+         * states.push_back(Shaders::Phong::compile({}));
+         * states.push_back(Shaders::Phong::compile(Shaders::Phong::Flag::DiffuseTexture));
+         *
+         * // each frame
+         * for(auto it = states.begin(); it != states.end(); ) {
+         *     if(!it->isLinkFinished()) { ++it; continue; }
+         *     shaders.emplace_back(std::move(*it));
+         *     it = states.erase(it);
+         * }
+         * @endcode
+         *
+         * See @ref AbstractShaderProgram-async for more information.
+         */
+        static CompileState compile(Flags flags = Flags());
+
         /**
          * @brief Constructor
          * @param flags     Flags
+         *
+         * Equivalent to calling @ref Phong(CompileState&&) on result of
+         * @ref compile().
          */
         explicit Phong(Flags flags = Flags());
 
+        /**
+         * @brief Finalize asynchronous compilation
+         *
+         * Checks compilation and link status and queries uniform locations.
+         * Blocks if the compilation isn't finished yet.
+         * @see @ref CompileState::isLinkFinished()
+         */
+        explicit Phong(CompileState&& state);
+
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
@@ -216,7 +859,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @brief Set ambient texture
          * @return Reference to self (for method chaining)
          *
-         * Has effect only if @ref Flag::AmbientTexture is set.
+         * Has effect only if @ref Flag::AmbientTexture is set and
+         * @ref Flag::BindlessTextures is not set.
          * @see @ref setTextures(), @ref setAmbientColor()
          */
         Phong& setAmbientTexture(Texture2D& texture);
@@ -239,7 +883,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @brief Set diffuse texture
          * @return Reference to self (for method chaining)
          *
-         * Has effect only if @ref Flag::DiffuseTexture is set.
+         * Has effect only if @ref Flag::DiffuseTexture is set and
+         * @ref Flag::BindlessTextures is not set.
          * @see @ref setTextures(), @ref setDiffuseColor()
          */
         Phong& setDiffuseTexture(Texture2D& texture);
@@ -262,7 +907,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @brief Set specular texture
          * @return Reference to self (for method chaining)
          *
-         * Has effect only if @ref Flag::SpecularTexture is set.
+         * Has effect only if @ref Flag::SpecularTexture is set and
+         * @ref Flag::BindlessTextures is not set.
          * @see @ref setTextures(), @ref setSpecularColor()
          */
         Phong& setSpecularTexture(Texture2D& texture);
@@ -273,12 +919,72 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          *
          * A particular texture has effect only if particular texture flag from
          * @ref Phong::Flag "Flag" is set, you can use `nullptr` for the rest.
-         * More efficient than setting each texture separately.
+         * More efficient than setting each texture separately. Does nothing
+         * if @ref Flag::BindlessTextures is set.
          * @see @ref setAmbientTexture(), @ref setDiffuseTexture(),
          *      @ref setSpecularTexture()
          */
         Phong& setTextures(Texture2D* ambient, Texture2D* diffuse, Texture2D* specular);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set ambient texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureArrays is set, has effect only if
+         * @ref Flag::AmbientTexture is set as well.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL
+         *      1.0.
+         */
+        Phong& setAmbientTexture(Texture2DArray& texture);
+
+        /**
+         * @brief Set diffuse texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureArrays is set, has effect only if
+         * @ref Flag::DiffuseTexture is set as well.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL
+         *      1.0.
+         */
+        Phong& setDiffuseTexture(Texture2DArray& texture);
+
+        /**
+         * @brief Set specular texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureArrays is set, has effect only if
+         * @ref Flag::SpecularTexture is set as well.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL
+         *      1.0.
+         */
+        Phong& setSpecularTexture(Texture2DArray& texture);
+
+        /**
+         * @brief Set texture arrays
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureArrays is set. Similarly to
+         * @ref setTextures(Texture2D*, Texture2D*, Texture2D*) you can use
+         * `nullptr` for textures that are not used.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL
+         *      1.0.
+         */
+        Phong& setTextures(Texture2DArray* ambient, Texture2DArray* diffuse, Texture2DArray* specular);
+        #endif
+
         /**
          * @brief Set shininess
          * @return Reference to self (for method chaining)
@@ -291,6 +997,25 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set object ID
+         * @return Reference to self (for method chaining)
+         *
+         * Has effect only if @ref Flag::ObjectId is set, the value is written
+         * to @ref ObjectIdOutput. If not set, default value is `0`.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Object ID output is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Object ID output is not available in WebGL
+         *      1.0.
+         */
+        Phong& setObjectId(UnsignedInt id) {
+            setUniform(objectIdUniform, id);
+            return *this;
+        }
+        #endif
+
         /**
          * @brief Set transformation matrix
          * @return Reference to self (for method chaining)
@@ -324,6 +1049,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
         /**
          * @brief Set light position
          * @return Reference to self (for method chaining)
+         *
+         * Has no effect if @ref Flag::ClusteredLights is set.
          */
         Phong& setLightPosition(const Vector3& light) {
             setUniform(lightUniform, light);
@@ -334,14 +1061,277 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @brief Set light color
          * @return Reference to self (for method chaining)
          *
-         * If not set, default value is `{1.0f, 1.0f, 1.0f, 1.0f}`.
+         * If not set, default value is `{1.0f, 1.0f, 1.0f, 1.0f}`. Has no
+         * effect if @ref Flag::ClusteredLights is set.
          */
         Phong& setLightColor(const Color4& color) {
             setUniform(lightColorUniform, color);
             return *this;
         }
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Use light clusters
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::ClusteredLights is set. Sets cluster
+         * parameters and binds buffers of given clusters to binding points
+         * listed in @ref StorageBufferBinding. Needs to be called again
+         * after @ref LightClusters::setProjection().
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        Phong& bindLightClusters(LightClusters& clusters);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Use shadow cascades
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Shadows is set. Sets the shadow matrices
+         * and split distances of given cascades and binds their depth
+         * texture. Needs to be called again after each
+         * @ref ShadowCascades::update().
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays and shadow samplers are not
+         *      available in OpenGL ES 2.0.
+         * @requires_webgl20 Texture arrays and shadow samplers are not
+         *      available in WebGL 1.0.
+         */
+        Phong& setShadowCascades(ShadowCascades& cascades);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set view projection matrices
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::MultiView is set and that there's at most
+         * @ref MaxViewCount matrices. Instance @f$ i @f$ of the draw goes
+         * through matrix @f$ i \bmod n @f$, where @f$ n @f$ is the matrix
+         * count, and is rendered into framebuffer layer of the same index.
+         * The matrix set via @ref setProjectionMatrix() is not used. See
+         * @ref Phong-multi-view for more information.
+         * @requires_extension Extension @extension{AMD,vertex_shader_layer}
+         * @requires_gl Layered rendering from the vertex shader is not
+         *      available in OpenGL ES or WebGL.
+         */
+        Phong& setViewProjectionMatrices(Containers::ArrayView<const Matrix4> matrices);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set transformation texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TransformationTexture is set. The texture
+         * is expected to have @ref BufferTextureFormat::RGBA32F format with
+         * four texels for each @ref Matrix4. See
+         * @ref Phong-transformation-texture for more information.
+         * @see @ref SceneGraph::TransformationPalette
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        Phong& setTransformationTexture(BufferTexture& texture);
+
+        /**
+         * @brief Set transformation texture offset
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TransformationTexture is set. Instance
+         * @f$ i @f$ of the draw uses matrix at index @f$ o + i @f$ of the
+         * palette, where @f$ o @f$ is the offset. Initial value is `0`.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        Phong& setTransformationTextureOffset(UnsignedInt offset);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind projection uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a @ref ProjectionUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindProjectionBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind projection uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindProjectionBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a @ref TransformationUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTransformationBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind transformation uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. Usually called
+         * before each draw with a different offset into a buffer containing
+         * data for all draws.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTransformationBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind light uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a @ref LightUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindLightBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind light uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindLightBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind material uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a @ref MaterialUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindMaterialBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind material uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is set. Can be used to
+         * switch between materials stored in a single buffer.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindMaterialBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bind bindless texture uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::BindlessTextures is set. The buffer is
+         * expected to contain a @ref TextureUniform.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Phong& bindTextureBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind bindless texture uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::BindlessTextures is set. Can be used to
+         * switch between texture sets stored in a single buffer.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Phong& bindTextureBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind joint uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::DualQuaternionSkinning is set. The buffer
+         * is expected to contain at most @ref MaxJointCount
+         * @ref DualQuaternion "DualQuaternion"s. See @ref Phong-skinning for
+         * more information.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind joint uniform buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::DualQuaternionSkinning is set. Can be used
+         * to switch between joints of different characters stored in a
+         * single buffer.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
     private:
+        /* Creates the program object without compiling anything */
+        struct SubmitTag {};
+        explicit Phong(SubmitTag, Flags flags);
+
         Int transformationMatrixUniform,
             projectionMatrixUniform,
             normalMatrixUniform,
@@ -351,10 +1341,46 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
             specularColorUniform,
             lightColorUniform,
             shininessUniform;
+        #ifndef MAGNUM_TARGET_GLES2
+        Int objectIdUniform;
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int clusterCountUniform,
+            clusterParametersUniform;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        Int shadowMatricesUniform,
+            shadowSplitsUniform,
+            shadowCascadeCountUniform;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Int viewProjectionMatricesUniform,
+            viewCountUniform;
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int transformationTextureOffsetUniform;
+        #endif
 
         Flags _flags;
 };
 
+/**
+@brief Asynchronous compilation state of @ref Phong
+
+Returned by @ref Phong::compile(). Shouldn't be used for anything else than
+checking @ref isLinkFinished() and passing to @ref Phong::Phong(CompileState&&).
+*/
+class Phong::CompileState: public Phong {
+    friend Phong;
+
+    private:
+        explicit CompileState(Phong&& shader, Shader&& vert, Shader&& frag, Version version, bool cached): Phong{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+        Shader _vert, _frag;
+        Version _version;
+        bool _cached;
+};
+
 CORRADE_ENUMSET_OPERATORS(Phong::Flags)
 
 }}
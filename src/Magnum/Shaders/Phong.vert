@@ -28,6 +28,23 @@
 #define out varying
 #endif
 
+#ifdef UNIFORM_BUFFERS
+layout(std140) uniform Projection {
+    highp mat4 projectionMatrix;
+};
+
+layout(std140) uniform Transformation {
+    highp mat4 transformationMatrix;
+    mediump mat3 normalMatrix;
+};
+
+#ifndef CLUSTERED_LIGHTS
+layout(std140) uniform Light {
+    highp vec3 light;
+    lowp vec4 lightColor;
+};
+#endif
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -43,10 +60,37 @@ layout(location = 2)
 #endif
 uniform mediump mat3 normalMatrix;
 
+#ifndef CLUSTERED_LIGHTS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 3)
 #endif
 uniform highp vec3 light;
+#endif
+#endif
+
+#ifdef MULTI_VIEW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 18)
+#endif
+uniform highp mat4 viewProjectionMatrices[MAX_VIEW_COUNT];
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 24)
+#endif
+uniform highp int viewCount = 1;
+#endif
+
+#ifdef TRANSFORMATION_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 4)
+#endif
+uniform highp samplerBuffer transformationTexture;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 25)
+#endif
+uniform highp int transformationTextureOffset; /* defaults to zero */
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
@@ -58,6 +102,13 @@ layout(location = NORMAL_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec3 normal;
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
 #ifdef TEXTURED
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
@@ -67,29 +118,99 @@ in mediump vec2 textureCoords;
 out mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifdef TEXTURE_ARRAYS
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURE_ARRAY_LAYER_ATTRIBUTE_LOCATION)
+#endif
+in highp float textureArrayLayer;
+
+flat out highp float interpolatedTextureArrayLayer;
+#endif
+
 out mediump vec3 transformedNormal;
+#ifdef CLUSTERED_LIGHTS
+out highp vec3 viewPosition;
+#else
 out highp vec3 lightDirection;
+#endif
 out highp vec3 cameraDirection;
 
 void main() {
+    #ifdef DUAL_QUATERNION_SKINNING
+    /* Skinned position and normal in model space */
+    highp vec4 jointReal, jointDual;
+    blendJoints(jointReal, jointDual);
+    highp vec4 vertexPosition = transformPoint(jointReal, jointDual, position);
+    mediump vec3 vertexNormal = rotateVector(jointReal, normal);
+    #else
+    highp vec4 vertexPosition = position;
+    mediump vec3 vertexNormal = normal;
+    #endif
+
+    #ifdef TRANSFORMATION_TEXTURE
+    /* Per-instance transformation fetched from the palette, four texels per
+       matrix. With multiple views each instance is drawn into all of
+       them. */
+    #ifdef MULTI_VIEW
+    highp int transformationTexel = (transformationTextureOffset + gl_InstanceID/viewCount)*4;
+    #else
+    highp int transformationTexel = (transformationTextureOffset + gl_InstanceID)*4;
+    #endif
+    highp mat4 instancedTransformationMatrix = mat4(
+        texelFetch(transformationTexture, transformationTexel),
+        texelFetch(transformationTexture, transformationTexel + 1),
+        texelFetch(transformationTexture, transformationTexel + 2),
+        texelFetch(transformationTexture, transformationTexel + 3));
+    #endif
+
+    #if defined(INSTANCED_TRANSFORMATION) || defined(TRANSFORMATION_TEXTURE)
+    /* Transformed vertex position. Matrix-from-matrix constructors aren't
+       available in GLSL ES 1.00, so the rotation part is extracted by
+       hand. */
+    highp vec4 transformedPosition4 = transformationMatrix*instancedTransformationMatrix*vertexPosition;
+    mediump mat3 instancedNormalMatrix = mat3(instancedTransformationMatrix[0].xyz,
+                                              instancedTransformationMatrix[1].xyz,
+                                              instancedTransformationMatrix[2].xyz);
+
+    /* Transformed normal vector */
+    transformedNormal = normalMatrix*instancedNormalMatrix*vertexNormal;
+    #else
     /* Transformed vertex position */
-    highp vec4 transformedPosition4 = transformationMatrix*position;
-    highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
+    highp vec4 transformedPosition4 = transformationMatrix*vertexPosition;
 
     /* Transformed normal vector */
-    transformedNormal = normalMatrix*normal;
+    transformedNormal = normalMatrix*vertexNormal;
+    #endif
+
+    highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
+    #ifdef CLUSTERED_LIGHTS
+    /* Position for finding the cluster and directions to the lights */
+    viewPosition = transformedPosition;
+    #else
     /* Direction to the light */
     lightDirection = normalize(light - transformedPosition);
+    #endif
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
 
     /* Transform the position */
+    #ifdef MULTI_VIEW
+    /* Each instance goes into a different view and layer */
+    int view = gl_InstanceID % viewCount;
+    gl_Position = viewProjectionMatrices[view]*transformedPosition4;
+    gl_Layer = view;
+    #else
     gl_Position = projectionMatrix*transformedPosition4;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
     interpolatedTextureCoords = textureCoords;
     #endif
+
+    #ifdef TEXTURE_ARRAYS
+    interpolatedTextureArrayLayer = textureArrayLayer;
+    #endif
 }
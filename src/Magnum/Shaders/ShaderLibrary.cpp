@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderLibrary.h"
+
+#include <sstream>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/MeshVisualizer.h"
+#include "Magnum/Shaders/Phong.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/DeferredGeometry.h"
+#endif
+
+namespace Magnum { namespace Shaders {
+
+ShaderLibrary::ShaderLibrary() {
+    registerShader<DistanceFieldVector2D>()
+        .registerShader<DistanceFieldVector3D>()
+        .registerShader<Flat2D>()
+        .registerShader<Flat3D>()
+        .registerShader<MeshVisualizer>()
+        .registerShader<Phong>();
+    #ifndef MAGNUM_TARGET_GLES2
+    registerShader<DeferredGeometry>();
+    #endif
+}
+
+ShaderLibrary::ShaderLibrary(ShaderLibrary&&) noexcept = default;
+
+ShaderLibrary::~ShaderLibrary() = default;
+
+ShaderLibrary& ShaderLibrary::operator=(ShaderLibrary&&) noexcept = default;
+
+void ShaderLibrary::registerInternal(const char* const name, const Creator creator) {
+    _creators.emplace(name, creator);
+}
+
+AbstractShaderProgram& ShaderLibrary::getInternal(const char* const name, const UnsignedLong flags) {
+    std::unique_ptr<AbstractShaderProgram>& variant = _variants[{name, flags}];
+    if(!variant) variant.reset(_creators.at(name)(flags));
+    return *variant;
+}
+
+std::vector<std::pair<std::string, UnsignedLong>> ShaderLibrary::variants() const {
+    std::vector<std::pair<std::string, UnsignedLong>> out;
+    out.reserve(_variants.size());
+    for(const auto& variant: _variants) out.push_back(variant.first);
+    return out;
+}
+
+std::string ShaderLibrary::variantList() const {
+    std::ostringstream out;
+    for(const auto& variant: _variants)
+        out << variant.first.first << ' ' << variant.first.second << '\n';
+    return out.str();
+}
+
+std::size_t ShaderLibrary::preload(const std::string& list) {
+    std::istringstream in{list};
+    std::string line;
+    std::size_t count = 0;
+    while(std::getline(in, line)) {
+        std::istringstream lineIn{line};
+        std::string name;
+        UnsignedLong flags;
+        if(!(lineIn >> name)) continue;
+        if(!(lineIn >> flags)) {
+            Warning() << "Shaders::ShaderLibrary::preload(): can't parse line" << line;
+            continue;
+        }
+
+        const auto creator = _creators.find(name);
+        if(creator == _creators.end()) {
+            Warning() << "Shaders::ShaderLibrary::preload(): unknown shader" << name;
+            continue;
+        }
+
+        std::unique_ptr<AbstractShaderProgram>& variant = _variants[{name, flags}];
+        if(variant) continue;
+        variant.reset(creator->second(flags));
+        ++count;
+    }
+
+    return count;
+}
+
+void ShaderLibrary::clear() { _variants.clear(); }
+
+}}
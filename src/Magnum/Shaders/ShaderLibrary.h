@@ -0,0 +1,228 @@
+#ifndef Magnum_Shaders_ShaderLibrary_h
+#define Magnum_Shaders_ShaderLibrary_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ShaderLibrary, struct @ref Magnum::Shaders::ShaderLibraryTraits
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Shader library traits
+
+Provides a unique name for a shader type used by @ref ShaderLibrary in the
+variant list. Specialized for all builtin shaders that take flags in the
+constructor, for custom shaders provide a specialization with a
+`static const char* name()` function. The shader type is expected to have
+nested `Flag` and `Flags` types and a constructor taking `Flags`.
+*/
+template<class T> struct ShaderLibraryTraits;
+
+/**
+@brief Shader variant library
+
+Owns instances of shader variants keyed by shader type and flags. Each
+variant is compiled on first use in @ref get() and then reused, so there's
+never more than one program for the same variant and users don't need to
+keep track of the instances themselves:
+
+@code
+Shaders::ShaderLibrary library;
+
+Shaders::Phong& shader = library.get<Shaders::Phong>(Shaders::Phong::Flag::DiffuseTexture);
+@endcode
+
+Compiling shaders on first use causes stalls in the middle of rendering. To
+make the startup cost deterministic instead, the list of variants used in
+one run can be recorded with @ref variantList() and all of them compiled
+upfront in the next run with @ref preload():
+
+@code
+// at startup
+if(Utility::Directory::fileExists("shaders.txt"))
+    library.preload(Utility::Directory::readString("shaders.txt"));
+
+// at exit
+Utility::Directory::writeString("shaders.txt", library.variantList());
+@endcode
+
+The variants are created through their regular constructors, so if a
+@ref ProgramBinaryCache is current, the preloaded variants are loaded from
+binaries saved in previous runs instead of being compiled. Custom shaders
+can be used in the library after specializing @ref ShaderLibraryTraits for
+them, they need to be registered using @ref registerShader() before
+@ref preload() so the library knows how to create them.
+*/
+class MAGNUM_SHADERS_EXPORT ShaderLibrary {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Registers all builtin shaders that have a
+         * @ref ShaderLibraryTraits specialization. Doesn't compile anything.
+         */
+        explicit ShaderLibrary();
+
+        /** @brief Copying is not allowed */
+        ShaderLibrary(const ShaderLibrary&) = delete;
+
+        /** @brief Move constructor */
+        ShaderLibrary(ShaderLibrary&&) noexcept;
+
+        ~ShaderLibrary();
+
+        /** @brief Copying is not allowed */
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+        /** @brief Move assignment */
+        ShaderLibrary& operator=(ShaderLibrary&&) noexcept;
+
+        /**
+         * @brief Register a shader type
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the shader type known to @ref preload(). Done implicitly
+         * by @ref get(), registering the same type more than once does
+         * nothing.
+         */
+        template<class T> ShaderLibrary& registerShader();
+
+        /**
+         * @brief Shader variant
+         *
+         * Creates the variant if it doesn't exist yet.
+         * @see @ref contains()
+         */
+        template<class T> T& get(typename T::Flags flags = {});
+
+        /** @brief Whether given shader variant is already created */
+        template<class T> bool contains(typename T::Flags flags = {}) const {
+            return _variants.find({ShaderLibraryTraits<T>::name(), flagsValue<T>(flags)}) != _variants.end();
+        }
+
+        /** @brief Count of created variants */
+        std::size_t variantCount() const { return _variants.size(); }
+
+        /**
+         * @brief Variants created so far
+         *
+         * Pairs of shader name and raw flag value, sorted.
+         */
+        std::vector<std::pair<std::string, UnsignedLong>> variants() const;
+
+        /**
+         * @brief List of created variants
+         *
+         * One variant per line, consisting of shader name and raw flag value
+         * separated by space. Meant to be passed to @ref preload() in the
+         * next run.
+         */
+        std::string variantList() const;
+
+        /**
+         * @brief Create variants from a list
+         * @return Count of newly created variants
+         *
+         * Creates all variants from a list produced by @ref variantList()
+         * that don't exist yet. Lines with unknown shader names or that can't
+         * be parsed are skipped with a warning.
+         */
+        std::size_t preload(const std::string& list);
+
+        /**
+         * @brief Remove all variants
+         *
+         * The registered shader types are kept.
+         */
+        void clear();
+
+    private:
+        typedef AbstractShaderProgram*(*Creator)(UnsignedLong);
+
+        template<class T> static UnsignedLong flagsValue(typename T::Flags flags) {
+            return UnsignedLong(typename T::Flags::UnderlyingType(flags));
+        }
+
+        void registerInternal(const char* name, Creator creator);
+        AbstractShaderProgram& getInternal(const char* name, UnsignedLong flags);
+
+        std::unordered_map<std::string, Creator> _creators;
+        std::map<std::pair<std::string, UnsignedLong>, std::unique_ptr<AbstractShaderProgram>> _variants;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> struct ShaderLibraryTraits<DistanceFieldVector2D> {
+    static const char* name() { return "DistanceFieldVector2D"; }
+};
+template<> struct ShaderLibraryTraits<DistanceFieldVector3D> {
+    static const char* name() { return "DistanceFieldVector3D"; }
+};
+template<> struct ShaderLibraryTraits<Flat2D> {
+    static const char* name() { return "Flat2D"; }
+};
+template<> struct ShaderLibraryTraits<Flat3D> {
+    static const char* name() { return "Flat3D"; }
+};
+template<> struct ShaderLibraryTraits<MeshVisualizer> {
+    static const char* name() { return "MeshVisualizer"; }
+};
+template<> struct ShaderLibraryTraits<Phong> {
+    static const char* name() { return "Phong"; }
+};
+#ifndef MAGNUM_TARGET_GLES2
+template<> struct ShaderLibraryTraits<DeferredGeometry> {
+    static const char* name() { return "DeferredGeometry"; }
+};
+#endif
+#endif
+
+template<class T> ShaderLibrary& ShaderLibrary::registerShader() {
+    registerInternal(ShaderLibraryTraits<T>::name(), [](UnsignedLong flags) -> AbstractShaderProgram* {
+        return new T{typename T::Flags{static_cast<typename T::Flag>(flags)}};
+    });
+    return *this;
+}
+
+template<class T> T& ShaderLibrary::get(const typename T::Flags flags) {
+    registerShader<T>();
+    return static_cast<T&>(getInternal(ShaderLibraryTraits<T>::name(), flagsValue<T>(flags)));
+}
+
+}}
+
+#endif
@@ -34,6 +34,12 @@
 namespace Magnum { namespace Shaders {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_TARGET_GLES2
+class DeferredGeometry;
+class DeferredLight;
+class DeferredResolve;
+#endif
+
 template<UnsignedInt> class DistanceFieldVector;
 typedef DistanceFieldVector<2> DistanceFieldVector2D;
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
@@ -46,10 +52,30 @@ template<UnsignedInt> class Flat;
 typedef Flat<2> Flat2D;
 typedef Flat<3> Flat3D;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class FrustumCulling;
+#endif
+
 /* Generic is used only statically */
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class LightClusters;
+#endif
 class MeshVisualizer;
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class ParticleSimulation;
+#endif
 class Phong;
+class ShaderLibrary;
+template<class> struct ShaderLibraryTraits;
+#ifndef MAGNUM_TARGET_GLES2
+class ShadowCascades;
+#endif
+class ShadowDepth;
+#ifndef MAGNUM_TARGET_GLES2
+class SharpenUpscale;
+class Skinning;
+#endif
 
 template<UnsignedInt> class Vector;
 typedef Vector<2> Vector2D;
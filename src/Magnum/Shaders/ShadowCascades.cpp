@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShadowCascades.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Shaders {
+
+ShadowCascades::ShadowCascades(const Int cascadeCount, const Int size): _size{size} {
+    CORRADE_ASSERT(cascadeCount > 0 && cascadeCount <= MaxCascadeCount,
+        "Shaders::ShadowCascades: expected 1 to" << Int(MaxCascadeCount) << "cascades but got" << cascadeCount, );
+
+    _depthTexture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setCompareMode(Sampler::CompareMode::CompareRefToTexture)
+        .setCompareFunction(Sampler::CompareFunction::LessOrEqual)
+        .setStorage(1, TextureFormat::DepthComponent24, {size, size, cascadeCount});
+
+    _cascades.reserve(cascadeCount);
+    for(Int i = 0; i != cascadeCount; ++i) {
+        Framebuffer framebuffer{{{}, Vector2i{size}}};
+        framebuffer.attachTextureLayer(Framebuffer::BufferAttachment::Depth, _depthTexture, 0, i)
+            .mapForDraw(Framebuffer::DrawAttachment::None);
+        _cascades.emplace_back(std::move(framebuffer));
+    }
+}
+
+ShadowCascades& ShadowCascades::setLightDirection(const Vector3& direction) {
+    _lightDirection = direction;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::setSplitLambda(const Float lambda) {
+    _splitLambda = lambda;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::setCasterDistance(const Float distance) {
+    _casterDistance = distance;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::setCachedCascadeStart(const Int start) {
+    _cachedCascadeStart = start;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::setCacheMargin(const Float margin) {
+    _cacheMargin = margin;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::invalidate(const Range3D& bounds) {
+    for(Cascade& cascade: _cascades) {
+        if(cascade.invalidated) continue;
+
+        /* The projection is orthographic, so the bounding box of the
+           projected corners is exact */
+        Vector3 min{Constants::inf()}, max{-Constants::inf()};
+        for(Int i = 0; i != 8; ++i) {
+            const Vector3 corner = cascade.projectionMatrix.transformPoint({
+                (i & 1 ? bounds.max() : bounds.min()).x(),
+                (i & 2 ? bounds.max() : bounds.min()).y(),
+                (i & 4 ? bounds.max() : bounds.min()).z()});
+            min = Math::min(min, corner);
+            max = Math::max(max, corner);
+        }
+
+        if((min <= Vector3{1.0f}).all() && (max >= Vector3{-1.0f}).all())
+            cascade.invalidated = true;
+    }
+
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::invalidateAll() {
+    for(Cascade& cascade: _cascades) cascade.invalidated = true;
+    return *this;
+}
+
+ShadowCascades& ShadowCascades::update(const Matrix4& cameraMatrix, const Rad fov, const Float aspectRatio, const Float near, const Float far) {
+    CORRADE_ASSERT(near > 0.0f && far > near,
+        "Shaders::ShadowCascades::update(): expected 0 < near < far but got" << near << "and" << far, *this);
+
+    const Matrix4 cameraInverse = cameraMatrix.invertedRigid();
+
+    /* Light looks in the direction of its -Z axis, pick an up vector that
+       isn't parallel to it */
+    const Vector3 z = -_lightDirection.normalized();
+    const Vector3 x = Math::cross(std::abs(z.y()) > 0.99f ? Vector3::zAxis() : Vector3::yAxis(), z).normalized();
+    const Vector3 y = Math::cross(z, x);
+    const Matrix4 lightMatrix = Matrix4::from(Matrix3x3{x, y, z}.transposed(), {});
+
+    /* Maps clip coordinates to texture coordinates and depth */
+    const Matrix4 bias = Matrix4::translation(Vector3{0.5f})*Matrix4::scaling(Vector3{0.5f});
+
+    /* Squared distance of the frustum corner from the axis, divided by
+       squared distance from the camera */
+    const Float tanHalfFov = Math::tan(fov*0.5f);
+    const Float cornerFactor = tanHalfFov*tanHalfFov*(1.0f + 1.0f/(aspectRatio*aspectRatio));
+
+    const Int count = _cascades.size();
+    Float splitNear = near;
+    for(Int i = 0; i != count; ++i) {
+        Cascade& cascade = _cascades[i];
+
+        /* Blend between uniform and logarithmic split distribution */
+        const Float t = Float(i + 1)/count;
+        const Float splitFar = Math::lerp(near + (far - near)*t, near*std::pow(far/near, t), _splitLambda);
+
+        /* Bounding sphere of the frustum slice. Its size doesn't depend on
+           camera orientation, so the cascade doesn't change size when the
+           camera rotates. */
+        const Vector3 center = cameraInverse.transformPoint({0.0f, 0.0f, -(splitNear + splitFar)*0.5f});
+        Float radius = std::sqrt(cornerFactor*splitFar*splitFar + (splitFar - splitNear)*(splitFar - splitNear)*0.25f);
+
+        /* Snap the cascade to a grid in light space, aligned to texel size
+           to avoid shimmering. Cached cascades are enlarged by a margin and
+           snapped to a grid of the margin size, so they still contain the
+           whole slice and don't change until the camera moves by the
+           margin. */
+        const bool cached = i >= _cachedCascadeStart;
+        const Float margin = cached ? _cacheMargin*radius : 0.0f;
+        radius += margin;
+        const Float texelSize = 2.0f*radius/_size;
+        const Float step = Math::max(std::floor(margin/texelSize), 1.0f)*texelSize;
+        const Vector3 lightCenter = Math::round(lightMatrix.transformPoint(center)/step)*step;
+
+        const Matrix4 projectionMatrix =
+            Matrix4::orthographicProjection(Vector2{2.0f*radius}, 0.0f, 2.0f*radius + _casterDistance)*
+            Matrix4::translation(-lightCenter - Vector3::zAxis(radius + _casterDistance))*
+            lightMatrix;
+
+        cascade.dirty = cascade.invalidated || !cached || projectionMatrix != cascade.projectionMatrix;
+        cascade.invalidated = false;
+        cascade.projectionMatrix = projectionMatrix;
+        cascade.shadowMatrix = bias*projectionMatrix*cameraInverse;
+        cascade.splitDistance = splitFar;
+
+        splitNear = splitFar;
+    }
+
+    return *this;
+}
+
+bool ShadowCascades::isDirty(const Int cascade) const {
+    CORRADE_ASSERT(std::size_t(cascade) < _cascades.size(),
+        "Shaders::ShadowCascades::isDirty(): index" << cascade << "out of range for" << _cascades.size() << "cascades", {});
+    return _cascades[cascade].dirty;
+}
+
+Matrix4 ShadowCascades::projectionMatrix(const Int cascade) const {
+    CORRADE_ASSERT(std::size_t(cascade) < _cascades.size(),
+        "Shaders::ShadowCascades::projectionMatrix(): index" << cascade << "out of range for" << _cascades.size() << "cascades", {});
+    return _cascades[cascade].projectionMatrix;
+}
+
+Matrix4 ShadowCascades::shadowMatrix(const Int cascade) const {
+    CORRADE_ASSERT(std::size_t(cascade) < _cascades.size(),
+        "Shaders::ShadowCascades::shadowMatrix(): index" << cascade << "out of range for" << _cascades.size() << "cascades", {});
+    return _cascades[cascade].shadowMatrix;
+}
+
+Float ShadowCascades::splitDistance(const Int cascade) const {
+    CORRADE_ASSERT(std::size_t(cascade) < _cascades.size(),
+        "Shaders::ShadowCascades::splitDistance(): index" << cascade << "out of range for" << _cascades.size() << "cascades", {});
+    return _cascades[cascade].splitDistance;
+}
+
+Framebuffer& ShadowCascades::framebuffer(const Int cascade) {
+    CORRADE_ASSERT(std::size_t(cascade) < _cascades.size(),
+        "Shaders::ShadowCascades::framebuffer(): index" << cascade << "out of range for" << _cascades.size() << "cascades", _cascades.front().framebuffer);
+    return _cascades[cascade].framebuffer;
+}
+
+}}
@@ -0,0 +1,307 @@
+#ifndef Magnum_Shaders_ShadowCascades_h
+#define Magnum_Shaders_ShadowCascades_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::ShadowCascades
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Cascaded shadow maps
+
+Manages shadow maps of a directional light for @ref Phong with
+@ref Phong::Flag::Shadows. The view frustum is split along the depth into
+@ref cascadeCount() slices and each slice gets its own orthographic shadow
+map, stored in one layer of a @ref Texture2DArray depth texture. Near
+cascades thus get much higher shadow resolution than far ones.
+
+Each cascade covers the bounding sphere of its frustum slice, so its size
+doesn't change when the camera rotates, and its position is snapped to a
+grid in light space, so the shadow edges don't shimmer when the camera
+moves.
+
+@anchor ShadowCascades-cached-cascades
+## Cached cascades
+
+Cascades starting from @ref cachedCascadeStart() are cached --- they cover
+the frustum slice with an additional margin and are snapped to a grid
+coarse enough that their projection stays the same until the camera moves
+by a sizeable distance. Such cascades need to be rendered again only if
+their projection changes or if a shadow caster inside them moves, which is
+reported with @ref invalidate(). For mostly static scenes the far cascades,
+which contain most of the geometry, are then rendered only occasionally.
+Cascades before @ref cachedCascadeStart() are rendered every frame.
+
+## Example usage
+
+Rendering the shadow maps with @ref ShadowDepth, enabling polygon offset to
+avoid self-shadowing artifacts:
+@code
+Shaders::ShadowCascades cascades{4, 2048};
+cascades.setLightDirection({-1.0f, -2.0f, -1.0f});
+Shaders::ShadowDepth depthShader;
+
+// each frame, for each shadow caster that moved
+cascades.invalidate(oldBounds)
+    .invalidate(newBounds);
+
+cascades.update(camera.cameraMatrix(), Deg(35.0f), aspectRatio, 0.1f, 100.0f);
+
+Renderer::enable(Renderer::Feature::PolygonOffsetFill);
+Renderer::setPolygonOffset(2.0f, 1.0f);
+for(Int i = 0; i != cascades.cascadeCount(); ++i) {
+    if(!cascades.isDirty(i)) continue;
+
+    cascades.framebuffer(i).clear(FramebufferClear::Depth)
+        .bind();
+    for(Caster& caster: casters) {
+        depthShader.setTransformationProjectionMatrix(cascades.projectionMatrix(i)*caster.transformation);
+        caster.mesh.draw(depthShader);
+    }
+}
+Renderer::disable(Renderer::Feature::PolygonOffsetFill);
+@endcode
+
+Using the shadow maps in the main pass:
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::Shadows};
+
+defaultFramebuffer.bind();
+shader.setShadowCascades(cascades)
+    .setLightPosition(camera.cameraMatrix().transformVector(-cascades.lightDirection())*1000.0f)
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.rotation())
+    .setProjectionMatrix(camera.projectionMatrix());
+mesh.draw(shader);
+@endcode
+
+@requires_gl30 Extension @extension{EXT,texture_array}
+@requires_gles30 Texture arrays and shadow samplers are not available in
+    OpenGL ES 2.0.
+@requires_webgl20 Texture arrays and shadow samplers are not available in
+    WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT ShadowCascades {
+    public:
+        enum: Int {
+            MaxCascadeCount = 4 /**< Max cascade count */
+        };
+
+        /**
+         * @brief Constructor
+         * @param cascadeCount  Cascade count, at most
+         *      @ref MaxCascadeCount
+         * @param size          Shadow map size
+         *
+         * Creates a @ref TextureFormat::DepthComponent24 texture array with
+         * one layer per cascade, set up for depth comparison and linear
+         * filtering, and a framebuffer for each layer.
+         */
+        explicit ShadowCascades(Int cascadeCount, Int size);
+
+        /** @brief Cascade count */
+        Int cascadeCount() const { return _cascades.size(); }
+
+        /** @brief Shadow map size */
+        Int size() const { return _size; }
+
+        /** @brief Light direction */
+        Vector3 lightDirection() const { return _lightDirection; }
+
+        /**
+         * @brief Set light direction
+         * @return Reference to self (for method chaining)
+         *
+         * World-space direction in which the light shines, doesn't need to
+         * be normalized. Default is `{0.0f, -1.0f, 0.0f}`. Changing the
+         * direction marks all cascades as dirty in the next @ref update().
+         */
+        ShadowCascades& setLightDirection(const Vector3& direction);
+
+        /** @brief Split distribution factor */
+        Float splitLambda() const { return _splitLambda; }
+
+        /**
+         * @brief Set split distribution factor
+         * @return Reference to self (for method chaining)
+         *
+         * Blends between uniform (`0.0f`) and logarithmic (`1.0f`)
+         * distribution of split distances. Default is `0.75f`.
+         */
+        ShadowCascades& setSplitLambda(Float lambda);
+
+        /** @brief Caster distance */
+        Float casterDistance() const { return _casterDistance; }
+
+        /**
+         * @brief Set caster distance
+         * @return Reference to self (for method chaining)
+         *
+         * How far towards the light from the cascade bounds the casters are
+         * still rendered into the shadow map. Default is `100.0f`.
+         */
+        ShadowCascades& setCasterDistance(Float distance);
+
+        /** @brief Index of first cached cascade */
+        Int cachedCascadeStart() const { return _cachedCascadeStart; }
+
+        /**
+         * @brief Set index of first cached cascade
+         * @return Reference to self (for method chaining)
+         *
+         * Cascades with index equal to or larger than @p start are cached,
+         * see @ref ShadowCascades-cached-cascades "above" for details. Set
+         * to @ref cascadeCount() to disable caching. Default is `1`.
+         */
+        ShadowCascades& setCachedCascadeStart(Int start);
+
+        /** @brief Margin of cached cascades */
+        Float cacheMargin() const { return _cacheMargin; }
+
+        /**
+         * @brief Set margin of cached cascades
+         * @return Reference to self (for method chaining)
+         *
+         * Cached cascades are enlarged by given fraction of their radius
+         * and snapped to a grid of the same step, so larger margin means
+         * less frequent re-rendering at the cost of lower shadow resolution.
+         * Default is `0.25f`.
+         */
+        ShadowCascades& setCacheMargin(Float margin);
+
+        /**
+         * @brief Invalidate cascades containing given bounds
+         * @return Reference to self (for method chaining)
+         *
+         * Marks all cascades that may contain a shadow caster with given
+         * world-space bounds as dirty in the next @ref update(). Call it
+         * with both the old and new bounds of every caster that moved.
+         */
+        ShadowCascades& invalidate(const Range3D& bounds);
+
+        /**
+         * @brief Invalidate all cascades
+         * @return Reference to self (for method chaining)
+         */
+        ShadowCascades& invalidateAll();
+
+        /**
+         * @brief Update the cascades
+         * @param cameraMatrix      Camera matrix, transforming world
+         *      coordinates to camera coordinates
+         * @param fov               Horizontal field of view
+         * @param aspectRatio       Aspect ratio
+         * @param near              Near plane distance
+         * @param far               Far plane distance
+         * @return Reference to self (for method chaining)
+         *
+         * Calculates the split distances and cascade projections and
+         * decides which cascades are dirty and need to be rendered in this
+         * frame. The parameters are expected to match the camera
+         * projection used for rendering the scene.
+         */
+        ShadowCascades& update(const Matrix4& cameraMatrix, Rad fov, Float aspectRatio, Float near, Float far);
+
+        /**
+         * @brief Whether given cascade needs to be rendered
+         *
+         * Cascades are dirty after construction, if their projection
+         * changed in the last @ref update() or if they were invalidated
+         * before it.
+         */
+        bool isDirty(Int cascade) const;
+
+        /**
+         * @brief Light projection matrix of given cascade
+         *
+         * Transforms world coordinates to the cascade clip coordinates.
+         * Valid after @ref update().
+         */
+        Matrix4 projectionMatrix(Int cascade) const;
+
+        /**
+         * @brief Shadow matrix of given cascade
+         *
+         * Transforms camera coordinates to shadow map texture coordinates
+         * and depth of given cascade. Valid after @ref update(), used by
+         * @ref Phong::setShadowCascades().
+         */
+        Matrix4 shadowMatrix(Int cascade) const;
+
+        /**
+         * @brief Split distance of given cascade
+         *
+         * Distance from the camera where given cascade ends. Valid after
+         * @ref update().
+         */
+        Float splitDistance(Int cascade) const;
+
+        /** @brief Framebuffer for rendering given cascade */
+        Framebuffer& framebuffer(Int cascade);
+
+        /** @brief Depth texture */
+        Texture2DArray& depthTexture() { return _depthTexture; }
+
+    private:
+        struct Cascade {
+            explicit Cascade(Framebuffer&& framebuffer): framebuffer{std::move(framebuffer)} {}
+
+            Framebuffer framebuffer;
+            Matrix4 projectionMatrix, shadowMatrix;
+            Float splitDistance{};
+            bool dirty{true}, invalidated{true};
+        };
+
+        Int _size;
+        Vector3 _lightDirection{0.0f, -1.0f, 0.0f};
+        Float _splitLambda{0.75f},
+            _casterDistance{100.0f},
+            _cacheMargin{0.25f};
+        Int _cachedCascadeStart{1};
+
+        Texture2DArray _depthTexture;
+        std::vector<Cascade> _cascades;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform mediump vec2 textureScale
+    #ifndef GL_ES
+    = vec2(1.0)
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform lowp float sharpness
+    #ifndef GL_ES
+    = 0.5
+    #endif
+    ;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform lowp sampler2D textureData;
+
+in mediump vec2 interpolatedTextureCoordinates;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out lowp vec4 color;
+
+void main() {
+    /* Keep the bilinear taps inside of the rendered area so nothing from
+       outside of it bleeds in */
+    mediump vec2 texelSize = vec2(1.0)/vec2(textureSize(textureData, 0));
+    mediump vec2 minCoordinates = 0.5*texelSize;
+    mediump vec2 maxCoordinates = textureScale - 0.5*texelSize;
+
+    lowp vec4 center = texture(textureData, clamp(interpolatedTextureCoordinates, minCoordinates, maxCoordinates));
+    lowp vec4 left = texture(textureData, clamp(interpolatedTextureCoordinates - vec2(texelSize.x, 0.0), minCoordinates, maxCoordinates));
+    lowp vec4 right = texture(textureData, clamp(interpolatedTextureCoordinates + vec2(texelSize.x, 0.0), minCoordinates, maxCoordinates));
+    lowp vec4 bottom = texture(textureData, clamp(interpolatedTextureCoordinates - vec2(0.0, texelSize.y), minCoordinates, maxCoordinates));
+    lowp vec4 top = texture(textureData, clamp(interpolatedTextureCoordinates + vec2(0.0, texelSize.y), minCoordinates, maxCoordinates));
+
+    /* Unsharp mask, clamped to the neighborhood range to avoid ringing */
+    lowp vec4 neighborhoodMin = min(center, min(min(left, right), min(bottom, top)));
+    lowp vec4 neighborhoodMax = max(center, max(max(left, right), max(bottom, top)));
+    lowp vec4 sharpened = center + sharpness*(center - 0.25*(left + right + bottom + top));
+    color = clamp(sharpened, neighborhoodMin, neighborhoodMax);
+}
@@ -0,0 +1,128 @@
+#ifndef Magnum_Shaders_SharpenUpscale_h
+#define Magnum_Shaders_SharpenUpscale_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::SharpenUpscale
+ */
+#endif
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Sharpening upscale shader
+
+Upscales the lower left part of a texture to the whole framebuffer with
+bilinear filtering followed by a sharpening pass, which restores some of the
+detail lost by the upscale. Meant for presenting a frame rendered at reduced
+resolution by @ref DynamicResolution. Draws a full screen triangle generated
+from `gl_VertexID`, so it's meant to be used with
+@ref MeshTools::fullScreenTriangle():
+@code
+std::unique_ptr<Buffer> buffer;
+Mesh triangle;
+std::tie(buffer, triangle) = MeshTools::fullScreenTriangle();
+
+Shaders::SharpenUpscale shader;
+
+defaultFramebuffer.bind();
+Renderer::disable(Renderer::Feature::DepthTest);
+shader.setTexture(resolution.colorTexture())
+    .setTextureScale(resolution.textureScale());
+triangle.draw(shader);
+@endcode
+
+The sharpening is an unsharp mask over the four nearest neighbors in the
+source texture, clamped to their range to avoid ringing around edges.
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_webgl20 Not available in WebGL 1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT SharpenUpscale: public AbstractShaderProgram {
+    public:
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always.
+             */
+            ColorOutput = Generic3D::ColorOutput
+        };
+
+        explicit SharpenUpscale();
+
+        /**
+         * @brief Set texture scale
+         * @return Reference to self (for method chaining)
+         *
+         * Part of the texture that contains the rendered image, relative to
+         * the texture size. The area outside of it is never sampled. If not
+         * set, default value is `{1.0f, 1.0f}`.
+         * @see @ref DynamicResolution::textureScale()
+         */
+        SharpenUpscale& setTextureScale(const Vector2& scale) {
+            setUniform(_textureScaleUniform, scale);
+            return *this;
+        }
+
+        /**
+         * @brief Set sharpness
+         * @return Reference to self (for method chaining)
+         *
+         * Value of `0.0f` means plain bilinear upscale, `1.0f` is the
+         * strongest sharpening. If not set, default value is `0.5f`.
+         */
+        SharpenUpscale& setSharpness(Float sharpness) {
+            setUniform(_sharpnessUniform, sharpness);
+            return *this;
+        }
+
+        /**
+         * @brief Set source texture
+         * @return Reference to self (for method chaining)
+         *
+         * The texture is expected to have linear filtering.
+         */
+        SharpenUpscale& setTexture(Texture2D& texture);
+
+    private:
+        Int _textureScaleUniform{0},
+            _sharpnessUniform{1};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Skinning.h"
+
+#include <string>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/TransformFeedback.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+Skinning::Skinning(const UnsignedInt jointCount): _jointCount{jointCount} {
+    CORRADE_ASSERT(jointCount, "Shaders::Skinning: joint count can't be zero", );
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::gpu_shader4);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::transform_feedback);
+    const Version version = Context::current().supportedVersion({Version::GL330, Version::GL300});
+    #else
+    const Version version = Version::GLES300;
+    #endif
+
+    Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+
+    vert.addSource("#define JOINT_COUNT " + std::to_string(jointCount) + "\n")
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("Skinning.vert"));
+    frag.addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("Skinning.frag"));
+
+    if(!loadCachedBinary({vert, frag})) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        {
+            bindAttributeLocation(Position::Location, "position");
+            bindAttributeLocation(Normal::Location, "normal");
+            bindAttributeLocation(JointIds::Location, "jointIds");
+            bindAttributeLocation(Weights::Location, "weights");
+        }
+        #endif
+
+        setTransformFeedbackOutputs({"skinnedPosition", "skinnedNormal"}, TransformFeedbackBufferMode::InterleavedAttributes);
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        saveCachedBinary({vert, frag});
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _jointMatricesUniform = uniformLocation("jointMatrices");
+    }
+}
+
+Skinning& Skinning::setJointMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(matrices.size() == _jointCount,
+        "Shaders::Skinning::setJointMatrices(): expected" << _jointCount << "matrices but got" << matrices.size(), *this);
+    setUniform(_jointMatricesUniform, Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>>{matrices.data(), matrices.size()});
+    return *this;
+}
+
+Skinning& Skinning::skin(Mesh& mesh, TransformFeedback& feedback, Buffer& output, const GLintptr offset) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Points,
+        "Shaders::Skinning::skin(): expected a point mesh", *this);
+
+    feedback.attachBuffer(OutputBufferIndex, output, offset, mesh.count()*sizeof(Vertex));
+
+    Renderer::enable(Renderer::Feature::RasterizerDiscard);
+    feedback.begin(*this, TransformFeedback::PrimitiveMode::Points);
+    mesh.draw(*this);
+    feedback.end();
+    Renderer::disable(Renderer::Feature::RasterizerDiscard);
+
+    return *this;
+}
+
+}}
@@ -0,0 +1,200 @@
+#ifndef Magnum_Shaders_Skinning_h
+#define Magnum_Shaders_Skinning_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::Skinning
+ */
+#endif
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Skinning shader
+
+Transforms mesh vertices by a weighted blend of up to four joint matrices
+and captures the result using @ref TransformFeedback into a vertex buffer.
+The mesh is skinned only once per frame and the resulting buffer is then
+reused by all rendering passes (shadow maps, depth pre-pass, main pass), which
+then don't need to do any skinning by themselves.
+
+## Example usage
+
+The source mesh contains one point per vertex, with @ref Position,
+@ref Normal, @ref JointIds and @ref Weights attributes. It's expected to be
+non-indexed and to have @ref MeshPrimitive::Points primitive. The mesh used
+for rendering takes the skinned buffer as its vertex buffer, while keeping
+the original primitive and index buffer:
+@code
+Mesh source;
+source.setPrimitive(MeshPrimitive::Points)
+    .setCount(vertexCount)
+    .addVertexBuffer(vertices, 0,
+        Shaders::Skinning::Position{},
+        Shaders::Skinning::Normal{},
+        Shaders::Skinning::JointIds{},
+        Shaders::Skinning::Weights{});
+
+Buffer skinned;
+skinned.setData({nullptr, vertexCount*sizeof(Shaders::Skinning::Vertex)}, BufferUsage::DynamicCopy);
+
+Mesh mesh;
+mesh.setPrimitive(MeshPrimitive::Triangles)
+    .setCount(indexCount)
+    .addVertexBuffer(skinned, 0, Shaders::Phong::Position{}, Shaders::Phong::Normal{})
+    .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedShort);
+
+Shaders::Skinning skinning{jointCount};
+TransformFeedback feedback;
+@endcode
+
+Each frame:
+@code
+skinning.setJointMatrices(jointMatrices)
+    .skin(source, feedback, skinned);
+
+mesh.draw(shadowShader);
+mesh.draw(depthShader);
+mesh.draw(phongShader);
+@endcode
+
+With more characters, the same shader and transform feedback object can be
+used for all of them, each writing to its own buffer or buffer range.
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4} for integer
+    attributes and @extension{EXT,transform_feedback}
+@requires_gl40 Extension @extension{ARB,transform_feedback2} for
+    @ref TransformFeedback objects
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT Skinning: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref Magnum::Vector3 "Vector3", the same location as
+         * @ref Generic::Position.
+         */
+        typedef Generic3D::Position Position;
+
+        /**
+         * @brief Normal direction
+         *
+         * @ref Magnum::Vector3 "Vector3", the same location as
+         * @ref Generic::Normal.
+         */
+        typedef Generic3D::Normal Normal;
+
+        /**
+         * @brief Joint IDs
+         *
+         * @ref Magnum::Vector4ui "Vector4ui", indices into the array set by
+         * @ref setJointMatrices(). Occupies the location of
+         * @ref Generic::TransformationMatrix, which isn't used by this
+         * shader.
+         */
+        typedef Attribute<4, Vector4ui> JointIds;
+
+        /**
+         * @brief Joint weights
+         *
+         * @ref Magnum::Vector4 "Vector4", weight of each joint from
+         * @ref JointIds. The weights are expected to sum up to `1.0f`,
+         * unused joints should have zero weight.
+         */
+        typedef Attribute<5, Vector4> Weights;
+
+        /**
+         * @brief Skinned vertex
+         *
+         * Layout of the vertex data captured by @ref skin(), the stride is
+         * 24 bytes.
+         */
+        struct Vertex {
+            Vector3 position;   /**< Skinned position */
+            Vector3 normal;     /**< Skinned normal */
+        };
+
+        /** @brief Transform feedback buffer binding points */
+        enum: UnsignedInt {
+            /** Binding point for the skinned vertex buffer */
+            OutputBufferIndex = 0
+        };
+
+        /**
+         * @brief Constructor
+         * @param jointCount    Count of joint matrices
+         */
+        explicit Skinning(UnsignedInt jointCount);
+
+        /** @brief Joint count */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the size of @p matrices is the same as
+         * @ref jointCount(). The matrices are expected to contain the inverse
+         * bind pose already and to have no non-uniform scaling.
+         */
+        Skinning& setJointMatrices(Containers::ArrayView<const Matrix4> matrices);
+
+        /**
+         * @brief Skin a mesh
+         * @return Reference to self (for method chaining)
+         *
+         * Draws @p mesh with rasterization disabled and captures the skinned
+         * vertices into @p output at given @p offset, which is expected to
+         * have space for @ref Mesh::count() @ref Vertex structures. Expects
+         * that @p mesh has @ref MeshPrimitive::Points primitive.
+         * @see @ref TransformFeedback::attachBuffer(),
+         *      @ref Renderer::Feature::RasterizerDiscard
+         */
+        Skinning& skin(Mesh& mesh, TransformFeedback& feedback, Buffer& output, GLintptr offset = 0);
+
+    private:
+        UnsignedInt _jointCount;
+        Int _jointMatricesUniform{0};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
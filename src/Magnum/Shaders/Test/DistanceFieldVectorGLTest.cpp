@@ -23,7 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#endif
 #include "Magnum/Test/AbstractOpenGLTester.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -33,11 +38,24 @@ struct DistanceFieldVectorGLTest: Magnum::Test::AbstractOpenGLTester {
 
     void compile2D();
     void compile3D();
+    void compile2DMultiChannel();
+    void compile3DMultiChannel();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compile2DTextureArray();
+    void compile3DTextureArray();
+    #endif
 };
 
 DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
     addTests({&DistanceFieldVectorGLTest::compile2D,
-              &DistanceFieldVectorGLTest::compile3D});
+              &DistanceFieldVectorGLTest::compile3D,
+              &DistanceFieldVectorGLTest::compile2DMultiChannel,
+              &DistanceFieldVectorGLTest::compile3DMultiChannel,
+              #ifndef MAGNUM_TARGET_GLES2
+              &DistanceFieldVectorGLTest::compile2DTextureArray,
+              &DistanceFieldVectorGLTest::compile3DTextureArray
+              #endif
+              });
 }
 
 void DistanceFieldVectorGLTest::compile2D() {
@@ -60,6 +78,74 @@ void DistanceFieldVectorGLTest::compile3D() {
     }
 }
 
+void DistanceFieldVectorGLTest::compile2DMultiChannel() {
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::MultiChannel};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector2D::Flag::MultiChannel);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DistanceFieldVectorGLTest::compile3DMultiChannel() {
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::MultiChannel};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector3D::Flag::MultiChannel);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorGLTest::compile2DTextureArray() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Texture2DArray texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {16, 16, 2});
+
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::MultiChannel|Shaders::DistanceFieldVector2D::Flag::TextureArray};
+    shader.setVectorTexture(texture)
+        .setTextureArrayLayer(1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DistanceFieldVectorGLTest::compile3DTextureArray() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Texture2DArray texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {16, 16, 2});
+
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::MultiChannel|Shaders::DistanceFieldVector3D::Flag::TextureArray};
+    shader.setVectorTexture(texture)
+        .setTextureArrayLayer(1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::DistanceFieldVectorGLTest)
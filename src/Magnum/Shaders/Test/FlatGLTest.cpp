@@ -23,7 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Shaders/Flat.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#include "Magnum/BufferTextureFormat.h"
+#endif
 #include "Magnum/Test/AbstractOpenGLTester.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -35,13 +47,52 @@ struct FlatGLTest: Magnum::Test::AbstractOpenGLTester {
     void compile3D();
     void compile2DTextured();
     void compile3DTextured();
+    void compile2DInstanced();
+    void compile3DInstanced();
+    void compile2DInstancedColor();
+    void compile3DInstancedColor();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compile2DUniformBuffers();
+    void compile3DUniformBuffers();
+    void compile2DObjectId();
+    void compile3DObjectId();
+    void compile3DDualQuaternionSkinning();
+    void compile3DTextureArrays();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void compile3DMultiView();
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compile2DTransformationTexture();
+    void compile3DTransformationTexture();
+    #endif
 };
 
 FlatGLTest::FlatGLTest() {
     addTests({&FlatGLTest::compile2D,
               &FlatGLTest::compile3D,
               &FlatGLTest::compile2DTextured,
-              &FlatGLTest::compile3DTextured});
+              &FlatGLTest::compile3DTextured,
+              &FlatGLTest::compile2DInstanced,
+              &FlatGLTest::compile3DInstanced,
+              &FlatGLTest::compile2DInstancedColor,
+              &FlatGLTest::compile3DInstancedColor,
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatGLTest::compile2DUniformBuffers,
+              &FlatGLTest::compile3DUniformBuffers,
+              &FlatGLTest::compile2DObjectId,
+              &FlatGLTest::compile3DObjectId,
+              &FlatGLTest::compile3DDualQuaternionSkinning,
+              &FlatGLTest::compile3DTextureArrays,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &FlatGLTest::compile3DMultiView,
+              #endif
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &FlatGLTest::compile2DTransformationTexture,
+              &FlatGLTest::compile3DTransformationTexture
+              #endif
+              });
 }
 
 void FlatGLTest::compile2D() {
@@ -84,6 +135,287 @@ void FlatGLTest::compile3DTextured() {
     }
 }
 
+void FlatGLTest::compile2DInstanced() {
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DInstanced() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile2DInstancedColor() {
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::InstancedTransformation|Shaders::Flat2D::Flag::InstancedColor);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DInstancedColor() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::InstancedTransformation|Shaders::Flat3D::Flag::InstancedColor);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::compile2DUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string{" is not supported."});
+    #endif
+
+    /* std140 layout, mat3 columns are padded to vec4 */
+    CORRADE_COMPARE(sizeof(Shaders::Flat2D::TransformationProjectionUniform), 48);
+    CORRADE_COMPARE(sizeof(Shaders::Flat2D::MaterialUniform), 16);
+
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::UniformBuffers};
+
+    const Shaders::Flat2D::TransformationProjectionUniform transformationProjectionData;
+    const Shaders::Flat2D::MaterialUniform materialData;
+    Buffer transformationProjection, material;
+    transformationProjection.setData({&transformationProjectionData, 1}, BufferUsage::StaticDraw);
+    material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+    shader.bindTransformationProjectionBuffer(transformationProjection)
+        .bindMaterialBuffer(material);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string{" is not supported."});
+    #endif
+
+    /* std140 layout */
+    CORRADE_COMPARE(sizeof(Shaders::Flat3D::TransformationProjectionUniform), 64);
+    CORRADE_COMPARE(sizeof(Shaders::Flat3D::MaterialUniform), 16);
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers};
+
+    const Shaders::Flat3D::TransformationProjectionUniform transformationProjectionData;
+    const Shaders::Flat3D::MaterialUniform materialData;
+    Buffer transformationProjection, material;
+    transformationProjection.setData({&transformationProjectionData, 1}, BufferUsage::StaticDraw);
+    material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+    shader.bindTransformationProjectionBuffer(transformationProjection)
+        .bindMaterialBuffer(material);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile2DObjectId() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::gpu_shader4>())
+        CORRADE_SKIP(Extensions::GL::EXT::gpu_shader4::string() + std::string{" is not supported."});
+    #endif
+
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::ObjectId};
+    CORRADE_VERIFY(shader.flags() == Shaders::Flat2D::Flag::ObjectId);
+
+    shader.setObjectId(0xdeadbeef);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DObjectId() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::gpu_shader4>())
+        CORRADE_SKIP(Extensions::GL::EXT::gpu_shader4::string() + std::string{" is not supported."});
+    #endif
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::ObjectId};
+    CORRADE_VERIFY(shader.flags() == Shaders::Flat3D::Flag::ObjectId);
+
+    shader.setObjectId(0xdeadbeef);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DDualQuaternionSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string{" is not supported."});
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::gpu_shader4>())
+        CORRADE_SKIP(Extensions::GL::EXT::gpu_shader4::string() + std::string{" is not supported."});
+    #endif
+
+    /* The joints are tightly packed vec4 pairs in std140 */
+    CORRADE_COMPARE(sizeof(DualQuaternion), 32);
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::DualQuaternionSkinning};
+    CORRADE_VERIFY(shader.flags() == Shaders::Flat3D::Flag::DualQuaternionSkinning);
+
+    const DualQuaternion jointData[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f}),
+        DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis())
+    };
+    Buffer joints;
+    joints.setData(jointData, BufferUsage::StaticDraw);
+    shader.bindJointBuffer(joints);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string{" is not supported."});
+    #endif
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::TextureArrays|Shaders::Flat3D::Flag::InstancedTransformation};
+    CORRADE_VERIFY(shader.flags() == (Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::TextureArrays|Shaders::Flat3D::Flag::InstancedTransformation));
+
+    Texture2DArray texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4, 2});
+    shader.setTexture(texture);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void FlatGLTest::compile3DMultiView() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::AMD::vertex_shader_layer>())
+        CORRADE_SKIP(Extensions::GL::AMD::vertex_shader_layer::string() + std::string{" is not supported."});
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::MultiView};
+    CORRADE_VERIFY(shader.flags() == Shaders::Flat3D::Flag::MultiView);
+
+    const Matrix4 viewProjectionMatrices[]{
+        Matrix4::translation(Vector3::xAxis(0.5f)),
+        Matrix4::translation(Vector3::xAxis(-0.5f))
+    };
+    shader.setViewProjectionMatrices(viewProjectionMatrices);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void FlatGLTest::compile2DTransformationTexture() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    /* The per-instance attribute is ignored in favor of the palette */
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::TransformationTexture|Shaders::Flat2D::Flag::InstancedTransformation};
+    CORRADE_VERIFY(shader.flags() == (Shaders::Flat2D::Flag::TransformationTexture|Shaders::Flat2D::Flag::InstancedTransformation));
+
+    /* Three columns per matrix, padded to four components */
+    const Vector4 transformations[6]{};
+    Buffer buffer;
+    buffer.setData(transformations, BufferUsage::StaticDraw);
+    BufferTexture texture;
+    texture.setBuffer(BufferTextureFormat::RGBA32F, buffer);
+    shader.setTransformationTexture(texture)
+        .setTransformationTextureOffset(1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DTransformationTexture() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    /* The per-instance attribute is ignored in favor of the palette */
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::TransformationTexture|Shaders::Flat3D::Flag::InstancedTransformation};
+    CORRADE_VERIFY(shader.flags() == (Shaders::Flat3D::Flag::TransformationTexture|Shaders::Flat3D::Flag::InstancedTransformation));
+
+    /* Four columns per matrix */
+    const Vector4 transformations[8]{};
+    Buffer buffer;
+    buffer.setData(transformations, BufferUsage::StaticDraw);
+    BufferTexture texture;
+    texture.setBuffer(BufferTextureFormat::RGBA32F, buffer);
+    shader.setTransformationTexture(texture)
+        .setTransformationTextureOffset(1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::FlatGLTest)
@@ -0,0 +1,168 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shaders/FrustumCulling.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct FrustumCullingGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit FrustumCullingGLTest();
+
+    void compile();
+    void compileOcclusionCulling();
+    #ifndef MAGNUM_TARGET_GLES
+    void cull();
+    #endif
+};
+
+FrustumCullingGLTest::FrustumCullingGLTest() {
+    addTests({&FrustumCullingGLTest::compile,
+              &FrustumCullingGLTest::compileOcclusionCulling,
+              #ifndef MAGNUM_TARGET_GLES
+              &FrustumCullingGLTest::cull
+              #endif
+              });
+}
+
+namespace {
+    bool computeSupported() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>() &&
+               Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>();
+        #else
+        return Context::current().isVersionSupported(Version::GLES310);
+        #endif
+    }
+}
+
+void FrustumCullingGLTest::compile() {
+    if(!computeSupported())
+        CORRADE_SKIP("Compute shaders are not supported.");
+
+    FrustumCulling shader;
+    CORRADE_COMPARE(shader.flags(), FrustumCulling::Flags{});
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FrustumCullingGLTest::compileOcclusionCulling() {
+    if(!computeSupported())
+        CORRADE_SKIP("Compute shaders are not supported.");
+
+    FrustumCulling shader{FrustumCulling::Flag::OcclusionCulling};
+    CORRADE_COMPARE(shader.flags(), FrustumCulling::Flag::OcclusionCulling);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void FrustumCullingGLTest::cull() {
+    if(!computeSupported())
+        CORRADE_SKIP("Compute shaders are not supported.");
+
+    /* Identity projection, so the frustum is the [-1, 1] cube */
+    const FrustumCulling::Object objects[] = {
+        /* Inside */
+        {Matrix4{}, {}, 0.5f},
+        /* Outside */
+        {Matrix4::translation({5.0f, 0.0f, 0.0f}), {}, 0.5f},
+        /* Partially inside */
+        {Matrix4::translation({0.0f, 1.25f, 0.0f}), {}, 0.5f},
+        /* Outside, but the scaled radius reaches inside */
+        {Matrix4::translation({0.0f, 0.0f, -2.5f})*Matrix4::scaling(Vector3{2.0f}), {}, 0.8f},
+        /* Outside, sphere center offset in object space */
+        {Matrix4{}, {0.0f, 0.0f, 3.0f}, 0.5f}
+    };
+
+    const MeshView::DrawElementsIndirectCommand commands[] = {
+        {10, 1, 0, 0, 0},
+        {20, 1, 0, 0, 1},
+        {30, 1, 0, 0, 2},
+        {40, 1, 0, 0, 3},
+        {50, 1, 0, 0, 4}
+    };
+
+    Buffer objectBuffer, commandBuffer, visibleCommandBuffer, drawCountBuffer;
+    objectBuffer.setData(objects, BufferUsage::StaticDraw);
+    commandBuffer.setData(commands, BufferUsage::StaticDraw);
+    visibleCommandBuffer.setData({nullptr, sizeof(commands)}, BufferUsage::DynamicCopy);
+    constexpr UnsignedInt zero[]{0};
+    drawCountBuffer.setData(zero, BufferUsage::DynamicCopy);
+
+    FrustumCulling shader;
+    shader.setProjectionCameraMatrix(Matrix4{})
+        .bindObjectBuffer(objectBuffer)
+        .bindCommandBuffer(commandBuffer)
+        .bindVisibleCommandBuffer(visibleCommandBuffer)
+        .bindDrawCountBuffer(drawCountBuffer)
+        .cull(5);
+
+    Renderer::setMemoryBarrier(Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Containers::Array<UnsignedInt> drawCount = drawCountBuffer.data<UnsignedInt>();
+    CORRADE_COMPARE(drawCount[0], 3);
+
+    /* The order is not preserved */
+    Containers::Array<MeshView::DrawElementsIndirectCommand> visible = visibleCommandBuffer.data<MeshView::DrawElementsIndirectCommand>();
+    std::sort(visible.begin(), visible.begin() + 3,
+        [](const MeshView::DrawElementsIndirectCommand& a, const MeshView::DrawElementsIndirectCommand& b) {
+            return a.count < b.count;
+        });
+    CORRADE_COMPARE(visible[0].count, 10);
+    CORRADE_COMPARE(visible[0].baseInstance, 0);
+    CORRADE_COMPARE(visible[1].count, 30);
+    CORRADE_COMPARE(visible[1].baseInstance, 2);
+    CORRADE_COMPARE(visible[2].count, 40);
+    CORRADE_COMPARE(visible[2].baseInstance, 3);
+}
+#endif
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::FrustumCullingGLTest)
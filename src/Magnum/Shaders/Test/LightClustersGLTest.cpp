@@ -0,0 +1,146 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Shaders/LightClusters.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct LightClustersGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit LightClustersGLTest();
+
+    void construct();
+    void clusterRange();
+    void clusterRangeOutside();
+    void clusterRangeNearPlane();
+    void update();
+    void updateEmpty();
+};
+
+LightClustersGLTest::LightClustersGLTest() {
+    addTests({&LightClustersGLTest::construct,
+              &LightClustersGLTest::clusterRange,
+              &LightClustersGLTest::clusterRangeOutside,
+              &LightClustersGLTest::clusterRangeNearPlane,
+              &LightClustersGLTest::update,
+              &LightClustersGLTest::updateEmpty});
+}
+
+namespace {
+    /* 90° field of view, so the NDC coordinates are just x/-z */
+    const Matrix4 Projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 1.0f, 100.0f);
+}
+
+void LightClustersGLTest::construct() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(clusters.clusterCount(), (Vector3i{4, 4, 8}));
+    CORRADE_COMPARE(clusters.near(), 1.0f);
+    CORRADE_COMPARE(clusters.far(), 100.0f);
+    CORRADE_COMPARE(clusters.viewportSize(), (Vector2i{256, 256}));
+    CORRADE_VERIFY(clusters.clusters().empty());
+}
+
+void LightClustersGLTest::clusterRange() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256});
+
+    /* Depth 9 to 11 is in slices 3 and 4, NDC -1/9 to 1/9 in tiles 1 and 2 */
+    CORRADE_COMPARE(clusters.clusterRange({{0.0f, 0.0f, -10.0f}, 1.0f}),
+        (Range3Di{{1, 1, 3}, {3, 3, 5}}));
+}
+
+void LightClustersGLTest::clusterRangeOutside() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256});
+
+    /* Behind the camera */
+    CORRADE_COMPARE(clusters.clusterRange({{0.0f, 0.0f, 5.0f}, 1.0f}), Range3Di{});
+    /* Beyond the far plane */
+    CORRADE_COMPARE(clusters.clusterRange({{0.0f, 0.0f, -110.0f}, 1.0f}), Range3Di{});
+    /* Outside on the side */
+    CORRADE_COMPARE(clusters.clusterRange({{50.0f, 0.0f, -10.0f}, 1.0f}), Range3Di{});
+}
+
+void LightClustersGLTest::clusterRangeNearPlane() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256});
+
+    /* Crossing the near plane, covers the whole screen */
+    CORRADE_COMPARE(clusters.clusterRange({{0.0f, 0.0f, -1.0f}, 1.0f}),
+        (Range3Di{{0, 0, 0}, {4, 4, 2}}));
+}
+
+void LightClustersGLTest::update() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256})
+        .update({
+            {{0.0f, 0.0f, -10.0f}, 1.0f},
+            {{50.0f, 0.0f, -10.0f}, 1.0f},
+            {{0.0f, 0.0f, -1.0f}, 1.0f},
+            {{0.0f, 0.0f, -10.0f}, 1.0f, Color4{0.5f}}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(clusters.clusters().size(), 4*4*8);
+    CORRADE_COMPARE(clusters.lightIndices().size(), 8 + 32 + 8);
+
+    /* Cluster {1, 1, 3} has the first and last light */
+    const Vector2ui a = clusters.clusters()[1 + 4*(1 + 4*3)];
+    CORRADE_COMPARE(a.y(), 2);
+    CORRADE_COMPARE(clusters.lightIndices()[a.x()], 0);
+    CORRADE_COMPARE(clusters.lightIndices()[a.x() + 1], 3);
+
+    /* Cluster {0, 0, 0} has only the light crossing near plane */
+    const Vector2ui b = clusters.clusters()[0];
+    CORRADE_COMPARE(b.y(), 1);
+    CORRADE_COMPARE(clusters.lightIndices()[b.x()], 2);
+
+    /* Cluster {0, 0, 7} has nothing */
+    CORRADE_COMPARE(clusters.clusters()[4*4*7].y(), 0);
+
+    CORRADE_COMPARE(clusters.lightBuffer().size(), Int(4*sizeof(LightClusters::Light)));
+    CORRADE_COMPARE(clusters.clusterBuffer().size(), Int(4*4*8*sizeof(Vector2ui)));
+    CORRADE_COMPARE(clusters.lightIndexBuffer().size(), Int(48*sizeof(UnsignedInt)));
+}
+
+void LightClustersGLTest::updateEmpty() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Projection, 1.0f, 100.0f, {256, 256})
+        .update({});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(clusters.clusters().size(), 4*4*8);
+    CORRADE_VERIFY(clusters.lightIndices().empty());
+
+    /* The buffers are never empty so they can be bound */
+    CORRADE_COMPARE(clusters.lightBuffer().size(), Int(sizeof(LightClusters::Light)));
+    CORRADE_COMPARE(clusters.lightIndexBuffer().size(), Int(sizeof(UnsignedInt)));
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::LightClustersGLTest)
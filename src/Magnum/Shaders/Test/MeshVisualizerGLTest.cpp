@@ -24,6 +24,11 @@
 */
 
 #include "Magnum/Context.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Buffer.h"
+#include "Magnum/BufferTexture.h"
+#include "Magnum/BufferTextureFormat.h"
+#endif
 #include "Magnum/Extensions.h"
 #include "Magnum/Shaders/MeshVisualizer.h"
 #include "Magnum/Test/AbstractOpenGLTester.h"
@@ -38,6 +43,9 @@ struct MeshVisualizerGLTest: Magnum::Test::AbstractOpenGLTester {
     void compileWireframeGeometryShader();
     #endif
     void compileWireframeNoGeometryShader();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compileWireframeVertexPulling();
+    #endif
 };
 
 MeshVisualizerGLTest::MeshVisualizerGLTest() {
@@ -45,7 +53,11 @@ MeshVisualizerGLTest::MeshVisualizerGLTest() {
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
               &MeshVisualizerGLTest::compileWireframeGeometryShader,
               #endif
-              &MeshVisualizerGLTest::compileWireframeNoGeometryShader});
+              &MeshVisualizerGLTest::compileWireframeNoGeometryShader,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshVisualizerGLTest::compileWireframeVertexPulling
+              #endif
+              });
 }
 
 void MeshVisualizerGLTest::compile() {
@@ -93,6 +105,37 @@ void MeshVisualizerGLTest::compileWireframeNoGeometryShader() {
     }
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshVisualizerGLTest::compileWireframeVertexPulling() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string(" is not supported"));
+    #endif
+
+    Shaders::MeshVisualizer shader(Shaders::MeshVisualizer::Flag::Wireframe|Shaders::MeshVisualizer::Flag::VertexPulling);
+
+    Buffer indices, positions;
+    indices.setData({nullptr, 3*sizeof(UnsignedInt)}, BufferUsage::StaticDraw);
+    positions.setData({nullptr, 3*sizeof(Vector4)}, BufferUsage::StaticDraw);
+    BufferTexture indexTexture, positionTexture;
+    indexTexture.setBuffer(BufferTextureFormat::R32UI, indices);
+    positionTexture.setBuffer(BufferTextureFormat::RGBA32F, positions);
+    shader.setIndexTexture(indexTexture)
+        .setPositionTexture(positionTexture);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::MeshVisualizerGLTest)
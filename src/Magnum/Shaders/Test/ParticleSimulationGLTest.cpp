@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shaders/ParticleSimulation.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ParticleSimulationGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit ParticleSimulationGLTest();
+
+    void compile();
+    #ifndef MAGNUM_TARGET_GLES
+    void simulate();
+    #endif
+};
+
+ParticleSimulationGLTest::ParticleSimulationGLTest() {
+    addTests({&ParticleSimulationGLTest::compile,
+              #ifndef MAGNUM_TARGET_GLES
+              &ParticleSimulationGLTest::simulate
+              #endif
+              });
+}
+
+void ParticleSimulationGLTest::compile() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    ParticleSimulation shader;
+    CORRADE_COMPARE(shader.workGroupSize(), (Vector3ui{64, 1, 1}));
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void ParticleSimulationGLTest::simulate() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."));
+
+    /* Not a multiple of the workgroup size to verify the bounds check */
+    std::vector<ParticleSimulation::Particle> data(100);
+    data[99].lifetime = 1000.0f;
+    data[99].velocity = {1.0f, 0.0f, 0.0f};
+
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::DynamicCopy);
+
+    ParticleSimulation shader;
+    shader.setTimeDelta(0.5f)
+        .setGravity({})
+        .setEmitterPosition({1.0f, 2.0f, 3.0f})
+        .setEmitterVelocity({0.0f, 4.0f, 0.0f})
+        .setSpread(0.5f)
+        .setLifetime(10.0f)
+        .bindParticleBuffer(buffer)
+        .simulate(UnsignedInt(data.size()));
+
+    Renderer::setMemoryBarrier(Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Containers::Array<ParticleSimulation::Particle> result = buffer.data<ParticleSimulation::Particle>();
+    CORRADE_COMPARE(result.size(), 100);
+
+    /* Dead particles got respawned at the emitter */
+    for(std::size_t i = 0; i != 99; ++i) {
+        CORRADE_COMPARE(result[i].position, (Vector3{1.0f, 2.0f, 3.0f}));
+        CORRADE_VERIFY(result[i].lifetime >= 5.0f && result[i].lifetime <= 10.0f);
+        CORRADE_VERIFY(Math::abs(result[i].velocity - Vector3{0.0f, 4.0f, 0.0f}).max() <= 0.5f);
+    }
+
+    /* Alive particle got integrated */
+    CORRADE_COMPARE(result[99].position, (Vector3{0.5f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(result[99].lifetime, 999.5f);
+}
+#endif
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::ParticleSimulationGLTest)
@@ -23,7 +23,22 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
 #include "Magnum/Shaders/Phong.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#include "Magnum/BufferTextureFormat.h"
+#include "Magnum/Shaders/LightClusters.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#include "Magnum/Shaders/ShadowCascades.h"
+#endif
 #include "Magnum/Test/AbstractOpenGLTester.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -39,6 +54,30 @@ struct PhongGLTest: Magnum::Test::AbstractOpenGLTester {
     void compileAmbientSpecularTexture();
     void compileDiffuseSpecularTexture();
     void compileAmbientDiffuseSpecularTexture();
+    void compileInstanced();
+    void compileInstancedDiffuseTexture();
+    void compileAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileUniformBuffers();
+    void compileObjectId();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void compileBindlessTextures();
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compileClusteredLights();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileShadows();
+    void compileDualQuaternionSkinning();
+    void compileTextureArrays();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void compileMultiView();
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compileTransformationTexture();
+    #endif
 };
 
 PhongGLTest::PhongGLTest() {
@@ -49,7 +88,32 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::compileAmbientDiffuseTexture,
               &PhongGLTest::compileAmbientSpecularTexture,
               &PhongGLTest::compileDiffuseSpecularTexture,
-              &PhongGLTest::compileAmbientDiffuseSpecularTexture});
+              &PhongGLTest::compileAmbientDiffuseSpecularTexture,
+              &PhongGLTest::compileInstanced,
+              &PhongGLTest::compileInstancedDiffuseTexture,
+              &PhongGLTest::compileAsync,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::compileUniformBuffers,
+              &PhongGLTest::compileObjectId,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &PhongGLTest::compileBindlessTextures,
+              #endif
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &PhongGLTest::compileClusteredLights,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::compileShadows,
+              &PhongGLTest::compileDualQuaternionSkinning,
+              &PhongGLTest::compileTextureArrays,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &PhongGLTest::compileMultiView,
+              #endif
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &PhongGLTest::compileTransformationTexture
+              #endif
+              });
 }
 
 void PhongGLTest::compile() {
@@ -132,6 +196,311 @@ void PhongGLTest::compileAmbientDiffuseSpecularTexture() {
     }
 }
 
+void PhongGLTest::compileInstanced() {
+    Shaders::Phong shader(Shaders::Phong::Flag::InstancedTransformation);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileInstancedDiffuseTexture() {
+    Shaders::Phong shader(Shaders::Phong::Flag::InstancedTransformation|Shaders::Phong::Flag::DiffuseTexture);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileAsync() {
+    Shaders::Phong::CompileState state = Shaders::Phong::compile(Shaders::Phong::Flag::DiffuseTexture);
+    CORRADE_VERIFY(state.flags() == Shaders::Phong::Flag::DiffuseTexture);
+
+    /* Would be spread across frames in a real application */
+    while(!state.isLinkFinished()) {}
+
+    Shaders::Phong shader{std::move(state)};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::DiffuseTexture);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::compileUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string{" is not supported."});
+    #endif
+
+    /* std140 layout */
+    CORRADE_COMPARE(sizeof(Shaders::Phong::ProjectionUniform), 64);
+    CORRADE_COMPARE(sizeof(Shaders::Phong::TransformationUniform), 112);
+    CORRADE_COMPARE(sizeof(Shaders::Phong::LightUniform), 32);
+    CORRADE_COMPARE(sizeof(Shaders::Phong::MaterialUniform), 64);
+
+    Shaders::Phong shader{Shaders::Phong::Flag::UniformBuffers};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::UniformBuffers);
+
+    const Shaders::Phong::ProjectionUniform projectionData;
+    const Shaders::Phong::TransformationUniform transformationData;
+    const Shaders::Phong::LightUniform lightData;
+    const Shaders::Phong::MaterialUniform materialData;
+    Buffer projection, transformation, light, material;
+    projection.setData({&projectionData, 1}, BufferUsage::StaticDraw);
+    transformation.setData({&transformationData, 1}, BufferUsage::StaticDraw);
+    light.setData({&lightData, 1}, BufferUsage::StaticDraw);
+    material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+    shader.bindProjectionBuffer(projection)
+        .bindTransformationBuffer(transformation, 0, sizeof(Shaders::Phong::TransformationUniform))
+        .bindLightBuffer(light)
+        .bindMaterialBuffer(material);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileObjectId() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::gpu_shader4>())
+        CORRADE_SKIP(Extensions::GL::EXT::gpu_shader4::string() + std::string{" is not supported."});
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::ObjectId};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::ObjectId);
+
+    shader.setObjectId(0xdeadbeef);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void PhongGLTest::compileBindlessTextures() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string{" is not supported."});
+
+    /* std140 layout */
+    CORRADE_COMPARE(sizeof(Shaders::Phong::TextureUniform), 32);
+
+    Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::BindlessTextures};
+    CORRADE_VERIFY(shader.flags() & Shaders::Phong::Flag::UniformBuffers);
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4})
+        .setResident(true);
+    CORRADE_VERIFY(texture.isResident());
+
+    const Shaders::Phong::ProjectionUniform projectionData;
+    const Shaders::Phong::TransformationUniform transformationData;
+    const Shaders::Phong::LightUniform lightData;
+    const Shaders::Phong::MaterialUniform materialData;
+    const Shaders::Phong::TextureUniform textureData{0, texture.handle()};
+    Buffer projection, transformation, light, material, textures;
+    projection.setData({&projectionData, 1}, BufferUsage::StaticDraw);
+    transformation.setData({&transformationData, 1}, BufferUsage::StaticDraw);
+    light.setData({&lightData, 1}, BufferUsage::StaticDraw);
+    material.setData({&materialData, 1}, BufferUsage::StaticDraw);
+    textures.setData({&textureData, 1}, BufferUsage::StaticDraw);
+    shader.bindProjectionBuffer(projection)
+        .bindTransformationBuffer(transformation)
+        .bindLightBuffer(light)
+        .bindMaterialBuffer(material)
+        .bindTextureBuffer(textures);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(shader.validate().first);
+
+    texture.setResident(false);
+    CORRADE_VERIFY(!texture.isResident());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::compileClusteredLights() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string{" is not supported."});
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::ClusteredLights};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::ClusteredLights);
+
+    Shaders::LightClusters clusters{{4, 4, 8}};
+    clusters.setProjection(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f), 0.1f, 100.0f, {64, 64})
+        .update({{{0.0f, 0.0f, -5.0f}, 2.0f}, {{1.0f, 1.0f, -10.0f}, 3.0f, Color4{0.5f}}});
+    shader.bindLightClusters(clusters)
+        .setLightPosition({1.0f, 2.0f, 3.0f})
+        .setLightColor(Color4{1.0f});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::compileShadows() {
+    Shaders::Phong shader{Shaders::Phong::Flag::Shadows};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::Shadows);
+
+    Shaders::ShadowCascades cascades{3, 256};
+    cascades.setLightDirection({-1.0f, -1.0f, 0.0f})
+        .update({}, Deg(60.0f), 1.0f, 0.1f, 100.0f);
+    shader.setShadowCascades(cascades)
+        .setLightPosition({100.0f, 100.0f, 0.0f});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileDualQuaternionSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string{" is not supported."});
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::gpu_shader4>())
+        CORRADE_SKIP(Extensions::GL::EXT::gpu_shader4::string() + std::string{" is not supported."});
+    #endif
+
+    /* The joints are tightly packed vec4 pairs in std140 */
+    CORRADE_COMPARE(sizeof(DualQuaternion), 32);
+
+    Shaders::Phong shader{Shaders::Phong::Flag::DualQuaternionSkinning};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::DualQuaternionSkinning);
+
+    const DualQuaternion jointData[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f}),
+        DualQuaternion::rotation(Deg(90.0f), Vector3::zAxis())
+    };
+    Buffer joints;
+    joints.setData(jointData, BufferUsage::StaticDraw);
+    shader.bindJointBuffer(joints);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string{" is not supported."});
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::SpecularTexture|Shaders::Phong::Flag::TextureArrays};
+    CORRADE_VERIFY(shader.flags() == (Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::SpecularTexture|Shaders::Phong::Flag::TextureArrays));
+
+    Texture2DArray diffuse, specular;
+    diffuse.setStorage(1, TextureFormat::RGBA8, {4, 4, 2});
+    specular.setStorage(1, TextureFormat::RGBA8, {4, 4, 2});
+    shader.setTextures(nullptr, &diffuse, &specular);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void PhongGLTest::compileMultiView() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::AMD::vertex_shader_layer>())
+        CORRADE_SKIP(Extensions::GL::AMD::vertex_shader_layer::string() + std::string{" is not supported."});
+
+    /* Clustered lights are ignored */
+    Shaders::Phong shader{Shaders::Phong::Flag::MultiView|Shaders::Phong::Flag::ClusteredLights};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::MultiView);
+
+    const Matrix4 viewProjectionMatrices[]{
+        Matrix4::translation(Vector3::xAxis(0.5f)),
+        Matrix4::translation(Vector3::xAxis(-0.5f))
+    };
+    shader.setViewProjectionMatrices(viewProjectionMatrices);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::compileTransformationTexture() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string{" is not supported."});
+    #endif
+
+    /* The per-instance attribute is ignored */
+    Shaders::Phong shader{Shaders::Phong::Flag::TransformationTexture|Shaders::Phong::Flag::InstancedTransformation};
+    CORRADE_VERIFY(shader.flags() == Shaders::Phong::Flag::TransformationTexture);
+
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::xAxis(0.5f)),
+        Matrix4::translation(Vector3::xAxis(-0.5f))
+    };
+    Buffer buffer;
+    buffer.setData(transformations, BufferUsage::StaticDraw);
+    BufferTexture texture;
+    texture.setBuffer(BufferTextureFormat::RGBA32F, buffer);
+    shader.setTransformationTexture(texture)
+        .setTransformationTextureOffset(1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::PhongGLTest)
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/ShaderLibrary.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ShaderLibraryGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit ShaderLibraryGLTest();
+
+    void get();
+    void variantList();
+    void preload();
+    void preloadInvalid();
+};
+
+ShaderLibraryGLTest::ShaderLibraryGLTest() {
+    addTests({&ShaderLibraryGLTest::get,
+              &ShaderLibraryGLTest::variantList,
+              &ShaderLibraryGLTest::preload,
+              &ShaderLibraryGLTest::preloadInvalid});
+}
+
+void ShaderLibraryGLTest::get() {
+    ShaderLibrary library;
+    CORRADE_VERIFY(!library.contains<Phong>(Phong::Flag::DiffuseTexture));
+
+    Phong& a = library.get<Phong>(Phong::Flag::DiffuseTexture);
+    Phong& b = library.get<Phong>(Phong::Flag::DiffuseTexture);
+    Phong& c = library.get<Phong>();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(library.contains<Phong>(Phong::Flag::DiffuseTexture));
+    CORRADE_COMPARE(&a, &b);
+    CORRADE_VERIFY(&a != &c);
+    CORRADE_COMPARE(a.flags(), Phong::Flag::DiffuseTexture);
+    CORRADE_COMPARE(library.variantCount(), 2);
+}
+
+void ShaderLibraryGLTest::variantList() {
+    ShaderLibrary library;
+    library.get<Phong>(Phong::Flag::DiffuseTexture);
+    library.get<Flat3D>();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    std::ostringstream expected;
+    expected << "Flat3D 0\n"
+             << "Phong " << UnsignedLong(UnsignedShort(Phong::Flags{Phong::Flag::DiffuseTexture})) << "\n";
+    CORRADE_COMPARE(library.variantList(), expected.str());
+}
+
+void ShaderLibraryGLTest::preload() {
+    std::string list;
+    {
+        ShaderLibrary library;
+        library.get<Phong>(Phong::Flag::DiffuseTexture);
+        library.get<Flat2D>(Flat2D::Flag::Textured);
+        list = library.variantList();
+    }
+
+    ShaderLibrary library;
+    library.get<Flat2D>(Flat2D::Flag::Textured);
+    CORRADE_COMPARE(library.preload(list), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(library.variantCount(), 2);
+    CORRADE_VERIFY(library.contains<Phong>(Phong::Flag::DiffuseTexture));
+    CORRADE_VERIFY(library.contains<Flat2D>(Flat2D::Flag::Textured));
+}
+
+void ShaderLibraryGLTest::preloadInvalid() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    ShaderLibrary library;
+    CORRADE_COMPARE(library.preload("Flat3D 0\n\nNonexistent 3\nPhong\n"), 1);
+    CORRADE_COMPARE(library.variantCount(), 1);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::ShaderLibrary::preload(): unknown shader Nonexistent\n"
+        "Shaders::ShaderLibrary::preload(): can't parse line Phong\n");
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::ShaderLibraryGLTest)
@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Shaders/ShadowCascades.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ShadowCascadesGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit ShadowCascadesGLTest();
+
+    void construct();
+    void splitUniform();
+    void splitLogarithmic();
+    void shadowMatrix();
+    void dirty();
+    void dirtyCameraMove();
+    void dirtyInvalidate();
+};
+
+ShadowCascadesGLTest::ShadowCascadesGLTest() {
+    addTests({&ShadowCascadesGLTest::construct,
+              &ShadowCascadesGLTest::splitUniform,
+              &ShadowCascadesGLTest::splitLogarithmic,
+              &ShadowCascadesGLTest::shadowMatrix,
+              &ShadowCascadesGLTest::dirty,
+              &ShadowCascadesGLTest::dirtyCameraMove,
+              &ShadowCascadesGLTest::dirtyInvalidate});
+}
+
+void ShadowCascadesGLTest::construct() {
+    ShadowCascades cascades{3, 256};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cascades.cascadeCount(), 3);
+    CORRADE_COMPARE(cascades.size(), 256);
+    CORRADE_COMPARE(cascades.cachedCascadeStart(), 1);
+    for(Int i = 0; i != 3; ++i) {
+        CORRADE_VERIFY(cascades.isDirty(i));
+        CORRADE_COMPARE(cascades.framebuffer(i).checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    }
+}
+
+void ShadowCascadesGLTest::splitUniform() {
+    ShadowCascades cascades{4, 256};
+    cascades.setSplitLambda(0.0f)
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    CORRADE_COMPARE(cascades.splitDistance(0), 25.75f);
+    CORRADE_COMPARE(cascades.splitDistance(1), 50.5f);
+    CORRADE_COMPARE(cascades.splitDistance(2), 75.25f);
+    CORRADE_COMPARE(cascades.splitDistance(3), 100.0f);
+}
+
+void ShadowCascadesGLTest::splitLogarithmic() {
+    ShadowCascades cascades{4, 256};
+    cascades.setSplitLambda(1.0f)
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    CORRADE_COMPARE(cascades.splitDistance(0), 3.162278f);
+    CORRADE_COMPARE(cascades.splitDistance(1), 10.0f);
+    CORRADE_COMPARE(cascades.splitDistance(2), 31.62278f);
+    CORRADE_COMPARE(cascades.splitDistance(3), 100.0f);
+}
+
+void ShadowCascadesGLTest::shadowMatrix() {
+    ShadowCascades cascades{2, 256};
+    cascades.setLightDirection({-1.0f, -2.0f, 0.5f})
+        .update(Matrix4::translation({3.0f, 1.0f, 2.0f}).invertedRigid(), Deg(60.0f), 1.5f, 0.1f, 50.0f);
+
+    /* A point in the first cascade lands inside its shadow map */
+    const Vector3 point = cascades.shadowMatrix(0).transformPoint({0.5f, -0.3f, -2.0f});
+    CORRADE_VERIFY((point >= Vector3{0.0f}).all());
+    CORRADE_VERIFY((point <= Vector3{1.0f}).all());
+}
+
+void ShadowCascadesGLTest::dirty() {
+    ShadowCascades cascades{3, 256};
+    cascades.update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(0));
+    CORRADE_VERIFY(cascades.isDirty(1));
+    CORRADE_VERIFY(cascades.isDirty(2));
+
+    /* Nothing changed, only the first cascade is rendered again */
+    cascades.update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(0));
+    CORRADE_VERIFY(!cascades.isDirty(1));
+    CORRADE_VERIFY(!cascades.isDirty(2));
+
+    /* Changing the light direction changes all projections */
+    cascades.setLightDirection({1.0f, -1.0f, 0.0f})
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(1));
+    CORRADE_VERIFY(cascades.isDirty(2));
+
+    /* Disabling caching */
+    cascades.setCachedCascadeStart(3)
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(1));
+    CORRADE_VERIFY(cascades.isDirty(2));
+}
+
+void ShadowCascadesGLTest::dirtyCameraMove() {
+    ShadowCascades cascades{3, 256};
+    cascades.update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    /* Small movement and rotation stays within the margin */
+    cascades.update((Matrix4::translation({0.01f, 0.0f, -0.01f})*Matrix4::rotationY(Deg(10.0f))).invertedRigid(), Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(!cascades.isDirty(1));
+    CORRADE_VERIFY(!cascades.isDirty(2));
+
+    /* Large movement doesn't */
+    cascades.update(Matrix4::translation({500.0f, 0.0f, 0.0f}).invertedRigid(), Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(1));
+    CORRADE_VERIFY(cascades.isDirty(2));
+}
+
+void ShadowCascadesGLTest::dirtyInvalidate() {
+    ShadowCascades cascades{4, 256};
+    cascades.setSplitLambda(0.0f)
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    /* Too far away to affect any cascade */
+    cascades.invalidate({{-1.0f, -1.0f, -305.0f}, {1.0f, 1.0f, -300.0f}})
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(!cascades.isDirty(1));
+    CORRADE_VERIFY(!cascades.isDirty(2));
+    CORRADE_VERIFY(!cascades.isDirty(3));
+
+    /* Only in the last cascade */
+    cascades.invalidate({{-1.0f, -1.0f, -230.0f}, {1.0f, 1.0f, -225.0f}})
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(!cascades.isDirty(1));
+    CORRADE_VERIFY(!cascades.isDirty(2));
+    CORRADE_VERIFY(cascades.isDirty(3));
+
+    /* The invalidation is consumed by the update */
+    cascades.update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(!cascades.isDirty(3));
+
+    cascades.invalidateAll()
+        .update({}, Deg(90.0f), 1.0f, 1.0f, 100.0f);
+    CORRADE_VERIFY(cascades.isDirty(1));
+    CORRADE_VERIFY(cascades.isDirty(2));
+    CORRADE_VERIFY(cascades.isDirty(3));
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::ShadowCascadesGLTest)
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/TransformFeedback.h"
+#include "Magnum/Shaders/Skinning.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct SkinningGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit SkinningGLTest();
+
+    void compile();
+    void skin();
+};
+
+SkinningGLTest::SkinningGLTest() {
+    addTests({&SkinningGLTest::compile,
+              &SkinningGLTest::skin});
+}
+
+void SkinningGLTest::compile() {
+    Shaders::Skinning shader{16};
+    CORRADE_COMPARE(shader.jointCount(), 16);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+namespace {
+    struct InputVertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector4ui jointIds;
+        Vector4 weights;
+    };
+
+    const InputVertex InputData[]{
+        /* Only the first joint */
+        {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0, 0, 0, 0}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        /* Only the second joint */
+        {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1, 0, 0, 0}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        /* Half of each */
+        {{0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}, {0, 1, 0, 0}, {0.5f, 0.5f, 0.0f, 0.0f}}
+    };
+}
+
+void SkinningGLTest::skin() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::transform_feedback2>())
+        CORRADE_SKIP(Extensions::GL::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{32});
+    Framebuffer fb{{{}, Vector2i{32}}};
+    fb.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+      .bind();
+
+    Buffer input;
+    input.setData(InputData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .setCount(3)
+        .addVertexBuffer(input, 0,
+            Skinning::Position{},
+            Skinning::Normal{},
+            Skinning::JointIds{},
+            Skinning::Weights{});
+
+    /* Put the output at an offset to verify it's respected */
+    Buffer output;
+    output.setData({nullptr, 256 + 3*sizeof(Skinning::Vertex)}, BufferUsage::StaticRead);
+
+    const Matrix4 joints[]{
+        Matrix4::translation({0.0f, 2.0f, 0.0f}),
+        Matrix4::rotationZ(Deg(90.0f))
+    };
+
+    Skinning shader{2};
+    TransformFeedback feedback;
+    shader.setJointMatrices(joints)
+        .skin(mesh, feedback, output, 256);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Skinning::Vertex* data = output.map<Skinning::Vertex>(256, 3*sizeof(Skinning::Vertex), Buffer::MapFlag::Read);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data[0].position, (Vector3{1.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(data[0].normal, (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(data[1].position, (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(data[1].normal, (Vector3{-1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(data[2].position, (Vector3{0.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(data[2].normal, (Vector3{0.5f, 0.5f, 0.0f}.normalized()));
+    output.unmap();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Shaders::Test::SkinningGLTest)
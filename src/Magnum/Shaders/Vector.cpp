@@ -32,6 +32,7 @@
 #include "Magnum/Shader.h"
 
 #include "Implementation/CreateCompatibilityShader.h"
+#include "Implementation/PrecompiledSpirv.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -41,7 +42,18 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "AbstractVector3D.vert"; }
 }
 
-template<UnsignedInt dimensions> Vector<dimensions>::Vector(): transformationProjectionMatrixUniform(0), backgroundColorUniform(1), colorUniform(2) {
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): transformationProjectionMatrixUniform(0), backgroundColorUniform(1), colorUniform(2), _flags(flags) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::InstancedGlyphs) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::instanced_arrays);
+        #else
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+        #endif
+    }
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -51,6 +63,11 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(): transformationPro
 
     #ifndef MAGNUM_TARGET_GLES
     const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    /* Buffer textures need ESSL 3.10 */
+    const Version version = flags & Flag::InstancedGlyphs ?
+        Context::current().supportedVersion({Version::GLES310, Version::GLES300}) :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -58,26 +75,47 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(): transformationPro
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    vert.addSource(rs.get("generic.glsl"))
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::InstancedGlyphs)
+        vert.addSource("#extension GL_EXT_texture_buffer: require\n");
+    #endif
+
+    vert
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
     frag.addSource(rs.get("Vector.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
-
-    AbstractShaderProgram::attachShaders({vert,  frag});
-
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
-    #endif
-    {
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+    if(!AbstractShaderProgram::loadCachedBinary({vert, frag})) {
+        Implementation::usePrecompiledSpirv({vert, frag});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        AbstractShaderProgram::attachShaders({vert,  frag});
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(flags & Flag::InstancedGlyphs) {
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphPosition::Location, "glyphPosition");
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphRectangleId::Location, "glyphRectangleId");
+            } else
+            #endif
+            {
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+                AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+            }
+        }
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
+        AbstractShaderProgram::saveCachedBinary({vert, frag});
     }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
-
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
@@ -92,6 +130,10 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(): transformationPro
     #endif
     {
         AbstractShaderProgram::setUniform(AbstractShaderProgram::uniformLocation("vectorTexture"), AbstractVector<dimensions>::VectorTextureLayer);
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::InstancedGlyphs)
+            AbstractShaderProgram::setUniform(AbstractShaderProgram::uniformLocation("glyphRectangles"), AbstractVector<dimensions>::GlyphRectangleTextureLayer);
+        #endif
     }
 }
 
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::Vector, typedef @ref Magnum::Shaders::Vector2D, @ref Magnum::Shaders::Vector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -38,6 +40,15 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VectorFlag: UnsignedByte {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        InstancedGlyphs = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<VectorFlag> VectorFlags;
+}
+
 /**
 @brief Vector shader
 
@@ -83,11 +94,69 @@ shader.setColor(Color3::fromHSV(216.0_degf, 0.85f, 1.0f))
 mesh.draw(shader);
 @endcode
 
+@anchor Shaders-Vector-instanced-glyphs
+## Instanced glyphs
+
+With @ref Flag::InstancedGlyphs the shader doesn't use the @ref Position and
+@ref TextureCoordinates attributes. Instead, the mesh is drawn as an
+instanced four-vertex triangle strip with one @ref GlyphPosition and
+@ref GlyphRectangleId per instance, the quad is expanded in the vertex shader
+from a table of glyph rectangles set via @ref setGlyphRectangleTexture().
+@ref Text::InstancedRenderer prepares both the instance data and the table:
+@code
+Text::InstancedRenderer renderer{*font, cache, 0.15f};
+renderer.reserve(4096, BufferUsage::DynamicDraw);
+renderer.render(logText);
+
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::InstancedGlyphs};
+shader.setGlyphRectangleTexture(renderer.glyphRectangleTexture())
+    .setVectorTexture(cache.texture())
+    .setTransformationProjectionMatrix(projection);
+renderer.mesh().draw(shader);
+@endcode
+
 @see @ref shaders, @ref Vector2D, @ref Vector3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public AbstractVector<dimensions> {
     public:
-        Vector();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Expand glyph quads from per-instance data. See
+             * @ref Shaders-Vector-instanced-glyphs "Instanced glyphs" for more
+             * information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+             *      @extension{ARB,texture_buffer_object}
+             * @requires_gles31 Extension @es_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            InstancedGlyphs = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::VectorFlag Flag;
+        typedef Implementation::VectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit Vector(Flags flags = Flags());
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
 
         /**
          * @brief Set transformation and projection matrix
@@ -127,12 +196,20 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
             AbstractVector<dimensions>::setVectorTexture(texture);
             return *this;
         }
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Vector<dimensions>& setGlyphRectangleTexture(BufferTexture& texture) {
+            AbstractVector<dimensions>::setGlyphRectangleTexture(texture);
+            return *this;
+        }
+        #endif
         #endif
 
     private:
         Int transformationProjectionMatrixUniform,
             backgroundColorUniform,
             colorUniform;
+
+        Flags _flags;
 };
 
 /** @brief Two-dimensional vector shader */
@@ -141,6 +218,8 @@ typedef Vector<2> Vector2D;
 /** @brief Three-dimensional vector shader */
 typedef Vector<3> Vector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::VectorFlags)
+
 }}
 
 #endif
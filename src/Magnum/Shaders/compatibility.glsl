@@ -43,6 +43,10 @@
     #define EXPLICIT_UNIFORM_LOCATION
 #endif
 
+#if !defined(GL_ES) && __VERSION__ < 140 && defined(GL_ARB_uniform_buffer_object)
+    #extension GL_ARB_uniform_buffer_object: enable
+#endif
+
 #if defined(GL_ES) && __VERSION__ >= 300
     #define EXPLICIT_ATTRIB_LOCATION
     /* EXPLICIT_TEXTURE_LAYER, EXPLICIT_UNIFORM_LOCATION and RUNTIME_CONST is not
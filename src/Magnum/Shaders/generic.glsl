@@ -26,3 +26,11 @@
 #define POSITION_ATTRIBUTE_LOCATION 0
 #define TEXTURECOORDINATES_ATTRIBUTE_LOCATION 1
 #define NORMAL_ATTRIBUTE_LOCATION 2
+#define COLOR_ATTRIBUTE_LOCATION 3
+#define TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION 4
+#define GLYPH_POSITION_ATTRIBUTE_LOCATION 4
+#define GLYPH_RECTANGLE_ID_ATTRIBUTE_LOCATION 5
+#define TEXTURE_ARRAY_LAYER_ATTRIBUTE_LOCATION 10
+
+#define COLOR_OUTPUT_ATTRIBUTE_LOCATION 0
+#define OBJECT_ID_OUTPUT_ATTRIBUTE_LOCATION 1
@@ -27,13 +27,14 @@
 
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Math/Range.h"
 #include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/ShapeGroup.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group) {
+template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group), _boundsDirty(true), _queuedIn(nullptr) {
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
 }
 
@@ -57,8 +58,21 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
     return Implementation::collision(abstractTransformedShape(), other.abstractTransformedShape());
 }
 
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> AbstractShape<dimensions>::bounds() const {
+    return Implementation::bounds(abstractTransformedShape());
+}
+
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
-    if(group()) group()->setDirty();
+    _boundsDirty = true;
+
+    ShapeGroup<dimensions>* const group = this->group();
+    if(!group) return;
+
+    group->setDirty();
+    if(_queuedIn != group) {
+        group->_dirtyShapes.push_back(this);
+        _queuedIn = group;
+    }
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -57,6 +57,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
     /* Otherwise it complains that this is not a function */
     template<UnsignedInt dimensions_> friend const Implementation::AbstractShape<dimensions_>& Implementation::getAbstractShape(const Shapes::AbstractShape<dimensions_>&);
     #endif
+    friend ShapeGroup<dimensions>;
 
     public:
         enum: UnsignedInt {
@@ -112,12 +113,28 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         Collision<dimensions> collision(const AbstractShape<dimensions>& other) const;
 
+        /**
+         * @brief Bounds of transformed shape
+         *
+         * Conservative axis-aligned bounding box of the shape with absolute
+         * transformation applied, used by @ref ShapeGroup broadphase. Shapes
+         * which are not bounded (e.g. @ref Line, @ref Plane, @ref Cylinder or
+         * @ref InvertedSphere) have infinite bounds.
+         */
+        RangeTypeFor<dimensions, Float> bounds() const;
+
     protected:
         /** Marks also the group as dirty */
         void markDirty() override;
 
     private:
         virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractTransformedShape() const = 0;
+
+        bool _boundsDirty;
+
+        /* Group in which this shape is queued for cleaning, to avoid
+           queuing it more than once */
+        ShapeGroup<dimensions>* _queuedIn;
 };
 
 /** @brief Base class for two-dimensional object shapes */
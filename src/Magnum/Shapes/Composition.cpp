@@ -28,10 +28,18 @@
 #include <algorithm>
 #include <Corrade/Utility/Assert.h>
 
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
 
+namespace {
+    template<UnsignedInt dimensions> inline bool overlaps(const Math::Range<dimensions, Float>& a, const Math::Range<dimensions, Float>& b) {
+        return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+    }
+}
+
 /*
 Hierarchy implementation notes:
 
@@ -58,16 +66,40 @@ Shapes are merged together by concatenating its node and shape list and adding
 new node at the beginning with properly set `rightNode` and `rightShape`.
 Because these values are relative to parent, they don't need to be modified
 when concatenating.
+
+For collision detection the tree is compiled into a flat program in
+`_program`, with one instruction for each leaf shape test. Each instruction
+has two jump targets, `Instruction::onTrue` and `Instruction::onFalse`, either
+pointing to another instruction or being one of `ResultFalse` / `ResultTrue`,
+which ends the evaluation. `_entry` is index of the first instruction (or
+directly the result for empty compositions). Given the targets of the whole
+subtree, the subtree is compiled like this:
+
+ *  leaf shape -- single instruction jumping to the targets
+ *  NOT -- child with the targets swapped
+ *  AND -- right child with the targets, left child with `onTrue` pointing
+    to the first instruction of right child
+ *  OR -- right child with the targets, left child with `onFalse` pointing to
+    the first instruction of right child
+
+The right child needs to be compiled before the left child, so the
+instructions are emitted in reverse and the order is flipped at the end. The
+program depends only on the tree structure and thus doesn't change on
+transformation, only bounds of the leaf shapes in `Instruction::bounds` and
+bounds of the whole composition in `_bounds` are recalculated.
 */
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()) {
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()), _program(other._program.size()), _entry(other._entry), _bounds(other._bounds) {
     copyShapes(0, other);
     copyNodes(0, other);
+    std::copy(other._program.begin(), other._program.end(), _program.begin());
 }
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)) {
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)), _program(std::move(other._program)), _entry(other._entry), _bounds(other._bounds) {
     other._shapes = nullptr;
     other._nodes = nullptr;
+    other._program = nullptr;
+    other._entry = ResultFalse;
 }
 
 template<UnsignedInt dimensions> Composition<dimensions>::~Composition() {
@@ -85,8 +117,14 @@ template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions
     if(_nodes.size() != other._nodes.size())
         _nodes = Containers::Array<Node>(other._nodes.size());
 
+    if(_program.size() != other._program.size())
+        _program = Containers::Array<Instruction>(other._program.size());
+
     copyShapes(0, other);
     copyNodes(0, other);
+    std::copy(other._program.begin(), other._program.end(), _program.begin());
+    _entry = other._entry;
+    _bounds = other._bounds;
     return *this;
 }
 
@@ -94,6 +132,9 @@ template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions
     using std::swap;
     swap(other._shapes, _shapes);
     swap(other._nodes, _nodes);
+    swap(other._program, _program);
+    swap(other._entry, _entry);
+    swap(other._bounds, _bounds);
     return *this;
 }
 
@@ -118,34 +159,136 @@ template<UnsignedInt dimensions> Composition<dimensions> Composition<dimensions>
     Composition<dimensions> out(*this);
     for(Implementation::AbstractShape<dimensions> * const* i = _shapes.begin(), * const* o = out._shapes.begin(); i != _shapes.end(); ++i, ++o)
         (*i)->transform(matrix, *o);
+    out.updateBounds();
     return out;
 }
 
-template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
+template<UnsignedInt dimensions> void Composition<dimensions>::compile() {
+    std::vector<Instruction> program;
+    program.reserve(_shapes.size());
+    const Int entry = _nodes.empty() ? Int(ResultFalse) :
+        compile(program, 0, 0, _shapes.size(), ResultTrue, ResultFalse);
+
+    /* Flip the order so the first evaluated instruction is first in the
+       array, remap the jump targets accordingly */
+    const Int last = Int(program.size()) - 1;
+    _program = Containers::Array<Instruction>(program.size());
+    for(std::size_t i = 0; i != program.size(); ++i) {
+        Instruction& instruction = _program[last - i];
+        instruction = program[i];
+        if(instruction.onTrue >= 0) instruction.onTrue = last - instruction.onTrue;
+        if(instruction.onFalse >= 0) instruction.onFalse = last - instruction.onFalse;
+    }
+    _entry = entry >= 0 ? last - entry : entry;
+
+    updateBounds();
+}
+
+template<UnsignedInt dimensions> Int Composition<dimensions>::compile(std::vector<Instruction>& program, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd, const Int onTrue, const Int onFalse) const {
     /* Empty group */
-    if(shapeBegin == shapeEnd) return false;
+    if(shapeBegin == shapeEnd) return onFalse;
 
     CORRADE_INTERNAL_ASSERT(node < _nodes.size() && shapeBegin < shapeEnd);
 
-    /* Collision on the left child. If the node is leaf one (no left child
-       exists), do it directly, recurse instead. */
-    const bool collidesLeft = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin]) :
-        collides(a, node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+    /* Children are traversed the same way as in bounds() */
+    const Node& n = _nodes[node];
+    auto left = [&](const Int whenTrue, const Int whenFalse) -> Int {
+        if(n.rightNode == 0 || n.rightNode == 2) {
+            program.push_back({{}, UnsignedInt(shapeBegin), whenTrue, whenFalse});
+            return program.size() - 1;
+        }
+        return compile(program, node+1, shapeBegin, shapeBegin+n.rightShape, whenTrue, whenFalse);
+    };
+    auto right = [&](const Int whenTrue, const Int whenFalse) -> Int {
+        if(n.rightNode < 2) {
+            program.push_back({{}, UnsignedInt(shapeBegin+n.rightShape), whenTrue, whenFalse});
+            return program.size() - 1;
+        }
+        return compile(program, node+n.rightNode-1, shapeBegin+n.rightShape, shapeEnd, whenTrue, whenFalse);
+    };
 
     /* NOT operation */
+    if(n.operation == CompositionOperation::Not)
+        return left(onFalse, onTrue);
+
+    /* Short-circuit evaluation for AND/OR -- the right child is evaluated
+       only if the left child doesn't decide the result already */
+    const Int rightEntry = right(onTrue, onFalse);
+    return n.operation == CompositionOperation::Or ?
+        left(onTrue, rightEntry) : left(rightEntry, onFalse);
+}
+
+template<UnsignedInt dimensions> void Composition<dimensions>::updateBounds() {
+    for(Instruction& instruction: _program)
+        instruction.bounds = Implementation::bounds(*_shapes[instruction.shape]);
+
+    /* Empty composition collides with nothing, zero-sized range at origin is
+       as good as any other */
+    _bounds = _shapes.empty() ? RangeTypeFor<dimensions, Float>{} : bounds(0, 0, _shapes.size());
+}
+
+template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a) const {
+    if(_entry < 0) return _entry == ResultTrue;
+
+    /* Early rejection using bounds of the whole composition. These are
+       infinite for complements, so this never rejects anything NOT could
+       make colliding. */
+    const RangeTypeFor<dimensions, Float> bounds = Implementation::bounds(a);
+    if(!overlaps(bounds, _bounds)) return false;
+
+    /* Leaf shapes with bounds not overlapping the other shape can't collide,
+       so the actual collision detection is done only for the rest */
+    Int i = _entry;
+    do {
+        const Instruction& instruction = _program[i];
+        const bool hit = overlaps(bounds, instruction.bounds) &&
+            Implementation::collides(a, *_shapes[instruction.shape]);
+        i = hit ? instruction.onTrue : instruction.onFalse;
+    } while(i >= 0);
+
+    return i == ResultTrue;
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> Composition<dimensions>::bounds(const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
+    /* Empty group, stay conservative */
+    if(shapeBegin == shapeEnd)
+        return {VectorTypeFor<dimensions, Float>(-Constants::inf()),
+                VectorTypeFor<dimensions, Float>(Constants::inf())};
+
+    /* Complement of a bounded shape is not bounded */
     if(_nodes[node].operation == CompositionOperation::Not)
-        return !collidesLeft;
+        return {VectorTypeFor<dimensions, Float>(-Constants::inf()),
+                VectorTypeFor<dimensions, Float>(Constants::inf())};
+
+    /* Bounds of child nodes, traversed the same way as in collides() */
+    const RangeTypeFor<dimensions, Float> left = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
+        Implementation::bounds(*_shapes[shapeBegin]) :
+        bounds(node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+    const RangeTypeFor<dimensions, Float> right = (_nodes[node].rightNode < 2) ?
+        Implementation::bounds(*_shapes[shapeBegin+_nodes[node].rightShape]) :
+        bounds(node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
+
+    /* AND is bounded by intersection, OR by union of the children */
+    if(_nodes[node].operation == CompositionOperation::And)
+        return {Math::max(left.min(), right.min()), Math::min(left.max(), right.max())};
+    return {Math::min(left.min(), right.min()), Math::max(left.max(), right.max())};
+}
+
+namespace Implementation {
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> compositionBounds(const Composition<dimensions>& composition) {
+    return composition._bounds;
+}
+
+template<UnsignedInt dimensions> bool compositionCollides(const Composition<dimensions>& composition, const AbstractShape<dimensions>& shape) {
+    return composition.collides(shape);
+}
 
-    /* Short-circuit evaluation for AND/OR */
-    if((_nodes[node].operation == CompositionOperation::Or) == collidesLeft)
-        return collidesLeft;
+template MAGNUM_SHAPES_EXPORT Range2D compositionBounds(const Composition<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D compositionBounds(const Composition<3>&);
+template MAGNUM_SHAPES_EXPORT bool compositionCollides(const Composition<2>&, const AbstractShape<2>&);
+template MAGNUM_SHAPES_EXPORT bool compositionCollides(const Composition<3>&, const AbstractShape<3>&);
 
-    /* Now the collision result depends only on the right child. Similar to
-       collision on the left child. */
-    return (_nodes[node].rightNode < 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin+_nodes[node].rightShape]) :
-        collides(a, node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
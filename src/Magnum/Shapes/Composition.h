@@ -31,10 +31,12 @@
 
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/shapeImplementation.h"
 #include "Magnum/Shapes/visibility.h"
@@ -50,6 +52,9 @@ namespace Implementation {
     template<UnsignedInt dimensions> inline const AbstractShape<dimensions>& getAbstractShape(const Composition<dimensions>& group, std::size_t i) {
         return *group._shapes[i];
     }
+
+    template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> compositionBounds(const Composition<dimensions>& composition);
+    template<UnsignedInt dimensions> bool compositionCollides(const Composition<dimensions>& composition, const AbstractShape<dimensions>& shape);
 }
 
 /** @brief Shape operation */
@@ -63,10 +68,27 @@ enum class CompositionOperation: UnsignedByte {
 @brief Composition of shapes
 
 Result of logical operations on shapes. See @ref shapes for brief introduction.
+
+@section Composition-evaluation Evaluation
+
+The operation tree is compiled on construction into a linear list of leaf
+shape tests, each of them continuing to the next test or finishing with a
+result depending on whether the leaf shape collided. The short-circuit
+evaluation of @ref operator&&() and @ref operator||() and the negation of
+@ref operator!() are thus encoded in the jump targets and the collision is
+evaluated without any recursion. Bounds of the whole composition and of each
+leaf shape are computed along with the program and refreshed when the
+composition is transformed, so leaf shapes whose bounds don't overlap bounds
+of the other shape are treated as not colliding without doing the actual
+collision test. Compositions attached to objects through @ref Shape are
+transformed in @ref ShapeGroup::setClean(), so the group always tests against
+up-to-date program.
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
     friend Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(Composition<dimensions>&, std::size_t);
     friend const Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(const Composition<dimensions>&, std::size_t);
+    friend RangeTypeFor<dimensions, Float> Implementation::compositionBounds<>(const Composition<dimensions>&);
+    friend bool Implementation::compositionCollides<>(const Composition<dimensions>&, const Implementation::AbstractShape<dimensions>&);
     friend Implementation::ShapeHelper<Composition<dimensions>>;
 
     public:
@@ -97,7 +119,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
          *
          * Creates empty composition.
          */
-        explicit Composition() {}
+        explicit Composition(): _entry(ResultFalse) {}
 
         /**
          * @brief Unary operation constructor
@@ -155,11 +177,26 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
             CompositionOperation operation;
         };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a) const {
-            return collides(a, 0, 0, _shapes.size());
-        }
+        /* Leaf shape test, continuing to given instruction or ending with
+           one of the Result* values */
+        struct Instruction {
+            RangeTypeFor<dimensions, Float> bounds;
+            UnsignedInt shape;
+            Int onTrue, onFalse;
+        };
+
+        enum: Int {
+            ResultFalse = -1,
+            ResultTrue = -2
+        };
+
+        bool collides(const Implementation::AbstractShape<dimensions>& a) const;
+
+        void compile();
+        Int compile(std::vector<Instruction>& program, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd, Int onTrue, Int onFalse) const;
+        void updateBounds();
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
+        RangeTypeFor<dimensions, Float> bounds(std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
 
         template<class T> constexpr static std::size_t shapeCount(const T&) {
             return 1;
@@ -185,6 +222,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
 
         Containers::Array<Implementation::AbstractShape<dimensions>*> _shapes;
         Containers::Array<Node> _nodes;
+        Containers::Array<Instruction> _program;
+        Int _entry;
+        RangeTypeFor<dimensions, Float> _bounds;
 };
 
 /** @brief Two-dimensional shape composition */
@@ -256,7 +296,7 @@ template<class T, class U> inline auto operator||(T&& a, U&& b) -> enableIfAreSh
 #undef enableIfAreShapeType
 #endif
 
-template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Composition(CompositionOperation operation, T&& a): _shapes(shapeCount(a)), _nodes(nodeCount(a)+1) {
+template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Composition(CompositionOperation operation, T&& a): _shapes(shapeCount(a)), _nodes(nodeCount(a)+1), _entry(ResultFalse) {
     CORRADE_ASSERT(operation == CompositionOperation::Not,
         "Shapes::Composition::Composition(): unary operation expected", );
     _nodes[0].operation = operation;
@@ -266,9 +306,10 @@ template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Comp
     _nodes[0].rightShape = shapeCount(a);
     copyNodes(1, a);
     copyShapes(0, std::forward<T>(a));
+    compile();
 }
 
-template<UnsignedInt dimensions> template<class T, class U> Composition<dimensions>::Composition(CompositionOperation operation, T&& a, U&& b): _shapes(shapeCount(a) + shapeCount(b)), _nodes(nodeCount(a) + nodeCount(b) + 1) {
+template<UnsignedInt dimensions> template<class T, class U> Composition<dimensions>::Composition(CompositionOperation operation, T&& a, U&& b): _shapes(shapeCount(a) + shapeCount(b)), _nodes(nodeCount(a) + nodeCount(b) + 1), _entry(ResultFalse) {
     CORRADE_ASSERT(operation != CompositionOperation::Not,
         "Shapes::Composition::Composition(): binary operation expected", );
     _nodes[0].operation = operation;
@@ -285,6 +326,7 @@ template<UnsignedInt dimensions> template<class T, class U> Composition<dimensio
     copyNodes(nodeCount(a) + 1, b);
     copyShapes(shapeCount(a), std::forward<U>(b));
     copyShapes(0, std::forward<T>(a));
+    compile();
 }
 
 template<UnsignedInt dimensions> template<class T> inline const T& Composition<dimensions>::get(std::size_t i) const {
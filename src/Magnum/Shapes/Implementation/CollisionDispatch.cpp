@@ -25,9 +25,15 @@
 
 #include "CollisionDispatch.h"
 
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Geometry/Intersection.h"
 #include "Magnum/Shapes/AxisAlignedBox.h"
 #include "Magnum/Shapes/Box.h"
 #include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
 #include "Magnum/Shapes/Cylinder.h"
 #include "Magnum/Shapes/LineSegment.h"
 #include "Magnum/Shapes/Plane.h"
@@ -40,6 +46,12 @@ namespace Magnum { namespace Shapes { namespace Implementation {
 template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
     if(a.type() < b.type()) return collides(b, a);
 
+    /* Composition has the largest type ID, so it's always on the left side.
+       It evaluates its compiled program, dispatching each leaf shape back
+       here. */
+    if(a.type() == ShapeDimensionTraits<2>::Type::Composition)
+        return compositionCollides(static_cast<const Shape<Composition2D>&>(a).shape, b);
+
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<2>::Type::aType)*UnsignedInt(ShapeDimensionTraits<2>::Type::bType): \
@@ -83,6 +95,10 @@ template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape
 template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
     if(a.type() < b.type()) return collides(b, a);
 
+    /* Composition, see above */
+    if(a.type() == ShapeDimensionTraits<3>::Type::Composition)
+        return compositionCollides(static_cast<const Shape<Composition3D>&>(a).shape, b);
+
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<3>::Type::aType)*UnsignedInt(ShapeDimensionTraits<3>::Type::bType): \
@@ -126,4 +142,317 @@ template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape
     return {};
 }
 
+namespace {
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsImplementation(const AbstractShape<dimensions>& shape) {
+    typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+
+    switch(shape.type()) {
+        case Type::Point: {
+            const VectorTypeFor<dimensions, Float> position = static_cast<const Shape<Shapes::Point<dimensions>>&>(shape).shape.position();
+            return {position, position};
+        }
+
+        case Type::LineSegment: {
+            const Shapes::LineSegment<dimensions>& segment = static_cast<const Shape<Shapes::LineSegment<dimensions>>&>(shape).shape;
+            return {Math::min(segment.a(), segment.b()), Math::max(segment.a(), segment.b())};
+        }
+
+        case Type::Sphere: {
+            const Shapes::Sphere<dimensions>& sphere = static_cast<const Shape<Shapes::Sphere<dimensions>>&>(shape).shape;
+            return {sphere.position() - VectorTypeFor<dimensions, Float>(sphere.radius()),
+                    sphere.position() + VectorTypeFor<dimensions, Float>(sphere.radius())};
+        }
+
+        case Type::Capsule: {
+            const Shapes::Capsule<dimensions>& capsule = static_cast<const Shape<Shapes::Capsule<dimensions>>&>(shape).shape;
+            return {Math::min(capsule.a(), capsule.b()) - VectorTypeFor<dimensions, Float>(capsule.radius()),
+                    Math::max(capsule.a(), capsule.b()) + VectorTypeFor<dimensions, Float>(capsule.radius())};
+        }
+
+        case Type::AxisAlignedBox: {
+            const Shapes::AxisAlignedBox<dimensions>& box = static_cast<const Shape<Shapes::AxisAlignedBox<dimensions>>&>(shape).shape;
+            return {Math::min(box.min(), box.max()), Math::max(box.min(), box.max())};
+        }
+
+        /* The box is unit cube transformed with given matrix, half-extent in
+           each direction is sum of absolute values of the projected axes */
+        case Type::Box: {
+            const MatrixTypeFor<dimensions, Float> transformation = static_cast<const Shape<Shapes::Box<dimensions>>&>(shape).shape.transformation();
+            VectorTypeFor<dimensions, Float> halfExtent;
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                halfExtent += Math::abs(VectorTypeFor<dimensions, Float>::pad(transformation[i]));
+            return {transformation.translation() - halfExtent,
+                    transformation.translation() + halfExtent};
+        }
+
+        case Type::Composition:
+            return compositionBounds(static_cast<const Shape<Shapes::Composition<dimensions>>&>(shape).shape);
+
+        /* Line, inverted sphere, cylinder and plane are not bounded */
+        default: break;
+    }
+
+    return {VectorTypeFor<dimensions, Float>(-Constants::inf()),
+            VectorTypeFor<dimensions, Float>(Constants::inf())};
+}
+
+/* Ray parameter of the nearer solution of |w + t*d|^2 = r^2, with a = d.d,
+   b = w.d and c = w.w - r^2. Zero if w is inside the sphere, infinity if
+   there's no intersection in front of the origin. */
+inline Float rayQuadratic(const Float a, const Float b, const Float c) {
+    if(c <= 0.0f) return 0.0f;
+
+    const Float discriminant = b*b - a*c;
+    if(a == 0.0f || discriminant < 0.0f) return Constants::inf();
+
+    const Float t = (-b - std::sqrt(discriminant))/a;
+    return t >= 0.0f ? t : Constants::inf();
+}
+
+template<UnsignedInt dimensions> Float raySphere(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& position, const Float radius) {
+    const VectorTypeFor<dimensions, Float> w = origin - position;
+    return rayQuadratic(direction.dot(), Math::dot(w, direction), w.dot() - Math::pow<2>(radius));
+}
+
+/* Infinite cylinder, the same as sphere with axis direction projected out */
+template<UnsignedInt dimensions> Float rayCylinder(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Float radius) {
+    const VectorTypeFor<dimensions, Float> axis = b - a;
+    const Float axisDot = axis.dot();
+    const VectorTypeFor<dimensions, Float> w = origin - a;
+    const VectorTypeFor<dimensions, Float> wPerpendicular = w - axis*(Math::dot(w, axis)/axisDot);
+    const VectorTypeFor<dimensions, Float> directionPerpendicular = direction - axis*(Math::dot(direction, axis)/axisDot);
+    return rayQuadratic(directionPerpendicular.dot(), Math::dot(wPerpendicular, directionPerpendicular), wPerpendicular.dot() - Math::pow<2>(radius));
+}
+
+/* The capsule is union of the cylinder part between the endpoints and two
+   spheres, the cylinder hit counts only if it is between the endpoints */
+template<UnsignedInt dimensions> Float rayCapsule(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Shapes::Capsule<dimensions>& capsule) {
+    Float t = Constants::inf();
+
+    const Float cylinder = rayCylinder<dimensions>(origin, direction, capsule.a(), capsule.b(), capsule.radius());
+    if(cylinder != Constants::inf()) {
+        const VectorTypeFor<dimensions, Float> axis = capsule.b() - capsule.a();
+        const Float s = Math::dot(origin + direction*cylinder - capsule.a(), axis)/axis.dot();
+        if(s >= 0.0f && s <= 1.0f) t = cylinder;
+    }
+
+    return Math::min(t, Math::min(
+        raySphere<dimensions>(origin, direction, capsule.a(), capsule.radius()),
+        raySphere<dimensions>(origin, direction, capsule.b(), capsule.radius())));
+}
+
+/* Exit point of the sphere if the origin is inside */
+template<UnsignedInt dimensions> Float rayInvertedSphere(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Shapes::InvertedSphere<dimensions>& sphere) {
+    const VectorTypeFor<dimensions, Float> w = origin - sphere.position();
+    const Float a = direction.dot();
+    const Float b = Math::dot(w, direction);
+    const Float c = w.dot() - Math::pow<2>(sphere.radius());
+    if(c >= 0.0f) return 0.0f;
+    if(a == 0.0f) return Constants::inf();
+
+    return (-b + std::sqrt(b*b - a*c))/a;
+}
+
+/* Slab test */
+template<UnsignedInt dimensions> Float rayRange(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max) {
+    Float near = 0.0f;
+    Float far = Constants::inf();
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        if(direction[i] == 0.0f) {
+            if(origin[i] < min[i] || origin[i] > max[i]) return Constants::inf();
+            continue;
+        }
+
+        Float t1 = (min[i] - origin[i])/direction[i];
+        Float t2 = (max[i] - origin[i])/direction[i];
+        if(t1 > t2) std::swap(t1, t2);
+        near = Math::max(near, t1);
+        far = Math::min(far, t2);
+        if(near > far) return Constants::inf();
+    }
+
+    return near;
+}
+
+template<UnsignedInt dimensions> Float raycastImplementation(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction) {
+    typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+
+    switch(shape.type()) {
+        case Type::Sphere: {
+            const Shapes::Sphere<dimensions>& sphere = static_cast<const Shape<Shapes::Sphere<dimensions>>&>(shape).shape;
+            return raySphere<dimensions>(origin, direction, sphere.position(), sphere.radius());
+        }
+
+        case Type::InvertedSphere:
+            return rayInvertedSphere(origin, direction, static_cast<const Shape<Shapes::InvertedSphere<dimensions>>&>(shape).shape);
+
+        case Type::Cylinder: {
+            const Shapes::Cylinder<dimensions>& cylinder = static_cast<const Shape<Shapes::Cylinder<dimensions>>&>(shape).shape;
+            return rayCylinder<dimensions>(origin, direction, cylinder.a(), cylinder.b(), cylinder.radius());
+        }
+
+        case Type::Capsule:
+            return rayCapsule(origin, direction, static_cast<const Shape<Shapes::Capsule<dimensions>>&>(shape).shape);
+
+        case Type::AxisAlignedBox: {
+            const Shapes::AxisAlignedBox<dimensions>& box = static_cast<const Shape<Shapes::AxisAlignedBox<dimensions>>&>(shape).shape;
+            return rayRange<dimensions>(origin, direction, Math::min(box.min(), box.max()), Math::max(box.min(), box.max()));
+        }
+
+        /* The box is a transformed [-1, 1] cube, the ray parameter stays the
+           same after transforming the ray into its local space */
+        case Type::Box: {
+            const MatrixTypeFor<dimensions, Float> inverted = static_cast<const Shape<Shapes::Box<dimensions>>&>(shape).shape.transformation().inverted();
+            return rayRange<dimensions>(inverted.transformPoint(origin), inverted.transformVector(direction), VectorTypeFor<dimensions, Float>(-1.0f), VectorTypeFor<dimensions, Float>(1.0f));
+        }
+
+        /* Points, lines and line segments have no volume, compositions are
+           not supported */
+        default: break;
+    }
+
+    return Constants::inf();
+}
+
+/* The shape is inflated by the sphere radius and the sphere center is then
+   cast as a ray with the displacement as direction, so the ray parameter is
+   directly the fraction of the displacement */
+template<UnsignedInt dimensions> Float sweepImplementation(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& position, const Float radius, const VectorTypeFor<dimensions, Float>& displacement) {
+    typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+
+    switch(shape.type()) {
+        case Type::Point:
+            return raySphere<dimensions>(position, displacement, static_cast<const Shape<Shapes::Point<dimensions>>&>(shape).shape.position(), radius);
+
+        case Type::Line: {
+            const Shapes::Line<dimensions>& line = static_cast<const Shape<Shapes::Line<dimensions>>&>(shape).shape;
+            return rayCylinder<dimensions>(position, displacement, line.a(), line.b(), radius);
+        }
+
+        case Type::LineSegment: {
+            const Shapes::LineSegment<dimensions>& segment = static_cast<const Shape<Shapes::LineSegment<dimensions>>&>(shape).shape;
+            return rayCapsule(position, displacement, Shapes::Capsule<dimensions>{segment.a(), segment.b(), radius});
+        }
+
+        case Type::Sphere: {
+            const Shapes::Sphere<dimensions>& sphere = static_cast<const Shape<Shapes::Sphere<dimensions>>&>(shape).shape;
+            return raySphere<dimensions>(position, displacement, sphere.position(), sphere.radius() + radius);
+        }
+
+        /* The sphere collides as soon as it is not fully inside */
+        case Type::InvertedSphere: {
+            const Shapes::InvertedSphere<dimensions>& sphere = static_cast<const Shape<Shapes::InvertedSphere<dimensions>>&>(shape).shape;
+            return rayInvertedSphere(position, displacement, Shapes::InvertedSphere<dimensions>{sphere.position(), Math::max(sphere.radius() - radius, 0.0f)});
+        }
+
+        case Type::Cylinder: {
+            const Shapes::Cylinder<dimensions>& cylinder = static_cast<const Shape<Shapes::Cylinder<dimensions>>&>(shape).shape;
+            return rayCylinder<dimensions>(position, displacement, cylinder.a(), cylinder.b(), cylinder.radius() + radius);
+        }
+
+        case Type::Capsule: {
+            const Shapes::Capsule<dimensions>& capsule = static_cast<const Shape<Shapes::Capsule<dimensions>>&>(shape).shape;
+            return rayCapsule(position, displacement, Shapes::Capsule<dimensions>{capsule.a(), capsule.b(), capsule.radius() + radius});
+        }
+
+        /* Boxes are inflated along their faces only, so the sphere can hit
+           their corners slightly earlier than it should */
+        case Type::AxisAlignedBox: {
+            const Shapes::AxisAlignedBox<dimensions>& box = static_cast<const Shape<Shapes::AxisAlignedBox<dimensions>>&>(shape).shape;
+            return rayRange<dimensions>(position, displacement,
+                Math::min(box.min(), box.max()) - VectorTypeFor<dimensions, Float>(radius),
+                Math::max(box.min(), box.max()) + VectorTypeFor<dimensions, Float>(radius));
+        }
+
+        /* Offset of length r in world space changes i-th local coordinate
+           by at most r times length of i-th row of the inverse */
+        case Type::Box: {
+            const MatrixTypeFor<dimensions, Float> inverted = static_cast<const Shape<Shapes::Box<dimensions>>&>(shape).shape.transformation().inverted();
+            VectorTypeFor<dimensions, Float> extent;
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                extent[i] = 1.0f + radius*VectorTypeFor<dimensions, Float>::pad(inverted.row(i)).length();
+            return rayRange<dimensions>(inverted.transformPoint(position), inverted.transformVector(displacement), -extent, extent);
+        }
+
+        /* Compositions are not supported */
+        default: break;
+    }
+
+    return Constants::inf();
+}
+
+}
+
+template<> Range2D bounds(const AbstractShape<2>& shape) {
+    return boundsImplementation(shape);
+}
+
+template<> Range3D bounds(const AbstractShape<3>& shape) {
+    return boundsImplementation(shape);
+}
+
+template<> Float raycast(const AbstractShape<2>& shape, const Vector2& origin, const Vector2& direction) {
+    return raycastImplementation(shape, origin, direction);
+}
+
+template<> Float raycast(const AbstractShape<3>& shape, const Vector3& origin, const Vector3& direction) {
+    if(shape.type() == ShapeDimensionTraits<3>::Type::Plane) {
+        const Shapes::Plane& plane = static_cast<const Shape<Shapes::Plane>&>(shape).shape;
+        const Float t = Math::Geometry::Intersection::planeLine(plane.position(), plane.normal(), origin, direction);
+        return t >= 0.0f ? t : Constants::inf();
+    }
+
+    return raycastImplementation(shape, origin, direction);
+}
+
+template<> Float sweep(const AbstractShape<2>& shape, const Vector2& position, const Float radius, const Vector2& displacement) {
+    return sweepImplementation(shape, position, radius, displacement);
+}
+
+template<> Float sweep(const AbstractShape<3>& shape, const Vector3& position, const Float radius, const Vector3& displacement) {
+    /* The plane is offset by the radius towards the sphere */
+    if(shape.type() == ShapeDimensionTraits<3>::Type::Plane) {
+        const Shapes::Plane& plane = static_cast<const Shape<Shapes::Plane>&>(shape).shape;
+        const Vector3 normal = plane.normal().normalized();
+        const Float distance = Math::dot(position - plane.position(), normal);
+        if(std::abs(distance) <= radius) return 0.0f;
+
+        const Float approach = distance > 0.0f ? -Math::dot(displacement, normal) : Math::dot(displacement, normal);
+        if(approach <= 0.0f) return Constants::inf();
+        return (std::abs(distance) - radius)/approach;
+    }
+
+    return sweepImplementation(shape, position, radius, displacement);
+}
+
+template<UnsignedInt dimensions> Float sweep(const AbstractShape<dimensions>& shape, const Shapes::Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement) {
+    typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+
+    /* Points and spheres are swept against the capsule in the opposite
+       direction instead, which is exact */
+    if(shape.type() == Type::Point) {
+        const VectorTypeFor<dimensions, Float> position = static_cast<const Shape<Shapes::Point<dimensions>>&>(shape).shape.position();
+        return rayCapsule(position, -displacement, capsule);
+    }
+    if(shape.type() == Type::Sphere) {
+        const Shapes::Sphere<dimensions>& sphere = static_cast<const Shape<Shapes::Sphere<dimensions>>&>(shape).shape;
+        return rayCapsule(sphere.position(), -displacement, Shapes::Capsule<dimensions>{capsule.a(), capsule.b(), capsule.radius() + sphere.radius()});
+    }
+
+    /* Everything else against the bounding sphere of the capsule */
+    return sweep(shape, (capsule.a() + capsule.b())*0.5f, (capsule.b() - capsule.a()).length()*0.5f + capsule.radius(), displacement);
+}
+
+template Float sweep(const AbstractShape<2>&, const Capsule2D&, const Vector2&);
+template Float sweep(const AbstractShape<3>&, const Capsule3D&, const Vector3&);
+
+template<> Float raycast<2>(const Range2D& range, const Vector2& origin, const Vector2& direction) {
+    return rayRange<2>(origin, direction, range.min(), range.max());
+}
+
+template<> Float raycast<3>(const Range3D& range, const Vector3& origin, const Vector3& direction) {
+    return rayRange<3>(origin, direction, range.min(), range.max());
+}
+
 }}}
@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/DimensionTraits.h"
 #include "Magnum/Types.h"
 #include "Magnum/Shapes/Shapes.h"
 
@@ -46,6 +47,43 @@ template<UnsignedInt dimensions> bool collides(const AbstractShape<dimensions>&
 
 template<UnsignedInt dimensions> Collision<dimensions> collision(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b);
 
+/*
+Conservative axis-aligned bounds of given shape, used for broadphase in
+ShapeGroup. Shapes which are not bounded (lines, planes, infinite cylinders,
+inverted spheres) have infinite bounds, thus they are candidates for collision
+with everything.
+*/
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const AbstractShape<dimensions>& shape);
+
+/*
+Distance along a ray with normalized direction to the first point of given
+shape, zero if the origin is inside the shape and infinity if the ray doesn't
+hit it. Shapes without any volume (points, lines and line segments) are never
+hit, except for planes. Compositions are not supported and are never hit
+either.
+*/
+template<UnsignedInt dimensions> Float raycast(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction);
+
+/*
+Time of impact of a sphere moving from given position by given displacement,
+as a fraction of the displacement. Zero if the sphere already collides with
+the shape at the start and infinity if it doesn't hit the shape anywhere along
+the (unbounded) line of the motion. Points are spheres with zero radius. The
+shape is inflated by the sphere radius, which is exact for everything except
+boxes, which the sphere may hit slightly earlier near their corners.
+Compositions are not supported and are never hit.
+*/
+template<UnsignedInt dimensions> Float sweep(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& position, Float radius, const VectorTypeFor<dimensions, Float>& displacement);
+
+/*
+Same as above for a capsule. Exact for points and spheres, everything else is
+swept against the bounding sphere of the capsule, which may hit earlier.
+*/
+template<UnsignedInt dimensions> Float sweep(const AbstractShape<dimensions>& shape, const Shapes::Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement);
+
+/* Same as above for an axis-aligned range, used for broadphase */
+template<UnsignedInt dimensions> Float raycast(const RangeTypeFor<dimensions, Float>& range, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction);
+
 }}}
 
 #endif
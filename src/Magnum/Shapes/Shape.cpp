@@ -41,6 +41,10 @@ template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::tran
     CORRADE_INTERNAL_ASSERT(shape._shape.shape.size() == shape._transformedShape.shape.size());
     for(std::size_t i = 0; i != shape.shape().size(); ++i)
         shape._shape.shape._shapes[i]->transform(absoluteTransformationMatrix, shape._transformedShape.shape._shapes[i]);
+
+    /* The compiled program stays the same, only the bounds used for early
+       rejection need to be updated */
+    shape._transformedShape.shape.updateBounds();
 }
 
 template struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<2>>;
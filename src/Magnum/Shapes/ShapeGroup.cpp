@@ -25,26 +25,375 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "Magnum/FrameAllocator.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/Implementation/Simd.h"
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Collision.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+#include "Magnum/Shapes/Implementation/CollisionDispatch.h"
+
+#if !defined(MAGNUM_MATH_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 namespace Magnum { namespace Shapes {
 
+namespace {
+    template<UnsignedInt dimensions> inline bool overlaps(const Math::Range<dimensions, Float>& a, const Math::Range<dimensions, Float>& b) {
+        return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+    }
+
+    /* Operations on as many floats as the instruction set allows */
+    #if !defined(MAGNUM_MATH_NO_SIMD) && defined(__AVX__)
+    struct Lanes {
+        enum: std::size_t { Size = 8 };
+        typedef __m256 Type;
+        typedef __m256 Mask;
+
+        static Type load(const Float* a) { return _mm256_loadu_ps(a); }
+        static Type set(Float a) { return _mm256_set1_ps(a); }
+        static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Mask less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Mask greaterEqual(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static Mask both(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+        static Int bits(Mask a) { return _mm256_movemask_ps(a); }
+    };
+    #elif defined(MAGNUM_MATH_SIMD_SSE2)
+    struct Lanes {
+        enum: std::size_t { Size = 4 };
+        typedef __m128 Type;
+        typedef __m128 Mask;
+
+        static Type load(const Float* a) { return _mm_loadu_ps(a); }
+        static Type set(Float a) { return _mm_set1_ps(a); }
+        static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Mask less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+        static Mask greaterEqual(Type a, Type b) { return _mm_cmpge_ps(a, b); }
+        static Mask both(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static Int bits(Mask a) { return _mm_movemask_ps(a); }
+    };
+    #else
+    struct Lanes {
+        enum: std::size_t { Size = 1 };
+        typedef Float Type;
+        typedef bool Mask;
+
+        static Type load(const Float* a) { return *a; }
+        static Type set(Float a) { return a; }
+        static Type add(Type a, Type b) { return a + b; }
+        static Type sub(Type a, Type b) { return a - b; }
+        static Type mul(Type a, Type b) { return a*b; }
+        static Mask less(Type a, Type b) { return a < b; }
+        static Mask greaterEqual(Type a, Type b) { return a >= b; }
+        static Mask both(Mask a, Mask b) { return a && b; }
+        static Int bits(Mask a) { return a; }
+    };
+    #endif
+
+    inline std::size_t firstBit(const Int bits) {
+        std::size_t i = 0;
+        while(!(bits & (1 << i))) ++i;
+        return i;
+    }
+
+    /* Squared distance of given position from the one in the arrays, in the
+       same order of operations as Vector::dot() */
+    template<UnsignedInt dimensions> inline Lanes::Type distanceSquared(const std::vector<Float>(&positions)[dimensions], const std::size_t i, const Lanes::Type(&position)[dimensions]) {
+        Lanes::Type d = Lanes::sub(Lanes::load(positions[0].data() + i), position[0]);
+        Lanes::Type out = Lanes::mul(d, d);
+        for(UnsignedInt c = 1; c != dimensions; ++c) {
+            d = Lanes::sub(Lanes::load(positions[c].data() + i), position[c]);
+            out = Lanes::add(out, Lanes::mul(d, d));
+        }
+        return out;
+    }
+
+    /* The kernels return position of first colliding shape in the arrays or
+       size of the arrays if there's none. The arrays are padded with NaNs to
+       a multiple of lane count, which never compare as colliding. */
+
+    /* Same as Sphere::operator%() with a sphere, with a point if radius is
+       zero */
+    template<UnsignedInt dimensions> std::size_t firstSphere(const std::vector<Float>(&positions)[dimensions], const std::vector<Float>& radii, const VectorTypeFor<dimensions, Float>& position, const Float radius) {
+        Lanes::Type p[dimensions];
+        for(UnsignedInt c = 0; c != dimensions; ++c) p[c] = Lanes::set(position[c]);
+        const Lanes::Type r = Lanes::set(radius);
+
+        for(std::size_t i = 0; i < radii.size(); i += Lanes::Size) {
+            const Lanes::Type sum = Lanes::add(Lanes::load(radii.data() + i), r);
+            if(const Int bits = Lanes::bits(Lanes::less(distanceSquared<dimensions>(positions, i, p), Lanes::mul(sum, sum))))
+                return i + firstBit(bits);
+        }
+
+        return radii.size();
+    }
+
+    /* Same as Sphere::operator%() with a point */
+    template<UnsignedInt dimensions> std::size_t firstPoint(const std::vector<Float>(&positions)[dimensions], const VectorTypeFor<dimensions, Float>& position, const Float radius) {
+        Lanes::Type p[dimensions];
+        for(UnsignedInt c = 0; c != dimensions; ++c) p[c] = Lanes::set(position[c]);
+        const Lanes::Type r = Lanes::set(radius);
+        const Lanes::Type radiusSquared = Lanes::mul(r, r);
+
+        for(std::size_t i = 0; i < positions[0].size(); i += Lanes::Size)
+            if(const Int bits = Lanes::bits(Lanes::less(distanceSquared<dimensions>(positions, i, p), radiusSquared)))
+                return i + firstBit(bits);
+
+        return positions[0].size();
+    }
+
+    /* Same as AxisAlignedBox::operator%() with a point */
+    template<UnsignedInt dimensions> std::size_t firstBox(const std::vector<Float>(&min)[dimensions], const std::vector<Float>(&max)[dimensions], const VectorTypeFor<dimensions, Float>& position) {
+        Lanes::Type p[dimensions];
+        for(UnsignedInt c = 0; c != dimensions; ++c) p[c] = Lanes::set(position[c]);
+
+        for(std::size_t i = 0; i < min[0].size(); i += Lanes::Size) {
+            Lanes::Mask inside = Lanes::both(
+                Lanes::greaterEqual(p[0], Lanes::load(min[0].data() + i)),
+                Lanes::less(p[0], Lanes::load(max[0].data() + i)));
+            for(UnsignedInt c = 1; c != dimensions; ++c) inside = Lanes::both(inside, Lanes::both(
+                Lanes::greaterEqual(p[c], Lanes::load(min[c].data() + i)),
+                Lanes::less(p[c], Lanes::load(max[c].data() + i))));
+            if(const Int bits = Lanes::bits(inside))
+                return i + firstBit(bits);
+        }
+
+        return min[0].size();
+    }
+
+    /* Remaining shapes are tested through the collision dispatch, only up to
+       the first collision found so far */
+    template<UnsignedInt dimensions, class T> std::size_t firstOther(ShapeGroup<dimensions>& group, const std::vector<UnsignedInt>& ids, const T& query, const std::size_t first) {
+        const Implementation::Shape<T> shape{query};
+        for(const UnsignedInt id: ids) {
+            if(id > first) break;
+            if(Implementation::collides(Implementation::getAbstractShape(group[id]), shape))
+                return id;
+        }
+
+        return first;
+    }
+
+    template<class Batch, UnsignedInt dimensions> Int batchFirstCollision(ShapeGroup<dimensions>& group, const Batch& batch, const Point<dimensions>& point) {
+        std::size_t first = std::numeric_limits<std::size_t>::max();
+
+        const std::size_t sphere = firstSphere<dimensions>(batch.spherePositions, batch.sphereRadii, point.position(), 0.0f);
+        if(sphere < batch.sphereIds.size()) first = batch.sphereIds[sphere];
+
+        const std::size_t box = firstBox<dimensions>(batch.boxMin, batch.boxMax, point.position());
+        if(box < batch.boxIds.size()) first = std::min<std::size_t>(first, batch.boxIds[box]);
+
+        first = firstOther(group, batch.otherIds, point, first);
+        return first == std::numeric_limits<std::size_t>::max() ? -1 : Int(first);
+    }
+
+    template<class Batch, UnsignedInt dimensions> Int batchFirstCollision(ShapeGroup<dimensions>& group, const Batch& batch, const Sphere<dimensions>& sphere) {
+        std::size_t first = std::numeric_limits<std::size_t>::max();
+
+        const std::size_t point = firstPoint<dimensions>(batch.pointPositions, sphere.position(), sphere.radius());
+        if(point < batch.pointIds.size()) first = batch.pointIds[point];
+
+        const std::size_t other = firstSphere<dimensions>(batch.spherePositions, batch.sphereRadii, sphere.position(), sphere.radius());
+        if(other < batch.sphereIds.size()) first = std::min<std::size_t>(first, batch.sphereIds[other]);
+
+        first = firstOther(group, batch.otherIds, sphere, first);
+        return first == std::numeric_limits<std::size_t>::max() ? -1 : Int(first);
+    }
+
+    template<class Batch, UnsignedInt dimensions> inline Sphere<dimensions> batchSphere(const Batch& batch, const UnsignedInt i) {
+        VectorTypeFor<dimensions, Float> position;
+        for(UnsignedInt c = 0; c != dimensions; ++c)
+            position[c] = batch.spherePositions[c][i];
+        return {position, batch.sphereRadii[i]};
+    }
+
+    template<class Batch, UnsignedInt dimensions> inline Point<dimensions> batchPoint(const Batch& batch, const UnsignedInt i) {
+        VectorTypeFor<dimensions, Float> position;
+        for(UnsignedInt c = 0; c != dimensions; ++c)
+            position[c] = batch.pointPositions[c][i];
+        return {position};
+    }
+
+    /* Points and spheres are taken directly from the arrays, everything else
+       goes through the collision dispatch */
+    template<class Batch, UnsignedInt dimensions> Collision<dimensions> batchContact(ShapeGroup<dimensions>& group, const Batch& batch, const UnsignedInt a, const UnsignedInt b) {
+        typedef typename Batch::Kind Kind;
+        const std::pair<Kind, UnsignedInt> slotA = batch.slots[a];
+        const std::pair<Kind, UnsignedInt> slotB = batch.slots[b];
+
+        if(slotA.first == Kind::Sphere && slotB.first == Kind::Sphere)
+            return batchSphere<Batch, dimensions>(batch, slotA.second)/batchSphere<Batch, dimensions>(batch, slotB.second);
+        if(slotA.first == Kind::Sphere && slotB.first == Kind::Point)
+            return batchSphere<Batch, dimensions>(batch, slotA.second)/batchPoint<Batch, dimensions>(batch, slotB.second);
+        if(slotA.first == Kind::Point && slotB.first == Kind::Sphere)
+            return batchPoint<Batch, dimensions>(batch, slotA.second)/batchSphere<Batch, dimensions>(batch, slotB.second);
+
+        return Implementation::collision(Implementation::getAbstractShape(group[a]), Implementation::getAbstractShape(group[b]));
+    }
+
+    inline void pad(std::vector<Float>& array) {
+        while(array.size() % Lanes::Size)
+            array.push_back(std::numeric_limits<Float>::quiet_NaN());
+    }
+}
+
+template<UnsignedInt dimensions> struct ShapeGroup<dimensions>::Batch {
+    /* One array per coordinate, indices are positions of the shapes in the
+       group, in ascending order */
+    std::vector<Float> pointPositions[dimensions];
+    std::vector<UnsignedInt> pointIds;
+    std::vector<Float> spherePositions[dimensions];
+    std::vector<Float> sphereRadii;
+    std::vector<UnsignedInt> sphereIds;
+    std::vector<Float> boxMin[dimensions];
+    std::vector<Float> boxMax[dimensions];
+    std::vector<UnsignedInt> boxIds;
+    std::vector<UnsignedInt> otherIds;
+
+    /* Kind of each shape in group order and its position in the arrays
+       above, used for contact generation */
+    enum class Kind: UnsignedByte { Point, Sphere, AxisAlignedBox, Other };
+    std::vector<std::pair<Kind, UnsignedInt>> slots;
+
+    /* Shapes in group order at the time of last update, used to detect
+       added and removed shapes */
+    std::vector<AbstractShape<dimensions>*> shapes;
+};
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>::ShapeGroup(): dirty(true), _broadphaseEnabled(false), _batchDirty(true), _threadCount(0), _cleanedCount(0) {}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>::~ShapeGroup() {
+    for(std::size_t i = 0; i != this->size(); ++i)
+        if((*this)[i]._queuedIn == this) (*this)[i]._queuedIn = nullptr;
+}
+
 template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
-    /* Clean all objects */
-    if(!this->isEmpty()) {
-        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
+    /* If any shape was added, removed or the group was reordered, the dirty
+       list might contain shapes which are not in the group anymore (or not
+       at all), so don't touch it and clean everything */
+    bool changed = _cleanShapes.size() != this->size();
+    for(std::size_t i = 0; !changed && i != this->size(); ++i)
+        if(_cleanShapes[i] != &(*this)[i]) changed = true;
+
+    /* Reusing the storage from last time to avoid allocations */
+    std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>>& objects = _cleanObjects;
+    objects.clear();
+    if(changed) {
+        _cleanShapes.clear();
+        _cleanShapes.reserve(this->size());
         objects.reserve(this->size());
-        for(std::size_t i = 0; i != this->size(); ++i)
-            objects.push_back((*this)[i].object());
+        for(std::size_t i = 0; i != this->size(); ++i) {
+            AbstractShape<dimensions>& shape = (*this)[i];
+            _cleanShapes.push_back(&shape);
+            objects.push_back(shape.object());
+            shape._queuedIn = nullptr;
+        }
 
-        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    /* Otherwise clean only objects of shapes that were marked dirty */
+    } else {
+        objects.reserve(_dirtyShapes.size());
+        for(AbstractShape<dimensions>* shape: _dirtyShapes) {
+            objects.push_back(shape->object());
+            shape->_queuedIn = nullptr;
+        }
     }
 
+    _dirtyShapes.clear();
+    _cleanedCount = objects.size();
+    if(!objects.empty())
+        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+
+    if(_broadphaseEnabled) updateBroadphase();
+
+    /* The batch data are updated lazily on next batch query */
+    if(dirty) _batchDirty = true;
+
     dirty = false;
 }
 
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBroadphase() {
+    /* If any shape was added, removed or the group was reordered, rebuild
+       everything from scratch */
+    bool rebuild = _broadphaseShapes.size() != this->size();
+    for(std::size_t i = 0; !rebuild && i != this->size(); ++i)
+        if(_broadphaseShapes[i] != &(*this)[i]) rebuild = true;
+
+    if(rebuild) {
+        _broadphaseShapes.clear();
+        _broadphaseShapes.reserve(this->size());
+        _broadphase.clear();
+        _broadphase.reserve(this->size());
+        for(std::size_t i = 0; i != this->size(); ++i) {
+            AbstractShape<dimensions>& shape = (*this)[i];
+            _broadphaseShapes.push_back(&shape);
+            _broadphase.push_back({&shape, shape.bounds(), UnsignedInt(i)});
+            shape._boundsDirty = false;
+        }
+
+        std::sort(_broadphase.begin(), _broadphase.end(), [](const BroadphaseEntry& a, const BroadphaseEntry& b) {
+            return a.bounds.min().x() < b.bounds.min().x();
+        });
+        return;
+    }
+
+    /* Update bounds only of shapes that changed since last time */
+    for(BroadphaseEntry& entry: _broadphase) {
+        if(!entry.shape->_boundsDirty) continue;
+        entry.bounds = entry.shape->bounds();
+        entry.shape->_boundsDirty = false;
+    }
+
+    /* The shapes usually don't move much between updates, so the array is
+       nearly sorted and insertion sort is close to linear */
+    for(std::size_t i = 1; i < _broadphase.size(); ++i) {
+        const BroadphaseEntry entry = _broadphase[i];
+        std::size_t j = i;
+        for(; j && _broadphase[j - 1].bounds.min().x() > entry.bounds.min().x(); --j)
+            _broadphase[j] = _broadphase[j - 1];
+        _broadphase[j] = entry;
+    }
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::setBroadphaseEnabled(const bool enabled) {
+    _broadphaseEnabled = enabled;
+
+    /* Free the memory, the data would be rebuilt on next enable anyway */
+    if(!enabled) {
+        std::vector<AbstractShape<dimensions>*>{}.swap(_broadphaseShapes);
+        std::vector<BroadphaseEntry>{}.swap(_broadphase);
+    }
+
+    return *this;
+}
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimensions>::firstCollision(const AbstractShape<dimensions>& shape) {
     setClean();
+
+    if(_broadphaseEnabled) {
+        const RangeTypeFor<dimensions, Float> bounds = shape.bounds();
+        for(const BroadphaseEntry& entry: _broadphase) {
+            /* All following shapes are past the query shape on X axis */
+            if(entry.bounds.min().x() > bounds.max().x()) break;
+
+            if(entry.shape != &shape && overlaps(entry.bounds, bounds) && entry.shape->collides(shape))
+                return entry.shape;
+        }
+
+        return nullptr;
+    }
+
     for(std::size_t i = 0; i != this->size(); ++i)
         if(&(*this)[i] != &shape && (*this)[i].collides(shape))
             return &(*this)[i];
@@ -52,6 +401,314 @@ template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimension
     return nullptr;
 }
 
+template<UnsignedInt dimensions> std::vector<AbstractShape<dimensions>*> ShapeGroup<dimensions>::allCollisions(const AbstractShape<dimensions>& shape) {
+    setClean();
+
+    std::vector<AbstractShape<dimensions>*> out;
+    if(_broadphaseEnabled) {
+        const RangeTypeFor<dimensions, Float> bounds = shape.bounds();
+        for(const BroadphaseEntry& entry: _broadphase) {
+            /* All following shapes are past the query shape on X axis */
+            if(entry.bounds.min().x() > bounds.max().x()) break;
+
+            if(entry.shape != &shape && overlaps(entry.bounds, bounds) && entry.shape->collides(shape))
+                out.push_back(entry.shape);
+        }
+
+        return out;
+    }
+
+    for(std::size_t i = 0; i != this->size(); ++i)
+        if(&(*this)[i] != &shape && (*this)[i].collides(shape))
+            out.push_back(&(*this)[i]);
+
+    return out;
+}
+
+template<UnsignedInt dimensions> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> ShapeGroup<dimensions>::collidingPairs() {
+    setClean();
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    if(_broadphaseEnabled) {
+        for(std::size_t i = 0; i != _broadphase.size(); ++i) {
+            const BroadphaseEntry& a = _broadphase[i];
+
+            /* Sweep over shapes starting before this one ends on X axis */
+            for(std::size_t j = i + 1; j != _broadphase.size() && _broadphase[j].bounds.min().x() <= a.bounds.max().x(); ++j) {
+                const BroadphaseEntry& b = _broadphase[j];
+                if(overlaps(a.bounds, b.bounds) && a.shape->collides(*b.shape))
+                    out.emplace_back(a.shape, b.shape);
+            }
+        }
+
+        return out;
+    }
+
+    for(std::size_t i = 0; i != this->size(); ++i)
+        for(std::size_t j = i + 1; j != this->size(); ++j)
+            if((*this)[i].collides((*this)[j]))
+                out.emplace_back(&(*this)[i], &(*this)[j]);
+
+    return out;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) -> RaycastHit {
+    CORRADE_ASSERT(direction.isNormalized(),
+        "Shapes::ShapeGroup::raycast(): direction" << direction << "is not normalized", (RaycastHit{nullptr, maxDistance}));
+
+    setClean();
+    return raycastInternal(origin, direction, maxDistance);
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::raycast(const Containers::ArrayView<const VectorTypeFor<dimensions, Float>> origins, const Containers::ArrayView<const VectorTypeFor<dimensions, Float>> directions, const Float maxDistance) -> std::vector<RaycastHit> {
+    CORRADE_ASSERT(origins.size() == directions.size(),
+        "Shapes::ShapeGroup::raycast(): expected the same count of origins and directions but got" << origins.size() << "and" << directions.size(), {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const VectorTypeFor<dimensions, Float>& direction: directions)
+        CORRADE_ASSERT(direction.isNormalized(),
+            "Shapes::ShapeGroup::raycast(): direction" << direction << "is not normalized", {});
+    #endif
+
+    setClean();
+
+    std::vector<RaycastHit> out(origins.size());
+    Magnum::Implementation::parallelForEach(origins.size(), _threadCount, [this, &origins, &directions, maxDistance, &out](const std::size_t i) {
+        out[i] = raycastInternal(origins[i], directions[i], maxDistance);
+    });
+
+    return out;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::raycastInternal(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) -> RaycastHit {
+    RaycastHit hit{nullptr, maxDistance};
+
+    if(_broadphaseEnabled) {
+        for(const BroadphaseEntry& entry: _broadphase) {
+            /* If the ray doesn't go in negative X direction, all following
+               shapes are past the nearest hit found so far */
+            if(direction.x() >= 0.0f && entry.bounds.min().x() > origin.x() + direction.x()*hit.distance) break;
+
+            /* Skip shapes whose bounds are not hit closer than the nearest
+               hit found so far */
+            if(Implementation::raycast<dimensions>(entry.bounds, origin, direction) >= hit.distance) continue;
+
+            const Float distance = Implementation::raycast(Implementation::getAbstractShape(*entry.shape), origin, direction);
+            if(distance < hit.distance) hit = {entry.shape, distance};
+        }
+
+        return hit;
+    }
+
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        const Float distance = Implementation::raycast(Implementation::getAbstractShape((*this)[i]), origin, direction);
+        if(distance < hit.distance) hit = {&(*this)[i], distance};
+    }
+
+    return hit;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::sweep(const Point<dimensions>& point, const VectorTypeFor<dimensions, Float>& displacement) -> SweepHit {
+    return sweepInternal({point.position(), point.position()}, displacement, [&point, &displacement](const Implementation::AbstractShape<dimensions>& shape) {
+        return Implementation::sweep(shape, point.position(), 0.0f, displacement);
+    });
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement) -> SweepHit {
+    const VectorTypeFor<dimensions, Float> radius{sphere.radius()};
+    return sweepInternal({sphere.position() - radius, sphere.position() + radius}, displacement, [&sphere, &displacement](const Implementation::AbstractShape<dimensions>& shape) {
+        return Implementation::sweep(shape, sphere.position(), sphere.radius(), displacement);
+    });
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement) -> SweepHit {
+    const VectorTypeFor<dimensions, Float> radius{capsule.radius()};
+    return sweepInternal({Math::min(capsule.a(), capsule.b()) - radius, Math::max(capsule.a(), capsule.b()) + radius}, displacement, [&capsule, &displacement](const Implementation::AbstractShape<dimensions>& shape) {
+        return Implementation::sweep(shape, capsule, displacement);
+    });
+}
+
+template<UnsignedInt dimensions> template<class F> auto ShapeGroup<dimensions>::sweepInternal(const RangeTypeFor<dimensions, Float>& bounds, const VectorTypeFor<dimensions, Float>& displacement, F timeOfImpact) -> SweepHit {
+    setClean();
+
+    SweepHit hit{nullptr, 1.0f};
+
+    if(_broadphaseEnabled) {
+        /* Moving box hits the shape bounds at the same time as its center
+           hits the bounds inflated by half of its size */
+        const VectorTypeFor<dimensions, Float> center = bounds.center();
+        const VectorTypeFor<dimensions, Float> halfSize = bounds.size()*0.5f;
+
+        for(const BroadphaseEntry& entry: _broadphase) {
+            /* If the query doesn't move in negative X direction, all
+               following shapes are past the first hit found so far */
+            if(displacement.x() >= 0.0f && entry.bounds.min().x() > bounds.max().x() + displacement.x()*hit.time) break;
+
+            /* Skip shapes whose bounds are not hit earlier than the first
+               hit found so far */
+            if(Implementation::raycast<dimensions>(RangeTypeFor<dimensions, Float>{entry.bounds.min() - halfSize, entry.bounds.max() + halfSize}, center, displacement) >= hit.time) continue;
+
+            const Float time = timeOfImpact(Implementation::getAbstractShape(*entry.shape));
+            if(time < hit.time) hit = {entry.shape, time};
+        }
+
+        return hit;
+    }
+
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        const Float time = timeOfImpact(Implementation::getAbstractShape((*this)[i]));
+        if(time < hit.time) hit = {&(*this)[i], time};
+    }
+
+    return hit;
+}
+
+template<UnsignedInt dimensions> std::vector<std::pair<UnsignedInt, UnsignedInt>> ShapeGroup<dimensions>::candidatePairs() {
+    setClean();
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> out;
+    if(_broadphaseEnabled) {
+        for(std::size_t i = 0; i != _broadphase.size(); ++i) {
+            const BroadphaseEntry& a = _broadphase[i];
+
+            /* Sweep over shapes starting before this one ends on X axis */
+            for(std::size_t j = i + 1; j != _broadphase.size() && _broadphase[j].bounds.min().x() <= a.bounds.max().x(); ++j) {
+                const BroadphaseEntry& b = _broadphase[j];
+                if(overlaps(a.bounds, b.bounds))
+                    out.push_back(std::minmax(a.id, b.id));
+            }
+        }
+
+        return out;
+    }
+
+    FrameVector<RangeTypeFor<dimensions, Float>> bounds;
+    bounds.reserve(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        bounds.push_back((*this)[i].bounds());
+
+    for(std::size_t i = 0; i != this->size(); ++i)
+        for(std::size_t j = i + 1; j != this->size(); ++j)
+            if(overlaps(bounds[i], bounds[j]))
+                out.emplace_back(i, j);
+
+    return out;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::contacts(const Containers::ArrayView<const std::pair<UnsignedInt, UnsignedInt>> pairs, const Containers::ArrayView<Collision<dimensions>> contacts) {
+    CORRADE_ASSERT(pairs.size() == contacts.size(),
+        "Shapes::ShapeGroup::contacts(): expected the same count of pairs and contacts but got" << pairs.size() << "and" << contacts.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const std::pair<UnsignedInt, UnsignedInt>& pair: pairs)
+        CORRADE_ASSERT(pair.first < this->size() && pair.second < this->size(),
+            "Shapes::ShapeGroup::contacts(): pair" << pair.first << pair.second << "out of range for" << this->size() << "shapes", );
+    #endif
+
+    setClean();
+    updateBatch();
+
+    const Batch& batch = *_batch;
+    Magnum::Implementation::parallelForEach(pairs.size(), _threadCount, [this, &batch, &pairs, &contacts](const std::size_t i) {
+        contacts[i] = batchContact(*this, batch, pairs[i].first, pairs[i].second);
+    });
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBatch() {
+    if(!_batch) _batch.reset(new Batch);
+    Batch& batch = *_batch;
+
+    /* If anything moved or if any shape was added, removed or the group was
+       reordered, rebuild everything */
+    bool rebuild = _batchDirty || batch.shapes.size() != this->size();
+    for(std::size_t i = 0; !rebuild && i != this->size(); ++i)
+        if(batch.shapes[i] != &(*this)[i]) rebuild = true;
+    if(!rebuild) return;
+
+    batch.shapes.clear();
+    for(UnsignedInt c = 0; c != dimensions; ++c) {
+        batch.pointPositions[c].clear();
+        batch.spherePositions[c].clear();
+        batch.boxMin[c].clear();
+        batch.boxMax[c].clear();
+    }
+    batch.pointIds.clear();
+    batch.sphereRadii.clear();
+    batch.sphereIds.clear();
+    batch.boxIds.clear();
+    batch.otherIds.clear();
+    batch.slots.clear();
+
+    typedef typename Implementation::ShapeDimensionTraits<dimensions>::Type Type;
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        AbstractShape<dimensions>& shape = (*this)[i];
+        batch.shapes.push_back(&shape);
+
+        const Implementation::AbstractShape<dimensions>& transformed = Implementation::getAbstractShape(shape);
+        switch(transformed.type()) {
+            case Type::Point: {
+                const VectorTypeFor<dimensions, Float> position = static_cast<const Implementation::Shape<Point<dimensions>>&>(transformed).shape.position();
+                for(UnsignedInt c = 0; c != dimensions; ++c)
+                    batch.pointPositions[c].push_back(position[c]);
+                batch.slots.emplace_back(Batch::Kind::Point, batch.pointIds.size());
+                batch.pointIds.push_back(i);
+            } break;
+
+            case Type::Sphere: {
+                const Sphere<dimensions>& sphere = static_cast<const Implementation::Shape<Sphere<dimensions>>&>(transformed).shape;
+                for(UnsignedInt c = 0; c != dimensions; ++c)
+                    batch.spherePositions[c].push_back(sphere.position()[c]);
+                batch.sphereRadii.push_back(sphere.radius());
+                batch.slots.emplace_back(Batch::Kind::Sphere, batch.sphereIds.size());
+                batch.sphereIds.push_back(i);
+            } break;
+
+            case Type::AxisAlignedBox: {
+                const AxisAlignedBox<dimensions>& box = static_cast<const Implementation::Shape<AxisAlignedBox<dimensions>>&>(transformed).shape;
+                for(UnsignedInt c = 0; c != dimensions; ++c) {
+                    batch.boxMin[c].push_back(box.min()[c]);
+                    batch.boxMax[c].push_back(box.max()[c]);
+                }
+                batch.slots.emplace_back(Batch::Kind::AxisAlignedBox, batch.boxIds.size());
+                batch.boxIds.push_back(i);
+            } break;
+
+            default:
+                batch.slots.emplace_back(Batch::Kind::Other, batch.otherIds.size());
+                batch.otherIds.push_back(i);
+        }
+    }
+
+    for(UnsignedInt c = 0; c != dimensions; ++c) {
+        pad(batch.pointPositions[c]);
+        pad(batch.spherePositions[c]);
+        pad(batch.boxMin[c]);
+        pad(batch.boxMax[c]);
+    }
+    pad(batch.sphereRadii);
+
+    _batchDirty = false;
+}
+
+template<UnsignedInt dimensions> template<class T> std::vector<Int> ShapeGroup<dimensions>::firstCollisionsInternal(const Containers::ArrayView<const T> queries) {
+    setClean();
+    updateBatch();
+
+    std::vector<Int> out(queries.size());
+    const Batch& batch = *_batch;
+    Magnum::Implementation::parallelForEach(queries.size(), _threadCount, [this, &batch, &queries, &out](const std::size_t i) {
+        out[i] = batchFirstCollision(*this, batch, queries[i]);
+    });
+
+    return out;
+}
+
+template<UnsignedInt dimensions> std::vector<Int> ShapeGroup<dimensions>::firstCollisions(const Containers::ArrayView<const Point<dimensions>> points) {
+    return firstCollisionsInternal(points);
+}
+
+template<UnsignedInt dimensions> std::vector<Int> ShapeGroup<dimensions>::firstCollisions(const Containers::ArrayView<const Sphere<dimensions>> spheres) {
+    return firstCollisionsInternal(spheres);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<2>;
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<3>;
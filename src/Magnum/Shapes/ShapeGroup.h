@@ -29,8 +29,14 @@
  * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
  */
 
+#include <memory>
+#include <utility>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/Shapes/AbstractShape.h"
 #include "Magnum/Shapes/visibility.h"
@@ -41,18 +47,146 @@ namespace Magnum { namespace Shapes {
 @brief Group of shapes
 
 See @ref Shape for more information. See @ref shapes for brief introduction.
+
+@section ShapeGroup-broadphase Broadphase
+
+By default, @ref firstCollision(), @ref allCollisions() and
+@ref collidingPairs() test the shapes against each other one by one, which is
+linear for single query and quadratic for all pairs. With
+@ref setBroadphaseEnabled() the group keeps axis-aligned bounds of all
+transformed shapes (see @ref AbstractShape::bounds()) sorted along the X axis
+and the actual collision detection is done only for shapes with overlapping
+bounds (sweep and prune). The bounds are recalculated in @ref setClean() only
+for shapes whose objects were marked dirty and the sort order is updated
+incrementally, which is close to linear if the shapes move coherently between
+frames.
+@code
+Shapes::ShapeGroup3D shapes;
+shapes.setBroadphaseEnabled(true);
+
+// ...
+
+for(const auto& pair: shapes.collidingPairs())
+    resolve(*pair.first, *pair.second);
+@endcode
+
+@section ShapeGroup-batch Batch queries
+
+@ref firstCollisions() tests a whole array of query points or spheres against
+the group at once and returns a compact array of indices of colliding shapes.
+Points, spheres and axis-aligned boxes in the group are kept in
+structure-of-arrays layout, updated in @ref setClean() only when the group is
+dirty, and tested 4 or 8 at a time using SSE2 or AVX if enabled in compiler
+flags. The queries are distributed across multiple threads, see
+@ref setThreadCount(). Other shape types are tested one by one through the
+usual collision dispatch, so the results are always the same as with
+@ref firstCollision().
+@code
+std::vector<Shapes::Point3D> bullets;
+std::vector<Int> hits = shapes.firstCollisions(bullets);
+for(std::size_t i = 0; i != hits.size(); ++i)
+    if(hits[i] != -1) hit(bullets[i], shapes[hits[i]]);
+@endcode
+
+@section ShapeGroup-contacts Contacts
+
+@ref contacts() calculates collision data for a whole array of shape pairs at
+once, for example the ones returned by @ref candidatePairs(), and writes them
+to a preallocated array. The pairs are distributed across multiple threads and
+points and spheres are taken from the same structure-of-arrays data as in
+batch queries, so there's no allocation and no virtual call per pair in the
+common case.
+@code
+std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs = shapes.candidatePairs();
+std::vector<Shapes::Collision3D> contacts(pairs.size());
+shapes.contacts({pairs.data(), pairs.size()}, {contacts.data(), contacts.size()});
+for(std::size_t i = 0; i != pairs.size(); ++i)
+    if(contacts[i]) resolve(pairs[i], contacts[i]);
+@endcode
+
+@section ShapeGroup-raycast Ray casting
+
+@ref raycast() returns the nearest shape hit by given ray together with the
+distance to it, for example for mouse picking. If broadphase is enabled,
+shapes whose bounds are not hit by the ray or are farther than the nearest hit
+found so far are skipped without testing the actual shape. A batch of rays can
+be cast at once, distributed across multiple threads similarly to batch
+collision queries.
+@code
+Shapes::ShapeGroup3D::RaycastHit hit = shapes.raycast(cameraPosition, direction);
+if(hit.shape) select(*hit.shape, cameraPosition + direction*hit.distance);
+@endcode
+
+@section ShapeGroup-sweep Continuous collision detection
+
+Fast moving shapes can pass through thin shapes between two frames without
+ever colliding with them at the discrete positions. @ref sweep() moves given
+point, sphere or capsule by given displacement and returns the first shape
+hit on the way together with the time of impact as a fraction of the
+displacement, so one query can be done instead of several sub-steps. Only the
+query moves, shapes in the group are treated as static. If broadphase is
+enabled, shapes whose bounds are not hit by the swept bounds of the query or
+are hit later than the first hit found so far are skipped.
+@code
+Vector3 previous = bullet.absoluteTransformation().translation();
+bullet.translate(velocity*timeDelta);
+Vector3 current = bullet.absoluteTransformation().translation();
+
+Shapes::ShapeGroup3D::SweepHit hit = shapes.sweep(Shapes::Sphere3D{previous, 0.1f}, current - previous);
+if(hit.shape) explode(previous + (current - previous)*hit.time);
+@endcode
+
 @see @ref scenegraph, @ref ShapeGroup2D, @ref ShapeGroup3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float> {
     friend AbstractShape<dimensions>;
 
     public:
+        /**
+         * @brief Ray cast hit
+         *
+         * @see @ref raycast()
+         */
+        struct RaycastHit {
+            /** @brief Hit shape or `nullptr` if nothing was hit */
+            AbstractShape<dimensions>* shape;
+
+            /**
+             * @brief Distance from ray origin to the hit
+             *
+             * Zero if the origin is inside the shape, `maxDistance` passed to
+             * @ref raycast() if nothing was hit.
+             */
+            Float distance;
+        };
+
+        /**
+         * @brief Sweep hit
+         *
+         * @see @ref sweep()
+         */
+        struct SweepHit {
+            /** @brief Hit shape or `nullptr` if nothing was hit */
+            AbstractShape<dimensions>* shape;
+
+            /**
+             * @brief Time of impact
+             *
+             * Fraction of the displacement at which the query first touches
+             * the shape. Zero if the query collides with the shape already at
+             * the start, `1.0f` if nothing was hit.
+             */
+            Float time;
+        };
+
         /**
          * @brief Constructor
          *
          * Marks the group as dirty.
          */
-        explicit ShapeGroup(): dirty(true) {}
+        explicit ShapeGroup();
+
+        ~ShapeGroup();
 
         /**
          * @brief Whether the group is dirty
@@ -74,10 +208,21 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. Unless shapes were added to or removed
+         * from the group since the last call, only objects of shapes that
+         * were marked dirty in the meantime are cleaned.
+         * @see @ref cleanedCount()
          */
         void setClean();
 
+        /**
+         * @brief Count of shapes cleaned in last @ref setClean() call
+         *
+         * If group membership changed since previous @ref setClean() call,
+         * all shapes in the group are cleaned.
+         */
+        std::size_t cleanedCount() const { return _cleanedCount; }
+
         /**
          * @brief First collision of given shape with other shapes in the group
          *
@@ -87,8 +232,208 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief All collisions of given shape with other shapes in the group
+         *
+         * Returns all shapes colliding with given one, except the shape
+         * itself. Calls @ref setClean() before the operation. The order is
+         * unspecified if broadphase is enabled.
+         * @see @ref setBroadphaseEnabled()
+         */
+        std::vector<AbstractShape<dimensions>*> allCollisions(const AbstractShape<dimensions>& shape);
+
+        /**
+         * @brief All pairs of colliding shapes in the group
+         *
+         * Each colliding pair is returned only once. Calls @ref setClean()
+         * before the operation. The order is unspecified if broadphase is
+         * enabled.
+         * @see @ref setBroadphaseEnabled()
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> collidingPairs();
+
+        /**
+         * @brief Whether broadphase is enabled
+         *
+         * @see @ref setBroadphaseEnabled()
+         */
+        bool isBroadphaseEnabled() const { return _broadphaseEnabled; }
+
+        /**
+         * @brief Enable or disable broadphase
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref ShapeGroup-broadphase "class documentation" for more
+         * information. Disabled by default.
+         */
+        ShapeGroup<dimensions>& setBroadphaseEnabled(bool enabled);
+
+        /**
+         * @brief First collisions of a batch of points
+         * @return For each query point the index of the first colliding
+         *      shape in the group, `-1` if there is no collision
+         *
+         * Calls @ref setClean() before the operation. See
+         * @ref ShapeGroup-batch "class documentation" for more information.
+         */
+        std::vector<Int> firstCollisions(Containers::ArrayView<const Point<dimensions>> points);
+
+        /**
+         * @brief First collisions of a batch of spheres
+         * @return For each query sphere the index of the first colliding
+         *      shape in the group, `-1` if there is no collision
+         *
+         * Calls @ref setClean() before the operation. See
+         * @ref ShapeGroup-batch "class documentation" for more information.
+         */
+        std::vector<Int> firstCollisions(Containers::ArrayView<const Sphere<dimensions>> spheres);
+
+        /**
+         * @brief Nearest shape hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, expected to be normalized
+         * @param maxDistance   Maximal distance of the hit
+         *
+         * Returns shape whose surface is nearest to @p origin along the ray
+         * and closer than @p maxDistance. Points, lines and line segments
+         * have no volume and are never hit, compositions are not supported
+         * yet. Calls @ref setClean() before the operation. See
+         * @ref ShapeGroup-raycast "class documentation" for more information.
+         */
+        RaycastHit raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief Nearest shapes hit by a batch of rays
+         *
+         * Same as calling @ref raycast(const VectorTypeFor<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, Float)
+         * for each pair of origin and direction, but calls @ref setClean()
+         * only once and distributes the rays across multiple threads, see
+         * @ref setThreadCount(). Expects that both arrays have the same
+         * size.
+         */
+        std::vector<RaycastHit> raycast(Containers::ArrayView<const VectorTypeFor<dimensions, Float>> origins, Containers::ArrayView<const VectorTypeFor<dimensions, Float>> directions, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief First shape hit by a moving point
+         * @param point         Point at the start of the motion
+         * @param displacement  Motion of the point
+         *
+         * Returns the shape hit first when moving @p point by
+         * @p displacement. Points, lines and line segments have no volume,
+         * so they are hit only if the point moves exactly through them,
+         * compositions are not supported yet. Calls
+         * @ref setClean() before the operation. See
+         * @ref ShapeGroup-sweep "class documentation" for more information.
+         */
+        SweepHit sweep(const Point<dimensions>& point, const VectorTypeFor<dimensions, Float>& displacement);
+
+        /**
+         * @brief First shape hit by a moving sphere
+         *
+         * Similar to @ref sweep(const Point<dimensions>&, const VectorTypeFor<dimensions, Float>&),
+         * except that also points, lines and line segments can be hit.
+         * Boxes are hit conservatively, thus the sphere can hit their
+         * corners slightly earlier than it should.
+         */
+        SweepHit sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement);
+
+        /**
+         * @brief First shape hit by a moving capsule
+         *
+         * Similar to @ref sweep(const Sphere<dimensions>&, const VectorTypeFor<dimensions, Float>&).
+         * The time of impact is exact only for points and spheres, other
+         * shapes are hit by a bounding sphere of the capsule, thus possibly
+         * earlier than they should.
+         */
+        SweepHit sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement);
+
+        /**
+         * @brief Pairs of shapes with overlapping bounds
+         * @return Pairs of shape indices, the first index in each pair is
+         *      always smaller
+         *
+         * Candidate pairs for @ref contacts(). Uses the broadphase if it is
+         * enabled, otherwise the bounds of all pairs are compared against
+         * each other. The order is unspecified if broadphase is enabled.
+         * Calls @ref setClean() before the operation.
+         */
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> candidatePairs();
+
+        /**
+         * @brief Contacts of a batch of shape pairs
+         * @param pairs         Pairs of shape indices, for example from
+         *      @ref candidatePairs()
+         * @param[out] contacts Where to put the contacts
+         *
+         * For each pair writes collision of the first shape with the second
+         * into the same position in @p contacts, see @ref Collision for
+         * details. Pairs which don't collide or for which the collision data
+         * are not implemented get empty @ref Collision. Expects that both
+         * arrays have the same size and the indices are in range. Calls
+         * @ref setClean() before the operation. See
+         * @ref ShapeGroup-contacts "class documentation" for more
+         * information.
+         */
+        void contacts(Containers::ArrayView<const std::pair<UnsignedInt, UnsignedInt>> pairs, Containers::ArrayView<Collision<dimensions>> contacts);
+
+        /** @brief Thread count */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set thread count
+         * @return Reference to self (for method chaining)
+         *
+         * Maximal count of threads used in @ref firstCollisions(),
+         * @ref contacts() and batch @ref raycast(), `0` means all workers
+         * of @ref TaskScheduler::global(). Small batches are always
+         * processed on the calling thread only. Default is `0`.
+         */
+        ShapeGroup<dimensions>& setThreadCount(UnsignedInt count) {
+            _threadCount = count;
+            return *this;
+        }
+
     private:
+        struct BroadphaseEntry {
+            AbstractShape<dimensions>* shape;
+            RangeTypeFor<dimensions, Float> bounds;
+            UnsignedInt id;
+        };
+
+        struct Batch;
+
+        void MAGNUM_SHAPES_LOCAL updateBroadphase();
+        void MAGNUM_SHAPES_LOCAL updateBatch();
+        template<class T> std::vector<Int> MAGNUM_SHAPES_LOCAL firstCollisionsInternal(Containers::ArrayView<const T> queries);
+        RaycastHit MAGNUM_SHAPES_LOCAL raycastInternal(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance);
+        template<class F> SweepHit MAGNUM_SHAPES_LOCAL sweepInternal(const RangeTypeFor<dimensions, Float>& bounds, const VectorTypeFor<dimensions, Float>& displacement, F timeOfImpact);
+
         bool dirty;
+        bool _broadphaseEnabled;
+        bool _batchDirty;
+        UnsignedInt _threadCount;
+        std::size_t _cleanedCount;
+
+        /* Shapes marked dirty since last setClean(), and all shapes in group
+           order at the time of last setClean() to detect added and removed
+           shapes, which would make the list unreliable */
+        std::vector<AbstractShape<dimensions>*> _dirtyShapes;
+        std::vector<AbstractShape<dimensions>*> _cleanShapes;
+
+        /* Objects passed to SceneGraph in setClean(), kept to avoid
+           allocations */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _cleanObjects;
+
+        /* Structure-of-arrays copy of simple shapes for batch queries,
+           allocated on first use */
+        std::unique_ptr<Batch> _batch;
+
+        /* Shapes in group order at the time of last update, used to detect
+           added and removed shapes */
+        std::vector<AbstractShape<dimensions>*> _broadphaseShapes;
+
+        /* Shape bounds sorted by minimal X coordinate */
+        std::vector<BroadphaseEntry> _broadphase;
 };
 
 /**
@@ -43,6 +43,8 @@ struct CompositionTest: TestSuite::Tester {
     void multipleUnary();
     void hierarchy();
     void empty();
+    void compiled();
+    void boundsRejection();
 
     void copy();
     void move();
@@ -56,6 +58,8 @@ CompositionTest::CompositionTest() {
               &CompositionTest::multipleUnary,
               &CompositionTest::hierarchy,
               &CompositionTest::empty,
+              &CompositionTest::compiled,
+              &CompositionTest::boundsRejection,
 
               &CompositionTest::copy,
               &CompositionTest::move,
@@ -132,6 +136,38 @@ void CompositionTest::empty() {
     VERIFY_NOT_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
 }
 
+void CompositionTest::compiled() {
+    const Shapes::Composition2D a =
+        (Shapes::Sphere2D({}, 1.0f) && !Shapes::Sphere2D({0.5f, 0.0f}, 0.25f)) ||
+        (Shapes::Sphere2D({5.0f, 0.0f}, 1.0f) && Shapes::AxisAlignedBox2D({4.0f, -1.0f}, {6.0f, 0.0f}));
+
+    CORRADE_COMPARE(a.size(), 4);
+
+    /* Left side of OR */
+    VERIFY_COLLIDES(a, Shapes::Point2D({}));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D({0.5f, 0.0f}));
+
+    /* Right side of OR */
+    VERIFY_COLLIDES(a, Shapes::Point2D({5.0f, -0.5f}));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D({5.0f, 0.5f}));
+
+    /* Neither */
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D({10.0f, 0.0f}));
+}
+
+void CompositionTest::boundsRejection() {
+    /* Complement is not bounded, so it isn't rejected far away */
+    const Shapes::Composition2D a = !Shapes::Sphere2D({}, 1.0f);
+    VERIFY_COLLIDES(a, Shapes::Point2D({100.0f, 100.0f}));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D({0.5f, 0.0f}));
+
+    /* Ring, bounded by the outer sphere */
+    const Shapes::Composition2D b = Shapes::Sphere2D({}, 1.0f) && !Shapes::Sphere2D({}, 0.5f);
+    VERIFY_COLLIDES(b, Shapes::Point2D({0.75f, 0.0f}));
+    VERIFY_NOT_COLLIDES(b, Shapes::Point2D({0.25f, 0.0f}));
+    VERIFY_NOT_COLLIDES(b, Shapes::Point2D({100.0f, 100.0f}));
+}
+
 void CompositionTest::copy() {
     const Shapes::Composition3D a = Shapes::Sphere3D({}, 1.0f) &&
         (Shapes::Point3D(Vector3::xAxis(1.5f)) || !Shapes::AxisAlignedBox3D({}, Vector3(0.5f)));
@@ -146,6 +182,11 @@ void CompositionTest::copy() {
     c = a;
     CORRADE_COMPARE(c.size(), 3);
     CORRADE_COMPARE(c.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
+
+    /* The compiled program is copied too */
+    VERIFY_COLLIDES(b, Shapes::Point3D(Vector3::xAxis(0.75f)));
+    VERIFY_COLLIDES(c, Shapes::Point3D(Vector3::xAxis(0.75f)));
+    VERIFY_NOT_COLLIDES(c, Shapes::Point3D(Vector3(0.25f)));
 }
 
 void CompositionTest::move() {
@@ -158,6 +199,8 @@ void CompositionTest::move() {
         CORRADE_COMPARE(a.size(), 0);
         CORRADE_COMPARE(b.size(), 3);
         CORRADE_COMPARE(b.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
+        VERIFY_COLLIDES(b, Shapes::Point3D(Vector3::xAxis(0.75f)));
+        VERIFY_NOT_COLLIDES(a, Shapes::Point3D(Vector3::xAxis(0.75f)));
     } {
         Shapes::Composition3D a = Shapes::Sphere3D({}, 1.0f) &&
             (Shapes::Point3D(Vector3::xAxis(1.5f)) || !Shapes::AxisAlignedBox3D({}, Vector3(0.5f)));
@@ -181,6 +224,12 @@ void CompositionTest::transformed() {
     CORRADE_COMPARE(b.get<Shapes::Point2D>(1).position(), Vector2(3.0f, -7.0f));
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).min(), Vector2(1.5f, -7.0f));
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(2.0f, -6.5f));
+
+    /* Bounds used for early rejection are updated as well */
+    VERIFY_COLLIDES(a, Shapes::Point2D({-0.5f, 0.0f}));
+    VERIFY_NOT_COLLIDES(b, Shapes::Point2D({-0.5f, 0.0f}));
+    VERIFY_COLLIDES(b, Shapes::Point2D({1.0f, -7.0f}));
+    VERIFY_NOT_COLLIDES(b, Shapes::Point2D({1.75f, -6.75f}));
 }
 
 }}}
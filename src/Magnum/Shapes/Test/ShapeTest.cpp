@@ -23,9 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <memory>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/Line.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Shape.h"
 #include "Magnum/Shapes/ShapeGroup.h"
@@ -40,10 +50,33 @@ struct ShapeTest: TestSuite::Tester {
     explicit ShapeTest();
 
     void clean();
+    void cleanOnlyDirty();
     void collides();
     void collision();
     void firstCollision();
+    void allCollisions();
+    void collidingPairs();
     void shapeGroup();
+    void shapeGroupCollisionComposition();
+
+    void bounds();
+    void boundsComposition();
+    void broadphase();
+    void broadphaseIncremental();
+    void broadphaseAddRemove();
+    void broadphaseUnbounded();
+
+    void batchFirstCollisions();
+    void batchFirstCollisionsThreaded();
+
+    void raycast();
+    void raycastBroadphase();
+    void raycastBatch();
+
+    void sweep();
+    void sweepBroadphase();
+
+    void contacts();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
@@ -53,10 +86,33 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 ShapeTest::ShapeTest() {
     addTests({&ShapeTest::clean,
+              &ShapeTest::cleanOnlyDirty,
               &ShapeTest::collides,
               &ShapeTest::collision,
               &ShapeTest::firstCollision,
-              &ShapeTest::shapeGroup});
+              &ShapeTest::allCollisions,
+              &ShapeTest::collidingPairs,
+              &ShapeTest::shapeGroup,
+              &ShapeTest::shapeGroupCollisionComposition,
+
+              &ShapeTest::bounds,
+              &ShapeTest::boundsComposition,
+              &ShapeTest::broadphase,
+              &ShapeTest::broadphaseIncremental,
+              &ShapeTest::broadphaseAddRemove,
+              &ShapeTest::broadphaseUnbounded,
+
+              &ShapeTest::batchFirstCollisions,
+              &ShapeTest::batchFirstCollisionsThreaded,
+
+              &ShapeTest::raycast,
+              &ShapeTest::raycastBroadphase,
+              &ShapeTest::raycastBatch,
+
+              &ShapeTest::sweep,
+              &ShapeTest::sweepBroadphase,
+
+              &ShapeTest::contacts});
 }
 
 void ShapeTest::clean() {
@@ -99,6 +155,71 @@ void ShapeTest::clean() {
     CORRADE_VERIFY(b.isDirty());
 }
 
+void ShapeTest::cleanOnlyDirty() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Point3D> aShape(a, {{1.0f, 0.0f, 0.0f}}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{2.0f, 0.0f, 0.0f}}, &shapes);
+
+    Object3D c(&b);
+    Shape<Shapes::Point3D> cShape(c, {{3.0f, 0.0f, 0.0f}}, &shapes);
+
+    /* Everything is cleaned the first time */
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 3u);
+
+    /* Nothing moved, nothing cleaned */
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 0u);
+
+    /* Only the moved object gets cleaned */
+    a.translate(Vector3::yAxis(1.0f));
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 1u);
+    CORRADE_COMPARE(aShape.transformedShape().position(), (Vector3{1.0f, 1.0f, 0.0f}));
+
+    /* Moving parent moves the children too, setting the shape dirties the
+       object, each is cleaned just once */
+    b.translate(Vector3::zAxis(1.0f));
+    c.translate(Vector3::zAxis(1.0f));
+    cShape.setShape({{4.0f, 0.0f, 0.0f}});
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 2u);
+    CORRADE_COMPARE(bShape.transformedShape().position(), (Vector3{2.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(cShape.transformedShape().position(), (Vector3{4.0f, 0.0f, 2.0f}));
+
+    /* Removing a shape cleans everything */
+    {
+        Object3D d(&scene);
+        Shape<Shapes::Point3D> dShape(d, &shapes);
+        d.translate(Vector3::xAxis(1.0f));
+        shapes.setClean();
+        CORRADE_COMPARE(shapes.cleanedCount(), 4u);
+
+        d.translate(Vector3::xAxis(1.0f));
+    }
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 3u);
+
+    /* A shape moved to another group gets cleaned there */
+    ShapeGroup3D other;
+    other.setClean();
+    a.translate(Vector3::yAxis(1.0f));
+    other.add(aShape);
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 2u);
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.cleanedCount(), 0u);
+    a.translate(Vector3::yAxis(1.0f));
+    other.setClean();
+    CORRADE_COMPARE(other.cleanedCount(), 1u);
+    CORRADE_COMPARE(aShape.transformedShape().position(), (Vector3{1.0f, 3.0f, 0.0f}));
+}
+
 void ShapeTest::collides() {
     Scene3D scene;
     ShapeGroup3D shapes;
@@ -206,6 +327,61 @@ void ShapeTest::firstCollision() {
     CORRADE_VERIFY(!shapes.isDirty());
 }
 
+void ShapeTest::allCollisions() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{1.0f, -2.0f, 3.0f}, 1.5f}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{2.0f, -2.0f, 3.0f}}, &shapes);
+
+    Object3D c(&scene);
+    Shape<Shapes::Point3D> cShape(c, {{5.0f, -2.0f, 3.0f}}, &shapes);
+
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{1.0f, -1.0f, 3.0f}}, &shapes);
+
+    CORRADE_COMPARE(shapes.allCollisions(aShape),
+        (std::vector<AbstractShape3D*>{&bShape, &dShape}));
+    CORRADE_COMPARE(shapes.allCollisions(cShape),
+        std::vector<AbstractShape3D*>{});
+
+    /* Move point into sphere */
+    c.translate(Vector3::xAxis(-3.5f));
+    CORRADE_COMPARE(shapes.allCollisions(aShape),
+        (std::vector<AbstractShape3D*>{&bShape, &cShape, &dShape}));
+    CORRADE_COMPARE(shapes.allCollisions(cShape),
+        std::vector<AbstractShape3D*>{&aShape});
+}
+
+void ShapeTest::collidingPairs() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Sphere2D> bShape(b, {{1.5f, 0.0f}, 1.0f}, &shapes);
+
+    Object2D c(&scene);
+    Shape<Shapes::Point2D> cShape(c, {{0.75f, 0.0f}}, &shapes);
+
+    Object2D d(&scene);
+    Shape<Shapes::Point2D> dShape(d, {{10.0f, 0.0f}}, &shapes);
+
+    typedef std::pair<AbstractShape2D*, AbstractShape2D*> Pair;
+    CORRADE_COMPARE(shapes.collidingPairs(),
+        (std::vector<Pair>{{&aShape, &bShape}, {&aShape, &cShape}, {&bShape, &cShape}}));
+
+    /* Move the second sphere away */
+    b.translate(Vector2::yAxis(5.0f));
+    CORRADE_COMPARE(shapes.collidingPairs(),
+        (std::vector<Pair>{{&aShape, &cShape}}));
+}
+
 void ShapeTest::shapeGroup() {
     Scene2D scene;
     ShapeGroup2D shapes;
@@ -222,6 +398,632 @@ void ShapeTest::shapeGroup() {
     CORRADE_COMPARE(point.position(), Vector2(5.25f, -1.0f));
 }
 
+void ShapeTest::shapeGroupCollisionComposition() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Ring */
+    Object2D a(&scene);
+    Shape<Shapes::Composition2D> aShape(a, Shapes::Sphere2D({}, 1.0f) && !Shapes::Sphere2D({}, 0.5f), &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{0.75f, 0.0f}}, &shapes);
+
+    /* Point inside the ring */
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == &aShape);
+
+    /* Point in the hole */
+    b.translate(Vector2::xAxis(-0.5f));
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+    CORRADE_VERIFY(!shapes.firstCollision(bShape));
+
+    /* Moving the ring updates the bounds of the compiled composition */
+    a.translate(Vector2::xAxis(10.0f));
+    b.translate(Vector2::xAxis(10.5f));
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == &aShape);
+
+    /* Composition with another composition */
+    Object2D c(&scene);
+    Shape<Shapes::Composition2D> cShape(c, Shapes::Point2D({9.25f, 0.0f}) || Shapes::Point2D({20.0f, 0.0f}), &shapes);
+    CORRADE_COMPARE(shapes.allCollisions(cShape),
+        std::vector<AbstractShape2D*>{&aShape});
+}
+
+void ShapeTest::bounds() {
+    Scene3D scene;
+    Object3D a(&scene);
+    a.translate({1.0f, 2.0f, 3.0f});
+
+    Shape<Shapes::Point3D> point(a, {{1.0f, 0.0f, -1.0f}});
+    Shape<Shapes::Sphere3D> sphere(a, {{}, 0.5f});
+    Shape<Shapes::LineSegment3D> segment(a, {{1.0f, -1.0f, 0.0f}, {-1.0f, 0.0f, 2.0f}});
+    Shape<Shapes::Capsule3D> capsule(a, {{1.0f, -1.0f, 0.0f}, {-1.0f, 0.0f, 2.0f}, 0.5f});
+    Shape<Shapes::AxisAlignedBox3D> aabb(a, {{-1.0f, -2.0f, -3.0f}, {1.0f, 0.0f, 0.0f}});
+    /* Unit box scaled and rotated by 90 degrees around Z */
+    Shape<Shapes::Box3D> box(a, {Matrix4::rotationZ(Deg(90.0f))*Matrix4::scaling({2.0f, 1.0f, 0.5f})});
+    Shape<Shapes::Line3D> line(a, {{}, Vector3::xAxis()});
+    a.setClean();
+
+    CORRADE_COMPARE(point.bounds(), Range3D({2.0f, 2.0f, 2.0f}, {2.0f, 2.0f, 2.0f}));
+    CORRADE_COMPARE(sphere.bounds(), Range3D({0.5f, 1.5f, 2.5f}, {1.5f, 2.5f, 3.5f}));
+    CORRADE_COMPARE(segment.bounds(), Range3D({0.0f, 1.0f, 3.0f}, {2.0f, 2.0f, 5.0f}));
+    CORRADE_COMPARE(capsule.bounds(), Range3D({-0.5f, 0.5f, 2.5f}, {2.5f, 2.5f, 5.5f}));
+    CORRADE_COMPARE(aabb.bounds(), Range3D({0.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 3.0f}));
+
+    const Range3D boxBounds = box.bounds();
+    CORRADE_COMPARE(boxBounds.min(), Vector3(0.0f, 0.0f, 2.5f));
+    CORRADE_COMPARE(boxBounds.max(), Vector3(2.0f, 4.0f, 3.5f));
+
+    /* Line is not bounded */
+    CORRADE_COMPARE(line.bounds(), Range3D(Vector3(-Constants::inf()), Vector3(Constants::inf())));
+}
+
+void ShapeTest::boundsComposition() {
+    Scene2D scene;
+    Object2D a(&scene);
+
+    /* OR is union of the operands */
+    Shape<Shapes::Composition2D> shapeOr(a, Shapes::Sphere2D({}, 0.5f) || Shapes::Point2D({2.0f, -1.0f}));
+    CORRADE_COMPARE(shapeOr.bounds(), Range2D({-0.5f, -1.0f}, {2.0f, 0.5f}));
+
+    /* AND is intersection of the operands */
+    Shape<Shapes::Composition2D> shapeAnd(a, Shapes::Sphere2D({}, 1.0f) && Shapes::Sphere2D({1.0f, 0.5f}, 1.0f));
+    CORRADE_COMPARE(shapeAnd.bounds(), Range2D({0.0f, -0.5f}, {1.0f, 1.0f}));
+
+    /* NOT is not bounded, thus neither OR with it */
+    Shape<Shapes::Composition2D> shapeNot(a, Shapes::Point2D({2.0f, -1.0f}) || !Shapes::Sphere2D({}, 0.5f));
+    CORRADE_COMPARE(shapeNot.bounds(), Range2D(Vector2(-Constants::inf()), Vector2(Constants::inf())));
+
+    /* ... but AND with it is */
+    Shape<Shapes::Composition2D> shapeAndNot(a, Shapes::Sphere2D({}, 1.0f) && !Shapes::Sphere2D({}, 0.5f));
+    CORRADE_COMPARE(shapeAndNot.bounds(), Range2D({-1.0f, -1.0f}, {1.0f, 1.0f}));
+}
+
+void ShapeTest::broadphase() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    ShapeGroup2D shapesBroadphase;
+    shapesBroadphase.setBroadphaseEnabled(true);
+    CORRADE_VERIFY(!shapes.isBroadphaseEnabled());
+    CORRADE_VERIFY(shapesBroadphase.isBroadphaseEnabled());
+
+    /* Grid of spheres with varying radius, some of them overlapping */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(Int i = 0; i != 10; ++i) for(Int j = 0; j != 10; ++j) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate(Vector2(Float(j), Float(i))*1.2f);
+        const Float radius = 0.4f + 0.1f*((i*7 + j*3) % 5);
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, radius}, &shapes);
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, radius}, &shapesBroadphase);
+    }
+
+    /* The order of broadphase results is unspecified, sort them by position
+       in the group to be able to compare */
+    auto pairsInGroupOrder = [](ShapeGroup2D& group) {
+        std::vector<std::pair<std::size_t, std::size_t>> out;
+        for(const auto& pair: group.collidingPairs()) {
+            std::size_t a = 0, b = 0;
+            for(std::size_t i = 0; i != group.size(); ++i) {
+                if(&group[i] == pair.first) a = i;
+                if(&group[i] == pair.second) b = i;
+            }
+            out.emplace_back(std::min(a, b), std::max(a, b));
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+
+    const auto expected = pairsInGroupOrder(shapes);
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_COMPARE(pairsInGroupOrder(shapesBroadphase), expected);
+
+    /* Single queries give the same result too */
+    for(std::size_t i = 0; i != shapes.size(); ++i) {
+        CORRADE_COMPARE(shapesBroadphase.allCollisions(shapesBroadphase[i]).size(),
+            shapes.allCollisions(shapes[i]).size());
+        CORRADE_COMPARE(!shapesBroadphase.firstCollision(shapesBroadphase[i]),
+            !shapes.firstCollision(shapes[i]));
+    }
+}
+
+void ShapeTest::broadphaseIncremental() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    shapes.setBroadphaseEnabled(true);
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Sphere2D> bShape(b, {{5.0f, 0.0f}, 1.0f}, &shapes);
+
+    Object2D c(&scene);
+    Shape<Shapes::Point2D> cShape(c, {{10.0f, 0.0f}}, &shapes);
+
+    CORRADE_VERIFY(shapes.collidingPairs().empty());
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Move the point over both spheres so the sort order changes */
+    c.translate(Vector2::xAxis(-9.5f));
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_COMPARE(shapes.allCollisions(cShape),
+        std::vector<AbstractShape2D*>{&aShape});
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    c.translate(Vector2::xAxis(5.0f));
+    CORRADE_COMPARE(shapes.allCollisions(cShape),
+        std::vector<AbstractShape2D*>{&bShape});
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == nullptr);
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == &cShape);
+
+    /* Changing the shape itself updates the bounds too */
+    aShape.setShape({{}, 6.0f});
+    CORRADE_COMPARE(shapes.allCollisions(aShape),
+        (std::vector<AbstractShape2D*>{&bShape, &cShape}));
+}
+
+void ShapeTest::broadphaseAddRemove() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    shapes.setBroadphaseEnabled(true);
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{}}, &shapes);
+
+    typedef std::pair<AbstractShape2D*, AbstractShape2D*> Pair;
+    CORRADE_COMPARE(shapes.collidingPairs().size(), 1);
+
+    {
+        /* Added shape is picked up */
+        Object2D c(&scene);
+        Shape<Shapes::Point2D> cShape(c, {{0.5f, 0.0f}}, &shapes);
+        CORRADE_COMPARE(shapes.collidingPairs().size(), 2);
+        CORRADE_COMPARE(shapes.allCollisions(cShape),
+            std::vector<AbstractShape2D*>{&aShape});
+    }
+
+    /* Destroyed shape is removed */
+    CORRADE_COMPARE(shapes.collidingPairs().size(), 1);
+
+    /* Removed shape is not reported anymore */
+    shapes.remove(bShape);
+    CORRADE_VERIFY(shapes.collidingPairs().empty());
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+
+    /* Re-enabling works as well */
+    shapes.add(bShape);
+    shapes.setBroadphaseEnabled(false);
+    shapes.setBroadphaseEnabled(true);
+    CORRADE_COMPARE(shapes.collidingPairs().size(), 1);
+    CORRADE_VERIFY(shapes.collidingPairs().front() == Pair(&aShape, &bShape) ||
+                   shapes.collidingPairs().front() == Pair(&bShape, &aShape));
+}
+
+void ShapeTest::broadphaseUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    shapes.setBroadphaseEnabled(true);
+
+    Object3D a(&scene);
+    Shape<Shapes::Line3D> aShape(a, {{}, Vector3::xAxis()}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{100.0f, 0.5f, 0.0f}, 1.0f}, &shapes);
+
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{-100.0f, 5.0f, 0.0f}, 1.0f}, &shapes);
+
+    /* Infinite bounds of the line should not prevent collision detection
+       with shapes far away */
+    CORRADE_COMPARE(shapes.allCollisions(aShape),
+        std::vector<AbstractShape3D*>{&bShape});
+    CORRADE_COMPARE(shapes.allCollisions(bShape),
+        std::vector<AbstractShape3D*>{&aShape});
+    CORRADE_VERIFY(shapes.allCollisions(cShape).empty());
+}
+
+void ShapeTest::batchFirstCollisions() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::AxisAlignedBox3D> bShape(b, {Vector3{4.0f}, Vector3{6.0f}}, &shapes);
+
+    Object3D c(&scene);
+    Shape<Shapes::Point3D> cShape(c, {{10.0f, 0.0f, 0.0f}}, &shapes);
+
+    Object3D d(&scene);
+    Shape<Shapes::Capsule3D> dShape(d, {{20.0f, -1.0f, 0.0f}, {20.0f, 1.0f, 0.0f}, 0.5f}, &shapes);
+
+    Object3D e(&scene);
+    Shape<Shapes::Sphere3D> eShape(e, {{0.5f, 0.0f, 0.0f}, 1.0f}, &shapes);
+
+    /* More spheres than fits into a single SIMD register */
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<std::unique_ptr<Shape<Shapes::Sphere3D>>> spheres;
+    for(Int i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object3D{&scene});
+        spheres.emplace_back(new Shape<Shapes::Sphere3D>{*objects.back(), {{0.0f, 100.0f + i, 0.0f}, 0.25f}, &shapes});
+    }
+
+    const Shapes::Point3D points[]{
+        {{0.2f, 0.0f, 0.0f}},
+        {Vector3{5.0f}},
+        {{20.0f, 0.5f, 0.0f}},
+        {{1.3f, 0.0f, 0.0f}},
+        {Vector3{50.0f}},
+        {{0.0f, 107.1f, 0.0f}}};
+    CORRADE_COMPARE(shapes.firstCollisions(points),
+        (std::vector<Int>{0, 1, 3, 4, -1, 12}));
+
+    /* Sphere and box collision is not implemented, thus the last sphere
+       doesn't collide with anything, consistently with firstCollision() */
+    const Shapes::Sphere3D queries[]{
+        {{10.0f, 0.5f, 0.0f}, 1.0f},
+        {{20.0f, 2.0f, 0.0f}, 1.0f},
+        {{1.8f, 0.0f, 0.0f}, 0.5f},
+        {Vector3{5.0f}, 0.5f}};
+    CORRADE_COMPARE(shapes.firstCollisions(queries),
+        (std::vector<Int>{2, 3, 4, -1}));
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* The results should be the same as with firstCollision() */
+    for(const Shapes::Point3D& point: points) {
+        Object3D o(&scene);
+        Shape<Shapes::Point3D> shape(o, point);
+        o.setClean();
+
+        AbstractShape3D* const collision = shapes.firstCollision(shape);
+        Int expected = -1;
+        for(std::size_t i = 0; i != shapes.size(); ++i)
+            if(&shapes[i] == collision) expected = i;
+        CORRADE_COMPARE(shapes.firstCollisions({&point, 1}).front(), expected);
+    }
+
+    /* Moving an object updates the batch */
+    a.translate(Vector3::xAxis(10.0f));
+    CORRADE_COMPARE(shapes.firstCollisions(points),
+        (std::vector<Int>{4, 1, 3, 4, -1, 12}));
+
+    /* Removing a shape too */
+    spheres.pop_back();
+    CORRADE_COMPARE(shapes.firstCollisions(points),
+        (std::vector<Int>{4, 1, 3, 4, -1, 12}));
+    spheres.erase(spheres.begin() + 7);
+    CORRADE_COMPARE(shapes.firstCollisions(points),
+        (std::vector<Int>{4, 1, 3, 4, -1, -1}));
+}
+
+void ShapeTest::batchFirstCollisionsThreaded() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    CORRADE_COMPARE(shapes.threadCount(), 0u);
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{3.0f, 0.0f}}, &shapes);
+
+    std::vector<Shapes::Sphere2D> queries;
+    for(Int i = 0; i != 1000; ++i)
+        queries.push_back({{Float(i%5), 0.0f}, 0.5f});
+
+    shapes.setThreadCount(4);
+    CORRADE_COMPARE(shapes.threadCount(), 4u);
+
+    const std::vector<Int> out = shapes.firstCollisions({queries.data(), queries.size()});
+    CORRADE_COMPARE(out.size(), 1000u);
+    for(std::size_t i = 0; i != out.size(); ++i)
+        CORRADE_COMPARE(out[i], i%5 == 0 || i%5 == 1 ? 0 : i%5 == 3 ? 1 : -1);
+}
+
+void ShapeTest::raycast() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{10.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::AxisAlignedBox3D> bShape(b, {{4.0f, -1.0f, -1.0f}, {6.0f, 1.0f, 1.0f}}, &shapes);
+    b.translate(Vector3::yAxis(5.0f));
+
+    Object3D c(&scene);
+    Shape<Shapes::Box3D> cShape(c, {Matrix4::scaling(Vector3{0.5f})}, &shapes);
+    c.rotateZ(Deg(45.0f))
+     .translate(Vector3::zAxis(5.0f));
+
+    Object3D d(&scene);
+    Shape<Shapes::Capsule3D> dShape(d, {{0.0f, 0.0f, -10.0f}, {0.0f, 0.0f, -8.0f}, 0.5f}, &shapes);
+
+    Object3D e(&scene);
+    Shape<Shapes::Point3D> eShape(e, {{-3.0f, 0.0f, 0.0f}}, &shapes);
+
+    /* Nearest of the two spheres on the ray */
+    Object3D f(&scene);
+    Shape<Shapes::Sphere3D> fShape(f, {{20.0f, 0.0f, 0.0f}, 5.0f}, &shapes);
+    ShapeGroup3D::RaycastHit hit = shapes.raycast({}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape == &aShape);
+    CORRADE_COMPARE(hit.distance, 9.0f);
+    hit = shapes.raycast({}, Vector3::xAxis(), 5.0f);
+    CORRADE_VERIFY(!hit.shape);
+    CORRADE_COMPARE(hit.distance, 5.0f);
+
+    /* Transformed axis-aligned box */
+    hit = shapes.raycast({0.0f, 5.0f, 0.0f}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape == &bShape);
+    CORRADE_COMPARE(hit.distance, 4.0f);
+
+    /* Rotated box, hit in the corner */
+    hit = shapes.raycast({-5.0f, 0.0f, 5.0f}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape == &cShape);
+    CORRADE_COMPARE(hit.distance, 5.0f - Constants::sqrt2()*0.5f);
+
+    /* Capsule, hit on the cap */
+    hit = shapes.raycast({}, -Vector3::zAxis());
+    CORRADE_VERIFY(hit.shape == &dShape);
+    CORRADE_COMPARE(hit.distance, 7.5f);
+
+    /* Points are never hit */
+    hit = shapes.raycast({}, -Vector3::xAxis());
+    CORRADE_VERIFY(!hit.shape);
+    CORRADE_COMPARE(hit.distance, Constants::inf());
+
+    /* Origin inside */
+    hit = shapes.raycast({10.0f, 0.5f, 0.0f}, Vector3::yAxis());
+    CORRADE_VERIFY(hit.shape == &aShape);
+    CORRADE_COMPARE(hit.distance, 0.0f);
+}
+
+void ShapeTest::raycastBroadphase() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    ShapeGroup3D broadphaseShapes;
+    broadphaseShapes.setBroadphaseEnabled(true);
+
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<std::unique_ptr<AbstractShape3D>> features;
+    for(Int i = 0; i != 20; ++i) {
+        objects.emplace_back(new Object3D{&scene});
+        const Vector3 position{Float(i%5)*3.0f - 6.0f, Float(i/5)*3.0f - 6.0f, Float(i%3) - 1.0f};
+        if(i % 2) features.emplace_back(new Shape<Shapes::Sphere3D>{*objects.back(), {position, 1.0f}, &shapes});
+        else features.emplace_back(new Shape<Shapes::AxisAlignedBox3D>{*objects.back(), {position - Vector3{0.75f}, position + Vector3{0.75f}}, &shapes});
+
+        /* The same shapes in the other group */
+        objects.emplace_back(new Object3D{&scene});
+        if(i % 2) features.emplace_back(new Shape<Shapes::Sphere3D>{*objects.back(), {position, 1.0f}, &broadphaseShapes});
+        else features.emplace_back(new Shape<Shapes::AxisAlignedBox3D>{*objects.back(), {position - Vector3{0.75f}, position + Vector3{0.75f}}, &broadphaseShapes});
+    }
+
+    /* Infinite cylinder should be found even though it's out of all other
+       bounds */
+    Object3D cylinder(&scene);
+    Shape<Shapes::Cylinder3D> cylinderShape(cylinder, {{-100.0f, 0.0f, 0.0f}, {-100.0f, 1.0f, 0.0f}, 1.0f}, &broadphaseShapes);
+
+    const Vector3 directions[]{
+        Vector3::xAxis(),
+        -Vector3::xAxis(),
+        Vector3::yAxis(),
+        -Vector3::yAxis(),
+        Vector3{1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{-1.0f, 0.5f, 0.25f}.normalized()};
+    for(const Vector3& direction: directions) {
+        for(Int i = 0; i != 10; ++i) {
+            const Vector3 origin{Float(i) - 15.0f, Float(i%4) - 1.5f, 0.0f};
+            const ShapeGroup3D::RaycastHit hit = shapes.raycast(origin, direction, 50.0f);
+            const ShapeGroup3D::RaycastHit broadphaseHit = broadphaseShapes.raycast(origin, direction, 50.0f);
+            if(hit.shape && broadphaseHit.shape != &cylinderShape) {
+                CORRADE_VERIFY(broadphaseHit.shape);
+                CORRADE_COMPARE(broadphaseHit.distance, hit.distance);
+            } else if(!hit.shape) CORRADE_VERIFY(!broadphaseHit.shape || broadphaseHit.shape == &cylinderShape);
+        }
+    }
+
+    const ShapeGroup3D::RaycastHit hit = broadphaseShapes.raycast({-90.0f, 0.0f, 0.0f}, -Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape == &cylinderShape);
+    CORRADE_COMPARE(hit.distance, 9.0f);
+}
+
+void ShapeTest::raycastBatch() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    shapes.setThreadCount(3);
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{5.0f, 0.0f}, 1.0f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::AxisAlignedBox2D> bShape(b, {{-6.0f, -1.0f}, {-4.0f, 1.0f}}, &shapes);
+
+    std::vector<Vector2> origins;
+    std::vector<Vector2> directions;
+    for(Int i = 0; i != 1000; ++i) {
+        origins.push_back({});
+        directions.push_back(i % 3 == 0 ? Vector2::xAxis() : i % 3 == 1 ? -Vector2::xAxis() : Vector2::yAxis());
+    }
+
+    const std::vector<ShapeGroup2D::RaycastHit> hits = shapes.raycast(
+        {origins.data(), origins.size()}, {directions.data(), directions.size()});
+    CORRADE_COMPARE(hits.size(), 1000u);
+    for(std::size_t i = 0; i != hits.size(); ++i) {
+        CORRADE_VERIFY(hits[i].shape == (i % 3 == 0 ? &aShape : i % 3 == 1 ? static_cast<AbstractShape2D*>(&bShape) : nullptr));
+        CORRADE_COMPARE(hits[i].distance, i % 3 == 2 ? Constants::inf() : 4.0f);
+    }
+}
+
+void ShapeTest::sweep() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Thin wall */
+    Object3D a(&scene);
+    Shape<Shapes::AxisAlignedBox3D> aShape(a, {{4.9f, -5.0f, -5.0f}, {5.1f, 5.0f, 5.0f}}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{0.0f, 10.0f, 0.0f}, 1.0f}, &shapes);
+
+    Object3D c(&scene);
+    Shape<Shapes::Point3D> cShape(c, {{0.0f, -10.0f, 0.0f}}, &shapes);
+
+    Object3D d(&scene);
+    Shape<Shapes::Plane> dShape(d, {{0.0f, 0.0f, -20.0f}, Vector3::zAxis()}, &shapes);
+
+    /* Point tunneling through the wall, not colliding at either end */
+    ShapeGroup3D::SweepHit hit = shapes.sweep(Shapes::Point3D{}, Vector3::xAxis(10.0f));
+    CORRADE_VERIFY(hit.shape == &aShape);
+    CORRADE_COMPARE(hit.time, 0.49f);
+
+    /* Sphere hits the wall earlier */
+    hit = shapes.sweep(Shapes::Sphere3D{{}, 0.5f}, Vector3::xAxis(10.0f));
+    CORRADE_VERIFY(hit.shape == &aShape);
+    CORRADE_COMPARE(hit.time, 0.44f);
+
+    /* Sphere against sphere */
+    hit = shapes.sweep(Shapes::Sphere3D{{}, 0.5f}, Vector3::yAxis(10.0f));
+    CORRADE_VERIFY(hit.shape == &bShape);
+    CORRADE_COMPARE(hit.time, 0.85f);
+
+    /* Points are hit only by spheres and capsules */
+    hit = shapes.sweep(Shapes::Point3D{{0.25f, 0.0f, 0.0f}}, Vector3::yAxis(-20.0f));
+    CORRADE_VERIFY(!hit.shape);
+    CORRADE_COMPARE(hit.time, 1.0f);
+    hit = shapes.sweep(Shapes::Sphere3D{{}, 0.5f}, Vector3::yAxis(-20.0f));
+    CORRADE_VERIFY(hit.shape == &cShape);
+    CORRADE_COMPARE(hit.time, 0.475f);
+
+    /* Capsule against point is exact */
+    hit = shapes.sweep(Shapes::Capsule3D{{4.0f, -11.0f, 0.0f}, {4.0f, -9.0f, 0.0f}, 0.5f}, Vector3::xAxis(-10.0f));
+    CORRADE_VERIFY(hit.shape == &cShape);
+    CORRADE_COMPARE(hit.time, 0.35f);
+
+    /* Sphere against plane */
+    hit = shapes.sweep(Shapes::Sphere3D{{}, 1.0f}, Vector3::zAxis(-38.0f));
+    CORRADE_VERIFY(hit.shape == &dShape);
+    CORRADE_COMPARE(hit.time, 0.5f);
+
+    /* Not reaching the wall */
+    hit = shapes.sweep(Shapes::Sphere3D{{}, 0.5f}, Vector3::xAxis(4.0f));
+    CORRADE_VERIFY(!hit.shape);
+    CORRADE_COMPARE(hit.time, 1.0f);
+
+    /* Colliding already at the start */
+    hit = shapes.sweep(Shapes::Sphere3D{{5.0f, 0.0f, 0.0f}, 0.5f}, Vector3::xAxis(-10.0f));
+    CORRADE_VERIFY(hit.shape == &aShape);
+    CORRADE_COMPARE(hit.time, 0.0f);
+}
+
+void ShapeTest::sweepBroadphase() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    ShapeGroup2D broadphaseShapes;
+    broadphaseShapes.setBroadphaseEnabled(true);
+
+    std::vector<std::unique_ptr<Object2D>> objects;
+    std::vector<std::unique_ptr<AbstractShape2D>> features;
+    for(Int i = 0; i != 20; ++i) {
+        const Vector2 position{Float(i%5)*3.0f - 6.0f, Float(i/5)*3.0f - 6.0f};
+        for(ShapeGroup2D* group: {&shapes, &broadphaseShapes}) {
+            objects.emplace_back(new Object2D{&scene});
+            if(i % 2) features.emplace_back(new Shape<Shapes::Sphere2D>{*objects.back(), {position, 0.5f}, group});
+            else features.emplace_back(new Shape<Shapes::Point2D>{*objects.back(), {position}, group});
+        }
+    }
+
+    const Vector2 displacements[]{
+        Vector2::xAxis(20.0f),
+        Vector2::xAxis(-20.0f),
+        Vector2::yAxis(20.0f),
+        Vector2{-15.0f, 10.0f}};
+    for(const Vector2& displacement: displacements) {
+        for(Int i = 0; i != 10; ++i) {
+            const Shapes::Sphere2D sphere{{Float(i) - 5.0f, Float(i%4)*2.0f - 3.0f}, 0.25f};
+            const ShapeGroup2D::SweepHit hit = shapes.sweep(sphere, displacement);
+            const ShapeGroup2D::SweepHit broadphaseHit = broadphaseShapes.sweep(sphere, displacement);
+            CORRADE_COMPARE(!hit.shape, !broadphaseHit.shape);
+            CORRADE_COMPARE(broadphaseHit.time, hit.time);
+
+            const Shapes::Capsule2D capsule{sphere.position(), sphere.position() + Vector2::yAxis(), 0.25f};
+            const ShapeGroup2D::SweepHit capsuleHit = shapes.sweep(capsule, displacement);
+            const ShapeGroup2D::SweepHit capsuleBroadphaseHit = broadphaseShapes.sweep(capsule, displacement);
+            CORRADE_COMPARE(!capsuleHit.shape, !capsuleBroadphaseHit.shape);
+            CORRADE_COMPARE(capsuleBroadphaseHit.time, capsuleHit.time);
+        }
+    }
+}
+
+void ShapeTest::contacts() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    ShapeGroup2D broadphaseShapes;
+    broadphaseShapes.setBroadphaseEnabled(true);
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+    Shape<Shapes::Sphere2D> aShape2(a, {{}, 1.0f}, &broadphaseShapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Sphere2D> bShape(b, {{1.5f, 0.0f}, 1.0f}, &shapes);
+    Shape<Shapes::Sphere2D> bShape2(b, {{1.5f, 0.0f}, 1.0f}, &broadphaseShapes);
+
+    Object2D c(&scene);
+    Shape<Shapes::Point2D> cShape(c, {{0.75f, 0.0f}}, &shapes);
+    Shape<Shapes::Point2D> cShape2(c, {{0.75f, 0.0f}}, &broadphaseShapes);
+
+    Object2D d(&scene);
+    Shape<Shapes::Point2D> dShape(d, {{10.0f, 0.0f}}, &shapes);
+    Shape<Shapes::Point2D> dShape2(d, {{10.0f, 0.0f}}, &broadphaseShapes);
+
+    /* Collision data are not implemented for boxes */
+    Object2D e(&scene);
+    Shape<Shapes::AxisAlignedBox2D> eShape(e, {{9.0f, -1.0f}, {11.0f, 1.0f}}, &shapes);
+    Shape<Shapes::AxisAlignedBox2D> eShape2(e, {{9.0f, -1.0f}, {11.0f, 1.0f}}, &broadphaseShapes);
+
+    typedef std::pair<UnsignedInt, UnsignedInt> Pair;
+    std::vector<Pair> pairs = shapes.candidatePairs();
+    CORRADE_COMPARE(pairs, (std::vector<Pair>{{0, 1}, {0, 2}, {1, 2}, {3, 4}}));
+
+    std::vector<Pair> broadphasePairs = broadphaseShapes.candidatePairs();
+    std::sort(broadphasePairs.begin(), broadphasePairs.end());
+    CORRADE_COMPARE(broadphasePairs, pairs);
+
+    /* Point vs. sphere in flipped order */
+    pairs.emplace_back(2, 0);
+
+    std::vector<Collision2D> contacts(pairs.size());
+    shapes.contacts({pairs.data(), pairs.size()}, {contacts.data(), contacts.size()});
+
+    const Collision2D ab = aShape.shape()/bShape.shape();
+    CORRADE_VERIFY(contacts[0]);
+    CORRADE_COMPARE(contacts[0].position(), ab.position());
+    CORRADE_COMPARE(contacts[0].separationNormal(), Vector2(-1.0f, 0.0f));
+    CORRADE_COMPARE(contacts[0].separationDistance(), 0.5f);
+
+    const Collision2D ac = aShape.shape()/cShape.shape();
+    CORRADE_VERIFY(contacts[1]);
+    CORRADE_COMPARE(contacts[1].position(), ac.position());
+    CORRADE_COMPARE(contacts[1].separationNormal(), ac.separationNormal());
+    CORRADE_COMPARE(contacts[1].separationDistance(), 0.25f);
+
+    CORRADE_VERIFY(contacts[2]);
+    CORRADE_COMPARE(contacts[2].separationNormal(), Vector2(1.0f, 0.0f));
+    CORRADE_COMPARE(contacts[2].separationDistance(), 0.25f);
+
+    CORRADE_VERIFY(!contacts[3]);
+
+    CORRADE_VERIFY(contacts[4]);
+    CORRADE_COMPARE(contacts[4].position(), ac.flipped().position());
+    CORRADE_COMPARE(contacts[4].separationNormal(), Vector2(1.0f, 0.0f));
+    CORRADE_COMPARE(contacts[4].separationDistance(), 0.25f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeTest)
@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+TaskScheduler& TaskScheduler::global() {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_TARGET_NACL)
+    static TaskScheduler scheduler{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+    #else
+    static TaskScheduler scheduler{0};
+    #endif
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler(UnsignedInt workerCount) {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) || defined(CORRADE_TARGET_NACL)
+    workerCount = 0;
+    #endif
+
+    /* The queue count is read by the workers, so it has to be set before
+       they are started */
+    _queueCount = workerCount + 1;
+    _queues.reset(new Queue[_queueCount]);
+    _workers.reserve(workerCount);
+    for(UnsignedInt i = 0; i != workerCount; ++i)
+        _workers.emplace_back(&TaskScheduler::work, this, i);
+}
+
+TaskScheduler::~TaskScheduler() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _condition.notify_all();
+    for(std::thread& worker: _workers) worker.join();
+}
+
+auto TaskScheduler::add(std::function<void()> task, const std::vector<TaskId>& dependencies) -> TaskId {
+    TaskId id;
+    bool ready;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        id = _nextId++;
+        Task& t = _tasks[id];
+        t.function = std::move(task);
+        t.remainingDependencies = 0;
+
+        /* Finished tasks are already removed from the map */
+        for(const TaskId dependency: dependencies) {
+            CORRADE_ASSERT(dependency < id,
+                "TaskScheduler::add(): invalid dependency" << dependency, id);
+            const auto found = _tasks.find(dependency);
+            if(found == _tasks.end()) continue;
+            found->second.dependents.push_back(id);
+            ++t.remainingDependencies;
+        }
+
+        ready = !t.remainingDependencies;
+    }
+
+    if(ready) push(currentQueue(), id);
+    return id;
+}
+
+bool TaskScheduler::isFinished(const TaskId id) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _tasks.find(id) == _tasks.end();
+}
+
+void TaskScheduler::wait(const TaskId id) {
+    const std::size_t queue = currentQueue();
+    for(;;) {
+        if(isFinished(id)) return;
+        if(runNext(queue, queue != _queueCount - 1)) continue;
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this, id]() {
+            return _tasks.find(id) == _tasks.end() || _queuedCount;
+        });
+    }
+}
+
+void TaskScheduler::wait() {
+    const std::size_t queue = currentQueue();
+    for(;;) {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            if(_tasks.empty()) return;
+        }
+        if(runNext(queue, queue != _queueCount - 1)) continue;
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this]() {
+            return _tasks.empty() || _queuedCount;
+        });
+    }
+}
+
+void TaskScheduler::parallelFor(const std::size_t count, std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& function) {
+    grainSize = std::max(grainSize, std::size_t{1});
+
+    /* Nothing to parallelize, do it in order on the calling thread */
+    if(count <= grainSize || _workers.empty()) {
+        for(std::size_t begin = 0; begin < count; begin += grainSize)
+            function(begin, std::min(begin + grainSize, count));
+        return;
+    }
+
+    /* Add all subranges except the first, which is processed right away */
+    std::vector<TaskId> tasks;
+    tasks.reserve((count - 1)/grainSize);
+    for(std::size_t begin = grainSize; begin < count; begin += grainSize) {
+        const std::size_t end = std::min(begin + grainSize, count);
+        tasks.push_back(add([&function, begin, end]() { function(begin, end); }));
+    }
+
+    function(0, grainSize);
+    for(const TaskId id: tasks) wait(id);
+}
+
+void TaskScheduler::work(const std::size_t queue) {
+    for(;;) {
+        if(runNext(queue, true)) continue;
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this]() { return _quit || _queuedCount; });
+        if(_quit && !_queuedCount) return;
+    }
+}
+
+std::size_t TaskScheduler::currentQueue() const {
+    const std::thread::id current = std::this_thread::get_id();
+    for(std::size_t i = 0; i != _workers.size(); ++i)
+        if(_workers[i].get_id() == current) return i;
+    return _workers.size();
+}
+
+void TaskScheduler::push(const std::size_t queue, const TaskId id) {
+    {
+        std::lock_guard<std::mutex> lock{_queues[queue].mutex};
+        _queues[queue].tasks.push_back(id);
+    }
+
+    /* Increment the count before locking the mutex so a thread that just
+       checked the count under the lock doesn't miss the notification */
+    ++_queuedCount;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+    }
+    _condition.notify_all();
+}
+
+bool TaskScheduler::pop(const std::size_t queue, TaskId& id, const bool fromBack) {
+    std::lock_guard<std::mutex> lock{_queues[queue].mutex};
+    std::deque<TaskId>& tasks = _queues[queue].tasks;
+    if(tasks.empty()) return false;
+
+    if(fromBack) {
+        id = tasks.back();
+        tasks.pop_back();
+    } else {
+        id = tasks.front();
+        tasks.pop_front();
+    }
+
+    --_queuedCount;
+    return true;
+}
+
+bool TaskScheduler::runNext(const std::size_t queue, const bool fromBack) {
+    /* Own queue first, then steal from the front of the others, in order */
+    TaskId id;
+    for(std::size_t i = 0; i != _queueCount; ++i) {
+        const std::size_t other = (queue + i) % _queueCount;
+        if(pop(other, id, i == 0 && fromBack)) {
+            run(queue, id);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskScheduler::run(const std::size_t queue, const TaskId id) {
+    std::function<void()> function;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        function = std::move(_tasks[id].function);
+    }
+
+    function();
+
+    /* Remove the task and schedule dependents that have nothing else to wait
+       for */
+    std::vector<TaskId> ready;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const auto found = _tasks.find(id);
+        for(const TaskId dependent: found->second.dependents)
+            if(!--_tasks[dependent].remainingDependencies)
+                ready.push_back(dependent);
+        _tasks.erase(found);
+    }
+
+    for(const TaskId dependent: ready) push(queue, dependent);
+    _condition.notify_all();
+}
+
+}
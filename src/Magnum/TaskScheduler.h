@@ -0,0 +1,221 @@
+#ifndef Magnum_TaskScheduler_h
+#define Magnum_TaskScheduler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TaskScheduler
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Work-stealing task scheduler
+
+Runs tasks on a fixed pool of worker threads. Each worker has its own queue,
+takes tasks from its back and, if it's empty, steals from the front of queues
+of other workers. Tasks added from a worker thread go to its own queue, tasks
+added from other threads go to a shared queue.
+
+## Basic usage
+
+Library algorithms such as @ref MeshTools::transformPointsInPlace(),
+@ref TextureTools::distanceField() or @ref SceneGraph::Object::setClean() split
+their work using @ref parallelFor() on the @ref global() scheduler:
+@code
+std::vector<Vector3> positions;
+TaskScheduler::global().parallelFor(positions.size(), 4096, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i)
+        positions[i] = transformation.transformPoint(positions[i]);
+});
+@endcode
+
+The calling thread processes the first range itself and then helps with the
+rest until all ranges are done, so calling @ref parallelFor() from inside a
+task doesn't deadlock.
+
+## Task dependencies
+
+Tasks added with @ref add() can depend on previously added tasks and are run
+only after all of them finish. @ref wait() blocks until given task or all
+tasks are finished, running queued tasks on the calling thread meanwhile:
+@code
+TaskScheduler& scheduler = TaskScheduler::global();
+TaskScheduler::TaskId parse = scheduler.add([&]{ ... });
+TaskScheduler::TaskId normals = scheduler.add([&]{ ... }, {parse});
+TaskScheduler::TaskId tangents = scheduler.add([&]{ ... }, {parse});
+scheduler.add([&]{ ... }, {normals, tangents});
+scheduler.wait();
+@endcode
+
+## Deterministic execution
+
+A scheduler with zero workers doesn't spawn any threads. Tasks are then run
+only inside @ref wait(), on the calling thread, in the order they became
+ready, and @ref parallelFor() processes the ranges in order. This is useful
+for tests and debugging. On platforms without threads
+(@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", @ref CORRADE_TARGET_NACL "NaCl")
+the worker count is always zero.
+*/
+class MAGNUM_EXPORT TaskScheduler {
+    public:
+        /**
+         * @brief Task ID
+         *
+         * @see @ref add()
+         */
+        typedef UnsignedInt TaskId;
+
+        /**
+         * @brief Global scheduler
+         *
+         * Created on first use with one worker less than the hardware thread
+         * count, as the calling thread participates in the work as well.
+         */
+        static TaskScheduler& global();
+
+        /**
+         * @brief Constructor
+         * @param workerCount   Worker thread count. If `0`, all tasks run
+         *      on the thread calling @ref wait() or @ref parallelFor().
+         */
+        explicit TaskScheduler(UnsignedInt workerCount);
+
+        /** @brief Copying is not allowed */
+        TaskScheduler(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for all tasks to finish and then stops the workers.
+         */
+        ~TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt workerCount() const { return UnsignedInt(_workers.size()); }
+
+        /**
+         * @brief Add a task
+         * @param task          Task to run
+         * @param dependencies  Tasks that need to finish first
+         *
+         * Dependencies that already finished are ignored. Expects that all
+         * @p dependencies were returned from earlier calls to this function.
+         * Can be called from any thread, including from inside a task.
+         * @see @ref wait(TaskId), @ref isFinished()
+         */
+        TaskId add(std::function<void()> task, const std::vector<TaskId>& dependencies = {});
+
+        /** @brief Whether given task is finished */
+        bool isFinished(TaskId id);
+
+        /**
+         * @brief Wait for given task to finish
+         *
+         * Runs queued tasks on the calling thread while waiting.
+         */
+        void wait(TaskId id);
+
+        /**
+         * @brief Wait for all tasks to finish
+         *
+         * Runs queued tasks on the calling thread while waiting. Can't be
+         * called from inside a task, as it would wait for itself.
+         */
+        void wait();
+
+        /**
+         * @brief Run a function for subranges of given range in parallel
+         * @param count         Size of the range
+         * @param grainSize     Size of the subranges
+         * @param function      Function called with beginning and end of
+         *      each subrange
+         *
+         * The range @f$ [0, count) @f$ is split into consecutive subranges
+         * of @p grainSize items, the last one possibly smaller, so the split
+         * doesn't depend on worker count. Returns after @p function finished
+         * for all of them. If there's just one subrange or the scheduler has
+         * no workers, @p function is called on the calling thread for each
+         * subrange in order. Grain size of `0` is treated as `1`.
+         */
+        void parallelFor(std::size_t count, std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& function);
+
+    private:
+        struct Task {
+            std::function<void()> function;
+            std::size_t remainingDependencies;
+            std::vector<TaskId> dependents;
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<TaskId> tasks;
+        };
+
+        MAGNUM_LOCAL void work(std::size_t queue);
+        MAGNUM_LOCAL std::size_t currentQueue() const;
+        MAGNUM_LOCAL void push(std::size_t queue, TaskId id);
+        MAGNUM_LOCAL bool pop(std::size_t queue, TaskId& id, bool fromBack);
+        MAGNUM_LOCAL bool runNext(std::size_t queue, bool fromBack);
+        MAGNUM_LOCAL void run(std::size_t queue, TaskId id);
+
+        /* One queue for each worker and one shared for all other threads */
+        std::size_t _queueCount;
+        std::unique_ptr<Queue[]> _queues;
+        std::vector<std::thread> _workers;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::unordered_map<TaskId, Task> _tasks;
+        TaskId _nextId{};
+        std::atomic<std::size_t> _queuedCount{};
+        bool _quit{};
+};
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef Magnum_Test_AbstractOpenGLBenchmarker_h
+#define Magnum_Test_AbstractOpenGLBenchmarker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/TimeQuery.h"
+#endif
+
+namespace Magnum { namespace Test {
+
+/* Benchmark harness measuring both CPU time spent submitting the commands and
+   GPU time spent executing them (if timer queries are available). Each
+   measurement is repeated and the median is taken to filter out outliers.
+   Results are printed and, if the MAGNUM_GL_BENCHMARK_OUTPUT environment
+   variable is set, appended as tab-separated lines to given file together
+   with the GL renderer and version string, so they can be compared across
+   releases and drivers. */
+class AbstractOpenGLBenchmarker: public AbstractOpenGLTester {
+    public:
+        struct Result {
+            std::string name;
+            std::size_t iterations;
+            Double cpuTime;     /* Nanoseconds per iteration */
+            Double gpuTime;     /* Nanoseconds per iteration, -1 if unknown */
+        };
+
+        explicit AbstractOpenGLBenchmarker();
+
+        ~AbstractOpenGLBenchmarker();
+
+        const std::vector<Result>& results() const { return _results; }
+
+    protected:
+        /* Calls `f` once to warm up caches and lazy driver state, then
+           `repeats` times measures `iterations` consecutive calls */
+        template<class F> const Result& measure(const std::string& name, std::size_t iterations, F f, std::size_t repeats = 5);
+
+    private:
+        static Double median(std::vector<Double>& values) {
+            std::sort(values.begin(), values.end());
+            return values[values.size()/2];
+        }
+
+        bool _hasTimerQuery;
+        std::vector<Result> _results;
+};
+
+AbstractOpenGLBenchmarker::AbstractOpenGLBenchmarker():
+    #ifndef MAGNUM_TARGET_GLES
+    _hasTimerQuery{Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>()}
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    _hasTimerQuery{Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>()}
+    #else
+    _hasTimerQuery{false}
+    #endif
+{
+    if(!_hasTimerQuery) Debug() << "Timer queries are not available, measuring only CPU time";
+}
+
+AbstractOpenGLBenchmarker::~AbstractOpenGLBenchmarker() {
+    const char* const filename = std::getenv("MAGNUM_GL_BENCHMARK_OUTPUT");
+    if(!filename || _results.empty()) return;
+
+    std::ofstream out{filename, std::ios::app};
+    if(!out.good()) {
+        Error() << "Cannot write benchmark results to" << filename;
+        return;
+    }
+
+    const std::string renderer = Context::current().rendererString();
+    const std::string version = Context::current().versionString();
+    for(const Result& result: _results)
+        out << result.name << '\t' << result.iterations << '\t' << result.cpuTime << '\t' << result.gpuTime << '\t' << renderer << '\t' << version << '\n';
+}
+
+template<class F> const AbstractOpenGLBenchmarker::Result& AbstractOpenGLBenchmarker::measure(const std::string& name, const std::size_t iterations, F f, const std::size_t repeats) {
+    /* Warm up and make sure nothing from previous benchmarks is pending */
+    f();
+    Renderer::finish();
+
+    std::vector<Double> cpuTimes, gpuTimes;
+    cpuTimes.reserve(repeats);
+    gpuTimes.reserve(repeats);
+    for(std::size_t r = 0; r != repeats; ++r) {
+        #ifndef MAGNUM_TARGET_WEBGL
+        TimeQuery query{TimeQuery::Target::TimeElapsed};
+        if(_hasTimerQuery) query.begin();
+        #endif
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for(std::size_t i = 0; i != iterations; ++i) f();
+        const auto end = std::chrono::high_resolution_clock::now();
+        cpuTimes.push_back(std::chrono::duration<Double, std::nano>(end - start).count()/iterations);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(_hasTimerQuery) {
+            query.end();
+            gpuTimes.push_back(Double(query.result<UnsignedLong>())/iterations);
+        } else
+        #endif
+        {
+            Renderer::finish();
+        }
+    }
+
+    _results.push_back({name, iterations, median(cpuTimes), gpuTimes.empty() ? -1.0 : median(gpuTimes)});
+    const Result& result = _results.back();
+
+    Debug d;
+    d << name << Debug::nospace << ":" << result.cpuTime << "ns CPU";
+    if(result.gpuTime >= 0.0) d << Debug::nospace << "," << result.gpuTime << "ns GPU";
+    d << "per iteration";
+
+    return result;
+}
+
+}}
+
+#endif
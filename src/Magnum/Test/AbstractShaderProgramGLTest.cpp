@@ -66,6 +66,7 @@ struct AbstractShaderProgramGLTest: AbstractOpenGLTester {
     void uniformVector();
     void uniformMatrix();
     void uniformArray();
+    void uniformCache();
 
     #ifndef MAGNUM_TARGET_GLES2
     void createUniformBlocks();
@@ -94,6 +95,7 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               &AbstractShaderProgramGLTest::uniformVector,
               &AbstractShaderProgramGLTest::uniformMatrix,
               &AbstractShaderProgramGLTest::uniformArray,
+              &AbstractShaderProgramGLTest::uniformCache,
 
               #ifndef MAGNUM_TARGET_GLES2
               &AbstractShaderProgramGLTest::createUniformBlocks,
@@ -503,6 +505,46 @@ void AbstractShaderProgramGLTest::uniformArray() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
+void AbstractShaderProgramGLTest::uniformCache() {
+    MyShader shader;
+    CORRADE_VERIFY(!shader.isUniformCacheEnabled());
+
+    /* Nothing is counted with cache disabled */
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    CORRADE_COMPARE(shader.skippedUniformUploadCount(), 0);
+    CORRADE_COMPARE(shader.issuedUniformUploadCount(), 0);
+
+    shader.setUniformCacheEnabled(true);
+    CORRADE_VERIFY(shader.isUniformCacheEnabled());
+
+    /* First upload is always issued, repeated one is skipped */
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    CORRADE_COMPARE(shader.skippedUniformUploadCount(), 1);
+    CORRADE_COMPARE(shader.issuedUniformUploadCount(), 1);
+
+    /* Different value or different location is issued */
+    shader.setUniform(shader.multiplierUniform, 0.5f);
+    shader.setUniform(shader.colorUniform, Vector4(0.3f, 0.7f, 1.0f, 0.25f));
+    shader.setUniform(shader.colorUniform, Vector4(0.3f, 0.7f, 1.0f, 0.25f));
+    CORRADE_COMPARE(shader.skippedUniformUploadCount(), 2);
+    CORRADE_COMPARE(shader.issuedUniformUploadCount(), 3);
+
+    /* State reset invalidates the cache */
+    Context::current().resetState(Context::State::Shaders);
+    shader.setUniform(shader.multiplierUniform, 0.5f);
+    CORRADE_COMPARE(shader.skippedUniformUploadCount(), 2);
+    CORRADE_COMPARE(shader.issuedUniformUploadCount(), 4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    shader.setUniformCacheEnabled(false);
+    CORRADE_VERIFY(!shader.isUniformCacheEnabled());
+    CORRADE_COMPARE(shader.skippedUniformUploadCount(), 0);
+    CORRADE_COMPARE(shader.issuedUniformUploadCount(), 0);
+}
+
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractShaderProgramGLTest::createUniformBlocks() {
     Utility::Resource rs("AbstractShaderProgramGLTest");
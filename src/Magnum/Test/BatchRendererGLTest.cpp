@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <mutex>
+
+#include "Magnum/BatchRenderer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct BatchRendererGLTest: AbstractOpenGLTester {
+    explicit BatchRendererGLTest();
+
+    void construct();
+    void render();
+};
+
+BatchRendererGLTest::BatchRendererGLTest() {
+    addTests({&BatchRendererGLTest::construct,
+              &BatchRendererGLTest::render});
+}
+
+void BatchRendererGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    BatchRenderer renderer{{16, 8}, 2, 3};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(renderer.size(), (Vector2i{16, 8}));
+    CORRADE_COMPARE(renderer.inFlightCount(), 2);
+    CORRADE_COMPARE(renderer.encoderThreadCount(), 3);
+    CORRADE_COMPARE(renderer.framebuffer().checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    CORRADE_COMPARE(renderer.pendingCount(), 0);
+}
+
+void BatchRendererGLTest::render() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    BatchRenderer renderer{{4, 4}, 2, 2};
+
+    /* More jobs than reads in flight, so submit() has to retire some */
+    std::mutex mutex;
+    std::vector<std::pair<UnsignedByte, Color4ub>> encoded;
+    for(UnsignedByte i = 0; i != 5; ++i) {
+        renderer.submit([i](Framebuffer& framebuffer) {
+            Renderer::setClearColor(Math::normalize<Color4>(Color4ub(UnsignedByte(i*10), 20, 30, 255)));
+            framebuffer.clear(FramebufferClear::Color);
+        }, [i, &mutex, &encoded](Image2D& image) {
+            std::lock_guard<std::mutex> lock{mutex};
+            encoded.emplace_back(i, image.data<Color4ub>()[15]);
+        });
+        CORRADE_VERIFY(renderer.pendingCount() <= 5);
+    }
+
+    renderer.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.pendingCount(), 0);
+    CORRADE_COMPARE(renderer.finishedCount(), 5);
+
+    /* Encoding order is unspecified */
+    std::sort(encoded.begin(), encoded.end(), [](const std::pair<UnsignedByte, Color4ub>& a, const std::pair<UnsignedByte, Color4ub>& b) { return a.first < b.first; });
+    CORRADE_COMPARE(encoded.size(), 5);
+    for(UnsignedByte i = 0; i != 5; ++i)
+        CORRADE_COMPARE(encoded[i].second, Color4ub(UnsignedByte(i*10), 20, 30, 255));
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::BatchRendererGLTest)
@@ -52,6 +52,10 @@ struct BufferGLTest: AbstractOpenGLTester {
     #endif
 
     void data();
+    #ifndef MAGNUM_TARGET_GLES
+    void storage();
+    void storageSparse();
+    #endif
     void map();
     #ifdef CORRADE_TARGET_NACL
     void mapSub();
@@ -79,6 +83,10 @@ BufferGLTest::BufferGLTest() {
               #endif
 
               &BufferGLTest::data,
+              #ifndef MAGNUM_TARGET_GLES
+              &BufferGLTest::storage,
+              &BufferGLTest::storageSparse,
+              #endif
               &BufferGLTest::map,
               #ifdef CORRADE_TARGET_NACL
               &BufferGLTest::mapSub,
@@ -338,6 +346,57 @@ void BufferGLTest::mapSub() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void BufferGLTest::storage() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    constexpr Int data[] = {2, 7, 5, 13, 25};
+    Buffer buffer;
+    buffer.setStorage(data, Buffer::StorageFlag::MapRead|Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.size(), 5*4);
+
+    Int* contents = buffer.map<Int>(0, 5*4, Buffer::MapFlag::Read|Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(contents);
+    CORRADE_COMPARE(contents[3], 13);
+
+    CORRADE_VERIFY(buffer.unmap());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void BufferGLTest::storageSparse() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_buffer>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_buffer::string() + std::string(" is not supported"));
+
+    const Int pageSize = Buffer::sparsePageSize();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(pageSize > 0);
+
+    Buffer buffer;
+    buffer.setStorage({nullptr, std::size_t(pageSize*4)}, Buffer::StorageFlag::Sparse|Buffer::StorageFlag::DynamicStorage);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.size(), pageSize*4);
+
+    buffer.commitPages(pageSize, pageSize);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    constexpr Int data[] = {2, 7, 5, 13, 25};
+    buffer.setSubData(pageSize, data);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Containers::Array<Int> contents = buffer.subData<Int>(pageSize, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(contents[3], 13);
+
+    buffer.decommitPages(pageSize, pageSize);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 void BufferGLTest::mapRange() {
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
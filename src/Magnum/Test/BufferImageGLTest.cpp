@@ -36,6 +36,7 @@ struct BufferImageGLTest: AbstractOpenGLTester {
 
     void construct();
     void constructCompressed();
+    void constructBuffer();
     void constructCopy();
     void constructCopyCompressed();
     void constructMove();
@@ -48,6 +49,7 @@ struct BufferImageGLTest: AbstractOpenGLTester {
 BufferImageGLTest::BufferImageGLTest() {
     addTests({&BufferImageGLTest::construct,
               &BufferImageGLTest::constructCompressed,
+              &BufferImageGLTest::constructBuffer,
               &BufferImageGLTest::constructCopy,
               &BufferImageGLTest::constructCopyCompressed,
               &BufferImageGLTest::constructMove,
@@ -109,6 +111,29 @@ void BufferImageGLTest::constructCompressed() {
     #endif
 }
 
+void BufferImageGLTest::constructBuffer() {
+    const char data[] = { 'a', 'b', 'c', 'd' };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+    const GLuint id = buffer.id();
+
+    /* Second row only */
+    BufferImage2D a{PixelStorage{}.setAlignment(1).setSkip({0, 1, 0}),
+        PixelFormat::Red, PixelType::UnsignedByte, {1, 3}, std::move(buffer), 4};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(a.storage().skip(), (Vector3i{0, 1, 0}));
+    CORRADE_COMPARE(a.size(), Vector2i(1, 3));
+    CORRADE_COMPARE(a.dataSize(), 4);
+    CORRADE_COMPARE(a.buffer().id(), id);
+    CORRADE_COMPARE(buffer.id(), 0);
+
+    Buffer released = a.release();
+    CORRADE_COMPARE(released.id(), id);
+    CORRADE_COMPARE(a.buffer().id(), 0);
+    CORRADE_COMPARE(a.dataSize(), 0);
+}
+
 void BufferImageGLTest::constructCopy() {
     CORRADE_VERIFY(!(std::is_constructible<BufferImage2D, const BufferImage2D&>{}));
     CORRADE_VERIFY(!(std::is_assignable<BufferImage2D, const BufferImage2D&>{}));
@@ -0,0 +1,370 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/CommandCapture.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct CommandCaptureGLTest: AbstractOpenGLTester {
+    explicit CommandCaptureGLTest();
+
+    void buffer();
+    void bufferElidePayload();
+    void texture();
+    void drawUniforms();
+    void state();
+    void frames();
+    void alreadyActive();
+};
+
+CommandCaptureGLTest::CommandCaptureGLTest() {
+    addTests({&CommandCaptureGLTest::buffer,
+              &CommandCaptureGLTest::bufferElidePayload,
+              &CommandCaptureGLTest::texture,
+              &CommandCaptureGLTest::drawUniforms,
+              &CommandCaptureGLTest::state,
+              &CommandCaptureGLTest::frames,
+              &CommandCaptureGLTest::alreadyActive});
+}
+
+namespace {
+    struct ColorShader: AbstractShaderProgram {
+        explicit ColorShader();
+
+        ColorShader& setColor(const Color4& color) {
+            setUniform(_colorUniform, color);
+            return *this;
+        }
+
+        Int colorUniform() const { return _colorUniform; }
+
+        private:
+            Int _colorUniform;
+    };
+
+    /* Skips to the first command of given type, returns false if there's
+       none */
+    bool skipTo(CommandCaptureReader& reader, const CommandCapture::Command command) {
+        while(reader.nextCommand())
+            if(reader.command() == command) return true;
+        return false;
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+ColorShader::ColorShader() {
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    vert.addSource("void main() { gl_Position = vec4(0.0); }");
+    frag.addSource(
+        #ifdef MAGNUM_TARGET_GLES
+        "precision mediump float;\n"
+        #endif
+        "uniform vec4 color;\n"
+        #ifndef CORRADE_TARGET_APPLE
+        "void main() { gl_FragColor = color; }"
+        #else
+        "out vec4 fragmentColor;\n"
+        "void main() { fragmentColor = color; }"
+        #endif
+        );
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _colorUniform = uniformLocation("color");
+}
+#endif
+
+void CommandCaptureGLTest::buffer() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    const char data[]{'a', 'b', 'c', 'd', 'e', 'f'};
+
+    std::ostringstream out;
+    Buffer buffer;
+    {
+        CommandCapture capture{out, 1};
+        buffer.setData(data, BufferUsage::StaticDraw);
+        buffer.setSubData(4, Containers::ArrayView<const char>{data, 2});
+        capture.nextFrame();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::BufferData));
+    const auto bufferData = reader.record<CommandCapture::BufferDataRecord>();
+    CORRADE_COMPARE(bufferData.buffer, buffer.id());
+    CORRADE_COMPARE(bufferData.size, 6);
+    CORRADE_COMPARE(bufferData.usage, GL_STATIC_DRAW);
+    CORRADE_COMPARE(std::string(reader.payload(), reader.payload().size()), "abcdef");
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::BufferSubData));
+    const auto bufferSubData = reader.record<CommandCapture::BufferSubDataRecord>();
+    CORRADE_COMPARE(bufferSubData.buffer, buffer.id());
+    CORRADE_COMPARE(bufferSubData.offset, 4);
+    CORRADE_COMPARE(bufferSubData.size, 2);
+    CORRADE_COMPARE(std::string(reader.payload(), reader.payload().size()), "ab");
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::EndFrame));
+    CORRADE_VERIFY(!reader.nextCommand());
+}
+
+void CommandCaptureGLTest::bufferElidePayload() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    const char data[]{'a', 'b', 'c', 'd', 'e', 'f'};
+
+    std::ostringstream out;
+    Buffer buffer;
+    {
+        CommandCapture capture{out, 1, CommandCapture::Flag::ElidePayload};
+        buffer.setData(data, BufferUsage::StaticDraw);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::BufferData));
+    CORRADE_COMPARE(reader.record<CommandCapture::BufferDataRecord>().size, 6);
+    CORRADE_VERIFY(reader.payload().empty());
+}
+
+void CommandCaptureGLTest::texture() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    const char data[16]{};
+
+    std::ostringstream out;
+    Texture2D texture;
+    {
+        CommandCapture capture{out, 1};
+        texture.setStorage(1, TextureFormat::RGBA8, Vector2i{4})
+            .setSubImage(0, {2, 0}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, data});
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::TextureStorage));
+    const auto storage = reader.record<CommandCapture::TextureStorageRecord>();
+    CORRADE_COMPARE(storage.texture, texture.id());
+    CORRADE_COMPARE(storage.target, GL_TEXTURE_2D);
+    CORRADE_COMPARE(storage.levels, 1);
+    CORRADE_COMPARE(storage.format, GLenum(TextureFormat::RGBA8));
+    CORRADE_COMPARE(storage.size, (Vector3i{4, 4, 1}));
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::TextureSubImage));
+    const auto subImage = reader.record<CommandCapture::TextureSubImageRecord>();
+    CORRADE_COMPARE(subImage.texture, texture.id());
+    CORRADE_COMPARE(subImage.level, 0);
+    CORRADE_COMPARE(subImage.offset, (Vector3i{2, 0, 0}));
+    CORRADE_COMPARE(subImage.size, (Vector3i{2, 2, 1}));
+    CORRADE_COMPARE(subImage.format, GLenum(PixelFormat::RGBA));
+    CORRADE_COMPARE(subImage.type, GLenum(PixelType::UnsignedByte));
+    CORRADE_COMPARE(subImage.alignment, 4);
+    CORRADE_COMPARE(subImage.dataSize, 16);
+    CORRADE_COMPARE(reader.payload().size(), 16);
+}
+
+void CommandCaptureGLTest::drawUniforms() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    ColorShader shader;
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(3);
+
+    std::ostringstream out;
+    {
+        CommandCapture capture{out, 1};
+        shader.setColor(Color4{0.25f, 0.5f, 0.75f, 1.0f});
+        mesh.draw(shader);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::Uniform));
+    const auto uniform = reader.record<CommandCapture::UniformRecord>();
+    CORRADE_COMPARE(uniform.program, shader.id());
+    CORRADE_COMPARE(uniform.location, shader.colorUniform());
+    CORRADE_COMPARE(uniform.type, GL_FLOAT_VEC4);
+    CORRADE_COMPARE(uniform.count, 1);
+    CORRADE_COMPARE(reader.payload().size(), 4*sizeof(Float));
+    CORRADE_COMPARE(reinterpret_cast<const Float*>(reader.payload().data())[1], 0.5f);
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::UseProgram));
+    CORRADE_COMPARE(reader.record<CommandCapture::UseProgramRecord>().program, shader.id());
+
+    CORRADE_VERIFY(skipTo(reader, CommandCapture::Command::Draw));
+    const auto draw = reader.record<CommandCapture::DrawRecord>();
+    CORRADE_COMPARE(draw.mesh, mesh.id());
+    CORRADE_COMPARE(draw.primitive, GL_TRIANGLES);
+    CORRADE_COMPARE(draw.count, 3);
+    CORRADE_COMPARE(draw.instanceCount, 1);
+    CORRADE_COMPARE(draw.indexBuffer, 0);
+    CORRADE_COMPARE(draw.indexType, 0);
+}
+
+void CommandCaptureGLTest::state() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    std::ostringstream out;
+    {
+        CommandCapture capture{out, 1};
+        Renderer::enable(Renderer::Feature::Blending);
+        /* Redundant, filtered out by the state tracker and not captured */
+        Renderer::enable(Renderer::Feature::Blending);
+        Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha);
+        Renderer::disable(Renderer::Feature::Blending);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::State);
+    const auto enable = reader.record<CommandCapture::StateRecord>();
+    CORRADE_VERIFY(enable.function == CommandCapture::StateFunction::Enable);
+    CORRADE_COMPARE(enable.arguments[0], GL_BLEND);
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::State);
+    const auto blendFunction = reader.record<CommandCapture::StateRecord>();
+    CORRADE_VERIFY(blendFunction.function == CommandCapture::StateFunction::BlendFunction);
+    CORRADE_COMPARE(blendFunction.arguments[0], GL_ONE);
+    CORRADE_COMPARE(blendFunction.arguments[1], GL_ONE_MINUS_SRC_ALPHA);
+    CORRADE_COMPARE(blendFunction.arguments[2], GL_ONE);
+    CORRADE_COMPARE(blendFunction.arguments[3], GL_ONE_MINUS_SRC_ALPHA);
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::State);
+    const auto disable = reader.record<CommandCapture::StateRecord>();
+    CORRADE_VERIFY(disable.function == CommandCapture::StateFunction::Disable);
+    CORRADE_COMPARE(disable.arguments[0], GL_BLEND);
+
+    CORRADE_VERIFY(!reader.nextCommand());
+}
+
+void CommandCaptureGLTest::frames() {
+    #ifndef MAGNUM_BUILD_CAPTURE
+    CORRADE_SKIP("MAGNUM_BUILD_CAPTURE is not enabled.");
+    #endif
+
+    const char data[4]{};
+
+    std::ostringstream out;
+    Buffer buffer;
+    {
+        CommandCapture capture{out, 1};
+        buffer.setData(data, BufferUsage::StaticDraw);
+        capture.nextFrame();
+        CORRADE_VERIFY(!capture.isCapturing());
+
+        /* Not recorded anymore */
+        buffer.setData(data, BufferUsage::StaticDraw);
+        CORRADE_COMPARE(capture.commandCount(), 2);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string captured = out.str();
+    CommandCaptureReader reader{{captured.data(), captured.size()}};
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::BufferData);
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::EndFrame);
+    CORRADE_VERIFY(!reader.nextCommand());
+}
+
+void CommandCaptureGLTest::alreadyActive() {
+    std::ostringstream a, b;
+    CommandCapture capture{a, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CommandCapture another{b, 0};
+    CORRADE_COMPARE(out.str(), "CommandCapture: another capture is already active on current context\n");
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::CommandCaptureGLTest)
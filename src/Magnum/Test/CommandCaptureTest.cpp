@@ -0,0 +1,262 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/CommandCapture.h"
+
+namespace Magnum { namespace Test {
+
+struct CommandCaptureTest: TestSuite::Tester {
+    explicit CommandCaptureTest();
+
+    void recordSize();
+
+    void frames();
+    void framesUnlimited();
+    void flags();
+
+    void read();
+    void readInvalidSignature();
+    void readInvalidVersion();
+    void readTruncated();
+    void readUnknownCommand();
+    void readRecordSizeMismatch();
+};
+
+CommandCaptureTest::CommandCaptureTest() {
+    addTests({&CommandCaptureTest::recordSize,
+
+              &CommandCaptureTest::frames,
+              &CommandCaptureTest::framesUnlimited,
+              &CommandCaptureTest::flags,
+
+              &CommandCaptureTest::read,
+              &CommandCaptureTest::readInvalidSignature,
+              &CommandCaptureTest::readInvalidVersion,
+              &CommandCaptureTest::readTruncated,
+              &CommandCaptureTest::readUnknownCommand,
+              &CommandCaptureTest::readRecordSizeMismatch});
+}
+
+namespace {
+    /* Capture with no context, consisting of just the header */
+    std::string header() {
+        std::ostringstream out;
+        CommandCapture capture{out, 0};
+        capture.stop();
+        return out.str();
+    }
+
+    void appendCommand(std::string& data, const CommandCapture::Command command, const void* const record, const std::size_t size, const std::string& payload = {}) {
+        const UnsignedByte commandValue = UnsignedByte(command);
+        const UnsignedInt bodySize = size + payload.size();
+        data.append(reinterpret_cast<const char*>(&commandValue), sizeof(commandValue));
+        data.append(reinterpret_cast<const char*>(&bodySize), sizeof(bodySize));
+        data.append(static_cast<const char*>(record), size);
+        data.append(payload);
+    }
+}
+
+void CommandCaptureTest::recordSize() {
+    /* The records are written as-is, make sure there's no hidden padding */
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::EndFrame), 0);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::BufferData), 16);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::BufferSubData), 24);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::TextureStorage), 28);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::TextureSubImage), 56);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::Draw), 40);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::UseProgram), 4);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::Uniform), 16);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::BindTexture), 8);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::BindFramebuffer), 8);
+    CORRADE_COMPARE(CommandCapture::recordSize(CommandCapture::Command::State), 20);
+}
+
+void CommandCaptureTest::frames() {
+    std::ostringstream out;
+    {
+        CommandCapture capture{out, 2};
+        CORRADE_VERIFY(capture.isCapturing());
+        CORRADE_COMPARE(capture.frameCount(), 2);
+        CORRADE_COMPARE(capture.capturedFrameCount(), 0);
+
+        capture.nextFrame();
+        CORRADE_VERIFY(capture.isCapturing());
+        capture.nextFrame();
+        CORRADE_VERIFY(!capture.isCapturing());
+        CORRADE_COMPARE(capture.capturedFrameCount(), 2);
+        CORRADE_COMPARE(capture.commandCount(), 2);
+
+        /* Ignored after the capture stopped */
+        capture.nextFrame();
+        CORRADE_COMPARE(capture.capturedFrameCount(), 2);
+        CORRADE_COMPARE(capture.commandCount(), 2);
+    }
+
+    const std::string data = out.str();
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(reader.isValid());
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::EndFrame);
+    CORRADE_VERIFY(reader.payload().empty());
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::EndFrame);
+    CORRADE_VERIFY(!reader.nextCommand());
+    CORRADE_VERIFY(reader.isValid());
+}
+
+void CommandCaptureTest::framesUnlimited() {
+    std::ostringstream out;
+    CommandCapture capture{out, 0};
+
+    for(Int i = 0; i != 5; ++i) capture.nextFrame();
+    CORRADE_VERIFY(capture.isCapturing());
+    CORRADE_COMPARE(capture.capturedFrameCount(), 5);
+
+    capture.stop();
+    CORRADE_VERIFY(!capture.isCapturing());
+}
+
+void CommandCaptureTest::flags() {
+    std::ostringstream out;
+    {
+        CommandCapture capture{out, 1, CommandCapture::Flag::ElidePayload};
+        CORRADE_VERIFY(capture.flags() == CommandCapture::Flag::ElidePayload);
+    }
+
+    const std::string data = out.str();
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(reader.isValid());
+    CORRADE_VERIFY(reader.flags() == CommandCapture::Flag::ElidePayload);
+}
+
+void CommandCaptureTest::read() {
+    std::string data = header();
+
+    const CommandCapture::BufferDataRecord bufferData{5, 3, GL_STATIC_DRAW};
+    appendCommand(data, CommandCapture::Command::BufferData, &bufferData, sizeof(bufferData), "hello");
+    const CommandCapture::StateRecord state{CommandCapture::StateFunction::Enable, {GL_BLEND, 0, 0, 0}};
+    appendCommand(data, CommandCapture::Command::State, &state, sizeof(state));
+    appendCommand(data, CommandCapture::Command::EndFrame, nullptr, 0);
+
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(reader.isValid());
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::BufferData);
+    const auto readBufferData = reader.record<CommandCapture::BufferDataRecord>();
+    CORRADE_COMPARE(readBufferData.size, 5);
+    CORRADE_COMPARE(readBufferData.buffer, 3);
+    CORRADE_COMPARE(readBufferData.usage, GL_STATIC_DRAW);
+    CORRADE_COMPARE(std::string(reader.payload(), reader.payload().size()), "hello");
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::State);
+    const auto readState = reader.record<CommandCapture::StateRecord>();
+    CORRADE_VERIFY(readState.function == CommandCapture::StateFunction::Enable);
+    CORRADE_COMPARE(readState.arguments[0], GL_BLEND);
+    CORRADE_VERIFY(reader.payload().empty());
+
+    CORRADE_VERIFY(reader.nextCommand());
+    CORRADE_VERIFY(reader.command() == CommandCapture::Command::EndFrame);
+
+    CORRADE_VERIFY(!reader.nextCommand());
+    CORRADE_VERIFY(reader.isValid());
+}
+
+void CommandCaptureTest::readInvalidSignature() {
+    const char data[]{'M', 'G', 'X', 'P', 1, 0, 0, 0, 0, 0, 0, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CommandCaptureReader reader{data};
+    CORRADE_VERIFY(!reader.isValid());
+    CORRADE_VERIFY(!reader.nextCommand());
+    CORRADE_COMPARE(out.str(), "CommandCaptureReader: invalid file signature\n");
+}
+
+void CommandCaptureTest::readInvalidVersion() {
+    std::string data = header();
+    data[4] = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(!reader.isValid());
+    CORRADE_COMPARE(out.str(), "CommandCaptureReader: unsupported version 2\n");
+}
+
+void CommandCaptureTest::readTruncated() {
+    std::string data = header();
+    const CommandCapture::UseProgramRecord useProgram{7};
+    appendCommand(data, CommandCapture::Command::UseProgram, &useProgram, sizeof(useProgram));
+    data.resize(data.size() - 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(reader.isValid());
+    CORRADE_VERIFY(!reader.nextCommand());
+    CORRADE_VERIFY(!reader.isValid());
+    CORRADE_COMPARE(out.str(), "CommandCaptureReader::nextCommand(): truncated command at offset 12\n");
+}
+
+void CommandCaptureTest::readUnknownCommand() {
+    std::string data = header();
+    appendCommand(data, CommandCapture::Command(0x7f), nullptr, 0);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(!reader.nextCommand());
+    CORRADE_VERIFY(!reader.isValid());
+    CORRADE_COMPARE(out.str(), "CommandCaptureReader::nextCommand(): unknown command 127 at offset 12\n");
+}
+
+void CommandCaptureTest::readRecordSizeMismatch() {
+    std::string data = header();
+    const CommandCapture::UseProgramRecord useProgram{7};
+    appendCommand(data, CommandCapture::Command::UseProgram, &useProgram, sizeof(useProgram));
+
+    CommandCaptureReader reader{{data.data(), data.size()}};
+    CORRADE_VERIFY(reader.nextCommand());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    reader.record<CommandCapture::DrawRecord>();
+    CORRADE_COMPARE(out.str(), "CommandCaptureReader::record(): expected a record of 4 bytes but got 40\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::CommandCaptureTest)
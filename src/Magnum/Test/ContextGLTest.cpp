@@ -25,8 +25,13 @@
 
 #include <algorithm>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
 #include "Magnum/Test/AbstractOpenGLTester.h"
 
 namespace Magnum { namespace Test {
@@ -43,6 +48,18 @@ struct ContextGLTest: AbstractOpenGLTester {
     void supportedVersion();
     void isExtensionSupported();
     void isExtensionDisabled();
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    void statistics();
+    #endif
+
+    void memoryTrackingDisabled();
+    void memoryTrackingBuffer();
+    void memoryTrackingTexture();
+    void memoryTrackingRenderbuffer();
+    #ifndef MAGNUM_TARGET_GLES
+    void deviceMemory();
+    #endif
 };
 
 ContextGLTest::ContextGLTest() {
@@ -54,7 +71,20 @@ ContextGLTest::ContextGLTest() {
               #endif
               &ContextGLTest::supportedVersion,
               &ContextGLTest::isExtensionSupported,
-              &ContextGLTest::isExtensionDisabled});
+              &ContextGLTest::isExtensionDisabled,
+
+              #ifdef MAGNUM_BUILD_STATISTICS
+              &ContextGLTest::statistics,
+              #endif
+
+              &ContextGLTest::memoryTrackingDisabled,
+              &ContextGLTest::memoryTrackingBuffer,
+              &ContextGLTest::memoryTrackingTexture,
+              &ContextGLTest::memoryTrackingRenderbuffer,
+              #ifndef MAGNUM_TARGET_GLES
+              &ContextGLTest::deviceMemory
+              #endif
+              });
 }
 
 void ContextGLTest::constructCopyMove() {
@@ -139,6 +169,139 @@ void ContextGLTest::isExtensionDisabled() {
     #endif
 }
 
+#ifdef MAGNUM_BUILD_STATISTICS
+void ContextGLTest::statistics() {
+    Context& context = Context::current();
+    context.resetStatistics();
+
+    Buffer buffer;
+    buffer.setData({nullptr, 1024}, BufferUsage::StaticDraw);
+    CORRADE_COMPARE(context.statistics().bufferUploads, 0);
+
+    const char data[256]{};
+    buffer.setSubData(0, data);
+    buffer.setData(data, BufferUsage::StaticDraw);
+    CORRADE_COMPARE(context.statistics().bufferUploads, 2);
+    CORRADE_COMPARE(context.statistics().bufferUploadBytes, 512);
+
+    /* Redundant binds are not counted */
+    Texture2D texture;
+    texture.bind(0);
+    texture.bind(0);
+    CORRADE_COMPARE(context.statistics().textureBinds, 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Context::Statistics statistics = context.resetStatistics();
+    CORRADE_COMPARE(statistics.bufferUploads, 2);
+    CORRADE_COMPARE(statistics.textureBinds, 1);
+    CORRADE_COMPARE(context.statistics().bufferUploads, 0);
+    CORRADE_COMPARE(context.statistics().bufferUploadBytes, 0);
+    CORRADE_COMPARE(context.statistics().textureBinds, 0);
+}
+#endif
+
+void ContextGLTest::memoryTrackingDisabled() {
+    Context& context = Context::current();
+    CORRADE_VERIFY(!context.isMemoryTrackingEnabled());
+
+    Buffer buffer;
+    buffer.setData({nullptr, 1024}, BufferUsage::StaticDraw);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).objectCount, 0);
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).byteCount, 0);
+}
+
+void ContextGLTest::memoryTrackingBuffer() {
+    Context& context = Context::current();
+    context.setMemoryTrackingEnabled(true);
+    CORRADE_VERIFY(context.isMemoryTrackingEnabled());
+
+    {
+        Buffer a, b;
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).objectCount, 2);
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).byteCount, 0);
+
+        a.setData({nullptr, 1024}, BufferUsage::StaticDraw);
+        b.setData({nullptr, 256}, BufferUsage::StaticDraw);
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).byteCount, 1280);
+
+        /* Reallocation replaces the previous size */
+        a.setData({nullptr, 512}, BufferUsage::StaticDraw);
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).byteCount, 768);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).objectCount, 0);
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Buffer).byteCount, 0);
+
+    context.setMemoryTrackingEnabled(false);
+}
+
+void ContextGLTest::memoryTrackingTexture() {
+    Context& context = Context::current();
+    context.setMemoryTrackingEnabled(true);
+
+    {
+        Texture2D texture;
+        texture.setStorage(3,
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            TextureFormat::RGBA8,
+            #else
+            TextureFormat::RGBA,
+            #endif
+            {16, 8});
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Texture).objectCount, 1);
+        /* 16x8, 8x4 and 4x2 RGBA pixels */
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Texture).byteCount, (128 + 32 + 8)*4);
+    }
+
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Texture).objectCount, 0);
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Texture).byteCount, 0);
+
+    context.setMemoryTrackingEnabled(false);
+}
+
+void ContextGLTest::memoryTrackingRenderbuffer() {
+    Context& context = Context::current();
+    context.setMemoryTrackingEnabled(true);
+
+    {
+        Renderbuffer renderbuffer;
+        renderbuffer.setStorage(RenderbufferFormat::RGBA4, {32, 32});
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Renderbuffer).objectCount, 1);
+        CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Renderbuffer).byteCount, 32*32*2);
+    }
+
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Renderbuffer).objectCount, 0);
+    CORRADE_COMPARE(context.memoryUsage(Context::MemoryObject::Renderbuffer).byteCount, 0);
+
+    context.setMemoryTrackingEnabled(false);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void ContextGLTest::deviceMemory() {
+    Context& context = Context::current();
+    if(!context.isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>() && !context.isExtensionSupported<Extensions::GL::ATI::meminfo>())
+        CORRADE_SKIP("Neither " + std::string(Extensions::GL::NVX::gpu_memory_info::string()) + " nor " + Extensions::GL::ATI::meminfo::string() + " is supported.");
+
+    const std::size_t available = context.availableDeviceMemory();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(available > 0);
+
+    if(context.isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+        const std::size_t total = context.totalDeviceMemory();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(total >= available);
+    }
+}
+#endif
+
 }}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Test::ContextGLTest)
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Attribute.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+/* Measures CPU time of common object setup operations. Run once as-is and
+   once with --magnum-disable-extensions "GL_ARB_direct_state_access
+   GL_EXT_direct_state_access" to compare the DSA and bind-to-edit paths. If
+   built with MAGNUM_BUILD_STATISTICS, the number of buffer, texture and
+   framebuffer binds done per iteration is printed as well. */
+struct DirectStateAccessGLBenchmark: AbstractOpenGLTester {
+    explicit DirectStateAccessGLBenchmark();
+
+    void meshSetup();
+    void framebufferAttach();
+    void bufferUpload();
+    void textureUpload();
+};
+
+DirectStateAccessGLBenchmark::DirectStateAccessGLBenchmark() {
+    addBenchmarks<DirectStateAccessGLBenchmark>({
+        &DirectStateAccessGLBenchmark::meshSetup,
+        &DirectStateAccessGLBenchmark::framebufferAttach,
+        &DirectStateAccessGLBenchmark::bufferUpload,
+        &DirectStateAccessGLBenchmark::textureUpload}, 10);
+
+    Debug() << "Using"
+        << (Context::current().isExtensionSupported<Extensions::GL::ARB::direct_state_access>() ? Extensions::GL::ARB::direct_state_access::string() :
+            Context::current().isExtensionSupported<Extensions::GL::EXT::direct_state_access>() ? Extensions::GL::EXT::direct_state_access::string() : "no DSA extension");
+}
+
+namespace {
+
+enum: std::size_t { Iterations = 1000 };
+
+typedef Attribute<0, Vector3> Position;
+typedef Attribute<1, Vector2> TextureCoordinates;
+typedef Attribute<2, Vector3> Normal;
+
+#ifdef MAGNUM_BUILD_STATISTICS
+void printBinds(const char* name, const Context::Statistics& statistics) {
+    Debug() << name << "per iteration:"
+        << Float(statistics.bufferBinds)/Iterations << "buffer binds,"
+        << Float(statistics.textureBinds)/Iterations << "texture binds,"
+        << Float(statistics.framebufferBinds)/Iterations << "framebuffer binds,"
+        << Float(statistics.meshBinds)/Iterations << "mesh binds";
+}
+#endif
+
+}
+
+void DirectStateAccessGLBenchmark::meshSetup() {
+    Buffer vertices, indices;
+    vertices.setData({nullptr, 1024*(sizeof(Vector3)*2 + sizeof(Vector2))}, BufferUsage::StaticDraw);
+    indices.setData({nullptr, 1024*sizeof(UnsignedShort)}, BufferUsage::StaticDraw);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().resetStatistics();
+    #endif
+
+    CORRADE_BENCHMARK(Iterations) {
+        Mesh mesh;
+        mesh.addVertexBuffer(vertices, 0,
+                Position{}, Normal{}, TextureCoordinates{})
+            .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedShort)
+            .setCount(1024);
+    }
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    printBinds("Mesh setup", Context::current().resetStatistics());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DirectStateAccessGLBenchmark::framebufferAttach() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+
+    Texture2D color;
+    color.setStorage(1, TextureFormat::RGBA8, Vector2i{128});
+    Renderbuffer depthStencil;
+    depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, Vector2i{128});
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().resetStatistics();
+    #endif
+
+    CORRADE_BENCHMARK(Iterations) {
+        Framebuffer framebuffer{{{}, Vector2i{128}}};
+        framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, color, 0)
+            .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, depthStencil);
+    }
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    printBinds("Framebuffer attach", Context::current().resetStatistics());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DirectStateAccessGLBenchmark::bufferUpload() {
+    Buffer buffer;
+    buffer.setData({nullptr, 64*1024}, BufferUsage::DynamicDraw);
+    const char data[256]{};
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().resetStatistics();
+    #endif
+
+    /* Upload into the buffer while other buffers get bound in between, like
+       in a real frame */
+    Buffer other;
+    CORRADE_BENCHMARK(Iterations) {
+        buffer.setSubData(0, data);
+        other.setData(data, BufferUsage::DynamicDraw);
+    }
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    printBinds("Buffer upload", Context::current().resetStatistics());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DirectStateAccessGLBenchmark::textureUpload() {
+    Texture2D a, b;
+    a.setStorage(1, TextureFormat::RGBA8, Vector2i{16});
+    b.setStorage(1, TextureFormat::RGBA8, Vector2i{16});
+    const char data[16*16*4]{};
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{16}, data};
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().resetStatistics();
+    #endif
+
+    /* Alternating between two textures so the bind-to-edit path can't reuse
+       the binding from the previous iteration */
+    CORRADE_BENCHMARK(Iterations) {
+        a.setSubImage(0, {}, image);
+        b.setSubImage(0, {}, image);
+    }
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    printBinds("Texture upload", Context::current().resetStatistics());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::DirectStateAccessGLBenchmark)
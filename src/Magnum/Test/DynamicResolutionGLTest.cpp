@@ -0,0 +1,167 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/DynamicResolution.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct DynamicResolutionGLTest: AbstractOpenGLTester {
+    explicit DynamicResolutionGLTest();
+
+    void construct();
+
+    void setScale();
+    void setScaleRange();
+
+    void frameTimeOverBudget();
+    void frameTimeUnderBudget();
+    void frameTimeWithinHeadroom();
+
+    void beginEnd();
+};
+
+DynamicResolutionGLTest::DynamicResolutionGLTest() {
+    addTests({&DynamicResolutionGLTest::construct,
+
+              &DynamicResolutionGLTest::setScale,
+              &DynamicResolutionGLTest::setScaleRange,
+
+              &DynamicResolutionGLTest::frameTimeOverBudget,
+              &DynamicResolutionGLTest::frameTimeUnderBudget,
+              &DynamicResolutionGLTest::frameTimeWithinHeadroom,
+
+              &DynamicResolutionGLTest::beginEnd});
+}
+
+void DynamicResolutionGLTest::construct() {
+    DynamicResolution resolution{{640, 480}};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(resolution.maxSize(), (Vector2i{640, 480}));
+    CORRADE_COMPARE(resolution.size(), (Vector2i{640, 480}));
+    CORRADE_COMPARE(resolution.textureScale(), Vector2{1.0f});
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+    CORRADE_COMPARE(resolution.minScale(), 0.5f);
+    CORRADE_COMPARE(resolution.maxScale(), 1.0f);
+    CORRADE_COMPARE(resolution.frameTime(), 0.0f);
+}
+
+void DynamicResolutionGLTest::setScale() {
+    DynamicResolution resolution{{640, 480}};
+    resolution.setScale(0.7f);
+
+    /* 448x336, rounded up to multiple of 8 */
+    CORRADE_COMPARE(resolution.scale(), 0.7f);
+    CORRADE_COMPARE(resolution.size(), (Vector2i{448, 336}));
+    CORRADE_COMPARE(resolution.textureScale(), (Vector2{0.7f, 0.7f}));
+
+    /* 403.2x302.4 gets rounded up */
+    resolution.setScale(0.63f);
+    CORRADE_COMPARE(resolution.size(), (Vector2i{408, 304}));
+
+    /* Clamped to the range */
+    resolution.setScale(0.1f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+    CORRADE_COMPARE(resolution.size(), (Vector2i{320, 240}));
+}
+
+void DynamicResolutionGLTest::setScaleRange() {
+    DynamicResolution resolution{{640, 480}};
+    resolution.setScaleRange(0.25f, 0.75f);
+
+    /* Current scale is clamped to the new range */
+    CORRADE_COMPARE(resolution.minScale(), 0.25f);
+    CORRADE_COMPARE(resolution.maxScale(), 0.75f);
+    CORRADE_COMPARE(resolution.scale(), 0.75f);
+    CORRADE_COMPARE(resolution.size(), (Vector2i{480, 360}));
+}
+
+void DynamicResolutionGLTest::frameTimeOverBudget() {
+    DynamicResolution resolution{{640, 480}};
+    resolution.setTargetFrameTime(0.01f);
+
+    /* Twice the budget, pixel count should go down to a half */
+    resolution.addFrameTime(0.02f);
+    CORRADE_COMPARE(resolution.scale(), 0.707107f);
+    CORRADE_COMPARE(resolution.size(), (Vector2i{456, 344}));
+
+    /* The average gets renormalized to the new scale */
+    CORRADE_COMPARE(resolution.frameTime(), 0.01f);
+
+    /* Way over the budget, clamped to the min scale */
+    resolution.addFrameTime(1.0f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+}
+
+void DynamicResolutionGLTest::frameTimeUnderBudget() {
+    DynamicResolution resolution{{640, 480}};
+    resolution.setTargetFrameTime(0.01f)
+        .setScale(0.5f);
+
+    /* Way under the budget, goes up only gradually */
+    resolution.addFrameTime(0.001f);
+    CORRADE_COMPARE(resolution.scale(), 0.525f);
+    resolution.addFrameTime(0.001f);
+    CORRADE_VERIFY(resolution.scale() > 0.525f);
+    CORRADE_VERIFY(resolution.scale() < 0.6f);
+}
+
+void DynamicResolutionGLTest::frameTimeWithinHeadroom() {
+    DynamicResolution resolution{{640, 480}};
+    resolution.setTargetFrameTime(0.01f)
+        .setScale(0.5f);
+
+    /* Under the budget, but not enough to go up */
+    resolution.addFrameTime(0.009f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+}
+
+void DynamicResolutionGLTest::beginEnd() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available."));
+    #endif
+
+    DynamicResolution resolution{{64, 64}, TextureFormat::RGBA8, RenderbufferFormat::DepthComponent24, 2};
+    resolution.setScale(0.5f);
+
+    for(Int i = 0; i != 4; ++i) {
+        resolution.begin();
+        resolution.framebuffer().clear(FramebufferClear::Color|FramebufferClear::Depth);
+        resolution.end();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(resolution.framebuffer().viewport(), (Range2Di{{}, {32, 32}}));
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::DynamicResolutionGLTest)
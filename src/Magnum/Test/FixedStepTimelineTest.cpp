@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/FixedStepTimeline.h"
+
+namespace Magnum { namespace Test {
+
+struct FixedStepTimelineTest: TestSuite::Tester {
+    explicit FixedStepTimelineTest();
+
+    void construct();
+    void step();
+    void accumulate();
+    void negative();
+    void maxSteps();
+    void reset();
+};
+
+FixedStepTimelineTest::FixedStepTimelineTest() {
+    addTests({&FixedStepTimelineTest::construct,
+              &FixedStepTimelineTest::step,
+              &FixedStepTimelineTest::accumulate,
+              &FixedStepTimelineTest::negative,
+              &FixedStepTimelineTest::maxSteps,
+              &FixedStepTimelineTest::reset});
+}
+
+void FixedStepTimelineTest::construct() {
+    FixedStepTimeline t{0.25f, 4};
+    CORRADE_COMPARE(t.stepDuration(), 0.25f);
+    CORRADE_COMPARE(t.maxSteps(), 4);
+    CORRADE_COMPARE(t.stepCount(), 0);
+    CORRADE_COMPARE(t.time(), 0.0f);
+    CORRADE_COMPARE(t.alpha(), 0.0f);
+    CORRADE_COMPARE(t.droppedTime(), 0.0f);
+    CORRADE_VERIFY(!t.step());
+}
+
+void FixedStepTimelineTest::step() {
+    FixedStepTimeline t{0.25f};
+    t.advance(0.625f);
+
+    CORRADE_VERIFY(t.step());
+    CORRADE_VERIFY(t.step());
+    CORRADE_VERIFY(!t.step());
+    CORRADE_COMPARE(t.stepCount(), 2);
+    CORRADE_COMPARE(t.time(), 0.5f);
+    CORRADE_COMPARE(t.alpha(), 0.5f);
+}
+
+void FixedStepTimelineTest::accumulate() {
+    FixedStepTimeline t{0.25f};
+
+    /* Frames shorter than the step run no simulation */
+    t.advance(0.125f);
+    CORRADE_VERIFY(!t.step());
+    CORRADE_COMPARE(t.alpha(), 0.5f);
+
+    /* ...until enough time is accumulated */
+    t.advance(0.1875f);
+    CORRADE_VERIFY(t.step());
+    CORRADE_VERIFY(!t.step());
+    CORRADE_COMPARE(t.stepCount(), 1);
+    CORRADE_COMPARE(t.alpha(), 0.25f);
+}
+
+void FixedStepTimelineTest::negative() {
+    FixedStepTimeline t{0.25f};
+    t.advance(0.125f);
+    t.advance(-1.0f);
+    CORRADE_COMPARE(t.alpha(), 0.5f);
+}
+
+void FixedStepTimelineTest::maxSteps() {
+    FixedStepTimeline t{0.25f, 2};
+
+    /* A long hitch runs at most two steps, the rest is dropped */
+    t.advance(1.0f);
+    CORRADE_VERIFY(t.step());
+    CORRADE_VERIFY(t.step());
+    CORRADE_VERIFY(!t.step());
+    CORRADE_COMPARE(t.alpha(), 0.0f);
+    CORRADE_COMPARE(t.droppedTime(), 0.5f);
+}
+
+void FixedStepTimelineTest::reset() {
+    FixedStepTimeline t{0.25f, 2};
+    t.advance(1.125f);
+    CORRADE_VERIFY(t.step());
+
+    t.reset();
+    CORRADE_COMPARE(t.stepCount(), 0);
+    CORRADE_COMPARE(t.alpha(), 0.0f);
+    CORRADE_COMPARE(t.droppedTime(), 0.0f);
+    CORRADE_VERIFY(!t.step());
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FixedStepTimelineTest)
@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/FrameAllocator.h"
+
+namespace Magnum { namespace Test {
+
+struct FrameAllocatorTest: TestSuite::Tester {
+    explicit FrameAllocatorTest();
+
+    void construct();
+    void allocate();
+    void alignment();
+    void alignmentInvalid();
+    void overflow();
+    void rewind();
+    void nextFrame();
+    void deallocateNull();
+    void deallocateNoAllocation();
+
+    void vector();
+    void current();
+};
+
+FrameAllocatorTest::FrameAllocatorTest() {
+    addTests({&FrameAllocatorTest::construct,
+              &FrameAllocatorTest::allocate,
+              &FrameAllocatorTest::alignment,
+              &FrameAllocatorTest::alignmentInvalid,
+              &FrameAllocatorTest::overflow,
+              &FrameAllocatorTest::rewind,
+              &FrameAllocatorTest::nextFrame,
+              &FrameAllocatorTest::deallocateNull,
+              &FrameAllocatorTest::deallocateNoAllocation,
+
+              &FrameAllocatorTest::vector,
+              &FrameAllocatorTest::current});
+}
+
+void FrameAllocatorTest::construct() {
+    FrameAllocator a{1024};
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.usedSize(), 0);
+    CORRADE_COMPARE(a.allocationCount(), 0);
+    CORRADE_COMPARE(a.heapAllocationCount(), 0);
+}
+
+void FrameAllocatorTest::allocate() {
+    FrameAllocator a{1024};
+    char* first = static_cast<char*>(a.allocate(16, 1));
+    char* second = static_cast<char*>(a.allocate(32, 1));
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(second, first + 16);
+    CORRADE_COMPARE(a.capacity(), 1024);
+    CORRADE_COMPARE(a.usedSize(), 48);
+    CORRADE_COMPARE(a.allocationCount(), 2);
+    CORRADE_COMPARE(a.heapAllocationCount(), 1);
+
+    a.deallocate(second);
+    CORRADE_COMPARE(a.allocationCount(), 1);
+    CORRADE_COMPARE(a.usedSize(), 48);
+
+    a.deallocate(first);
+    CORRADE_COMPARE(a.allocationCount(), 0);
+    CORRADE_COMPARE(a.usedSize(), 0);
+
+    /* Memory is reused after everything is freed */
+    CORRADE_COMPARE(a.allocate(8, 1), first);
+    CORRADE_COMPARE(a.heapAllocationCount(), 1);
+}
+
+void FrameAllocatorTest::alignment() {
+    FrameAllocator a{1024};
+    a.allocate(1, 1);
+    void* aligned = a.allocate(4, 16);
+    CORRADE_COMPARE(reinterpret_cast<std::size_t>(aligned) % 16, 0);
+    CORRADE_VERIFY(a.usedSize() >= 5);
+    CORRADE_VERIFY(a.usedSize() <= 20);
+}
+
+void FrameAllocatorTest::alignmentInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FrameAllocator a;
+    a.allocate(4, 3);
+    CORRADE_COMPARE(out.str(), "FrameAllocator::allocate(): alignment 3 is not a power of two\n");
+}
+
+void FrameAllocatorTest::overflow() {
+    FrameAllocator a{64};
+    a.allocate(48, 1);
+    void* data = a.allocate(48, 1);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(a.capacity(), 128);
+    CORRADE_COMPARE(a.heapAllocationCount(), 2);
+
+    /* Allocation larger than the initial capacity gets its own block */
+    a.allocate(256, 8);
+    CORRADE_COMPARE(a.capacity(), 128 + 256 + 7);
+    CORRADE_COMPARE(a.heapAllocationCount(), 3);
+    CORRADE_COMPARE(a.allocationCount(), 3);
+}
+
+void FrameAllocatorTest::rewind() {
+    FrameAllocator a{64};
+    void* first = a.allocate(48, 1);
+    void* second = a.allocate(48, 1);
+    CORRADE_COMPARE(a.capacity(), 128);
+
+    /* Blocks get merged into one after all allocations are freed */
+    a.deallocate(first);
+    CORRADE_COMPARE(a.heapAllocationCount(), 2);
+    a.deallocate(second);
+    CORRADE_COMPARE(a.capacity(), 128);
+    CORRADE_COMPARE(a.heapAllocationCount(), 3);
+
+    /* Next time the same allocations fit without touching the heap */
+    a.nextFrame();
+    a.deallocate(a.allocate(48, 1));
+    a.allocate(48, 1);
+    a.allocate(48, 1);
+    CORRADE_COMPARE(a.heapAllocationCount(), 0);
+}
+
+void FrameAllocatorTest::nextFrame() {
+    FrameAllocator a{64};
+    a.allocate(16, 1);
+    CORRADE_COMPARE(a.heapAllocationCount(), 1);
+
+    a.nextFrame();
+    CORRADE_COMPARE(a.heapAllocationCount(), 0);
+    CORRADE_COMPARE(a.allocationCount(), 1);
+    CORRADE_COMPARE(a.usedSize(), 16);
+}
+
+void FrameAllocatorTest::deallocateNull() {
+    FrameAllocator a;
+    a.allocate(16, 1);
+    a.deallocate(nullptr);
+    CORRADE_COMPARE(a.allocationCount(), 1);
+}
+
+void FrameAllocatorTest::deallocateNoAllocation() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FrameAllocator a;
+    char data;
+    a.deallocate(&data);
+    CORRADE_COMPARE(out.str(), "FrameAllocator::deallocate(): no allocation to free\n");
+}
+
+void FrameAllocatorTest::vector() {
+    FrameAllocator a{1024};
+
+    {
+        FrameVector<Int> v(FrameAllocatorAdapter<Int>{a});
+        v.reserve(16);
+        for(Int i = 0; i != 16; ++i) v.push_back(i);
+        CORRADE_COMPARE(v[15], 15);
+        CORRADE_COMPARE(a.allocationCount(), 1);
+        CORRADE_COMPARE(a.usedSize() % sizeof(Int), 0);
+        CORRADE_VERIFY(a.usedSize() >= 16*sizeof(Int));
+    }
+
+    CORRADE_COMPARE(a.allocationCount(), 0);
+    CORRADE_COMPARE(a.usedSize(), 0);
+    CORRADE_COMPARE(a.heapAllocationCount(), 1);
+}
+
+void FrameAllocatorTest::current() {
+    FrameAllocator& a = FrameAllocator::current();
+    CORRADE_COMPARE(&FrameAllocator::current(), &a);
+
+    const std::size_t count = a.allocationCount();
+    {
+        FrameVector<Float> v(32, 1.5f);
+        CORRADE_COMPARE(&v.get_allocator().allocator(), &a);
+        CORRADE_COMPARE(a.allocationCount(), count + 1);
+    }
+    CORRADE_COMPARE(a.allocationCount(), count);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FrameAllocatorTest)
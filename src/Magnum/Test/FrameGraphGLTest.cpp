@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <vector>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/FrameGraph.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct FrameGraphGLTest: AbstractOpenGLTester {
+    explicit FrameGraphGLTest();
+
+    void order();
+    void cull();
+    void alias();
+    void aliasDifferentSize();
+    void multipleAttachments();
+    void recompile();
+};
+
+FrameGraphGLTest::FrameGraphGLTest() {
+    addTests({&FrameGraphGLTest::order,
+              &FrameGraphGLTest::cull,
+              &FrameGraphGLTest::alias,
+              &FrameGraphGLTest::aliasDifferentSize,
+              &FrameGraphGLTest::multipleAttachments,
+              &FrameGraphGLTest::recompile});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA8;
+    #else
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA;
+    #endif
+}
+
+void FrameGraphGLTest::order() {
+    Texture2D output;
+    output.setStorage(1, ColorFormat, Vector2i{32});
+
+    FrameGraph graph;
+    const UnsignedInt a = graph.addAttachment(ColorFormat);
+    const UnsignedInt result = graph.importAttachment(output, Vector2i{32}, ColorFormat);
+
+    std::vector<UnsignedInt> executed;
+    const UnsignedInt compose = graph.addPass([&]() { executed.push_back(0); });
+    const UnsignedInt render = graph.addPass([&]() { executed.push_back(1); });
+    const UnsignedInt present = graph.addPass([&]() { executed.push_back(2); });
+    graph.addRead(compose, a)
+        .addWrite(compose, result)
+        .addWrite(render, a)
+        .addRead(present, result);
+
+    graph.compile(Vector2i{32});
+    graph.execute();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(graph.passCount(), 3);
+    CORRADE_COMPARE(graph.culledPassCount(), 0);
+    CORRADE_COMPARE(graph.textureCount(), 1);
+    CORRADE_COMPARE(&graph.texture(result), &output);
+    CORRADE_COMPARE_AS(executed, (std::vector<UnsignedInt>{1, 0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void FrameGraphGLTest::cull() {
+    FrameGraph graph;
+    const UnsignedInt a = graph.addAttachment(ColorFormat);
+    const UnsignedInt unused = graph.addAttachment(ColorFormat);
+
+    std::vector<UnsignedInt> executed;
+    const UnsignedInt render = graph.addPass([&]() { executed.push_back(0); });
+    const UnsignedInt debug = graph.addPass([&]() { executed.push_back(1); });
+    const UnsignedInt present = graph.addPass([&]() { executed.push_back(2); });
+    graph.addWrite(render, a)
+        .addRead(debug, a)
+        .addWrite(debug, unused)
+        .addRead(present, a);
+
+    graph.compile(Vector2i{32});
+    graph.execute();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(graph.passCount(), 2);
+    CORRADE_COMPARE(graph.culledPassCount(), 1);
+    CORRADE_COMPARE(graph.textureCount(), 1);
+    CORRADE_COMPARE_AS(executed, (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void FrameGraphGLTest::alias() {
+    FrameGraph graph;
+    const UnsignedInt a = graph.addAttachment(ColorFormat);
+    const UnsignedInt b = graph.addAttachment(ColorFormat);
+    const UnsignedInt c = graph.addAttachment(ColorFormat);
+
+    const UnsignedInt first = graph.addPass({});
+    const UnsignedInt second = graph.addPass({});
+    const UnsignedInt third = graph.addPass({});
+    const UnsignedInt present = graph.addPass({});
+    graph.addWrite(first, a)
+        .addRead(second, a)
+        .addWrite(second, b)
+        .addRead(third, b)
+        .addWrite(third, c)
+        .addRead(present, c);
+
+    graph.compile(Vector2i{32});
+    graph.execute();
+
+    /* A is not needed anymore when C is written, B overlaps with both */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(graph.passCount(), 4);
+    CORRADE_COMPARE(graph.textureCount(), 2);
+    CORRADE_COMPARE(&graph.texture(a), &graph.texture(c));
+    CORRADE_VERIFY(&graph.texture(a) != &graph.texture(b));
+}
+
+void FrameGraphGLTest::aliasDifferentSize() {
+    FrameGraph graph;
+    const UnsignedInt a = graph.addAttachment(ColorFormat);
+    const UnsignedInt b = graph.addAttachment(ColorFormat, Vector2{0.5f});
+    const UnsignedInt c = graph.addAttachment(ColorFormat, Vector2{0.5f});
+    const UnsignedInt d = graph.addAttachment(ColorFormat);
+
+    const UnsignedInt first = graph.addPass({});
+    const UnsignedInt second = graph.addPass({});
+    const UnsignedInt third = graph.addPass({});
+    const UnsignedInt present = graph.addPass({});
+    graph.addWrite(first, a)
+        .addRead(second, a)
+        .addWrite(second, b)
+        .addRead(third, b)
+        .addWrite(third, c)
+        .addRead(present, c);
+    /* D is not used by any pass */
+    static_cast<void>(d);
+
+    graph.compile(Vector2i{32});
+    graph.execute();
+
+    /* C has the same lifetime relation as in the previous case, but
+       different size than A */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(graph.textureCount(), 3);
+    CORRADE_COMPARE(graph.framebuffer(second).viewport(), (Range2Di{{}, Vector2i{16}}));
+}
+
+void FrameGraphGLTest::multipleAttachments() {
+    #if defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!Context::current().isExtensionSupported<Extensions::GL::OES::depth_texture>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::ANGLE::depth_texture>())
+        CORRADE_SKIP("No required extension is supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::WEBGL::depth_texture>())
+        CORRADE_SKIP(Extensions::GL::WEBGL::depth_texture::string() + std::string(" is not supported."));
+    #endif
+
+    FrameGraph graph;
+    const UnsignedInt color = graph.addAttachment(ColorFormat);
+    #ifndef MAGNUM_TARGET_GLES2
+    const UnsignedInt normal = graph.addAttachment(ColorFormat);
+    #endif
+    const UnsignedInt depth = graph.addAttachment(
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::DepthComponent24
+        #else
+        TextureFormat::DepthComponent
+        #endif
+        );
+
+    Framebuffer::Status status{};
+    UnsignedInt gbuffer{};
+    gbuffer = graph.addPass([&]() {
+        status = graph.framebuffer(gbuffer).checkStatus(FramebufferTarget::Draw);
+        graph.framebuffer(gbuffer).clear(FramebufferClear::Color|FramebufferClear::Depth);
+    });
+    const UnsignedInt present = graph.addPass({});
+    graph.addWrite(gbuffer, color)
+        #ifndef MAGNUM_TARGET_GLES2
+        .addWrite(gbuffer, normal)
+        .addRead(present, normal)
+        #endif
+        .addWrite(gbuffer, depth)
+        .addRead(present, color)
+        .addRead(present, depth);
+
+    graph.compile(Vector2i{32});
+    graph.execute();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(status, Framebuffer::Status::Complete);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(graph.textureCount(), 3);
+    #else
+    CORRADE_COMPARE(graph.textureCount(), 2);
+    #endif
+}
+
+void FrameGraphGLTest::recompile() {
+    FrameGraph graph;
+    const UnsignedInt a = graph.addAttachment(ColorFormat);
+
+    const UnsignedInt render = graph.addPass({});
+    const UnsignedInt present = graph.addPass({});
+    graph.addWrite(render, a)
+        .addRead(present, a);
+
+    graph.compile(Vector2i{32});
+    const GLuint id = graph.texture(a).id();
+
+    /* Same size, the texture is kept */
+    graph.compile(Vector2i{32});
+    CORRADE_COMPARE(graph.texture(a).id(), id);
+
+    /* Different size, new texture */
+    graph.compile(Vector2i{64});
+    graph.execute();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(graph.framebuffer(render).viewport(), (Range2Di{{}, Vector2i{64}}));
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::FrameGraphGLTest)
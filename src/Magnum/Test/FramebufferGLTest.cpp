@@ -103,10 +103,14 @@ struct FramebufferGLTest: AbstractOpenGLTester {
     void multipleColorOutputs();
 
     void clear();
+    #ifndef MAGNUM_TARGET_GLES2
+    void clearColorInteger();
+    #endif
     void invalidate();
     #ifndef MAGNUM_TARGET_GLES2
     void invalidateSub();
     #endif
+    void renderPass();
     void read();
     #ifndef MAGNUM_TARGET_GLES2
     void readBuffer();
@@ -197,10 +201,14 @@ FramebufferGLTest::FramebufferGLTest() {
               &FramebufferGLTest::multipleColorOutputs,
 
               &FramebufferGLTest::clear,
+              #ifndef MAGNUM_TARGET_GLES2
+              &FramebufferGLTest::clearColorInteger,
+              #endif
               &FramebufferGLTest::invalidate,
               #ifndef MAGNUM_TARGET_GLES2
               &FramebufferGLTest::invalidateSub,
               #endif
+              &FramebufferGLTest::renderPass,
               &FramebufferGLTest::read,
               #ifndef MAGNUM_TARGET_GLES2
               &FramebufferGLTest::readBuffer,
@@ -1075,6 +1083,88 @@ namespace {
     const std::size_t DataOffset = 16*8;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FramebufferGLTest::clearColorInteger() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(128));
+
+    Renderbuffer objectId;
+    objectId.setStorage(RenderbufferFormat::R32UI, Vector2i(128));
+
+    Framebuffer framebuffer({{}, Vector2i(128)});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+               .attachRenderbuffer(Framebuffer::ColorAttachment(1), objectId)
+               .mapForDraw({{0, Framebuffer::ColorAttachment(0)},
+                            {1, Framebuffer::ColorAttachment(1)}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    framebuffer.clearColor(0, Math::normalize<Color4>(Color4ub(128, 64, 32, 17)))
+               .clearColor(1, Vector4ui(0xdeadbeef));
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    framebuffer.mapForRead(Framebuffer::ColorAttachment(0));
+    Image2D colorImage = framebuffer.read(Range2Di::fromSize({16, 8}, {1, 1}),
+        {PixelFormat::RGBA, PixelType::UnsignedByte});
+    framebuffer.mapForRead(Framebuffer::ColorAttachment(1));
+    Image2D objectIdImage = framebuffer.read(Range2Di::fromSize({16, 8}, {1, 1}),
+        {PixelFormat::RedInteger, PixelType::UnsignedInt});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(colorImage.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    CORRADE_COMPARE(objectIdImage.data<UnsignedInt>()[0], 0xdeadbeef);
+}
+#endif
+
+void FramebufferGLTest::renderPass() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(128));
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i(128));
+    #endif
+
+    Renderbuffer stencil;
+    stencil.setStorage(RenderbufferFormat::StencilIndex8, Vector2i(128));
+
+    Framebuffer framebuffer({{}, Vector2i(128)});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::Stencil, stencil);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!framebuffer.renderPassClear());
+    CORRADE_VERIFY(!framebuffer.renderPassInvalidation());
+
+    framebuffer.setRenderPassPolicy(FramebufferClear::Color|FramebufferClear::Stencil, FramebufferClear::Stencil);
+    CORRADE_VERIFY(framebuffer.renderPassClear() == (FramebufferClear::Color|FramebufferClear::Stencil));
+    CORRADE_VERIFY(framebuffer.renderPassInvalidation() == FramebufferClear::Stencil);
+
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(128, 64, 32, 17)));
+    framebuffer.beginRenderPass()
+               .endRenderPass();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D colorImage = framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(colorImage.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    #endif
+}
+
 void FramebufferGLTest::read() {
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
@@ -0,0 +1,166 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/FramebufferReader.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct FramebufferReaderGLTest: AbstractOpenGLTester {
+    explicit FramebufferReaderGLTest();
+
+    void construct();
+
+    void read();
+    void readMultiple();
+    void discard();
+};
+
+FramebufferReaderGLTest::FramebufferReaderGLTest() {
+    addTests({&FramebufferReaderGLTest::construct,
+
+              &FramebufferReaderGLTest::read,
+              &FramebufferReaderGLTest::readMultiple,
+              &FramebufferReaderGLTest::discard});
+}
+
+void FramebufferReaderGLTest::construct() {
+    FramebufferReader reader{2};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(reader.slotCount(), 2);
+    CORRADE_COMPARE(reader.pendingCount(), 0);
+}
+
+void FramebufferReaderGLTest::read() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(32));
+    Framebuffer framebuffer{{{}, Vector2i(32)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(128, 64, 32, 17)));
+    framebuffer.clear(FramebufferClear::Color);
+
+    FramebufferReader reader{2};
+    const UnsignedInt slot = reader.read(framebuffer, Range2Di::fromSize({4, 8}, {8, 4}), PixelFormat::RGBA, PixelType::UnsignedByte);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(reader.pendingCount(), 1);
+    CORRADE_COMPARE(reader.image(slot).size(), (Vector2i{8, 4}));
+
+    /* Don't wait forever if the fence doesn't get signaled */
+    for(std::size_t i = 0; i != 1000000 && !reader.isReady(slot); ++i);
+    CORRADE_VERIFY(reader.isReady(slot));
+
+    Image2D image = reader.retrieve(slot);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(reader.pendingCount(), 0);
+
+    CORRADE_COMPARE(image.size(), (Vector2i{8, 4}));
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    CORRADE_COMPARE(image.data<Color4ub>()[8*4 - 1], Color4ub(128, 64, 32, 17));
+}
+
+void FramebufferReaderGLTest::readMultiple() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(4));
+    Framebuffer framebuffer{{{}, Vector2i(4)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    FramebufferReader reader{2};
+
+    /* Second read goes to the other slot while the first one is in flight,
+       the first retrieved slot is then reused */
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(10, 20, 30, 40)));
+    framebuffer.clear(FramebufferClear::Color);
+    const UnsignedInt a = reader.read(framebuffer, {{}, Vector2i(4)}, PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(50, 60, 70, 80)));
+    framebuffer.clear(FramebufferClear::Color);
+    const UnsignedInt b = reader.read(framebuffer, {{}, Vector2i(2)}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(reader.pendingCount(), 2);
+
+    Image2D first = reader.retrieve(a);
+    CORRADE_COMPARE(first.size(), Vector2i(4));
+    CORRADE_COMPARE(first.data<Color4ub>()[0], Color4ub(10, 20, 30, 40));
+
+    const UnsignedInt c = reader.read(framebuffer, {{}, Vector2i(4)}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    CORRADE_COMPARE(c, a);
+
+    Image2D second = reader.retrieve(b);
+    Image2D third = reader.retrieve(c);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(second.size(), Vector2i(2));
+    CORRADE_COMPARE(second.data<Color4ub>()[0], Color4ub(50, 60, 70, 80));
+    CORRADE_COMPARE(third.data<Color4ub>()[15], Color4ub(50, 60, 70, 80));
+}
+
+void FramebufferReaderGLTest::discard() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(4));
+    Framebuffer framebuffer{{{}, Vector2i(4)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    FramebufferReader reader{1};
+    const UnsignedInt slot = reader.read(framebuffer, {{}, Vector2i(4)}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    reader.discard(slot);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(reader.pendingCount(), 0);
+
+    /* The slot is free again */
+    CORRADE_COMPARE(reader.read(framebuffer, {{}, Vector2i(4)}, PixelFormat::RGBA, PixelType::UnsignedByte), slot);
+    reader.retrieve(slot);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::FramebufferReaderGLTest)
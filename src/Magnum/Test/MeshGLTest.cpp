@@ -105,6 +105,13 @@ struct MeshGLTest: AbstractOpenGLTester {
 
     void addVertexBufferMultiple();
     void addVertexBufferMultipleGaps();
+    void addVertexBufferSwitchMeshes();
+    void addVertexBufferSwitchMeshesDeletedBuffer();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void addVertexFormat();
+    void addVertexFormatSetVertexBuffer();
+    #endif
 
     void setIndexBuffer();
     void setIndexBufferRange();
@@ -135,6 +142,15 @@ struct MeshGLTest: AbstractOpenGLTester {
     #ifndef MAGNUM_TARGET_GLES
     void multiDrawBaseVertex();
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawIndirect();
+    void drawIndirectIndexed();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void drawIndirectCount();
+    void drawIndirectCountIndexed();
+    #endif
 };
 
 MeshGLTest::MeshGLTest() {
@@ -197,6 +213,13 @@ MeshGLTest::MeshGLTest() {
 
               &MeshGLTest::addVertexBufferMultiple,
               &MeshGLTest::addVertexBufferMultipleGaps,
+              &MeshGLTest::addVertexBufferSwitchMeshes,
+              &MeshGLTest::addVertexBufferSwitchMeshesDeletedBuffer,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::addVertexFormat,
+              &MeshGLTest::addVertexFormatSetVertexBuffer,
+              #endif
 
               &MeshGLTest::setIndexBuffer,
               &MeshGLTest::setIndexBufferRange,
@@ -225,7 +248,16 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::multiDraw,
               &MeshGLTest::multiDrawIndexed,
               #ifndef MAGNUM_TARGET_GLES
-              &MeshGLTest::multiDrawBaseVertex
+              &MeshGLTest::multiDrawBaseVertex,
+              #endif
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::drawIndirect,
+              &MeshGLTest::drawIndirectIndexed,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &MeshGLTest::drawIndirectCount,
+              &MeshGLTest::drawIndirectCountIndexed
               #endif
               });
 }
@@ -1316,6 +1348,75 @@ void MeshGLTest::addVertexBufferMultipleGaps() {
     CORRADE_COMPARE(value, Color4ub(64 + 15 + 97, 17 + 164 + 28, 56 + 17, 255));
 }
 
+namespace {
+    UnsignedByte drawFloat(Mesh& mesh) {
+        return Checker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+            #ifndef MAGNUM_TARGET_GLES2
+            RenderbufferFormat::RGBA8,
+            #else
+            RenderbufferFormat::RGBA4,
+            #endif
+            mesh).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    }
+}
+
+void MeshGLTest::addVertexBufferSwitchMeshes() {
+    typedef Attribute<0, Float> Attribute;
+
+    const Float dataA[] = { 0.0f, -0.7f, Math::normalize<Float, UnsignedByte>(96) };
+    const Float dataB[] = { 0.0f, 0.0f, 0.3f, Math::normalize<Float, UnsignedByte>(48) };
+    Buffer bufferA, bufferB;
+    bufferA.setData(dataA, BufferUsage::StaticDraw);
+    bufferB.setData(dataB, BufferUsage::StaticDraw);
+
+    /* Same attribute location and format, but different buffer and offset,
+       which has to be respecified even if vertex array objects are not
+       available */
+    Mesh meshA, meshB;
+    meshA.setBaseVertex(1)
+        .addVertexBuffer(bufferA, 4, Attribute());
+    meshB.setBaseVertex(1)
+        .addVertexBuffer(bufferB, 8, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(drawFloat(meshA), 96);
+    CORRADE_COMPARE(drawFloat(meshB), 48);
+    CORRADE_COMPARE(drawFloat(meshA), 96);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MeshGLTest::addVertexBufferSwitchMeshesDeletedBuffer() {
+    typedef Attribute<0, Float> Attribute;
+
+    {
+        const Float data[] = { 0.0f, -0.7f, Math::normalize<Float, UnsignedByte>(96) };
+        Buffer buffer;
+        buffer.setData(data, BufferUsage::StaticDraw);
+
+        Mesh mesh;
+        mesh.setBaseVertex(1)
+            .addVertexBuffer(buffer, 4, Attribute());
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(drawFloat(mesh), 96);
+    }
+
+    /* The new buffer may get the same ID as the deleted one, the attribute
+       has to be specified again anyway */
+    const Float data[] = { 0.0f, -0.7f, Math::normalize<Float, UnsignedByte>(32) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setBaseVertex(1)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawFloat(mesh), 32);
+}
+
 namespace {
     const Float indexedVertexData[] = {
         0.0f, /* Offset */
@@ -1370,6 +1471,81 @@ namespace {
     constexpr Color4ub indexedResult(64 + 15 + 97, 17 + 164 + 28, 56 + 17, 255);
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::addVertexFormat() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>())
+        CORRADE_SKIP(Extensions::GL::ARB::vertex_attrib_binding::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = {
+        0.0f, 0.0f, -0.7f,
+        0.0f, 0.0f, Math::normalize<Float, UnsignedByte>(96)
+    };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    /* Gap before the attribute, vertex stride is 12 bytes */
+    Mesh mesh;
+    mesh.addVertexFormat(0, 8, Attribute{})
+        .setVertexBuffer(0, buffer, 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = Checker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        RenderbufferFormat::RGBA8, mesh).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::addVertexFormatSetVertexBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>())
+        CORRADE_SKIP(Extensions::GL::ARB::vertex_attrib_binding::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float first[] = { 0.0f, 0.0f, Math::normalize<Float, UnsignedByte>(96) };
+    const Float second[] = { Math::normalize<Float, UnsignedByte>(32), Math::normalize<Float, UnsignedByte>(64) };
+    Buffer a, b;
+    a.setData(first, BufferUsage::StaticDraw);
+    b.setData(second, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexFormat(0, Attribute{})
+        .setVertexBuffer(0, a, 4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = Checker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        RenderbufferFormat::RGBA8, mesh).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+
+    /* Swapping the buffer doesn't need the format to be specified again */
+    mesh.setVertexBuffer(0, b, 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto swapped = Checker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        RenderbufferFormat::RGBA8, mesh).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(swapped, 64);
+}
+#endif
+
 void MeshGLTest::setIndexBuffer() {
     Buffer vertices;
     vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
@@ -1873,6 +2049,76 @@ template<class T> T MultiChecker::get(PixelFormat format, PixelType type) {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace {
+    struct IndirectChecker {
+        IndirectChecker(AbstractShaderProgram&& shader, Mesh& mesh, bool drawCount = false);
+
+        template<class T> T get(PixelFormat format, PixelType type);
+
+        Renderbuffer renderbuffer;
+        Framebuffer framebuffer;
+    };
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+IndirectChecker::IndirectChecker(AbstractShaderProgram&& shader, Mesh& mesh, const bool drawCount): framebuffer({{}, Vector2i(1)}) {
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i(1));
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+
+    framebuffer.bind();
+    mesh.setPrimitive(MeshPrimitive::Points);
+
+    /* Same views as in MultiChecker, with the second one drawn last */
+    MeshView a(mesh);
+    a.setCount(1);
+
+    MeshView b(mesh);
+    b.setCount(1);
+    if(mesh.isIndexed()) b.setIndexRange(1);
+    else b.setBaseVertex(1);
+
+    /* Padding between the commands to test also stride */
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    if(mesh.isIndexed()) {
+        const MeshView::DrawElementsIndirectCommand data[] = {
+            a.elementsIndirectCommand(), {},
+            b.elementsIndirectCommand(), {}
+        };
+        commands.setData(data, BufferUsage::StaticDraw);
+    } else {
+        const MeshView::DrawArraysIndirectCommand data[] = {
+            a.arraysIndirectCommand(), {},
+            b.arraysIndirectCommand(), {}
+        };
+        commands.setData(data, BufferUsage::StaticDraw);
+    }
+
+    const GLsizei stride = 2*(mesh.isIndexed() ? sizeof(MeshView::DrawElementsIndirectCommand) : sizeof(MeshView::DrawArraysIndirectCommand));
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Draw count taken from a buffer, at non-zero offset */
+    if(drawCount) {
+        constexpr UnsignedInt countData[] = { 0, 2 };
+        Buffer count{Buffer::TargetHint::Parameter};
+        count.setData(countData, BufferUsage::StaticDraw);
+
+        MeshView::drawIndirect(shader, mesh, commands, 0, count, 4, 2, stride);
+        return;
+    }
+    #else
+    static_cast<void>(drawCount);
+    #endif
+
+    MeshView::drawIndirect(shader, mesh, commands, 0, 2, stride);
+}
+
+template<class T> T IndirectChecker::get(PixelFormat format, PixelType type) {
+    return framebuffer.read({{}, Vector2i{1}}, {format, type}).data<T>()[0];
+}
+#endif
+#endif
+
 void MeshGLTest::multiDraw() {
     #ifdef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::EXT::multi_draw_arrays>())
@@ -1950,6 +2196,116 @@ void MeshGLTest::multiDrawBaseVertex() {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::drawIndirect() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::normalize<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = IndirectChecker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        mesh).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectIndexed() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(vertices, 1*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 2, Mesh::IndexType::UnsignedShort);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = IndirectChecker(MultipleShader{}, mesh).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, indexedResult);
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshGLTest::drawIndirectCount() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::indirect_parameters>())
+        CORRADE_SKIP(Extensions::GL::ARB::indirect_parameters::string() + std::string(" is not available."));
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::normalize<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = IndirectChecker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        mesh, true).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectCountIndexed() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::indirect_parameters>())
+        CORRADE_SKIP(Extensions::GL::ARB::indirect_parameters::string() + std::string(" is not available."));
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(vertices, 1*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 2, Mesh::IndexType::UnsignedShort);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto value = IndirectChecker(MultipleShader{}, mesh, true).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, indexedResult);
+}
+#endif
+
 }}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Test::MeshGLTest)
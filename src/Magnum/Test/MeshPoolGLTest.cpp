@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/MeshPool.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct MeshPoolGLTest: AbstractOpenGLTester {
+    explicit MeshPoolGLTest();
+
+    void construct();
+
+    void add();
+    void addAligned();
+    void addNoIndices();
+    void addNoSpace();
+    void remove();
+    void removeMerge();
+};
+
+MeshPoolGLTest::MeshPoolGLTest() {
+    addTests({&MeshPoolGLTest::construct,
+
+              &MeshPoolGLTest::add,
+              &MeshPoolGLTest::addAligned,
+              &MeshPoolGLTest::addNoIndices,
+              &MeshPoolGLTest::addNoSpace,
+              &MeshPoolGLTest::remove,
+              &MeshPoolGLTest::removeMerge});
+}
+
+namespace {
+    constexpr Float Vertices[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    constexpr UnsignedShort Indices[]{0, 1, 2};
+}
+
+void MeshPoolGLTest::construct() {
+    MeshPool pool{1000, 500};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(pool.vertexBuffer().id() > 0);
+    CORRADE_VERIFY(pool.indexBuffer().id() > 0);
+    CORRADE_VERIFY(pool.vertexCapacity() >= 1000);
+    CORRADE_VERIFY(pool.indexCapacity() >= 500);
+    CORRADE_COMPARE(pool.vertexBuffer().size(), pool.vertexCapacity());
+
+    if(pool.isSparse()) {
+        Debug() << "Using sparse buffers";
+        CORRADE_COMPARE(pool.committedSize(), 0);
+    } else CORRADE_COMPARE(pool.committedSize(), pool.vertexCapacity() + pool.indexCapacity());
+}
+
+void MeshPoolGLTest::add() {
+    MeshPool pool{1000, 500};
+
+    std::optional<MeshPool::Allocation> a = pool.add(Vertices, 8, Indices, 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->vertexOffset, 0);
+    CORRADE_COMPARE(a->vertexSize, 24);
+    CORRADE_COMPARE(a->indexOffset, 0);
+    CORRADE_COMPARE(a->indexSize, 6);
+
+    std::optional<MeshPool::Allocation> b = pool.add(Vertices, 8, Indices, 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->vertexOffset, 24);
+    CORRADE_COMPARE(b->indexOffset, 6);
+
+    if(pool.isSparse()) CORRADE_COMPARE(pool.committedSize(), 2*Buffer::sparsePageSize());
+
+    const Containers::Array<Float> vertices = pool.vertexBuffer().subData<Float>(b->vertexOffset, 6);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(vertices[4], 4.0f);
+
+    const Containers::Array<UnsignedShort> indices = pool.indexBuffer().subData<UnsignedShort>(b->indexOffset, 3);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(indices[2], 2);
+}
+
+void MeshPoolGLTest::addAligned() {
+    MeshPool pool{1000, 500};
+
+    std::optional<MeshPool::Allocation> a = pool.add({Vertices, 20}, 1, Indices, 2);
+    CORRADE_VERIFY(a);
+
+    /* Aligned to the vertex stride */
+    std::optional<MeshPool::Allocation> b = pool.add(Vertices, 12, Indices, 2);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->vertexOffset, 24);
+
+    /* The gap before is still free */
+    std::optional<MeshPool::Allocation> c = pool.add({Vertices, 4}, 1, Indices, 2);
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(c->vertexOffset, 20);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MeshPoolGLTest::addNoIndices() {
+    MeshPool pool{1000, 500};
+
+    std::optional<MeshPool::Allocation> a = pool.add(Vertices, 4, nullptr, 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->indexOffset, 0);
+    CORRADE_COMPARE(a->indexSize, 0);
+
+    pool.remove(*a);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MeshPoolGLTest::addNoSpace() {
+    MeshPool pool{1000, 500};
+
+    /* Fill the whole capacity, whatever it got rounded to */
+    Containers::Array<char> data{std::size_t(pool.indexCapacity())};
+    std::optional<MeshPool::Allocation> a = pool.add(Vertices, 4, {data.data(), data.size()}, 1);
+    CORRADE_VERIFY(a);
+
+    /* Vertices would fit but indices not, nothing is allocated */
+    CORRADE_VERIFY(!pool.add(Vertices, 4, Indices, 2));
+    std::optional<MeshPool::Allocation> b = pool.add(Vertices, 4, nullptr, 1);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->vertexOffset, 24);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MeshPoolGLTest::remove() {
+    MeshPool pool{1000, 500};
+
+    std::optional<MeshPool::Allocation> a = pool.add(Vertices, 4, Indices, 2);
+    std::optional<MeshPool::Allocation> b = pool.add(Vertices, 4, Indices, 2);
+    CORRADE_VERIFY(a && b);
+
+    pool.remove(*a);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The page is still used by the other allocation */
+    if(pool.isSparse()) CORRADE_COMPARE(pool.committedSize(), 2*Buffer::sparsePageSize());
+
+    /* The space is reused */
+    std::optional<MeshPool::Allocation> c = pool.add(Vertices, 4, Indices, 2);
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(c->vertexOffset, 0);
+    CORRADE_COMPARE(c->indexOffset, 0);
+
+    pool.remove(*b);
+    pool.remove(*c);
+    MAGNUM_VERIFY_NO_ERROR();
+    if(pool.isSparse()) CORRADE_COMPARE(pool.committedSize(), 0);
+}
+
+void MeshPoolGLTest::removeMerge() {
+    MeshPool pool{1000, 500};
+
+    std::optional<MeshPool::Allocation> a = pool.add(Vertices, 4, Indices, 2);
+    std::optional<MeshPool::Allocation> b = pool.add(Vertices, 4, Indices, 2);
+    std::optional<MeshPool::Allocation> c = pool.add(Vertices, 4, Indices, 2);
+    CORRADE_VERIFY(a && b && c);
+
+    /* Freeing the outer ones first and then the middle one merges all three
+       into one block again, so a larger allocation fits at the beginning */
+    pool.remove(*a);
+    pool.remove(*c);
+    pool.remove(*b);
+
+    Containers::Array<char> data{72};
+    std::optional<MeshPool::Allocation> d = pool.add({data.data(), data.size()}, 1, Indices, 2);
+    CORRADE_VERIFY(d);
+    CORRADE_COMPARE(d->vertexOffset, 0);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::MeshPoolGLTest)
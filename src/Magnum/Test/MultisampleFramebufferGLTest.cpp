@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/MultisampleFramebuffer.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct MultisampleFramebufferGLTest: AbstractOpenGLTester {
+    explicit MultisampleFramebufferGLTest();
+
+    void construct();
+    void constructCopy();
+    void resolve();
+    void resolveRectangle();
+};
+
+MultisampleFramebufferGLTest::MultisampleFramebufferGLTest() {
+    addTests({&MultisampleFramebufferGLTest::construct,
+              &MultisampleFramebufferGLTest::constructCopy,
+              &MultisampleFramebufferGLTest::resolve,
+              &MultisampleFramebufferGLTest::resolveRectangle});
+}
+
+void MultisampleFramebufferGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_storage>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_storage::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>())
+        CORRADE_SKIP(Extensions::GL::EXT::multisampled_render_to_texture::string() + std::string(" is not available."));
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    MultisampleFramebuffer framebuffer{texture, Vector2i{32}, 4,
+        RenderbufferFormat::RGBA8, RenderbufferFormat::Depth24Stencil8};
+    #else
+    MultisampleFramebuffer framebuffer{texture, Vector2i{32}, 4,
+        RenderbufferFormat::RGBA8, RenderbufferFormat::DepthComponent16};
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.size(), Vector2i{32});
+    CORRADE_COMPARE(framebuffer.samples(), 4);
+    CORRADE_VERIFY(framebuffer.framebuffer().id() > 0);
+    CORRADE_COMPARE(framebuffer.framebuffer().checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_COMPARE(framebuffer.isImplicitResolve(), Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>());
+    #else
+    CORRADE_VERIFY(!framebuffer.isImplicitResolve());
+    #endif
+}
+
+void MultisampleFramebufferGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<MultisampleFramebuffer, const MultisampleFramebuffer&>{}));
+    CORRADE_VERIFY(!(std::is_constructible<MultisampleFramebuffer, MultisampleFramebuffer&&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<MultisampleFramebuffer, const MultisampleFramebuffer&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<MultisampleFramebuffer, MultisampleFramebuffer&&>{}));
+}
+
+void MultisampleFramebufferGLTest::resolve() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_storage>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_storage::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>())
+        CORRADE_SKIP(Extensions::GL::EXT::multisampled_render_to_texture::string() + std::string(" is not available."));
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+
+    MultisampleFramebuffer framebuffer{texture, Vector2i{32}, 4,
+        RenderbufferFormat::RGBA8, RenderbufferFormat::DepthComponent16};
+
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(128, 64, 32, 17)));
+    framebuffer.framebuffer().clear(FramebufferClear::Color|FramebufferClear::Depth);
+    framebuffer.resolve();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Framebuffer read{{{}, Vector2i{32}}};
+    read.attachTexture(Framebuffer::ColorAttachment{0}, texture, 0);
+    Image2D image = read.read({{}, Vector2i{32}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    CORRADE_COMPARE(image.data<Color4ub>()[32*32 - 1], Color4ub(128, 64, 32, 17));
+}
+
+void MultisampleFramebufferGLTest::resolveRectangle() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_storage>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_storage::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>())
+        CORRADE_SKIP(Extensions::GL::EXT::multisampled_render_to_texture::string() + std::string(" is not available."));
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+
+    MultisampleFramebuffer framebuffer{texture, Vector2i{32}, 4,
+        RenderbufferFormat::RGBA8, RenderbufferFormat::DepthComponent16};
+    if(framebuffer.isImplicitResolve())
+        CORRADE_SKIP("The whole framebuffer is always resolved with implicit resolve.");
+
+    /* Resolve black everywhere first, then only the bottom left quarter */
+    Renderer::setClearColor(Color4{0.0f});
+    framebuffer.framebuffer().clear(FramebufferClear::Color);
+    framebuffer.resolve();
+
+    Renderer::setClearColor(Math::normalize<Color4>(Color4ub(128, 64, 32, 17)));
+    framebuffer.framebuffer().clear(FramebufferClear::Color);
+    framebuffer.resolve({{}, Vector2i{16}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Framebuffer read{{{}, Vector2i{32}}};
+    read.attachTexture(Framebuffer::ColorAttachment{0}, texture, 0);
+    Image2D image = read.read({{}, Vector2i{32}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    CORRADE_COMPARE(image.data<Color4ub>()[32*32 - 1], Color4ub{});
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::MultisampleFramebufferGLTest)
@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Attribute.h"
+#include "Magnum/Buffer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/BufferImage.h"
+#endif
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Test/AbstractOpenGLBenchmarker.h"
+
+namespace Magnum { namespace Test {
+
+struct OpenGLBenchmark: AbstractOpenGLBenchmarker {
+    explicit OpenGLBenchmark();
+
+    void bufferSetData();
+    void bufferSetSubData();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void bufferMap();
+    #endif
+
+    void meshDraw();
+    void meshViewDraw();
+    void meshViewMultiDraw();
+
+    void textureSetSubImage();
+    #ifndef MAGNUM_TARGET_GLES2
+    void textureSetSubImageBuffer();
+    #endif
+};
+
+OpenGLBenchmark::OpenGLBenchmark() {
+    addTests({&OpenGLBenchmark::bufferSetData,
+              &OpenGLBenchmark::bufferSetSubData,
+              #ifndef MAGNUM_TARGET_WEBGL
+              &OpenGLBenchmark::bufferMap,
+              #endif
+
+              &OpenGLBenchmark::meshDraw,
+              &OpenGLBenchmark::meshViewDraw,
+              &OpenGLBenchmark::meshViewMultiDraw,
+
+              &OpenGLBenchmark::textureSetSubImage,
+              #ifndef MAGNUM_TARGET_GLES2
+              &OpenGLBenchmark::textureSetSubImageBuffer
+              #endif
+              });
+}
+
+namespace {
+
+enum: std::size_t { BufferSize = 64*1024 };
+
+struct PositionShader: AbstractShaderProgram {
+    typedef Attribute<0, Vector2> Position;
+
+    explicit PositionShader() {
+        #ifndef MAGNUM_TARGET_GLES
+        Shader vert(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Vertex);
+        Shader frag(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Fragment);
+        #elif defined(MAGNUM_TARGET_GLES2)
+        Shader vert(Version::GLES200, Shader::Type::Vertex);
+        Shader frag(Version::GLES200, Shader::Type::Fragment);
+        #else
+        Shader vert(Version::GLES300, Shader::Type::Vertex);
+        Shader frag(Version::GLES300, Shader::Type::Fragment);
+        #endif
+
+        vert.addSource(
+            "#if !defined(GL_ES) && __VERSION__ == 120\n"
+            "#define mediump\n"
+            "#endif\n"
+            "#if __VERSION__ < 130\n"
+            "#define in attribute\n"
+            "#endif\n"
+            "in mediump vec2 position;\n"
+            "void main() {\n"
+            "    gl_Position = vec4(position, 0.0, 1.0);\n"
+            "}\n");
+        frag.addSource(
+            "#if !defined(GL_ES) && __VERSION__ == 120\n"
+            "#define mediump\n"
+            "#endif\n"
+            "#if __VERSION__ < 130\n"
+            "#define result gl_FragColor\n"
+            "#else\n"
+            "out mediump vec4 result;\n"
+            "#endif\n"
+            "void main() { result = vec4(1.0); }\n");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        bindAttributeLocation(Position::Location, "position");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
+};
+
+struct RenderTarget {
+    explicit RenderTarget(): framebuffer{{{}, Vector2i{16}}} {
+        renderbuffer.setStorage(
+            #ifndef MAGNUM_TARGET_GLES2
+            RenderbufferFormat::RGBA8,
+            #else
+            RenderbufferFormat::RGBA4,
+            #endif
+            Vector2i{16});
+        framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+            .bind();
+    }
+
+    Renderbuffer renderbuffer;
+    Framebuffer framebuffer;
+};
+
+}
+
+void OpenGLBenchmark::bufferSetData() {
+    Containers::Array<char> data{Containers::ValueInit, BufferSize};
+    Buffer buffer;
+
+    measure("Buffer::setData() 64 kB", 1000, [&]() {
+        buffer.setData({data.data(), data.size()}, BufferUsage::StreamDraw);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OpenGLBenchmark::bufferSetSubData() {
+    Containers::Array<char> data{Containers::ValueInit, BufferSize};
+    Buffer buffer;
+    buffer.setData({data.data(), data.size()}, BufferUsage::StreamDraw);
+
+    measure("Buffer::setSubData() 64 kB", 1000, [&]() {
+        buffer.setSubData(0, {data.data(), data.size()});
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void OpenGLBenchmark::bufferMap() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::EXT::map_buffer_range::string() + std::string(" is not supported"));
+    #endif
+
+    Containers::Array<char> data{Containers::ValueInit, BufferSize};
+    Buffer buffer;
+    buffer.setData({data.data(), data.size()}, BufferUsage::StreamDraw);
+
+    measure("Buffer::map() 64 kB", 1000, [&]() {
+        char* mapped = buffer.map<char>(0, BufferSize, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+        std::memcpy(mapped, data.data(), BufferSize);
+        buffer.unmap();
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+void OpenGLBenchmark::meshDraw() {
+    RenderTarget target;
+    PositionShader shader;
+
+    const Vector2 positions[]{{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.0f, 0.5f}};
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0, PositionShader::Position{});
+
+    measure("Mesh::draw()", 10000, [&]() {
+        mesh.draw(shader);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OpenGLBenchmark::meshViewDraw() {
+    RenderTarget target;
+    PositionShader shader;
+
+    Vector2 positions[8*3];
+    for(std::size_t i = 0; i != 8; ++i) {
+        positions[i*3 + 0] = {-0.5f, -0.5f};
+        positions[i*3 + 1] = {0.5f, -0.5f};
+        positions[i*3 + 2] = {0.0f, 0.5f};
+    }
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(vertices, 0, PositionShader::Position{});
+
+    MeshView a{mesh}, b{mesh}, c{mesh}, d{mesh}, e{mesh}, f{mesh}, g{mesh}, h{mesh};
+    Int baseVertex = 0;
+    for(MeshView* view: {&a, &b, &c, &d, &e, &f, &g, &h}) {
+        view->setCount(3).setBaseVertex(baseVertex);
+        baseVertex += 3;
+    }
+
+    /* Same as below, but with a separate draw call for each view */
+    measure("8x MeshView::draw()", 1000, [&]() {
+        for(MeshView* view: {&a, &b, &c, &d, &e, &f, &g, &h})
+            view->draw(shader);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OpenGLBenchmark::meshViewMultiDraw() {
+    RenderTarget target;
+    PositionShader shader;
+
+    Vector2 positions[8*3];
+    for(std::size_t i = 0; i != 8; ++i) {
+        positions[i*3 + 0] = {-0.5f, -0.5f};
+        positions[i*3 + 1] = {0.5f, -0.5f};
+        positions[i*3 + 2] = {0.0f, 0.5f};
+    }
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(vertices, 0, PositionShader::Position{});
+
+    MeshView a{mesh}, b{mesh}, c{mesh}, d{mesh}, e{mesh}, f{mesh}, g{mesh}, h{mesh};
+    Int baseVertex = 0;
+    for(MeshView* view: {&a, &b, &c, &d, &e, &f, &g, &h}) {
+        view->setCount(3).setBaseVertex(baseVertex);
+        baseVertex += 3;
+    }
+
+    measure("MeshView::draw() with 8 views", 1000, [&]() {
+        MeshView::draw(shader, {a, b, c, d, e, f, g, h});
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OpenGLBenchmark::textureSetSubImage() {
+    Texture2D texture;
+    texture.setStorage(1,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        Vector2i{256});
+
+    Containers::Array<char> data{Containers::ValueInit, 256*256*4};
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{256}, {data.data(), data.size()}};
+
+    measure("Texture2D::setSubImage() 256x256 RGBA8", 100, [&]() {
+        texture.setSubImage(0, {}, image);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void OpenGLBenchmark::textureSetSubImageBuffer() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{256});
+
+    Containers::Array<char> data{Containers::ValueInit, 256*256*4};
+    BufferImage2D image{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{256}, {data.data(), data.size()}, BufferUsage::StaticDraw};
+
+    measure("Texture2D::setSubImage() 256x256 RGBA8 from a buffer", 100, [&]() {
+        texture.setSubImage(0, {}, image);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::OpenGLBenchmark)
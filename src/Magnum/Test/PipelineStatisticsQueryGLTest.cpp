@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/PipelineStatisticsQuery.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct PipelineStatisticsQueryGLTest: AbstractOpenGLTester {
+    explicit PipelineStatisticsQueryGLTest();
+
+    void constructNoCreate();
+    void wrap();
+
+    void query();
+};
+
+PipelineStatisticsQueryGLTest::PipelineStatisticsQueryGLTest() {
+    addTests({&PipelineStatisticsQueryGLTest::constructNoCreate,
+              &PipelineStatisticsQueryGLTest::wrap,
+
+              &PipelineStatisticsQueryGLTest::query});
+}
+
+void PipelineStatisticsQueryGLTest::constructNoCreate() {
+    {
+        PipelineStatisticsQuery query{NoCreate};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(query.id(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void PipelineStatisticsQueryGLTest::wrap() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::pipeline_statistics_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::pipeline_statistics_query::string() + std::string(" is not available."));
+
+    GLuint id;
+    glGenQueries(1, &id);
+
+    /* Releasing won't delete anything */
+    {
+        auto query = PipelineStatisticsQuery::wrap(id, PipelineStatisticsQuery::Target::VerticesSubmitted, ObjectFlag::DeleteOnDestruction);
+        CORRADE_COMPARE(query.release(), id);
+    }
+
+    /* ...so we can wrap it again */
+    PipelineStatisticsQuery::wrap(id, PipelineStatisticsQuery::Target::VerticesSubmitted);
+    glDeleteQueries(1, &id);
+}
+
+void PipelineStatisticsQueryGLTest::query() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::pipeline_statistics_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::pipeline_statistics_query::string() + std::string(" is not available."));
+
+    /* Queries of different targets can be active at the same time */
+    PipelineStatisticsQuery vertices{PipelineStatisticsQuery::Target::VerticesSubmitted},
+        fragments{PipelineStatisticsQuery::Target::FragmentShaderInvocations};
+    vertices.begin();
+    fragments.begin();
+    fragments.end();
+    vertices.end();
+
+    /* Nothing was drawn */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(vertices.result<UnsignedLong>(), 0);
+    CORRADE_COMPARE(fragments.result<UnsignedLong>(), 0);
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::PipelineStatisticsQueryGLTest)
@@ -0,0 +1,280 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelConversion.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace Test {
+
+struct PixelConversionTest: TestSuite::Tester {
+    explicit PixelConversionTest();
+
+    void supported();
+
+    void swapRedBlue();
+    void swapRedBlueInPlace();
+    void rgbToRgba();
+    void rgbaToRgb();
+    void rgToRgb();
+    void byteToFloat();
+    void floatToHalf();
+    void premultiply();
+    void unpremultiply();
+
+    void image();
+    void imageParallel();
+
+    void debugFlag();
+};
+
+PixelConversionTest::PixelConversionTest() {
+    addTests({&PixelConversionTest::supported,
+
+              &PixelConversionTest::swapRedBlue,
+              &PixelConversionTest::swapRedBlueInPlace,
+              &PixelConversionTest::rgbToRgba,
+              &PixelConversionTest::rgbaToRgb,
+              &PixelConversionTest::rgToRgb,
+              &PixelConversionTest::byteToFloat,
+              &PixelConversionTest::floatToHalf,
+              &PixelConversionTest::premultiply,
+              &PixelConversionTest::unpremultiply,
+
+              &PixelConversionTest::image,
+              &PixelConversionTest::imageParallel,
+
+              &PixelConversionTest::debugFlag});
+}
+
+namespace {
+    /* Long enough to go through all SIMD paths and the remainder */
+    std::vector<UnsignedByte> rgbaPixels(const std::size_t count) {
+        std::vector<UnsignedByte> out(count*4);
+        for(std::size_t i = 0; i != out.size(); ++i) out[i] = UnsignedByte(i*7 + 3);
+        return out;
+    }
+
+    Containers::ArrayView<const char> view(const std::vector<UnsignedByte>& data) {
+        return {reinterpret_cast<const char*>(data.data()), data.size()};
+    }
+
+    Containers::ArrayView<char> view(std::vector<UnsignedByte>& data) {
+        return {reinterpret_cast<char*>(data.data()), data.size()};
+    }
+}
+
+void PixelConversionTest::supported() {
+    CORRADE_VERIFY(isPixelConversionSupported(PixelFormat::RGB, PixelType::UnsignedByte, PixelFormat::RGBA, PixelType::Float));
+    CORRADE_VERIFY(isPixelConversionSupported(PixelFormat::RGBA, PixelType::HalfFloat, PixelFormat::RGB, PixelType::UnsignedByte));
+    CORRADE_VERIFY(!isPixelConversionSupported(PixelFormat::RGBA, PixelType::UnsignedShort, PixelFormat::RGBA, PixelType::UnsignedByte));
+    CORRADE_VERIFY(!isPixelConversionSupported(PixelFormat::RGBA, PixelType::UnsignedByte, PixelFormat::DepthComponent, PixelType::UnsignedByte));
+}
+
+void PixelConversionTest::swapRedBlue() {
+    const std::vector<UnsignedByte> in = rgbaPixels(37);
+    std::vector<UnsignedByte> out(in.size());
+    convertPixels(PixelFormat::RGBA, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGBA, PixelType::UnsignedByte, view(out),
+                  PixelConversionFlag::SwapRedBlue);
+
+    std::vector<UnsignedByte> expected(in.size());
+    for(std::size_t i = 0; i != 37; ++i) {
+        expected[i*4 + 0] = in[i*4 + 2];
+        expected[i*4 + 1] = in[i*4 + 1];
+        expected[i*4 + 2] = in[i*4 + 0];
+        expected[i*4 + 3] = in[i*4 + 3];
+    }
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::swapRedBlueInPlace() {
+    /* Three-channel pixels are processed in overlapping blocks, verify the
+       overlap doesn't break in-place operation */
+    std::vector<UnsignedByte> data(41*3);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = UnsignedByte(i);
+    const std::vector<UnsignedByte> in = data;
+
+    convertPixels(PixelFormat::RGB, PixelType::UnsignedByte, view(data),
+                  PixelFormat::RGB, PixelType::UnsignedByte, view(data),
+                  PixelConversionFlag::SwapRedBlue);
+
+    std::vector<UnsignedByte> expected(in.size());
+    for(std::size_t i = 0; i != 41; ++i) {
+        expected[i*3 + 0] = in[i*3 + 2];
+        expected[i*3 + 1] = in[i*3 + 1];
+        expected[i*3 + 2] = in[i*3 + 0];
+    }
+    CORRADE_COMPARE_AS(data, expected, TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::rgbToRgba() {
+    std::vector<UnsignedByte> in(37*3);
+    for(std::size_t i = 0; i != in.size(); ++i) in[i] = UnsignedByte(i);
+    std::vector<UnsignedByte> out(37*4);
+    convertPixels(PixelFormat::RGB, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGBA, PixelType::UnsignedByte, view(out));
+
+    std::vector<UnsignedByte> expected(out.size());
+    for(std::size_t i = 0; i != 37; ++i) {
+        expected[i*4 + 0] = in[i*3 + 0];
+        expected[i*4 + 1] = in[i*3 + 1];
+        expected[i*4 + 2] = in[i*3 + 2];
+        expected[i*4 + 3] = 255;
+    }
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::rgbaToRgb() {
+    const std::vector<UnsignedByte> in = rgbaPixels(37);
+    std::vector<UnsignedByte> out(37*3);
+    convertPixels(PixelFormat::RGBA, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGB, PixelType::UnsignedByte, view(out));
+
+    std::vector<UnsignedByte> expected(out.size());
+    for(std::size_t i = 0; i != 37; ++i) {
+        expected[i*3 + 0] = in[i*4 + 0];
+        expected[i*3 + 1] = in[i*4 + 1];
+        expected[i*3 + 2] = in[i*4 + 2];
+    }
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::rgToRgb() {
+    #if defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    CORRADE_SKIP("Two-component formats are not available in WebGL 1.0.");
+    #else
+    const std::vector<UnsignedByte> in{10, 20, 30, 40};
+    std::vector<UnsignedByte> out(6);
+    convertPixels(PixelFormat::RG, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGB, PixelType::UnsignedByte, view(out));
+
+    /* Missing blue is zero */
+    CORRADE_COMPARE_AS(out, (std::vector<UnsignedByte>{10, 20, 0, 30, 40, 0}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void PixelConversionTest::byteToFloat() {
+    const std::vector<UnsignedByte> in{0, 51, 255, 102, 204, 0};
+    std::vector<Float> out(8);
+    convertPixels(PixelFormat::RGB, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGBA, PixelType::Float,
+                  {reinterpret_cast<char*>(out.data()), out.size()*4});
+
+    CORRADE_COMPARE_AS(out, (std::vector<Float>{
+        0.0f, 0.2f, 1.0f, 1.0f,
+        0.4f, 0.8f, 0.0f, 1.0f}), TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::floatToHalf() {
+    const std::vector<Float> in{0.5f, -2.0f, 1.0f, 0.25f};
+    std::vector<UnsignedShort> out(4);
+    convertPixels(PixelFormat::RGBA, PixelType::Float,
+                  {reinterpret_cast<const char*>(in.data()), in.size()*4},
+                  PixelFormat::RGBA, PixelType::HalfFloat,
+                  {reinterpret_cast<char*>(out.data()), out.size()*2});
+
+    CORRADE_COMPARE_AS(out, (std::vector<UnsignedShort>{
+        Math::packHalf(0.5f), Math::packHalf(-2.0f),
+        Math::packHalf(1.0f), Math::packHalf(0.25f)}),
+        TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::premultiply() {
+    const std::vector<UnsignedByte> in{255, 102, 0, 51, 200, 100, 50, 255};
+    std::vector<UnsignedByte> out(8);
+    convertPixels(PixelFormat::RGBA, PixelType::UnsignedByte, view(in),
+                  PixelFormat::RGBA, PixelType::UnsignedByte, view(out),
+                  PixelConversionFlag::PremultiplyAlpha);
+
+    CORRADE_COMPARE_AS(out, (std::vector<UnsignedByte>{51, 20, 0, 51, 200, 100, 50, 255}),
+        TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::unpremultiply() {
+    const std::vector<Float> in{0.25f, 0.125f, 0.0f, 0.5f, 0.5f, 0.5f, 0.5f, 0.0f};
+    std::vector<Float> out(8);
+    convertPixels(PixelFormat::RGBA, PixelType::Float,
+                  {reinterpret_cast<const char*>(in.data()), in.size()*4},
+                  PixelFormat::RGBA, PixelType::Float,
+                  {reinterpret_cast<char*>(out.data()), out.size()*4},
+                  PixelConversionFlag::UnpremultiplyAlpha);
+
+    /* Zero alpha results in black */
+    CORRADE_COMPARE_AS(out, (std::vector<Float>{0.5f, 0.25f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f}),
+        TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::image() {
+    /* Two RGB rows of two pixels, padded to four bytes */
+    const UnsignedByte data[]{
+        1, 2, 3,  4, 5, 6,  0, 0,
+        7, 8, 9, 10, 11, 12, 0, 0
+    };
+    ImageView2D view{PixelFormat::RGB, PixelType::UnsignedByte, {2, 2}, data};
+
+    Image2D out = convertPixels(view, PixelFormat::RGBA, PixelType::UnsignedByte,
+        PixelConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE(out.storage().alignment(), 4);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const UnsignedByte>{reinterpret_cast<const UnsignedByte*>(out.data()), 16}),
+        (Containers::ArrayView<const UnsignedByte>{std::initializer_list<UnsignedByte>{
+            3, 2, 1, 255, 6, 5, 4, 255,
+            9, 8, 7, 255, 12, 11, 10, 255}.begin(), 16}),
+        TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::imageParallel() {
+    /* Odd width to have padded rows */
+    const Vector2i size{67, 53};
+    std::vector<UnsignedByte> data(size.product()*4);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = UnsignedByte(i*13);
+    ImageView2D view{PixelFormat::RGBA, PixelType::UnsignedByte, size, {data.data(), data.size()}};
+
+    Image2D single = convertPixels(view, PixelFormat::RGB, PixelType::Float, {}, 1);
+    Image2D parallel = convertPixels(view, PixelFormat::RGB, PixelType::Float, {}, 4);
+    CORRADE_COMPARE(single.data().size(), parallel.data().size());
+    CORRADE_COMPARE_AS(parallel.data(), single.data(), TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::debugFlag() {
+    std::ostringstream out;
+    Debug(&out) << PixelConversionFlag::PremultiplyAlpha << PixelConversionFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "PixelConversionFlag::PremultiplyAlpha PixelConversionFlag::(invalid)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::PixelConversionTest)
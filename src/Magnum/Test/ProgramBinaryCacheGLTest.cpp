@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ProgramBinaryCache.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Test {
+
+struct ProgramBinaryCacheGLTest: AbstractOpenGLTester {
+    explicit ProgramBinaryCacheGLTest();
+
+    void construct();
+    void key();
+    void insertFindRemove();
+    void findTruncated();
+
+    void loadSave();
+};
+
+ProgramBinaryCacheGLTest::ProgramBinaryCacheGLTest() {
+    addTests({&ProgramBinaryCacheGLTest::construct,
+              &ProgramBinaryCacheGLTest::key,
+              &ProgramBinaryCacheGLTest::insertFindRemove,
+              &ProgramBinaryCacheGLTest::findTruncated,
+
+              &ProgramBinaryCacheGLTest::loadSave});
+
+    Utility::Directory::mkpath(PROGRAMBINARYCACHEGLTEST_DIR);
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version ShaderVersion = Version::GL210;
+    #else
+    constexpr Version ShaderVersion = Version::GLES300;
+    #endif
+
+    void addSources(Shader& vert, Shader& frag) {
+        vert.addSource("void main() { gl_Position = vec4(0.0); }\n");
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource("void main() { gl_FragColor = vec4(1.0); }\n");
+        #else
+        frag.addSource("out lowp vec4 color;\nvoid main() { color = vec4(1.0); }\n");
+        #endif
+    }
+
+    struct MyShader: AbstractShaderProgram {
+        explicit MyShader(UnsignedInt& compiled) {
+            Shader vert{ShaderVersion, Shader::Type::Vertex};
+            Shader frag{ShaderVersion, Shader::Type::Fragment};
+            addSources(vert, frag);
+
+            if(!loadCachedBinary({vert, frag})) {
+                CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+                attachShaders({vert, frag});
+                CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+                saveCachedBinary({vert, frag});
+                ++compiled;
+            }
+        }
+    };
+}
+
+void ProgramBinaryCacheGLTest::construct() {
+    const std::string directory = Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_DIR, "construct");
+    if(Utility::Directory::fileExists(directory))
+        CORRADE_VERIFY(Utility::Directory::rm(directory));
+
+    CORRADE_VERIFY(!ProgramBinaryCache::hasCurrent());
+    {
+        ProgramBinaryCache cache{directory};
+        CORRADE_VERIFY(ProgramBinaryCache::hasCurrent());
+        CORRADE_COMPARE(&ProgramBinaryCache::current(), &cache);
+        CORRADE_COMPARE(cache.directory(), directory);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 0);
+        CORRADE_VERIFY(Utility::Directory::fileExists(directory));
+    }
+    CORRADE_VERIFY(!ProgramBinaryCache::hasCurrent());
+}
+
+void ProgramBinaryCacheGLTest::key() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_DIR};
+
+    Shader a{ShaderVersion, Shader::Type::Vertex};
+    Shader b{ShaderVersion, Shader::Type::Vertex};
+    Shader c{ShaderVersion, Shader::Type::Fragment};
+    Shader d{ShaderVersion, Shader::Type::Vertex};
+    a.addSource("void main() {}\n");
+    b.addSource("void main() {}\n");
+    c.addSource("void main() {}\n");
+    d.addSource("void main() {").addSource("}\n");
+
+    const std::string key = cache.key({a});
+    CORRADE_COMPARE(key.size(), 40);
+    CORRADE_COMPARE(cache.key({b}), key);
+    CORRADE_VERIFY(cache.key({c}) != key);
+    CORRADE_VERIFY(cache.key({d}) != key);
+    CORRADE_VERIFY(cache.key({a, c}) != key);
+    CORRADE_VERIFY(cache.key({a, c}) != cache.key({c, a}));
+}
+
+void ProgramBinaryCacheGLTest::insertFindRemove() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_DIR};
+    cache.remove("insertFind");
+
+    CORRADE_VERIFY(!cache.find("insertFind").second);
+
+    constexpr char data[] = {2, 7, 5, 13, 25};
+    CORRADE_VERIFY(cache.insert("insertFind", 0x1234, data));
+
+    const std::pair<GLenum, Containers::Array<char>> binary = cache.find("insertFind");
+    CORRADE_COMPARE(binary.first, 0x1234);
+    CORRADE_COMPARE(binary.second.size(), 5);
+    CORRADE_COMPARE(binary.second[3], 13);
+
+    CORRADE_VERIFY(cache.remove("insertFind"));
+    CORRADE_VERIFY(!cache.find("insertFind").second);
+    CORRADE_VERIFY(!cache.remove("insertFind"));
+}
+
+void ProgramBinaryCacheGLTest::findTruncated() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_DIR};
+
+    constexpr char data[] = {2, 7};
+    CORRADE_VERIFY(Utility::Directory::write(Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_DIR, "truncated.bin"), data));
+    CORRADE_VERIFY(!cache.find("truncated").second);
+}
+
+void ProgramBinaryCacheGLTest::loadSave() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Program binaries are not supported in OpenGL ES 2.0.");
+    #elif defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_SKIP("Program binaries are not supported in WebGL.");
+    #else
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::GL::ARB::get_program_binary::string() + std::string(" is not supported"));
+    #endif
+
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if(!formatCount) CORRADE_SKIP("The driver doesn't support any program binary formats");
+
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_DIR};
+
+    /* Remove what was possibly left there from previous runs */
+    Shader vert{ShaderVersion, Shader::Type::Vertex};
+    Shader frag{ShaderVersion, Shader::Type::Fragment};
+    addSources(vert, frag);
+    const std::string key = cache.key({vert, frag});
+    cache.remove(key);
+
+    UnsignedInt compiled = 0;
+    {
+        MyShader shader{compiled};
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(compiled, 1);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+    }
+
+    const std::pair<GLenum, Containers::Array<char>> binary = cache.find(key);
+    CORRADE_VERIFY(binary.second);
+
+    /* Second time it's loaded from the cache */
+    {
+        MyShader shader{compiled};
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(compiled, 1);
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 1);
+    }
+
+    /* Binary that the driver refuses is recompiled and replaced */
+    constexpr char garbage[] = {2, 7, 5, 13, 25};
+    CORRADE_VERIFY(cache.insert(key, binary.first, garbage));
+    {
+        MyShader shader{compiled};
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(compiled, 2);
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 2);
+    }
+    CORRADE_COMPARE(cache.find(key).second.size(), binary.second.size());
+    #endif
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::ProgramBinaryCacheGLTest)
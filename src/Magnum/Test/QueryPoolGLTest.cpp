@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/QueryPool.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SampleQuery.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct QueryPoolGLTest: AbstractOpenGLTester {
+    explicit QueryPoolGLTest();
+
+    void construct();
+    void reuse();
+    void inFlight();
+    void release();
+};
+
+QueryPoolGLTest::QueryPoolGLTest() {
+    addTests({&QueryPoolGLTest::construct,
+              &QueryPoolGLTest::reuse,
+              &QueryPoolGLTest::inFlight,
+              &QueryPoolGLTest::release});
+}
+
+void QueryPoolGLTest::construct() {
+    {
+        QueryPool<SampleQuery> pool{SampleQuery::Target::AnySamplesPassed};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(pool.target() == SampleQuery::Target::AnySamplesPassed);
+        CORRADE_COMPARE(pool.size(), 0);
+        CORRADE_COMPARE(pool.activeCount(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void QueryPoolGLTest::reuse() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    QueryPool<SampleQuery> pool{SampleQuery::Target::AnySamplesPassed};
+
+    const UnsignedInt a = pool.begin();
+    pool.end(a);
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(pool.activeCount(), 1);
+
+    /* The result doesn't block, so poll until it's there */
+    Renderer::finish();
+    bool result = true;
+    while(!pool.result(a, result)) {}
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!result);
+    CORRADE_COMPARE(pool.activeCount(), 0);
+
+    /* The query is taken from the pool again */
+    const UnsignedInt b = pool.begin();
+    pool.end(b);
+    CORRADE_COMPARE(b, a);
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(pool.activeCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void QueryPoolGLTest::inFlight() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    QueryPool<SampleQuery> pool{SampleQuery::Target::AnySamplesPassed};
+
+    const UnsignedInt a = pool.begin();
+    pool.end(a);
+    const UnsignedInt b = pool.begin();
+    pool.end(b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.activeCount(), 2);
+    CORRADE_VERIFY(pool.query(a).id() != pool.query(b).id());
+
+    /* Results can be fetched in any order */
+    Renderer::finish();
+    bool result;
+    while(!pool.result(b, result)) {}
+    CORRADE_COMPARE(pool.activeCount(), 1);
+    while(!pool.result(a, result)) {}
+    CORRADE_COMPARE(pool.activeCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void QueryPoolGLTest::release() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    QueryPool<SampleQuery> pool{SampleQuery::Target::AnySamplesPassed};
+
+    const UnsignedInt a = pool.begin();
+    pool.end(a);
+    pool.release(a);
+    CORRADE_COMPARE(pool.activeCount(), 0);
+
+    /* Released query is reused without reading the result */
+    CORRADE_COMPARE(pool.begin(), a);
+    CORRADE_COMPARE(pool.size(), 1);
+    pool.end(a);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::QueryPoolGLTest)
@@ -0,0 +1,430 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <vector>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/CommandBuffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/RenderQueue.h"
+#include "Magnum/RenderState.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderQueueGLTest: AbstractOpenGLTester {
+    explicit RenderQueueGLTest();
+
+    void construct();
+
+    void orderState();
+    void orderFrontToBack();
+    void orderBackToFront();
+    void textures();
+    void clear();
+
+    void depthPrePass();
+    void depthPrePassDisabled();
+
+    void commandBuffer();
+    void commandBufferArena();
+    void commandBufferThreads();
+    void commandBufferRenderState();
+};
+
+RenderQueueGLTest::RenderQueueGLTest() {
+    addTests({&RenderQueueGLTest::construct,
+
+              &RenderQueueGLTest::orderState,
+              &RenderQueueGLTest::orderFrontToBack,
+              &RenderQueueGLTest::orderBackToFront,
+              &RenderQueueGLTest::textures,
+              &RenderQueueGLTest::clear,
+
+              &RenderQueueGLTest::depthPrePass,
+              &RenderQueueGLTest::depthPrePassDisabled,
+
+              &RenderQueueGLTest::commandBuffer,
+              &RenderQueueGLTest::commandBufferArena,
+              &RenderQueueGLTest::commandBufferThreads,
+              &RenderQueueGLTest::commandBufferRenderState});
+}
+
+namespace {
+    struct DummyShader: AbstractShaderProgram {
+        explicit DummyShader();
+    };
+
+    struct Uniforms {
+        std::vector<Int>* order;
+        Int id;
+    };
+
+    void applyUniforms(DummyShader&, const Uniforms& uniforms) {
+        uniforms.order->push_back(uniforms.id);
+    }
+
+    /* The pre-pass setup can't capture anything, the draw ID is in the
+       matrix translation */
+    std::vector<Int>* prePassOrder;
+
+    void prePassSetup(AbstractShaderProgram&, const Matrix4& transformationProjectionMatrix) {
+        prePassOrder->push_back(Int(transformationProjectionMatrix.translation().x()));
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+DummyShader::DummyShader() {
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    vert.addSource("void main() { gl_Position = vec4(0.0); }");
+    frag.addSource(
+        #ifndef CORRADE_TARGET_APPLE
+        "void main() { gl_FragColor = vec4(1.0); }"
+        #else
+        "out vec4 color;\n"
+        "void main() { color = vec4(1.0); }"
+        #endif
+        );
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+#endif
+
+void RenderQueueGLTest::construct() {
+    RenderQueue queue{RenderQueue::Order::FrontToBack};
+    CORRADE_VERIFY(queue.order() == RenderQueue::Order::FrontToBack);
+    CORRADE_COMPARE(queue.size(), 0);
+    CORRADE_COMPARE(queue.drawCount(), 0);
+
+    queue.setOrder(RenderQueue::Order::BackToFront);
+    CORRADE_VERIFY(queue.order() == RenderQueue::Order::BackToFront);
+
+    DummyShader depthShader;
+    CORRADE_VERIFY(!queue.isDepthPrePassEnabled());
+    queue.setDepthPrePass(depthShader, prePassSetup);
+    CORRADE_VERIFY(queue.isDepthPrePassEnabled());
+    queue.disableDepthPrePass();
+    CORRADE_VERIFY(!queue.isDepthPrePassEnabled());
+}
+
+void RenderQueueGLTest::orderState() {
+    DummyShader a, b;
+    /* Meshes with zero count don't issue any draw calls */
+    Mesh first, second;
+
+    std::vector<Int> order;
+    RenderQueue queue;
+    queue.add(a, first, 3.0f, [&order]() { order.push_back(0); })
+        .add(b, first, 1.0f, [&order]() { order.push_back(1); })
+        .add(a, second, 2.0f, [&order]() { order.push_back(2); })
+        .add(a, first, 1.0f, [&order]() { order.push_back(3); })
+        .add(b, first, 5.0f, [&order]() { order.push_back(4); });
+    CORRADE_COMPARE(queue.size(), 5);
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Grouped by shader and mesh, same state ordered front to back */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{3, 0, 2, 1, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(queue.size(), 0);
+    CORRADE_COMPARE(queue.drawCount(), 5);
+    CORRADE_COMPARE(queue.shaderBindsAvoided(), 3);
+    CORRADE_COMPARE(queue.meshBindsAvoided(), 2);
+}
+
+void RenderQueueGLTest::orderFrontToBack() {
+    DummyShader a, b;
+    Mesh mesh;
+
+    std::vector<Int> order;
+    RenderQueue queue{RenderQueue::Order::FrontToBack};
+    queue.add(a, mesh, 3.0f, [&order]() { order.push_back(0); })
+        .add(b, mesh, 1.0f, [&order]() { order.push_back(1); })
+        .add(a, mesh, -2.0f, [&order]() { order.push_back(2); })
+        .add(a, mesh, 1.0f, [&order]() { order.push_back(3); });
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Negative depth is treated as zero, same depth grouped by shader */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{2, 3, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(queue.shaderBindsAvoided(), 1);
+    CORRADE_COMPARE(queue.meshBindsAvoided(), 3);
+}
+
+void RenderQueueGLTest::orderBackToFront() {
+    DummyShader a;
+    Mesh mesh;
+
+    std::vector<Int> order;
+    RenderQueue queue{RenderQueue::Order::BackToFront};
+    queue.add(a, mesh, 3.0f, [&order]() { order.push_back(0); })
+        .add(a, mesh, 10.0f, [&order]() { order.push_back(1); })
+        .add(a, mesh, 0.5f, [&order]() { order.push_back(2); });
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{1, 0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueGLTest::textures() {
+    DummyShader shader;
+    Mesh mesh;
+    Texture2D diffuse, specular, other;
+
+    RenderQueue queue;
+    queue.add(shader, mesh, {&diffuse, &specular}, 1.0f)
+        .add(shader, mesh, {&other}, 1.0f)
+        .add(shader, mesh, {&diffuse, &specular}, 2.0f)
+        .add(shader, mesh, {nullptr, &specular}, 3.0f);
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The draws with the same texture set are grouped together, so only the
+       first one binds both, the null pointer is skipped */
+    CORRADE_COMPARE(queue.drawCount(), 4);
+    CORRADE_COMPARE(queue.textureBindsAvoided(), 3);
+}
+
+void RenderQueueGLTest::clear() {
+    DummyShader shader;
+    Mesh mesh;
+
+    bool called = false;
+    RenderQueue queue;
+    queue.add(shader, mesh, 1.0f, [&called]() { called = true; });
+    CORRADE_COMPARE(queue.size(), 1);
+
+    queue.clear();
+    CORRADE_COMPARE(queue.size(), 0);
+
+    queue.draw();
+    CORRADE_VERIFY(!called);
+    CORRADE_COMPARE(queue.drawCount(), 0);
+}
+
+void RenderQueueGLTest::depthPrePass() {
+    DummyShader a, b, depthShader;
+    Mesh mesh;
+
+    std::vector<Int> order;
+    prePassOrder = &order;
+    RenderQueue queue;
+    queue.setDepthPrePass(depthShader, prePassSetup)
+        .addOpaque(a, mesh, Matrix4::translation(Vector3::xAxis(0.0f)), 3.0f, [&order]() { order.push_back(10); })
+        .add(b, mesh, 1.0f, [&order]() { order.push_back(11); })
+        .addOpaque(b, mesh, Matrix4::translation(Vector3::xAxis(2.0f)), 0.5f, [&order]() { order.push_back(12); })
+        .addOpaque(a, mesh, Matrix4::translation(Vector3::xAxis(3.0f)), 2.0f, [&order]() { order.push_back(13); });
+
+    Renderer::enable(Renderer::Feature::DepthTest);
+    queue.draw();
+    Renderer::disable(Renderer::Feature::DepthTest);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Opaque draws front to back in the pre-pass, then all grouped by state
+       in the main pass */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{2, 3, 0, 13, 10, 12, 11}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(queue.prePassDrawCount(), 3);
+    CORRADE_COMPARE(queue.drawCount(), 4);
+}
+
+void RenderQueueGLTest::depthPrePassDisabled() {
+    DummyShader a, depthShader;
+    Mesh mesh;
+
+    std::vector<Int> order;
+    prePassOrder = &order;
+    RenderQueue queue;
+    queue.setDepthPrePass(depthShader, prePassSetup)
+        .disableDepthPrePass()
+        .addOpaque(a, mesh, Matrix4::translation(Vector3::xAxis(0.0f)), 3.0f, [&order]() { order.push_back(10); })
+        .addOpaque(a, mesh, Matrix4::translation(Vector3::xAxis(1.0f)), 2.0f, [&order]() { order.push_back(11); });
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Treated the same as ordinary draws */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{11, 10}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(queue.prePassDrawCount(), 0);
+    CORRADE_COMPARE(queue.drawCount(), 2);
+}
+
+void RenderQueueGLTest::commandBuffer() {
+    DummyShader a, b;
+    Mesh first, second;
+
+    std::vector<Int> order;
+    CommandBuffer buffer;
+    CORRADE_VERIFY(buffer.isEmpty());
+    buffer.record(a, first, {}, nullptr, 3.0f, Uniforms{&order, 0}, applyUniforms)
+        .record(b, first, {}, nullptr, 1.0f, Uniforms{&order, 1}, applyUniforms)
+        .record(a, second, {}, nullptr, 2.0f, Uniforms{&order, 2}, applyUniforms);
+    CORRADE_COMPARE(buffer.size(), 3);
+
+    RenderQueue queue;
+    queue.add(a, first, 1.0f, [&order]() { order.push_back(3); })
+        .add(buffer)
+        .add(b, first, 5.0f, [&order]() { order.push_back(4); });
+    CORRADE_COMPARE(queue.size(), 5);
+
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Recorded packets are sorted together with the other draws */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{3, 0, 2, 1, 4}),
+        TestSuite::Compare::Container);
+
+    /* The buffer is untouched by the queue */
+    CORRADE_COMPARE(buffer.size(), 3);
+}
+
+void RenderQueueGLTest::commandBufferArena() {
+    DummyShader shader;
+    Mesh mesh;
+
+    struct Big { char data[40]; };
+    CommandBuffer buffer{100};
+    CORRADE_COMPARE(buffer.arenaCapacity(), 0);
+
+    /* Each blob is aligned to 16 bytes, so only two fit into one block */
+    const Big big{};
+    for(std::size_t i = 0; i != 3; ++i)
+        buffer.record(shader, mesh, {}, nullptr, 0.0f, nullptr, &big, sizeof(Big));
+    CORRADE_COMPARE(buffer.arenaCapacity(), 200);
+    CORRADE_COMPARE(buffer.arenaSize(), 140);
+
+    /* Blobs larger than block size get a dedicated block */
+    char huge[150]{};
+    buffer.record(shader, mesh, {}, nullptr, 0.0f, nullptr, huge, sizeof(huge));
+    CORRADE_COMPARE(buffer.arenaCapacity(), 350);
+
+    /* Clearing keeps the memory */
+    buffer.clear();
+    CORRADE_VERIFY(buffer.isEmpty());
+    CORRADE_COMPARE(buffer.arenaSize(), 0);
+    CORRADE_COMPARE(buffer.arenaCapacity(), 350);
+
+    buffer.record(shader, mesh, {}, nullptr, 0.0f, nullptr, &big, sizeof(Big));
+    CORRADE_COMPARE(buffer.arenaCapacity(), 350);
+}
+
+void RenderQueueGLTest::commandBufferThreads() {
+    DummyShader shader;
+    Mesh mesh;
+    Texture2D texture;
+
+    /* Record on worker threads, no GL calls are allowed there */
+    std::vector<Int> order;
+    std::vector<CommandBuffer> buffers(4);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != buffers.size(); ++i) threads.emplace_back([&buffers, &shader, &mesh, &texture, &order, i]() {
+        for(Int j = 0; j != 100; ++j)
+            buffers[i].record(shader, mesh, {&texture}, nullptr, Float(j), Uniforms{&order, Int(i)*100 + j}, applyUniforms);
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    RenderQueue queue;
+    for(const CommandBuffer& buffer: buffers) queue.add(buffer);
+    queue.draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(queue.drawCount(), 400);
+    CORRADE_COMPARE(queue.textureBindsAvoided(), 399);
+    CORRADE_COMPARE(order.size(), 400);
+
+    /* Same state, ordered front to back, stable for the same depth */
+    CORRADE_COMPARE(order[0], 0);
+    CORRADE_COMPARE(order[1], 100);
+    CORRADE_COMPARE(order[399], 399);
+}
+
+void RenderQueueGLTest::commandBufferRenderState() {
+    DummyShader shader;
+    Mesh mesh;
+    const RenderState opaque = RenderState{}
+        .enable(Renderer::Feature::DepthTest);
+    const RenderState transparent = RenderState{}
+        .enable(Renderer::Feature::Blending)
+        .disable(Renderer::Feature::DepthTest);
+
+    std::vector<Int> order;
+    CommandBuffer buffer;
+    buffer.record(shader, mesh, {}, &transparent, 1.0f, Uniforms{&order, 0}, applyUniforms)
+        .record(shader, mesh, {}, &opaque, 2.0f, Uniforms{&order, 1}, applyUniforms)
+        .record(shader, mesh, {}, &transparent, 3.0f, Uniforms{&order, 2}, applyUniforms);
+
+    RenderQueue queue;
+    queue.add(buffer).draw();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Draws with the same state are grouped, the last state stays applied.
+       The opaque state doesn't touch blending. */
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::disable(Renderer::Feature::Blending);
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::RenderQueueGLTest)
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/RenderState.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderStateGLTest: AbstractOpenGLTester {
+    explicit RenderStateGLTest();
+
+    void apply();
+    void applyPartial();
+    void applySeparateStencil();
+    void redundantCallsFiltered();
+    void untrackedFeature();
+};
+
+RenderStateGLTest::RenderStateGLTest() {
+    addTests({&RenderStateGLTest::apply,
+              &RenderStateGLTest::applyPartial,
+              &RenderStateGLTest::applySeparateStencil,
+              &RenderStateGLTest::redundantCallsFiltered,
+              &RenderStateGLTest::untrackedFeature});
+}
+
+namespace {
+    Int integer(const GLenum parameter) {
+        GLint value;
+        glGetIntegerv(parameter, &value);
+        return value;
+    }
+}
+
+void RenderStateGLTest::apply() {
+    Renderer::setState(RenderState{}
+        .enable(Renderer::Feature::Blending)
+        .enable(Renderer::Feature::FaceCulling)
+        .disable(Renderer::Feature::DepthTest)
+        .setFaceCullingMode(Renderer::PolygonFacing::Front)
+        .setFrontFace(Renderer::FrontFace::ClockWise)
+        .setDepthFunction(Renderer::DepthFunction::LessOrEqual)
+        .setDepthMask(false)
+        .setBlendEquation(Renderer::BlendEquation::Subtract)
+        .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha)
+        .setStencilFunction(Renderer::StencilFunction::Equal, 3, 0xff));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_COMPARE(integer(GL_CULL_FACE_MODE), GL_FRONT);
+    CORRADE_COMPARE(integer(GL_FRONT_FACE), GL_CW);
+    CORRADE_COMPARE(integer(GL_DEPTH_FUNC), GL_LEQUAL);
+    CORRADE_COMPARE(integer(GL_DEPTH_WRITEMASK), GL_FALSE);
+    CORRADE_COMPARE(integer(GL_BLEND_EQUATION_RGB), GL_FUNC_SUBTRACT);
+    CORRADE_COMPARE(integer(GL_BLEND_SRC_RGB), GL_ONE);
+    CORRADE_COMPARE(integer(GL_BLEND_DST_ALPHA), GL_ONE_MINUS_SRC_ALPHA);
+    CORRADE_COMPARE(integer(GL_STENCIL_FUNC), GL_EQUAL);
+    CORRADE_COMPARE(integer(GL_STENCIL_BACK_REF), 3);
+
+    /* Restore defaults for other tests */
+    Renderer::setState(RenderState{}
+        .disable(Renderer::Feature::Blending)
+        .disable(Renderer::Feature::FaceCulling)
+        .setFaceCullingMode(Renderer::PolygonFacing::Back)
+        .setFrontFace(Renderer::FrontFace::CounterClockWise)
+        .setDepthFunction(Renderer::DepthFunction::Less)
+        .setDepthMask(true)
+        .setBlendEquation(Renderer::BlendEquation::Add)
+        .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::Zero)
+        .setStencilFunction(Renderer::StencilFunction::Always, 0, 0xffffffffu));
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderStateGLTest::applyPartial() {
+    Renderer::setDepthFunction(Renderer::DepthFunction::Greater);
+    Renderer::setState(RenderState{}.enable(Renderer::Feature::ScissorTest));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_SCISSOR_TEST));
+    /* State not in the block is left untouched */
+    CORRADE_COMPARE(integer(GL_DEPTH_FUNC), GL_GREATER);
+
+    Renderer::disable(Renderer::Feature::ScissorTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+}
+
+void RenderStateGLTest::applySeparateStencil() {
+    Renderer::setState(RenderState{}
+        .setStencilOperation(Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep)
+        .setStencilOperation(Renderer::PolygonFacing::Back, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Increment)
+        .setStencilMask(Renderer::PolygonFacing::Front, 0x0f));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(integer(GL_STENCIL_PASS_DEPTH_PASS), GL_KEEP);
+    CORRADE_COMPARE(integer(GL_STENCIL_BACK_PASS_DEPTH_PASS), GL_INCR);
+    CORRADE_COMPARE(integer(GL_STENCIL_WRITEMASK), 0x0f);
+
+    Renderer::setStencilOperation(Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep);
+    Renderer::setStencilMask(0xffffffffu);
+}
+
+void RenderStateGLTest::redundantCallsFiltered() {
+    Renderer::enable(Renderer::Feature::DepthTest);
+
+    /* Change the state behind the tracker's back, the next call is filtered
+       out as redundant */
+    glDisable(GL_DEPTH_TEST);
+    Renderer::enable(Renderer::Feature::DepthTest);
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+
+    /* After resetting the tracked state the call goes through */
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::enable(Renderer::Feature::DepthTest);
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+
+    Renderer::disable(Renderer::Feature::DepthTest);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderStateGLTest::untrackedFeature() {
+    #ifndef MAGNUM_TARGET_GLES
+    /* Features not in the enum are always passed through */
+    Renderer::enable(Renderer::Feature(GL_CLIP_DISTANCE0));
+    glDisable(GL_CLIP_DISTANCE0);
+    Renderer::enable(Renderer::Feature(GL_CLIP_DISTANCE0));
+    CORRADE_VERIFY(glIsEnabled(GL_CLIP_DISTANCE0));
+
+    Renderer::disable(Renderer::Feature(GL_CLIP_DISTANCE0));
+    MAGNUM_VERIFY_NO_ERROR();
+    #else
+    CORRADE_SKIP("Clip distances are not available in OpenGL ES.");
+    #endif
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::RenderStateGLTest)
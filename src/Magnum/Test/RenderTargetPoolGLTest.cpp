@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/RenderTargetPool.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderTargetPoolGLTest: AbstractOpenGLTester {
+    explicit RenderTargetPoolGLTest();
+
+    void construct();
+    void reuse();
+    void sameFrame();
+    void differentKey();
+    void framebuffer();
+    void framebufferMultipleColor();
+    void evict();
+};
+
+RenderTargetPoolGLTest::RenderTargetPoolGLTest() {
+    addTests({&RenderTargetPoolGLTest::construct,
+              &RenderTargetPoolGLTest::reuse,
+              &RenderTargetPoolGLTest::sameFrame,
+              &RenderTargetPoolGLTest::differentKey,
+              &RenderTargetPoolGLTest::framebuffer,
+              &RenderTargetPoolGLTest::framebufferMultipleColor,
+              &RenderTargetPoolGLTest::evict});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA8;
+    #else
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA;
+    #endif
+}
+
+void RenderTargetPoolGLTest::construct() {
+    RenderTargetPool pool{5};
+
+    CORRADE_COMPARE(pool.maxIdleFrames(), 5);
+    CORRADE_COMPARE(pool.frame(), 0);
+    CORRADE_COMPARE(pool.textureCount(), 0);
+    CORRADE_COMPARE(pool.renderbufferCount(), 0);
+    CORRADE_COMPARE(pool.framebufferCount(), 0);
+    CORRADE_COMPARE(pool.activeCount(), 0);
+}
+
+void RenderTargetPoolGLTest::reuse() {
+    RenderTargetPool pool;
+
+    Texture2D& texture = pool.texture(ColorFormat, Vector2i{32});
+    Renderbuffer& renderbuffer = pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32});
+    CORRADE_COMPARE(pool.activeCount(), 2);
+
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.frame(), 1);
+    CORRADE_COMPARE(pool.activeCount(), 0);
+
+    /* Targets from the previous frame are handed out again */
+    CORRADE_COMPARE(&pool.texture(ColorFormat, Vector2i{32}), &texture);
+    CORRADE_COMPARE(&pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32}), &renderbuffer);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.renderbufferCount(), 1);
+    CORRADE_COMPARE(pool.activeCount(), 2);
+}
+
+void RenderTargetPoolGLTest::sameFrame() {
+    RenderTargetPool pool;
+
+    /* A target is handed out only once per frame */
+    Texture2D& a = pool.texture(ColorFormat, Vector2i{32});
+    Texture2D& b = pool.texture(ColorFormat, Vector2i{32});
+    CORRADE_VERIFY(&a != &b);
+
+    pool.nextFrame();
+    Texture2D& c = pool.texture(ColorFormat, Vector2i{32});
+    Texture2D& d = pool.texture(ColorFormat, Vector2i{32});
+    Texture2D& e = pool.texture(ColorFormat, Vector2i{32});
+    CORRADE_COMPARE(&c, &a);
+    CORRADE_COMPARE(&d, &b);
+    CORRADE_VERIFY(&e != &a && &e != &b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.textureCount(), 3);
+}
+
+void RenderTargetPoolGLTest::differentKey() {
+    RenderTargetPool pool;
+
+    Texture2D& a = pool.texture(ColorFormat, Vector2i{32});
+    Renderbuffer& b = pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32});
+    pool.nextFrame();
+
+    /* Different size doesn't match */
+    CORRADE_VERIFY(&pool.texture(ColorFormat, Vector2i{16}) != &a);
+    CORRADE_VERIFY(&pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{16}) != &b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.renderbufferCount(), 2);
+}
+
+void RenderTargetPoolGLTest::framebuffer() {
+    RenderTargetPool pool;
+
+    Texture2D* color = &pool.texture(ColorFormat, Vector2i{32});
+    Renderbuffer* depth = &pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32});
+    Framebuffer& framebuffer = pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, *color},
+        {Framebuffer::BufferAttachment::Depth, *depth}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, Vector2i{32}}));
+    CORRADE_COMPARE(pool.framebufferCount(), 1);
+
+    /* Same attachment set in the next frame gives back the same framebuffer */
+    pool.nextFrame();
+    color = &pool.texture(ColorFormat, Vector2i{32});
+    depth = &pool.renderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32});
+    CORRADE_COMPARE(&pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, *color},
+        {Framebuffer::BufferAttachment::Depth, *depth}}), &framebuffer);
+    CORRADE_COMPARE(pool.framebufferCount(), 1);
+
+    /* Different attachment set gives a new one */
+    Framebuffer& colorOnly = pool.framebuffer({{Framebuffer::ColorAttachment{0}, *color}});
+    CORRADE_VERIFY(&colorOnly != &framebuffer);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.framebufferCount(), 2);
+}
+
+void RenderTargetPoolGLTest::framebufferMultipleColor() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Multiple render targets are not guaranteed to be available in OpenGL ES 2.0.");
+    #else
+    RenderTargetPool pool;
+
+    Texture2D& color = pool.texture(ColorFormat, Vector2i{32});
+    Texture2D& normal = pool.texture(ColorFormat, Vector2i{32});
+    Framebuffer& framebuffer = pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, color},
+        {Framebuffer::ColorAttachment{1}, normal},
+        {Framebuffer::BufferAttachment::Depth, pool.renderbuffer(RenderbufferFormat::DepthComponent24, Vector2i{32})}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    #endif
+}
+
+void RenderTargetPoolGLTest::evict() {
+    RenderTargetPool pool{1};
+
+    Texture2D& color = pool.texture(ColorFormat, Vector2i{32});
+    pool.framebuffer({{Framebuffer::ColorAttachment{0}, color}});
+    pool.texture(ColorFormat, Vector2i{16});
+
+    /* Used in the frame that just ended */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.framebufferCount(), 1);
+
+    /* Only the 32x32 texture is used, the framebuffer is not requested */
+    pool.texture(ColorFormat, Vector2i{32});
+
+    /* One idle frame is still fine */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.framebufferCount(), 1);
+
+    /* Two idle frames delete the 16x16 texture and the framebuffer */
+    pool.texture(ColorFormat, Vector2i{32});
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.framebufferCount(), 0);
+
+    /* Nothing used for two frames deletes everything */
+    pool.nextFrame();
+    pool.nextFrame();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.textureCount(), 0);
+    CORRADE_COMPARE(pool.framebufferCount(), 0);
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::RenderTargetPoolGLTest)
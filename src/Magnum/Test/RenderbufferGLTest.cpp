@@ -45,6 +45,9 @@ struct RenderbufferGLTest: AbstractOpenGLTester {
 
     void setStorage();
     void setStorageMultisample();
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    void setStorageMultisampleImplicitResolve();
+    #endif
 };
 
 RenderbufferGLTest::RenderbufferGLTest() {
@@ -57,7 +60,11 @@ RenderbufferGLTest::RenderbufferGLTest() {
               &RenderbufferGLTest::label,
 
               &RenderbufferGLTest::setStorage,
-              &RenderbufferGLTest::setStorageMultisample});
+              &RenderbufferGLTest::setStorageMultisample,
+              #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+              &RenderbufferGLTest::setStorageMultisampleImplicitResolve
+              #endif
+              });
 }
 
 void RenderbufferGLTest::construct() {
@@ -197,6 +204,18 @@ void RenderbufferGLTest::setStorageMultisample() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+void RenderbufferGLTest::setStorageMultisampleImplicitResolve() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::multisampled_render_to_texture>())
+        CORRADE_SKIP(Extensions::GL::EXT::multisampled_render_to_texture::string() + std::string(" is not available."));
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorageMultisampleImplicitResolve(4, RenderbufferFormat::DepthComponent16, {128, 128});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 }}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Test::RenderbufferGLTest)
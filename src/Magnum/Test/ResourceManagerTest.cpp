@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/AbstractResourceLoader.h"
@@ -41,10 +44,21 @@ struct ResourceManagerTest: TestSuite::Tester {
     void residentPolicy();
     void referenceCountedPolicy();
     void manualPolicy();
+    void budgetedPolicy();
+    void budgetedPolicyLeastRecentlyUsed();
+    void memoryUsage();
+    void replaceWhileReferenced();
+    void concurrentLookup();
+    void concurrentUnknownKey();
+    void concurrentRelease();
+    void concurrentReplace();
     void defaults();
+    void pinned();
+    void pinnedCopyDestroy();
     void clear();
     void clearWhileReferenced();
     void loader();
+    void reload();
 };
 
 struct Data {
@@ -66,10 +80,21 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::residentPolicy,
               &ResourceManagerTest::referenceCountedPolicy,
               &ResourceManagerTest::manualPolicy,
+              &ResourceManagerTest::budgetedPolicy,
+              &ResourceManagerTest::budgetedPolicyLeastRecentlyUsed,
+              &ResourceManagerTest::memoryUsage,
+              &ResourceManagerTest::replaceWhileReferenced,
+              &ResourceManagerTest::concurrentLookup,
+              &ResourceManagerTest::concurrentUnknownKey,
+              &ResourceManagerTest::concurrentRelease,
+              &ResourceManagerTest::concurrentReplace,
               &ResourceManagerTest::defaults,
+              &ResourceManagerTest::pinned,
+              &ResourceManagerTest::pinnedCopyDestroy,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
-              &ResourceManagerTest::loader});
+              &ResourceManagerTest::loader,
+              &ResourceManagerTest::reload});
 }
 
 void ResourceManagerTest::state() {
@@ -233,12 +258,289 @@ void ResourceManagerTest::manualPolicy() {
     CORRADE_COMPARE(Data::count, 1);
 }
 
+void ResourceManagerTest::budgetedPolicy() {
+    ResourceManager rm;
+    rm.setBudget<Data>(100);
+
+    /* Under the budget, nothing is deleted */
+    rm.set("first", new Data, ResourceDataState::Final, ResourcePolicy::Budgeted, 60);
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(rm.evictedCount<Data>(), 0);
+
+    /* Referenced resources are not deleted even when over the budget */
+    {
+        Resource<Data> first = rm.get<Data>("first");
+        rm.set("second", new Data, ResourceDataState::Final, ResourcePolicy::Budgeted, 60);
+        CORRADE_COMPARE(rm.count<Data>(), 2);
+        CORRADE_COMPARE(Data::count, 2);
+        CORRADE_COMPARE(rm.memoryUsage<Data>(), 120);
+    }
+
+    /* Removing last reference puts the resource to the end of the queue, so
+       the other one gets deleted */
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(Data::count, 1);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 60);
+    CORRADE_COMPARE(rm.evictedCount<Data>(), 1);
+    CORRADE_COMPARE(rm.state<Data>("first"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Data>("second"), ResourceState::NotLoaded);
+
+    /* Lowering the budget deletes the rest */
+    rm.setBudget<Data>(50);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+    CORRADE_COMPARE(rm.evictedCount<Data>(), 2);
+
+    /* Budgeted resources are deleted also on free() */
+    rm.set("third", new Data, ResourceDataState::Final, ResourcePolicy::Budgeted, 10);
+    rm.free();
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(rm.evictedCount<Data>(), 2);
+}
+
+void ResourceManagerTest::budgetedPolicyLeastRecentlyUsed() {
+    ResourceManager rm;
+    rm.setBudget<Int>(30);
+
+    rm.set("a", 1, ResourceDataState::Final, ResourcePolicy::Budgeted, 10);
+    rm.set("b", 2, ResourceDataState::Final, ResourcePolicy::Budgeted, 10);
+    rm.set("c", 3, ResourceDataState::Final, ResourcePolicy::Budgeted, 10);
+
+    /* Use the first one, making the second one least recently used */
+    rm.get<Int>("a");
+
+    /* Resource that was just set is never deleted, even if it alone is over
+       the budget */
+    rm.set("d", 4, ResourceDataState::Final, ResourcePolicy::Budgeted, 15);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("d"), ResourceState::Final);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 25);
+
+    rm.set("e", 5, ResourceDataState::Final, ResourcePolicy::Budgeted, 40);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("e"), ResourceState::Final);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 40);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 4);
+}
+
+void ResourceManagerTest::memoryUsage() {
+    ResourceManager rm;
+    CORRADE_COMPARE(rm.budget<Int>(), ~std::size_t{});
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 0);
+
+    /* All policies are accounted, replacing the data updates the cost */
+    rm.set("resident", 1, ResourceDataState::Mutable, ResourcePolicy::Resident, 100);
+    rm.set("manual", 2, ResourceDataState::Final, ResourcePolicy::Manual, 20);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 120);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+
+    rm.set("resident", 3, ResourceDataState::Final, ResourcePolicy::Resident, 50);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 70);
+
+    /* Non-budgeted resources are never evicted */
+    rm.setBudget<Int>(10);
+    CORRADE_COMPARE(rm.count<Int>(), 2);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 0);
+
+    rm.free();
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 50);
+
+    rm.clear();
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 0);
+}
+
+void ResourceManagerTest::replaceWhileReferenced() {
+    ResourceManager rm;
+    rm.set("data", new Data, ResourceDataState::Mutable, ResourcePolicy::Resident);
+
+    {
+        Resource<Data> data = rm.get<Data>("data");
+        Data* const first = data;
+
+        /* The resource might still be using the previous data, so they are
+           not deleted yet */
+        rm.set("data", new Data, ResourceDataState::Mutable, ResourcePolicy::Resident);
+        CORRADE_COMPARE(Data::count, 2);
+
+        /* Accessing the resource again means the previous data are not used
+           anymore, they are deleted next time the manager is modified */
+        CORRADE_VERIFY(static_cast<Data*>(data) != first);
+        CORRADE_COMPARE(Data::count, 2);
+        rm.free();
+        CORRADE_COMPARE(Data::count, 1);
+    }
+
+    /* Nothing reads the data, so they are deleted right away */
+    rm.set("data", new Data, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    CORRADE_COMPARE(Data::count, 1);
+
+    /* The same for fallback */
+    rm.setFallback(new Data);
+    {
+        Resource<Data> missing = rm.get<Data>("missing");
+        CORRADE_COMPARE(missing.state(), ResourceState::NotLoadedFallback);
+
+        rm.setFallback(new Data);
+        CORRADE_COMPARE(Data::count, 3);
+    }
+
+    rm.free();
+    CORRADE_COMPARE(Data::count, 2);
+}
+
 void ResourceManagerTest::defaults() {
     ResourceManager rm;
     rm.set("data", new Data);
     CORRADE_COMPARE(rm.state<Data>("data"), ResourceState::Final);
 }
 
+void ResourceManagerTest::concurrentLookup() {
+    ResourceManager rm;
+    rm.set("answer", 42, ResourceDataState::Final, ResourcePolicy::Resident);
+
+    /* Other threads look up and reference resources while this thread keeps
+       modifying the manager and growing its lookup table */
+    std::size_t sums[4]{};
+    std::thread threads[4];
+    for(std::size_t i = 0; i != 4; ++i) threads[i] = std::thread{[&rm, &sums, i]() {
+        for(std::size_t j = 0; j != 1000; ++j) {
+            Resource<Int> answer = rm.get<Int>("answer");
+            sums[i] += *answer;
+            Resource<Int> copy = answer;
+        }
+    }};
+
+    for(Int i = 0; i != 1000; ++i)
+        rm.set(ResourceKey(std::size_t(i)), i, ResourceDataState::Mutable, ResourcePolicy::Manual);
+
+    for(std::thread& thread: threads) thread.join();
+    for(std::size_t sum: sums) CORRADE_COMPARE(sum, 42000);
+    CORRADE_COMPARE(rm.count<Int>(), 1001);
+    CORRADE_COMPARE(rm.referenceCount<Int>("answer"), 0);
+}
+
+void ResourceManagerTest::concurrentUnknownKey() {
+    ResourceManager rm;
+
+    /* Other threads can't add resources to the manager, the resource is
+       looked up again once it's set */
+    Resource<Int> data;
+    std::thread{[&rm, &data]() {
+        data = rm.get<Int>("data");
+    }}.join();
+    CORRADE_COMPARE(data.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+
+    rm.set("data", 1337);
+    CORRADE_COMPARE(data.state(), ResourceState::Final);
+    CORRADE_COMPARE(*data, 1337);
+    CORRADE_COMPARE(rm.referenceCount<Int>("data"), 1);
+}
+
+void ResourceManagerTest::concurrentRelease() {
+    ResourceManager rm;
+    rm.set("data", 3, ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+
+    /* Last reference removed on another thread doesn't delete the resource
+       until the manager is modified on this thread */
+    Int value{};
+    std::thread{[&rm, &value]() {
+        Resource<Int> data = rm.get<Int>("data");
+        value = *data;
+    }}.join();
+    CORRADE_COMPARE(value, 3);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("data"), ResourceState::Final);
+
+    rm.free();
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+    CORRADE_COMPARE(rm.state<Int>("data"), ResourceState::NotLoaded);
+}
+
+void ResourceManagerTest::concurrentReplace() {
+    ResourceManager rm;
+    rm.set("data", 0, ResourceDataState::Mutable, ResourcePolicy::Resident);
+
+    /* Other threads keep reading the data while this thread replaces them.
+       The values only grow and data acquired by a resource are not deleted
+       until it's accessed again, so the value can't change under its
+       hands. */
+    std::atomic<std::size_t> finished{0};
+    std::size_t invalid[4]{};
+    std::thread threads[4];
+    for(std::size_t i = 0; i != 4; ++i) threads[i] = std::thread{[&rm, &finished, &invalid, i]() {
+        Resource<Int> data = rm.get<Int>("data");
+        Int previous = 0;
+        for(std::size_t j = 0; j != 10000; ++j) {
+            const Int* const value = data;
+            const Int current = *value;
+            std::this_thread::yield();
+            if(*value != current || current < previous) ++invalid[i];
+            previous = current;
+        }
+        finished.fetch_add(1, std::memory_order_release);
+    }};
+
+    for(Int i = 1; finished.load(std::memory_order_acquire) != 4; ++i)
+        rm.set("data", i, ResourceDataState::Mutable, ResourcePolicy::Resident);
+
+    for(std::thread& thread: threads) thread.join();
+    for(std::size_t count: invalid) CORRADE_COMPARE(count, 0);
+    CORRADE_COMPARE(rm.referenceCount<Int>("data"), 0);
+}
+
+void ResourceManagerTest::pinned() {
+    ResourceManager rm;
+
+    PinnedResource<Int> pinned{rm.get<Int>("answer")};
+    CORRADE_VERIFY(!pinned);
+    CORRADE_COMPARE(pinned.key(), ResourceKey("answer"));
+
+    /* Pinned pointer is not updated until refreshed */
+    rm.set("answer", 42, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    CORRADE_VERIFY(!pinned);
+
+    rm.refreshPinned<Int>();
+    CORRADE_VERIFY(pinned);
+    CORRADE_COMPARE(*pinned, 42);
+
+    /* Replaced data get picked up by the bulk refresh */
+    rm.set("answer", 43, ResourceDataState::Final, ResourcePolicy::Resident);
+    rm.refreshPinned();
+    CORRADE_COMPARE(*pinned, 43);
+
+    /* Pinning an already loaded resource gives valid data right away */
+    PinnedResource<Int> loaded{rm.get<Int>("answer")};
+    CORRADE_VERIFY(loaded);
+    CORRADE_COMPARE(*loaded, 43);
+}
+
+void ResourceManagerTest::pinnedCopyDestroy() {
+    ResourceManager rm;
+
+    PinnedResource<Int> a{rm.get<Int>("answer")};
+    PinnedResource<Int> c;
+    {
+        PinnedResource<Int> b{a};
+        c = b;
+
+        rm.set("answer", 42, ResourceDataState::Mutable, ResourcePolicy::Resident);
+        rm.refreshPinned<Int>();
+        CORRADE_COMPARE(*a, 42);
+        CORRADE_COMPARE(*b, 42);
+        CORRADE_COMPARE(*c, 42);
+    }
+
+    /* The destroyed pin is unlinked, the remaining ones still get updated */
+    rm.set("answer", 43, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    rm.refreshPinned<Int>();
+    CORRADE_COMPARE(*a, 43);
+    CORRADE_COMPARE(*c, 43);
+}
+
 void ResourceManagerTest::clear() {
     ResourceManager rm;
 
@@ -326,6 +628,59 @@ void ResourceManagerTest::loader() {
     CORRADE_COMPARE(Data::count, 0);
 }
 
+void ResourceManagerTest::reload() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        public:
+            std::vector<ResourceKey> requested;
+
+            void load() {
+                for(ResourceKey key: requested)
+                    set(key, 42, ResourceDataState::Mutable, ResourcePolicy::Resident);
+                requested.clear();
+            }
+
+        private:
+            void doLoad(ResourceKey key) override { requested.push_back(key); }
+    };
+
+    ResourceManager rm;
+    auto loader = new IntResourceLoader;
+    rm.setLoader(loader);
+
+    /* Final unreferenced and manually set resources are reloaded as well,
+       resources that are still loading are untouched */
+    rm.set("final", 1, ResourceDataState::Final, ResourcePolicy::Resident);
+    rm.set("manual", 2, ResourceDataState::Mutable, ResourcePolicy::Manual);
+    rm.set<Int>("loading", nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    Resource<Int> finalReferenced = rm.get<Int>("finalReferenced");
+    Resource<Int> once = rm.get<Int>("once");
+    Resource<Int> twice = rm.get<Int>("twice");
+    Resource<Int> twiceAgain = rm.get<Int>("twice");
+    loader->requested.clear();
+    rm.set("finalReferenced", 3, ResourceDataState::Final, ResourcePolicy::Resident);
+    rm.set("once", 4, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    rm.set("twice", 5, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    CORRADE_COMPARE(*twice, 5);
+
+    rm.reload<Int>();
+
+    /* Most referenced first, referenced final resource skipped */
+    CORRADE_COMPARE(loader->requested.size(), 4);
+    CORRADE_COMPARE(loader->requested[0], ResourceKey("twice"));
+    CORRADE_COMPARE(loader->requested[1], ResourceKey("once"));
+    CORRADE_COMPARE(twice.state(), ResourceState::Loading);
+    CORRADE_COMPARE(rm.state<Int>("final"), ResourceState::Loading);
+    CORRADE_COMPARE(rm.state<Int>("manual"), ResourceState::Loading);
+    CORRADE_COMPARE(rm.state<Int>("loading"), ResourceState::Loading);
+    CORRADE_COMPARE(*finalReferenced, 3);
+
+    loader->load();
+    CORRADE_COMPARE(twice.state(), ResourceState::Mutable);
+    CORRADE_COMPARE(*twice, 42);
+    CORRADE_COMPARE(*once, 42);
+    CORRADE_COMPARE(loader->requestedCount(), 4 + 3);
+}
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ResourceManagerTest)
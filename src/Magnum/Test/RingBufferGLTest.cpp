@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/RingBuffer.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RingBufferGLTest: AbstractOpenGLTester {
+    explicit RingBufferGLTest();
+
+    void construct();
+
+    void allocate();
+    void allocateAligned();
+    void upload();
+    void wrapAround();
+};
+
+RingBufferGLTest::RingBufferGLTest() {
+    addTests({&RingBufferGLTest::construct,
+
+              &RingBufferGLTest::allocate,
+              &RingBufferGLTest::allocateAligned,
+              &RingBufferGLTest::upload,
+              &RingBufferGLTest::wrapAround});
+}
+
+void RingBufferGLTest::construct() {
+    RingBuffer ring{1024};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(ring.buffer().id() > 0);
+    CORRADE_COMPARE(ring.size(), 1024);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(ring.buffer().size(), 1024);
+    #endif
+
+    if(ring.isPersistent())
+        Debug() << "Using persistently mapped buffer storage";
+}
+
+void RingBufferGLTest::allocate() {
+    RingBuffer ring{16};
+
+    std::pair<GLintptr, Containers::ArrayView<char>> a = ring.allocate(3);
+    CORRADE_COMPARE(a.first, 0);
+    CORRADE_COMPARE(a.second.size(), 3);
+
+    std::pair<GLintptr, Containers::ArrayView<char>> b = ring.allocate(5);
+    CORRADE_COMPARE(b.first, 3);
+    CORRADE_COMPARE(b.second.size(), 5);
+    CORRADE_COMPARE(b.second.data(), a.second.data() + 3);
+
+    ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RingBufferGLTest::allocateAligned() {
+    RingBuffer ring{64};
+
+    CORRADE_COMPARE(ring.allocate(3).first, 0);
+    CORRADE_COMPARE(ring.allocate(4, 16).first, 16);
+    CORRADE_COMPARE(ring.allocate(1, 4).first, 20);
+
+    ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RingBufferGLTest::upload() {
+    RingBuffer ring{16};
+
+    constexpr char data[] = {2, 7, 5, 13, 25};
+    CORRADE_COMPARE(ring.upload(data), 0);
+    CORRADE_COMPARE(ring.upload(data), 5);
+    ring.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> contents = ring.buffer().subData<char>(5, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(contents[0], 2);
+    CORRADE_COMPARE(contents[3], 13);
+    CORRADE_COMPARE(contents[4], 25);
+    #endif
+
+    ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RingBufferGLTest::wrapAround() {
+    RingBuffer ring{16};
+
+    constexpr char first[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    CORRADE_COMPARE(ring.upload(first), 0);
+    ring.fence();
+
+    /* Doesn't fit into the rest, wraps to the beginning */
+    constexpr char second[] = {21, 22, 23, 24, 25, 26, 27, 28};
+    constexpr char third[] = {31, 32, 33, 34};
+    CORRADE_COMPARE(ring.upload(second), 0);
+    CORRADE_COMPARE(ring.upload(third, 4), 8);
+    ring.fence();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> contents = ring.buffer().subData<char>(0, 12);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(contents[0], 21);
+    CORRADE_COMPARE(contents[7], 28);
+    CORRADE_COMPARE(contents[8], 31);
+    CORRADE_COMPARE(contents[11], 34);
+    #endif
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::RingBufferGLTest)
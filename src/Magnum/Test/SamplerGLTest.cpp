@@ -0,0 +1,255 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Sampler.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct SamplerGLTest: AbstractOpenGLTester {
+    explicit SamplerGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructCopy();
+    void constructMove();
+    void wrap();
+
+    void setParameters();
+
+    void cached();
+    void bind();
+    void bindMulti();
+};
+
+SamplerGLTest::SamplerGLTest() {
+    addTests({&SamplerGLTest::construct,
+              &SamplerGLTest::constructNoCreate,
+              &SamplerGLTest::constructCopy,
+              &SamplerGLTest::constructMove,
+              &SamplerGLTest::wrap,
+
+              &SamplerGLTest::setParameters,
+
+              &SamplerGLTest::cached,
+              &SamplerGLTest::bind,
+              &SamplerGLTest::bindMulti});
+}
+
+void SamplerGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    {
+        const Sampler sampler;
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(sampler.id() > 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void SamplerGLTest::constructNoCreate() {
+    {
+        Sampler sampler{NoCreate};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(sampler.id(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void SamplerGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<Sampler, const Sampler&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<Sampler, const Sampler&>{}));
+}
+
+void SamplerGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    Sampler a;
+    const Int id = a.id();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(id > 0);
+
+    Sampler b(std::move(a));
+
+    CORRADE_COMPARE(a.id(), 0);
+    CORRADE_COMPARE(b.id(), id);
+
+    Sampler c;
+    const Int cId = c.id();
+    c = std::move(b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cId > 0);
+    CORRADE_COMPARE(b.id(), cId);
+    CORRADE_COMPARE(c.id(), id);
+}
+
+void SamplerGLTest::wrap() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    GLuint id;
+    glGenSamplers(1, &id);
+
+    /* Releasing won't delete anything */
+    {
+        auto sampler = Sampler::wrap(id, ObjectFlag::DeleteOnDestruction);
+        CORRADE_COMPARE(sampler.release(), id);
+    }
+
+    /* ...so we can wrap it again */
+    Sampler::wrap(id);
+    glDeleteSamplers(1, &id);
+}
+
+void SamplerGLTest::setParameters() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    Sampler sampler;
+    sampler.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setMinLod(-750.0f)
+        .setMaxLod(750.0f)
+        #ifndef MAGNUM_TARGET_GLES
+        .setLodBias(0.5f)
+        .setBorderColor(Color4(0.2f, 0.4f, 0.6f, 0.8f))
+        #endif
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setMaxAnisotropy(Sampler::maxMaxAnisotropy())
+        .setCompareMode(Sampler::CompareMode::CompareRefToTexture)
+        .setCompareFunction(Sampler::CompareFunction::GreaterOrEqual);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint minificationFilter, wrapping;
+    GLfloat maxLod;
+    glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_MIN_FILTER, &minificationFilter);
+    glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_WRAP_T, &wrapping);
+    glGetSamplerParameterfv(sampler.id(), GL_TEXTURE_MAX_LOD, &maxLod);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(minificationFilter, GL_LINEAR_MIPMAP_LINEAR);
+    CORRADE_COMPARE(wrapping, GL_CLAMP_TO_EDGE);
+    CORRADE_COMPARE(maxLod, 750.0f);
+}
+
+void SamplerGLTest::cached() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    Sampler::Parameters linear;
+    linear.minificationFilter = Sampler::Filter::Linear;
+    linear.magnificationFilter = Sampler::Filter::Linear;
+
+    Sampler::Parameters nearest;
+    nearest.magnificationFilter = Sampler::Filter::Nearest;
+
+    Sampler::Parameters linearCopy = linear;
+    CORRADE_VERIFY(linearCopy == linear);
+    CORRADE_VERIFY(linear != nearest);
+
+    /* Same parameters give back the same object, different ones not */
+    Sampler& a = Sampler::cached(linear);
+    Sampler& b = Sampler::cached(nearest);
+    Sampler& c = Sampler::cached(linearCopy);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a.id() > 0);
+    CORRADE_VERIFY(b.id() > 0);
+    CORRADE_COMPARE(&a, &c);
+    CORRADE_COMPARE(a.id(), c.id());
+    CORRADE_VERIFY(a.id() != b.id());
+
+    /* The cached sampler has the parameters set */
+    GLint magnificationFilter;
+    glGetSamplerParameteriv(b.id(), GL_TEXTURE_MAG_FILTER, &magnificationFilter);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(magnificationFilter, GL_NEAREST);
+}
+
+void SamplerGLTest::bind() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    Sampler sampler;
+    sampler.bind(15);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint binding;
+    glActiveTexture(GL_TEXTURE15);
+    glGetIntegerv(GL_SAMPLER_BINDING, &binding);
+    CORRADE_COMPARE(GLuint(binding), sampler.id());
+
+    Sampler::unbind(15);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_SAMPLER_BINDING, &binding);
+    CORRADE_COMPARE(binding, 0);
+}
+
+void SamplerGLTest::bindMulti() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."));
+    #endif
+
+    Sampler a, b;
+    Sampler::bind(7, {&a, nullptr, &b});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Sampler::unbind(7, 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::SamplerGLTest)
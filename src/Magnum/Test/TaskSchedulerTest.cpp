@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/TaskScheduler.h"
+
+namespace Magnum { namespace Test {
+
+struct TaskSchedulerTest: TestSuite::Tester {
+    explicit TaskSchedulerTest();
+
+    void inline_();
+    void inlineDependencies();
+    void inlineParallelFor();
+
+    void dependencies();
+    void waitFinished();
+    void parallelFor();
+    void parallelForNested();
+    void parallelForEmpty();
+    void addFromTask();
+    void destructorWaits();
+};
+
+TaskSchedulerTest::TaskSchedulerTest() {
+    addTests({&TaskSchedulerTest::inline_,
+              &TaskSchedulerTest::inlineDependencies,
+              &TaskSchedulerTest::inlineParallelFor,
+
+              &TaskSchedulerTest::dependencies,
+              &TaskSchedulerTest::waitFinished,
+              &TaskSchedulerTest::parallelFor,
+              &TaskSchedulerTest::parallelForNested,
+              &TaskSchedulerTest::parallelForEmpty,
+              &TaskSchedulerTest::addFromTask,
+              &TaskSchedulerTest::destructorWaits});
+}
+
+void TaskSchedulerTest::inline_() {
+    TaskScheduler scheduler{0};
+    CORRADE_COMPARE(scheduler.workerCount(), 0);
+
+    std::vector<Int> order;
+    const TaskScheduler::TaskId a = scheduler.add([&]() { order.push_back(0); });
+    scheduler.add([&]() { order.push_back(1); });
+    scheduler.add([&]() { order.push_back(2); });
+
+    /* Nothing is run until waiting */
+    CORRADE_VERIFY(order.empty());
+    CORRADE_VERIFY(!scheduler.isFinished(a));
+
+    scheduler.wait(a);
+    CORRADE_VERIFY(scheduler.isFinished(a));
+    CORRADE_COMPARE(order, (std::vector<Int>{0}));
+
+    scheduler.wait();
+    CORRADE_COMPARE(order, (std::vector<Int>{0, 1, 2}));
+}
+
+void TaskSchedulerTest::inlineDependencies() {
+    TaskScheduler scheduler{0};
+
+    /* Tasks are run in the order they become ready */
+    std::vector<Int> order;
+    const TaskScheduler::TaskId a = scheduler.add([&]() { order.push_back(0); });
+    const TaskScheduler::TaskId b = scheduler.add([&]() { order.push_back(1); }, {a});
+    scheduler.add([&]() { order.push_back(2); });
+    scheduler.add([&]() { order.push_back(3); }, {b, a});
+    scheduler.wait();
+    CORRADE_COMPARE(order, (std::vector<Int>{0, 2, 1, 3}));
+}
+
+void TaskSchedulerTest::inlineParallelFor() {
+    TaskScheduler scheduler{0};
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    scheduler.parallelFor(10, 4, [&](std::size_t begin, std::size_t end) {
+        ranges.emplace_back(begin, end);
+    });
+    CORRADE_COMPARE(ranges.size(), 3);
+    CORRADE_VERIFY(ranges[0] == std::make_pair(std::size_t{0}, std::size_t{4}));
+    CORRADE_VERIFY(ranges[1] == std::make_pair(std::size_t{4}, std::size_t{8}));
+    CORRADE_VERIFY(ranges[2] == std::make_pair(std::size_t{8}, std::size_t{10}));
+}
+
+void TaskSchedulerTest::dependencies() {
+    TaskScheduler scheduler{4};
+    CORRADE_COMPARE(scheduler.workerCount(), 4);
+
+    /* Diamond dependency repeated many times, each task verifies that its
+       dependencies finished */
+    for(std::size_t i = 0; i != 100; ++i) {
+        std::atomic<Int> a{0}, b{0}, c{0}, d{0};
+        std::atomic<Int> failures{0};
+        const TaskScheduler::TaskId ta = scheduler.add([&]() { a = 1; });
+        const TaskScheduler::TaskId tb = scheduler.add([&]() {
+            if(!a) ++failures;
+            b = 1;
+        }, {ta});
+        const TaskScheduler::TaskId tc = scheduler.add([&]() {
+            if(!a) ++failures;
+            c = 1;
+        }, {ta});
+        const TaskScheduler::TaskId td = scheduler.add([&]() {
+            if(!b || !c) ++failures;
+            d = 1;
+        }, {tb, tc});
+
+        scheduler.wait(td);
+        CORRADE_COMPARE(failures.load(), 0);
+        CORRADE_COMPARE(d.load(), 1);
+    }
+
+    scheduler.wait();
+}
+
+void TaskSchedulerTest::waitFinished() {
+    TaskScheduler scheduler{2};
+
+    Int value = 0;
+    const TaskScheduler::TaskId id = scheduler.add([&]() { value = 42; });
+    scheduler.wait(id);
+    CORRADE_COMPARE(value, 42);
+
+    /* Waiting for and depending on a finished task is fine */
+    scheduler.wait(id);
+    scheduler.wait(scheduler.add([&]() { value = 1337; }, {id}));
+    CORRADE_COMPARE(value, 1337);
+}
+
+void TaskSchedulerTest::parallelFor() {
+    TaskScheduler scheduler{3};
+
+    std::vector<Int> data(100000);
+    scheduler.parallelFor(data.size(), 1000, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) ++data[i];
+    });
+
+    /* Each item was processed exactly once */
+    CORRADE_COMPARE_AS(data, std::vector<Int>(100000, 1), TestSuite::Compare::Container);
+}
+
+void TaskSchedulerTest::parallelForNested() {
+    TaskScheduler scheduler{2};
+
+    /* The outer ranges wait for the inner ones while running on a worker,
+       which shouldn't deadlock */
+    std::atomic<std::size_t> count{0};
+    scheduler.parallelFor(16, 1, [&](std::size_t, std::size_t) {
+        scheduler.parallelFor(1000, 10, [&](std::size_t begin, std::size_t end) {
+            count += end - begin;
+        });
+    });
+    CORRADE_COMPARE(count.load(), 16000);
+}
+
+void TaskSchedulerTest::parallelForEmpty() {
+    TaskScheduler scheduler{2};
+
+    Int called = 0;
+    scheduler.parallelFor(0, 10, [&](std::size_t, std::size_t) { ++called; });
+    CORRADE_COMPARE(called, 0);
+
+    /* Zero grain size is treated as one */
+    scheduler.parallelFor(3, 0, [&](std::size_t begin, std::size_t end) {
+        called += Int(end - begin);
+    });
+    CORRADE_COMPARE(called, 3);
+}
+
+void TaskSchedulerTest::addFromTask() {
+    TaskScheduler scheduler{2};
+
+    std::atomic<Int> count{0};
+    scheduler.add([&]() {
+        for(std::size_t i = 0; i != 10; ++i) scheduler.add([&]() { ++count; });
+    });
+    scheduler.wait();
+    CORRADE_COMPARE(count.load(), 10);
+}
+
+void TaskSchedulerTest::destructorWaits() {
+    std::atomic<Int> count{0};
+    {
+        TaskScheduler scheduler{2};
+        for(std::size_t i = 0; i != 100; ++i) scheduler.add([&]() { ++count; });
+    }
+    CORRADE_COMPARE(count.load(), 100);
+
+    /* With no workers, the tasks are run by the destructor */
+    {
+        TaskScheduler scheduler{0};
+        scheduler.add([&]() { ++count; });
+    }
+    CORRADE_COMPARE(count.load(), 101);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TaskSchedulerTest)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
 #include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/configure.h"
@@ -65,6 +66,10 @@ struct TextureGLTest: AbstractOpenGLTester {
     #endif
     void bind2D();
     void bind3D();
+    #ifndef MAGNUM_TARGET_GLES
+    void bindless2D();
+    void sparse2D();
+    #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     #ifndef MAGNUM_TARGET_GLES
@@ -228,6 +233,10 @@ TextureGLTest::TextureGLTest() {
         #endif
         &TextureGLTest::bind2D,
         &TextureGLTest::bind3D,
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureGLTest::bindless2D,
+        &TextureGLTest::sparse2D,
+        #endif
 
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         #ifndef MAGNUM_TARGET_GLES
@@ -592,6 +601,69 @@ void TextureGLTest::bind3D() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureGLTest::bindless2D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i(32));
+
+    const UnsignedLong handle = texture.handle();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(handle);
+    CORRADE_COMPARE(texture.handle(), handle);
+    CORRADE_VERIFY(!texture.isResident());
+
+    texture.setResident(true);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(texture.isResident());
+
+    /* Making it resident again is a no-op */
+    texture.setResident(true);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    texture.setResident(false);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!texture.isResident());
+}
+
+void TextureGLTest::sparse2D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector3i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+    MAGNUM_VERIFY_NO_ERROR();
+    if(pageSize.isZero())
+        CORRADE_SKIP("TextureFormat::RGBA8 is not supported for sparse textures.");
+    CORRADE_COMPARE(pageSize.z(), 1);
+
+    Texture2D texture;
+    texture.setSparseStorage(4, TextureFormat::RGBA8, pageSize.xy()*4);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* First level is larger than a page, so it's not part of the tail */
+    const Int sparseLevelCount = texture.sparseLevelCount();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(sparseLevelCount >= 1);
+
+    texture.commitPages(0, {pageSize.xy(), pageSize.xy()*2});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Upload into the committed page and read it back */
+    const std::vector<Color4ub> data(pageSize.xy().product(), Color4ub{0x11, 0x22, 0x33, 0x44});
+    texture.setSubImage(0, pageSize.xy(), ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, pageSize.xy(), {data.data(), data.size()*sizeof(Color4ub)}});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = texture.subImage(0, {pageSize.xy(), pageSize.xy()*2}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{0x11, 0x22, 0x33, 0x44}));
+
+    texture.decommitPages(0, {pageSize.xy(), pageSize.xy()*2});
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 #ifndef MAGNUM_TARGET_GLES
 void TextureGLTest::bindImage1D() {
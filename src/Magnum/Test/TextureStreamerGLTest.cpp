@@ -0,0 +1,156 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <thread>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureStreamer.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct TextureStreamerGLTest: AbstractOpenGLTester {
+    explicit TextureStreamerGLTest();
+
+    void construct();
+
+    void acquire();
+    void upload();
+    void uploadThreaded();
+};
+
+TextureStreamerGLTest::TextureStreamerGLTest() {
+    addTests({&TextureStreamerGLTest::construct,
+
+              &TextureStreamerGLTest::acquire,
+              &TextureStreamerGLTest::upload,
+              &TextureStreamerGLTest::uploadThreaded});
+}
+
+void TextureStreamerGLTest::construct() {
+    TextureStreamer streamer{1000, 3};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(streamer.buffer().id() > 0);
+    CORRADE_COMPARE(streamer.sliceSize(), 1008);
+    CORRADE_COMPARE(streamer.sliceCount(), 3);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(streamer.buffer().size(), 3*1008);
+    #endif
+
+    if(streamer.isPersistent())
+        Debug() << "Using persistently mapped buffer storage";
+}
+
+void TextureStreamerGLTest::acquire() {
+    TextureStreamer streamer{16, 2};
+
+    const UnsignedInt a = streamer.tryAcquire();
+    const UnsignedInt b = streamer.tryAcquire();
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(streamer.tryAcquire(), UnsignedInt(TextureStreamer::NoSlice));
+    CORRADE_COMPARE(streamer.sliceData(b).data(), streamer.sliceData(a).data() + 16);
+    CORRADE_COMPARE(streamer.sliceData(b).size(), 16);
+
+    streamer.release(a);
+    CORRADE_COMPARE(streamer.tryAcquire(), a);
+}
+
+namespace {
+    constexpr UnsignedByte Data[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+}
+
+void TextureStreamerGLTest::upload() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{4, 2});
+
+    TextureStreamer streamer{16, 2};
+    const UnsignedInt slice = streamer.acquire();
+    std::copy_n(reinterpret_cast<const char*>(Data), 16, streamer.sliceData(slice).data());
+    streamer.submit(slice, texture, 0, {1, 0}, PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2});
+    CORRADE_COMPARE(streamer.update(), 1);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Nothing left to upload */
+    CORRADE_COMPARE(streamer.update(), 0);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(image.size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE_AS(
+        (Containers::ArrayView<const UnsignedByte>{image.data<UnsignedByte>() + 4, 8}),
+        (Containers::ArrayView<const UnsignedByte>{Data, 8}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(
+        (Containers::ArrayView<const UnsignedByte>{image.data<UnsignedByte>() + 20, 8}),
+        (Containers::ArrayView<const UnsignedByte>{Data + 8, 8}), TestSuite::Compare::Container);
+    #endif
+}
+
+void TextureStreamerGLTest::uploadThreaded() {
+    constexpr Int TileCount = 16;
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{TileCount, 1});
+
+    /* Less slices than uploads, so the loader has to wait for recycling */
+    TextureStreamer streamer{4, 2};
+    std::thread loader{[&streamer, &texture]() {
+        for(Int i = 0; i != TileCount; ++i) {
+            const UnsignedInt slice = streamer.acquire();
+            std::fill_n(streamer.sliceData(slice).data(), 4, char(i));
+            streamer.submit(slice, texture, 0, {i, 0}, PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1});
+        }
+    }};
+
+    Int uploaded = 0;
+    while(uploaded != TileCount) uploaded += streamer.update();
+    loader.join();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    for(Int i = 0; i != TileCount; ++i)
+        CORRADE_COMPARE(Int(image.data<UnsignedByte>()[i*4 + 3]), i);
+    #endif
+}
+
+}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Test::TextureStreamerGLTest)
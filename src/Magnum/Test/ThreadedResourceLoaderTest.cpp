@@ -0,0 +1,168 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ResourceManager.h"
+#include "Magnum/ThreadedResourceLoader.h"
+
+namespace Magnum { namespace Test {
+
+struct ThreadedResourceLoaderTest: TestSuite::Tester {
+    explicit ThreadedResourceLoaderTest();
+
+    void load();
+    void notFound();
+    void fallback();
+    void budget();
+    void stop();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+ThreadedResourceLoaderTest::ThreadedResourceLoaderTest() {
+    addTests({&ThreadedResourceLoaderTest::load,
+              &ThreadedResourceLoaderTest::notFound,
+              &ThreadedResourceLoaderTest::fallback,
+              &ThreadedResourceLoaderTest::budget,
+              &ThreadedResourceLoaderTest::stop});
+}
+
+namespace {
+    class IntResourceLoader: public ThreadedResourceLoader<Int, Int> {
+        public:
+            explicit IntResourceLoader(UnsignedInt threadCount = 2): ThreadedResourceLoader<Int, Int>{threadCount} {}
+
+            ~IntResourceLoader() { stop(); }
+
+        private:
+            std::optional<Int> doDecode(ResourceKey key) override {
+                if(key == ResourceKey("hello")) return 21;
+                if(key == ResourceKey("world")) return 12;
+                return std::nullopt;
+            }
+
+            void doCreate(ResourceKey key, Int&& data) override {
+                set(key, data*2);
+            }
+    };
+}
+
+void ThreadedResourceLoaderTest::load() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader;
+    rm.setLoader(loader);
+    CORRADE_COMPARE(loader->threadCount(), 2);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->requestedCount(), 2);
+
+    /* Nothing is created without calling update() */
+    loader->wait();
+    CORRADE_COMPARE(loader->pendingCount(), 2);
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->loadedCount(), 0);
+
+    CORRADE_COMPARE(loader->update(), 2);
+    CORRADE_COMPARE(loader->pendingCount(), 0);
+    CORRADE_COMPARE(loader->loadedCount(), 2);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 42);
+    CORRADE_COMPARE(*world, 24);
+
+    /* Nothing more to do */
+    CORRADE_COMPARE(loader->update(), 0);
+}
+
+void ThreadedResourceLoaderTest::notFound() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader;
+    rm.setLoader(loader);
+
+    Resource<Int> data = rm.get<Int>("nonexistent");
+    loader->wait();
+    CORRADE_COMPARE(loader->update(), 1);
+    CORRADE_COMPARE(data.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader->notFoundCount(), 1);
+    CORRADE_COMPARE(loader->loadedCount(), 0);
+}
+
+void ThreadedResourceLoaderTest::fallback() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader;
+    rm.setLoader(loader);
+    rm.setFallback(new Int{-1});
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(hello.state(), ResourceState::LoadingFallback);
+    CORRADE_COMPARE(*hello, -1);
+
+    /* The handle switches to the loaded data on its own */
+    loader->wait();
+    loader->update();
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 42);
+}
+
+void ThreadedResourceLoaderTest::budget() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader;
+    rm.setLoader(loader);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    Resource<Int> nonexistent = rm.get<Int>("nonexistent");
+    loader->wait();
+
+    /* Zero budget still makes progress, one resource at a time */
+    CORRADE_COMPARE(loader->update(std::chrono::microseconds::zero()), 1);
+    CORRADE_COMPARE(loader->pendingCount(), 2);
+    CORRADE_COMPARE(loader->update(std::chrono::microseconds::zero()), 1);
+    CORRADE_COMPARE(loader->update(std::chrono::microseconds::zero()), 1);
+    CORRADE_COMPARE(loader->update(std::chrono::microseconds::zero()), 0);
+
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(world.state(), ResourceState::Final);
+    CORRADE_COMPARE(nonexistent.state(), ResourceState::NotFound);
+}
+
+void ThreadedResourceLoaderTest::stop() {
+    IntResourceLoader loader{1};
+    CORRADE_COMPARE(loader.threadCount(), 1);
+
+    loader.stop();
+    CORRADE_COMPARE(loader.threadCount(), 0);
+
+    /* Calling it again is a no-op, waiting doesn't block */
+    loader.stop();
+    loader.wait();
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ThreadedResourceLoaderTest)
@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Tracing.h"
+
+namespace Magnum { namespace Test {
+
+struct TracingTest: TestSuite::Tester {
+    explicit TracingTest();
+
+    void zone();
+    void nested();
+    void noCallbacks();
+    void callbacksResetInside();
+    void callbacksOnlyOne();
+
+    void macro();
+};
+
+TracingTest::TracingTest() {
+    addTests({&TracingTest::zone,
+              &TracingTest::nested,
+              &TracingTest::noCallbacks,
+              &TracingTest::callbacksResetInside,
+              &TracingTest::callbacksOnlyOne,
+
+              &TracingTest::macro});
+}
+
+namespace {
+    void begin(const Tracing::Location& location, void* userData) {
+        static_cast<std::vector<std::string>*>(userData)->push_back(std::string{"begin "} + location.name);
+    }
+
+    void end(const Tracing::Location& location, void* userData) {
+        static_cast<std::vector<std::string>*>(userData)->push_back(std::string{"end "} + location.name);
+    }
+
+    constexpr Tracing::Location Outer{"outer", "zone", __FILE__, __LINE__, false};
+    constexpr Tracing::Location Inner{"inner", "zone", __FILE__, __LINE__, false};
+}
+
+void TracingTest::zone() {
+    std::vector<std::string> events;
+    Tracing::setCallbacks(begin, end, &events);
+
+    {
+        Tracing::Zone zone{Outer};
+        CORRADE_COMPARE_AS(events, (std::vector<std::string>{"begin outer"}),
+            TestSuite::Compare::Container);
+    }
+
+    Tracing::setCallbacks(nullptr, nullptr);
+    CORRADE_COMPARE_AS(events, (std::vector<std::string>{"begin outer", "end outer"}),
+        TestSuite::Compare::Container);
+}
+
+void TracingTest::nested() {
+    std::vector<std::string> events;
+    Tracing::setCallbacks(begin, end, &events);
+
+    {
+        Tracing::Zone outer{Outer};
+        Tracing::Zone inner{Inner};
+    }
+
+    Tracing::setCallbacks(nullptr, nullptr);
+    CORRADE_COMPARE_AS(events, (std::vector<std::string>{
+        "begin outer", "begin inner", "end inner", "end outer"}),
+        TestSuite::Compare::Container);
+}
+
+void TracingTest::noCallbacks() {
+    std::vector<std::string> events;
+
+    {
+        Tracing::Zone zone{Outer};
+    }
+
+    /* Callbacks set after the zone began don't get the end event */
+    {
+        Tracing::Zone zone{Outer};
+        Tracing::setCallbacks(begin, end, &events);
+    }
+
+    Tracing::setCallbacks(nullptr, nullptr);
+    CORRADE_VERIFY(events.empty());
+}
+
+void TracingTest::callbacksResetInside() {
+    std::vector<std::string> events;
+    Tracing::setCallbacks(begin, end, &events);
+
+    {
+        Tracing::Zone zone{Outer};
+        Tracing::setCallbacks(nullptr, nullptr);
+    }
+
+    CORRADE_COMPARE_AS(events, (std::vector<std::string>{"begin outer"}),
+        TestSuite::Compare::Container);
+}
+
+void TracingTest::callbacksOnlyOne() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Tracing::setCallbacks(begin, nullptr);
+    CORRADE_COMPARE(out.str(), "Tracing::setCallbacks(): either both or none of the callbacks has to be set\n");
+}
+
+void TracingTest::macro() {
+    std::vector<std::string> events;
+    Tracing::setCallbacks(begin, end, &events);
+
+    {
+        MAGNUM_TRACE_CPU_ZONE("macro");
+    }
+
+    Tracing::setCallbacks(nullptr, nullptr);
+
+    #ifdef MAGNUM_BUILD_TRACING
+    CORRADE_COMPARE_AS(events, (std::vector<std::string>{"begin macro", "end macro"}),
+        TestSuite::Compare::Container);
+    #else
+    /* Compiled out */
+    CORRADE_VERIFY(events.empty());
+    #endif
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TracingTest)
@@ -136,7 +136,23 @@ void AbstractFont::fillGlyphCache(GlyphCache& cache, const std::string& characte
     CORRADE_ASSERT(!(features() & Feature::PreparedGlyphCache),
         "Text::AbstractFont::fillGlyphCache(): feature not supported", );
 
-    doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
+    if(!cache.isDynamic()) {
+        doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
+        return;
+    }
+
+    /* Render only unique characters which are not in the cache yet, mark
+       the rest as used so they aren't evicted while filling the new ones */
+    cache.beginFill();
+    std::u32string missing;
+    for(const char32_t character: Utility::Unicode::utf32(characters)) {
+        const UnsignedInt glyph = doGlyphId(character);
+        if(cache.contains(glyph)) cache.touch(glyph);
+        else if(missing.find(character) == std::u32string::npos)
+            missing += character;
+    }
+
+    if(!missing.empty()) doFillGlyphCache(cache, missing);
 }
 
 void AbstractFont::doFillGlyphCache(GlyphCache&, const std::u32string&) {
@@ -157,13 +173,50 @@ std::unique_ptr<GlyphCache> AbstractFont::doCreateGlyphCache() {
     return nullptr;
 }
 
+std::optional<std::pair<Vector2i, Image2D>> AbstractFont::rasterizeGlyph(const UnsignedInt glyph) {
+    CORRADE_ASSERT(isOpened(),
+        "Text::AbstractFont::rasterizeGlyph(): no font opened", std::nullopt);
+    CORRADE_ASSERT(features() & Feature::GlyphRasterization,
+        "Text::AbstractFont::rasterizeGlyph(): feature not supported", std::nullopt);
+
+    return doRasterizeGlyph(glyph);
+}
+
+std::optional<std::pair<Vector2i, Image2D>> AbstractFont::doRasterizeGlyph(UnsignedInt) {
+    CORRADE_ASSERT(false, "Text::AbstractFont::rasterizeGlyph(): feature advertised but not implemented", std::nullopt);
+    return std::nullopt;
+}
+
 std::unique_ptr<AbstractLayouter> AbstractFont::layout(const GlyphCache& cache, const Float size, const std::string& text) {
     CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
 
     return doLayout(cache, size, text);
 }
 
-AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount) {}
+std::unique_ptr<AbstractLayouter> AbstractFont::layout(GlyphCache& cache, const Float size, const std::string& text) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
+
+    if(cache.isDynamic() && !(features() & Feature::PreparedGlyphCache))
+        fillGlyphCache(cache, text);
+
+    return doLayout(cache, size, text);
+}
+
+void AbstractFont::layoutInto(const GlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter>& layouter) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layoutInto(): no font opened", );
+
+    /* Pass the layouter to the implementation only if it created it */
+    if(layouter && layouter->_font != this) layouter = nullptr;
+
+    layouter = doLayoutInto(cache, size, text, std::move(layouter));
+    layouter->_font = this;
+}
+
+std::unique_ptr<AbstractLayouter> AbstractFont::doLayoutInto(const GlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter>) {
+    return doLayout(cache, size, std::string{text.data(), text.size()});
+}
+
+AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount), _font{} {}
 
 AbstractLayouter::~AbstractLayouter() {}
 
@@ -34,11 +34,14 @@
 #include <tuple>
 #include <Corrade/PluginManager/AbstractPlugin.h>
 
+#include "Magnum/Image.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/Texture.h"
 #include "Magnum/Text/Text.h"
 #include "Magnum/Text/visibility.h"
 
+#include "MagnumExternal/Optional/optional.hpp"
+
 namespace Magnum { namespace Text {
 
 /**
@@ -72,10 +75,10 @@ checked by the implementation:
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
-Plugin interface string is `"cz.mosra.magnum.Text.AbstractFont/0.2.4"`.
+Plugin interface string is `"cz.mosra.magnum.Text.AbstractFont/0.2.6"`.
 */
 class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Text.AbstractFont/0.2.4")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Text.AbstractFont/0.2.6")
 
     public:
         /**
@@ -98,7 +101,13 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
              *
              * @see @ref fillGlyphCache(), @ref createGlyphCache()
              */
-            PreparedGlyphCache = 1 << 2
+            PreparedGlyphCache = 1 << 2,
+
+            /**
+             * Rasterizing single glyphs into memory using
+             * @ref rasterizeGlyph()
+             */
+            GlyphRasterization = 1 << 3
         };
 
         /** @brief Set of features supported by this importer */
@@ -217,6 +226,12 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          * Fills the cache with given characters. Fonts having
          * @ref Feature::PreparedGlyphCache do not support partial glyph cache
          * filling, use @ref createGlyphCache() instead.
+         *
+         * If the cache is @ref GlyphCache::isDynamic() "dynamic", only
+         * characters which are not already in the cache are rendered and all
+         * glyphs for given characters are marked as recently used. See
+         * @ref Text-GlyphCache-dynamic "GlyphCache documentation" for more
+         * information.
          */
         void fillGlyphCache(GlyphCache& cache, const std::string& characters);
 
@@ -230,6 +245,23 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         std::unique_ptr<GlyphCache> createGlyphCache();
 
+        /**
+         * @brief Rasterize glyph
+         * @param glyph     Glyph ID
+         *
+         * Available only if @ref Feature::GlyphRasterization is supported.
+         * Returns glyph position relative to point on baseline and glyph
+         * image in @ref PixelFormat::Red and @ref PixelType::UnsignedByte,
+         * or @ref std::nullopt on failure. The image doesn't need any OpenGL
+         * context, so it can be used for filling a glyph cache offline, see
+         * @ref magnum-fontconverter for an example.
+         *
+         * The font instance is not expected to be thread-safe, to rasterize
+         * glyphs on more threads in parallel, open the font in a separate
+         * instance for each thread.
+         */
+        std::optional<std::pair<Vector2i, Image2D>> rasterizeGlyph(UnsignedInt glyph);
+
         /**
          * @brief Layout the text using font's own layouter
          * @param cache     Glyph cache
@@ -242,6 +274,32 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         std::unique_ptr<AbstractLayouter> layout(const GlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout the text using font's own layouter, filling the cache
+         *
+         * If the cache is @ref GlyphCache::isDynamic() "dynamic", calls
+         * @ref fillGlyphCache() with given @p text first, so the glyphs
+         * missing in the cache are rendered on demand. Otherwise same as
+         * @ref layout(const GlyphCache&, Float, const std::string&).
+         */
+        std::unique_ptr<AbstractLayouter> layout(GlyphCache& cache, Float size, const std::string& text);
+
+        /**
+         * @brief Layout the text reusing existing layouter
+         * @param cache     Glyph cache
+         * @param size      Font size
+         * @param text      UTF-8 text to layout
+         * @param layouter  Layouter to reuse
+         *
+         * Unlike @ref layout(), the text doesn't need to be a standalone
+         * @ref std::string. If @p layouter was returned from previous call to
+         * this function on the same font, it may be reused, otherwise it's
+         * replaced with a new one. Fonts which implement @ref doLayoutInto()
+         * don't allocate any memory once the reused layouter has enough
+         * capacity for the text.
+         */
+        void layoutInto(const GlyphCache& cache, Float size, Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter>& layouter);
+
     protected:
         /**
          * @brief Font metrics
@@ -332,9 +390,23 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref createGlyphCache() */
         virtual std::unique_ptr<GlyphCache> doCreateGlyphCache();
 
+        /** @brief Implementation for @ref rasterizeGlyph() */
+        virtual std::optional<std::pair<Vector2i, Image2D>> doRasterizeGlyph(UnsignedInt glyph);
+
         /** @brief Implementation for @ref layout() */
         virtual std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, Float size, const std::string& text) = 0;
 
+        /**
+         * @brief Implementation for @ref layoutInto()
+         *
+         * The @p layouter is either `nullptr` or was returned from
+         * previous call to this function on the same font. The function
+         * should update it with the new text and return it, if possible.
+         * Default implementation passes the text to @ref doLayout() and
+         * returns a new layouter.
+         */
+        virtual std::unique_ptr<AbstractLayouter> doLayoutInto(const GlyphCache& cache, Float size, Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter> layouter);
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
@@ -355,6 +427,8 @@ implements @ref doRenderGlyph(). Bounds checking on @p i is done automatically
 in the wrapping @ref renderGlyph() function.
 */
 class MAGNUM_TEXT_EXPORT AbstractLayouter {
+    friend class AbstractFont;
+
     public:
         /** @brief Copying is not allowed */
         AbstractLayouter(const AbstractLayouter&) = delete;
@@ -392,6 +466,14 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         explicit AbstractLayouter(UnsignedInt glyphCount);
 
+        /**
+         * @brief Set count of glyphs in laid out text
+         *
+         * Meant to be used when the layouter is reused in
+         * @ref AbstractFont::doLayoutInto().
+         */
+        void setGlyphCount(UnsignedInt glyphCount) { _glyphCount = glyphCount; }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -410,6 +492,8 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
     private:
     #endif
         UnsignedInt _glyphCount;
+        /* Font which created the layouter in AbstractFont::layoutInto() */
+        const AbstractFont* _font;
 };
 
 }}
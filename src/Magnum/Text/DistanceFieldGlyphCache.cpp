@@ -86,7 +86,18 @@ void DistanceFieldGlyphCache::setImage(const Vector2i& offset, const ImageView2D
         .setMagnificationFilter(Sampler::Filter::Linear)
         .setImage(0, internalFormat, image);
 
-    /* Create distance field from input texture */
+    /* Create distance field from input texture. Jump flooding is much faster
+       for large radii, use it where available. */
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isVersionSupported(Version::GL330))
+    #endif
+    {
+        TextureTools::jumpFloodingDistanceField(input, texture(), Range2Di::fromSize(offset*scale, image.size()*scale), radius, image.size());
+        return;
+    }
+    #endif
+
     TextureTools::distanceField(input, texture(), Range2Di::fromSize(offset*scale, image.size()*scale), radius, image.size());
 }
 
@@ -77,7 +77,10 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          * @brief Set cache image
          *
          * Uploads image for one or more glyphs to given offset in original
-         * cache texture. The texture is then converted to distance field.
+         * cache texture. The texture is then converted to distance field
+         * using @ref TextureTools::jumpFloodingDistanceField() if OpenGL 3.3
+         * or OpenGL ES 3.0 is available, @ref TextureTools::distanceField()
+         * otherwise.
          */
         void setImage(const Vector2i& offset, const ImageView2D& image) override;
 
@@ -25,23 +25,132 @@
 
 #include "GlyphCache.h"
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelStorage.h"
 #include "Magnum/TextureFormat.h"
-#include "Magnum/TextureTools/Atlas.h"
+#include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace Text {
 
+struct GlyphCache::Dynamic {
+    /* Horizontal strip of glyphs of similar height */
+    struct Shelf {
+        Int y, height;
+        /* End of the space ever used on the shelf */
+        Int end;
+        /* Freed spans below the end, X and width */
+        std::vector<Vector2i> free;
+    };
+
+    struct Glyph {
+        /* Padded region on a shelf */
+        Range2Di region;
+        /* Fill during which the glyph was last used */
+        UnsignedInt fill;
+        std::list<UnsignedInt>::iterator lru;
+    };
+
+    std::optional<Range2Di> allocate(const Vector2i& size, Int width, Int height);
+    void free(const Range2Di& region);
+
+    std::vector<Shelf> shelves;
+    Int shelvesEnd{};
+
+    /* Glyph data, the most recently used glyph is at the front of the list */
+    std::unordered_map<UnsignedInt, Glyph> glyphs;
+    std::list<UnsignedInt> lru;
+    UnsignedInt fill{};
+
+    /* Regions reserved but not yet inserted, new regions not yet uploaded */
+    std::vector<Range2Di> reserved, dirty;
+
+    std::size_t usedArea{}, evictedCount{};
+};
+
+std::optional<Range2Di> GlyphCache::Dynamic::allocate(const Vector2i& size, const Int width, const Int height) {
+    /* Find the best fitting shelf. Allow wasting at most half the glyph height
+       on non-empty shelves, so small glyphs don't take space on large shelves
+       which could be used for large glyphs. */
+    Shelf* best = nullptr;
+    for(Shelf& shelf: shelves) {
+        if(shelf.height < size.y() || (best && best->height <= shelf.height))
+            continue;
+        if(shelf.end != 0 && shelf.height > size.y() + size.y()/2)
+            continue;
+
+        const bool fitsFree = std::any_of(shelf.free.begin(), shelf.free.end(), [&size](const Vector2i& span) { return span.y() >= size.x(); });
+        if(fitsFree || shelf.end + size.x() <= width) best = &shelf;
+    }
+
+    /* Create a new shelf, if there's space left */
+    if(!best) {
+        if(shelvesEnd + size.y() > height || size.x() > width) return {};
+        shelves.push_back({shelvesEnd, size.y(), 0, {}});
+        shelvesEnd += size.y();
+        best = &shelves.back();
+    }
+
+    /* Take first free span that fits, otherwise the end of the shelf */
+    Int x;
+    auto found = std::find_if(best->free.begin(), best->free.end(), [&size](const Vector2i& span) { return span.y() >= size.x(); });
+    if(found != best->free.end()) {
+        x = found->x();
+        if(found->y() == size.x()) best->free.erase(found);
+        else *found += Vector2i{size.x(), -size.x()};
+    } else {
+        x = best->end;
+        best->end += size.x();
+    }
+
+    return Range2Di::fromSize({x, best->y}, size);
+}
+
+void GlyphCache::Dynamic::free(const Range2Di& region) {
+    auto shelf = std::find_if(shelves.begin(), shelves.end(), [&region](const Shelf& shelf) { return shelf.y == region.bottom(); });
+    CORRADE_INTERNAL_ASSERT(shelf != shelves.end());
+
+    /* Insert the span sorted and merge it with neighbors */
+    Vector2i span{region.left(), region.sizeX()};
+    auto next = std::find_if(shelf->free.begin(), shelf->free.end(), [&span](const Vector2i& other) { return other.x() > span.x(); });
+    if(next != shelf->free.end() && span.x() + span.y() == next->x()) {
+        span.y() += next->y();
+        next = shelf->free.erase(next);
+    }
+    if(next != shelf->free.begin() && (next - 1)->x() + (next - 1)->y() == span.x()) {
+        (next - 1)->y() += span.y();
+        span = *(next - 1);
+        next = shelf->free.erase(next - 1);
+    }
+
+    /* Span at the end of the shelf just shrinks it */
+    if(span.x() + span.y() == shelf->end) shelf->end = span.x();
+    else shelf->free.insert(next, span);
+
+    /* Remove empty shelves from the top so the space can be used for shelves
+       of different height */
+    while(!shelves.empty() && shelves.back().end == 0) {
+        shelvesEnd = shelves.back().y;
+        shelves.pop_back();
+    }
+}
+
 GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& size, const Vector2i& padding): GlyphCache{internalFormat, size, size, padding} {}
 
-GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding) {
+GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding} {
     initialize(internalFormat, size);
 }
 
 GlyphCache::GlyphCache(const Vector2i& size, const Vector2i& padding): GlyphCache{size, size, padding} {}
 
-GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding) {
+GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding} {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
     #endif
@@ -62,6 +171,22 @@ GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const
     initialize(internalFormat, size);
 }
 
+GlyphCache::GlyphCache(NoCreateT, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding}, _texture{NoCreate} {
+    _image.emplace(PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, size, Containers::Array<char>{Containers::ValueInit, std::size_t(size.product())});
+
+    /* Default "Not Found" glyph */
+    glyphs.insert({0, {}});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+GlyphCache::GlyphCache(Texture2DArray& textureArray, const Int layer, const Vector2i& size, const Vector2i& padding): GlyphCache{textureArray, layer, size, size, padding} {}
+
+GlyphCache::GlyphCache(Texture2DArray& textureArray, const Int layer, const Vector2i& originalSize, const Vector2i&, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding}, _texture{NoCreate}, _textureArray{&textureArray}, _textureArrayLayer{layer} {
+    /* Default "Not Found" glyph */
+    glyphs.insert({0, {}});
+}
+#endif
+
 GlyphCache::~GlyphCache() = default;
 
 void GlyphCache::initialize(const TextureFormat internalFormat, const Vector2i& size) {
@@ -75,11 +200,133 @@ void GlyphCache::initialize(const TextureFormat internalFormat, const Vector2i&
     glyphs.insert({0, {}});
 }
 
+Texture2D& GlyphCache::texture() {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!_image && !_textureArray, "Text::GlyphCache::texture(): the cache has no texture", _texture);
+    #else
+    CORRADE_ASSERT(!_image, "Text::GlyphCache::texture(): the cache has no texture", _texture);
+    #endif
+    return _texture;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+Texture2DArray& GlyphCache::textureArray() {
+    CORRADE_ASSERT(_textureArray, "Text::GlyphCache::textureArray(): the cache is not in a texture array", *_textureArray);
+    return *_textureArray;
+}
+#endif
+
+Image2D GlyphCache::image() {
+    if(_image) {
+        Containers::Array<char> data{_image->data().size()};
+        std::copy(_image->data().begin(), _image->data().end(), data.begin());
+        return Image2D{_image->storage(), _image->format(), _image->type(), _image->size(), std::move(data)};
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_textureArray) {
+        /* Download the whole array and extract the layer */
+        Image3D array{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte};
+        _textureArray->image(0, array);
+        const std::size_t layerSize = array.size().xy().product();
+        Containers::Array<char> data{layerSize};
+        std::copy_n(array.data() + _textureArrayLayer*layerSize, layerSize, data.begin());
+        return Image2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, array.size().xy(), std::move(data)};
+    }
+
+    Image2D image{PixelFormat::Red, PixelType::UnsignedByte};
+    _texture.image(0, image);
+    return image;
+    #else
+    CORRADE_ASSERT(false, "Text::GlyphCache::image(): texture download is not available in OpenGL ES", (Image2D{PixelFormat::Red, PixelType::UnsignedByte}));
+    #endif
+}
+
+Float GlyphCache::occupancy() const {
+    if(_dynamic) return Float(_dynamic->usedArea)/_size.product();
+    return _packer.occupancy();
+}
+
+GlyphCache& GlyphCache::setDynamic(const bool enabled) {
+    CORRADE_ASSERT(glyphs.size() == 1 && (_dynamic ? _dynamic->reserved.empty() : _packer.occupancy() == 0.0f),
+        "Text::GlyphCache::setDynamic(): the cache is not empty", *this);
+
+    if(enabled && !_dynamic) _dynamic.reset(new Dynamic);
+    else if(!enabled) _dynamic = nullptr;
+    return *this;
+}
+
+std::size_t GlyphCache::evictedGlyphCount() const {
+    return _dynamic ? _dynamic->evictedCount : 0;
+}
+
+void GlyphCache::touch(const UnsignedInt glyph) {
+    if(!_dynamic) return;
+
+    auto found = _dynamic->glyphs.find(glyph);
+    if(found == _dynamic->glyphs.end()) return;
+
+    found->second.fill = _dynamic->fill;
+    _dynamic->lru.splice(_dynamic->lru.begin(), _dynamic->lru, found->second.lru);
+}
+
+void GlyphCache::beginFill() {
+    if(_dynamic) ++_dynamic->fill;
+}
+
+void GlyphCache::evict(const UnsignedInt glyph) {
+    auto found = _dynamic->glyphs.find(glyph);
+    const Range2Di region = found->second.region;
+    _dynamic->lru.erase(found->second.lru);
+    _dynamic->glyphs.erase(found);
+    glyphs.erase(glyph);
+
+    _dynamic->free(region);
+    _dynamic->usedArea -= (region.size() - 2*_padding).product();
+    ++_dynamic->evictedCount;
+}
+
 std::vector<Range2Di> GlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
-        "Text::GlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
     glyphs.reserve(glyphs.size() + sizes.size());
-    return TextureTools::atlas(_size, sizes, _padding);
+    if(!_dynamic) return _packer.add(sizes);
+
+    /* Place larger glyphs first so shelves are created for them */
+    std::vector<std::size_t> order(sizes.size());
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) { return sizes[a].y() > sizes[b].y(); });
+
+    std::vector<Range2Di> out(sizes.size());
+    std::vector<Range2Di> regions;
+    for(const std::size_t i: order) {
+        const Vector2i size = sizes[i] + 2*_padding;
+
+        /* Evict least recently used glyphs until the new one fits, but never
+           the ones used in current fill */
+        std::optional<Range2Di> region;
+        while(!(region = _dynamic->allocate(size, _size.x(), _size.y()))) {
+            if(_dynamic->lru.empty() || _dynamic->glyphs.at(_dynamic->lru.back()).fill == _dynamic->fill)
+                break;
+            evict(_dynamic->lru.back());
+        }
+
+        /* Not enough space even after evicting everything, free what was
+           allocated so far */
+        if(!region) {
+            for(const Range2Di& r: regions) _dynamic->free(r);
+            return {};
+        }
+
+        regions.push_back(*region);
+        out[i] = region->padded(-_padding);
+    }
+
+    for(const Range2Di& region: regions) {
+        _dynamic->usedArea += (region.size() - 2*_padding).product();
+        _dynamic->reserved.push_back(region);
+        _dynamic->dirty.push_back(region);
+    }
+
+    return out;
 }
 
 void GlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
@@ -90,11 +337,79 @@ void GlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const
 
     /* Inserting new glyph */
     else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+
+    /* Take ownership of the reserved region, if any, so the glyph can be
+       evicted later */
+    if(_dynamic && glyph != 0) {
+        auto found = std::find(_dynamic->reserved.begin(), _dynamic->reserved.end(), glyphData.second);
+        if(found == _dynamic->reserved.end()) return;
+
+        _dynamic->lru.push_front(glyph);
+        _dynamic->glyphs.insert({glyph, {*found, _dynamic->fill, _dynamic->lru.begin()}});
+        _dynamic->reserved.erase(found);
+    }
 }
 
 void GlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
     /** @todo some internalformat/format checking also here (if querying internal format is not slow) */
-    _texture.setSubImage(0, offset, image);
+    if(!_dynamic) {
+        upload(offset, image);
+        return;
+    }
+
+    /* Upload only newly reserved regions covered by the image, so existing
+       glyphs aren't overwritten */
+    const Range2Di imageRegion = Range2Di::fromSize(offset, image.size());
+    const std::size_t pixelSize = image.pixelSize();
+    const auto properties = image.dataProperties();
+    const std::size_t rowStride = std::get<1>(properties).x();
+    const char* const imageData = image.data() + std::get<0>(properties).sum();
+    std::vector<char> data;
+    for(auto it = _dynamic->dirty.begin(); it != _dynamic->dirty.end(); ) {
+        const Range2Di region{Math::max(it->min(), imageRegion.min()), Math::min(it->max(), imageRegion.max())};
+        if(region.sizeX() <= 0 || region.sizeY() <= 0) {
+            ++it;
+            continue;
+        }
+
+        /* Copy the rows out of the image to a tightly packed one */
+        const std::size_t regionRowSize = region.sizeX()*pixelSize;
+        data.resize(regionRowSize*region.sizeY());
+        for(Int y = 0; y != region.sizeY(); ++y)
+            std::memcpy(data.data() + y*regionRowSize, imageData + (region.bottom() - offset.y() + y)*rowStride + (region.left() - offset.x())*pixelSize, regionRowSize);
+
+        upload(region.min(), ImageView2D{PixelStorage{}.setAlignment(1), image.format(), image.type(), region.size(), {data.data(), data.size()}});
+
+        /* Regions only partially covered by the image stay dirty */
+        if(region == *it) it = _dynamic->dirty.erase(it);
+        else ++it;
+    }
+}
+
+void GlyphCache::upload(const Vector2i& offset, const ImageView2D& image) {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_textureArray) {
+        _textureArray->setSubImage(0, {offset, _textureArrayLayer}, ImageView3D{image.storage(), image.format(), image.type(), {image.size(), 1}, image.data()});
+        return;
+    }
+    #endif
+
+    if(!_image) {
+        _texture.setSubImage(0, offset, image);
+        return;
+    }
+
+    CORRADE_ASSERT(image.format() == PixelFormat::Red && image.type() == PixelType::UnsignedByte,
+        "Text::GlyphCache::setImage(): expected" << PixelFormat::Red << "and" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), );
+    CORRADE_ASSERT((offset >= Vector2i{}).all() && (offset + image.size() <= _image->size()).all(),
+        "Text::GlyphCache::setImage(): image of size" << image.size() << "at" << offset << "out of bounds of cache of size" << _image->size(), );
+
+    /* Copy the rows to the in-memory image, which is tightly packed */
+    const auto properties = image.dataProperties();
+    const std::size_t rowStride = std::get<1>(properties).x();
+    const char* const imageData = image.data() + std::get<0>(properties).sum();
+    for(Int y = 0; y != image.size().y(); ++y)
+        std::memcpy(_image->data() + (offset.y() + y)*_image->size().x() + offset.x(), imageData + y*rowStride, image.size().x());
 }
 
 }}
@@ -29,12 +29,18 @@
  * @brief Class @ref Magnum::Text::GlyphCache
  */
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
+#include "Magnum/Image.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#endif
 #include "Magnum/Text/visibility.h"
+#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
@@ -56,6 +62,64 @@ font->createGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 @endcode
 
 See @ref Renderer for information about text rendering.
+
+@anchor Text-GlyphCache-dynamic
+## Dynamic glyph cache
+
+If the set of characters isn't known upfront, such as for user-generated
+text in languages with large alphabets, the cache can be switched to dynamic
+mode using @ref setDynamic(). Then @ref AbstractFont::fillGlyphCache() adds
+only glyphs that aren't in the cache yet and @ref AbstractFont::layout()
+fills the missing glyphs on demand:
+@code
+Text::GlyphCache cache{Vector2i{1024}};
+cache.setDynamic(true);
+
+std::unique_ptr<Text::AbstractLayouter> layouter = font->layout(cache, 0.1f, message);
+@endcode
+
+Glyphs are placed on shelves of similar height and when there is no space
+left, the least recently used glyphs are evicted from the cache to make room
+for new ones. Glyphs used by the @ref AbstractFont::fillGlyphCache() or
+@ref AbstractFont::layout() call that's being processed are never evicted,
+but text that was laid out earlier might reference an evicted glyph, so it
+needs to be laid out again if @ref evictedGlyphCount() changed. Only the
+newly reserved regions of the texture are updated in @ref setImage().
+
+When rendering through @ref Renderer, which works with a const cache, call
+@ref AbstractFont::fillGlyphCache() with the rendered text before rendering
+it.
+
+@anchor Text-GlyphCache-cpu
+## Glyph cache without OpenGL context
+
+Cache constructed using @ref GlyphCache(NoCreateT, const Vector2i&, const Vector2i&, const Vector2i&)
+doesn't create any texture and keeps the glyph image in memory instead, so it
+can be filled and exported without any OpenGL context, for example in
+offline tools running on build servers. The image is then accessible through
+@ref image().
+
+@anchor Text-GlyphCache-array
+## Glyph cache in a texture array
+
+Cache constructed using @ref GlyphCache(Texture2DArray&, Int, const Vector2i&, const Vector2i&, const Vector2i&)
+uses one layer of an externally owned @ref Texture2DArray instead of a
+texture of its own. Caches of many fonts can then share a single texture
+binding, rendered with @ref Shaders::DistanceFieldVector::Flag::TextureArray
+and the layer from @ref textureArrayLayer():
+@code
+Texture2DArray glyphs;
+glyphs.setStorage(1, TextureFormat::R8, {512, 512, 2});
+
+Text::GlyphCache sansCache{glyphs, 0, Vector2i{512}};
+Text::GlyphCache serifCache{glyphs, 1, Vector2i{512}};
+sans->fillGlyphCache(sansCache, "abcdefghijklmnopqrstuvwxyz");
+serif->fillGlyphCache(serifCache, "abcdefghijklmnopqrstuvwxyz");
+@endcode
+
+Smaller caches (for example with multi-channel distance field glyphs, see
+@ref TextureTools::multiChannelDistanceField()) can be packed into a single
+array without any binding changes when switching fonts.
 @todo Some way for Font to negotiate or check internal texture format
 @todo Default glyph 0 with rect 0 0 0 0 will result in negative dimensions when
     nonzero padding is removed
@@ -99,6 +163,53 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          */
         explicit GlyphCache(const Vector2i& size, const Vector2i& padding = Vector2i());
 
+        /**
+         * @brief Construct cache without OpenGL texture
+         * @param originalSize      Unscaled glyph cache image size
+         * @param size              Actual glyph cache image size
+         * @param padding           Padding around every glyph
+         *
+         * The glyph image is stored in memory in @ref PixelFormat::Red and
+         * @ref PixelType::UnsignedByte instead of a texture, thus no OpenGL
+         * context is needed. The @ref texture() can't be used with such
+         * cache, use @ref image() instead. See
+         * @ref Text-GlyphCache-cpu "class documentation" for more
+         * information.
+         */
+        explicit GlyphCache(NoCreateT, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding = Vector2i());
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct cache in a texture array layer
+         * @param textureArray      Texture array with already allocated
+         *      storage
+         * @param layer             Texture array layer
+         * @param originalSize      Unscaled glyph cache texture size
+         * @param size              Actual glyph cache texture size
+         * @param padding           Padding around every glyph
+         *
+         * Instead of creating its own texture, the cache uses @p layer of
+         * @p textureArray, which is expected to have at least @p size. The
+         * texture array is not owned by the cache and has to be kept alive
+         * for the whole cache lifetime. The @ref texture() can't be used
+         * with such cache, use @ref textureArray() instead. See
+         * @ref Text-GlyphCache-array "class documentation" for more
+         * information.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        explicit GlyphCache(Texture2DArray& textureArray, Int layer, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding = Vector2i());
+
+        /**
+         * @brief Construct cache in a texture array layer
+         *
+         * Same as calling the above with @p originalSize and @p size the same.
+         */
+        explicit GlyphCache(Texture2DArray& textureArray, Int layer, const Vector2i& size, const Vector2i& padding = Vector2i());
+        #endif
+
         virtual ~GlyphCache();
 
         /**
@@ -111,11 +222,121 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
         /** @brief Glyph padding */
         Vector2i padding() const { return _padding; }
 
+        /**
+         * @brief Cache occupancy
+         *
+         * Ratio of space reserved with @ref reserve() (without padding) to
+         * the cache texture area, in range @f$ [ 0, 1 ] @f$.
+         */
+        Float occupancy() const;
+
         /** @brief Count of glyphs in the cache */
         std::size_t glyphCount() const { return glyphs.size(); }
 
-        /** @brief Cache texture */
-        Texture2D& texture() { return _texture; }
+        /**
+         * @brief Whether the cache is dynamic
+         *
+         * @see @ref setDynamic()
+         */
+        bool isDynamic() const { return !!_dynamic; }
+
+        /**
+         * @brief Enable or disable dynamic mode
+         * @return Reference to self (for method chaining)
+         *
+         * In dynamic mode, least recently used glyphs are evicted when there
+         * isn't enough space for new ones. Can be changed only if there are no
+         * glyphs except glyph `0` in the cache. See
+         * @ref Text-GlyphCache-dynamic "class documentation" for more
+         * information.
+         */
+        GlyphCache& setDynamic(bool enabled);
+
+        /**
+         * @brief Count of evicted glyphs
+         *
+         * Count of glyphs evicted from the cache since it was switched to
+         * dynamic mode. Always `0` if the cache is not dynamic.
+         */
+        std::size_t evictedGlyphCount() const;
+
+        /**
+         * @brief Whether given glyph is in the cache
+         *
+         * Glyph `0` is always in the cache.
+         */
+        bool contains(UnsignedInt glyph) const {
+            return glyphs.find(glyph) != glyphs.end();
+        }
+
+        /**
+         * @brief Mark glyph as used
+         *
+         * In dynamic mode marks the glyph as most recently used, so it's the
+         * last candidate for eviction, and protects it from being evicted by
+         * current fill of the cache, see @ref beginFill(). Does nothing if
+         * the cache is not dynamic or the glyph is not in the cache. Called by
+         * @ref AbstractFont::fillGlyphCache(), you don't need to call it
+         * explicitly.
+         */
+        void touch(UnsignedInt glyph);
+
+        /**
+         * @brief Begin filling the cache
+         *
+         * In dynamic mode, glyphs inserted or @ref touch() "touched" after
+         * this call are not evicted until this function is called again.
+         * Does nothing if the cache is not dynamic. Called by
+         * @ref AbstractFont::fillGlyphCache(), you don't need to call it
+         * explicitly.
+         */
+        void beginFill();
+
+        /**
+         * @brief Cache texture
+         *
+         * Expects that the cache was not created using
+         * @ref GlyphCache(NoCreateT, const Vector2i&, const Vector2i&, const Vector2i&).
+         */
+        Texture2D& texture();
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Cache texture array
+         *
+         * Expects that the cache was created using
+         * @ref GlyphCache(Texture2DArray&, Int, const Vector2i&, const Vector2i&, const Vector2i&).
+         * @see @ref textureArrayLayer()
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        Texture2DArray& textureArray();
+
+        /**
+         * @brief Cache texture array layer
+         *
+         * Layer of @ref textureArray() containing the glyphs, `0` if the
+         * cache is not in a texture array.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        Int textureArrayLayer() const { return _textureArrayLayer; }
+        #endif
+
+        /**
+         * @brief Cache image
+         *
+         * If the cache was created using @ref GlyphCache(NoCreateT, const Vector2i&, const Vector2i&, const Vector2i&),
+         * returns copy of the in-memory image, otherwise downloads image of
+         * @ref texture() or its layer of @ref textureArray() in
+         * @ref PixelFormat::Red and @ref PixelType::UnsignedByte.
+         * Downloading the texture is not available in OpenGL ES.
+         */
+        Image2D image();
 
         /**
          * @brief Parameters of given glyph
@@ -149,16 +370,22 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
         /**
          * @brief Layout glyphs with given sizes to the cache
          *
-         * Returns non-overlapping regions in cache texture to store glyphs.
-         * The reserved space is reused on next call to @ref reserve() if no
-         * glyph was stored there, use @ref insert() to store actual glyph on
-         * given position and @ref setImage() to upload glyph image.
+         * Returns non-overlapping regions in cache texture to store glyphs,
+         * use @ref insert() to store actual glyph on given position and
+         * @ref setImage() to upload glyph image. The glyphs are packed using
+         * @ref TextureTools::AtlasPacker into space not reserved by previous
+         * calls, so the cache can be filled incrementally. If there is not
+         * enough space left, empty vector is returned.
+         *
+         * In dynamic mode the glyphs are placed on shelves of similar height
+         * and if there is not enough space left, least recently used glyphs
+         * that weren't @ref touch() "touched" during current fill are evicted.
+         * Empty vector is returned only if the glyphs don't fit even after
+         * that.
          *
          * Glyph @p sizes are expected to be without padding.
          *
-         * @attention Cache size must be large enough to contain all rendered
-         *      glyphs.
-         * @see @ref padding()
+         * @see @ref padding(), @ref occupancy()
          */
         std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
 
@@ -183,17 +410,34 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          * @brief Set cache image
          *
          * Uploads image for one or more glyphs to given offset in cache
-         * texture.
+         * texture. In dynamic mode only the parts of the image overlapping
+         * with regions returned from @ref reserve() since last call are
+         * uploaded, so the image can cover the whole cache without
+         * overwriting existing glyphs. If the cache was created using
+         * @ref GlyphCache(NoCreateT, const Vector2i&, const Vector2i&, const Vector2i&),
+         * the image is expected to be in @ref PixelFormat::Red and
+         * @ref PixelType::UnsignedByte and is copied to the in-memory image.
          */
         virtual void setImage(const Vector2i& offset, const ImageView2D& image);
 
     private:
+        struct Dynamic;
+
         void MAGNUM_LOCAL initialize(TextureFormat internalFormat, const Vector2i& size);
+        void MAGNUM_LOCAL evict(UnsignedInt glyph);
+        void MAGNUM_LOCAL upload(const Vector2i& offset, const ImageView2D& image);
 
         Vector2i _size, _padding;
+        TextureTools::AtlasPacker _packer;
         Texture2D _texture;
+        #ifndef MAGNUM_TARGET_GLES2
+        Texture2DArray* _textureArray{};
+        Int _textureArrayLayer{};
+        #endif
+        std::optional<Image2D> _image;
 
         std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        std::unique_ptr<Dynamic> _dynamic;
 };
 
 }}
@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "LayoutCache.h"
+
+#include <algorithm>
+
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+/* FNV-1a over the text, combined with the rest of the key */
+std::size_t hashKey(const AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment, const Containers::ArrayView<const char> text) {
+    UnsignedLong hash = 14695981039346656037ull;
+    auto add = [&hash](const char* data, std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i) {
+            hash ^= UnsignedByte(data[i]);
+            hash *= 1099511628211ull;
+        }
+    };
+
+    const void* const pointers[]{&font, &cache};
+    add(reinterpret_cast<const char*>(pointers), sizeof(pointers));
+    add(reinterpret_cast<const char*>(&size), sizeof(Float));
+    add(reinterpret_cast<const char*>(&alignment), sizeof(Alignment));
+    add(text.data(), text.size());
+    return std::size_t(hash);
+}
+
+}
+
+LayoutCache::LayoutCache(const std::size_t capacity): _capacity{capacity} {}
+
+LayoutCache::~LayoutCache() = default;
+
+LayoutCache& LayoutCache::setCapacity(const std::size_t capacity) {
+    _capacity = capacity;
+    while(_entries.size() > _capacity) {
+        erase(std::prev(_entries.end()));
+        ++_evictedCount;
+    }
+    return *this;
+}
+
+Float LayoutCache::hitRate() const {
+    const std::size_t lookupCount = _hitCount + _missCount;
+    return lookupCount ? Float(_hitCount)/lookupCount : 0.0f;
+}
+
+LayoutCache& LayoutCache::resetStatistics() {
+    _hitCount = _missCount = _evictedCount = 0;
+    return *this;
+}
+
+LayoutCache& LayoutCache::clear() {
+    _lookup.clear();
+    _entries.clear();
+    return *this;
+}
+
+std::list<LayoutCache::Entry>::iterator LayoutCache::findInternal(const std::size_t hash, const AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment, const Containers::ArrayView<const char> text) {
+    const auto range = _lookup.equal_range(hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        const Entry& entry = *it->second;
+        if(entry.font == &font && entry.cache == &cache && entry.size == size && entry.alignment == alignment && entry.text.size() == text.size() && std::equal(text.begin(), text.end(), entry.text.begin()))
+            return it->second;
+    }
+
+    return _entries.end();
+}
+
+void LayoutCache::erase(const std::list<Entry>::iterator entry) {
+    const auto range = _lookup.equal_range(entry->hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(it->second != entry) continue;
+        _lookup.erase(it);
+        break;
+    }
+
+    _entries.erase(entry);
+}
+
+auto LayoutCache::find(const AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment, const Containers::ArrayView<const char> text) -> const Layout* {
+    const auto found = findInternal(hashKey(font, cache, size, alignment, text), font, cache, size, alignment, text);
+    if(found == _entries.end()) {
+        ++_missCount;
+        return nullptr;
+    }
+
+    /* Texture coordinates of the glyphs might not be valid anymore if the
+       glyph cache evicted anything since */
+    if(found->evictedGlyphCount != cache.evictedGlyphCount()) {
+        erase(found);
+        ++_evictedCount;
+        ++_missCount;
+        return nullptr;
+    }
+
+    /* Mark as most recently used */
+    _entries.splice(_entries.begin(), _entries, found);
+    ++_hitCount;
+    return &found->layout;
+}
+
+auto LayoutCache::insert(const AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment, const Containers::ArrayView<const char> text, Layout&& layout) -> const Layout& {
+    const std::size_t hash = hashKey(font, cache, size, alignment, text);
+
+    /* Replace existing entry, if any */
+    const auto found = findInternal(hash, font, cache, size, alignment, text);
+    if(found != _entries.end()) erase(found);
+
+    /* Evict least recently used entries to make room for the new one */
+    while(!_entries.empty() && _entries.size() >= _capacity) {
+        erase(std::prev(_entries.end()));
+        ++_evictedCount;
+    }
+
+    _entries.push_front({hash, &font, &cache, size, alignment, {text.data(), text.size()}, cache.evictedGlyphCount(), std::move(layout)});
+    _lookup.emplace(hash, _entries.begin());
+    return _entries.front().layout;
+}
+
+}}
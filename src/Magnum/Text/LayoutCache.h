@@ -0,0 +1,229 @@
+#ifndef Magnum_Text_LayoutCache_h
+#define Magnum_Text_LayoutCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::LayoutCache
+ */
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Text layout cache
+
+Remembers rendered glyph quads of recently rendered texts, so rendering the
+same text again, such as a label which is updated every frame but changes only
+rarely, doesn't need to lay out the text again. Entries are keyed by font,
+glyph cache, size, alignment and the text itself. When the cache is full, the
+least recently used entry is evicted.
+
+The cache is used by @ref Renderer and @ref BatchRenderer if set using
+@ref AbstractRenderer::setLayoutCache() or
+@ref AbstractBatchRenderer::setLayoutCache(). One cache can be shared by any
+number of renderers:
+@code
+Text::LayoutCache layoutCache{512};
+renderer.setLayoutCache(&layoutCache);
+batch.setLayoutCache(&layoutCache);
+
+// ...
+Debug() << "Layout cache hit rate:" << layoutCache.hitRate();
+@endcode
+
+Layouts rendered with a @ref GlyphCache::isDynamic() "dynamic glyph cache"
+are invalidated when the glyph cache evicts any glyph, as their texture
+coordinates may no longer be valid. The cache expects that the font is not
+reopened and the glyph cache is not refilled while the cached layouts are
+in use, call @ref clear() in that case.
+*/
+class MAGNUM_TEXT_EXPORT LayoutCache {
+    public:
+        /**
+         * @brief Cached layout
+         *
+         * @see @ref find(), @ref insert()
+         */
+        struct Layout {
+            /**
+             * @brief Vertex data
+             *
+             * Four vertices per glyph, each consisting of position and
+             * texture coordinates, in the same order as the vertices written
+             * by @ref Renderer.
+             */
+            std::vector<Vector2> vertices;
+
+            /** @brief Rectangle spanning the rendered text */
+            Range2D rectangle;
+
+            /** @brief Glyph count */
+            UnsignedInt glyphCount() const { return vertices.size()/8; }
+        };
+
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of cached layouts
+         */
+        explicit LayoutCache(std::size_t capacity = 256);
+
+        /** @brief Copying is not allowed */
+        LayoutCache(const LayoutCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        LayoutCache(LayoutCache&&) = delete;
+
+        ~LayoutCache();
+
+        /** @brief Copying is not allowed */
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        LayoutCache& operator=(LayoutCache&&) = delete;
+
+        /** @brief Max count of cached layouts */
+        std::size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Set max count of cached layouts
+         * @return Reference to self (for method chaining)
+         *
+         * If there is more layouts than @p capacity, least recently used
+         * ones are evicted.
+         */
+        LayoutCache& setCapacity(std::size_t capacity);
+
+        /** @brief Count of cached layouts */
+        std::size_t size() const { return _entries.size(); }
+
+        /**
+         * @brief Count of cache hits
+         *
+         * @see @ref find(), @ref hitRate(), @ref resetStatistics()
+         */
+        std::size_t hitCount() const { return _hitCount; }
+
+        /**
+         * @brief Count of cache misses
+         *
+         * @see @ref find(), @ref hitRate(), @ref resetStatistics()
+         */
+        std::size_t missCount() const { return _missCount; }
+
+        /**
+         * @brief Hit rate
+         *
+         * Ratio of hits to all lookups, in range @f$ [ 0, 1 ] @f$. Returns
+         * `0.0f` if there were no lookups yet. Useful for tuning the
+         * @ref capacity().
+         */
+        Float hitRate() const;
+
+        /**
+         * @brief Count of evicted layouts
+         *
+         * Count of layouts evicted because the cache was full or because the
+         * glyph cache evicted some glyphs.
+         * @see @ref resetStatistics()
+         */
+        std::size_t evictedCount() const { return _evictedCount; }
+
+        /**
+         * @brief Reset hit, miss and eviction statistics
+         * @return Reference to self (for method chaining)
+         */
+        LayoutCache& resetStatistics();
+
+        /**
+         * @brief Remove all cached layouts
+         * @return Reference to self (for method chaining)
+         *
+         * Doesn't reset the statistics.
+         */
+        LayoutCache& clear();
+
+        /**
+         * @brief Find cached layout
+         *
+         * If the layout is found, marks it as most recently used, counts a
+         * hit and returns pointer to it, otherwise counts a miss and returns
+         * `nullptr`. The pointer is valid until next call to @ref insert(),
+         * @ref setCapacity() or @ref clear(). The lookup doesn't allocate
+         * any memory. Called by the renderers, you don't need to call it
+         * explicitly.
+         */
+        const Layout* find(const AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment, Containers::ArrayView<const char> text);
+
+        /**
+         * @brief Insert layout to the cache
+         *
+         * Evicts the least recently used layout if the cache is full and
+         * inserts @p layout as the most recently used one. If there already
+         * is a layout for given key, it's replaced. If @ref capacity() is
+         * zero, the layout is still inserted so the returned reference is
+         * valid, but it's evicted on next insertion. Called by the renderers,
+         * you don't need to call it explicitly.
+         */
+        const Layout& insert(const AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment, Containers::ArrayView<const char> text, Layout&& layout);
+
+    private:
+        struct Entry {
+            std::size_t hash;
+            const AbstractFont* font;
+            const GlyphCache* cache;
+            Float size;
+            Alignment alignment;
+            std::string text;
+            /* Glyph cache eviction count at the time of insertion */
+            std::size_t evictedGlyphCount;
+            Layout layout;
+        };
+
+        std::list<Entry>::iterator MAGNUM_TEXT_LOCAL findInternal(std::size_t hash, const AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment, Containers::ArrayView<const char> text);
+        void MAGNUM_TEXT_LOCAL erase(std::list<Entry>::iterator entry);
+
+        std::size_t _capacity;
+        std::size_t _hitCount{}, _missCount{}, _evictedCount{};
+
+        /* Most recently used entry is at the front, entries are looked up by
+           hash of the key */
+        std::list<Entry> _entries;
+        std::unordered_multimap<std::size_t, std::list<Entry>::iterator> _lookup;
+};
+
+}}
+
+#endif
@@ -25,15 +25,39 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTextureFormat.h"
+#endif
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Tracing.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/LayoutCache.h"
 
 namespace Magnum { namespace Text {
 
+namespace Implementation {
+
+struct QuadIndexBuffer {
+    explicit QuadIndexBuffer(Mesh::IndexType type): buffer{Buffer::TargetHint::ElementArray}, type{type}, glyphCount{0} {}
+
+    Buffer buffer;
+    Mesh::IndexType type;
+    UnsignedInt glyphCount;
+};
+
+}
+
 namespace {
 
 template<class T> void createIndices(void* output, const UnsignedInt glyphCount) {
@@ -60,98 +84,87 @@ struct Vertex {
     Vector2 position, textureCoordinates;
 };
 
-std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
-    /* Output data, reserve memory as when the text would be ASCII-only. In
-       reality the actual vertex count will be smaller, but allocating more at
-       once is better than reallocating many times later. */
-    std::vector<Vertex> vertices;
-    vertices.reserve(text.size()*4);
-
-    /* Total rendered bounds, intial line position, line increment, last+1
-       vertex on previous line */
+/* Renders the text into given vertex output and returns count of glyphs and
+   bounds. If the output is not large enough, only the glyphs that fit are
+   written, but all of them are counted. */
+std::pair<UnsignedInt, Range2D> renderVerticesInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, const Alignment alignment, std::unique_ptr<AbstractLayouter>& layouter, const Containers::ArrayView<Vertex> vertices) {
+    /* Total rendered bounds, intial line position, line increment, output
+       glyph count, first glyph on current line */
     Range2D rectangle;
     Vector2 linePosition;
     const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
-    std::size_t lastLineLastVertex = 0;
-
-    /* Temp buffer so we don't allocate for each new line */
-    /**
-     * @todo C++1z: use std::string_view to avoid the one allocation and all
-     *      the copying altogether
-     */
-    std::string line;
-    line.reserve(text.size());
+    const UnsignedInt capacity = vertices.size()/4;
+    UnsignedInt glyphCount = 0;
+    UnsignedInt lineFirstGlyph = 0;
 
     /* Render each line separately and align it horizontally */
-    std::size_t pos, prevPos = 0;
-    do {
-        /* Empty line, nothing to do (the rest is done below in while expression) */
-        if((pos = text.find('\n', prevPos)) == prevPos) continue;
-
-        /* Copy the line into the temp buffer */
-        line.assign(text, prevPos, pos-prevPos);
-
-        /* Layout the line */
-        const auto layouter = font.layout(cache, size, line);
-
-        /* Verify that we don't reallocate anything. The only problem might
-           arise when the layouter decides to compose one character from more
-           than one glyph (i.e. accents). Will remove the assert when this
-           issue arises. */
-        CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
-
-        /* Bounds of rendered line */
-        Range2D lineRectangle;
-
-        /* Render all glyphs */
-        Vector2 cursorPosition(linePosition);
-        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
-            Range2D quadPosition, textureCoordinates;
-            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
-
-            /* 0---2
-               |   |
-               |   |
-               |   |
-               1---3 */
-
-            vertices.insert(vertices.end(), {
-                {quadPosition.topLeft(), textureCoordinates.topLeft()},
-                {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
-                {quadPosition.topRight(), textureCoordinates.topRight()},
-                {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
-            });
+    std::size_t prevPos = 0;
+    for(;;) {
+        const char* const lineEnd = std::find(text.begin() + prevPos, text.end(), '\n');
+        const std::size_t pos = lineEnd - text.begin();
+
+        /* Empty line, nothing to do except moving to next line */
+        if(pos != prevPos) {
+            /* Layout the line, reusing the layouter */
+            font.layoutInto(cache, size, text.slice(prevPos, pos), layouter);
+
+            /* Bounds of rendered line */
+            Range2D lineRectangle;
+
+            /* Render all glyphs */
+            Vector2 cursorPosition(linePosition);
+            for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i, ++glyphCount) {
+                Range2D quadPosition, textureCoordinates;
+                std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
+
+                /* Not enough space, count the glyphs but don't write them */
+                if(glyphCount >= capacity) continue;
+
+                /* 0---2
+                   |   |
+                   |   |
+                   |   |
+                   1---3 */
+
+                Vertex* const quad = vertices.data() + glyphCount*4;
+                quad[0] = {quadPosition.topLeft(), textureCoordinates.topLeft()};
+                quad[1] = {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()};
+                quad[2] = {quadPosition.topRight(), textureCoordinates.topRight()};
+                quad[3] = {quadPosition.bottomRight(), textureCoordinates.bottomRight()};
+            }
+
+            /** @todo What about top-down text? */
+
+            /* Horizontally align the rendered line */
+            Float alignmentOffsetX = 0.0f;
+            if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+                alignmentOffsetX = -lineRectangle.centerX();
+            else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+                alignmentOffsetX = -lineRectangle.right();
+
+            /* Integer alignment */
+            if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+                alignmentOffsetX = Math::round(alignmentOffsetX);
+
+            /* Align positions and bounds on current line */
+            lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+            for(UnsignedInt i = lineFirstGlyph*4, end = Math::min(glyphCount, capacity)*4; i < end; ++i)
+                vertices[i].position.x() += alignmentOffsetX;
+
+            /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
         }
 
-        /** @todo What about top-down text? */
-
-        /* Horizontally align the rendered line */
-        Float alignmentOffsetX = 0.0f;
-        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
-            alignmentOffsetX = -lineRectangle.centerX();
-        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
-            alignmentOffsetX = -lineRectangle.right();
+        if(pos == text.size()) break;
 
-        /* Integer alignment */
-        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-            alignmentOffsetX = Math::round(alignmentOffsetX);
-
-        /* Align positions and bounds on current line */
-        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
-        for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
-            it->position.x() += alignmentOffsetX;
-
-        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
-        if(!rectangle.size().isZero()) {
-            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
-            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
-        } else rectangle = lineRectangle;
-
-    /* Move to next line */
-    } while(prevPos = pos+1,
-            linePosition -= lineAdvance,
-            lastLineLastVertex = vertices.size(),
-            pos != std::string::npos);
+        /* Move to next line */
+        prevPos = pos + 1;
+        linePosition -= lineAdvance;
+        lineFirstGlyph = glyphCount;
+    }
 
     /* Vertically align the rendered text */
     Float alignmentOffsetY = 0.0f;
@@ -166,9 +179,61 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
 
     /* Align positions and bounds */
     rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
-    for(auto& v: vertices) v.position.y() += alignmentOffsetY;
+    for(UnsignedInt i = 0, end = Math::min(glyphCount, capacity)*4; i != end; ++i)
+        vertices[i].position.y() += alignmentOffsetY;
+
+    return {glyphCount, rectangle};
+}
+
+static_assert(sizeof(Vertex) == 2*sizeof(Vector2), "Vertex layout doesn't match LayoutCache::Layout::vertices");
 
-    return std::make_tuple(std::move(vertices), rectangle);
+/* Same as renderVerticesInto(), but takes the vertices from given layout
+   cache, if any. On a miss the text is rendered into the new cache entry
+   first and then copied to the output, as the output might be a write-only
+   mapped buffer. Only layouts that fit into the output are cached. */
+std::pair<UnsignedInt, Range2D> renderVerticesCached(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, const Alignment alignment, std::unique_ptr<AbstractLayouter>& layouter, LayoutCache* const layoutCache, const Containers::ArrayView<Vertex> vertices) {
+    if(!layoutCache) return renderVerticesInto(font, cache, size, text, alignment, layouter, vertices);
+
+    if(const LayoutCache::Layout* const layout = layoutCache->find(font, cache, size, alignment, text)) {
+        const UnsignedInt glyphCount = layout->glyphCount();
+        const Vertex* const cached = reinterpret_cast<const Vertex*>(layout->vertices.data());
+        std::copy(cached, cached + Math::min(std::size_t(glyphCount)*4, vertices.size()), vertices.begin());
+        return {glyphCount, layout->rectangle};
+    }
+
+    LayoutCache::Layout layout;
+    layout.vertices.resize(vertices.size()*2);
+    const Containers::ArrayView<Vertex> rendered{reinterpret_cast<Vertex*>(layout.vertices.data()), vertices.size()};
+    const std::pair<UnsignedInt, Range2D> out = renderVerticesInto(font, cache, size, text, alignment, layouter, rendered);
+    std::copy(rendered.begin(), rendered.begin() + Math::min(std::size_t(out.first)*4, vertices.size()), vertices.begin());
+
+    if(std::size_t(out.first)*4 <= vertices.size()) {
+        layout.vertices.resize(out.first*8);
+        layout.vertices.shrink_to_fit();
+        layout.rectangle = out.second;
+        layoutCache->insert(font, cache, size, alignment, text, std::move(layout));
+    }
+
+    return out;
+}
+
+std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+    /* Output data, reserve memory as when the text would be ASCII-only. In
+       reality the actual vertex count will be smaller, but allocating more at
+       once is better than reallocating many times later. The only problem
+       might arise when the layouter decides to compose one character from
+       more than one glyph (i.e. accents), in that case the text is rendered
+       again into larger output. */
+    std::vector<Vertex> vertices(text.size()*4);
+    std::unique_ptr<AbstractLayouter> layouter;
+    std::pair<UnsignedInt, Range2D> out = renderVerticesInto(font, cache, size, {text.data(), text.size()}, alignment, layouter, {vertices.data(), vertices.size()});
+    if(out.first*4 > vertices.size()) {
+        vertices.resize(out.first*4);
+        out = renderVerticesInto(font, cache, size, {text.data(), text.size()}, alignment, layouter, {vertices.data(), vertices.size()});
+    }
+
+    vertices.resize(out.first*4);
+    return std::make_tuple(std::move(vertices), out.second);
 }
 
 std::pair<Containers::Array<char>, Mesh::IndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
@@ -194,6 +259,46 @@ std::pair<Containers::Array<char>, Mesh::IndexType> renderIndicesInternal(const
     return {std::move(indices), indexType};
 }
 
+/* Quad index buffers shared by all renderers in given context. The index type
+   of each buffer is fixed, so meshes referencing it stay valid when the
+   buffer is enlarged -- the new contents have the old contents as prefix. The
+   buffers are kept alive by the renderers using them and destroyed together
+   with the last one. */
+std::shared_ptr<Implementation::QuadIndexBuffer> sharedQuadIndices(const UnsignedInt glyphCount, const BufferUsage usage) {
+    static std::unordered_map<const Context*, std::array<std::weak_ptr<Implementation::QuadIndexBuffer>, 2>> buffers;
+
+    /* 16-bit indices for up to 65536 vertices, 32-bit for more */
+    constexpr UnsignedInt maxShortGlyphCount = 65536/4;
+    const bool large = glyphCount > maxShortGlyphCount;
+    std::weak_ptr<Implementation::QuadIndexBuffer>& weak = buffers[&Context::current()][large];
+    std::shared_ptr<Implementation::QuadIndexBuffer> indices = weak.lock();
+    if(!indices) {
+        indices = std::make_shared<Implementation::QuadIndexBuffer>(large ? Mesh::IndexType::UnsignedInt : Mesh::IndexType::UnsignedShort);
+        weak = indices;
+    }
+
+    /* Enlarge the buffer geometrically so repeated reserves don't upload the
+       indices again */
+    if(indices->glyphCount < glyphCount) {
+        UnsignedInt newGlyphCount = Math::max(glyphCount, indices->glyphCount*2);
+        if(!large) newGlyphCount = Math::min(newGlyphCount, maxShortGlyphCount);
+
+        if(large) {
+            Containers::Array<UnsignedInt> data(newGlyphCount*6);
+            createIndices<UnsignedInt>(data, newGlyphCount);
+            indices->buffer.setData(data, usage);
+        } else {
+            Containers::Array<UnsignedShort> data(newGlyphCount*6);
+            createIndices<UnsignedShort>(data, newGlyphCount);
+            indices->buffer.setData(data, usage);
+        }
+
+        indices->glyphCount = newGlyphCount;
+    }
+
+    return indices;
+}
+
 std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
     /* Render vertices and upload them */
     std::vector<Vertex> vertices;
@@ -284,8 +389,9 @@ void* AbstractRenderer::bufferMapImplementationRange(Buffer& buffer, GLsizeiptr
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     return buffer.map(0, length, Buffer::MapFlag::InvalidateBuffer|Buffer::MapFlag::Write);
     #else
+    static_cast<void>(buffer);
     static_cast<void>(length);
-    return &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData;
+    return _vertexBufferData;
     #endif
 }
 
@@ -298,11 +404,11 @@ void AbstractRenderer::bufferUnmapImplementationDefault(Buffer& buffer)
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     buffer.unmap();
     #else
-    buffer.setSubData(0, &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData);
+    buffer.setSubData(0, _vertexBufferData);
     #endif
 }
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indices{sharedQuadIndices(0, BufferUsage::StaticDraw)}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -349,56 +455,613 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const BufferUsage vert
     #ifdef CORRADE_TARGET_EMSCRIPTEN
     _vertexBufferData = Containers::Array<UnsignedByte>(vertexCount*sizeof(Vertex));
     #endif
-    _mesh.setCount(0);
-
-    /* Render indices */
-    Containers::Array<char> indexData;
-    Mesh::IndexType indexType;
-    std::tie(indexData, indexType) = renderIndicesInternal(glyphCount);
 
-    /* Allocate index buffer, reset index count and reconfigure buffer binding */
-    _indexBuffer.setData({nullptr, indexData.size()}, indexBufferUsage);
-    #ifdef CORRADE_TARGET_EMSCRIPTEN
-    _indexBufferData = Containers::Array<UnsignedByte>(indexData.size());
-    #endif
+    /* Get shared index buffer large enough, reset index count and
+       reconfigure buffer binding */
+    _indices = sharedQuadIndices(glyphCount, indexBufferUsage);
     _mesh.setCount(0)
-        .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
+        .setIndexBuffer(_indices->buffer, 0, _indices->type, 0, vertexCount);
+}
+
+Buffer& AbstractRenderer::indexBuffer() { return _indices->buffer; }
+
+void AbstractRenderer::render(const Containers::ArrayView<const char> text) {
+    MAGNUM_TRACE_ZONE("Text::Renderer::render");
+
+    /* Render the vertices directly into mapped buffer, reusing the layouter
+       from previous call */
+    const UnsignedInt vertexCount = _capacity*4;
+    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
+        vertexCount*sizeof(Vertex))), vertexCount);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vertices || !vertexCount);
+    UnsignedInt glyphCount;
+    std::tie(glyphCount, _rectangle) = renderVerticesCached(font, cache, size, text, _alignment, _layouter, _layoutCache, vertices);
+    bufferUnmapImplementation(_vertexBuffer);
+
+    CORRADE_ASSERT(glyphCount <= _capacity,
+        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
-    /* Prefill index buffer */
-    char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, indexData.size()));
-    CORRADE_INTERNAL_ASSERT(indices);
-    /** @todo Emscripten: it can be done without this copying altogether */
-    std::copy(indexData.begin(), indexData.end(), indices);
-    bufferUnmapImplementation(_indexBuffer);
+    /* Update index count */
+    _mesh.setCount(glyphCount*6);
+}
+
+void AbstractRenderer::render(const char* const text) {
+    render(Containers::ArrayView<const char>{text, std::strlen(text)});
 }
 
 void AbstractRenderer::render(const std::string& text) {
-    /* Render vertex data */
-    std::vector<Vertex> vertexData;
-    _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    render(Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+AbstractBatchRenderer::AbstractBatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size): _vertexBuffer{Buffer::TargetHint::Array}, _indices{sharedQuadIndices(0, BufferUsage::StaticDraw)}, font(font), cache(cache), size(size), _capacity(0), _labelCount(0), _vertexBufferUsage{BufferUsage::DynamicDraw}, _indexBufferUsage{BufferUsage::StaticDraw} {
+    /* Vertex buffer configuration depends on dimension count, done in subclass */
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(0);
+}
+
+AbstractBatchRenderer::~AbstractBatchRenderer() {}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size): AbstractBatchRenderer(font, cache, size) {
+    /* Finalize mesh configuration */
+    _mesh.addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
+}
+
+void AbstractBatchRenderer::reserve(const UnsignedInt glyphCount, const BufferUsage vertexBufferUsage, const BufferUsage indexBufferUsage) {
+    #ifndef CORRADE_NO_ASSERT
+    UnsignedInt occupied = 0;
+    for(const Label& label: _labels)
+        if(label.used) occupied = Math::max(occupied, label.offset + label.capacity);
+    #endif
+    CORRADE_ASSERT(glyphCount >= occupied,
+        "Text::BatchRenderer::reserve(): capacity" << glyphCount << "too small to contain labels occupying" << occupied << "glyphs", );
+
+    _capacity = glyphCount;
+    _vertexBufferUsage = vertexBufferUsage;
+    _indexBufferUsage = indexBufferUsage;
 
-    const UnsignedInt glyphCount = vertexData.size()/4;
     const UnsignedInt vertexCount = glyphCount*4;
-    const UnsignedInt indexCount = glyphCount*6;
+
+    /* Resize the data, the new space is zero-initialized. Then apply the
+       transformation of all labels and upload everything */
+    _vertexData.resize(vertexCount*2);
+    _transformedVertexData = _vertexData;
+    for(const Label& label: _labels) {
+        if(!label.used) continue;
+        for(std::size_t i = label.offset*8, end = (label.offset + label.glyphCount)*8; i != end; i += 2)
+            _transformedVertexData[i] = label.transformation.transformPoint(_vertexData[i]);
+    }
+    _vertexBuffer.setData(_transformedVertexData, vertexBufferUsage);
+
+    /* Get shared index buffer large enough, reconfigure buffer binding */
+    _indices = sharedQuadIndices(glyphCount, indexBufferUsage);
+    _mesh.setIndexBuffer(_indices->buffer, 0, _indices->type, 0, vertexCount);
+}
+
+Buffer& AbstractBatchRenderer::indexBuffer() { return _indices->buffer; }
+
+UnsignedInt AbstractBatchRenderer::add(const UnsignedInt glyphCapacity, const Alignment alignment) {
+    /* Find first free space large enough for the label */
+    FrameVector<std::pair<UnsignedInt, UnsignedInt>> ranges;
+    ranges.reserve(_labelCount);
+    for(const Label& label: _labels)
+        if(label.used) ranges.emplace_back(label.offset, label.offset + label.capacity);
+    std::sort(ranges.begin(), ranges.end());
+    UnsignedInt offset = 0;
+    for(const std::pair<UnsignedInt, UnsignedInt>& range: ranges) {
+        if(range.first - offset >= glyphCapacity) break;
+        offset = range.second;
+    }
+
+    /* Enlarge the buffers if there is not enough space */
+    if(offset + glyphCapacity > _capacity)
+        reserve(Math::max(offset + glyphCapacity, _capacity*2), _vertexBufferUsage, _indexBufferUsage);
+
+    /* Reuse ID of some removed label, if possible. The space is already
+       zeroed, so nothing needs to be uploaded. */
+    const Label label{offset, glyphCapacity, 0, alignment, true, {}, {}};
+    UnsignedInt id = 0;
+    for(; id != _labels.size() && _labels[id].used; ++id);
+    if(id == _labels.size()) _labels.push_back(label);
+    else _labels[id] = label;
+
+    ++_labelCount;
+    updateCount();
+    return id;
+}
+
+void AbstractBatchRenderer::remove(const UnsignedInt label) {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::remove(): invalid label" << label, );
+
+    /* Make the glyphs degenerate so they don't get rendered */
+    Label& l = _labels[label];
+    std::fill(_vertexData.begin() + l.offset*8, _vertexData.begin() + (l.offset + l.capacity)*8, Vector2{});
+    l.glyphCount = 0;
+    upload(l);
+
+    l.used = false;
+    --_labelCount;
+    updateCount();
+}
+
+void AbstractBatchRenderer::render(const UnsignedInt label, const Containers::ArrayView<const char> text) {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::render(): invalid label" << label, );
+
+    /* Render the vertices into space reserved for the label */
+    Label& l = _labels[label];
+    const Containers::ArrayView<Vertex> vertices{reinterpret_cast<Vertex*>(_vertexData.data()) + l.offset*4, l.capacity*4};
+    UnsignedInt glyphCount;
+    std::tie(glyphCount, l.rectangle) = renderVerticesCached(font, cache, size, text, l.alignment, _layouter, _layoutCache, vertices);
+
+    CORRADE_ASSERT(glyphCount <= l.capacity,
+        "Text::BatchRenderer::render(): label capacity" << l.capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* Make the unused glyphs degenerate so they don't get rendered */
+    std::fill(vertices.begin() + glyphCount*4, vertices.end(), Vertex{});
+    l.glyphCount = glyphCount;
+    upload(l);
+}
+
+void AbstractBatchRenderer::render(const UnsignedInt label, const char* const text) {
+    render(label, Containers::ArrayView<const char>{text, std::strlen(text)});
+}
+
+void AbstractBatchRenderer::render(const UnsignedInt label, const std::string& text) {
+    render(label, Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+Range2D AbstractBatchRenderer::rectangle(const UnsignedInt label) const {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::rectangle(): invalid label" << label, {});
+    return _labels[label].rectangle;
+}
+
+Matrix3 AbstractBatchRenderer::transformation(const UnsignedInt label) const {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::transformation(): invalid label" << label, {});
+    return _labels[label].transformation;
+}
+
+void AbstractBatchRenderer::setTransformation(const UnsignedInt label, const Matrix3& transformation) {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::setTransformation(): invalid label" << label, );
+    Label& l = _labels[label];
+    l.transformation = transformation;
+    upload(l);
+}
+
+MeshView& AbstractBatchRenderer::labelView(const UnsignedInt label, MeshView& view) const {
+    CORRADE_ASSERT(label < _labels.size() && _labels[label].used,
+        "Text::BatchRenderer::labelView(): invalid label" << label, view);
+    const Label& l = _labels[label];
+    return view.setCount(l.glyphCount*6)
+        .setIndexRange(l.offset*6, l.offset*4, (l.offset + l.capacity)*4);
+}
+
+void AbstractBatchRenderer::upload(const Label& label) {
+    /* Transform the positions and upload the data. The scratch space keeps
+       its capacity, so it doesn't allocate once it's large enough. */
+    _transformedVertexData.assign(_vertexData.begin() + label.offset*8, _vertexData.begin() + (label.offset + label.capacity)*8);
+    for(std::size_t i = 0, end = label.glyphCount*8; i != end; i += 2)
+        _transformedVertexData[i] = label.transformation.transformPoint(_transformedVertexData[i]);
+    _vertexBuffer.setSubData(label.offset*4*sizeof(Vertex), _transformedVertexData);
+}
+
+void AbstractBatchRenderer::updateCount() {
+    /* Draw everything up to the end of last label */
+    UnsignedInt end = 0;
+    for(const Label& label: _labels)
+        if(label.used) end = Math::max(end, label.offset + label.capacity);
+    _mesh.setCount(end*6);
+}
+
+AbstractEditableRenderer::AbstractEditableRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indices{sharedQuadIndices(0, BufferUsage::StaticDraw)}, font(font), cache(cache), size(size), _alignment(alignment), _wrapWidth{0.0f}, _alignmentOffsetY{0.0f}, _capacity(0), _glyphCount(0), _vertexBufferUsage{BufferUsage::DynamicDraw}, _indexBufferUsage{BufferUsage::StaticDraw} {
+    /* Empty text has one empty line */
+    _lines.push_back({0, 0, 0, 0, {}});
+
+    /* Vertex buffer configuration depends on dimension count, done in subclass */
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(0);
+}
+
+AbstractEditableRenderer::~AbstractEditableRenderer() {}
+
+template<UnsignedInt dimensions> EditableRenderer<dimensions>::EditableRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): AbstractEditableRenderer(font, cache, size, alignment) {
+    /* Finalize mesh configuration */
+    _mesh.addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
+}
+
+void AbstractEditableRenderer::reserve(const UnsignedInt glyphCount, const BufferUsage vertexBufferUsage, const BufferUsage indexBufferUsage) {
+    CORRADE_ASSERT(glyphCount >= _glyphCount,
+        "Text::EditableRenderer::reserve(): capacity" << glyphCount << "too small to contain" << _glyphCount << "glyphs", );
+
+    _capacity = glyphCount;
+    _vertexBufferUsage = vertexBufferUsage;
+    _indexBufferUsage = indexBufferUsage;
+
+    const UnsignedInt vertexCount = glyphCount*4;
+
+    /* Allocate vertex buffer and upload the current text */
+    _vertexBuffer.setData({nullptr, vertexCount*sizeof(Vertex)}, vertexBufferUsage);
+    upload(0, _glyphCount);
+
+    /* Get shared index buffer large enough, reconfigure buffer binding */
+    _indices = sharedQuadIndices(glyphCount, indexBufferUsage);
+    _mesh.setIndexBuffer(_indices->buffer, 0, _indices->type, 0, vertexCount);
+}
+
+Buffer& AbstractEditableRenderer::indexBuffer() { return _indices->buffer; }
+
+AbstractEditableRenderer& AbstractEditableRenderer::setWrapWidth(const Float width) {
+    _wrapWidth = width;
+    relayout(0, _text.size(), _text.size());
+    return *this;
+}
+
+void AbstractEditableRenderer::setText(const Containers::ArrayView<const char> text) {
+    replace(0, _text.size(), text);
+}
+
+void AbstractEditableRenderer::setText(const char* const text) {
+    setText(Containers::ArrayView<const char>{text, std::strlen(text)});
+}
+
+void AbstractEditableRenderer::setText(const std::string& text) {
+    setText(Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+void AbstractEditableRenderer::replace(const std::size_t position, const std::size_t count, const Containers::ArrayView<const char> text) {
+    CORRADE_ASSERT(position + count <= _text.size(),
+        "Text::EditableRenderer::replace(): can't replace" << count << "bytes at position" << position << "in text of" << _text.size() << "bytes", );
+
+    MAGNUM_TRACE_ZONE("Text::EditableRenderer::replace");
+
+    /* The edit affects everything from the line containing its start to the
+       line containing its end, including lines wrapped from them */
+    std::size_t paragraphBegin = position;
+    while(paragraphBegin && _text[paragraphBegin - 1] != '\n') --paragraphBegin;
+    const std::size_t oldParagraphEnd = Math::min(_text.find('\n', position + count), _text.size());
+
+    _text.replace(position, count, text.data(), text.size());
+    relayout(paragraphBegin, oldParagraphEnd, oldParagraphEnd - count + text.size());
+}
+
+void AbstractEditableRenderer::replace(const std::size_t position, const std::size_t count, const std::string& text) {
+    replace(position, count, Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+void AbstractEditableRenderer::insert(const std::size_t position, const Containers::ArrayView<const char> text) {
+    replace(position, 0, text);
+}
+
+void AbstractEditableRenderer::insert(const std::size_t position, const std::string& text) {
+    replace(position, 0, Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+void AbstractEditableRenderer::append(const Containers::ArrayView<const char> text) {
+    replace(_text.size(), 0, text);
+}
+
+void AbstractEditableRenderer::append(const std::string& text) {
+    replace(_text.size(), 0, Containers::ArrayView<const char>{text.data(), text.size()});
+}
+
+void AbstractEditableRenderer::remove(const std::size_t position, const std::size_t count) {
+    replace(position, count, nullptr);
+}
+
+void AbstractEditableRenderer::relayout(const std::size_t paragraphBegin, const std::size_t oldParagraphEnd, const std::size_t newParagraphEnd) {
+    /* Find the lines laid out from the affected range. Each paragraph starts
+       a new line, so the first line begins exactly at the paragraph start. */
+    const std::size_t firstLine = std::lower_bound(_lines.begin(), _lines.end(), paragraphBegin,
+        [](const Line& line, std::size_t position) { return line.begin < position; }) - _lines.begin();
+    const std::size_t endLine = std::upper_bound(_lines.begin() + firstLine, _lines.end(), oldParagraphEnd,
+        [](std::size_t position, const Line& line) { return position < line.begin; }) - _lines.begin();
+    CORRADE_INTERNAL_ASSERT(firstLine < endLine && _lines[firstLine].begin == paragraphBegin);
+
+    /* Lay out the range again */
+    _layoutedLines.clear();
+    _layoutedVertexData.clear();
+    layoutParagraphs(paragraphBegin, newParagraphEnd);
+
+    /* Replace the old lines with the new ones and move the following lines */
+    const UnsignedInt glyphBegin = _lines[firstLine].glyphOffset;
+    const UnsignedInt oldGlyphEnd = endLine == _lines.size() ? _glyphCount : _lines[endLine].glyphOffset;
+    const UnsignedInt newGlyphEnd = glyphBegin + UnsignedInt(_layoutedVertexData.size()/8);
+    for(Line& line: _layoutedLines)
+        line.glyphOffset += glyphBegin;
+    for(std::size_t i = endLine; i != _lines.size(); ++i) {
+        _lines[i].begin = _lines[i].begin - oldParagraphEnd + newParagraphEnd;
+        _lines[i].end = _lines[i].end - oldParagraphEnd + newParagraphEnd;
+        _lines[i].glyphOffset = _lines[i].glyphOffset - oldGlyphEnd + newGlyphEnd;
+    }
+    const bool lineCountChanged = _layoutedLines.size() != endLine - firstLine;
+    _lines.erase(_lines.begin() + firstLine, _lines.begin() + endLine);
+    _lines.insert(_lines.begin() + firstLine, _layoutedLines.begin(), _layoutedLines.end());
+    _vertexData.erase(_vertexData.begin() + glyphBegin*8, _vertexData.begin() + oldGlyphEnd*8);
+    _vertexData.insert(_vertexData.begin() + glyphBegin*8, _layoutedVertexData.begin(), _layoutedVertexData.end());
+    _glyphCount = _glyphCount - oldGlyphEnd + newGlyphEnd;
+
+    const bool alignmentChanged = updateRectangle();
+
+    /* Enlarge the buffers if there is not enough space, which uploads
+       everything */
+    if(_glyphCount > _capacity)
+        reserve(Math::max(_glyphCount, _capacity*2), _vertexBufferUsage, _indexBufferUsage);
+
+    /* If vertical alignment changed, everything moved. If glyph count or line
+       count changed, the following lines moved. Otherwise upload only the
+       lines laid out again. */
+    else if(alignmentChanged)
+        upload(0, _glyphCount);
+    else if(lineCountChanged || newGlyphEnd != oldGlyphEnd)
+        upload(glyphBegin, _glyphCount);
+    else upload(glyphBegin, newGlyphEnd);
+
+    _mesh.setCount(_glyphCount*6);
+}
+
+void AbstractEditableRenderer::layoutParagraphs(const std::size_t begin, const std::size_t end) {
+    std::size_t paragraphBegin = begin;
+    for(;;) {
+        const std::size_t paragraphEnd = Math::min(_text.find('\n', paragraphBegin), end);
+
+        /* Split the paragraph into lines, breaking after spaces. The first
+           word is always put on the line, even if it doesn't fit. */
+        std::size_t lineBegin = paragraphBegin;
+        for(;;) {
+            std::size_t lineEnd = paragraphEnd;
+            std::size_t renderEnd = paragraphEnd;
+            if(_wrapWidth > 0.0f) {
+                Float lineWidth = 0.0f;
+                std::size_t previousWordEnd = lineBegin;
+                for(std::size_t position = lineBegin; position != paragraphEnd; ) {
+                    std::size_t wordEnd = position;
+                    while(wordEnd != paragraphEnd && _text[wordEnd] != ' ') ++wordEnd;
+                    std::size_t spaceEnd = wordEnd;
+                    while(spaceEnd != paragraphEnd && _text[spaceEnd] == ' ') ++spaceEnd;
+
+                    /* The word doesn't fit, break before it and don't render
+                       the trailing spaces so they don't affect alignment */
+                    const Float wordWidth = advance(position, wordEnd);
+                    if(position != lineBegin && lineWidth + wordWidth > _wrapWidth) {
+                        lineEnd = position;
+                        renderEnd = previousWordEnd;
+                        break;
+                    }
+
+                    lineWidth += wordWidth + advance(wordEnd, spaceEnd);
+                    previousWordEnd = wordEnd;
+                    position = spaceEnd;
+                }
+            }
+
+            layoutLine(lineBegin, lineEnd, renderEnd);
+            if(lineEnd == paragraphEnd) break;
+            lineBegin = lineEnd;
+        }
+
+        if(paragraphEnd == end) break;
+        paragraphBegin = paragraphEnd + 1;
+    }
+}
+
+void AbstractEditableRenderer::layoutLine(const std::size_t begin, const std::size_t end, const std::size_t renderEnd) {
+    Line line{begin, end, UnsignedInt(_layoutedVertexData.size()/8), 0, {}};
+
+    if(renderEnd != begin) {
+        /* Only the horizontal alignment is applied here, the line is moved to
+           its baseline and vertically aligned on upload */
+        const Alignment alignment = Alignment(UnsignedByte((UnsignedByte(_alignment) & ~Implementation::AlignmentVertical)|Implementation::AlignmentLine));
+        const Containers::ArrayView<const char> text{_text.data() + begin, renderEnd - begin};
+
+        /* Reserve space as when the text would be ASCII-only, render again
+           into larger space if the layouter composed some characters from
+           more glyphs */
+        const std::size_t offset = _layoutedVertexData.size();
+        _layoutedVertexData.resize(offset + text.size()*8);
+        std::pair<UnsignedInt, Range2D> out = renderVerticesInto(font, cache, size, text, alignment, _layouter,
+            {reinterpret_cast<Vertex*>(_layoutedVertexData.data() + offset), text.size()*4});
+        if(out.first > text.size()) {
+            _layoutedVertexData.resize(offset + out.first*8);
+            out = renderVerticesInto(font, cache, size, text, alignment, _layouter,
+                {reinterpret_cast<Vertex*>(_layoutedVertexData.data() + offset), out.first*4});
+        }
+        _layoutedVertexData.resize(offset + out.first*8);
+
+        std::tie(line.glyphCount, line.rectangle) = out;
+    }
+
+    _layoutedLines.push_back(line);
+}
+
+Float AbstractEditableRenderer::advance(const std::size_t begin, const std::size_t end) {
+    if(begin == end) return 0.0f;
+
+    font.layoutInto(cache, size, {_text.data() + begin, end - begin}, _layouter);
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    for(UnsignedInt i = 0; i != _layouter->glyphCount(); ++i)
+        _layouter->renderGlyph(i, cursorPosition, rectangle);
+    return cursorPosition.x();
+}
+
+bool AbstractEditableRenderer::updateRectangle() {
+    /* Add bounds of all lines placed on their baselines, similarly to
+       renderVerticesInto() */
+    const Float lineAdvance = font.lineHeight()*size/font.size();
+    Range2D rectangle;
+    Float linePosition = 0.0f;
+    for(const Line& line: _lines) {
+        if(line.glyphCount) {
+            const Range2D lineRectangle = line.rectangle.translated(Vector2::yAxis(linePosition));
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
+        }
+
+        linePosition -= lineAdvance;
+    }
+
+    /* Vertically align the text */
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(_alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(_alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(_alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
+
+    _rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+    const bool changed = alignmentOffsetY != _alignmentOffsetY;
+    _alignmentOffsetY = alignmentOffsetY;
+    return changed;
+}
+
+void AbstractEditableRenderer::upload(const UnsignedInt glyphBegin, const UnsignedInt glyphEnd) {
+    if(glyphBegin == glyphEnd) return;
+
+    /* Move the glyphs to baseline of their line and apply the vertical
+       alignment. The scratch space keeps its capacity, so it doesn't
+       allocate once it's large enough. */
+    _transformedVertexData.assign(_vertexData.begin() + glyphBegin*8, _vertexData.begin() + glyphEnd*8);
+    const Float lineAdvance = font.lineHeight()*size/font.size();
+    Float linePosition = _alignmentOffsetY;
+    for(const Line& line: _lines) {
+        if(line.glyphOffset >= glyphEnd) break;
+
+        const UnsignedInt begin = Math::max(line.glyphOffset, glyphBegin);
+        const UnsignedInt end = Math::min(line.glyphOffset + line.glyphCount, glyphEnd);
+        if(begin < end) for(std::size_t i = (begin - glyphBegin)*8, iEnd = (end - glyphBegin)*8; i != iEnd; i += 2)
+            _transformedVertexData[i].y() += linePosition;
+
+        linePosition -= lineAdvance;
+    }
+
+    _vertexBuffer.setSubData(glyphBegin*4*sizeof(Vertex), _transformedVertexData);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+bool InstancedRenderer::GlyphRectangle::operator==(const GlyphRectangle& other) const {
+    /* Exact comparison to be consistent with the hash */
+    return textureCoordinates.min()[0] == other.textureCoordinates.min()[0] &&
+           textureCoordinates.min()[1] == other.textureCoordinates.min()[1] &&
+           textureCoordinates.max()[0] == other.textureCoordinates.max()[0] &&
+           textureCoordinates.max()[1] == other.textureCoordinates.max()[1] &&
+           size[0] == other.size[0] && size[1] == other.size[1];
+}
+
+std::size_t InstancedRenderer::GlyphRectangleHash::operator()(const GlyphRectangle& rectangle) const {
+    const Float data[]{
+        rectangle.textureCoordinates.min()[0], rectangle.textureCoordinates.min()[1],
+        rectangle.textureCoordinates.max()[0], rectangle.textureCoordinates.max()[1],
+        rectangle.size[0], rectangle.size[1]};
+    std::size_t hash = 0;
+    for(const Float value: data) {
+        UnsignedInt bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash ^= std::hash<UnsignedInt>{}(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+InstancedRenderer::InstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): font(font), cache(cache), size(size), _alignment(alignment), _capacity(0), _glyphCount(0), _instanceBuffer{Buffer::TargetHint::Array} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::instanced_arrays);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_buffer_object);
+    #else
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_buffer);
+    #endif
+
+    /* The quad is expanded from gl_VertexID in the shader, so there are no
+       per-vertex attributes */
+    _mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .setInstanceCount(0)
+        .addVertexBufferInstanced(_instanceBuffer, 1, 0,
+            Shaders::AbstractVector2D::GlyphPosition{},
+            Shaders::AbstractVector2D::GlyphRectangleId{});
+}
+
+InstancedRenderer::~InstancedRenderer() {}
+
+void InstancedRenderer::reserve(const UnsignedInt glyphCount, const BufferUsage usage) {
+    _capacity = glyphCount;
+    _glyphCount = 0;
+
+    _instanceBuffer.setData({nullptr, glyphCount*sizeof(Instance)}, usage);
+    _vertexData.resize(glyphCount*8);
+    _instanceData.reserve(glyphCount);
+    _mesh.setInstanceCount(0);
+}
+
+void InstancedRenderer::render(const Containers::ArrayView<const char> text) {
+    MAGNUM_TRACE_ZONE("Text::InstancedRenderer::render");
+
+    /* Render the quads into scratch space, reusing the layouter from
+       previous call */
+    const Containers::ArrayView<Vertex> vertices{reinterpret_cast<Vertex*>(_vertexData.data()), _capacity*4};
+    UnsignedInt glyphCount;
+    std::tie(glyphCount, _rectangle) = renderVerticesCached(font, cache, size, text, _alignment, _layouter, _layoutCache, vertices);
 
     CORRADE_ASSERT(glyphCount <= _capacity,
-        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+        "Text::InstancedRenderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
-    /* Interleave the data into mapped buffer*/
-    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
-        vertexCount*sizeof(Vertex))), vertexCount);
-    CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
-    std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
-    bufferUnmapImplementation(_vertexBuffer);
+    /* Convert the quads to instances, looking up the glyph rectangles or
+       adding new ones. Vertex 1 is bottom left, vertex 2 top right. */
+    const std::size_t glyphRectangleCount = _glyphRectangleData.size();
+    _instanceData.clear();
+    for(UnsignedInt i = 0; i != glyphCount; ++i) {
+        const Vertex* const quad = vertices.data() + i*4;
+        const GlyphRectangle rectangle{
+            {quad[1].textureCoordinates, quad[2].textureCoordinates},
+            quad[2].position - quad[1].position};
+
+        const auto inserted = _glyphRectangleIds.emplace(rectangle, UnsignedInt(_glyphRectangleData.size()/2));
+        if(inserted.second) {
+            const Range2D& t = rectangle.textureCoordinates;
+            _glyphRectangleData.emplace_back(t.min().x(), t.min().y(), t.max().x(), t.max().y());
+            _glyphRectangleData.emplace_back(rectangle.size.x(), rectangle.size.y(), 0.0f, 0.0f);
+        }
 
-    /* Update index count */
-    _mesh.setCount(indexCount);
+        _instanceData.push_back({quad[1].position, inserted.first->second});
+    }
+
+    /* Upload the rectangle table if it changed and the instances */
+    if(_glyphRectangleData.size() != glyphRectangleCount) {
+        _glyphRectangleBuffer.setData(_glyphRectangleData, BufferUsage::DynamicDraw);
+        _glyphRectangleTexture.setBuffer(BufferTextureFormat::RGBA32F, _glyphRectangleBuffer);
+    }
+    _instanceBuffer.setSubData(0, _instanceData);
+
+    _glyphCount = glyphCount;
+    _mesh.setInstanceCount(glyphCount);
+}
+
+void InstancedRenderer::render(const char* const text) {
+    render(Containers::ArrayView<const char>{text, std::strlen(text)});
 }
 
+void InstancedRenderer::render(const std::string& text) {
+    render(Containers::ArrayView<const char>{text.data(), text.size()});
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
+template class MAGNUM_TEXT_EXPORT EditableRenderer<2>;
+template class MAGNUM_TEXT_EXPORT EditableRenderer<3>;
 #endif
 
 }}
@@ -26,15 +26,22 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, @ref Magnum::Text::AbstractBatchRenderer, @ref Magnum::Text::BatchRenderer, @ref Magnum::Text::AbstractEditableRenderer, @ref Magnum::Text::EditableRenderer, @ref Magnum::Text::InstancedRenderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D, @ref Magnum::Text::EditableRenderer2D, @ref Magnum::Text::EditableRenderer3D
  */
 
+#include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector4.h"
 #include "Magnum/Buffer.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferTexture.h"
+#endif
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Text/Text.h"
@@ -43,6 +50,8 @@
 
 namespace Magnum { namespace Text {
 
+namespace Implementation { struct QuadIndexBuffer; }
+
 /**
 @brief Base for text renderers
 
@@ -77,8 +86,14 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         /** @brief Vertex buffer */
         Buffer& vertexBuffer() { return _vertexBuffer; }
 
-        /** @brief Index buffer */
-        Buffer& indexBuffer() { return _indexBuffer; }
+        /**
+         * @brief Index buffer
+         *
+         * The buffer is shared among all renderers in current OpenGL
+         * context and may contain more indices than needed for current
+         * capacity.
+         */
+        Buffer& indexBuffer();
 
         /** @brief Mesh */
         Mesh& mesh() { return _mesh; }
@@ -86,11 +101,14 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         /**
          * @brief Reserve capacity for rendered glyphs
          *
-         * Reallocates memory in buffers to hold @p glyphCount glyphs and
-         * prefills index buffer. Consider using appropriate @p vertexBufferUsage
-         * if the text will be changed frequently. Index buffer is changed
-         * only by calling this function, thus @p indexBufferUsage generally
-         * doesn't need to be so dynamic if the capacity won't be changed much.
+         * Reallocates memory in vertex buffer to hold @p glyphCount glyphs.
+         * Consider using appropriate @p vertexBufferUsage if the text will be
+         * changed frequently. The index buffer is shared among all renderers
+         * in current OpenGL context and it's enlarged with
+         * @p indexBufferUsage only if it isn't large enough for
+         * @p glyphCount glyphs already. It's changed only by calling this
+         * function, thus @p indexBufferUsage generally doesn't need to be so
+         * dynamic.
          *
          * Initially zero capacity is reserved.
          * @see @ref capacity()
@@ -105,11 +123,44 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * available through @ref rectangle().
          *
          * Initially no text is rendered.
+         * The vertices are written directly into mapped vertex buffer and the
+         * font layouter is reused between calls, so with fonts implementing
+         * @ref AbstractFont::doLayoutInto() the rendering doesn't allocate
+         * any memory.
          * @attention The capacity must be large enough to contain all glyphs,
          *      see @ref reserve() for more information.
          */
+        void render(Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void render(const char* text);
+
+        /** @overload */
         void render(const std::string& text);
 
+        /**
+         * @brief Layout cache
+         *
+         * @see @ref setLayoutCache()
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @ref render() takes the glyph quads from the cache if the
+         * same text was rendered with the same font, glyph cache, size and
+         * alignment recently, and puts them there otherwise. Set to
+         * `nullptr` to disable the caching. The cache is not owned by the
+         * renderer and has to stay in scope for the renderer lifetime. See
+         * @ref LayoutCache for more information. Default is `nullptr`.
+         */
+        AbstractRenderer& setLayoutCache(LayoutCache* cache) {
+            _layoutCache = cache;
+            return *this;
+        }
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -120,9 +171,10 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         ~AbstractRenderer();
 
         Mesh _mesh;
-        Buffer _vertexBuffer, _indexBuffer;
+        Buffer _vertexBuffer;
+        std::shared_ptr<Implementation::QuadIndexBuffer> _indices;
         #ifdef CORRADE_TARGET_EMSCRIPTEN
-        Containers::Array<UnsignedByte> _vertexBufferData, _indexBufferData;
+        Containers::Array<UnsignedByte> _vertexBufferData;
         #endif
 
     private:
@@ -132,6 +184,8 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         Alignment _alignment;
         UnsignedInt _capacity;
         Range2D _rectangle;
+        std::unique_ptr<AbstractLayouter> _layouter;
+        LayoutCache* _layoutCache{};
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
         typedef void*(*BufferMapImplementation)(Buffer&, GLsizeiptr);
@@ -226,6 +280,11 @@ shader.setTransformationProjectionMatrix(projection)
 renderer.mesh().draw(shader);
 @endcode
 
+Texts which change often, but mostly between a few distinct strings (e.g.
+status messages or UI labels updated each frame), can additionally use a
+@ref LayoutCache, which avoids laying out the same text again, see
+@ref setLayoutCache().
+
 ## Required OpenGL functionality
 
 Mutable text rendering requires @extension{ARB,map_buffer_range} on desktop
@@ -275,6 +334,716 @@ typedef Renderer<2> Renderer2D;
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
 
+/**
+@brief Base for batched text renderers
+
+Not meant to be used directly, see @ref BatchRenderer for more information.
+@see @ref BatchRenderer2D, @ref BatchRenderer3D
+*/
+class MAGNUM_TEXT_EXPORT AbstractBatchRenderer {
+    public:
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer(const AbstractBatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractBatchRenderer(AbstractBatchRenderer&&) = delete;
+
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer& operator=(const AbstractBatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractBatchRenderer& operator=(AbstractBatchRenderer&&) = delete;
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * Total glyph capacity of all labels, including free space.
+         * @see @ref reserve(), @ref add()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Count of labels in the batch */
+        UnsignedInt labelCount() const { return _labelCount; }
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /**
+         * @brief Index buffer
+         *
+         * Shared with other renderers, see @ref AbstractRenderer::indexBuffer()
+         * for more information.
+         */
+        Buffer& indexBuffer();
+
+        /**
+         * @brief Mesh
+         *
+         * Draws all labels in the batch with single draw call. Glyph slots
+         * which are not used by any label are rendered as degenerate
+         * triangles.
+         */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in vertex buffer to hold @p glyphCount glyphs and
+         * enlarges the shared index buffer, if needed. Labels which are
+         * already in the batch are
+         * preserved. The capacity can't be made smaller than the space
+         * occupied by existing labels. See @ref AbstractRenderer::reserve()
+         * for more information about the usage parameters.
+         *
+         * Initially zero capacity is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage vertexBufferUsage, BufferUsage indexBufferUsage);
+
+        /**
+         * @brief Add label
+         * @param glyphCapacity Maximal count of glyphs in the label
+         * @param alignment     Text alignment
+         * @return Label ID
+         *
+         * Allocates space for the label in the buffers, reusing space of
+         * removed labels if possible. If there is not enough space, the
+         * capacity is enlarged using buffer usage passed to last call to
+         * @ref reserve(). The label is initially empty with identity
+         * transformation. IDs of removed labels are reused.
+         * @see @ref render(), @ref remove()
+         */
+        UnsignedInt add(UnsignedInt glyphCapacity, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Remove label
+         *
+         * Frees the space for use by other labels. The ID is not valid
+         * anymore after this call.
+         */
+        void remove(UnsignedInt label);
+
+        /**
+         * @brief Render label text
+         *
+         * Renders the text into space allocated for given label, updating
+         * only corresponding part of the vertex buffer. Rectangle spanning
+         * the rendered text is available through @ref rectangle().
+         * @attention The label capacity must be large enough to contain all
+         *      glyphs, see @ref add() for more information.
+         */
+        void render(UnsignedInt label, Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void render(UnsignedInt label, const char* text);
+
+        /** @overload */
+        void render(UnsignedInt label, const std::string& text);
+
+        /**
+         * @brief Layout cache
+         *
+         * @see @ref setLayoutCache()
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @ref render() takes the glyph quads from the cache if
+         * possible. See @ref AbstractRenderer::setLayoutCache() for more
+         * information. Default is `nullptr`.
+         */
+        AbstractBatchRenderer& setLayoutCache(LayoutCache* cache) {
+            _layoutCache = cache;
+            return *this;
+        }
+
+        /**
+         * @brief Rectangle spanning the label text
+         *
+         * The rectangle doesn't include label transformation.
+         */
+        Range2D rectangle(UnsignedInt label) const;
+
+        /** @brief Label transformation */
+        Matrix3 transformation(UnsignedInt label) const;
+
+        /**
+         * @brief Set label transformation
+         *
+         * The transformation is applied to label vertex positions before
+         * uploading them to the vertex buffer, so it can differ for each
+         * label and the whole batch can be still drawn with single draw call.
+         * Default is identity transformation.
+         */
+        void setTransformation(UnsignedInt label, const Matrix3& transformation);
+
+        /**
+         * @brief Configure mesh view for drawing single label
+         * @param label     Label ID
+         * @param view      View on @ref mesh()
+         * @return Reference to @p view (for method chaining)
+         *
+         * Useful for drawing some labels with different shader setup (e.g.
+         * with different color) without duplicating buffers. The view is
+         * valid only until the capacity is changed.
+         */
+        MeshView& labelView(UnsignedInt label, MeshView& view) const;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        explicit MAGNUM_TEXT_LOCAL AbstractBatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size);
+
+        ~AbstractBatchRenderer();
+
+        Mesh _mesh;
+        Buffer _vertexBuffer;
+        std::shared_ptr<Implementation::QuadIndexBuffer> _indices;
+
+    private:
+        struct Label {
+            UnsignedInt offset, capacity, glyphCount;
+            Alignment alignment;
+            bool used;
+            Range2D rectangle;
+            Matrix3 transformation;
+        };
+
+        MAGNUM_TEXT_LOCAL void upload(const Label& label);
+        MAGNUM_TEXT_LOCAL void updateCount();
+
+        AbstractFont& font;
+        const GlyphCache& cache;
+        Float size;
+        UnsignedInt _capacity, _labelCount;
+        BufferUsage _vertexBufferUsage, _indexBufferUsage;
+        std::unique_ptr<AbstractLayouter> _layouter;
+        LayoutCache* _layoutCache{};
+        std::vector<Label> _labels;
+        /* Untransformed vertex data for whole capacity and scratch space for
+           transformed data of one label, position and texture coordinates
+           interleaved */
+        std::vector<Vector2> _vertexData, _transformedVertexData;
+};
+
+/**
+@brief Batched text renderer
+
+Packs many independently updatable labels into one vertex and index buffer
+pair, so they can be drawn with single draw call through any
+@ref Shaders::AbstractVector subclass. All labels share the same font, glyph
+cache and font size.
+
+## Usage
+
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache;
+Shaders::Vector2D shader;
+
+// Initialize the renderer and add some labels
+Text::BatchRenderer2D batch{*font, cache, 0.15f};
+batch.reserve(512, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+UnsignedInt fps = batch.add(16);
+UnsignedInt title = batch.add(32, Text::Alignment::LineCenter);
+
+// Render and place the labels
+batch.render(title, "Hello World!");
+batch.setTransformation(title, Matrix3::translation({0.0f, 0.8f}));
+batch.render(fps, "FPS: 60");
+
+// Draw all labels with single draw call
+shader.setTransformationProjectionMatrix(projection)
+    .setColor(Color3(1.0f))
+    .setVectorTexture(cache.texture());
+batch.mesh().draw(shader);
+@endcode
+
+Labels of different color can be drawn separately using @ref labelView()
+without duplicating the buffers.
+
+Unlike @ref Renderer, the labels are updated using @ref Buffer::setSubData(),
+so no buffer mapping functionality is required.
+@see @ref BatchRenderer2D, @ref BatchRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer: public AbstractBatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         */
+        explicit BatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size);
+        BatchRenderer(AbstractFont&, GlyphCache&&, Float) = delete; /**< @overload */
+};
+
+/** @brief Two-dimensional batched text renderer */
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/** @brief Three-dimensional batched text renderer */
+typedef BatchRenderer<3> BatchRenderer3D;
+
+/**
+@brief Base for editable text renderers
+
+Not meant to be used directly, see @ref EditableRenderer for more information.
+@see @ref EditableRenderer2D, @ref EditableRenderer3D
+*/
+class MAGNUM_TEXT_EXPORT AbstractEditableRenderer {
+    public:
+        /** @brief Copying is not allowed */
+        AbstractEditableRenderer(const AbstractEditableRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractEditableRenderer(AbstractEditableRenderer&&) = delete;
+
+        /** @brief Copying is not allowed */
+        AbstractEditableRenderer& operator=(const AbstractEditableRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractEditableRenderer& operator=(AbstractEditableRenderer&&) = delete;
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Count of rendered glyphs */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /**
+         * @brief Count of lines
+         *
+         * Includes lines created by word wrapping. Empty text has one line.
+         * @see @ref setWrapWidth()
+         */
+        UnsignedInt lineCount() const { return _lines.size(); }
+
+        /** @brief Text */
+        const std::string& text() const { return _text; }
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const { return _rectangle; }
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /**
+         * @brief Index buffer
+         *
+         * Shared with other renderers, see @ref AbstractRenderer::indexBuffer()
+         * for more information.
+         */
+        Buffer& indexBuffer();
+
+        /** @brief Mesh */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in vertex buffer to hold @p glyphCount glyphs
+         * and enlarges the shared index buffer, if needed. The text is
+         * preserved, the capacity can't be made smaller than its glyph
+         * count. See @ref AbstractRenderer::reserve() for more information
+         * about the usage parameters.
+         *
+         * Initially zero capacity is reserved. If an edit doesn't fit into
+         * the capacity, it's enlarged using buffer usage passed to last call
+         * to this function.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage vertexBufferUsage, BufferUsage indexBufferUsage);
+
+        /** @brief Wrap width */
+        Float wrapWidth() const { return _wrapWidth; }
+
+        /**
+         * @brief Set wrap width
+         * @return Reference to self (for method chaining)
+         *
+         * If nonzero, lines longer than @p width are wrapped after spaces.
+         * Words longer than @p width are not broken and overflow the width.
+         * Lays out the whole text again. Default is `0.0f`, i.e. no
+         * wrapping.
+         */
+        AbstractEditableRenderer& setWrapWidth(Float width);
+
+        /**
+         * @brief Set text
+         *
+         * Equivalent to calling @ref replace() on the whole text.
+         */
+        void setText(Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void setText(const char* text);
+
+        /** @overload */
+        void setText(const std::string& text);
+
+        /**
+         * @brief Replace part of the text
+         * @param position  Byte position in the text
+         * @param count     Count of bytes to replace
+         * @param text      New text
+         *
+         * Lays out again only lines affected by the change --- from the line
+         * containing @p position to the line containing end of the replaced
+         * range, including all lines wrapped from them --- and updates only
+         * corresponding part of the vertex buffer. If the edit changes glyph
+         * count or line count, vertices of all following lines are moved in
+         * the buffer, but not laid out again. If the edit changes vertical
+         * alignment offset, the whole buffer is updated.
+         * @see @ref insert(), @ref append(), @ref remove()
+         */
+        void replace(std::size_t position, std::size_t count, Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void replace(std::size_t position, std::size_t count, const std::string& text);
+
+        /**
+         * @brief Insert text
+         *
+         * Equivalent to calling @ref replace() with zero @p count.
+         */
+        void insert(std::size_t position, Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void insert(std::size_t position, const std::string& text);
+
+        /**
+         * @brief Append text
+         *
+         * Equivalent to calling @ref insert() at the end of the text. Only
+         * the last line is laid out again.
+         */
+        void append(Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void append(const std::string& text);
+
+        /**
+         * @brief Remove part of the text
+         *
+         * Equivalent to calling @ref replace() with empty text.
+         */
+        void remove(std::size_t position, std::size_t count);
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        explicit MAGNUM_TEXT_LOCAL AbstractEditableRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment);
+
+        ~AbstractEditableRenderer();
+
+        Mesh _mesh;
+        Buffer _vertexBuffer;
+        std::shared_ptr<Implementation::QuadIndexBuffer> _indices;
+
+    private:
+        struct Line {
+            /* Byte range in the text, excluding the newline */
+            std::size_t begin, end;
+            UnsignedInt glyphOffset, glyphCount;
+            /* Horizontally aligned, relative to line baseline */
+            Range2D rectangle;
+        };
+
+        MAGNUM_TEXT_LOCAL void relayout(std::size_t paragraphBegin, std::size_t oldParagraphEnd, std::size_t newParagraphEnd);
+        MAGNUM_TEXT_LOCAL void layoutParagraphs(std::size_t begin, std::size_t end);
+        MAGNUM_TEXT_LOCAL void layoutLine(std::size_t begin, std::size_t end, std::size_t renderEnd);
+        MAGNUM_TEXT_LOCAL Float advance(std::size_t begin, std::size_t end);
+        MAGNUM_TEXT_LOCAL bool updateRectangle();
+        MAGNUM_TEXT_LOCAL void upload(UnsignedInt glyphBegin, UnsignedInt glyphEnd);
+
+        AbstractFont& font;
+        const GlyphCache& cache;
+        Float size;
+        Alignment _alignment;
+        Float _wrapWidth, _alignmentOffsetY;
+        UnsignedInt _capacity, _glyphCount;
+        BufferUsage _vertexBufferUsage, _indexBufferUsage;
+        Range2D _rectangle;
+        std::unique_ptr<AbstractLayouter> _layouter;
+        std::string _text;
+        std::vector<Line> _lines, _layoutedLines;
+        /* Vertex data of all glyphs relative to baseline of their line,
+           scratch space for lines being laid out again and for data being
+           uploaded, position and texture coordinates interleaved */
+        std::vector<Vector2> _vertexData, _layoutedVertexData, _transformedVertexData;
+};
+
+/**
+@brief Editable text renderer
+
+Keeps the text together with layout of each line, so a change of the text
+lays out again only the lines it affects. Meant for text which is edited
+often, such as text fields or in-application consoles, where @ref Renderer
+would lay out and upload the whole text on every keystroke. Lines can be
+optionally wrapped to given width, see @ref setWrapWidth().
+
+## Usage
+
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache;
+Shaders::Vector2D shader;
+
+Text::EditableRenderer2D console{*font, cache, 0.15f, Text::Alignment::TopLeft};
+console.reserve(4096, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+console.setWrapWidth(1.8f);
+
+// Only the last line is laid out again
+console.append("> ls\n");
+
+// Only the edited line is laid out again
+console.insert(cursor, "x");
+
+shader.setTransformationProjectionMatrix(projection)
+    .setColor(Color3(1.0f))
+    .setVectorTexture(cache.texture());
+console.mesh().draw(shader);
+@endcode
+
+Similarly to @ref BatchRenderer, the vertex buffer is updated using
+@ref Buffer::setSubData(), so no buffer mapping functionality is required.
+@see @ref EditableRenderer2D, @ref EditableRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT EditableRenderer: public AbstractEditableRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit EditableRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        EditableRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Overloads to remove WTF-factor from method chaining order */
+        EditableRenderer<dimensions>& setWrapWidth(Float width) {
+            AbstractEditableRenderer::setWrapWidth(width);
+            return *this;
+        }
+        #endif
+};
+
+/** @brief Two-dimensional editable text renderer */
+typedef EditableRenderer<2> EditableRenderer2D;
+
+/** @brief Three-dimensional editable text renderer */
+typedef EditableRenderer<3> EditableRenderer3D;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Instanced text renderer
+
+Like @ref Renderer, but instead of four vertices and six indices per glyph it
+uploads just one instance record --- glyph quad position and ID of glyph
+rectangle --- taking 12 bytes instead of 76. The quads are expanded in the
+vertex shader from a table of distinct glyph rectangles, which is built as
+new glyphs are rendered and kept in a buffer texture. Meant for large
+amounts of frequently changing text, such as logs or consoles.
+
+## Usage
+
+The mesh is meant to be drawn with @ref Shaders::Vector or
+@ref Shaders::DistanceFieldVector created with the instanced glyphs flag,
+both in 2D and 3D:
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache;
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::InstancedGlyphs};
+
+Text::InstancedRenderer renderer{*font, cache, 0.15f};
+renderer.reserve(4096, BufferUsage::DynamicDraw);
+
+// Update the text occasionally
+renderer.render(logText);
+
+// Draw the text on the screen
+shader.setTransformationProjectionMatrix(projection)
+    .setColor(Color3(1.0f))
+    .setVectorTexture(cache.texture())
+    .setGlyphRectangleTexture(renderer.glyphRectangleTexture());
+renderer.mesh().draw(shader);
+@endcode
+
+Glyph rectangles are identified by their texture coordinates and quad size,
+thus the table stays small for any amount of text, as long as the font, glyph
+cache and size don't change. The rectangle table and the instance data are
+updated using @ref Buffer::setData() and @ref Buffer::setSubData(), no buffer
+mapping functionality is required.
+
+@see @ref Shaders-Vector-instanced-glyphs
+@requires_gl33 Extension @extension{ARB,instanced_arrays} and
+    @extension{ARB,texture_buffer_object}
+@requires_gles31 Extension @es_extension{EXT,texture_buffer}
+@requires_gles Buffer textures are not available in WebGL.
+*/
+class MAGNUM_TEXT_EXPORT InstancedRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit InstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        InstancedRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer(const InstancedRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedRenderer(InstancedRenderer&&) = delete;
+
+        ~InstancedRenderer();
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer& operator=(const InstancedRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        InstancedRenderer& operator=(InstancedRenderer&&) = delete;
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Count of rendered glyphs */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /** @brief Count of distinct glyph rectangles rendered so far */
+        UnsignedInt glyphRectangleCount() const { return _glyphRectangleData.size()/2; }
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const { return _rectangle; }
+
+        /**
+         * @brief Instance buffer
+         *
+         * Contains glyph position and glyph rectangle ID for each glyph.
+         */
+        Buffer& instanceBuffer() { return _instanceBuffer; }
+
+        /**
+         * @brief Glyph rectangle texture
+         *
+         * To be passed to @ref Shaders::AbstractVector::setGlyphRectangleTexture().
+         */
+        BufferTexture& glyphRectangleTexture() { return _glyphRectangleTexture; }
+
+        /**
+         * @brief Mesh
+         *
+         * Instanced four-vertex triangle strip with no per-vertex
+         * attributes.
+         */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in instance buffer to hold @p glyphCount glyphs.
+         * Consider using appropriate @p usage if the text will be changed
+         * frequently. Initially zero capacity is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage usage);
+
+        /**
+         * @brief Render text
+         *
+         * Renders the text to instance buffer, adding new glyph rectangles
+         * to the table if needed. Rectangle spanning the rendered text is
+         * available through @ref rectangle(). Initially no text is rendered.
+         * @attention The capacity must be large enough to contain all glyphs,
+         *      see @ref reserve() for more information.
+         */
+        void render(Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void render(const char* text);
+
+        /** @overload */
+        void render(const std::string& text);
+
+        /**
+         * @brief Layout cache
+         *
+         * @see @ref setLayoutCache()
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref AbstractRenderer::setLayoutCache() for more information.
+         * Default is `nullptr`.
+         */
+        InstancedRenderer& setLayoutCache(LayoutCache* cache) {
+            _layoutCache = cache;
+            return *this;
+        }
+
+    private:
+        struct Instance {
+            Vector2 position;
+            UnsignedInt glyphRectangleId;
+        };
+
+        struct GlyphRectangle {
+            bool operator==(const GlyphRectangle& other) const;
+
+            Range2D textureCoordinates;
+            Vector2 size;
+        };
+
+        struct GlyphRectangleHash {
+            std::size_t operator()(const GlyphRectangle& rectangle) const;
+        };
+
+        AbstractFont& font;
+        const GlyphCache& cache;
+        Float size;
+        Alignment _alignment;
+        UnsignedInt _capacity, _glyphCount;
+        Range2D _rectangle;
+        std::unique_ptr<AbstractLayouter> _layouter;
+        LayoutCache* _layoutCache{};
+
+        Mesh _mesh;
+        Buffer _instanceBuffer, _glyphRectangleBuffer;
+        BufferTexture _glyphRectangleTexture;
+
+        /* Scratch space for quads of the rendered text and the instance
+           data, glyph rectangle table with texture coordinates and quad size
+           in two consecutive entries */
+        std::vector<Vector2> _vertexData;
+        std::vector<Instance> _instanceData;
+        std::vector<Vector4> _glyphRectangleData;
+        std::unordered_map<GlyphRectangle, UnsignedInt, GlyphRectangleHash> _glyphRectangleIds;
+};
+#endif
+
 }}
 
 #endif
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <Corrade/Containers/ArrayView.h>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Text/AbstractFont.h"
 
@@ -39,11 +42,17 @@ struct AbstractFontTest: TestSuite::Tester {
 
     void openSingleData();
     void openFile();
+
+    void rasterizeGlyph();
+    void rasterizeGlyphNotSupported();
 };
 
 AbstractFontTest::AbstractFontTest() {
     addTests({&AbstractFontTest::openSingleData,
-              &AbstractFontTest::openFile});
+              &AbstractFontTest::openFile,
+
+              &AbstractFontTest::rasterizeGlyph,
+              &AbstractFontTest::rasterizeGlyphNotSupported});
 }
 
 namespace {
@@ -72,6 +81,19 @@ class SingleDataFont: public Text::AbstractFont {
         bool opened;
 };
 
+class RasterizingFont: public SingleDataFont {
+    public:
+        Features doFeatures() const override { return Feature::OpenData|Feature::GlyphRasterization; }
+
+        std::optional<std::pair<Vector2i, Image2D>> doRasterizeGlyph(UnsignedInt glyph) override {
+            if(glyph != 3) return std::nullopt;
+
+            Containers::Array<char> data{6};
+            for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i*50);
+            return std::make_pair(Vector2i{1, -2}, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, {3, 2}, std::move(data)});
+        }
+};
+
 }
 
 void AbstractFontTest::openSingleData() {
@@ -91,6 +113,32 @@ void AbstractFontTest::openFile() {
     CORRADE_VERIFY(font.isOpened());
 }
 
+void AbstractFontTest::rasterizeGlyph() {
+    RasterizingFont font;
+    const char data[] = {'\xa5'};
+    font.openSingleData(data, 3.0f);
+    CORRADE_VERIFY(font.isOpened());
+
+    std::optional<std::pair<Vector2i, Image2D>> glyph = font.rasterizeGlyph(3);
+    CORRADE_VERIFY(glyph);
+    CORRADE_COMPARE(glyph->first, (Vector2i{1, -2}));
+    CORRADE_COMPARE(glyph->second.size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE(glyph->second.data()[4], char(200));
+
+    CORRADE_VERIFY(!font.rasterizeGlyph(2));
+}
+
+void AbstractFontTest::rasterizeGlyphNotSupported() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SingleDataFont font;
+    const char data[] = {'\xa5'};
+    font.openSingleData(data, 3.0f);
+    CORRADE_VERIFY(!font.rasterizeGlyph(0));
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::rasterizeGlyph(): feature not supported\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractFontTest)
@@ -23,9 +23,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <tuple>
 
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
 #include "Magnum/Test/AbstractOpenGLTester.h"
+
 #include "Magnum/Text/GlyphCache.h"
 
 namespace Magnum { namespace Text { namespace Test {
@@ -36,12 +41,25 @@ struct GlyphCacheGLTest: Magnum::Test::AbstractOpenGLTester {
     void initialize();
     void access();
     void reserve();
+    void reserveIncremental();
+    void reserveDynamic();
+    void reserveDynamicEvict();
+    #ifndef MAGNUM_TARGET_GLES2
+    void textureArray();
+    #endif
 };
 
 GlyphCacheGLTest::GlyphCacheGLTest() {
     addTests({&GlyphCacheGLTest::initialize,
               &GlyphCacheGLTest::access,
-              &GlyphCacheGLTest::reserve});
+              &GlyphCacheGLTest::reserve,
+              &GlyphCacheGLTest::reserveIncremental,
+              &GlyphCacheGLTest::reserveDynamic,
+              &GlyphCacheGLTest::reserveDynamicEvict,
+              #ifndef MAGNUM_TARGET_GLES2
+              &GlyphCacheGLTest::textureArray
+              #endif
+              });
 }
 
 void GlyphCacheGLTest::initialize() {
@@ -91,6 +109,100 @@ void GlyphCacheGLTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void GlyphCacheGLTest::reserveIncremental() {
+    Text::GlyphCache cache(Vector2i(16));
+
+    std::vector<Range2Di> first = cache.reserve({{16, 10}});
+    CORRADE_COMPARE(first, std::vector<Range2Di>{Range2Di::fromSize({}, {16, 10})});
+    cache.insert(1, {}, first[0]);
+
+    /* Reserving in non-empty cache doesn't overwrite already reserved space */
+    std::vector<Range2Di> second = cache.reserve({{8, 6}, {8, 6}});
+    CORRADE_COMPARE(second, (std::vector<Range2Di>{
+        Range2Di::fromSize({0, 10}, {8, 6}),
+        Range2Di::fromSize({8, 10}, {8, 6})}));
+    CORRADE_COMPARE(cache.occupancy(), 1.0f);
+
+    /* No space left */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(cache.reserve({{1, 1}}).empty());
+}
+
+void GlyphCacheGLTest::reserveDynamic() {
+    Text::GlyphCache cache(Vector2i(16));
+    CORRADE_VERIFY(!cache.isDynamic());
+    cache.setDynamic(true);
+    CORRADE_VERIFY(cache.isDynamic());
+
+    /* Glyphs of similar height share a shelf, larger first */
+    std::vector<Range2Di> first = cache.reserve({{4, 5}, {4, 6}, {4, 10}});
+    CORRADE_COMPARE(first, (std::vector<Range2Di>{
+        Range2Di::fromSize({4, 10}, {4, 5}),
+        Range2Di::fromSize({0, 10}, {4, 6}),
+        Range2Di::fromSize({0, 0}, {4, 10})}));
+    CORRADE_COMPARE(cache.occupancy(), 84.0f/256.0f);
+
+    cache.insert(1, {}, first[0]);
+    cache.insert(2, {}, first[1]);
+    cache.insert(3, {}, first[2]);
+    CORRADE_VERIFY(cache.contains(2));
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+}
+
+void GlyphCacheGLTest::reserveDynamicEvict() {
+    Text::GlyphCache cache(Vector2i(16));
+    cache.setDynamic(true);
+
+    cache.beginFill();
+    std::vector<Range2Di> first = cache.reserve({{16, 8}, {16, 8}});
+    CORRADE_COMPARE(first.size(), 2);
+    cache.insert(1, {}, first[0]);
+    cache.insert(2, {}, first[1]);
+    CORRADE_COMPARE(cache.occupancy(), 1.0f);
+
+    /* Glyphs from current fill are not evicted */
+    CORRADE_VERIFY(cache.reserve({{16, 8}}).empty());
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /* Least recently used glyph is evicted */
+    cache.beginFill();
+    cache.touch(1);
+    std::vector<Range2Di> second = cache.reserve({{16, 8}});
+    CORRADE_COMPARE(second, std::vector<Range2Di>{first[1]});
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 1);
+    CORRADE_VERIFY(cache.contains(1));
+    CORRADE_VERIFY(!cache.contains(2));
+    cache.insert(3, {}, second[0]);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void GlyphCacheGLTest::textureArray() {
+    Texture2DArray glyphs;
+    glyphs.setStorage(1, TextureFormat::R8, {8, 8, 2});
+
+    Text::GlyphCache first{glyphs, 0, Vector2i{8}};
+    Text::GlyphCache second{glyphs, 1, Vector2i{8}};
+    CORRADE_VERIFY(&first.textureArray() == &glyphs);
+    CORRADE_COMPARE(second.textureArrayLayer(), 1);
+
+    /* Each cache fills only its own layer */
+    std::vector<char> data(8*8);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i);
+    first.insert(1, {}, first.reserve({Vector2i{8}})[0]);
+    second.setImage({}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, Vector2i{8}, {data.data(), data.size()}});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = second.image();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.size(), Vector2i{8});
+    CORRADE_COMPARE(std::vector<char>(image.data(), image.data() + 8*8), data);
+    #endif
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Text::Test::GlyphCacheGLTest)
@@ -0,0 +1,99 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct GlyphCacheTest: TestSuite::Tester {
+    explicit GlyphCacheTest();
+
+    void constructNoCreate();
+    void setImageNoCreate();
+    void setImageNoCreateDynamic();
+};
+
+GlyphCacheTest::GlyphCacheTest() {
+    addTests({&GlyphCacheTest::constructNoCreate,
+              &GlyphCacheTest::setImageNoCreate,
+              &GlyphCacheTest::setImageNoCreateDynamic});
+}
+
+void GlyphCacheTest::constructNoCreate() {
+    GlyphCache cache{NoCreate, {16, 8}, {8, 4}, {1, 2}};
+
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{16, 8}));
+    CORRADE_COMPARE(cache.padding(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+
+    Image2D image = cache.image();
+    CORRADE_COMPARE(image.format(), PixelFormat::Red);
+    CORRADE_COMPARE(image.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image.size(), (Vector2i{8, 4}));
+    for(const char c: image.data()) CORRADE_COMPARE(c, 0);
+}
+
+void GlyphCacheTest::setImageNoCreate() {
+    GlyphCache cache{NoCreate, {4, 3}, {4, 3}};
+
+    const char data[] = { 1, 2, 0, 0,
+                          3, 4, 0, 0 };
+    cache.setImage({1, 1}, ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, data});
+
+    Image2D image = cache.image();
+    const char expected[] = { 0, 0, 0, 0,
+                              0, 1, 2, 0,
+                              0, 3, 4, 0 };
+    CORRADE_COMPARE(image.data().size(), 12);
+    for(std::size_t i = 0; i != 12; ++i) CORRADE_COMPARE(image.data()[i], expected[i]);
+}
+
+void GlyphCacheTest::setImageNoCreateDynamic() {
+    GlyphCache cache{NoCreate, {4, 2}, {4, 2}};
+    cache.setDynamic(true);
+
+    /* Only the reserved region gets copied */
+    std::vector<Range2Di> regions = cache.reserve({Vector2i{2, 2}});
+    CORRADE_COMPARE(regions.size(), 1);
+    CORRADE_COMPARE(regions[0], (Range2Di{{}, {2, 2}}));
+
+    const char data[] = { 5, 5, 5, 5,
+                          5, 5, 5, 5 };
+    cache.setImage({}, ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {4, 2}, data});
+
+    Image2D image = cache.image();
+    const char expected[] = { 5, 5, 0, 0,
+                              5, 5, 0, 0 };
+    for(std::size_t i = 0; i != 8; ++i) CORRADE_COMPARE(image.data()[i], expected[i]);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::GlyphCacheTest)
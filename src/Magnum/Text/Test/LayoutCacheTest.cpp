@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct LayoutCacheTest: TestSuite::Tester {
+    explicit LayoutCacheTest();
+
+    void findInsert();
+    void keys();
+    void replace();
+    void evictLeastRecentlyUsed();
+    void setCapacity();
+    void evictedGlyphs();
+    void statistics();
+};
+
+LayoutCacheTest::LayoutCacheTest() {
+    addTests({&LayoutCacheTest::findInsert,
+              &LayoutCacheTest::keys,
+              &LayoutCacheTest::replace,
+              &LayoutCacheTest::evictLeastRecentlyUsed,
+              &LayoutCacheTest::setCapacity,
+              &LayoutCacheTest::evictedGlyphs,
+              &LayoutCacheTest::statistics});
+}
+
+namespace {
+
+class DummyFont: public Text::AbstractFont {
+    Features doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return false; }
+    void doClose() override {}
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string&) override { return nullptr; }
+};
+
+LayoutCache::Layout layout(UnsignedInt glyphCount, Float width) {
+    LayoutCache::Layout layout;
+    layout.vertices.resize(glyphCount*8);
+    layout.rectangle = {{}, {width, 1.0f}};
+    return layout;
+}
+
+Containers::ArrayView<const char> view(const char* text) {
+    return {text, std::strlen(text)};
+}
+
+}
+
+void LayoutCacheTest::findInsert() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache{4};
+
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hello")));
+
+    const LayoutCache::Layout& inserted = layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("hello"), layout(5, 3.0f));
+    CORRADE_COMPARE(inserted.glyphCount(), 5);
+    CORRADE_COMPARE(layoutCache.size(), 1);
+
+    const LayoutCache::Layout* found = layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hello"));
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found->glyphCount(), 5);
+    CORRADE_COMPARE(found->rectangle, (Range2D{{}, {3.0f, 1.0f}}));
+}
+
+void LayoutCacheTest::keys() {
+    DummyFont font, anotherFont;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    GlyphCache anotherCache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache;
+
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("hello"), layout(5, 3.0f));
+
+    /* Everything in the key has to match */
+    CORRADE_VERIFY(!layoutCache.find(anotherFont, cache, 1.0f, Alignment::LineLeft, view("hello")));
+    CORRADE_VERIFY(!layoutCache.find(font, anotherCache, 1.0f, Alignment::LineLeft, view("hello")));
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 2.0f, Alignment::LineLeft, view("hello")));
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineRight, view("hello")));
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hell")));
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hellO")));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hello")));
+}
+
+void LayoutCacheTest::replace() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache;
+
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("hello"), layout(5, 3.0f));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("hello"), layout(5, 4.0f));
+    CORRADE_COMPARE(layoutCache.size(), 1);
+
+    const LayoutCache::Layout* found = layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("hello"));
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found->rectangle.sizeX(), 4.0f);
+}
+
+void LayoutCacheTest::evictLeastRecentlyUsed() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache{2};
+
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("a"), layout(1, 1.0f));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("b"), layout(1, 1.0f));
+
+    /* Using "a" makes "b" the least recently used one */
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("c"), layout(1, 1.0f));
+
+    CORRADE_COMPARE(layoutCache.size(), 2);
+    CORRADE_COMPARE(layoutCache.evictedCount(), 1);
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("b")));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("c")));
+}
+
+void LayoutCacheTest::setCapacity() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache{3};
+
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("a"), layout(1, 1.0f));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("b"), layout(1, 1.0f));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("c"), layout(1, 1.0f));
+
+    layoutCache.setCapacity(1);
+    CORRADE_COMPARE(layoutCache.capacity(), 1);
+    CORRADE_COMPARE(layoutCache.size(), 1);
+    CORRADE_COMPARE(layoutCache.evictedCount(), 2);
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("c")));
+
+    layoutCache.clear();
+    CORRADE_COMPARE(layoutCache.size(), 0);
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("c")));
+}
+
+void LayoutCacheTest::evictedGlyphs() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{4}, Vector2i{4}};
+    cache.setDynamic(true);
+    LayoutCache layoutCache;
+
+    cache.beginFill();
+    cache.insert(1, {}, cache.reserve({Vector2i{4}})[0]);
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("a"), layout(1, 1.0f));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+
+    /* Glyph 1 gets evicted to make space for glyph 2, the cached layout
+       might reference it */
+    cache.beginFill();
+    cache.insert(2, {}, cache.reserve({Vector2i{4}})[0]);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 1);
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    CORRADE_COMPARE(layoutCache.size(), 0);
+}
+
+void LayoutCacheTest::statistics() {
+    DummyFont font;
+    GlyphCache cache{NoCreate, Vector2i{16}, Vector2i{16}};
+    LayoutCache layoutCache;
+    CORRADE_COMPARE(layoutCache.hitRate(), 0.0f);
+
+    CORRADE_VERIFY(!layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    layoutCache.insert(font, cache, 1.0f, Alignment::LineLeft, view("a"), layout(1, 1.0f));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+    CORRADE_VERIFY(layoutCache.find(font, cache, 1.0f, Alignment::LineLeft, view("a")));
+
+    CORRADE_COMPARE(layoutCache.hitCount(), 3);
+    CORRADE_COMPARE(layoutCache.missCount(), 1);
+    CORRADE_COMPARE(layoutCache.hitRate(), 0.75f);
+
+    layoutCache.resetStatistics();
+    CORRADE_COMPARE(layoutCache.hitCount(), 0);
+    CORRADE_COMPARE(layoutCache.missCount(), 0);
+    CORRADE_COMPARE(layoutCache.size(), 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::LayoutCacheTest)
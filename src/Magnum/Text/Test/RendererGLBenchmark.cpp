@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Test/AbstractOpenGLBenchmarker.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct RendererGLBenchmark: Magnum::Test::AbstractOpenGLBenchmarker {
+    explicit RendererGLBenchmark();
+
+    void renderMesh();
+    void mutableText();
+};
+
+RendererGLBenchmark::RendererGLBenchmark() {
+    addTests({&RendererGLBenchmark::renderMesh,
+              &RendererGLBenchmark::mutableText});
+}
+
+namespace {
+
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*_size),
+                Range2D::fromSize({(i%16)*6.0f, 0.0f}, {6.0f, 10.0f}),
+                Vector2::xAxis(3.0f)*_size
+            );
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    Features doFeatures() const override { return Feature::OpenData; }
+
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, const Float size, const std::string& text) override {
+        return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size()));
+    }
+};
+
+/* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
+char glyphCacheData;
+GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
+
+const std::string Sentence = "The quick brown fox jumps over the lazy dog, 0123456789";
+
+}
+
+void RendererGLBenchmark::renderMesh() {
+    TestFont font;
+    Buffer vertexBuffer, indexBuffer;
+
+    measure("Renderer2D::render() into a new mesh", 1000, [&]() {
+        Renderer2D::render(font, nullGlyphCache, 0.25f, Sentence, vertexBuffer, indexBuffer, BufferUsage::StaticDraw);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererGLBenchmark::mutableText() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_EMSCRIPTEN)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>()
+       #ifdef CORRADE_TARGET_NACL
+       && !Context::current().isExtensionSupported<Extensions::GL::CHROMIUM::map_sub>()
+       #endif
+    ) {
+        CORRADE_SKIP("No required extension is supported");
+    }
+    #endif
+
+    TestFont font;
+    Renderer2D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(Sentence.size(), BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+    measure("Renderer2D::render() into a reserved buffer", 1000, [&]() {
+        renderer.render(Sentence);
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Text::Test::RendererGLBenchmark)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/Test/AbstractOpenGLTester.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/Renderer.h"
@@ -36,8 +38,19 @@ struct RendererGLTest: Magnum::Test::AbstractOpenGLTester {
     void renderMesh();
     void renderMeshIndexType();
     void mutableText();
+    void mutableTextReuseLayouter();
+    void sharedIndexBuffer();
 
     void multiline();
+
+    void batch();
+
+    void editable();
+    void editableWrap();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void instanced();
+    #endif
 };
 
 RendererGLTest::RendererGLTest() {
@@ -45,8 +58,20 @@ RendererGLTest::RendererGLTest() {
               &RendererGLTest::renderMesh,
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
+              &RendererGLTest::mutableTextReuseLayouter,
+              &RendererGLTest::sharedIndexBuffer,
+
+              &RendererGLTest::multiline,
 
-              &RendererGLTest::multiline});
+              &RendererGLTest::batch,
+
+              &RendererGLTest::editable,
+              &RendererGLTest::editableWrap,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &RendererGLTest::instanced
+              #endif
+              });
 }
 
 namespace {
@@ -55,6 +80,11 @@ class TestLayouter: public Text::AbstractLayouter {
     public:
         explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
 
+        void relayout(Float size, std::size_t glyphCount) {
+            _size = size;
+            setGlyphCount(glyphCount);
+        }
+
     private:
         std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
             return std::make_tuple(
@@ -81,6 +111,42 @@ class TestFont: public Text::AbstractFont {
     }
 };
 
+/* Fixed-size glyphs with fixed advance and nonzero line height */
+class FixedLayouter: public Text::AbstractLayouter {
+    public:
+        explicit FixedLayouter(UnsignedInt glyphCount): AbstractLayouter(glyphCount) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+            return std::make_tuple(Range2D({}, Vector2(1.0f)), Range2D({}, Vector2(1.0f)), Vector2::xAxis(2.0f));
+        }
+};
+
+class FixedFont: public Text::AbstractFont {
+    public:
+        explicit FixedFont(): _opened(false) {}
+
+    private:
+        Features doFeatures() const override { return {};  }
+
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {0.5f, 0.45f, -0.25f, 0.75f};
+        }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string& text) override {
+            return std::unique_ptr<AbstractLayouter>(new FixedLayouter(text.size()));
+        }
+
+        bool _opened;
+};
+
 /* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
 char glyphCacheData;
 GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
@@ -283,8 +349,8 @@ void RendererGLTest::mutableText() {
     CORRADE_COMPARE(renderer.capacity(), 4);
     /** @todo How to verify this on ES? */
     #ifndef MAGNUM_TARGET_GLES
-    Containers::Array<UnsignedByte> indices = renderer.indexBuffer().data<UnsignedByte>();
-    CORRADE_COMPARE(std::vector<UnsignedByte>(indices.begin(), indices.end()), (std::vector<UnsignedByte>{
+    Containers::Array<UnsignedShort> indices = renderer.indexBuffer().subData<UnsignedShort>(0, 24);
+    CORRADE_COMPARE(std::vector<UnsignedShort>(indices.begin(), indices.end()), (std::vector<UnsignedShort>{
          0,  1,  2,  1,  3,  2,
          4,  5,  6,  5,  7,  6,
          8,  9, 10,  9, 11, 10,
@@ -323,6 +389,93 @@ void RendererGLTest::mutableText() {
     #endif
 }
 
+void RendererGLTest::mutableTextReuseLayouter() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_EMSCRIPTEN)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>()
+       #ifdef CORRADE_TARGET_NACL
+       && !Context::current().isExtensionSupported<Extensions::GL::CHROMIUM::map_sub>()
+       #endif
+    ) {
+        CORRADE_SKIP("No required extension is supported");
+    }
+    #endif
+
+    class ReusingFont: public TestFont {
+        public:
+            std::size_t layouterCount = 0;
+
+        private:
+            std::unique_ptr<AbstractLayouter> doLayoutInto(const GlyphCache&, const Float size, const Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter> layouter) override {
+                if(!layouter) {
+                    ++layouterCount;
+                    return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size()));
+                }
+
+                static_cast<TestLayouter&>(*layouter).relayout(size, text.size());
+                return layouter;
+            }
+    } font;
+
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(4, BufferUsage::DynamicDraw, BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Render only part of the text, the layouter gets created */
+    const char text[] = "xxabcxx";
+    renderer.render(Containers::ArrayView<const char>{text + 2, 3});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(font.layouterCount, 1);
+    CORRADE_COMPARE(renderer.mesh().count(), 18);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+
+    /* Rendering again reuses the layouter */
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(font.layouterCount, 1);
+    CORRADE_COMPARE(renderer.mesh().count(), 12);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+}
+
+void RendererGLTest::sharedIndexBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_EMSCRIPTEN)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>()
+       #ifdef CORRADE_TARGET_NACL
+       && !Context::current().isExtensionSupported<Extensions::GL::CHROMIUM::map_sub>()
+       #endif
+    ) {
+        CORRADE_SKIP("No required extension is supported");
+    }
+    #endif
+
+    TestFont font;
+    Text::Renderer2D a(font, nullGlyphCache, 0.25f);
+    Text::Renderer3D b(font, nullGlyphCache, 0.25f);
+    Text::BatchRenderer2D c(font, nullGlyphCache, 0.25f);
+    a.reserve(16, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    b.reserve(4, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    c.reserve(8, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* All renderers use the same index buffer, which is large enough for the
+       largest one */
+    CORRADE_COMPARE(a.indexBuffer().id(), b.indexBuffer().id());
+    CORRADE_COMPARE(a.indexBuffer().id(), c.indexBuffer().id());
+    CORRADE_COMPARE(a.indexBuffer().size(), 16*6*Int(sizeof(UnsignedShort)));
+
+    /* Rendering with smaller renderer works */
+    b.render("abc");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(b.mesh().count(), 18);
+}
+
 void RendererGLTest::multiline() {
     class Layouter: public Text::AbstractLayouter {
         public:
@@ -430,6 +583,216 @@ void RendererGLTest::multiline() {
     }));
 }
 
+void RendererGLTest::batch() {
+    TestFont font;
+    Text::BatchRenderer2D batch(font, nullGlyphCache, 0.25f);
+    batch.reserve(4, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.capacity(), 4);
+    CORRADE_COMPARE(batch.labelCount(), 0);
+    CORRADE_COMPARE(batch.mesh().count(), 0);
+
+    /* Second label doesn't fit, the capacity gets doubled */
+    const UnsignedInt a = batch.add(3);
+    const UnsignedInt b = batch.add(2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(batch.capacity(), 8);
+    CORRADE_COMPARE(batch.labelCount(), 2);
+    CORRADE_COMPARE(batch.mesh().count(), 30);
+
+    batch.render(a, "ab");
+    batch.render(b, "ab");
+    batch.setTransformation(b, Matrix3::translation({10.0f, 0.0f}));
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Rectangle doesn't include the transformation */
+    CORRADE_COMPARE(batch.rectangle(a), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+    CORRADE_COMPARE(batch.rectangle(b), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+    CORRADE_COMPARE(batch.transformation(b), Matrix3::translation({10.0f, 0.0f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Unused glyph of first label is degenerate, second label is
+       transformed */
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(2*4*16, 48);
+    CORRADE_COMPARE(std::vector<Float>(vertices.begin(), vertices.end()), (std::vector<Float>{
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+
+        10.0f,  0.5f, 0.0f, 10.0f,
+        10.0f,  0.0f, 0.0f,  0.0f,
+        10.75f, 0.5f, 6.0f, 10.0f,
+        10.75f, 0.0f, 6.0f,  0.0f,
+
+        11.0f,  0.75f,  6.0f, 10.0f,
+        11.0f, -0.25f,  6.0f,  0.0f,
+        12.5f,  0.75f, 12.0f, 10.0f,
+        12.5f, -0.25f, 12.0f,  0.0f
+    }));
+    #endif
+
+    /* Removing the first label doesn't change the drawn range, its space and
+       ID gets reused */
+    batch.remove(a);
+    CORRADE_COMPARE(batch.labelCount(), 1);
+    CORRADE_COMPARE(batch.mesh().count(), 30);
+    CORRADE_COMPARE(batch.add(2), 0);
+    CORRADE_COMPARE(batch.capacity(), 8);
+    CORRADE_COMPARE(batch.mesh().count(), 30);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererGLTest::editable() {
+    FixedFont font;
+    font.openFile({}, 0.0f);
+    Text::EditableRenderer2D renderer(font, nullGlyphCache, 2.0f, Alignment::TopLeft);
+    renderer.reserve(4, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.lineCount(), 1);
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+
+    /* The line advance is 0.75f*2.0f/0.5f = 3.0f, vertically aligned to
+       top of the first line */
+    renderer.setText("ab\ncd");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.text(), "ab\ncd");
+    CORRADE_COMPARE(renderer.glyphCount(), 4);
+    CORRADE_COMPARE(renderer.lineCount(), 2);
+    CORRADE_COMPARE(renderer.mesh().count(), 24);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -4.0f}, {3.0f, 0.0f}));
+
+    /* Inserting a line doesn't fit into the capacity, it gets doubled */
+    renderer.insert(3, "efg\n");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.text(), "ab\nefg\ncd");
+    CORRADE_COMPARE(renderer.capacity(), 8);
+    CORRADE_COMPARE(renderer.glyphCount(), 7);
+    CORRADE_COMPARE(renderer.lineCount(), 3);
+    CORRADE_COMPARE(renderer.mesh().count(), 42);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -7.0f}, {5.0f, 0.0f}));
+
+    /* Edits spanning more lines */
+    renderer.remove(1, 3);
+    renderer.replace(2, 3, "hi\n\n");
+    renderer.append("j");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.text(), "afhi\n\ndj");
+    CORRADE_COMPARE(renderer.capacity(), 8);
+    CORRADE_COMPARE(renderer.glyphCount(), 6);
+    CORRADE_COMPARE(renderer.lineCount(), 3);
+
+    /* The result is the same as when rendering the whole text at once */
+    std::vector<Vector2> positions, textureCoordinates;
+    Range2D rectangle;
+    std::tie(positions, textureCoordinates, std::ignore, rectangle) = Text::AbstractRenderer::render(font, nullGlyphCache, 2.0f, renderer.text(), Alignment::TopLeft);
+    CORRADE_COMPARE(renderer.rectangle(), rectangle);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    std::vector<Vector2> expected;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        expected.push_back(positions[i]);
+        expected.push_back(textureCoordinates[i]);
+    }
+    const Containers::Array<Vector2> vertices = renderer.vertexBuffer().subData<Vector2>(0, renderer.glyphCount()*8);
+    CORRADE_COMPARE(std::vector<Vector2>(vertices.begin(), vertices.end()), expected);
+    #endif
+}
+
+void RendererGLTest::editableWrap() {
+    FixedFont font;
+    font.openFile({}, 0.0f);
+    Text::EditableRenderer2D renderer(font, nullGlyphCache, 2.0f);
+    renderer.reserve(8, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    renderer.setText("a a a a");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 7);
+    CORRADE_COMPARE(renderer.lineCount(), 1);
+
+    /* Each glyph advances by 2.0f, trailing spaces of wrapped lines are not
+       rendered */
+    renderer.setWrapWidth(7.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.wrapWidth(), 7.0f);
+    CORRADE_COMPARE(renderer.glyphCount(), 6);
+    CORRADE_COMPARE(renderer.lineCount(), 2);
+
+    /* Making the first word longer wraps the rest again */
+    renderer.insert(0, "b");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 6);
+    CORRADE_COMPARE(renderer.lineCount(), 3);
+
+    /* Words longer than the width are not broken */
+    renderer.setText("aaaaa aa");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 7);
+    CORRADE_COMPARE(renderer.lineCount(), 2);
+
+    renderer.setWrapWidth(0.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 8);
+    CORRADE_COMPARE(renderer.lineCount(), 1);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void RendererGLTest::instanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not supported."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::texture_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::texture_buffer_object::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_buffer>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_buffer::string() + std::string(" is not supported."));
+    #endif
+
+    TestFont font;
+    Text::InstancedRenderer renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(4, BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 4);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+
+    /* Each glyph of the test layouter has a different size, so three distinct
+       rectangles */
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 3);
+    CORRADE_COMPARE(renderer.glyphRectangleCount(), 3);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 3);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Bottom left corner of each glyph followed by rectangle ID */
+    const Containers::Array<UnsignedInt> instances = renderer.instanceBuffer().subData<UnsignedInt>(0, 9);
+    const Float* const positions = reinterpret_cast<const Float*>(instances.data());
+    CORRADE_COMPARE(Vector2(positions[0], positions[1]), Vector2(0.0f, 0.0f));
+    CORRADE_COMPARE(instances[2], 0);
+    CORRADE_COMPARE(Vector2(positions[3], positions[4]), Vector2(1.0f, -0.25f));
+    CORRADE_COMPARE(instances[5], 1);
+    CORRADE_COMPARE(Vector2(positions[6], positions[7]), Vector2(2.75f, -0.5f));
+    CORRADE_COMPARE(instances[8], 2);
+    #endif
+
+    /* Rendering the same glyphs again reuses the rectangles */
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 2);
+    CORRADE_COMPARE(renderer.glyphRectangleCount(), 3);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 2);
+}
+#endif
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Text::Test::RendererGLTest)
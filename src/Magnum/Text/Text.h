@@ -40,6 +40,7 @@ class AbstractFontConverter;
 class AbstractLayouter;
 class DistanceFieldGlyphCache;
 class GlyphCache;
+class LayoutCache;
 
 enum class Alignment: UnsignedByte;
 
@@ -47,6 +48,20 @@ class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+
+class AbstractBatchRenderer;
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
+
+class AbstractEditableRenderer;
+template<UnsignedInt> class EditableRenderer;
+typedef EditableRenderer<2> EditableRenderer2D;
+typedef EditableRenderer<3> EditableRenderer3D;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class InstancedRenderer;
+#endif
 #endif
 
 }}
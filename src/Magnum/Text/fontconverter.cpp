@@ -23,13 +23,23 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <unordered_set>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Directory.h>
-
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractFontConverter.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #ifdef MAGNUM_TARGET_HEADLESS
@@ -58,7 +68,7 @@ namespace Magnum {
 
 @section magnum-fontconverter-usage Usage
 
-    magnum-fontconverter [-h|--help] --font FONT --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS] [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N] [--] input output
+    magnum-fontconverter [-h|--help] --font FONT --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS] [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N] [--cpu] [--threads N] [--] input output
 
 Arguments:
 
@@ -76,6 +86,12 @@ Arguments:
 -   `--output-size "X Y"` -- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` -- distance field computation radius (default: `24`)
+-   `--cpu` -- rasterize the glyphs and compute the distance field on the
+    CPU instead of the GPU, no OpenGL context is created in that case. The
+    font plugin needs to support
+    @ref Text::AbstractFont::Feature::GlyphRasterization "glyph rasterization".
+-   `--threads N` -- count of threads used for computing on the CPU, `0`
+    means all workers of @ref TaskScheduler::global() (default: `0`)
 
 The resulting font files can be then used as specified in the documentation of
 `converter` plugin.
@@ -91,6 +107,14 @@ Making raster font from TTF file with default set of characters using
 According to `MagnumFontConverter` plugin documentation, this will generate
 files `myfont.conf` and `myfont.tga` in current directory. You can then load
 and use them with the @ref Text::MagnumFont "MagnumFont" plugin.
+
+    magnum-fontconverter --cpu --font FreeTypeFont --converter MagnumFontConverter DejaVuSans.ttf myfont
+
+The same, but done on the CPU. The font is opened once for each thread, glyphs
+are rasterized in parallel, packed using @ref TextureTools::AtlasPacker and
+distance field of each glyph is computed in parallel using
+@ref TextureTools::distanceField(const ImageView2D&, Image2D&, const Range2Di&, Int, UnsignedInt).
+Useful e.g. on build servers without any GPU.
 */
 
 namespace Text {
@@ -102,9 +126,38 @@ class FontConverter: public Platform::WindowlessApplication {
         int exec() override;
 
     private:
+        std::unique_ptr<GlyphCache> populateGlyphCacheCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFont& font);
+
         Utility::Arguments args;
 };
 
+namespace {
+
+/* Calls given function for each index in [0, count) on the global task
+   scheduler, split into at most given count of chunks. Each chunk is processed
+   by a single task, so the chunk index passed to the function can be used to
+   pick an object that can't be used from more threads at once. */
+template<class F> void parallelFor(const std::size_t count, const UnsignedInt threadCount, F function) {
+    const std::size_t chunkSize = (count + threadCount - 1)/threadCount;
+    Magnum::Implementation::parallelFor(count, threadCount, [chunkSize, &function](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) function(UnsignedInt(begin/chunkSize), i);
+    });
+}
+
+/* Copies rectangle of given image to given offset in tightly packed red
+   output image */
+void copyPixels(const ImageView2D& image, const Range2Di& rectangle, Image2D& output, const Vector2i& offset) {
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = image.dataProperties();
+    const char* const data = image.data() + dataOffset.sum();
+    for(Int y = 0; y != rectangle.sizeY(); ++y)
+        for(Int x = 0; x != rectangle.sizeX(); ++x)
+            output.data()[(offset.y() + y)*output.size().x() + offset.x() + x] = data[(rectangle.bottom() + y)*dataSize.x() + (rectangle.left() + x)*pixelSize];
+}
+
+}
+
 FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
     args.addArgument("input").setHelp("input", "input font")
         .addArgument("output").setHelp("output", "output filename prefix")
@@ -118,11 +171,14 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "rasterize glyphs and compute the distance field on the CPU")
+        .addOption("threads", "0").setHelp("threads", "count of threads used for computing on the CPU, 0 means all task scheduler workers", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    /* Context is not needed for CPU conversion */
+    if(!args.isSet("cpu")) createContext();
 }
 
 int FontConverter::exec() {
@@ -147,9 +203,18 @@ int FontConverter::exec() {
         std::exit(1);
     }
 
-    /* Create distance field glyph cache if radius is specified */
+    /* Populate the cache on the CPU, if requested */
     std::unique_ptr<Text::GlyphCache> cache;
-    if(!args.value<Vector2i>("output-size").isZero()) {
+    if(args.isSet("cpu")) {
+        if(!(font->features() & AbstractFont::Feature::GlyphRasterization)) {
+            Error() << "Font plugin" << args.value("font") << "doesn't support glyph rasterization";
+            std::exit(1);
+        }
+
+        cache = populateGlyphCacheCpu(fontManager, *font);
+
+    /* Create distance field glyph cache if radius is specified */
+    } else if(!args.value<Vector2i>("output-size").isZero()) {
         Debug() << "Populating distance field glyph cache...";
 
         cache.reset(new Text::DistanceFieldGlyphCache(
@@ -165,7 +230,7 @@ int FontConverter::exec() {
     }
 
     /* Fill the cache */
-    font->fillGlyphCache(*cache, args.value("characters"));
+    if(!args.isSet("cpu")) font->fillGlyphCache(*cache, args.value("characters"));
 
     Debug() << "Converting font...";
 
@@ -180,6 +245,95 @@ int FontConverter::exec() {
     return 0;
 }
 
+std::unique_ptr<GlyphCache> FontConverter::populateGlyphCacheCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFont& font) {
+    const Vector2i atlasSize = args.value<Vector2i>("atlas-size");
+    const Vector2i outputSize = args.value<Vector2i>("output-size");
+    const bool distanceField = !outputSize.isZero();
+    const Int radius = distanceField ? args.value<Int>("radius") : 0;
+
+    /* Unique glyphs for all characters, glyph 0 first */
+    std::vector<UnsignedInt> glyphs{0};
+    std::unordered_set<UnsignedInt> uniqueGlyphs{0};
+    for(const char32_t character: Utility::Unicode::utf32(args.value("characters"))) {
+        const UnsignedInt glyph = font.glyphId(character);
+        if(uniqueGlyphs.insert(glyph).second) glyphs.push_back(glyph);
+    }
+
+    UnsignedInt threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = TaskScheduler::global().workerCount() + 1;
+    threadCount = Math::min(threadCount, UnsignedInt(glyphs.size()));
+
+    /* Font plugins are not thread-safe, open the font once for each
+       additional chunk */
+    std::vector<std::unique_ptr<AbstractFont>> fontInstances;
+    std::vector<AbstractFont*> fonts{&font};
+    for(UnsignedInt thread = 1; thread < threadCount; ++thread) {
+        fontInstances.push_back(fontManager.instance(args.value("font")));
+        if(!fontInstances.back()->openFile(args.value("input"), args.value<Float>("font-size"))) {
+            Error() << "Cannot open font" << args.value("input");
+            std::exit(1);
+        }
+        fonts.push_back(fontInstances.back().get());
+    }
+
+    Debug() << "Rasterizing" << glyphs.size() << "glyphs on" << threadCount << "threads...";
+
+    std::vector<std::optional<std::pair<Vector2i, Image2D>>> rasterized(glyphs.size());
+    parallelFor(glyphs.size(), threadCount, [&](const UnsignedInt thread, const std::size_t i) {
+        rasterized[i] = fonts[thread]->rasterizeGlyph(glyphs[i]);
+    });
+
+    std::vector<Vector2i> sizes;
+    sizes.reserve(glyphs.size());
+    for(std::size_t i = 0; i != glyphs.size(); ++i) {
+        if(!rasterized[i]) {
+            Error() << "Cannot rasterize glyph" << glyphs[i];
+            std::exit(1);
+        }
+        sizes.push_back(rasterized[i]->second.size());
+    }
+
+    /* Pack the glyphs. In case of distance field the padding is large
+       enough to contain the distance falloff around the glyph. */
+    std::unique_ptr<GlyphCache> cache{new GlyphCache{NoCreate, atlasSize, distanceField ? outputSize : atlasSize, Vector2i{radius}}};
+    const std::vector<Range2Di> rectangles = cache->reserve(sizes);
+    if(rectangles.empty()) {
+        Error() << "Cannot fit" << glyphs.size() << "glyphs into atlas of size" << atlasSize;
+        std::exit(1);
+    }
+    for(std::size_t i = 0; i != glyphs.size(); ++i)
+        cache->insert(glyphs[i], rasterized[i]->first, rectangles[i]);
+
+    /* Copy the glyphs to the atlas */
+    Image2D atlas{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, atlasSize, Containers::Array<char>{Containers::ValueInit, std::size_t(atlasSize.product())}};
+    parallelFor(glyphs.size(), threadCount, [&](UnsignedInt, const std::size_t i) {
+        copyPixels(rasterized[i]->second, {{}, sizes[i]}, atlas, rectangles[i].min());
+    });
+
+    if(!distanceField) {
+        cache->setImage({}, atlas);
+        return cache;
+    }
+
+    /* Compute distance field of each glyph separately, including the padding
+       around it. The glyph regions don't overlap, so neither do the output
+       regions. */
+    Debug() << "Computing distance field of" << glyphs.size() << "glyphs on" << threadCount << "threads...";
+
+    Image2D output{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, outputSize, Containers::Array<char>{Containers::ValueInit, std::size_t(outputSize.product())}};
+    const Vector2 scale = Vector2(outputSize)/Vector2(atlasSize);
+    parallelFor(glyphs.size(), threadCount, [&](UnsignedInt, const std::size_t i) {
+        const Range2Di padded = rectangles[i].padded(Vector2i{radius});
+        Image2D input{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, padded.size(), Containers::Array<char>{std::size_t(padded.size().product())}};
+        copyPixels(atlas, padded, input, {});
+
+        TextureTools::distanceField(input, output, {Vector2i{Vector2(padded.min())*scale}, Vector2i{Vector2(padded.max())*scale}}, radius, 1);
+    });
+
+    cache->setImage({}, output);
+    return cache;
+}
+
 }
 
 }
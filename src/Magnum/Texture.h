@@ -723,6 +723,107 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Virtual page size for sparse textures
+         *
+         * Size of one page in given internal format. All offsets and sizes
+         * passed to @ref commitPages() and @ref decommitPages() need to be
+         * multiples of it. Returns zero vector if the format can't be used
+         * for sparse textures. Expects that @extension{ARB,sparse_texture}
+         * is available.
+         * @see @ref setSparseStorage(), @fn_gl{GetInternalformat} with
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_X,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_Y,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_Z,ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        static Vector3i sparsePageSize(TextureFormat internalFormat) {
+            return sparsePageSizeInternal(Implementation::textureTarget<dimensions>(), internalFormat);
+        }
+
+        /**
+         * @brief Set sparse storage
+         * @param levels            Mip level count
+         * @param internalFormat    Internal format
+         * @param size              Size of largest mip level
+         * @return Reference to self (for method chaining)
+         *
+         * Like @ref setStorage(), but only reserves the virtual address
+         * space, no memory is committed. Use @ref commitPages() to make
+         * parts of the texture resident before uploading data to them.
+         * Reading from uncommitted regions gives undefined values, writes to
+         * them are discarded. Mip levels smaller than the page size are
+         * packed into a single *mip tail* that needs to be committed as a
+         * whole, see @ref sparseLevelCount(). Expects that
+         * @extension{ARB,sparse_texture} is available.
+         * @see @ref sparsePageSize(), @fn_gl{TexParameter} with
+         *      @def_gl_extension{TEXTURE_SPARSE,ARB,sparse_texture}, then
+         *      @ref setStorage()
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Texture<dimensions>& setSparseStorage(Int levels, TextureFormat internalFormat, const VectorTypeFor<dimensions, Int>& size) {
+            setSparseStorageInternal<dimensions>(levels, internalFormat, size);
+            return *this;
+        }
+
+        /**
+         * @brief Count of sparse mip levels
+         *
+         * Levels starting from this one are part of the mip tail and have to
+         * be committed together. The result is not cached in any way.
+         * Expects that @extension{ARB,sparse_texture} is available.
+         * @see @ref setSparseStorage(), @fn_gl{ActiveTexture},
+         *      @fn_gl{BindTexture} and @fn_gl{GetTexParameter} with
+         *      @def_gl_extension{NUM_SPARSE_LEVELS,ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Int sparseLevelCount() { return sparseLevelCountInternal(); }
+
+        /**
+         * @brief Commit sparse texture pages
+         * @param level             Mip level
+         * @param range             Range to commit
+         * @return Reference to self (for method chaining)
+         *
+         * Allocates physical memory for pages covering given range. The
+         * range needs to be aligned to @ref sparsePageSize(), except for
+         * regions touching the texture edge. The texture must have storage
+         * allocated with @ref setSparseStorage(). If
+         * @extension{EXT,direct_state_access} desktop extension is not
+         * available, the texture is bound before the operation (if not
+         * already).
+         * @see @ref decommitPages(), @fn_gl_extension{TexturePageCommitment,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_extension{TexPageCommitment,ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Texture<dimensions>& commitPages(Int level, const RangeTypeFor<dimensions, Int>& range) {
+            commitPagesInternal(level, Vector3i::pad(Math::Vector<dimensions, Int>{range.min()}), Vector3i::pad(Math::Vector<dimensions, Int>{range.size()}, 1), true);
+            return *this;
+        }
+
+        /**
+         * @brief Decommit sparse texture pages
+         * @param level             Mip level
+         * @param range             Range to decommit
+         * @return Reference to self (for method chaining)
+         *
+         * Releases physical memory of pages covering given range, the
+         * contents are lost. See @ref commitPages() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Texture<dimensions>& decommitPages(Int level, const RangeTypeFor<dimensions, Int>& range) {
+            commitPagesInternal(level, Vector3i::pad(Math::Vector<dimensions, Int>{range.min()}), Vector3i::pad(Math::Vector<dimensions, Int>{range.size()}, 1), false);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES2
         /**
          * @brief Image size in given mip level
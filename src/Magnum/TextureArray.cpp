@@ -32,6 +32,7 @@
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/BufferImage.h"
 #include "Magnum/Image.h"
+#include "Magnum/Math/Range.h"
 #endif
 
 #include "Implementation/maxTextureSize.h"
@@ -454,6 +454,67 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @copybrief Texture::sparsePageSize()
+         *
+         * See @ref Texture::sparsePageSize() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        static Vector3i sparsePageSize(TextureFormat internalFormat) {
+            return sparsePageSizeInternal(Implementation::textureArrayTarget<dimensions>(), internalFormat);
+        }
+
+        /**
+         * @copybrief Texture::setSparseStorage()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::setSparseStorage() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        TextureArray<dimensions>& setSparseStorage(Int levels, TextureFormat internalFormat, const VectorTypeFor<dimensions+1, Int>& size) {
+            setSparseStorageInternal<dimensions+1>(levels, internalFormat, size);
+            return *this;
+        }
+
+        /**
+         * @copybrief Texture::sparseLevelCount()
+         *
+         * See @ref Texture::sparseLevelCount() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Int sparseLevelCount() { return sparseLevelCountInternal(); }
+
+        /**
+         * @copybrief Texture::commitPages()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::commitPages() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        TextureArray<dimensions>& commitPages(Int level, const RangeTypeFor<dimensions+1, Int>& range) {
+            commitPagesInternal(level, Vector3i::pad(range.min()), Vector3i::pad(range.size(), 1), true);
+            return *this;
+        }
+
+        /**
+         * @copybrief Texture::decommitPages()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::decommitPages() for more information.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        TextureArray<dimensions>& decommitPages(Int level, const RangeTypeFor<dimensions+1, Int>& range) {
+            commitPagesInternal(level, Vector3i::pad(range.min()), Vector3i::pad(range.size(), 1), false);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_WEBGL
         /**
          * @copybrief Texture::imageSize()
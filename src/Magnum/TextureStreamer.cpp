@@ -0,0 +1,158 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Texture.h"
+
+#include "Implementation/State.h"
+#include "Implementation/TextureState.h"
+
+namespace Magnum {
+
+TextureStreamer::TextureStreamer(const std::size_t sliceSize, const UnsignedInt sliceCount): _sliceSize{(sliceSize + 15)/16*16}, _sliceCount{sliceCount}, _mapped{nullptr} {
+    CORRADE_ASSERT(sliceSize && sliceCount, "TextureStreamer::TextureStreamer(): slice size and count must be positive", );
+
+    const std::size_t size = _sliceSize*_sliceCount;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) {
+        _buffer.setStorage({nullptr, size}, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+        _mapped = _buffer.map<char>(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+        CORRADE_INTERNAL_ASSERT(_mapped);
+    } else
+    #endif
+    {
+        _data = Containers::Array<char>{size};
+        _buffer.setData({nullptr, size}, BufferUsage::StreamDraw);
+    }
+
+    /* Popping from the back, so the slices are acquired in order */
+    _free.reserve(sliceCount);
+    for(UnsignedInt i = sliceCount; i != 0; --i) _free.push_back(i - 1);
+}
+
+TextureStreamer::~TextureStreamer() {
+    #ifndef MAGNUM_TARGET_GLES
+    for(const auto& fence: _fences) glDeleteSync(fence.first);
+    #endif
+}
+
+UnsignedInt TextureStreamer::acquire() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _freeCondition.wait(lock, [this]() { return !_free.empty(); });
+    const UnsignedInt slice = _free.back();
+    _free.pop_back();
+    return slice;
+}
+
+UnsignedInt TextureStreamer::tryAcquire() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(_free.empty()) return NoSlice;
+    const UnsignedInt slice = _free.back();
+    _free.pop_back();
+    return slice;
+}
+
+Containers::ArrayView<char> TextureStreamer::sliceData(const UnsignedInt slice) {
+    CORRADE_ASSERT(slice < _sliceCount,
+        "TextureStreamer::sliceData(): index" << slice << "out of range for" << _sliceCount << "slices", {});
+    return {(_mapped ? _mapped : _data.data()) + slice*_sliceSize, _sliceSize};
+}
+
+void TextureStreamer::submit(const UnsignedInt slice, Texture2D& texture, const Int level, const Vector2i& offset, const PixelStorage& storage, const PixelFormat format, const PixelType type, const Vector2i& size) {
+    CORRADE_ASSERT(slice < _sliceCount,
+        "TextureStreamer::submit(): index" << slice << "out of range for" << _sliceCount << "slices", );
+    const std::size_t dataSize = Implementation::imageDataSize(ImageView2D{storage, format, type, size});
+    CORRADE_ASSERT(dataSize <= _sliceSize,
+        "TextureStreamer::submit(): image of" << dataSize << "bytes doesn't fit into a slice of" << _sliceSize << "bytes", );
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    _pending.push_back({slice, &texture, level, offset, storage, format, type, size, dataSize});
+}
+
+void TextureStreamer::release(const UnsignedInt slice) {
+    CORRADE_ASSERT(slice < _sliceCount,
+        "TextureStreamer::release(): index" << slice << "out of range for" << _sliceCount << "slices", );
+    recycle(slice);
+}
+
+UnsignedInt TextureStreamer::update() {
+    #ifndef MAGNUM_TARGET_GLES
+    /* Recycle slices whose uploads are finished. The fences are signaled in
+       order, so stop at the first one that isn't. */
+    while(!_fences.empty() && glClientWaitSync(_fences.front().first, 0, 0) != GL_TIMEOUT_EXPIRED) {
+        glDeleteSync(_fences.front().first);
+        recycle(_fences.front().second);
+        _fences.pop_front();
+    }
+    #endif
+
+    /* Take the pending uploads so the loader threads aren't blocked while
+       the uploads are issued */
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        std::swap(_pending, _issued);
+    }
+
+    const UnsignedInt count = _issued.size();
+    for(Upload& upload: _issued) {
+        const std::size_t offset = upload.slice*_sliceSize;
+        if(!_mapped) _buffer.setSubData(offset, {_data + offset, upload.dataSize});
+
+        /* With a pixel unpack buffer bound, the data pointer is an offset
+           into it */
+        _buffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+        upload.storage.applyUnpack();
+        (upload.texture->*Context::current().state().texture->subImage2DImplementation)(upload.level, upload.offset, upload.size, upload.format, upload.type, reinterpret_cast<const GLvoid*>(offset));
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(_mapped) _fences.emplace_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), upload.slice);
+        else
+        #endif
+        {
+            /* The data were already copied to the buffer */
+            recycle(upload.slice);
+        }
+    }
+
+    _issued.clear();
+    return count;
+}
+
+void TextureStreamer::recycle(const UnsignedInt slice) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _free.push_back(slice);
+    }
+    _freeCondition.notify_one();
+}
+
+}
@@ -0,0 +1,264 @@
+#ifndef Magnum_TextureStreamer_h
+#define Magnum_TextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::TextureStreamer
+ */
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/Math/Vector2.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum {
+
+/**
+@brief Asynchronous texture uploader
+
+Streams pixel data decoded on a loader thread into 2D textures through a pixel
+unpack buffer divided into fixed-size slices. The loader thread writes the
+pixels directly into buffer memory, the render thread then only issues the
+texture uploads from the buffer, which don't block on the data transfer.
+
+## Usage
+
+On the loader thread, acquire a slice, fill it and submit it for upload to
+given texture:
+@code
+TextureStreamer streamer{256*256*4, 8};
+
+// on the loader thread
+UnsignedInt slice = streamer.acquire();
+decodeTile(tile, streamer.sliceData(slice));
+streamer.submit(slice, texture, 0, tileOffset, PixelFormat::RGBA, PixelType::UnsignedByte, {256, 256});
+@endcode
+
+On the render thread, call @ref update() once per frame to issue the pending
+uploads and recycle slices whose uploads were finished:
+@code
+// each frame on the render thread
+streamer.update();
+@endcode
+
+Functions @ref acquire(), @ref tryAcquire(), @ref sliceData(),
+@ref submit() and @ref release() are thread-safe, all other functions
+including the constructor and destructor need to be called from the thread
+with current OpenGL context. The textures must not be destroyed while an
+upload to them is pending.
+
+@anchor TextureStreamer-implementation
+## Implementation
+
+If @extension{ARB,buffer_storage} (part of OpenGL 4.4) is supported, the
+buffer storage is mapped persistently and coherently and the slices point
+directly to the mapped memory. Each upload is followed by a fence sync object
+and @ref update() recycles the slice only after the fence is signaled, without
+ever waiting for it.
+
+Otherwise the slices point to client memory, which is copied to the buffer in
+@ref update() right before the texture upload is issued. The slice is recycled
+right after that.
+
+@see @ref isPersistent(), @ref RingBuffer, @ref TextureTools::MipResidency
+@requires_gles30 Pixel unpack buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Pixel unpack buffers are not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT TextureStreamer {
+    public:
+        /** @brief Value returned by @ref tryAcquire() if no slice is free */
+        enum: UnsignedInt { NoSlice = ~UnsignedInt{} };
+
+        /**
+         * @brief Constructor
+         * @param sliceSize     Size of one slice in bytes
+         * @param sliceCount    Slice count
+         *
+         * Creates the buffer and its storage. The slice size is rounded up to
+         * a multiple of 16 bytes.
+         * @see @ref Buffer::setStorage(), @ref Buffer::map(),
+         *      @ref Buffer::setData()
+         */
+        explicit TextureStreamer(std::size_t sliceSize, UnsignedInt sliceCount);
+
+        /** @brief Copying is not allowed */
+        TextureStreamer(const TextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureStreamer(TextureStreamer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fence sync objects and the buffer. Uploads that
+         * were submitted but not issued by @ref update() are discarded. No
+         * thread may be waiting in @ref acquire() at that point.
+         */
+        ~TextureStreamer();
+
+        /** @brief Copying is not allowed */
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Size of one slice in bytes */
+        std::size_t sliceSize() const { return _sliceSize; }
+
+        /** @brief Slice count */
+        UnsignedInt sliceCount() const { return _sliceCount; }
+
+        /**
+         * @brief Whether the buffer is persistently mapped
+         *
+         * See @ref TextureStreamer-implementation "class documentation" for
+         * more information.
+         */
+        bool isPersistent() const { return _mapped; }
+
+        /**
+         * @brief Acquire a free slice
+         *
+         * Blocks until some slice is free. Slices are recycled only in
+         * @ref update(), so this function must not be called from the render
+         * thread if no slice is free. Thread-safe.
+         * @see @ref tryAcquire()
+         */
+        UnsignedInt acquire();
+
+        /**
+         * @brief Try to acquire a free slice
+         *
+         * Returns @ref NoSlice if there is no free slice. Thread-safe.
+         * @see @ref acquire()
+         */
+        UnsignedInt tryAcquire();
+
+        /**
+         * @brief Slice memory
+         *
+         * Memory to which the pixel data of acquired slice should be written.
+         * Thread-safe.
+         */
+        Containers::ArrayView<char> sliceData(UnsignedInt slice);
+
+        /**
+         * @brief Submit slice for upload
+         * @param slice     Acquired slice
+         * @param texture   Texture to upload to
+         * @param level     Mip level
+         * @param offset    Offset where to put the data in the texture
+         * @param storage   Storage of the data in the slice
+         * @param format    Format of the data
+         * @param type      Type of the data
+         * @param size      Image size
+         *
+         * The upload is issued in the next @ref update() call, the slice is
+         * recycled after the upload is finished. Expects that the image fits
+         * into the slice. Thread-safe.
+         * @see @ref Texture::setSubImage()
+         */
+        void submit(UnsignedInt slice, Texture2D& texture, Int level, const Vector2i& offset, const PixelStorage& storage, PixelFormat format, PixelType type, const Vector2i& size);
+
+        /** @overload
+         * Similar to the above, but uses default @ref PixelStorage parameters.
+         */
+        void submit(UnsignedInt slice, Texture2D& texture, Int level, const Vector2i& offset, PixelFormat format, PixelType type, const Vector2i& size) {
+            submit(slice, texture, level, offset, {}, format, type, size);
+        }
+
+        /**
+         * @brief Release slice without uploading it
+         *
+         * Thread-safe.
+         */
+        void release(UnsignedInt slice);
+
+        /**
+         * @brief Issue pending uploads and recycle finished slices
+         * @return Count of uploads issued
+         *
+         * Call on the render thread, preferably once per frame. Never waits
+         * for OpenGL to finish previous uploads.
+         * @see @fn_gl{FenceSync}, @fn_gl{ClientWaitSync}
+         */
+        UnsignedInt update();
+
+    private:
+        struct Upload {
+            UnsignedInt slice;
+            Texture2D* texture;
+            Int level;
+            Vector2i offset;
+            PixelStorage storage;
+            PixelFormat format;
+            PixelType type;
+            Vector2i size;
+            std::size_t dataSize;
+        };
+
+        void MAGNUM_LOCAL recycle(UnsignedInt slice);
+
+        Buffer _buffer;
+        std::size_t _sliceSize;
+        UnsignedInt _sliceCount;
+
+        /* Persistently mapped memory or client memory copy */
+        char* _mapped;
+        Containers::Array<char> _data;
+
+        /* Shared with the loader threads */
+        std::mutex _mutex;
+        std::condition_variable _freeCondition;
+        std::vector<UnsignedInt> _free;
+        std::deque<Upload> _pending;
+
+        /* Used only by the render thread, kept to avoid reallocations */
+        std::deque<Upload> _issued;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /* Fences protecting slices that are being uploaded */
+        std::deque<std::pair<GLsync, UnsignedInt>> _fences;
+        #endif
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -25,11 +25,133 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
+AtlasPacker::AtlasPacker(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
+    clear();
+}
+
+Float AtlasPacker::occupancy() const {
+    const std::size_t area = std::size_t(_size.x())*std::size_t(_size.y());
+    return area ? Float(_usedArea)/Float(area) : 0.0f;
+}
+
+void AtlasPacker::clear() {
+    _skyline.clear();
+    _skyline.push_back({0, 0, _size.x()});
+    _usedArea = 0;
+}
+
+Int AtlasPacker::fit(std::size_t i, const Vector2i& size) const {
+    /* Doesn't fit horizontally */
+    const Int x = _skyline[i].x;
+    if(x + size.x() > _size.x()) return -1;
+
+    /* The rectangle lies on the highest of all skyline segments it spans */
+    Int y = 0;
+    for(Int widthLeft = size.x(); widthLeft > 0; ++i) {
+        CORRADE_INTERNAL_ASSERT(i < _skyline.size());
+        y = Math::max(y, _skyline[i].y);
+        if(y + size.y() > _size.y()) return -1;
+        widthLeft -= _skyline[i].width;
+    }
+
+    return y;
+}
+
+std::optional<Range2Di> AtlasPacker::add(const Vector2i& size) {
+    const Vector2i paddedSize = size + 2*_padding;
+
+    /* Empty textures don't occupy any space */
+    if(!paddedSize.product()) return Range2Di::fromSize(_padding, size);
+
+    /* Find the lowest position, prefer narrower segments to leave larger
+       spans free for wider textures */
+    std::size_t bestNode = _skyline.size();
+    Int bestTop = _size.y() + 1, bestWidth = _size.x() + 1, bestY = 0;
+    for(std::size_t i = 0; i != _skyline.size(); ++i) {
+        const Int y = fit(i, paddedSize);
+        if(y == -1) continue;
+
+        const Int top = y + paddedSize.y();
+        if(top < bestTop || (top == bestTop && _skyline[i].width < bestWidth)) {
+            bestNode = i;
+            bestTop = top;
+            bestWidth = _skyline[i].width;
+            bestY = y;
+        }
+    }
+
+    /* No space left */
+    if(bestNode == _skyline.size()) return std::nullopt;
+
+    /* Insert new skyline segment on top of the placed texture */
+    const Vector2i position{_skyline[bestNode].x, bestY};
+    _skyline.insert(_skyline.begin() + bestNode, SkylineNode{position.x(), bestTop, paddedSize.x()});
+
+    /* Shrink or remove segments that are now covered by it */
+    for(std::size_t i = bestNode + 1; i < _skyline.size(); ) {
+        const Int previousEnd = _skyline[i - 1].x + _skyline[i - 1].width;
+        if(_skyline[i].x >= previousEnd) break;
+
+        const Int shrink = previousEnd - _skyline[i].x;
+        if(_skyline[i].width <= shrink) {
+            _skyline.erase(_skyline.begin() + i);
+            continue;
+        }
+
+        _skyline[i].x += shrink;
+        _skyline[i].width -= shrink;
+        break;
+    }
+
+    /* Merge neighboring segments of the same height */
+    for(std::size_t i = 1; i < _skyline.size(); ) {
+        if(_skyline[i - 1].y == _skyline[i].y) {
+            _skyline[i - 1].width += _skyline[i].width;
+            _skyline.erase(_skyline.begin() + i);
+        } else ++i;
+    }
+
+    _usedArea += std::size_t(size.x())*std::size_t(size.y());
+    return Range2Di::fromSize(position + _padding, size);
+}
+
+std::vector<Range2Di> AtlasPacker::add(const std::vector<Vector2i>& sizes) {
+    /* Place the tallest textures first */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y() || (sizes[a].y() == sizes[b].y() && sizes[a].x() > sizes[b].x());
+    });
+
+    /* Backup the state so it can be restored on failure */
+    const std::vector<SkylineNode> skyline = _skyline;
+    const std::size_t usedArea = _usedArea;
+
+    std::vector<Range2Di> ranges(sizes.size());
+    for(std::size_t i: order) {
+        std::optional<Range2Di> range = add(sizes[i]);
+        if(!range) {
+            Error() << "TextureTools::AtlasPacker::add(): there is not enough space in" << _size
+                    << "atlas to fit" << sizes.size() << "textures";
+            _skyline = skyline;
+            _usedArea = usedArea;
+            return {};
+        }
+
+        ranges[i] = *range;
+    }
+
+    return ranges;
+}
+
 std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
     if(sizes.empty()) return {};
 
@@ -50,8 +172,6 @@ std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2
         return atlas;
     }
 
-    /** @todo actual magic implementation, not this joke */
-
     atlas.reserve(sizes.size());
     for(std::size_t i = 0; i != sizes.size(); ++i)
         atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
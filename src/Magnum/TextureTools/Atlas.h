@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas()
  */
 
 #include <vector>
@@ -35,8 +35,96 @@
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/TextureTools/visibility.h"
 
+#include "MagnumExternal/Optional/optional.hpp"
+
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Incremental texture atlas packer
+
+Packs rectangles into an atlas of fixed size using the *skyline bottom-left*
+heuristic. Unlike @ref atlas(), which places every texture into an uniform
+grid cell of the largest texture, the packer places each rectangle at the
+lowest position where it fits, which results in a much tighter packing for
+textures of varying size, such as font glyphs.
+
+The packer remembers the occupied space, so textures can be added
+incrementally without repacking the already placed ones:
+@code
+TextureTools::AtlasPacker packer{Vector2i{512}, Vector2i{1}};
+
+std::vector<Range2Di> glyphs = packer.add(glyphSizes);
+// ...
+std::optional<Range2Di> another = packer.add(Vector2i{12, 17});
+Debug() << "Atlas is" << packer.occupancy()*100.0f << "% full";
+@endcode
+
+Padding is added twice to each size and the textures are laid out so the
+padding doesn't overlap. Returned ranges are the same as original sizes, i.e.
+without the padding.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Atlas size
+         * @param padding   Padding around each texture
+         */
+        explicit AtlasPacker(const Vector2i& size, const Vector2i& padding = Vector2i());
+
+        /** @brief Atlas size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Padding around each texture */
+        Vector2i padding() const { return _padding; }
+
+        /**
+         * @brief Occupancy
+         *
+         * Ratio of area of all added textures (without padding) to the atlas
+         * area, in range @f$ [ 0, 1 ] @f$.
+         */
+        Float occupancy() const;
+
+        /**
+         * @brief Add one texture to the atlas
+         *
+         * Returns position of the texture in the atlas or
+         * @ref std::nullopt if there is no space left for it. In that case
+         * the packer state is not modified.
+         */
+        std::optional<Range2Di> add(const Vector2i& size);
+
+        /**
+         * @brief Add more textures to the atlas
+         *
+         * The textures are placed in order of decreasing height, which gives
+         * better results than adding them one by one. Returned ranges are in
+         * the same order as @p sizes. If the textures cannot be packed into
+         * the remaining space, empty vector is returned and the packer state
+         * is not modified.
+         */
+        std::vector<Range2Di> add(const std::vector<Vector2i>& sizes);
+
+        /**
+         * @brief Clear the atlas
+         *
+         * Makes the whole atlas space available again.
+         */
+        void clear();
+
+    private:
+        struct SkylineNode {
+            Int x, y, width;
+        };
+
+        Int MAGNUM_LOCAL fit(std::size_t i, const Vector2i& size) const;
+
+        Vector2i _size, _padding;
+        std::vector<SkylineNode> _skyline;
+        std::size_t _usedArea;
+};
+
 /**
 @brief Pack textures into texture atlas
 @param atlasSize    Size of resulting atlas
@@ -46,6 +134,10 @@ namespace Magnum { namespace TextureTools {
 Packs many small textures into one larger. If the textures cannot be packed
 into required size, empty vector is returned.
 
+The textures are placed into an uniform grid with cell size of the largest
+texture, which wastes a lot of space if the textures have different sizes.
+Use @ref AtlasPacker for tighter and incremental packing.
+
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
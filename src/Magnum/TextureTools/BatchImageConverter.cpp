@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchImageConverter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace TextureTools {
+
+struct BatchImageConverter::State {
+    /* Blocks until the budget allows another conversion. A conversion is
+       always allowed if nothing else is running, otherwise large images
+       would never get converted. */
+    void acquire() {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this]() { return !running || used < budget; });
+        ++running;
+    }
+
+    void reserve(const std::size_t bytes) {
+        std::lock_guard<std::mutex> lock{mutex};
+        used += bytes;
+        peak = std::max(peak, used);
+    }
+
+    void release(const std::size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            used -= bytes;
+            --running;
+        }
+        condition.notify_all();
+    }
+
+    std::string settings;
+    std::size_t budget;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::size_t next{}, running{}, used{}, peak{};
+    std::size_t converted{}, skipped{}, failed{};
+};
+
+std::string BatchImageConverter::levelFilename(const std::string& filename, const UnsignedInt level) {
+    if(!level) return filename;
+
+    /* Search for the extension only in the last path component */
+    const std::size_t slash = filename.rfind('/');
+    const std::size_t dot = filename.rfind('.');
+    const std::string index = '.' + std::to_string(level);
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash) || dot == (slash == std::string::npos ? 0 : slash + 1))
+        return filename + index;
+
+    return filename.substr(0, dot) + index + filename.substr(dot);
+}
+
+BatchImageConverter::BatchImageConverter(PluginManager::Manager<Trade::AbstractImporter>& importerManager, const std::string& importerPlugin, PluginManager::Manager<Trade::AbstractImageConverter>& converterManager, const std::string& converterPlugin, UnsignedInt threadCount): _mipmaps{false}, _skipUpToDate{true}, _filter{DownsampleFilter::Box}, _colorSpace{ColorSpace::Linear}, _memoryBudget{512*1024*1024} {
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _importers.reserve(threadCount);
+    _converters.reserve(threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i) {
+        _importers.push_back(importerManager.instance(importerPlugin));
+        _converters.push_back(converterManager.instance(converterPlugin));
+    }
+}
+
+BatchImageConverter::BatchImageConverter(std::vector<std::unique_ptr<Trade::AbstractImporter>> importers, std::vector<std::unique_ptr<Trade::AbstractImageConverter>> converters): _importers{std::move(importers)}, _converters{std::move(converters)}, _mipmaps{false}, _skipUpToDate{true}, _filter{DownsampleFilter::Box}, _colorSpace{ColorSpace::Linear}, _memoryBudget{512*1024*1024} {
+    CORRADE_ASSERT(!_importers.empty(),
+        "TextureTools::BatchImageConverter: no importers specified", );
+    CORRADE_ASSERT(_importers.size() == _converters.size(),
+        "TextureTools::BatchImageConverter: expected" << _importers.size() << "converters but got" << _converters.size(), );
+}
+
+BatchImageConverter::~BatchImageConverter() = default;
+
+BatchImageConverter& BatchImageConverter::add(const std::string& input, const std::string& output) {
+    _files.emplace_back(input, output);
+    return *this;
+}
+
+BatchImageConverter::Statistics BatchImageConverter::convert() {
+    State state;
+    state.budget = _memoryBudget;
+
+    /* Everything that affects the output goes into the hash together with
+       the input data */
+    state.settings = _converters.front()->plugin();
+    if(_mipmaps) state.settings += ":mipmaps:" + std::to_string(UnsignedInt(_filter)) + ':' + std::to_string(UnsignedInt(_colorSpace));
+
+    /* No need to spawn more threads than there are files */
+    const std::size_t threadCount = std::min(_importers.size(), _files.size());
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for(std::size_t i = 0; i != threadCount; ++i)
+        threads.emplace_back(&BatchImageConverter::work, this, std::ref(state), i);
+    for(std::thread& thread: threads) thread.join();
+
+    _files.clear();
+    return Statistics{state.converted, state.skipped, state.failed, state.peak};
+}
+
+void BatchImageConverter::work(State& state, const std::size_t worker) {
+    Trade::AbstractImporter& importer = *_importers[worker];
+    Trade::AbstractImageConverter& converter = *_converters[worker];
+
+    for(;;) {
+        state.acquire();
+
+        std::size_t id;
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            id = state.next++;
+        }
+        if(id >= _files.size()) {
+            state.release(0);
+            return;
+        }
+
+        const std::string& input = _files[id].first;
+        const std::string& output = _files[id].second;
+
+        /* Read the file upfront, as it's needed for the hash anyway */
+        if(!Utility::Directory::fileExists(input)) {
+            Error() << "TextureTools::BatchImageConverter::convert(): cannot open file" << input;
+            state.release(0);
+            std::lock_guard<std::mutex> lock{state.mutex};
+            ++state.failed;
+            continue;
+        }
+        Containers::Array<char> data = Utility::Directory::read(input);
+        std::size_t memory = data.size();
+        state.reserve(memory);
+
+        Utility::Sha1 sha1;
+        sha1 << std::string{data, data.size()} << state.settings;
+        const std::string hash = sha1.digest().hexString();
+        const std::string hashFilename = output + ".sha1";
+
+        /* Skip if the output was produced from the same data and settings */
+        if(_skipUpToDate && Utility::Directory::fileExists(output) && Utility::Directory::fileExists(hashFilename)) {
+            Containers::Array<char> previous = Utility::Directory::read(hashFilename);
+            if(std::string{previous, previous.size()} == hash) {
+                state.release(memory);
+                std::lock_guard<std::mutex> lock{state.mutex};
+                ++state.skipped;
+                continue;
+            }
+        }
+
+        /* Remove the stale hash so a failed conversion isn't treated as
+           up-to-date later */
+        if(Utility::Directory::fileExists(hashFilename))
+            Utility::Directory::rm(hashFilename);
+
+        bool success = false;
+        if((importer.features() & Trade::AbstractImporter::Feature::OpenData ? importer.openData(data) : importer.openFile(input))) {
+            std::optional<Trade::ImageData2D> image;
+            if(importer.image2DCount()) image = importer.image2D(0);
+            else Error() << "TextureTools::BatchImageConverter::convert(): no image in file" << input;
+            importer.close();
+
+            /* The input data are not needed anymore */
+            data = nullptr;
+
+            if(image) {
+                memory += image->data().size();
+                state.reserve(image->data().size());
+
+                if(image->isCompressed()) {
+                    if(_mipmaps) Error() << "TextureTools::BatchImageConverter::convert(): can't generate mip levels for compressed image" << input;
+                    else success = converter.exportToFile(CompressedImageView2D(*image), output);
+
+                } else if(_mipmaps) {
+                    if(image->type() != PixelType::UnsignedByte || image->pixelSize() < 1 || image->pixelSize() > 4) {
+                        Error() << "TextureTools::BatchImageConverter::convert(): can't generate mip levels for" << image->type() << "image" << input;
+                    } else {
+                        /* The worker pool is already saturated, so generate
+                           the levels single-threaded */
+                        const std::vector<Image2D> levels = generateMipmaps(*image, _filter, _colorSpace, 1);
+                        std::size_t levelMemory = 0;
+                        for(const Image2D& level: levels) levelMemory += level.data().size();
+                        memory += levelMemory;
+                        state.reserve(levelMemory);
+
+                        success = converter.exportToFile(ImageView2D(*image), output);
+                        for(std::size_t i = 0; success && i != levels.size(); ++i)
+                            success = converter.exportToFile(levels[i], levelFilename(output, i + 1));
+                    }
+
+                } else success = converter.exportToFile(ImageView2D(*image), output);
+            }
+        } else Error() << "TextureTools::BatchImageConverter::convert(): cannot import file" << input;
+
+        /* Save the hash only after everything was exported */
+        if(success) success = Utility::Directory::write(hashFilename, Containers::ArrayView<const char>{hash.data(), hash.size()});
+
+        state.release(memory);
+        std::lock_guard<std::mutex> lock{state.mutex};
+        if(success) ++state.converted;
+        else ++state.failed;
+    }
+}
+
+}}
@@ -0,0 +1,268 @@
+#ifndef Magnum_TextureTools_BatchImageConverter_h
+#define Magnum_TextureTools_BatchImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::BatchImageConverter
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <Corrade/PluginManager/PluginManager.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/Mipmap.h"
+#include "Magnum/TextureTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Batch image converter
+
+Imports images with a @ref Trade::AbstractImporter, optionally generates
+their mip chain using @ref generateMipmaps() and exports them with a
+@ref Trade::AbstractImageConverter, processing many images in parallel on a
+pool of worker threads. Each worker owns one importer and one converter
+instance, which are used only by that worker, so any plugins can be used
+even though they are not thread-safe. The instances are created up front on
+the constructing thread, as the plugin manager isn't thread-safe either.
+@code
+PluginManager::Manager<Trade::AbstractImporter> importerManager{MAGNUM_PLUGINS_IMPORTER_DIR};
+PluginManager::Manager<Trade::AbstractImageConverter> converterManager{MAGNUM_PLUGINS_IMAGECONVERTER_DIR};
+TextureTools::BatchImageConverter converter{importerManager, "PngImporter", converterManager, "TgaImageConverter"};
+converter.setMipmapGenerationEnabled(true)
+    .setColorSpace(TextureTools::ColorSpace::Srgb);
+
+for(const std::string& name: names)
+    converter.add(name + ".png", name + ".tga");
+TextureTools::BatchImageConverter::Statistics stats = converter.convert();
+@endcode
+
+## Mip levels
+
+If mip generation is enabled, the base level is exported to the output
+file and each following level to a file with the level index inserted
+before the extension, see @ref levelFilename(). Mip levels can be generated
+only for @ref PixelType::UnsignedByte images with one to four channels,
+conversion of other images fails.
+
+## Memory budget
+
+A worker starts a new conversion only if the memory used by conversions in
+progress is below @ref memoryBudget(), or if no other conversion is in
+progress. The memory includes the input file, the imported image and its mip
+levels. As the size of the imported image isn't known before the import,
+the memory use is bounded by the budget plus memory of one conversion per
+worker.
+
+## Up-to-date outputs
+
+After a successful conversion, a SHA-1 hash of the input file contents and
+of the conversion settings is saved next to the output file, in a file with
+`.sha1` appended to its name. If skipping of up-to-date outputs is enabled
+and the output exists with a matching hash, the conversion is skipped
+without importing the file.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT BatchImageConverter {
+    public:
+        /** @brief Conversion statistics */
+        struct Statistics {
+            std::size_t convertedCount; /**< @brief Converted image count */
+
+            /** @brief Image count skipped because the output was up-to-date */
+            std::size_t skippedCount;
+
+            std::size_t failedCount;    /**< @brief Failed image count */
+
+            /** @brief Peak memory used by conversions in progress */
+            std::size_t peakMemory;
+        };
+
+        /**
+         * @brief Filename of given mip level
+         *
+         * Returns @p filename for level `0`, otherwise inserts the level
+         * index before the extension, e.g. `image.tga` becomes
+         * `image.2.tga` for level `2`. If there is no extension, the level
+         * index is appended.
+         */
+        static std::string levelFilename(const std::string& filename, UnsignedInt level);
+
+        /**
+         * @brief Construct with plugins
+         * @param importerManager   Importer plugin manager
+         * @param importerPlugin    Importer plugin name
+         * @param converterManager  Image converter plugin manager
+         * @param converterPlugin   Image converter plugin name
+         * @param threadCount       Worker thread count. If `0`, count of
+         *      hardware threads is used.
+         *
+         * Instantiates both plugins once for each worker thread. The plugins
+         * are expected to be loaded already.
+         */
+        explicit BatchImageConverter(PluginManager::Manager<Trade::AbstractImporter>& importerManager, const std::string& importerPlugin, PluginManager::Manager<Trade::AbstractImageConverter>& converterManager, const std::string& converterPlugin, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct with plugin instances
+         *
+         * Creates one worker thread for each pair of @p importers and
+         * @p converters. Expects that there is at least one importer, the
+         * same count of converters and that the instances are not used by
+         * anything else.
+         */
+        explicit BatchImageConverter(std::vector<std::unique_ptr<Trade::AbstractImporter>> importers, std::vector<std::unique_ptr<Trade::AbstractImageConverter>> converters);
+
+        /** @brief Copying is not allowed */
+        BatchImageConverter(const BatchImageConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchImageConverter(BatchImageConverter&&) = delete;
+
+        ~BatchImageConverter();
+
+        /** @brief Copying is not allowed */
+        BatchImageConverter& operator=(const BatchImageConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchImageConverter& operator=(BatchImageConverter&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt threadCount() const { return UnsignedInt(_importers.size()); }
+
+        /** @brief Whether mip generation is enabled */
+        bool isMipmapGenerationEnabled() const { return _mipmaps; }
+
+        /**
+         * @brief Enable or disable mip generation
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default.
+         */
+        BatchImageConverter& setMipmapGenerationEnabled(bool enabled) {
+            _mipmaps = enabled;
+            return *this;
+        }
+
+        /** @brief Downsample filter */
+        DownsampleFilter downsampleFilter() const { return _filter; }
+
+        /**
+         * @brief Set downsample filter
+         * @return Reference to self (for method chaining)
+         *
+         * Used only if mip generation is enabled. Default is
+         * @ref DownsampleFilter::Box.
+         */
+        BatchImageConverter& setDownsampleFilter(DownsampleFilter filter) {
+            _filter = filter;
+            return *this;
+        }
+
+        /** @brief Color space of the images */
+        ColorSpace colorSpace() const { return _colorSpace; }
+
+        /**
+         * @brief Set color space of the images
+         * @return Reference to self (for method chaining)
+         *
+         * Used only if mip generation is enabled. Default is
+         * @ref ColorSpace::Linear.
+         */
+        BatchImageConverter& setColorSpace(ColorSpace colorSpace) {
+            _colorSpace = colorSpace;
+            return *this;
+        }
+
+        /** @brief Memory budget in bytes */
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        /**
+         * @brief Set memory budget
+         * @return Reference to self (for method chaining)
+         *
+         * Default is 512 MB, if set to `0`, the images are converted one
+         * after another. See the class documentation for details.
+         */
+        BatchImageConverter& setMemoryBudget(std::size_t bytes) {
+            _memoryBudget = bytes;
+            return *this;
+        }
+
+        /** @brief Whether up-to-date outputs are skipped */
+        bool isSkipUpToDateEnabled() const { return _skipUpToDate; }
+
+        /**
+         * @brief Enable or disable skipping of up-to-date outputs
+         * @return Reference to self (for method chaining)
+         *
+         * Enabled by default.
+         */
+        BatchImageConverter& setSkipUpToDateEnabled(bool enabled) {
+            _skipUpToDate = enabled;
+            return *this;
+        }
+
+        /** @brief Count of images waiting for @ref convert() */
+        std::size_t pendingCount() const { return _files.size(); }
+
+        /**
+         * @brief Add an image
+         * @return Reference to self (for method chaining)
+         *
+         * The first image of @p input is converted to @p output when
+         * @ref convert() is called.
+         */
+        BatchImageConverter& add(const std::string& input, const std::string& output);
+
+        /**
+         * @brief Convert all added images
+         *
+         * Blocks until all images added with @ref add() are converted and
+         * clears the list. Failures are printed to error output, the
+         * conversion of remaining images continues.
+         */
+        Statistics convert();
+
+    private:
+        struct State;
+
+        void work(State& state, std::size_t worker);
+
+        std::vector<std::unique_ptr<Trade::AbstractImporter>> _importers;
+        std::vector<std::unique_ptr<Trade::AbstractImageConverter>> _converters;
+        std::vector<std::pair<std::string, std::string>> _files;
+        bool _mipmaps, _skipUpToDate;
+        DownsampleFilter _filter;
+        ColorSpace _colorSpace;
+        std::size_t _memoryBudget;
+};
+
+}}
+
+#endif
@@ -25,17 +25,28 @@
 
 #include "DistanceField.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
 
 #ifdef MAGNUM_BUILD_STATIC
@@ -212,4 +223,388 @@ void distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangl
     mesh.draw(shader);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+namespace {
+
+class JumpFloodingShader: public AbstractShaderProgram {
+    public:
+        enum class Mode { Seed, Step, Resolve };
+
+        explicit JumpFloodingShader(const Utility::Resource& rs, Version version, Shader& vert, Mode mode);
+
+        JumpFloodingShader& setStepSize(Int size) {
+            setUniform(stepSizeUniform, size);
+            return *this;
+        }
+
+        JumpFloodingShader& setRadius(Int radius) {
+            setUniform(radiusUniform, radius);
+            return *this;
+        }
+
+        JumpFloodingShader& setScaling(const Vector2& scaling) {
+            setUniform(scalingUniform, scaling);
+            return *this;
+        }
+
+        JumpFloodingShader& setOffset(const Vector2& offset) {
+            setUniform(offsetUniform, offset);
+            return *this;
+        }
+
+        JumpFloodingShader& setTexture(Texture2D& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+        JumpFloodingShader& setSeedTexture(Texture2D& texture) {
+            texture.bind(SeedTextureUnit);
+            return *this;
+        }
+
+    private:
+        enum: Int {
+            TextureUnit = 8,
+            SeedTextureUnit = 9
+        };
+
+        Int stepSizeUniform{-1},
+            radiusUniform{-1},
+            scalingUniform{-1},
+            offsetUniform{-1};
+};
+
+JumpFloodingShader::JumpFloodingShader(const Utility::Resource& rs, const Version version, Shader& vert, const Mode mode) {
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    frag.addSource(mode == Mode::Seed ? "#define SEED\n" :
+                   mode == Mode::Step ? "#define STEP\n" : "#define RESOLVE\n")
+        .addSource(rs.get("DistanceFieldJumpFlooding.frag"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(frag.compile());
+
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    if(mode == Mode::Step)
+        stepSizeUniform = uniformLocation("stepSize");
+    if(mode == Mode::Resolve) {
+        radiusUniform = uniformLocation("radius");
+        scalingUniform = uniformLocation("scaling");
+        offsetUniform = uniformLocation("offset");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        if(mode != Mode::Step)
+            setUniform(uniformLocation("textureData"), TextureUnit);
+        if(mode != Mode::Seed)
+            setUniform(uniformLocation("seedData"), SeedTextureUnit);
+    }
+}
+
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void jumpFloodingDistanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, const Int radius, const Vector2i&)
+#else
+void jumpFloodingDistanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, const Int radius, const Vector2i& imageSize)
+#endif
+{
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL330);
+    constexpr Version version = Version::GL330;
+    const Vector2i imageSize = input.imageSize(0);
+    #else
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES300);
+    constexpr Version version = Version::GLES300;
+    #endif
+
+    /* Seed coordinates are stored in 16-bit signed integers */
+    CORRADE_ASSERT((imageSize < Vector2i{32768}).all(),
+        "TextureTools::jumpFloodingDistanceField(): input size" << imageSize << "is too large", );
+
+    Framebuffer framebuffer(rectangle);
+    framebuffer.attachTexture(Framebuffer::ColorAttachment(0), output, 0);
+
+    const Framebuffer::Status status = framebuffer.checkStatus(FramebufferTarget::Draw);
+    if(status != Framebuffer::Status::Complete) {
+        Error() << "TextureTools::jumpFloodingDistanceField(): cannot render to given output texture, unexpected framebuffer status"
+                << status;
+        return;
+    }
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("DistanceFieldShader.vert"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile());
+
+    JumpFloodingShader seedShader{rs, version, vert, JumpFloodingShader::Mode::Seed};
+    JumpFloodingShader stepShader{rs, version, vert, JumpFloodingShader::Mode::Step};
+    JumpFloodingShader resolveShader{rs, version, vert, JumpFloodingShader::Mode::Resolve};
+
+    /* Two seed textures of input size to ping-pong between. Integer textures
+       need nearest filtering to be complete. */
+    Texture2D seeds[2];
+    Framebuffer seedFramebuffers[2]{Framebuffer{{{}, imageSize}}, Framebuffer{{{}, imageSize}}};
+    for(std::size_t i = 0; i != 2; ++i) {
+        seeds[i].setMinificationFilter(Sampler::Filter::Nearest)
+            .setMagnificationFilter(Sampler::Filter::Nearest)
+            .setWrapping(Sampler::Wrapping::ClampToEdge)
+            .setStorage(1, TextureFormat::RGBA16I, imageSize);
+        seedFramebuffers[i].attachTexture(Framebuffer::ColorAttachment(0), seeds[i], 0);
+    }
+
+    /* GLSL 3.30 / ESSL 3.00 has gl_VertexID, no buffer needed */
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(3);
+
+    /* Every pixel is a seed for either the inside or the outside */
+    seedFramebuffers[0].bind();
+    seedShader.setTexture(input);
+    mesh.draw(seedShader);
+
+    /* Seeds propagate at most to a distance of 2*step - 1 in the passes, so
+       start with the smallest power of two that covers the radius. The
+       additional pass with step of one fixes most of the errors the jump
+       flooding makes (the "1+JFA" variant). */
+    Int step = 1;
+    while(2*step - 1 < radius + 1) step *= 2;
+    std::size_t current = 0;
+    for(Int size = step; ; size /= 2) {
+        seedFramebuffers[current ^ 1].bind();
+        stepShader.setStepSize(Math::max(size, 1))
+            .setSeedTexture(seeds[current]);
+        mesh.draw(stepShader);
+        current ^= 1;
+
+        if(size == 0) break;
+    }
+
+    /* Calculate distances to nearest seed of opposite color */
+    framebuffer.bind();
+    resolveShader.setRadius(radius)
+        .setScaling(Vector2(imageSize)/Vector2(rectangle.size()))
+        .setOffset(Vector2(rectangle.min()))
+        .setTexture(input)
+        .setSeedTexture(seeds[current]);
+    mesh.draw(resolveShader);
+}
+#endif
+
+namespace {
+
+constexpr Float DistanceInfinity = 1.0e20f;
+
+/* One-dimensional squared distance transform of sampled function, replacing
+   the values in-place. The d, v, z arrays are scratch space of size at least
+   n, n and n + 1. The envelope intersections are calculated in double
+   precision, as the squared distances are too large for float precision on
+   larger images. Felzenszwalb & Huttenlocher, Algorithm 1. */
+void distanceTransform1D(Float* const f, const std::size_t n, Float* const d, Int* const v, Double* const z) {
+    /* Compute lower envelope of the parabolas rooted at f */
+    std::size_t k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<Double>::infinity();
+    z[1] = std::numeric_limits<Double>::infinity();
+    for(Int q = 1; q < Int(n); ++q) {
+        Double s;
+        for(;;) {
+            const Int p = v[k];
+            s = ((Double(f[q]) + Double(q)*q) - (Double(f[p]) + Double(p)*p))/(2.0*(q - p));
+            if(s > z[k]) break;
+            --k;
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<Double>::infinity();
+    }
+
+    /* Fill in the values of distance transform */
+    k = 0;
+    for(Int q = 0; q < Int(n); ++q) {
+        while(z[k + 1] < q) ++k;
+        const Float dq = Float(q - v[k]);
+        d[q] = dq*dq + f[v[k]];
+    }
+
+    std::copy(d, d + n, f);
+}
+
+/* Squared Euclidean distance of each pixel to nearest feature pixel.
+   Transforms all columns first and then all rows. */
+void distanceTransform(const std::vector<bool>& features, const Vector2i& size, const UnsignedInt threadCount, std::vector<Float>& distances) {
+    for(std::size_t i = 0; i != distances.size(); ++i)
+        distances[i] = features[i] ? 0.0f : DistanceInfinity;
+
+    const std::size_t maxSize = Math::max(size.x(), size.y());
+
+    Magnum::Implementation::parallelFor(size.x(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Float> column(size.y()), d(maxSize);
+        std::vector<Int> v(maxSize);
+        std::vector<Double> z(maxSize + 1);
+        for(std::size_t x = begin; x != end; ++x) {
+            for(std::size_t y = 0; y != std::size_t(size.y()); ++y)
+                column[y] = distances[y*size.x() + x];
+            distanceTransform1D(column.data(), size.y(), d.data(), v.data(), z.data());
+            for(std::size_t y = 0; y != std::size_t(size.y()); ++y)
+                distances[y*size.x() + x] = column[y];
+        }
+    });
+
+    Magnum::Implementation::parallelFor(size.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Float> d(maxSize);
+        std::vector<Int> v(maxSize);
+        std::vector<Double> z(maxSize + 1);
+        for(std::size_t y = begin; y != end; ++y)
+            distanceTransform1D(distances.data() + y*size.x(), size.x(), d.data(), v.data(), z.data());
+    });
+}
+
+/* Binarized red channel of the input */
+std::vector<bool> binarize(const ImageView2D& input) {
+    const Vector2i size = input.size();
+    std::vector<bool> inside(size.product());
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = input.dataProperties();
+    const char* const data = input.data() + offset.sum();
+    for(std::size_t y = 0; y != std::size_t(size.y()); ++y)
+        for(std::size_t x = 0; x != std::size_t(size.x()); ++x)
+            inside[y*size.x() + x] = UnsignedByte(data[y*dataSize.x() + x*pixelSize]) > 127;
+
+    return inside;
+}
+
+/* Save distances of pixels on given side of the edge to one channel of
+   output in the same form as the shader does. Output pixels map to input
+   pixels the same way as in the shader. */
+void saveDistances(const std::vector<bool>& inside, const bool isInside, const std::vector<Float>& distances, const Vector2i& size, const Range2Di& rectangle, const Int radius, char* const data, const std::size_t rowStride, const std::size_t pixelSize) {
+    const Vector2 scaling = Vector2(size)/Vector2(rectangle.size());
+    const Float maxDistance = Float(radius + 1);
+    const Float sign = isInside ? 1.0f : -1.0f;
+
+    for(Int y = rectangle.min().y(); y != rectangle.max().y(); ++y) {
+        for(Int x = rectangle.min().x(); x != rectangle.max().x(); ++x) {
+            const Vector2i position{Vector2(Vector2i{x, y} - rectangle.min())*scaling};
+            const std::size_t i = position.y()*size.x() + position.x();
+            if(inside[i] != isInside) continue;
+
+            const Float distance = Math::min(std::sqrt(distances[i]), maxDistance);
+            const Float value = sign*distance/(2.0f*maxDistance) + 0.5f;
+            data[y*rowStride + x*pixelSize] = char(UnsignedByte(Math::round(Math::clamp(value, 0.0f, 1.0f)*255.0f)));
+        }
+    }
+}
+
+}
+
+void distanceField(const ImageView2D& input, Image2D& output, const Range2Di& rectangle, const Int radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte && output.type() == PixelType::UnsignedByte,
+        "TextureTools::distanceField(): expected images of" << PixelType::UnsignedByte << "but got" << input.type() << "and" << output.type(), );
+    CORRADE_ASSERT(output.data(),
+        "TextureTools::distanceField(): output image data not allocated", );
+    CORRADE_ASSERT((rectangle.min() >= Vector2i{}).all() && (rectangle.max() <= output.size()).all(),
+        "TextureTools::distanceField(): rectangle" << rectangle << "out of bounds of output image of size" << output.size(), );
+
+    const Vector2i size = input.size();
+    if(!size.product() || !rectangle.size().product()) return;
+
+    const std::vector<bool> inside = binarize(input);
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = output.dataProperties();
+    char* const data = output.data() + offset.sum();
+
+    /* Calculate distance to nearest pixel inside for pixels outside and then
+       distance to nearest pixel outside for pixels inside, reusing the
+       memory */
+    std::vector<bool> features(size.product());
+    std::vector<Float> distances(size.product());
+    for(const bool isInside: {false, true}) {
+        for(std::size_t i = 0; i != features.size(); ++i)
+            features[i] = inside[i] != isInside;
+        distanceTransform(features, size, threadCount, distances);
+        saveDistances(inside, isInside, distances, size, rectangle, radius, data, dataSize.x(), pixelSize);
+    }
+}
+
+void multiChannelDistanceField(const ImageView2D& input, Image2D& output, const Range2Di& rectangle, const Int radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte && output.type() == PixelType::UnsignedByte,
+        "TextureTools::multiChannelDistanceField(): expected images of" << PixelType::UnsignedByte << "but got" << input.type() << "and" << output.type(), );
+    CORRADE_ASSERT(output.pixelSize() >= 3,
+        "TextureTools::multiChannelDistanceField(): expected output image with at least three channels but got" << output.format(), );
+    CORRADE_ASSERT(output.data(),
+        "TextureTools::multiChannelDistanceField(): output image data not allocated", );
+    CORRADE_ASSERT((rectangle.min() >= Vector2i{}).all() && (rectangle.max() <= output.size()).all(),
+        "TextureTools::multiChannelDistanceField(): rectangle" << rectangle << "out of bounds of output image of size" << output.size(), );
+
+    const Vector2i size = input.size();
+    if(!size.product() || !rectangle.size().product()) return;
+
+    const std::vector<bool> inside = binarize(input);
+
+    /* Assign channels to edge pixels, i.e. pixels with a 4-neighbor of
+       opposite value, based on direction of the edge normal. The normal is
+       estimated using Sobel operator on the binarized image and divided into
+       three 120° sectors, each sector goes to two channels. Edges on two
+       sides of a sharp corner then fall into different sectors which share
+       only one channel, so the median of the three distances preserves the
+       corner. Edge pixels without any meaningful normal go to all channels. */
+    std::vector<UnsignedByte> channels(size.product());
+    const auto at = [&](Int x, Int y) {
+        x = Math::clamp(x, 0, size.x() - 1);
+        y = Math::clamp(y, 0, size.y() - 1);
+        return inside[y*size.x() + x] ? 1 : 0;
+    };
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const bool value = inside[y*size.x() + x];
+        if(at(x - 1, y) == value && at(x + 1, y) == value &&
+           at(x, y - 1) == value && at(x, y + 1) == value) continue;
+
+        const Int gx = (at(x + 1, y - 1) + 2*at(x + 1, y) + at(x + 1, y + 1)) -
+                       (at(x - 1, y - 1) + 2*at(x - 1, y) + at(x - 1, y + 1));
+        const Int gy = (at(x - 1, y + 1) + 2*at(x, y + 1) + at(x + 1, y + 1)) -
+                       (at(x - 1, y - 1) + 2*at(x, y - 1) + at(x + 1, y - 1));
+        if(!gx && !gy) {
+            channels[y*size.x() + x] = 0x7;
+            continue;
+        }
+
+        const Float angle = std::atan2(Float(gy), Float(gx)) + Constants::pi();
+        const Int sector = Math::min(Int(angle/(2.0f*Constants::pi())*3.0f), 2);
+        channels[y*size.x() + x] = UnsignedByte((1 << sector)|(1 << (sector + 1)%3));
+    }
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = output.dataProperties();
+    char* const data = output.data() + offset.sum();
+
+    /* For each channel calculate the distances the same way as in
+       distanceField(), but only to edge pixels assigned to that channel */
+    std::vector<bool> features(size.product());
+    std::vector<Float> distances(size.product());
+    for(std::size_t channel = 0; channel != 3; ++channel) {
+        for(const bool isInside: {false, true}) {
+            for(std::size_t i = 0; i != features.size(); ++i)
+                features[i] = inside[i] != isInside && (channels[i] & (1 << channel));
+            distanceTransform(features, size, threadCount, distances);
+            saveDistances(inside, isInside, distances, size, rectangle, radius, data + channel, dataSize.x(), pixelSize);
+        }
+    }
+}
+
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::distanceField()
+ * @brief Function @ref Magnum::TextureTools::distanceField(), @ref Magnum::TextureTools::jumpFloodingDistanceField(), @ref Magnum::TextureTools::multiChannelDistanceField()
  */
 
 #ifndef MAGNUM_TARGET_GLES
@@ -99,6 +99,121 @@ void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& outpu
 void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize);
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Create signed distance field using jump flooding
+@param input        Input texture
+@param output       Output texture
+@param rectangle    Rectangle in output texture where to render
+@param radius       Max lookup radius in input texture
+@param imageSize    Input texture size. Needed only in OpenGL ES, in desktop
+    OpenGL the information is gathered automatically using
+    @ref Texture2D::imageSize().
+
+Alternative to @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&)
+producing the same output. Instead of searching all pixels in @p radius for
+each output pixel, coordinates of nearest inside and outside pixel are
+propagated through the input in @f$ \lceil \log_2 (radius + 1) \rceil + 1 @f$
+full-screen passes, thus the cost depends on @p radius only logarithmically.
+That makes large radii cheap and the distance field can be recalculated at
+runtime, which is done by @ref Text::DistanceFieldGlyphCache.
+
+The propagation is done at input resolution in two temporary
+@ref TextureFormat::RGBA16I textures, thus the input size is limited to
+@f$ 32767 @f$ pixels in each direction. Jump flooding may in rare cases pick
+a seed that is not the nearest one, resulting in a slightly larger distance.
+
+Based on: *Guodong Rong, Tiow-Seng Tan - Jump Flooding in GPU with
+Applications to Voronoi Diagram and Distance Transform, I3D 2006,
+http://www.comp.nus.edu.sg/~tants/jfa/i3d06.pdf*
+
+@attention This is GPU-only implementation, so it expects active context.
+
+@requires_gl33 GLSL 3.30 with integer textures.
+@requires_gles30 Integer textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Integer textures are not available in WebGL 1.0.
+*/
+#ifndef MAGNUM_TARGET_GLES
+void MAGNUM_TEXTURETOOLS_EXPORT jumpFloodingDistanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize = Vector2i());
+#else
+void MAGNUM_TEXTURETOOLS_EXPORT jumpFloodingDistanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize);
+#endif
+#endif
+
+/**
+@brief Create signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param rectangle    Rectangle in output image where to render
+@param radius       Max lookup radius in input image
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+CPU alternative to @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&),
+which doesn't need any OpenGL context. Converts binary image (stored in red
+channel of @p input) to signed distance field (stored in red channel in
+@p rectangle of @p output). Both images are expected to be of
+@ref PixelType::UnsignedByte, the @p output image is expected to have its
+data already allocated. See the GPU implementation documentation for more
+information about the resulting values. The only difference is that the GPU
+implementation looks for opposite pixels only in a square area given by
+@p radius, thus it may report slightly larger distances for pixels which are
+farther than @p radius from an edge.
+
+Instead of looking up the nearest pixel of opposite color in the whole
+@p radius for each output pixel, exact Euclidean distance transform of
+the input image is calculated in time linear to pixel count, independently
+of @p radius. The transform is done first for all columns and then for all rows
+of the image, both passes are run in parallel on @p threadCount threads.
+
+Based on: *Pedro F. Felzenszwalb, Daniel P. Huttenlocher - Distance Transforms
+of Sampled Functions, Theory of Computing, Volume 8, 2012,
+http://cs.brown.edu/people/pfelzens/papers/dt-final.pdf*
+*/
+void MAGNUM_TEXTURETOOLS_EXPORT distanceField(const ImageView2D& input, Image2D& output, const Range2Di& rectangle, Int radius, UnsignedInt threadCount = 0);
+
+/**
+@brief Create multi-channel signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param rectangle    Rectangle in output image where to render
+@param radius       Max lookup radius in input image
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+Like @ref distanceField(const ImageView2D&, Image2D&, const Range2Di&, Int, UnsignedInt),
+but saves three distances into red, green and blue channel of @p output, each
+of them measured only to a subset of edges of the input. The @p output image
+is expected to be of @ref PixelType::UnsignedByte with at least three
+channels, the alpha channel, if any, is left untouched. The original value is
+reconstructed by taking median of the three channels, which is done by
+@ref Shaders::DistanceFieldVector with
+@ref Shaders::DistanceFieldVector::Flag::MultiChannel "Flag::MultiChannel".
+
+Compared to single-channel distance field, sharp corners are preserved when
+the result is magnified, so a smaller @p output gives the same visual
+quality.
+
+### The algorithm
+
+Edge pixels are assigned to channels based on direction of the edge normal,
+which is estimated from the binarized input. The normals are divided into
+three sectors, each of them assigned to two channels, so edges on the two
+sides of a sharp corner share only one channel and the median of the three
+distances keeps the corner sharp. Distance to nearest edge pixel of given
+channel is then calculated for each channel the same way as in the
+single-channel variant, thus the operation is roughly three times slower.
+
+Based on: *Viktor Chlumský - Shape Decomposition for Multi-channel Distance
+Fields, Master's thesis, Czech Technical University in Prague, 2015,
+https://github.com/Chlumsky/msdfgen*. The thesis colors edges of the vector
+outline, this function works with binary raster input and colors the edge
+pixels instead, so the corners are reconstructed only approximately.
+*/
+void MAGNUM_TEXTURETOOLS_EXPORT multiChannelDistanceField(const ImageView2D& input, Image2D& output, const Range2Di& rectangle, Int radius, UnsignedInt threadCount = 0);
+
 }}
 
 #endif
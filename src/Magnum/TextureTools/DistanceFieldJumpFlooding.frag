@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Mode is selected by SEED, STEP or RESOLVE defined by the caller. Seed data
+   store coordinates of nearest inside pixel in xy and nearest outside pixel
+   in zw, negative if no such pixel was found yet. */
+
+#if defined(SEED) || defined(RESOLVE)
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 8) uniform lowp sampler2D textureData;
+#else
+uniform lowp sampler2D textureData;
+#endif
+#endif
+
+#if defined(STEP) || defined(RESOLVE)
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 9) uniform highp isampler2D seedData;
+#else
+uniform highp isampler2D seedData;
+#endif
+#endif
+
+#ifdef STEP
+uniform highp int stepSize;
+#endif
+
+#ifdef RESOLVE
+uniform highp int radius;
+uniform highp vec2 scaling;
+uniform highp vec2 offset;
+
+out lowp float value;
+#else
+out highp ivec4 seeds;
+#endif
+
+#ifdef STEP
+highp int distanceSquared(const highp ivec2 a, const highp ivec2 b) {
+    highp ivec2 d = a - b;
+    return d.x*d.x + d.y*d.y;
+}
+#endif
+
+void main() {
+    #ifdef SEED
+    highp ivec2 position = ivec2(gl_FragCoord.xy);
+    if(texelFetch(textureData, position, 0).r > 0.5)
+        seeds = ivec4(position, -1, -1);
+    else
+        seeds = ivec4(-1, -1, position);
+    #elif defined(STEP)
+    highp ivec2 position = ivec2(gl_FragCoord.xy);
+    highp ivec2 size = textureSize(seedData, 0);
+
+    /* Take the nearest inside and outside seed of the eight neighbors in
+       given step distance and of the pixel itself */
+    highp ivec4 nearest = ivec4(-1);
+    highp int nearestInside = 0x7fffffff;
+    highp int nearestOutside = 0x7fffffff;
+    for(int y = -1; y <= 1; ++y) for(int x = -1; x <= 1; ++x) {
+        highp ivec2 neighbor = position + ivec2(x, y)*stepSize;
+        if(any(lessThan(neighbor, ivec2(0))) || any(greaterThanEqual(neighbor, size)))
+            continue;
+
+        highp ivec4 candidate = texelFetch(seedData, neighbor, 0);
+        if(candidate.x >= 0) {
+            highp int d = distanceSquared(candidate.xy, position);
+            if(d < nearestInside) {
+                nearestInside = d;
+                nearest.xy = candidate.xy;
+            }
+        }
+        if(candidate.z >= 0) {
+            highp int d = distanceSquared(candidate.zw, position);
+            if(d < nearestOutside) {
+                nearestOutside = d;
+                nearest.zw = candidate.zw;
+            }
+        }
+    }
+
+    seeds = nearest;
+    #elif defined(RESOLVE)
+    highp ivec2 position = ivec2((gl_FragCoord.xy - vec2(0.5) - offset)*scaling);
+
+    /* If pixel at the position is inside, the distance is measured to the
+       nearest pixel outside and the value will be positive (> 0.5) and vice
+       versa */
+    bool isInside = texelFetch(textureData, position, 0).r > 0.5;
+    highp ivec4 nearest = texelFetch(seedData, position, 0);
+    highp ivec2 opposite = isInside ? nearest.zw : nearest.xy;
+
+    /* Distance just out of the radius if there's no opposite pixel nearby */
+    highp float maxDistance = float(radius + 1);
+    highp float distance = opposite.x < 0 ? maxDistance :
+        min(length(vec2(opposite - position)), maxDistance);
+
+    /* Final signed distance, normalized from [-radius-1, radius+1] to [0, 1] */
+    value = (isInside ? 1.0 : -1.0)*distance/float(radius*2+2)+0.5;
+    #else
+    #error mode not defined
+    #endif
+}
@@ -0,0 +1,415 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EnvironmentFilter.h"
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/CubeMapTexture.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/TimeQuery.h"
+#endif
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importTextureToolResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RCS)
+}
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+enum: Int { TextureUnit = 7 };
+
+/* Max count of samples in one piece of work, to keep the pieces small
+   enough for reasonably fine-grained budgeting */
+constexpr std::size_t MaxPieceSamples = 1 << 22;
+
+/* Face size of the input level used for irradiance calculation */
+constexpr Int IrradianceFaceSize = 32;
+
+Shader createFragmentShader(const Utility::Resource& rs, const Version version, const std::string& file) {
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    frag.addSource(rs.get("EnvironmentFilter.glsl"))
+        .addSource(rs.get(file));
+    return frag;
+}
+
+class EnvironmentFilterShader: public AbstractShaderProgram {
+    public:
+        explicit EnvironmentFilterShader(const Utility::Resource& rs, Version version, Shader& vert, const std::string& file);
+
+    protected:
+        Int uniform(const char* name) { return uniformLocation(name); }
+};
+
+EnvironmentFilterShader::EnvironmentFilterShader(const Utility::Resource& rs, const Version version, Shader& vert, const std::string& file) {
+    Shader frag = createFragmentShader(rs, version, file);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(frag.compile());
+
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        setUniform(uniformLocation("inputTexture"), TextureUnit);
+    }
+}
+
+class PrefilterShader: public EnvironmentFilterShader {
+    public:
+        explicit PrefilterShader(const Utility::Resource& rs, Version version, Shader& vert): EnvironmentFilterShader{rs, version, vert, "EnvironmentFilterShader.frag"},
+            faceUniform{uniform("face")},
+            outputSizeUniform{uniform("outputSize")},
+            inputSizeUniform{uniform("inputSize")},
+            roughnessUniform{uniform("roughness")},
+            sampleCountUniform{uniform("sampleCount")} {}
+
+        PrefilterShader& setFace(Int face) {
+            setUniform(faceUniform, face);
+            return *this;
+        }
+
+        PrefilterShader& setSizes(Int input, Int output) {
+            setUniform(inputSizeUniform, Float(input));
+            setUniform(outputSizeUniform, Float(output));
+            return *this;
+        }
+
+        PrefilterShader& setRoughness(Float roughness) {
+            setUniform(roughnessUniform, roughness);
+            return *this;
+        }
+
+        PrefilterShader& setSampleCount(Int count) {
+            setUniform(sampleCountUniform, count);
+            return *this;
+        }
+
+    private:
+        Int faceUniform,
+            outputSizeUniform,
+            inputSizeUniform,
+            roughnessUniform,
+            sampleCountUniform;
+};
+
+class IrradianceShader: public EnvironmentFilterShader {
+    public:
+        explicit IrradianceShader(const Utility::Resource& rs, Version version, Shader& vert): EnvironmentFilterShader{rs, version, vert, "EnvironmentFilterIrradiance.frag"},
+            faceSizeUniform{uniform("faceSize")},
+            levelUniform{uniform("level")} {}
+
+        IrradianceShader& setLevel(Int level, Int faceSize) {
+            setUniform(levelUniform, Float(level));
+            setUniform(faceSizeUniform, faceSize);
+            return *this;
+        }
+
+    private:
+        Int faceSizeUniform,
+            levelUniform;
+};
+
+Shader createVertexShader(const Utility::Resource& rs, const Version version) {
+    /* The distance field vertex shader is just a full-screen triangle */
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("DistanceFieldShader.vert"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile());
+    return vert;
+}
+
+const Utility::Resource& resources() {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    static const Utility::Resource rs{"MagnumTextureTools"};
+    return rs;
+}
+
+constexpr Version ShaderVersion =
+    #ifndef MAGNUM_TARGET_GLES
+    Version::GL330;
+    #else
+    Version::GLES300;
+    #endif
+
+}
+
+struct EnvironmentFilter::State {
+    /* Either a strip of rows of one face of one output level or, if level is
+       -1, the irradiance calculation */
+    struct Piece {
+        Int level, face, begin, end;
+        std::size_t samples;
+    };
+
+    explicit State(UnsignedInt sampleCount);
+
+    Shader vert;
+    PrefilterShader prefilterShader;
+    IrradianceShader irradianceShader;
+    Mesh mesh;
+    Framebuffer framebuffer;
+    Texture2D irradianceTexture;
+    Framebuffer irradianceFramebuffer;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    TimeQuery query{NoCreate};
+    std::size_t queriedSamples{};
+    bool queryPending{};
+    #endif
+
+    UnsignedInt sampleCount;
+    Float costPerSample{0.1f};
+
+    CubeMapTexture* input{};
+    CubeMapTexture* output{};
+    Int inputSize{}, outputSize{}, levelCount{};
+
+    std::vector<Piece> pieces;
+    std::size_t next{}, totalSamples{}, processedSamples{};
+    std::array<Vector3, 9> irradiance;
+};
+
+EnvironmentFilter::State::State(const UnsignedInt sampleCount): vert{createVertexShader(resources(), ShaderVersion)}, prefilterShader{resources(), ShaderVersion, vert}, irradianceShader{resources(), ShaderVersion, vert}, framebuffer{{{}, {1, 1}}}, irradianceFramebuffer{{{}, {9, 1}}}, sampleCount{sampleCount} {
+    mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(3);
+
+    irradianceTexture.setStorage(1, TextureFormat::RGBA32F, {9, 1});
+    irradianceFramebuffer.attachTexture(Framebuffer::ColorAttachment{0}, irradianceTexture, 0);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+    #else
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+    #endif
+    {
+        query = TimeQuery{TimeQuery::Target::TimeElapsed};
+    }
+    #endif
+}
+
+Vector3 EnvironmentFilter::evaluateIrradiance(const std::array<Vector3, 9>& coefficients, const Vector3& d) {
+    return coefficients[0]*0.282095f +
+        coefficients[1]*(0.488603f*d.y()) +
+        coefficients[2]*(0.488603f*d.z()) +
+        coefficients[3]*(0.488603f*d.x()) +
+        coefficients[4]*(1.092548f*d.x()*d.y()) +
+        coefficients[5]*(1.092548f*d.y()*d.z()) +
+        coefficients[6]*(0.315392f*(3.0f*d.z()*d.z() - 1.0f)) +
+        coefficients[7]*(1.092548f*d.x()*d.z()) +
+        coefficients[8]*(0.546274f*(d.x()*d.x() - d.y()*d.y()));
+}
+
+EnvironmentFilter::EnvironmentFilter(const UnsignedInt sampleCount) {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL330);
+    #else
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES300);
+    #endif
+
+    CORRADE_ASSERT(sampleCount, "TextureTools::EnvironmentFilter: sample count can't be zero", );
+
+    _state.reset(new State{sampleCount});
+}
+
+EnvironmentFilter::EnvironmentFilter(EnvironmentFilter&&) noexcept = default;
+
+EnvironmentFilter::~EnvironmentFilter() = default;
+
+EnvironmentFilter& EnvironmentFilter::operator=(EnvironmentFilter&&) noexcept = default;
+
+UnsignedInt EnvironmentFilter::sampleCount() const { return _state->sampleCount; }
+
+Float EnvironmentFilter::costPerSample() const { return _state->costPerSample; }
+
+EnvironmentFilter& EnvironmentFilter::setCostPerSample(const Float nanoseconds) {
+    _state->costPerSample = nanoseconds;
+    return *this;
+}
+
+void EnvironmentFilter::start(CubeMapTexture& input, const Int inputSize, CubeMapTexture& output, const Int outputSize, const Int levelCount) {
+    CORRADE_ASSERT(inputSize > 0 && outputSize > 0 && levelCount > 0 && (outputSize >> (levelCount - 1)) > 0,
+        "TextureTools::EnvironmentFilter::start(): invalid sizes" << inputSize << outputSize << "or level count" << levelCount, );
+
+    State& state = *_state;
+    state.input = &input;
+    state.output = &output;
+    state.inputSize = inputSize;
+    state.outputSize = outputSize;
+    state.levelCount = levelCount;
+    state.pieces.clear();
+    state.next = 0;
+    state.totalSamples = 0;
+    state.processedSamples = 0;
+
+    /* Split each face of each level into strips of rows */
+    for(Int level = 0; level != levelCount; ++level) {
+        const Int size = outputSize >> level;
+        const std::size_t texelSamples = level ? state.sampleCount : 1;
+        const Int rows = Int(std::max(std::size_t(1), MaxPieceSamples/(std::size_t(size)*texelSamples)));
+        for(Int face = 0; face != 6; ++face) {
+            for(Int begin = 0; begin < size; begin += rows) {
+                const Int end = std::min(begin + rows, size);
+                const std::size_t samples = std::size_t(end - begin)*size*texelSamples;
+                state.pieces.push_back({level, face, begin, end, samples});
+                state.totalSamples += samples;
+            }
+        }
+    }
+
+    /* Irradiance calculation as the last piece */
+    const Int irradianceFaceSize = std::min(inputSize, IrradianceFaceSize);
+    const std::size_t irradianceSamples = 9*6*std::size_t(irradianceFaceSize)*irradianceFaceSize;
+    state.pieces.push_back({-1, 0, 0, 0, irradianceSamples});
+    state.totalSamples += irradianceSamples;
+}
+
+bool EnvironmentFilter::step(const std::chrono::nanoseconds budget) {
+    State& state = *_state;
+    CORRADE_ASSERT(!state.pieces.empty(),
+        "TextureTools::EnvironmentFilter::step(): processing not started", true);
+
+    if(state.next == state.pieces.size()) return true;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Calibrate the cost estimate from the last measurement, if it's
+       already available. Don't start a new measurement while the previous
+       one is still pending. */
+    if(state.queryPending && state.query.resultAvailable()) {
+        const Float measured = Float(state.query.result<UnsignedLong>())/Float(state.queriedSamples);
+        state.costPerSample = state.costPerSample*0.5f + measured*0.5f;
+        state.queryPending = false;
+    }
+    const bool measure = state.query.id() && !state.queryPending;
+    if(measure) state.query.begin();
+    #endif
+
+    /* Always process at least one piece, then continue while the estimated
+       time fits into the budget */
+    const Float budgetNanoseconds = Float(budget.count());
+    Float spent = 0.0f;
+    std::size_t samples = 0;
+    do {
+        const State::Piece& piece = state.pieces[state.next];
+        process(state.next++);
+        spent += Float(piece.samples)*state.costPerSample;
+        samples += piece.samples;
+    } while(state.next != state.pieces.size() &&
+        spent + Float(state.pieces[state.next].samples)*state.costPerSample <= budgetNanoseconds);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(measure) {
+        state.query.end();
+        state.queriedSamples = samples;
+        state.queryPending = true;
+    }
+    #endif
+
+    state.processedSamples += samples;
+    return state.next == state.pieces.size();
+}
+
+void EnvironmentFilter::run(CubeMapTexture& input, const Int inputSize, CubeMapTexture& output, const Int outputSize, const Int levelCount) {
+    start(input, inputSize, output, outputSize, levelCount);
+    while(!step(std::chrono::nanoseconds::max())) {}
+}
+
+bool EnvironmentFilter::isFinished() const {
+    return !_state->pieces.empty() && _state->next == _state->pieces.size();
+}
+
+Float EnvironmentFilter::progress() const {
+    return _state->totalSamples ? Float(_state->processedSamples)/Float(_state->totalSamples) : 0.0f;
+}
+
+const std::array<Vector3, 9>& EnvironmentFilter::irradiance() const {
+    CORRADE_ASSERT(isFinished(),
+        "TextureTools::EnvironmentFilter::irradiance(): processing not finished", _state->irradiance);
+    return _state->irradiance;
+}
+
+void EnvironmentFilter::process(const std::size_t index) {
+    State& state = *_state;
+    const State::Piece& piece = state.pieces[index];
+
+    state.input->bind(TextureUnit);
+
+    /* Irradiance calculation from a coarse input level, reading back the
+       nine coefficients */
+    if(piece.level == -1) {
+        const Int faceSize = std::min(state.inputSize, IrradianceFaceSize);
+        const Int level = Math::log2(UnsignedInt(state.inputSize/faceSize));
+
+        state.irradianceFramebuffer.bind();
+        state.irradianceShader.setLevel(level, faceSize);
+        state.mesh.draw(state.irradianceShader);
+
+        Image2D image = state.irradianceFramebuffer.read({{}, {9, 1}}, {PixelFormat::RGBA, PixelType::Float});
+        const Vector4* const pixels = image.data<Vector4>();
+        for(std::size_t i = 0; i != 9; ++i)
+            state.irradiance[i] = pixels[i].xyz();
+        return;
+    }
+
+    /* Prefiltered level, render the strip */
+    const Int size = state.outputSize >> piece.level;
+    state.framebuffer.attachCubeMapTexture(Framebuffer::ColorAttachment{0}, *state.output, CubeMapCoordinate(GLenum(CubeMapCoordinate::PositiveX) + piece.face), piece.level);
+    state.framebuffer.setViewport({{0, piece.begin}, {size, piece.end}});
+    state.framebuffer.bind();
+
+    state.prefilterShader.setFace(piece.face)
+        .setSizes(state.inputSize, size)
+        .setRoughness(state.levelCount == 1 ? 0.0f : Float(piece.level)/Float(state.levelCount - 1))
+        .setSampleCount(piece.level ? state.sampleCount : 1);
+    state.mesh.draw(state.prefilterShader);
+}
+
+}}
@@ -0,0 +1,236 @@
+#ifndef Magnum_TextureTools_EnvironmentFilter_h
+#define Magnum_TextureTools_EnvironmentFilter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::EnvironmentFilter
+ */
+
+#include <array>
+#include <chrono>
+#include <memory>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/TextureTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Prefiltered environment map generator
+
+Generates a mip chain prefiltered with the GGX distribution for image-based
+lighting from an environment @ref CubeMapTexture, together with spherical
+harmonics coefficients of the diffuse irradiance. Mip level @f$ i @f$ of
+@f$ n @f$ output levels corresponds to roughness @f$ \frac{i}{n - 1} @f$,
+level `0` is thus a plain copy of the input.
+
+The work is split into small pieces (strips of one face of one mip level) that
+can be spread over several frames, so the environment map can be updated
+dynamically, for example for reflection probes rendered at runtime:
+@code
+CubeMapTexture input, output;
+// render the probe into input, then input.generateMipmap()
+output.setStorage(5, TextureFormat::RGBA16F, {128, 128});
+
+TextureTools::EnvironmentFilter filter;
+filter.start(input, 256, output, 128, 5);
+
+// each frame
+if(!filter.isFinished() && filter.step(std::chrono::milliseconds{1})) {
+    std::array<Vector3, 9> irradiance = filter.irradiance();
+    // ...
+}
+@endcode
+
+The @p input texture is expected to have a complete mip chain, which is used
+to reduce sampling noise in higher roughness levels. Both textures have to
+stay alive and unchanged until the processing is finished. If
+@ref Renderer::Feature::SeamlessCubeMapTexture is available, it's recommended
+to enable it to avoid seams in rougher levels.
+
+### Time budget
+
+Each @ref step() issues pieces of work until their estimated GPU time exceeds
+given budget, always at least one. The estimate is based on sample count of
+each piece and a per-sample cost, which is initially set to
+@ref costPerSample() and then calibrated from @ref TimeQuery measurements of
+previous steps, if @extension{ARB,timer_query} (part of OpenGL 3.3) or
+@es_extension{EXT,disjoint_timer_query} is available. The measurements are
+read back only once they are available, so this doesn't cause any pipeline
+stall.
+
+### Irradiance
+
+The last piece of work projects the input onto the first nine real spherical
+harmonics basis functions (bands 0 to 2) and convolves them with the clamped
+cosine lobe, the resulting coefficients thus directly give the irradiance
+@f$ E(\boldsymbol{n}) @f$ for surface normal @f$ \boldsymbol{n} @f$, see
+@ref evaluateIrradiance(). The projection is done on the GPU from a coarse
+mip level of the input, only the nine resulting values are read back. This
+read is synchronous.
+
+Based on: *Brian Karis - Real Shading in Unreal Engine 4, SIGGRAPH 2013* and
+*Ravi Ramamoorthi, Pat Hanrahan - An Efficient Representation for Irradiance
+Environment Maps, SIGGRAPH 2001*.
+
+@attention This is GPU-only implementation, so it expects active context. The
+    processing changes the framebuffer binding and viewport, depth test and
+    blending are expected to be disabled.
+
+@requires_gl33 The implementation uses GLSL 3.30.
+@requires_gles30 Not available in OpenGL ES 2.0. Rendering into the
+    floating-point target used for irradiance calculation requires
+    @es_extension{EXT,color_buffer_float} in OpenGL ES.
+@requires_webgl20 Not available in WebGL 1.0.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT EnvironmentFilter {
+    public:
+        /**
+         * @brief Evaluate irradiance for given direction
+         * @param coefficients  Irradiance coefficients returned by
+         *      @ref irradiance()
+         * @param direction     Normalized direction
+         *
+         * Sums the basis functions weighted with @p coefficients. The same
+         * can be done in a shader.
+         */
+        static Vector3 evaluateIrradiance(const std::array<Vector3, 9>& coefficients, const Vector3& direction);
+
+        /**
+         * @brief Constructor
+         * @param sampleCount   Sample count for each texel of rough levels
+         *
+         * Compiles the shaders. Higher @p sampleCount gives less noisy
+         * results at a higher cost.
+         */
+        explicit EnvironmentFilter(UnsignedInt sampleCount = 64);
+
+        /** @brief Copying is not allowed */
+        EnvironmentFilter(const EnvironmentFilter&) = delete;
+
+        /** @brief Move constructor */
+        EnvironmentFilter(EnvironmentFilter&&) noexcept;
+
+        ~EnvironmentFilter();
+
+        /** @brief Copying is not allowed */
+        EnvironmentFilter& operator=(const EnvironmentFilter&) = delete;
+
+        /** @brief Move assignment */
+        EnvironmentFilter& operator=(EnvironmentFilter&&) noexcept;
+
+        /** @brief Sample count for each texel of rough levels */
+        UnsignedInt sampleCount() const;
+
+        /**
+         * @brief Estimated GPU cost of one sample
+         *
+         * Initial value is `0.1` nanoseconds, calibrated from
+         * measurements during processing if timer queries are available.
+         */
+        Float costPerSample() const;
+
+        /**
+         * @brief Set estimated GPU cost of one sample
+         * @return Reference to self (for method chaining)
+         *
+         * Useful to give a better initial estimate if timer queries are not
+         * available.
+         */
+        EnvironmentFilter& setCostPerSample(Float nanoseconds);
+
+        /**
+         * @brief Start processing
+         * @param input         Input environment map with complete mip chain
+         * @param inputSize     Size of the input face in level `0`
+         * @param output        Output texture with storage of at least
+         *      @p levelCount levels in renderable format
+         * @param outputSize    Size of the output face in level `0`
+         * @param levelCount    Count of output levels to fill
+         *
+         * Discards any unfinished processing. The sizes are passed
+         * explicitly, because texture size queries are not available in
+         * OpenGL ES 3.0.
+         */
+        void start(CubeMapTexture& input, Int inputSize, CubeMapTexture& output, Int outputSize, Int levelCount);
+
+        /**
+         * @brief Process next pieces of work
+         * @return `true` if the processing is finished, `false` otherwise
+         *
+         * Issues pieces of work until their estimated GPU time exceeds
+         * @p budget, at least one. Expects that @ref start() was called. See
+         * @ref TextureTools-EnvironmentFilter-time-budget "class documentation"
+         * for more information.
+         */
+        bool step(std::chrono::nanoseconds budget);
+
+        /**
+         * @brief Process everything at once
+         *
+         * Equivalent to calling @ref start() and then @ref step() with
+         * unlimited budget until the processing is finished.
+         */
+        void run(CubeMapTexture& input, Int inputSize, CubeMapTexture& output, Int outputSize, Int levelCount);
+
+        /** @brief Whether the processing is finished */
+        bool isFinished() const;
+
+        /**
+         * @brief Processing progress
+         *
+         * Ratio of samples processed so far to all samples, in range
+         * @f$ [ 0, 1 ] @f$.
+         */
+        Float progress() const;
+
+        /**
+         * @brief Irradiance coefficients
+         *
+         * Coefficients of spherical harmonics basis functions in order
+         * @f$ Y_{00}, Y_{1-1}, Y_{10}, Y_{11}, Y_{2-2}, Y_{2-1}, Y_{20}, Y_{21}, Y_{22} @f$
+         * for each color channel. Expects that the processing is finished.
+         * @see @ref evaluateIrradiance()
+         */
+        const std::array<Vector3, 9>& irradiance() const;
+
+    private:
+        struct State;
+
+        void process(std::size_t piece);
+
+        std::unique_ptr<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL 1.0 build
+#endif
+
+#endif
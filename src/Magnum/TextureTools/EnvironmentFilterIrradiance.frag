@@ -0,0 +1,76 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define M_PI 3.1415926535897932384626433832795
+
+uniform highp int faceSize;
+uniform highp float level;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 7) uniform highp samplerCube inputTexture;
+#else
+uniform highp samplerCube inputTexture;
+#endif
+
+out highp vec4 coefficient;
+
+/* Real spherical harmonics basis functions of bands 0 to 2 */
+highp float basis(const highp int index, const highp vec3 d) {
+    if(index == 0) return 0.282095;
+    if(index == 1) return 0.488603*d.y;
+    if(index == 2) return 0.488603*d.z;
+    if(index == 3) return 0.488603*d.x;
+    if(index == 4) return 1.092548*d.x*d.y;
+    if(index == 5) return 1.092548*d.y*d.z;
+    if(index == 6) return 0.315392*(3.0*d.z*d.z - 1.0);
+    if(index == 7) return 1.092548*d.x*d.z;
+    return 0.546274*(d.x*d.x - d.y*d.y);
+}
+
+void main() {
+    /* One fragment for each coefficient */
+    highp int index = int(gl_FragCoord.x);
+
+    highp vec3 sum = vec3(0.0);
+    for(highp int face = 0; face != 6; ++face) {
+        for(highp int y = 0; y != faceSize; ++y) {
+            for(highp int x = 0; x != faceSize; ++x) {
+                highp vec2 uv = (vec2(x, y) + vec2(0.5))/float(faceSize)*2.0 - vec2(1.0);
+                highp vec3 direction = cubeMapDirection(face, uv);
+
+                /* Solid angle of the texel, |direction|^2 = 1 + u^2 + v^2 */
+                highp float lengthSquared = dot(direction, direction);
+                highp float solidAngle = 4.0/(float(faceSize*faceSize)*lengthSquared*sqrt(lengthSquared));
+
+                direction *= inversesqrt(lengthSquared);
+                sum += textureLod(inputTexture, direction, level).rgb*basis(index, direction)*solidAngle;
+            }
+        }
+    }
+
+    /* Convolution with the clamped cosine lobe */
+    highp float band = index == 0 ? M_PI : index < 4 ? 2.0*M_PI/3.0 : M_PI/4.0;
+    coefficient = vec4(sum*band, 1.0);
+}
@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define M_PI 3.1415926535897932384626433832795
+
+uniform highp int face;
+uniform highp float outputSize;
+uniform highp float inputSize;
+uniform highp float roughness;
+uniform highp int sampleCount;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 7) uniform highp samplerCube inputTexture;
+#else
+uniform highp samplerCube inputTexture;
+#endif
+
+out highp vec4 color;
+
+/* Low-discrepancy Hammersley point set, radical inverse done by hand as
+   bitfieldReverse() is not available in GLSL 3.30 / ESSL 3.00 */
+highp vec2 hammersley(const highp int i, const highp int count) {
+    highp uint bits = uint(i);
+    bits = (bits << 16u)|(bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u)|((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u)|((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u)|((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u)|((bits & 0xFF00FF00u) >> 8u);
+    return vec2(float(i)/float(count), float(bits)*2.3283064365386963e-10);
+}
+
+/* Half vector distributed according to GGX around the normal */
+highp vec3 importanceSampleGgx(const highp vec2 xi, const highp float alpha, const highp vec3 normal) {
+    highp float phi = 2.0*M_PI*xi.x;
+    highp float cosTheta = sqrt((1.0 - xi.y)/(1.0 + (alpha*alpha - 1.0)*xi.y));
+    highp float sinTheta = sqrt(1.0 - cosTheta*cosTheta);
+
+    highp vec3 up = abs(normal.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    highp vec3 tangentX = normalize(cross(up, normal));
+    highp vec3 tangentY = cross(normal, tangentX);
+    return tangentX*sinTheta*cos(phi) + tangentY*sinTheta*sin(phi) + normal*cosTheta;
+}
+
+void main() {
+    /* View direction is assumed to be equal to the normal */
+    highp vec3 normal = normalize(cubeMapDirection(face, gl_FragCoord.xy/outputSize*2.0 - vec2(1.0)));
+
+    /* Roughness 0 is a perfect mirror, just copy the input */
+    if(roughness == 0.0) {
+        color = vec4(textureLod(inputTexture, normal, 0.0).rgb, 1.0);
+        return;
+    }
+
+    highp float alpha = roughness*roughness;
+    highp float texelSolidAngle = 4.0*M_PI/(6.0*inputSize*inputSize);
+
+    highp vec3 sum = vec3(0.0);
+    highp float weight = 0.0;
+    for(highp int i = 0; i < sampleCount; ++i) {
+        highp vec3 halfVector = importanceSampleGgx(hammersley(i, sampleCount), alpha, normal);
+        highp vec3 light = 2.0*dot(normal, halfVector)*halfVector - normal;
+
+        highp float nDotL = dot(normal, light);
+        if(nDotL <= 0.0) continue;
+
+        /* Filtered importance sampling -- pick input mip level based on
+           the solid angle covered by the sample, reduces the noise */
+        highp float nDotH = max(dot(normal, halfVector), 0.0);
+        highp float d = nDotH*nDotH*(alpha*alpha - 1.0) + 1.0;
+        highp float distribution = alpha*alpha/(M_PI*d*d);
+        /* With view equal to normal, the pdf D*nDotH/(4*vDotH) simplifies */
+        highp float pdf = distribution*0.25 + 0.0001;
+        highp float sampleSolidAngle = 1.0/(float(sampleCount)*pdf);
+        highp float level = max(0.5*log2(sampleSolidAngle/texelSolidAngle) + 1.0, 0.0);
+
+        sum += textureLod(inputTexture, light, level).rgb*nDotL;
+        weight += nDotL;
+    }
+
+    color = vec4(sum/max(weight, 0.0001), 1.0);
+}
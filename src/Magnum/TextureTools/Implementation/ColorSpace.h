@@ -0,0 +1,74 @@
+#ifndef Magnum_TextureTools_Implementation_ColorSpace_h
+#define Magnum_TextureTools_Implementation_ColorSpace_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/ColorBatch.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+inline bool hasAlpha(const PixelFormat format) {
+    switch(format) {
+        case PixelFormat::RGBA:
+        #ifndef MAGNUM_TARGET_WEBGL
+        case PixelFormat::BGRA:
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case PixelFormat::LuminanceAlpha:
+        #endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Converts a row of 8-bit values to linear floats. If the row is sRGB, the
+   color channels are decoded through a lookup table and the last channel is
+   normalized as-is if the format has alpha. */
+inline void decodeRow(const UnsignedByte* const in, Float* const out, const std::size_t size, const std::size_t channelCount, const bool srgb, const bool alpha) {
+    if(srgb) {
+        Math::srgbToLinear({in, size}, {out, size});
+        if(alpha) for(std::size_t i = channelCount - 1; i < size; i += channelCount)
+            out[i] = in[i]/255.0f;
+    } else for(std::size_t i = 0; i != size; ++i) out[i] = in[i]/255.0f;
+}
+
+/* Inverse of decodeRow(), values are clamped to [0, 1] and rounded */
+inline void encodeRow(const Float* const in, UnsignedByte* const out, const std::size_t size, const std::size_t channelCount, const bool srgb, const bool alpha) {
+    if(srgb) {
+        Math::linearToSrgb({in, size}, {out, size});
+        if(alpha) for(std::size_t i = channelCount - 1; i < size; i += channelCount)
+            out[i] = UnsignedByte(Math::round(Math::clamp(in[i], 0.0f, 1.0f)*255.0f));
+    } else for(std::size_t i = 0; i != size; ++i)
+        out[i] = UnsignedByte(Math::round(Math::clamp(in[i], 0.0f, 1.0f)*255.0f));
+}
+
+}}}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MipResidency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+MipResidency::MipResidency(const std::size_t memoryBudget): _memoryBudget{memoryBudget}, _memoryUsage{}, _loadBudget{4}, _frame{}, _levelBias{} {}
+
+UnsignedInt MipResidency::addTexture(const Vector2i& size, const Int levelCount, const std::size_t pixelSize) {
+    CORRADE_ASSERT(size.min() > 0 && levelCount >= 1 && levelCount <= Int(Math::log2(UnsignedInt(size.max()))) + 1,
+        "TextureTools::MipResidency::addTexture(): invalid level count" << levelCount << "for size" << size, {});
+
+    _textures.push_back({size, pixelSize, levelCount, levelCount, levelCount - 1, 0.0f, 0, false, false});
+    return UnsignedInt(_textures.size() - 1);
+}
+
+void MipResidency::removeTexture(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _textures.size() && !_textures[id].removed,
+        "TextureTools::MipResidency::removeTexture(): texture" << id << "doesn't exist", );
+
+    Texture& texture = _textures[id];
+    for(Int level = texture.loading ? texture.baseLevel - 1 : texture.baseLevel; level != texture.levelCount; ++level)
+        _memoryUsage -= levelMemory(id, level);
+    texture.removed = true;
+}
+
+Int MipResidency::levelCount(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::levelCount(): index" << id << "out of range for" << _textures.size() << "textures", {});
+    return _textures[id].levelCount;
+}
+
+Vector2i MipResidency::levelSize(const UnsignedInt id, const Int level) const {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::levelSize(): index" << id << "out of range for" << _textures.size() << "textures", {});
+    return Math::max(_textures[id].size >> level, Vector2i{1});
+}
+
+std::size_t MipResidency::levelMemory(const UnsignedInt id, const Int level) const {
+    const Vector2i size = levelSize(id, level);
+    return std::size_t(size.product())*_textures[id].pixelSize;
+}
+
+Int MipResidency::baseLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::baseLevel(): index" << id << "out of range for" << _textures.size() << "textures", {});
+    return _textures[id].baseLevel;
+}
+
+Int MipResidency::requiredLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::requiredLevel(): index" << id << "out of range for" << _textures.size() << "textures", {});
+    return _textures[id].requiredLevel;
+}
+
+bool MipResidency::isLoading(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::isLoading(): index" << id << "out of range for" << _textures.size() << "textures", {});
+    return _textures[id].loading;
+}
+
+void MipResidency::addCoverage(const UnsignedInt id, const Float pixels) {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::addCoverage(): index" << id << "out of range for" << _textures.size() << "textures", );
+    Texture& texture = _textures[id];
+    texture.coverage = Math::max(texture.coverage, pixels);
+}
+
+void MipResidency::evictLevel(const UnsignedInt id, Changes& changes) {
+    Texture& texture = _textures[id];
+    _memoryUsage -= levelMemory(id, texture.baseLevel);
+    changes.evict.push_back({id, texture.baseLevel});
+    ++texture.baseLevel;
+}
+
+bool MipResidency::evictFor(const std::size_t size, const UnsignedInt except, Changes& changes) {
+    if(_memoryUsage + size <= _memoryBudget) return true;
+
+    /* Only levels finer than required can be evicted. Check that it's
+       possible to make enough space first, so nothing is evicted in vain. */
+    std::size_t evictable = 0;
+    for(std::size_t i = 0; i != _textures.size(); ++i) {
+        const Texture& texture = _textures[i];
+        if(i == except || texture.removed || texture.loading) continue;
+        for(Int level = texture.baseLevel; level < texture.requiredLevel; ++level)
+            evictable += levelMemory(i, level);
+    }
+    if(_memoryUsage + size - evictable > _memoryBudget) return false;
+
+    /* Evict textures that weren't seen for the longest time first, and from
+       those the ones with finest levels */
+    while(_memoryUsage + size > _memoryBudget) {
+        UnsignedInt victim = ~UnsignedInt{};
+        for(std::size_t i = 0; i != _textures.size(); ++i) {
+            const Texture& texture = _textures[i];
+            if(i == except || texture.removed || texture.loading || texture.baseLevel >= texture.requiredLevel) continue;
+
+            if(victim == ~UnsignedInt{} ||
+               texture.lastSeen < _textures[victim].lastSeen ||
+              (texture.lastSeen == _textures[victim].lastSeen && texture.baseLevel < _textures[victim].baseLevel))
+                victim = i;
+        }
+
+        CORRADE_INTERNAL_ASSERT(victim != ~UnsignedInt{});
+        evictLevel(victim, changes);
+    }
+
+    return true;
+}
+
+MipResidency::Changes MipResidency::update() {
+    Changes changes;
+    ++_frame;
+
+    /* Calculate required levels from the coverage */
+    for(Texture& texture: _textures) {
+        if(texture.removed) continue;
+
+        if(texture.coverage > 0.0f) {
+            const Float level = std::floor(std::log2(Float(texture.size.max())/texture.coverage) + _levelBias);
+            texture.requiredLevel = Int(Math::clamp(level, 0.0f, Float(texture.levelCount - 1)));
+            texture.lastSeen = _frame;
+        } else texture.requiredLevel = texture.levelCount - 1;
+
+        texture.coverage = 0.0f;
+    }
+
+    /* The budget might have been lowered since last time */
+    evictFor(0, ~UnsignedInt{}, changes);
+
+    /* Textures with nothing resident first, then the ones with the largest
+       difference between resident and required level */
+    std::vector<std::pair<Int, UnsignedInt>> candidates;
+    for(std::size_t i = 0; i != _textures.size(); ++i) {
+        const Texture& texture = _textures[i];
+        if(texture.removed || texture.loading || texture.baseLevel <= texture.requiredLevel) continue;
+
+        candidates.emplace_back(texture.baseLevel == texture.levelCount ?
+            -std::numeric_limits<Int>::max() : texture.requiredLevel - texture.baseLevel, i);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    UnsignedInt budget = _loadBudget;
+    for(const std::pair<Int, UnsignedInt>& candidate: candidates) {
+        if(!budget) break;
+
+        Texture& texture = _textures[candidate.second];
+        const Int level = texture.baseLevel - 1;
+        const std::size_t size = levelMemory(candidate.second, level);
+
+        /* The coarsest level is loaded always, otherwise make space for the
+           level or postpone it */
+        if(texture.baseLevel != texture.levelCount && !evictFor(size, candidate.second, changes))
+            continue;
+
+        --budget;
+        texture.loading = true;
+        _memoryUsage += size;
+        changes.load.push_back({candidate.second, level});
+    }
+
+    return changes;
+}
+
+void MipResidency::setLevelLoaded(const UnsignedInt id, const Int level) {
+    CORRADE_ASSERT(id < _textures.size(),
+        "TextureTools::MipResidency::setLevelLoaded(): index" << id << "out of range for" << _textures.size() << "textures", );
+
+    Texture& texture = _textures[id];
+    if(texture.removed) return;
+
+    CORRADE_ASSERT(texture.loading && level == texture.baseLevel - 1,
+        "TextureTools::MipResidency::setLevelLoaded(): level" << level << "of texture" << id << "is not being loaded", );
+
+    texture.loading = false;
+    texture.baseLevel = level;
+}
+
+}}
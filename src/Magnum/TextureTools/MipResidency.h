@@ -0,0 +1,315 @@
+#ifndef Magnum_TextureTools_MipResidency_h
+#define Magnum_TextureTools_MipResidency_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::MipResidency
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Coverage-driven mip level residency manager
+
+Decides which mip levels of a set of textures should be resident in memory,
+based on how large the textures appear on the screen, and keeps the total
+memory used by them under a budget. Unlike @ref VirtualTexture, which
+operates on tiles of a single sparse texture, this works with whole mip
+levels of ordinary textures, limiting the sampled range using
+@ref Texture2D::setBaseLevel() and @ref Texture2D::setMaxLevel().
+
+Resident levels of each texture always form a contiguous range from the
+coarsest level up to @ref baseLevel(). Finer levels are loaded one at a time
+and the finest resident level is the first to be evicted, so the texture is
+always complete.
+
+## Usage
+
+Add each texture with the size of its largest level, level count and pixel
+size in bytes. The texture is created with mutable storage and
+@ref Texture2D::setMaxLevel() set to the coarsest level:
+@code
+TextureTools::MipResidency residency{256*1024*1024};
+
+Texture2D texture;
+texture.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+    .setMaxLevel(levelCount - 1);
+UnsignedInt id = residency.addTexture(size, levelCount, 4);
+@endcode
+
+During drawing, report size of the textures on the screen in pixels. If the
+texture is mapped to the object once, it's equal to the screen size of the
+object, which can be calculated for example with
+@ref SceneGraph::LevelOfDetail::screenSize():
+@code
+void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+    _residency.addCoverage(_textureId,
+        _lod->screenSize(transformationMatrix, camera)*camera.viewport().y());
+    // ...
+}
+@endcode
+
+Once a frame call @ref update() and apply the changes. For each evicted level
+raise the base level and drop the level data, for each loaded level allocate
+the level and upload its data, for example asynchronously through
+@ref TextureStreamer. After the upload is issued, call @ref setLevelLoaded()
+and lower the base level:
+@code
+TextureTools::MipResidency::Changes changes = residency.update();
+for(const TextureTools::MipResidency::Level& level: changes.evict) {
+    textures[level.texture].setBaseLevel(level.level + 1)
+        .setImage(level.level, TextureFormat::RGBA8,
+            ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {}});
+}
+for(const TextureTools::MipResidency::Level& level: changes.load) {
+    textures[level.texture].setImage(level.level, TextureFormat::RGBA8,
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte,
+            residency.levelSize(level.texture, level.level)});
+    loader.enqueue(level); // decodes the level and calls streamer.submit()
+}
+
+streamer.update();
+for(const TextureTools::MipResidency::Level& level: loader.submitted()) {
+    residency.setLevelLoaded(level.texture, level.level);
+    textures[level.texture].setBaseLevel(level.level);
+}
+@endcode
+
+## Level selection and budget
+
+The required level is calculated from the largest coverage reported since
+last @ref update() as @f$ \lfloor \log_2 \frac{s}{c} + b \rfloor @f$, where
+@f$ s @f$ is the larger dimension of the texture, @f$ c @f$ is the coverage
+and @f$ b @f$ is @ref levelBias(). Textures with no coverage reported require
+only the coarsest level.
+
+At most @ref loadBudget() levels are loaded in a single @ref update(),
+textures with the largest difference between resident and required level
+first. The coarsest level of each texture is always loaded. If a load would
+exceed @ref memoryBudget(), levels finer than required by other textures are
+evicted first, starting from textures that weren't seen for the longest
+time. If that's not enough, the load is postponed. Levels are not evicted if
+the memory fits into the budget, so textures going out of view and back don't
+need to be loaded again.
+
+The residency logic doesn't need any OpenGL context.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT MipResidency {
+    public:
+        /** @brief Mip level of a texture */
+        struct Level {
+            UnsignedInt texture;    /**< @brief Texture ID */
+            Int level;              /**< @brief Mip level */
+
+            /** @brief Equality comparison */
+            bool operator==(const Level& other) const {
+                return texture == other.texture && level == other.level;
+            }
+
+            /** @brief Non-equality comparison */
+            bool operator!=(const Level& other) const {
+                return !operator==(other);
+            }
+        };
+
+        /**
+         * @brief Residency changes
+         *
+         * @see @ref update()
+         */
+        struct Changes {
+            std::vector<Level> load;    /**< @brief Levels to load */
+            std::vector<Level> evict;   /**< @brief Levels to evict */
+        };
+
+        /**
+         * @brief Constructor
+         * @param memoryBudget  Memory budget in bytes
+         */
+        explicit MipResidency(std::size_t memoryBudget);
+
+        /** @brief Memory budget in bytes */
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        /**
+         * @brief Set memory budget
+         * @return Reference to self (for method chaining)
+         *
+         * If the current memory usage exceeds the new budget, levels are
+         * evicted in the next @ref update().
+         */
+        MipResidency& setMemoryBudget(std::size_t budget) {
+            _memoryBudget = budget;
+            return *this;
+        }
+
+        /** @brief Max count of levels loaded in one @ref update() */
+        UnsignedInt loadBudget() const { return _loadBudget; }
+
+        /**
+         * @brief Set max count of levels loaded in one update
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `4`.
+         */
+        MipResidency& setLoadBudget(UnsignedInt budget) {
+            _loadBudget = budget;
+            return *this;
+        }
+
+        /** @brief Level bias */
+        Float levelBias() const { return _levelBias; }
+
+        /**
+         * @brief Set level bias
+         * @return Reference to self (for method chaining)
+         *
+         * Added to the calculated required level, positive values make the
+         * textures blurrier and save memory. Default is `0.0f`.
+         */
+        MipResidency& setLevelBias(Float bias) {
+            _levelBias = bias;
+            return *this;
+        }
+
+        /**
+         * @brief Memory usage in bytes
+         *
+         * Includes the resident levels and levels that are being loaded.
+         */
+        std::size_t memoryUsage() const { return _memoryUsage; }
+
+        /**
+         * @brief Add texture
+         * @param size          Size of the largest level
+         * @param levelCount    Level count
+         * @param pixelSize     Size of a pixel in bytes
+         * @return Texture ID
+         *
+         * No level is resident initially, the coarsest level is loaded in the
+         * next @ref update(). Expects that @p levelCount is at least `1` and
+         * not larger than the mip chain of @p size.
+         */
+        UnsignedInt addTexture(const Vector2i& size, Int levelCount, std::size_t pixelSize);
+
+        /**
+         * @brief Remove texture
+         *
+         * Memory of its levels is no longer counted, a pending load is
+         * discarded. The ID is not reused.
+         */
+        void removeTexture(UnsignedInt id);
+
+        /** @brief Count of added textures, including removed ones */
+        std::size_t textureCount() const { return _textures.size(); }
+
+        /** @brief Level count of given texture */
+        Int levelCount(UnsignedInt id) const;
+
+        /** @brief Size of given level */
+        Vector2i levelSize(UnsignedInt id, Int level) const;
+
+        /** @brief Memory used by given level in bytes */
+        std::size_t levelMemory(UnsignedInt id, Int level) const;
+
+        /**
+         * @brief Finest resident level
+         *
+         * If no level is resident, returns @ref levelCount().
+         */
+        Int baseLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Level required in last update
+         *
+         * @see @ref update()
+         */
+        Int requiredLevel(UnsignedInt id) const;
+
+        /** @brief Whether a level of given texture is being loaded */
+        bool isLoading(UnsignedInt id) const;
+
+        /**
+         * @brief Add coverage
+         * @param id        Texture ID
+         * @param pixels    Size of the larger texture dimension on the
+         *      screen in pixels
+         *
+         * The largest value reported since last @ref update() is used. Can
+         * be called more than once per frame, for example if the texture is
+         * used by more drawables.
+         */
+        void addCoverage(UnsignedInt id, Float pixels);
+
+        /**
+         * @brief Update residency
+         *
+         * Calculates which levels need to be loaded and evicted based on
+         * coverage reported since last update. Evicted levels are removed
+         * from the internal state immediately, loaded levels are counted in
+         * @ref memoryUsage() but become resident only after
+         * @ref setLevelLoaded() is called. It's up to the caller to apply the
+         * changes to the textures, evicting first. At most one level of each
+         * texture is being loaded at a time.
+         */
+        Changes update();
+
+        /**
+         * @brief Mark level as loaded
+         *
+         * Expects that given level was returned by @ref update() and wasn't
+         * marked as loaded yet. Loads of removed textures are ignored.
+         */
+        void setLevelLoaded(UnsignedInt id, Int level);
+
+    private:
+        struct Texture {
+            Vector2i size;
+            std::size_t pixelSize;
+            Int levelCount, baseLevel, requiredLevel;
+            Float coverage;
+            UnsignedInt lastSeen;
+            bool loading, removed;
+        };
+
+        void evictLevel(UnsignedInt id, Changes& changes);
+        bool evictFor(std::size_t size, UnsignedInt except, Changes& changes);
+
+        std::size_t _memoryBudget, _memoryUsage;
+        UnsignedInt _loadBudget, _frame;
+        Float _levelBias;
+        std::vector<Texture> _textures;
+};
+
+}}
+
+#endif
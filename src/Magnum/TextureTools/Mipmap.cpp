@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Mipmap.h"
+
+#include <cmath>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Implementation/Simd.h"
+#include "Magnum/TextureTools/Implementation/ColorSpace.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Output pixel i is calculated from input pixels 2i + offset + t, t being
+   index into the weights */
+struct Kernel {
+    Int offset;
+    std::vector<Float> weights;
+};
+
+/* Zeroth-order modified Bessel function of the first kind, power series */
+Double besselI0(const Double x) {
+    Double sum = 1.0, term = 1.0;
+    for(Int k = 1; k != 32; ++k) {
+        term *= (x/(2.0*k))*(x/(2.0*k));
+        sum += term;
+    }
+    return sum;
+}
+
+Kernel kernel(const DownsampleFilter filter) {
+    if(filter == DownsampleFilter::Box) return {0, {0.5f, 0.5f}};
+
+    /* Sinc with cutoff at half of the input sampling frequency, windowed with
+       Kaiser window of radius 4 input pixels. Output pixel center is between
+       input pixels 2i and 2i + 1. */
+    constexpr Double Radius = 4.0;
+    constexpr Double Beta = 4.0;
+    Kernel k{-3, std::vector<Float>(8)};
+    Double sum = 0.0;
+    std::vector<Double> weights(8);
+    for(std::size_t t = 0; t != weights.size(); ++t) {
+        const Double x = Double(t) - 3.5;
+        const Double sinc = std::sin(Constantsd::pi()*x/2.0)/(Constantsd::pi()*x/2.0);
+        const Double window = besselI0(Beta*std::sqrt(1.0 - (x/Radius)*(x/Radius)))/besselI0(Beta);
+        weights[t] = sinc*window;
+        sum += weights[t];
+    }
+
+    /* Normalize so flat areas keep their value */
+    for(std::size_t t = 0; t != weights.size(); ++t)
+        k.weights[t] = Float(weights[t]/sum);
+    return k;
+}
+
+/* out = sum of weights[t]*rows[t] for each of size values */
+void weightedSum(const Float* const* const rows, const Float* const weights, const std::size_t count, Float* const out, const std::size_t size) {
+    std::size_t x = 0;
+
+    #if defined(MAGNUM_MATH_SIMD_SSE2)
+    for(; x + 4 <= size; x += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for(std::size_t t = 0; t != count; ++t)
+            sum = Math::Implementation::Simd::multiplyAdd(_mm_set1_ps(weights[t]), _mm_loadu_ps(rows[t] + x), sum);
+        _mm_storeu_ps(out + x, sum);
+    }
+    #elif defined(MAGNUM_MATH_SIMD_NEON)
+    for(; x + 4 <= size; x += 4) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for(std::size_t t = 0; t != count; ++t)
+            sum = vmlaq_n_f32(sum, vld1q_f32(rows[t] + x), weights[t]);
+        vst1q_f32(out + x, sum);
+    }
+    #endif
+
+    for(; x != size; ++x) {
+        Float sum = 0.0f;
+        for(std::size_t t = 0; t != count; ++t)
+            sum += weights[t]*rows[t][x];
+        out[x] = sum;
+    }
+}
+
+}
+
+Debug& operator<<(Debug& debug, const DownsampleFilter value) {
+    switch(value) {
+        #define _c(value) case DownsampleFilter::value: return debug << "TextureTools::DownsampleFilter::" #value;
+        _c(Box)
+        _c(Kaiser)
+        #undef _c
+    }
+
+    return debug << "TextureTools::DownsampleFilter::(invalid)";
+}
+
+Debug& operator<<(Debug& debug, const ColorSpace value) {
+    switch(value) {
+        #define _c(value) case ColorSpace::value: return debug << "TextureTools::ColorSpace::" #value;
+        _c(Linear)
+        _c(Srgb)
+        #undef _c
+    }
+
+    return debug << "TextureTools::ColorSpace::(invalid)";
+}
+
+Image2D downsample(const ImageView2D& image, const DownsampleFilter filter, const ColorSpace colorSpace, UnsignedInt threadCount) {
+    const std::size_t channelCount = image.pixelSize();
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && channelCount >= 1 && channelCount <= 4,
+        "TextureTools::downsample(): expected" << PixelType::UnsignedByte << "image with one to four channels but got" << image.format() << "and" << image.type(),
+        (Image2D{image.format(), image.type()}));
+    CORRADE_ASSERT(image.size().product() && image.data(),
+        "TextureTools::downsample(): expected non-empty image with data",
+        (Image2D{image.format(), image.type()}));
+
+    const Vector2i inputSize = image.size();
+    const Vector2i outputSize = Math::max(inputSize/2, Vector2i{1});
+    const Kernel k = kernel(filter);
+    const std::size_t inputRowSize = inputSize.x()*channelCount;
+
+    /* Color channels are converted from and to sRGB, alpha is kept linear */
+    const bool srgb = colorSpace == ColorSpace::Srgb;
+    const bool alpha = Implementation::hasAlpha(image.format());
+
+    /* Convert the input to tightly packed floats, honoring the storage */
+    std::vector<Float> input(inputSize.product()*channelCount);
+    {
+        Math::Vector2<std::size_t> offset, dataSize;
+        std::size_t pixelSize;
+        std::tie(offset, dataSize, pixelSize) = image.dataProperties();
+        const UnsignedByte* const data = reinterpret_cast<const UnsignedByte*>(image.data() + offset.sum());
+        Magnum::Implementation::parallelFor(inputSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t y = begin; y != end; ++y)
+                Implementation::decodeRow(data + y*dataSize.x(), input.data() + y*inputRowSize, inputRowSize, channelCount, srgb, alpha);
+        });
+    }
+
+    /* Vertical pass, rows are contiguous so this is where most of the
+       bandwidth goes */
+    std::vector<Float> vertical(outputSize.y()*inputRowSize);
+    Magnum::Implementation::parallelFor(outputSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<const Float*> rows(k.weights.size());
+        for(std::size_t y = begin; y != end; ++y) {
+            for(std::size_t t = 0; t != rows.size(); ++t)
+                rows[t] = input.data() + Math::clamp(Int(2*y) + k.offset + Int(t), 0, inputSize.y() - 1)*inputRowSize;
+            weightedSum(rows.data(), k.weights.data(), rows.size(), vertical.data() + y*inputRowSize, inputRowSize);
+        }
+    });
+
+    /* Output keeps the input alignment */
+    const std::size_t alignment = image.storage().alignment();
+    const std::size_t outputRowStride = (outputSize.x()*channelCount + alignment - 1)/alignment*alignment;
+    Containers::Array<char> outputData{Containers::ValueInit, outputRowStride*outputSize.y()};
+
+    /* Horizontal pass and conversion back to bytes */
+    Magnum::Implementation::parallelFor(outputSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Float> row(outputSize.x()*channelCount);
+        for(std::size_t y = begin; y != end; ++y) {
+            const Float* const in = vertical.data() + y*inputRowSize;
+            for(Int x = 0; x != outputSize.x(); ++x) {
+                for(std::size_t c = 0; c != channelCount; ++c) {
+                    Float sum = 0.0f;
+                    for(std::size_t t = 0; t != k.weights.size(); ++t) {
+                        const Int position = Math::clamp(2*x + k.offset + Int(t), 0, inputSize.x() - 1);
+                        sum += k.weights[t]*in[position*channelCount + c];
+                    }
+                    row[x*channelCount + c] = sum;
+                }
+            }
+
+            Implementation::encodeRow(row.data(), reinterpret_cast<UnsignedByte*>(outputData.data()) + y*outputRowStride, row.size(), channelCount, srgb, alpha);
+        }
+    });
+
+    return Image2D{PixelStorage{}.setAlignment(alignment), image.format(), image.type(), outputSize, std::move(outputData)};
+}
+
+std::vector<Image2D> generateMipmaps(const ImageView2D& image, const DownsampleFilter filter, const ColorSpace colorSpace, const UnsignedInt threadCount) {
+    std::vector<Image2D> levels;
+    if(image.size() == Vector2i{1}) return levels;
+
+    levels.push_back(downsample(image, filter, colorSpace, threadCount));
+    while(levels.back().size() != Vector2i{1}) {
+        Image2D next = downsample(levels.back(), filter, colorSpace, threadCount);
+        levels.push_back(std::move(next));
+    }
+
+    return levels;
+}
+
+}}
@@ -0,0 +1,142 @@
+#ifndef Magnum_TextureTools_Mipmap_h
+#define Magnum_TextureTools_Mipmap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::TextureTools::DownsampleFilter, @ref Magnum::TextureTools::ColorSpace, function @ref Magnum::TextureTools::downsample(), @ref Magnum::TextureTools::generateMipmaps()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Downsample filter
+
+@see @ref downsample(), @ref generateMipmaps()
+*/
+enum class DownsampleFilter: UnsignedByte {
+    /**
+     * Average of 2x2 pixel blocks. Fastest, but leaves slight aliasing in
+     * high-frequency content.
+     */
+    Box,
+
+    /**
+     * Separable 8-tap windowed sinc filter with Kaiser window. Keeps the
+     * images noticeably sharper without aliasing, about four times slower
+     * than @ref DownsampleFilter::Box.
+     */
+    Kaiser
+};
+
+/** @debugoperatorenum{Magnum::TextureTools::DownsampleFilter} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, DownsampleFilter value);
+
+/**
+@brief Color space of image data
+
+@see @ref downsample(), @ref generateMipmaps(), @ref srgbToLinear(),
+    @ref linearToSrgb()
+*/
+enum class ColorSpace: UnsignedByte {
+    Linear,     /**< Linear values, filtered directly */
+
+    /**
+     * sRGB-encoded color channels. The color is converted to linear space
+     * before filtering and back to sRGB after, so the downsampled image keeps
+     * the same perceived brightness. Alpha channel, if present, is always
+     * treated as linear. The conversion is done using
+     * @ref Math::srgbToLinear(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>) "Math::srgbToLinear()"
+     * and @ref Math::linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>) "Math::linearToSrgb()",
+     * see also @ref srgbToLinear(const ImageView2D&, UnsignedInt) for
+     * converting whole images.
+     */
+    Srgb
+};
+
+/** @debugoperatorenum{Magnum::TextureTools::ColorSpace} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, ColorSpace value);
+
+/**
+@brief Downsample image to half size
+@param image        Input image
+@param filter       Filter to use
+@param colorSpace   Color space of the image data
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+Returns image with size halved in both dimensions (rounded down, but never
+less than `1`) in the same format as @p image. Expects that the image is of
+@ref PixelType::UnsignedByte with one to four channels, all
+@ref PixelStorage properties of @p image are taken into account. The output
+has the same @ref PixelStorage::alignment() as the input, other storage
+properties are default. The filtering is separable, the vertical pass is
+vectorized if SIMD is enabled in @ref Math and both passes are run in parallel
+on @p threadCount threads. Pixels outside of the image are clamped to the
+edge.
+@see @ref generateMipmaps()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D downsample(const ImageView2D& image, DownsampleFilter filter = DownsampleFilter::Box, ColorSpace colorSpace = ColorSpace::Linear, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate mip chain on the CPU
+@param image        Base level
+@param filter       Filter to use
+@param colorSpace   Color space of the image data
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+Repeatedly calls @ref downsample() until the image has size `1x1` and returns
+all levels except the base one, the first returned image is level `1`. In
+contrast to @ref AbstractTexture::generateMipmap() it doesn't need any
+OpenGL context, so the chain can be created in offline tools, saved together
+with the base level and then uploaded level by level without any stall:
+@code
+Image2D image = ...;
+std::vector<Image2D> levels = TextureTools::generateMipmaps(image,
+    TextureTools::DownsampleFilter::Kaiser, TextureTools::ColorSpace::Srgb);
+
+Texture2D texture;
+texture.setStorage(levels.size() + 1, TextureFormat::SRGB8Alpha8, image.size())
+    .setSubImage(0, {}, image);
+for(std::size_t i = 0; i != levels.size(); ++i)
+    texture.setSubImage(i + 1, {}, levels[i]);
+@endcode
+
+Expects that the image is of @ref PixelType::UnsignedByte with one to four
+channels.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT std::vector<Image2D> generateMipmaps(const ImageView2D& image, DownsampleFilter filter = DownsampleFilter::Box, ColorSpace colorSpace = ColorSpace::Linear, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Srgb.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Implementation/ColorSpace.h"
+
+namespace Magnum { namespace TextureTools {
+
+Image2D srgbToLinear(const ImageView2D& image, UnsignedInt threadCount) {
+    const std::size_t channelCount = image.pixelSize();
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && channelCount >= 1 && channelCount <= 4,
+        "TextureTools::srgbToLinear(): expected" << PixelType::UnsignedByte << "image with one to four channels but got" << image.format() << "and" << image.type(),
+        (Image2D{image.format(), PixelType::Float}));
+    CORRADE_ASSERT(!image.size().product() || image.data(),
+        "TextureTools::srgbToLinear(): expected image with data",
+        (Image2D{image.format(), PixelType::Float}));
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = image.dataProperties();
+    const UnsignedByte* const data = reinterpret_cast<const UnsignedByte*>(image.data() + offset.sum());
+
+    /* Float rows are always four-byte aligned */
+    const std::size_t rowSize = image.size().x()*channelCount;
+    Containers::Array<char> outputData{rowSize*image.size().y()*sizeof(Float)};
+    Float* const output = reinterpret_cast<Float*>(outputData.data());
+
+    const bool alpha = Implementation::hasAlpha(image.format());
+    Magnum::Implementation::parallelFor(image.size().y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y)
+            Implementation::decodeRow(data + y*dataSize.x(), output + y*rowSize, rowSize, channelCount, true, alpha);
+    });
+
+    return Image2D{image.format(), PixelType::Float, image.size(), std::move(outputData)};
+}
+
+Image2D linearToSrgb(const ImageView2D& image, UnsignedInt threadCount) {
+    const std::size_t channelCount = image.pixelSize()/sizeof(Float);
+    CORRADE_ASSERT(image.type() == PixelType::Float && channelCount >= 1 && channelCount <= 4,
+        "TextureTools::linearToSrgb(): expected" << PixelType::Float << "image with one to four channels but got" << image.format() << "and" << image.type(),
+        (Image2D{image.format(), PixelType::UnsignedByte}));
+    CORRADE_ASSERT(!image.size().product() || image.data(),
+        "TextureTools::linearToSrgb(): expected image with data",
+        (Image2D{image.format(), PixelType::UnsignedByte}));
+
+    Math::Vector2<std::size_t> offset, dataSize;
+    std::size_t pixelSize;
+    std::tie(offset, dataSize, pixelSize) = image.dataProperties();
+    const char* const data = image.data() + offset.sum();
+
+    const std::size_t rowSize = image.size().x()*channelCount;
+    Containers::Array<char> outputData{rowSize*image.size().y()};
+    UnsignedByte* const output = reinterpret_cast<UnsignedByte*>(outputData.data());
+
+    const bool alpha = Implementation::hasAlpha(image.format());
+    Magnum::Implementation::parallelFor(image.size().y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y)
+            Implementation::encodeRow(reinterpret_cast<const Float*>(data + y*dataSize.x()), output + y*rowSize, rowSize, channelCount, true, alpha);
+    });
+
+    return Image2D{PixelStorage{}.setAlignment(1), image.format(), PixelType::UnsignedByte, image.size(), std::move(outputData)};
+}
+
+}}
@@ -0,0 +1,80 @@
+#ifndef Magnum_TextureTools_Srgb_h
+#define Magnum_TextureTools_Srgb_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::srgbToLinear(), @ref Magnum::TextureTools::linearToSrgb()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Convert sRGB image to linear floats
+@param image        Input image
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+Expects that the image is of @ref PixelType::UnsignedByte with one to four
+channels, all @ref PixelStorage properties of @p image are taken into
+account. Returns image of the same format and size with @ref PixelType::Float
+and default storage. Color channels are decoded using
+@ref Math::srgbToLinear(Containers::ArrayView<const UnsignedByte>, Containers::ArrayView<Float>) "Math::srgbToLinear()",
+alpha channel, if present, is only normalized. Useful for processing the
+image on the CPU, such as filtering or blending, in linear space:
+@code
+Image2D linear = TextureTools::srgbToLinear(image);
+// process the linear image ...
+Image2D srgb = TextureTools::linearToSrgb(linear);
+@endcode
+@see @ref ColorSpace::Srgb
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D srgbToLinear(const ImageView2D& image, UnsignedInt threadCount = 0);
+
+/**
+@brief Convert image with linear floats to sRGB
+@param image        Input image
+@param threadCount  Count of threads to use. If `0`, the count is
+    given by worker count of @ref TaskScheduler::global() plus the calling
+    thread.
+
+Inverse of @ref srgbToLinear(). Expects that the image is of
+@ref PixelType::Float with one to four channels, all @ref PixelStorage
+properties of @p image are taken into account. Returns image of the same
+format and size with @ref PixelType::UnsignedByte and with
+@ref PixelStorage::alignment() set to `1`. Color channels are encoded using
+@ref Math::linearToSrgb(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedByte>) "Math::linearToSrgb()",
+alpha channel, if present, is only clamped to @f$ [0.0, 1.0] @f$ and
+denormalized.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D linearToSrgb(const ImageView2D& image, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -38,13 +38,31 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+
+    void packer();
+    void packerPadding();
+    void packerIncremental();
+    void packerNoOverlap();
+    void packerEmptySize();
+    void packerFull();
+    void packerTooSmall();
+    void packerClear();
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+
+              &AtlasTest::packer,
+              &AtlasTest::packerPadding,
+              &AtlasTest::packerIncremental,
+              &AtlasTest::packerNoOverlap,
+              &AtlasTest::packerEmptySize,
+              &AtlasTest::packerFull,
+              &AtlasTest::packerTooSmall,
+              &AtlasTest::packerClear});
 }
 
 void AtlasTest::create() {
@@ -93,6 +111,142 @@ void AtlasTest::createTooSmall() {
     CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
 }
 
+void AtlasTest::packer() {
+    AtlasPacker packer{{64, 64}};
+    CORRADE_COMPARE(packer.size(), Vector2i(64, 64));
+    CORRADE_COMPARE(packer.padding(), Vector2i());
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+
+    std::vector<Range2Di> atlas = packer.add(std::vector<Vector2i>{
+        {12, 18},
+        {32, 15},
+        {23, 25}
+    });
+
+    /* Tallest is placed first, the rest is put to the lowest place */
+    CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}));
+    CORRADE_COMPARE(packer.occupancy(), 1271.0f/4096.0f);
+}
+
+void AtlasTest::packerPadding() {
+    AtlasPacker packer{{64, 32}, {2, 1}};
+    CORRADE_COMPARE(packer.padding(), Vector2i(2, 1));
+
+    /* Same input as in createTooSmall(), which fails with the grid layout */
+    std::vector<Range2Di> atlas = packer.add(std::vector<Vector2i>{
+        {8, 16},
+        {21, 13},
+        {19, 29}
+    });
+
+    CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
+        Range2Di::fromSize({25, 1}, {8, 16}),
+        Range2Di::fromSize({37, 1}, {21, 13}),
+        Range2Di::fromSize({2, 1}, {19, 29})}));
+    CORRADE_COMPARE(packer.occupancy(), 952.0f/2048.0f);
+}
+
+void AtlasTest::packerIncremental() {
+    AtlasPacker packer{{64, 64}};
+    packer.add(std::vector<Vector2i>{
+        {12, 18},
+        {32, 15},
+        {23, 25}
+    });
+
+    /* Narrower of the two lowest places is picked */
+    std::optional<Range2Di> a = packer.add({20, 10});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Range2Di::fromSize({0, 25}, {20, 10}));
+
+    std::optional<Range2Di> b = packer.add({64, 20});
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(*b, Range2Di::fromSize({0, 35}, {64, 20}));
+    CORRADE_COMPARE(packer.occupancy(), 2751.0f/4096.0f);
+}
+
+void AtlasTest::packerNoOverlap() {
+    AtlasPacker packer{{256, 256}, {1, 1}};
+
+    std::vector<Vector2i> sizes;
+    for(Int i = 0; i != 150; ++i)
+        sizes.push_back({3 + (i*7)%13, 2 + (i*11)%17});
+
+    std::vector<Range2Di> atlas = packer.add(sizes);
+    CORRADE_COMPARE(atlas.size(), sizes.size());
+
+    for(std::size_t i = 0; i != atlas.size(); ++i) {
+        CORRADE_COMPARE(atlas[i].size(), sizes[i]);
+
+        const Range2Di padded = atlas[i].padded({1, 1});
+        CORRADE_VERIFY((padded.min() >= Vector2i{}).all());
+        CORRADE_VERIFY((padded.max() <= Vector2i{256}).all());
+
+        for(std::size_t j = 0; j != i; ++j) {
+            const Range2Di other = atlas[j].padded({1, 1});
+            CORRADE_VERIFY(!((padded.min() < other.max()).all() && (other.min() < padded.max()).all()));
+        }
+    }
+}
+
+void AtlasTest::packerEmptySize() {
+    AtlasPacker packer{{16, 16}};
+
+    std::optional<Range2Di> a = packer.add({0, 5});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Range2Di::fromSize({}, {0, 5}));
+
+    /* Doesn't occupy any space */
+    std::optional<Range2Di> b = packer.add({16, 16});
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(*b, Range2Di::fromSize({}, {16, 16}));
+    CORRADE_COMPARE(packer.occupancy(), 1.0f);
+}
+
+void AtlasTest::packerFull() {
+    AtlasPacker packer{{16, 16}};
+    CORRADE_VERIFY(packer.add({16, 10}));
+    CORRADE_VERIFY(!packer.add({17, 1}));
+    CORRADE_VERIFY(!packer.add({4, 7}));
+
+    /* Failed insertion doesn't change the state */
+    std::optional<Range2Di> a = packer.add({16, 6});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Range2Di::fromSize({0, 10}, {16, 6}));
+    CORRADE_COMPARE(packer.occupancy(), 1.0f);
+}
+
+void AtlasTest::packerTooSmall() {
+    AtlasPacker packer{{16, 16}};
+    CORRADE_VERIFY(packer.add({10, 10}));
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    CORRADE_VERIFY(packer.add(std::vector<Vector2i>{{6, 16}, {6, 7}}).empty());
+    CORRADE_COMPARE(o.str(), "TextureTools::AtlasPacker::add(): there is not enough space in Vector(16, 16) atlas to fit 2 textures\n");
+
+    /* The state is restored to before the failed batch */
+    std::optional<Range2Di> a = packer.add({6, 16});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Range2Di::fromSize({10, 0}, {6, 16}));
+}
+
+void AtlasTest::packerClear() {
+    AtlasPacker packer{{16, 16}};
+    CORRADE_VERIFY(packer.add({16, 16}));
+    CORRADE_VERIFY(!packer.add({1, 1}));
+
+    packer.clear();
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+
+    std::optional<Range2Di> a = packer.add({1, 1});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Range2Di::fromSize({}, {1, 1}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::TextureTools::Test::AtlasTest)
@@ -0,0 +1,357 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/FileToString.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/BatchImageConverter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct BatchImageConverterTest: TestSuite::Tester {
+    explicit BatchImageConverterTest();
+
+    void construct();
+    void levelFilename();
+
+    void convert();
+    void convertMipmaps();
+    void convertMipmapsUnsupported();
+    void convertFailed();
+
+    void skipUpToDate();
+    void skipUpToDateDisabled();
+    void memoryBudget();
+};
+
+BatchImageConverterTest::BatchImageConverterTest() {
+    addTests({&BatchImageConverterTest::construct,
+              &BatchImageConverterTest::levelFilename,
+
+              &BatchImageConverterTest::convert,
+              &BatchImageConverterTest::convertMipmaps,
+              &BatchImageConverterTest::convertMipmapsUnsupported,
+              &BatchImageConverterTest::convertFailed,
+
+              &BatchImageConverterTest::skipUpToDate,
+              &BatchImageConverterTest::skipUpToDateDisabled,
+              &BatchImageConverterTest::memoryBudget});
+
+    Utility::Directory::mkpath(TEXTURETOOLS_TEST_OUTPUT_DIR);
+}
+
+namespace {
+    /* The first byte is image size, the rest are pixels of a square
+       one-channel image. If the first byte is zero, the image has a float
+       type instead. Counts the files opened. */
+    class Importer: public Trade::AbstractImporter {
+        public:
+            explicit Importer(std::atomic<Int>& openCount): _openCount(openCount) {}
+
+        private:
+            Features doFeatures() const override { return Feature::OpenData; }
+            bool doIsOpened() const override { return !_data.empty(); }
+            void doClose() override { _data = {}; }
+
+            void doOpenData(Containers::ArrayView<const char> data) override {
+                ++_openCount;
+                if(!data.empty() && (!data[0] || std::size_t(data[0])*data[0] + 1 == data.size()))
+                    _data = std::string{data.data(), data.size()};
+            }
+
+            UnsignedInt doImage2DCount() const override { return 1; }
+            std::optional<Trade::ImageData2D> doImage2D(UnsignedInt) override {
+                if(!_data[0])
+                    return Trade::ImageData2D{PixelFormat::Red, PixelType::Float, {1, 1}, Containers::Array<char>{4}};
+
+                const Int size = _data[0];
+                Containers::Array<char> data{std::size_t(size*size)};
+                std::copy(_data.begin() + 1, _data.end(), data.begin());
+                return Trade::ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, {size, size}, std::move(data)};
+            }
+
+            std::string _data;
+            std::atomic<Int>& _openCount;
+    };
+
+    /* Saves the image size and value of the first pixel */
+    class Converter: public Trade::AbstractImageConverter {
+        private:
+            Features doFeatures() const override { return Feature::ConvertData; }
+
+            Containers::Array<char> doExportToData(const ImageView2D& image) override {
+                const std::string out = std::to_string(image.size().x()) + 'x' + std::to_string(image.size().y()) + ':' + std::to_string(Int(UnsignedByte(image.data()[0])));
+                Containers::Array<char> data{out.size()};
+                std::copy(out.begin(), out.end(), data.begin());
+                return data;
+            }
+    };
+
+    std::unique_ptr<BatchImageConverter> converter(std::atomic<Int>& openCount, UnsignedInt count) {
+        std::vector<std::unique_ptr<Trade::AbstractImporter>> importers;
+        std::vector<std::unique_ptr<Trade::AbstractImageConverter>> converters;
+        for(UnsignedInt i = 0; i != count; ++i) {
+            importers.emplace_back(new Importer{openCount});
+            converters.emplace_back(new Converter);
+        }
+        return std::unique_ptr<BatchImageConverter>{new BatchImageConverter{std::move(importers), std::move(converters)}};
+    }
+
+    std::string path(const std::string& filename) {
+        return Utility::Directory::join(TEXTURETOOLS_TEST_OUTPUT_DIR, filename);
+    }
+
+    /* Writes a square image of given size filled with given value */
+    void writeImage(const std::string& filename, const UnsignedByte size, const UnsignedByte value) {
+        std::string data(std::size_t(size)*size + 1, char(value));
+        data[0] = char(size);
+        Utility::Directory::write(path(filename), Containers::ArrayView<const char>{data.data(), data.size()});
+    }
+
+    void removeOutput(const std::string& filename) {
+        for(const std::string& file: {filename, filename + ".sha1", BatchImageConverter::levelFilename(filename, 1), BatchImageConverter::levelFilename(filename, 2)})
+            if(Utility::Directory::fileExists(path(file)))
+                Utility::Directory::rm(path(file));
+    }
+}
+
+void BatchImageConverterTest::construct() {
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 3);
+
+    CORRADE_COMPARE(c->threadCount(), 3);
+    CORRADE_COMPARE(c->pendingCount(), 0);
+    CORRADE_VERIFY(!c->isMipmapGenerationEnabled());
+    CORRADE_VERIFY(c->isSkipUpToDateEnabled());
+    CORRADE_VERIFY(c->downsampleFilter() == DownsampleFilter::Box);
+    CORRADE_VERIFY(c->colorSpace() == ColorSpace::Linear);
+    CORRADE_COMPARE(c->memoryBudget(), std::size_t(512*1024*1024));
+}
+
+void BatchImageConverterTest::levelFilename() {
+    CORRADE_COMPARE(BatchImageConverter::levelFilename("image.tga", 0), "image.tga");
+    CORRADE_COMPARE(BatchImageConverter::levelFilename("image.tga", 3), "image.3.tga");
+    CORRADE_COMPARE(BatchImageConverter::levelFilename("dir.d/image.tar.gz", 1), "dir.d/image.tar.1.gz");
+    CORRADE_COMPARE(BatchImageConverter::levelFilename("dir.d/image", 1), "dir.d/image.1");
+    CORRADE_COMPARE(BatchImageConverter::levelFilename("dir/.hidden", 2), "dir/.hidden.2");
+}
+
+void BatchImageConverterTest::convert() {
+    for(const char* name: {"a.out", "b.out", "c.out", "d.out", "e.out"})
+        removeOutput(name);
+    writeImage("a.in", 4, 'a');
+    writeImage("b.in", 2, 'b');
+    writeImage("c.in", 1, 'c');
+    writeImage("d.in", 3, 'd');
+    writeImage("e.in", 5, 'e');
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 2);
+    for(const char* name: {"a", "b", "c", "d", "e"})
+        c->add(path(name + std::string{".in"}), path(name + std::string{".out"}));
+    CORRADE_COMPARE(c->pendingCount(), 5);
+
+    const BatchImageConverter::Statistics stats = c->convert();
+    CORRADE_COMPARE(c->pendingCount(), 0);
+    CORRADE_COMPARE(stats.convertedCount, 5);
+    CORRADE_COMPARE(stats.skippedCount, 0);
+    CORRADE_COMPARE(stats.failedCount, 0);
+    CORRADE_VERIFY(stats.peakMemory >= 5*5*2 + 1);
+    CORRADE_COMPARE(openCount.load(), 5);
+
+    CORRADE_COMPARE_AS(path("a.out"), "4x4:97", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("b.out"), "2x2:98", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("c.out"), "1x1:99", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("d.out"), "3x3:100", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("e.out"), "5x5:101", TestSuite::Compare::FileToString);
+    CORRADE_VERIFY(Utility::Directory::fileExists(path("a.out.sha1")));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(path("a.1.out")));
+}
+
+void BatchImageConverterTest::convertMipmaps() {
+    removeOutput("mips.out");
+    writeImage("mips.in", 4, 200);
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 1);
+    c->setMipmapGenerationEnabled(true)
+        .add(path("mips.in"), path("mips.out"));
+
+    const BatchImageConverter::Statistics stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(stats.failedCount, 0);
+
+    /* Constant image stays constant in all levels */
+    CORRADE_COMPARE_AS(path("mips.out"), "4x4:200", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("mips.1.out"), "2x2:200", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(path("mips.2.out"), "1x1:200", TestSuite::Compare::FileToString);
+}
+
+void BatchImageConverterTest::convertMipmapsUnsupported() {
+    removeOutput("float.out");
+    std::string data(1, '\0');
+    Utility::Directory::write(path("float.in"), Containers::ArrayView<const char>{data.data(), data.size()});
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 1);
+    c->setMipmapGenerationEnabled(true)
+        .add(path("float.in"), path("float.out"));
+
+    std::ostringstream out;
+    BatchImageConverter::Statistics stats;
+    {
+        Error redirectError{&out};
+        stats = c->convert();
+    }
+    CORRADE_COMPARE(stats.convertedCount, 0);
+    CORRADE_COMPARE(stats.failedCount, 1);
+    CORRADE_COMPARE(out.str(), "TextureTools::BatchImageConverter::convert(): can't generate mip levels for PixelType::Float image " + path("float.in") + "\n");
+    CORRADE_VERIFY(!Utility::Directory::fileExists(path("float.out")));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(path("float.out.sha1")));
+}
+
+void BatchImageConverterTest::convertFailed() {
+    removeOutput("ok.out");
+    removeOutput("broken.out");
+    writeImage("ok.in", 2, 1);
+    Utility::Directory::write(path("broken.in"), Containers::ArrayView<const char>{"\x05\x01", 2});
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 2);
+    c->add(path("nonexistent.in"), path("nonexistent.out"))
+        .add(path("broken.in"), path("broken.out"))
+        .add(path("ok.in"), path("ok.out"));
+
+    std::ostringstream out;
+    BatchImageConverter::Statistics stats;
+    {
+        Error redirectError{&out};
+        stats = c->convert();
+    }
+
+    /* The remaining images are converted */
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(stats.failedCount, 2);
+    CORRADE_VERIFY(out.str().find("TextureTools::BatchImageConverter::convert(): cannot open file " + path("nonexistent.in") + "\n") != std::string::npos);
+    CORRADE_VERIFY(!Utility::Directory::fileExists(path("broken.out")));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(path("broken.out.sha1")));
+    CORRADE_COMPARE_AS(path("ok.out"), "2x2:1", TestSuite::Compare::FileToString);
+}
+
+void BatchImageConverterTest::skipUpToDate() {
+    removeOutput("skip.out");
+    writeImage("skip.in", 2, 10);
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 2);
+    c->add(path("skip.in"), path("skip.out"));
+    CORRADE_COMPARE(c->convert().convertedCount, 1);
+    CORRADE_COMPARE(openCount.load(), 1);
+
+    /* Same data and settings, nothing is imported */
+    c->add(path("skip.in"), path("skip.out"));
+    BatchImageConverter::Statistics stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 0);
+    CORRADE_COMPARE(stats.skippedCount, 1);
+    CORRADE_COMPARE(openCount.load(), 1);
+
+    /* Changed settings */
+    c->setMipmapGenerationEnabled(true)
+        .add(path("skip.in"), path("skip.out"));
+    stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(stats.skippedCount, 0);
+    CORRADE_COMPARE(openCount.load(), 2);
+    CORRADE_COMPARE_AS(path("skip.1.out"), "1x1:10", TestSuite::Compare::FileToString);
+
+    /* Changed data */
+    writeImage("skip.in", 2, 11);
+    c->add(path("skip.in"), path("skip.out"));
+    stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(openCount.load(), 3);
+    CORRADE_COMPARE_AS(path("skip.out"), "2x2:11", TestSuite::Compare::FileToString);
+
+    /* Removed output */
+    Utility::Directory::rm(path("skip.out"));
+    c->add(path("skip.in"), path("skip.out"));
+    stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(openCount.load(), 4);
+    CORRADE_VERIFY(Utility::Directory::fileExists(path("skip.out")));
+}
+
+void BatchImageConverterTest::skipUpToDateDisabled() {
+    removeOutput("force.out");
+    writeImage("force.in", 2, 10);
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 1);
+    c->add(path("force.in"), path("force.out"));
+    CORRADE_COMPARE(c->convert().convertedCount, 1);
+
+    c->setSkipUpToDateEnabled(false)
+        .add(path("force.in"), path("force.out"));
+    const BatchImageConverter::Statistics stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 1);
+    CORRADE_COMPARE(stats.skippedCount, 0);
+    CORRADE_COMPARE(openCount.load(), 2);
+}
+
+void BatchImageConverterTest::memoryBudget() {
+    for(const char* name: {"budget0.out", "budget1.out", "budget2.out", "budget3.out"})
+        removeOutput(name);
+    for(const char* name: {"budget0.in", "budget1.in", "budget2.in", "budget3.in"})
+        writeImage(name, 4, 1);
+
+    std::atomic<Int> openCount{0};
+    std::unique_ptr<BatchImageConverter> c = converter(openCount, 4);
+    c->setMemoryBudget(0);
+    for(const char* name: {"budget0", "budget1", "budget2", "budget3"})
+        c->add(path(name + std::string{".in"}), path(name + std::string{".out"}));
+
+    /* With zero budget the conversions are done one after another, so the
+       peak is the input file and the imported image of one conversion */
+    const BatchImageConverter::Statistics stats = c->convert();
+    CORRADE_COMPARE(stats.convertedCount, 4);
+    CORRADE_COMPARE(stats.peakMemory, 17 + 16);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::BatchImageConverterTest)
@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/DistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct DistanceFieldTest: TestSuite::Tester {
+    explicit DistanceFieldTest();
+
+    void cpu();
+    void cpuThreads();
+    void cpuRectangleOutOfBounds();
+
+    void multiChannel();
+    void multiChannelThreads();
+    void multiChannelInvalidFormat();
+};
+
+DistanceFieldTest::DistanceFieldTest() {
+    addTests({&DistanceFieldTest::cpu,
+              &DistanceFieldTest::cpuThreads,
+              &DistanceFieldTest::cpuRectangleOutOfBounds,
+
+              &DistanceFieldTest::multiChannel,
+              &DistanceFieldTest::multiChannelThreads,
+              &DistanceFieldTest::multiChannelInvalidFormat});
+}
+
+namespace {
+
+/* Disc and a thin bar, 48x32 pixels */
+std::vector<char> inputData() {
+    std::vector<char> data(48*32);
+    for(Int y = 0; y != 32; ++y) for(Int x = 0; x != 48; ++x) {
+        const bool inside = (Vector2i{x, y} - Vector2i{16, 16}).dot() < 100 ||
+            (x >= 30 && x < 44 && y >= 20 && y < 22);
+        data[y*48 + x] = inside ? char(255) : 0;
+    }
+    return data;
+}
+
+/* Square in the middle, 32x32 pixels */
+std::vector<char> squareData() {
+    std::vector<char> data(32*32);
+    for(Int y = 0; y != 32; ++y) for(Int x = 0; x != 32; ++x)
+        data[y*32 + x] = x >= 8 && x < 24 && y >= 8 && y < 24 ? char(255) : 0;
+    return data;
+}
+
+/* Brute-force lookup of nearest pixel with opposite value */
+std::vector<UnsignedByte> reference(const std::vector<char>& input, const Vector2i& inputSize, const Vector2i& outputSize, const Int radius) {
+    std::vector<UnsignedByte> out(outputSize.product());
+    const Vector2 scaling = Vector2(inputSize)/Vector2(outputSize);
+    for(Int y = 0; y != outputSize.y(); ++y) for(Int x = 0; x != outputSize.x(); ++x) {
+        const Vector2i position{Vector2{Vector2i{x, y}}*scaling};
+        const bool isInside = input[position.y()*inputSize.x() + position.x()] != 0;
+        Float distance = Float(radius + 1);
+        for(Int yy = 0; yy != inputSize.y(); ++yy) for(Int xx = 0; xx != inputSize.x(); ++xx)
+            if((input[yy*inputSize.x() + xx] != 0) != isInside)
+                distance = Math::min(distance, std::sqrt(Float((Vector2i{xx, yy} - position).dot())));
+
+        const Float value = (isInside ? 1.0f : -1.0f)*distance/Float(2*radius + 2) + 0.5f;
+        out[y*outputSize.x() + x] = UnsignedByte(Math::round(value*255.0f));
+    }
+    return out;
+}
+
+}
+
+void DistanceFieldTest::cpu() {
+    const std::vector<char> input = inputData();
+    Image2D output{PixelFormat::Red, PixelType::UnsignedByte, {24, 16}, Containers::Array<char>(24*16)};
+    distanceField(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {48, 32}, {input.data(), input.size()}}, output, {{}, {24, 16}}, 4, 1);
+
+    const std::vector<UnsignedByte> expected = reference(input, {48, 32}, {24, 16}, 4);
+    CORRADE_COMPARE(std::vector<UnsignedByte>(output.data<UnsignedByte>(), output.data<UnsignedByte>() + 24*16), expected);
+}
+
+void DistanceFieldTest::cpuThreads() {
+    const std::vector<char> input = inputData();
+    const ImageView2D inputView{PixelFormat::Red, PixelType::UnsignedByte, {48, 32}, {input.data(), input.size()}};
+
+    /* Rendering into part of the output only, the rest is untouched */
+    Image2D single{PixelFormat::Red, PixelType::UnsignedByte, {32, 24}, Containers::Array<char>(32*24)};
+    Image2D threaded{PixelFormat::Red, PixelType::UnsignedByte, {32, 24}, Containers::Array<char>(32*24)};
+    std::fill_n(single.data<char>(), 32*24, 0);
+    std::fill_n(threaded.data<char>(), 32*24, 0);
+    distanceField(inputView, single, Range2Di::fromSize({4, 4}, {24, 16}), 6, 1);
+    distanceField(inputView, threaded, Range2Di::fromSize({4, 4}, {24, 16}), 6, 3);
+
+    CORRADE_COMPARE(std::vector<char>(threaded.data<char>(), threaded.data<char>() + 32*24),
+                    std::vector<char>(single.data<char>(), single.data<char>() + 32*24));
+    CORRADE_COMPARE(single.data<char>()[0], 0);
+    CORRADE_COMPARE(single.data<char>()[32*24 - 1], 0);
+}
+
+void DistanceFieldTest::cpuRectangleOutOfBounds() {
+    const char input[4]{};
+    Image2D output{PixelFormat::Red, PixelType::UnsignedByte, {4, 4}, Containers::Array<char>(16)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    distanceField(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, input}, output, {{2, 2}, {5, 5}}, 4);
+    CORRADE_COMPARE(out.str(), "TextureTools::distanceField(): rectangle Range({2, 2}, {5, 5}) out of bounds of output image of size Vector(4, 4)\n");
+}
+
+void DistanceFieldTest::multiChannel() {
+    const std::vector<char> input = squareData();
+    const ImageView2D inputView{PixelFormat::Red, PixelType::UnsignedByte, {32, 32}, {input.data(), input.size()}};
+
+    Image2D single{PixelFormat::Red, PixelType::UnsignedByte, {32, 32}, Containers::Array<char>(32*32)};
+    Image2D multi{PixelFormat::RGB, PixelType::UnsignedByte, {32, 32}, Containers::Array<char>(32*32*3)};
+    distanceField(inputView, single, {{}, {32, 32}}, 4, 1);
+    multiChannelDistanceField(inputView, multi, {{}, {32, 32}}, 4, 1);
+
+    /* Straight edges are kept, so median of the channels is the same as the
+       single-channel distance field everywhere */
+    const std::size_t rowStride = std::get<1>(multi.dataProperties()).x();
+    const auto channel = [&](Int x, Int y, Int c) {
+        return multi.data<UnsignedByte>()[y*rowStride + x*3 + c];
+    };
+    for(Int y = 0; y != 32; ++y) for(Int x = 0; x != 32; ++x) {
+        const UnsignedByte a = channel(x, y, 0), b = channel(x, y, 1), c = channel(x, y, 2);
+        const UnsignedByte median = Math::max(Math::min(a, b), Math::min(Math::max(a, b), c));
+        CORRADE_COMPARE(median, single.data<UnsignedByte>()[y*32 + x]);
+    }
+
+    /* Outside of the corner one channel is farther from the edge than the
+       single-channel distance, which is what makes the corner sharp */
+    const UnsignedByte corner = single.data<UnsignedByte>()[6*32 + 6];
+    CORRADE_VERIFY(Math::min(Math::min(channel(6, 6, 0), channel(6, 6, 1)), channel(6, 6, 2)) < corner);
+}
+
+void DistanceFieldTest::multiChannelThreads() {
+    const std::vector<char> input = inputData();
+    const ImageView2D inputView{PixelFormat::Red, PixelType::UnsignedByte, {48, 32}, {input.data(), input.size()}};
+
+    /* Alpha channel is untouched */
+    Image2D single{PixelFormat::RGBA, PixelType::UnsignedByte, {24, 16}, Containers::Array<char>(24*16*4)};
+    Image2D threaded{PixelFormat::RGBA, PixelType::UnsignedByte, {24, 16}, Containers::Array<char>(24*16*4)};
+    std::fill_n(single.data<char>(), 24*16*4, 0);
+    std::fill_n(threaded.data<char>(), 24*16*4, 0);
+    multiChannelDistanceField(inputView, single, {{}, {24, 16}}, 6, 1);
+    multiChannelDistanceField(inputView, threaded, {{}, {24, 16}}, 6, 3);
+
+    CORRADE_COMPARE(std::vector<char>(threaded.data<char>(), threaded.data<char>() + 24*16*4),
+                    std::vector<char>(single.data<char>(), single.data<char>() + 24*16*4));
+    CORRADE_COMPARE(single.data<char>()[3], 0);
+    CORRADE_COMPARE(single.data<char>()[24*16*4 - 1], 0);
+}
+
+void DistanceFieldTest::multiChannelInvalidFormat() {
+    const char input[4]{};
+    Image2D output{PixelFormat::Red, PixelType::UnsignedByte, {4, 4}, Containers::Array<char>(16)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiChannelDistanceField(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, input}, output, {{}, {4, 4}}, 4);
+    CORRADE_COMPARE(out.str(), "TextureTools::multiChannelDistanceField(): expected output image with at least three channels but got PixelFormat::Red\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldTest)
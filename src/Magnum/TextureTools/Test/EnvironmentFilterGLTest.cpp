@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include "Magnum/Context.h"
+#include "Magnum/CubeMapTexture.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#include "Magnum/TextureTools/EnvironmentFilter.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct EnvironmentFilterGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit EnvironmentFilterGLTest();
+
+    void evaluateIrradiance();
+    void uniform();
+    void budget();
+};
+
+EnvironmentFilterGLTest::EnvironmentFilterGLTest() {
+    addTests({&EnvironmentFilterGLTest::evaluateIrradiance,
+              &EnvironmentFilterGLTest::uniform,
+              &EnvironmentFilterGLTest::budget});
+}
+
+namespace {
+    constexpr Color4ub InputColor{128, 64, 255, 255};
+
+    void uniformInput(CubeMapTexture& input) {
+        Color4ub data[16*16];
+        for(Color4ub& i: data) i = InputColor;
+
+        input.setStorage(5, TextureFormat::RGBA8, {16, 16});
+        for(Int face = 0; face != 6; ++face)
+            input.setSubImage(CubeMapCoordinate(GLenum(CubeMapCoordinate::PositiveX) + face), 0, {},
+                ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {16, 16}, data});
+        input.generateMipmap();
+    }
+
+    #ifdef MAGNUM_TARGET_GLES
+    bool colorBufferFloatSupported() {
+        const std::vector<std::string> extensions = Context::current().extensionStrings();
+        return std::find(extensions.begin(), extensions.end(), "GL_EXT_color_buffer_float") != extensions.end();
+    }
+    #endif
+}
+
+void EnvironmentFilterGLTest::evaluateIrradiance() {
+    /* Only the constant term, the irradiance is the same everywhere */
+    std::array<Vector3, 9> coefficients{};
+    coefficients[0] = Vector3{2.0f};
+    CORRADE_COMPARE(EnvironmentFilter::evaluateIrradiance(coefficients, Vector3::xAxis()), Vector3{0.56419f});
+    CORRADE_COMPARE(EnvironmentFilter::evaluateIrradiance(coefficients, -Vector3::zAxis()), Vector3{0.56419f});
+
+    /* Linear term along Z gives a gradient from back to front */
+    coefficients[2] = Vector3{1.0f};
+    CORRADE_COMPARE(EnvironmentFilter::evaluateIrradiance(coefficients, Vector3::zAxis()), Vector3{1.052793f});
+    CORRADE_COMPARE(EnvironmentFilter::evaluateIrradiance(coefficients, -Vector3::zAxis()), Vector3{0.075587f});
+}
+
+void EnvironmentFilterGLTest::uniform() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL330))
+        CORRADE_SKIP("OpenGL 3.3 is not supported.");
+    #else
+    if(!colorBufferFloatSupported())
+        CORRADE_SKIP("GL_EXT_color_buffer_float is not supported.");
+    #endif
+
+    CubeMapTexture input;
+    uniformInput(input);
+
+    CubeMapTexture output;
+    output.setStorage(3, TextureFormat::RGBA8, {8, 8});
+
+    EnvironmentFilter filter{16};
+    filter.run(input, 16, output, 8, 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(filter.isFinished());
+    CORRADE_COMPARE(filter.progress(), 1.0f);
+
+    /* Uniform input stays uniform in all levels */
+    for(Int level: {0, 2}) {
+        const Int size = 8 >> level;
+        Framebuffer framebuffer{{{}, {size, size}}};
+        framebuffer.attachCubeMapTexture(Framebuffer::ColorAttachment{0}, output, CubeMapCoordinate::NegativeZ, level);
+        Image2D image = framebuffer.read({{}, {size, size}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+        MAGNUM_VERIFY_NO_ERROR();
+        const Color4ub* const pixels = image.data<Color4ub>();
+        for(Int i = 0; i != size*size; ++i)
+            CORRADE_VERIFY((Math::abs(Vector4i{pixels[i]} - Vector4i{InputColor})).max() <= 1);
+    }
+
+    /* Irradiance of uniform radiance L is pi*L in all directions, thus only
+       the constant term is non-zero */
+    const Vector3 radiance = Math::normalize<Color3>(InputColor.rgb());
+    const std::array<Vector3, 9>& irradiance = filter.irradiance();
+    CORRADE_VERIFY((Math::abs(irradiance[0] - radiance*11.1366f)).max() < 0.05f);
+    for(std::size_t i = 1; i != 9; ++i)
+        CORRADE_VERIFY((Math::abs(irradiance[i])).max() < 0.01f);
+    CORRADE_VERIFY((Math::abs(EnvironmentFilter::evaluateIrradiance(irradiance, Vector3::yAxis()) - radiance*Constants::pi())).max() < 0.05f);
+}
+
+void EnvironmentFilterGLTest::budget() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL330))
+        CORRADE_SKIP("OpenGL 3.3 is not supported.");
+    #else
+    if(!colorBufferFloatSupported())
+        CORRADE_SKIP("GL_EXT_color_buffer_float is not supported.");
+    #endif
+
+    CubeMapTexture input;
+    uniformInput(input);
+
+    CubeMapTexture output;
+    output.setStorage(2, TextureFormat::RGBA8, {4, 4});
+
+    EnvironmentFilter filter{16};
+    filter.start(input, 16, output, 4, 2);
+    CORRADE_VERIFY(!filter.isFinished());
+    CORRADE_COMPARE(filter.progress(), 0.0f);
+
+    /* Zero budget processes just one piece of work at a time -- one face of
+       each level and the irradiance calculation at the end */
+    Int steps = 0;
+    Float progress = 0.0f;
+    while(!filter.step(std::chrono::nanoseconds{0})) {
+        CORRADE_VERIFY(filter.progress() > progress);
+        progress = filter.progress();
+        ++steps;
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(steps, 2*6);
+    CORRADE_VERIFY(filter.isFinished());
+    CORRADE_COMPARE(filter.progress(), 1.0f);
+
+    /* Unlimited budget processes everything at once */
+    filter.start(input, 16, output, 4, 2);
+    CORRADE_VERIFY(filter.step(std::chrono::nanoseconds::max()));
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::TextureTools::Test::EnvironmentFilterGLTest)
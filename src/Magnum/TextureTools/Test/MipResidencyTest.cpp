@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/TextureTools/MipResidency.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct MipResidencyTest: TestSuite::Tester {
+    explicit MipResidencyTest();
+
+    void levelSize();
+    void addTextureInvalid();
+
+    void coarsestLevel();
+    void coverage();
+    void levelBias();
+    void loadBudget();
+    void loadPriority();
+    void evict();
+    void evictPostponed();
+    void evictLowerBudget();
+    void removeTexture();
+    void setLevelLoadedInvalid();
+};
+
+MipResidencyTest::MipResidencyTest() {
+    addTests({&MipResidencyTest::levelSize,
+              &MipResidencyTest::addTextureInvalid,
+
+              &MipResidencyTest::coarsestLevel,
+              &MipResidencyTest::coverage,
+              &MipResidencyTest::levelBias,
+              &MipResidencyTest::loadBudget,
+              &MipResidencyTest::loadPriority,
+              &MipResidencyTest::evict,
+              &MipResidencyTest::evictPostponed,
+              &MipResidencyTest::evictLowerBudget,
+              &MipResidencyTest::removeTexture,
+              &MipResidencyTest::setLevelLoadedInvalid});
+}
+
+namespace {
+    /* Memory of 256x256 RGBA8 texture levels 0 to 8 */
+    constexpr std::size_t LevelMemory[]{262144, 65536, 16384, 4096, 1024, 256, 64, 16, 4};
+
+    /* Reports given coverage and loads everything until nothing changes,
+       returns the evicted levels */
+    std::vector<MipResidency::Level> settle(MipResidency& residency, std::initializer_list<std::pair<UnsignedInt, Float>> coverage) {
+        std::vector<MipResidency::Level> evicted;
+        for(;;) {
+            for(const std::pair<UnsignedInt, Float>& c: coverage)
+                residency.addCoverage(c.first, c.second);
+
+            const MipResidency::Changes changes = residency.update();
+            evicted.insert(evicted.end(), changes.evict.begin(), changes.evict.end());
+            if(changes.load.empty()) return evicted;
+
+            for(const MipResidency::Level& level: changes.load)
+                residency.setLevelLoaded(level.texture, level.level);
+        }
+    }
+
+    /* Texture ID and level pairs flattened for easier comparison */
+    std::vector<Int> flatten(const std::vector<MipResidency::Level>& levels) {
+        std::vector<Int> out;
+        for(const MipResidency::Level& level: levels) {
+            out.push_back(level.texture);
+            out.push_back(level.level);
+        }
+        return out;
+    }
+}
+
+void MipResidencyTest::levelSize() {
+    MipResidency residency{1024};
+    const UnsignedInt id = residency.addTexture({256, 64}, 9, 4);
+    CORRADE_COMPARE(id, 0);
+    CORRADE_COMPARE(residency.textureCount(), 1);
+    CORRADE_COMPARE(residency.levelCount(id), 9);
+    CORRADE_COMPARE(residency.levelSize(id, 0), (Vector2i{256, 64}));
+    CORRADE_COMPARE(residency.levelSize(id, 7), (Vector2i{2, 1}));
+    CORRADE_COMPARE(residency.levelSize(id, 8), (Vector2i{1, 1}));
+    CORRADE_COMPARE(residency.levelMemory(id, 0), 65536);
+    CORRADE_COMPARE(residency.levelMemory(id, 8), 4);
+
+    /* Nothing resident initially */
+    CORRADE_COMPARE(residency.baseLevel(id), 9);
+    CORRADE_COMPARE(residency.requiredLevel(id), 8);
+    CORRADE_VERIFY(!residency.isLoading(id));
+    CORRADE_COMPARE(residency.memoryUsage(), 0);
+}
+
+void MipResidencyTest::addTextureInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MipResidency residency{1024};
+    residency.addTexture({256, 64}, 0, 4);
+    residency.addTexture({256, 64}, 10, 4);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::MipResidency::addTexture(): invalid level count 0 for size Vector(256, 64)\n"
+        "TextureTools::MipResidency::addTexture(): invalid level count 10 for size Vector(256, 64)\n");
+}
+
+void MipResidencyTest::coarsestLevel() {
+    /* The coarsest level is loaded even with zero budget */
+    MipResidency residency{0};
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 4, 4);
+
+    const MipResidency::Changes changes = residency.update();
+    CORRADE_COMPARE(flatten(changes.load), (std::vector<Int>{0, 8, 1, 3}));
+    CORRADE_VERIFY(changes.evict.empty());
+    CORRADE_VERIFY(residency.isLoading(0));
+    CORRADE_VERIFY(residency.isLoading(1));
+    CORRADE_COMPARE(residency.baseLevel(0), 9);
+    CORRADE_COMPARE(residency.memoryUsage(), LevelMemory[8] + LevelMemory[3]);
+
+    /* Nothing more to load while loading */
+    CORRADE_VERIFY(residency.update().load.empty());
+
+    residency.setLevelLoaded(0, 8);
+    CORRADE_VERIFY(!residency.isLoading(0));
+    CORRADE_COMPARE(residency.baseLevel(0), 8);
+
+    /* Without any coverage nothing else is needed */
+    CORRADE_VERIFY(residency.update().load.empty());
+}
+
+void MipResidencyTest::coverage() {
+    MipResidency residency{1024*1024};
+    const UnsignedInt id = residency.addTexture({256, 256}, 9, 4);
+    residency.setLevelLoaded(id, residency.update().load.front().level);
+
+    /* 256 pixel texture covering 64 pixels needs level 2, loaded one level
+       at a time from the coarsest */
+    residency.addCoverage(id, 64.0f);
+    residency.addCoverage(id, 16.0f);
+    MipResidency::Changes changes = residency.update();
+    CORRADE_COMPARE(residency.requiredLevel(id), 2);
+    CORRADE_COMPARE(flatten(changes.load), (std::vector<Int>{Int(id), 7}));
+    residency.setLevelLoaded(id, 7);
+
+    settle(residency, {{id, 64.0f}});
+    CORRADE_COMPARE(residency.baseLevel(id), 2);
+    CORRADE_COMPARE(residency.memoryUsage(), 21844);
+
+    /* Coverage larger than the texture needs level 0 */
+    settle(residency, {{id, 1000.0f}});
+    CORRADE_COMPARE(residency.requiredLevel(id), 0);
+    CORRADE_COMPARE(residency.baseLevel(id), 0);
+}
+
+void MipResidencyTest::levelBias() {
+    MipResidency residency{1024*1024};
+    residency.setLevelBias(1.5f);
+    const UnsignedInt id = residency.addTexture({256, 256}, 9, 4);
+
+    settle(residency, {{id, 64.0f}});
+    CORRADE_COMPARE(residency.requiredLevel(id), 3);
+    CORRADE_COMPARE(residency.baseLevel(id), 3);
+}
+
+void MipResidencyTest::loadBudget() {
+    MipResidency residency{1024*1024};
+    residency.setLoadBudget(2);
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+
+    CORRADE_COMPARE(flatten(residency.update().load), (std::vector<Int>{0, 8, 1, 8}));
+    CORRADE_COMPARE(flatten(residency.update().load), (std::vector<Int>{2, 8}));
+}
+
+void MipResidencyTest::loadPriority() {
+    MipResidency residency{1024*1024};
+    residency.setLoadBudget(1);
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+    settle(residency, {});
+
+    /* The texture with larger difference between resident and required
+       level goes first */
+    residency.addCoverage(0, 32.0f);
+    residency.addCoverage(1, 128.0f);
+    CORRADE_COMPARE(flatten(residency.update().load), (std::vector<Int>{1, 7}));
+}
+
+void MipResidencyTest::evict() {
+    MipResidency residency{600000};
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+
+    CORRADE_VERIFY(settle(residency, {{0, 256.0f}}).empty());
+    CORRADE_COMPARE(residency.baseLevel(0), 0);
+
+    /* The first texture is not visible anymore, so its finest level is
+       evicted to make space for the second */
+    const std::vector<MipResidency::Level> evicted = settle(residency, {{1, 256.0f}});
+    CORRADE_COMPARE(flatten(evicted), (std::vector<Int>{0, 0}));
+    CORRADE_COMPARE(residency.baseLevel(0), 1);
+    CORRADE_COMPARE(residency.baseLevel(1), 0);
+    CORRADE_COMPARE(residency.memoryUsage(), 436904);
+}
+
+void MipResidencyTest::evictPostponed() {
+    MipResidency residency{400000};
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+
+    CORRADE_VERIFY(settle(residency, {{0, 256.0f}}).empty());
+    CORRADE_COMPARE(residency.baseLevel(0), 0);
+
+    /* Both textures are visible, so nothing can be evicted and the second
+       one stays at a coarser level */
+    CORRADE_VERIFY(settle(residency, {{0, 256.0f}, {1, 256.0f}}).empty());
+    CORRADE_COMPARE(residency.baseLevel(0), 0);
+    CORRADE_COMPARE(residency.baseLevel(1), 2);
+    CORRADE_COMPARE(residency.memoryUsage(), 371368);
+}
+
+void MipResidencyTest::evictLowerBudget() {
+    MipResidency residency{1024*1024};
+    residency.addTexture({256, 256}, 9, 4);
+    settle(residency, {{0, 256.0f}});
+    CORRADE_COMPARE(residency.baseLevel(0), 0);
+
+    /* Levels that are not needed anymore are evicted only if over budget */
+    CORRADE_VERIFY(settle(residency, {}).empty());
+    CORRADE_COMPARE(residency.baseLevel(0), 0);
+
+    residency.setMemoryBudget(30000);
+    CORRADE_COMPARE(flatten(settle(residency, {})), (std::vector<Int>{0, 0, 0, 1}));
+    CORRADE_COMPARE(residency.baseLevel(0), 2);
+    CORRADE_COMPARE(residency.memoryUsage(), 21844);
+}
+
+void MipResidencyTest::removeTexture() {
+    MipResidency residency{1024*1024};
+    residency.addTexture({256, 256}, 9, 4);
+    residency.addTexture({256, 256}, 9, 4);
+    settle(residency, {{0, 64.0f}});
+
+    /* Loading level of the second texture is counted as well */
+    residency.addCoverage(1, 256.0f);
+    residency.update();
+    CORRADE_VERIFY(residency.isLoading(1));
+
+    residency.removeTexture(1);
+    CORRADE_COMPARE(residency.memoryUsage(), 21844);
+    CORRADE_COMPARE(residency.textureCount(), 2);
+
+    /* Finishing the load of a removed texture is ignored */
+    residency.setLevelLoaded(1, 7);
+    CORRADE_VERIFY(residency.update().load.empty());
+    CORRADE_COMPARE(residency.memoryUsage(), 21844);
+}
+
+void MipResidencyTest::setLevelLoadedInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MipResidency residency{1024};
+    residency.addTexture({256, 256}, 9, 4);
+    residency.setLevelLoaded(0, 8);
+    residency.update();
+    residency.setLevelLoaded(0, 7);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::MipResidency::setLevelLoaded(): level 8 of texture 0 is not being loaded\n"
+        "TextureTools::MipResidency::setLevelLoaded(): level 7 of texture 0 is not being loaded\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::MipResidencyTest)
@@ -0,0 +1,187 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Mipmap.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct MipmapTest: TestSuite::Tester {
+    explicit MipmapTest();
+
+    void box();
+    void boxSrgb();
+    void boxAlignment();
+    void kaiserConstant();
+    void kaiserThreads();
+    void invalidType();
+
+    void generateMipmaps();
+    void generateMipmapsSinglePixel();
+
+    void debugFilter();
+    void debugColorSpace();
+};
+
+MipmapTest::MipmapTest() {
+    addTests({&MipmapTest::box,
+              &MipmapTest::boxSrgb,
+              &MipmapTest::boxAlignment,
+              &MipmapTest::kaiserConstant,
+              &MipmapTest::kaiserThreads,
+              &MipmapTest::invalidType,
+
+              &MipmapTest::generateMipmaps,
+              &MipmapTest::generateMipmapsSinglePixel,
+
+              &MipmapTest::debugFilter,
+              &MipmapTest::debugColorSpace});
+}
+
+void MipmapTest::box() {
+    const UnsignedByte data[]{
+        10, 20, 100, 100,
+        30, 40, 100, 200
+    };
+
+    Image2D out = downsample(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {4, 2}, data}, DownsampleFilter::Box, ColorSpace::Linear, 1);
+    CORRADE_COMPARE(out.format(), PixelFormat::Red);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out.data<UnsignedByte>()[0], 25);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[1], 125);
+}
+
+void MipmapTest::boxSrgb() {
+    const UnsignedByte data[]{
+        0, 0, 0, 0, 255, 255, 255, 255
+    };
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 1}, data};
+
+    /* Linear average */
+    Image2D linear = downsample(image, DownsampleFilter::Box, ColorSpace::Linear, 1);
+    CORRADE_COMPARE(linear.size(), Vector2i{1});
+    CORRADE_COMPARE(linear.data<UnsignedByte>()[0], 128);
+    CORRADE_COMPARE(linear.data<UnsignedByte>()[3], 128);
+
+    /* Color is averaged in linear space, alpha is left as-is */
+    Image2D srgb = downsample(image, DownsampleFilter::Box, ColorSpace::Srgb, 1);
+    CORRADE_COMPARE(srgb.data<UnsignedByte>()[0], 188);
+    CORRADE_COMPARE(srgb.data<UnsignedByte>()[1], 188);
+    CORRADE_COMPARE(srgb.data<UnsignedByte>()[2], 188);
+    CORRADE_COMPARE(srgb.data<UnsignedByte>()[3], 128);
+}
+
+void MipmapTest::boxAlignment() {
+    /* Rows are padded to four bytes, the third column is not used */
+    const UnsignedByte data[]{
+        10, 20, 30, 30, 40, 50, 255, 255, 255, 0, 0, 0,
+        50, 60, 70, 70, 80, 90, 255, 255, 255, 0, 0, 0
+    };
+
+    Image2D out = downsample(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {3, 2}, data}, DownsampleFilter::Box, ColorSpace::Linear, 1);
+    CORRADE_COMPARE(out.size(), Vector2i{1});
+    CORRADE_COMPARE(out.storage().alignment(), 4);
+    CORRADE_COMPARE(out.data().size(), 4);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[0], 40);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[1], 50);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[2], 60);
+}
+
+void MipmapTest::kaiserConstant() {
+    std::vector<UnsignedByte> data(16*16*4);
+    for(std::size_t i = 0; i != data.size(); i += 4) {
+        data[i] = data[i + 1] = data[i + 2] = 100;
+        data[i + 3] = 255;
+    }
+
+    /* Flat areas keep their value even with edge clamping */
+    Image2D out = downsample(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {16, 16}, {data.data(), data.size()}}, DownsampleFilter::Kaiser, ColorSpace::Srgb, 1);
+    CORRADE_COMPARE(out.size(), Vector2i{8});
+    for(std::size_t i = 0; i != 8*8*4; i += 4) {
+        CORRADE_COMPARE(out.data<UnsignedByte>()[i], 100);
+        CORRADE_COMPARE(out.data<UnsignedByte>()[i + 3], 255);
+    }
+}
+
+void MipmapTest::kaiserThreads() {
+    std::vector<UnsignedByte> data(37*23*4);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = UnsignedByte((i*i*7 + i*13) % 256);
+    const ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::RGBA, PixelType::UnsignedByte, {37, 23}, {data.data(), data.size()}};
+
+    Image2D single = downsample(image, DownsampleFilter::Kaiser, ColorSpace::Srgb, 1);
+    Image2D threaded = downsample(image, DownsampleFilter::Kaiser, ColorSpace::Srgb, 4);
+    CORRADE_COMPARE(threaded.size(), (Vector2i{18, 11}));
+    CORRADE_COMPARE(std::vector<char>(threaded.data(), threaded.data() + threaded.data().size()),
+                    std::vector<char>(single.data(), single.data() + single.data().size()));
+}
+
+void MipmapTest::invalidType() {
+    const Float data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    downsample(ImageView2D{PixelFormat::Red, PixelType::Float, {2, 2}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::downsample(): expected PixelType::UnsignedByte image with one to four channels but got PixelFormat::Red and PixelType::Float\n");
+}
+
+void MipmapTest::generateMipmaps() {
+    std::vector<UnsignedByte> data(8*2*4, 50);
+
+    std::vector<Image2D> levels = TextureTools::generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 2}, {data.data(), data.size()}}, DownsampleFilter::Kaiser, ColorSpace::Linear, 2);
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{4, 1}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(levels[2].data<UnsignedByte>()[0], 50);
+}
+
+void MipmapTest::generateMipmapsSinglePixel() {
+    const UnsignedByte data[4]{};
+    CORRADE_VERIFY(TextureTools::generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data}).empty());
+}
+
+void MipmapTest::debugFilter() {
+    std::ostringstream out;
+    Debug(&out) << DownsampleFilter::Kaiser << DownsampleFilter(0xf0);
+    CORRADE_COMPARE(out.str(), "TextureTools::DownsampleFilter::Kaiser TextureTools::DownsampleFilter::(invalid)\n");
+}
+
+void MipmapTest::debugColorSpace() {
+    std::ostringstream out;
+    Debug(&out) << ColorSpace::Srgb << ColorSpace(0xf0);
+    CORRADE_COMPARE(out.str(), "TextureTools::ColorSpace::Srgb TextureTools::ColorSpace::(invalid)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::MipmapTest)
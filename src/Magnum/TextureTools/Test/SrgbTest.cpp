@@ -0,0 +1,122 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Srgb.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct SrgbTest: TestSuite::Tester {
+    explicit SrgbTest();
+
+    void srgbToLinear();
+    void srgbToLinearAlignment();
+    void linearToSrgb();
+    void roundTrip();
+};
+
+SrgbTest::SrgbTest() {
+    addTests({&SrgbTest::srgbToLinear,
+              &SrgbTest::srgbToLinearAlignment,
+              &SrgbTest::linearToSrgb,
+              &SrgbTest::roundTrip});
+}
+
+void SrgbTest::srgbToLinear() {
+    const UnsignedByte data[]{
+        0x33, 0xb2, 0x7f, 0x80, 0, 0, 0, 255
+    };
+
+    /* Alpha is only normalized */
+    Image2D out = TextureTools::srgbToLinear(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 1}, data}, 1);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out.data<Float>()[0], 0.0331048f);
+    CORRADE_COMPARE(out.data<Float>()[1], 0.445201f);
+    CORRADE_COMPARE(out.data<Float>()[2], 0.212231f);
+    CORRADE_COMPARE(out.data<Float>()[3], 0.501961f);
+    CORRADE_COMPARE(out.data<Float>()[4], 0.0f);
+    CORRADE_COMPARE(out.data<Float>()[7], 1.0f);
+}
+
+void SrgbTest::srgbToLinearAlignment() {
+    /* Rows are padded to four bytes */
+    const UnsignedByte data[]{
+        0x33, 0xb2, 0x7f, 0,
+        255, 0, 0x80, 0
+    };
+
+    Image2D out = TextureTools::srgbToLinear(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {3, 2}, data}, 2);
+    CORRADE_COMPARE(out.size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE(out.data().size(), 6*sizeof(Float));
+    CORRADE_COMPARE(out.data<Float>()[0], 0.0331048f);
+    CORRADE_COMPARE(out.data<Float>()[2], 0.212231f);
+    CORRADE_COMPARE(out.data<Float>()[3], 1.0f);
+    CORRADE_COMPARE(out.data<Float>()[4], 0.0f);
+    CORRADE_COMPARE(out.data<Float>()[5], 0.215861f);
+}
+
+void SrgbTest::linearToSrgb() {
+    const Float data[]{
+        0.0331048f, 0.445201f, 0.212231f, 0.5f,
+        -1.0f, 2.0f, 0.0f, 1.5f
+    };
+
+    /* Alpha is only clamped and denormalized */
+    Image2D out = TextureTools::linearToSrgb(ImageView2D{PixelFormat::RGBA, PixelType::Float, {2, 1}, data}, 1);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out.storage().alignment(), 1);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[0], 0x33);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[1], 0xb2);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[2], 0x7f);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[3], 128);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[4], 0);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[5], 255);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[6], 0);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[7], 255);
+}
+
+void SrgbTest::roundTrip() {
+    UnsignedByte data[256];
+    for(std::size_t i = 0; i != 256; ++i) data[i] = UnsignedByte(i);
+
+    /* Every value survives the round trip */
+    Image2D linear = TextureTools::srgbToLinear(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {16, 16}, data}, 4);
+    Image2D out = TextureTools::linearToSrgb(linear, 4);
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(Int(out.data<UnsignedByte>()[i]), Int(i));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::SrgbTest)
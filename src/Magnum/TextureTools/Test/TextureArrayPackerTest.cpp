@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureTools/TextureArrayPacker.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct TextureArrayPackerTest: TestSuite::Tester {
+    explicit TextureArrayPackerTest();
+
+    void groupBySize();
+    void groupByFormat();
+    void full();
+    void clear();
+};
+
+TextureArrayPackerTest::TextureArrayPackerTest() {
+    addTests({&TextureArrayPackerTest::groupBySize,
+              &TextureArrayPackerTest::groupByFormat,
+              &TextureArrayPackerTest::full,
+              &TextureArrayPackerTest::clear});
+}
+
+void TextureArrayPackerTest::groupBySize() {
+    TextureArrayPacker packer{16};
+    CORRADE_COMPARE(packer.maxLayerCount(), 16);
+
+    const TextureArrayLocation a = packer.add(TextureFormat::RGBA8, {256, 256});
+    const TextureArrayLocation b = packer.add(TextureFormat::RGBA8, {128, 256});
+    const TextureArrayLocation c = packer.add(TextureFormat::RGBA8, {256, 256});
+    const TextureArrayLocation d = packer.add(TextureFormat::RGBA8, {128, 256});
+    const TextureArrayLocation e = packer.add(TextureFormat::RGBA8, {256, 256});
+
+    CORRADE_COMPARE(packer.arrayCount(), 2);
+    CORRADE_COMPARE(packer.arraySize(0), (Vector2i{256, 256}));
+    CORRADE_COMPARE(packer.arrayLayerCount(0), 3);
+    CORRADE_COMPARE(packer.arraySize(1), (Vector2i{128, 256}));
+    CORRADE_COMPARE(packer.arrayLayerCount(1), 2);
+
+    CORRADE_COMPARE(a.array, 0);
+    CORRADE_COMPARE(a.layer, 0);
+    CORRADE_COMPARE(b.array, 1);
+    CORRADE_COMPARE(b.layer, 0);
+    CORRADE_COMPARE(c.array, 0);
+    CORRADE_COMPARE(c.layer, 1);
+    CORRADE_COMPARE(d.array, 1);
+    CORRADE_COMPARE(d.layer, 1);
+    CORRADE_COMPARE(e.array, 0);
+    CORRADE_COMPARE(e.layer, 2);
+}
+
+void TextureArrayPackerTest::groupByFormat() {
+    TextureArrayPacker packer{16};
+
+    const TextureArrayLocation a = packer.add(TextureFormat::RGBA8, {64, 64});
+    const TextureArrayLocation b = packer.add(TextureFormat::RGB8, {64, 64});
+    const TextureArrayLocation c = packer.add(TextureFormat::RGB8, {64, 64});
+
+    CORRADE_COMPARE(packer.arrayCount(), 2);
+    CORRADE_VERIFY(packer.arrayFormat(0) == TextureFormat::RGBA8);
+    CORRADE_VERIFY(packer.arrayFormat(1) == TextureFormat::RGB8);
+
+    CORRADE_COMPARE(a.array, 0);
+    CORRADE_COMPARE(a.layer, 0);
+    CORRADE_COMPARE(b.array, 1);
+    CORRADE_COMPARE(b.layer, 0);
+    CORRADE_COMPARE(c.array, 1);
+    CORRADE_COMPARE(c.layer, 1);
+}
+
+void TextureArrayPackerTest::full() {
+    TextureArrayPacker packer{2};
+
+    packer.add(TextureFormat::RGBA8, {32, 32});
+    packer.add(TextureFormat::RGBA8, {32, 32});
+    const TextureArrayLocation c = packer.add(TextureFormat::RGBA8, {32, 32});
+    const TextureArrayLocation d = packer.add(TextureFormat::RGBA8, {32, 32});
+    const TextureArrayLocation e = packer.add(TextureFormat::RGBA8, {32, 32});
+
+    /* Full arrays are not reused, a new one is created instead */
+    CORRADE_COMPARE(packer.arrayCount(), 3);
+    CORRADE_COMPARE(packer.arrayLayerCount(0), 2);
+    CORRADE_COMPARE(packer.arrayLayerCount(1), 2);
+    CORRADE_COMPARE(packer.arrayLayerCount(2), 1);
+
+    CORRADE_COMPARE(c.array, 1);
+    CORRADE_COMPARE(c.layer, 0);
+    CORRADE_COMPARE(d.array, 1);
+    CORRADE_COMPARE(d.layer, 1);
+    CORRADE_COMPARE(e.array, 2);
+    CORRADE_COMPARE(e.layer, 0);
+}
+
+void TextureArrayPackerTest::clear() {
+    TextureArrayPacker packer{16};
+    packer.add(TextureFormat::RGBA8, {32, 32});
+    packer.add(TextureFormat::RGB8, {32, 32});
+    CORRADE_COMPARE(packer.arrayCount(), 2);
+
+    packer.clear();
+    CORRADE_COMPARE(packer.arrayCount(), 0);
+
+    const TextureArrayLocation a = packer.add(TextureFormat::RGB8, {32, 32});
+    CORRADE_COMPARE(a.array, 0);
+    CORRADE_COMPARE(a.layer, 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::TextureArrayPackerTest)
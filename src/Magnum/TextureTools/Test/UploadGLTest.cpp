@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Test/AbstractOpenGLTester.h"
+#include "Magnum/TextureTools/Upload.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct UploadGLTest: Magnum::Test::AbstractOpenGLTester {
+    explicit UploadGLTest();
+
+    void mipLevelCount();
+    void single();
+    void levels();
+    void generateMipmap();
+};
+
+UploadGLTest::UploadGLTest() {
+    addTests({&UploadGLTest::mipLevelCount,
+              &UploadGLTest::single,
+              &UploadGLTest::levels,
+              &UploadGLTest::generateMipmap});
+}
+
+namespace {
+    /* Each level filled with its index, rows padded to four bytes */
+    const UnsignedByte Data[] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+    const UnsignedByte Data1[] = {
+        1, 1, 1, 1,
+        1, 1, 1, 1
+    };
+    const UnsignedByte Data2[] = {
+        2, 2, 2, 2
+    };
+}
+
+void UploadGLTest::mipLevelCount() {
+    CORRADE_COMPARE(TextureTools::mipLevelCount({1, 1}), 1);
+    CORRADE_COMPARE(TextureTools::mipLevelCount({4, 1}), 3);
+    CORRADE_COMPARE(TextureTools::mipLevelCount({5, 8}), 4);
+    CORRADE_COMPARE(TextureTools::mipLevelCount({256, 256}), 9);
+}
+
+void UploadGLTest::single() {
+    Texture2D texture;
+    upload(texture, TextureFormat::RGBA8,
+        {ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 4}, Data}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(texture.imageSize(0), (Vector2i{2, 4}));
+    #endif
+}
+
+void UploadGLTest::levels() {
+    Texture2D texture;
+    upload(texture, TextureFormat::RGBA8, {
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 4}, Data},
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 2}, Data1},
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, Data2}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Each level is read from correct offset in the staging buffer */
+    for(Int i: {0, 1, 2}) {
+        Image2D image = texture.image(i, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(image.size(), Math::max(Vector2i{2, 4} >> i, Vector2i{1}));
+        CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(i));
+    }
+    #endif
+}
+
+void UploadGLTest::generateMipmap() {
+    Texture2D texture;
+    upload(texture, TextureFormat::RGBA8, {
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 4}, Data},
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 2}, Data1}},
+        UploadFlag::GenerateMipmap);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(texture.imageSize(2), (Vector2i{1, 1}));
+
+    /* Supplied levels are kept, the last one is generated from them */
+    Image2D image1 = texture.image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image2D image2 = texture.image(2, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image1.data<Color4ub>()[0], Color4ub(1));
+    CORRADE_COMPARE(image2.data<Color4ub>()[0], Color4ub(1));
+    #endif
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::TextureTools::Test::UploadGLTest)
@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/VirtualTexture.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct VirtualTextureTest: TestSuite::Tester {
+    explicit VirtualTextureTest();
+
+    void packTile();
+    void tileCount();
+    void tileRange();
+
+    void mipTail();
+    void feedbackInvalid();
+    void feedbackParents();
+    void commitBudget();
+    void residentTileLimit();
+};
+
+VirtualTextureTest::VirtualTextureTest() {
+    addTests({&VirtualTextureTest::packTile,
+              &VirtualTextureTest::tileCount,
+              &VirtualTextureTest::tileRange,
+
+              &VirtualTextureTest::mipTail,
+              &VirtualTextureTest::feedbackInvalid,
+              &VirtualTextureTest::feedbackParents,
+              &VirtualTextureTest::commitBudget,
+              &VirtualTextureTest::residentTileLimit});
+}
+
+void VirtualTextureTest::packTile() {
+    const UnsignedInt id = VirtualTexture::packTile({37, 4000}, 5);
+    CORRADE_COMPARE(id, 0x85fa0025u);
+
+    const VirtualTexture::Tile tile = VirtualTexture::unpackTile(id);
+    CORRADE_COMPARE(tile.coordinates, (Vector2i{37, 4000}));
+    CORRADE_COMPARE(tile.level, 5);
+}
+
+void VirtualTextureTest::tileCount() {
+    /* 1000x600 with 128x64 tiles, the last level is 1x1 */
+    VirtualTexture texture{{1000, 600}, 10, {128, 64}, 4};
+
+    CORRADE_COMPARE(texture.tileCount(0), (Vector2i{8, 10}));
+    CORRADE_COMPARE(texture.tileCount(1), (Vector2i{4, 5}));
+    CORRADE_COMPARE(texture.tileCount(3), (Vector2i{1, 2}));
+    CORRADE_COMPARE(texture.tileCount(9), (Vector2i{1, 1}));
+}
+
+void VirtualTextureTest::tileRange() {
+    VirtualTexture texture{{1000, 600}, 10, {128, 64}, 4};
+
+    CORRADE_COMPARE(texture.tileRange({{1, 2}, 0}), (Range2Di{{128, 128}, {256, 192}}));
+
+    /* Clamped at the edge */
+    CORRADE_COMPARE(texture.tileRange({{7, 9}, 0}), (Range2Di{{896, 576}, {1000, 600}}));
+
+    /* Mip tail is the whole level */
+    CORRADE_COMPARE(texture.tileRange({{}, 4}), (Range2Di{{}, {62, 37}}));
+}
+
+void VirtualTextureTest::mipTail() {
+    VirtualTexture texture{{512, 512}, 10, {128, 128}, 3};
+    CORRADE_VERIFY(!texture.isResident({{}, 3}));
+    CORRADE_VERIFY(!texture.isResident({{}, 7}));
+
+    /* The tail is committed in the first update even without any feedback */
+    VirtualTexture::Changes changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 1);
+    CORRADE_COMPARE(changes.commit[0].coordinates, Vector2i{});
+    CORRADE_COMPARE(changes.commit[0].level, 3);
+    CORRADE_VERIFY(changes.decommit.empty());
+    CORRADE_VERIFY(texture.isResident({{}, 7}));
+    CORRADE_COMPARE(texture.residentTileCount(), 0);
+
+    /* And only once */
+    changes = texture.update();
+    CORRADE_VERIFY(changes.commit.empty());
+
+    /* Texture without tail */
+    VirtualTexture noTail{{512, 512}, 2, {128, 128}, 2};
+    CORRADE_VERIFY(noTail.update().commit.empty());
+}
+
+void VirtualTextureTest::feedbackInvalid() {
+    VirtualTexture texture{{512, 512}, 10, {128, 128}, 3};
+    texture.update();
+
+    const UnsignedInt feedback[]{
+        0,                                      /* cleared pixel */
+        VirtualTexture::packTile({4, 0}, 0),    /* out of bounds */
+        VirtualTexture::packTile({0, 2}, 1),    /* out of bounds */
+        VirtualTexture::packTile({0, 0}, 5),    /* in the mip tail */
+        VirtualTexture::packTile({0, 0}, 12)    /* no such level */
+    };
+    texture.processFeedback(feedback);
+
+    CORRADE_VERIFY(texture.update().commit.empty());
+    CORRADE_COMPARE(texture.residentTileCount(), 0);
+}
+
+void VirtualTextureTest::feedbackParents() {
+    VirtualTexture texture{{512, 512}, 10, {128, 128}, 3};
+    texture.update();
+
+    /* The same tile many times */
+    const UnsignedInt feedback[]{
+        VirtualTexture::packTile({3, 2}, 0),
+        VirtualTexture::packTile({3, 2}, 0),
+        VirtualTexture::packTile({3, 2}, 0)
+    };
+    texture.processFeedback(feedback);
+
+    /* Parents are committed first */
+    VirtualTexture::Changes changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 3);
+    CORRADE_COMPARE(changes.commit[0].coordinates, (Vector2i{0, 0}));
+    CORRADE_COMPARE(changes.commit[0].level, 2);
+    CORRADE_COMPARE(changes.commit[1].coordinates, (Vector2i{1, 1}));
+    CORRADE_COMPARE(changes.commit[1].level, 1);
+    CORRADE_COMPARE(changes.commit[2].coordinates, (Vector2i{3, 2}));
+    CORRADE_COMPARE(changes.commit[2].level, 0);
+    CORRADE_COMPARE(texture.residentTileCount(), 3);
+
+    /* Resident tiles are not committed again */
+    texture.processFeedback(feedback);
+    CORRADE_VERIFY(texture.update().commit.empty());
+}
+
+void VirtualTextureTest::commitBudget() {
+    VirtualTexture texture{{512, 512}, 10, {128, 128}, 3};
+    texture.setCommitBudget(2);
+    texture.update();
+
+    const UnsignedInt feedback[]{
+        VirtualTexture::packTile({0, 0}, 0),
+        VirtualTexture::packTile({1, 0}, 0)
+    };
+
+    /* Level 2 parent and level 1 parent fit in the budget */
+    texture.processFeedback(feedback);
+    VirtualTexture::Changes changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 2);
+    CORRADE_COMPARE(changes.commit[0].level, 2);
+    CORRADE_COMPARE(changes.commit[1].level, 1);
+
+    /* The remaining ones in the next update, if still requested */
+    texture.processFeedback(feedback);
+    changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 2);
+    CORRADE_COMPARE(changes.commit[0].coordinates, (Vector2i{1, 0}));
+    CORRADE_COMPARE(changes.commit[1].coordinates, (Vector2i{0, 0}));
+    CORRADE_COMPARE(texture.residentTileCount(), 4);
+}
+
+void VirtualTextureTest::residentTileLimit() {
+    VirtualTexture texture{{512, 512}, 10, {128, 128}, 3};
+    texture.setResidentTileLimit(3);
+    texture.update();
+
+    const UnsignedInt first[]{VirtualTexture::packTile({0, 0}, 0)};
+    const UnsignedInt second[]{VirtualTexture::packTile({3, 3}, 0)};
+
+    texture.processFeedback(first);
+    CORRADE_COMPARE(texture.update().commit.size(), 3);
+
+    /* The level 2 parent is shared, the other two are replaced */
+    texture.processFeedback(second);
+    VirtualTexture::Changes changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 2);
+    CORRADE_COMPARE(changes.decommit.size(), 2);
+    CORRADE_COMPARE(texture.residentTileCount(), 3);
+    CORRADE_VERIFY(!texture.isResident({{0, 0}, 0}));
+    CORRADE_VERIFY(!texture.isResident({{0, 0}, 1}));
+    CORRADE_VERIFY(texture.isResident({{0, 0}, 2}));
+    CORRADE_VERIFY(texture.isResident({{3, 3}, 0}));
+    CORRADE_VERIFY(texture.isResident({{1, 1}, 1}));
+
+    /* Requested tiles are kept even over the limit */
+    const UnsignedInt both[]{first[0], second[0]};
+    texture.processFeedback(both);
+    changes = texture.update();
+    CORRADE_COMPARE(changes.commit.size(), 2);
+    CORRADE_VERIFY(changes.decommit.empty());
+    CORRADE_COMPARE(texture.residentTileCount(), 5);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::VirtualTextureTest)
@@ -0,0 +1,66 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureArrayPacker.h"
+
+#include "Magnum/TextureArray.h"
+
+namespace Magnum { namespace TextureTools {
+
+TextureArrayPacker::TextureArrayPacker(const Int maxLayerCount): _maxLayerCount{maxLayerCount ? maxLayerCount : Texture2DArray::maxSize().z()} {
+    CORRADE_ASSERT(_maxLayerCount > 0, "TextureTools::TextureArrayPacker: max layer count is zero", );
+}
+
+TextureArrayLocation TextureArrayPacker::add(const TextureFormat format, const Vector2i& size) {
+    /* Newly filled arrays are always last for given format and size, so
+       searching from the end finds the free one fastest */
+    for(std::size_t i = _arrays.size(); i != 0; --i) {
+        Array& array = _arrays[i - 1];
+        if(array.format != format || array.size != size) continue;
+        if(array.layerCount == _maxLayerCount) break;
+
+        return {UnsignedInt(i - 1), array.layerCount++};
+    }
+
+    _arrays.push_back(Array{format, size, 1});
+    return {UnsignedInt(_arrays.size() - 1), 0};
+}
+
+TextureFormat TextureArrayPacker::arrayFormat(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _arrays.size(), "TextureTools::TextureArrayPacker::arrayFormat(): index" << id << "out of range for" << _arrays.size() << "arrays", {});
+    return _arrays[id].format;
+}
+
+Vector2i TextureArrayPacker::arraySize(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _arrays.size(), "TextureTools::TextureArrayPacker::arraySize(): index" << id << "out of range for" << _arrays.size() << "arrays", {});
+    return _arrays[id].size;
+}
+
+Int TextureArrayPacker::arrayLayerCount(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _arrays.size(), "TextureTools::TextureArrayPacker::arrayLayerCount(): index" << id << "out of range for" << _arrays.size() << "arrays", {});
+    return _arrays[id].layerCount;
+}
+
+}}
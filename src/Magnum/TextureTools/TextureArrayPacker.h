@@ -0,0 +1,151 @@
+#ifndef Magnum_TextureTools_TextureArrayPacker_h
+#define Magnum_TextureTools_TextureArrayPacker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::TextureArrayPacker, struct @ref Magnum::TextureTools::TextureArrayLocation
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Location of a texture in a texture array
+
+@see @ref TextureArrayPacker
+*/
+struct TextureArrayLocation {
+    UnsignedInt array;  /**< @brief Texture array ID */
+    Int layer;          /**< @brief Layer in the texture array */
+};
+
+/**
+@brief Texture array packer
+
+Groups textures of the same internal format and size into layers of
+@ref Texture2DArray "Texture2DArray"s, so materials that differ only in their
+textures can be drawn with a single texture binding and the per-instance
+layer index. Only textures with exactly the same size are put into one array,
+as all layers of a texture array are required to have the same size; resize
+the source images to a common set of sizes beforehand to reduce the array
+count.
+
+The packer only computes the layout, creating the textures and uploading the
+data is left on the user. The returned locations can be used directly as a
+remapping table for material texture references:
+@code
+std::vector<Trade::ImageData2D> images;
+TextureTools::TextureArrayPacker packer;
+std::vector<TextureTools::TextureArrayLocation> locations;
+for(const Trade::ImageData2D& image: images)
+    locations.push_back(packer.add(TextureFormat::RGBA8, image.size()));
+
+std::vector<Texture2DArray> arrays;
+for(UnsignedInt i = 0; i != packer.arrayCount(); ++i) {
+    std::vector<ImageView2D> layers;
+    for(std::size_t j = 0; j != images.size(); ++j)
+        if(locations[j].array == i) layers.push_back(images[j]);
+
+    arrays.emplace_back();
+    TextureTools::upload(arrays.back(), packer.arrayFormat(i), layers,
+        TextureTools::UploadFlag::GenerateMipmap);
+}
+
+// Diffuse texture of a material is now in array
+// locations[material.diffuseTexture()].array at layer
+// locations[material.diffuseTexture()].layer
+@endcode
+
+The layers are assigned in order in which the textures were added, so the
+layer list for each array can be assembled just by iterating over the added
+textures as shown above. See @ref Shaders::Phong::Flag::TextureArrays and
+@ref Shaders::Flat::Flag::TextureArrays for rendering with the packed arrays.
+@requires_gl30 Extension @extension{EXT,texture_array}
+@requires_gles30 Texture arrays are not available in OpenGL ES 2.0.
+@requires_webgl20 Texture arrays are not available in WebGL 1.0.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT TextureArrayPacker {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxLayerCount     Max layer count in one array
+         *
+         * If @p maxLayerCount is `0`, the value of
+         * @ref Texture2DArray::maxSize() is used, which requires an active
+         * OpenGL context. Otherwise the packer doesn't access OpenGL in any
+         * way.
+         */
+        explicit TextureArrayPacker(Int maxLayerCount = 0);
+
+        /** @brief Max layer count in one array */
+        Int maxLayerCount() const { return _maxLayerCount; }
+
+        /**
+         * @brief Add a texture
+         *
+         * Puts the texture into first array with matching format and size
+         * that has a free layer, creates a new array if there is none.
+         */
+        TextureArrayLocation add(TextureFormat format, const Vector2i& size);
+
+        /** @brief Count of texture arrays */
+        UnsignedInt arrayCount() const { return _arrays.size(); }
+
+        /** @brief Internal format of given texture array */
+        TextureFormat arrayFormat(UnsignedInt id) const;
+
+        /** @brief Layer size of given texture array */
+        Vector2i arraySize(UnsignedInt id) const;
+
+        /** @brief Layer count of given texture array */
+        Int arrayLayerCount(UnsignedInt id) const;
+
+        /** @brief Remove all arrays */
+        void clear() { _arrays.clear(); }
+
+    private:
+        struct Array {
+            TextureFormat format;
+            Vector2i size;
+            Int layerCount;
+        };
+
+        Int _maxLayerCount;
+        std::vector<Array> _arrays;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Upload.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/ImageData.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Buffer.h"
+#include "Magnum/BufferImage.h"
+#include "Magnum/TextureArray.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+Int mipLevelCount(const Vector2i& size) {
+    return Math::log2(UnsignedInt(size.max())) + 1;
+}
+
+namespace {
+
+bool checkLevelSizes(const std::vector<Vector2i>& sizes, const char* const function) {
+    CORRADE_ASSERT(!sizes.empty(), function << "no levels supplied", false);
+    CORRADE_ASSERT(Int(sizes.size()) <= mipLevelCount(sizes.front()),
+        function << "expected at most" << mipLevelCount(sizes.front()) << "levels for size" << sizes.front() << "but got" << sizes.size(), false);
+    for(std::size_t i = 1; i != sizes.size(); ++i) {
+        const Vector2i expected = Math::max(sizes.front() >> Int(i), Vector2i{1});
+        CORRADE_ASSERT(sizes[i] == expected,
+            function << "expected level" << i << "to have size" << expected << "but got" << sizes[i], false);
+    }
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(function);
+    #endif
+    return true;
+}
+
+void generateRemainingLevels(Texture2D& texture, const Int suppliedLevelCount) {
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Generate the rest from the last supplied level, so the supplied ones
+       are not overwritten */
+    texture.setBaseLevel(suppliedLevelCount - 1)
+        .generateMipmap()
+        .setBaseLevel(0);
+    #else
+    /* ES2 has no base level, the whole chain is regenerated from level 0 */
+    static_cast<void>(suppliedLevelCount);
+    texture.generateMipmap();
+    #endif
+}
+
+}
+
+void upload(Texture2D& texture, const TextureFormat internalFormat, const std::vector<ImageView2D>& levels, const UploadFlags flags) {
+    std::vector<Vector2i> sizes;
+    sizes.reserve(levels.size());
+    for(const ImageView2D& level: levels) sizes.push_back(level.size());
+    if(!checkLevelSizes(sizes, "TextureTools::upload():")) return;
+
+    const Int levelCount = flags & UploadFlag::GenerateMipmap ?
+        mipLevelCount(sizes.front()) : Int(levels.size());
+    texture.setStorage(levelCount, internalFormat, sizes.front());
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(levels.size() > 1) {
+        /* Calculate offset of each level in the staging buffer. Each level is
+           copied including its skip, with the offset rounded up to its row
+           stride, so it can be addressed by just adding to skipped rows. */
+        std::vector<std::size_t> offsets;
+        offsets.reserve(levels.size());
+        std::size_t size = 0;
+        for(const ImageView2D& level: levels) {
+            const std::size_t rowStride = std::get<1>(level.dataProperties()).x();
+            size = (size + rowStride - 1)/rowStride*rowStride;
+            offsets.push_back(size);
+            size += level.data().size();
+        }
+
+        Containers::Array<char> data{Containers::ValueInit, size};
+        for(std::size_t i = 0; i != levels.size(); ++i)
+            std::copy(levels[i].data().begin(), levels[i].data().end(), data + offsets[i]);
+
+        Buffer buffer{Buffer::TargetHint::PixelUnpack};
+        buffer.setData(data, BufferUsage::StaticDraw);
+
+        for(std::size_t i = 0; i != levels.size(); ++i) {
+            const ImageView2D& level = levels[i];
+            const std::size_t rowStride = std::get<1>(level.dataProperties()).x();
+            PixelStorage storage = level.storage();
+            storage.setSkip(storage.skip() + Vector3i::yAxis(Int(offsets[i]/rowStride)));
+
+            BufferImage2D image{storage, level.format(), level.type(), level.size(), std::move(buffer), size};
+            texture.setSubImage(i, {}, image);
+            buffer = image.release();
+        }
+    } else
+    #endif
+    {
+        for(std::size_t i = 0; i != levels.size(); ++i)
+            texture.setSubImage(i, {}, levels[i]);
+    }
+
+    if(Int(levels.size()) != levelCount)
+        generateRemainingLevels(texture, levels.size());
+}
+
+void upload(Texture2D& texture, const TextureFormat internalFormat, const std::vector<Trade::ImageData2D>& levels, const UploadFlags flags) {
+    CORRADE_ASSERT(!levels.empty(), "TextureTools::upload(): no levels supplied", );
+
+    /* Uncompressed images are delegated to the view overload */
+    if(!levels.front().isCompressed()) {
+        std::vector<ImageView2D> views;
+        views.reserve(levels.size());
+        for(const Trade::ImageData2D& level: levels) {
+            CORRADE_ASSERT(!level.isCompressed(),
+                "TextureTools::upload(): can't mix compressed and uncompressed levels", );
+            views.push_back(level);
+        }
+        upload(texture, internalFormat, views, flags);
+        return;
+    }
+
+    CORRADE_ASSERT(!(flags & UploadFlag::GenerateMipmap),
+        "TextureTools::upload(): can't generate mipmaps for compressed images", );
+
+    std::vector<Vector2i> sizes;
+    sizes.reserve(levels.size());
+    for(const Trade::ImageData2D& level: levels) {
+        CORRADE_ASSERT(level.isCompressed() && level.compressedFormat() == levels.front().compressedFormat(),
+            "TextureTools::upload(): expected all levels to have the same compressed format", );
+        sizes.push_back(level.size());
+    }
+    if(!checkLevelSizes(sizes, "TextureTools::upload():")) return;
+
+    texture.setStorage(levels.size(), TextureFormat(GLenum(levels.front().compressedFormat())), sizes.front());
+    for(std::size_t i = 0; i != levels.size(); ++i)
+        texture.setCompressedSubImage(i, {}, CompressedImageView2D(levels[i]));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void upload(Texture2DArray& texture, const TextureFormat internalFormat, const std::vector<ImageView2D>& layers, const UploadFlags flags) {
+    CORRADE_ASSERT(!layers.empty(), "TextureTools::upload(): no layers supplied", );
+
+    const Vector2i size = layers.front().size();
+    for(std::size_t i = 1; i != layers.size(); ++i) {
+        CORRADE_ASSERT(layers[i].size() == size,
+            "TextureTools::upload(): expected layer" << i << "to have size" << size << "but got" << layers[i].size(), );
+    }
+
+    texture.setStorage(flags & UploadFlag::GenerateMipmap ? mipLevelCount(size) : 1,
+        internalFormat, {size, Int(layers.size())});
+
+    for(std::size_t i = 0; i != layers.size(); ++i) {
+        const ImageView2D& layer = layers[i];
+        texture.setSubImage(0, Vector3i::zAxis(Int(i)), ImageView3D{layer.storage(), layer.format(), layer.type(), {layer.size(), 1}, layer.data()});
+    }
+
+    if(flags & UploadFlag::GenerateMipmap) texture.generateMipmap();
+}
+#endif
+
+}}
@@ -0,0 +1,145 @@
+#ifndef Magnum_TextureTools_Upload_h
+#define Magnum_TextureTools_Upload_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::TextureTools::UploadFlag, enum set @ref Magnum::TextureTools::UploadFlags, function @ref Magnum::TextureTools::mipLevelCount(), @ref Magnum::TextureTools::upload()
+ */
+
+#include <vector>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Texture upload flag
+
+@see @ref UploadFlags, @ref upload()
+*/
+enum class UploadFlag: UnsignedByte {
+    /**
+     * Allocate the full mip chain and generate the levels that weren't
+     * supplied using @ref Texture::generateMipmap() from the last supplied
+     * one.
+     */
+    GenerateMipmap = 1 << 0
+};
+
+/**
+@brief Texture upload flags
+
+@see @ref upload()
+*/
+typedef Containers::EnumSet<UploadFlag> UploadFlags;
+
+CORRADE_ENUMSET_OPERATORS(UploadFlags)
+
+/**
+@brief Mip level count for given size
+
+Count of levels in full mip chain for texture of given size, i.e.
+@f$ \lfloor \log_2 \max(w, h) \rfloor + 1 @f$.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Int mipLevelCount(const Vector2i& size);
+
+/**
+@brief Upload image with mip levels to a texture
+@param texture          Texture to upload to
+@param internalFormat   Texture internal format
+@param levels           Image for each mip level, starting with the base
+    level
+@param flags            Upload flags
+
+Allocates immutable texture storage using a single call to
+@ref Texture::setStorage() and uploads all levels in one pass, avoiding
+reallocation and revalidation done by the driver when calling
+@ref Texture::setImage() for each level separately. Size of each level is
+expected to be half of the previous level, rounded down and clamped to `1`.
+If @ref UploadFlag::GenerateMipmap is set, storage for the full mip chain is
+allocated and the remaining levels are generated on the GPU.
+
+If more than one level is supplied, the data are copied into a single
+staging @ref Buffer and each level is uploaded from it with an offset, so
+there is only one buffer allocation per texture. Pixel unpack state is set
+only when it differs from the previous level. On OpenGL ES 2.0 and WebGL 1.0
+the levels are uploaded directly from client memory.
+
+@code
+std::optional<Trade::ImageData2D> image = importer->image2D(0);
+
+Texture2D texture;
+texture.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear);
+TextureTools::upload(texture, TextureFormat::RGBA8, {ImageView2D(*image)},
+    TextureTools::UploadFlag::GenerateMipmap);
+@endcode
+
+The texture must not have storage allocated yet.
+@see @ref mipLevelCount(), @ref generateMipmaps()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void upload(Texture2D& texture, TextureFormat internalFormat, const std::vector<ImageView2D>& levels, UploadFlags flags = {});
+
+/**
+@brief Upload imported image with mip levels to a texture
+
+If the images are uncompressed, the data are uploaded the same way as in
+@ref upload(Texture2D&, TextureFormat, const std::vector<ImageView2D>&, UploadFlags).
+Compressed images are uploaded using @ref Texture::setCompressedSubImage()
+with internal format matching the compressed format, @p internalFormat is
+ignored in that case and @ref UploadFlag::GenerateMipmap is not allowed. All
+levels are expected to be either compressed or uncompressed.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void upload(Texture2D& texture, TextureFormat internalFormat, const std::vector<Trade::ImageData2D>& levels, UploadFlags flags = {});
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Upload images as layers of a texture array
+@param texture          Texture array to upload to
+@param internalFormat   Texture internal format
+@param layers           Base level image for each layer
+@param flags            Upload flags
+
+Allocates immutable storage for all layers using a single call to
+@ref TextureArray::setStorage() and uploads each image into one layer of the
+base level. All images are expected to have the same size. If
+@ref UploadFlag::GenerateMipmap is set, storage for the full mip chain is
+allocated and the remaining levels are generated on the GPU. Useful together
+with @ref TextureArrayPacker.
+
+The texture must not have storage allocated yet.
+@requires_gl30 Extension @extension{EXT,texture_array}
+@requires_gles30 Texture arrays are not available in OpenGL ES 2.0.
+@requires_webgl20 Texture arrays are not available in WebGL 1.0.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void upload(Texture2DArray& texture, TextureFormat internalFormat, const std::vector<ImageView2D>& layers, UploadFlags flags = {});
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VirtualTexture.h"
+
+#include <algorithm>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Texture.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+    inline Vector2i levelSize(const Vector2i& size, const Int level) {
+        return Math::max(size >> level, Vector2i{1});
+    }
+}
+
+VirtualTexture::VirtualTexture(const Vector2i& size, const Int levels, const Vector2i& tileSize, const Int sparseLevelCount): _size{size}, _tileSize{tileSize}, _levels{levels}, _sparseLevelCount{Math::min(sparseLevelCount, levels)}, _commitBudget{32}, _residentTileLimit{~UnsignedInt{}}, _frame{}, _tailResident{} {
+    CORRADE_ASSERT(!tileSize.isZero(),
+        "TextureTools::VirtualTexture: tile size must not be zero", );
+}
+
+Vector2i VirtualTexture::tileCount(const Int level) const {
+    return (levelSize(_size, level) + _tileSize - Vector2i{1})/_tileSize;
+}
+
+Range2Di VirtualTexture::tileRange(const Tile& tile) const {
+    const Vector2i size = levelSize(_size, tile.level);
+    if(tile.level >= _sparseLevelCount) return {{}, size};
+
+    const Vector2i min = tile.coordinates*_tileSize;
+    return {min, Math::min(min + _tileSize, size)};
+}
+
+bool VirtualTexture::isResident(const Tile& tile) const {
+    if(tile.level >= _sparseLevelCount) return _tailResident;
+    return _resident.find(packTile(tile.coordinates, tile.level)) != _resident.end();
+}
+
+void VirtualTexture::processFeedback(const Containers::ArrayView<const UnsignedInt> feedback) {
+    for(const UnsignedInt id: feedback) {
+        if(!(id & 0x80000000u)) continue;
+
+        /* Tiles in the mip tail are always resident, everything out of
+           bounds is garbage */
+        const Tile tile = unpackTile(id);
+        if(tile.level >= _sparseLevelCount) continue;
+        const Vector2i count = tileCount(tile.level);
+        if(tile.coordinates.x() >= count.x() || tile.coordinates.y() >= count.y()) continue;
+
+        _requested.push_back(id);
+    }
+}
+
+VirtualTexture::Changes VirtualTexture::update() {
+    Changes changes;
+    ++_frame;
+
+    /* The mip tail is committed first and stays resident */
+    if(!_tailResident && _sparseLevelCount < _levels) {
+        changes.commit.push_back({{}, _sparseLevelCount});
+        _tailResident = true;
+    }
+
+    /* Add parents of all requested tiles so there's always something to fall
+       back to, then remove duplicates. The feedback usually contains the same
+       tile many times, so deduplicate it first to make this cheaper. */
+    std::sort(_requested.begin(), _requested.end());
+    _requested.erase(std::unique(_requested.begin(), _requested.end()), _requested.end());
+    const std::size_t requestedCount = _requested.size();
+    for(std::size_t i = 0; i != requestedCount; ++i) {
+        Tile tile = unpackTile(_requested[i]);
+        for(++tile.level; tile.level < _sparseLevelCount; ++tile.level) {
+            tile.coordinates /= 2;
+            _requested.push_back(packTile(tile.coordinates, tile.level));
+        }
+    }
+
+    /* Coarser levels first, so if the budget is exhausted, the finer tiles
+       are committed in the next updates and in the meantime the parents are
+       sampled instead */
+    std::sort(_requested.begin(), _requested.end(), [](UnsignedInt a, UnsignedInt b) {
+        return a > b;
+    });
+    _requested.erase(std::unique(_requested.begin(), _requested.end()), _requested.end());
+
+    UnsignedInt budget = _commitBudget;
+    for(const UnsignedInt id: _requested) {
+        auto found = _resident.find(id);
+        if(found != _resident.end()) {
+            found->second = _frame;
+            continue;
+        }
+
+        if(!budget) continue;
+        --budget;
+        _resident.emplace(id, _frame);
+        changes.commit.push_back(unpackTile(id));
+    }
+    _requested.clear();
+
+    /* Decommit least recently requested tiles over the limit. Tiles
+       requested in this update are never decommitted. */
+    if(_resident.size() > _residentTileLimit) {
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> candidates;
+        for(const auto& tile: _resident)
+            if(tile.second != _frame) candidates.emplace_back(tile.second, tile.first);
+
+        const std::size_t count = Math::min(_resident.size() - _residentTileLimit, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+        for(std::size_t i = 0; i != count; ++i) {
+            _resident.erase(candidates[i].second);
+            changes.decommit.push_back(unpackTile(candidates[i].second));
+        }
+    }
+
+    return changes;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+std::vector<VirtualTexture::Tile> VirtualTexture::update(Texture2D& texture) {
+    Changes changes = update();
+    for(const Tile& tile: changes.decommit)
+        texture.decommitPages(tile.level, tileRange(tile));
+    for(const Tile& tile: changes.commit)
+        texture.commitPages(tile.level, tileRange(tile));
+    return std::move(changes.commit);
+}
+#endif
+
+}}
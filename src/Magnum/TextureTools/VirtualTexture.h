@@ -0,0 +1,275 @@
+#ifndef Magnum_TextureTools_VirtualTexture_h
+#define Magnum_TextureTools_VirtualTexture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::VirtualTexture
+ */
+
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Feedback-driven virtual texture residency manager
+
+Decides which tiles of a large sparse texture should be backed by physical
+memory, based on which tiles were actually sampled in the last frame. The
+texture is expected to have storage allocated with
+@ref Texture2D::setSparseStorage() and the tile size to be equal to
+@ref Texture2D::sparsePageSize().
+
+The visible tiles are determined by rendering the scene in low resolution
+(e.g. a sixteenth of the framebuffer size) into an integer
+@ref TextureFormat::R32UI attachment, writing the packed ID of the tile that
+would be sampled instead of the color. The buffer is cleared to `0`, which
+marks pixels with no virtual texture sample. The packing is the same as in
+@ref packTile():
+@code
+uniform ivec2 virtualTextureSize;
+uniform ivec2 pageSize;
+uniform int sparseLevelCount;
+
+uint feedback(vec2 textureCoordinates) {
+    vec2 texel = textureCoordinates*vec2(virtualTextureSize);
+    vec2 dx = dFdx(texel), dy = dFdy(texel);
+    int level = clamp(int(0.5*log2(max(dot(dx, dx), dot(dy, dy)))), 0, sparseLevelCount - 1);
+    uvec2 tile = uvec2(clamp(texel, vec2(0.0), vec2(virtualTextureSize - 1)))/uvec2(pageSize << level);
+    return 0x80000000u|(uint(level) << 24)|(tile.y << 12)|tile.x;
+}
+@endcode
+
+The buffer is then read back (preferably asynchronously through a
+@ref BufferImage2D to avoid a pipeline stall, one frame of latency is
+acceptable) and passed to @ref processFeedback(). Calling @ref update() once a
+frame then commits the newly requested tiles and returns them so the
+application can upload their data:
+@code
+Texture2D texture;
+texture.setSparseStorage(levels, TextureFormat::RGBA8, size);
+
+TextureTools::VirtualTexture virtualTexture{size, levels,
+    Texture2D::sparsePageSize(TextureFormat::RGBA8).xy(),
+    texture.sparseLevelCount()};
+virtualTexture.setResidentTileLimit(4096);
+
+// each frame
+virtualTexture.processFeedback(feedbackData);
+for(const TextureTools::VirtualTexture::Tile& tile: virtualTexture.update(texture))
+    texture.setSubImage(tile.level, virtualTexture.tileRange(tile).min(), loadTile(tile));
+@endcode
+
+Besides the requested tiles, also all their parent tiles in coarser mip levels
+are kept resident, so there's always lower-resolution data to fall back to
+while the finer tiles are being streamed in. Mip levels starting from
+@ref sparseLevelCount() form the *mip tail*, which is committed as a whole in
+the first @ref update() and never decommitted. It is represented by a single
+tile at coordinates `{0, 0}` in level @ref sparseLevelCount() and the
+application is expected to upload all remaining levels when it is returned.
+
+To limit the upload cost, at most @ref commitBudget() tiles are committed in
+a single @ref update(), coarser levels first. If the count of resident tiles
+exceeds @ref residentTileLimit(), tiles that weren't requested for the
+longest time are decommitted.
+
+The residency logic itself doesn't need any OpenGL context, see
+@ref update() for a variant that only calculates the changes.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT VirtualTexture {
+    public:
+        /** @brief Virtual texture tile */
+        struct Tile {
+            Vector2i coordinates;   /**< @brief Tile coordinates in given level */
+            Int level;              /**< @brief Mip level */
+
+            /** @brief Equality comparison */
+            bool operator==(const Tile& other) const {
+                return coordinates == other.coordinates && level == other.level;
+            }
+
+            /** @brief Non-equality comparison */
+            bool operator!=(const Tile& other) const {
+                return !operator==(other);
+            }
+        };
+
+        /**
+         * @brief Residency changes
+         *
+         * @see @ref update()
+         */
+        struct Changes {
+            std::vector<Tile> commit;   /**< @brief Tiles to commit */
+            std::vector<Tile> decommit; /**< @brief Tiles to decommit */
+        };
+
+        /**
+         * @brief Pack tile ID for feedback
+         *
+         * The tile coordinates are stored in the lower 24 bits, 12 bits for
+         * each, the level in the next 7 bits and the highest bit is always
+         * set to distinguish valid samples from cleared pixels.
+         * @see @ref unpackTile()
+         */
+        static UnsignedInt packTile(const Vector2i& coordinates, Int level) {
+            return 0x80000000u|(UnsignedInt(level & 0x7f) << 24)|(UnsignedInt(coordinates.y() & 0xfff) << 12)|UnsignedInt(coordinates.x() & 0xfff);
+        }
+
+        /**
+         * @brief Unpack tile ID
+         *
+         * Inverse to @ref packTile(). The highest bit is ignored.
+         */
+        static Tile unpackTile(UnsignedInt id) {
+            return {{Int(id & 0xfff), Int((id >> 12) & 0xfff)}, Int((id >> 24) & 0x7f)};
+        }
+
+        /**
+         * @brief Constructor
+         * @param size              Size of the largest mip level
+         * @param levels            Mip level count
+         * @param tileSize          Tile size, equal to
+         *      @ref Texture2D::sparsePageSize()
+         * @param sparseLevelCount  Count of levels that are not part of the
+         *      mip tail, equal to @ref Texture2D::sparseLevelCount()
+         */
+        explicit VirtualTexture(const Vector2i& size, Int levels, const Vector2i& tileSize, Int sparseLevelCount);
+
+        /** @brief Size of the largest mip level */
+        Vector2i size() const { return _size; }
+
+        /** @brief Mip level count */
+        Int levelCount() const { return _levels; }
+
+        /** @brief Tile size */
+        Vector2i tileSize() const { return _tileSize; }
+
+        /** @brief Count of levels that are not part of the mip tail */
+        Int sparseLevelCount() const { return _sparseLevelCount; }
+
+        /** @brief Tile count in given level */
+        Vector2i tileCount(Int level) const;
+
+        /**
+         * @brief Tile range
+         *
+         * Range of pixels covered by given tile in its mip level, clamped to
+         * the level size. For the mip tail tile returns the whole level.
+         */
+        Range2Di tileRange(const Tile& tile) const;
+
+        /** @brief Max count of tiles committed in one @ref update() */
+        UnsignedInt commitBudget() const { return _commitBudget; }
+
+        /**
+         * @brief Set max count of tiles committed in one update
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `32`.
+         */
+        VirtualTexture& setCommitBudget(UnsignedInt budget) {
+            _commitBudget = budget;
+            return *this;
+        }
+
+        /** @brief Max count of resident tiles */
+        UnsignedInt residentTileLimit() const { return _residentTileLimit; }
+
+        /**
+         * @brief Set max count of resident tiles
+         * @return Reference to self (for method chaining)
+         *
+         * The mip tail is not included in the count. Tiles requested in the
+         * current update are never decommitted, so the limit can be
+         * temporarily exceeded. Default is unlimited, i.e. tiles are never
+         * decommitted.
+         */
+        VirtualTexture& setResidentTileLimit(UnsignedInt limit) {
+            _residentTileLimit = limit;
+            return *this;
+        }
+
+        /** @brief Count of resident tiles, excluding the mip tail */
+        std::size_t residentTileCount() const { return _resident.size(); }
+
+        /** @brief Whether given tile is resident */
+        bool isResident(const Tile& tile) const;
+
+        /**
+         * @brief Process feedback buffer
+         *
+         * Records tiles requested in given feedback buffer for the next
+         * @ref update(). Zero values and tiles outside of the texture are
+         * ignored, tiles in the mip tail are always resident. Can be called
+         * more than once per frame.
+         */
+        void processFeedback(Containers::ArrayView<const UnsignedInt> feedback);
+
+        /**
+         * @brief Update residency
+         *
+         * Calculates which tiles need to be committed and decommitted based
+         * on feedback recorded since last update. The internal state is
+         * updated as if the changes were already applied, it's up to the
+         * caller to apply them to the texture, decommitting first.
+         */
+        Changes update();
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Update residency of given texture
+         *
+         * Calls @ref update(), decommits and commits the pages in
+         * @p texture using @ref Texture2D::decommitPages() and
+         * @ref Texture2D::commitPages() and returns the newly committed
+         * tiles, for which the application needs to upload data.
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        std::vector<Tile> update(Texture2D& texture);
+        #endif
+
+    private:
+        Vector2i _size, _tileSize;
+        Int _levels, _sparseLevelCount;
+        UnsignedInt _commitBudget, _residentTileLimit, _frame;
+        bool _tailResident;
+
+        /* Requested tiles and resident tiles with the update in which they
+           were requested last, both as IDs from packTile() */
+        std::vector<UnsignedInt> _requested;
+        std::unordered_map<UnsignedInt, UnsignedInt> _resident;
+};
+
+}}
+
+#endif
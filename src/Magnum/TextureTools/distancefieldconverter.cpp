@@ -63,7 +63,7 @@ namespace Magnum {
 
 @section magnum-distancefieldconverter-usage Usage
 
-    magnum-distancefieldconverter [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N [--] input output
+    magnum-distancefieldconverter [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--cpu] [--jump-flooding] [--threads N] --output-size "X Y" --radius N [--] input output
 
 Arguments:
 
@@ -76,6 +76,13 @@ Arguments:
     Magnum install location)
 -   `--output-size "X Y"` -- size of output image
 -   `--radius N` -- distance field computation radius
+-   `--cpu` -- compute the distance field on the CPU instead of the GPU,
+    doesn't need any OpenGL context
+-   `--jump-flooding` -- compute the distance field on the GPU using jump
+    flooding, which is much faster for large radii. Not available in OpenGL
+    ES 2.0 and WebGL 1.0.
+-   `--threads N` -- count of threads used for computing on the CPU (default:
+    `0`, which means count of available CPU cores)
 
 Images with @ref PixelFormat::Red, @ref PixelFormat::RGB or @ref PixelFormat::RGBA
 are accepted on input.
@@ -92,6 +99,10 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
+    magnum-distancefieldconverter --cpu --output-size "256 256" --radius 24 logo-src.png logo.png
+
+The same, but done on the CPU. Useful e.g. on build servers without any GPU.
+
 */
 
 namespace TextureTools {
@@ -114,11 +125,17 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("plugin-dir", MAGNUM_PLUGINS_DIR).setHelp("plugin-dir", "base plugin dir", "DIR")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "compute the distance field on the CPU")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addBooleanOption("jump-flooding").setHelp("jump-flooding", "compute the distance field on the GPU using jump flooding")
+        #endif
+        .addOption("threads", "0").setHelp("threads", "count of threads used for computing on the CPU, 0 means count of CPU cores", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    /* Context is not needed for CPU conversion */
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -141,6 +158,27 @@ int DistanceFieldConverter::exec() {
         return 1;
     }
 
+    /* Do it on the CPU, if requested */
+    if(args.isSet("cpu")) {
+        if(image->type() != PixelType::UnsignedByte || (image->format() != PixelFormat::Red && image->format() != PixelFormat::RGB && image->format() != PixelFormat::RGBA)) {
+            Error() << "Unsupported image format" << image->format() << image->type();
+            return 1;
+        }
+
+        const Vector2i outputSize = args.value<Vector2i>("output-size");
+        Image2D result{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, outputSize, Containers::Array<char>(outputSize.product())};
+
+        Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+        TextureTools::distanceField(*image, result, {{}, outputSize}, args.value<Int>("radius"), args.value<UnsignedInt>("threads"));
+
+        if(!converter->exportToFile(result, args.value("output"))) {
+            Error() << "Cannot save file" << args.value("output");
+            return 1;
+        }
+
+        return 0;
+    }
+
     /* Decide about internal format */
     TextureFormat internalFormat;
     if(image->format() == PixelFormat::Red) internalFormat = TextureFormat::R8;
@@ -167,7 +205,14 @@ int DistanceFieldConverter::exec() {
 
     /* Do it */
     Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::distanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
+    #ifndef MAGNUM_TARGET_GLES2
+    if(args.isSet("jump-flooding"))
+        TextureTools::jumpFloodingDistanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
+    else
+    #endif
+    {
+        TextureTools::distanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
+    }
 
     /* Save image */
     Image2D result(PixelFormat::Red, PixelType::UnsignedByte);
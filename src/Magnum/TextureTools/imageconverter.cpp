@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/TextureTools/BatchImageConverter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "imageconverterConfigure.h"
+
+namespace Magnum {
+
+/** @page magnum-imageconverter Batch image conversion utility
+@brief Converts images in parallel, optionally generating mip levels
+
+@section magnum-imageconverter-usage Usage
+
+    magnum-imageconverter [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--threads N] [--memory-budget MB] [--mipmaps] [--filter FILTER] [--srgb] [--force] [--output-dir DIR] --extension EXT [--] input
+
+Arguments:
+
+-   `input` -- text file with a list of input images, one per line
+-   `-h`, `--help` -- display help message and exit
+-   `--importer IMPORTER` -- image importer plugin (default: @ref Trade::AnyImageImporter "AnyImageImporter")
+-   `--converter CONVERTER` -- image converter plugin (default: @ref Trade::AnyImageConverter "AnyImageConverter")
+-   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
+    Magnum install location)
+-   `--threads N` -- count of worker threads (default: `0`, which means
+    count of available CPU cores)
+-   `--memory-budget MB` -- memory used by conversions in progress, in
+    megabytes (default: `512`)
+-   `--mipmaps` -- generate mip levels
+-   `--filter FILTER` -- mip level downsample filter, `box` or `kaiser`
+    (default: `box`)
+-   `--srgb` -- treat the images as sRGB when generating mip levels
+-   `--force` -- convert also images with up-to-date output
+-   `--output-dir DIR` -- directory to put the output images into (default:
+    directory of each input image)
+-   `--extension EXT` -- output file extension
+
+The output filename is the input filename with extension replaced by `EXT`.
+The images are converted using @ref TextureTools::BatchImageConverter, see
+its documentation for details about mip level naming, memory budget and
+skipping of up-to-date outputs.
+
+@section magnum-imageconverter-example Example usage
+
+    ls textures/*.png > textures.txt
+    magnum-imageconverter --mipmaps --srgb --extension tga textures.txt
+
+This will convert all PNG files in the `textures/` directory to TGA files
+next to them using any plugins that can read PNG files and write TGA files.
+A chain of sRGB-correct mip levels is generated for each image. Running the
+command again converts only the images that changed in the meantime.
+
+*/
+
+}
+
+int main(int argc, char** argv) {
+    using namespace Magnum;
+
+    Utility::Arguments args;
+    args.addArgument("input").setHelp("input", "text file with a list of input images, one per line")
+        .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
+        .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
+        .addOption("plugin-dir", MAGNUM_PLUGINS_DIR).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addOption("threads", "0").setHelp("threads", "count of worker threads, 0 means count of CPU cores", "N")
+        .addOption("memory-budget", "512").setHelp("memory-budget", "memory used by conversions in progress, in megabytes", "MB")
+        .addBooleanOption("mipmaps").setHelp("mipmaps", "generate mip levels")
+        .addOption("filter", "box").setHelp("filter", "mip level downsample filter, box or kaiser", "FILTER")
+        .addBooleanOption("srgb").setHelp("srgb", "treat the images as sRGB when generating mip levels")
+        .addBooleanOption("force").setHelp("force", "convert also images with up-to-date output")
+        .addOption("output-dir").setHelp("output-dir", "directory to put the output images into", "DIR")
+        .addNamedArgument("extension").setHelp("extension", "output file extension", "EXT")
+        .setHelp("Converts images in parallel, optionally generating mip levels.")
+        .parse(argc, argv);
+
+    TextureTools::DownsampleFilter filter;
+    if(args.value("filter") == "box") filter = TextureTools::DownsampleFilter::Box;
+    else if(args.value("filter") == "kaiser") filter = TextureTools::DownsampleFilter::Kaiser;
+    else {
+        Error() << "Unknown filter" << args.value("filter");
+        return 1;
+    }
+
+    /* Load importer plugin */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager(Utility::Directory::join(args.value("plugin-dir"), "importers/"));
+    if(!(importerManager.load(args.value("importer")) & PluginManager::LoadState::Loaded))
+        return 1;
+
+    /* Load converter plugin */
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager(Utility::Directory::join(args.value("plugin-dir"), "imageconverters/"));
+    if(!(converterManager.load(args.value("converter")) & PluginManager::LoadState::Loaded))
+        return 1;
+
+    TextureTools::BatchImageConverter converter{importerManager, args.value("importer"), converterManager, args.value("converter"), args.value<UnsignedInt>("threads")};
+    converter.setMipmapGenerationEnabled(args.isSet("mipmaps"))
+        .setDownsampleFilter(filter)
+        .setColorSpace(args.isSet("srgb") ? TextureTools::ColorSpace::Srgb : TextureTools::ColorSpace::Linear)
+        .setMemoryBudget(args.value<std::size_t>("memory-budget")*1024*1024)
+        .setSkipUpToDateEnabled(!args.isSet("force"));
+
+    if(!Utility::Directory::fileExists(args.value("input"))) {
+        Error() << "Cannot open file" << args.value("input");
+        return 1;
+    }
+
+    /* Replace the extension and optionally the directory */
+    for(std::string input: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(args.value("input")), '\n')) {
+        /* Files with Windows line endings */
+        if(input.back() == '\r') input.pop_back();
+        if(input.empty()) continue;
+
+        const std::size_t slash = input.rfind('/');
+        const std::size_t dot = input.rfind('.');
+        std::string output = (dot == std::string::npos || (slash != std::string::npos && dot < slash) ? input : input.substr(0, dot)) + '.' + args.value("extension");
+        if(!args.value("output-dir").empty())
+            output = Utility::Directory::join(args.value("output-dir"), Utility::Directory::filename(output));
+
+        if(output == input) {
+            Error() << "Refusing to overwrite input file" << input;
+            return 1;
+        }
+
+        converter.add(input, output);
+    }
+
+    Debug() << "Converting" << converter.pendingCount() << "images on" << converter.threadCount() << "threads...";
+    const TextureTools::BatchImageConverter::Statistics stats = converter.convert();
+    Debug() << "Converted" << stats.convertedCount << "images, skipped" << stats.skippedCount << "up-to-date, peak memory use" << stats.peakMemory/1024/1024 << "MB";
+
+    if(stats.failedCount) {
+        Error() << stats.failedCount << "images failed to convert";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,296 @@
+#ifndef Magnum_ThreadedResourceLoader_h
+#define Magnum_ThreadedResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::ThreadedResourceLoader
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum {
+
+/**
+@brief Base for resource loaders decoding data on worker threads
+@tparam T   Resource type
+@tparam U   Intermediate CPU-side data type
+
+Splits loading of each resource into two steps. The first step, implemented in
+@ref doDecode(), runs on a pool of worker threads and does everything that
+doesn't need the OpenGL context --- file I/O, running the importer, processing
+the data with @ref MeshTools etc. The second step, implemented in
+@ref doCreate(), runs on the thread owning the OpenGL context and the
+@ref ResourceManager, turning the decoded data into the final object and
+passing it to the manager using @ref set().
+
+## Usage
+
+Requesting a resource from the manager only puts its key into a job queue, the
+resource stays in @ref ResourceState::Loading (or
+@ref ResourceState::LoadingFallback) state. Call @ref update() once per frame
+to create objects for the resources that finished decoding. Creation can be
+limited by a time budget so a burst of finished resources doesn't cause a
+frame hitch. Existing @ref Resource instances pick up the loaded data
+automatically, switching from the fallback to the real data without any
+intervention.
+@code
+class MeshLoader: public ThreadedResourceLoader<Mesh, Trade::MeshData3D> {
+    public:
+        ~MeshLoader() { stop(); }
+
+    private:
+        std::optional<Trade::MeshData3D> doDecode(ResourceKey key) override {
+            // Open a file using a per-thread importer instance, return the
+            // data or std::nullopt if not found...
+        }
+
+        void doCreate(ResourceKey key, Trade::MeshData3D&& data) override {
+            Mesh mesh;
+            // Upload the data...
+            set(key, std::move(mesh));
+        }
+};
+
+MeshLoader loader;
+manager.setLoader(&loader);
+
+// Each frame
+loader.update(std::chrono::milliseconds{2});
+@endcode
+
+## Thread safety
+
+@ref doDecode() is called concurrently from all worker threads, it must not
+access the @ref ResourceManager nor any state shared with other threads
+without its own synchronization. All other functions, including
+@ref doCreate() and the manager itself, are used only from the thread calling
+@ref update(), thus the manager doesn't need any locking. Subclasses have to
+call @ref stop() in their destructor so no worker thread calls @ref doDecode()
+on a partially destroyed object.
+*/
+template<class T, class U> class ThreadedResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Worker thread count. If `0`, count of
+         *      hardware threads is used.
+         */
+        explicit ThreadedResourceLoader(UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop(), but that is too late to be safe, see class
+         * documentation for more information.
+         */
+        ~ThreadedResourceLoader();
+
+        /** @brief Worker thread count */
+        UnsignedInt threadCount() const { return _threads.size(); }
+
+        /**
+         * @brief Count of resources waiting for creation
+         *
+         * Resources that are queued or being decoded plus resources that are
+         * decoded, but @ref update() wasn't yet called for them. Thread-safe.
+         */
+        std::size_t pendingCount();
+
+        /**
+         * @brief Create decoded resources
+         * @param budget    Time budget
+         * @return Count of resources processed
+         *
+         * Calls @ref doCreate() for the resources that finished decoding, or
+         * marks them as not found if decoding failed. Stops after the time
+         * budget is exceeded, but always processes at least one resource if
+         * there is any, so loading makes progress even with zero budget.
+         * Never waits for the worker threads. Call on the thread owning the
+         * @ref ResourceManager, preferably once per frame.
+         */
+        std::size_t update(std::chrono::microseconds budget = std::chrono::microseconds::max());
+
+        /**
+         * @brief Wait for all queued resources to be decoded
+         *
+         * Blocks until the job queue is empty and no worker thread is
+         * decoding. Decoded resources still need to be created using
+         * @ref update().
+         */
+        void wait();
+
+        /**
+         * @brief Stop worker threads
+         *
+         * Waits for the resources currently being decoded and then joins all
+         * worker threads. Resources that weren't yet picked up by any worker
+         * stay in loading state. Must be called from destructor of the
+         * subclass, calling it more than once is a no-op.
+         */
+        void stop();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Decode the resource
+         *
+         * Called from a worker thread. Return `std::nullopt` if the
+         * resource was not found. See class documentation for thread safety
+         * considerations.
+         */
+        virtual std::optional<U> doDecode(ResourceKey key) = 0;
+
+        /**
+         * @brief Create the resource from decoded data
+         *
+         * Called from @ref update(). The implementation is expected to call
+         * either @ref set() or @ref setNotFound() for given @p key.
+         */
+        virtual void doCreate(ResourceKey key, U&& data) = 0;
+
+    private:
+        void doLoad(ResourceKey key) override final;
+
+        void run();
+
+        std::vector<std::thread> _threads;
+
+        /* Shared with the worker threads */
+        std::mutex _mutex;
+        std::condition_variable _jobCondition, _doneCondition;
+        std::deque<ResourceKey> _jobs;
+        std::deque<std::pair<ResourceKey, std::optional<U>>> _decoded;
+        std::size_t _running;
+        bool _stopped;
+};
+
+template<class T, class U> ThreadedResourceLoader<T, U>::ThreadedResourceLoader(UnsignedInt threadCount): _running{}, _stopped{} {
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _threads.reserve(threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i)
+        _threads.emplace_back(&ThreadedResourceLoader<T, U>::run, this);
+}
+
+template<class T, class U> ThreadedResourceLoader<T, U>::~ThreadedResourceLoader() { stop(); }
+
+template<class T, class U> std::size_t ThreadedResourceLoader<T, U>::pendingCount() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _jobs.size() + _running + _decoded.size();
+}
+
+template<class T, class U> void ThreadedResourceLoader<T, U>::doLoad(const ResourceKey key) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _jobs.push_back(key);
+    }
+    _jobCondition.notify_one();
+}
+
+template<class T, class U> void ThreadedResourceLoader<T, U>::run() {
+    for(;;) {
+        ResourceKey key;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _jobCondition.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+            if(_stopped) return;
+
+            key = _jobs.front();
+            _jobs.pop_front();
+            ++_running;
+        }
+
+        std::optional<U> data = doDecode(key);
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _decoded.emplace_back(key, std::move(data));
+            --_running;
+        }
+        _doneCondition.notify_all();
+    }
+}
+
+template<class T, class U> std::size_t ThreadedResourceLoader<T, U>::update(const std::chrono::microseconds budget) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::size_t count = 0;
+    for(;;) {
+        std::pair<ResourceKey, std::optional<U>> decoded;
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            if(_decoded.empty()) break;
+
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+
+        if(decoded.second) doCreate(decoded.first, std::move(*decoded.second));
+        else this->setNotFound(decoded.first);
+        ++count;
+
+        /* Cast to the budget type, the other way would overflow with the
+           default unlimited budget */
+        if(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start) >= budget) break;
+    }
+
+    return count;
+}
+
+template<class T, class U> void ThreadedResourceLoader<T, U>::wait() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _doneCondition.wait(lock, [this]() { return _stopped || (_jobs.empty() && !_running); });
+}
+
+template<class T, class U> void ThreadedResourceLoader<T, U>::stop() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopped = true;
+    }
+    _jobCondition.notify_all();
+    _doneCondition.notify_all();
+
+    for(std::thread& thread: _threads) thread.join();
+    _threads.clear();
+}
+
+}
+
+#endif
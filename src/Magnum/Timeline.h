@@ -88,6 +88,9 @@ void MyApplication::drawEvent() {
     timeline.nextFrame();
 }
 @endcode
+
+To run simulation with a constant step independently of the framerate, feed
+@ref previousFrameDuration() to @ref FixedStepTimeline.
 */
 class MAGNUM_EXPORT Timeline {
     public:
@@ -0,0 +1,83 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Tracing.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/Context.h"
+#include "Magnum/DebugOutput.h"
+
+#include "Implementation/DebugState.h"
+#include "Implementation/State.h"
+#endif
+
+namespace Magnum {
+
+namespace {
+    struct {
+        Tracing::Callback begin;
+        Tracing::Callback end;
+        void* userData;
+        bool gpuMarkers;
+    } state{};
+}
+
+void Tracing::setCallbacks(const Callback begin, const Callback end, void* const userData) {
+    CORRADE_ASSERT(!begin == !end,
+        "Tracing::setCallbacks(): either both or none of the callbacks has to be set", );
+    state.begin = begin;
+    state.end = end;
+    state.userData = userData;
+}
+
+void Tracing::setGpuMarkersEnabled(const bool enabled) {
+    state.gpuMarkers = enabled;
+}
+
+Tracing::Zone::Zone(const Location& location): _location(location), _callbacks{state.begin != nullptr}, _gpuMarker{false} {
+    if(_callbacks) state.begin(location, state.userData);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(state.gpuMarkers && location.gpu && Context::hasCurrent()) {
+        _gpuMarker = true;
+        Context::current().state().debug->pushGroupImplementation(DebugGroup::Source::ThirdParty, 0, {location.name, std::strlen(location.name)});
+    }
+    #endif
+}
+
+Tracing::Zone::~Zone() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuMarker) Context::current().state().debug->popGroupImplementation();
+    #endif
+
+    /* Callbacks might have been reset in the meantime, then there's no end
+       to call */
+    if(_callbacks && state.end) state.end(_location, state.userData);
+}
+
+}
@@ -0,0 +1,176 @@
+#ifndef Magnum_Tracing_h
+#define Magnum_Tracing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Tracing, macro @ref MAGNUM_TRACE_ZONE(), @ref MAGNUM_TRACE_CPU_ZONE()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Hot path tracing hooks
+
+Forwards begin/end events of instrumented zones inside the library to a
+user-registered sink, such as a Tracy, ITT or Perfetto adapter. Instrumented
+are @ref Mesh::draw(), @ref MeshView::draw(), texture `setSubImage()`,
+@ref SceneGraph::Camera::draw(), @ref SceneGraph::Object::setClean() and
+@ref Text::Renderer::render().
+
+The zones are compiled in only if the library is built with
+@ref MAGNUM_BUILD_TRACING, otherwise @ref MAGNUM_TRACE_ZONE() and
+@ref MAGNUM_TRACE_CPU_ZONE() expand to nothing. Even if compiled in, a zone
+does nothing more than a single branch until callbacks are set or GPU markers
+are enabled:
+@code
+void begin(const Tracing::Location& location, void*) {
+    ___tracy_emit_zone_begin(...);
+}
+void end(const Tracing::Location&, void*) {
+    ___tracy_emit_zone_end(...);
+}
+
+Tracing::setCallbacks(begin, end);
+@endcode
+
+With @ref setGpuMarkersEnabled() the zones that issue GL commands are also
+wrapped in a debug group, so they can be seen in graphics debuggers. See
+@ref DebugGroup for more information.
+
+The callbacks are global for the whole process, not specific to a
+@ref Context. Set them before any instrumented code runs, changing them while
+other threads are in an instrumented zone is not safe.
+*/
+class MAGNUM_EXPORT Tracing {
+    public:
+        /**
+         * @brief Static source location of an instrumented zone
+         *
+         * Created by @ref MAGNUM_TRACE_ZONE() and @ref MAGNUM_TRACE_CPU_ZONE()
+         * as a function-local static variable, so its address is stable and
+         * can be used as a zone identifier.
+         */
+        struct Location {
+            const char* name;       /**< @brief Zone name */
+            const char* function;   /**< @brief Function name */
+            const char* file;       /**< @brief Source file */
+            UnsignedInt line;       /**< @brief Source line */
+            bool gpu;               /**< @brief Whether the zone issues GL commands */
+        };
+
+        /**
+         * @brief Zone callback
+         *
+         * The second parameter is the user data passed to
+         * @ref setCallbacks().
+         */
+        typedef void(*Callback)(const Location&, void*);
+
+        /**
+         * @brief Set zone callbacks
+         *
+         * Pass `nullptr` to both to disable the callbacks. Expects
+         * that either both or none of the callbacks are set.
+         */
+        static void setCallbacks(Callback begin, Callback end, void* userData = nullptr);
+
+        /**
+         * @brief Enable GPU-side markers
+         *
+         * If enabled and a context with @extension{KHR,debug} or
+         * @extension2{EXT,debug_marker} is current, zones that issue GL
+         * commands push a debug group with @ref DebugGroup::Source::ThirdParty
+         * on begin and pop it on end. Disabled by default. Not available in
+         * WebGL, where the markers are never emitted.
+         */
+        static void setGpuMarkersEnabled(bool enabled);
+
+        /**
+         * @brief Instrumented zone
+         *
+         * Calls the begin callback on construction and the end callback on
+         * destruction. Use @ref MAGNUM_TRACE_ZONE() instead of creating it
+         * directly.
+         */
+        class MAGNUM_EXPORT Zone {
+            public:
+                /** @brief Constructor */
+                explicit Zone(const Location& location);
+
+                /** @brief Copying is not allowed */
+                Zone(const Zone&) = delete;
+
+                /** @brief Moving is not allowed */
+                Zone(Zone&&) = delete;
+
+                /** @brief Destructor */
+                ~Zone();
+
+                /** @brief Copying is not allowed */
+                Zone& operator=(const Zone&) = delete;
+
+                /** @brief Moving is not allowed */
+                Zone& operator=(Zone&&) = delete;
+
+            private:
+                const Location& _location;
+                bool _callbacks, _gpuMarker;
+        };
+
+        Tracing() = delete;
+};
+
+#if defined(MAGNUM_BUILD_TRACING) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Instrument the rest of current scope as a zone that issues GL commands
+
+Expands to nothing if the library is not built with
+@ref MAGNUM_BUILD_TRACING. Can be used at most once in a scope.
+@see @ref MAGNUM_TRACE_CPU_ZONE()
+*/
+#define MAGNUM_TRACE_ZONE(name)                                             \
+    static const Magnum::Tracing::Location _magnumTraceLocation{name, __func__, __FILE__, __LINE__, true}; \
+    const Magnum::Tracing::Zone _magnumTraceZone{_magnumTraceLocation}
+
+/**
+@brief Instrument the rest of current scope as a CPU-only zone
+
+Same as @ref MAGNUM_TRACE_ZONE(), but the zone never emits GPU markers, so it
+can be used also in code that runs without a GL context.
+*/
+#define MAGNUM_TRACE_CPU_ZONE(name)                                         \
+    static const Magnum::Tracing::Location _magnumTraceLocation{name, __func__, __FILE__, __LINE__, false}; \
+    const Magnum::Tracing::Zone _magnumTraceZone{_magnumTraceLocation}
+#else
+#define MAGNUM_TRACE_ZONE(name) static_cast<void>(0)
+#define MAGNUM_TRACE_CPU_ZONE(name) static_cast<void>(0)
+#endif
+
+}
+
+#endif
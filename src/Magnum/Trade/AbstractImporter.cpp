@@ -30,12 +30,17 @@
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Implementation/viewAllocator.h"
 #include "Magnum/Trade/AbstractMaterialData.h"
+#include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/CameraData.h"
+#include "Magnum/Trade/FlatSceneData3D.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/MeshObjectData3D.h"
 #include "Magnum/Trade/ObjectData2D.h"
 #include "Magnum/Trade/ObjectData3D.h"
 #include "Magnum/Trade/SceneData.h"
@@ -80,6 +85,17 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
     doOpenData(Utility::Directory::read(filename));
 }
 
+AbstractImporter& AbstractImporter::setAllocator(const Allocator allocator, void* const userData) {
+    _allocator = allocator;
+    _allocatorUserData = userData;
+    return *this;
+}
+
+Containers::Array<char> AbstractImporter::allocate(const std::size_t size) {
+    if(_allocator) return _allocator(size, _allocatorUserData);
+    return Containers::Array<char>{size};
+}
+
 void AbstractImporter::close() {
     if(isOpened()) {
         doClose();
@@ -244,6 +260,59 @@ std::unique_ptr<ObjectData3D> AbstractImporter::object3D(const UnsignedInt id) {
 
 std::unique_ptr<ObjectData3D> AbstractImporter::doObject3D(UnsignedInt) { return nullptr; }
 
+std::optional<FlatSceneData3D> AbstractImporter::flatScene3D(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::flatScene3D(): no file opened", {});
+    CORRADE_ASSERT(id < doSceneCount(), "Trade::AbstractImporter::flatScene3D(): index out of range", {});
+    return doFlatScene3D(id);
+}
+
+std::optional<FlatSceneData3D> AbstractImporter::doFlatScene3D(const UnsignedInt id) {
+    std::optional<SceneData> scene = doScene(id);
+    if(!scene) return std::nullopt;
+
+    const UnsignedInt objectCount = doObject3DCount();
+    std::vector<UnsignedInt> objects;
+    std::vector<Int> parents;
+    std::vector<Matrix4> transformations;
+    std::vector<ObjectInstanceType3D> instanceTypes;
+    std::vector<Int> instances, materials;
+
+    /* Explicit stack of (object ID, parent index) pairs instead of recursion,
+       children pushed in reverse to keep their original order */
+    std::vector<std::pair<UnsignedInt, Int>> stack;
+    for(auto it = scene->children3D().rbegin(); it != scene->children3D().rend(); ++it)
+        stack.emplace_back(*it, -1);
+
+    std::vector<bool> visited(objectCount);
+    while(!stack.empty()) {
+        const std::pair<UnsignedInt, Int> top = stack.back();
+        stack.pop_back();
+
+        if(top.first >= objectCount || visited[top.first]) {
+            Error() << "Trade::AbstractImporter::flatScene3D(): object" << top.first << "is out of range or referenced more than once";
+            return std::nullopt;
+        }
+        visited[top.first] = true;
+
+        std::unique_ptr<ObjectData3D> object = doObject3D(top.first);
+        if(!object) return std::nullopt;
+
+        const Int index = objects.size();
+        objects.push_back(top.first);
+        parents.push_back(top.second);
+        transformations.push_back(object->transformation());
+        instanceTypes.push_back(object->instanceType());
+        instances.push_back(object->instance());
+        materials.push_back(object->instanceType() == ObjectInstanceType3D::Mesh ?
+            static_cast<MeshObjectData3D&>(*object).material() : -1);
+
+        for(auto it = object->children().rbegin(); it != object->children().rend(); ++it)
+            stack.emplace_back(*it, index);
+    }
+
+    return FlatSceneData3D{std::move(objects), std::move(parents), std::move(transformations), std::move(instanceTypes), std::move(instances), std::move(materials), scene->importerState()};
+}
+
 UnsignedInt AbstractImporter::mesh2DCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::mesh2DCount(): no file opened", {});
     return doMesh2DCount();
@@ -304,6 +373,64 @@ std::optional<MeshData3D> AbstractImporter::mesh3D(const UnsignedInt id) {
 
 std::optional<MeshData3D> AbstractImporter::doMesh3D(UnsignedInt) { return std::nullopt; }
 
+UnsignedInt AbstractImporter::meshCount() const {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshCount(): no file opened", {});
+    return doMeshCount();
+}
+
+UnsignedInt AbstractImporter::doMeshCount() const { return 0; }
+
+Int AbstractImporter::meshForName(const std::string& name) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshForName(): no file opened", {});
+    return doMeshForName(name);
+}
+
+Int AbstractImporter::doMeshForName(const std::string&) { return -1; }
+
+std::string AbstractImporter::meshName(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshName(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::meshName(): index out of range", {});
+    return doMeshName(id);
+}
+
+std::string AbstractImporter::doMeshName(UnsignedInt) { return {}; }
+
+std::optional<MeshData> AbstractImporter::mesh(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::mesh(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::mesh(): index out of range", {});
+    return doMesh(id);
+}
+
+std::optional<MeshData> AbstractImporter::mesh(const UnsignedInt id, const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::mesh(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::mesh(): index out of range", {});
+
+    /* Temporarily hand out the view to the implementation */
+    const Allocator allocator = _allocator;
+    void* const allocatorUserData = _allocatorUserData;
+    Implementation::ViewAllocatorState state{data, false};
+    setAllocator(Implementation::viewAllocator, &state);
+    std::optional<MeshData> mesh = doMesh(id);
+    setAllocator(allocator, allocatorUserData);
+    if(!mesh) return std::nullopt;
+
+    if(mesh->data().size() > data.size()) {
+        Error() << "Trade::AbstractImporter::mesh(): expected at least" << mesh->data().size() << "bytes for the data but got" << data.size();
+        return std::nullopt;
+    }
+
+    std::vector<MeshAttributeData> attributes;
+    attributes.reserve(mesh->attributeCount());
+    for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i)
+        attributes.push_back(mesh->attributeData(i));
+
+    if(!mesh->isIndexed())
+        return MeshData{mesh->primitive(), Implementation::moveIntoView(mesh->release(), data), std::move(attributes), mesh->vertexCount(), mesh->importerState()};
+    return MeshData{mesh->primitive(), Implementation::moveIntoView(mesh->release(), data), mesh->indexType(), mesh->indexOffset(), mesh->indexCount(), std::move(attributes), mesh->vertexCount(), mesh->importerState()};
+}
+
+std::optional<MeshData> AbstractImporter::doMesh(UnsignedInt) { return std::nullopt; }
+
 UnsignedInt AbstractImporter::materialCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::materialCount(): no file opened", {});
     return doMaterialCount();
@@ -422,6 +549,34 @@ std::optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id) {
     return doImage2D(id);
 }
 
+std::optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id, const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2D(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2D(): index out of range", {});
+
+    /* Temporarily hand out the view to the implementation */
+    const Allocator allocator = _allocator;
+    void* const allocatorUserData = _allocatorUserData;
+    Implementation::ViewAllocatorState state{data, false};
+    setAllocator(Implementation::viewAllocator, &state);
+    std::optional<ImageData2D> image = doImage2D(id);
+    setAllocator(allocator, allocatorUserData);
+    if(!image) return std::nullopt;
+
+    if(image->data().size() > data.size()) {
+        Error() << "Trade::AbstractImporter::image2D(): expected at least" << image->data().size() << "bytes for the data but got" << data.size();
+        return std::nullopt;
+    }
+
+    /* Release resets the size, so query it first */
+    const Vector2i size = image->size();
+    if(image->isCompressed()) return ImageData2D{
+        #ifndef MAGNUM_TARGET_GLES
+        image->compressedStorage(),
+        #endif
+        image->compressedFormat(), size, Implementation::moveIntoView(image->release(), data), image->importerState()};
+    return ImageData2D{image->storage(), image->format(), image->type(), size, Implementation::moveIntoView(image->release(), data), image->importerState()};
+}
+
 std::optional<ImageData2D> AbstractImporter::doImage2D(UnsignedInt) { return std::nullopt; }
 
 UnsignedInt AbstractImporter::image3DCount() const {
@@ -454,6 +609,36 @@ std::optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id) {
 
 std::optional<ImageData3D> AbstractImporter::doImage3D(UnsignedInt) { return std::nullopt; }
 
+UnsignedInt AbstractImporter::animationCount() const {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animationCount(): no file opened", {});
+    return doAnimationCount();
+}
+
+UnsignedInt AbstractImporter::doAnimationCount() const { return 0; }
+
+Int AbstractImporter::animationForName(const std::string& name) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animationForName(): no file opened", {});
+    return doAnimationForName(name);
+}
+
+Int AbstractImporter::doAnimationForName(const std::string&) { return -1; }
+
+std::string AbstractImporter::animationName(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animationName(): no file opened", {});
+    CORRADE_ASSERT(id < doAnimationCount(), "Trade::AbstractImporter::animationName(): index out of range", {});
+    return doAnimationName(id);
+}
+
+std::string AbstractImporter::doAnimationName(UnsignedInt) { return {}; }
+
+std::optional<AnimationData> AbstractImporter::animation(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animation(): no file opened", {});
+    CORRADE_ASSERT(id < doAnimationCount(), "Trade::AbstractImporter::animation(): index out of range", {});
+    return doAnimation(id);
+}
+
+std::optional<AnimationData> AbstractImporter::doAnimation(UnsignedInt) { return std::nullopt; }
+
 const void* AbstractImporter::importerState() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::importerState(): no file opened", {});
     return doImporterState();
@@ -43,8 +43,8 @@ namespace Magnum { namespace Trade {
 /**
 @brief Base for importer plugins
 
-Provides interface for importing 2D/3D scene, mesh, material, texture and image
-data. See @ref plugins for more information and `*Importer` classes in
+Provides interface for importing 2D/3D scene, mesh, material, texture, image
+and animation data. See @ref plugins for more information and `*Importer` classes in
 @ref Trade namespace for available importer plugins.
 
 ## Subclassing
@@ -72,12 +72,12 @@ checked by the implementation:
 -   All `do*()` implementations taking data ID as parameter are called only if
     the ID is from valid range.
 
-Plugin interface string is `"cz.mosra.magnum.Trade.AbstractImporter/0.3"`.
+Plugin interface string is `"cz.mosra.magnum.Trade.AbstractImporter/0.3.4"`.
 
 @todo How to handle casting from std::unique_ptr<> in more convenient way?
 */
 class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlugin<AbstractImporter> {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
 
     public:
         /**
@@ -93,6 +93,15 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Set of features supported by this importer */
         typedef Containers::EnumSet<Feature> Features;
 
+        /**
+         * @brief Data allocator
+         *
+         * Called with requested size in bytes and the user pointer passed
+         * to @ref setAllocator().
+         * @see @ref allocate()
+         */
+        typedef Containers::Array<char>(*Allocator)(std::size_t, void*);
+
         /** @brief Default constructor */
         explicit AbstractImporter();
 
@@ -280,6 +289,19 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         std::unique_ptr<ObjectData3D> object3D(UnsignedInt id);
 
+        /**
+         * @brief Flattened three-dimensional scene
+         * @param id        Scene ID, from range [0, @ref sceneCount()).
+         *
+         * Returns all three-dimensional objects of given scene in contiguous
+         * arrays or `std::nullopt` if importing failed. Compared to calling
+         * @ref object3D() for each object in the hierarchy this avoids a
+         * heap allocation per object, if the importer implements it
+         * directly.
+         * @see @ref SceneGraph::FlatScene
+         */
+        std::optional<FlatSceneData3D> flatScene3D(UnsignedInt id);
+
         /** @brief Two-dimensional mesh count */
         UnsignedInt mesh2DCount() const;
 
@@ -334,6 +356,54 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         std::optional<MeshData3D> mesh3D(UnsignedInt id);
 
+        /**
+         * @brief Mesh count
+         *
+         * Count of meshes available in the contiguous @ref MeshData
+         * representation. Independent on @ref mesh2DCount() and
+         * @ref mesh3DCount().
+         */
+        UnsignedInt meshCount() const;
+
+        /**
+         * @brief Mesh ID for given name
+         *
+         * If no mesh for given name exists, returns `-1`.
+         * @see @ref meshName()
+         */
+        Int meshForName(const std::string& name);
+
+        /**
+         * @brief Mesh name
+         * @param id        Mesh ID, from range [0, @ref meshCount()).
+         *
+         * @see @ref meshForName()
+         */
+        std::string meshName(UnsignedInt id);
+
+        /**
+         * @brief Mesh
+         * @param id        Mesh ID, from range [0, @ref meshCount()).
+         *
+         * Returns given mesh or `std::nullopt` if importing failed.
+         */
+        std::optional<MeshData> mesh(UnsignedInt id);
+
+        /**
+         * @brief Mesh imported into existing memory
+         * @param id        Mesh ID, from range [0, @ref meshCount()).
+         * @param data      Where to put the index and vertex data
+         *
+         * Like @ref mesh(UnsignedInt), but the returned mesh references
+         * @p data instead of owning its storage. If the importer allocates
+         * the data through @ref allocate(), it writes them directly to
+         * @p data, otherwise they are copied there. Returns `std::nullopt`
+         * if importing failed or if @p data is too small. There is no such
+         * variant for @ref mesh3D(), as @ref MeshData3D stores each
+         * attribute in a separate `std::vector`.
+         */
+        std::optional<MeshData> mesh(UnsignedInt id, Containers::ArrayView<char> data);
+
         /** @brief Material count */
         UnsignedInt materialCount() const;
 
@@ -442,6 +512,20 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         std::optional<ImageData2D> image2D(UnsignedInt id);
 
+        /**
+         * @brief Two-dimensional image imported into existing memory
+         * @param id        Image ID, from range [0, @ref image2DCount()).
+         * @param data      Where to put the image data
+         *
+         * Like @ref image2D(UnsignedInt), but the returned image references
+         * @p data instead of owning its storage, so it can be for example a
+         * reused staging area or a mapped pixel buffer. If the importer
+         * allocates the data through @ref allocate(), it decodes them
+         * directly to @p data, otherwise they are copied there. Returns
+         * `std::nullopt` if importing failed or if @p data is too small.
+         */
+        std::optional<ImageData2D> image2D(UnsignedInt id, Containers::ArrayView<char> data);
+
         /** @brief Three-dimensional image count */
         UnsignedInt image3DCount() const;
 
@@ -469,6 +553,33 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         std::optional<ImageData3D> image3D(UnsignedInt id);
 
+        /** @brief Animation count */
+        UnsignedInt animationCount() const;
+
+        /**
+         * @brief Animation ID for given name
+         *
+         * If no animation for given name exists, returns `-1`.
+         * @see @ref animationName()
+         */
+        Int animationForName(const std::string& name);
+
+        /**
+         * @brief Animation name
+         * @param id        Animation ID, from range [0, @ref animationCount()).
+         *
+         * @see @ref animationForName()
+         */
+        std::string animationName(UnsignedInt id);
+
+        /**
+         * @brief Animation
+         * @param id        Animation ID, from range [0, @ref animationCount()).
+         *
+         * Returns given animation or `std::nullopt` if importing failed.
+         */
+        std::optional<AnimationData> animation(UnsignedInt id);
+
         /*@}*/
 
         /**
@@ -479,6 +590,7 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          * documentation of particular plugin for more information about
          * returned type and contents. Returns `nullptr` by default.
          * @see @ref AbstractMaterialData::importerState(),
+         *      @ref AnimationData::importerState(),
          *      @ref CameraData::importerState(), @ref ImageData::importerState(),
          *      @ref MeshData2D::importerState(), @ref MeshData3D::importerState(),
          *      @ref ObjectData2D::importerState(), @ref ObjectData3D::importerState(),
@@ -486,7 +598,33 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         const void* importerState() const;
 
+        /** @brief Data allocator */
+        Allocator allocator() const { return _allocator; }
+
+        /**
+         * @brief Set data allocator
+         * @return Reference to self (for method chaining)
+         *
+         * The @p allocator is called by importer implementations for storage
+         * of returned image and mesh data, see @ref allocate(). The returned
+         * array can use a custom deleter to give the memory back to a
+         * staging arena instead of the heap. Importers referencing
+         * memory-mapped files directly don't call the allocator. Set to
+         * `nullptr` to use the default heap allocation.
+         */
+        AbstractImporter& setAllocator(Allocator allocator, void* userData = nullptr);
+
     protected:
+        /**
+         * @brief Allocate data storage
+         *
+         * Should be used by implementations for storage of returned image and
+         * mesh data instead of allocating the array directly. Calls the
+         * allocator set by @ref setAllocator(), if any, otherwise allocates a
+         * default-initialized array on the heap.
+         */
+        Containers::Array<char> allocate(std::size_t size);
+
         /**
          * @brief Implementation for @ref openFile()
          *
@@ -641,6 +779,16 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Implementation for @ref object3D() */
         virtual std::unique_ptr<ObjectData3D> doObject3D(UnsignedInt id);
 
+        /**
+         * @brief Implementation for @ref flatScene3D()
+         *
+         * Default implementation walks the hierarchy of the scene returned
+         * by @ref doScene() depth-first using @ref doObject3D(). Importers
+         * with the hierarchy already in an array-like form should override
+         * it to avoid the per-object allocations.
+         */
+        virtual std::optional<FlatSceneData3D> doFlatScene3D(UnsignedInt id);
+
         /**
          * @brief Implementation for @ref mesh2DCount()
          *
@@ -689,6 +837,30 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Implementation for @ref mesh3D() */
         virtual std::optional<MeshData3D> doMesh3D(UnsignedInt id);
 
+        /**
+         * @brief Implementation for @ref meshCount()
+         *
+         * Default implementation returns `0`.
+         */
+        virtual UnsignedInt doMeshCount() const;
+
+        /**
+         * @brief Implementation for @ref meshForName()
+         *
+         * Default implementation returns `-1`.
+         */
+        virtual Int doMeshForName(const std::string& name);
+
+        /**
+         * @brief Implementation for @ref meshName()
+         *
+         * Default implementation returns empty string.
+         */
+        virtual std::string doMeshName(UnsignedInt id);
+
+        /** @brief Implementation for @ref mesh() */
+        virtual std::optional<MeshData> doMesh(UnsignedInt id);
+
         /**
          * @brief Implementation for @ref materialCount()
          *
@@ -809,8 +981,36 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Implementation for @ref image3D() */
         virtual std::optional<ImageData3D> doImage3D(UnsignedInt id);
 
+        /**
+         * @brief Implementation for @ref animationCount()
+         *
+         * Default implementation returns `0`.
+         */
+        virtual UnsignedInt doAnimationCount() const;
+
+        /**
+         * @brief Implementation for @ref animationForName()
+         *
+         * Default implementation returns `-1`.
+         */
+        virtual Int doAnimationForName(const std::string& name);
+
+        /**
+         * @brief Implementation for @ref animationName()
+         *
+         * Default implementation returns empty string.
+         */
+        virtual std::string doAnimationName(UnsignedInt id);
+
+        /** @brief Implementation for @ref animation() */
+        virtual std::optional<AnimationData> doAnimation(UnsignedInt id);
+
         /** @brief Implementation for @ref importerState() */
         virtual const void* doImporterState() const;
+
+    private:
+        Allocator _allocator{};
+        void* _allocatorUserData{};
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AnimationData.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Trade {
+
+UnsignedInt animationTrackTypeSize(const AnimationTrackType type) {
+    switch(type) {
+        case AnimationTrackType::Float: return sizeof(Float);
+        case AnimationTrackType::Vector2: return sizeof(Vector2);
+        case AnimationTrackType::Vector3: return sizeof(Vector3);
+        case AnimationTrackType::Vector4: return sizeof(Vector4);
+        case AnimationTrackType::Quaternion: return sizeof(Quaternion);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+namespace {
+    template<class T> inline T interpolateLinear(const T& a, const T& b, const Float t) {
+        return Math::lerp(a, b, t);
+    }
+
+    inline Quaternion interpolateLinear(const Quaternion& a, const Quaternion& b, const Float t) {
+        return Math::slerp(a, b, t);
+    }
+}
+
+template<class T> AnimationTrackView<T>::AnimationTrackView(const Containers::ArrayView<const Float> times, const Containers::ArrayView<const T> values, const AnimationInterpolation interpolation) noexcept: _times{times}, _values{values}, _interpolation{interpolation} {
+    CORRADE_ASSERT(times.size() == values.size(),
+        "Trade::AnimationTrackView: expected the same count of times and values but got" << times.size() << "and" << values.size(), );
+}
+
+template<class T> Float AnimationTrackView<T>::duration() const {
+    return _times.empty() ? 0.0f : _times[_times.size() - 1];
+}
+
+template<class T> T AnimationTrackView<T>::at(const Float time, std::size_t& hint) const {
+    CORRADE_ASSERT(!_times.empty(), "Trade::AnimationTrackView::at(): the track is empty", {});
+
+    /* Clamp to the first and last keyframe */
+    const std::size_t size = _times.size();
+    if(size == 1 || time <= _times[0]) {
+        hint = 0;
+        return _values[0];
+    }
+    if(time >= _times[size - 1]) {
+        hint = size - 1;
+        return _values[size - 1];
+    }
+
+    /* Now there's always a keyframe pair surrounding the time. Check the hint
+       and the keyframe after it first, binary search if neither matches. */
+    if(hint + 1 >= size || _times[hint] > time || (time >= _times[hint + 1] && (hint + 2 >= size || time >= _times[hint + 2])))
+        hint = std::upper_bound(_times.begin(), _times.end(), time) - _times.begin() - 1;
+    else if(time >= _times[hint + 1])
+        ++hint;
+
+    if(_interpolation == AnimationInterpolation::Constant)
+        return _values[hint];
+
+    const Float t = (time - _times[hint])/(_times[hint + 1] - _times[hint]);
+    return interpolateLinear(_values[hint], _values[hint + 1], t);
+}
+
+AnimationData::AnimationData(Containers::Array<char>&& data, std::vector<AnimationTrackData> tracks, const void* const importerState): _data{std::move(data)}, _tracks{std::move(tracks)}, _duration{}, _importerState{importerState} {
+    for(std::size_t i = 0; i != _tracks.size(); ++i) {
+        const AnimationTrackData& track = _tracks[i];
+        CORRADE_ASSERT(track.timesOffset() + track.keyframeCount()*sizeof(Float) <= _data.size() && track.valuesOffset() + track.keyframeCount()*animationTrackTypeSize(track.type()) <= _data.size(),
+            "Trade::AnimationData: track" << i << "with" << track.keyframeCount() << "keyframes doesn't fit into" << _data.size() << "bytes", );
+        if(!track.keyframeCount()) continue;
+
+        const Float* const times = reinterpret_cast<const Float*>(_data + track.timesOffset());
+        CORRADE_ASSERT(std::is_sorted(times, times + track.keyframeCount()),
+            "Trade::AnimationData: keyframe times of track" << i << "are not sorted", );
+        _duration = std::max(_duration, times[track.keyframeCount() - 1]);
+    }
+}
+
+AnimationData::AnimationData(AnimationData&&) = default;
+
+AnimationData::~AnimationData() = default;
+
+AnimationData& AnimationData::operator=(AnimationData&&) = default;
+
+Containers::Array<char> AnimationData::release() {
+    Containers::Array<char> data{std::move(_data)};
+    return data;
+}
+
+const AnimationTrackData& AnimationData::trackData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _tracks.size(),
+        "Trade::AnimationData::trackData(): index" << id << "out of range for" << _tracks.size() << "tracks", _tracks[0]);
+    return _tracks[id];
+}
+
+const char* AnimationData::trackDataChecked(const UnsignedInt id, const AnimationTrackType type) const {
+    CORRADE_ASSERT(id < _tracks.size(),
+        "Trade::AnimationData::track(): index" << id << "out of range for" << _tracks.size() << "tracks", nullptr);
+    CORRADE_ASSERT(_tracks[id].type() == type,
+        "Trade::AnimationData::track(): track" << id << "is" << _tracks[id].type() << "but requested" << type, nullptr);
+    return _data + _tracks[id].valuesOffset();
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class AnimationTrackView<Float>;
+template class AnimationTrackView<Vector2>;
+template class AnimationTrackView<Vector3>;
+template class AnimationTrackView<Vector4>;
+template class AnimationTrackView<Quaternion>;
+
+Debug& operator<<(Debug& debug, const AnimationTrackType value) {
+    switch(value) {
+        #define _c(value) case AnimationTrackType::value: return debug << "Trade::AnimationTrackType::" #value;
+        _c(Float)
+        _c(Vector2)
+        _c(Vector3)
+        _c(Vector4)
+        _c(Quaternion)
+        #undef _c
+    }
+
+    return debug << "Trade::AnimationTrackType::(invalid)";
+}
+
+Debug& operator<<(Debug& debug, const AnimationTrackTarget value) {
+    switch(value) {
+        #define _c(value) case AnimationTrackTarget::value: return debug << "Trade::AnimationTrackTarget::" #value;
+        _c(Translation)
+        _c(Rotation)
+        _c(Scaling)
+        _c(Custom)
+        #undef _c
+    }
+
+    return debug << "Trade::AnimationTrackTarget::(invalid)";
+}
+
+Debug& operator<<(Debug& debug, const AnimationInterpolation value) {
+    switch(value) {
+        #define _c(value) case AnimationInterpolation::value: return debug << "Trade::AnimationInterpolation::" #value;
+        _c(Constant)
+        _c(Linear)
+        #undef _c
+    }
+
+    return debug << "Trade::AnimationInterpolation::(invalid)";
+}
+#endif
+
+}}
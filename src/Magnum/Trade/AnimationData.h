@@ -0,0 +1,386 @@
+#ifndef Magnum_Trade_AnimationData_h
+#define Magnum_Trade_AnimationData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AnimationData, @ref Magnum::Trade::AnimationTrackData, @ref Magnum::Trade::AnimationTrackView, enum @ref Magnum::Trade::AnimationTrackType, @ref Magnum::Trade::AnimationTrackTarget, @ref Magnum::Trade::AnimationInterpolation
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Animation track value type
+
+@see @ref AnimationTrackData, @ref animationTrackTypeSize()
+*/
+enum class AnimationTrackType: UnsignedByte {
+    Float,      /**< @ref Magnum::Float "Float" */
+    Vector2,    /**< @ref Magnum::Vector2 "Vector2" */
+    Vector3,    /**< @ref Magnum::Vector3 "Vector3" */
+    Vector4,    /**< @ref Magnum::Vector4 "Vector4" */
+    Quaternion  /**< @ref Magnum::Quaternion "Quaternion" */
+};
+
+/** @debugoperatorenum{Magnum::Trade::AnimationTrackType} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, AnimationTrackType value);
+
+/** @brief Size of given animation track value type */
+MAGNUM_EXPORT UnsignedInt animationTrackTypeSize(AnimationTrackType type);
+
+/**
+@brief Animation track target
+
+@see @ref AnimationTrackData
+*/
+enum class AnimationTrackTarget: UnsignedByte {
+    /** Object translation, usually @ref AnimationTrackType::Vector3 */
+    Translation,
+
+    /** Object rotation, usually @ref AnimationTrackType::Quaternion */
+    Rotation,
+
+    /** Object scaling, usually @ref AnimationTrackType::Vector3 */
+    Scaling,
+
+    /** Importer-specific target */
+    Custom
+};
+
+/** @debugoperatorenum{Magnum::Trade::AnimationTrackTarget} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, AnimationTrackTarget value);
+
+/**
+@brief Animation interpolation
+
+@see @ref AnimationTrackData, @ref AnimationTrackView::at()
+*/
+enum class AnimationInterpolation: UnsignedByte {
+    /** Value of the previous keyframe is used */
+    Constant,
+
+    /**
+     * Values are linearly interpolated using @ref Math::lerp(),
+     * quaternions using @ref Math::slerp()
+     */
+    Linear
+};
+
+/** @debugoperatorenum{Magnum::Trade::AnimationInterpolation} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, AnimationInterpolation value);
+
+/**
+@brief Animation track data
+
+Describes location of keyframes of one track in @ref AnimationData storage.
+Keyframe times are @ref Magnum::Float "Float" values in seconds, stored in
+ascending order.
+*/
+class AnimationTrackData {
+    public:
+        /**
+         * @brief Constructor
+         * @param type          Value type
+         * @param target        Track target
+         * @param targetObject  ID of the target object in the scene
+         * @param interpolation Interpolation
+         * @param timesOffset   Offset of keyframe times in the data array
+         * @param valuesOffset  Offset of keyframe values in the data array
+         * @param keyframeCount Keyframe count
+         */
+        constexpr explicit AnimationTrackData(AnimationTrackType type, AnimationTrackTarget target, UnsignedInt targetObject, AnimationInterpolation interpolation, std::size_t timesOffset, std::size_t valuesOffset, UnsignedInt keyframeCount): _type{type}, _target{target}, _interpolation{interpolation}, _targetObject{targetObject}, _timesOffset{timesOffset}, _valuesOffset{valuesOffset}, _keyframeCount{keyframeCount} {}
+
+        /** @brief Value type */
+        constexpr AnimationTrackType type() const { return _type; }
+
+        /** @brief Track target */
+        constexpr AnimationTrackTarget target() const { return _target; }
+
+        /** @brief Interpolation */
+        constexpr AnimationInterpolation interpolation() const { return _interpolation; }
+
+        /** @brief ID of the target object in the scene */
+        constexpr UnsignedInt targetObject() const { return _targetObject; }
+
+        /** @brief Offset of keyframe times in the data array */
+        constexpr std::size_t timesOffset() const { return _timesOffset; }
+
+        /** @brief Offset of keyframe values in the data array */
+        constexpr std::size_t valuesOffset() const { return _valuesOffset; }
+
+        /** @brief Keyframe count */
+        constexpr UnsignedInt keyframeCount() const { return _keyframeCount; }
+
+    private:
+        AnimationTrackType _type;
+        AnimationTrackTarget _target;
+        AnimationInterpolation _interpolation;
+        UnsignedInt _targetObject;
+        std::size_t _timesOffset, _valuesOffset;
+        UnsignedInt _keyframeCount;
+};
+
+/**
+@brief Typed view on animation track
+
+Non-owning view on keyframe times and values of one track. Returned by
+@ref AnimationData::track(), can be also created from user-provided arrays.
+
+Explicitly instantiated for @ref Magnum::Float "Float",
+@ref Magnum::Vector2 "Vector2", @ref Magnum::Vector3 "Vector3",
+@ref Magnum::Vector4 "Vector4" and @ref Magnum::Quaternion "Quaternion".
+*/
+template<class T> class MAGNUM_EXPORT AnimationTrackView {
+    public:
+        /** @brief Default constructor */
+        constexpr /*implicit*/ AnimationTrackView() noexcept: _interpolation{} {}
+
+        /**
+         * @brief Constructor
+         * @param times         Keyframe times in ascending order
+         * @param values        Keyframe values
+         * @param interpolation Interpolation
+         *
+         * Expects that both arrays have the same size.
+         */
+        explicit AnimationTrackView(Containers::ArrayView<const Float> times, Containers::ArrayView<const T> values, AnimationInterpolation interpolation) noexcept;
+
+        /** @brief Keyframe times */
+        Containers::ArrayView<const Float> times() const { return _times; }
+
+        /** @brief Keyframe values */
+        Containers::ArrayView<const T> values() const { return _values; }
+
+        /** @brief Interpolation */
+        AnimationInterpolation interpolation() const { return _interpolation; }
+
+        /** @brief Keyframe count */
+        std::size_t size() const { return _times.size(); }
+
+        /** @brief Whether the track is empty */
+        bool empty() const { return _times.empty(); }
+
+        /**
+         * @brief Duration
+         *
+         * Time of the last keyframe or `0.0f` if the track is empty.
+         */
+        Float duration() const;
+
+        /**
+         * @brief Sample the track
+         * @param time      Time in seconds
+         * @param hint      Keyframe hint
+         *
+         * Finds keyframes surrounding @p time and interpolates between them.
+         * Times outside of the track range are clamped to the first or last
+         * keyframe. The @p hint is an index of the keyframe found in previous
+         * call, which is checked first along with the one following it, so
+         * sampling a track with monotonically increasing time is @f$ O(1) @f$
+         * amortized. Binary search is done only if the hint doesn't match.
+         * Initialize the hint to `0` and keep it between calls:
+         * @code
+         * Trade::AnimationTrackView<Vector3> track = animation.track<Vector3>(0);
+         * std::size_t hint{};
+         *
+         * // every frame:
+         * Vector3 translation = track.at(time, hint);
+         * @endcode
+         *
+         * Expects that the track is not empty.
+         */
+        T at(Float time, std::size_t& hint) const;
+
+        /**
+         * @brief Sample the track without a hint
+         *
+         * Always does a binary search, prefer
+         * @ref at(Float, std::size_t&) const for sampling in a loop.
+         */
+        T at(Float time) const {
+            std::size_t hint{};
+            return at(time, hint);
+        }
+
+    private:
+        Containers::ArrayView<const Float> _times;
+        Containers::ArrayView<const T> _values;
+        AnimationInterpolation _interpolation;
+};
+
+/**
+@brief Animation data
+
+Keeps keyframe times and values of all animation tracks in a single
+contiguous allocation, the layout is described by a list of
+@ref AnimationTrackData. Each track animates one property of one object in
+the scene. Example of an animation with translation and rotation of one
+object sharing the same keyframe times:
+@code
+struct Data {
+    Float times[3];
+    Vector3 translations[3];
+    Quaternion rotations[3];
+};
+
+Containers::Array<char> data{sizeof(Data)};
+// fill the data...
+
+Trade::AnimationData animation{std::move(data), {
+    Trade::AnimationTrackData{Trade::AnimationTrackType::Vector3, Trade::AnimationTrackTarget::Translation, 0, Trade::AnimationInterpolation::Linear, offsetof(Data, times), offsetof(Data, translations), 3},
+    Trade::AnimationTrackData{Trade::AnimationTrackType::Quaternion, Trade::AnimationTrackTarget::Rotation, 0, Trade::AnimationInterpolation::Linear, offsetof(Data, times), offsetof(Data, rotations), 3}}};
+@endcode
+
+Tracks are accessed through typed views, which are also able to sample the
+data, see @ref AnimationTrackView::at() for details:
+@code
+Trade::AnimationTrackView<Quaternion> rotation = animation.track<Quaternion>(1);
+Quaternion q = rotation.at(0.75f);
+@endcode
+
+Keyframe times and values are expected to be aligned to the size of their
+scalar type.
+@see @ref AbstractImporter::animation()
+*/
+class MAGNUM_EXPORT AnimationData {
+    public:
+        /**
+         * @brief Constructor
+         * @param data          Keyframe times and values
+         * @param tracks        Track description
+         * @param importerState Importer-specific state
+         *
+         * Expects that all tracks fit into @p data and their keyframe times
+         * are sorted.
+         */
+        explicit AnimationData(Containers::Array<char>&& data, std::vector<AnimationTrackData> tracks, const void* importerState = nullptr);
+
+        /** @brief Copying is not allowed */
+        AnimationData(const AnimationData&) = delete;
+
+        /** @brief Move constructor */
+        AnimationData(AnimationData&&);
+
+        ~AnimationData();
+
+        /** @brief Copying is not allowed */
+        AnimationData& operator=(const AnimationData&) = delete;
+
+        /** @brief Move assignment */
+        AnimationData& operator=(AnimationData&&);
+
+        /** @brief Raw keyframe data */
+        Containers::ArrayView<const char> data() const { return _data; }
+
+        /**
+         * @brief Release data storage
+         *
+         * Releases the ownership of the data array. The track description
+         * is kept, so the caller can still interpret the returned data.
+         */
+        Containers::Array<char> release();
+
+        /**
+         * @brief Duration
+         *
+         * Maximum of durations of all tracks.
+         */
+        Float duration() const { return _duration; }
+
+        /** @brief Track count */
+        UnsignedInt trackCount() const { return _tracks.size(); }
+
+        /**
+         * @brief Track description
+         *
+         * Expects that @p id is less than @ref trackCount().
+         */
+        const AnimationTrackData& trackData(UnsignedInt id) const;
+
+        /**
+         * @brief Typed view on a track
+         *
+         * Expects that @p id is less than @ref trackCount() and @p T
+         * corresponds to @ref AnimationTrackData::type().
+         */
+        template<class T> AnimationTrackView<T> track(UnsignedInt id) const;
+
+        /**
+         * @brief Importer-specific state
+         *
+         * See @ref AbstractImporter::importerState() for more information.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        const char* trackDataChecked(UnsignedInt id, AnimationTrackType type) const;
+
+        Containers::Array<char> _data;
+        std::vector<AnimationTrackData> _tracks;
+        Float _duration;
+        const void* _importerState;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    template<class> struct AnimationTrackTypeFor;
+    template<> struct AnimationTrackTypeFor<Float> {
+        constexpr static AnimationTrackType type() { return AnimationTrackType::Float; }
+    };
+    template<> struct AnimationTrackTypeFor<Vector2> {
+        constexpr static AnimationTrackType type() { return AnimationTrackType::Vector2; }
+    };
+    template<> struct AnimationTrackTypeFor<Vector3> {
+        constexpr static AnimationTrackType type() { return AnimationTrackType::Vector3; }
+    };
+    template<> struct AnimationTrackTypeFor<Vector4> {
+        constexpr static AnimationTrackType type() { return AnimationTrackType::Vector4; }
+    };
+    template<> struct AnimationTrackTypeFor<Quaternion> {
+        constexpr static AnimationTrackType type() { return AnimationTrackType::Quaternion; }
+    };
+}
+#endif
+
+template<class T> AnimationTrackView<T> AnimationData::track(const UnsignedInt id) const {
+    const char* const data = trackDataChecked(id, Implementation::AnimationTrackTypeFor<T>::type());
+    if(!data) return {};
+    const AnimationTrackData& track = _tracks[id];
+    return AnimationTrackView<T>{
+        {reinterpret_cast<const Float*>(_data + track.timesOffset()), track.keyframeCount()},
+        {reinterpret_cast<const T*>(data), track.keyframeCount()},
+        track.interpolation()};
+}
+
+}}
+
+#endif
@@ -0,0 +1,217 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncImporter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+namespace Magnum { namespace Trade {
+
+void AsyncImportHandle::cancel() { _state->cancelled = true; }
+
+bool AsyncImportHandle::isCancelled() const { return _state->cancelled; }
+
+Int AsyncImportHandle::priority() const { return _state->priority; }
+
+void AsyncImportHandle::setPriority(const Int priority) { _state->priority = priority; }
+
+struct AsyncImporter::State {
+    struct QueuedJob {
+        std::shared_ptr<Implementation::AsyncImportState> state;
+        std::string filename;
+        Job job;
+    };
+
+    void run(AbstractImporter& importer);
+
+    /* Picks the waiting job with highest priority, the oldest one if there
+       are more. Linear, as the priorities can change any time. */
+    std::deque<QueuedJob>::iterator nextJob() {
+        auto found = jobs.begin();
+        for(auto it = jobs.begin(); it != jobs.end(); ++it)
+            if(it->state->priority > found->state->priority) found = it;
+        return found;
+    }
+
+    std::vector<std::unique_ptr<AbstractImporter>> importers;
+    std::vector<std::thread> threads;
+
+    /* Shared with the worker threads */
+    mutable std::mutex mutex;
+    std::condition_variable jobCondition, doneCondition;
+    std::deque<QueuedJob> jobs;
+    std::deque<std::pair<std::shared_ptr<Implementation::AsyncImportState>, std::function<void()>>> completed;
+    std::size_t running{};
+    bool stopped{};
+};
+
+void AsyncImporter::State::run(AbstractImporter& importer) {
+    for(;;) {
+        QueuedJob job;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            jobCondition.wait(lock, [this]() { return stopped || !jobs.empty(); });
+            if(stopped) return;
+
+            auto found = nextJob();
+            job = std::move(*found);
+            jobs.erase(found);
+            ++running;
+        }
+
+        /* Check for cancellation before the (potentially slow) open and
+           again before importing the data */
+        std::function<void()> completion;
+        if(!job.state->cancelled && importer.openFile(job.filename)) {
+            completion = job.job(job.state->cancelled ? nullptr : &importer);
+            importer.close();
+        } else completion = job.job(nullptr);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            if(completion) completed.emplace_back(std::move(job.state), std::move(completion));
+            --running;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+AsyncImporter::AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, UnsignedInt threadCount): AsyncImporter{[&]() {
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<std::unique_ptr<AbstractImporter>> importers;
+    importers.reserve(threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i)
+        importers.push_back(manager.instance(plugin));
+    return importers;
+}()} {}
+
+AsyncImporter::AsyncImporter(std::vector<std::unique_ptr<AbstractImporter>> importers): _state{new State} {
+    CORRADE_ASSERT(!importers.empty(), "Trade::AsyncImporter: no importers specified", );
+
+    _state->importers = std::move(importers);
+    _state->threads.reserve(_state->importers.size());
+    for(std::unique_ptr<AbstractImporter>& importer: _state->importers)
+        _state->threads.emplace_back(&State::run, _state.get(), std::ref(*importer));
+}
+
+AsyncImporter::~AsyncImporter() {
+    /* Resolve the waiting imports, so nobody waits on their futures forever */
+    std::deque<State::QueuedJob> jobs;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stopped = true;
+        jobs = std::move(_state->jobs);
+    }
+    _state->jobCondition.notify_all();
+    _state->doneCondition.notify_all();
+
+    for(State::QueuedJob& job: jobs) {
+        job.state->cancelled = true;
+        job.job(nullptr);
+    }
+
+    for(std::thread& thread: _state->threads) thread.join();
+}
+
+UnsignedInt AsyncImporter::threadCount() const { return _state->threads.size(); }
+
+std::size_t AsyncImporter::pendingCount() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->jobs.size() + _state->running + _state->completed.size();
+}
+
+std::shared_ptr<Implementation::AsyncImportState> AsyncImporter::submit(const std::string& filename, const Int priority, Job job) {
+    auto state = std::make_shared<Implementation::AsyncImportState>(priority);
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->jobs.push_back({state, filename, std::move(job)});
+    }
+    _state->jobCondition.notify_one();
+    return state;
+}
+
+AsyncImport<ImageData2D> AsyncImporter::image2D(const std::string& filename, const UnsignedInt id, const Int priority) {
+    return import<ImageData2D>(filename, [id](AbstractImporter& importer) -> std::optional<ImageData2D> {
+        if(id >= importer.image2DCount()) return std::nullopt;
+        return importer.image2D(id);
+    }, priority);
+}
+
+AsyncImportHandle AsyncImporter::image2D(const std::string& filename, const UnsignedInt id, const Int priority, std::function<void(std::optional<ImageData2D>&&)> completion) {
+    return import<ImageData2D>(filename, [id](AbstractImporter& importer) -> std::optional<ImageData2D> {
+        if(id >= importer.image2DCount()) return std::nullopt;
+        return importer.image2D(id);
+    }, priority, std::move(completion));
+}
+
+AsyncImport<MeshData3D> AsyncImporter::mesh3D(const std::string& filename, const UnsignedInt id, const Int priority) {
+    return import<MeshData3D>(filename, [id](AbstractImporter& importer) -> std::optional<MeshData3D> {
+        if(id >= importer.mesh3DCount()) return std::nullopt;
+        return importer.mesh3D(id);
+    }, priority);
+}
+
+AsyncImportHandle AsyncImporter::mesh3D(const std::string& filename, const UnsignedInt id, const Int priority, std::function<void(std::optional<MeshData3D>&&)> completion) {
+    return import<MeshData3D>(filename, [id](AbstractImporter& importer) -> std::optional<MeshData3D> {
+        if(id >= importer.mesh3DCount()) return std::nullopt;
+        return importer.mesh3D(id);
+    }, priority, std::move(completion));
+}
+
+std::size_t AsyncImporter::update() {
+    std::size_t count = 0;
+    for(;;) {
+        std::pair<std::shared_ptr<Implementation::AsyncImportState>, std::function<void()>> completed;
+        {
+            std::lock_guard<std::mutex> lock{_state->mutex};
+            if(_state->completed.empty()) break;
+
+            completed = std::move(_state->completed.front());
+            _state->completed.pop_front();
+        }
+
+        if(completed.first->cancelled) continue;
+        completed.second();
+        ++count;
+    }
+
+    return count;
+}
+
+void AsyncImporter::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->doneCondition.wait(lock, [this]() { return _state->stopped || (_state->jobs.empty() && !_state->running); });
+}
+
+}}
@@ -0,0 +1,392 @@
+#ifndef Magnum_Trade_AsyncImporter_h
+#define Magnum_Trade_AsyncImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncImporter, @ref Magnum::Trade::AsyncImportHandle, @ref Magnum::Trade::AsyncImport
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Corrade/PluginManager/PluginManager.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum { namespace Trade {
+
+namespace Implementation {
+    struct AsyncImportState {
+        explicit AsyncImportState(Int priority): cancelled{false}, priority{priority} {}
+
+        std::atomic<bool> cancelled;
+        std::atomic<Int> priority;
+    };
+}
+
+/**
+@brief Handle to an asynchronous import
+
+Allows cancelling the import and changing its priority while it waits in the
+queue. Returned by the @ref AsyncImporter functions taking a completion
+callback, see @ref AsyncImport for a variant returning the result through a
+future. Copies of the handle refer to the same import.
+*/
+class MAGNUM_EXPORT AsyncImportHandle {
+    friend AsyncImporter;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an invalid handle, not referring to any import.
+         */
+        explicit AsyncImportHandle() = default;
+
+        /** @brief Whether the handle refers to an import */
+        bool isValid() const { return !!_state; }
+
+        /**
+         * @brief Cancel the import
+         *
+         * Thread-safe. If the import didn't start yet, it is skipped. If it
+         * is running, the data are not imported after the file finishes
+         * opening. A completion callback is not called for a cancelled import
+         * and @ref AsyncImport::get() returns `std::nullopt`. Calling this
+         * function again does nothing.
+         */
+        void cancel();
+
+        /** @brief Whether the import was cancelled */
+        bool isCancelled() const;
+
+        /** @brief Priority */
+        Int priority() const;
+
+        /**
+         * @brief Set priority
+         *
+         * Thread-safe. Imports with higher priority are started first. Has
+         * an effect only if the import didn't start yet, so the priority of
+         * waiting imports can be raised for example when the asset becomes
+         * visible.
+         */
+        void setPriority(Int priority);
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        explicit AsyncImportHandle(std::shared_ptr<Implementation::AsyncImportState> state): _state{std::move(state)} {}
+
+    private:
+
+        std::shared_ptr<Implementation::AsyncImportState> _state;
+};
+
+/**
+@brief Asynchronous import
+
+@ref AsyncImportHandle with a future for the import result. Returned by the
+@ref AsyncImporter functions not taking a completion callback. Move-only.
+*/
+template<class T> class AsyncImport: public AsyncImportHandle {
+    friend AsyncImporter;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an invalid import.
+         */
+        explicit AsyncImport() = default;
+
+        /** @brief Handle for cancelling and reprioritizing the import */
+        AsyncImportHandle handle() const { return *this; }
+
+        /**
+         * @brief Whether the result is ready
+         *
+         * Doesn't block. Returns `true` also if the import was cancelled and
+         * its result is thus known to be `std::nullopt`. Expects that the
+         * import is valid and @ref get() wasn't called yet.
+         */
+        bool isReady() const {
+            return _future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        }
+
+        /**
+         * @brief Import result
+         *
+         * Blocks until the import is finished, then returns the imported
+         * data or `std::nullopt` if opening the file or importing the data
+         * failed or the import was cancelled. Can be called only once.
+         */
+        std::optional<T> get() { return _future.get(); }
+
+    private:
+        explicit AsyncImport(std::shared_ptr<Implementation::AsyncImportState> state, std::future<std::optional<T>> future): AsyncImportHandle{std::move(state)}, _future{std::move(future)} {}
+
+        std::future<std::optional<T>> _future;
+};
+
+/**
+@brief Asynchronous importer
+
+Runs importer calls on a pool of worker threads, so loading assets doesn't
+block the main thread. Each worker owns one importer instance, which is
+used only by that worker, so any importer plugin can be used even though the
+importers themselves are not thread-safe.
+
+## Usage
+
+The importer instances are created up front on the constructing thread, as
+the plugin manager isn't thread-safe either. Each import opens the file,
+imports given data and closes the file again. The result is either returned
+through @ref AsyncImport, a thin wrapper around `std::future`:
+@code
+PluginManager::Manager<Trade::AbstractImporter> manager{MAGNUM_PLUGINS_IMPORTER_DIR};
+Trade::AsyncImporter importer{manager, "TgaImporter"};
+
+Trade::AsyncImport<Trade::ImageData2D> image = importer.image2D("texture.tga");
+
+// later, once image.isReady() returns true
+std::optional<Trade::ImageData2D> data = image.get();
+@endcode
+
+Or passed to a completion callback, which is called from @ref update() on the
+main thread, for example from @ref Platform::Sdl2Application::tickEvent() "tickEvent()".
+The callbacks can thus safely upload the data to the GPU or access the scene:
+@code
+Trade::AsyncImportHandle handle = importer.mesh3D("level/rock.obj", 0, 0,
+    [&](std::optional<Trade::MeshData3D>&& data) {
+        if(data) rock.setMesh(MeshTools::compile(*data, BufferUsage::StaticDraw));
+    });
+
+// each frame
+importer.update();
+@endcode
+
+Data for which there isn't a dedicated function can be imported with
+@ref import(), which calls given function on an importer with the file
+opened:
+@code
+Trade::AsyncImport<Trade::SceneData> scene = importer.import<Trade::SceneData>("level.gltf",
+    [](Trade::AbstractImporter& importer) { return importer.scene(importer.defaultScene()); });
+@endcode
+
+## Priorities and cancellation
+
+Every import has a priority. Waiting imports with higher priority are started
+first, imports with the same priority in the order in which they were
+submitted. The priority of a waiting import can be changed through its
+@ref AsyncImportHandle, for example to load assets that just became visible
+before the rest. An import that's not needed anymore, for example because the
+player left the area, can be cancelled. The cancellation is cooperative --- a
+waiting import is skipped, a running import finishes opening the file but
+doesn't import the data.
+
+## Thread safety
+
+All functions except @ref update() can be called from any thread, the
+completion callbacks are called only from @ref update(). The functions passed
+to @ref import() are called from the worker threads and must not access state
+shared with other threads without its own synchronization.
+*/
+class MAGNUM_EXPORT AsyncImporter {
+    public:
+        /**
+         * @brief Construct with importer plugin
+         * @param manager       Plugin manager
+         * @param plugin        Importer plugin name
+         * @param threadCount   Worker thread count. If `0`, count of
+         *      hardware threads is used.
+         *
+         * Instantiates the @p plugin once for each worker thread. The plugin
+         * is expected to be loaded already. The manager is expected to
+         * outlive the importer.
+         */
+        explicit AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct with importer instances
+         *
+         * Creates one worker thread for each of @p importers. Expects that
+         * there is at least one importer and that the importers are not
+         * used by anything else.
+         */
+        explicit AsyncImporter(std::vector<std::unique_ptr<AbstractImporter>> importers);
+
+        /** @brief Copying is not allowed */
+        AsyncImporter(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Cancels all waiting imports, waits for the running ones and joins
+         * the worker threads. Completion callbacks that weren't yet called
+         * from @ref update() are discarded.
+         */
+        ~AsyncImporter();
+
+        /** @brief Copying is not allowed */
+        AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter& operator=(AsyncImporter&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Count of unfinished imports
+         *
+         * Imports that are waiting or running plus finished imports with a
+         * completion callback for which @ref update() wasn't yet called.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Import a 2D image asynchronously
+         * @param filename  File to open
+         * @param id        Image ID
+         * @param priority  Import priority
+         *
+         * @see @ref AbstractImporter::image2D()
+         */
+        AsyncImport<ImageData2D> image2D(const std::string& filename, UnsignedInt id = 0, Int priority = 0);
+
+        /**
+         * @brief Import a 2D image asynchronously with a completion callback
+         *
+         * The @p completion is called from @ref update() after the import
+         * finishes, unless the import was cancelled.
+         */
+        AsyncImportHandle image2D(const std::string& filename, UnsignedInt id, Int priority, std::function<void(std::optional<ImageData2D>&&)> completion);
+
+        /**
+         * @brief Import a 3D mesh asynchronously
+         * @param filename  File to open
+         * @param id        Mesh ID
+         * @param priority  Import priority
+         *
+         * @see @ref AbstractImporter::mesh3D()
+         */
+        AsyncImport<MeshData3D> mesh3D(const std::string& filename, UnsignedInt id = 0, Int priority = 0);
+
+        /**
+         * @brief Import a 3D mesh asynchronously with a completion callback
+         *
+         * The @p completion is called from @ref update() after the import
+         * finishes, unless the import was cancelled.
+         */
+        AsyncImportHandle mesh3D(const std::string& filename, UnsignedInt id, Int priority, std::function<void(std::optional<MeshData3D>&&)> completion);
+
+        /**
+         * @brief Import arbitrary data asynchronously
+         * @param filename  File to open
+         * @param function  Function importing the data
+         * @param priority  Import priority
+         *
+         * The @p function is called from a worker thread with an importer
+         * that has @p filename opened. If the file can't be opened or the
+         * import is cancelled, it's not called at all.
+         */
+        template<class T> AsyncImport<T> import(const std::string& filename, std::function<std::optional<T>(AbstractImporter&)> function, Int priority = 0);
+
+        /**
+         * @brief Import arbitrary data asynchronously with a completion callback
+         *
+         * The @p completion is called from @ref update() after the import
+         * finishes, unless the import was cancelled.
+         */
+        template<class T> AsyncImportHandle import(const std::string& filename, std::function<std::optional<T>(AbstractImporter&)> function, Int priority, std::function<void(std::optional<T>&&)> completion);
+
+        /**
+         * @brief Call completion callbacks of finished imports
+         * @return Count of called callbacks
+         *
+         * Never waits for the worker threads. Call from the thread that
+         * should receive the callbacks, preferably once per frame.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Wait for all imports to finish
+         *
+         * Blocks until there's no waiting or running import. The completion
+         * callbacks still need to be called using @ref update().
+         */
+        void wait();
+
+    private:
+        struct State;
+
+        /* Runs on a worker thread with importer that has the file opened, or
+           with nullptr if the file couldn't be opened or the import was
+           cancelled. Returns a function to be called from update() unless
+           the import gets cancelled, or an empty function. */
+        typedef std::function<std::function<void()>(AbstractImporter*)> Job;
+
+        std::shared_ptr<Implementation::AsyncImportState> submit(const std::string& filename, Int priority, Job job);
+
+        std::unique_ptr<State> _state;
+};
+
+template<class T> AsyncImport<T> AsyncImporter::import(const std::string& filename, std::function<std::optional<T>(AbstractImporter&)> function, const Int priority) {
+    /* std::function needs a copyable functor */
+    auto promise = std::make_shared<std::promise<std::optional<T>>>();
+    std::future<std::optional<T>> future = promise->get_future();
+    std::shared_ptr<Implementation::AsyncImportState> state = submit(filename, priority, [function, promise](AbstractImporter* importer) {
+        promise->set_value(importer ? function(*importer) : std::nullopt);
+        return std::function<void()>{};
+    });
+    return AsyncImport<T>{std::move(state), std::move(future)};
+}
+
+template<class T> AsyncImportHandle AsyncImporter::import(const std::string& filename, std::function<std::optional<T>(AbstractImporter&)> function, const Int priority, std::function<void(std::optional<T>&&)> completion) {
+    return AsyncImportHandle{submit(filename, priority, [function, completion](AbstractImporter* importer) -> std::function<void()> {
+        if(!importer) return [completion]() { completion(std::nullopt); };
+        auto data = std::make_shared<std::optional<T>>(function(*importer));
+        return [completion, data]() { completion(std::move(*data)); };
+    })};
+}
+
+}}
+
+#endif
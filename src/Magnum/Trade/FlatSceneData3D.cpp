@@ -0,0 +1,46 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlatSceneData3D.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace Trade {
+
+FlatSceneData3D::FlatSceneData3D(std::vector<UnsignedInt> objects, std::vector<Int> parents, std::vector<Matrix4> transformations, std::vector<ObjectInstanceType3D> instanceTypes, std::vector<Int> instances, std::vector<Int> materials, const void* const importerState): _objects{std::move(objects)}, _parents{std::move(parents)}, _transformations{std::move(transformations)}, _instanceTypes{std::move(instanceTypes)}, _instances{std::move(instances)}, _materials{std::move(materials)}, _importerState{importerState} {
+    CORRADE_ASSERT(_parents.size() == _objects.size() && _transformations.size() == _objects.size() && _instanceTypes.size() == _objects.size() && _instances.size() == _objects.size() && _materials.size() == _objects.size(),
+        "Trade::FlatSceneData3D: all arrays are expected to have the same size", );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        CORRADE_ASSERT(_parents[i] >= -1 && _parents[i] < Int(i),
+            "Trade::FlatSceneData3D: parent" << _parents[i] << "of object" << i << "doesn't precede it", );
+    #endif
+}
+
+FlatSceneData3D::FlatSceneData3D(FlatSceneData3D&&) = default;
+
+FlatSceneData3D& FlatSceneData3D::operator=(FlatSceneData3D&&) = default;
+
+}}
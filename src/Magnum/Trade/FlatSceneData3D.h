@@ -0,0 +1,143 @@
+#ifndef Magnum_Trade_FlatSceneData3D_h
+#define Magnum_Trade_FlatSceneData3D_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Trade::FlatSceneData3D
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/ObjectData3D.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Flattened three-dimensional scene data
+
+All objects of a scene stored in contiguous arrays indexed by position in the
+flattened hierarchy, instead of one @ref ObjectData3D allocation per object.
+The objects are in depth-first order, thus parent of each object always
+precedes the object itself. That makes the data directly usable with
+@ref SceneGraph::FlatScene::add(Containers::ArrayView<const Int>, Containers::ArrayView<const MatrixType>, Int):
+@code
+std::optional<Trade::FlatSceneData3D> data = importer.flatScene3D(importer.defaultScene());
+
+SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> scene;
+scene.add({data->parents().data(), data->size()}, {data->transformations().data(), data->size()});
+@endcode
+@see @ref AbstractImporter::flatScene3D()
+*/
+class MAGNUM_EXPORT FlatSceneData3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param objects           Importer object IDs
+         * @param parents           Parent indices into the flattened
+         *      hierarchy or `-1` for top-level objects
+         * @param transformations   Transformations (relative to parent)
+         * @param instanceTypes     Instance types
+         * @param instances         Instance IDs or `-1`
+         * @param materials         Material IDs or `-1`
+         * @param importerState     Importer-specific state
+         *
+         * All arrays are expected to have the same size and each parent
+         * index is expected to be less than index of the object itself.
+         */
+        explicit FlatSceneData3D(std::vector<UnsignedInt> objects, std::vector<Int> parents, std::vector<Matrix4> transformations, std::vector<ObjectInstanceType3D> instanceTypes, std::vector<Int> instances, std::vector<Int> materials, const void* importerState = nullptr);
+
+        /** @brief Copying is not allowed */
+        FlatSceneData3D(const FlatSceneData3D&) = delete;
+
+        /** @brief Move constructor */
+        FlatSceneData3D(FlatSceneData3D&&);
+
+        /** @brief Copying is not allowed */
+        FlatSceneData3D& operator=(const FlatSceneData3D&) = delete;
+
+        /** @brief Move assignment */
+        FlatSceneData3D& operator=(FlatSceneData3D&&);
+
+        /** @brief Object count */
+        std::size_t size() const { return _objects.size(); }
+
+        /**
+         * @brief Importer object IDs
+         *
+         * Can be used to query for example @ref AbstractImporter::object3DName().
+         */
+        const std::vector<UnsignedInt>& objects() const { return _objects; }
+
+        /**
+         * @brief Parent indices
+         *
+         * Index of parent in the flattened hierarchy or `-1` for top-level
+         * objects. The index is always less than index of the object itself.
+         */
+        const std::vector<Int>& parents() const { return _parents; }
+
+        /** @brief Transformations (relative to parent) */
+        const std::vector<Matrix4>& transformations() const { return _transformations; }
+
+        /** @brief Instance types */
+        const std::vector<ObjectInstanceType3D>& instanceTypes() const { return _instanceTypes; }
+
+        /**
+         * @brief Instance IDs
+         *
+         * `-1` for objects with @ref ObjectInstanceType3D::Empty.
+         */
+        const std::vector<Int>& instances() const { return _instances; }
+
+        /**
+         * @brief Material IDs
+         *
+         * `-1` for objects that are not meshes or have no material assigned.
+         */
+        const std::vector<Int>& materials() const { return _materials; }
+
+        /**
+         * @brief Importer-specific state
+         *
+         * See @ref AbstractImporter::importerState() for more information.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        std::vector<UnsignedInt> _objects;
+        std::vector<Int> _parents;
+        std::vector<Matrix4> _transformations;
+        std::vector<ObjectInstanceType3D> _instanceTypes;
+        std::vector<Int> _instances, _materials;
+        const void* _importerState;
+};
+
+}}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "MeshData.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Trade {
+
+UnsignedInt meshAttributeTypeSize(const MeshAttributeType type) {
+    switch(type) {
+        case MeshAttributeType::Vector2: return sizeof(Vector2);
+        case MeshAttributeType::Vector3: return sizeof(Vector3);
+        case MeshAttributeType::Vector4: return sizeof(Vector4);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+UnsignedInt meshIndexTypeSize(const MeshIndexType type) {
+    switch(type) {
+        case MeshIndexType::UnsignedByte: return sizeof(UnsignedByte);
+        case MeshIndexType::UnsignedShort: return sizeof(UnsignedShort);
+        case MeshIndexType::UnsignedInt: return sizeof(UnsignedInt);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+MeshData::MeshData(const MeshPrimitive primitive, Containers::Array<char>&& data, const MeshIndexType indexType, const std::size_t indexOffset, const UnsignedInt indexCount, std::vector<MeshAttributeData> attributes, const UnsignedInt vertexCount, const void* const importerState): _primitive{primitive}, _indexType{indexType}, _data{std::move(data)}, _indexOffset{indexOffset}, _indexCount{indexCount}, _vertexCount{vertexCount}, _attributes{std::move(attributes)}, _importerState{importerState} {
+    CORRADE_ASSERT(!_indexCount || _indexOffset + _indexCount*meshIndexTypeSize(_indexType) <= _data.size(),
+        "Trade::MeshData: index array of" << _indexCount << "items at offset" << _indexOffset << "doesn't fit into" << _data.size() << "bytes", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const MeshAttributeData& attribute: _attributes)
+        CORRADE_ASSERT(!_vertexCount || attribute.offset() + (_vertexCount - 1)*attribute.stride() + meshAttributeTypeSize(attribute.type()) <= _data.size(),
+            "Trade::MeshData:" << attribute.name() << "attribute of" << _vertexCount << "items at offset" << attribute.offset() << "with stride" << attribute.stride() << "doesn't fit into" << _data.size() << "bytes", );
+    #endif
+}
+
+MeshData::MeshData(const MeshPrimitive primitive, Containers::Array<char>&& data, std::vector<MeshAttributeData> attributes, const UnsignedInt vertexCount, const void* const importerState): MeshData{primitive, std::move(data), MeshIndexType::UnsignedInt, 0, 0, std::move(attributes), vertexCount, importerState} {}
+
+MeshData::MeshData(MeshData&&) = default;
+
+MeshData::~MeshData() = default;
+
+MeshData& MeshData::operator=(MeshData&&) = default;
+
+Containers::Array<char> MeshData::release() {
+    Containers::Array<char> data{std::move(_data)};
+    return data;
+}
+
+MeshIndexType MeshData::indexType() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indexType(): the mesh is not indexed", {});
+    return _indexType;
+}
+
+Containers::ArrayView<const char> MeshData::indexData() const {
+    if(!isIndexed()) return nullptr;
+    return _data.slice(_indexOffset, _indexOffset + _indexCount*meshIndexTypeSize(_indexType));
+}
+
+std::vector<UnsignedInt> MeshData::indicesAsArray() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indicesAsArray(): the mesh is not indexed", {});
+
+    std::vector<UnsignedInt> out(_indexCount);
+    const char* const data = _data + _indexOffset;
+    switch(_indexType) {
+        case MeshIndexType::UnsignedByte:
+            for(std::size_t i = 0; i != _indexCount; ++i)
+                out[i] = reinterpret_cast<const UnsignedByte*>(data)[i];
+            break;
+        case MeshIndexType::UnsignedShort:
+            for(std::size_t i = 0; i != _indexCount; ++i)
+                out[i] = reinterpret_cast<const UnsignedShort*>(data)[i];
+            break;
+        case MeshIndexType::UnsignedInt:
+            std::memcpy(out.data(), data, _indexCount*sizeof(UnsignedInt));
+            break;
+    }
+
+    return out;
+}
+
+const MeshAttributeData& MeshData::attributeData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _attributes.size(),
+        "Trade::MeshData::attributeData(): index" << id << "out of range for" << _attributes.size() << "attributes", _attributes[0]);
+    return _attributes[id];
+}
+
+UnsignedInt MeshData::attributeCount(const MeshAttributeName name) const {
+    UnsignedInt count = 0;
+    for(const MeshAttributeData& attribute: _attributes)
+        if(attribute.name() == name) ++count;
+    return count;
+}
+
+UnsignedInt MeshData::attributeId(const MeshAttributeName name, UnsignedInt id) const {
+    for(std::size_t i = 0; i != _attributes.size(); ++i) {
+        if(_attributes[i].name() != name) continue;
+        if(id-- == 0) return i;
+    }
+
+    return _attributes.size();
+}
+
+const char* MeshData::attributeDataChecked(const UnsignedInt id, const MeshAttributeType type) const {
+    CORRADE_ASSERT(id < _attributes.size(),
+        "Trade::MeshData::attribute(): attribute not found", nullptr);
+    CORRADE_ASSERT(_attributes[id].type() == type,
+        "Trade::MeshData::attribute():" << _attributes[id].name() << "is" << _attributes[id].type() << "but requested" << type, nullptr);
+    return _data + _attributes[id].offset();
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const MeshAttributeName value) {
+    switch(value) {
+        #define _c(value) case MeshAttributeName::value: return debug << "Trade::MeshAttributeName::" #value;
+        _c(Position)
+        _c(Normal)
+        _c(TextureCoordinates)
+        _c(Color)
+        #undef _c
+    }
+
+    return debug << "Trade::MeshAttributeName::(invalid)";
+}
+
+Debug& operator<<(Debug& debug, const MeshAttributeType value) {
+    switch(value) {
+        #define _c(value) case MeshAttributeType::value: return debug << "Trade::MeshAttributeType::" #value;
+        _c(Vector2)
+        _c(Vector3)
+        _c(Vector4)
+        #undef _c
+    }
+
+    return debug << "Trade::MeshAttributeType::(invalid)";
+}
+
+Debug& operator<<(Debug& debug, const MeshIndexType value) {
+    switch(value) {
+        #define _c(value) case MeshIndexType::value: return debug << "Trade::MeshIndexType::" #value;
+        _c(UnsignedByte)
+        _c(UnsignedShort)
+        _c(UnsignedInt)
+        #undef _c
+    }
+
+    return debug << "Trade::MeshIndexType::(invalid)";
+}
+#endif
+
+}}
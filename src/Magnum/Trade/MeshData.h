@@ -0,0 +1,403 @@
+#ifndef Magnum_Trade_MeshData_h
+#define Magnum_Trade_MeshData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshData, @ref Magnum::Trade::MeshAttributeData, @ref Magnum::Trade::MeshAttributeView, enum @ref Magnum::Trade::MeshAttributeName, @ref Magnum::Trade::MeshAttributeType, @ref Magnum::Trade::MeshIndexType
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh attribute name
+
+@see @ref MeshAttributeData, @ref MeshData::attribute()
+*/
+enum class MeshAttributeName: UnsignedByte {
+    /**
+     * Position. Bound to @ref Shaders::Generic2D::Position or
+     * @ref Shaders::Generic3D::Position by @ref MeshTools::compile().
+     */
+    Position,
+
+    /**
+     * Normal. Bound to @ref Shaders::Generic3D::Normal by
+     * @ref MeshTools::compile().
+     */
+    Normal,
+
+    /**
+     * Texture coordinates. Bound to
+     * @ref Shaders::Generic3D::TextureCoordinates by
+     * @ref MeshTools::compile().
+     */
+    TextureCoordinates,
+
+    /**
+     * Vertex color. Bound to @ref Shaders::Generic3D::Color by
+     * @ref MeshTools::compile().
+     */
+    Color
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshAttributeName} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MeshAttributeName value);
+
+/**
+@brief Mesh attribute type
+
+@see @ref MeshAttributeData, @ref meshAttributeTypeSize()
+*/
+enum class MeshAttributeType: UnsignedByte {
+    Vector2,    /**< @ref Magnum::Vector2 "Vector2" */
+    Vector3,    /**< @ref Magnum::Vector3 "Vector3" */
+    Vector4     /**< @ref Magnum::Vector4 "Vector4" */
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshAttributeType} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MeshAttributeType value);
+
+/** @brief Size of given mesh attribute type */
+MAGNUM_EXPORT UnsignedInt meshAttributeTypeSize(MeshAttributeType type);
+
+/**
+@brief Mesh index type
+
+@see @ref MeshData::indexType(), @ref meshIndexTypeSize()
+*/
+enum class MeshIndexType: UnsignedByte {
+    UnsignedByte,   /**< @ref Magnum::UnsignedByte "UnsignedByte" */
+    UnsignedShort,  /**< @ref Magnum::UnsignedShort "UnsignedShort" */
+    UnsignedInt     /**< @ref Magnum::UnsignedInt "UnsignedInt" */
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshIndexType} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MeshIndexType value);
+
+/** @brief Size of given mesh index type */
+MAGNUM_EXPORT UnsignedInt meshIndexTypeSize(MeshIndexType type);
+
+/**
+@brief Mesh attribute data
+
+Describes location of one attribute in @ref MeshData storage.
+*/
+class MeshAttributeData {
+    public:
+        /**
+         * @brief Constructor
+         * @param name      Attribute name
+         * @param type      Attribute type
+         * @param offset    Offset of the first item in the data array
+         * @param stride    Distance between two consecutive items
+         */
+        constexpr explicit MeshAttributeData(MeshAttributeName name, MeshAttributeType type, std::size_t offset, UnsignedInt stride): _name{name}, _type{type}, _offset{offset}, _stride{stride} {}
+
+        /** @brief Attribute name */
+        constexpr MeshAttributeName name() const { return _name; }
+
+        /** @brief Attribute type */
+        constexpr MeshAttributeType type() const { return _type; }
+
+        /** @brief Offset of the first item in the data array */
+        constexpr std::size_t offset() const { return _offset; }
+
+        /** @brief Distance between two consecutive items */
+        constexpr UnsignedInt stride() const { return _stride; }
+
+    private:
+        MeshAttributeName _name;
+        MeshAttributeType _type;
+        std::size_t _offset;
+        UnsignedInt _stride;
+};
+
+/**
+@brief Strided view on mesh attribute
+
+Non-owning view on attribute items placed in memory with given stride.
+Returned by @ref MeshData::attribute().
+*/
+template<class T> class MeshAttributeView {
+    public:
+        /** @brief Default constructor */
+        constexpr /*implicit*/ MeshAttributeView() noexcept: _data{}, _size{}, _stride{} {}
+
+        /**
+         * @brief Constructor
+         * @param data      Pointer to the first item
+         * @param size      Item count
+         * @param stride    Distance between two consecutive items
+         */
+        constexpr explicit MeshAttributeView(const char* data, std::size_t size, std::size_t stride) noexcept: _data{data}, _size{size}, _stride{stride} {}
+
+        /** @brief Item count */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the view is empty */
+        bool empty() const { return !_size; }
+
+        /** @brief Distance between two consecutive items */
+        std::size_t stride() const { return _stride; }
+
+        /** @brief Item at given position */
+        const T& operator[](std::size_t i) const {
+            return *reinterpret_cast<const T*>(_data + i*_stride);
+        }
+
+        /** @brief Copy the items to a contiguous array */
+        std::vector<T> toVector() const {
+            std::vector<T> out;
+            out.reserve(_size);
+            for(std::size_t i = 0; i != _size; ++i) out.push_back((*this)[i]);
+            return out;
+        }
+
+    private:
+        const char* _data;
+        std::size_t _size;
+        std::size_t _stride;
+};
+
+/**
+@brief Mesh data
+
+Alternative to @ref MeshData2D and @ref MeshData3D that keeps index and
+vertex data of the mesh in a single contiguous allocation. Attributes can be
+stored either interleaved or one after another, the layout is described by
+a list of @ref MeshAttributeData. The vertex data can be uploaded to GPU
+with a single @ref Buffer::setData() call using @ref MeshTools::compile().
+
+Example of a mesh with interleaved positions and normals and 16-bit indices
+after them:
+@code
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+
+Containers::Array<char> data{vertexCount*sizeof(Vertex) + indexCount*sizeof(UnsignedShort)};
+// fill the data...
+
+Trade::MeshData meshData{MeshPrimitive::Triangles, std::move(data),
+    Trade::MeshIndexType::UnsignedShort, vertexCount*sizeof(Vertex), indexCount,
+    {Trade::MeshAttributeData{Trade::MeshAttributeName::Position, Trade::MeshAttributeType::Vector3, offsetof(Vertex, position), sizeof(Vertex)},
+     Trade::MeshAttributeData{Trade::MeshAttributeName::Normal, Trade::MeshAttributeType::Vector3, offsetof(Vertex, normal), sizeof(Vertex)}},
+    vertexCount};
+@endcode
+
+Attributes can be accessed through typed strided views:
+@code
+Trade::MeshAttributeView<Vector3> positions = meshData.attribute<Vector3>(Trade::MeshAttributeName::Position);
+for(std::size_t i = 0; i != positions.size(); ++i) {
+    // ...
+}
+@endcode
+
+Index and attribute data are expected to be aligned to the size of their
+scalar type.
+*/
+class MAGNUM_EXPORT MeshData {
+    public:
+        /**
+         * @brief Construct indexed mesh data
+         * @param primitive     Primitive
+         * @param data          Index and vertex data
+         * @param indexType     Index type
+         * @param indexOffset   Offset of the index array in @p data
+         * @param indexCount    Index count
+         * @param attributes    Attribute description
+         * @param vertexCount   Vertex count
+         * @param importerState Importer-specific state
+         *
+         * Expects that the indices and all attributes fit into @p data.
+         */
+        explicit MeshData(MeshPrimitive primitive, Containers::Array<char>&& data, MeshIndexType indexType, std::size_t indexOffset, UnsignedInt indexCount, std::vector<MeshAttributeData> attributes, UnsignedInt vertexCount, const void* importerState = nullptr);
+
+        /**
+         * @brief Construct non-indexed mesh data
+         * @param primitive     Primitive
+         * @param data          Vertex data
+         * @param attributes    Attribute description
+         * @param vertexCount   Vertex count
+         * @param importerState Importer-specific state
+         *
+         * Expects that all attributes fit into @p data.
+         */
+        explicit MeshData(MeshPrimitive primitive, Containers::Array<char>&& data, std::vector<MeshAttributeData> attributes, UnsignedInt vertexCount, const void* importerState = nullptr);
+
+        /** @brief Copying is not allowed */
+        MeshData(const MeshData&) = delete;
+
+        /** @brief Move constructor */
+        MeshData(MeshData&&);
+
+        ~MeshData();
+
+        /** @brief Copying is not allowed */
+        MeshData& operator=(const MeshData&) = delete;
+
+        /** @brief Move assignment */
+        MeshData& operator=(MeshData&&);
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Raw index and vertex data */
+        Containers::ArrayView<const char> data() const { return _data; }
+
+        /**
+         * @brief Release data storage
+         *
+         * Releases the ownership of the data array and resets internal state
+         * to default. The attribute and index description is kept, so the
+         * caller can still interpret the returned data.
+         */
+        Containers::Array<char> release();
+
+        /** @brief Whether the mesh is indexed */
+        bool isIndexed() const { return _indexCount; }
+
+        /**
+         * @brief Index type
+         *
+         * Expects that the mesh is indexed.
+         */
+        MeshIndexType indexType() const;
+
+        /** @brief Offset of the index array in @ref data() */
+        std::size_t indexOffset() const { return _indexOffset; }
+
+        /** @brief Index count, `0` if the mesh is not indexed */
+        UnsignedInt indexCount() const { return _indexCount; }
+
+        /**
+         * @brief Raw index data
+         *
+         * Empty if the mesh is not indexed.
+         */
+        Containers::ArrayView<const char> indexData() const;
+
+        /**
+         * @brief Indices converted to 32-bit integers
+         *
+         * Expects that the mesh is indexed. Useful for passing the data to
+         * @ref MeshTools algorithms.
+         */
+        std::vector<UnsignedInt> indicesAsArray() const;
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /** @brief Total count of attributes */
+        UnsignedInt attributeCount() const { return _attributes.size(); }
+
+        /**
+         * @brief Attribute description
+         *
+         * Expects that @p id is less than @ref attributeCount().
+         */
+        const MeshAttributeData& attributeData(UnsignedInt id) const;
+
+        /** @brief Count of attributes with given name */
+        UnsignedInt attributeCount(MeshAttributeName name) const;
+
+        /** @brief Whether the mesh has given attribute */
+        bool hasAttribute(MeshAttributeName name) const {
+            return attributeCount(name);
+        }
+
+        /**
+         * @brief Typed view on an attribute
+         * @param id        Attribute ID
+         *
+         * Expects that @p id is less than @ref attributeCount() and @p T
+         * corresponds to @ref MeshAttributeData::type().
+         */
+        template<class T> MeshAttributeView<T> attribute(UnsignedInt id) const;
+
+        /**
+         * @brief Typed view on an attribute with given name
+         * @param name      Attribute name
+         * @param id        ID of attribute with given name
+         *
+         * Expects that @p id is less than @ref attributeCount(MeshAttributeName) const
+         * and @p T corresponds to @ref MeshAttributeData::type().
+         */
+        template<class T> MeshAttributeView<T> attribute(MeshAttributeName name, UnsignedInt id = 0) const {
+            return attribute<T>(attributeId(name, id));
+        }
+
+        /**
+         * @brief Importer-specific state
+         *
+         * See @ref AbstractImporter::importerState() for more information.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        UnsignedInt attributeId(MeshAttributeName name, UnsignedInt id) const;
+        const char* attributeDataChecked(UnsignedInt id, MeshAttributeType type) const;
+
+        MeshPrimitive _primitive;
+        MeshIndexType _indexType;
+        Containers::Array<char> _data;
+        std::size_t _indexOffset;
+        UnsignedInt _indexCount, _vertexCount;
+        std::vector<MeshAttributeData> _attributes;
+        const void* _importerState;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    template<class> struct MeshAttributeTypeFor;
+    template<> struct MeshAttributeTypeFor<Vector2> {
+        constexpr static MeshAttributeType type() { return MeshAttributeType::Vector2; }
+    };
+    template<> struct MeshAttributeTypeFor<Vector3> {
+        constexpr static MeshAttributeType type() { return MeshAttributeType::Vector3; }
+    };
+    template<> struct MeshAttributeTypeFor<Vector4> {
+        constexpr static MeshAttributeType type() { return MeshAttributeType::Vector4; }
+    };
+}
+#endif
+
+template<class T> MeshAttributeView<T> MeshData::attribute(const UnsignedInt id) const {
+    const char* const data = attributeDataChecked(id, Implementation::MeshAttributeTypeFor<T>::type());
+    if(!data) return {};
+    return MeshAttributeView<T>{data, _vertexCount, _attributes[id].stride()};
+}
+
+}}
+
+#endif
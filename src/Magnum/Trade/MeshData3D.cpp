@@ -25,7 +25,7 @@
 
 #include "MeshData3D.h"
 
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
 
 namespace Magnum { namespace Trade {
 
@@ -33,6 +33,15 @@ MeshData3D::MeshData3D(const MeshPrimitive primitive, std::vector<UnsignedInt> i
     CORRADE_ASSERT(!_positions.empty(), "Trade::MeshData3D: no position array specified", );
 }
 
+MeshData3D::MeshData3D(const MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<Vector4ui> jointIds, std::vector<Vector4> jointWeights, const void* const importerState): MeshData3D{primitive, std::move(indices), std::move(positions), std::move(normals), std::move(textureCoords2D), importerState} {
+    _jointIds = std::move(jointIds);
+    _jointWeights = std::move(jointWeights);
+    CORRADE_ASSERT(_jointIds.size() == _jointWeights.size(),
+        "Trade::MeshData3D: expected" << _jointIds.size() << "joint weights but got" << _jointWeights.size(), );
+    CORRADE_ASSERT(_jointIds.empty() || _positions.empty() || _jointIds.size() == _positions[0].size(),
+        "Trade::MeshData3D: expected" << _positions[0].size() << "joint IDs but got" << _jointIds.size(), );
+}
+
 MeshData3D::MeshData3D(MeshData3D&&) = default;
 
 MeshData3D::~MeshData3D() = default;
@@ -79,4 +88,24 @@ const std::vector<Vector2>& MeshData3D::textureCoords2D(const UnsignedInt id) co
     return _textureCoords2D[id];
 }
 
+std::vector<Vector4ui>& MeshData3D::jointIds() {
+    CORRADE_ASSERT(hasJoints(), "Trade::MeshData3D::jointIds(): the mesh is not skinned", _jointIds);
+    return _jointIds;
+}
+
+const std::vector<Vector4ui>& MeshData3D::jointIds() const {
+    CORRADE_ASSERT(hasJoints(), "Trade::MeshData3D::jointIds(): the mesh is not skinned", _jointIds);
+    return _jointIds;
+}
+
+std::vector<Vector4>& MeshData3D::jointWeights() {
+    CORRADE_ASSERT(hasJoints(), "Trade::MeshData3D::jointWeights(): the mesh is not skinned", _jointWeights);
+    return _jointWeights;
+}
+
+const std::vector<Vector4>& MeshData3D::jointWeights() const {
+    CORRADE_ASSERT(hasJoints(), "Trade::MeshData3D::jointWeights(): the mesh is not skinned", _jointWeights);
+    return _jointWeights;
+}
+
 }}
@@ -59,6 +59,28 @@ class MAGNUM_EXPORT MeshData3D {
          */
         explicit MeshData3D(MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, const void* importerState = nullptr);
 
+        /**
+         * @brief Construct skinned mesh data
+         * @param primitive         Primitive
+         * @param indices           Index array or empty array, if the mesh is
+         *      not indexed
+         * @param positions         Position arrays. At least one position
+         *      array should be present.
+         * @param normals           Normal arrays, if present
+         * @param textureCoords2D   Two-dimensional texture coordinate arrays,
+         *      if present
+         * @param jointIds          IDs of up to four joints affecting each
+         *      vertex, or empty array if the mesh is not skinned
+         * @param jointWeights      Weights of joints from @p jointIds,
+         *      or empty array if the mesh is not skinned
+         * @param importerState     Importer-specific state
+         *
+         * Expects that @p jointIds and @p jointWeights have the same size as
+         * the first position array. Weights of each vertex are expected to
+         * sum up to `1.0f`, unused joints should have zero weight.
+         */
+        explicit MeshData3D(MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<Vector4ui> jointIds, std::vector<Vector4> jointWeights, const void* importerState = nullptr);
+
         /** @brief Copying is not allowed */
         MeshData3D(const MeshData3D&) = delete;
 
@@ -133,6 +155,32 @@ class MAGNUM_EXPORT MeshData3D {
         std::vector<Vector2>& textureCoords2D(UnsignedInt id);
         const std::vector<Vector2>& textureCoords2D(UnsignedInt id) const; /**< @overload */
 
+        /**
+         * @brief Whether the mesh is skinned
+         *
+         * @see @ref jointIds(), @ref jointWeights()
+         */
+        bool hasJoints() const { return !_jointIds.empty(); }
+
+        /**
+         * @brief Joint IDs
+         *
+         * IDs of up to four joints affecting each vertex.
+         * @see @ref hasJoints(), @ref MeshTools::skinDualQuaternionsInto(),
+         *      @ref Shaders::Phong::JointIds
+         */
+        std::vector<Vector4ui>& jointIds();
+        const std::vector<Vector4ui>& jointIds() const; /**< @overload */
+
+        /**
+         * @brief Joint weights
+         *
+         * Weights of joints from @ref jointIds().
+         * @see @ref hasJoints(), @ref Shaders::Phong::Weights
+         */
+        std::vector<Vector4>& jointWeights();
+        const std::vector<Vector4>& jointWeights() const; /**< @overload */
+
         /**
          * @brief Importer-specific state
          *
@@ -146,6 +194,8 @@ class MAGNUM_EXPORT MeshData3D {
         std::vector<std::vector<Vector3>> _positions;
         std::vector<std::vector<Vector3>> _normals;
         std::vector<std::vector<Vector2>> _textureCoords2D;
+        std::vector<Vector4ui> _jointIds;
+        std::vector<Vector4> _jointWeights;
         const void* _importerState;
 };
 
@@ -23,11 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/FlatSceneData3D.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshObjectData3D.h"
+#include "Magnum/Trade/SceneData.h"
 
 #include "configure.h"
 
@@ -38,10 +47,92 @@ class AbstractImporterTest: public TestSuite::Tester {
         explicit AbstractImporterTest();
 
         void openFile();
+
+        void flatScene3D();
+        void flatScene3DInvalidHierarchy();
+
+        void allocator();
+        void image2DIntoView();
+        void image2DIntoViewCopy();
+        void image2DIntoViewTooSmall();
+        void meshIntoView();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+
+              &AbstractImporterTest::flatScene3D,
+              &AbstractImporterTest::flatScene3DInvalidHierarchy,
+
+              &AbstractImporterTest::allocator,
+              &AbstractImporterTest::image2DIntoView,
+              &AbstractImporterTest::image2DIntoViewCopy,
+              &AbstractImporterTest::image2DIntoViewTooSmall,
+              &AbstractImporterTest::meshIntoView});
+}
+
+namespace {
+    /* Scene 0 is a valid hierarchy, scene 1 references object 2 twice */
+    class SceneImporter: public Trade::AbstractImporter {
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            UnsignedInt doSceneCount() const override { return 2; }
+            std::optional<SceneData> doScene(UnsignedInt id) override {
+                if(id == 0) return SceneData{{}, {4, 0}, &state};
+                return SceneData{{}, {0, 2}};
+            }
+
+            UnsignedInt doObject3DCount() const override { return 5; }
+            std::unique_ptr<ObjectData3D> doObject3D(UnsignedInt id) override {
+                switch(id) {
+                    case 0: return std::unique_ptr<ObjectData3D>{new MeshObjectData3D{{1, 2}, Matrix4::translation(Vector3::xAxis()), 3, 7}};
+                    case 1: return std::unique_ptr<ObjectData3D>{new ObjectData3D{{}, Matrix4::scaling(Vector3{2.0f})}};
+                    case 2: return std::unique_ptr<ObjectData3D>{new ObjectData3D{{3}, Matrix4::translation(Vector3::yAxis())}};
+                    case 3: return std::unique_ptr<ObjectData3D>{new MeshObjectData3D{{}, {}, 1, -1}};
+                    case 4: return std::unique_ptr<ObjectData3D>{new ObjectData3D{{}, {}, ObjectInstanceType3D::Camera, 0}};
+                }
+
+                return nullptr;
+            }
+
+        public:
+            int state;
+    };
+
+    /* Image 0 and mesh 0 are allocated through allocate(), image 1 not */
+    class DataImporter: public Trade::AbstractImporter {
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            UnsignedInt doImage2DCount() const override { return 2; }
+            std::optional<ImageData2D> doImage2D(UnsignedInt id) override {
+                Containers::Array<char> data = id == 0 ? allocate(8) : Containers::Array<char>{8};
+                for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i + 1);
+                return ImageData2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 1}, std::move(data), &state};
+            }
+
+            UnsignedInt doMeshCount() const override { return 1; }
+            std::optional<MeshData> doMesh(UnsignedInt) override {
+                Containers::Array<char> data = allocate(3*sizeof(Vector3) + 3*sizeof(UnsignedShort));
+                Vector3* positions = reinterpret_cast<Vector3*>(data.data());
+                positions[0] = {0.0f, 0.0f, 0.0f};
+                positions[1] = {1.0f, 0.0f, 0.0f};
+                positions[2] = {0.0f, 1.0f, 0.0f};
+                UnsignedShort* indices = reinterpret_cast<UnsignedShort*>(data.data() + 3*sizeof(Vector3));
+                indices[0] = 2;
+                indices[1] = 1;
+                indices[2] = 0;
+                return MeshData{MeshPrimitive::Triangles, std::move(data), MeshIndexType::UnsignedShort, 3*sizeof(Vector3), 3, {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vector3)}}, 3, &state};
+            }
+
+        public:
+            int state;
+    };
 }
 
 void AbstractImporterTest::openFile() {
@@ -68,6 +159,125 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+void AbstractImporterTest::flatScene3D() {
+    SceneImporter importer;
+    std::optional<FlatSceneData3D> scene = importer.flatScene3D(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->size(), 5);
+    CORRADE_COMPARE(scene->importerState(), &importer.state);
+
+    /* Depth-first, children in their original order */
+    CORRADE_COMPARE(scene->objects(), (std::vector<UnsignedInt>{4, 0, 1, 2, 3}));
+    CORRADE_COMPARE(scene->parents(), (std::vector<Int>{-1, -1, 1, 1, 3}));
+    CORRADE_COMPARE(scene->transformations()[1], Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(scene->transformations()[3], Matrix4::translation(Vector3::yAxis()));
+    CORRADE_COMPARE(scene->instanceTypes(), (std::vector<ObjectInstanceType3D>{
+        ObjectInstanceType3D::Camera,
+        ObjectInstanceType3D::Mesh,
+        ObjectInstanceType3D::Empty,
+        ObjectInstanceType3D::Empty,
+        ObjectInstanceType3D::Mesh}));
+    CORRADE_COMPARE(scene->instances(), (std::vector<Int>{0, 3, -1, -1, 1}));
+    CORRADE_COMPARE(scene->materials(), (std::vector<Int>{-1, 7, -1, -1, -1}));
+}
+
+void AbstractImporterTest::flatScene3DInvalidHierarchy() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SceneImporter importer;
+    CORRADE_VERIFY(!importer.flatScene3D(1));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::flatScene3D(): object 2 is out of range or referenced more than once\n");
+}
+
+void AbstractImporterTest::allocator() {
+    DataImporter importer;
+    CORRADE_VERIFY(!importer.allocator());
+
+    struct Arena {
+        char data[32];
+        std::size_t offset;
+    } arena{{}, 0};
+    importer.setAllocator([](std::size_t size, void* userData) {
+        Arena& a = *static_cast<Arena*>(userData);
+        char* data = a.data + a.offset;
+        a.offset += size;
+        return Containers::Array<char>{data, size, [](char*, std::size_t) {}};
+    }, &arena);
+    CORRADE_VERIFY(importer.allocator());
+
+    std::optional<ImageData2D> a = importer.image2D(0);
+    std::optional<ImageData2D> b = importer.image2D(0);
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(static_cast<const void*>(a->data().data()), arena.data);
+    CORRADE_COMPARE(static_cast<const void*>(b->data().data()), arena.data + 8);
+    CORRADE_COMPARE(arena.data[9], 2);
+
+    /* Resetting goes back to the heap */
+    importer.setAllocator(nullptr);
+    std::optional<ImageData2D> c = importer.image2D(0);
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(arena.offset, 16);
+}
+
+void AbstractImporterTest::image2DIntoView() {
+    DataImporter importer;
+    char data[10]{};
+
+    std::optional<ImageData2D> image = importer.image2D(0, data);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), data);
+    CORRADE_COMPARE(image->data().size(), 8);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 1));
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->importerState(), &importer.state);
+    CORRADE_COMPARE(data[7], 8);
+    CORRADE_COMPARE(data[8], 0);
+
+    /* The original allocator is restored afterwards */
+    CORRADE_VERIFY(!importer.allocator());
+}
+
+void AbstractImporterTest::image2DIntoViewCopy() {
+    DataImporter importer;
+    char data[8]{};
+
+    /* The importer doesn't use allocate(), the data are copied */
+    std::optional<ImageData2D> image = importer.image2D(1, data);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), data);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 1));
+    CORRADE_COMPARE(data[0], 1);
+    CORRADE_COMPARE(data[7], 8);
+}
+
+void AbstractImporterTest::image2DIntoViewTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DataImporter importer;
+    char data[7];
+    CORRADE_VERIFY(!importer.image2D(0, data));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2D(): expected at least 8 bytes for the data but got 7\n");
+}
+
+void AbstractImporterTest::meshIntoView() {
+    DataImporter importer;
+    alignas(4) char data[3*sizeof(Vector3) + 3*sizeof(UnsignedShort)];
+
+    std::optional<MeshData> mesh = importer.mesh(0, data);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(static_cast<const void*>(mesh->data().data()), data);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->indicesAsArray(), (std::vector<UnsignedInt>{2, 1, 0}));
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttributeName::Position).toVector(), (std::vector<Vector3>{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(mesh->importerState(), &importer.state);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AbstractImporterTest)
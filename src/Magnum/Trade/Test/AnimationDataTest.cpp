@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class AnimationDataTest: public TestSuite::Tester {
+    public:
+        explicit AnimationDataTest();
+
+        void construct();
+        void constructMove();
+        void release();
+        void typeSize();
+
+        void sampleLinear();
+        void sampleConstant();
+        void sampleQuaternion();
+        void sampleClamp();
+        void sampleHint();
+
+        void debugTrackType();
+        void debugTrackTarget();
+        void debugInterpolation();
+};
+
+AnimationDataTest::AnimationDataTest() {
+    addTests({&AnimationDataTest::construct,
+              &AnimationDataTest::constructMove,
+              &AnimationDataTest::release,
+              &AnimationDataTest::typeSize,
+
+              &AnimationDataTest::sampleLinear,
+              &AnimationDataTest::sampleConstant,
+              &AnimationDataTest::sampleQuaternion,
+              &AnimationDataTest::sampleClamp,
+              &AnimationDataTest::sampleHint,
+
+              &AnimationDataTest::debugTrackType,
+              &AnimationDataTest::debugTrackTarget,
+              &AnimationDataTest::debugInterpolation});
+}
+
+namespace {
+    using namespace Math::Literals;
+
+    struct Data {
+        Float times[3];
+        Float weightTimes[2];
+        Vector3 translations[3];
+        Quaternion rotations[3];
+        Float weights[2];
+    };
+
+    const Data Keyframes{
+        {0.0f, 1.0f, 3.0f},
+        {0.5f, 4.0f},
+        {{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {2.0f, 4.0f, 0.0f}},
+        {{}, Quaternion::rotation(90.0_degf, Vector3::xAxis()), Quaternion::rotation(90.0_degf, Vector3::xAxis())},
+        {0.25f, 0.75f}
+    };
+
+    AnimationData animationData(const void* importerState = nullptr) {
+        Containers::Array<char> data{sizeof(Data)};
+        std::memcpy(data, &Keyframes, sizeof(Data));
+        return AnimationData{std::move(data), {
+            AnimationTrackData{AnimationTrackType::Vector3, AnimationTrackTarget::Translation, 5, AnimationInterpolation::Linear, offsetof(Data, times), offsetof(Data, translations), 3},
+            AnimationTrackData{AnimationTrackType::Quaternion, AnimationTrackTarget::Rotation, 5, AnimationInterpolation::Linear, offsetof(Data, times), offsetof(Data, rotations), 3},
+            AnimationTrackData{AnimationTrackType::Float, AnimationTrackTarget::Custom, 2, AnimationInterpolation::Constant, offsetof(Data, weightTimes), offsetof(Data, weights), 2}},
+            importerState};
+    }
+}
+
+void AnimationDataTest::construct() {
+    int state{};
+    const AnimationData data = animationData(&state);
+
+    CORRADE_COMPARE(data.data().size(), sizeof(Data));
+    CORRADE_COMPARE(data.importerState(), &state);
+    CORRADE_COMPARE(data.duration(), 4.0f);
+    CORRADE_COMPARE(data.trackCount(), 3);
+
+    CORRADE_COMPARE(data.trackData(1).type(), AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(data.trackData(1).target(), AnimationTrackTarget::Rotation);
+    CORRADE_COMPARE(data.trackData(1).targetObject(), 5);
+    CORRADE_COMPARE(data.trackData(1).interpolation(), AnimationInterpolation::Linear);
+    CORRADE_COMPARE(data.trackData(1).timesOffset(), offsetof(Data, times));
+    CORRADE_COMPARE(data.trackData(1).valuesOffset(), offsetof(Data, rotations));
+    CORRADE_COMPARE(data.trackData(1).keyframeCount(), 3);
+
+    AnimationTrackView<Vector3> translation = data.track<Vector3>(0);
+    CORRADE_COMPARE(translation.size(), 3);
+    CORRADE_COMPARE(translation.duration(), 3.0f);
+    CORRADE_COMPARE(translation.interpolation(), AnimationInterpolation::Linear);
+    CORRADE_COMPARE(translation.times()[1], 1.0f);
+    CORRADE_COMPARE(translation.values()[2], (Vector3{2.0f, 4.0f, 0.0f}));
+
+    AnimationTrackView<Float> weights = data.track<Float>(2);
+    CORRADE_COMPARE(weights.size(), 2);
+    CORRADE_COMPARE(weights.duration(), 4.0f);
+    CORRADE_COMPARE(weights.values()[1], 0.75f);
+}
+
+void AnimationDataTest::constructMove() {
+    AnimationData a = animationData();
+    const char* data = a.data().data();
+
+    AnimationData b{std::move(a)};
+    CORRADE_COMPARE(b.data().data(), data);
+    CORRADE_COMPARE(b.trackCount(), 3);
+
+    AnimationData c{Containers::Array<char>{}, {}};
+    CORRADE_COMPARE(c.duration(), 0.0f);
+    c = std::move(b);
+    CORRADE_COMPARE(c.data().data(), data);
+    CORRADE_COMPARE(c.duration(), 4.0f);
+}
+
+void AnimationDataTest::release() {
+    AnimationData data = animationData();
+    const char* pointer = data.data().data();
+
+    Containers::Array<char> released = data.release();
+    CORRADE_COMPARE(released.data(), pointer);
+    CORRADE_VERIFY(data.data().empty());
+    CORRADE_COMPARE(data.trackCount(), 3);
+}
+
+void AnimationDataTest::typeSize() {
+    CORRADE_COMPARE(animationTrackTypeSize(AnimationTrackType::Float), 4);
+    CORRADE_COMPARE(animationTrackTypeSize(AnimationTrackType::Vector3), 12);
+    CORRADE_COMPARE(animationTrackTypeSize(AnimationTrackType::Quaternion), 16);
+}
+
+void AnimationDataTest::sampleLinear() {
+    const AnimationData data = animationData();
+    AnimationTrackView<Vector3> translation = data.track<Vector3>(0);
+
+    CORRADE_COMPARE(translation.at(0.5f), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(translation.at(1.0f), (Vector3{2.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(translation.at(2.5f), (Vector3{2.0f, 3.0f, 0.0f}));
+}
+
+void AnimationDataTest::sampleConstant() {
+    const AnimationData data = animationData();
+    AnimationTrackView<Float> weights = data.track<Float>(2);
+
+    CORRADE_COMPARE(weights.at(0.75f), 0.25f);
+    CORRADE_COMPARE(weights.at(3.99f), 0.25f);
+    CORRADE_COMPARE(weights.at(4.0f), 0.75f);
+}
+
+void AnimationDataTest::sampleQuaternion() {
+    const AnimationData data = animationData();
+    AnimationTrackView<Quaternion> rotation = data.track<Quaternion>(1);
+
+    CORRADE_COMPARE(rotation.at(0.5f), Quaternion::rotation(45.0_degf, Vector3::xAxis()));
+}
+
+void AnimationDataTest::sampleClamp() {
+    const AnimationData data = animationData();
+    AnimationTrackView<Vector3> translation = data.track<Vector3>(0);
+
+    std::size_t hint = 1;
+    CORRADE_COMPARE(translation.at(-1.0f, hint), Vector3{});
+    CORRADE_COMPARE(hint, 0);
+    CORRADE_COMPARE(translation.at(5.0f, hint), (Vector3{2.0f, 4.0f, 0.0f}));
+    CORRADE_COMPARE(hint, 2);
+}
+
+void AnimationDataTest::sampleHint() {
+    const Float times[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Float values[]{0.0f, 10.0f, 20.0f, 30.0f, 40.0f};
+    AnimationTrackView<Float> track{times, values, AnimationInterpolation::Linear};
+
+    /* Same keyframe */
+    std::size_t hint{};
+    CORRADE_COMPARE(track.at(0.5f, hint), 5.0f);
+    CORRADE_COMPARE(hint, 0);
+
+    /* Next keyframe */
+    CORRADE_COMPARE(track.at(1.5f, hint), 15.0f);
+    CORRADE_COMPARE(hint, 1);
+
+    /* Skipping a keyframe needs a search */
+    CORRADE_COMPARE(track.at(3.5f, hint), 35.0f);
+    CORRADE_COMPARE(hint, 3);
+
+    /* Going back as well */
+    CORRADE_COMPARE(track.at(2.25f, hint), 22.5f);
+    CORRADE_COMPARE(hint, 2);
+
+    /* Invalid hint is ignored */
+    hint = 100;
+    CORRADE_COMPARE(track.at(1.5f, hint), 15.0f);
+    CORRADE_COMPARE(hint, 1);
+}
+
+void AnimationDataTest::debugTrackType() {
+    std::ostringstream out;
+    Debug(&out) << AnimationTrackType::Quaternion << AnimationTrackType(0xde);
+    CORRADE_COMPARE(out.str(), "Trade::AnimationTrackType::Quaternion Trade::AnimationTrackType::(invalid)\n");
+}
+
+void AnimationDataTest::debugTrackTarget() {
+    std::ostringstream out;
+    Debug(&out) << AnimationTrackTarget::Scaling << AnimationTrackTarget(0xde);
+    CORRADE_COMPARE(out.str(), "Trade::AnimationTrackTarget::Scaling Trade::AnimationTrackTarget::(invalid)\n");
+}
+
+void AnimationDataTest::debugInterpolation() {
+    std::ostringstream out;
+    Debug(&out) << AnimationInterpolation::Linear << AnimationInterpolation(0xde);
+    CORRADE_COMPARE(out.str(), "Trade::AnimationInterpolation::Linear Trade::AnimationInterpolation::(invalid)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AnimationDataTest)
@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AsyncImporter.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct AsyncImporterTest: TestSuite::Tester {
+    explicit AsyncImporterTest();
+
+    void construct();
+    void constructNoImporters();
+
+    void image2D();
+    void image2DCompletion();
+    void mesh3DNotFound();
+    void import();
+    void openFailed();
+
+    void cancel();
+    void cancelCompletion();
+    void priority();
+
+    void destructWaiting();
+};
+
+AsyncImporterTest::AsyncImporterTest() {
+    addTests({&AsyncImporterTest::construct,
+              &AsyncImporterTest::constructNoImporters,
+
+              &AsyncImporterTest::image2D,
+              &AsyncImporterTest::image2DCompletion,
+              &AsyncImporterTest::mesh3DNotFound,
+              &AsyncImporterTest::import,
+              &AsyncImporterTest::openFailed,
+
+              &AsyncImporterTest::cancel,
+              &AsyncImporterTest::cancelCompletion,
+              &AsyncImporterTest::priority,
+
+              &AsyncImporterTest::destructWaiting});
+}
+
+namespace {
+    /* Opens any file except "nonexistent", the file "gate" blocks until
+       released. Contains one image with width equal to filename length. */
+    class Importer: public AbstractImporter {
+        public:
+            explicit Importer(std::shared_future<void> gate = {}, std::promise<void>* gateEntered = nullptr, std::vector<std::string>* opened = nullptr): _gate{std::move(gate)}, _gateEntered{gateEntered}, _openedFiles{opened} {}
+
+        private:
+            Features doFeatures() const override { return {}; }
+            bool doIsOpened() const override { return !_filename.empty(); }
+            void doClose() override { _filename = {}; }
+
+            void doOpenFile(const std::string& filename) override {
+                if(filename == "gate") {
+                    _gateEntered->set_value();
+                    _gate.wait();
+                }
+                if(_openedFiles) _openedFiles->push_back(filename);
+                if(filename != "nonexistent") _filename = filename;
+            }
+
+            UnsignedInt doImage2DCount() const override { return 1; }
+            std::optional<ImageData2D> doImage2D(UnsignedInt) override {
+                return ImageData2D{PixelFormat::Red, PixelType::UnsignedByte, {Int(_filename.size()), 1}, Containers::Array<char>{_filename.size()}};
+            }
+
+            std::string _filename;
+            std::shared_future<void> _gate;
+            std::promise<void>* _gateEntered;
+            std::vector<std::string>* _openedFiles;
+    };
+
+    std::vector<std::unique_ptr<AbstractImporter>> importers(UnsignedInt count) {
+        std::vector<std::unique_ptr<AbstractImporter>> out;
+        for(UnsignedInt i = 0; i != count; ++i) out.emplace_back(new Importer);
+        return out;
+    }
+}
+
+void AsyncImporterTest::construct() {
+    AsyncImporter importer{importers(3)};
+    CORRADE_COMPARE(importer.threadCount(), 3);
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+    CORRADE_COMPARE(importer.update(), 0);
+}
+
+void AsyncImporterTest::constructNoImporters() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AsyncImporter importer{std::vector<std::unique_ptr<AbstractImporter>>{}};
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter: no importers specified\n");
+}
+
+void AsyncImporterTest::image2D() {
+    AsyncImporter importer{importers(2)};
+
+    AsyncImport<ImageData2D> a = importer.image2D("a.tga");
+    AsyncImport<ImageData2D> b = importer.image2D("bbb.tga");
+    CORRADE_VERIFY(a.isValid());
+    CORRADE_COMPARE(a.priority(), 0);
+
+    std::optional<ImageData2D> imageB = b.get();
+    std::optional<ImageData2D> imageA = a.get();
+    CORRADE_VERIFY(imageA);
+    CORRADE_VERIFY(imageB);
+    CORRADE_COMPARE(imageA->size(), (Vector2i{5, 1}));
+    CORRADE_COMPARE(imageB->size(), (Vector2i{7, 1}));
+
+    /* Futures don't need update() */
+    importer.wait();
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+}
+
+void AsyncImporterTest::image2DCompletion() {
+    AsyncImporter importer{importers(2)};
+
+    std::vector<Int> widths;
+    for(const char* filename: {"a.tga", "bb.tga", "ccc.tga"})
+        importer.image2D(filename, 0, 0, [&widths](std::optional<ImageData2D>&& image) {
+            widths.push_back(image ? image->size().x() : -1);
+        });
+
+    /* Callbacks are called only from update() */
+    importer.wait();
+    CORRADE_VERIFY(widths.empty());
+    CORRADE_COMPARE(importer.pendingCount(), 3);
+
+    CORRADE_COMPARE(importer.update(), 3);
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+    std::sort(widths.begin(), widths.end());
+    CORRADE_COMPARE_AS(widths, (std::vector<Int>{5, 6, 7}), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::mesh3DNotFound() {
+    AsyncImporter importer{importers(1)};
+
+    /* The test importer has no meshes */
+    CORRADE_VERIFY(!importer.mesh3D("mesh.obj").get());
+}
+
+void AsyncImporterTest::import() {
+    AsyncImporter importer{importers(1)};
+
+    AsyncImport<UnsignedInt> count = importer.import<UnsignedInt>("file.bin", [](AbstractImporter& importer) -> std::optional<UnsignedInt> {
+        return importer.image2DCount() + 41;
+    });
+    std::optional<UnsignedInt> result = count.get();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(*result, 42);
+}
+
+void AsyncImporterTest::openFailed() {
+    AsyncImporter importer{importers(1)};
+
+    CORRADE_VERIFY(!importer.image2D("nonexistent").get());
+
+    /* Completion is called also for failed imports */
+    bool called = false;
+    importer.image2D("nonexistent", 0, 0, [&called](std::optional<ImageData2D>&& image) {
+        called = !image;
+    });
+    importer.wait();
+    CORRADE_COMPARE(importer.update(), 1);
+    CORRADE_VERIFY(called);
+}
+
+void AsyncImporterTest::cancel() {
+    std::promise<void> gate, gateEntered;
+    std::vector<std::string> opened;
+    std::vector<std::unique_ptr<AbstractImporter>> instances;
+    instances.emplace_back(new Importer{gate.get_future().share(), &gateEntered, &opened});
+    AsyncImporter importer{std::move(instances)};
+
+    /* Block the only worker */
+    AsyncImport<ImageData2D> blocking = importer.image2D("gate");
+    gateEntered.get_future().wait();
+
+    AsyncImport<ImageData2D> a = importer.image2D("a.tga");
+    AsyncImport<ImageData2D> b = importer.image2D("b.tga");
+    b.cancel();
+    CORRADE_VERIFY(b.isCancelled());
+    CORRADE_VERIFY(!a.isCancelled());
+
+    gate.set_value();
+    CORRADE_VERIFY(blocking.get());
+    CORRADE_VERIFY(a.get());
+    CORRADE_VERIFY(!b.get());
+
+    /* The cancelled file was never opened */
+    CORRADE_COMPARE_AS(opened, (std::vector<std::string>{"gate", "a.tga"}), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::cancelCompletion() {
+    AsyncImporter importer{importers(1)};
+
+    Int called = 0;
+    AsyncImportHandle a = importer.image2D("a.tga", 0, 0, [&called](std::optional<ImageData2D>&&) { ++called; });
+    AsyncImportHandle b = importer.image2D("b.tga", 0, 0, [&called](std::optional<ImageData2D>&&) { called += 10; });
+
+    /* Cancelling a finished import before update() still prevents the
+       callback from being called */
+    importer.wait();
+    b.cancel();
+    CORRADE_COMPARE(importer.update(), 1);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(!a.isCancelled());
+}
+
+void AsyncImporterTest::priority() {
+    std::promise<void> gate, gateEntered;
+    std::vector<std::string> opened;
+    std::vector<std::unique_ptr<AbstractImporter>> instances;
+    instances.emplace_back(new Importer{gate.get_future().share(), &gateEntered, &opened});
+    AsyncImporter importer{std::move(instances)};
+
+    AsyncImport<ImageData2D> blocking = importer.image2D("gate");
+    gateEntered.get_future().wait();
+
+    AsyncImport<ImageData2D> a = importer.image2D("a", 0, 0);
+    AsyncImport<ImageData2D> b = importer.image2D("b", 0, 1);
+    AsyncImport<ImageData2D> c = importer.image2D("c", 0, 0);
+    AsyncImport<ImageData2D> d = importer.image2D("d", 0, 0);
+
+    /* The asset became visible, load it first */
+    c.setPriority(5);
+    CORRADE_COMPARE(c.priority(), 5);
+
+    gate.set_value();
+    importer.wait();
+
+    /* Same priority is processed in order of submission */
+    CORRADE_COMPARE_AS(opened, (std::vector<std::string>{"gate", "c", "b", "a", "d"}), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::destructWaiting() {
+    std::promise<void> gate, gateEntered;
+    AsyncImport<ImageData2D> blocking, waiting;
+    {
+        std::vector<std::unique_ptr<AbstractImporter>> instances;
+        instances.emplace_back(new Importer{gate.get_future().share(), &gateEntered});
+        AsyncImporter importer{std::move(instances)};
+
+        blocking = importer.image2D("gate");
+        gateEntered.get_future().wait();
+        waiting = importer.image2D("a.tga");
+
+        /* Release the worker from another thread only after the destructor
+           cancelled the waiting import */
+        std::thread release{[&gate]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            gate.set_value();
+        }};
+        release.detach();
+    }
+
+    /* The running import finished, the waiting one got cancelled */
+    CORRADE_VERIFY(blocking.get());
+    CORRADE_VERIFY(waiting.isCancelled());
+    CORRADE_VERIFY(!waiting.get());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AsyncImporterTest)
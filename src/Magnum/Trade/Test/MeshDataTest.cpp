@@ -0,0 +1,253 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class MeshDataTest: public TestSuite::Tester {
+    public:
+        explicit MeshDataTest();
+
+        void constructInterleaved();
+        void constructPlanar();
+        void constructNotIndexed();
+        void constructMove();
+        void indices8();
+        void indices16();
+        void release();
+        void typeSize();
+
+        void debugAttributeName();
+        void debugAttributeType();
+        void debugIndexType();
+};
+
+MeshDataTest::MeshDataTest() {
+    addTests({&MeshDataTest::constructInterleaved,
+              &MeshDataTest::constructPlanar,
+              &MeshDataTest::constructNotIndexed,
+              &MeshDataTest::constructMove,
+              &MeshDataTest::indices8,
+              &MeshDataTest::indices16,
+              &MeshDataTest::release,
+              &MeshDataTest::typeSize,
+
+              &MeshDataTest::debugAttributeName,
+              &MeshDataTest::debugAttributeType,
+              &MeshDataTest::debugIndexType});
+}
+
+namespace {
+    struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+        Vector3 normal;
+    };
+
+    const Vertex Vertices[]{
+        {{1.0f, 2.0f, 3.0f}, {0.0f, 0.5f}, {0.0f, 1.0f, 0.0f}},
+        {{4.0f, 5.0f, 6.0f}, {1.0f, 0.5f}, {1.0f, 0.0f, 0.0f}},
+        {{7.0f, 8.0f, 9.0f}, {0.5f, 1.0f}, {0.0f, 0.0f, 1.0f}}
+    };
+
+    const UnsignedInt Indices[]{2, 0, 1, 1, 0, 2};
+
+    /* Interleaved vertices followed by 32-bit indices */
+    Containers::Array<char> interleavedData() {
+        Containers::Array<char> data{sizeof(Vertices) + sizeof(Indices)};
+        std::memcpy(data, Vertices, sizeof(Vertices));
+        std::memcpy(data + sizeof(Vertices), Indices, sizeof(Indices));
+        return data;
+    }
+}
+
+void MeshDataTest::constructInterleaved() {
+    int state{};
+    const MeshData data{MeshPrimitive::Triangles, interleavedData(),
+        MeshIndexType::UnsignedInt, sizeof(Vertices), 6,
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, offsetof(Vertex, position), sizeof(Vertex)},
+         MeshAttributeData{MeshAttributeName::TextureCoordinates, MeshAttributeType::Vector2, offsetof(Vertex, textureCoordinates), sizeof(Vertex)},
+         MeshAttributeData{MeshAttributeName::Normal, MeshAttributeType::Vector3, offsetof(Vertex, normal), sizeof(Vertex)}},
+        3, &state};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data.data().size(), sizeof(Vertices) + sizeof(Indices));
+    CORRADE_COMPARE(data.importerState(), &state);
+
+    CORRADE_VERIFY(data.isIndexed());
+    CORRADE_COMPARE(data.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(data.indexOffset(), sizeof(Vertices));
+    CORRADE_COMPARE(data.indexCount(), 6);
+    CORRADE_COMPARE(data.indexData().size(), sizeof(Indices));
+    CORRADE_COMPARE(data.indicesAsArray(), (std::vector<UnsignedInt>{2, 0, 1, 1, 0, 2}));
+
+    CORRADE_COMPARE(data.vertexCount(), 3);
+    CORRADE_COMPARE(data.attributeCount(), 3);
+    CORRADE_COMPARE(data.attributeCount(MeshAttributeName::Normal), 1);
+    CORRADE_VERIFY(data.hasAttribute(MeshAttributeName::TextureCoordinates));
+    CORRADE_VERIFY(!data.hasAttribute(MeshAttributeName::Color));
+    CORRADE_COMPARE(data.attributeData(1).name(), MeshAttributeName::TextureCoordinates);
+    CORRADE_COMPARE(data.attributeData(1).type(), MeshAttributeType::Vector2);
+    CORRADE_COMPARE(data.attributeData(1).offset(), offsetof(Vertex, textureCoordinates));
+    CORRADE_COMPARE(data.attributeData(1).stride(), sizeof(Vertex));
+
+    MeshAttributeView<Vector3> positions = data.attribute<Vector3>(MeshAttributeName::Position);
+    CORRADE_COMPARE(positions.size(), 3);
+    CORRADE_COMPARE(positions.stride(), sizeof(Vertex));
+    CORRADE_COMPARE(positions[1], (Vector3{4.0f, 5.0f, 6.0f}));
+
+    CORRADE_COMPARE(data.attribute<Vector2>(1)[2], (Vector2{0.5f, 1.0f}));
+    CORRADE_COMPARE(data.attribute<Vector3>(MeshAttributeName::Normal).toVector(),
+        (std::vector<Vector3>{Vector3::yAxis(), Vector3::xAxis(), Vector3::zAxis()}));
+}
+
+void MeshDataTest::constructPlanar() {
+    /* Positions, then two sets of texture coordinates */
+    Containers::Array<char> storage{3*sizeof(Vector3) + 2*3*sizeof(Vector2)};
+    Vector3* positions = reinterpret_cast<Vector3*>(storage.data());
+    Vector2* textureCoordinates = reinterpret_cast<Vector2*>(storage.data() + 3*sizeof(Vector3));
+    for(std::size_t i = 0; i != 3; ++i) {
+        positions[i] = Vertices[i].position;
+        textureCoordinates[i] = Vertices[i].textureCoordinates;
+        textureCoordinates[3 + i] = Vertices[i].textureCoordinates*2.0f;
+    }
+
+    const MeshData data{MeshPrimitive::Points, std::move(storage),
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vector3)},
+         MeshAttributeData{MeshAttributeName::TextureCoordinates, MeshAttributeType::Vector2, 3*sizeof(Vector3), sizeof(Vector2)},
+         MeshAttributeData{MeshAttributeName::TextureCoordinates, MeshAttributeType::Vector2, 3*sizeof(Vector3) + 3*sizeof(Vector2), sizeof(Vector2)}},
+        3};
+
+    CORRADE_COMPARE(data.attributeCount(MeshAttributeName::TextureCoordinates), 2);
+    CORRADE_COMPARE(data.attribute<Vector3>(MeshAttributeName::Position)[2], (Vector3{7.0f, 8.0f, 9.0f}));
+    CORRADE_COMPARE(data.attribute<Vector2>(MeshAttributeName::TextureCoordinates, 0)[1], (Vector2{1.0f, 0.5f}));
+    CORRADE_COMPARE(data.attribute<Vector2>(MeshAttributeName::TextureCoordinates, 1)[1], (Vector2{2.0f, 1.0f}));
+}
+
+void MeshDataTest::constructNotIndexed() {
+    const MeshData data{MeshPrimitive::Lines, interleavedData(),
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vertex)}},
+        3};
+
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_COMPARE(data.indexCount(), 0);
+    CORRADE_VERIFY(data.indexData().empty());
+    CORRADE_COMPARE(data.attribute<Vector3>(0)[2], (Vector3{7.0f, 8.0f, 9.0f}));
+}
+
+void MeshDataTest::constructMove() {
+    MeshData a{MeshPrimitive::Triangles, interleavedData(),
+        MeshIndexType::UnsignedInt, sizeof(Vertices), 6,
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vertex)}},
+        3};
+    const char* const pointer = a.data().data();
+
+    MeshData b{std::move(a)};
+    CORRADE_COMPARE(b.data().data(), pointer);
+    CORRADE_COMPARE(b.indexCount(), 6);
+    CORRADE_COMPARE(b.attributeCount(), 1);
+
+    MeshData c{MeshPrimitive::Points, nullptr, {}, 0};
+    c = std::move(b);
+    CORRADE_COMPARE(c.data().data(), pointer);
+    CORRADE_COMPARE(c.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(c.vertexCount(), 3);
+}
+
+void MeshDataTest::indices8() {
+    Containers::Array<char> storage{Containers::ValueInit, sizeof(Vector3) + 4};
+    const UnsignedByte indices[]{0, 0, 0, 0};
+    std::memcpy(storage + sizeof(Vector3), indices, sizeof(indices));
+
+    const MeshData data{MeshPrimitive::Points, std::move(storage),
+        MeshIndexType::UnsignedByte, sizeof(Vector3), 4,
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vector3)}},
+        1};
+    CORRADE_COMPARE(data.indexData().size(), 4);
+    CORRADE_COMPARE(data.indicesAsArray(), (std::vector<UnsignedInt>{0, 0, 0, 0}));
+}
+
+void MeshDataTest::indices16() {
+    Containers::Array<char> storage{sizeof(Vertices) + 6*sizeof(UnsignedShort)};
+    const UnsignedShort indices[]{1, 2, 0, 0, 1, 2};
+    std::memcpy(storage, Vertices, sizeof(Vertices));
+    std::memcpy(storage + sizeof(Vertices), indices, sizeof(indices));
+
+    const MeshData data{MeshPrimitive::Triangles, std::move(storage),
+        MeshIndexType::UnsignedShort, sizeof(Vertices), 6,
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vertex)}},
+        3};
+    CORRADE_COMPARE(data.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(data.indicesAsArray(), (std::vector<UnsignedInt>{1, 2, 0, 0, 1, 2}));
+}
+
+void MeshDataTest::release() {
+    MeshData data{MeshPrimitive::Triangles, interleavedData(),
+        MeshIndexType::UnsignedInt, sizeof(Vertices), 6,
+        {MeshAttributeData{MeshAttributeName::Position, MeshAttributeType::Vector3, 0, sizeof(Vertex)}},
+        3};
+    const char* const pointer = data.data().data();
+
+    Containers::Array<char> released = data.release();
+    CORRADE_COMPARE(released.data(), pointer);
+    CORRADE_COMPARE(released.size(), sizeof(Vertices) + sizeof(Indices));
+    CORRADE_VERIFY(data.data().empty());
+}
+
+void MeshDataTest::typeSize() {
+    CORRADE_COMPARE(meshAttributeTypeSize(MeshAttributeType::Vector2), 8);
+    CORRADE_COMPARE(meshAttributeTypeSize(MeshAttributeType::Vector4), 16);
+    CORRADE_COMPARE(meshIndexTypeSize(MeshIndexType::UnsignedShort), 2);
+}
+
+void MeshDataTest::debugAttributeName() {
+    std::ostringstream o;
+    Debug(&o) << MeshAttributeName::TextureCoordinates;
+    CORRADE_COMPARE(o.str(), "Trade::MeshAttributeName::TextureCoordinates\n");
+}
+
+void MeshDataTest::debugAttributeType() {
+    std::ostringstream o;
+    Debug(&o) << MeshAttributeType::Vector3;
+    CORRADE_COMPARE(o.str(), "Trade::MeshAttributeType::Vector3\n");
+}
+
+void MeshDataTest::debugIndexType() {
+    std::ostringstream o;
+    Debug(&o) << MeshIndexType::UnsignedByte;
+    CORRADE_COMPARE(o.str(), "Trade::MeshIndexType::UnsignedByte\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshDataTest)
@@ -37,7 +37,17 @@ namespace Magnum { namespace Trade {
 class AbstractImageConverter;
 class AbstractImporter;
 class AbstractMaterialData;
+enum class AnimationInterpolation: UnsignedByte;
+enum class AnimationTrackTarget: UnsignedByte;
+enum class AnimationTrackType: UnsignedByte;
+class AnimationData;
+class AnimationTrackData;
+template<class> class AnimationTrackView;
+template<class> class AsyncImport;
+class AsyncImportHandle;
+class AsyncImporter;
 class CameraData;
+class FlatSceneData3D;
 
 template<UnsignedInt> class ImageData;
 typedef ImageData<1> ImageData1D;
@@ -45,6 +55,12 @@ typedef ImageData<2> ImageData2D;
 typedef ImageData<3> ImageData3D;
 
 class LightData;
+enum class MeshAttributeName: UnsignedByte;
+enum class MeshAttributeType: UnsignedByte;
+enum class MeshIndexType: UnsignedByte;
+class MeshAttributeData;
+template<class> class MeshAttributeView;
+class MeshData;
 class MeshData2D;
 class MeshData3D;
 class MeshObjectData2D;
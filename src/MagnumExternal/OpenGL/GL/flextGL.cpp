@@ -25,6 +25,9 @@ FLEXTGL_EXPORT void(APIENTRY *flextglVertexAttribL1ui64vARB)(GLuint, const GLuin
 /* GL_ARB_compute_variable_group_size */
 FLEXTGL_EXPORT void(APIENTRY *flextglDispatchComputeGroupSizeARB)(GLuint, GLuint, GLuint, GLuint, GLuint, GLuint) = nullptr;
 
+/* GL_ARB_gl_spirv */
+FLEXTGL_EXPORT void(APIENTRY *flextglSpecializeShaderARB)(GLuint, const GLchar *, GLuint, const GLuint *, const GLuint *) = nullptr;
+
 /* GL_ARB_indirect_parameters */
 FLEXTGL_EXPORT void(APIENTRY *flextglMultiDrawArraysIndirectCountARB)(GLenum, GLintptr, GLintptr, GLsizei, GLsizei) = nullptr;
 FLEXTGL_EXPORT void(APIENTRY *flextglMultiDrawElementsIndirectCountARB)(GLenum, GLenum, GLintptr, GLintptr, GLsizei, GLsizei) = nullptr;
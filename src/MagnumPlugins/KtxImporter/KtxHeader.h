@@ -0,0 +1,60 @@
+#ifndef Magnum_Trade_KtxHeader_h
+#define Magnum_Trade_KtxHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Struct @ref Magnum::Trade::KtxHeader
+ */
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace Trade {
+
+/** @brief KTX file header */
+/** @todoc Enable @c INLINE_SIMPLE_STRUCTS again when unclosed &lt;component&gt; in tagfile is fixed*/
+struct KtxHeader {
+    char            identifier[12];         /**< @brief File identifier */
+    UnsignedInt     endianness;             /**< @brief `0x04030201` in file endianness */
+    UnsignedInt     glType;                 /**< @brief Pixel type, 0 for compressed data */
+    UnsignedInt     glTypeSize;             /**< @brief Size of pixel type in bytes for endianness conversion */
+    UnsignedInt     glFormat;               /**< @brief Pixel format, 0 for compressed data */
+    UnsignedInt     glInternalFormat;       /**< @brief Texture or compressed pixel format */
+    UnsignedInt     glBaseInternalFormat;   /**< @brief Base internal format */
+    UnsignedInt     pixelWidth;             /**< @brief Image width */
+    UnsignedInt     pixelHeight;            /**< @brief Image height, 0 for 1D images */
+    UnsignedInt     pixelDepth;             /**< @brief Image depth, 0 for 1D and 2D images */
+    UnsignedInt     numberOfArrayElements;  /**< @brief Array element count, 0 for non-array images */
+    UnsignedInt     numberOfFaces;          /**< @brief Face count, 6 for cube maps, 1 otherwise */
+    UnsignedInt     numberOfMipmapLevels;   /**< @brief Mip level count, 0 if the mip levels should be generated */
+    UnsignedInt     bytesOfKeyValueData;    /**< @brief Size of key/value data following the header */
+};
+
+static_assert(sizeof(KtxHeader) == 64, "KtxHeader size is not 64 bytes");
+
+}}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "KtxImporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/mapFile.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/KtxImporter/KtxHeader.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+constexpr char KtxIdentifier[12]{'\xab', 'K', 'T', 'X', ' ', '1', '1', '\xbb', '\r', '\n', '\x1a', '\n'};
+
+}
+
+KtxImporter::KtxImporter() = default;
+
+KtxImporter::KtxImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter{manager, std::move(plugin)} {}
+
+KtxImporter::~KtxImporter() = default;
+
+auto KtxImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+bool KtxImporter::doIsOpened() const { return !_levels.empty(); }
+
+void KtxImporter::doClose() {
+    _in = nullptr;
+    _filename.clear();
+    _levels.clear();
+}
+
+bool KtxImporter::parse(const Containers::ArrayView<const char> data, const char* const prefix) {
+    if(data.size() < sizeof(KtxHeader)) {
+        Error() << prefix << "the file is too short:" << data.size() << "bytes";
+        return false;
+    }
+
+    const KtxHeader& header = *reinterpret_cast<const KtxHeader*>(data.data());
+    if(!std::equal(header.identifier, header.identifier + sizeof(KtxIdentifier), KtxIdentifier)) {
+        Error() << prefix << "invalid file identifier";
+        return false;
+    }
+
+    if(header.endianness != 0x04030201) {
+        Error() << prefix << "files with different endianness are not supported";
+        return false;
+    }
+
+    if(!header.pixelWidth || !header.pixelHeight || header.pixelDepth || header.numberOfArrayElements || header.numberOfFaces != 1) {
+        Error() << prefix << "only 2D images are supported";
+        return false;
+    }
+
+    /* Uncompressed data have the pixel type specified */
+    if(header.glType) {
+        _format = header.glFormat;
+        _type = header.glType;
+    } else {
+        _format = header.glInternalFormat;
+        _type = 0;
+    }
+
+    /* Each level is prefixed with its size and padded to four bytes. Zero
+       level count means the levels should be generated, only the base level
+       is present in that case. */
+    const UnsignedInt levelCount = std::max(header.numberOfMipmapLevels, 1u);
+    const Vector2i size{Int(header.pixelWidth), Int(header.pixelHeight)};
+    std::size_t offset = sizeof(KtxHeader) + header.bytesOfKeyValueData;
+    std::vector<Level> levels;
+    levels.reserve(levelCount);
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        UnsignedInt dataSize;
+        if(data.size() < offset + sizeof(dataSize)) {
+            Error() << prefix << "the file is too short for level" << i;
+            return false;
+        }
+        std::memcpy(&dataSize, data + offset, sizeof(dataSize));
+        offset += sizeof(dataSize);
+
+        if(data.size() < offset + dataSize) {
+            Error() << prefix << "level" << i << "data of" << dataSize << "bytes are truncated";
+            return false;
+        }
+
+        levels.push_back({offset, dataSize, Math::max(size >> Int(i), Vector2i{1})});
+        offset += (dataSize + 3)/4*4;
+    }
+
+    _levels = std::move(levels);
+    return true;
+}
+
+void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    if(!parse(data, "Trade::KtxImporter::openData():")) return;
+
+    _in = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), _in.begin());
+}
+
+void KtxImporter::doOpenFile(const std::string& filename) {
+    /* If the file can be mapped, parse the header and level list and
+       remember the filename only, each level is then mapped again in
+       image2D() so the returned image can take the ownership of it */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(const Containers::Array<const char> mapped = Magnum::Implementation::mapFile(filename)) {
+        if(parse(mapped, "Trade::KtxImporter::openFile():")) _filename = filename;
+        return;
+    }
+    #endif
+
+    /* Otherwise read the file into memory */
+    AbstractImporter::doOpenFile(filename);
+}
+
+UnsignedInt KtxImporter::doImage2DCount() const { return _levels.size(); }
+
+std::optional<ImageData2D> KtxImporter::doImage2D(const UnsignedInt id) {
+    const Level& level = _levels[id];
+
+    /* Reference the mapped level directly, copy otherwise */
+    Containers::Array<char> data;
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(!_filename.empty() && level.dataSize) {
+        if(!(data = Magnum::Implementation::mapFileWritable(_filename, level.offset, level.dataSize))) {
+            Error() << "Trade::KtxImporter::image2D(): cannot map file" << _filename;
+            return std::nullopt;
+        }
+    } else
+    #endif
+    {
+        data = allocate(level.dataSize);
+        std::copy_n(_in + level.offset, level.dataSize, data.begin());
+    }
+
+    if(!_type)
+        return ImageData2D{CompressedPixelFormat(_format), level.size, std::move(data)};
+    return ImageData2D{PixelFormat(_format), PixelType(_type), level.size, std::move(data)};
+}
+
+}}
@@ -0,0 +1,128 @@
+#ifndef Magnum_Trade_KtxImporter_h
+#define Magnum_Trade_KtxImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::KtxImporter
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/KtxImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_KTXIMPORTER_BUILD_STATIC
+    #if defined(KtxImporter_EXPORTS) || defined(KtxImporterObjects_EXPORTS)
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_KTXIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief KTX importer plugin
+
+Supports 2D images in [KTX](https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/)
+version 1.1 files, both uncompressed and compressed in any format supported by
+OpenGL, such as S3TC, ETC2 or ASTC. Array, cube map and 3D images aren't
+supported, files with different endianness than the platform aren't
+supported either.
+
+This plugin is built if `WITH_KTXIMPORTER` is enabled when building Magnum. To
+use dynamic plugin, you need to load `KtxImporter` plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a dependency
+of another plugin, you need to request `KtxImporter` component of `Magnum`
+package in CMake and link to `Magnum::KtxImporter` target. See @ref building,
+@ref cmake and @ref plugins for more information.
+
+Each mip level in the file is imported as a separate image, image with ID `0`
+being the base level. Compressed images are imported with
+@ref CompressedPixelFormat equal to `glInternalFormat` from the file, the
+data can be uploaded directly to a texture without any conversion:
+@code
+Texture2D texture;
+texture.setStorage(importer.image2DCount(), TextureFormat(format), size);
+for(UnsignedInt level = 0; level != importer.image2DCount(); ++level) {
+    std::optional<Trade::ImageData2D> image = importer.image2D(level);
+    texture.setCompressedSubImage(level, {}, *image);
+}
+@endcode
+
+Uncompressed images are imported with @ref PixelFormat and @ref PixelType
+equal to `glFormat` and `glType` from the file and with default
+@ref PixelStorage parameters, as the KTX format pads the rows to four bytes.
+
+On Unix systems, files opened with @ref openFile() are memory-mapped instead
+of being read into memory. Only the mip level list is parsed when opening the
+file, each call to @ref image2D() then maps just the pages containing given
+mip level and the returned image data reference them directly.
+*/
+class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit KtxImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit KtxImporter(PluginManager::AbstractManager& manager, std::string plugin);
+
+        ~KtxImporter();
+
+    private:
+        struct Level {
+            std::size_t offset, dataSize;
+            Vector2i size;
+        };
+
+        Features MAGNUM_KTXIMPORTER_LOCAL doFeatures() const override;
+        bool MAGNUM_KTXIMPORTER_LOCAL doIsOpened() const override;
+        void MAGNUM_KTXIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_KTXIMPORTER_LOCAL doOpenFile(const std::string& filename) override;
+        void MAGNUM_KTXIMPORTER_LOCAL doClose() override;
+        UnsignedInt MAGNUM_KTXIMPORTER_LOCAL doImage2DCount() const override;
+        std::optional<ImageData2D> MAGNUM_KTXIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
+
+        bool MAGNUM_KTXIMPORTER_LOCAL parse(Containers::ArrayView<const char> data, const char* prefix);
+
+        Containers::Array<char> _in;
+        std::string _filename;
+        UnsignedInt _format, _type;
+        std::vector<Level> _levels;
+};
+
+}}
+
+#endif
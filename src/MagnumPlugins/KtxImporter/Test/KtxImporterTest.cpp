@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/KtxImporter/KtxHeader.h"
+#include "MagnumPlugins/KtxImporter/KtxImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class KtxImporterTest: public TestSuite::Tester {
+    public:
+        KtxImporterTest();
+
+        void openShort();
+        void invalidIdentifier();
+        void differentEndianness();
+        void cubeMap();
+        void levelTruncated();
+
+        void compressed();
+        void uncompressed();
+        void keyValueData();
+
+        void openFile();
+};
+
+KtxImporterTest::KtxImporterTest() {
+    addTests({&KtxImporterTest::openShort,
+              &KtxImporterTest::invalidIdentifier,
+              &KtxImporterTest::differentEndianness,
+              &KtxImporterTest::cubeMap,
+              &KtxImporterTest::levelTruncated,
+
+              &KtxImporterTest::compressed,
+              &KtxImporterTest::uncompressed,
+              &KtxImporterTest::keyValueData,
+
+              &KtxImporterTest::openFile});
+}
+
+namespace {
+
+KtxHeader header(UnsignedInt glType, UnsignedInt glFormat, UnsignedInt glInternalFormat, const Vector2i& size, UnsignedInt levelCount) {
+    return {{'\xab', 'K', 'T', 'X', ' ', '1', '1', '\xbb', '\r', '\n', '\x1a', '\n'},
+        0x04030201, glType, glType ? 1u : 0u, glFormat, glInternalFormat, GL_RGBA,
+        UnsignedInt(size.x()), UnsignedInt(size.y()), 0, 0, 1, levelCount, 0};
+}
+
+std::vector<char> file(const KtxHeader& header, std::initializer_list<std::vector<char>> levels) {
+    std::vector<char> out(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header + 1));
+    for(const std::vector<char>& level: levels) {
+        const UnsignedInt size = level.size();
+        out.insert(out.end(), reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size + 1));
+        out.insert(out.end(), level.begin(), level.end());
+        out.resize((out.size() + 3)/4*4);
+    }
+    return out;
+}
+
+}
+
+void KtxImporterTest::openShort() {
+    KtxImporter importer;
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    const char data[32]{};
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(debug.str(), "Trade::KtxImporter::openData(): the file is too short: 32 bytes\n");
+}
+
+void KtxImporterTest::invalidIdentifier() {
+    KtxImporter importer;
+    KtxHeader h = header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {4, 4}, 1);
+    h.identifier[5] = '2';
+    const std::vector<char> data = file(h, {std::vector<char>(8)});
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::KtxImporter::openData(): invalid file identifier\n");
+}
+
+void KtxImporterTest::differentEndianness() {
+    KtxImporter importer;
+    KtxHeader h = header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {4, 4}, 1);
+    h.endianness = 0x01020304;
+    const std::vector<char> data = file(h, {std::vector<char>(8)});
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::KtxImporter::openData(): files with different endianness are not supported\n");
+}
+
+void KtxImporterTest::cubeMap() {
+    KtxImporter importer;
+    KtxHeader h = header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {4, 4}, 1);
+    h.numberOfFaces = 6;
+    const std::vector<char> data = file(h, {std::vector<char>(48)});
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::KtxImporter::openData(): only 2D images are supported\n");
+}
+
+void KtxImporterTest::levelTruncated() {
+    KtxImporter importer;
+    std::vector<char> data = file(header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {8, 8}, 2), {std::vector<char>(32), std::vector<char>(8)});
+    data.resize(data.size() - 1);
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::KtxImporter::openData(): level 1 data of 8 bytes are truncated\n");
+}
+
+void KtxImporterTest::compressed() {
+    KtxImporter importer;
+    const std::vector<char> level0{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const std::vector<char> level1{17, 18, 19, 20, 21, 22, 23, 24};
+    const std::vector<char> data = file(header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {8, 4}, 2), {level0, level1});
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(importer.image2DCount(), 2);
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBAS3tcDxt1);
+    CORRADE_COMPARE(image->size(), (Vector2i{8, 4}));
+    CORRADE_COMPARE_AS(image->data(), (Containers::ArrayView<const char>{level0.data(), level0.size()}),
+        TestSuite::Compare::Container);
+
+    image = importer.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE_AS(image->data(), (Containers::ArrayView<const char>{level1.data(), level1.size()}),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::uncompressed() {
+    KtxImporter importer;
+    const std::vector<char> level0{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const std::vector<char> data = file(header(GL_UNSIGNED_BYTE, GL_RGBA, GL_RGBA8, {2, 2}, 1), {level0});
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(importer.image2DCount(), 1);
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(image->data(), (Containers::ArrayView<const char>{level0.data(), level0.size()}),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::keyValueData() {
+    KtxImporter importer;
+    KtxHeader h = header(0, 0, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, {4, 4}, 0);
+    h.bytesOfKeyValueData = 8;
+    std::vector<char> data = file(h, {});
+    const std::vector<char> level{4, 0, 0, 0, 'a', 'b', 'c', 0,
+        8, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8};
+    data.insert(data.end(), level.begin(), level.end());
+
+    /* Zero level count means just the base level is present */
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(importer.image2DCount(), 1);
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i{4});
+    CORRADE_COMPARE_AS(image->data(), (Containers::ArrayView<const char>{level.data() + 12, 8}),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::openFile() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx")));
+    CORRADE_COMPARE(importer.image2DCount(), 3);
+
+    /* Verify that each level can be imported repeatedly */
+    for(UnsignedInt i: {2, 0, 1, 2}) {
+        std::optional<Trade::ImageData2D> image = importer.image2D(i);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBAS3tcDxt1);
+        CORRADE_COMPARE(image->size(), Vector2i{4 >> i});
+        CORRADE_COMPARE(image->data().size(), 8);
+        CORRADE_COMPARE(image->data()[0], char(i*16));
+        CORRADE_COMPARE(image->data()[7], char(i*16 + 7));
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::KtxImporterTest)
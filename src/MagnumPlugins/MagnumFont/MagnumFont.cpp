@@ -26,36 +26,68 @@
 #include "MagnumFont.h"
 
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
 
+#include "Magnum/Implementation/mapFile.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontHeader.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MAGNUMFONT_USE_SSE2
+#endif
+
 namespace Magnum { namespace Text {
 
 struct MagnumFont::Data {
-    Utility::Configuration conf;
+    explicit Data(Trade::ImageData2D&& image): image{std::move(image)} {}
+
     Trade::ImageData2D image;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
-    std::vector<Vector2> glyphAdvance;
+    Vector2i originalImageSize, padding;
+
+    /* Either the (memory-mapped) binary metrics file or metrics converted
+       from the configuration file, the pointers below point into one of
+       them */
+    Containers::Array<const char> binary;
+    std::vector<MagnumFontGlyph> glyphStorage;
+    std::vector<MagnumFontCharRange> rangeStorage;
+    std::vector<UnsignedInt> glyphIdStorage;
+
+    const MagnumFontGlyph* glyphs;
+    std::size_t glyphCount;
+    const MagnumFontCharRange* ranges;
+    std::size_t rangeCount;
+    const UnsignedInt* glyphIds;
+
+    /* Built from the ranges on open, shared by all layouters */
+    Implementation::MagnumFontGlyphTable glyphTable;
 };
 
 namespace {
     class MagnumFontLayouter: public AbstractLayouter {
         public:
-            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const GlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+            explicit MagnumFontLayouter(const MagnumFontGlyph* glyphData, const GlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+
+            /* Replaces the laid out text, reusing the glyph array */
+            template<class T> void layout(const Implementation::MagnumFontGlyphTable& glyphTable, const GlyphCache& cache, Float textSize, const T& text);
 
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
 
-            const std::vector<Vector2>& glyphAdvance;
-            const GlyphCache& cache;
-            const Float fontSize, textSize;
-            const std::vector<UnsignedInt> glyphs;
+            const MagnumFontGlyph* glyphData;
+            const GlyphCache* cache;
+            const Float fontSize;
+            Float textSize;
+            std::vector<UnsignedInt> glyphs;
     };
+
+    bool isBinary(const Containers::ArrayView<const char> data) {
+        return data.size() >= sizeof(MagnumFontIdentifier) && std::equal(MagnumFontIdentifier, MagnumFontIdentifier + sizeof(MagnumFontIdentifier), data.data());
+    }
 }
 
 MagnumFont::MagnumFont(): _opened(nullptr) {}
@@ -68,32 +100,110 @@ auto MagnumFont::doFeatures() const -> Features { return Feature::OpenData|Featu
 
 bool MagnumFont::doIsOpened() const { return _opened; }
 
+namespace {
+
+/* Validates the binary metrics file upfront, so the lookups can't go out of
+   bounds later */
+bool checkBinary(const Containers::ArrayView<const char> data, const char* const prefix) {
+    if(data.size() < sizeof(MagnumFontHeader)) {
+        Error() << prefix << "the file is too short:" << data.size() << "bytes";
+        return false;
+    }
+
+    const MagnumFontHeader& header = *reinterpret_cast<const MagnumFontHeader*>(data.data());
+    if(header.endianness != 0x04030201) {
+        Error() << prefix << "files with different endianness are not supported";
+        return false;
+    }
+
+    if(header.version != MagnumFontVersion) {
+        Error() << prefix << "unsupported binary version" << header.version << Debug::nospace << ", expected" << MagnumFontVersion;
+        return false;
+    }
+
+    if(header.glyphOffset % MagnumFontAlignment || header.rangeOffset % MagnumFontAlignment || header.charOffset % MagnumFontAlignment) {
+        Error() << prefix << "misaligned data";
+        return false;
+    }
+
+    if(data.size() < header.glyphOffset + header.glyphCount*sizeof(MagnumFontGlyph) ||
+       data.size() < header.rangeOffset + header.rangeCount*sizeof(MagnumFontCharRange) ||
+       data.size() < header.charOffset + header.charCount*sizeof(UnsignedInt) ||
+       data.size() < header.imageFilenameOffset + header.imageFilenameSize) {
+        Error() << prefix << "the file is too short for" << header.glyphCount << "glyphs and" << header.rangeCount << "character ranges";
+        return false;
+    }
+
+    const auto* const ranges = reinterpret_cast<const MagnumFontCharRange*>(data.data() + header.rangeOffset);
+    for(std::size_t i = 0; i != header.rangeCount; ++i) {
+        if(std::size_t(ranges[i].charOffset) + ranges[i].count > header.charCount || (i && ranges[i].first < ranges[i - 1].first + ranges[i - 1].count)) {
+            Error() << prefix << "invalid character range" << i;
+            return false;
+        }
+    }
+
+    const auto* const glyphIds = reinterpret_cast<const UnsignedInt*>(data.data() + header.charOffset);
+    for(std::size_t i = 0; i != header.charCount; ++i) {
+        if(glyphIds[i] >= header.glyphCount) {
+            Error() << prefix << "glyph ID" << glyphIds[i] << "out of bounds for" << header.glyphCount << "glyphs";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string binaryImageFilename(const Containers::ArrayView<const char> data) {
+    const MagnumFontHeader& header = *reinterpret_cast<const MagnumFontHeader*>(data.data());
+    return {data.data() + header.imageFilenameOffset, header.imageFilenameSize};
+}
+
+}
+
 auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data, const Float) -> Metrics {
-    /* We need just the configuration file and image file */
+    /* We need just the metrics file and image file */
     if(data.size() != 2) {
         Error() << "Text::MagnumFont::openData(): wanted two files, got" << data.size();
         return {};
     }
 
-    /* Open the configuration file */
-    std::istringstream in({data[0].second.begin(), data[0].second.size()});
-    Utility::Configuration conf(in, Utility::Configuration::Flag::SkipComments);
-    if(!conf.isValid() || conf.isEmpty()) {
-        Error() << "Text::MagnumFont::openData(): cannot open file" << data[0].first;
-        return {};
-    }
-
-    /* Check version */
-    if(conf.value<UnsignedInt>("version") != 1) {
-        Error() << "Text::MagnumFont::openData(): unsupported file version, expected 1 but got"
-                << conf.value<UnsignedInt>("version");
-        return {};
+    /* Binary metrics file. The data are not owned by us, so copy them. */
+    const bool binary = isBinary(data[0].second);
+    Containers::Array<const char> binaryData;
+    std::optional<Utility::Configuration> conf;
+    std::string imageFilename;
+    if(binary) {
+        if(!checkBinary(data[0].second, "Text::MagnumFont::openData():"))
+            return {};
+
+        char* const copy = new char[data[0].second.size()];
+        std::copy(data[0].second.begin(), data[0].second.end(), copy);
+        binaryData = Containers::Array<const char>{copy, data[0].second.size()};
+        imageFilename = binaryImageFilename(binaryData);
+
+    /* Configuration file */
+    } else {
+        std::istringstream in({data[0].second.begin(), data[0].second.size()});
+        conf.emplace(in, Utility::Configuration::Flag::SkipComments);
+        if(!conf->isValid() || conf->isEmpty()) {
+            Error() << "Text::MagnumFont::openData(): cannot open file" << data[0].first;
+            return {};
+        }
+
+        /* Check version */
+        if(conf->value<UnsignedInt>("version") != 1) {
+            Error() << "Text::MagnumFont::openData(): unsupported file version, expected 1 but got"
+                    << conf->value<UnsignedInt>("version");
+            return {};
+        }
+
+        imageFilename = conf->value("image");
     }
 
     /* Check that we have also the image file */
-    if(conf.value("image") != data[1].first) {
+    if(imageFilename != data[1].first) {
         Error() << "Text::MagnumFont::openData(): expected file"
-                << conf.value("image") << "but got" << data[1].first;
+                << imageFilename << "but got" << data[1].first;
         return {};
     }
 
@@ -109,26 +219,54 @@ auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers:
         return {};
     }
 
-    return openInternal(std::move(conf), std::move(*image));
+    if(binary) return openBinaryInternal(std::move(binaryData), std::move(*image));
+    return openInternal(std::move(*conf), std::move(*image));
 }
 
 auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
-    /* Open the configuration file */
-    Utility::Configuration conf(filename, Utility::Configuration::Flag::ReadOnly|Utility::Configuration::Flag::SkipComments);
-    if(!conf.isValid() || conf.isEmpty()) {
-        Error() << "Text::MagnumFont::openFile(): cannot open file" << filename << conf.isValid();
-        return {};
+    /* Binary metrics file is memory-mapped, if possible */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    Containers::Array<const char> binaryData = Magnum::Implementation::mapFile(filename);
+    #else
+    /* The read data use the default deleter, so the ownership can be just
+       transferred to a const array */
+    Containers::Array<const char> binaryData;
+    if(Utility::Directory::fileExists(filename)) {
+        Containers::Array<char> read = Utility::Directory::read(filename);
+        const std::size_t size = read.size();
+        binaryData = Containers::Array<const char>{read.release(), size};
     }
-
-    /* Check version */
-    if(conf.value<UnsignedInt>("version") != 1) {
-        Error() << "Text::MagnumFont::openFile(): unsupported file version, expected 1 but got"
-                << conf.value<UnsignedInt>("version");
-        return {};
+    #endif
+    const bool binary = isBinary(binaryData);
+    std::optional<Utility::Configuration> conf;
+    std::string imageFilename;
+    if(binary) {
+        if(!checkBinary(binaryData, "Text::MagnumFont::openFile():"))
+            return {};
+
+        imageFilename = binaryImageFilename(binaryData);
+
+    /* Configuration file */
+    } else {
+        binaryData = nullptr;
+        conf.emplace(filename, Utility::Configuration::Flag::ReadOnly|Utility::Configuration::Flag::SkipComments);
+        if(!conf->isValid() || conf->isEmpty()) {
+            Error() << "Text::MagnumFont::openFile(): cannot open file" << filename << conf->isValid();
+            return {};
+        }
+
+        /* Check version */
+        if(conf->value<UnsignedInt>("version") != 1) {
+            Error() << "Text::MagnumFont::openFile(): unsupported file version, expected 1 but got"
+                    << conf->value<UnsignedInt>("version");
+            return {};
+        }
+
+        imageFilename = conf->value("image");
     }
 
     /* Open and load image file */
-    const std::string imageFilename = Utility::Directory::join(Utility::Directory::path(filename), conf.value("image"));
+    imageFilename = Utility::Directory::join(Utility::Directory::path(filename), imageFilename);
     Trade::TgaImporter importer;
     if(!importer.openFile(imageFilename)) {
         Error() << "Text::MagnumFont::openFile(): cannot open image file" << imageFilename;
@@ -140,31 +278,63 @@ auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
         return {};
     }
 
-    return openInternal(std::move(conf), std::move(*image));
+    if(binary) return openBinaryInternal(std::move(binaryData), std::move(*image));
+    return openInternal(std::move(*conf), std::move(*image));
 }
 
 auto MagnumFont::openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image) -> Metrics {
     /* Everything okay, save the data internally */
-    _opened = new Data{std::move(conf), std::move(image), std::unordered_map<char32_t, UnsignedInt>{}, {}};
+    _opened = new Data{std::move(image)};
+    _opened->originalImageSize = conf.value<Vector2i>("originalImageSize");
+    _opened->padding = conf.value<Vector2i>("padding");
 
-    /* Glyph advances */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    _opened->glyphAdvance.reserve(glyphs.size());
+    /* Glyph properties */
+    const std::vector<Utility::ConfigurationGroup*> glyphs = conf.groups("glyph");
+    _opened->glyphStorage.reserve(glyphs.size());
     for(const Utility::ConfigurationGroup* const g: glyphs)
-        _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
+        _opened->glyphStorage.push_back({g->value<Vector2>("advance"), g->value<Vector2i>("position"), g->value<Range2Di>("rectangle")});
 
-    /* Fill character->glyph map */
-    const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
+    /* Convert the character->glyph map to the same ranges as in the binary
+       file */
+    const std::vector<Utility::ConfigurationGroup*> chars = conf.groups("char");
+    std::vector<std::pair<char32_t, UnsignedInt>> characters;
+    characters.reserve(chars.size());
     for(const Utility::ConfigurationGroup* const c: chars) {
         const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
-        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphAdvance.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
+        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphStorage.size());
+        characters.emplace_back(c->value<char32_t>("unicode"), glyphId);
     }
+    Implementation::magnumFontCharRanges(std::move(characters), _opened->rangeStorage, _opened->glyphIdStorage);
+
+    _opened->glyphs = _opened->glyphStorage.data();
+    _opened->glyphCount = _opened->glyphStorage.size();
+    _opened->ranges = _opened->rangeStorage.data();
+    _opened->rangeCount = _opened->rangeStorage.size();
+    _opened->glyphIds = _opened->glyphIdStorage.data();
+    Implementation::magnumFontGlyphTable(_opened->ranges, _opened->rangeCount, _opened->glyphIds, _opened->glyphTable);
+
+    return {conf.value<Float>("fontSize"),
+            conf.value<Float>("ascent"),
+            conf.value<Float>("descent"),
+            conf.value<Float>("lineHeight")};
+}
 
-    return {_opened->conf.value<Float>("fontSize"),
-            _opened->conf.value<Float>("ascent"),
-            _opened->conf.value<Float>("descent"),
-            _opened->conf.value<Float>("lineHeight")};
+auto MagnumFont::openBinaryInternal(Containers::Array<const char>&& data, Trade::ImageData2D&& image) -> Metrics {
+    /* The data are already validated, just point into them */
+    _opened = new Data{std::move(image)};
+    _opened->binary = std::move(data);
+
+    const MagnumFontHeader& header = *reinterpret_cast<const MagnumFontHeader*>(_opened->binary.data());
+    _opened->originalImageSize = header.originalImageSize;
+    _opened->padding = header.padding;
+    _opened->glyphs = reinterpret_cast<const MagnumFontGlyph*>(_opened->binary.data() + header.glyphOffset);
+    _opened->glyphCount = header.glyphCount;
+    _opened->ranges = reinterpret_cast<const MagnumFontCharRange*>(_opened->binary.data() + header.rangeOffset);
+    _opened->rangeCount = header.rangeCount;
+    _opened->glyphIds = reinterpret_cast<const UnsignedInt*>(_opened->binary.data() + header.charOffset);
+    Implementation::magnumFontGlyphTable(_opened->ranges, _opened->rangeCount, _opened->glyphIds, _opened->glyphTable);
+
+    return {header.fontSize, header.ascent, header.descent, header.lineHeight};
 }
 
 void MagnumFont::doClose() {
@@ -173,63 +343,100 @@ void MagnumFont::doClose() {
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    return _opened->glyphTable(character);
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
-    return glyph < _opened->glyphAdvance.size() ? _opened->glyphAdvance[glyph] : Vector2();
+    return glyph < _opened->glyphCount ? _opened->glyphs[glyph].advance : Vector2();
 }
 
 std::unique_ptr<GlyphCache> MagnumFont::doCreateGlyphCache() {
     /* Set cache image */
     std::unique_ptr<GlyphCache> cache(new Text::GlyphCache(
-        _opened->conf.value<Vector2i>("originalImageSize"),
+        _opened->originalImageSize,
         _opened->image.size(),
-        _opened->conf.value<Vector2i>("padding")));
+        _opened->padding));
     cache->setImage({}, _opened->image);
 
     /* Fill glyph map */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    for(std::size_t i = 0; i != glyphs.size(); ++i)
-        cache->insert(i, glyphs[i]->value<Vector2i>("position"), glyphs[i]->value<Range2Di>("rectangle"));
+    for(std::size_t i = 0; i != _opened->glyphCount; ++i)
+        cache->insert(i, _opened->glyphs[i].position, _opened->glyphs[i].rectangle);
 
     return cache;
 }
 
 std::unique_ptr<AbstractLayouter> MagnumFont::doLayout(const GlyphCache& cache, Float size, const std::string& text) {
-    /* Get glyph codes from characters */
-    std::vector<UnsignedInt> glyphs;
-    glyphs.reserve(text.size());
-    for(std::size_t i = 0; i != text.size(); ) {
-        UnsignedInt codepoint;
-        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
-    }
+    std::unique_ptr<MagnumFontLayouter> layouter{new MagnumFontLayouter(_opened->glyphs, cache, this->size(), size, {})};
+    layouter->layout(_opened->glyphTable, cache, size, text);
+    return std::move(layouter);
+}
 
-    return std::unique_ptr<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
+std::unique_ptr<AbstractLayouter> MagnumFont::doLayoutInto(const GlyphCache& cache, Float size, const Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter> layouter) {
+    /* The layouter, if any, was created by this font, so it's ours */
+    if(!layouter) layouter.reset(new MagnumFontLayouter(_opened->glyphs, cache, this->size(), size, {}));
+    static_cast<MagnumFontLayouter&>(*layouter).layout(_opened->glyphTable, cache, size, text);
+    return layouter;
 }
 
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const GlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const MagnumFontGlyph* const glyphData, const GlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphData(glyphData), cache(&cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+
+template<class T> void MagnumFontLayouter::layout(const Implementation::MagnumFontGlyphTable& glyphTable, const GlyphCache& cache, const Float textSize, const T& text) {
+    this->cache = &cache;
+    this->textSize = textSize;
+
+    /* Get glyph codes from characters. There's at most one glyph per byte,
+       the capacity is kept from previous layouts, so this allocates only if
+       the text is longer than before. */
+    const char* const data = text.data();
+    const std::size_t size = text.size();
+    glyphs.resize(size);
+    UnsignedInt* out = glyphs.data();
+    for(std::size_t i = 0; i != size; ) {
+        #ifdef MAGNUM_MAGNUMFONT_USE_SSE2
+        /* If the next sixteen bytes are all ASCII, look them up without
+           decoding */
+        if(size - i >= 16 && !_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)))) {
+            for(std::size_t j = 0; j != 16; ++j)
+                *out++ = glyphTable.latin1[UnsignedByte(data[i + j])];
+            i += 16;
+            continue;
+        }
+        #endif
+
+        /* Single ASCII character */
+        if(!(data[i] & 0x80)) {
+            *out++ = glyphTable.latin1[UnsignedByte(data[i])];
+            ++i;
+            continue;
+        }
+
+        /* Multi-byte sequence, invalid ones are mapped to glyph 0 */
+        UnsignedInt codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+        *out++ = glyphTable(codepoint);
+    }
+
+    glyphs.resize(out - glyphs.data());
+    setGlyphCount(glyphs.size());
+}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
     /* Position of the texture in the resulting glyph, texture coordinates */
     Vector2i position;
     Range2Di rectangle;
-    std::tie(position, rectangle) = cache[glyphs[i]];
+    std::tie(position, rectangle) = (*cache)[glyphs[i]];
 
     /* Normalized texture coordinates */
-    const auto textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(cache.textureSize()));
+    const auto textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(cache->textureSize()));
 
     /* Quad rectangle, computed from texture rectangle, denormalized to
        requested text size */
     const auto quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(textSize/fontSize));
 
     /* Advance for given glyph, denormalized to requested text size */
-    const Vector2 advance = glyphAdvance[glyphs[i]]*(textSize/fontSize);
+    const Vector2 advance = glyphData[glyphs[i]].advance*(textSize/fontSize);
 
     return std::make_tuple(quadRectangle, textureCoordinates, advance);
 }
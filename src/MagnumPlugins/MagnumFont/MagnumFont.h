@@ -101,6 +101,25 @@ The file syntax is as in following:
 
     # ...
 
+## Binary metrics file
+
+Instead of the text file, the font can use a binary metrics file, which is
+also written by MagnumFontConverter. Opening it doesn't involve any parsing
+--- on Unix systems the file is memory-mapped and the glyph properties and
+character map are used directly from the mapped memory. The file consists of
+a @ref MagnumFontHeader, followed by an array of @ref MagnumFontGlyph entries,
+an array of @ref MagnumFontCharRange entries sorted by first character and an
+array of glyph IDs referenced by the ranges. Consecutive characters are stored
+in the same range, so glyph ID lookup is a binary search over the ranges
+followed by direct indexing into the range. The binary file is recognized by
+its identifier, so it can be passed to @ref openFile() or as first file to
+@ref openData() in place of the text file:
+
+    magnum-fontconverter --font FreeTypeFont --converter MagnumFontConverter DejaVuSans.ttf font
+    # font.conf, font.bin and font.tga are created, font.bin can then be opened instead of font.conf
+
+The text file is converted to the same representation on opening.
+
 @see Trade::TgaImporter
 */
 class MagnumFont: public AbstractFont {
@@ -134,7 +153,10 @@ class MagnumFont: public AbstractFont {
 
         std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, Float size, const std::string& text) override;
 
+        std::unique_ptr<AbstractLayouter> doLayoutInto(const GlyphCache& cache, Float size, Containers::ArrayView<const char> text, std::unique_ptr<AbstractLayouter> layouter) override;
+
         Metrics openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image);
+        Metrics openBinaryInternal(Containers::Array<const char>&& data, Trade::ImageData2D&& image);
 
         Data* _opened;
 };
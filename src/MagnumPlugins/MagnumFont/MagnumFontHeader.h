@@ -0,0 +1,224 @@
+#ifndef Magnum_Text_MagnumFontHeader_h
+#define Magnum_Text_MagnumFontHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Text::MagnumFontHeader, @ref Magnum::Text::MagnumFontGlyph, @ref Magnum::Text::MagnumFontCharRange
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Binary MagnumFont metrics file header
+
+The header is followed by @ref MagnumFontHeader::glyphCount
+@ref MagnumFontGlyph entries at @ref MagnumFontHeader::glyphOffset,
+@ref MagnumFontHeader::rangeCount @ref MagnumFontCharRange entries sorted by
+@ref MagnumFontCharRange::first at @ref MagnumFontHeader::rangeOffset,
+@ref MagnumFontHeader::charCount glyph IDs (@ref UnsignedInt) at
+@ref MagnumFontHeader::charOffset and image filename (not null-terminated) at
+@ref MagnumFontHeader::imageFilenameOffset. All offsets are from file start
+and are aligned to @ref MagnumFontAlignment bytes.
+*/
+/** @todoc Enable @c INLINE_SIMPLE_STRUCTS again when unclosed &lt;component&gt; in tagfile is fixed*/
+struct MagnumFontHeader {
+    char            identifier[8];      /**< @brief File identifier */
+    UnsignedInt     version;            /**< @brief Format version */
+    UnsignedInt     endianness;         /**< @brief `0x04030201` in file endianness */
+    Float           fontSize;           /**< @brief Font size */
+    Float           ascent;             /**< @brief Font ascent */
+    Float           descent;            /**< @brief Font descent */
+    Float           lineHeight;         /**< @brief Line height */
+    Vector2i        originalImageSize;  /**< @brief Size of unscaled font image */
+    Vector2i        padding;            /**< @brief Glyph padding */
+    UnsignedInt     glyphCount;         /**< @brief Count of glyph entries */
+    UnsignedInt     rangeCount;         /**< @brief Count of character range entries */
+    UnsignedInt     charCount;          /**< @brief Count of glyph IDs referenced from character ranges */
+    UnsignedInt     imageFilenameSize;  /**< @brief Image filename length */
+    UnsignedLong    glyphOffset;        /**< @brief Offset of glyph entries */
+    UnsignedLong    rangeOffset;        /**< @brief Offset of character range entries */
+    UnsignedLong    charOffset;         /**< @brief Offset of glyph IDs */
+    UnsignedLong    imageFilenameOffset; /**< @brief Offset of image filename */
+};
+
+/**
+@brief Binary MagnumFont glyph entry
+
+Glyph ID is the index of the entry. The values have the same meaning as the
+`advance`, `position` and `rectangle` values in the configuration file, see
+@ref MagnumFont for more information.
+*/
+struct MagnumFontGlyph {
+    Vector2         advance;            /**< @brief Advance to next character */
+    Vector2i        position;           /**< @brief Glyph position relative to baseline */
+    Range2Di        rectangle;          /**< @brief Glyph rectangle in font image */
+};
+
+/**
+@brief Binary MagnumFont character range entry
+
+Characters in range @f$ [ first, first + count ) @f$ are mapped to glyph IDs
+at @ref charOffset + *character* - @ref first in the glyph ID array. Ranges
+don't overlap, characters that have no glyph inside a range are mapped to
+glyph `0`.
+*/
+struct MagnumFontCharRange {
+    UnsignedInt     first;              /**< @brief First character in the range */
+    UnsignedInt     count;              /**< @brief Count of characters in the range */
+    UnsignedInt     charOffset;         /**< @brief Index of first glyph ID of the range */
+    UnsignedInt     reserved;           /**< @brief Reserved, zero */
+};
+
+/** @brief Binary MagnumFont file identifier */
+constexpr char MagnumFontIdentifier[8]{'\x89', 'M', 'G', 'N', 'F', 'N', 'T', '\n'};
+
+/** @brief Current binary MagnumFont format version */
+constexpr UnsignedInt MagnumFontVersion = 1;
+
+/** @brief Alignment of binary MagnumFont sections */
+constexpr std::size_t MagnumFontAlignment = 8;
+
+/**
+@brief Max gap between characters in one range
+
+Characters which are closer to each other than this are put into the same
+range, filling the gap with glyph `0`, so common alphabets end up in a single
+range with direct lookup.
+*/
+constexpr UnsignedInt MagnumFontMaxCharRangeGap = 8;
+
+static_assert(sizeof(MagnumFontHeader) == 96, "MagnumFontHeader size is not 96 bytes");
+static_assert(sizeof(MagnumFontGlyph) == 32, "MagnumFontGlyph size is not 32 bytes");
+static_assert(sizeof(MagnumFontCharRange) == 16, "MagnumFontCharRange size is not 16 bytes");
+
+namespace Implementation {
+
+/* Creates sorted character ranges from a character -> glyph ID mapping. If
+   a character is there more than once, its first occurence wins. */
+inline void magnumFontCharRanges(std::vector<std::pair<char32_t, UnsignedInt>> characters, std::vector<MagnumFontCharRange>& ranges, std::vector<UnsignedInt>& glyphIds) {
+    std::stable_sort(characters.begin(), characters.end(), [](const std::pair<char32_t, UnsignedInt>& a, const std::pair<char32_t, UnsignedInt>& b) { return a.first < b.first; });
+
+    for(const std::pair<char32_t, UnsignedInt>& c: characters) {
+        if(!ranges.empty()) {
+            MagnumFontCharRange& last = ranges.back();
+            if(c.first < last.first + last.count) continue;
+
+            if(c.first - (last.first + last.count) < MagnumFontMaxCharRangeGap) {
+                last.count = c.first - last.first + 1;
+                glyphIds.resize(last.charOffset + last.count, 0);
+                glyphIds.back() = c.second;
+                continue;
+            }
+        }
+
+        ranges.push_back({UnsignedInt(c.first), 1, UnsignedInt(glyphIds.size()), 0});
+        glyphIds.push_back(c.second);
+    }
+}
+
+/* Glyph ID for given character, 0 if not found */
+inline UnsignedInt magnumFontGlyphId(const MagnumFontCharRange* const ranges, const std::size_t rangeCount, const UnsignedInt* const glyphIds, const char32_t character) {
+    /* First range starting after the character, only the one before it can
+       contain the character */
+    const MagnumFontCharRange* found = std::upper_bound(ranges, ranges + rangeCount, UnsignedInt(character), [](UnsignedInt c, const MagnumFontCharRange& range) { return c < range.first; });
+    if(found == ranges) return 0;
+
+    --found;
+    const UnsignedInt offset = character - found->first;
+    return offset < found->count ? glyphIds[found->charOffset + offset] : 0;
+}
+
+/* Direct-mapped character -> glyph ID table, so the layouter doesn't need to
+   search the ranges for every character. Latin-1 is a dense array, the rest
+   of Unicode is split into pages of 256 characters which are allocated only
+   if any character in them has a glyph. */
+struct MagnumFontGlyphTable {
+    enum: UnsignedInt {
+        PageSize = 256,
+        MaxCharacter = 0x10ffff
+    };
+
+    UnsignedInt latin1[PageSize];
+
+    /* For each page up to the last allocated one, its index in `pages` plus
+       one or zero if the page has no glyphs */
+    std::vector<UnsignedShort> pageIndices;
+    std::vector<UnsignedInt> pages;
+
+    /* Glyph ID for given character, 0 if not found */
+    UnsignedInt operator()(const char32_t character) const {
+        if(character < PageSize) return latin1[character];
+
+        const std::size_t page = character/PageSize;
+        if(page >= pageIndices.size() || !pageIndices[page]) return 0;
+        return pages[(pageIndices[page] - 1)*PageSize + character%PageSize];
+    }
+};
+
+/* Fills the table from character ranges. Characters outside of Unicode are
+   not put into the table. */
+inline void magnumFontGlyphTable(const MagnumFontCharRange* const ranges, const std::size_t rangeCount, const UnsignedInt* const glyphIds, MagnumFontGlyphTable& table) {
+    std::fill_n(table.latin1, std::size_t(MagnumFontGlyphTable::PageSize), 0);
+    table.pageIndices.clear();
+    table.pages.clear();
+
+    for(std::size_t i = 0; i != rangeCount; ++i) {
+        for(UnsignedInt j = 0; j != ranges[i].count; ++j) {
+            const UnsignedInt character = ranges[i].first + j;
+            const UnsignedInt glyphId = glyphIds[ranges[i].charOffset + j];
+            if(!glyphId) continue;
+
+            if(character < MagnumFontGlyphTable::PageSize) {
+                table.latin1[character] = glyphId;
+                continue;
+            }
+
+            if(character > MagnumFontGlyphTable::MaxCharacter) break;
+
+            const std::size_t page = character/MagnumFontGlyphTable::PageSize;
+            if(page >= table.pageIndices.size())
+                table.pageIndices.resize(page + 1, 0);
+            if(!table.pageIndices[page]) {
+                table.pages.resize(table.pages.size() + MagnumFontGlyphTable::PageSize, 0);
+                table.pageIndices[page] = table.pages.size()/MagnumFontGlyphTable::PageSize;
+            }
+
+            table.pages[(table.pageIndices[page] - 1)*MagnumFontGlyphTable::PageSize + character%MagnumFontGlyphTable::PageSize] = glyphId;
+        }
+    }
+}
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Test/AbstractOpenGLBenchmarker.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "MagnumPlugins/MagnumFont/MagnumFont.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct MagnumFontGLBenchmark: Magnum::Test::AbstractOpenGLBenchmarker {
+    explicit MagnumFontGLBenchmark();
+
+    void layoutAscii();
+    void layoutUtf8();
+    void glyphIdRanges();
+    void glyphIdTable();
+};
+
+MagnumFontGLBenchmark::MagnumFontGLBenchmark() {
+    addTests({&MagnumFontGLBenchmark::layoutAscii,
+              &MagnumFontGLBenchmark::layoutUtf8,
+              &MagnumFontGLBenchmark::glyphIdRanges,
+              &MagnumFontGLBenchmark::glyphIdTable});
+}
+
+namespace {
+
+/* Roughly what a log viewer shows on one screen */
+std::string repeat(const std::string& line, std::size_t count) {
+    std::string out;
+    out.reserve(line.size()*count);
+    for(std::size_t i = 0; i != count; ++i) out += line;
+    return out;
+}
+
+const std::string AsciiText = repeat("[2016-04-02 13:37:00] Renderer: drew 1024 meshes in 2.5 ms, 0 errors\n", 1000);
+const std::string Utf8Text = repeat("[2016-04-02 13:37:00] Příliš žluťoučký kůň úpěl ďábelské ódy, 0 chyb\n", 1000);
+
+/* Characters sparse enough to end up in many ranges and table pages */
+std::vector<std::pair<char32_t, UnsignedInt>> sparseCharacters() {
+    std::vector<std::pair<char32_t, UnsignedInt>> characters;
+    for(char32_t c = 32; c != 0x3000; c += 11)
+        characters.emplace_back(c, characters.size() + 1);
+    return characters;
+}
+
+}
+
+void MagnumFontGLBenchmark::layoutAscii() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    GlyphCache cache(Vector2i(256));
+
+    std::unique_ptr<AbstractLayouter> layouter;
+    measure("MagnumFont::layoutInto() with ASCII text", 100, [&]() {
+        font.layoutInto(cache, 0.5f, {AsciiText.data(), AsciiText.size()}, layouter);
+    });
+
+    CORRADE_COMPARE(layouter->glyphCount(), AsciiText.size());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MagnumFontGLBenchmark::layoutUtf8() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    GlyphCache cache(Vector2i(256));
+
+    std::unique_ptr<AbstractLayouter> layouter;
+    measure("MagnumFont::layoutInto() with UTF-8 text", 100, [&]() {
+        font.layoutInto(cache, 0.5f, {Utf8Text.data(), Utf8Text.size()}, layouter);
+    });
+
+    CORRADE_VERIFY(layouter->glyphCount() < Utf8Text.size());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MagnumFontGLBenchmark::glyphIdRanges() {
+    std::vector<MagnumFontCharRange> ranges;
+    std::vector<UnsignedInt> glyphIds;
+    Implementation::magnumFontCharRanges(sparseCharacters(), ranges, glyphIds);
+
+    UnsignedInt sum = 0;
+    measure("Binary search in character ranges", 100, [&]() {
+        for(char32_t c = 0; c != 0x3000; ++c)
+            sum += Implementation::magnumFontGlyphId(ranges.data(), ranges.size(), glyphIds.data(), c);
+    });
+
+    CORRADE_VERIFY(sum);
+}
+
+void MagnumFontGLBenchmark::glyphIdTable() {
+    std::vector<MagnumFontCharRange> ranges;
+    std::vector<UnsignedInt> glyphIds;
+    Implementation::magnumFontCharRanges(sparseCharacters(), ranges, glyphIds);
+    Implementation::MagnumFontGlyphTable table;
+    Implementation::magnumFontGlyphTable(ranges.data(), ranges.size(), glyphIds.data(), table);
+
+    /* Both lookups give the same result */
+    for(char32_t c = 0; c != 0x3000; ++c)
+        CORRADE_COMPARE(table(c), Implementation::magnumFontGlyphId(ranges.data(), ranges.size(), glyphIds.data(), c));
+
+    UnsignedInt sum = 0;
+    measure("Direct-mapped glyph table", 100, [&]() {
+        for(char32_t c = 0; c != 0x3000; ++c)
+            sum += table(c);
+    });
+
+    CORRADE_VERIFY(sum);
+}
+
+}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Text::Test::MagnumFontGLBenchmark)
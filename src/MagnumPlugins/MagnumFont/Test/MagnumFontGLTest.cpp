@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Test/AbstractOpenGLTester.h"
@@ -39,13 +41,25 @@ class MagnumFontGLTest: public Magnum::Test::AbstractOpenGLTester {
 
         void properties();
         void layout();
+        void layoutLong();
         void createGlyphCache();
+
+        void propertiesBinary();
+        void openDataBinary();
+        void openBinaryInvalid();
+        void createGlyphCacheBinary();
 };
 
 MagnumFontGLTest::MagnumFontGLTest() {
     addTests({&MagnumFontGLTest::properties,
               &MagnumFontGLTest::layout,
-              &MagnumFontGLTest::createGlyphCache});
+              &MagnumFontGLTest::layoutLong,
+              &MagnumFontGLTest::createGlyphCache,
+
+              &MagnumFontGLTest::propertiesBinary,
+              &MagnumFontGLTest::openDataBinary,
+              &MagnumFontGLTest::openBinaryInvalid,
+              &MagnumFontGLTest::createGlyphCacheBinary});
 }
 
 void MagnumFontGLTest::properties() {
@@ -101,6 +115,30 @@ void MagnumFontGLTest::layout() {
     CORRADE_COMPARE(cursorPosition, Vector2(0.375f, 0.0f));
 }
 
+void MagnumFontGLTest::layoutLong() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    GlyphCache cache(Vector2i(256));
+
+    /* Long enough to go through the ASCII fast path, followed by a two-byte
+       character, an invalid byte and ASCII again */
+    auto layouter = font.layout(cache, 0.5f, "WeWeWeWeWeWeWeWeWe\xc3\xa9\xffWe");
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 22);
+
+    /* Only the advances are checked, glyph 0 ('a' and everything unknown)
+       has a different one than 'W' and 'e' */
+    const std::pair<UnsignedInt, Float> expected[]{
+        {0, 0.71875f}, {15, 0.375f}, {17, 0.375f},
+        {18, 0.25f}, {19, 0.25f}, {20, 0.71875f}, {21, 0.375f}};
+    Range2D rectangle;
+    for(const std::pair<UnsignedInt, Float>& e: expected) {
+        Vector2 cursorPosition;
+        layouter->renderGlyph(e.first, cursorPosition, rectangle);
+        CORRADE_COMPARE(cursorPosition, Vector2(e.second, 0.0f));
+    }
+}
+
 void MagnumFontGLTest::createGlyphCache() {
     MagnumFont font;
     CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
@@ -115,6 +153,64 @@ void MagnumFontGLTest::createGlyphCache() {
     /** @todo properly test contents */
 }
 
+void MagnumFontGLTest::propertiesBinary() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.bin"), 0.0f));
+    CORRADE_COMPARE(font.size(), 16.0f);
+    CORRADE_COMPARE(font.ascent(), 25.0f);
+    CORRADE_COMPARE(font.descent(), -10.0f);
+    CORRADE_COMPARE(font.lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font.glyphId(U'W'), 2);
+    CORRADE_COMPARE(font.glyphId(U'e'), 1);
+    CORRADE_COMPARE(font.glyphId(U'a'), 0);
+    /* In the range gap, before and after all ranges */
+    CORRADE_COMPARE(font.glyphId(U'c'), 0);
+    CORRADE_COMPARE(font.glyphId(U' '), 0);
+    CORRADE_COMPARE(font.glyphId(U'z'), 0);
+    CORRADE_COMPARE(font.glyphAdvance(font.glyphId(U'W')), Vector2(23.0f, 0.0f));
+}
+
+void MagnumFontGLTest::openDataBinary() {
+    MagnumFont font;
+    Containers::Array<char> metrics = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.bin"));
+    Containers::Array<char> image = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+    CORRADE_VERIFY(font.openData({{"font.bin", metrics}, {"font.tga", image}}, 0.0f));
+    CORRADE_COMPARE(font.size(), 16.0f);
+    CORRADE_COMPARE(font.glyphAdvance(font.glyphId(U'e')), Vector2(12.0f, 0.0f));
+}
+
+void MagnumFontGLTest::openBinaryInvalid() {
+    Containers::Array<char> metrics = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.bin"));
+    Containers::Array<char> image = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Truncated */
+    MagnumFont font;
+    CORRADE_VERIFY(!font.openData({{"font.bin", Containers::ArrayView<const char>{metrics.data(), 200}}, {"font.tga", image}}, 0.0f));
+
+    /* Glyph ID out of bounds, the first one is for 'W' */
+    metrics[240] = 3;
+    CORRADE_VERIFY(!font.openData({{"font.bin", metrics}, {"font.tga", image}}, 0.0f));
+
+    CORRADE_COMPARE(out.str(),
+        "Text::MagnumFont::openData(): the file is too short for 3 glyphs and 3 character ranges\n"
+        "Text::MagnumFont::openData(): glyph ID 3 out of bounds for 3 glyphs\n");
+}
+
+void MagnumFontGLTest::createGlyphCacheBinary() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.bin"), 0.0f));
+
+    std::unique_ptr<GlyphCache> cache = font.createGlyphCache();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE((*cache)[2].second, (Range2Di{{0, 8}, {16, 128}}.padded(Vector2i{24})));
+}
+
 }}}
 
 MAGNUM_GL_TEST_MAIN(Magnum::Text::Test::MagnumFontGLTest)
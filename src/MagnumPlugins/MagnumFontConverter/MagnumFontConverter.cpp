@@ -25,6 +25,7 @@
 
 #include "MagnumFontConverter.h"
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
@@ -33,6 +34,7 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontHeader.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
@@ -73,6 +75,8 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         inverseGlyphIdMap[map.second] = map.first;
 
     /* Character->glyph map, map glyph IDs to new ones */
+    std::vector<std::pair<char32_t, UnsignedInt>> charGlyphs;
+    charGlyphs.reserve(characters.size());
     for(const char32_t c: characters) {
         Utility::ConfigurationGroup* group = configuration.addGroup("char");
         const UnsignedInt glyphId = font.glyphId(c);
@@ -80,18 +84,23 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
 
         /* Map old glyph ID to new, if not found, map to glyph 0 */
         auto found = glyphIdMap.find(glyphId);
-        group->setValue("glyph", found == glyphIdMap.end() ? 0 : glyphIdMap.at(glyphId));
+        const UnsignedInt newGlyphId = found == glyphIdMap.end() ? 0 : found->second;
+        group->setValue("glyph", newGlyphId);
+        charGlyphs.emplace_back(c, newGlyphId);
     }
 
     /* Save glyph properties in order which preserves their IDs, remove padding
        from the values so they aren't added twice when using the font later */
     /** @todo Some better way to handle this padding stuff */
+    std::vector<MagnumFontGlyph> glyphs;
+    glyphs.reserve(inverseGlyphIdMap.size());
     for(UnsignedInt oldGlyphId: inverseGlyphIdMap) {
         std::pair<Vector2i, Range2Di> glyph = cache[oldGlyphId];
+        glyphs.push_back({font.glyphAdvance(oldGlyphId), glyph.first+cache.padding(), glyph.second.padded(-cache.padding())});
         Utility::ConfigurationGroup* group = configuration.addGroup("glyph");
-        group->setValue("advance", font.glyphAdvance(oldGlyphId));
-        group->setValue("position", glyph.first+cache.padding());
-        group->setValue("rectangle", glyph.second.padded(-cache.padding()));
+        group->setValue("advance", glyphs.back().advance);
+        group->setValue("position", glyphs.back().position);
+        group->setValue("rectangle", glyphs.back().rectangle);
     }
 
     std::ostringstream confOut;
@@ -101,12 +110,47 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     std::copy(confStr.begin(), confStr.end(), confData.begin());
 
     /* Save cache image */
-    Image2D image(PixelFormat::Red, PixelType::UnsignedByte);
-    cache.texture().image(0, image);
+    Image2D image = cache.image();
     auto tgaData = Trade::TgaImageConverter().exportToData(image);
 
+    /* Binary metrics with the same contents */
+    std::vector<MagnumFontCharRange> ranges;
+    std::vector<UnsignedInt> rangeGlyphIds;
+    Implementation::magnumFontCharRanges(std::move(charGlyphs), ranges, rangeGlyphIds);
+
+    const std::string imageFilename = configuration.value("image");
+    auto align = [](std::size_t offset) {
+        return (offset + MagnumFontAlignment - 1)/MagnumFontAlignment*MagnumFontAlignment;
+    };
+    MagnumFontHeader header{};
+    std::copy(MagnumFontIdentifier, MagnumFontIdentifier + sizeof(MagnumFontIdentifier), header.identifier);
+    header.version = MagnumFontVersion;
+    header.endianness = 0x04030201;
+    header.fontSize = font.size();
+    header.ascent = font.ascent();
+    header.descent = font.descent();
+    header.lineHeight = font.lineHeight();
+    header.originalImageSize = cache.textureSize();
+    header.padding = cache.padding();
+    header.glyphCount = glyphs.size();
+    header.rangeCount = ranges.size();
+    header.charCount = rangeGlyphIds.size();
+    header.imageFilenameSize = imageFilename.size();
+    header.glyphOffset = sizeof(MagnumFontHeader);
+    header.rangeOffset = align(header.glyphOffset + glyphs.size()*sizeof(MagnumFontGlyph));
+    header.charOffset = align(header.rangeOffset + ranges.size()*sizeof(MagnumFontCharRange));
+    header.imageFilenameOffset = align(header.charOffset + rangeGlyphIds.size()*sizeof(UnsignedInt));
+
+    Containers::Array<char> binData{Containers::ValueInit, std::size_t(header.imageFilenameOffset + imageFilename.size())};
+    std::memcpy(binData, &header, sizeof(MagnumFontHeader));
+    if(!glyphs.empty()) std::memcpy(binData + header.glyphOffset, glyphs.data(), glyphs.size()*sizeof(MagnumFontGlyph));
+    if(!ranges.empty()) std::memcpy(binData + header.rangeOffset, ranges.data(), ranges.size()*sizeof(MagnumFontCharRange));
+    if(!rangeGlyphIds.empty()) std::memcpy(binData + header.charOffset, rangeGlyphIds.data(), rangeGlyphIds.size()*sizeof(UnsignedInt));
+    std::copy(imageFilename.begin(), imageFilename.end(), binData + header.imageFilenameOffset);
+
     std::vector<std::pair<std::string, Containers::Array<char>>> out;
     out.emplace_back(filename + ".conf", std::move(confData));
+    out.emplace_back(filename + ".bin", std::move(binData));
     out.emplace_back(filename + ".tga", std::move(tgaData));
     return out;
 }
@@ -36,11 +36,14 @@ namespace Magnum { namespace Text {
 /**
 @brief MagnumFont converter plugin
 
-Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
-@ref MagnumFont for more information about the font.
+Expects filename prefix, creates three files, text metrics file
+`prefix.conf`, binary metrics file `prefix.bin` and image `prefix.tga`. Either
+of the metrics files can be opened with @ref MagnumFont, see its documentation
+for more information about the font and the binary format.
 
-This plugin is available only on desktop OpenGL, as it uses @ref Texture::image()
-to read back the generated data. It depends on
+Unless the glyph cache was created without a texture, this plugin is
+available only on desktop OpenGL, as it uses @ref Texture::image() to read
+back the generated data. It depends on
 @ref Trade::TgaImageConverter "TgaImageConverter" plugin and is built if
 `WITH_MAGNUMFONTCONVERTER` is enabled when building Magnum. To use dynamic
 plugin, you need to load `MagnumFontConverter` plugin from
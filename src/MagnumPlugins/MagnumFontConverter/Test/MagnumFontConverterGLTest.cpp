@@ -55,6 +55,7 @@ MagnumFontConverterGLTest::MagnumFontConverterGLTest() {
 void MagnumFontConverterGLTest::exportFont() {
     /* Remove previously created files */
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.bin"));
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
 
     /* Fake font with fake cache */
@@ -110,6 +111,9 @@ void MagnumFontConverterGLTest::exportFont() {
     CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"),
                        Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"),
                        TestSuite::Compare::File);
+    CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.bin"),
+                       Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.bin"),
+                       TestSuite::Compare::File);
 
     /* Verify font image, no need to test image contents, as the image is garbage anyway */
     Trade::TgaImporter importer;
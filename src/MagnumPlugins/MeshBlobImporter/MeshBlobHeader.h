@@ -0,0 +1,114 @@
+#ifndef Magnum_Trade_MeshBlobHeader_h
+#define Magnum_Trade_MeshBlobHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Trade::MeshBlobHeader, @ref Magnum::Trade::MeshBlobAttribute, enum @ref Magnum::Trade::MeshBlobFlag
+ */
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob file header
+
+The header is followed by @ref MeshBlobHeader::attributeCount
+@ref MeshBlobAttribute entries. The mesh data then begin at
+@ref MeshBlobHeader::dataOffset, which is aligned to @ref MeshBlobAlignment
+bytes. Vertex data are at the beginning of the data region, index data are at
+@ref MeshBlobHeader::indexOffset relative to it, again aligned.
+
+If @ref MeshBlobHeader::flags contain @ref MeshBlobFlag::EncodedVertices or
+@ref MeshBlobFlag::EncodedIndices, the respective region is compressed and
+the offsets in the attribute table describe the decoded layout instead, see
+@ref MeshBlobFlag for details.
+*/
+/** @todoc Enable @c INLINE_SIMPLE_STRUCTS again when unclosed &lt;component&gt; in tagfile is fixed*/
+struct MeshBlobHeader {
+    char            identifier[8];      /**< @brief File identifier */
+    UnsignedInt     version;            /**< @brief Format version */
+    UnsignedInt     endianness;         /**< @brief `0x04030201` in file endianness */
+    UnsignedInt     primitive;          /**< @brief Mesh primitive, @ref MeshPrimitive value */
+    UnsignedInt     vertexCount;        /**< @brief Vertex count */
+    UnsignedInt     indexType;          /**< @brief Index type, @ref MeshIndexType value */
+    UnsignedInt     indexCount;         /**< @brief Index count, 0 for non-indexed meshes */
+    UnsignedLong    indexOffset;        /**< @brief Offset of index data relative to @ref dataOffset */
+    UnsignedInt     attributeCount;     /**< @brief Count of attribute entries following the header */
+    UnsignedInt     flags;              /**< @brief Combination of @ref MeshBlobFlag values, zero in version 1 */
+    UnsignedLong    dataOffset;         /**< @brief Offset of mesh data from file start */
+    UnsignedLong    dataSize;           /**< @brief Size of mesh data */
+};
+
+/** @brief Mesh blob attribute entry */
+struct MeshBlobAttribute {
+    UnsignedByte    name;               /**< @brief Attribute name, @ref MeshAttributeName value */
+    UnsignedByte    type;               /**< @brief Attribute type, @ref MeshAttributeType value */
+    UnsignedShort   reserved;           /**< @brief Reserved, zero */
+    UnsignedInt     stride;             /**< @brief Attribute stride */
+    UnsignedLong    offset;             /**< @brief Offset of first item relative to @ref MeshBlobHeader::dataOffset */
+};
+
+/**
+@brief Mesh blob flag
+
+@see @ref MeshBlobHeader::flags
+*/
+enum class MeshBlobFlag: UnsignedInt {
+    /**
+     * The vertex region, i.e. the data region up to
+     * @ref MeshBlobHeader::indexOffset or the whole data region for
+     * non-indexed meshes, contains a stream produced by
+     * @ref MeshTools::encodeVertexStream(). All attributes have the same
+     * stride, the stream has one float component for each four bytes of it.
+     * The decoded vertex data are followed by decoded index data at the
+     * next offset aligned to @ref MeshBlobAlignment.
+     */
+    EncodedVertices = 1 << 0,
+
+    /**
+     * The index region, i.e. the data region from
+     * @ref MeshBlobHeader::indexOffset to its end, contains a stream produced
+     * by @ref MeshTools::encodeIndexStream().
+     */
+    EncodedIndices = 1 << 1
+};
+
+/** @brief Mesh blob file identifier */
+constexpr char MeshBlobIdentifier[8]{'\x89', 'M', 'G', 'N', 'M', 'S', 'H', '\n'};
+
+/** @brief Current mesh blob format version */
+constexpr UnsignedInt MeshBlobVersion = 2;
+
+/** @brief Alignment of mesh blob data and index regions */
+constexpr std::size_t MeshBlobAlignment = 16;
+
+static_assert(sizeof(MeshBlobHeader) == 64, "MeshBlobHeader size is not 64 bytes");
+static_assert(sizeof(MeshBlobAttribute) == 16, "MeshBlobAttribute size is not 16 bytes");
+
+}}
+
+#endif
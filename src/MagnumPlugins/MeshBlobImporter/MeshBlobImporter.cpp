@@ -0,0 +1,234 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlobImporter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Implementation/mapFile.h"
+#include "Magnum/MeshTools/StreamCodec.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MeshBlobImporter::MeshBlobImporter() = default;
+
+MeshBlobImporter::MeshBlobImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter{manager, std::move(plugin)} {}
+
+MeshBlobImporter::~MeshBlobImporter() = default;
+
+auto MeshBlobImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+bool MeshBlobImporter::doIsOpened() const { return _opened; }
+
+void MeshBlobImporter::doClose() {
+    _in = nullptr;
+    _filename.clear();
+    _attributes.clear();
+    _opened = false;
+}
+
+bool MeshBlobImporter::parse(const Containers::ArrayView<const char> data, const char* const prefix) {
+    if(data.size() < sizeof(MeshBlobHeader)) {
+        Error() << prefix << "the file is too short:" << data.size() << "bytes";
+        return false;
+    }
+
+    const MeshBlobHeader& header = *reinterpret_cast<const MeshBlobHeader*>(data.data());
+    if(!std::equal(header.identifier, header.identifier + sizeof(MeshBlobIdentifier), MeshBlobIdentifier)) {
+        Error() << prefix << "invalid file identifier";
+        return false;
+    }
+
+    if(header.endianness != 0x04030201) {
+        Error() << prefix << "files with different endianness are not supported";
+        return false;
+    }
+
+    if(!header.version || header.version > MeshBlobVersion) {
+        Error() << prefix << "unsupported version" << header.version << Debug::nospace << ", expected" << MeshBlobVersion << "or older";
+        return false;
+    }
+
+    if(data.size() < sizeof(MeshBlobHeader) + header.attributeCount*sizeof(MeshBlobAttribute) || data.size() < header.dataOffset + header.dataSize || header.dataOffset < sizeof(MeshBlobHeader) + header.attributeCount*sizeof(MeshBlobAttribute)) {
+        Error() << prefix << "the file is too short for" << header.attributeCount << "attributes and" << header.dataSize << "bytes of data";
+        return false;
+    }
+
+    if(header.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+        Error() << prefix << "invalid index type" << header.indexType;
+        return false;
+    }
+
+    if(header.flags & ~UnsignedInt(UnsignedInt(MeshBlobFlag::EncodedVertices)|UnsignedInt(MeshBlobFlag::EncodedIndices)) || (header.version == 1 && header.flags)) {
+        Error() << prefix << "invalid flags" << header.flags;
+        return false;
+    }
+
+    const bool encodedVertices = header.flags & UnsignedInt(MeshBlobFlag::EncodedVertices);
+    const bool encodedIndices = header.flags & UnsignedInt(MeshBlobFlag::EncodedIndices);
+    if(header.indexCount && (encodedIndices ? header.indexOffset > header.dataSize : header.indexOffset + header.indexCount*meshIndexTypeSize(MeshIndexType(header.indexType)) > header.dataSize)) {
+        Error() << prefix << header.indexCount << "indices at offset" << header.indexOffset << "are out of bounds for" << header.dataSize << "bytes of data";
+        return false;
+    }
+
+    /* Encoded vertices are decoded into a buffer with one float component for
+       each four bytes of the common stride, indices then follow at the next
+       aligned offset */
+    const auto* const attributeTable = reinterpret_cast<const MeshBlobAttribute*>(data.data() + sizeof(MeshBlobHeader));
+    std::size_t vertexDataSize = header.indexCount ? header.indexOffset : header.dataSize;
+    UnsignedInt componentCount = 0;
+    if(encodedVertices) {
+        const UnsignedInt stride = header.attributeCount ? attributeTable[0].stride : 0;
+        for(UnsignedInt i = 0; i != header.attributeCount; ++i) if(attributeTable[i].stride != stride) {
+            Error() << prefix << "encoded vertices need the same stride for all attributes";
+            return false;
+        }
+
+        if(!stride || stride % 4) {
+            Error() << prefix << "invalid stride" << stride << "for encoded vertices";
+            return false;
+        }
+
+        componentCount = stride/4;
+        vertexDataSize = std::size_t(header.vertexCount)*stride;
+    }
+
+    const std::size_t decodedIndexOffset = encodedVertices ?
+        (vertexDataSize + MeshBlobAlignment - 1)/MeshBlobAlignment*MeshBlobAlignment : header.indexOffset;
+    const std::size_t decodedSize = header.indexCount ?
+        decodedIndexOffset + header.indexCount*meshIndexTypeSize(MeshIndexType(header.indexType)) :
+        (encodedVertices ? vertexDataSize : header.dataSize);
+
+    /* Validate the attribute table upfront so MeshData construction in
+       mesh() can't fail */
+    std::vector<MeshAttributeData> attributes;
+    attributes.reserve(header.attributeCount);
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const MeshBlobAttribute& attribute = attributeTable[i];
+        if(attribute.name > UnsignedByte(MeshAttributeName::Color) || attribute.type > UnsignedByte(MeshAttributeType::Vector4)) {
+            Error() << prefix << "invalid name or type of attribute" << i;
+            return false;
+        }
+
+        if(header.vertexCount && attribute.offset + (header.vertexCount - 1)*std::size_t(attribute.stride) + meshAttributeTypeSize(MeshAttributeType(attribute.type)) > (encodedVertices ? vertexDataSize : header.dataSize)) {
+            Error() << prefix << "attribute" << i << "is out of bounds for" << (encodedVertices ? vertexDataSize : header.dataSize) << "bytes of data";
+            return false;
+        }
+
+        attributes.emplace_back(MeshAttributeName(attribute.name), MeshAttributeType(attribute.type), attribute.offset, attribute.stride);
+    }
+
+    _primitive = MeshPrimitive(header.primitive);
+    _indexType = MeshIndexType(header.indexType);
+    _indexCount = header.indexCount;
+    _indexOffset = header.indexOffset;
+    _vertexCount = header.vertexCount;
+    _dataOffset = header.dataOffset;
+    _dataSize = header.dataSize;
+    _flags = header.flags;
+    _componentCount = componentCount;
+    _decodedIndexOffset = decodedIndexOffset;
+    _decodedSize = decodedSize;
+    _attributes = std::move(attributes);
+    return _opened = true;
+}
+
+void MeshBlobImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    if(!parse(data, "Trade::MeshBlobImporter::openData():")) return;
+
+    /* Keep just the data region, the header is not needed anymore */
+    _in = Containers::Array<char>{_dataSize};
+    std::copy_n(data + _dataOffset, _dataSize, _in.begin());
+}
+
+void MeshBlobImporter::doOpenFile(const std::string& filename) {
+    /* If the file can be mapped, parse the header and remember the filename
+       only, the data region is then mapped again in mesh() so the returned
+       mesh can take the ownership of it */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(const Containers::Array<const char> mapped = Magnum::Implementation::mapFile(filename)) {
+        if(parse(mapped, "Trade::MeshBlobImporter::openFile():")) _filename = filename;
+        return;
+    }
+    #endif
+
+    /* Otherwise read the file into memory */
+    AbstractImporter::doOpenFile(filename);
+}
+
+UnsignedInt MeshBlobImporter::doMeshCount() const { return 1; }
+
+std::optional<MeshData> MeshBlobImporter::doMesh(UnsignedInt) {
+    /* Reference the mapped data directly, copy otherwise */
+    Containers::Array<char> data;
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(!_filename.empty() && _dataSize) {
+        if(!(data = Magnum::Implementation::mapFileWritable(_filename, _dataOffset, _dataSize))) {
+            Error() << "Trade::MeshBlobImporter::mesh(): cannot map file" << _filename;
+            return std::nullopt;
+        }
+    } else
+    #endif
+    {
+        data = allocate(_dataSize);
+        std::copy(_in.begin(), _in.end(), data.begin());
+    }
+
+    /* Decode compressed regions into a new buffer, copying the rest */
+    if(_flags) {
+        Containers::Array<char> decoded = allocate(_decodedSize);
+        std::fill(decoded.begin(), decoded.end(), 0);
+
+        const std::size_t vertexDataEnd = _indexCount ? _indexOffset : _dataSize;
+        if(_flags & UnsignedInt(MeshBlobFlag::EncodedVertices)) {
+            if(!MeshTools::decodeVertexStream(data.prefix(vertexDataEnd), {reinterpret_cast<Float*>(decoded.data()), std::size_t(_vertexCount)*_componentCount}, _componentCount))
+                return std::nullopt;
+        } else std::copy_n(data.begin(), vertexDataEnd, decoded.begin());
+
+        if(_indexCount) {
+            char* const indices = decoded.data() + _decodedIndexOffset;
+            const Containers::ArrayView<const char> indexData = data.suffix(_indexOffset);
+            if(!(_flags & UnsignedInt(MeshBlobFlag::EncodedIndices)))
+                std::copy_n(indexData.begin(), _indexCount*meshIndexTypeSize(_indexType), indices);
+            else if(!(_indexType == MeshIndexType::UnsignedByte ?
+                MeshTools::decodeIndexStream(indexData, {reinterpret_cast<UnsignedByte*>(indices), _indexCount}) :
+              _indexType == MeshIndexType::UnsignedShort ?
+                MeshTools::decodeIndexStream(indexData, {reinterpret_cast<UnsignedShort*>(indices), _indexCount}) :
+                MeshTools::decodeIndexStream(indexData, {reinterpret_cast<UnsignedInt*>(indices), _indexCount})))
+                return std::nullopt;
+        }
+
+        data = std::move(decoded);
+    }
+
+    if(!_indexCount)
+        return MeshData{_primitive, std::move(data), _attributes, _vertexCount};
+    return MeshData{_primitive, std::move(data), _indexType, _flags ? _decodedIndexOffset : _indexOffset, _indexCount, _attributes, _vertexCount};
+}
+
+}}
@@ -0,0 +1,120 @@
+#ifndef Magnum_Trade_MeshBlobImporter_h
+#define Magnum_Trade_MeshBlobImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshBlobImporter
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "MagnumPlugins/MeshBlobImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHBLOBIMPORTER_BUILD_STATIC
+    #if defined(MeshBlobImporter_EXPORTS) || defined(MeshBlobImporterObjects_EXPORTS)
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob importer plugin
+
+Imports meshes baked by the @ref magnum-meshbaker "magnum-meshbaker" utility.
+The file consists of a @ref MeshBlobHeader, a table of @ref MeshBlobAttribute
+entries and a data region with interleaved vertex data followed by index
+data, both aligned and already in the layout expected by the GPU. The file
+contains exactly one mesh, which is available through @ref mesh() as
+@ref MeshData, the @ref mesh2D() / @ref mesh3D() APIs are not implemented.
+Files with different endianness than the platform aren't supported.
+
+This plugin is built if `WITH_MESHBLOBIMPORTER` is enabled when building
+Magnum. To use dynamic plugin, you need to load `MeshBlobImporter` plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a
+dependency of another plugin, you need to request `MeshBlobImporter`
+component of `Magnum` package in CMake and link to `Magnum::MeshBlobImporter`
+target. See @ref building, @ref cmake and @ref plugins for more information.
+
+Only the header and the attribute table are validated when opening the file,
+nothing else is parsed. On Unix systems, files opened with @ref openFile() are
+memory-mapped instead of being read into memory and each call to @ref mesh()
+maps just the data region, so the returned @ref MeshData references the file
+pages directly and can be uploaded with a single @ref Buffer::setData() call,
+for example using @ref MeshTools::compile(const Trade::MeshData&, BufferUsage).
+
+Files baked with `--encode` contain compressed vertex and index data, see
+@ref MeshBlobFlag. These are decoded in @ref mesh() into a newly allocated
+buffer and the file is thus mapped only temporarily. Both version 1 and
+version 2 files are supported.
+*/
+class MAGNUM_MESHBLOBIMPORTER_EXPORT MeshBlobImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshBlobImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshBlobImporter(PluginManager::AbstractManager& manager, std::string plugin);
+
+        ~MeshBlobImporter();
+
+    private:
+        Features MAGNUM_MESHBLOBIMPORTER_LOCAL doFeatures() const override;
+        bool MAGNUM_MESHBLOBIMPORTER_LOCAL doIsOpened() const override;
+        void MAGNUM_MESHBLOBIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_MESHBLOBIMPORTER_LOCAL doOpenFile(const std::string& filename) override;
+        void MAGNUM_MESHBLOBIMPORTER_LOCAL doClose() override;
+        UnsignedInt MAGNUM_MESHBLOBIMPORTER_LOCAL doMeshCount() const override;
+        std::optional<MeshData> MAGNUM_MESHBLOBIMPORTER_LOCAL doMesh(UnsignedInt id) override;
+
+        bool MAGNUM_MESHBLOBIMPORTER_LOCAL parse(Containers::ArrayView<const char> data, const char* prefix);
+
+        Containers::Array<char> _in;
+        std::string _filename;
+        bool _opened{};
+        MeshPrimitive _primitive;
+        MeshIndexType _indexType;
+        UnsignedInt _indexCount, _vertexCount;
+        UnsignedInt _flags, _componentCount;
+        std::size_t _indexOffset, _dataOffset, _dataSize, _decodedIndexOffset, _decodedSize;
+        std::vector<MeshAttributeData> _attributes;
+};
+
+}}
+
+#endif
@@ -0,0 +1,308 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/StreamCodec.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class MeshBlobImporterTest: public TestSuite::Tester {
+    public:
+        MeshBlobImporterTest();
+
+        void openShort();
+        void invalidIdentifier();
+        void differentEndianness();
+        void unsupportedVersion();
+        void invalidFlags();
+        void dataTruncated();
+        void indicesOutOfBounds();
+        void attributeOutOfBounds();
+        void encodedStrideMismatch();
+
+        void indexed();
+        void nonIndexed();
+        void encoded();
+
+        void openFile();
+};
+
+MeshBlobImporterTest::MeshBlobImporterTest() {
+    addTests({&MeshBlobImporterTest::openShort,
+              &MeshBlobImporterTest::invalidIdentifier,
+              &MeshBlobImporterTest::differentEndianness,
+              &MeshBlobImporterTest::unsupportedVersion,
+              &MeshBlobImporterTest::invalidFlags,
+              &MeshBlobImporterTest::dataTruncated,
+              &MeshBlobImporterTest::indicesOutOfBounds,
+              &MeshBlobImporterTest::attributeOutOfBounds,
+              &MeshBlobImporterTest::encodedStrideMismatch,
+
+              &MeshBlobImporterTest::indexed,
+              &MeshBlobImporterTest::nonIndexed,
+              &MeshBlobImporterTest::encoded,
+
+              &MeshBlobImporterTest::openFile});
+}
+
+namespace {
+
+MeshBlobHeader header(UnsignedInt vertexCount, UnsignedInt indexCount, std::size_t indexOffset, UnsignedInt attributeCount, std::size_t dataSize) {
+    return {{'\x89', 'M', 'G', 'N', 'M', 'S', 'H', '\n'},
+        1, 0x04030201, UnsignedInt(MeshPrimitive::Triangles), vertexCount,
+        UnsignedInt(MeshIndexType::UnsignedShort), indexCount, indexOffset,
+        attributeCount, 0, (sizeof(MeshBlobHeader) + attributeCount*sizeof(MeshBlobAttribute) + 15)/16*16, dataSize};
+}
+
+std::vector<char> file(const MeshBlobHeader& header, std::initializer_list<MeshBlobAttribute> attributes, const std::vector<char>& data) {
+    std::vector<char> out(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header + 1));
+    for(const MeshBlobAttribute& attribute: attributes)
+        out.insert(out.end(), reinterpret_cast<const char*>(&attribute), reinterpret_cast<const char*>(&attribute + 1));
+    out.resize(header.dataOffset);
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+/* Three Vector3 positions followed by three UnsignedShort indices at offset
+   48 */
+std::vector<char> positionIndexData() {
+    const Float positions[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+    const UnsignedShort indices[]{2, 0, 1};
+    std::vector<char> out(reinterpret_cast<const char*>(positions), reinterpret_cast<const char*>(positions) + sizeof(positions));
+    out.insert(out.end(), reinterpret_cast<const char*>(indices), reinterpret_cast<const char*>(indices) + sizeof(indices));
+    return out;
+}
+
+constexpr MeshBlobAttribute PositionAttribute{UnsignedByte(MeshAttributeName::Position), UnsignedByte(MeshAttributeType::Vector3), 0, 12, 0};
+
+}
+
+void MeshBlobImporterTest::openShort() {
+    MeshBlobImporter importer;
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    const char data[32]{};
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): the file is too short: 32 bytes\n");
+}
+
+void MeshBlobImporterTest::invalidIdentifier() {
+    MeshBlobImporter importer;
+    MeshBlobHeader h = header(3, 3, 36, 1, 42);
+    h.identifier[1] = 'N';
+    const std::vector<char> data = file(h, {PositionAttribute}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): invalid file identifier\n");
+}
+
+void MeshBlobImporterTest::differentEndianness() {
+    MeshBlobImporter importer;
+    MeshBlobHeader h = header(3, 3, 36, 1, 42);
+    h.endianness = 0x01020304;
+    const std::vector<char> data = file(h, {PositionAttribute}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): files with different endianness are not supported\n");
+}
+
+void MeshBlobImporterTest::unsupportedVersion() {
+    MeshBlobImporter importer;
+    MeshBlobHeader h = header(3, 3, 36, 1, 42);
+    h.version = 3;
+    const std::vector<char> data = file(h, {PositionAttribute}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): unsupported version 3, expected 2 or older\n");
+}
+
+void MeshBlobImporterTest::invalidFlags() {
+    MeshBlobImporter importer;
+    MeshBlobHeader h = header(3, 3, 36, 1, 42);
+    h.flags = UnsignedInt(MeshBlobFlag::EncodedIndices);
+    const std::vector<char> data = file(h, {PositionAttribute}, positionIndexData());
+    h.version = 2;
+    h.flags = 4;
+    const std::vector<char> data2 = file(h, {PositionAttribute}, positionIndexData());
+
+    /* Version 1 has no flags */
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_VERIFY(!importer.openData({data2.data(), data2.size()}));
+    CORRADE_COMPARE(debug.str(),
+        "Trade::MeshBlobImporter::openData(): invalid flags 2\n"
+        "Trade::MeshBlobImporter::openData(): invalid flags 4\n");
+}
+
+void MeshBlobImporterTest::dataTruncated() {
+    MeshBlobImporter importer;
+    std::vector<char> data = file(header(3, 3, 36, 1, 42), {PositionAttribute}, positionIndexData());
+    data.resize(data.size() - 1);
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): the file is too short for 1 attributes and 42 bytes of data\n");
+}
+
+void MeshBlobImporterTest::indicesOutOfBounds() {
+    MeshBlobImporter importer;
+    const std::vector<char> data = file(header(3, 4, 36, 1, 42), {PositionAttribute}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): 4 indices at offset 36 are out of bounds for 42 bytes of data\n");
+}
+
+void MeshBlobImporterTest::attributeOutOfBounds() {
+    MeshBlobImporter importer;
+    const std::vector<char> data = file(header(3, 3, 36, 1, 42), {{UnsignedByte(MeshAttributeName::Position), UnsignedByte(MeshAttributeType::Vector3), 0, 16, 0}}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(debug.str(), "Trade::MeshBlobImporter::openData(): attribute 0 is out of bounds for 42 bytes of data\n");
+}
+
+void MeshBlobImporterTest::encodedStrideMismatch() {
+    MeshBlobImporter importer;
+    MeshBlobHeader h = header(3, 3, 36, 2, 42);
+    h.version = 2;
+    h.flags = UnsignedInt(MeshBlobFlag::EncodedVertices);
+    const std::vector<char> data = file(h, {PositionAttribute, {UnsignedByte(MeshAttributeName::Normal), UnsignedByte(MeshAttributeType::Vector3), 0, 16, 0}}, positionIndexData());
+    h.attributeCount = 1;
+    const std::vector<char> data2 = file(h, {{UnsignedByte(MeshAttributeName::Position), UnsignedByte(MeshAttributeType::Vector3), 0, 14, 0}}, positionIndexData());
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.openData({data.data(), data.size()}));
+    CORRADE_VERIFY(!importer.openData({data2.data(), data2.size()}));
+    CORRADE_COMPARE(debug.str(),
+        "Trade::MeshBlobImporter::openData(): encoded vertices need the same stride for all attributes\n"
+        "Trade::MeshBlobImporter::openData(): invalid stride 14 for encoded vertices\n");
+}
+
+void MeshBlobImporterTest::indexed() {
+    MeshBlobImporter importer;
+    const std::vector<char> data = file(header(3, 3, 36, 1, 42), {PositionAttribute}, positionIndexData());
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+    CORRADE_COMPARE(importer.meshCount(), 1);
+
+    std::optional<Trade::MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 36);
+    CORRADE_COMPARE(mesh->indicesAsArray(), (std::vector<UnsignedInt>{2, 0, 1}));
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttributeName::Position).toVector(), (std::vector<Vector3>{
+        {0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {6.0f, 7.0f, 8.0f}}));
+}
+
+void MeshBlobImporterTest::nonIndexed() {
+    MeshBlobImporter importer;
+    const std::vector<char> data = file(header(3, 0, 0, 1, 36), {PositionAttribute}, positionIndexData());
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    std::optional<Trade::MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->data().size(), 36);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttributeName::Position)[2], (Vector3{6.0f, 7.0f, 8.0f}));
+}
+
+void MeshBlobImporterTest::encoded() {
+    const Float positions[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+    Containers::Array<char> vertices = MeshTools::encodeVertexStream(positions, 3, 24);
+    Containers::Array<char> indices = MeshTools::encodeIndexStream({2, 0, 1});
+    std::vector<char> blob(vertices.begin(), vertices.end());
+    blob.insert(blob.end(), indices.begin(), indices.end());
+
+    MeshBlobHeader h = header(3, 3, vertices.size(), 1, blob.size());
+    h.version = 2;
+    h.flags = UnsignedInt(MeshBlobFlag::EncodedVertices)|UnsignedInt(MeshBlobFlag::EncodedIndices);
+    const std::vector<char> data = file(h, {PositionAttribute}, blob);
+
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    /* Decoded indices are at the next aligned offset after the vertices */
+    std::optional<Trade::MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->data().size(), 54);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 48);
+    CORRADE_COMPARE(mesh->indicesAsArray(), (std::vector<UnsignedInt>{2, 0, 1}));
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttributeName::Position).toVector(), (std::vector<Vector3>{
+        {0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {6.0f, 7.0f, 8.0f}}));
+}
+
+void MeshBlobImporterTest::openFile() {
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "file.blob")));
+    CORRADE_COMPARE(importer.meshCount(), 1);
+
+    /* Verify that the mesh can be imported repeatedly */
+    for(std::size_t i = 0; i != 2; ++i) {
+        std::optional<Trade::MeshData> mesh = importer.mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->data().size(), 70);
+        CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+        CORRADE_COMPARE(mesh->indicesAsArray(), (std::vector<UnsignedInt>{2, 0, 1}));
+        CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttributeName::Position).toVector(), (std::vector<Vector3>{
+            {0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {6.0f, 7.0f, 8.0f}}));
+        CORRADE_COMPARE(mesh->attribute<Vector2>(MeshAttributeName::TextureCoordinates).toVector(), (std::vector<Vector2>{
+            {0.25f, 0.5f}, {0.75f, 1.0f}, {0.0f, 0.125f}}));
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobImporterTest)
@@ -25,76 +25,191 @@
 
 #include "ObjImporter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <limits>
-#include <sstream>
+#include <numeric>
 #include <unordered_map>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
-#include <Corrade/Utility/String.h>
 
 #include "Magnum/Mesh.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/mapFile.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/MeshData3D.h"
 
-#if defined(CORRADE_TARGET_NACL_NEWLIB) || defined(CORRADE_TARGET_ANDROID)
-#include <sstream>
-#endif
-
 namespace Magnum { namespace Trade {
 
 struct ObjImporter::File {
+    struct Mesh {
+        /* Range of the mesh in the data */
+        std::size_t begin, end;
+
+        /* Global index of first position, texture coordinate and normal in
+           this mesh (counting from 1) and count of them */
+        UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+        UnsignedInt positionCount, textureCoordinateCount, normalCount;
+    };
+
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    std::unique_ptr<std::istream> in;
+    std::vector<Mesh> meshes;
+    Containers::Array<const char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* The data are not null-terminated, so everything works on explicit ranges
+   and nothing needs to be copied */
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char* skipWhitespace(const char* it, const char* const end) {
+    while(it != end && isWhitespace(*it)) ++it;
+    return it;
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(std::string str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
+inline const char* skipToken(const char* it, const char* const end) {
+    while(it != end && !isWhitespace(*it)) ++it;
+    return it;
+}
+
+inline bool equals(const char* const begin, const char* const end, const char* const string) {
+    const std::size_t size = std::strlen(string);
+    return std::size_t(end - begin) == size && std::memcmp(begin, string, size) == 0;
+}
+
+/* Returns pointer to the end of the line (without the newline character) */
+inline const char* findLineEnd(const char* const it, const char* const end) {
+    const char* const found = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    return found ? found : end;
+}
+
+/* Non-allocating replacement for std::stof(), the whole range has to be
+   consumed */
+Float parseFloat(const char* it, const char* const end) {
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) negative = *it++ == '-';
+
+    /* Mantissa, extra digits that don't fit are only accounted in exponent */
+    std::uint64_t mantissa = 0;
+    Int exponent = 0;
+    bool hasDigits = false;
+    for(; it != end && *it >= '0' && *it <= '9'; ++it) {
+        hasDigits = true;
+        if(mantissa < 100000000000000000ull) mantissa = mantissa*10 + (*it - '0');
+        else ++exponent;
+    }
+    if(it != end && *it == '.') for(++it; it != end && *it >= '0' && *it <= '9'; ++it) {
+        hasDigits = true;
+        if(mantissa < 100000000000000000ull) {
+            mantissa = mantissa*10 + (*it - '0');
+            --exponent;
+        }
+    }
+
+    if(!hasDigits) throw 0;
+
+    /* Exponent */
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) negativeExponent = *it++ == '-';
+        if(it == end || *it < '0' || *it > '9') throw 0;
+
+        Int explicitExponent = 0;
+        for(; it != end && *it >= '0' && *it <= '9'; ++it)
+            if(explicitExponent < 10000) explicitExponent = explicitExponent*10 + (*it - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    /* Trailing garbage */
+    if(it != end) throw 0;
+
+    /* Powers of ten up to 22 are exactly representable in a double, so this
+       gives correctly rounded result in the vast majority of cases */
+    constexpr Double powers[]{1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6,
+        1.0e7, 1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+        1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+    Double value = Double(mantissa);
+    if(exponent < 0) value = exponent >= -22 ? value/powers[-exponent] : value/std::pow(10.0, -exponent);
+    else if(exponent > 0) value = exponent <= 22 ? value*powers[exponent] : value*std::pow(10.0, exponent);
+
+    return Float(negative ? -value : value);
+}
+
+/* Non-allocating replacement for std::stoul(), the whole range has to be
+   consumed */
+UnsignedInt parseUnsignedInt(const char* it, const char* const end) {
+    if(it == end) throw 0;
+
+    std::uint64_t value = 0;
+    for(; it != end; ++it) {
+        if(*it < '0' || *it > '9') throw 0;
+        value = value*10 + (*it - '0');
+        if(value > std::numeric_limits<UnsignedInt>::max()) throw 0;
+    }
+
+    return UnsignedInt(value);
+}
+
+template<std::size_t size> Math::Vector<size, Float> extractFloatData(const char* const begin, const char* const end, Float* extra = nullptr) {
+    /* Find the tokens first, so the count can be checked before anything is
+       converted */
+    std::pair<const char*, const char*> tokens[size + 1];
+    std::size_t count = 0;
+    for(const char* it = skipWhitespace(begin, end); it != end; it = skipWhitespace(it, end)) {
+        const char* const tokenEnd = skipToken(it, end);
+        if(count == size + (extra ? 1 : 0)) {
+            ++count;
+            break;
+        }
+        tokens[count++] = {it, tokenEnd};
+        it = tokenEnd;
+    }
+
+    if(count < size || count > size + (extra ? 1 : 0)) {
         Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
         throw 0;
     }
 
     Math::Vector<size, Float> output;
 
-    #if defined(CORRADE_TARGET_NACL_NEWLIB) || defined(CORRADE_TARGET_ANDROID)
-    std::istringstream in;
-    #endif
+    try {
+        for(std::size_t i = 0; i != size; ++i)
+            output[i] = parseFloat(tokens[i].first, tokens[i].second);
 
-    for(std::size_t i = 0; i != size; ++i) {
-        #if !defined(CORRADE_TARGET_NACL_NEWLIB) && !defined(CORRADE_TARGET_ANDROID)
-        output[i] = std::stof(data[i]);
-        #else
-        in.str(data[i]);
-        in >> output[i];
-        #endif
-    }
+        if(count == size+1) {
+            /* This should be obvious from the first if, but add this just to
+               make Clang Analyzer happy */
+            CORRADE_INTERNAL_ASSERT(extra);
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
-
-        #if !defined(CORRADE_TARGET_NACL_NEWLIB) && !defined(CORRADE_TARGET_ANDROID)
-        *extra = std::stof(data.back());
-        #else
-        in.str(data.back());
-        in >> *extra;
-        #endif
+            *extra = parseFloat(tokens[size].first, tokens[size].second);
+        }
+    } catch(...) {
+        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+        throw;
     }
 
     return output;
 }
 
+UnsignedInt extractIndex(const char* const begin, const char* const end) {
+    try {
+        return parseUnsignedInt(begin, end);
+    } catch(...) {
+        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+        throw;
+    }
+}
+
 template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vector<T>& data) {
     /* Check that indices are in range */
     for(UnsignedInt i: indices) if(i >= data.size()) {
@@ -120,56 +235,89 @@ void ObjImporter::doClose() { _file.reset(); }
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
 void ObjImporter::doOpenFile(const std::string& filename) {
-    std::unique_ptr<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
+    /* Map the file into memory, if possible. Empty files can't be mapped, so
+       these go through the generic path. */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(Containers::Array<const char> mapped = Magnum::Implementation::mapFile(filename)) {
+        _file.reset(new File);
+        _file->data = std::move(mapped);
+        parseMeshNames();
+        return;
+    }
+    #endif
+
+    /* Otherwise read the whole file into a single buffer */
+    std::ifstream in{filename, std::ios::binary};
+    if(!in.good()) {
         Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
         return;
     }
 
+    in.seekg(0, std::ios::end);
+    const std::size_t size = in.tellg();
+    char* const data = new char[size];
+    in.seekg(0, std::ios::beg);
+    in.read(data, size);
+
     _file.reset(new File);
-    _file->in = std::move(in);
+    _file->data = Containers::Array<const char>{data, size};
     parseMeshNames();
 }
 
 void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
+    /* The data view doesn't need to be valid after this function returns, so
+       make a copy */
+    char* const copy = new char[data.size()];
+    std::copy(data.begin(), data.end(), copy);
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = Containers::Array<const char>{copy, data.size()};
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const char* const begin = _file->data.begin();
+    const char* const end = _file->data.end();
+
     /* First mesh starts at the beginning, its indices start from 1. The end
-       offset will be updated to proper value later. */
+       offset and counts will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
-    UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    UnsignedInt normalIndexOffset = 1;
+    _file->meshes.push_back({0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
-        /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+    /* Finish the last mesh, recording its end offset and counts */
+    auto finishMesh = [&](const std::size_t meshEnd) {
+        File::Mesh& mesh = _file->meshes.back();
+        mesh.end = meshEnd;
+        mesh.positionCount = positionIndexOffset - mesh.positionIndexOffset;
+        mesh.textureCoordinateCount = textureCoordinateIndexOffset - mesh.textureCoordinateIndexOffset;
+        mesh.normalCount = normalIndexOffset - mesh.normalIndexOffset;
+    };
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+    for(const char* it = begin; it < end; ) {
+        /* The previous object might end at the beginning of this line */
+        const char* const lineBegin = it;
+        const char* const lineEnd = findLineEnd(it, end);
+        it = lineEnd == end ? end : lineEnd + 1;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        /* Parse the keyword, ignore empty and comment lines */
+        const char* const keywordBegin = skipWhitespace(lineBegin, lineEnd);
+        if(keywordBegin == lineEnd || *keywordBegin == '#') continue;
+        const char* const keywordEnd = skipToken(keywordBegin, lineEnd);
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(equals(keywordBegin, keywordEnd, "o")) {
+            /* Trim the name */
+            const char* const nameBegin = skipWhitespace(keywordEnd, lineEnd);
+            const char* nameEnd = lineEnd;
+            while(nameEnd != nameBegin && isWhitespace(*(nameEnd - 1))) --nameEnd;
+            std::string name{nameBegin, nameEnd};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -181,54 +329,48 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                _file->meshes.back().begin = it - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                finishMesh(lineBegin - begin);
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.push_back({std::size_t(it - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(equals(keywordBegin, keywordEnd, "v")) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(equals(keywordBegin, keywordEnd, "vt")) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(equals(keywordBegin, keywordEnd, "vn")) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(thisIsFirstMeshAndItHasNoData && (
+            equals(keywordBegin, keywordEnd, "p") ||
+            equals(keywordBegin, keywordEnd, "l") ||
+            equals(keywordBegin, keywordEnd, "f")))
+        {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    finishMesh(end - begin);
 }
 
 UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
@@ -243,11 +385,41 @@ std::string ObjImporter::doMesh3DName(UnsignedInt id) {
 }
 
 std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    return parseMesh(id);
+}
+
+std::vector<std::optional<MeshData3D>> ObjImporter::meshes3D(std::vector<UnsignedInt> ids, UnsignedInt threadCount) {
+    CORRADE_ASSERT(isOpened(), "Trade::ObjImporter::meshes3D(): no file opened", {});
+
+    /* Import all meshes if no IDs were specified */
+    if(ids.empty()) {
+        ids.resize(_file->meshes.size());
+        std::iota(ids.begin(), ids.end(), 0);
+    }
+
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt id: ids)
+        CORRADE_ASSERT(id < _file->meshes.size(), "Trade::ObjImporter::meshes3D(): index out of range", {});
+    #endif
+
+    std::vector<std::optional<MeshData3D>> meshes(ids.size());
+
+    /* Each mesh is a separate task, so the load is balanced even when the
+       meshes differ a lot in size */
+    auto parse = [this, &ids, &meshes](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            meshes[i] = parseMesh(ids[i]);
+    };
+    if(threadCount == 1) parse(0, ids.size());
+    else TaskScheduler::global().parallelFor(ids.size(), 1, parse);
+
+    return meshes;
+}
+
+std::optional<MeshData3D> ObjImporter::parseMesh(const UnsignedInt id) const {
+    /* Set mesh parsing parameters */
+    const File::Mesh& mesh = _file->meshes[id];
+    const char* const end = _file->data.begin() + mesh.end;
 
     std::optional<MeshPrimitive> primitive;
     std::vector<Vector3> positions;
@@ -257,31 +429,35 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
     std::vector<UnsignedInt> textureCoordinateIndices;
     std::vector<UnsignedInt> normalIndices;
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+    /* The counts are known from parseMeshNames(), avoid reallocations */
+    positions.reserve(mesh.positionCount);
+    if(mesh.textureCoordinateCount) {
+        textureCoordinates.emplace_back();
+        textureCoordinates.front().reserve(mesh.textureCoordinateCount);
+    }
+    if(mesh.normalCount) {
+        normals.emplace_back();
+        normals.front().reserve(mesh.normalCount);
+    }
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
+    try { for(const char* it = _file->data.begin() + mesh.begin; it < end; ) {
+        /* Get the line, trim it */
+        const char* const lineBegin = skipWhitespace(it, end);
+        const char* lineEnd = findLineEnd(lineBegin, end);
+        it = lineEnd == end ? end : lineEnd + 1;
+        while(lineEnd != lineBegin && isWhitespace(*(lineEnd - 1))) --lineEnd;
 
-        /* Ignore empty lines */
-        if(line.empty()) continue;
+        /* Ignore empty lines and comments */
+        if(lineBegin == lineEnd || *lineBegin == '#') continue;
 
         /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+        const char* const keywordEnd = skipToken(lineBegin, lineEnd);
+        const char* const contents = skipWhitespace(keywordEnd, lineEnd);
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(equals(lineBegin, keywordEnd, "v")) {
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
+            const Vector3 data = extractFloatData<3>(contents, lineEnd, &extra);
             if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
                 Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
                 return std::nullopt;
@@ -290,9 +466,9 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
             positions.push_back(data);
 
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(equals(lineBegin, keywordEnd, "vt")) {
             Float extra{0.0f};
-            const auto data = extractFloatData<2>(contents, &extra);
+            const auto data = extractFloatData<2>(contents, lineEnd, &extra);
             if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
                 Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
                 return std::nullopt;
@@ -302,16 +478,19 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
             textureCoordinates.front().push_back(data);
 
         /* Normal */
-        } else if(keyword == "vn") {
+        } else if(equals(lineBegin, keywordEnd, "vn")) {
             if(normals.empty()) normals.push_back({});
-            normals.front().push_back(extractFloatData<3>(contents));
+            normals.front().push_back(extractFloatData<3>(contents, lineEnd));
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
+        } else if(equals(lineBegin, keywordEnd, "p") || equals(lineBegin, keywordEnd, "l") || equals(lineBegin, keywordEnd, "f")) {
+            /* Count the index tuples first */
+            std::size_t indexTupleCount = 0;
+            for(const char* tuple = contents; tuple != lineEnd; tuple = skipWhitespace(skipToken(tuple, lineEnd), lineEnd))
+                ++indexTupleCount;
 
             /* Points */
-            if(keyword == "p") {
+            if(*lineBegin == 'p') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Points) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
@@ -319,7 +498,7 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
+                if(indexTupleCount != 1) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
                     return std::nullopt;
                 }
@@ -327,7 +506,7 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 primitive = MeshPrimitive::Points;
 
             /* Lines */
-            } else if(keyword == "l") {
+            } else if(*lineBegin == 'l') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Lines) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
@@ -335,7 +514,7 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
+                if(indexTupleCount != 2) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
                     return std::nullopt;
                 }
@@ -343,7 +522,7 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 primitive = MeshPrimitive::Lines;
 
             /* Faces */
-            } else if(keyword == "f") {
+            } else if(*lineBegin == 'f') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Triangles) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
@@ -351,10 +530,10 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
+                if(indexTupleCount < 3) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
                     return std::nullopt;
-                } else if(indexTuples.size() != 3) {
+                } else if(indexTupleCount != 3) {
                     Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
                     return std::nullopt;
                 }
@@ -363,61 +542,48 @@ std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
 
             } else CORRADE_ASSERT_UNREACHABLE();
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
-                if(indices.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
-                    return std::nullopt;
+            for(const char* tuple = contents; tuple != lineEnd; ) {
+                const char* const tupleEnd = skipToken(tuple, lineEnd);
+
+                /* Split the tuple on slashes */
+                std::pair<const char*, const char*> indices[3]{{tuple, tupleEnd}};
+                std::size_t indexCount = 1;
+                for(const char* i = tuple; i != tupleEnd; ++i) if(*i == '/') {
+                    if(indexCount == 3) {
+                        Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
+                        return std::nullopt;
+                    }
+
+                    indices[indexCount - 1].second = i;
+                    indices[indexCount++] = {i + 1, tupleEnd};
                 }
 
                 /* Position indices */
-                #if !defined(CORRADE_TARGET_NACL_NEWLIB) && !defined(CORRADE_TARGET_ANDROID)
-                positionIndices.push_back(std::stoul(indices[0]) - positionIndexOffset);
-                #else
-                std::istringstream in(indices[0]);
-                UnsignedInt index;
-                in >> index;
-                positionIndices.push_back(index - positionIndexOffset);
-                #endif
+                positionIndices.push_back(extractIndex(indices[0].first, indices[0].second) - mesh.positionIndexOffset);
 
                 /* Texture coordinates */
-                if(indices.size() == 2 || (indices.size() == 3 && !indices[1].empty())) {
-                    #if !defined(CORRADE_TARGET_NACL_NEWLIB) && !defined(CORRADE_TARGET_ANDROID)
-                    textureCoordinateIndices.push_back(std::stoul(indices[1]) - textureCoordinateIndexOffset);
-                    #else
-                    in.str(indices[1]);
-                    in >> index;
-                    textureCoordinateIndices.push_back(index - textureCoordinateIndexOffset);
-                    #endif
-                }
+                if(indexCount == 2 || (indexCount == 3 && indices[1].first != indices[1].second))
+                    textureCoordinateIndices.push_back(extractIndex(indices[1].first, indices[1].second) - mesh.textureCoordinateIndexOffset);
 
                 /* Normal indices */
-                if(indices.size() == 3) {
-                    #if !defined(CORRADE_TARGET_NACL_NEWLIB) && !defined(CORRADE_TARGET_ANDROID)
-                    normalIndices.push_back(std::stoul(indices[2]) - normalIndexOffset);
-                    #else
-                    in.str(indices[2]);
-                    in >> index;
-                    normalIndices.push_back(index - normalIndexOffset);
-                    #endif
-                }
+                if(indexCount == 3)
+                    normalIndices.push_back(extractIndex(indices[2].first, indices[2].second) - mesh.normalIndexOffset);
+
+                tuple = skipWhitespace(tupleEnd, lineEnd);
             }
 
         /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
+        } else if(![&lineBegin, &keywordEnd](){
             /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
+            for(const char* expected: {"mtllib", "usemtl", "g", "s"})
+                if(equals(lineBegin, keywordEnd, expected)) return true;
             return false;
         }()) {
-            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << keyword;
+            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << std::string{lineBegin, keywordEnd};
             return std::nullopt;
         }
 
-    }} catch(std::exception) {
-        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
-        return std::nullopt;
-    } catch(...) {
+    }} catch(...) {
         /* Error message already printed */
         return std::nullopt;
     }
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::ObjImporter
  */
 
+#include <vector>
+
 #include "Magnum/Trade/AbstractImporter.h"
 
 namespace Magnum { namespace Trade {
@@ -44,6 +46,23 @@ Supported features:
 Polygons (quads etc.), automatic normal generation and material properties are
 currently not supported.
 
+The file is parsed in place without any intermediate string allocations. On
+Unix systems @ref openFile() maps the file into memory instead of reading
+it, elsewhere and in case of @ref openData() the data are copied into a single
+internal buffer.
+
+## Parallel import
+
+As all mesh ranges are known after opening the file, the meshes can be
+parsed independently of each other. Use @ref meshes3D() to import many meshes
+at once on a pool of worker threads:
+@code
+Trade::ObjImporter importer;
+importer.openFile("scan.obj");
+
+std::vector<std::optional<Trade::MeshData3D>> meshes = importer.meshes3D();
+@endcode
+
 This plugin is built if `WITH_OBJIMPORTER` is enabled when building Magnum. To
 use dynamic plugin, you need to load `ObjImporter` plugin from
 `MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a dependency
@@ -61,6 +80,21 @@ class ObjImporter: public AbstractImporter {
 
         ~ObjImporter();
 
+        /**
+         * @brief Import more meshes in parallel
+         * @param ids           IDs of meshes to import. If empty, all meshes
+         *      in the file are imported.
+         * @param threadCount   If `1`, the meshes are imported on the calling
+         *      thread only, otherwise on all workers of
+         *      @ref TaskScheduler::global().
+         *
+         * Returns one item for each ID in @p ids, in the same order. Meshes
+         * that fail to import are @ref std::nullopt, same as with
+         * @ref mesh3D(). The import is serial on platforms without thread
+         * support.
+         */
+        std::vector<std::optional<MeshData3D>> meshes3D(std::vector<UnsignedInt> ids = {}, UnsignedInt threadCount = 0);
+
     private:
         struct File;
 
@@ -77,6 +111,7 @@ class ObjImporter: public AbstractImporter {
         std::optional<MeshData3D> doMesh3D(UnsignedInt id) override;
 
         void parseMeshNames();
+        std::optional<MeshData3D> parseMesh(UnsignedInt id) const;
 
         std::unique_ptr<File> _file;
 };
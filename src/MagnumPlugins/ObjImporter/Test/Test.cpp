@@ -55,7 +55,12 @@ class ObjImporterTest: public TestSuite::Tester {
         void namedMesh();
         void moreMeshes();
         void unnamedFirstMesh();
+        void openData();
+        void parallel();
+        void parallelSubset();
+        void parallelFailed();
 
+        void numberFormats();
         void wrongFloat();
         void wrongInteger();
         void unmergedIndexOutOfRange();
@@ -107,7 +112,12 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::namedMesh,
               &ObjImporterTest::moreMeshes,
               &ObjImporterTest::unnamedFirstMesh,
+              &ObjImporterTest::openData,
+              &ObjImporterTest::parallel,
+              &ObjImporterTest::parallelSubset,
+              &ObjImporterTest::parallelFailed,
 
+              &ObjImporterTest::numberFormats,
               &ObjImporterTest::wrongFloat,
               &ObjImporterTest::wrongInteger,
               &ObjImporterTest::unmergedIndexOutOfRange,
@@ -399,6 +409,93 @@ void ObjImporterTest::unnamedFirstMesh() {
     CORRADE_COMPARE(importer.mesh3DForName("SecondMesh"), 1);
 }
 
+void ObjImporterTest::openData() {
+    ObjImporter importer;
+
+    /* The data don't need to be kept in scope after opening */
+    {
+        const std::string data = "o First\nv 0 1 2\np 1\n\no Second\r\nv 1 2 3\r\np 2\r\n";
+        CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+    }
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    CORRADE_COMPARE(importer.mesh3DName(0), "First");
+    const std::optional<MeshData3D> data = importer.mesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->positions(0), (std::vector<Vector3>{{0.0f, 1.0f, 2.0f}}));
+    CORRADE_COMPARE(data->indices(), std::vector<UnsignedInt>{0});
+
+    /* Windows line endings are trimmed */
+    CORRADE_COMPARE(importer.mesh3DName(1), "Second");
+    const std::optional<MeshData3D> data1 = importer.mesh3D(1);
+    CORRADE_VERIFY(data1);
+    CORRADE_COMPARE(data1->positions(0), (std::vector<Vector3>{{1.0f, 2.0f, 3.0f}}));
+    CORRADE_COMPARE(data1->indices(), std::vector<UnsignedInt>{0});
+}
+
+void ObjImporterTest::parallel() {
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj")));
+
+    /* More threads than meshes */
+    std::vector<std::optional<MeshData3D>> meshes = importer.meshes3D({}, 8);
+    CORRADE_COMPARE(meshes.size(), 3);
+
+    /* The result should be the same as when importing serially */
+    for(UnsignedInt i = 0; i != meshes.size(); ++i) {
+        std::optional<MeshData3D> expected = importer.mesh3D(i);
+        CORRADE_VERIFY(expected);
+        CORRADE_VERIFY(meshes[i]);
+        CORRADE_COMPARE(meshes[i]->primitive(), expected->primitive());
+        CORRADE_COMPARE(meshes[i]->indices(), expected->indices());
+        CORRADE_COMPARE(meshes[i]->positions(0), expected->positions(0));
+    }
+}
+
+void ObjImporterTest::parallelSubset() {
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj")));
+
+    std::vector<std::optional<MeshData3D>> meshes = importer.meshes3D({2, 0, 2});
+    CORRADE_COMPARE(meshes.size(), 3);
+    CORRADE_VERIFY(meshes[0]);
+    CORRADE_COMPARE(meshes[0]->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(meshes[1]);
+    CORRADE_COMPARE(meshes[1]->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(meshes[2]);
+    CORRADE_COMPARE(meshes[2]->indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 2, 1, 0
+    }));
+}
+
+void ObjImporterTest::parallelFailed() {
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "wrongNumbers.obj")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    std::vector<std::optional<MeshData3D>> meshes = importer.meshes3D({}, 1);
+    CORRADE_COMPARE(meshes.size(), 5);
+    for(const std::optional<MeshData3D>& mesh: meshes)
+        CORRADE_VERIFY(!mesh);
+}
+
+void ObjImporterTest::numberFormats() {
+    ObjImporter importer;
+    const std::string data = "v -1.5 +0.25 .5\nv 1e2 2.5E-1 -3.e1\nv 0.000001 123456789 7.\n"
+                             "p 1\np 3\t \n";
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    const std::optional<MeshData3D> mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {-1.5f, 0.25f, 0.5f},
+        {100.0f, 0.25f, -30.0f},
+        {0.000001f, 123456789.0f, 7.0f}
+    }));
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 2}));
+}
+
 void ObjImporterTest::wrongFloat() {
     ObjImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "wrongNumbers.obj")));
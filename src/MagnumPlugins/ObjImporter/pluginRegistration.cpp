@@ -26,4 +26,4 @@
 #include "MagnumPlugins/ObjImporter/ObjImporter.h"
 
 CORRADE_PLUGIN_REGISTER(ObjImporter, Magnum::Trade::ObjImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
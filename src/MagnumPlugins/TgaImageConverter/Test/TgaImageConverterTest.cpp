@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <tuple>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -49,6 +50,14 @@ class TgaImageConverterTest: public TestSuite::Tester {
 
         void rgb();
         void rgba();
+        void rgbRle();
+        void rgbaRle();
+        void grayscaleRle();
+
+        void exportToFile();
+        void exportToFileRle();
+        void exportToFileDirect();
+        void appendRows();
 };
 
 namespace {
@@ -83,7 +92,15 @@ TgaImageConverterTest::TgaImageConverterTest() {
               &TgaImageConverterTest::wrongType,
 
               &TgaImageConverterTest::rgb,
-              &TgaImageConverterTest::rgba});
+              &TgaImageConverterTest::rgba,
+              &TgaImageConverterTest::rgbRle,
+              &TgaImageConverterTest::rgbaRle,
+              &TgaImageConverterTest::grayscaleRle,
+
+              &TgaImageConverterTest::exportToFile,
+              &TgaImageConverterTest::exportToFileRle,
+              &TgaImageConverterTest::exportToFileDirect,
+              &TgaImageConverterTest::appendRows});
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -156,6 +173,154 @@ void TgaImageConverterTest::rgba() {
         TestSuite::Compare::Container);
 }
 
+void TgaImageConverterTest::rgbRle() {
+    TgaImageConverter converter;
+    CORRADE_VERIFY(!converter.rleCompression());
+    converter.setRleCompression(true);
+    const auto data = converter.exportToData(OriginalRGB);
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGB);
+    CORRADE_COMPARE_AS(converted->data(), Containers::ArrayView<const char>{ConvertedDataRGB},
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rgbaRle() {
+    /* Runs of 130 pixels each row, long enough to need two packets */
+    std::vector<char> original;
+    for(char y = 0; y != 3; ++y) for(std::size_t x = 0; x != 130; ++x)
+        original.insert(original.end(), {y, 2, 3, 4});
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {130, 3}, original.data()};
+
+    const auto data = TgaImageConverter().setRleCompression(true).exportToData(image);
+
+    /* Header and two run-length packets for each row */
+    CORRADE_COMPARE(data.size(), 18 + 3*2*(1 + 4));
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(130, 3));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE_AS(converted->data(), Containers::ArrayView<const char>(original.data(), original.size()),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::grayscaleRle() {
+    constexpr char original[] = {
+        1, 2, 2, 3, 3, 3, 3, 0,
+        4, 4, 4, 5, 6, 7, 7, 0
+    };
+    const ImageView2D image{
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        PixelFormat::Red,
+        #else
+        PixelFormat::Luminance,
+        #endif
+        PixelType::UnsignedByte, {7, 2}, original};
+
+    const auto data = TgaImageConverter().setRleCompression(true).exportToData(image);
+
+    /* Single-byte runs shorter than three pixels are stored raw */
+    const char expected[] = {
+        '\x02', 1, 2, 2, '\x83', 3,
+        '\x82', 4, '\x03', 5, 6, 7, 7
+    };
+    CORRADE_COMPARE(data[2], 11);
+    CORRADE_COMPARE_AS(data.suffix(18), Containers::ArrayView<const char>{expected},
+        TestSuite::Compare::Container);
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(7, 2));
+}
+
+void TgaImageConverterTest::exportToFile() {
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_DIR, "image.tga");
+    Utility::Directory::rm(filename);
+
+    /* The streamed file should be the same as the data exported at once */
+    TgaImageConverter converter;
+    CORRADE_VERIFY(converter.exportToFile(OriginalRGB, filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter.exportToData(OriginalRGB),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::exportToFileRle() {
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_DIR, "image-rle.tga");
+    Utility::Directory::rm(filename);
+
+    /* Rows longer than 16 bytes to test the vectorized path as well */
+    std::vector<char> original;
+    for(char y = 0; y != 3; ++y) for(char x = 0; x != 130; ++x)
+        original.insert(original.end(), {y, char(x/4), 3, 4});
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {130, 3}, original.data()};
+
+    TgaImageConverter converter;
+    converter.setRleCompression(true);
+    CORRADE_VERIFY(converter.exportToFile(image, filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter.exportToData(image),
+        TestSuite::Compare::Container);
+
+    TgaImporter importer;
+    CORRADE_VERIFY(importer.openFile(filename));
+    std::optional<Trade::ImageData2D> converted = importer.image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE_AS(converted->data(), Containers::ArrayView<const char>(original.data(), original.size()),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::exportToFileDirect() {
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_DIR, "image-direct.tga");
+    Utility::Directory::rm(filename);
+
+    /* Larger than the direct write alignment, so there's an unaligned rest
+       written at the end. Falls back to buffered write if the filesystem
+       doesn't support it. */
+    std::vector<char> original(67*45*3);
+    for(std::size_t i = 0; i != original.size(); ++i) original[i] = char(i*7);
+    const ImageView2D image{PixelStorage{}.setAlignment(1),
+        PixelFormat::RGB, PixelType::UnsignedByte, {67, 45}, original.data()};
+
+    TgaImageConverter converter;
+    CORRADE_VERIFY(!converter.directWrite());
+    converter.setDirectWrite(true);
+    CORRADE_VERIFY(converter.exportToFile(image, filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter.exportToData(image),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::appendRows() {
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_DIR, "image-rows.tga");
+    Utility::Directory::rm(filename);
+
+    /* First row and then the remaining two, the file should be the same as
+       when exported at once */
+    TgaImageConverter converter;
+    CORRADE_VERIFY(converter.beginFile(filename, PixelFormat::RGB, PixelType::UnsignedByte, {2, 3}));
+    CORRADE_VERIFY(converter.appendRows(ImageView2D{PixelStorage{}.setSkip({0, 1, 0}),
+        PixelFormat::RGB, PixelType::UnsignedByte, {2, 1}, OriginalDataRGB}));
+    CORRADE_VERIFY(converter.appendRows(ImageView2D{PixelStorage{}.setSkip({0, 2, 0}),
+        PixelFormat::RGB, PixelType::UnsignedByte, {2, 2}, OriginalDataRGB}));
+    CORRADE_VERIFY(converter.endFile());
+
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter.exportToData(OriginalRGB),
+        TestSuite::Compare::Container);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
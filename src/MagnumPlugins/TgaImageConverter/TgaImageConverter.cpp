@@ -26,62 +26,82 @@
 #include "TgaImageConverter.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/Image.h"
+#include "Magnum/PixelConversion.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
-namespace Magnum { namespace Trade {
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_TARGET_NACL)
+#define MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-TgaImageConverter::TgaImageConverter() = default;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_TGAIMAGECONVERTER_USE_SSE2
+#endif
 
-TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImageConverter(manager, std::move(plugin)) {}
+namespace Magnum { namespace Trade {
 
-auto TgaImageConverter::doFeatures() const -> Features { return Feature::ConvertData; }
+namespace {
 
-Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
-    #ifndef MAGNUM_TARGET_GLES
-    if(image.storage().swapBytes()) {
-        Error() << "Trade::TgaImageConverter::exportToData(): pixel byte swap is not supported";
-        return nullptr;
-    }
-    #endif
+/* Size of the write buffer in exportToFile(). Large enough to not make the
+   syscall overhead significant, small enough to not matter next to the image
+   itself. */
+constexpr std::size_t WriteBufferSize = 4*1024*1024;
+
+/* Alignment of buffer address, file offset and write size for O_DIRECT */
+constexpr std::size_t DirectWriteAlignment = 4096;
 
-    if(image.format() != PixelFormat::RGB &&
-       image.format() != PixelFormat::RGBA
+bool checkFormat(const PixelFormat format, const PixelType type, const char* const prefix) {
+    if(format != PixelFormat::RGB &&
+       format != PixelFormat::RGBA
        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-       && image.format() != PixelFormat::Red
+       && format != PixelFormat::Red
        #endif
        #ifdef MAGNUM_TARGET_GLES2
-       && image.format() != PixelFormat::Luminance
+       && format != PixelFormat::Luminance
        #endif
        )
     {
-        Error() << "Trade::TgaImageConverter::exportToData(): unsupported color format" << image.format();
-        return nullptr;
+        Error() << prefix << "unsupported color format" << format;
+        return false;
     }
 
-    if(image.type() != PixelType::UnsignedByte) {
-        Error() << "Trade::TgaImageConverter::exportToData(): unsupported color type" << image.type();
-        return nullptr;
+    if(type != PixelType::UnsignedByte) {
+        Error() << prefix << "unsupported color type" << type;
+        return false;
     }
 
-    /* Initialize data buffer */
-    const auto pixelSize = UnsignedByte(image.pixelSize());
-    Containers::Array<char> data{Containers::ValueInit, sizeof(TgaHeader) + pixelSize*image.size().product()};
+    return true;
+}
 
-    /* Fill header */
-    auto header = reinterpret_cast<TgaHeader*>(data.begin());
-    switch(image.format()) {
+bool checkImage(const ImageView2D& image, const char* const prefix) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(image.storage().swapBytes()) {
+        Error() << prefix << "pixel byte swap is not supported";
+        return false;
+    }
+    #endif
+
+    return checkFormat(image.format(), image.type(), prefix);
+}
+
+TgaHeader headerFor(const PixelFormat format, const std::size_t pixelSize, const Vector2i& size, const bool rle) {
+    TgaHeader header{};
+    switch(format) {
         case PixelFormat::RGB:
         case PixelFormat::RGBA:
-            header->imageType = 2;
+            header.imageType = 2;
             break;
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         case PixelFormat::Red:
@@ -89,36 +109,360 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
         #ifdef MAGNUM_TARGET_GLES2
         case PixelFormat::Luminance:
         #endif
-            header->imageType = 3;
+            header.imageType = 3;
             break;
         default: CORRADE_ASSERT_UNREACHABLE();
     }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    if(rle) header.imageType |= 8;
+    header.bpp = pixelSize*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(size.x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(size.y()));
+    return header;
+}
+
+/* Copies one row of pixels, swapping the red and blue channel of RGB and RGBA
+   pixels */
+void copyRow(const char* const from, char* const to, const std::size_t size, const PixelFormat format) {
+    if(format == PixelFormat::RGB || format == PixelFormat::RGBA)
+        convertPixels(format, PixelType::UnsignedByte, {from, size}, format, PixelType::UnsignedByte, {to, size}, PixelConversionFlag::SwapRedBlue);
+    else std::copy_n(from, size, to);
+}
+
+/* Buffered file output. The buffer is aligned and with direct writes only
+   whole aligned blocks are written until the final flush, which writes the
+   rest with O_DIRECT disabled. */
+class FileWriter {
+    public:
+        explicit FileWriter(const std::string& filename, std::size_t minCapacity, bool direct);
+
+        ~FileWriter();
+
+        bool isOpened() const;
+
+        /* Space for at most `size` bytes, flushing the buffer first if needed.
+           Returns nullptr if a previous write failed. */
+        char* reserve(std::size_t size);
+
+        /* Mark `size` bytes in the reserved space as used */
+        void commit(std::size_t size) { _size += size; }
+
+        /* Writes the rest of the buffer, returns false if any write failed */
+        bool finish();
+
+    private:
+        bool write(std::size_t size);
+
+        Containers::Array<char> _storage;
+        char* _buffer;
+        std::size_t _capacity, _size{};
+        bool _direct, _failed{};
+        #ifdef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+        int _fd;
+        #else
+        std::ofstream _file;
+        #endif
+};
+
+FileWriter::FileWriter(const std::string& filename, const std::size_t minCapacity, bool direct): _capacity{(std::max(WriteBufferSize, minCapacity + DirectWriteAlignment) + DirectWriteAlignment - 1)/DirectWriteAlignment*DirectWriteAlignment} {
+    #ifdef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+    /* Not all filesystems support O_DIRECT, fall back to buffered I/O there */
+    #ifdef O_DIRECT
+    _fd = direct ? ::open(filename.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_DIRECT, 0666) : -1;
+    if(_fd == -1)
+    #endif
+    {
+        direct = false;
+        _fd = ::open(filename.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    }
+    #else
+    direct = false;
+    _file.open(filename, std::ofstream::binary);
+    #endif
+    _direct = direct;
+
+    _storage = Containers::Array<char>{_capacity + DirectWriteAlignment};
+    _buffer = _storage + (DirectWriteAlignment - reinterpret_cast<std::uintptr_t>(_storage.data()) % DirectWriteAlignment) % DirectWriteAlignment;
+}
+
+FileWriter::~FileWriter() {
+    #ifdef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+    if(_fd != -1) ::close(_fd);
+    #endif
+}
+
+bool FileWriter::isOpened() const {
+    #ifdef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+    return _fd != -1;
+    #else
+    return _file.good();
+    #endif
+}
+
+bool FileWriter::write(const std::size_t size) {
+    #ifdef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+    for(std::size_t written = 0; written != size; ) {
+        const ssize_t result = ::write(_fd, _buffer + written, size - written);
+        if(result == -1 && errno == EINTR) continue;
+        if(result <= 0) return false;
+        written += result;
+    }
+    return true;
+    #else
+    return bool(_file.write(_buffer, size));
+    #endif
+}
+
+char* FileWriter::reserve(const std::size_t size) {
+    if(_failed) return nullptr;
+    if(_size + size <= _capacity) return _buffer + _size;
+
+    /* With direct writes keep the unaligned rest for the next time */
+    const std::size_t flushSize = _direct ? _size/DirectWriteAlignment*DirectWriteAlignment : _size;
+    if(!write(flushSize)) {
+        _failed = true;
+        return nullptr;
+    }
+    std::memmove(_buffer, _buffer + flushSize, _size - flushSize);
+    _size -= flushSize;
+    return _buffer + _size;
+}
+
+bool FileWriter::finish() {
+    if(_failed) return false;
+
+    #if defined(MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO) && defined(O_DIRECT)
+    if(_direct) {
+        const std::size_t flushSize = _size/DirectWriteAlignment*DirectWriteAlignment;
+        if(!write(flushSize)) return false;
+        std::memmove(_buffer, _buffer + flushSize, _size - flushSize);
+        _size -= flushSize;
+        if(::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) & ~O_DIRECT) == -1)
+            return false;
+    }
+    #endif
+
+    if(!write(_size)) return false;
+    _size = 0;
+
+    #ifndef MAGNUM_TGAIMAGECONVERTER_USE_POSIX_IO
+    _file.flush();
+    return _file.good();
+    #else
+    return true;
+    #endif
+}
+
+/* Returns count of pixels at the beginning of given data equal to the first
+   one, at most `maxCount`. A pixel is equal to the next one if all its bytes
+   are equal to bytes `pixelSize` further, so it's enough to find the first
+   byte that differs from the byte `pixelSize` further. */
+std::size_t runLength(const char* const data, const std::size_t maxCount, const std::size_t pixelSize) {
+    const std::size_t size = (maxCount - 1)*pixelSize;
+    std::size_t i = 0;
+    #ifdef MAGNUM_TGAIMAGECONVERTER_USE_SSE2
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + pixelSize));
+        const UnsignedInt mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xffff;
+        if(mask) {
+            std::size_t first = 0;
+            while(!(mask & (1 << first))) ++first;
+            return (i + first)/pixelSize + 1;
+        }
+    }
+    #endif
+    for(; i != size; ++i)
+        if(data[i] != data[i + pixelSize]) break;
+    return i/pixelSize + 1;
+}
+
+/* Encodes one row of pixels, returns pointer after the last written byte. For
+   single-byte pixels a run of two isn't any shorter than raw data and it would
+   only split the raw packet, so the runs need to be at least three pixels
+   long. That way the output is never larger than one packet header per 128
+   pixels. */
+char* encodeRle(const char* in, const std::size_t pixelCount, const std::size_t pixelSize, char* out) {
+    const std::size_t minRun = pixelSize == 1 ? 3 : 2;
+    const char* const end = in + pixelCount*pixelSize;
+    while(in != end) {
+        const std::size_t remaining = (end - in)/pixelSize;
+        const std::size_t run = runLength(in, std::min<std::size_t>(remaining, 128), pixelSize);
+
+        /* Run-length packet */
+        if(run >= minRun) {
+            *out++ = char(0x80|(run - 1));
+            out = std::copy_n(in, pixelSize, out);
+            in += run*pixelSize;
+            continue;
+        }
+
+        /* Raw packet, until the next run worth encoding */
+        std::size_t count = run;
+        while(count < std::min<std::size_t>(remaining, 128) &&
+            runLength(in + count*pixelSize, std::min(remaining - count, minRun), pixelSize) < minRun)
+            ++count;
+        *out++ = char(count - 1);
+        out = std::copy_n(in, count*pixelSize, out);
+        in += count*pixelSize;
+    }
+
+    return out;
+}
+
+}
+
+struct TgaImageConverter::File {
+    explicit File(const std::string& filename, std::size_t minCapacity, bool direct): writer{filename, minCapacity, direct} {}
+
+    FileWriter writer;
+    std::string filename;
+    PixelFormat format;
+    PixelType type;
+    Vector2i size;
+    std::size_t maxRowSize;
+    Int rowsWritten{};
+    bool rle;
+    Containers::Array<char> row;
+};
+
+TgaImageConverter::TgaImageConverter(): _rle{false}, _directWrite{false} {}
+
+TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImageConverter(manager, std::move(plugin)), _rle{false}, _directWrite{false} {}
+
+TgaImageConverter::~TgaImageConverter() = default;
+
+auto TgaImageConverter::doFeatures() const -> Features { return Feature::ConvertData; }
+
+Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
+    if(!checkImage(image, "Trade::TgaImageConverter::exportToData():"))
+        return nullptr;
+
+    /* Initialize data buffer */
+    const auto pixelSize = UnsignedByte(image.pixelSize());
+    Containers::Array<char> data{Containers::ValueInit, sizeof(TgaHeader) + pixelSize*image.size().product()};
+
+    /* Fill header */
+    *reinterpret_cast<TgaHeader*>(data.begin()) = headerFor(image.format(), pixelSize, image.size(), _rle);
 
     /* Image data pointer including skip */
     const char* imageData = image.data() + std::get<0>(image.dataProperties()).sum();
 
-    /* Fill data or copy them row by row if we need to drop the padding */
+    /* Copy the data row by row, dropping the padding and swizzling the
+       channels */
     const std::size_t rowSize = image.size().x()*pixelSize;
     const std::size_t rowStride = std::get<1>(image.dataProperties()).x();
-    if(rowStride != rowSize) {
-        for(std::int_fast32_t y = 0; y != image.size().y(); ++y)
-            std::copy_n(imageData + y*rowStride, rowSize, data.begin() + sizeof(TgaHeader) + y*rowSize);
-    } else std::copy_n(imageData, pixelSize*image.size().product(), data.begin() + sizeof(TgaHeader));
-
-    if(image.format() == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(image.format() == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
+    for(std::int_fast32_t y = 0; y != image.size().y(); ++y)
+        copyRow(imageData + y*rowStride, data.begin() + sizeof(TgaHeader) + y*rowSize, rowSize, image.format());
+
+    if(!_rle) return data;
+
+    /* Compress the data row by row. In the worst case there is one packet
+       header for each 128 pixels. */
+    const std::size_t packetCount = (image.size().x() + 127)/128*image.size().y();
+    Containers::Array<char> compressed{sizeof(TgaHeader) + pixelSize*image.size().product() + packetCount};
+    std::copy_n(data.begin(), sizeof(TgaHeader), compressed.begin());
+    char* out = compressed.begin() + sizeof(TgaHeader);
+    for(std::int_fast32_t y = 0; y != image.size().y(); ++y)
+        out = encodeRle(data.begin() + sizeof(TgaHeader) + y*rowSize, image.size().x(), pixelSize, out);
+
+    /* Copy to an array of the final size */
+    Containers::Array<char> result{std::size_t(out - compressed.begin())};
+    std::copy(compressed.begin(), out, result.begin());
+    return result;
+}
+
+bool TgaImageConverter::doExportToFile(const ImageView2D& image, const std::string& filename) {
+    if(!checkImage(image, "Trade::TgaImageConverter::exportToFile():"))
+        return false;
+
+    return beginFile(filename, image.format(), image.type(), image.size()) &&
+        appendRows(image) && endFile();
+}
+
+bool TgaImageConverter::beginFile(const std::string& filename, const PixelFormat format, const PixelType type, const Vector2i& size) {
+    _file = nullptr;
+    if(!checkFormat(format, type, "Trade::TgaImageConverter::beginFile():"))
+        return false;
+
+    /* In the worst case there is one RLE packet header for each 128 pixels */
+    const std::size_t pixelSize = PixelStorage::pixelSize(format, type);
+    const std::size_t rowSize = size.x()*pixelSize;
+    const std::size_t maxRowSize = _rle ? rowSize + (size.x() + 127)/128 : rowSize;
+
+    std::unique_ptr<File> file{new File{filename, std::max(maxRowSize, sizeof(TgaHeader)), _directWrite}};
+    if(!file->writer.isOpened()) {
+        Error() << "Trade::TgaImageConverter::beginFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    file->filename = filename;
+    file->format = format;
+    file->type = type;
+    file->size = size;
+    file->maxRowSize = maxRowSize;
+    file->rle = _rle;
+    if(_rle) file->row = Containers::Array<char>{rowSize};
+
+    const TgaHeader header = headerFor(format, pixelSize, size, _rle);
+    std::copy_n(reinterpret_cast<const char*>(&header), sizeof(TgaHeader), file->writer.reserve(sizeof(TgaHeader)));
+    file->writer.commit(sizeof(TgaHeader));
+
+    _file = std::move(file);
+    return true;
+}
+
+bool TgaImageConverter::appendRows(const ImageView2D& rows) {
+    CORRADE_ASSERT(_file,
+        "Trade::TgaImageConverter::appendRows(): no file opened", false);
+    CORRADE_ASSERT(rows.format() == _file->format && rows.type() == _file->type && rows.size().x() == _file->size.x(),
+        "Trade::TgaImageConverter::appendRows(): expected" << _file->format << _file->type << "rows" << _file->size.x() << "pixels wide but got" << rows.format() << rows.type() << rows.size().x(), false);
+    CORRADE_ASSERT(_file->rowsWritten + rows.size().y() <= _file->size.y(),
+        "Trade::TgaImageConverter::appendRows(): can't append" << rows.size().y() << "rows to" << _file->rowsWritten << "out of" << _file->size.y(), false);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!rows.storage().swapBytes(),
+        "Trade::TgaImageConverter::appendRows(): pixel byte swap is not supported", false);
+    #endif
+
+    /* Swizzle the rows directly into the write buffer, with RLE they need to
+       go through a row-sized temporary first */
+    const std::size_t pixelSize = rows.pixelSize();
+    const std::size_t rowSize = rows.size().x()*pixelSize;
+    const char* data = rows.data() + std::get<0>(rows.dataProperties()).sum();
+    const std::size_t rowStride = std::get<1>(rows.dataProperties()).x();
+    for(std::int_fast32_t y = 0; y != rows.size().y(); ++y) {
+        char* const out = _file->writer.reserve(_file->maxRowSize);
+        if(!out) {
+            Error() << "Trade::TgaImageConverter::appendRows(): cannot write to file" << _file->filename;
+            _file = nullptr;
+            return false;
+        }
+
+        if(_file->rle) {
+            copyRow(data + y*rowStride, _file->row, rowSize, rows.format());
+            _file->writer.commit(encodeRle(_file->row, rows.size().x(), pixelSize, out) - out);
+        } else {
+            copyRow(data + y*rowStride, out, rowSize, rows.format());
+            _file->writer.commit(rowSize);
+        }
+    }
+
+    _file->rowsWritten += rows.size().y();
+    return true;
+}
+
+bool TgaImageConverter::endFile() {
+    CORRADE_ASSERT(_file,
+        "Trade::TgaImageConverter::endFile(): no file opened", false);
+    CORRADE_ASSERT(_file->rowsWritten == _file->size.y(),
+        "Trade::TgaImageConverter::endFile(): expected" << _file->size.y() << "rows but got" << _file->rowsWritten, false);
+
+    const std::unique_ptr<File> file = std::move(_file);
+    if(!file->writer.finish()) {
+        Error() << "Trade::TgaImageConverter::endFile(): cannot write to file" << file->filename;
+        return false;
     }
 
-    return data;
+    return true;
 }
 
 }}
@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::Trade::TgaImageConverter
  */
 
+#include <memory>
+#include <string>
+
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #include "MagnumPlugins/TgaImageConverter/configure.h"
@@ -54,7 +57,26 @@ namespace Magnum { namespace Trade {
 Supports images with format @ref PixelFormat::RGB, @ref PixelFormat::RGBA or
 @ref PixelFormat::Red (or @ref PixelFormat::Luminance in OpenGL ES 2.0 and
 WebGL 1.0) and type @ref PixelType::UnsignedByte. Does *not* support
-non-default @ref PixelStorage::swapBytes() values.
+non-default @ref PixelStorage::swapBytes() values. The data are saved
+uncompressed by default, RLE compression can be enabled using
+@ref setRleCompression().
+
+@ref exportToFile() doesn't build the whole file in memory. The header is
+written first and then the rows are swizzled into a reusable buffer of a few
+megabytes and written as it fills up, so even huge images can be saved with
+just a small constant memory overhead. On Linux, @ref setDirectWrite() can
+additionally bypass the page cache.
+
+If even the image itself doesn't fit into memory, the file can be written
+piece by piece using @ref beginFile(), @ref appendRows() and @ref endFile(),
+for example from @ref DebugTools::renderTiled():
+@code
+Trade::TgaImageConverter converter;
+converter.beginFile("capture.tga", PixelFormat::RGB, PixelType::UnsignedByte, size);
+DebugTools::renderTiled(framebuffer, size, PixelFormat::RGB, PixelType::UnsignedByte,
+    draw, [&](const ImageView2D& rows) { return converter.appendRows(rows); });
+converter.endFile();
+@endcode
 
 This plugin is built if `WITH_TGAIMAGECONVERTER` is enabled when building
 Magnum. To use dynamic plugin, you need to load `TgaImageConverter` plugin
@@ -71,9 +93,81 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
         /** @brief Plugin manager constructor */
         explicit TgaImageConverter(PluginManager::AbstractManager& manager, std::string plugin);
 
+        ~TgaImageConverter();
+
+        /** @brief Whether RLE compression is enabled */
+        bool rleCompression() const { return _rle; }
+
+        /**
+         * @brief Enable or disable RLE compression
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the images are saved as RLE-compressed TGA files (image
+         * type 10 or 11). Runs never cross scanline boundaries. Default is
+         * `false`.
+         */
+        TgaImageConverter& setRleCompression(bool enabled) {
+            _rle = enabled;
+            return *this;
+        }
+
+        /** @brief Whether direct write is enabled */
+        bool directWrite() const { return _directWrite; }
+
+        /**
+         * @brief Enable or disable direct write
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref exportToFile() opens the file with `O_DIRECT`,
+         * so saving huge images doesn't evict everything else from the page
+         * cache. Has no effect on platforms or filesystems that don't support
+         * it. Default is `false`.
+         */
+        TgaImageConverter& setDirectWrite(bool enabled) {
+            _directWrite = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Begin writing a file piece by piece
+         *
+         * Checks the format, opens the file and writes the header. Use
+         * @ref appendRows() to write the pixel data from bottom to top and
+         * @ref endFile() to finish the file. The RLE compression and direct
+         * write setting is taken at the time this function is called. Any
+         * file that wasn't finished yet is discarded, the same happens when
+         * calling @ref exportToFile(). Returns `true` on success, `false`
+         * otherwise.
+         */
+        bool beginFile(const std::string& filename, PixelFormat format, PixelType type, const Vector2i& size);
+
+        /**
+         * @brief Append rows to a file
+         *
+         * Expects that @ref beginFile() was called, that @p rows have the
+         * same format, type and width as passed to it and that the total row
+         * count doesn't exceed the image height. Returns `true` on success,
+         * `false` if writing failed, in which case the file is discarded.
+         */
+        bool appendRows(const ImageView2D& rows);
+
+        /**
+         * @brief Finish a file
+         *
+         * Expects that @ref beginFile() was called and all rows were
+         * appended. Returns `true` on success, `false` if writing failed.
+         */
+        bool endFile();
+
     private:
+        struct File;
+
         Features MAGNUM_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
         Containers::Array<char> MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToData(const ImageView2D& image) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToFile(const ImageView2D& image, const std::string& filename) override;
+
+        bool _rle, _directWrite;
+        std::unique_ptr<File> _file;
 };
 
 }}
@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -43,31 +44,45 @@ class TgaImporterTest: public TestSuite::Tester {
 
         void openNonexistent();
         void openShort();
+        void openShortData();
         void paletted();
         void compressed();
 
         void colorBits16();
         void colorBits24();
         void colorBits32();
+        void colorBits24Large();
+        void colorBits32Large();
 
         void grayscaleBits8();
         void grayscaleBits16();
 
+        void colorRle();
+        void grayscaleRle();
+        void rleTruncated();
+
         void useTwice();
 };
 
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openShort,
+              &TgaImporterTest::openShortData,
               &TgaImporterTest::paletted,
               &TgaImporterTest::compressed,
 
               &TgaImporterTest::colorBits16,
               &TgaImporterTest::colorBits24,
               &TgaImporterTest::colorBits32,
+              &TgaImporterTest::colorBits24Large,
+              &TgaImporterTest::colorBits32Large,
 
               &TgaImporterTest::grayscaleBits8,
               &TgaImporterTest::grayscaleBits16,
 
+              &TgaImporterTest::colorRle,
+              &TgaImporterTest::grayscaleRle,
+              &TgaImporterTest::rleTruncated,
+
               &TgaImporterTest::useTwice});
 }
 
@@ -82,6 +97,20 @@ void TgaImporterTest::openShort() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 17 bytes\n");
 }
 
+void TgaImporterTest::openShortData() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        1, 2, 3, 2, 3, 4
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 24 bytes, expected 36\n");
+}
+
 void TgaImporterTest::paletted() {
     TgaImporter importer;
     const char data[] = { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -165,6 +194,45 @@ void TgaImporterTest::colorBits32() {
         TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::colorBits24Large() {
+    /* Enough pixels to go through both the SIMD and the scalar code path */
+    TgaImporter importer;
+    std::vector<char> data{0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 3, 0, 24, 0};
+    std::vector<char> pixels;
+    for(char i = 0; i != 7*3; ++i) {
+        data.insert(data.end(), {char(i + 2), char(i + 1), i});
+        pixels.insert(pixels.end(), {i, char(i + 1), char(i + 2)});
+    }
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(7, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::ArrayView<const char>(pixels.data(), pixels.size()),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::colorBits32Large() {
+    TgaImporter importer;
+    std::vector<char> data{0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 3, 0, 32, 0};
+    std::vector<char> pixels;
+    for(char i = 0; i != 5*3; ++i) {
+        data.insert(data.end(), {char(i + 2), char(i + 1), i, char(i + 3)});
+        pixels.insert(pixels.end(), {i, char(i + 1), char(i + 2), char(i + 3)});
+    }
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->size(), Vector2i(5, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::ArrayView<const char>(pixels.data(), pixels.size()),
+        TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::grayscaleBits8() {
     TgaImporter importer;
     const char data[] = {
@@ -200,20 +268,84 @@ void TgaImporterTest::grayscaleBits16() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel: 16\n");
 }
 
+void TgaImporterTest::colorRle() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        /* Run of three pixels */
+        '\x82', 1, 2, 3,
+        /* Three raw pixels */
+        '\x02', 3, 4, 5, 4, 5, 6, 5, 6, 7
+    };
+    const char pixels[] = {
+        3, 2, 1, 3, 2, 1,
+        3, 2, 1, 5, 4, 3,
+        6, 5, 4, 7, 6, 5
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(image->data(), Containers::ArrayView<const char>{pixels},
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::grayscaleRle() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        /* Two raw pixels, run of four pixels */
+        1, 1, 2, '\x83', 3
+    };
+    const char pixels[] = { 1, 2, 3, 3, 3, 3 };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image->format(), PixelFormat::Red);
+    #else
+    CORRADE_COMPARE(image->format(), PixelFormat::Luminance);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::ArrayView<const char>{pixels},
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleTruncated() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        '\x82', 1, 2, 3
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the RLE-compressed data are truncated\n");
+}
+
 void TgaImporterTest::useTwice() {
     TgaImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
 
-    /* Verify that the file is rewinded for second use */
-    {
-        std::optional<Trade::ImageData2D> image = importer.image2D(0);
-        CORRADE_VERIFY(image);
-        CORRADE_COMPARE(image->size(), (Vector2i{2, 3}));
-    } {
-        std::optional<Trade::ImageData2D> image = importer.image2D(0);
-        CORRADE_VERIFY(image);
-        CORRADE_COMPARE(image->size(), (Vector2i{2, 3}));
-    }
+    /* Verify that the file is rewinded for second use and that the in-place
+       conversion of the first image doesn't affect the second */
+    std::optional<Trade::ImageData2D> first = importer.image2D(0);
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(first->size(), (Vector2i{2, 3}));
+
+    std::optional<Trade::ImageData2D> second = importer.image2D(0);
+    CORRADE_VERIFY(second);
+    CORRADE_COMPARE(second->size(), (Vector2i{2, 3}));
+    CORRADE_COMPARE_AS(second->data(), first->data(),
+        TestSuite::Compare::Container);
 }
 
 }}}
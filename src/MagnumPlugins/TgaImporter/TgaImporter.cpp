@@ -31,9 +31,10 @@
 #include <Corrade/Utility/Endianness.h>
 #include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/PixelConversion.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Implementation/mapFile.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -44,6 +45,57 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+#ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+/* Transfers ownership of the mapping to array containing just the pixel
+   data. Pages after the pixel data are unmapped right away, the deleter then
+   unmaps the rest including the header. */
+Containers::Array<char> pixelsFromMapping(Containers::Array<char>&& file, const std::size_t dataSize) {
+    const std::size_t fileSize = file.size();
+    char* const base = file.release();
+
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    const std::size_t end = (sizeof(TgaHeader) + dataSize + pageSize - 1)/pageSize*pageSize;
+    if(end < fileSize) munmap(base + end, fileSize - end);
+
+    return Containers::Array<char>{base + sizeof(TgaHeader), dataSize, [](char* data, std::size_t size) {
+        munmap(data - sizeof(TgaHeader), size + sizeof(TgaHeader));
+    }};
+}
+#endif
+
+/* Decodes RLE packets until the output is filled, returns false if the input
+   is truncated */
+bool decodeRle(const char* in, const char* const inEnd, char* out, char* const outEnd, const std::size_t pixelSize) {
+    while(out != outEnd) {
+        if(in == inEnd) return false;
+
+        /* Packets going past the end of the image are silently cut */
+        const UnsignedByte packet = *in++;
+        const std::size_t count = std::min<std::size_t>((packet & 0x7f) + 1, (outEnd - out)/pixelSize);
+
+        /* Run-length packet, one pixel repeated */
+        if(packet & 0x80) {
+            if(std::size_t(inEnd - in) < pixelSize) return false;
+            for(std::size_t i = 0; i != count; ++i)
+                out = std::copy_n(in, pixelSize, out);
+            in += pixelSize;
+
+        /* Raw packet */
+        } else {
+            const std::size_t size = count*pixelSize;
+            if(std::size_t(inEnd - in) < size) return false;
+            out = std::copy_n(in, size, out);
+            in += size;
+        }
+    }
+
+    return true;
+}
+
+}
+
 TgaImporter::TgaImporter() = default;
 
 TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter{manager, std::move(plugin)} {}
@@ -52,25 +104,60 @@ TgaImporter::~TgaImporter() = default;
 
 auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData; }
 
-bool TgaImporter::doIsOpened() const { return _in; }
+bool TgaImporter::doIsOpened() const { return _in || !_filename.empty(); }
 
-void TgaImporter::doClose() { _in = nullptr; }
+void TgaImporter::doClose() {
+    _in = nullptr;
+    _mapped = nullptr;
+    _filename.clear();
+}
 
 void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
     _in = Containers::Array<char>{data.size()};
     std::copy(data.begin(), data.end(), _in.begin());
 }
 
+void TgaImporter::doOpenFile(const std::string& filename) {
+    /* If the file can be mapped, keep the mapping and remember its name. The
+       returned image takes the ownership of the mapping, so image2D() maps
+       the file again if called more than once. Private writable mapping, so
+       the pixels can be converted in place without touching the file. */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if((_mapped = Magnum::Implementation::mapFileWritable(filename))) {
+        _filename = filename;
+        return;
+    }
+    #endif
+
+    /* Otherwise read the file into memory */
+    AbstractImporter::doOpenFile(filename);
+}
+
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
 
 std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
+    /* Take the mapping done in openFile() or map the file again, if opened
+       from file */
+    Containers::Array<char> mapped;
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(!_filename.empty()) {
+        if(_mapped) mapped = std::move(_mapped);
+        else if(!(mapped = Magnum::Implementation::mapFileWritable(_filename))) {
+            Error() << "Trade::TgaImporter::image2D(): cannot map file" << _filename;
+            return std::nullopt;
+        }
+    }
+    #endif
+    const Containers::ArrayView<const char> in = mapped ?
+        Containers::ArrayView<const char>{mapped} : Containers::ArrayView<const char>{_in};
+
     /* Check if the file is long enough */
-    if(_in.size() < std::streamoff(sizeof(TgaHeader))) {
-        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << _in.size() << "bytes";
+    if(in.size() < std::streamoff(sizeof(TgaHeader))) {
+        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << in.size() << "bytes";
         return std::nullopt;
     }
 
-    const TgaHeader& header = *reinterpret_cast<const TgaHeader*>(_in.data());
+    const TgaHeader& header = *reinterpret_cast<const TgaHeader*>(in.data());
 
     /* Size in machine endian */
     const Vector2i size{Utility::Endianness::littleEndian(header.width),
@@ -84,7 +171,7 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
     }
 
     /* Color */
-    if(header.imageType == 2) {
+    if(header.imageType == 2 || header.imageType == 10) {
         switch(header.bpp) {
             case 24:
                 format = PixelFormat::RGB;
@@ -98,7 +185,7 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
         }
 
     /* Grayscale */
-    } else if(header.imageType == 3) {
+    } else if(header.imageType == 3 || header.imageType == 11) {
         #if defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         format = Context::hasCurrent() && Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
             PixelFormat::Red : PixelFormat::Luminance;
@@ -112,29 +199,45 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
             return std::nullopt;
         }
 
-    /* Compressed files */
+    /* Paletted or unknown files */
     } else {
         Error() << "Trade::TgaImporter::image2D(): unsupported (compressed?) image type:" << header.imageType;
         return std::nullopt;
     }
 
-    Containers::Array<char> data{std::size_t(size.product())*header.bpp/8};
-    std::copy_n(_in + sizeof(TgaHeader), data.size(), data.begin());
+    const std::size_t dataSize = std::size_t(size.product())*header.bpp/8;
+    Containers::Array<char> data;
+
+    /* Decompress RLE-encoded data */
+    if(header.imageType & 8) {
+        data = allocate(dataSize);
+        if(!decodeRle(in.data() + sizeof(TgaHeader), in.end(), data.begin(), data.end(), header.bpp/8)) {
+            Error() << "Trade::TgaImporter::image2D(): the RLE-compressed data are truncated";
+            return std::nullopt;
+        }
+
+    } else if(in.size() < sizeof(TgaHeader) + dataSize) {
+        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << in.size() << "bytes, expected" << sizeof(TgaHeader) + dataSize;
+        return std::nullopt;
+    }
+
+    /* Reference the mapped pixels directly, copy otherwise */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    else if(mapped) data = pixelsFromMapping(std::move(mapped), dataSize);
+    #endif
+    else {
+        data = allocate(dataSize);
+        std::copy_n(in.data() + sizeof(TgaHeader), dataSize, data.begin());
+    }
 
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
     if((size.x()*header.bpp/8)%4 != 0)
         storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(format == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
-    }
+    /* Convert BGR(A) to RGB(A) in place */
+    if(format == PixelFormat::RGB || format == PixelFormat::RGBA)
+        convertPixels(format, PixelType::UnsignedByte, data, format, PixelType::UnsignedByte, data, PixelConversionFlag::SwapRedBlue);
 
     return ImageData2D{storage, format, PixelType::UnsignedByte, size, std::move(data)};
 }
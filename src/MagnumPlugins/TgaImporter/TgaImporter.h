@@ -54,7 +54,8 @@ namespace Magnum { namespace Trade {
 /**
 @brief TGA importer plugin
 
-Supports uncompressed BGR, BGRA or grayscale images with 8 bits per channel.
+Supports uncompressed and RLE-compressed BGR, BGRA or grayscale images with 8
+bits per channel.
 
 This plugin is built if `WITH_TGAIMPORTER` is enabled when building Magnum. To
 use dynamic plugin, you need to load `TgaImporter` plugin from
@@ -69,6 +70,14 @@ require extension @extension{ARB,texture_rg}. Imported images are imported with
 default @ref PixelStorage parameters except for alignment, which may be changed
 to `1` if the data require it.
 
+On Unix systems, files opened with @ref openFile() are memory-mapped instead
+of being read into memory. Each call to @ref image2D() then maps the file
+again and the returned image data reference the mapped pages directly. The
+BGR to RGB conversion of color images is done in place using SIMD, if
+available on given platform, only the converted pages are copied by the
+system. Grayscale images aren't converted at all. RLE-compressed images are
+always decoded into newly allocated memory.
+
 In OpenGL ES 2.0, if @es_extension{EXT,texture_rg} is not supported and in
 WebGL 1.0, grayscale images use @ref PixelFormat::Luminance instead of
 @ref PixelFormat::Red.
@@ -87,11 +96,16 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         Features MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenFile(const std::string& filename) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         std::optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
 
         Containers::Array<char> _in;
+
+        /* File mapped in openFile(), handed over to the first image */
+        Containers::Array<char> _mapped;
+        std::string _filename;
 };
 
 }}
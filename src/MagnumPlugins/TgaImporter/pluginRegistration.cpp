@@ -26,4 +26,4 @@
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
@@ -45,6 +45,12 @@ class WavImporterTest: public TestSuite::Tester {
         void unsupportedChannelCount();
         void mono16();
         void stereo8();
+        void mono24();
+        void stereoFloat();
+
+        void readData();
+        void readFile();
+        void readConvertedData();
 };
 
 WavImporterTest::WavImporterTest() {
@@ -53,7 +59,13 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::unsupportedFormat,
               &WavImporterTest::unsupportedChannelCount,
               &WavImporterTest::mono16,
-              &WavImporterTest::stereo8});
+              &WavImporterTest::stereo8,
+              &WavImporterTest::mono24,
+              &WavImporterTest::stereoFloat,
+
+              &WavImporterTest::readData,
+              &WavImporterTest::readFile,
+              &WavImporterTest::readConvertedData});
 }
 
 void WavImporterTest::wrongSize() {
@@ -71,7 +83,7 @@ void WavImporterTest::wrongSignature() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "wrongSignature.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file signature is invalid\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file signature is invalid\n");
 }
 
 void WavImporterTest::unsupportedFormat() {
@@ -80,7 +92,7 @@ void WavImporterTest::unsupportedFormat() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedFormat.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported audio format 2\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported audio format 2\n");
 }
 
 void WavImporterTest::unsupportedChannelCount() {
@@ -89,7 +101,7 @@ void WavImporterTest::unsupportedChannelCount() {
 
     WavImporter importer;
     CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedChannelCount.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported channel count 6 with 8 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported channel count 6 with 8 bits per sample\n");
 }
 
 void WavImporterTest::mono16() {
@@ -114,6 +126,96 @@ void WavImporterTest::stereo8() {
         TestSuite::Compare::Container);
 }
 
+void WavImporterTest::mono24() {
+    /* There's no audio context, so the samples are converted to 16 bits */
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono24.wav")));
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(importer.frequency(), 48000);
+    CORRADE_COMPARE_AS(importer.data(),
+        Containers::Array<char>::from('\xff', '\x7f', '\x00', '\x80', '\x34', '\x12', '\xdc', '\xfe'),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::stereoFloat() {
+    /* The file has a LIST chunk before the format, which should be skipped.
+       Out-of-range samples are clamped. */
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereoFloat.wav")));
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer.frequency(), 44100);
+    CORRADE_COMPARE_AS(importer.data(),
+        Containers::Array<char>::from(
+            '\xff', '\x7f', '\x01', '\x80', '\x00', '\x40', '\xff', '\x7f',
+            '\x00', '\x00', '\x00', '\xe0', '\x00', '\x20', '\x01', '\x80',
+            '\x00', '\x10', '\x00', '\xc0'),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::readData() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav"))));
+
+    char data[3];
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 3}),
+        Containers::Array<char>::from('\xde', '\xfe', '\xca'),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 1);
+    CORRADE_COMPARE(data[0], '\x7e');
+    CORRADE_COMPARE(importer.read(data), 0);
+}
+
+void WavImporterTest::readFile() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16.wav")));
+
+    char data[2];
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 2}),
+        Containers::Array<char>::from('\x1d', '\x10'),
+        TestSuite::Compare::Container);
+
+    /* Reading the whole data shouldn't affect the incremental read */
+    CORRADE_COMPARE_AS(importer.data(),
+        Containers::Array<char>::from('\x1d', '\x10', '\x71', '\xc5'),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 2}),
+        Containers::Array<char>::from('\x71', '\xc5'),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 0);
+
+    /* After rewind the data are read from the beginning again */
+    importer.rewind();
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE(data[0], '\x1d');
+}
+
+void WavImporterTest::readConvertedData() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono24.wav"))));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+
+    char data[3];
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 3}),
+        Containers::Array<char>::from('\xff', '\x7f', '\x00'),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 3}),
+        Containers::Array<char>::from('\x80', '\x34', '\x12'),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const char>{data, 2}),
+        Containers::Array<char>::from('\xdc', '\xfe'),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
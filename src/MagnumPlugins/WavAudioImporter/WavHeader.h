@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Audio::WavHeader
+ * @brief Struct @ref Magnum::Audio::WavHeader, @ref Magnum::Audio::WavChunkHeader, @ref Magnum::Audio::WavFormatChunk
  */
 
 #include "Magnum/Types.h"
@@ -52,9 +52,37 @@ struct WavHeader {
     char subChunk2Id[4];            /**< @brief `data` characters */
     UnsignedInt subChunk2Size;      /**< @brief Size of the following data */
 };
+
+/**
+@brief WAV chunk header
+
+Header of each chunk following the `RIFF` and `WAVE` characters. The chunk
+data are padded to an even size.
+*/
+struct WavChunkHeader {
+    char chunkId[4];                /**< @brief Chunk ID */
+    UnsignedInt chunkSize;          /**< @brief Size of the chunk data */
+};
+
+/**
+@brief WAV format chunk
+
+Data of the `fmt ` chunk, at least 16 bytes. Formats other than PCM may have
+additional data after it.
+*/
+struct WavFormatChunk {
+    UnsignedShort audioFormat;      /**< @brief 1 = PCM, 3 = IEEE float */
+    UnsignedShort numChannels;      /**< @brief 1 = Mono, 2 = Stereo */
+    UnsignedInt sampleRate;         /**< @brief Sample rate in Hz */
+    UnsignedInt byteRate;           /**< @brief Bytes per second */
+    UnsignedShort blockAlign;       /**< @brief Bytes per sample (all channels) */
+    UnsignedShort bitsPerSample;    /**< @brief Bits per sample (one channel) */
+};
 #pragma pack()
 
 static_assert(sizeof(WavHeader) == 44, "WavHeader size is not 44 bytes");
+static_assert(sizeof(WavChunkHeader) == 8, "WavChunkHeader size is not 8 bytes");
+static_assert(sizeof(WavFormatChunk) == 16, "WavFormatChunk size is not 16 bytes");
 
 }}
 
@@ -25,105 +25,447 @@
 
 #include "WavImporter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Extensions.h"
+#include "Magnum/Implementation/mapFile.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_WAVIMPORTER_USE_SSE2
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 namespace Magnum { namespace Audio {
 
-WavImporter::WavImporter() = default;
+enum class WavImporter::Conversion: UnsignedByte {
+    None,
+    FloatToShort,
+    Int24ToShort,
+    Int24ToFloat
+};
 
-WavImporter::WavImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter(manager, std::move(plugin)) {}
+namespace {
 
-auto WavImporter::doFeatures() const -> Features { return Feature::OpenData; }
+enum: UnsignedShort {
+    FormatPcm = 1,
+    FormatFloat = 3,
+    FormatExtensible = 0xfffe
+};
 
-bool WavImporter::doIsOpened() const { return _data; }
+#ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+/* Shrinks the mapping after the samples were converted in place to a smaller
+   type. Pages after the new end are unmapped right away, the deleter then
+   unmaps the rest. */
+Containers::Array<char> shrinkMapping(Containers::Array<char>&& data, const std::size_t size) {
+    const std::size_t oldSize = data.size();
+    char* const begin = data.release();
 
-void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    const std::size_t pageOffset = reinterpret_cast<std::uintptr_t>(begin) % pageSize;
+    const std::size_t end = (pageOffset + size + pageSize - 1)/pageSize*pageSize;
+    const std::size_t oldEnd = (pageOffset + oldSize + pageSize - 1)/pageSize*pageSize;
+    if(end < oldEnd) munmap(begin - pageOffset + end, oldEnd - end);
+
+    return Containers::Array<char>{begin, size, Magnum::Implementation::unmapFile<char>};
+}
+#endif
+
+/* Walks the RIFF chunks up to the sample data, skipping the ones it doesn't
+   understand. The read function copies given range of the file, the ranges
+   are always checked against the file size first. */
+template<class Read> bool findChunks(Read read, const std::size_t size, const char* const prefix, WavFormatChunk& format, UnsignedShort& subFormat, std::size_t& dataOffset, std::size_t& dataSize) {
     /* Check file size */
-    if(data.size() < sizeof(WavHeader)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+    if(size < sizeof(WavHeader)) {
+        Error() << prefix << "the file is too short:" << size << "bytes";
+        return false;
     }
 
-    /* Get header contents and fix endianness */
-    WavHeader header(*reinterpret_cast<const WavHeader*>(data.begin()));
-    Utility::Endianness::littleEndianInPlace(header.chunkSize,
-        header.subChunk1Size, header.audioFormat, header.numChannels,
-        header.sampleRate, header.byteRate, header.blockAlign,
-        header.bitsPerSample, header.subChunk2Size);
+    /* Only the RIFF header is read from the WavHeader, the rest is chunk by
+       chunk */
+    WavHeader header;
+    read(0, reinterpret_cast<char*>(&header), 12);
+    Utility::Endianness::littleEndianInPlace(header.chunkSize);
 
     /* Check file signature */
     if(std::strncmp(header.chunkId, "RIFF", 4) != 0 ||
-       std::strncmp(header.format, "WAVE", 4) != 0 ||
-       std::strncmp(header.subChunk1Id, "fmt ", 4) != 0 ||
-       std::strncmp(header.subChunk2Id, "data", 4) != 0) {
-        Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+       std::strncmp(header.format, "WAVE", 4) != 0) {
+        Error() << prefix << "the file signature is invalid";
+        return false;
     }
 
     /* Check file size */
-    if(header.chunkSize + 8 != data.size()) {
-        Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunkSize + 8 << "but got" << data.size();
-        return;
+    if(header.chunkSize + 8 != size) {
+        Error() << prefix << "the file has improper size, expected"
+                << header.chunkSize + 8 << "but got" << size;
+        return false;
     }
 
-    /* Check PCM format */
-    if(header.audioFormat != 1) {
-        Error() << "Audio::WavImporter::openData(): unsupported audio format" << header.audioFormat;
-        return;
+    bool hasFormat = false;
+    std::size_t offset = 12;
+    while(offset + sizeof(WavChunkHeader) <= size) {
+        WavChunkHeader chunk;
+        read(offset, reinterpret_cast<char*>(&chunk), sizeof(WavChunkHeader));
+        Utility::Endianness::littleEndianInPlace(chunk.chunkSize);
+        offset += sizeof(WavChunkHeader);
+
+        if(chunk.chunkSize > size - offset) {
+            Error() << prefix << "the file is corrupted";
+            return false;
+        }
+
+        if(std::strncmp(chunk.chunkId, "fmt ", 4) == 0) {
+            if(chunk.chunkSize < sizeof(WavFormatChunk)) {
+                Error() << prefix << "the file is corrupted";
+                return false;
+            }
+
+            read(offset, reinterpret_cast<char*>(&format), sizeof(WavFormatChunk));
+            Utility::Endianness::littleEndianInPlace(format.audioFormat,
+                format.numChannels, format.sampleRate, format.byteRate,
+                format.blockAlign, format.bitsPerSample);
+
+            /* The actual format of extensible files is in the first two
+               bytes of the sub-format GUID */
+            subFormat = format.audioFormat;
+            if(format.audioFormat == FormatExtensible) {
+                if(chunk.chunkSize < 40) {
+                    Error() << prefix << "the file is corrupted";
+                    return false;
+                }
+
+                read(offset + 24, reinterpret_cast<char*>(&subFormat), 2);
+                Utility::Endianness::littleEndianInPlace(subFormat);
+            }
+
+            hasFormat = true;
+
+        } else if(std::strncmp(chunk.chunkId, "data", 4) == 0) {
+            if(!hasFormat) break;
+
+            dataOffset = offset;
+            dataSize = chunk.chunkSize;
+            return true;
+        }
+
+        /* Chunks are padded to even size */
+        offset += chunk.chunkSize + (chunk.chunkSize & 1);
+    }
+
+    Error() << prefix << "the file signature is invalid";
+    return false;
+}
+
+bool isFloatSupported() {
+    return Context::hasCurrent() && Context::current().isExtensionSupported<Extensions::AL::EXT::FLOAT32>();
+}
+
+/* Converts given count of single-channel samples. Conversions to a smaller
+   type can be done in place, as the output never overtakes the input. */
+void convertFloatToShort(const char* const from, char* const to, const std::size_t count) {
+    std::size_t i = 0;
+    #ifdef MAGNUM_WAVIMPORTER_USE_SSE2
+    /* The values are clamped first, as out-of-range floats would be converted
+       to the integer minimum regardless of sign */
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 min = _mm_set1_ps(-1.0f);
+    const __m128 max = _mm_set1_ps(1.0f);
+    for(; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_loadu_ps(reinterpret_cast<const Float*>(from) + i);
+        const __m128 b = _mm_loadu_ps(reinterpret_cast<const Float*>(from) + i + 4);
+        const __m128i ia = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(a, min), max), scale));
+        const __m128i ib = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(b, min), max), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i*2), _mm_packs_epi32(ia, ib));
+    }
+    #endif
+    for(; i != count; ++i) {
+        Float value;
+        std::memcpy(&value, from + i*4, 4);
+        const Short result = Short(std::lrint(std::min(std::max(value, -1.0f), 1.0f)*32767.0f));
+        std::memcpy(to + i*2, &result, 2);
+    }
+}
+
+void convertInt24ToShort(const char* const from, char* const to, const std::size_t count) {
+    std::size_t i = 0;
+    #ifdef __SSSE3__
+    /* Four samples in each block, the loads read four bytes past the last
+       sample. Only eight bytes are stored to not overwrite input that wasn't
+       processed yet when converting in place. */
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1);
+    for(; i*3 + 16 <= count*3; i += 4) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i*3));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(to + i*2), _mm_shuffle_epi8(block, shuffle));
+    }
+    #endif
+    for(; i != count; ++i) {
+        to[i*2] = from[i*3 + 1];
+        to[i*2 + 1] = from[i*3 + 2];
+    }
+}
+
+void convertInt24ToFloat(const char* const from, char* const to, const std::size_t count) {
+    std::size_t i = 0;
+    #ifdef __SSSE3__
+    /* Put the samples into upper three bytes of each 32-bit integer, which
+       takes care of the sign */
+    const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128 scale = _mm_set1_ps(1.0f/2147483648.0f);
+    for(; i*3 + 16 <= count*3; i += 4) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i*3));
+        _mm_storeu_ps(reinterpret_cast<Float*>(to) + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(block, shuffle)), scale));
+    }
+    #endif
+    for(; i != count; ++i) {
+        const Int value = Int(UnsignedInt(UnsignedByte(from[i*3])) << 8|
+                              UnsignedInt(UnsignedByte(from[i*3 + 1])) << 16|
+                              UnsignedInt(UnsignedByte(from[i*3 + 2])) << 24);
+        const Float result = Float(value)*(1.0f/2147483648.0f);
+        std::memcpy(to + i*4, &result, 4);
+    }
+}
+
+}
+
+WavImporter::WavImporter() = default;
+
+WavImporter::WavImporter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImporter(manager, std::move(plugin)) {}
+
+auto WavImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+WavImporter::~WavImporter() = default;
+
+bool WavImporter::doIsOpened() const { return _data || _file; }
+
+bool WavImporter::parse(const WavFormatChunk& header, const UnsignedShort subFormat, const std::size_t dataOffset, const std::size_t dataSize, const char* const prefix) {
+    /* Check sample format */
+    if(subFormat != FormatPcm && subFormat != FormatFloat) {
+        Error() << prefix << "unsupported audio format" << header.audioFormat;
+        return false;
     }
 
     /* Verify more things */
-    if(header.subChunk1Size != 16 ||
-       header.subChunk2Size + 44 != data.size() ||
-       header.blockAlign != header.numChannels*header.bitsPerSample/8 ||
+    if(header.blockAlign != header.numChannels*header.bitsPerSample/8 ||
        header.byteRate != header.sampleRate*header.blockAlign) {
-        Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        Error() << prefix << "the file is corrupted";
+        return false;
     }
 
-    /* Decide about format */
-    if(header.numChannels == 1 && header.bitsPerSample == 8)
-        _format = Buffer::Format::Mono8;
-    else if(header.numChannels == 1 && header.bitsPerSample == 16)
-        _format = Buffer::Format::Mono16;
-    else if(header.numChannels == 2 && header.bitsPerSample == 8)
-        _format = Buffer::Format::Stereo8;
-    else if(header.numChannels == 2 && header.bitsPerSample == 16)
-        _format = Buffer::Format::Stereo16;
-    else {
-        Error() << "Audio::WavImporter::openData(): unsupported channel count"
+    /* Decide about format. 24-bit and floating-point samples are converted
+       to floats if the current context supports them, to 16-bit integers
+       otherwise. */
+    const bool stereo = header.numChannels == 2;
+    bool supported = header.numChannels == 1 || stereo;
+    _conversion = Conversion::None;
+    _sourceSampleSize = _sampleSize = header.bitsPerSample/8;
+    if(!supported) {
+        /* Handled below */
+    } else if(subFormat == FormatPcm && header.bitsPerSample == 8) {
+        _format = stereo ? Buffer::Format::Stereo8 : Buffer::Format::Mono8;
+    } else if(subFormat == FormatPcm && header.bitsPerSample == 16) {
+        _format = stereo ? Buffer::Format::Stereo16 : Buffer::Format::Mono16;
+    } else if((subFormat == FormatPcm && header.bitsPerSample == 24) ||
+              (subFormat == FormatFloat && header.bitsPerSample == 32)) {
+        if(isFloatSupported()) {
+            _format = stereo ? Buffer::Format::StereoFloat : Buffer::Format::MonoFloat;
+            _sampleSize = 4;
+            if(subFormat == FormatPcm) _conversion = Conversion::Int24ToFloat;
+        } else {
+            _format = stereo ? Buffer::Format::Stereo16 : Buffer::Format::Mono16;
+            _sampleSize = 2;
+            _conversion = subFormat == FormatPcm ?
+                Conversion::Int24ToShort : Conversion::FloatToShort;
+        }
+    } else supported = false;
+
+    if(!supported) {
+        Error() << prefix << "unsupported channel count"
                 << header.numChannels << "with" << header.bitsPerSample
                 << "bits per sample";
-        return;
+        return false;
     }
 
-    /* Save frequency */
+    /* Save frequency and data location, trailing incomplete sample is
+       ignored */
     _frequency = header.sampleRate;
+    _dataOffset = dataOffset;
+    _dataSize = dataSize/_sourceSampleSize*_sourceSampleSize;
+    _readOffset = 0;
 
     /** @todo Convert the data from little endian too */
     CORRADE_INTERNAL_ASSERT(!Utility::Endianness::isBigEndian());
 
-    /* Copy the data */
-    _data = Containers::Array<char>(header.subChunk2Size);
-    std::copy(data.begin()+sizeof(WavHeader), data.end(), _data.begin());
-    return;
+    return true;
+}
+
+std::size_t WavImporter::convertedSize() const {
+    return _dataSize/_sourceSampleSize*_sampleSize;
+}
+
+void WavImporter::convert(const char* const from, char* const to, const std::size_t count) const {
+    switch(_conversion) {
+        case Conversion::None:
+            std::copy_n(from, count*_sampleSize, to);
+            return;
+        case Conversion::FloatToShort:
+            convertFloatToShort(from, to, count);
+            return;
+        case Conversion::Int24ToShort:
+            convertInt24ToShort(from, to, count);
+            return;
+        case Conversion::Int24ToFloat:
+            convertInt24ToFloat(from, to, count);
+            return;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::size_t WavImporter::readConverted(const std::size_t offset, const Containers::ArrayView<char> data) {
+    /* Unconverted data can be read byte by byte */
+    if(_conversion == Conversion::None) {
+        const std::size_t size = std::min(data.size(), _dataSize - offset);
+        if(_file) {
+            _file->clear();
+            _file->seekg(_dataOffset + offset);
+            _file->read(data, size);
+        } else std::copy_n(_data + _dataOffset + offset, size, data.begin());
+        return size;
+    }
+
+    /* Otherwise only whole samples */
+    const std::size_t count = std::min(data.size()/_sampleSize, (_dataSize - offset)/_sourceSampleSize);
+    if(!_file) {
+        convert(_data + _dataOffset + offset, data, count);
+        return count*_sampleSize;
+    }
+
+    /* Convert the file contents through a small staging buffer to avoid
+       reading all source data into memory */
+    char staging[4096];
+    const std::size_t stagingCount = sizeof(staging)/_sourceSampleSize;
+    _file->clear();
+    _file->seekg(_dataOffset + offset);
+    for(std::size_t i = 0; i < count; i += stagingCount) {
+        const std::size_t chunkCount = std::min(stagingCount, count - i);
+        _file->read(staging, chunkCount*_sourceSampleSize);
+        convert(staging, data + i*_sampleSize, chunkCount);
+    }
+    return count*_sampleSize;
+}
+
+void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    WavFormatChunk header;
+    UnsignedShort subFormat;
+    std::size_t dataOffset, dataSize;
+    if(!findChunks([&data](std::size_t offset, char* out, std::size_t count) {
+            std::copy_n(data + offset, count, out);
+        }, data.size(), "Audio::WavImporter::openData():", header, subFormat, dataOffset, dataSize) ||
+       !parse(header, subFormat, dataOffset, dataSize, "Audio::WavImporter::openData():"))
+        return;
+
+    /* Copy the data, converting them to the output format on the way so the
+       conversion doesn't need to be done again on every access */
+    _data = Containers::Array<char>(convertedSize());
+    convert(data + dataOffset, _data, _dataSize/_sourceSampleSize);
+    _conversion = Conversion::None;
+    _sourceSampleSize = _sampleSize;
+    _dataOffset = 0;
+    _dataSize = _data.size();
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    /* Map the file, the sample data are then referenced directly */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(Containers::Array<char> mapped = Magnum::Implementation::mapFileWritable(filename)) {
+        WavFormatChunk header;
+        UnsignedShort subFormat;
+        std::size_t dataOffset, dataSize;
+        if(!findChunks([&mapped](std::size_t offset, char* out, std::size_t count) {
+                std::copy_n(mapped + offset, count, out);
+            }, mapped.size(), "Audio::WavImporter::openFile():", header, subFormat, dataOffset, dataSize) ||
+           !parse(header, subFormat, dataOffset, dataSize, "Audio::WavImporter::openFile():"))
+            return;
+
+        _data = std::move(mapped);
+        _filename = filename;
+        return;
+    }
+    #endif
+
+    std::unique_ptr<std::ifstream> file{new std::ifstream{filename, std::ifstream::binary}};
+    if(!file->good()) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    /* Parse just the chunk headers, the sample data are then read from the
+       file on demand */
+    file->seekg(0, std::ios::end);
+    const std::size_t size = file->tellg();
+    WavFormatChunk header;
+    UnsignedShort subFormat;
+    std::size_t dataOffset, dataSize;
+    if(!findChunks([&file](std::size_t offset, char* out, std::size_t count) {
+            file->clear();
+            file->seekg(offset);
+            file->read(out, count);
+        }, size, "Audio::WavImporter::openFile():", header, subFormat, dataOffset, dataSize) ||
+       !parse(header, subFormat, dataOffset, dataSize, "Audio::WavImporter::openFile():"))
+        return;
+
+    _file = std::move(file);
 }
 
-void WavImporter::doClose() { _data = nullptr; }
+void WavImporter::doClose() {
+    _data = nullptr;
+    _file = nullptr;
+    _filename = {};
+}
 
 Buffer::Format WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data.size());
-    std::copy(_data.begin(), _data.end(), copy.begin());
-    return copy;
+    /* Map just the sample data from the file again, so the data can be
+       uploaded without any copy and pages that were already uploaded can be
+       discarded. Conversion to a smaller type is done in place, the mapping is
+       private so the file is not touched. */
+    #ifdef MAGNUM_IMPLEMENTATION_MAPFILE
+    if(!_filename.empty() && _conversion != Conversion::Int24ToFloat) {
+        if(Containers::Array<char> mapped = Magnum::Implementation::mapFileWritable(_filename, _dataOffset, _dataSize)) {
+            if(_conversion == Conversion::None) return mapped;
+
+            convert(mapped, mapped, _dataSize/_sourceSampleSize);
+            return shrinkMapping(std::move(mapped), convertedSize());
+        }
+    }
+    #endif
+
+    Containers::Array<char> out = allocate(convertedSize());
+    readConverted(0, out);
+    return out;
 }
 
+std::size_t WavImporter::doRead(const Containers::ArrayView<char> data) {
+    const std::size_t size = readConverted(_readOffset, data);
+    _readOffset += _conversion == Conversion::None ? size :
+        size/_sampleSize*_sourceSampleSize;
+    return size;
+}
+
+void WavImporter::doRewind() { _readOffset = 0; }
+
 }}
@@ -29,18 +29,41 @@
  * @brief Class @ref Magnum::Audio::WavImporter
  */
 
+#include <iosfwd>
+#include <memory>
+#include <string>
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
 namespace Magnum { namespace Audio {
 
+struct WavFormatChunk;
+
 /**
 @brief WAV importer plugin
 
-Supports mono and stereo PCM files with 8 or 16 bits per channel. The files are
-imported with @ref Buffer::Format::Mono8, @ref Buffer::Format::Mono16,
+Supports mono and stereo PCM files with 8, 16 or 24 bits per channel and
+32-bit IEEE floating-point files, including their `WAVE_FORMAT_EXTENSIBLE`
+variants. Chunks other than `fmt ` and `data` are skipped. 8- and 16-bit files
+are imported with @ref Buffer::Format::Mono8, @ref Buffer::Format::Mono16,
 @ref Buffer::Format::Stereo8 or @ref Buffer::Format::Stereo16, respectively.
+24-bit and floating-point files are converted to
+@ref Buffer::Format::MonoFloat or @ref Buffer::Format::StereoFloat if there is
+current @ref Context supporting @al_extension{EXT,float32} at the time the
+file is opened, to @ref Buffer::Format::Mono16 or
+@ref Buffer::Format::Stereo16 otherwise. The conversion is SIMD-accelerated
+where possible.
+
+Files opened with @ref openFile() are not read into memory, only the chunk
+headers are parsed and the sample data are read from the file on demand by
+@ref data() or in chunks by @ref read(), which makes the plugin suitable for
+streaming long tracks with @ref StreamingSource. On Unix systems the files are
+memory-mapped and each call to @ref data() maps just the sample data again,
+which can be then passed to @ref Buffer::setData() without any intermediate
+copy. Conversion to 16-bit integers is done in place in the mapped memory,
+only conversion of 24-bit files to floats allocates new memory. Data opened
+with @ref openData() are copied and converted once when opening.
 
 This plugin is built if `WITH_WAVAUDIOIMPORTER` is enabled when building
 Magnum. To use dynamic plugin, you need to load `WavAudioImporter` plugin
@@ -57,19 +80,36 @@ class WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, std::string plugin);
 
+        ~WavImporter();
+
     private:
         Features doFeatures() const override;
         bool doIsOpened() const override;
         void doOpenData(Containers::ArrayView<const char> data) override;
+        void doOpenFile(const std::string& filename) override;
         void doClose() override;
 
         Buffer::Format doFormat() const override;
         UnsignedInt doFrequency() const override;
         Containers::Array<char> doData() override;
+        std::size_t doRead(Containers::ArrayView<char> data) override;
+        void doRewind() override;
+
+        enum class Conversion: UnsignedByte;
+
+        bool parse(const WavFormatChunk& header, UnsignedShort subFormat, std::size_t dataOffset, std::size_t dataSize, const char* prefix);
+        std::size_t convertedSize() const;
+        void convert(const char* from, char* to, std::size_t count) const;
+        std::size_t readConverted(std::size_t offset, Containers::ArrayView<char> data);
 
         Containers::Array<char> _data;
+        std::unique_ptr<std::ifstream> _file;
+        std::string _filename;
+        std::size_t _dataOffset, _dataSize, _readOffset;
         Buffer::Format _format;
+        Conversion _conversion;
         UnsignedInt _frequency;
+        UnsignedByte _sourceSampleSize, _sampleSize;
 };
 
 }}